@@ -38,6 +38,13 @@
  * gst-launch amcsrc location=test.mp4 | autovideosink
  * ]|
  * </refsect2>
+ *
+ * With hardware-buffer=true (Android API level 26 or higher), the codec
+ * decodes into the surface of an AImageReader, and each frame is given as a
+ * memory wrapping the AImage without memcpy(). The AHardwareBuffer of the
+ * frame can be obtained with gst_amc_src_memory_get_hardware_buffer (), so
+ * that the GPU or NNAPI delegates may consume it directly.
+ * Note that hardware-buffer should be set before location.
  */
 
 #ifdef HAVE_CONFIG_H
@@ -73,6 +80,9 @@
 #include <media/NdkMediaError.h>
 #include <media/NdkMediaCodec.h>
 #include <media/NdkMediaExtractor.h>
+#if GST_AMC_SRC_HAS_HARDWARE_BUFFER
+#include <media/NdkImageReader.h>
+#endif
 
 #define TAG "AMCSRC"
 #define LOGI(...) ((void)__android_log_print(ANDROID_LOG_INFO, TAG, __VA_ARGS__))
@@ -92,6 +102,9 @@
 #define O_BINARY (0)
 #endif
 
+/** the max number of frames in the image reader, held by the pipeline */
+#define AMC_SRC_MAX_IMAGES (4)
+
 /**
  * @brief Private members in GstAMCSrc
  */
@@ -127,6 +140,13 @@ struct _GstAMCSrcPrivate
   AMediaExtractor *ex;
   AMediaCodec *codec;
   void *looper;
+
+  /** hardware buffer output */
+  gboolean use_hwbuf;
+#if GST_AMC_SRC_HAS_HARDWARE_BUFFER
+  AImageReader *reader;
+  AImageReader_ImageListener listener;
+#endif
 };
 
 #define GST_AMC_SRC_GET_PRIVATE(obj)  \
@@ -161,13 +181,18 @@ static GstFlowReturn gst_amc_src_create (GstPushSrc * src, GstBuffer ** buf);
 static GstStateChangeReturn gst_amc_src_change_state (GstElement * element,
     GstStateChange transition);
 
+#if GST_AMC_SRC_HAS_HARDWARE_BUFFER
+static void feed_frame_image (void *context, AImageReader * reader);
+#endif
+
 /**
  * @brief enum for propery
  */
 typedef enum
 {
   PROP_0,
-  PROP_LOCATION
+  PROP_LOCATION,
+  PROP_HARDWARE_BUFFER
 } GstAMCSrcProperty;
 
 /**
@@ -240,6 +265,50 @@ gst_wrapped_buf_unref (GstWrappedBuf * self)
 G_DEFINE_BOXED_TYPE (GstWrappedBuf, gst_wrapped_buf,
     gst_wrapped_buf_ref, gst_wrapped_buf_unref);
 
+#if GST_AMC_SRC_HAS_HARDWARE_BUFFER
+/**
+ * @brief structure for a wrapped image of the image reader
+ */
+typedef struct
+{
+  GstAMCSrc *amcsrc;
+  AImage *image;
+} GstWrappedImage;
+
+/**
+ * @brief the quark to attach the hardware buffer to a wrapped memory
+ */
+#define HARDWARE_BUFFER_QUARK \
+    (g_quark_from_static_string ("GstAMCSrcHardwareBuffer"))
+
+/**
+ * @brief callback for releasing a wrapped image
+ * @param[in] a wrapped image
+ */
+static void
+gst_wrapped_image_free (GstWrappedImage * self)
+{
+  g_return_if_fail (self != NULL);
+
+  /** the image is returned to the image reader */
+  AImage_delete (self->image);
+  gst_object_unref (self->amcsrc);
+  g_free (self);
+}
+
+/**
+ * @brief get the hardware buffer of a memory given by amcsrc
+ */
+AHardwareBuffer *
+gst_amc_src_memory_get_hardware_buffer (GstMemory * mem)
+{
+  g_return_val_if_fail (mem != NULL, NULL);
+
+  return (AHardwareBuffer *) gst_mini_object_get_qdata (GST_MINI_OBJECT (mem),
+      HARDWARE_BUFFER_QUARK);
+}
+#endif
+
 /**
  * @brief get system's nanotime
  */
@@ -273,6 +342,14 @@ gst_amc_src_class_init (GstAMCSrcClass * klass)
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
           GST_PARAM_MUTABLE_READY));
 
+  g_object_class_install_property (gobject_class, PROP_HARDWARE_BUFFER,
+      g_param_spec_boolean ("hardware-buffer", "Hardware buffer",
+          "Decode frames into hardware buffers (AHardwareBuffer) and feed "
+          "them without memcpy(), requires Android API level 26 or higher. "
+          "This should be set before location.", FALSE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
   /** GstBaseSrcClass members */
   gstbasesrc_class->start = GST_DEBUG_FUNCPTR (gst_amc_src_start);
   gstbasesrc_class->stop = GST_DEBUG_FUNCPTR (gst_amc_src_stop);
@@ -296,6 +373,81 @@ gst_amc_src_class_init (GstAMCSrcClass * klass)
   gstelement_class->change_state = GST_DEBUG_FUNCPTR (gst_amc_src_change_state);
 }
 
+/**
+ * @brief create the image reader and get its surface for the decoded frames
+ * @return the surface, or NULL to use the codec's output buffer
+ */
+static ANativeWindow *
+gst_amc_src_get_window (GstAMCSrc * self)
+{
+  GstAMCSrcPrivate *priv = GST_AMC_SRC_GET_PRIVATE (self);
+#if GST_AMC_SRC_HAS_HARDWARE_BUFFER
+  ANativeWindow *window = NULL;
+  media_status_t err;
+
+  if (!priv->use_hwbuf)
+    return NULL;
+
+  err = AImageReader_newWithUsage (priv->width, priv->height,
+      AIMAGE_FORMAT_YUV_420_888,
+      AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN |
+      AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE, AMC_SRC_MAX_IMAGES,
+      &priv->reader);
+  if (err != AMEDIA_OK) {
+    LOGW ("Error creating image reader (%d), use codec buffer.", err);
+    priv->reader = NULL;
+    return NULL;
+  }
+
+  priv->listener.context = self;
+  priv->listener.onImageAvailable = feed_frame_image;
+  AImageReader_setImageListener (priv->reader, &priv->listener);
+
+  if (AImageReader_getWindow (priv->reader, &window) != AMEDIA_OK) {
+    LOGW ("Error getting window of image reader, use codec buffer.");
+    AImageReader_delete (priv->reader);
+    priv->reader = NULL;
+    return NULL;
+  }
+
+  return window;
+#else
+  if (priv->use_hwbuf)
+    LOGW ("Hardware buffer requires Android API level 26, use codec buffer.");
+
+  return NULL;
+#endif
+}
+
+/**
+ * @brief delete the image reader
+ */
+static void
+gst_amc_src_reader_close (GstAMCSrc * self)
+{
+#if GST_AMC_SRC_HAS_HARDWARE_BUFFER
+  GstAMCSrcPrivate *priv = GST_AMC_SRC_GET_PRIVATE (self);
+
+  if (priv->reader) {
+    AImageReader_delete (priv->reader);
+    priv->reader = NULL;
+  }
+#endif
+}
+
+/**
+ * @brief check if the decoded frames are given with the image reader
+ */
+static inline gboolean
+gst_amc_src_has_reader (GstAMCSrc * self)
+{
+#if GST_AMC_SRC_HAS_HARDWARE_BUFFER
+  return GST_AMC_SRC_GET_PRIVATE (self)->reader != NULL;
+#else
+  return FALSE;
+#endif
+}
+
 /**
  * @brief config media codec settings; set the media source and obtain its format
  */
@@ -344,7 +496,8 @@ gst_amc_src_codec_config (GstAMCSrc * self)
         AMediaFormat_getInt64 (format, AMEDIAFORMAT_KEY_DURATION,
             &priv->duration);
 
-        AMediaCodec_configure (priv->codec, format, NULL /** surface */ ,
+        AMediaCodec_configure (priv->codec, format,
+            gst_amc_src_get_window (self) /** surface */ ,
             NULL /** crypto */ , 0);
         AMediaExtractor_selectTrack (priv->ex, i);
         AMediaFormat_delete (format);
@@ -440,6 +593,7 @@ gst_amc_src_set_location (GstAMCSrc * self, const gchar * location,
       g_free (priv->filename);
       AMediaCodec_delete (priv->codec);
       AMediaExtractor_delete (priv->ex);
+      gst_amc_src_reader_close (self);
     }
 
     priv->filename = g_strdup (location);
@@ -463,6 +617,9 @@ gst_amc_src_set_property (GObject * object, guint prop_id,
     case PROP_LOCATION:
       gst_amc_src_set_location (self, g_value_get_string (value), NULL);
       break;
+    case PROP_HARDWARE_BUFFER:
+      GST_AMC_SRC_GET_PRIVATE (self)->use_hwbuf = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -483,6 +640,9 @@ gst_amc_src_get_property (GObject * object, guint prop_id,
     case PROP_LOCATION:
       g_value_set_string (value, priv->filename);
       break;
+    case PROP_HARDWARE_BUFFER:
+      g_value_set_boolean (value, priv->use_hwbuf);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -628,6 +788,61 @@ data_queue_item_free (GstDataQueueItem * item)
   g_free (item);
 }
 
+/**
+ * @brief get the timestamp and duration of a decoded frame
+ * @note the caller should hold the mutex
+ * @return FALSE if the frame should be dropped
+ */
+static gboolean
+get_frame_timestamp (GstAMCSrc * self, GstClockTime * pts,
+    GstClockTime * duration)
+{
+  GstAMCSrcPrivate *priv = GST_AMC_SRC_GET_PRIVATE (self);
+  GstElement *element = GST_ELEMENT (self);
+  GstClockTime current_ts = GST_CLOCK_TIME_NONE;
+  GstClock *clock;
+
+  if ((clock = gst_element_get_clock (element))) {
+    current_ts =
+        gst_clock_get_time (clock) - gst_element_get_base_time (element);
+    gst_object_unref (clock);
+  }
+
+  if (!priv->started || GST_CLOCK_TIME_IS_VALID (priv->previous_ts)) {
+    *duration = current_ts - priv->previous_ts;
+    *pts = current_ts;
+    priv->previous_ts = current_ts;
+    return TRUE;
+  }
+
+  /** Dropping first image to calculate duration */
+  priv->previous_ts = current_ts;
+  return FALSE;
+}
+
+/**
+ * @brief push a buffer of the decoded frame to the data queue
+ * @note the caller should hold the mutex
+ */
+static void
+push_frame_buffer (GstAMCSrc * self, GstBuffer * buffer)
+{
+  GstAMCSrcPrivate *priv = GST_AMC_SRC_GET_PRIVATE (self);
+  GstDataQueueItem *item;
+
+  item = g_new0 (GstDataQueueItem, 1);
+  g_assert (item != NULL);
+  item->object = GST_MINI_OBJECT (buffer);
+  item->size = gst_buffer_get_size (buffer);
+  item->visible = TRUE;
+  item->destroy = (GDestroyNotify) data_queue_item_free;
+
+  if (!gst_data_queue_push (priv->outbound_queue, item)) {
+    item->destroy (item);
+    LOGW ("Failed to push item because we're flushing");
+  }
+}
+
 /**
  * @brief feed a decoded data from media codec to pipeline
  * @note it avoid memcpy() by wrapping memory
@@ -641,36 +856,20 @@ feed_frame_buf (GstAMCSrc * self, guint8 * buf, gint idx, gsize real_size,
     gsize buf_size)
 {
   GstAMCSrcPrivate *priv;
-  GstElement *element;
   GstBuffer *buffer;
   GstMemory *mem;
-  GstDataQueueItem *item;
   GstClockTime duration = GST_CLOCK_TIME_NONE;
   GstClockTime current_ts = GST_CLOCK_TIME_NONE;
-  GstClock *clock;
   GstWrappedBuf *wrapped_buf;
 
   g_return_if_fail (self != NULL);
   g_return_if_fail (buf != NULL);
 
   priv = GST_AMC_SRC_GET_PRIVATE (self);
-  element = GST_ELEMENT (self);
-
-  if ((clock = gst_element_get_clock (element))) {
-    current_ts =
-        gst_clock_get_time (clock) - gst_element_get_base_time (element);
-    gst_object_unref (clock);
-  }
 
   g_mutex_lock (&priv->mutex);
 
-  if (!priv->started || GST_CLOCK_TIME_IS_VALID (priv->previous_ts)) {
-    duration = current_ts - priv->previous_ts;
-    priv->previous_ts = current_ts;
-  } else {
-    priv->previous_ts = current_ts;
-
-    /** Dropping first image to calculate duration */
+  if (!get_frame_timestamp (self, &current_ts, &duration)) {
     AMediaCodec_releaseOutputBuffer (priv->codec, idx, 0);
     LOGI ("Drop buf %d (reason: %s)", idx,
         priv->started ? "first frame" : "not yet started");
@@ -698,22 +897,156 @@ feed_frame_buf (GstAMCSrc * self, guint8 * buf, gint idx, gsize real_size,
 
   gst_buffer_append_memory (buffer, mem);
 
-  item = g_new0 (GstDataQueueItem, 1);
-  g_assert (item != NULL);
-  item->object = GST_MINI_OBJECT (buffer);
-  item->size = gst_buffer_get_size (buffer);
-  item->visible = TRUE;
-  item->destroy = (GDestroyNotify) data_queue_item_free;
+  push_frame_buffer (self, buffer);
 
-  if (!gst_data_queue_push (priv->outbound_queue, item)) {
-    item->destroy (item);
-    LOGW ("Failed to push item because we're flushing");
+  gst_wrapped_buf_unref (wrapped_buf);
+
+  g_mutex_unlock (&priv->mutex);
+}
+
+#if GST_AMC_SRC_HAS_HARDWARE_BUFFER
+/**
+ * @brief copy a decoded image to a NV12 memory
+ * @note this is used only if the planes of the image are not NV12
+ */
+static GstMemory *
+copy_frame_image (GstAMCSrc * self, AImage * image)
+{
+  GstAMCSrcPrivate *priv = GST_AMC_SRC_GET_PRIVATE (self);
+  GstMemory *mem;
+  GstMapInfo map;
+  uint8_t *y, *u, *v;
+  int len;
+  int32_t y_stride, uv_stride, uv_pixel;
+  gint r, c, width = priv->width, height = priv->height;
+
+  if (AImage_getPlaneData (image, 0, &y, &len) != AMEDIA_OK ||
+      AImage_getPlaneData (image, 1, &u, &len) != AMEDIA_OK ||
+      AImage_getPlaneData (image, 2, &v, &len) != AMEDIA_OK)
+    return NULL;
+
+  AImage_getPlaneRowStride (image, 0, &y_stride);
+  AImage_getPlaneRowStride (image, 1, &uv_stride);
+  AImage_getPlanePixelStride (image, 1, &uv_pixel);
+
+  mem = gst_allocator_alloc (NULL, width * height * 3 / 2, NULL);
+  if (!mem || !gst_memory_map (mem, &map, GST_MAP_WRITE)) {
+    if (mem)
+      gst_memory_unref (mem);
+    return NULL;
   }
 
-  gst_wrapped_buf_unref (wrapped_buf);
+  for (r = 0; r < height; r++)
+    memcpy (map.data + r * width, y + r * y_stride, width);
+
+  for (r = 0; r < height / 2; r++) {
+    guint8 *uv = map.data + width * height + r * width;
+
+    for (c = 0; c < width / 2; c++) {
+      uv[2 * c] = u[r * uv_stride + c * uv_pixel];
+      uv[2 * c + 1] = v[r * uv_stride + c * uv_pixel];
+    }
+  }
+
+  gst_memory_unmap (mem, &map);
+  return mem;
+}
+
+/**
+ * @brief feed a decoded image from the image reader to pipeline
+ * @note it avoid memcpy() by wrapping the image if its planes are NV12
+ * @param[in] context amcsrc
+ * @param[in] reader the image reader of the codec's surface
+ */
+static void
+feed_frame_image (void *context, AImageReader * reader)
+{
+  GstAMCSrc *self = GST_AMC_SRC_CAST (context);
+  GstAMCSrcPrivate *priv = GST_AMC_SRC_GET_PRIVATE (self);
+  GstClockTime duration = GST_CLOCK_TIME_NONE;
+  GstClockTime current_ts = GST_CLOCK_TIME_NONE;
+  GstWrappedImage *wrapped_image;
+  AHardwareBuffer *hwbuf = NULL;
+  AImage *image = NULL;
+  GstBuffer *buffer;
+  GstMemory *mem;
+  uint8_t *y, *u, *v;
+  int y_len, u_len, v_len;
+  int32_t y_stride = 0, uv_stride = 0, uv_pixel = 0;
+  media_status_t err;
+
+  err = AImageReader_acquireNextImage (reader, &image);
+  if (err != AMEDIA_OK) {
+    /** all images are held by the pipeline */
+    LOGW ("Drop image (reason: acquiring image failed %d)", err);
+    return;
+  }
+
+  g_mutex_lock (&priv->mutex);
+
+  if (!get_frame_timestamp (self, &current_ts, &duration)) {
+    AImage_delete (image);
+    LOGI ("Drop image (reason: %s)",
+        priv->started ? "first frame" : "not yet started");
+    g_mutex_unlock (&priv->mutex);
+
+    return;
+  }
+
+  buffer = gst_buffer_new ();
+  GST_BUFFER_DURATION (buffer) = duration;
+  GST_BUFFER_PTS (buffer) = current_ts;
+
+  AImage_getHardwareBuffer (image, &hwbuf);
+
+  if (AImage_getPlaneData (image, 0, &y, &y_len) == AMEDIA_OK &&
+      AImage_getPlaneData (image, 1, &u, &u_len) == AMEDIA_OK &&
+      AImage_getPlaneData (image, 2, &v, &v_len) == AMEDIA_OK) {
+    AImage_getPlaneRowStride (image, 0, &y_stride);
+    AImage_getPlaneRowStride (image, 1, &uv_stride);
+    AImage_getPlanePixelStride (image, 1, &uv_pixel);
+  }
+
+  if (uv_pixel == 2 && v == u + 1 && u > y) {
+    /** NV12 planes, wrap the image with the strides of the planes */
+    gsize offset[GST_VIDEO_MAX_PLANES] = { 0, (gsize) (u - y) };
+    gint stride[GST_VIDEO_MAX_PLANES] = { y_stride, uv_stride };
+    gsize size = (gsize) ((v + v_len) - y);
+
+    wrapped_image = g_new0 (GstWrappedImage, 1);
+    g_assert (wrapped_image != NULL);
+    wrapped_image->amcsrc = g_object_ref (self);
+    wrapped_image->image = image;
+
+    mem = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,
+        y, size, 0, size, wrapped_image,
+        (GDestroyNotify) gst_wrapped_image_free);
+    if (hwbuf)
+      gst_mini_object_set_qdata (GST_MINI_OBJECT (mem), HARDWARE_BUFFER_QUARK,
+          hwbuf, NULL);
+
+    gst_buffer_add_video_meta_full (buffer, GST_VIDEO_FRAME_FLAG_NONE,
+        GST_VIDEO_FORMAT_NV12, priv->width, priv->height, 2, offset, stride);
+  } else {
+    /** e.g., I420 planes, the image is not used after copying it */
+    mem = copy_frame_image (self, image);
+    AImage_delete (image);
+  }
+
+  if (mem == NULL) {
+    LOGE ("Drop image (reason: failed to get frame data)");
+    gst_buffer_unref (buffer);
+    g_mutex_unlock (&priv->mutex);
+    return;
+  }
+
+  gst_buffer_append_memory (buffer, mem);
+
+  push_frame_buffer (self, buffer);
 
   g_mutex_unlock (&priv->mutex);
 }
+#endif
 
 /**
  * @brief check codec's input/output buffers to monitor/control its progress
@@ -766,7 +1099,10 @@ check_codec_buf (GstAMCSrc * self)
       if (delay > 0)
         usleep (delay / 1000);
 
-      if (info.size > 0) {
+      if (gst_amc_src_has_reader (self)) {
+        /** render it to the surface, then the image reader feeds it */
+        AMediaCodec_releaseOutputBuffer (priv->codec, buf_idx, info.size > 0);
+      } else if (info.size > 0) {
         /**
          * we do not release this output buffer here.
          * it will be returned to the media codec when its wrapped buf is deallocated.
@@ -970,6 +1306,7 @@ gst_amc_src_init (GstAMCSrc * self)
   priv->height = 0;
   priv->framerate = 0;
   priv->duration = 0;
+  priv->use_hwbuf = FALSE;
 
   g_mutex_init (&priv->mutex);
 
@@ -991,6 +1328,7 @@ gst_amc_src_finalize (GObject * object)
   g_free (priv->filename);
   AMediaCodec_delete (priv->codec);
   AMediaExtractor_delete (priv->ex);
+  gst_amc_src_reader_close (self);
 
   g_clear_pointer (&priv->outbound_queue, gst_object_unref);
   looper_close (self);
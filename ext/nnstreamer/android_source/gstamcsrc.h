@@ -29,6 +29,16 @@
 #include <gst/gst.h>
 #include <gst/base/gstpushsrc.h>
 
+/**
+ * @brief Hardware buffer (AImageReader and AHardwareBuffer) requires Android API level 26.
+ */
+#if defined (__ANDROID_API__) && __ANDROID_API__ >= 26
+#define GST_AMC_SRC_HAS_HARDWARE_BUFFER 1
+#include <android/hardware_buffer.h>
+#else
+#define GST_AMC_SRC_HAS_HARDWARE_BUFFER 0
+#endif
+
 G_BEGIN_DECLS
 
 #define GST_TYPE_AMC_SRC              (gst_amc_src_get_type ())
@@ -67,6 +77,16 @@ struct _GstAMCSrcClass
 GST_EXPORT
 GType gst_amc_src_get_type (void);
 
+#if GST_AMC_SRC_HAS_HARDWARE_BUFFER
+/**
+ * @brief Get the hardware buffer of a memory given by amcsrc with hardware-buffer=true.
+ * @param[in] mem The memory of a buffer from amcsrc
+ * @return The hardware buffer, valid while the memory is alive. NULL if the memory does not have it.
+ */
+GST_EXPORT
+AHardwareBuffer *gst_amc_src_memory_get_hardware_buffer (GstMemory * mem);
+#endif
+
 G_END_DECLS
 
 #endif /** __GST_AMC_SRC_H__ */
@@ -33,13 +33,23 @@ typedef enum {
   GRPC_IDL_FLATBUF
 } grpc_idl;
 
+/**
+ * @brief enum for gRPC channel compression
+ */
+typedef enum {
+  GRPC_COMPRESSION_TYPE_NONE = 0,
+  GRPC_COMPRESSION_TYPE_DEFLATE,
+  GRPC_COMPRESSION_TYPE_GZIP
+} grpc_compression_type;
+
 /**
  * @brief enum for gRPC service's message streaming direction
  */
 typedef enum {
   GRPC_DIRECTION_NONE = 0,
   GRPC_DIRECTION_TENSORS_TO_BUFFER, /* from tensors to protobuf/flatbuf */
-  GRPC_DIRECTION_BUFFER_TO_TENSORS  /* from protobuf/flatbuf to tensors */
+  GRPC_DIRECTION_BUFFER_TO_TENSORS, /* from protobuf/flatbuf to tensors */
+  GRPC_DIRECTION_BIDIRECTIONAL      /* requests and responses in a stream */
 } grpc_direction;
 
 /**
@@ -52,6 +62,18 @@ typedef struct {
   gchar * host;
   gint port;
 
+  guint num_cqs; /* the number of server completion queues (polling threads) */
+
+  gboolean bidirectional; /* share an instance with src/sink of same address */
+  guint max_inflight; /* the max number of requests without response (client) */
+
+  /* channel options */
+  gint max_message_size; /* max send/receive message size (0 for gRPC default, -1 for unlimited) */
+  guint keepalive_time; /* keepalive ping interval in msec (0 to disable) */
+  guint keepalive_timeout; /* keepalive ping timeout in msec */
+  grpc_compression_type compression;
+  guint num_channels; /* the number of client channels (HTTP/2 connections) */
+
   gboolean is_server;
   gboolean is_blocking;
 
@@ -76,9 +98,38 @@ enum
   PROP_IDL,
   PROP_HOST,
   PROP_PORT,
+  PROP_NUM_CQS,
+  PROP_BIDIRECTIONAL,
+  PROP_MAX_INFLIGHT,
+  PROP_MAX_MESSAGE_SIZE,
+  PROP_KEEPALIVE_TIME,
+  PROP_KEEPALIVE_TIMEOUT,
+  PROP_COMPRESSION,
+  PROP_NUM_CHANNELS,
   PROP_OUT,
 };
 
+/**
+ * @brief Default and max number of server completion queues
+ */
+#define DEFAULT_PROP_NUM_CQS (1)
+#define MAX_PROP_NUM_CQS (64)
+
+/**
+ * @brief Default max number of in-flight requests of bidirectional client (0 for unlimited)
+ */
+#define DEFAULT_PROP_MAX_INFLIGHT (16)
+
+/**
+ * @brief Default channel options
+ */
+#define DEFAULT_PROP_MAX_MESSAGE_SIZE (0)
+#define DEFAULT_PROP_KEEPALIVE_TIME (0)
+#define DEFAULT_PROP_KEEPALIVE_TIMEOUT (20000)
+#define DEFAULT_PROP_COMPRESSION "none"
+#define DEFAULT_PROP_NUM_CHANNELS (1)
+#define MAX_PROP_NUM_CHANNELS (16)
+
 /**
  * @brief C++ wrappers for gRPC per-IDL codes
  */
@@ -87,9 +138,11 @@ extern "C" {
 #endif
 
 grpc_idl grpc_get_idl (const gchar *idl_str);
+gboolean grpc_get_compression (const gchar *str, grpc_compression_type *compression);
 
 void * grpc_new (const grpc_config * config);
 void grpc_destroy (void * instance);
+void grpc_release (void * instance, const grpc_config * config);
 
 gboolean grpc_start (void * instance);
 void grpc_stop (void * instance);
@@ -22,12 +22,21 @@
 
 #include <grpcpp/health_check_service_interface.h>
 
+#include <chrono>
+
 static constexpr const char *NNS_GRPC_PROTOBUF_NAME = "libnnstreamer_grpc_protobuf";
 static constexpr const char *NNS_GRPC_FLATBUF_NAME = "libnnstreamer_grpc_flatbuf";
 static constexpr const char *NNS_GRPC_CREATE_INSTANCE = "create_instance";
 
 using namespace grpc;
 
+/**
+ * @brief The instances shared by the bidirectional src and sink elements.
+ *        The key is made from the IDL, mode and address of the instance.
+ */
+static GHashTable *shared_instances = NULL;
+G_LOCK_DEFINE_STATIC (shared_instances);
+
 /** @brief create new instance of NNStreamerRPC */
 NNStreamerRPC *
 NNStreamerRPC::createInstance (const grpc_config * config)
@@ -79,11 +88,21 @@ NNStreamerRPC::createInstance (const grpc_config * config)
 
 /** @brief constructor of NNStreamerRPC */
 NNStreamerRPC::NNStreamerRPC (const grpc_config * config):
+  refcount_ (0), started_ (FALSE),
   host_ (config->host), port_ (config->port),
   is_server_ (config->is_server), is_blocking_ (config->is_blocking),
-  direction_ (config->dir), cb_ (config->cb), cb_data_ (config->cb_data),
-  config_ (config->config), server_instance_ (nullptr), handle_ (nullptr),
-  stop_ (false)
+  direction_ (config->bidirectional ? GRPC_DIRECTION_BIDIRECTIONAL : config->dir),
+  cb_ (config->cb), cb_data_ (config->cb_data),
+  max_inflight_ (config->max_inflight), inflight_ (0), unlocked_ (FALSE),
+  config_ (config->config),
+  max_message_size_ (config->max_message_size),
+  keepalive_time_ (config->keepalive_time),
+  keepalive_timeout_ (config->keepalive_timeout),
+  compression_ (config->compression),
+  num_channels_ (CLAMP (config->num_channels, 1U, (guint) MAX_PROP_NUM_CHANNELS)),
+  server_instance_ (nullptr),
+  num_cqs_ (CLAMP (config->num_cqs, 1U, (guint) MAX_PROP_NUM_CQS)),
+  handle_ (nullptr), stop_ (false)
 {
   queue_ = gst_data_queue_new (_data_queue_check_full_cb,
       NULL, NULL, NULL);
@@ -114,6 +133,7 @@ NNStreamerRPC::stop () {
 
   /* notify to the worker */
   stop_ = true;
+  unlock_send ();
 
   if (queue_) {
     /* wait until the queue's flushed */
@@ -124,11 +144,28 @@ NNStreamerRPC::stop () {
   }
 
   if (is_server_) {
-    if (server_instance_.get ())
-      server_instance_->Shutdown ();
+    if (server_instance_.get ()) {
+      if (direction_ == GRPC_DIRECTION_BIDIRECTIONAL) {
+        /* the streams wait for the requests of the clients, cancel them */
+        server_instance_->Shutdown (std::chrono::system_clock::now () +
+            std::chrono::seconds (1));
+      } else {
+        server_instance_->Shutdown ();
+      }
+    }
 
-    if (completion_queue_.get ())
-      completion_queue_->Shutdown ();
+    for (auto &cq : completion_queues_)
+      cq->Shutdown ();
+  }
+
+  for (auto &cq_worker : cq_workers_) {
+    if (cq_worker.joinable ())
+      cq_worker.join ();
+  }
+
+  for (auto &client_worker : client_workers_) {
+    if (client_worker.joinable ())
+      client_worker.join ();
   }
 
   if (worker_.joinable ())
@@ -140,6 +177,21 @@ gboolean
 NNStreamerRPC::send (GstBuffer *buffer) {
   GstDataQueueItem *item;
 
+  if (direction_ == GRPC_DIRECTION_BIDIRECTIONAL) {
+    /* the server writes the response to the stream of the request directly */
+    if (is_server_)
+      return send_response (buffer);
+
+    /* flow control: wait for the responses of the in-flight requests */
+    std::unique_lock<std::mutex> lock (inflight_lock_);
+    while (max_inflight_ > 0 && inflight_ >= max_inflight_ && !unlocked_)
+      inflight_cond_.wait_for (lock, std::chrono::milliseconds (10));
+
+    if (unlocked_)
+      return FALSE;
+    inflight_++;
+  }
+
   buffer = gst_buffer_ref (buffer);
 
   item = g_new0 (GstDataQueueItem, 1);
@@ -156,6 +208,278 @@ NNStreamerRPC::send (GstBuffer *buffer) {
   return TRUE;
 }
 
+/**
+ * @brief attach the element to the shared instance.
+ * @note The src element receives the tensors with its callback, and the tensors
+ *       from the sink element are sent with its config and max in-flight requests.
+ */
+void
+NNStreamerRPC::attach (const grpc_config *config)
+{
+  if (config->dir == GRPC_DIRECTION_BUFFER_TO_TENSORS) {
+    std::lock_guard<std::mutex> lock (cb_lock_);
+
+    cb_ = config->cb;
+    cb_data_ = config->cb_data;
+  } else if (config->dir == GRPC_DIRECTION_TENSORS_TO_BUFFER) {
+    std::lock_guard<std::mutex> lock (inflight_lock_);
+
+    config_ = config->config;
+    max_inflight_ = config->max_inflight;
+    unlocked_ = FALSE;
+  }
+}
+
+/** @brief detach the element from the shared instance */
+void
+NNStreamerRPC::detach (const grpc_config *config)
+{
+  if (config->dir == GRPC_DIRECTION_BUFFER_TO_TENSORS) {
+    std::lock_guard<std::mutex> lock (cb_lock_);
+
+    if (cb_data_ == config->cb_data) {
+      cb_ = nullptr;
+      cb_data_ = nullptr;
+    }
+  }
+}
+
+/** @brief unblock the sender waiting for the in-flight requests */
+void
+NNStreamerRPC::unlock_send ()
+{
+  std::lock_guard<std::mutex> lock (inflight_lock_);
+
+  unlocked_ = TRUE;
+  inflight_cond_.notify_all ();
+}
+
+/** @brief the response of an in-flight request is received */
+void
+NNStreamerRPC::release_inflight ()
+{
+  std::lock_guard<std::mutex> lock (inflight_lock_);
+
+  if (inflight_ > 0)
+    inflight_--;
+  inflight_cond_.notify_all ();
+}
+
+/** @brief deliver the received buffer via callback, this takes the buffer */
+void
+NNStreamerRPC::deliver (GstBuffer *buffer)
+{
+  std::lock_guard<std::mutex> lock (cb_lock_);
+
+  if (cb_)
+    cb_ (cb_data_, buffer);
+  else
+    gst_buffer_unref (buffer);
+}
+
+/** @brief get gRPC compression algorithm */
+static grpc_compression_algorithm
+_get_compression_algorithm (grpc_compression_type compression)
+{
+  switch (compression) {
+    case GRPC_COMPRESSION_TYPE_DEFLATE:
+      return GRPC_COMPRESS_DEFLATE;
+    case GRPC_COMPRESSION_TYPE_GZIP:
+      return GRPC_COMPRESS_GZIP;
+    default:
+      return GRPC_COMPRESS_NONE;
+  }
+}
+
+/**
+ * @brief create the client channel with the channel options.
+ * @note The channels of the pool do not share the subchannels, so each
+ *       channel has its own HTTP/2 connection.
+ */
+std::shared_ptr<Channel>
+NNStreamerRPC::create_channel (const std::string &address, guint idx)
+{
+  ChannelArguments args;
+
+  if (max_message_size_ != 0) {
+    args.SetMaxReceiveMessageSize (max_message_size_);
+    args.SetMaxSendMessageSize (max_message_size_);
+  }
+
+  if (keepalive_time_ > 0) {
+    args.SetInt (GRPC_ARG_KEEPALIVE_TIME_MS, (int) keepalive_time_);
+    args.SetInt (GRPC_ARG_KEEPALIVE_TIMEOUT_MS, (int) keepalive_timeout_);
+    args.SetInt (GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, 1);
+    args.SetInt (GRPC_ARG_HTTP2_MAX_PINGS_WITHOUT_DATA, 0);
+  }
+
+  if (compression_ != GRPC_COMPRESSION_TYPE_NONE)
+    args.SetCompressionAlgorithm (_get_compression_algorithm (compression_));
+
+  if (num_channels_ > 1) {
+    args.SetInt (GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+    args.SetInt ("nnstreamer.channel_index", (int) idx);
+  }
+
+  return grpc::CreateCustomChannel (address,
+      grpc::InsecureChannelCredentials (), args);
+}
+
+/** @brief set the channel options of the server */
+void
+NNStreamerRPC::set_server_options (ServerBuilder &builder)
+{
+  if (max_message_size_ != 0) {
+    builder.SetMaxReceiveMessageSize (max_message_size_);
+    builder.SetMaxSendMessageSize (max_message_size_);
+  }
+
+  if (keepalive_time_ > 0) {
+    builder.AddChannelArgument (GRPC_ARG_KEEPALIVE_TIME_MS, (int) keepalive_time_);
+    builder.AddChannelArgument (GRPC_ARG_KEEPALIVE_TIMEOUT_MS,
+        (int) keepalive_timeout_);
+    builder.AddChannelArgument (GRPC_ARG_KEEPALIVE_PERMIT_WITHOUT_CALLS, 1);
+    /* accept the pings of the clients with same interval */
+    builder.AddChannelArgument (GRPC_ARG_HTTP2_MIN_RECV_PING_INTERVAL_WITHOUT_DATA_MS,
+        (int) keepalive_time_);
+  }
+
+  if (compression_ != GRPC_COMPRESSION_TYPE_NONE)
+    builder.SetDefaultCompressionAlgorithm (
+        _get_compression_algorithm (compression_));
+}
+
+/** @brief mapped memory referenced by a slice */
+typedef struct {
+  GstMemory *mem;
+  GstMapInfo map;
+} slice_memory_s;
+
+/** @brief unmap and release the memory when the slice is released */
+static void
+_slice_memory_free (void *data)
+{
+  slice_memory_s *sm = static_cast<slice_memory_s *> (data);
+
+  gst_memory_unmap (sm->mem, &sm->map);
+  gst_memory_unref (sm->mem);
+  g_free (sm);
+}
+
+/** @brief wrap the memory into a slice without copy, this takes the memory */
+static gboolean
+_memory_to_slice (GstMemory *mem, Slice &slice)
+{
+  slice_memory_s *sm = g_new0 (slice_memory_s, 1);
+
+  if (!gst_memory_map (mem, &sm->map, GST_MAP_READ)) {
+    ml_loge ("Failed to map the memory\n");
+    gst_memory_unref (mem);
+    g_free (sm);
+    return FALSE;
+  }
+
+  sm->mem = mem;
+  slice = Slice (sm->map.data, sm->map.size, _slice_memory_free, sm);
+  return TRUE;
+}
+
+/**
+ * @brief get the slices of the tensors in the buffer, referencing the memories.
+ * @note The data is not copied if each tensor is in its own memory.
+ *       Otherwise, the memories are merged (by gstreamer) and the slices are
+ *       the sub-slices of the merged memory.
+ */
+gboolean
+NNStreamerRPC::buffer_to_slices (GstBuffer *buffer,
+    const GstTensorsInfo *info, std::vector<Slice> &slices)
+{
+  guint i, num = info->num_tensors;
+  gboolean per_memory = (gst_buffer_n_memory (buffer) == num);
+
+  slices.clear ();
+
+  for (i = 0; i < num && per_memory; i++) {
+    GstMemory *mem = gst_buffer_peek_memory (buffer, i);
+
+    if (gst_memory_get_sizes (mem, NULL, NULL) !=
+        gst_tensor_info_get_size (&info->info[i]))
+      per_memory = FALSE;
+  }
+
+  if (per_memory) {
+    for (i = 0; i < num; i++) {
+      Slice slice;
+
+      if (!_memory_to_slice (gst_buffer_get_memory (buffer, i), slice))
+        return FALSE;
+      slices.push_back (slice);
+    }
+  } else {
+    Slice whole;
+    gsize offset = 0;
+
+    if (!_memory_to_slice (gst_buffer_get_all_memory (buffer), whole))
+      return FALSE;
+
+    for (i = 0; i < num; i++) {
+      gsize tsize = gst_tensor_info_get_size (&info->info[i]);
+
+      if (offset + tsize > whole.size ()) {
+        ml_logw ("Setting invalid tensor data");
+        break;
+      }
+
+      slices.push_back (whole.sub (offset, offset + tsize));
+      offset += tsize;
+    }
+  }
+
+  return TRUE;
+}
+
+/** @brief release the slice wrapped in the memory */
+static void
+_free_slice (gpointer data)
+{
+  delete static_cast<Slice *> (data);
+}
+
+/**
+ * @brief wrap the part of the slice into the memory without copy.
+ * @note The memory holds a reference of the slice.
+ */
+GstMemory *
+NNStreamerRPC::slice_to_memory (const Slice &slice, gsize offset, gsize size)
+{
+  /* the data of a small (inlined) slice is in the slice object itself */
+  Slice *ref = new Slice (slice);
+  guint8 *data = const_cast<guint8 *> (ref->begin ()) + offset;
+
+  return gst_memory_new_wrapped ((GstMemoryFlags) 0, data, size, 0,
+      size, ref, _free_slice);
+}
+
+/**
+ * @brief get the contiguous slice of the byte buffer.
+ * @note The data is copied only if the message is received in several slices.
+ */
+gboolean
+NNStreamerRPC::byte_buffer_to_slice (const ByteBuffer &buffer, Slice &slice)
+{
+  std::vector<Slice> slices;
+
+  if (!buffer.Dump (&slices).ok ())
+    return FALSE;
+
+  if (slices.size () == 1) {
+    slice = slices[0];
+    return TRUE;
+  }
+
+  return buffer.DumpToSingleSlice (&slice).ok ();
+}
+
 /** @brief start server service */
 gboolean
 NNStreamerRPC::_start_server () {
@@ -209,6 +533,24 @@ grpc_get_idl (const gchar *idl_str)
     return GRPC_IDL_NONE;
 }
 
+/**
+ * @brief get gRPC compression enum from a given string
+ */
+gboolean
+grpc_get_compression (const gchar *str, grpc_compression_type *compression)
+{
+  if (g_ascii_strcasecmp (str, "none") == 0)
+    *compression = GRPC_COMPRESSION_TYPE_NONE;
+  else if (g_ascii_strcasecmp (str, "deflate") == 0)
+    *compression = GRPC_COMPRESSION_TYPE_DEFLATE;
+  else if (g_ascii_strcasecmp (str, "gzip") == 0)
+    *compression = GRPC_COMPRESSION_TYPE_GZIP;
+  else
+    return FALSE;
+
+  return TRUE;
+}
+
 /**
  * @brief gRPC C++ wrapper to create the class instance
  */
@@ -217,7 +559,39 @@ grpc_new (const grpc_config * config)
 {
   g_return_val_if_fail (config != NULL, NULL);
 
-  NNStreamerRPC * self = NNStreamerRPC::createInstance (config);
+  if (!config->bidirectional) {
+    NNStreamerRPC * self = NNStreamerRPC::createInstance (config);
+
+    return static_cast <void *> (self);
+  }
+
+  /* src and sink elements of the same address share the instance (stream) */
+  gchar *key = g_strdup_printf ("%d:%d:%s:%d", config->idl, config->is_server,
+      config->host, config->port);
+  NNStreamerRPC * self;
+
+  G_LOCK (shared_instances);
+  if (!shared_instances)
+    shared_instances = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+        NULL);
+
+  self = static_cast<NNStreamerRPC *> (g_hash_table_lookup (shared_instances, key));
+  if (self) {
+    self->attach (config);
+    g_free (key);
+  } else {
+    self = NNStreamerRPC::createInstance (config);
+    if (self) {
+      self->shared_key_ = key;
+      g_hash_table_insert (shared_instances, key, self);
+    } else {
+      g_free (key);
+    }
+  }
+
+  if (self)
+    self->refcount_++;
+  G_UNLOCK (shared_instances);
 
   return static_cast <void *> (self);
 }
@@ -239,6 +613,38 @@ grpc_destroy (void *instance)
     g_module_close ((GModule *) handle);
 }
 
+/**
+ * @brief gRPC C++ wrapper to release the instance of the element.
+ * @note The shared instance is stopped and destroyed with the last element.
+ */
+void
+grpc_release (void *instance, const grpc_config * config)
+{
+  g_return_if_fail (instance != NULL);
+  g_return_if_fail (config != NULL);
+
+  NNStreamerRPC * self = static_cast<NNStreamerRPC *> (instance);
+
+  if (!config->bidirectional) {
+    grpc_destroy (instance);
+    return;
+  }
+
+  G_LOCK (shared_instances);
+  self->detach (config);
+
+  if (--self->refcount_ > 0) {
+    G_UNLOCK (shared_instances);
+    return;
+  }
+
+  g_hash_table_remove (shared_instances, self->shared_key_.c_str ());
+  G_UNLOCK (shared_instances);
+
+  self->stop ();
+  grpc_destroy (instance);
+}
+
 /**
  * @brief gRPC C++ wrapper to start gRPC service
  */
@@ -248,8 +654,21 @@ grpc_start (void * instance)
   g_return_val_if_fail (instance != NULL, FALSE);
 
   NNStreamerRPC * self = static_cast<NNStreamerRPC *> (instance);
+  gboolean ret;
+
+  if (self->shared_key_.empty ())
+    return self->start ();
+
+  /* the shared instance is started once */
+  G_LOCK (shared_instances);
+  if (self->started_) {
+    ret = TRUE;
+  } else {
+    ret = self->started_ = self->start ();
+  }
+  G_UNLOCK (shared_instances);
 
-  return self->start ();
+  return ret;
 }
 
 /**
@@ -262,6 +681,20 @@ grpc_stop (void * instance)
 
   grpc::NNStreamerRPC * self = static_cast<grpc::NNStreamerRPC *> (instance);
 
+  if (!self->shared_key_.empty ()) {
+    gboolean in_use;
+
+    G_LOCK (shared_instances);
+    in_use = (self->refcount_ > 1);
+    G_UNLOCK (shared_instances);
+
+    /* the other element still uses the shared instance, unblock the sender only */
+    if (in_use) {
+      self->unlock_send ();
+      return;
+    }
+  }
+
   self->stop ();
 }
 
@@ -367,6 +800,46 @@ grpc_common_set_property (GObject * self, gboolean * silent,
       grpc->config.port = g_value_get_int (value);
       silent_debug ("Set port = %d", grpc->config.port);
       break;
+    case PROP_NUM_CQS:
+      grpc->config.num_cqs = g_value_get_uint (value);
+      silent_debug ("Set num-cqs = %u", grpc->config.num_cqs);
+      break;
+    case PROP_BIDIRECTIONAL:
+      grpc->config.bidirectional = g_value_get_boolean (value);
+      silent_debug ("Set bidirectional = %d", grpc->config.bidirectional);
+      break;
+    case PROP_MAX_INFLIGHT:
+      grpc->config.max_inflight = g_value_get_uint (value);
+      silent_debug ("Set max-inflight = %u", grpc->config.max_inflight);
+      break;
+    case PROP_MAX_MESSAGE_SIZE:
+      grpc->config.max_message_size = g_value_get_int (value);
+      silent_debug ("Set max-message-size = %d", grpc->config.max_message_size);
+      break;
+    case PROP_KEEPALIVE_TIME:
+      grpc->config.keepalive_time = g_value_get_uint (value);
+      silent_debug ("Set keepalive-time = %u", grpc->config.keepalive_time);
+      break;
+    case PROP_KEEPALIVE_TIMEOUT:
+      grpc->config.keepalive_timeout = g_value_get_uint (value);
+      silent_debug ("Set keepalive-timeout = %u", grpc->config.keepalive_timeout);
+      break;
+    case PROP_COMPRESSION:
+    {
+      const gchar * str = g_value_get_string (value);
+
+      if (str) {
+        if (grpc_get_compression (str, &grpc->config.compression))
+          silent_debug ("Set compression = %s", str);
+        else
+          ml_loge ("Invalid compression string provided: %s", str);
+      }
+      break;
+    }
+    case PROP_NUM_CHANNELS:
+      grpc->config.num_channels = g_value_get_uint (value);
+      silent_debug ("Set num-channels = %u", grpc->config.num_channels);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (self, prop_id, pspec);
       break;
@@ -408,6 +881,40 @@ grpc_common_get_property (GObject * self, gboolean silent, guint out,
     case PROP_PORT:
       g_value_set_int (value, grpc->config.port);
       break;
+    case PROP_NUM_CQS:
+      g_value_set_uint (value, grpc->config.num_cqs);
+      break;
+    case PROP_BIDIRECTIONAL:
+      g_value_set_boolean (value, grpc->config.bidirectional);
+      break;
+    case PROP_MAX_INFLIGHT:
+      g_value_set_uint (value, grpc->config.max_inflight);
+      break;
+    case PROP_MAX_MESSAGE_SIZE:
+      g_value_set_int (value, grpc->config.max_message_size);
+      break;
+    case PROP_KEEPALIVE_TIME:
+      g_value_set_uint (value, grpc->config.keepalive_time);
+      break;
+    case PROP_KEEPALIVE_TIMEOUT:
+      g_value_set_uint (value, grpc->config.keepalive_timeout);
+      break;
+    case PROP_COMPRESSION:
+      switch (grpc->config.compression) {
+        case GRPC_COMPRESSION_TYPE_DEFLATE:
+          g_value_set_string (value, "deflate");
+          break;
+        case GRPC_COMPRESSION_TYPE_GZIP:
+          g_value_set_string (value, "gzip");
+          break;
+        default:
+          g_value_set_string (value, "none");
+          break;
+      }
+      break;
+    case PROP_NUM_CHANNELS:
+      g_value_set_uint (value, grpc->config.num_channels);
+      break;
     case PROP_OUT:
       g_value_set_uint (value, out);
       break;
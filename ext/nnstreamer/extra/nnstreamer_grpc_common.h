@@ -20,9 +20,12 @@
 #include <gst/base/gstdataqueue.h>
 #include <grpcpp/grpcpp.h>
 
+#include <condition_variable>
 #include <cstring>
+#include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 namespace grpc {
 
@@ -40,6 +43,10 @@ class NNStreamerRPC {
     void stop ();
     gboolean send (GstBuffer *buffer);
 
+    void attach (const grpc_config *config);
+    void detach (const grpc_config *config);
+    void unlock_send ();
+
     /** @brief get gRPC listening port (server only) */
     int getListeningPort () {
       if (is_server_)
@@ -64,6 +71,18 @@ class NNStreamerRPC {
       return direction_;
     }
 
+    static gboolean buffer_to_slices (GstBuffer *buffer,
+        const GstTensorsInfo *info, std::vector<Slice> &slices);
+    static GstMemory * slice_to_memory (const Slice &slice, gsize offset,
+        gsize size);
+    static gboolean byte_buffer_to_slice (const ByteBuffer &buffer,
+        Slice &slice);
+
+    /* bookkeeping of the shared (bidirectional) instance, guarded by the registry lock */
+    std::string shared_key_;
+    guint refcount_;
+    gboolean started_;
+
   protected:
     const gchar *host_;
     gint port_;
@@ -75,23 +94,52 @@ class NNStreamerRPC {
 
     grpc_cb cb_;
     void * cb_data_;
+    std::mutex cb_lock_;
+
+    /* flow control of the bidirectional client */
+    guint max_inflight_;
+    guint inflight_;
+    gboolean unlocked_;
+    std::mutex inflight_lock_;
+    std::condition_variable inflight_cond_;
 
     GstTensorsConfig *config_;
     GstDataQueue *queue_;
 
+    /* channel options */
+    gint max_message_size_;
+    guint keepalive_time_;
+    guint keepalive_timeout_;
+    grpc_compression_type compression_;
+    guint num_channels_;
+
     std::unique_ptr<Server> server_instance_;
-    std::unique_ptr<ServerCompletionQueue> completion_queue_;
+
+    /* server completion queues, each is drained by its own thread in cq_workers_ */
+    guint num_cqs_;
+    std::vector<std::unique_ptr<ServerCompletionQueue>> completion_queues_;
+    std::vector<std::thread> cq_workers_;
 
     std::thread worker_;
+    /* the client threads of the other channels (channel pool) */
+    std::vector<std::thread> client_workers_;
 
     void * handle_;
     gboolean stop_;
 
+    void deliver (GstBuffer *buffer);
+    std::shared_ptr<Channel> create_channel (const std::string &address,
+        guint idx);
+    void set_server_options (ServerBuilder &builder);
+    void release_inflight ();
+
   private:
     /** @brief start gRPC server */
     virtual gboolean start_server (std::string address) { return FALSE; }
     /** @brief start gRPC client */
     virtual gboolean start_client (std::string address) { return FALSE; }
+    /** @brief send the response to the stream of the request (bidirectional server only) */
+    virtual gboolean send_response (GstBuffer *buffer) { return FALSE; }
 
     gboolean _start_server ();
     gboolean _start_client ();
@@ -38,7 +38,7 @@ using namespace grpc;
 
 /** @brief Constructor of ServiceImplFlatbuf */
 ServiceImplFlatbuf::ServiceImplFlatbuf (const grpc_config * config)
-  : NNStreamerRPC (config), client_stub_ (nullptr)
+  : NNStreamerRPC (config)
 {
 }
 
@@ -106,25 +106,28 @@ Status ServiceImplFlatbuf::_write_tensors (T writer)
   return Status::OK;
 }
 
-/** @brief convert tensors to buffer */
+/**
+ * @brief convert tensors to buffer
+ * @note The memories reference the slice of the received message without copy.
+ */
 void
 ServiceImplFlatbuf::_get_buffer_from_tensors (Message<Tensors> &msg,
     GstBuffer **buffer)
 {
   const Tensors *tensors = msg.GetRoot ();
   guint num_tensor = tensors->num_tensor ();
+  Slice slice (msg.BorrowSlice (), Slice::ADD_REF);
+  const guint8 *base = GRPC_SLICE_START_PTR (msg.BorrowSlice ());
   GstMemory *memory;
 
   *buffer = gst_buffer_new ();
 
   for (guint i = 0; i < num_tensor; i++) {
     const Tensor * tensor = tensors->tensor ()->Get (i);
-    const void * data = tensor->data ()->data ();
+    const guint8 * data = tensor->data ()->data ();
     gsize size = VectorLength (tensor->data ());
-    gpointer new_data = _g_memdup (data, size);
 
-    memory = gst_memory_new_wrapped ((GstMemoryFlags) 0, new_data, size,
-        0, size, new_data, g_free);
+    memory = slice_to_memory (slice, data - base, size);
     gst_buffer_append_memory (*buffer, memory);
   }
 }
@@ -215,6 +218,8 @@ SyncServiceImplFlatbuf::start_server (std::string address)
   ServerBuilder builder;
   builder.AddListeningPort (address, grpc::InsecureServerCredentials(), &port_);
   builder.RegisterService (this);
+  builder.SetSyncServerOption (ServerBuilder::SyncServerOption::NUM_CQS, num_cqs_);
+  set_server_options (builder);
 
   /* start the server */
   server_instance_ = builder.BuildAndStart ();
@@ -228,24 +233,31 @@ SyncServiceImplFlatbuf::start_server (std::string address)
 gboolean
 SyncServiceImplFlatbuf::start_client (std::string address)
 {
-  /* create a gRPC channel */
-  std::shared_ptr<Channel> channel = grpc::CreateChannel(
-      address, grpc::InsecureChannelCredentials());
-
-  /* connect the server */
-  client_stub_ = TensorService::NewStub (channel);
-  if (client_stub_.get () == nullptr)
-    return FALSE;
+  /**
+   * create the pool of gRPC channels. Each channel has its own connection
+   * and stream, and the streams share the data queue.
+   */
+  for (guint i = 0; i < num_channels_; i++) {
+    std::shared_ptr<Channel> channel = create_channel (address, i);
+
+    /* connect the server */
+    client_stubs_.emplace_back (TensorService::NewStub (channel));
+    if (client_stubs_.back ().get () == nullptr)
+      return FALSE;
+  }
 
-  worker_ = std::thread ([this] { this->_client_thread (); });
+  worker_ = std::thread ([this] { this->_client_thread (0); });
+  for (guint i = 1; i < num_channels_; i++)
+    client_workers_.emplace_back ([this, i] { this->_client_thread (i); });
 
   return TRUE;
 }
 
-/** @brief gRPC client thread */
+/** @brief gRPC client thread of a channel */
 void
-SyncServiceImplFlatbuf::_client_thread ()
+SyncServiceImplFlatbuf::_client_thread (guint idx)
 {
+  TensorService::Stub *client_stub = client_stubs_[idx].get ();
   ClientContext context;
 
   if (direction_ == GRPC_DIRECTION_TENSORS_TO_BUFFER) {
@@ -253,7 +265,7 @@ SyncServiceImplFlatbuf::_client_thread ()
 
     /* initiate the RPC call */
     std::unique_ptr< ClientWriter<Message<Tensors>> > writer(
-        client_stub_->SendTensors (&context, &empty));
+        client_stub->SendTensors (&context, &empty));
 
     _write_tensors (writer.get ());
 
@@ -273,7 +285,7 @@ SyncServiceImplFlatbuf::_client_thread ()
 
     /* initiate the RPC call */
     std::unique_ptr< ClientReader<Message<Tensors>> > reader(
-        client_stub_->RecvTensors (&context, builder.ReleaseMessage <Empty> ()));
+        client_stub->RecvTensors (&context, builder.ReleaseMessage <Empty> ()));
 
     _read_tensors (reader.get ());
 
@@ -285,15 +297,15 @@ SyncServiceImplFlatbuf::_client_thread ()
 
 /** @brief Constructor of AsyncServiceImplFlatbuf */
 AsyncServiceImplFlatbuf::AsyncServiceImplFlatbuf (const grpc_config * config)
-  : ServiceImplFlatbuf (config), last_call_ (nullptr)
+  : ServiceImplFlatbuf (config)
 {
 }
 
 /** @brief Destructor of AsyncServiceImplFlatbuf */
 AsyncServiceImplFlatbuf::~AsyncServiceImplFlatbuf ()
 {
-  if (last_call_)
-    delete last_call_;
+  for (auto call : last_calls_)
+    delete call;
 }
 
 
@@ -305,16 +317,24 @@ AsyncServiceImplFlatbuf::start_server (std::string address)
   ServerBuilder builder;
   builder.AddListeningPort (address, grpc::InsecureServerCredentials(), &port_);
   builder.RegisterService (this);
+  set_server_options (builder);
 
-  /* need to manually handle the completion queue */
-  completion_queue_ = builder.AddCompletionQueue ();
+  /**
+   * need to manually handle the completion queues. Each queue has its own
+   * pending call for new clients, so the streams are spread to the queues
+   * and all events of a stream are handled by the thread of its queue.
+   */
+  for (guint i = 0; i < num_cqs_; i++)
+    completion_queues_.emplace_back (builder.AddCompletionQueue ());
 
   /* start the server */
   server_instance_ = builder.BuildAndStart ();
   if (server_instance_.get () == nullptr)
     return FALSE;
 
-  worker_ = std::thread ([this] { this->_server_thread (); });
+  last_calls_.assign (num_cqs_, nullptr);
+  for (guint i = 0; i < num_cqs_; i++)
+    cq_workers_.emplace_back ([this, i] { this->_server_thread (i); });
 
   return TRUE;
 }
@@ -323,13 +343,12 @@ AsyncServiceImplFlatbuf::start_server (std::string address)
 gboolean
 AsyncServiceImplFlatbuf::start_client (std::string address)
 {
-  /* create a gRPC channel */
-  std::shared_ptr<Channel> channel = grpc::CreateChannel(
-      address, grpc::InsecureChannelCredentials());
+  /* create a gRPC channel, the async client uses a channel */
+  std::shared_ptr<Channel> channel = create_channel (address, 0);
 
   /* connect the server */
-  client_stub_ = TensorService::NewStub (channel);
-  if (client_stub_.get () == nullptr)
+  client_stubs_.emplace_back (TensorService::NewStub (channel));
+  if (client_stubs_.back ().get () == nullptr)
     return FALSE;
 
   worker_ = std::thread ([this] { this->_client_thread (); });
@@ -341,8 +360,10 @@ AsyncServiceImplFlatbuf::start_client (std::string address)
 class AsyncCallDataServer : public AsyncCallData {
   public:
     /** @brief Constructor of AsyncCallDataServer */
-    AsyncCallDataServer (AsyncServiceImplFlatbuf *service, ServerCompletionQueue *cq)
-      : AsyncCallData (service), cq_ (cq), writer_ (nullptr), reader_ (nullptr)
+    AsyncCallDataServer (AsyncServiceImplFlatbuf *service, ServerCompletionQueue *cq,
+        guint cq_idx)
+      : AsyncCallData (service), cq_ (cq), cq_idx_ (cq_idx), writer_ (nullptr),
+        reader_ (nullptr)
     {
       RunState ();
     }
@@ -372,7 +393,8 @@ class AsyncCallDataServer : public AsyncCallData {
       } else if (state_ == PROCESS) {
         if (count_ == 0) {
           /* spawn a new instance to serve new clients */
-          service_->set_last_call (new AsyncCallDataServer (service_, cq_));
+          service_->set_last_call (cq_idx_,
+              new AsyncCallDataServer (service_, cq_, cq_idx_));
         }
 
         if (reader_.get () != nullptr) {
@@ -413,6 +435,7 @@ class AsyncCallDataServer : public AsyncCallData {
 
   private:
     ServerCompletionQueue *cq_;
+    guint cq_idx_;
     ServerContext ctx_;
 
     std::unique_ptr<ServerAsyncWriter<Message<Tensors>>> writer_;
@@ -494,12 +517,14 @@ class AsyncCallDataClient : public AsyncCallData {
     std::unique_ptr<ClientAsyncReader<Message<Tensors>>> reader_;
 };
 
-/** @brief gRPC client thread */
+/** @brief gRPC server thread, polling a completion queue */
 void
-AsyncServiceImplFlatbuf::_server_thread ()
+AsyncServiceImplFlatbuf::_server_thread (guint cq_idx)
 {
+  ServerCompletionQueue *cq = completion_queues_[cq_idx].get ();
+
   /* spawn a new instance to server new clients */
-  set_last_call (new AsyncCallDataServer (this, completion_queue_.get ()));
+  set_last_call (cq_idx, new AsyncCallDataServer (this, cq, cq_idx));
 
   while (1) {
     void *tag;
@@ -510,7 +535,7 @@ AsyncServiceImplFlatbuf::_server_thread ()
       gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
           gpr_time_from_millis(10, GPR_TIMESPAN));
 
-    switch (completion_queue_->AsyncNext (&tag, &ok, deadline)) {
+    switch (cq->AsyncNext (&tag, &ok, deadline)) {
       case CompletionQueue::GOT_EVENT:
         static_cast<AsyncCallDataServer *>(tag)->RunState(ok);
         break;
@@ -529,7 +554,7 @@ AsyncServiceImplFlatbuf::_client_thread ()
   CompletionQueue cq;
 
   /* spawn a new instance to serve new clients */
-  new AsyncCallDataClient (this, client_stub_.get (), &cq);
+  new AsyncCallDataClient (this, client_stubs_[0].get (), &cq);
 
   /* until the stop is called */
   while (!stop_) {
@@ -557,6 +582,11 @@ AsyncServiceImplFlatbuf::_client_thread ()
 extern "C" NNStreamerRPC *
 create_instance (const grpc_config * config)
 {
+  if (config->bidirectional) {
+    ml_loge ("Bidirectional streaming is not supported with flatbuf IDL\n");
+    return NULL;
+  }
+
   if (config->is_blocking)
     return new SyncServiceImplFlatbuf (config);
   else
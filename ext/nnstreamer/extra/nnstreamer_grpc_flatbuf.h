@@ -48,7 +48,8 @@ class ServiceImplFlatbuf : public NNStreamerRPC
     void _get_tensors_from_buffer (GstBuffer *buffer, Message<Tensors> &tensors);
     void _get_buffer_from_tensors (Message<Tensors> &tensors, GstBuffer **buffer);
 
-    std::unique_ptr<nnstreamer::flatbuf::TensorService::Stub> client_stub_;
+    /* the stubs of the client channels, the first one is used by async client */
+    std::vector<std::unique_ptr<nnstreamer::flatbuf::TensorService::Stub>> client_stubs_;
 };
 
 /**
@@ -70,7 +71,7 @@ class SyncServiceImplFlatbuf final
     gboolean start_server (std::string address) override;
     gboolean start_client (std::string address) override;
 
-    void _client_thread ();
+    void _client_thread (guint idx);
 };
 
 class AsyncCallData;
@@ -85,17 +86,19 @@ class AsyncServiceImplFlatbuf final
     AsyncServiceImplFlatbuf (const grpc_config * config);
     ~AsyncServiceImplFlatbuf ();
 
-    /** @brief set the last call data */
-    void set_last_call (AsyncCallData * call) { last_call_ = call; }
+    /** @brief set the last call data of the completion queue */
+    void set_last_call (guint cq_idx, AsyncCallData * call) {
+      last_calls_[cq_idx] = call;
+    }
 
   private:
     gboolean start_server (std::string address) override;
     gboolean start_client (std::string address) override;
 
-    void _server_thread ();
+    void _server_thread (guint cq_idx);
     void _client_thread ();
 
-    AsyncCallData * last_call_;
+    std::vector<AsyncCallData *> last_calls_;
 };
 
 /** @brief Internal base class to serve a request */
@@ -18,6 +18,7 @@
 #include <nnstreamer_plugin_api.h>
 #include <nnstreamer_util.h>
 
+#include <chrono>
 #include <thread>
 
 #include <grpcpp/grpcpp.h>
@@ -30,9 +31,113 @@
 
 using namespace grpc;
 
+/** @brief Release the string having the tensor data wrapped in the memory */
+static void
+_free_tensor_data (gpointer data)
+{
+  delete static_cast<std::string *> (data);
+}
+
+/**
+ * @brief Field tags of nnstreamer.proto, to (de)serialize the tensors
+ *        without copying the tensor data.
+ */
+#define PB_WIRE_VARINT (0)
+#define PB_WIRE_FIXED64 (1)
+#define PB_WIRE_LEN (2)
+#define PB_WIRE_FIXED32 (5)
+#define PB_TAG(field,wire) ((guint64) (((field) << 3) | (wire)))
+
+#define PB_TENSORS_NUM_TENSOR PB_TAG (1, PB_WIRE_VARINT)
+#define PB_TENSORS_FR PB_TAG (2, PB_WIRE_LEN)
+#define PB_TENSORS_TENSOR PB_TAG (3, PB_WIRE_LEN)
+#define PB_FR_RATE_N PB_TAG (1, PB_WIRE_VARINT)
+#define PB_FR_RATE_D PB_TAG (2, PB_WIRE_VARINT)
+#define PB_TENSOR_NAME PB_TAG (1, PB_WIRE_LEN)
+#define PB_TENSOR_TYPE PB_TAG (2, PB_WIRE_VARINT)
+#define PB_TENSOR_DIMENSION PB_TAG (3, PB_WIRE_LEN)
+#define PB_TENSOR_DATA PB_TAG (4, PB_WIRE_LEN)
+
+/** @brief append the value as varint */
+static void
+_pb_append_varint (std::string &out, guint64 value)
+{
+  while (value >= 0x80) {
+    out.push_back ((char) ((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  out.push_back ((char) value);
+}
+
+/** @brief append the length-delimited field */
+static void
+_pb_append_bytes (std::string &out, guint64 tag, const std::string &bytes)
+{
+  _pb_append_varint (out, tag);
+  _pb_append_varint (out, bytes.size ());
+  out += bytes;
+}
+
+/** @brief read the varint */
+static gboolean
+_pb_read_varint (const guint8 **pos, const guint8 *end, guint64 *value)
+{
+  guint64 v = 0;
+  guint shift;
+
+  for (shift = 0; *pos < end && shift < 64; shift += 7) {
+    guint8 b = *(*pos)++;
+
+    v |= ((guint64) (b & 0x7F)) << shift;
+    if (!(b & 0x80)) {
+      *value = v;
+      return TRUE;
+    }
+  }
+
+  return FALSE;
+}
+
+/** @brief read the length of length-delimited field */
+static gboolean
+_pb_read_length (const guint8 **pos, const guint8 *end, guint64 *len)
+{
+  return _pb_read_varint (pos, end, len) && *len <= (guint64) (end - *pos);
+}
+
+/** @brief skip the field of the wire type */
+static gboolean
+_pb_skip_field (const guint8 **pos, const guint8 *end, guint64 tag)
+{
+  guint64 v;
+
+  switch (tag & 0x7) {
+    case PB_WIRE_VARINT:
+      return _pb_read_varint (pos, end, &v);
+    case PB_WIRE_FIXED64:
+      v = 8;
+      break;
+    case PB_WIRE_LEN:
+      if (!_pb_read_varint (pos, end, &v))
+        return FALSE;
+      break;
+    case PB_WIRE_FIXED32:
+      v = 4;
+      break;
+    default:
+      return FALSE;
+  }
+
+  if (v > (guint64) (end - *pos))
+    return FALSE;
+
+  *pos += v;
+  return TRUE;
+}
+
 /** @brief constructor */
 ServiceImplProtobuf::ServiceImplProtobuf (const grpc_config * config):
-  NNStreamerRPC (config), client_stub_ (nullptr)
+  NNStreamerRPC (config)
 {
 }
 
@@ -67,12 +172,48 @@ ServiceImplProtobuf::fill_tensors (Tensors &tensors)
   return TRUE;
 }
 
+/** @brief parse the serialized tensors and deliver the buffer via callback */
+void
+ServiceImplProtobuf::parse_raw_tensors (ByteBuffer &raw)
+{
+  GstBuffer *buffer;
+
+  if (!_get_buffer_from_raw (raw, &buffer))
+    return;
+
+  if (cb_)
+    cb_ (cb_data_, buffer);
+  else
+    gst_buffer_unref (buffer);
+}
+
+/** @brief serialize tensors from the buffer */
+gboolean
+ServiceImplProtobuf::fill_raw_tensors (ByteBuffer &raw)
+{
+  GstDataQueueItem *item;
+  gboolean ret;
+
+  if (!gst_data_queue_pop (queue_, &item))
+    return FALSE;
+
+  ret = _get_raw_from_buffer (GST_BUFFER (item->object), raw);
+
+  GDestroyNotify destroy = (item->destroy) ? item->destroy : g_free;
+  destroy (item);
+
+  return ret;
+}
+
 /** @brief read tensors and invoke the registered callback */
 template <typename T>
 Status ServiceImplProtobuf::_read_tensors (T reader)
 {
+  /* Reuse the message (and its allocations) for all frames */
+  Tensors tensors;
+
   while (1) {
-    Tensors tensors;
+    tensors.Clear ();
 
     if (!reader->Read (&tensors))
       break;
@@ -87,8 +228,11 @@ Status ServiceImplProtobuf::_read_tensors (T reader)
 template <typename T>
 Status ServiceImplProtobuf::_write_tensors (T writer)
 {
+  /* Reuse the message (and its allocations) for all frames */
+  Tensors tensors;
+
   while (1) {
-    Tensors tensors;
+    tensors.Clear ();
 
     /* until flushing */
     if (!fill_tensors (tensors))
@@ -110,14 +254,16 @@ ServiceImplProtobuf::_get_buffer_from_tensors (Tensors &tensors,
 
   *buffer = gst_buffer_new ();
 
-  for (guint i = 0; i < num_tensor; i++) {
-    const Tensor * tensor = &tensors.tensor (i);
-    const void * data = tensor->data ().c_str ();
-    gsize size = tensor->data ().length ();
-    gpointer new_data = _g_memdup (data, size);
+  for (guint i = 0; i < num_tensor && (int) i < tensors.tensor_size (); i++) {
+    /* Move the received data to the memory instead of copying it. */
+    std::string *data = new std::string ();
+    gsize size;
+
+    data->swap (*tensors.mutable_tensor (i)->mutable_data ());
+    size = data->length ();
 
-    memory = gst_memory_new_wrapped ((GstMemoryFlags) 0, new_data, size,
-        0, size, new_data, g_free);
+    memory = gst_memory_new_wrapped ((GstMemoryFlags) 0, (gpointer) data->data (),
+        size, 0, size, data, _free_tensor_data);
     gst_buffer_append_memory (*buffer, memory);
   }
 }
@@ -166,9 +312,141 @@ ServiceImplProtobuf::_get_tensors_from_buffer (GstBuffer *buffer,
   gst_buffer_unmap (buffer, &map);
 }
 
+/**
+ * @brief serialize the buffer to the message Tensors.
+ * @note The headers of the fields are written in small slices, and the tensor
+ *       data is sent from the slices referencing the memories of the buffer.
+ *       The byte buffer is same with the message serialized by protobuf.
+ */
+gboolean
+ServiceImplProtobuf::_get_raw_from_buffer (GstBuffer *buffer, ByteBuffer &raw)
+{
+  std::vector<Slice> data;
+  std::vector<Slice> slices;
+  std::string head, fr;
+  guint i, j;
+
+  if (!buffer_to_slices (buffer, &config_->info, data))
+    return FALSE;
+
+  _pb_append_varint (head, PB_TENSORS_NUM_TENSOR);
+  _pb_append_varint (head, config_->info.num_tensors);
+
+  _pb_append_varint (fr, PB_FR_RATE_N);
+  _pb_append_varint (fr, (guint64) (gint64) config_->rate_n);
+  _pb_append_varint (fr, PB_FR_RATE_D);
+  _pb_append_varint (fr, (guint64) (gint64) config_->rate_d);
+  _pb_append_bytes (head, PB_TENSORS_FR, fr);
+
+  for (i = 0; i < data.size (); i++) {
+    const GstTensorInfo *info = &config_->info.info[i];
+    std::string tensor, dims;
+
+    _pb_append_bytes (tensor, PB_TENSOR_NAME, "Anonymous");
+    _pb_append_varint (tensor, PB_TENSOR_TYPE);
+    _pb_append_varint (tensor, info->type);
+
+    for (j = 0; j < NNS_TENSOR_RANK_LIMIT; j++)
+      _pb_append_varint (dims, info->dimension[j]);
+    _pb_append_bytes (tensor, PB_TENSOR_DIMENSION, dims);
+
+    _pb_append_varint (tensor, PB_TENSOR_DATA);
+    _pb_append_varint (tensor, data[i].size ());
+
+    _pb_append_varint (head, PB_TENSORS_TENSOR);
+    _pb_append_varint (head, tensor.size () + data[i].size ());
+    head += tensor;
+
+    slices.push_back (Slice (head));
+    slices.push_back (data[i]);
+    head.clear ();
+  }
+
+  if (!head.empty ())
+    slices.push_back (Slice (head));
+
+  raw = ByteBuffer (slices.data (), slices.size ());
+  return TRUE;
+}
+
+/**
+ * @brief parse the serialized message Tensors to the buffer.
+ * @note The memories of the buffer reference the received slice.
+ */
+gboolean
+ServiceImplProtobuf::_get_buffer_from_raw (ByteBuffer &raw, GstBuffer **buffer)
+{
+  std::vector<std::pair<gsize, gsize>> data;
+  guint64 num_tensor = 0, tag, len;
+  const guint8 *base, *pos, *end;
+  Slice slice;
+  guint i;
+
+  if (!byte_buffer_to_slice (raw, slice)) {
+    ml_loge ("Failed to get the received message\n");
+    return FALSE;
+  }
+
+  base = pos = slice.begin ();
+  end = slice.end ();
+
+  while (pos < end) {
+    if (!_pb_read_varint (&pos, end, &tag))
+      goto error;
+
+    if (tag == PB_TENSORS_NUM_TENSOR) {
+      if (!_pb_read_varint (&pos, end, &num_tensor))
+        goto error;
+    } else if (tag == PB_TENSORS_TENSOR) {
+      const guint8 *tpos, *tend;
+      std::pair<gsize, gsize> tdata (0, 0);
+
+      if (!_pb_read_length (&pos, end, &len))
+        goto error;
+
+      tpos = pos;
+      tend = pos + len;
+      pos = tend;
+
+      while (tpos < tend) {
+        if (!_pb_read_varint (&tpos, tend, &tag))
+          goto error;
+
+        if (tag == PB_TENSOR_DATA) {
+          if (!_pb_read_length (&tpos, tend, &len))
+            goto error;
+
+          tdata.first = tpos - base;
+          tdata.second = len;
+          tpos += len;
+        } else if (!_pb_skip_field (&tpos, tend, tag)) {
+          goto error;
+        }
+      }
+
+      data.push_back (tdata);
+    } else if (!_pb_skip_field (&pos, end, tag)) {
+      goto error;
+    }
+  }
+
+  *buffer = gst_buffer_new ();
+
+  for (i = 0; i < num_tensor && i < data.size (); i++) {
+    gst_buffer_append_memory (*buffer,
+        slice_to_memory (slice, data[i].first, data[i].second));
+  }
+
+  return TRUE;
+
+error:
+  ml_loge ("Failed to parse the received tensors\n");
+  return FALSE;
+}
+
 /** @brief Constructor of SyncServiceImplProtobuf */
 SyncServiceImplProtobuf::SyncServiceImplProtobuf (const grpc_config * config)
-  : ServiceImplProtobuf (config)
+  : ServiceImplProtobuf (config), next_stream_id_ (1), next_request_id_ (0)
 {
 }
 
@@ -188,6 +466,121 @@ SyncServiceImplProtobuf::RecvTensors (ServerContext *context,
   return _write_tensors (writer);
 }
 
+/**
+ * @brief bidirectional streaming: a client sends requests and receives responses.
+ * @note The request is delivered with the query meta (client_id of the stream
+ *       and request_id given by the client), then the response having the meta
+ *       is written to the stream of the request in send_response ().
+ */
+Status
+SyncServiceImplProtobuf::InferTensors (ServerContext *context,
+    ServerReaderWriter<Tensors, Tensors> *stream)
+{
+  std::shared_ptr<BidiStreamProtobuf> bidi;
+  query_client_id_t id;
+  Tensors tensors;
+
+  if (direction_ != GRPC_DIRECTION_BIDIRECTIONAL)
+    return Status (StatusCode::UNIMPLEMENTED, "Bidirectional streaming is disabled");
+
+  bidi = std::make_shared<BidiStreamProtobuf> ();
+  bidi->stream = stream;
+  bidi->pending = 0;
+
+  {
+    std::lock_guard<std::mutex> lock (streams_lock_);
+
+    id = next_stream_id_++;
+    streams_[id] = bidi;
+  }
+
+  while (!stop_) {
+    GstBuffer *buffer;
+    GstMetaQuery *meta;
+
+    tensors.Clear ();
+
+    if (!stream->Read (&tensors))
+      break;
+
+    _get_buffer_from_tensors (tensors, &buffer);
+
+    meta = gst_buffer_add_meta_query (buffer);
+    if (meta) {
+      meta->client_id = id;
+      meta->request_id = (int64_t) tensors.request_id ();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock (bidi->lock);
+      bidi->pending++;
+    }
+
+    deliver (buffer);
+  }
+
+  /* the client may wait for the responses of the pending requests */
+  {
+    std::unique_lock<std::mutex> lock (bidi->lock);
+
+    while (bidi->pending > 0 && !stop_ && !context->IsCancelled ())
+      bidi->cond.wait_for (lock, std::chrono::milliseconds (10));
+
+    bidi->stream = nullptr;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock (streams_lock_);
+    streams_.erase (id);
+  }
+
+  return Status::OK;
+}
+
+/** @brief write the response to the stream of the request */
+gboolean
+SyncServiceImplProtobuf::send_response (GstBuffer *buffer)
+{
+  std::shared_ptr<BidiStreamProtobuf> bidi;
+  GstMetaQuery *meta;
+  Tensors tensors;
+
+  meta = gst_buffer_get_meta_query (buffer);
+  if (!meta) {
+    ml_logw ("Cannot get the query meta of the response. Drop the buffer.\n");
+    return TRUE;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock (streams_lock_);
+    auto it = streams_.find (meta->client_id);
+
+    if (it != streams_.end ())
+      bidi = it->second;
+  }
+
+  if (!bidi) {
+    ml_logw ("The stream %lld is closed. Drop the response.\n",
+        (long long) meta->client_id);
+    return TRUE;
+  }
+
+  _get_tensors_from_buffer (buffer, tensors);
+  tensors.set_request_id ((guint64) meta->request_id);
+
+  std::lock_guard<std::mutex> lock (bidi->lock);
+
+  if (bidi->stream && !bidi->stream->Write (tensors))
+    ml_logw ("Failed to write the response to the stream %lld.\n",
+        (long long) meta->client_id);
+
+  if (bidi->pending > 0)
+    bidi->pending--;
+  bidi->cond.notify_all ();
+
+  return TRUE;
+}
+
 /** @brief start gRPC server handling protobuf */
 gboolean
 SyncServiceImplProtobuf::start_server (std::string address)
@@ -196,6 +589,8 @@ SyncServiceImplProtobuf::start_server (std::string address)
   ServerBuilder builder;
   builder.AddListeningPort (address, grpc::InsecureServerCredentials(), &port_);
   builder.RegisterService (this);
+  builder.SetSyncServerOption (ServerBuilder::SyncServerOption::NUM_CQS, num_cqs_);
+  set_server_options (builder);
 
   /* start the server */
   server_instance_ = builder.BuildAndStart ();
@@ -209,31 +604,38 @@ SyncServiceImplProtobuf::start_server (std::string address)
 gboolean
 SyncServiceImplProtobuf::start_client (std::string address)
 {
-  /* create a gRPC channel */
-  std::shared_ptr<Channel> channel = grpc::CreateChannel(
-      address, grpc::InsecureChannelCredentials());
-
-  /* connect the server */
-  client_stub_ = TensorService::NewStub (channel);
-  if (client_stub_.get () == nullptr)
-    return FALSE;
+  /**
+   * create the pool of gRPC channels. Each channel has its own connection
+   * and stream, and the streams share the data queue.
+   */
+  for (guint i = 0; i < num_channels_; i++) {
+    std::shared_ptr<Channel> channel = create_channel (address, i);
+
+    /* connect the server */
+    client_stubs_.emplace_back (TensorService::NewStub (channel));
+    if (client_stubs_.back ().get () == nullptr)
+      return FALSE;
+  }
 
-  worker_ = std::thread ([this] { this->_client_thread (); });
+  worker_ = std::thread ([this] { this->_client_thread (0); });
+  for (guint i = 1; i < num_channels_; i++)
+    client_workers_.emplace_back ([this, i] { this->_client_thread (i); });
 
   return TRUE;
 }
 
-/** @brief gRPC client thread */
+/** @brief gRPC client thread of a channel */
 void
-SyncServiceImplProtobuf::_client_thread ()
+SyncServiceImplProtobuf::_client_thread (guint idx)
 {
+  TensorService::Stub *client_stub = client_stubs_[idx].get ();
   ClientContext context;
   Empty empty;
 
   if (direction_ == GRPC_DIRECTION_TENSORS_TO_BUFFER) {
     /* initiate the RPC call */
     std::unique_ptr< ClientWriter<Tensors> > writer(
-        client_stub_->SendTensors (&context, &empty));
+        client_stub->SendTensors (&context, &empty));
 
     _write_tensors (writer.get ());
 
@@ -244,27 +646,94 @@ SyncServiceImplProtobuf::_client_thread ()
 
     /* initiate the RPC call */
     std::unique_ptr< ClientReader<Tensors> > reader(
-        client_stub_->RecvTensors (&context, empty));
+        client_stub->RecvTensors (&context, empty));
 
     _read_tensors (reader.get ());
 
     reader->Finish ();
+  } else if (direction_ == GRPC_DIRECTION_BIDIRECTIONAL) {
+    _bidi_client (client_stub, &context);
   } else {
     g_assert (0); /* internal logic error */
   }
 }
 
+/**
+ * @brief pipeline the requests and responses in a bidirectional stream.
+ * @note The requests are written in this thread and the responses are read in
+ *       another thread. The number of in-flight requests is limited in send ().
+ */
+void
+SyncServiceImplProtobuf::_bidi_client (TensorService::Stub *stub,
+    ClientContext *context)
+{
+  std::unique_ptr< ClientReaderWriter<Tensors, Tensors> > stream (
+      stub->InferTensors (context));
+  Tensors tensors;
+
+  std::thread reader ([this, &stream] {
+    Tensors response;
+
+    while (1) {
+      GstBuffer *buffer;
+      GstMetaQuery *meta;
+
+      response.Clear ();
+
+      if (!stream->Read (&response))
+        break;
+
+      _get_buffer_from_tensors (response, &buffer);
+
+      meta = gst_buffer_add_meta_query (buffer);
+      if (meta)
+        meta->request_id = (int64_t) response.request_id ();
+
+      release_inflight ();
+      deliver (buffer);
+    }
+  });
+
+  while (1) {
+    tensors.Clear ();
+
+    /* until flushing */
+    if (!fill_tensors (tensors))
+      break;
+
+    tensors.set_request_id (next_request_id_++);
+
+    if (!stream->Write (tensors))
+      break;
+  }
+
+  stream->WritesDone ();
+
+  /* wait for the responses of the in-flight requests a while */
+  {
+    std::unique_lock<std::mutex> lock (inflight_lock_);
+
+    inflight_cond_.wait_for (lock, std::chrono::seconds (1),
+        [this] { return inflight_ == 0; });
+  }
+
+  context->TryCancel ();
+  reader.join ();
+
+  stream->Finish ();
+}
+
 /** @brief Constructor of AsyncServiceImplProtobuf */
 AsyncServiceImplProtobuf::AsyncServiceImplProtobuf (const grpc_config * config)
-  : ServiceImplProtobuf (config), last_call_ (nullptr)
+  : ServiceImplProtobuf (config)
 {
 }
 
 /** @brief Destructor of AsyncServiceImplProtobuf */
 AsyncServiceImplProtobuf::~AsyncServiceImplProtobuf ()
 {
-  if (last_call_)
-    delete last_call_;
+  for (auto call : last_calls_)
+    delete call;
 }
 
 /** @brief start gRPC server handling protobuf */
@@ -275,33 +744,99 @@ AsyncServiceImplProtobuf::start_server (std::string address)
   ServerBuilder builder;
   builder.AddListeningPort (address, grpc::InsecureServerCredentials(), &port_);
   builder.RegisterService (this);
+  set_server_options (builder);
 
-  /* need to manually handle the completion queue */
-  completion_queue_ = builder.AddCompletionQueue ();
+  /**
+   * need to manually handle the completion queues. Each queue has its own
+   * pending call for new clients, so the streams are spread to the queues
+   * and all events of a stream are handled by the thread of its queue.
+   */
+  for (guint i = 0; i < num_cqs_; i++)
+    completion_queues_.emplace_back (builder.AddCompletionQueue ());
 
   /* start the server */
   server_instance_ = builder.BuildAndStart ();
   if (server_instance_.get () == nullptr)
     return FALSE;
 
-  worker_ = std::thread ([this] { this->_server_thread (); });
+  last_calls_.assign (num_cqs_, nullptr);
+  for (guint i = 0; i < num_cqs_; i++)
+    cq_workers_.emplace_back ([this, i] { this->_server_thread (i); });
 
   return TRUE;
 }
 
+/**
+ * @brief request a client-to-server stream, reading the serialized message.
+ * @note Same with RequestSendTensors (), but the messages are not parsed by
+ *       protobuf, to wrap the tensor data without copying it.
+ */
+void
+AsyncServiceImplProtobuf::RequestSendTensorsRaw (ServerContext *context,
+    ServerAsyncReader<Empty, ByteBuffer> *reader, ServerCompletionQueue *cq,
+    void *tag)
+{
+  RequestAsyncClientStreaming (0, context, reader, cq, cq, tag);
+}
+
+/**
+ * @brief request a server-to-client stream, writing the serialized message.
+ * @note Same with RequestRecvTensors (), but the messages are serialized in
+ *       this class, to send the tensor data without copying it.
+ */
+void
+AsyncServiceImplProtobuf::RequestRecvTensorsRaw (ServerContext *context,
+    Empty *request, ServerAsyncWriter<ByteBuffer> *writer,
+    ServerCompletionQueue *cq, void *tag)
+{
+  RequestAsyncServerStreaming (1, context, request, writer, cq, cq, tag);
+}
+
+/**
+ * @brief start the client-to-server stream, writing the serialized message.
+ * @note Same with the generated stub (AsyncSendTensors).
+ */
+std::unique_ptr<ClientAsyncWriter<ByteBuffer>>
+AsyncServiceImplProtobuf::AsyncSendTensorsRaw (ClientContext *context,
+    Empty *response, CompletionQueue *cq, void *tag)
+{
+  return std::unique_ptr<ClientAsyncWriter<ByteBuffer>> (
+      internal::ClientAsyncWriterFactory<ByteBuffer>::Create (channel_.get (),
+          cq, *method_send_, context, response, true, tag));
+}
+
+/**
+ * @brief start the server-to-client stream, reading the serialized message.
+ * @note Same with the generated stub (AsyncRecvTensors).
+ */
+std::unique_ptr<ClientAsyncReader<ByteBuffer>>
+AsyncServiceImplProtobuf::AsyncRecvTensorsRaw (ClientContext *context,
+    const Empty &request, CompletionQueue *cq, void *tag)
+{
+  return std::unique_ptr<ClientAsyncReader<ByteBuffer>> (
+      internal::ClientAsyncReaderFactory<ByteBuffer>::Create (channel_.get (),
+          cq, *method_recv_, context, request, true, tag));
+}
+
 /** @brief start gRPC client handling protobuf */
 gboolean
 AsyncServiceImplProtobuf::start_client (std::string address)
 {
-  /* create a gRPC channel */
-  std::shared_ptr<Channel> channel = grpc::CreateChannel(
-      address, grpc::InsecureChannelCredentials());
+  /* create a gRPC channel, the async client uses a channel */
+  channel_ = create_channel (address, 0);
 
   /* connect the server */
-  client_stub_ = TensorService::NewStub (channel);
-  if (client_stub_.get () == nullptr)
+  client_stubs_.emplace_back (TensorService::NewStub (channel_));
+  if (client_stubs_.back ().get () == nullptr)
     return FALSE;
 
+  method_send_.reset (new internal::RpcMethod (
+      "/nnstreamer.protobuf.TensorService/SendTensors",
+      internal::RpcMethod::CLIENT_STREAMING, channel_));
+  method_recv_.reset (new internal::RpcMethod (
+      "/nnstreamer.protobuf.TensorService/RecvTensors",
+      internal::RpcMethod::SERVER_STREAMING, channel_));
+
   worker_ = std::thread ([this] { this->_client_thread (); });
 
   return TRUE;
@@ -311,8 +846,10 @@ AsyncServiceImplProtobuf::start_client (std::string address)
 class AsyncCallDataServer : public AsyncCallData {
   public:
     /** @brief Constructor of AsyncCallDataServer */
-    AsyncCallDataServer (AsyncServiceImplProtobuf *service, ServerCompletionQueue *cq)
-      : AsyncCallData (service), cq_ (cq), writer_ (nullptr), reader_ (nullptr)
+    AsyncCallDataServer (AsyncServiceImplProtobuf *service, ServerCompletionQueue *cq,
+        guint cq_idx)
+      : AsyncCallData (service), cq_ (cq), cq_idx_ (cq_idx), writer_ (nullptr),
+        reader_ (nullptr)
     {
       RunState ();
     }
@@ -323,7 +860,7 @@ class AsyncCallDataServer : public AsyncCallData {
       if (state_ == PROCESS && !ok) {
         if (count_ != 0) {
           if (reader_.get () != nullptr)
-            service_->parse_tensors (rpc_tensors_);
+            service_->parse_raw_tensors (rpc_raw_);
           state_ = FINISH;
         } else {
           return;
@@ -332,29 +869,30 @@ class AsyncCallDataServer : public AsyncCallData {
 
       if (state_ == CREATE) {
         if (service_->getDirection () == GRPC_DIRECTION_BUFFER_TO_TENSORS) {
-          reader_.reset (new ServerAsyncReader<Empty, Tensors> (&ctx_));
-          service_->RequestSendTensors (&ctx_, reader_.get (), cq_, cq_, this);
+          reader_.reset (new ServerAsyncReader<Empty, ByteBuffer> (&ctx_));
+          service_->RequestSendTensorsRaw (&ctx_, reader_.get (), cq_, this);
         } else {
-          writer_.reset (new ServerAsyncWriter<Tensors> (&ctx_));
-          service_->RequestRecvTensors (&ctx_, &rpc_empty_, writer_.get (), cq_, cq_, this);
+          writer_.reset (new ServerAsyncWriter<ByteBuffer> (&ctx_));
+          service_->RequestRecvTensorsRaw (&ctx_, &rpc_empty_, writer_.get (), cq_, this);
         }
         state_ = PROCESS;
       } else if (state_ == PROCESS) {
         if (count_ == 0) {
           /* spawn a new instance to serve new clients */
-          service_->set_last_call (new AsyncCallDataServer (service_, cq_));
+          service_->set_last_call (cq_idx_,
+              new AsyncCallDataServer (service_, cq_, cq_idx_));
         }
 
         if (reader_.get () != nullptr) {
           if (count_ != 0)
-            service_->parse_tensors (rpc_tensors_);
-          reader_->Read (&rpc_tensors_, this);
+            service_->parse_raw_tensors (rpc_raw_);
+          reader_->Read (&rpc_raw_, this);
           /* can't read tensors yet. use the next turn */
           count_++;
         } else if (writer_.get () != nullptr) {
-          Tensors tensors;
-          if (service_->fill_tensors (tensors)) {
-            writer_->Write (tensors, this);
+          ByteBuffer raw;
+          if (service_->fill_raw_tensors (raw)) {
+            writer_->Write (raw, this);
             count_++;
           } else {
             Status status;
@@ -377,19 +915,19 @@ class AsyncCallDataServer : public AsyncCallData {
 
   private:
     ServerCompletionQueue *cq_;
+    guint cq_idx_;
     ServerContext ctx_;
 
-    std::unique_ptr<ServerAsyncWriter<Tensors>> writer_;
-    std::unique_ptr<ServerAsyncReader<Empty, Tensors>> reader_;
+    std::unique_ptr<ServerAsyncWriter<ByteBuffer>> writer_;
+    std::unique_ptr<ServerAsyncReader<Empty, ByteBuffer>> reader_;
 };
 
 /** @brief Internal derived class for client */
 class AsyncCallDataClient : public AsyncCallData {
   public:
     /** @brief Constructor of AsyncCallDataClient */
-    AsyncCallDataClient (AsyncServiceImplProtobuf *service, TensorService::Stub * stub,
-        CompletionQueue *cq)
-      : AsyncCallData (service), stub_ (stub), cq_ (cq), writer_ (nullptr), reader_ (nullptr)
+    AsyncCallDataClient (AsyncServiceImplProtobuf *service, CompletionQueue *cq)
+      : AsyncCallData (service), cq_ (cq), writer_ (nullptr), reader_ (nullptr)
     {
       RunState ();
     }
@@ -400,7 +938,7 @@ class AsyncCallDataClient : public AsyncCallData {
       if (state_ == PROCESS && !ok) {
         if (count_ != 0) {
           if (reader_.get () != nullptr)
-            service_->parse_tensors (rpc_tensors_);
+            service_->parse_raw_tensors (rpc_raw_);
           state_ = FINISH;
         } else {
           return;
@@ -409,22 +947,22 @@ class AsyncCallDataClient : public AsyncCallData {
 
       if (state_ == CREATE) {
         if (service_->getDirection () == GRPC_DIRECTION_BUFFER_TO_TENSORS) {
-          reader_ = stub_->AsyncRecvTensors (&ctx_, rpc_empty_, cq_, this);
+          reader_ = service_->AsyncRecvTensorsRaw (&ctx_, rpc_empty_, cq_, this);
         } else {
-          writer_ = stub_->AsyncSendTensors (&ctx_, &rpc_empty_, cq_, this);
+          writer_ = service_->AsyncSendTensorsRaw (&ctx_, &rpc_empty_, cq_, this);
         }
         state_ = PROCESS;
       } else if (state_ == PROCESS) {
         if (reader_.get () != nullptr) {
           if (count_ != 0)
-            service_->parse_tensors (rpc_tensors_);
-          reader_->Read (&rpc_tensors_, this);
+            service_->parse_raw_tensors (rpc_raw_);
+          reader_->Read (&rpc_raw_, this);
           /* can't read tensors yet. use the next turn */
           count_++;
         } else if (writer_.get () != nullptr) {
-          Tensors tensors;
-          if (service_->fill_tensors (tensors)) {
-            writer_->Write (tensors, this);
+          ByteBuffer raw;
+          if (service_->fill_raw_tensors (raw)) {
+            writer_->Write (raw, this);
             count_++;
           } else {
             writer_->WritesDone (this);
@@ -444,20 +982,21 @@ class AsyncCallDataClient : public AsyncCallData {
     }
 
   private:
-    TensorService::Stub * stub_;
     CompletionQueue * cq_;
     ClientContext ctx_;
 
-    std::unique_ptr<ClientAsyncWriter<Tensors>> writer_;
-    std::unique_ptr<ClientAsyncReader<Tensors>> reader_;
+    std::unique_ptr<ClientAsyncWriter<ByteBuffer>> writer_;
+    std::unique_ptr<ClientAsyncReader<ByteBuffer>> reader_;
 };
 
-/** @brief gRPC client thread */
+/** @brief gRPC server thread, polling a completion queue */
 void
-AsyncServiceImplProtobuf::_server_thread ()
+AsyncServiceImplProtobuf::_server_thread (guint cq_idx)
 {
+  ServerCompletionQueue *cq = completion_queues_[cq_idx].get ();
+
   /* spawn a new instance to server new clients */
-  set_last_call (new AsyncCallDataServer (this, completion_queue_.get ()));
+  set_last_call (cq_idx, new AsyncCallDataServer (this, cq, cq_idx));
 
   while (1) {
     void *tag;
@@ -468,7 +1007,7 @@ AsyncServiceImplProtobuf::_server_thread ()
       gpr_time_add(gpr_now(GPR_CLOCK_MONOTONIC),
           gpr_time_from_millis(10, GPR_TIMESPAN));
 
-    switch (completion_queue_->AsyncNext (&tag, &ok, deadline)) {
+    switch (cq->AsyncNext (&tag, &ok, deadline)) {
       case CompletionQueue::GOT_EVENT:
         static_cast<AsyncCallDataServer *>(tag)->RunState(ok);
         break;
@@ -487,7 +1026,7 @@ AsyncServiceImplProtobuf::_client_thread ()
   CompletionQueue cq;
 
   /* spawn a new instance to serve new clients */
-  new AsyncCallDataClient (this, client_stub_.get (), &cq);
+  new AsyncCallDataClient (this, &cq);
 
   /* until the stop is called */
   while (!stop_) {
@@ -515,7 +1054,8 @@ AsyncServiceImplProtobuf::_client_thread ()
 extern "C" void *
 create_instance (const grpc_config * config)
 {
-  if (config->is_blocking)
+  /* bidirectional streaming is served by the sync service */
+  if (config->is_blocking || config->bidirectional)
     return new SyncServiceImplProtobuf (config);
   else
     return new AsyncServiceImplProtobuf (config);
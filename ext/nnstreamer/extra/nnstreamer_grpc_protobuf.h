@@ -18,6 +18,12 @@
 #include "nnstreamer_grpc_common.h"
 #include "nnstreamer.grpc.pb.h" /* Generated by `protoc` */
 
+#include <tensor_meta.h>
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+
 using nnstreamer::protobuf::TensorService;
 using nnstreamer::protobuf::Tensors;
 using nnstreamer::protobuf::Tensor;
@@ -37,6 +43,9 @@ class ServiceImplProtobuf : public NNStreamerRPC
     void parse_tensors (Tensors &tensors);
     gboolean fill_tensors (Tensors &tensors);
 
+    void parse_raw_tensors (ByteBuffer &raw);
+    gboolean fill_raw_tensors (ByteBuffer &raw);
+
   protected:
     template <typename T>
     grpc::Status _write_tensors (T writer);
@@ -47,7 +56,21 @@ class ServiceImplProtobuf : public NNStreamerRPC
     void _get_tensors_from_buffer (GstBuffer *buffer, Tensors &tensors);
     void _get_buffer_from_tensors (Tensors &tensors, GstBuffer **buffer);
 
-    std::unique_ptr<nnstreamer::protobuf::TensorService::Stub> client_stub_;
+    gboolean _get_raw_from_buffer (GstBuffer *buffer, ByteBuffer &raw);
+    gboolean _get_buffer_from_raw (ByteBuffer &raw, GstBuffer **buffer);
+
+    /* the stubs of the client channels, the first one is used by async client */
+    std::vector<std::unique_ptr<nnstreamer::protobuf::TensorService::Stub>> client_stubs_;
+};
+
+/**
+ * @brief Bidirectional stream of a client, served by the sync server.
+ */
+struct BidiStreamProtobuf {
+  ServerReaderWriter<Tensors, Tensors> *stream; /**< NULL if the stream is closed */
+  guint pending; /**< the number of requests without response */
+  std::mutex lock; /**< to write a message at a time */
+  std::condition_variable cond;
 };
 
 /**
@@ -65,11 +88,24 @@ class SyncServiceImplProtobuf final
     Status RecvTensors (ServerContext *context, const Empty *request,
         ServerWriter<Tensors> *writer) override;
 
+    Status InferTensors (ServerContext *context,
+        ServerReaderWriter<Tensors, Tensors> *stream) override;
+
   private:
     gboolean start_server (std::string address) override;
     gboolean start_client (std::string address) override;
+    gboolean send_response (GstBuffer *buffer) override;
 
-    void _client_thread ();
+    void _client_thread (guint idx);
+    void _bidi_client (TensorService::Stub *stub, ClientContext *context);
+
+    /* the streams of the bidirectional clients, the key is client_id of the query meta */
+    std::mutex streams_lock_;
+    std::unordered_map<query_client_id_t, std::shared_ptr<BidiStreamProtobuf>> streams_;
+    query_client_id_t next_stream_id_;
+
+    /* the sequence number of the requests, shared by the client channels */
+    std::atomic<guint64> next_request_id_;
 };
 
 class AsyncCallData;
@@ -84,17 +120,37 @@ class AsyncServiceImplProtobuf final
     AsyncServiceImplProtobuf (const grpc_config * config);
     ~AsyncServiceImplProtobuf ();
 
-    /** @brief set the last call data */
-    void set_last_call (AsyncCallData * call) { last_call_ = call; }
+    void RequestSendTensorsRaw (ServerContext *context,
+        ServerAsyncReader<Empty, ByteBuffer> *reader, ServerCompletionQueue *cq,
+        void *tag);
+    void RequestRecvTensorsRaw (ServerContext *context, Empty *request,
+        ServerAsyncWriter<ByteBuffer> *writer, ServerCompletionQueue *cq,
+        void *tag);
+
+    std::unique_ptr<ClientAsyncWriter<ByteBuffer>> AsyncSendTensorsRaw (
+        ClientContext *context, Empty *response, CompletionQueue *cq, void *tag);
+    std::unique_ptr<ClientAsyncReader<ByteBuffer>> AsyncRecvTensorsRaw (
+        ClientContext *context, const Empty &request, CompletionQueue *cq,
+        void *tag);
+
+    /** @brief set the last call data of the completion queue */
+    void set_last_call (guint cq_idx, AsyncCallData * call) {
+      last_calls_[cq_idx] = call;
+    }
 
   private:
     gboolean start_server (std::string address) override;
     gboolean start_client (std::string address) override;
 
-    void _server_thread ();
+    void _server_thread (guint cq_idx);
     void _client_thread ();
 
-    AsyncCallData * last_call_;
+    std::vector<AsyncCallData *> last_calls_;
+
+    /* the methods of the client to send and receive the serialized tensors */
+    std::shared_ptr<Channel> channel_;
+    std::unique_ptr<internal::RpcMethod> method_send_;
+    std::unique_ptr<internal::RpcMethod> method_recv_;
 };
 
 /** @brief Internal base class to serve a request */
@@ -119,7 +175,7 @@ class AsyncCallData {
     CallState state_;
     guint count_;
 
-    Tensors rpc_tensors_;
+    ByteBuffer rpc_raw_;
     Empty rpc_empty_;
 };
 
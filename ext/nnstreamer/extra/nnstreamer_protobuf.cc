@@ -24,59 +24,101 @@
  * protobuf-compiler17
  */
 
+#include <google/protobuf/arena.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <nnstreamer_log.h>
 #include <nnstreamer_plugin_api.h>
 #include <nnstreamer_util.h>
 #include "nnstreamer.pb.h" /* Generated by `protoc` */
 #include "nnstreamer_protobuf.h"
 
+using google::protobuf::Arena;
+using google::protobuf::ArenaOptions;
+using google::protobuf::io::ArrayOutputStream;
+using google::protobuf::io::CodedOutputStream;
+
+/**
+ * @brief The size of the initial arena block on the stack.
+ * The messages except the tensor data are allocated in this block.
+ */
+#define PROTOBUF_ARENA_BLOCK_SIZE (4096)
+
+/** @brief Get the tag of a length-delimited field (bytes or message) */
+#define PROTOBUF_LENGTH_DELIMITED_TAG(field) (((guint32) (field) << 3) | 2U)
+
+/** @brief Release the string having the tensor data wrapped in the memory */
+static void
+_protobuf_free_string (gpointer data)
+{
+  delete static_cast<std::string *> (data);
+}
+
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
 GstFlowReturn
 gst_tensor_decoder_protobuf (const GstTensorsConfig *config,
     const GstTensorMemory *input, GstBuffer *outbuf)
 {
+  const guint32 tensor_tag
+      = PROTOBUF_LENGTH_DELIMITED_TAG (nnstreamer::protobuf::Tensors::kTensorFieldNumber);
+  const guint32 data_tag
+      = PROTOBUF_LENGTH_DELIMITED_TAG (nnstreamer::protobuf::Tensor::kDataFieldNumber);
   GstMapInfo out_info;
   GstMemory *out_mem;
   size_t size, outbuf_size;
-  nnstreamer::protobuf::Tensors tensors;
+  size_t body_size[NNS_TENSOR_SIZE_LIMIT];
+  nnstreamer::protobuf::Tensors *tensors;
+  nnstreamer::protobuf::Tensor *tensor[NNS_TENSOR_SIZE_LIMIT];
   nnstreamer::protobuf::Tensors::frame_rate *fr = NULL;
   guint num_tensors;
-  gboolean is_flexible;
+  gboolean is_flexible, written;
   GstTensorMetaInfo meta;
   GstTensorsConfig pbd_config;
+  char arena_block[PROTOBUF_ARENA_BLOCK_SIZE];
+  ArenaOptions arena_options;
 
   if (!config || !input || !outbuf) {
     ml_loge ("NULL parameter is passed to tensor_decoder::protobuf");
     return GST_FLOW_ERROR;
   }
-  gst_tensors_config_copy (&pbd_config, config);
-  is_flexible = gst_tensors_config_is_flexible (&pbd_config);
 
-  num_tensors = pbd_config.info.num_tensors;
+  num_tensors = config->info.num_tensors;
   if (num_tensors <= 0 || num_tensors > NNS_TENSOR_SIZE_LIMIT) {
     ml_loge ("The number of input tenosrs "
              "exceeds more than NNS_TENSOR_SIZE_LIMIT, %s",
         NNS_TENSOR_SIZE_LIMIT_STR);
     return GST_FLOW_ERROR;
   }
-  tensors.set_num_tensor (num_tensors);
 
-  fr = tensors.mutable_fr ();
-  if (!fr) {
-    nns_loge ("Failed to get pointer of tensors / tensordec-protobuf");
-    return GST_FLOW_ERROR;
-  }
+  gst_tensors_config_copy (&pbd_config, config);
+  is_flexible = gst_tensors_config_is_flexible (&pbd_config);
 
+  arena_options.initial_block = arena_block;
+  arena_options.initial_block_size = sizeof (arena_block);
+  Arena arena (arena_options);
+
+  tensors = Arena::CreateMessage<nnstreamer::protobuf::Tensors> (&arena);
+  tensors->set_num_tensor (num_tensors);
+
+  fr = tensors->mutable_fr ();
   fr->set_rate_n (pbd_config.rate_n);
   fr->set_rate_d (pbd_config.rate_d);
 
-  tensors.set_format (
+  tensors->set_format (
       (nnstreamer::protobuf::Tensors::Tensor_format) pbd_config.info.format);
 
+  /**
+   * The tensor data is not copied into the messages.
+   * Each tensor is serialized as the message without data followed by the
+   * data field, which is the same on the wire as the message with the data.
+   */
+  size = tensors->ByteSizeLong ();
+
   for (unsigned int i = 0; i < num_tensors; ++i) {
-    nnstreamer::protobuf::Tensor *tensor = tensors.add_tensor ();
     gchar *name = NULL;
 
+    tensor[i] = Arena::CreateMessage<nnstreamer::protobuf::Tensor> (&arena);
+
     if (is_flexible) {
       gst_tensor_meta_info_parse_header (&meta, input[i].data);
       gst_tensor_meta_info_convert (&meta, &pbd_config.info.info[i]);
@@ -84,22 +126,26 @@ gst_tensor_decoder_protobuf (const GstTensorsConfig *config,
     name = pbd_config.info.info[i].name;
 
     if (name == NULL) {
-      tensor->set_name ("");
+      tensor[i]->set_name ("");
     } else {
-      tensor->set_name (name);
+      tensor[i]->set_name (name);
     }
 
-    tensor->set_type (
+    tensor[i]->set_type (
         (nnstreamer::protobuf::Tensor::Tensor_type) pbd_config.info.info[i].type);
 
     for (int j = 0; j < NNS_TENSOR_RANK_LIMIT; ++j) {
-      tensor->add_dimension (pbd_config.info.info[i].dimension[j]);
+      tensor[i]->add_dimension (pbd_config.info.info[i].dimension[j]);
     }
 
-    tensor->set_data (input[i].data, (int)input[i].size);
+    body_size[i] = tensor[i]->ByteSizeLong ()
+                   + CodedOutputStream::VarintSize32 (data_tag)
+                   + CodedOutputStream::VarintSize64 (input[i].size) + input[i].size;
+    size += CodedOutputStream::VarintSize32 (tensor_tag)
+            + CodedOutputStream::VarintSize64 (body_size[i]) + body_size[i];
   }
 
-  size = tensors.ByteSizeLong ();
+  gst_tensors_config_free (&pbd_config);
   outbuf_size = gst_buffer_get_size (outbuf);
 
   if (outbuf_size == 0) {
@@ -117,10 +163,32 @@ gst_tensor_decoder_protobuf (const GstTensorsConfig *config,
     return GST_FLOW_ERROR;
   }
 
-  tensors.SerializeToArray (out_info.data, size);
+  {
+    ArrayOutputStream array_stream (out_info.data, (int) size);
+    CodedOutputStream stream (&array_stream);
+
+    tensors->SerializeToCodedStream (&stream);
+
+    for (unsigned int i = 0; i < num_tensors; ++i) {
+      stream.WriteVarint32 (tensor_tag);
+      stream.WriteVarint64 (body_size[i]);
+      tensor[i]->SerializeToCodedStream (&stream);
+      stream.WriteVarint32 (data_tag);
+      stream.WriteVarint64 (input[i].size);
+      stream.WriteRaw (input[i].data, (int) input[i].size);
+    }
+
+    written = !stream.HadError ();
+  }
 
   gst_memory_unmap (out_mem, &out_info);
 
+  if (!written) {
+    nns_loge ("Failed to serialize the tensors / tensordec-protobuf");
+    gst_memory_unref (out_mem);
+    return GST_FLOW_ERROR;
+  }
+
   if (outbuf_size == 0)
     gst_buffer_append_memory (outbuf, out_mem);
   else
@@ -133,13 +201,14 @@ gst_tensor_decoder_protobuf (const GstTensorsConfig *config,
 GstBuffer *
 gst_tensor_converter_protobuf (GstBuffer *in_buf, GstTensorsConfig *config, void *priv_data)
 {
-  nnstreamer::protobuf::Tensors tensors;
+  nnstreamer::protobuf::Tensors *tensors;
   nnstreamer::protobuf::Tensors::frame_rate *fr = NULL;
   GstMemory *in_mem, *out_mem;
   GstMapInfo in_info;
   GstBuffer *out_buf;
   gsize mem_size;
-  gpointer mem_data;
+  char arena_block[PROTOBUF_ARENA_BLOCK_SIZE];
+  ArenaOptions arena_options;
   UNUSED (priv_data);
 
   if (!in_buf || !config) {
@@ -154,30 +223,47 @@ gst_tensor_converter_protobuf (GstBuffer *in_buf, GstTensorsConfig *config, void
     return NULL;
   }
 
-  tensors.ParseFromArray (in_info.data, in_info.size);
+  arena_options.initial_block = arena_block;
+  arena_options.initial_block_size = sizeof (arena_block);
+  Arena arena (arena_options);
 
-  config->info.num_tensors = tensors.num_tensor ();
-  config->info.format = (tensor_format) tensors.format ();
-  fr = tensors.mutable_fr ();
+  tensors = Arena::CreateMessage<nnstreamer::protobuf::Tensors> (&arena);
+  tensors->ParseFromArray (in_info.data, in_info.size);
+  gst_memory_unmap (in_mem, &in_info);
+
+  config->info.num_tensors = tensors->num_tensor ();
+  config->info.format = (tensor_format) tensors->format ();
+  fr = tensors->mutable_fr ();
   config->rate_n = fr->rate_n ();
   config->rate_d = fr->rate_d ();
+
+  if (config->info.num_tensors > NNS_TENSOR_SIZE_LIMIT
+      || (int) config->info.num_tensors > tensors->tensor_size ()) {
+    nns_loge ("Invalid number of tensors (%u) / tensor_converter_protobuf",
+        config->info.num_tensors);
+    return NULL;
+  }
+
   out_buf = gst_buffer_new ();
 
   for (guint i = 0; i < config->info.num_tensors; i++) {
-    const nnstreamer::protobuf::Tensor *tensor = &tensors.tensor (i);
-    std::string _name = tensor->name ();
-    const gchar *name = _name.c_str ();
+    nnstreamer::protobuf::Tensor *tensor = tensors->mutable_tensor (i);
+    const std::string &_name = tensor->name ();
+    std::string *data;
 
-    config->info.info[i].name = (name && strlen (name) > 0) ? g_strdup (name) : NULL;
+    config->info.info[i].name = (_name.length () > 0) ? g_strdup (_name.c_str ()) : NULL;
     config->info.info[i].type = (tensor_type)tensor->type ();
     for (guint j = 0; j < NNS_TENSOR_RANK_LIMIT; j++) {
       config->info.info[i].dimension[j] = tensor->dimension (j);
     }
-    mem_size = tensor->data ().length ();
-    mem_data = _g_memdup (tensor->data ().c_str (), mem_size);
 
-    out_mem = gst_memory_new_wrapped ((GstMemoryFlags) 0, mem_data, mem_size,
-        0, mem_size, NULL, NULL);
+    /* Move the parsed data to the memory instead of copying it. */
+    data = new std::string ();
+    data->swap (*tensor->mutable_data ());
+    mem_size = data->length ();
+
+    out_mem = gst_memory_new_wrapped ((GstMemoryFlags) 0, (gpointer) data->data (),
+        mem_size, 0, mem_size, data, _protobuf_free_string);
 
     gst_buffer_append_memory (out_buf, out_mem);
   }
@@ -185,7 +271,6 @@ gst_tensor_converter_protobuf (GstBuffer *in_buf, GstTensorsConfig *config, void
   /** copy timestamps */
   gst_buffer_copy_into (
       out_buf, in_buf, (GstBufferCopyFlags)GST_BUFFER_COPY_METADATA, 0, -1);
-  gst_memory_unmap (in_mem, &in_info);
 
   return out_buf;
 }
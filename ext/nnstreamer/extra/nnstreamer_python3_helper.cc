@@ -527,3 +527,113 @@ PyTensorShape_New (PyObject * shape_cls, const GstTensorInfo *info)
   return PyObject_CallObject (shape_cls, args);
   /* Its value is checked by setInputTensorDim */
 }
+
+/**
+ * @brief	initialize the persistent arrays
+ * @param views : the persistent arrays
+ */
+void
+PyTensorViews_Init (PyTensorViews *views)
+{
+  views->list = nullptr;
+  for (int i = 0; i < NNS_TENSOR_SIZE_LIMIT; i++)
+    views->arrays[i] = nullptr;
+}
+
+/**
+ * @brief	release the persistent arrays
+ * @param views : the persistent arrays
+ * @note	the caller should hold the GIL
+ */
+void
+PyTensorViews_Clear (PyTensorViews *views)
+{
+  Py_SAFEDECREF (views->list);
+  for (int i = 0; i < NNS_TENSOR_SIZE_LIMIT; i++)
+    Py_SAFEDECREF (views->arrays[i]);
+}
+
+/**
+ * @brief	get the list of the arrays for this frame
+ * @param views : the persistent arrays
+ * @param num : the number of the arrays in the list
+ * @return the list (borrowed reference), nullptr if error
+ * @note	the list is reused if the script did not keep or change it.
+ *        Set all the arrays with PyTensorViews_Set () before using the list.
+ */
+PyObject *
+PyTensorViews_Prepare (PyTensorViews *views, unsigned int num)
+{
+  if (num > NNS_TENSOR_SIZE_LIMIT)
+    return nullptr;
+
+  if (views->list && Py_REFCNT (views->list) == 1
+      && PyList_GET_SIZE (views->list) == (Py_ssize_t) num) {
+    unsigned int i;
+
+    for (i = 0; i < num; i++) {
+      if (PyList_GET_ITEM (views->list, i) != views->arrays[i])
+        break;
+    }
+
+    if (i == num)
+      return views->list;
+  }
+
+  Py_SAFEDECREF (views->list);
+  views->list = PyList_New (num);
+  return views->list;
+}
+
+/**
+ * @brief	rebind the idx-th array to the tensor memory
+ * @param views : the persistent arrays
+ * @param idx : the index of the array in the list
+ * @param type : the tensor type
+ * @param data : the tensor memory
+ * @param size : the size of the tensor memory
+ * @return 0 if OK, -1 if error
+ * @note	a new array is created only if the previous one is still referred by
+ *        the script, its shape, type or flags are changed, or the memory is not aligned.
+ */
+int
+PyTensorViews_Set (PyTensorViews *views, unsigned int idx, tensor_type type,
+    void *data, size_t size)
+{
+  PyArrayObject *array = (PyArrayObject *) views->arrays[idx];
+  NPY_TYPES np_type = getNumpyType (type);
+  npy_intp dims[] = { (npy_intp) (size / gst_tensor_get_element_size (type)) };
+  Py_ssize_t refs = 1;
+
+  if (views->list == nullptr || idx >= (unsigned int) PyList_GET_SIZE (views->list))
+    return -1;
+
+  if (array && PyList_GET_ITEM (views->list, idx) == (PyObject *) array)
+    refs = 2;
+
+  if (array && Py_REFCNT (array) == refs && PyArray_NDIM (array) == 1
+      && PyArray_DIM (array, 0) == dims[0] && PyArray_TYPE (array) == np_type
+      && PyArray_BASE (array) == nullptr
+      && ((guintptr) data) % gst_tensor_get_element_size (type) == 0
+      && PyArray_CHKFLAGS (array, NPY_ARRAY_CARRAY)) {
+    ((PyArrayObject_fields *) array)->data = (char *) data;
+  } else {
+    _import_array (); /** for numpy */
+
+    Py_SAFEDECREF (views->arrays[idx]);
+    views->arrays[idx] = PyArray_SimpleNewFromData (1, dims, np_type, data);
+    if (views->arrays[idx] == nullptr) {
+      Py_ERRMSG ("Failed to create the array over the tensor memory %u", idx);
+      return -1;
+    }
+    refs = 1;
+  }
+
+  if (refs == 1) {
+    /** the list steals the reference */
+    Py_XINCREF (views->arrays[idx]);
+    PyList_SetItem (views->list, idx, views->arrays[idx]);
+  }
+
+  return 0;
+}
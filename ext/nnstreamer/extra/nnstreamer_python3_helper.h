@@ -53,6 +53,17 @@
 #define PyEval_InitThreads_IfGood()     do { PyEval_InitThreads(); } while (0)
 #endif
 
+/**
+ * @brief Persistent 1-D numpy arrays over the tensor memories and the list of them.
+ *        The arrays are rebound to the memories of each frame instead of being
+ *        created again, unless the script keeps a reference to them.
+ */
+typedef struct
+{
+  PyObject *list; /**< the list of the arrays given to the script */
+  PyObject *arrays[NNS_TENSOR_SIZE_LIMIT]; /**< the arrays over the tensor memories */
+} PyTensorViews;
+
 extern tensor_type getTensorType (NPY_TYPES npyType);
 extern NPY_TYPES getNumpyType (tensor_type tType);
 extern int loadScript (PyObject **core_obj, const gchar *module_name, const gchar *class_name);
@@ -60,5 +71,9 @@ extern int openPythonLib (void **handle);
 extern int addToSysPath (const gchar *path);
 extern int parseTensorsInfo (PyObject *result, GstTensorsInfo *info);
 extern PyObject * PyTensorShape_New (PyObject * shape_cls, const GstTensorInfo *info);
+extern void PyTensorViews_Init (PyTensorViews *views);
+extern void PyTensorViews_Clear (PyTensorViews *views);
+extern PyObject * PyTensorViews_Prepare (PyTensorViews *views, unsigned int num);
+extern int PyTensorViews_Set (PyTensorViews *views, unsigned int idx, tensor_type type, void *data, size_t size);
 
 #endif /* __NNS_PYTHON_HELPER_H__ */
@@ -0,0 +1,764 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	tensor_converter_audio_feature.c
+ * @date	14 Oct 2026
+ * @brief	NNStreamer tensor-converter subplugin, "audio_feature",
+ *		which converts interleaved S16 audio to the planar float32 samples or the log-mel / MFCC features.
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ */
+/**
+ * SECTION:tensor_converter::audio_feature
+ *
+ * tensor_converter::audio_feature converts audio/x-raw (S16LE, interleaved)
+ * to the tensors with mode=custom-script:audio_feature:<option>.
+ * The option is a comma-separated list of key=value.
+ *
+ * - rate, channels: The format of the incoming audio, same as the caps (default: 16000, 1).
+ * - feature: raw (default), logmel or mfcc.
+ * - frames: The frames in a tensor, the samples with raw and the STFT frames with logmel and mfcc.
+ *   The tensor is pushed when the frames are ready, regardless of the incoming buffer size.
+ *   With raw, 0 (default) converts each incoming buffer to a tensor.
+ * - n-fft: The size of the FFT and the window, a power of 2 (default: 512).
+ * - hop: The samples between the STFT frames, not larger than n-fft (default: n-fft / 2).
+ * - n-mels: The mel bands (default: 40).
+ * - n-mfcc: The MFCC coefficients (default: 13).
+ * - fmin, fmax: The frequency range of the mel filterbank (default: 0 and rate / 2).
+ *
+ * The tensor dimension is frames:channels with raw (each channel is contiguous),
+ * and n-mels:frames:channels or n-mfcc:frames:channels with the features.
+ *
+ * The FFT is planned (the bit-reversal order, the twiddles, the window, the mel filterbank
+ * and the DCT) when the subplugin is opened, and the real signal of n-fft is transformed
+ * with a complex FFT of n-fft / 2.
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+#include <glib.h>
+#include <gst/gst.h>
+#include <nnstreamer_log.h>
+#include <nnstreamer_plugin_api.h>
+#include <nnstreamer_plugin_api_converter.h>
+#include <nnstreamer_util.h>
+#include <tensor_kernels.h>
+
+void init_afc (void) __attribute__ ((constructor));
+void fini_afc (void) __attribute__ ((destructor));
+
+/**
+ * @brief The floor of the mel energy before the logarithm.
+ */
+#define AF_LOG_FLOOR (1e-10f)
+
+/**
+ * @brief The features of the subplugin.
+ */
+typedef enum
+{
+  AF_FEATURE_RAW = 0,
+  AF_FEATURE_LOGMEL,
+  AF_FEATURE_MFCC,
+} af_feature_e;
+
+/**
+ * @brief The private data of the subplugin, the options and the FFT plan.
+ */
+typedef struct
+{
+  af_feature_e feature; /**< the output feature */
+  guint rate; /**< the sample rate */
+  guint channels; /**< the number of the channels */
+  guint frames; /**< the frames in a tensor */
+  guint n_fft; /**< the size of the FFT */
+  guint hop; /**< the samples between the STFT frames */
+  guint n_mels; /**< the mel bands */
+  guint n_mfcc; /**< the MFCC coefficients */
+  gfloat fmin; /**< the lowest frequency of the filterbank */
+  gfloat fmax; /**< the highest frequency of the filterbank */
+
+  gsize tensor_len; /**< the values in a tensor */
+  guint *bitrev; /**< the bit-reversal order of the complex FFT (n_fft / 2) */
+  gfloat *twiddle; /**< cos and sin of -2 * pi * k / n_fft (k < n_fft / 2) */
+  gfloat *window; /**< the periodic hann window (n_fft) */
+  gfloat *mel; /**< the weights of the mel filterbank (n_mels x bins) */
+  guint *mel_start; /**< the first non-zero bin of the mel band */
+  guint *mel_end; /**< the bin after the last non-zero bin of the mel band */
+  gfloat *dct; /**< the orthonormal DCT-II matrix (n_mfcc x n_mels) */
+
+  gfloat *pcm; /**< the planar samples not consumed yet (channels x pcm_cap) */
+  gsize pcm_len; /**< the frames in pcm */
+  gsize pcm_cap; /**< the frames allocated for a channel in pcm */
+  gfloat *fft; /**< the complex FFT buffer (n_fft) */
+  gfloat *power; /**< the power spectrum (bins) */
+  gfloat *logmel; /**< the log-mel energy (n_mels) */
+  gfloat *pending; /**< the tensor being filled */
+  guint pending_frames; /**< the frames in pending */
+} af_priv_s;
+
+/**
+ * @brief Parse the unsigned integer option.
+ */
+static gboolean
+_af_parse_uint (const gchar * str, guint min, guint * value)
+{
+  gchar *end;
+  guint64 val = g_ascii_strtoull (str, &end, 10);
+
+  if (end == str || *end != '\0' || val < min || val > G_MAXINT)
+    return FALSE;
+
+  *value = (guint) val;
+  return TRUE;
+}
+
+/**
+ * @brief Parse the frequency option.
+ */
+static gboolean
+_af_parse_freq (const gchar * str, gfloat * value)
+{
+  gchar *end;
+  gdouble val = g_ascii_strtod (str, &end);
+
+  if (end == str || *end != '\0' || !(val >= 0.0))
+    return FALSE;
+
+  *value = (gfloat) val;
+  return TRUE;
+}
+
+/**
+ * @brief Parse the option string of the subplugin.
+ */
+static gboolean
+_af_parse_option (af_priv_s * af, const gchar * option)
+{
+  gchar **options, **kv;
+  guint i, num;
+  gboolean ret = TRUE;
+
+  af->feature = AF_FEATURE_RAW;
+  af->rate = 16000;
+  af->channels = 1;
+  af->frames = 0;
+  af->n_fft = 512;
+  af->hop = 0;
+  af->n_mels = 40;
+  af->n_mfcc = 13;
+  af->fmin = 0.0f;
+  af->fmax = 0.0f;
+
+  if (!option || option[0] == '\0')
+    return TRUE;
+
+  options = g_strsplit (option, ",", -1);
+  num = g_strv_length (options);
+
+  for (i = 0; i < num && ret; i++) {
+    kv = g_strsplit (g_strstrip (options[i]), "=", 2);
+
+    if (g_strv_length (kv) != 2) {
+      nns_loge ("Invalid audio_feature option '%s', use key=value.",
+          options[i]);
+      ret = FALSE;
+    } else if (g_ascii_strcasecmp (kv[0], "feature") == 0) {
+      if (g_ascii_strcasecmp (kv[1], "raw") == 0)
+        af->feature = AF_FEATURE_RAW;
+      else if (g_ascii_strcasecmp (kv[1], "logmel") == 0)
+        af->feature = AF_FEATURE_LOGMEL;
+      else if (g_ascii_strcasecmp (kv[1], "mfcc") == 0)
+        af->feature = AF_FEATURE_MFCC;
+      else
+        ret = FALSE;
+    } else if (g_ascii_strcasecmp (kv[0], "rate") == 0) {
+      ret = _af_parse_uint (kv[1], 1, &af->rate);
+    } else if (g_ascii_strcasecmp (kv[0], "channels") == 0) {
+      ret = _af_parse_uint (kv[1], 1, &af->channels);
+    } else if (g_ascii_strcasecmp (kv[0], "frames") == 0) {
+      ret = _af_parse_uint (kv[1], 0, &af->frames);
+    } else if (g_ascii_strcasecmp (kv[0], "n-fft") == 0) {
+      ret = _af_parse_uint (kv[1], 4, &af->n_fft) &&
+          (af->n_fft & (af->n_fft - 1)) == 0;
+    } else if (g_ascii_strcasecmp (kv[0], "hop") == 0) {
+      ret = _af_parse_uint (kv[1], 1, &af->hop);
+    } else if (g_ascii_strcasecmp (kv[0], "n-mels") == 0) {
+      ret = _af_parse_uint (kv[1], 1, &af->n_mels);
+    } else if (g_ascii_strcasecmp (kv[0], "n-mfcc") == 0) {
+      ret = _af_parse_uint (kv[1], 1, &af->n_mfcc);
+    } else if (g_ascii_strcasecmp (kv[0], "fmin") == 0) {
+      ret = _af_parse_freq (kv[1], &af->fmin);
+    } else if (g_ascii_strcasecmp (kv[0], "fmax") == 0) {
+      ret = _af_parse_freq (kv[1], &af->fmax);
+    } else {
+      nns_loge ("Unknown audio_feature option '%s'.", kv[0]);
+      ret = FALSE;
+    }
+
+    if (!ret)
+      nns_loge ("Invalid audio_feature option '%s'.", options[i]);
+    g_strfreev (kv);
+  }
+
+  g_strfreev (options);
+  if (!ret)
+    return FALSE;
+
+  if (af->feature != AF_FEATURE_RAW) {
+    if (af->frames == 0)
+      af->frames = 1;
+    if (af->hop == 0)
+      af->hop = af->n_fft / 2;
+    if (af->fmax == 0.0f)
+      af->fmax = af->rate / 2.0f;
+
+    if (af->hop > af->n_fft) {
+      nns_loge ("The hop (%u) should not exceed n-fft (%u).", af->hop,
+          af->n_fft);
+      return FALSE;
+    }
+
+    if (af->fmin >= af->fmax || af->fmax > af->rate / 2.0f) {
+      nns_loge ("Invalid frequency range of the mel filterbank (%g - %g Hz).",
+          af->fmin, af->fmax);
+      return FALSE;
+    }
+
+    if (af->feature == AF_FEATURE_MFCC && af->n_mfcc > af->n_mels) {
+      nns_loge ("The MFCC coefficients (%u) should not exceed the mel bands (%u).",
+          af->n_mfcc, af->n_mels);
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Mel scale of the frequency (HTK).
+ */
+static gdouble
+_af_hz_to_mel (gdouble hz)
+{
+  return 2595.0 * log10 (1.0 + hz / 700.0);
+}
+
+/**
+ * @brief Frequency of the mel scale (HTK).
+ */
+static gdouble
+_af_mel_to_hz (gdouble mel)
+{
+  return 700.0 * (pow (10.0, mel / 2595.0) - 1.0);
+}
+
+/**
+ * @brief Plan the FFT, the window, the mel filterbank and the DCT.
+ */
+static void
+_af_plan (af_priv_s * af)
+{
+  const guint half = af->n_fft / 2;
+  const guint bins = half + 1;
+  guint i, j, bits = 0;
+  gdouble mel_lo, mel_hi;
+
+  while ((1U << bits) < half)
+    bits++;
+
+  af->bitrev = g_new (guint, half);
+  for (i = 0; i < half; i++) {
+    guint r = 0;
+
+    for (j = 0; j < bits; j++)
+      r |= ((i >> j) & 1U) << (bits - 1 - j);
+    af->bitrev[i] = r;
+  }
+
+  af->twiddle = g_new (gfloat, 2 * half);
+  for (i = 0; i < half; i++) {
+    gdouble a = -2.0 * G_PI * i / af->n_fft;
+
+    af->twiddle[2 * i] = (gfloat) cos (a);
+    af->twiddle[2 * i + 1] = (gfloat) sin (a);
+  }
+
+  af->window = g_new (gfloat, af->n_fft);
+  for (i = 0; i < af->n_fft; i++)
+    af->window[i] = (gfloat) (0.5 - 0.5 * cos (2.0 * G_PI * i / af->n_fft));
+
+  /* the triangular filters on the mel scale, the edges at n_mels + 2 points */
+  af->mel = g_new0 (gfloat, (gsize) af->n_mels * bins);
+  af->mel_start = g_new0 (guint, af->n_mels);
+  af->mel_end = g_new0 (guint, af->n_mels);
+  mel_lo = _af_hz_to_mel (af->fmin);
+  mel_hi = _af_hz_to_mel (af->fmax);
+
+  for (i = 0; i < af->n_mels; i++) {
+    gdouble lo = _af_mel_to_hz (mel_lo + (mel_hi - mel_lo) * i /
+        (af->n_mels + 1));
+    gdouble mid = _af_mel_to_hz (mel_lo + (mel_hi - mel_lo) * (i + 1) /
+        (af->n_mels + 1));
+    gdouble hi = _af_mel_to_hz (mel_lo + (mel_hi - mel_lo) * (i + 2) /
+        (af->n_mels + 1));
+    gfloat *w = af->mel + (gsize) i * bins;
+
+    af->mel_start[i] = bins;
+    for (j = 0; j < bins; j++) {
+      gdouble f = (gdouble) j * af->rate / af->n_fft;
+      gdouble v = 0.0;
+
+      if (f > lo && f < mid)
+        v = (f - lo) / (mid - lo);
+      else if (f >= mid && f < hi)
+        v = (hi - f) / (hi - mid);
+
+      if (v > 0.0) {
+        w[j] = (gfloat) v;
+        af->mel_start[i] = MIN (af->mel_start[i], j);
+        af->mel_end[i] = j + 1;
+      }
+    }
+
+    if (af->mel_start[i] >= af->mel_end[i])
+      nns_logw ("The mel band %u has no FFT bin, increase n-fft or decrease n-mels.",
+          i);
+  }
+
+  if (af->feature == AF_FEATURE_MFCC) {
+    af->dct = g_new (gfloat, (gsize) af->n_mfcc * af->n_mels);
+    for (i = 0; i < af->n_mfcc; i++) {
+      gdouble norm = sqrt (((i == 0) ? 1.0 : 2.0) / af->n_mels);
+
+      for (j = 0; j < af->n_mels; j++)
+        af->dct[i * af->n_mels + j] = (gfloat) (norm *
+            cos (G_PI * i * (j + 0.5) / af->n_mels));
+    }
+  }
+
+  af->fft = g_new (gfloat, af->n_fft);
+  af->power = g_new (gfloat, bins);
+  af->logmel = g_new (gfloat, af->n_mels);
+}
+
+/**
+ * @brief Free the private data.
+ */
+static void
+_af_free (af_priv_s * af)
+{
+  g_free (af->bitrev);
+  g_free (af->twiddle);
+  g_free (af->window);
+  g_free (af->mel);
+  g_free (af->mel_start);
+  g_free (af->mel_end);
+  g_free (af->dct);
+  g_free (af->pcm);
+  g_free (af->fft);
+  g_free (af->power);
+  g_free (af->logmel);
+  g_free (af->pending);
+  g_free (af);
+}
+
+/**
+ * @brief In-place radix-2 complex FFT of n_fft / 2 points (interleaved re and im).
+ */
+static void
+_af_fft (const af_priv_s * af, gfloat * x)
+{
+  const guint n = af->n_fft / 2;
+  guint i, len, k;
+
+  for (i = 0; i < n; i++) {
+    guint r = af->bitrev[i];
+
+    if (r > i) {
+      gfloat t = x[2 * i];
+
+      x[2 * i] = x[2 * r];
+      x[2 * r] = t;
+      t = x[2 * i + 1];
+      x[2 * i + 1] = x[2 * r + 1];
+      x[2 * r + 1] = t;
+    }
+  }
+
+  for (len = 2; len <= n; len <<= 1) {
+    /* the twiddle of n_fft / 2 points is every second one of n_fft */
+    const guint step = 2 * (n / len);
+
+    for (i = 0; i < n; i += len) {
+      for (k = 0; k < len / 2; k++) {
+        const gfloat wr = af->twiddle[2 * k * step];
+        const gfloat wi = af->twiddle[2 * k * step + 1];
+        gfloat *a = x + 2 * (i + k);
+        gfloat *b = x + 2 * (i + k + len / 2);
+        gfloat tr = b[0] * wr - b[1] * wi;
+        gfloat ti = b[0] * wi + b[1] * wr;
+
+        b[0] = a[0] - tr;
+        b[1] = a[1] - ti;
+        a[0] += tr;
+        a[1] += ti;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Compute the features of a STFT frame of the channel.
+ */
+static void
+_af_feature_frame (af_priv_s * af, const gfloat * pcm, gfloat * out)
+{
+  const guint half = af->n_fft / 2;
+  const guint bins = half + 1;
+  gfloat *z = af->fft;
+  guint i, j;
+
+  /* the real signal of n_fft as the complex signal of n_fft / 2 */
+  for (i = 0; i < af->n_fft; i++)
+    z[i] = pcm[i] * af->window[i];
+
+  _af_fft (af, z);
+
+  /* split the spectrum of the even and odd samples */
+  af->power[0] = (z[0] + z[1]) * (z[0] + z[1]);
+  af->power[half] = (z[0] - z[1]) * (z[0] - z[1]);
+  for (i = 1; i < half; i++) {
+    const gfloat *a = z + 2 * i;
+    const gfloat *b = z + 2 * (half - i);
+    const gfloat wr = af->twiddle[2 * i];
+    const gfloat wi = af->twiddle[2 * i + 1];
+    gfloat er = 0.5f * (a[0] + b[0]);
+    gfloat ei = 0.5f * (a[1] - b[1]);
+    gfloat odr = 0.5f * (a[1] + b[1]);
+    gfloat odi = -0.5f * (a[0] - b[0]);
+    gfloat re = er + wr * odr - wi * odi;
+    gfloat im = ei + wr * odi + wi * odr;
+
+    af->power[i] = re * re + im * im;
+  }
+
+  for (i = 0; i < af->n_mels; i++) {
+    const gfloat *w = af->mel + (gsize) i * bins;
+    gfloat e = 0.0f;
+
+    for (j = af->mel_start[i]; j < af->mel_end[i]; j++)
+      e += w[j] * af->power[j];
+    af->logmel[i] = logf (MAX (e, AF_LOG_FLOOR));
+  }
+
+  if (af->feature == AF_FEATURE_LOGMEL) {
+    memcpy (out, af->logmel, sizeof (gfloat) * af->n_mels);
+    return;
+  }
+
+  for (i = 0; i < af->n_mfcc; i++) {
+    const gfloat *d = af->dct + (gsize) i * af->n_mels;
+    gfloat c = 0.0f;
+
+    for (j = 0; j < af->n_mels; j++)
+      c += d[j] * af->logmel[j];
+    out[i] = c;
+  }
+}
+
+/**
+ * @brief Append the incoming samples to the planar samples not consumed yet.
+ */
+static void
+_af_push_samples (af_priv_s * af, const gint16 * src, gsize frames)
+{
+  const GstTensorKernels *kernels = gst_tensor_kernels_get ();
+  guint c;
+
+  if (af->pcm_len + frames > af->pcm_cap) {
+    gsize cap = MAX (af->pcm_cap * 2, af->pcm_len + frames);
+    gfloat *pcm = g_new (gfloat, cap * af->channels);
+
+    for (c = 0; c < af->channels; c++)
+      memcpy (pcm + c * cap, af->pcm + c * af->pcm_cap,
+          sizeof (gfloat) * af->pcm_len);
+
+    g_free (af->pcm);
+    af->pcm = pcm;
+    af->pcm_cap = cap;
+  }
+
+  kernels->s16_deinterleave_f32 (src, af->pcm + af->pcm_len, frames,
+      af->channels, af->pcm_cap);
+  af->pcm_len += frames;
+}
+
+/**
+ * @brief Drop the consumed samples.
+ */
+static void
+_af_pop_samples (af_priv_s * af, gsize frames)
+{
+  guint c;
+
+  if (frames == 0)
+    return;
+
+  af->pcm_len -= frames;
+  for (c = 0; c < af->channels; c++)
+    memmove (af->pcm + c * af->pcm_cap, af->pcm + c * af->pcm_cap + frames,
+        sizeof (gfloat) * af->pcm_len);
+}
+
+/**
+ * @brief Convert the samples in pcm to the tensors.
+ * @return The number of the tensors written to out.
+ */
+static gsize
+_af_convert_samples (af_priv_s * af, gfloat * out)
+{
+  gsize n = 0, pos = 0;
+  guint c;
+
+  if (af->feature == AF_FEATURE_RAW) {
+    for (; pos + af->frames <= af->pcm_len; pos += af->frames, n++) {
+      for (c = 0; c < af->channels; c++)
+        memcpy (out + (n * af->channels + c) * af->frames,
+            af->pcm + c * af->pcm_cap + pos, sizeof (gfloat) * af->frames);
+    }
+
+    _af_pop_samples (af, pos);
+    return n;
+  }
+
+  for (; pos + af->n_fft <= af->pcm_len; pos += af->hop) {
+    const gsize feat = af->tensor_len / ((gsize) af->frames * af->channels);
+
+    for (c = 0; c < af->channels; c++)
+      _af_feature_frame (af, af->pcm + c * af->pcm_cap + pos,
+          af->pending + ((gsize) c * af->frames + af->pending_frames) * feat);
+
+    if (++af->pending_frames == af->frames) {
+      memcpy (out + n * af->tensor_len, af->pending,
+          sizeof (gfloat) * af->tensor_len);
+      af->pending_frames = 0;
+      n++;
+    }
+  }
+
+  _af_pop_samples (af, pos);
+  return n;
+}
+
+/**
+ * @brief Count the tensors to be ready after the incoming frames are appended.
+ */
+static gsize
+_af_count_tensors (const af_priv_s * af, gsize frames)
+{
+  gsize len = af->pcm_len + frames;
+
+  if (af->feature == AF_FEATURE_RAW)
+    return len / af->frames;
+
+  if (len < af->n_fft)
+    return 0;
+
+  return (af->pending_frames + (len - af->n_fft) / af->hop + 1) / af->frames;
+}
+
+/** @brief tensor converter plugin's NNStreamerExternalConverter callback */
+static GstCaps *
+afc_query_caps (const GstTensorsConfig * config)
+{
+  UNUSED (config);
+  return gst_caps_from_string ("audio/x-raw,format=S16LE,layout=interleaved");
+}
+
+/** @brief tensor converter plugin's NNStreamerExternalConverter callback */
+static gboolean
+afc_get_out_config (const GstCaps * in_cap, GstTensorsConfig * config)
+{
+  GstStructure *structure;
+  gint rate = 0, channels = 1;
+
+  g_return_val_if_fail (config != NULL, FALSE);
+  gst_tensors_config_init (config);
+  g_return_val_if_fail (in_cap != NULL, FALSE);
+
+  structure = gst_caps_get_structure (in_cap, 0);
+  g_return_val_if_fail (structure != NULL, FALSE);
+
+  if (!gst_structure_has_name (structure, "audio/x-raw") ||
+      g_strcmp0 (gst_structure_get_string (structure, "format"), "S16LE") != 0) {
+    ml_loge ("tensor_converter::audio_feature requires audio/x-raw,format=S16LE.");
+    return FALSE;
+  }
+
+  gst_structure_get_int (structure, "rate", &rate);
+  gst_structure_get_int (structure, "channels", &channels);
+
+  /* All tensor info should be updated later in chain function. */
+  config->info.num_tensors = 1;
+  config->info.info[0].type = _NNS_FLOAT32;
+  config->info.info[0].dimension[0] = 1;
+  config->info.info[0].dimension[1] = (guint) MAX (channels, 1);
+  config->rate_n = MAX (rate, 0);
+  config->rate_d = 1;
+  return TRUE;
+}
+
+/** @brief tensor converter plugin's NNStreamerExternalConverter callback */
+static GstBuffer *
+afc_convert (GstBuffer * in_buf, GstTensorsConfig * config, void *priv_data)
+{
+  af_priv_s *af = (af_priv_s *) priv_data;
+  GstTensorInfo *info;
+  GstBuffer *out_buf;
+  GstMemory *out_mem;
+  GstMapInfo in_info, out_info;
+  gsize frames, num;
+  guint frames_dim;
+
+  g_return_val_if_fail (in_buf != NULL, NULL);
+  g_return_val_if_fail (config != NULL, NULL);
+  g_return_val_if_fail (af != NULL, NULL);
+
+  if (!gst_buffer_map (in_buf, &in_info, GST_MAP_READ)) {
+    ml_loge ("Cannot map input memory / tensor_converter::audio_feature.\n");
+    return NULL;
+  }
+
+  if (in_info.size % (sizeof (gint16) * af->channels) != 0) {
+    ml_loge ("The incoming buffer (%zu bytes) is not the S16 frames of %u channels.",
+        in_info.size, af->channels);
+    gst_buffer_unmap (in_buf, &in_info);
+    return NULL;
+  }
+
+  frames = in_info.size / (sizeof (gint16) * af->channels);
+  frames_dim = (af->feature == AF_FEATURE_RAW) ? 0 : 1;
+
+  gst_tensors_config_init (config);
+  config->info.num_tensors = 1;
+  info = &config->info.info[0];
+  info->type = _NNS_FLOAT32;
+  if (af->feature == AF_FEATURE_RAW) {
+    info->dimension[0] = (af->frames > 0) ? af->frames : (guint) frames;
+  } else {
+    info->dimension[0] =
+        (af->feature == AF_FEATURE_MFCC) ? af->n_mfcc : af->n_mels;
+    info->dimension[1] = af->frames;
+  }
+  info->dimension[frames_dim + 1] = af->channels;
+  config->rate_n = (gint) af->rate;
+  config->rate_d = (gint) ((af->feature == AF_FEATURE_RAW) ?
+      info->dimension[0] : af->frames * af->hop);
+
+  out_buf = gst_buffer_new ();
+
+  if (af->feature == AF_FEATURE_RAW && af->frames == 0) {
+    /* a tensor of the incoming buffer, deinterleave directly to the output */
+    if (frames > 0) {
+      out_mem = gst_allocator_alloc (NULL, frames * af->channels *
+          sizeof (gfloat), NULL);
+      gst_memory_map (out_mem, &out_info, GST_MAP_WRITE);
+      gst_tensor_kernels_get ()->s16_deinterleave_f32 ((const gint16 *)
+          in_info.data, (gfloat *) out_info.data, frames, af->channels, frames);
+      gst_memory_unmap (out_mem, &out_info);
+      gst_buffer_append_memory (out_buf, out_mem);
+    }
+  } else {
+    /* the tensors ready, nothing is pushed until the frames of a tensor are given */
+    num = _af_count_tensors (af, frames);
+    _af_push_samples (af, (const gint16 *) in_info.data, frames);
+
+    if (num > 0) {
+      out_mem = gst_allocator_alloc (NULL, num * af->tensor_len *
+          sizeof (gfloat), NULL);
+      gst_memory_map (out_mem, &out_info, GST_MAP_WRITE);
+      num = _af_convert_samples (af, (gfloat *) out_info.data);
+      gst_memory_unmap (out_mem, &out_info);
+      gst_buffer_append_memory (out_buf, out_mem);
+    }
+  }
+
+  gst_buffer_unmap (in_buf, &in_info);
+
+  /** copy timestamps */
+  gst_buffer_copy_into (out_buf, in_buf, GST_BUFFER_COPY_METADATA, 0, -1);
+  return out_buf;
+}
+
+/** @brief tensor converter plugin's NNStreamerExternalConverter callback */
+static void
+afc_close (void **priv_data)
+{
+  af_priv_s *af = (af_priv_s *) * priv_data;
+
+  g_return_if_fail (af != NULL);
+  _af_free (af);
+
+  *priv_data = NULL;
+}
+
+/** @brief tensor converter plugin's NNStreamerExternalConverter callback */
+static int
+afc_open (const gchar * option, void **priv_data)
+{
+  af_priv_s *af;
+  guint feat;
+
+  if (*priv_data != NULL)
+    afc_close (priv_data);
+
+  af = g_new0 (af_priv_s, 1);
+  if (!_af_parse_option (af, option)) {
+    ml_loge ("Failed to parse the option \"%s\" of tensor_converter::audio_feature.",
+        GST_STR_NULL (option));
+    _af_free (af);
+    return -EINVAL;
+  }
+
+  if (af->feature == AF_FEATURE_RAW) {
+    af->tensor_len = (gsize) af->frames * af->channels;
+  } else {
+    feat = (af->feature == AF_FEATURE_MFCC) ? af->n_mfcc : af->n_mels;
+    af->tensor_len = (gsize) feat * af->frames * af->channels;
+    af->pending = g_new0 (gfloat, af->tensor_len);
+    _af_plan (af);
+  }
+
+  *priv_data = af;
+  return 0;
+}
+
+static const gchar converter_subplugin_audio_feature[] = "audio_feature";
+
+/** @brief audio feature tensor converter sub-plugin NNStreamerExternalConverter instance */
+static NNStreamerExternalConverter audioFeature = {
+  .name = converter_subplugin_audio_feature,
+  .convert = afc_convert,
+  .get_out_config = afc_get_out_config,
+  .query_caps = afc_query_caps,
+  .open = afc_open,
+  .close = afc_close
+};
+
+/** @brief Initialize this object for tensor converter sub-plugin */
+void
+init_afc (void)
+{
+  registerExternalConverter (&audioFeature);
+}
+
+/** @brief Destruct this object for tensor converter sub-plugin */
+void
+fini_afc (void)
+{
+  unregisterExternalConverter (audioFeature.name);
+}
@@ -0,0 +1,505 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	tensor_converter_image.c
+ * @date	14 Oct 2026
+ * @brief	NNStreamer tensor-converter subplugin, "image",
+ *		which decodes JPEG and PNG images directly into the tensors.
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ */
+/**
+ * SECTION:tensor_converter::image
+ *
+ * tensor_converter::image decodes image/jpeg (libjpeg) and image/png (libpng)
+ * into the tensor buffer without the decoder element and the video frame.
+ *
+ * With the caps image/jpeg or image/png, tensor_converter decodes the image
+ * in the original size to a uint8 tensor (3:width:height or 1:width:height for gray).
+ *
+ * With mode=custom-script:image:<option>, the option is same as the preprocess mode
+ * (width, height, type, color, mean, std and layout). If width and height are given,
+ * a JPEG image is decoded with the scaled IDCT of libjpeg (1/2, 1/4 or 1/8) to the
+ * smallest size not smaller than the output, and then resized to the output.
+ * If the decoded image is the output (uint8 in nhwc without the normalization),
+ * the rows are decoded directly into the tensor.
+ */
+
+#include <setjmp.h>
+#include <stdio.h>
+#include <string.h>
+#include <glib.h>
+#include <gst/gst.h>
+#include <nnstreamer_log.h>
+#include <nnstreamer_plugin_api.h>
+#include <nnstreamer_plugin_api_converter.h>
+#include <nnstreamer_util.h>
+#include <elements/gsttensor_converter_preprocess.h>
+#include "tensor_converter_util.h"
+
+#ifdef ENABLE_JPEG
+#include <jpeglib.h>
+#endif
+#ifdef ENABLE_PNG
+#include <png.h>
+#endif
+
+void init_imgc (void) __attribute__ ((constructor));
+void fini_imgc (void) __attribute__ ((destructor));
+
+/**
+ * @brief The private data of the subplugin opened with the option.
+ */
+typedef struct
+{
+  tensor_converter_preprocess_s pre; /**< the output of the image */
+  gboolean configured; /**< TRUE if the preprocess is configured for the image size */
+  gboolean direct; /**< TRUE if the decoded image is the output tensor */
+  guint in_width; /**< the width of the configured image */
+  guint in_height; /**< the height of the configured image */
+  guint in_channels; /**< the channels of the configured image */
+  GstTensorInfo info; /**< the output tensor info */
+  guint8 *pixels; /**< the decoded image to be resized */
+  gsize pixels_size; /**< the allocated size of pixels */
+} img_priv_s;
+
+/**
+ * @brief The decoding of an image.
+ */
+typedef struct
+{
+  img_priv_s *priv; /**< the private data, NULL to decode in the original size */
+  guint width; /**< the width of the decoded image */
+  guint height; /**< the height of the decoded image */
+  guint channels; /**< the channels of the decoded image (1 or 3) */
+  GstTensorInfo info; /**< the output tensor info */
+  GstMemory *mem; /**< the output tensor */
+  GstMapInfo map; /**< the mapped output tensor */
+  guint8 *pixels; /**< the decoded image, the output tensor or the pixels of the private data */
+} img_decode_s;
+
+/**
+ * @brief Check the preprocess does nothing for the decoded image.
+ */
+static gboolean
+_img_is_direct (const tensor_converter_preprocess_s * pre)
+{
+  guint c;
+
+  if (pre->out_width != pre->in_width || pre->out_height != pre->in_height ||
+      pre->out_channels != pre->in_channels || pre->type != _NNS_UINT8 ||
+      pre->num_terms != 1)
+    return FALSE;
+
+  if (pre->channel_first && pre->out_channels > 1)
+    return FALSE;
+
+  for (c = 0; c < pre->out_channels; c++) {
+    if (pre->src[c][0] != c || pre->weight[c][0] != 1.0f ||
+        pre->scale[c] != 1.0f || pre->bias[c] != 0.0f)
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Check the image should be decoded in gray.
+ */
+static gboolean
+_img_want_gray (img_priv_s * priv, gboolean is_gray)
+{
+  if (priv && priv->pre.color != PREPROCESS_COLOR_KEEP)
+    return (priv->pre.color == PREPROCESS_COLOR_GRAY);
+
+  return is_gray;
+}
+
+/**
+ * @brief Prepare the output tensor and the rows to decode the image of the size.
+ */
+static gboolean
+_img_prepare (img_decode_s * dec)
+{
+  img_priv_s *priv = dec->priv;
+  gboolean direct = TRUE;
+  gsize size;
+
+  if (priv) {
+    if (!priv->configured || priv->in_width != dec->width ||
+        priv->in_height != dec->height || priv->in_channels != dec->channels) {
+      gst_tensor_info_init (&priv->info);
+      priv->configured = gst_tensor_converter_preprocess_configure (&priv->pre,
+          (dec->channels == 1) ? "GRAY8" : "RGB", dec->width, dec->height,
+          &priv->info);
+      if (!priv->configured)
+        return FALSE;
+
+      priv->in_width = dec->width;
+      priv->in_height = dec->height;
+      priv->in_channels = dec->channels;
+      priv->direct = _img_is_direct (&priv->pre);
+    }
+
+    dec->info = priv->info;
+    direct = priv->direct;
+  } else {
+    gst_tensor_info_init (&dec->info);
+    dec->info.type = _NNS_UINT8;
+    dec->info.dimension[0] = dec->channels;
+    dec->info.dimension[1] = dec->width;
+    dec->info.dimension[2] = dec->height;
+    dec->info.dimension[3] = 1;
+  }
+
+  dec->mem = gst_allocator_alloc (NULL, gst_tensor_info_get_size (&dec->info),
+      NULL);
+  if (!dec->mem || !gst_memory_map (dec->mem, &dec->map, GST_MAP_WRITE)) {
+    ml_loge ("Failed to allocate the tensor of the image (%u x %u).",
+        dec->width, dec->height);
+    if (dec->mem)
+      gst_memory_unref (dec->mem);
+    dec->mem = NULL;
+    return FALSE;
+  }
+
+  if (direct) {
+    dec->pixels = dec->map.data;
+  } else {
+    size = (gsize) dec->width * dec->height * dec->channels;
+    if (priv->pixels_size < size) {
+      g_free (priv->pixels);
+      priv->pixels = g_new (guint8, size);
+      priv->pixels_size = size;
+    }
+    dec->pixels = priv->pixels;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Resize and normalize the decoded image to the output tensor.
+ */
+static void
+_img_finish (img_decode_s * dec)
+{
+  const guint8 *planes[1];
+  gsize strides[1];
+
+  if (dec->pixels != dec->map.data) {
+    planes[0] = dec->pixels;
+    strides[0] = (gsize) dec->width * dec->channels;
+    gst_tensor_converter_preprocess_run (&dec->priv->pre, planes, strides,
+        dec->map.data);
+  }
+
+  gst_memory_unmap (dec->mem, &dec->map);
+}
+
+/**
+ * @brief Release the output tensor if the decoding is failed.
+ */
+static void
+_img_abort (img_decode_s * dec)
+{
+  if (dec->mem) {
+    gst_memory_unmap (dec->mem, &dec->map);
+    gst_memory_unref (dec->mem);
+    dec->mem = NULL;
+  }
+}
+
+#ifdef ENABLE_JPEG
+/**
+ * @brief The error manager of libjpeg, jumps back to the decoder instead of exit.
+ */
+typedef struct
+{
+  struct jpeg_error_mgr pub; /**< the error manager of libjpeg */
+  jmp_buf jump; /**< the context to return */
+} img_jpeg_error_s;
+
+/**
+ * @brief Callback of libjpeg for the fatal error.
+ */
+static void
+_img_jpeg_error_exit (j_common_ptr cinfo)
+{
+  img_jpeg_error_s *err = (img_jpeg_error_s *) cinfo->err;
+  char msg[JMSG_LENGTH_MAX];
+
+  (*cinfo->err->format_message) (cinfo, msg);
+  ml_loge ("Failed to decode the JPEG image: %s", msg);
+  longjmp (err->jump, 1);
+}
+
+/**
+ * @brief Get the denominator of the scaled IDCT, the largest one keeping the image not smaller than the output.
+ */
+static guint
+_img_jpeg_scale (guint width, guint height, guint out_width, guint out_height)
+{
+  guint denom;
+
+  if (out_width == 0 || out_height == 0)
+    return 1;
+
+  for (denom = 8; denom > 1; denom /= 2) {
+    if ((width + denom - 1) / denom >= out_width &&
+        (height + denom - 1) / denom >= out_height)
+      return denom;
+  }
+
+  return 1;
+}
+
+/**
+ * @brief Decode the JPEG image.
+ */
+static gboolean
+_img_decode_jpeg (img_decode_s * dec, const guint8 * data, gsize size)
+{
+  struct jpeg_decompress_struct cinfo;
+  img_jpeg_error_s err;
+  JSAMPROW row;
+  gsize stride;
+
+  cinfo.err = jpeg_std_error (&err.pub);
+  err.pub.error_exit = _img_jpeg_error_exit;
+
+  if (setjmp (err.jump)) {
+    jpeg_destroy_decompress (&cinfo);
+    _img_abort (dec);
+    return FALSE;
+  }
+
+  jpeg_create_decompress (&cinfo);
+  jpeg_mem_src (&cinfo, (unsigned char *) data, (unsigned long) size);
+  jpeg_read_header (&cinfo, TRUE);
+
+  if (_img_want_gray (dec->priv, cinfo.num_components == 1)) {
+    cinfo.out_color_space = JCS_GRAYSCALE;
+  } else {
+    cinfo.out_color_space = JCS_RGB;
+  }
+
+  /* decode in the reduced size with the scaled IDCT */
+  cinfo.scale_num = 1;
+  if (dec->priv) {
+    cinfo.scale_denom = _img_jpeg_scale (cinfo.image_width,
+        cinfo.image_height, dec->priv->pre.width, dec->priv->pre.height);
+  } else {
+    cinfo.scale_denom = 1;
+  }
+
+  jpeg_start_decompress (&cinfo);
+
+  dec->width = cinfo.output_width;
+  dec->height = cinfo.output_height;
+  dec->channels = (guint) cinfo.output_components;
+
+  if (!_img_prepare (dec)) {
+    jpeg_destroy_decompress (&cinfo);
+    return FALSE;
+  }
+
+  stride = (gsize) dec->width * dec->channels;
+  while (cinfo.output_scanline < cinfo.output_height) {
+    row = dec->pixels + cinfo.output_scanline * stride;
+    jpeg_read_scanlines (&cinfo, &row, 1);
+  }
+
+  jpeg_finish_decompress (&cinfo);
+  jpeg_destroy_decompress (&cinfo);
+  return TRUE;
+}
+#endif /* ENABLE_JPEG */
+
+#ifdef ENABLE_PNG
+/**
+ * @brief Decode the PNG image.
+ */
+static gboolean
+_img_decode_png (img_decode_s * dec, const guint8 * data, gsize size)
+{
+  png_image image;
+
+  memset (&image, 0, sizeof (png_image));
+  image.version = PNG_IMAGE_VERSION;
+
+  if (!png_image_begin_read_from_memory (&image, data, size)) {
+    ml_loge ("Failed to read the PNG image: %s", image.message);
+    return FALSE;
+  }
+
+  /* the alpha is composited on black */
+  if (_img_want_gray (dec->priv, !(image.format & PNG_FORMAT_FLAG_COLOR))) {
+    image.format = PNG_FORMAT_GRAY;
+    dec->channels = 1;
+  } else {
+    image.format = PNG_FORMAT_RGB;
+    dec->channels = 3;
+  }
+
+  dec->width = image.width;
+  dec->height = image.height;
+
+  if (!_img_prepare (dec)) {
+    png_image_free (&image);
+    return FALSE;
+  }
+
+  if (!png_image_finish_read (&image, NULL, dec->pixels,
+          (png_int_32) (dec->width * dec->channels), NULL)) {
+    ml_loge ("Failed to decode the PNG image: %s", image.message);
+    _img_abort (dec);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+#endif /* ENABLE_PNG */
+
+/** @brief tensor converter plugin's NNStreamerExternalConverter callback */
+static GstCaps *
+imgc_query_caps (const GstTensorsConfig * config)
+{
+  GstCaps *caps = gst_caps_new_empty ();
+  UNUSED (config);
+
+#ifdef ENABLE_JPEG
+  gst_caps_append (caps, gst_caps_from_string ("image/jpeg"));
+#endif
+#ifdef ENABLE_PNG
+  gst_caps_append (caps, gst_caps_from_string ("image/png"));
+#endif
+  return caps;
+}
+
+/** @brief tensor converter plugin's NNStreamerExternalConverter callback */
+static GstBuffer *
+imgc_convert (GstBuffer * in_buf, GstTensorsConfig * config, void *priv_data)
+{
+  img_decode_s dec;
+  GstBuffer *out_buf = NULL;
+  GstMapInfo in_info;
+  gboolean decoded = FALSE;
+
+  g_return_val_if_fail (in_buf != NULL, NULL);
+  g_return_val_if_fail (config != NULL, NULL);
+
+  if (!gst_buffer_map (in_buf, &in_info, GST_MAP_READ)) {
+    ml_loge ("Cannot map input memory / tensor_converter::image.\n");
+    return NULL;
+  }
+
+  memset (&dec, 0, sizeof (img_decode_s));
+  dec.priv = (img_priv_s *) priv_data;
+
+  if (in_info.size >= 3 && in_info.data[0] == 0xFF && in_info.data[1] == 0xD8
+      && in_info.data[2] == 0xFF) {
+#ifdef ENABLE_JPEG
+    decoded = _img_decode_jpeg (&dec, in_info.data, in_info.size);
+#else
+    ml_loge ("tensor_converter::image is built without libjpeg.");
+#endif
+  } else if (in_info.size >= 8 && memcmp (in_info.data, "\x89PNG\r\n\x1a\n",
+          8) == 0) {
+#ifdef ENABLE_PNG
+    decoded = _img_decode_png (&dec, in_info.data, in_info.size);
+#else
+    ml_loge ("tensor_converter::image is built without libpng.");
+#endif
+  } else {
+    ml_loge ("The incoming buffer is not a JPEG or PNG image.");
+  }
+
+  gst_buffer_unmap (in_buf, &in_info);
+
+  if (!decoded)
+    return NULL;
+
+  _img_finish (&dec);
+
+  gst_tensors_config_init (config);
+  config->info.num_tensors = 1;
+  config->info.info[0] = dec.info;
+  config->info.info[0].name = NULL;
+  config->rate_n = 0;
+  config->rate_d = 1;
+
+  out_buf = gst_buffer_new ();
+  gst_buffer_append_memory (out_buf, dec.mem);
+
+  /** copy timestamps */
+  gst_buffer_copy_into (out_buf, in_buf, GST_BUFFER_COPY_METADATA, 0, -1);
+  return out_buf;
+}
+
+/** @brief tensor converter plugin's NNStreamerExternalConverter callback */
+static void
+imgc_close (void **priv_data)
+{
+  img_priv_s *priv = (img_priv_s *) * priv_data;
+
+  g_return_if_fail (priv != NULL);
+
+  gst_tensor_converter_preprocess_free (&priv->pre);
+  g_free (priv->pixels);
+  g_free (priv);
+
+  *priv_data = NULL;
+}
+
+/** @brief tensor converter plugin's NNStreamerExternalConverter callback */
+static int
+imgc_open (const gchar * option, void **priv_data)
+{
+  img_priv_s *priv;
+
+  if (*priv_data != NULL)
+    imgc_close (priv_data);
+
+  priv = g_new0 (img_priv_s, 1);
+  gst_tensor_converter_preprocess_init (&priv->pre);
+
+  if (!gst_tensor_converter_preprocess_parse_option (&priv->pre, option)) {
+    ml_loge ("Failed to parse the option \"%s\" of tensor_converter::image.",
+        GST_STR_NULL (option));
+    gst_tensor_converter_preprocess_free (&priv->pre);
+    g_free (priv);
+    return -1;
+  }
+
+  *priv_data = priv;
+  return 0;
+}
+
+static const gchar converter_subplugin_image[] = "image";
+
+/** @brief image tensor converter sub-plugin NNStreamerExternalConverter instance */
+static NNStreamerExternalConverter imageConverter = {
+  .name = converter_subplugin_image,
+  .convert = imgc_convert,
+  .get_out_config = tcu_get_out_config,
+  .query_caps = imgc_query_caps,
+  .open = imgc_open,
+  .close = imgc_close
+};
+
+/** @brief Initialize this object for tensor converter sub-plugin */
+void
+init_imgc (void)
+{
+  registerExternalConverter (&imageConverter);
+}
+
+/** @brief Destruct this object for tensor converter sub-plugin */
+void
+fini_imgc (void)
+{
+  unregisterExternalConverter (imageConverter.name);
+}
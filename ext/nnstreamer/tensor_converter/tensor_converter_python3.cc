@@ -58,6 +58,7 @@ class PYConverterCore
   const std::string script_path;
   PyObject *shape_cls;
   PyObject *core_obj;
+  PyTensorViews input_views; /**< the persistent arrays of the input memories */
   void *handle; /**< returned handle by dlopen() */
   GMutex py_mutex;
 };
@@ -94,6 +95,7 @@ PYConverterCore::PYConverterCore (const char *_script_path)
 
   core_obj = NULL;
   shape_cls = NULL;
+  PyTensorViews_Init (&input_views);
 
   g_mutex_init (&py_mutex);
 }
@@ -106,6 +108,7 @@ PYConverterCore::~PYConverterCore ()
 {
   Py_SAFEDECREF (core_obj);
   Py_SAFEDECREF (shape_cls);
+  PyTensorViews_Clear (&input_views);
   PyErr_Clear ();
 
   dlclose (handle);
@@ -133,7 +136,12 @@ PYConverterCore::convert (GstBuffer *in_buf, GstTensorsConfig *config)
   tensors_info = output = pyValue = param = nullptr;
 
   Py_LOCK ();
-  param = PyList_New (num);
+  param = PyTensorViews_Prepare (&input_views, num);
+  if (nullptr == param) {
+    Py_ERRMSG ("Cannot prepare the input arrays / tensor_converter::custom-script");
+    num = 0;
+    goto done;
+  }
 
   for (i = 0; i < num; i++) {
     in_mem[i] = gst_buffer_peek_memory (in_buf, i);
@@ -144,11 +152,11 @@ PYConverterCore::convert (GstBuffer *in_buf, GstTensorsConfig *config)
       goto done;
     }
 
-    npy_intp input_dims[] = { (npy_intp) (in_info[i].size) };
-    PyObject *input_array = PyArray_SimpleNewFromData (
-        1, input_dims, NPY_UINT8, in_info[i].data);
-
-    PyList_SetItem (param, i, input_array);
+    if (PyTensorViews_Set (&input_views, i, _NNS_UINT8, in_info[i].data,
+            in_info[i].size) != 0) {
+      num = i + 1;
+      goto done;
+    }
   }
 
   if (!PyObject_HasAttrString (core_obj, (char *)"convert")) {
@@ -194,7 +202,6 @@ done:
   for (i = 0; i < num; i++)
     gst_memory_unmap (in_mem[i], &in_info[i]);
 
-  Py_SAFEDECREF (param);
   Py_SAFEDECREF (pyValue);
 
   Py_UNLOCK ();
@@ -89,6 +89,12 @@
  * option5: Input Dimension (WIDTH:HEIGHT)
  *          This is independent from option1
  * option6: Box Style (NYI)
+ * option7: Output type
+ *          video (default): boxes are drawn on the transparent video frame (RGBA)
+ *          tensor: flexible tensor (float32, 6:N) of the detected objects,
+ *                  each row is x:y:width:height:class:probability.
+ *                  Use this if the overlay is done by the display path or not needed.
+ *          This is independent from option1
  *
  * MAJOR TODO: Support other colorspaces natively from _decode for performance gain
  * (e.g., BGRA, ARGB, ...)
@@ -106,6 +112,7 @@
 #include <glib.h>
 #include <gst/gst.h>
 #include <math.h>               /* expf */
+#include <glib/gstdio.h>
 #include <nnstreamer_plugin_api_decoder.h>
 #include <nnstreamer_plugin_api.h>
 #include <nnstreamer_log.h>
@@ -134,6 +141,9 @@ extern uint8_t rasters[][13];
 #define MP_PALM_DETECTION_INFO_SIZE             (18)
 #define MP_PALM_DETECTION_MAX_TENSORS           (2U)
 #define MP_PALM_DETECTION_DETECTION_MAX         (2016)
+#define BB_TENSOR_INFO_SIZE                     (6)     /* x, y, width, height, class, prob */
+#define NMS_GRID_MAX_CELLS                      (32)
+#define NMS_GRID_MIN_CELL_SIZE                  (16)
 
 /**
  * @todo Fill in the value at build time or hardcode this. It's const value
@@ -163,6 +173,26 @@ typedef enum
   BOUNDING_BOX_UNKNOWN,
 } bounding_box_modes;
 
+/**
+ * @brief The output of bounding boxes.
+ */
+typedef enum
+{
+  BB_OUTPUT_VIDEO = 0, /**< boxes drawn on the transparent video frame */
+  BB_OUTPUT_TENSOR = 1, /**< flexible tensor of the detected objects */
+
+  BB_OUTPUT_UNKNOWN,
+} bb_output_types;
+
+/**
+ * @brief List of bounding-box output types in string
+ */
+static const char *bb_output_type_str[] = {
+  [BB_OUTPUT_VIDEO] = "video",
+  [BB_OUTPUT_TENSOR] = "tensor",
+  NULL,
+};
+
 /**
  * @brief MOBILENET SSD PostProcess Output tensor feature mapping.
  */
@@ -197,7 +227,6 @@ typedef struct
 {
   /* From option3, box prior data */
   char *box_prior_path; /**< Box Prior file path */
-  gfloat box_priors[BOX_SIZE][MOBILENET_SSD_DETECTION_MAX + 1]; /** loaded box prior */
 #define MOBILENET_SSD_PARAMS_THRESHOLD_IDX 0
 #define MOBILENET_SSD_PARAMS_Y_SCALE_IDX 1
 #define MOBILENET_SSD_PARAMS_X_SCALE_IDX 2
@@ -254,10 +283,27 @@ typedef struct
   gfloat offset_y; /** anchor Y offset */
   gint strides[MP_PALM_DETECTION_PARAMS_STRIDE_SIZE]; /** Stride data for each layers */
   gfloat min_score_threshold; /** minimum threshold of score */
+} properties_MP_PALM_DETECTION;
 
-  GArray *anchors;
+/**
+ * @brief The index of the box priors and anchors.
+ */
+#define BB_PRIOR_Y_CENTER (0)
+#define BB_PRIOR_X_CENTER (1)
+#define BB_PRIOR_HEIGHT (2)
+#define BB_PRIOR_WIDTH (3)
 
-} properties_MP_PALM_DETECTION;
+/**
+ * @brief Box priors (mobilenet-ssd) or anchors (mp-palm-detection) shared by the decoder instances.
+ * The values are stored in SoA, data[BB_PRIOR_Y_CENTER][i] is the y-center of the i-th prior.
+ */
+typedef struct
+{
+  gchar *key; /**< The key of the priors (mode and options) */
+  gint refcount; /**< Reference count, the priors are freed if there is no decoder using them */
+  guint num; /**< The number of the priors */
+  gfloat *data[BOX_SIZE]; /**< y-center, x-center, height and width of the priors */
+} bb_priors;
 
 /**
  * @brief Data structure for bounding box info.
@@ -274,6 +320,7 @@ typedef struct
   };
 
   properties_MP_PALM_DETECTION mp_palm_detection; /**< mp_palm_detection mode properties configuration settings */
+  bb_priors *priors; /**< Box priors or anchors configured by option1 + 3 (mobilenet-ssd and mp-palm-detection) */
 
   /* From option2 */
   imglabel_t labeldata;
@@ -289,6 +336,9 @@ typedef struct
 
   guint max_detection;
   gboolean flag_use_label;
+
+  /* From option7 */
+  bb_output_types output_type; /**< Output of the detected objects */
 } bounding_boxes;
 
 /** @brief check the mode is mobilenet-ssd */
@@ -354,10 +404,155 @@ logit (float x)
   return log (x / (1.0 - x));
 }
 
+/**
+ * @brief Get the bound of the raw score (before sigmoid) to skip the sigmoid.
+ * @details The sigmoid of the raw score smaller than the bound is always smaller than the threshold.
+ *          The margin covers the rounding error of the sigmoid, and -INFINITY is returned if the bound is not safe.
+ */
+static float
+_get_sigmoid_skip_bound (float threshold)
+{
+  float bound;
+
+  /* the sigmoid is rounded to 1.0 with the large raw score */
+  if (threshold <= 0.0f || threshold > 0.99f)
+    return -INFINITY;
+
+  bound = logit (threshold) - 0.01f;
+
+  /* the raw score is clamped to -100 */
+  return (bound > -100.0f) ? bound : -INFINITY;
+}
+
+/**
+ * @brief The table of the box priors and anchors shared by the decoder instances.
+ */
+static GHashTable *bb_priors_table = NULL;
+G_LOCK_DEFINE_STATIC (bb_priors_table);
+
+/**
+ * @brief Allocate the priors. The values are initialized with 0.
+ */
+static bb_priors *
+_bb_priors_new (const gchar * key, guint num)
+{
+  bb_priors *priors;
+  guint i;
+
+  priors = g_new0 (bb_priors, 1);
+  priors->key = g_strdup (key);
+  priors->refcount = 1;
+  priors->num = num;
+
+  /* single block for all rows */
+  priors->data[0] = g_new0 (gfloat, (gsize) BOX_SIZE * MAX (num, 1U));
+  for (i = 1; i < BOX_SIZE; i++)
+    priors->data[i] = priors->data[0] + (gsize) num * i;
+
+  return priors;
+}
+
+/**
+ * @brief Free the priors.
+ */
+static void
+_bb_priors_free (bb_priors * priors)
+{
+  g_free (priors->data[0]);
+  g_free (priors->key);
+  g_free (priors);
+}
+
+/**
+ * @brief Find the priors with the key and increase the reference count.
+ * @return The shared priors, NULL if not found.
+ */
+static bb_priors *
+_bb_priors_lookup (const gchar * key)
+{
+  bb_priors *priors = NULL;
+
+  G_LOCK (bb_priors_table);
+  if (bb_priors_table)
+    priors = g_hash_table_lookup (bb_priors_table, key);
+  if (priors)
+    priors->refcount++;
+  G_UNLOCK (bb_priors_table);
+
+  return priors;
+}
+
+/**
+ * @brief Share the priors with the other decoder instances.
+ * @return The shared priors. If other instance has registered the same key, the given priors are freed.
+ */
+static bb_priors *
+_bb_priors_register (bb_priors * priors)
+{
+  bb_priors *found;
+
+  G_LOCK (bb_priors_table);
+  if (!bb_priors_table)
+    bb_priors_table = g_hash_table_new (g_str_hash, g_str_equal);
+
+  found = g_hash_table_lookup (bb_priors_table, priors->key);
+  if (found)
+    found->refcount++;
+  else
+    g_hash_table_insert (bb_priors_table, priors->key, priors);
+  G_UNLOCK (bb_priors_table);
+
+  if (found) {
+    _bb_priors_free (priors);
+    priors = found;
+  }
+
+  return priors;
+}
+
+/**
+ * @brief Decrease the reference count of the priors, and free the priors if the decoder is the last one.
+ */
+static void
+_bb_priors_unref (bb_priors * priors)
+{
+  if (!priors)
+    return;
+
+  G_LOCK (bb_priors_table);
+  if (--priors->refcount == 0) {
+    g_hash_table_remove (bb_priors_table, priors->key);
+
+    if (g_hash_table_size (bb_priors_table) == 0) {
+      g_hash_table_destroy (bb_priors_table);
+      bb_priors_table = NULL;
+    }
+  } else {
+    priors = NULL;
+  }
+  G_UNLOCK (bb_priors_table);
+
+  if (priors)
+    _bb_priors_free (priors);
+}
+
+/**
+ * @brief Set the priors of the decoder and release the old one.
+ */
+static void
+_bb_set_priors (bounding_boxes * bdata, bb_priors * priors)
+{
+  _bb_priors_unref (bdata->priors);
+  bdata->priors = priors;
+}
+
 /** @brief Initialize bounding_boxes per mode */
 static int
 _init_modes (bounding_boxes * bdata)
 {
+  /* the priors are configured with option3 */
+  _bb_set_priors (bdata, NULL);
+
   if (bdata->mode == YOLOV5_BOUNDING_BOX) {
     bdata->yolov5_pp.scaled_output = 0; /* default conf is the output is not scaled */
     return TRUE;
@@ -425,7 +620,6 @@ _init_modes (bounding_boxes * bdata)
     data->strides[2] = MP_PALM_DETECTION_STRIDE_2_DEFAULT;
     data->strides[3] = MP_PALM_DETECTION_STRIDE_3_DEFAULT;
     data->min_score_threshold = MP_PALM_DETECTION_MIN_SCORE_THRESHOLD_DEFAULT;
-    data->anchors = g_array_new(FALSE, TRUE, sizeof(anchor));
 
     return TRUE;
   }
@@ -451,6 +645,7 @@ bb_init (void **pdata)
   bdata->i_width = 0;
   bdata->i_height = 0;
   bdata->flag_use_label = FALSE;
+  bdata->output_type = BB_OUTPUT_VIDEO;
 
   initSingleLineSprite (singleLineSprite, rasters, PIXEL_VALUE);
 
@@ -462,6 +657,8 @@ bb_init (void **pdata)
 static void
 _exit_modes (bounding_boxes * bdata)
 {
+  _bb_set_priors (bdata, NULL);
+
   if (_check_mode_is_mobilenet_ssd (bdata->mode)) {
     /* properties_MOBILENET_SSD *data = &bdata->mobilenet_ssd; */
   } else if (_check_mode_is_mobilenet_ssd_pp (bdata->mode)) {
@@ -487,6 +684,7 @@ bb_exit (void **pdata)
 
 /**
  * @brief Load box-prior data from a file
+ * @details The loaded priors are shared with the other decoders if the file is not changed.
  * @param[in/out] bdata The internal data.
  * @return TRUE if loaded and configured. FALSE if failed to do so.
  */
@@ -499,18 +697,42 @@ _mobilenet_ssd_loadBoxPrior (bounding_boxes * bdata)
   gchar **priors;
   gchar *line = NULL;
   gchar *contents = NULL;
+  gchar *key;
+  GStatBuf st;
+  bb_priors *box_priors;
   guint row;
   gint prev_reg = -1;
 
+  /* the priors are shared if the path, the modification time and the size of the file are same */
+  if (g_stat (mobilenet_ssd->box_prior_path, &st) == 0) {
+    key = g_strdup_printf ("mobilenet-ssd:%s:%" G_GINT64_FORMAT ":%"
+        G_GINT64_FORMAT, mobilenet_ssd->box_prior_path, (gint64) st.st_mtime,
+        (gint64) st.st_size);
+  } else {
+    key = g_strdup_printf ("mobilenet-ssd:%s", mobilenet_ssd->box_prior_path);
+  }
+
+  box_priors = _bb_priors_lookup (key);
+  if (box_priors) {
+    _bb_set_priors (bdata, box_priors);
+    g_free (key);
+    return TRUE;
+  }
+
   /* Read file contents */
   if (!g_file_get_contents (mobilenet_ssd->box_prior_path, &contents, NULL,
           &err)) {
     GST_ERROR ("Decoder/Bound-Box/SSD's box prior file %s cannot be read: %s",
         mobilenet_ssd->box_prior_path, err->message);
     g_clear_error (&err);
+    g_free (key);
     return FALSE;
   }
 
+  /* the decoder reads up to MOBILENET_SSD_DETECTION_MAX priors, the rest is 0. */
+  box_priors = _bb_priors_new (key, MOBILENET_SSD_DETECTION_MAX + 1);
+  g_free (key);
+
   priors = g_strsplit (contents, "\n", -1);
   /* If given prior file is inappropriate, report back to tensor-decoder */
   if (g_strv_length (priors) < BOX_SIZE) {
@@ -538,7 +760,7 @@ _mobilenet_ssd_loadBoxPrior (bounding_boxes * bdata)
                 registered, MOBILENET_SSD_DETECTION_MAX);
             break;
           }
-          mobilenet_ssd->box_priors[row][registered] =
+          box_priors->data[row][registered] =
               (gfloat) g_ascii_strtod (word, NULL);
           registered++;
         }
@@ -559,6 +781,14 @@ _mobilenet_ssd_loadBoxPrior (bounding_boxes * bdata)
 error:
   g_strfreev (priors);
   g_free (contents);
+
+  if (failed) {
+    _bb_priors_free (box_priors);
+  } else {
+    box_priors->num = (guint) prev_reg;
+    _bb_set_priors (bdata, _bb_priors_register (box_priors));
+  }
+
   return !failed;
 }
 
@@ -580,7 +810,8 @@ _calculate_scale (float min_scale, float max_scale, int stride_index, int num_st
  * @brief Generate anchor information
  */
 static void
-_mp_palm_detection_generate_anchors (properties_MP_PALM_DETECTION *palm_detection)
+_mp_palm_detection_generate_anchors (properties_MP_PALM_DETECTION *palm_detection,
+    GArray *anchors)
 {
   int layer_id = 0;
   int strides[MP_PALM_DETECTION_PARAMS_STRIDE_SIZE];
@@ -645,15 +876,63 @@ _mp_palm_detection_generate_anchors (properties_MP_PALM_DETECTION *palm_detectio
 
             const anchor a = {.x_center = x_center, .y_center = y_center,
               .w = g_array_index (anchor_width, gfloat, anchor_id), .h = g_array_index (anchor_height, gfloat, anchor_id)};
-            g_array_append_val(palm_detection->anchors, a);
+            g_array_append_val(anchors, a);
           }
         }
       }
       layer_id = last_same_stride_layer;
     }
 
-    g_array_free(aspect_ratios, FALSE);
+    g_array_free(aspect_ratios, TRUE);
+    g_array_free(scales, TRUE);
+    g_array_free(anchor_height, TRUE);
+    g_array_free(anchor_width, TRUE);
+  }
+}
+
+/**
+ * @brief Configure the anchors, the anchors generated with the same options are shared with the other decoders.
+ */
+static void
+_mp_palm_detection_load_anchors (bounding_boxes * bdata)
+{
+  properties_MP_PALM_DETECTION *palm_detection = &bdata->mp_palm_detection;
+  bb_priors *priors;
+  GArray *anchors;
+  GString *key;
+  gint idx;
+  guint i;
+
+  key = g_string_new ("mp-palm-detection");
+  g_string_append_printf (key, ":%d:%.9g:%.9g:%.9g:%.9g",
+      palm_detection->num_layers, palm_detection->min_scale,
+      palm_detection->max_scale, palm_detection->offset_x,
+      palm_detection->offset_y);
+  for (idx = 0; idx < MIN (palm_detection->num_layers,
+          MP_PALM_DETECTION_PARAMS_STRIDE_SIZE); idx++)
+    g_string_append_printf (key, ":%d", palm_detection->strides[idx]);
+
+  priors = _bb_priors_lookup (key->str);
+  if (!priors) {
+    anchors = g_array_new (FALSE, TRUE, sizeof (anchor));
+    _mp_palm_detection_generate_anchors (palm_detection, anchors);
+
+    priors = _bb_priors_new (key->str, anchors->len);
+    for (i = 0; i < anchors->len; i++) {
+      anchor *a = &g_array_index (anchors, anchor, i);
+
+      priors->data[BB_PRIOR_Y_CENTER][i] = a->y_center;
+      priors->data[BB_PRIOR_X_CENTER][i] = a->x_center;
+      priors->data[BB_PRIOR_HEIGHT][i] = a->h;
+      priors->data[BB_PRIOR_WIDTH][i] = a->w;
+    }
+
+    g_array_free (anchors, TRUE);
+    priors = _bb_priors_register (priors);
   }
+
+  _bb_set_priors (bdata, priors);
+  g_string_free (key, TRUE);
 }
 
 #define mp_palm_detection_option(option, type, idx) \
@@ -769,7 +1048,7 @@ _setOption_mode (bounding_boxes * bdata, const char *param)
       mp_palm_detection_option (palm_detection->strides[idx - 6], gint, idx);
     }
 
-    _mp_palm_detection_generate_anchors(palm_detection);
+    _mp_palm_detection_load_anchors (bdata);
 
   exit_mp_palm_detection:
     g_strfreev (options);
@@ -870,6 +1149,25 @@ bb_setOption (void **pdata, int opNum, const char *param)
     bdata->i_width = dim[0];
     bdata->i_height = dim[1];
     return TRUE;
+  } else if (opNum == 6) {
+    /* option7 = output type (video or tensor) */
+    int type;
+
+    if (param == NULL || *param == '\0') {
+      bdata->output_type = BB_OUTPUT_VIDEO;
+      return TRUE;
+    }
+
+    type = find_key_strv (bb_output_type_str, param);
+    if (type < 0) {
+      GST_ERROR
+          ("mode-option-7 of boundingbox is output type (video or tensor). The given parameter, \"%s\", is not acceptable.",
+          param);
+      return FALSE;
+    }
+
+    bdata->output_type = (bb_output_types) type;
+    return TRUE;
   }
   /**
    * @todo Accept color / border-width / ... with option-2
@@ -972,6 +1270,11 @@ bb_getOutCaps (void **pdata, const GstTensorsConfig * config)
     if (!_check_tensors (config, MOBILENET_SSD_MAX_TENSORS))
       return NULL;
 
+    if (!data->priors) {
+      GST_ERROR ("The box prior file of mobilenet-ssd is not loaded, set option3.");
+      return NULL;
+    }
+
     /* Check if the first tensor is compatible */
     dim1 = config->info.info[0].dimension;
     g_return_val_if_fail (dim1[0] == BOX_SIZE, NULL);
@@ -1080,6 +1383,10 @@ bb_getOutCaps (void **pdata, const GstTensorsConfig * config)
     if (!_check_tensors (config, MP_PALM_DETECTION_MAX_TENSORS))
       return NULL;
 
+    /* generate the anchors with the default options if option3 is not given */
+    if (!data->priors)
+      _mp_palm_detection_load_anchors (data);
+
     /* Check if the first tensor is compatible */
     dim1 = config->info.info[0].dimension;
 
@@ -1103,6 +1410,13 @@ bb_getOutCaps (void **pdata, const GstTensorsConfig * config)
     }
   }
 
+  if (data->output_type == BB_OUTPUT_TENSOR) {
+    /* the number of detected objects is changed in each frame */
+    caps = gst_caps_from_string (GST_TENSORS_FLEX_CAP_DEFAULT);
+    setFramerateFromConfig (caps, config);
+    return caps;
+  }
+
   str = g_strdup_printf ("video/x-raw, format = RGBA, " /* Use alpha channel to make the background transparent */
       "width = %u, height = %u", data->width, data->height);
   caps = gst_caps_from_string (str);
@@ -1222,7 +1536,7 @@ typedef struct
 
 /** @brief Macro to simplify calling _get_objects_mobilenet_ssd */
 #define _get_objects_mobilenet_ssd_(type, typename) \
-  _get_objects_mobilenet_ssd (bdata, type, typename, (bdata->mobilenet_ssd.box_priors), (boxes->data), (detections->data), config, results)
+  _get_objects_mobilenet_ssd (bdata, type, typename, (bdata->priors->data), (boxes->data), (detections->data), config, results)
 
 /**
  * @brief Compare Function for g_array_sort with detectedObject.
@@ -1256,42 +1570,151 @@ iou (detectedObject * a, detectedObject * b)
   return (o >= 0) ? o : 0;
 }
 
+/**
+ * @brief Check whether the box suppressed by one of the kept boxes in the list of the grid cell.
+ */
+static gboolean
+nms_is_suppressed (GArray * results, const gint * next, const guint * entry_box,
+    gint head, detectedObject * b, gfloat threshold)
+{
+  gint k;
+
+  for (k = head; k >= 0; k = next[k]) {
+    detectedObject *a = &g_array_index (results, detectedObject, entry_box[k]);
+    if (iou (a, b) > threshold)
+      return TRUE;
+  }
+
+  return FALSE;
+}
+
 /**
  * @brief Apply NMS to the given results (objects[MOBILENET_SSD_DETECTION_MAX])
+ * @details The box is suppressed if one of the kept boxes with higher probability overlaps it.
+ *          The kept boxes are registered in the grid cells covering them,
+ *          so that a box is compared with the kept boxes in the same cells only.
+ *          If the boxes do not overlap, iou() is 0; thus, the result is same as comparing all pairs.
  * @param[in/out] results The results to be filtered with nms
  */
 static void
 nms (GArray * results, gfloat threshold)
 {
-  guint boxes_size;
-  guint i, j;
+  guint boxes_size, num_kept;
+  guint i, num_entries, max_entries, n;
+  gint min_x, min_y, max_x, max_y;
+  gint cell, cols, rows, cx, cy;
+  gint *head, *next;
+  guint *entry_box;
+  gboolean use_grid;
 
   g_array_sort (results, compare_detection);
   boxes_size = results->len;
+  if (boxes_size == 0)
+    return;
+
+  /* the grid requires the boxes with positive size and non-negative threshold (iou 0 is not suppressed) */
+  use_grid = (threshold >= 0.0f);
+  min_x = min_y = G_MAXINT;
+  max_x = max_y = G_MININT;
+
+  for (i = 0; i < boxes_size && use_grid; i++) {
+    detectedObject *b = &g_array_index (results, detectedObject, i);
+
+    if (b->width < 0 || b->height < 0) {
+      use_grid = FALSE;
+      break;
+    }
+
+    min_x = MIN (min_x, b->x);
+    min_y = MIN (min_y, b->y);
+    max_x = MAX (max_x, b->x + b->width);
+    max_y = MAX (max_y, b->y + b->height);
+  }
+
+  if (use_grid) {
+    /* limit the number of cells (NMS_GRID_MAX_CELLS x NMS_GRID_MAX_CELLS) */
+    cell = MAX (max_x - min_x, max_y - min_y) / NMS_GRID_MAX_CELLS + 1;
+    cell = MAX (cell, NMS_GRID_MIN_CELL_SIZE);
+    cols = (max_x - min_x) / cell + 1;
+    rows = (max_y - min_y) / cell + 1;
+  } else {
+    /* single cell, compare with all kept boxes */
+    cell = 1;
+    cols = rows = 1;
+    min_x = min_y = 0;
+  }
 
+  head = g_new (gint, cols * rows);
+  for (i = 0; i < (guint) (cols * rows); i++)
+    head[i] = -1;
+
+  /* the list of the kept boxes in each cell (entry to the box index) */
+  num_entries = 0;
+  max_entries = boxes_size;
+  next = g_new (gint, max_entries);
+  entry_box = g_new (guint, max_entries);
+
+  num_kept = 0;
   for (i = 0; i < boxes_size; i++) {
-    detectedObject *a = &g_array_index (results, detectedObject, i);
-    if (a->valid == TRUE) {
-      for (j = i + 1; j < boxes_size; j++) {
-        detectedObject *b = &g_array_index (results, detectedObject, j);
-        if (b->valid == TRUE) {
-          if (iou (a, b) > threshold) {
-            b->valid = FALSE;
-          }
-        }
+    detectedObject *b = &g_array_index (results, detectedObject, i);
+    gint x0, y0, x1, y1;
+    gboolean suppressed = FALSE;
+
+    if (b->valid != TRUE)
+      continue;
+
+    if (use_grid) {
+      x0 = (b->x - min_x) / cell;
+      y0 = (b->y - min_y) / cell;
+      x1 = (b->x + b->width - min_x) / cell;
+      y1 = (b->y + b->height - min_y) / cell;
+    } else {
+      x0 = y0 = x1 = y1 = 0;
+    }
+
+    for (cy = y0; cy <= y1 && !suppressed; cy++) {
+      for (cx = x0; cx <= x1 && !suppressed; cx++) {
+        gint h = head[cy * cols + cx];
+
+        if (h >= 0)
+          suppressed =
+              nms_is_suppressed (results, next, entry_box, h, b, threshold);
       }
     }
+
+    if (suppressed) {
+      b->valid = FALSE;
+      continue;
+    }
+
+    /* keep the box, move it to the front and register it in the cells */
+    if (num_kept != i)
+      g_array_index (results, detectedObject, num_kept) = *b;
+
+    n = (guint) ((x1 - x0 + 1) * (y1 - y0 + 1));
+    if (num_entries + n > max_entries) {
+      max_entries = MAX (max_entries * 2, num_entries + n);
+      next = g_renew (gint, next, max_entries);
+      entry_box = g_renew (guint, entry_box, max_entries);
+    }
+
+    for (cy = y0; cy <= y1; cy++) {
+      for (cx = x0; cx <= x1; cx++) {
+        entry_box[num_entries] = num_kept;
+        next[num_entries] = head[cy * cols + cx];
+        head[cy * cols + cx] = num_entries;
+        num_entries++;
+      }
+    }
+
+    num_kept++;
   }
 
-  i = 0;
-  do {
-    detectedObject *a = &g_array_index (results, detectedObject, i);
-    if (a->valid == FALSE)
-      g_array_remove_index (results, i);
-    else
-      i++;
-  } while (i < results->len);
+  g_array_set_size (results, num_kept);
 
+  g_free (head);
+  g_free (next);
+  g_free (entry_box);
 }
 
 /**
@@ -1412,8 +1835,13 @@ nms (GArray * results, gfloat threshold)
     _type * boxes_ = (_type *) boxesinput; \
     guint i_width_ = bb->i_width; \
     guint i_height_ = bb->i_height; \
-    int num_ = bb->max_detection; \
+    int num_ = MIN (bb->max_detection, bb->priors->num); \
     size_t boxbpi_ = config->info.info[0].dimension[0]; \
+    const gfloat *ay_ = bb->priors->data[BB_PRIOR_Y_CENTER]; \
+    const gfloat *ax_ = bb->priors->data[BB_PRIOR_X_CENTER]; \
+    const gfloat *ah_ = bb->priors->data[BB_PRIOR_HEIGHT]; \
+    const gfloat *aw_ = bb->priors->data[BB_PRIOR_WIDTH]; \
+    gfloat bound_ = _get_sigmoid_skip_bound (data->min_score_threshold); \
     results = g_array_sized_new (FALSE, TRUE, sizeof (detectedObject), num_); \
     for (d_ = 0; d_ < num_; d_++) { \
       gfloat y_center, x_center, h, w; \
@@ -1421,17 +1849,20 @@ nms (GArray * results, gfloat threshold)
       int y, x, width, height; \
       detectedObject object; \
       gfloat score = (gfloat)scores_[d_]; \
-      _type * box = boxes_ + boxbpi_ * d_; \
-      anchor * a = &g_array_index (data->anchors, anchor, d_); \
+      _type * box; \
+      /* skip the sigmoid of the low score */ \
+      if (score < bound_) \
+        continue; \
+      box = boxes_ + boxbpi_ * d_; \
       score = MAX(score, -100.0f); \
       score = MIN(score, 100.0f); \
       score = 1.0f / (1.0f + exp (-score)); \
       if (score < data->min_score_threshold) \
         continue; \
-      y_center = (box[0] * 1.f) / i_height_ * a->h + a->y_center; \
-      x_center = (box[1] * 1.f) / i_width_ * a->w + a->x_center; \
-      h = (box[2] * 1.f) / i_height_ * a->h; \
-      w = (box[3] * 1.f) / i_width_ * a->w; \
+      y_center = (box[0] * 1.f) / i_height_ * ah_[d_] + ay_[d_]; \
+      x_center = (box[1] * 1.f) / i_width_ * aw_[d_] + ax_[d_]; \
+      h = (box[2] * 1.f) / i_height_ * ah_[d_]; \
+      w = (box[3] * 1.f) / i_width_ * aw_[d_]; \
       ymin = y_center - h / 2.f; \
       xmin = x_center - w / 2.f; \
       y = ymin * i_height_; \
@@ -1470,8 +1901,6 @@ draw (GstMapInfo * out_info, bounding_boxes * bdata, GArray * results)
     int x1, x2, y1, y2;         /* Box positions on the output surface */
     int j;
     uint32_t *pos1, *pos2;
-    const char *label;
-    int label_len;
     detectedObject *a = &g_array_index (results, detectedObject, i);
 
 
@@ -1513,52 +1942,27 @@ draw (GstMapInfo * out_info, bounding_boxes * bdata, GArray * results)
 
     /* 2. Write Labels */
     if (bdata->flag_use_label) {
-      label = bdata->labeldata.labels[a->class_id];
-      label_len = strlen (label);
       /* x1 is the same: x1 = MAX (0, (bdata->width * a->x) / bdata->i_width); */
       y1 = MAX (0, (y1 - 14));
-      pos1 = &frame[y1 * bdata->width + x1];
-      for (j = 0; j < label_len; j++) {
-        unsigned int char_index = label[j];
-        if ((x1 + 8) > (int) bdata->width)
-          break;                /* Stop drawing if it may overfill */
-        pos2 = pos1;
-        for (y2 = 0; y2 < 13; y2++) {
-          /* 13 : character height */
-          for (x2 = 0; x2 < 8; x2++) {
-            /* 8: character width */
-            *(pos2 + x2) = singleLineSprite[char_index][y2][x2];
-          }
-          pos2 += bdata->width;
-        }
-        x1 += 9;
-        pos1 += 9;              /* charater width + 1px */
-      }
+      drawSingleLineText (frame, bdata->width, x1, y1,
+          bdata->labeldata.labels[a->class_id], singleLineSprite);
     }
   }
 }
 
-/** @brief tensordec-plugin's GstTensorDecoderDef callback */
+/**
+ * @brief Draw the results on the transparent video frame (RGBA) in the output buffer.
+ */
 static GstFlowReturn
-bb_decode (void **pdata, const GstTensorsConfig * config,
-    const GstTensorMemory * input, GstBuffer * outbuf)
+_bb_write_video (GstBuffer * outbuf, bounding_boxes * bdata, GArray * results)
 {
-  bounding_boxes *bdata = *pdata;
   const size_t size = (size_t) bdata->width * bdata->height * 4; /* RGBA */
   GstMapInfo out_info;
   GstMemory *out_mem;
-  GArray *results = NULL;
-  const guint num_tensors = config->info.num_tensors;
   gboolean need_output_alloc;
 
-  g_assert (outbuf);
   need_output_alloc = gst_buffer_get_size (outbuf) == 0;
 
-  if (_check_label_props (bdata))
-    bdata->flag_use_label = TRUE;
-  else
-    bdata->flag_use_label = FALSE;
-
   /* Ensure we have outbuf properly allocated */
   if (need_output_alloc) {
     out_mem = gst_allocator_alloc (NULL, size, NULL);
@@ -1570,12 +1974,107 @@ bb_decode (void **pdata, const GstTensorsConfig * config,
   }
   if (!gst_memory_map (out_mem, &out_info, GST_MAP_WRITE)) {
     ml_loge ("Cannot map output memory / tensordec-bounding_boxes.\n");
-    goto error_free;
+    gst_memory_unref (out_mem);
+    return GST_FLOW_ERROR;
   }
 
   /** reset the buffer with alpha 0 / black */
   memset (out_info.data, 0, size);
 
+  draw (&out_info, bdata, results);
+
+  gst_memory_unmap (out_mem, &out_info);
+
+  if (need_output_alloc)
+    gst_buffer_append_memory (outbuf, out_mem);
+  else
+    gst_memory_unref (out_mem);
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Write the results to the flexible tensor (float32, BB_TENSOR_INFO_SIZE:N) in the output buffer.
+ * @details Each row is (x, y, width, height, class id, probability) of the detected object.
+ *          The tensor cannot be empty, a row with class id -1 and probability 0 is written if nothing is detected.
+ */
+static GstFlowReturn
+_bb_write_tensor (GstBuffer * outbuf, GArray * results)
+{
+  GstTensorMetaInfo meta;
+  GstMemory *mem, *out_mem;
+  GstMapInfo map;
+  gfloat *row;
+  guint i, num;
+
+  num = MAX (results->len, 1U);
+
+  gst_tensor_meta_info_init (&meta);
+  meta.type = _NNS_FLOAT32;
+  meta.format = _NNS_TENSOR_FORMAT_FLEXIBLE;
+  meta.dimension[0] = BB_TENSOR_INFO_SIZE;
+  meta.dimension[1] = num;
+
+  mem = gst_allocator_alloc (NULL, sizeof (gfloat) * BB_TENSOR_INFO_SIZE * num,
+      NULL);
+  if (!gst_memory_map (mem, &map, GST_MAP_WRITE)) {
+    ml_loge ("Cannot map output memory / tensordec-bounding_boxes.\n");
+    gst_memory_unref (mem);
+    return GST_FLOW_ERROR;
+  }
+
+  row = (gfloat *) map.data;
+  if (results->len == 0) {
+    memset (row, 0, sizeof (gfloat) * BB_TENSOR_INFO_SIZE);
+    row[4] = -1.0f;
+  }
+
+  for (i = 0; i < results->len; i++) {
+    detectedObject *a = &g_array_index (results, detectedObject, i);
+
+    row[0] = (gfloat) a->x;
+    row[1] = (gfloat) a->y;
+    row[2] = (gfloat) a->width;
+    row[3] = (gfloat) a->height;
+    row[4] = (gfloat) a->class_id;
+    row[5] = a->prob;
+    row += BB_TENSOR_INFO_SIZE;
+  }
+
+  gst_memory_unmap (mem, &map);
+
+  out_mem = gst_tensor_meta_info_append_header (&meta, mem);
+  gst_memory_unref (mem);
+
+  if (!out_mem) {
+    ml_loge ("Failed to append the header of the flexible tensor / tensordec-bounding_boxes.\n");
+    return GST_FLOW_ERROR;
+  }
+
+  if (gst_buffer_get_size (outbuf) > 0)
+    gst_buffer_remove_all_memory (outbuf);
+
+  gst_buffer_append_memory (outbuf, out_mem);
+  return GST_FLOW_OK;
+}
+
+/** @brief tensordec-plugin's GstTensorDecoderDef callback */
+static GstFlowReturn
+bb_decode (void **pdata, const GstTensorsConfig * config,
+    const GstTensorMemory * input, GstBuffer * outbuf)
+{
+  bounding_boxes *bdata = *pdata;
+  GArray *results = NULL;
+  const guint num_tensors = config->info.num_tensors;
+  GstFlowReturn ret;
+
+  g_assert (outbuf);
+
+  if (_check_label_props (bdata))
+    bdata->flag_use_label = TRUE;
+  else
+    bdata->flag_use_label = FALSE;
+
   if (_check_mode_is_mobilenet_ssd (bdata->mode)) {
     const GstTensorMemory *boxes, *detections = NULL;
     properties_MOBILENET_SSD *data = &bdata->mobilenet_ssd;
@@ -1753,27 +2252,16 @@ bb_decode (void **pdata, const GstTensorsConfig * config,
     nms (results, 0.05f);
   } else {
     GST_ERROR ("Failed to get output buffer, unknown mode %d.", bdata->mode);
-    goto error_unmap;
+    return GST_FLOW_ERROR;
   }
 
-  draw (&out_info, bdata, results);
-  g_array_free (results, TRUE);
-
-  gst_memory_unmap (out_mem, &out_info);
-
-  if (need_output_alloc)
-    gst_buffer_append_memory (outbuf, out_mem);
+  if (bdata->output_type == BB_OUTPUT_TENSOR)
+    ret = _bb_write_tensor (outbuf, results);
   else
-    gst_memory_unref (out_mem);
-
-  return GST_FLOW_OK;
+    ret = _bb_write_video (outbuf, bdata, results);
 
-error_unmap:
-  gst_memory_unmap (out_mem, &out_info);
-error_free:
-  gst_memory_unref (out_mem);
-
-  return GST_FLOW_ERROR;
+  g_array_free (results, TRUE);
+  return ret;
 }
 
 static gchar decoder_subplugin_bounding_box[] = "bounding_boxes";
@@ -24,6 +24,9 @@
  * @author	Jijoong Moon <jijoong.moon@samsung.com>
  * @bug		No known bugs except for NYI items
  *
+ * If the rows of the tensor are aligned to 4 bytes (the default stride of
+ * GStreamer video), the decoder shares the input memory without copying it.
+ * Otherwise, each row is copied with the padding.
  */
 
 #include <string.h>
@@ -273,6 +276,17 @@ _get_video_xraw_bufsize (const tensor_dim dim)
   return (size_t)((dim[0] * dim[1] - 1) / 4 + 1) * 4 * dim[2];
 }
 
+/** @brief check the tensor has the same layout with the video frame */
+static gboolean
+_is_video_layout (const GstTensorsConfig * config)
+{
+  const uint32_t *dim = &(config->info.info[0].dimension[0]);
+
+  return !gst_tensors_config_is_flexible (config) &&
+      config->info.info[0].type == _NNS_UINT8 &&
+      0 == ((dim[0] * dim[1]) % 4);
+}
+
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
 static size_t
 dv_getTransformSize (void **pdata, const GstTensorsConfig * config,
@@ -285,6 +299,10 @@ dv_getTransformSize (void **pdata, const GstTensorsConfig * config,
   UNUSED (size);
   UNUSED (othercaps);
 
+  /* Zero-copy with the input memory, no output memory is needed. */
+  if (_is_video_layout (config))
+    return 0;
+
   if (direction == GST_PAD_SINK)
     return _get_video_xraw_bufsize (dim);
   else
@@ -349,6 +367,27 @@ dv_decode (void **pdata, const GstTensorsConfig * config,
   return GST_FLOW_OK;
 }
 
+/** @brief tensordec-plugin's GstTensorDecoderDef callback */
+static GstFlowReturn
+dv_decodeMemory (void **pdata, const GstTensorsConfig * config,
+    GstMemory ** input, guint num_tensors, GstBuffer * outbuf)
+{
+  /* Direct video uses the first tensor only even if it's multi-tensor */
+  const uint32_t *dim = &(config->info.info[0].dimension[0]);
+  size_t size = _get_video_xraw_bufsize (dim);
+  UNUSED (pdata);
+
+  if (num_tensors < 1 || gst_buffer_get_size (outbuf) > 0 ||
+      !_is_video_layout (config) ||
+      gst_memory_get_sizes (input[0], NULL, NULL) != size)
+    return GST_FLOW_NOT_SUPPORTED;
+
+  /* The rows of the tensor are the rows of the video frame. */
+  gst_buffer_append_memory (outbuf, gst_memory_ref (input[0]));
+
+  return GST_FLOW_OK;
+}
+
 static gchar decoder_subplugin_direct_video[] = "direct_video";
 
 /** @brief Direct-Video tensordec-plugin GstTensorDecoderDef instance */
@@ -359,7 +398,9 @@ static GstTensorDecoderDef directVideo = {
   .setOption = dv_setOption,
   .getOutCaps = dv_getOutCaps,
   .getTransformSize = dv_getTransformSize,
-  .decode = dv_decode
+  .decode = dv_decode,
+  .decodeMemory = dv_decodeMemory,
+  .threadSafe = 1
 };
 
 /** @brief Initialize this object for tensordec-plugin */
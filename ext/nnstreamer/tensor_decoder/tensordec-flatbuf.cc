@@ -79,6 +79,13 @@ fbd_getOutCaps (void **pdata, const GstTensorsConfig *config)
   return caps;
 }
 
+/** @brief Release the serialized buffer wrapped in the output memory */
+static void
+fbd_free_buffer (gpointer data)
+{
+  delete static_cast<flatbuffers::DetachedBuffer *> (data);
+}
+
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
 static GstFlowReturn
 fbd_decode (void **pdata, const GstTensorsConfig *config,
@@ -91,7 +98,6 @@ fbd_decode (void **pdata, const GstTensorsConfig *config,
   GstMemory *out_mem;
   guint i, num_tensors;
   flatbuffers::uoffset_t fb_size;
-  flatbuffers::FlatBufferBuilder builder;
   std::vector<flatbuffers::Offset<Tensor>> tensor_vector;
   flatbuffers::Offset<flatbuffers::Vector<uint32_t>> dim;
   flatbuffers::Offset<flatbuffers::String> tensor_name;
@@ -111,6 +117,12 @@ fbd_decode (void **pdata, const GstTensorsConfig *config,
   }
   gst_tensors_config_copy (&fbd_config, config);
 
+  /* Reserve the whole message at once to avoid reallocation while building */
+  gsize reserved = 1024;
+  for (i = 0; i < config->info.num_tensors; i++)
+    reserved += input[i].size + 256;
+  flatbuffers::FlatBufferBuilder builder (reserved);
+
   is_flexible = gst_tensors_config_is_flexible (&fbd_config);
 
   num_tensors = fbd_config.info.num_tensors;
@@ -135,7 +147,6 @@ fbd_decode (void **pdata, const GstTensorsConfig *config,
     type = (Tensor_type) fbd_config.info.info[i].type;
 
     /* Create the vector first, and fill in data later */
-    /** @todo Consider to remove memcpy */
     input_vector = builder.CreateUninitializedVector<unsigned char> (input[i].size, &tmp_buf);
     memcpy (tmp_buf, input[i].data, input[i].size);
 
@@ -148,15 +159,22 @@ fbd_decode (void **pdata, const GstTensorsConfig *config,
   /* Serialize the data.*/
   builder.Finish (tensors);
   fb_size = builder.GetSize ();
+  gst_tensors_config_free (&fbd_config);
 
   if (gst_buffer_get_size (outbuf) == 0) {
-    out_mem = gst_allocator_alloc (NULL, fb_size, NULL);
-  } else {
-    if (gst_buffer_get_size (outbuf) < fb_size) {
-      gst_buffer_set_size (outbuf, fb_size);
-    }
-    out_mem = gst_buffer_get_all_memory (outbuf);
+    /* Wrap the serialized buffer without copying it */
+    flatbuffers::DetachedBuffer *fb = new flatbuffers::DetachedBuffer (builder.Release ());
+
+    out_mem = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY, fb->data (),
+        fb->size (), 0, fb->size (), fb, fbd_free_buffer);
+    gst_buffer_append_memory (outbuf, out_mem);
+    return GST_FLOW_OK;
+  }
+
+  if (gst_buffer_get_size (outbuf) < fb_size) {
+    gst_buffer_set_size (outbuf, fb_size);
   }
+  out_mem = gst_buffer_get_all_memory (outbuf);
 
   if (!gst_memory_map (out_mem, &out_info, GST_MAP_WRITE)) {
     gst_memory_unref (out_mem);
@@ -167,11 +185,7 @@ fbd_decode (void **pdata, const GstTensorsConfig *config,
   memcpy (out_info.data, builder.GetBufferPointer (), fb_size);
 
   gst_memory_unmap (out_mem, &out_info);
-
-  if (gst_buffer_get_size (outbuf) == 0)
-    gst_buffer_append_memory (outbuf, out_mem);
-  else
-    gst_memory_unref (out_mem);
+  gst_memory_unref (out_mem);
 
   return GST_FLOW_OK;
 }
@@ -112,6 +112,13 @@ flxd_getOutCaps (void **pdata, const GstTensorsConfig *config)
   return caps;
 }
 
+/** @brief Release the builder having the serialized buffer wrapped in the output memory */
+static void
+flxd_free_builder (gpointer data)
+{
+  delete static_cast<flexbuffers::Builder *> (data);
+}
+
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
 static GstFlowReturn
 flxd_decode (void **pdata, const GstTensorsConfig *config,
@@ -120,9 +127,9 @@ flxd_decode (void **pdata, const GstTensorsConfig *config,
   GstMapInfo out_info;
   GstMemory *out_mem;
   guint i, num_tensors;
-  gboolean need_alloc;
   size_t flex_size;
-  flexbuffers::Builder fbb;
+  gsize reserved = 256;
+  flexbuffers::Builder *builder;
   gboolean is_flexible;
   GstTensorMetaInfo meta;
   GstTensorsConfig flxd_config;
@@ -136,6 +143,13 @@ flxd_decode (void **pdata, const GstTensorsConfig *config,
   is_flexible = gst_tensors_config_is_flexible (&flxd_config);
 
   num_tensors = flxd_config.info.num_tensors;
+
+  /* Reserve the whole message at once to avoid reallocation while building */
+  for (i = 0; i < num_tensors; i++)
+    reserved += input[i].size + 128;
+  builder = new flexbuffers::Builder (reserved);
+  flexbuffers::Builder &fbb = *builder;
+
   fbb.Map ([&]() {
     fbb.UInt ("num_tensors", num_tensors);
     fbb.Int ("rate_n", flxd_config.rate_n);
@@ -168,20 +182,25 @@ flxd_decode (void **pdata, const GstTensorsConfig *config,
   });
   fbb.Finish ();
   flex_size = fbb.GetSize ();
+  gst_tensors_config_free (&flxd_config);
 
-  need_alloc = (gst_buffer_get_size (outbuf) == 0);
+  if (gst_buffer_get_size (outbuf) == 0) {
+    /* Wrap the serialized buffer without copying it, the builder is released with the memory */
+    out_mem = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,
+        (gpointer) fbb.GetBuffer ().data (), flex_size, 0, flex_size, builder,
+        flxd_free_builder);
+    gst_buffer_append_memory (outbuf, out_mem);
+    return GST_FLOW_OK;
+  }
 
-  if (need_alloc) {
-    out_mem = gst_allocator_alloc (NULL, flex_size, NULL);
-  } else {
-    if (gst_buffer_get_size (outbuf) < flex_size) {
-      gst_buffer_set_size (outbuf, flex_size);
-    }
-    out_mem = gst_buffer_get_all_memory (outbuf);
+  if (gst_buffer_get_size (outbuf) < flex_size) {
+    gst_buffer_set_size (outbuf, flex_size);
   }
+  out_mem = gst_buffer_get_all_memory (outbuf);
 
   if (!gst_memory_map (out_mem, &out_info, GST_MAP_WRITE)) {
     gst_memory_unref (out_mem);
+    delete builder;
     nns_loge ("Cannot map gst memory (tensor decoder flexbuf)\n");
     return GST_FLOW_ERROR;
   }
@@ -189,11 +208,8 @@ flxd_decode (void **pdata, const GstTensorsConfig *config,
   memcpy (out_info.data, fbb.GetBuffer ().data (), flex_size);
 
   gst_memory_unmap (out_mem, &out_info);
-
-  if (need_alloc)
-    gst_buffer_append_memory (outbuf, out_mem);
-  else
-    gst_memory_unref (out_mem);
+  gst_memory_unref (out_mem);
+  delete builder;
 
   return GST_FLOW_OK;
 }
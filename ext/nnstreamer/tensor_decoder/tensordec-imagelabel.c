@@ -24,6 +24,12 @@
  * @author      MyungJoo Ham <myungjoo.ham@samsung.com>
  * @bug         No known bugs except for NYI items
  *
+ * option1: Location of label file
+ * option2: The number of labels with the highest scores (top-k), default is 1
+ *          The text output has a label per line, from the highest score.
+ * option3: Output type, default is text
+ *          Available : text (text/x-raw, the labels)
+ *          Available : tensor (other/tensors float32 2:k, index and score per row, from the highest score)
  */
 
 #include <stdio.h>
@@ -43,11 +49,31 @@ void fini_il (void) __attribute__ ((destructor));
 #define DECODER_IL_TEXT_CAPS_STR \
     "text/x-raw, format = (string) utf8"
 
+#define IL_DEFAULT_TOP_K  (1)
+#define IL_MAX_TOP_K      (1024)
+
+/** @brief Output types of image labeling */
+typedef enum
+{
+  IL_OUTPUT_TEXT = 0,
+  IL_OUTPUT_TENSOR = 1,
+  IL_OUTPUT_UNKNOWN,
+} il_output_types;
+
+/** @brief List of the output types in string */
+static const char *il_output_type_str[] = {
+  [IL_OUTPUT_TEXT] = "text",
+  [IL_OUTPUT_TENSOR] = "tensor",
+  NULL,
+};
+
 /** @brief Internal data structure for image labeling */
 typedef struct
 {
   imglabel_t labels;
   char *label_path;
+  guint top_k; /**< The number of labels to emit */
+  il_output_types output_type; /**< The output type */
 } ImageLabelData;
 
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
@@ -55,12 +81,17 @@ static int
 il_init (void **pdata)
 {
   /** @todo check if we need to ensure plugin_data is not yet allocated */
-  *pdata = g_new0 (ImageLabelData, 1);
+  ImageLabelData *data;
+
+  data = *pdata = g_new0 (ImageLabelData, 1);
   if (*pdata == NULL) {
     GST_ERROR ("Failed to allocate memory for decoder subplugin.");
     return FALSE;
   }
 
+  data->top_k = IL_DEFAULT_TOP_K;
+  data->output_type = IL_OUTPUT_TEXT;
+
   return TRUE;
 }
 
@@ -98,6 +129,26 @@ il_setOption (void **pdata, int opNum, const char *param)
       return TRUE;
     else
       return FALSE;
+  } else if (opNum == 1) {
+    guint64 k = g_ascii_strtoull (param, NULL, 10);
+
+    if (k == 0 || k > IL_MAX_TOP_K) {
+      GST_ERROR ("Invalid top-k %s at option2, it should be 1 ~ %d.",
+          GST_STR_NULL (param), IL_MAX_TOP_K);
+      return FALSE;
+    }
+    data->top_k = (guint) k;
+    return TRUE;
+  } else if (opNum == 2) {
+    int type = find_key_strv (il_output_type_str, param);
+
+    if (type < 0) {
+      GST_ERROR ("Unknown output type %s at option3, use text or tensor.",
+          GST_STR_NULL (param));
+      return FALSE;
+    }
+    data->output_type = (il_output_types) type;
+    return TRUE;
   }
 
   GST_INFO ("Property mode-option-%d is ignored", opNum + 1);
@@ -108,10 +159,10 @@ il_setOption (void **pdata, int opNum, const char *param)
 static GstCaps *
 il_getOutCaps (void **pdata, const GstTensorsConfig * config)
 {
+  ImageLabelData *data = *pdata;
   const uint32_t *dim;
   GstCaps *caps;
   int i;
-  UNUSED (pdata);
 
   g_return_val_if_fail (config != NULL, NULL);
   g_return_val_if_fail (config->info.num_tensors >= 1, NULL);
@@ -123,6 +174,24 @@ il_getOutCaps (void **pdata, const GstTensorsConfig * config)
   for (i = 2; i < NNS_TENSOR_RANK_LIMIT; i++)
     g_return_val_if_fail (dim[i] == 1, NULL);
 
+  if (data->output_type == IL_OUTPUT_TENSOR) {
+    GstTensorsConfig out_config;
+
+    gst_tensors_config_init (&out_config);
+    out_config.info.num_tensors = 1;
+    out_config.info.info[0].type = _NNS_FLOAT32;
+    out_config.info.info[0].dimension[0] = 2;
+    out_config.info.info[0].dimension[1] = MIN (data->top_k, dim[0]);
+    for (i = 2; i < NNS_TENSOR_RANK_LIMIT; i++)
+      out_config.info.info[0].dimension[i] = 1;
+    out_config.rate_n = config->rate_n;
+    out_config.rate_d = config->rate_d;
+
+    caps = gst_tensors_caps_from_config (&out_config);
+    gst_tensors_config_free (&out_config);
+    return caps;
+  }
+
   caps = gst_caps_from_string (DECODER_IL_TEXT_CAPS_STR);
   setFramerateFromConfig (caps, config);
   return caps;
@@ -144,28 +213,82 @@ il_getTransformSize (void **pdata, const GstTensorsConfig * config,
   /** @todo Use max_word_length if that's appropriate */
 }
 
-/** @brief Search for max. Macro for tensor_element union */
-#define search_max(type, i, max_index, max_val, bpe, data, num_data) \
-do {\
-  unsigned int i;\
-  type *cursor = (type *) (data);\
-  max_val = cursor[0];\
-  max_index = 0;\
-  for (i = 1; i < (num_data); i++) {\
-    if (cursor[i] > (max_val)) {\
-      max_val = cursor[i];\
-      max_index = i;\
-    }\
-  }\
-} while (0);
-
-/** @brief Shorter case statement for search_max */
-#define search_max_case(type, typename) \
+/**
+ * @brief Check the score of index a is lower than index b.
+ * With the same scores, the later one is lower (the first label wins as before).
+ */
+#define il_lower(cursor, a, b) \
+  ((cursor)[a] < (cursor)[b] || ((cursor)[a] == (cursor)[b] && (a) > (b)))
+
+/**
+ * @brief Define the function to select the top-k indices for the given type.
+ *
+ * The indices are selected with a min-heap of k entries (the lowest at the
+ * root), so a score is compared with the root only unless it is in the top-k.
+ * Then the selected indices are sorted from the highest score.
+ */
+#define il_define_topk(type) \
+static guint \
+_il_topk_##type (const void *data, gsize num_data, guint k, guint * top, \
+    gfloat * score) \
+{ \
+  const type *cursor = (const type *) data; \
+  guint n = 0, i, c, p, tmp; \
+  gsize idx; \
+  k = (guint) MIN ((gsize) k, num_data); \
+  for (idx = 0; idx < num_data; idx++) { \
+    if (n < k) { \
+      /* push and sift up */ \
+      c = n++; \
+      top[c] = (guint) idx; \
+      while (c > 0 && il_lower (cursor, top[c], top[(c - 1) / 2])) { \
+        p = (c - 1) / 2; \
+        tmp = top[c]; top[c] = top[p]; top[p] = tmp; \
+        c = p; \
+      } \
+    } else if (il_lower (cursor, top[0], idx)) { \
+      /* replace the root and sift down */ \
+      top[0] = (guint) idx; \
+      p = 0; \
+      while ((c = 2 * p + 1) < n) { \
+        if (c + 1 < n && il_lower (cursor, top[c + 1], top[c])) \
+          c++; \
+        if (!il_lower (cursor, top[c], top[p])) \
+          break; \
+        tmp = top[c]; top[c] = top[p]; top[p] = tmp; \
+        p = c; \
+      } \
+    } \
+  } \
+  /* sort k entries from the highest score */ \
+  for (i = 1; i < n; i++) { \
+    tmp = top[i]; \
+    for (c = i; c > 0 && il_lower (cursor, top[c - 1], tmp); c--) \
+      top[c] = top[c - 1]; \
+    top[c] = tmp; \
+  } \
+  for (i = 0; i < n; i++) \
+    score[i] = (gfloat) cursor[top[i]]; \
+  return n; \
+}
+
+il_define_topk (int32_t)
+il_define_topk (uint32_t)
+il_define_topk (int16_t)
+il_define_topk (uint16_t)
+il_define_topk (int8_t)
+il_define_topk (uint8_t)
+il_define_topk (double)
+il_define_topk (float)
+il_define_topk (int64_t)
+il_define_topk (uint64_t)
+
+/** @brief Shorter case statement for the top-k selection */
+#define il_topk_case(type, typename) \
 case typename:\
-  search_max(type, i, max_index, max_val._##type, bpe, input_data, num_data);\
+  num_top = _il_topk_##type (input_data, num_data, data->top_k, top, score);\
   break;
 
-
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
 static GstFlowReturn
 il_decode (void **pdata, const GstTensorsConfig * config,
@@ -176,13 +299,15 @@ il_decode (void **pdata, const GstTensorsConfig * config,
   GstMemory *out_mem;
 
   gsize bpe = gst_tensor_get_element_size (config->info.info[0].type);
-  tensor_element max_val;
-  guint max_index = 0;
+  guint *top;
+  gfloat *score;
+  guint i, num_top = 0;
   gsize num_data;               /* Size / bpe */
   void *input_data;
 
   gsize size;
-  char *str;
+  GString *str = NULL;
+  GstFlowReturn ret = GST_FLOW_OK;
 
   g_assert (bpe > 0);
   g_assert (outbuf);
@@ -190,29 +315,48 @@ il_decode (void **pdata, const GstTensorsConfig * config,
   input_data = input->data;
   num_data = gst_tensor_info_get_size (&config->info.info[0]) / bpe;
 
+  top = g_new (guint, data->top_k);
+  score = g_new (gfloat, data->top_k);
+
   switch (config->info.info[0].type) {
-      search_max_case (int32_t, _NNS_INT32);
-      search_max_case (uint32_t, _NNS_UINT32);
-      search_max_case (int16_t, _NNS_INT16);
-      search_max_case (uint16_t, _NNS_UINT16);
-      search_max_case (int8_t, _NNS_INT8);
-      search_max_case (uint8_t, _NNS_UINT8);
-      search_max_case (double, _NNS_FLOAT64);
-      search_max_case (float, _NNS_FLOAT32);
-      search_max_case (int64_t, _NNS_INT64);
-      search_max_case (uint64_t, _NNS_UINT64);
+      il_topk_case (int32_t, _NNS_INT32);
+      il_topk_case (uint32_t, _NNS_UINT32);
+      il_topk_case (int16_t, _NNS_INT16);
+      il_topk_case (uint16_t, _NNS_UINT16);
+      il_topk_case (int8_t, _NNS_INT8);
+      il_topk_case (uint8_t, _NNS_UINT8);
+      il_topk_case (double, _NNS_FLOAT64);
+      il_topk_case (float, _NNS_FLOAT32);
+      il_topk_case (int64_t, _NNS_INT64);
+      il_topk_case (uint64_t, _NNS_UINT64);
     default:
-      return GST_FLOW_NOT_SUPPORTED;
+      ret = GST_FLOW_NOT_SUPPORTED;
+      goto done;
   }
 
-  g_assert (max_index < data->labels.total_labels);
+  if (data->output_type == IL_OUTPUT_TENSOR) {
+    size = sizeof (gfloat) * 2 * num_top;
+  } else {
+    str = g_string_new (NULL);
+
+    for (i = 0; i < num_top; i++) {
+      const char *label;
 
-  /** @todo With option-2, allow to change output format */
-  str = data->labels.labels[max_index];
+      g_assert (top[i] < data->labels.total_labels);
 
-  if (!str || (size = strlen (str)) == 0) {
-    ml_loge ("Invalid labels. Please check the label data.");
-    return GST_FLOW_ERROR;
+      label = data->labels.labels[top[i]];
+      if (!label || *label == '\0') {
+        ml_loge ("Invalid labels. Please check the label data.");
+        ret = GST_FLOW_ERROR;
+        goto done;
+      }
+
+      if (i > 0)
+        g_string_append_c (str, '\n');
+      g_string_append (str, label);
+    }
+
+    size = str->len;
   }
 
   /* Ensure we have outbuf properly allocated */
@@ -228,10 +372,20 @@ il_decode (void **pdata, const GstTensorsConfig * config,
   if (!gst_memory_map (out_mem, &out_info, GST_MAP_WRITE)) {
     ml_loge ("Cannot map output memory / tensordec-imagelabel.\n");
     gst_memory_unref (out_mem);
-    return GST_FLOW_ERROR;
+    ret = GST_FLOW_ERROR;
+    goto done;
   }
 
-  memcpy (out_info.data, str, size);
+  if (data->output_type == IL_OUTPUT_TENSOR) {
+    gfloat *pairs = (gfloat *) out_info.data;
+
+    for (i = 0; i < num_top; i++) {
+      pairs[i * 2] = (gfloat) top[i];
+      pairs[i * 2 + 1] = score[i];
+    }
+  } else {
+    memcpy (out_info.data, str->str, size);
+  }
 
   gst_memory_unmap (out_mem, &out_info);
 
@@ -240,7 +394,13 @@ il_decode (void **pdata, const GstTensorsConfig * config,
   else
     gst_memory_unref (out_mem);
 
-  return GST_FLOW_OK;
+done:
+  if (str)
+    g_string_free (str, TRUE);
+  g_free (top);
+  g_free (score);
+
+  return ret;
 }
 
 static gchar decoder_subplugin_image_labeling[] = "image_labeling";
@@ -253,7 +413,8 @@ static GstTensorDecoderDef imageLabeling = {
   .setOption = il_setOption,
   .getOutCaps = il_getOutCaps,
   .getTransformSize = il_getTransformSize,
-  .decode = il_decode
+  .decode = il_decode,
+  .threadSafe = 1
 };
 
 /** @brief Initialize this object for tensordec-plugin */
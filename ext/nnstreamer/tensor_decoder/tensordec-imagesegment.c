@@ -34,6 +34,14 @@
  *
  * option2: Maximum number of class labels (except background), default is 20 (Pascal)
  *
+ * option3: Output type, default is rgba
+ *          Available : rgba (video/x-raw RGBA, each label is painted in its color)
+ *          Available : index (other/tensors uint8 1:width:height:1, label index of each pixel)
+ *          The index output is not available in snpe-depth mode and needs 255 labels or less.
+ *
+ * option4: Number of threads to decode the rows of tflite-deeplab, default is 1
+ *          (0 to use all the processors)
+ *
  * expected models
  * - tflite-deeplab : deeplabv3_257_mv_gpu.tflite (designed for embedded devices)
  * - snpe-deeplab   : deeplabv3_mnv2_pascal_train_aug.dlc (converted from a TF model)
@@ -82,6 +90,7 @@
 #include <nnstreamer_plugin_api.h>
 #include <nnstreamer_log.h>
 #include <nnstreamer_util.h>
+#include <tensor_kernels.h>
 #include "tensordecutil.h"
 
 #if defined(__aarch64__)
@@ -95,6 +104,7 @@
 #define DEFAULT_LABELS  (20)
 #define RGBA_CHANNEL    (4)
 #define MAX_RGB         (255)
+#define MAX_THREADS     (16)
 
 void init_is (void) __attribute__ ((constructor));
 void fini_is (void) __attribute__ ((destructor));
@@ -122,6 +132,25 @@ static const char *is_modes[] = {
   NULL,
 };
 
+/**
+ * @brief Output types of the decoded segmentation
+ */
+typedef enum
+{
+  OUTPUT_RGBA = 0,
+  OUTPUT_INDEX = 1,
+  OUTPUT_UNKNOWN,
+} image_segment_outputs;
+
+/**
+ * @brief List of the output types in string
+ */
+static const char *is_outputs[] = {
+  [OUTPUT_RGBA] = "rgba",
+  [OUTPUT_INDEX] = "index",
+  NULL,
+};
+
 /**
  * @brief Data structure for image segmentation info
  */
@@ -138,8 +167,117 @@ typedef struct
 
   GRand *rand;              /**< random value generator */
   guint rgb_modifier;       /**< rgb modifier according to # labels */
+
+  image_segment_outputs output; /**< The output type */
+  guint threads;            /**< Number of threads to decode the rows (0 for all processors) */
+  gboolean pool_ref;        /**< TRUE if the shared worker threads are referred */
 } image_segments;
 
+/**
+ * @brief Function to decode the rows [start, end) of tflite-deeplab.
+ */
+typedef void (*is_rows_func) (image_segments * idata, const float *input,
+    guint8 * output, guint start, guint end);
+
+/**
+ * @brief Data structure to wait for the rows pushed to the worker threads.
+ */
+typedef struct
+{
+  GMutex lock; /**< lock for pending */
+  GCond cond; /**< signalled when all rows are done */
+  guint pending; /**< the number of row ranges not finished */
+} is_parallel_job;
+
+/**
+ * @brief Data structure for the rows decoded in the worker thread.
+ */
+typedef struct
+{
+  is_parallel_job *job; /**< the job this range belongs to */
+  is_rows_func func; /**< function to decode the rows */
+  image_segments *idata; /**< decoder data */
+  const float *input; /**< label probabilities */
+  guint8 *output; /**< decoded output */
+  guint start; /**< the first row of the range */
+  guint end; /**< the end (exclusive) of the range */
+} is_parallel_rows;
+
+/**
+ * @brief Worker threads shared by all image segment decoders using the threads.
+ */
+static GThreadPool *is_pool = NULL;
+static guint is_pool_refcount = 0;
+G_LOCK_DEFINE_STATIC (is_pool);
+
+/**
+ * @brief Decode a row range in the worker thread.
+ */
+static void
+_is_pool_run (gpointer data, gpointer user_data)
+{
+  is_parallel_rows *rows = (is_parallel_rows *) data;
+  is_parallel_job *job = rows->job;
+
+  UNUSED (user_data);
+  rows->func (rows->idata, rows->input, rows->output, rows->start, rows->end);
+
+  g_mutex_lock (&job->lock);
+  if (--job->pending == 0)
+    g_cond_signal (&job->cond);
+  g_mutex_unlock (&job->lock);
+}
+
+/**
+ * @brief Get the shared worker threads (create the pool if it is not created yet).
+ */
+static void
+_is_pool_ref (image_segments * idata)
+{
+  GError *error = NULL;
+
+  if (idata->pool_ref)
+    return;
+
+  G_LOCK (is_pool);
+  if (is_pool_refcount++ == 0) {
+    is_pool = g_thread_pool_new (_is_pool_run, NULL,
+        MIN (g_get_num_processors (), MAX_THREADS), FALSE, &error);
+    if (!is_pool) {
+      GST_WARNING ("Failed to create the worker threads, decode in a single thread: %s",
+          error ? error->message : "unknown reason");
+      g_clear_error (&error);
+    }
+  }
+  G_UNLOCK (is_pool);
+
+  idata->pool_ref = TRUE;
+}
+
+/**
+ * @brief Release the shared worker threads.
+ */
+static void
+_is_pool_unref (image_segments * idata)
+{
+  GThreadPool *pool = NULL;
+
+  if (!idata->pool_ref)
+    return;
+
+  G_LOCK (is_pool);
+  if (is_pool_refcount > 0 && --is_pool_refcount == 0) {
+    pool = is_pool;
+    is_pool = NULL;
+  }
+  G_UNLOCK (is_pool);
+
+  if (pool)
+    g_thread_pool_free (pool, FALSE, TRUE);
+
+  idata->pool_ref = FALSE;
+}
+
 /** @brief tensordec-plugin's GstTensorDecoderDef callback */
 static int
 is_init (void **pdata)
@@ -160,6 +298,9 @@ is_init (void **pdata)
   idata->segment_map = NULL;
   idata->color_map = NULL;
   idata->rgb_modifier = 0;
+  idata->output = OUTPUT_RGBA;
+  idata->threads = 1;
+  idata->pool_ref = FALSE;
 
   return TRUE;
 }
@@ -183,6 +324,7 @@ is_exit (void **pdata)
 {
   image_segments *idata = *pdata;
 
+  _is_pool_unref (idata);
   _free_resources (idata);
 
   g_free (*pdata);
@@ -237,6 +379,27 @@ is_setOption (void **pdata, int op_num, const char *param)
     guint64 max_labels_64 = g_ascii_strtoll (param, NULL, 10);
     if (max_labels_64 != 0 && max_labels_64 <= UINT_MAX)
       idata->max_labels = (guint) max_labels_64;
+    return TRUE;
+  } else if (op_num == 2) {
+    int output = find_key_strv (is_outputs, param);
+
+    if (output < 0) {
+      GST_ERROR ("Unknown output type %s at option3, use rgba or index.",
+          GST_STR_NULL (param));
+      return FALSE;
+    }
+
+    idata->output = (image_segment_outputs) output;
+    return TRUE;
+  } else if (op_num == 3) {
+    guint64 threads = g_ascii_strtoull (param, NULL, 10);
+
+    idata->threads = (guint) MIN (threads, MAX_THREADS);
+    if (idata->threads != 1)
+      _is_pool_ref (idata);
+    else
+      _is_pool_unref (idata);
+    return TRUE;
   }
 
   GST_WARNING ("mode-option-\"%d\" is not definded.", op_num);
@@ -248,10 +411,7 @@ static gboolean
 _init_modes (image_segments * idata)
 {
   if (idata->mode == MODE_TFLITE_DEEPLAB) {
-    /* init image segments if seg map is null */
-    if (idata->segment_map == NULL)
-      idata->segment_map = g_new0 (float, idata->height * idata->width);
-
+    /* labels are decoded into the output directly, no segment map */
     if (idata->color_map == NULL) {
       idata->color_map = g_new (guint, idata->max_labels + 1);
       _fill_color_map (idata);
@@ -298,6 +458,32 @@ is_getOutCaps (void **pdata, const GstTensorsConfig * config)
     idata->height = config->info.info[0].dimension[2];
   }
 
+  if (idata->output == OUTPUT_INDEX) {
+    GstTensorsConfig out_config;
+    guint i;
+
+    if (idata->mode == MODE_SNPE_DEPTH || idata->max_labels > G_MAXUINT8) {
+      GST_ERROR ("The index output needs a deeplab mode with 255 labels or less.");
+      return NULL;
+    }
+
+    gst_tensors_config_init (&out_config);
+    out_config.info.num_tensors = 1;
+    out_config.info.info[0].type = _NNS_UINT8;
+    out_config.info.info[0].dimension[0] = 1;
+    out_config.info.info[0].dimension[1] = idata->width;
+    out_config.info.info[0].dimension[2] = idata->height;
+    for (i = 3; i < NNS_TENSOR_RANK_LIMIT; i++)
+      out_config.info.info[0].dimension[i] = 1;
+    out_config.rate_n = config->rate_n;
+    out_config.rate_d = config->rate_d;
+
+    caps = gst_tensors_caps_from_config (&out_config);
+    gst_tensors_config_free (&out_config);
+
+    return caps;
+  }
+
   str = g_strdup_printf ("video/x-raw, format = RGBA, "
       "width = %u, height = %u", idata->width, idata->height);
   caps = gst_caps_from_string (str);
@@ -393,42 +579,14 @@ set_color_according_to_label (image_segments * idata, GstMapInfo * out_info)
 static float
 find_max_grayscale (image_segments * idata)
 {
-  float *input = idata->segment_map;
-  float gray_max = 0.0;
-  guint num_pixels = idata->height * idata->width;
-  guint idx = 0;
-
-#if defined (NEON64_ENABLED)
-  float32x4_t v_src, v_max;
-  guint num_lanes = 4;
-
-  v_max = vdupq_n_f32 (0);
-
-  /* find the maximum value per lane */
-  for (idx = 0; idx < num_pixels; idx += num_lanes) {
-    v_src = vld1q_f32 (input);
-    input += num_lanes;
-
-    v_max = vmaxq_f32 (v_src, v_max);
-  }
-
-  /* find the maximum value among all lanes */
-  gray_max = MAX (gray_max, vgetq_lane_f32 (v_max, 0));
-  gray_max = MAX (gray_max, vgetq_lane_f32 (v_max, 1));
-  gray_max = MAX (gray_max, vgetq_lane_f32 (v_max, 2));
-  gray_max = MAX (gray_max, vgetq_lane_f32 (v_max, 3));
+  gsize num_pixels = (gsize) idata->height * idata->width;
+  float gray_max;
 
-  if (num_pixels == idx)
-    return gray_max;
+  /* the kernel for the running CPU, NaN is ignored */
+  gray_max = gst_tensor_kernels_get ()->f32_max (idata->segment_map,
+      num_pixels);
 
-  /* handle remaining data */
-  input = idata->segment_map;
-  idx -= num_lanes;
-#endif
-  for (; idx < num_pixels; idx++)
-    gray_max = MAX (gray_max, input[idx]);
-
-  return gray_max;
+  return MAX (gray_max, 0.0f);
 }
 
 /** @brief Set color with grayscale value */
@@ -507,35 +665,126 @@ set_color_grayscale (image_segments * idata, GstMapInfo * out_info)
   }
 }
 
-/** @brief Set label index according to each pixel's label probabilities */
+/**
+ * @brief Find the label with the maximum probability (the first one if there are the same values).
+ */
+static inline guint
+_find_max_label (const GstTensorKernels * kernels, const float *prob,
+    guint num, float *max_prob)
+{
+  return (guint) kernels->f32_argmax (prob, num, max_prob);
+}
+
+/** @brief Paint the rows [start, end) with the colors of the labels having the maximum probability (RGBA) */
 static void
-set_label_index (image_segments * idata, void *data)
+set_color_rows_from_prob (image_segments * idata, const float *input,
+    guint8 * output, guint start, guint end)
 {
-  float *prob_map = (float *) data;
-  guint idx, i, j;
-  int max_idx;
+  const guint total_labels = idata->max_labels + 1;
+  const float *prob = input + (gsize) start * idata->width * total_labels;
+  uint32_t *out = (uint32_t *) output + (gsize) start * idata->width;
+  gsize idx, num_pixels = (gsize) (end - start) * idata->width;
+  const GstTensorKernels *kernels = gst_tensor_kernels_get ();
   float max_prob;
-  guint total_labels = idata->max_labels + 1;
-
-  memset (idata->segment_map, '\x00',
-      (size_t) idata->width * idata->height * sizeof (float));
-
-  for (i = 0; i < idata->height; i++) {
-    for (j = 0; j < idata->width; j++) {
-      max_idx = 0;
-      max_prob = prob_map[i * idata->width * total_labels + j * total_labels];
-      for (idx = 1; idx < total_labels; idx++) {
-        float prob = prob_map[i * idata->width * total_labels
-            + j * total_labels + idx];
-        if (prob > max_prob) {
-          max_prob = prob;
-          max_idx = idx;
-        }
-      }
-      if (max_prob > DETECTION_THRESHOLD) {
-        idata->segment_map[i * idata->width + j] = (float) max_idx;
-      }                         /* otherwise, regarded as background */
-    }
+  guint label;
+
+  for (idx = 0; idx < num_pixels; idx++, prob += total_labels) {
+    label = _find_max_label (kernels, prob, total_labels, &max_prob);
+
+    /* otherwise, regarded as background */
+    out[idx] = (max_prob > DETECTION_THRESHOLD) ? idata->color_map[label] : 0;
+  }
+}
+
+/** @brief Write the rows [start, end) with the labels having the maximum probability (uint8 index) */
+static void
+set_index_rows_from_prob (image_segments * idata, const float *input,
+    guint8 * output, guint start, guint end)
+{
+  const guint total_labels = idata->max_labels + 1;
+  const float *prob = input + (gsize) start * idata->width * total_labels;
+  guint8 *out = output + (gsize) start * idata->width;
+  gsize idx, num_pixels = (gsize) (end - start) * idata->width;
+  const GstTensorKernels *kernels = gst_tensor_kernels_get ();
+  float max_prob;
+  guint label;
+
+  for (idx = 0; idx < num_pixels; idx++, prob += total_labels) {
+    label = _find_max_label (kernels, prob, total_labels, &max_prob);
+    out[idx] = (max_prob > DETECTION_THRESHOLD) ? (guint8) label : 0;
+  }
+}
+
+/**
+ * @brief Split the rows across the worker threads and wait for all rows.
+ *
+ * The caller thread decodes the first range. If the threads are disabled,
+ * func is called once with all rows.
+ */
+static void
+decode_rows_parallel (image_segments * idata, const float *input,
+    guint8 * output, is_rows_func func)
+{
+  is_parallel_rows rows[MAX_THREADS];
+  is_parallel_job job;
+  GThreadPool *pool;
+  guint i, n;
+
+  n = (idata->threads == 0) ? g_get_num_processors () : idata->threads;
+  n = MIN (n, MAX_THREADS);
+  n = MIN (n, idata->height);
+
+  G_LOCK (is_pool);
+  pool = is_pool;
+  G_UNLOCK (is_pool);
+
+  if (n <= 1 || pool == NULL) {
+    func (idata, input, output, 0, idata->height);
+    return;
+  }
+
+  g_mutex_init (&job.lock);
+  g_cond_init (&job.cond);
+  job.pending = n - 1;
+
+  for (i = 0; i < n; i++) {
+    rows[i].job = &job;
+    rows[i].func = func;
+    rows[i].idata = idata;
+    rows[i].input = input;
+    rows[i].output = output;
+    rows[i].start = idata->height * i / n;
+    rows[i].end = idata->height * (i + 1) / n;
+
+    if (i > 0)
+      g_thread_pool_push (pool, &rows[i], NULL);
+  }
+
+  func (idata, input, output, rows[0].start, rows[0].end);
+
+  g_mutex_lock (&job.lock);
+  while (job.pending > 0)
+    g_cond_wait (&job.cond, &job.lock);
+  g_mutex_unlock (&job.lock);
+
+  g_mutex_clear (&job.lock);
+  g_cond_clear (&job.cond);
+}
+
+/** @brief Write the label index of each pixel (snpe-deeplab) */
+static void
+set_index_according_to_label (image_segments * idata, GstMapInfo * out_info)
+{
+  const float *input = idata->segment_map;
+  guint8 *output = out_info->data;
+  gsize idx, num_pixels = (gsize) idata->height * idata->width;
+  guint label_idx;
+
+  for (idx = 0; idx < num_pixels; idx++) {
+    label_idx = (guint) input[idx];
+
+    /* If out-of-range, regarded as background */
+    output[idx] = (label_idx > idata->max_labels) ? 0 : (guint8) label_idx;
   }
 }
 
@@ -543,20 +792,25 @@ set_label_index (image_segments * idata, void *data)
 static void
 set_color (image_segments * idata, void *data, GstMapInfo * out_info)
 {
-  /* tflite-deeplab needs to perform extra post-processing to set labels */
+  /* tflite-deeplab finds the label and writes the output in a single pass */
   if (idata->mode == MODE_TFLITE_DEEPLAB) {
-    set_label_index (idata, data);
-    set_color_according_to_label (idata, out_info);
+    decode_rows_parallel (idata, (const float *) data, out_info->data,
+        (idata->output == OUTPUT_INDEX) ?
+        set_index_rows_from_prob : set_color_rows_from_prob);
     return;
   }
 
   /* snpe-deeplab already has labeled data as input */
   idata->segment_map = data;
 
-  if (idata->mode == MODE_SNPE_DEEPLAB)
-    set_color_according_to_label (idata, out_info);
-  else if (idata->mode == MODE_SNPE_DEPTH)
+  if (idata->mode == MODE_SNPE_DEEPLAB) {
+    if (idata->output == OUTPUT_INDEX)
+      set_index_according_to_label (idata, out_info);
+    else
+      set_color_according_to_label (idata, out_info);
+  } else if (idata->mode == MODE_SNPE_DEPTH) {
     set_color_grayscale (idata, out_info);
+  }
 
   idata->segment_map = NULL;
 }
@@ -584,7 +838,8 @@ is_decode (void **pdata, const GstTensorsConfig * config,
     const GstTensorMemory * input, GstBuffer * outbuf)
 {
   image_segments *idata = *pdata;
-  const size_t size = (size_t) idata->width * idata->height * RGBA_CHANNEL;
+  const size_t size = (size_t) idata->width * idata->height *
+      ((idata->output == OUTPUT_INDEX) ? 1 : RGBA_CHANNEL);
   gboolean need_output_alloc;
   GstMapInfo out_info;
   GstMemory *out_mem;
@@ -606,7 +861,9 @@ is_decode (void **pdata, const GstTensorsConfig * config,
     goto error_free;
   }
 
-  memset (out_info.data, '\x00', size);
+  /* tflite-deeplab writes all pixels */
+  if (idata->mode != MODE_TFLITE_DEEPLAB)
+    memset (out_info.data, '\x00', size);
 
   if (!check_sanity (idata, config)) {
     ml_loge ("Invalid input data format detected.\n");
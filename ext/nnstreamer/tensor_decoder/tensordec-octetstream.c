@@ -102,6 +102,52 @@ os_decode (void **pdata, const GstTensorsConfig * config,
   return GST_FLOW_OK;
 }
 
+/** @brief tensordec-plugin's GstTensorDecoderDef callback */
+static GstFlowReturn
+os_decodeMemory (void **pdata, const GstTensorsConfig * config,
+    GstMemory ** input, guint num_tensors, GstBuffer * outbuf)
+{
+  guint i;
+  gboolean is_flexible;
+  GstTensorMetaInfo meta;
+  gsize offset[NNS_TENSOR_SIZE_LIMIT], data_size[NNS_TENSOR_SIZE_LIMIT];
+  UNUSED (pdata);
+
+  if (!config || !input || !outbuf || gst_buffer_get_size (outbuf) > 0 ||
+      num_tensors < config->info.num_tensors)
+    return GST_FLOW_NOT_SUPPORTED;
+
+  is_flexible = gst_tensors_config_is_flexible (config);
+
+  /* check all tensors before updating outbuf */
+  for (i = 0; i < config->info.num_tensors; i++) {
+    if (GST_MEMORY_FLAG_IS_SET (input[i], GST_MEMORY_FLAG_NO_SHARE))
+      return GST_FLOW_NOT_SUPPORTED;
+
+    if (is_flexible) {
+      if (!gst_tensor_meta_info_parse_memory (&meta, input[i]))
+        return GST_FLOW_NOT_SUPPORTED;
+
+      offset[i] = gst_tensor_meta_info_get_header_size (&meta);
+      data_size[i] = gst_tensor_meta_info_get_data_size (&meta);
+    } else {
+      offset[i] = 0;
+      data_size[i] = gst_tensors_info_get_size (&config->info, i);
+    }
+
+    if (gst_memory_get_sizes (input[i], NULL, NULL) < offset[i] + data_size[i])
+      return GST_FLOW_NOT_SUPPORTED;
+  }
+
+  /* The octet stream is the data of the tensors, share the input memory. */
+  for (i = 0; i < config->info.num_tensors; i++) {
+    gst_buffer_append_memory (outbuf,
+        gst_memory_share (input[i], offset[i], data_size[i]));
+  }
+
+  return GST_FLOW_OK;
+}
+
 static gchar decoder_subplugin_octet_stream[] = "octet_stream";
 
 /** @brief octet stream tensordec-plugin GstTensorDecoderDef instance */
@@ -112,7 +158,9 @@ static GstTensorDecoderDef octetSTream = {
   .setOption = os_setOption,
   .getOutCaps = os_getOutCaps,
   .getTransformSize = NULL,
-  .decode = os_decode
+  .decode = os_decode,
+  .decodeMemory = os_decodeMemory,
+  .threadSafe = 1
 };
 
 /** @brief Initialize this object for tensordec-plugin */
@@ -72,6 +72,16 @@
  *   			Tensor[1]: #labels x 2: width : height (float32, Offset position within heatmap grid)
  *	                    	(e.g., 34 x 9 x 9 )
  *
+ * option5: Maximum number of persons (optional, default is 1)
+ *      With 1, the peak of each keypoint heatmap is the keypoint of the person.
+ *      With more persons, the local maxima of the heatmaps (probability > 0.5)
+ *      are the candidates. From the strongest candidate, a person is grown by
+ *      following the body connections with the nearest candidates.
+ *
+ * option6: NMS radius in the output video pixels (optional, default is 20)
+ *      A candidate within the radius of the same keypoint of a found person
+ *      does not start a new person.
+ *
  * Pipeline:
  * 	v4l2src
  * 	   |
@@ -109,6 +119,12 @@
 #include <nnstreamer_util.h>
 #include "tensordecutil.h"
 
+#if defined(__aarch64__)
+#include <arm_neon.h>
+
+#define NEON64_ENABLED
+#endif
+
 void init_pose (void) __attribute__ ((constructor));
 void finish_pose (void) __attribute__ ((destructor));
 
@@ -120,6 +136,11 @@ extern uint8_t rasters[][13];
 #define POSE_MD_MAX_LABEL_SZ 16
 #define POSE_MD_MAX_CONNECTIONS_SZ 8
 
+#define POSE_DEFAULT_MAX_PERSONS  (1)
+#define POSE_DEFAULT_NMS_RADIUS   (20)
+#define POSE_SCORE_THRESHOLD      (0.5f)
+#define POSE_LOCAL_MAXIMUM_RADIUS (1)
+
 /**
  * @brief Macro for calculating sigmoid
  */
@@ -215,6 +236,12 @@ typedef struct
 
   /* From option4 */
   pose_modes mode; /**< The pose estimation decoding mode */
+
+  /* From option5 */
+  guint max_persons; /**< Maximum number of persons */
+
+  /* From option6 */
+  guint nms_radius; /**< NMS radius of the keypoints (output video pixels) */
 } pose_data;
 
 /**
@@ -336,6 +363,8 @@ pose_init (void **pdata)
   data->total_labels = POSE_SIZE_DEFAULT;
 
   data->mode = HEATMAP_ONLY;
+  data->max_persons = POSE_DEFAULT_MAX_PERSONS;
+  data->nms_radius = POSE_DEFAULT_NMS_RADIUS;
 
   initSingleLineSprite (singleLineSprite, rasters, PIXEL_VALUE);
 
@@ -419,6 +448,27 @@ pose_setOption (void **pdata, int opNum, const char *param)
     }
     data->mode = mode;
 
+    return TRUE;
+  } else if (opNum == 4) {
+    guint64 val = g_ascii_strtoull (param, NULL, 10);
+
+    if (val == 0 || val > G_MAXUINT16) {
+      GST_ERROR ("Invalid maximum number of persons %s at option5.",
+          GST_STR_NULL (param));
+      return FALSE;
+    }
+    data->max_persons = (guint) val;
+
+    return TRUE;
+  } else if (opNum == 5) {
+    guint64 val = g_ascii_strtoull (param, NULL, 10);
+
+    if (val > G_MAXUINT16) {
+      GST_ERROR ("Invalid NMS radius %s at option6.", GST_STR_NULL (param));
+      return FALSE;
+    }
+    data->nms_radius = (guint) val;
+
     return TRUE;
   }
 
@@ -634,12 +684,10 @@ draw_line_with_dot (uint32_t * frame, pose_data * data, int x1, int y1, int x2,
 static void
 draw_label (uint32_t * frame, pose_data * data, pose * xydata)
 {
-  int x1, y1, x2, y2;
-  uint32_t *pos1, *pos2;
-
-  guint i, j, label_len;
+  int x1, y1;
+  guint i;
   guint pose_size = data->total_labels;
-  char *label;
+
   for (i = 0; i < pose_size; i++) {
     if (xydata[i].valid) {
       pose_metadata_t *md = pose_get_metadata_by_id (data, i);
@@ -647,24 +695,9 @@ draw_label (uint32_t * frame, pose_data * data, pose * xydata)
       y1 = xydata[i].y;
       if (md == NULL)
         continue;
-      label = md->label;
-      label_len = strlen (label);
       y1 = MAX (0, (y1 - 14));
-      pos1 = &frame[y1 * data->width + x1];
-      for (j = 0; j < label_len; j++) {
-        unsigned int char_index = label[j];
-        if ((x1 + 8) > (int) data->width)
-          break;
-        pos2 = pos1;
-        for (y2 = 0; y2 < 13; y2++) {
-          for (x2 = 0; x2 < 8; x2++) {
-            *(pos2 + x2) = singleLineSprite[char_index][y2][x2];
-          }
-          pos2 += data->width;
-        }
-        x1 += 9;
-        pos1 += 9;
-      }
+      drawSingleLineText (frame, data->width, x1, y1, md->label,
+          singleLineSprite);
     }
   }
 }
@@ -673,10 +706,10 @@ draw_label (uint32_t * frame, pose_data * data, pose * xydata)
  * @brief Draw with the given results (pose) to the output buffer
  * @param[out] out_info The output buffer (RGBA plain)
  * @param[in] bdata The bouding-box internal data.
- * @param[in] results The final results to be drawn.
+ * @param[in] results The final results (pose_size keypoints of a person) to be drawn.
  */
 static void
-draw (GstMapInfo * out_info, pose_data * data, GArray * results)
+draw (GstMapInfo * out_info, pose_data * data, pose * results)
 {
   guint i;
   gint j;
@@ -690,7 +723,7 @@ draw (GstMapInfo * out_info, pose_data * data, GArray * results)
   }
 
   for (i = 0; i < pose_size; i++) {
-    XYdata[i] = &g_array_index (results, pose, i);
+    XYdata[i] = &results[i];
     if (XYdata[i]->prob < 0.5) {
       XYdata[i]->valid = FALSE;
     }
@@ -721,6 +754,297 @@ draw (GstMapInfo * out_info, pose_data * data, GArray * results)
   g_free (XYdata);
 }
 
+/**
+ * @brief Find the peak of each keypoint heatmap in a single pass over the grid.
+ * @param[in] arr The heatmap (keypoint is the innermost axis)
+ * @param[in] num_kp The number of keypoints
+ * @param[in] num_cells The number of grid cells (width x height)
+ * @param[in] init The initial maximum, a cell should be larger than this
+ * @param[out] max_val The maximum of each keypoint
+ * @param[out] max_idx The cell of the maximum (the first one if there are the same values)
+ */
+static void
+pose_find_peaks (const float *arr, guint num_kp, guint num_cells, float init,
+    float *max_val, guint32 * max_idx)
+{
+  guint c, k;
+
+  for (k = 0; k < num_kp; k++) {
+    max_val[k] = init;
+    max_idx[k] = 0;
+  }
+
+  for (c = 0; c < num_cells; c++, arr += num_kp) {
+    k = 0;
+#if defined (NEON64_ENABLED)
+    {
+      uint32x4_t v_cell = vdupq_n_u32 (c);
+
+      for (; k + 4 <= num_kp; k += 4) {
+        float32x4_t v_val = vld1q_f32 (arr + k);
+        float32x4_t v_max = vld1q_f32 (max_val + k);
+        uint32x4_t v_gt = vcgtq_f32 (v_val, v_max);
+
+        vst1q_f32 (max_val + k, vbslq_f32 (v_gt, v_val, v_max));
+        vst1q_u32 (max_idx + k, vbslq_u32 (v_gt, v_cell,
+                vld1q_u32 (max_idx + k)));
+      }
+    }
+#endif
+    /* branchless to be vectorized by the compiler */
+    for (; k < num_kp; k++) {
+      const gboolean gt = (arr[k] > max_val[k]);
+
+      max_val[k] = gt ? arr[k] : max_val[k];
+      max_idx[k] = gt ? c : max_idx[k];
+    }
+  }
+}
+
+/**
+ * @brief Set the position of a keypoint in the output video from its grid cell.
+ */
+static void
+pose_set_position (pose_data * data, const GstTensorMemory * input,
+    guint index, int gridX, int gridY, int grid_xsize, int grid_ysize,
+    pose * p)
+{
+  guint pose_size = data->total_labels;
+
+  if (data->mode == HEATMAP_OFFSET) {
+    const gfloat *offset = ((const GstTensorMemory *) &input[1])->data;
+    gfloat offsetX, offsetY, posX, posY;
+    int offsetIdx;
+    offsetIdx = (gridY * grid_xsize + gridX) * pose_size * 2 + index;
+    offsetY = offset[offsetIdx];
+    offsetX = offset[offsetIdx + pose_size];
+    posX = (((gfloat) gridX) / (grid_xsize - 1)) * data->i_width + offsetX;
+    posY = (((gfloat) gridY) / (grid_ysize - 1)) * data->i_height + offsetY;
+    p->x = posX * data->width / data->i_width;
+    p->y = posY * data->height / data->i_height;
+
+  } else {
+    p->x = (gridX * data->width) / data->i_width;
+    p->y = (gridY * data->height) / data->i_height;;
+  }
+  /* Some keypoints can be estimated slightly out of image range */
+  p->x = MIN (data->width, (guint) (MAX (0, p->x)));
+  p->y = MIN (data->height, (guint) (MAX (0, p->y)));
+}
+
+/**
+ * @brief Decode a person with the peak of each keypoint heatmap.
+ */
+static void
+pose_decode_single (pose_data * data, const GstTensorMemory * input,
+    int grid_xsize, int grid_ysize, GArray * results)
+{
+  guint pose_size = data->total_labels;
+  float *max_val = g_new (float, pose_size);
+  guint32 *max_idx = g_new (guint32, pose_size);
+  guint index;
+
+  /**
+   * The sigmoid is monotonic, so find the peaks with the raw values and
+   * calculate the probability of the peaks only.
+   */
+  pose_find_peaks ((const float *) input[0].data, pose_size,
+      grid_xsize * grid_ysize,
+      (data->mode == HEATMAP_OFFSET) ? -G_MAXFLOAT : G_MINFLOAT,
+      max_val, max_idx);
+
+  for (index = 0; index < pose_size; index++) {
+    pose p;
+
+    p.valid = TRUE;
+    p.prob = (data->mode == HEATMAP_OFFSET) ?
+        _sigmoid (max_val[index]) : max_val[index];
+    pose_set_position (data, input, index, max_idx[index] % grid_xsize,
+        max_idx[index] / grid_xsize, grid_xsize, grid_ysize, &p);
+
+    g_array_append_val (results, p);
+  }
+
+  g_free (max_val);
+  g_free (max_idx);
+}
+
+/** @brief A local maximum of a keypoint heatmap */
+typedef struct
+{
+  guint keypoint; /**< The keypoint id */
+  gfloat score; /**< The probability */
+  gboolean used; /**< TRUE if a person has this candidate */
+  pose pos; /**< The position in the output video */
+} pose_peak;
+
+/** @brief Compare the peaks to sort them in descending order of the score */
+static gint
+pose_compare_peak (gconstpointer a, gconstpointer b)
+{
+  const pose_peak *pa = (const pose_peak *) a;
+  const pose_peak *pb = (const pose_peak *) b;
+
+  if (pa->score > pb->score)
+    return -1;
+  return (pa->score < pb->score) ? 1 : 0;
+}
+
+/**
+ * @brief Find the local maxima of the keypoint heatmaps over the threshold.
+ * @return The candidates sorted in descending order of the score. Caller should free it.
+ */
+static GArray *
+pose_find_local_peaks (pose_data * data, const GstTensorMemory * input,
+    int grid_xsize, int grid_ysize)
+{
+  const float *arr = (const float *) input[0].data;
+  const guint pose_size = data->total_labels;
+  /* sigmoid (x) > 0.5 if x > 0 */
+  const float threshold = (data->mode == HEATMAP_OFFSET) ?
+      0.0f : POSE_SCORE_THRESHOLD;
+  const int r = POSE_LOCAL_MAXIMUM_RADIUS;
+  GArray *peaks = g_array_new (FALSE, FALSE, sizeof (pose_peak));
+  int x, y, nx, ny;
+  guint k;
+
+  for (y = 0; y < grid_ysize; y++) {
+    for (x = 0; x < grid_xsize; x++) {
+      const float *cell = arr + ((gsize) y * grid_xsize + x) * pose_size;
+
+      for (k = 0; k < pose_size; k++) {
+        gboolean is_max = (cell[k] > threshold);
+        pose_peak peak;
+
+        for (ny = MAX (0, y - r); is_max && ny <= MIN (grid_ysize - 1, y + r);
+            ny++) {
+          for (nx = MAX (0, x - r); nx <= MIN (grid_xsize - 1, x + r); nx++) {
+            if (arr[((gsize) ny * grid_xsize + nx) * pose_size + k] > cell[k]) {
+              is_max = FALSE;
+              break;
+            }
+          }
+        }
+
+        if (!is_max)
+          continue;
+
+        peak.keypoint = k;
+        peak.score = (data->mode == HEATMAP_OFFSET) ?
+            _sigmoid (cell[k]) : cell[k];
+        peak.used = FALSE;
+        peak.pos.valid = TRUE;
+        peak.pos.prob = peak.score;
+        pose_set_position (data, input, k, x, y, grid_xsize, grid_ysize,
+            &peak.pos);
+        g_array_append_val (peaks, peak);
+      }
+    }
+  }
+
+  g_array_sort (peaks, pose_compare_peak);
+  return peaks;
+}
+
+/** @brief Get the squared distance of two keypoints */
+static inline gint64
+pose_distance_sq (const pose * a, const pose * b)
+{
+  gint64 dx = a->x - b->x;
+  gint64 dy = a->y - b->y;
+
+  return dx * dx + dy * dy;
+}
+
+/**
+ * @brief Decode the persons from the local maxima of the keypoint heatmaps.
+ * @return The number of persons appended to the results.
+ */
+static guint
+pose_decode_multi (pose_data * data, const GstTensorMemory * input,
+    int grid_xsize, int grid_ysize, GArray * results)
+{
+  const guint pose_size = data->total_labels;
+  const gint64 radius_sq = (gint64) data->nms_radius * data->nms_radius;
+  GArray *peaks;
+  guint *queue;
+  guint i, j, n, num_persons = 0;
+
+  peaks = pose_find_local_peaks (data, input, grid_xsize, grid_ysize);
+  queue = g_new (guint, pose_size);
+
+  for (i = 0; i < peaks->len && num_persons < data->max_persons; i++) {
+    pose_peak *root = &g_array_index (peaks, pose_peak, i);
+    pose *person;
+    guint head = 0, tail = 0;
+    gboolean suppressed = FALSE;
+
+    if (root->used)
+      continue;
+
+    /* the same keypoint of a found person is near */
+    for (n = 0; n < num_persons && !suppressed; n++) {
+      const pose *p = &g_array_index (results, pose, n * pose_size
+          + root->keypoint);
+      suppressed = p->valid && pose_distance_sq (p, &root->pos) <= radius_sq;
+    }
+    if (suppressed)
+      continue;
+
+    g_array_set_size (results, (num_persons + 1) * pose_size);
+    person = &g_array_index (results, pose, num_persons * pose_size);
+    memset (person, 0, sizeof (pose) * pose_size);
+
+    root->used = TRUE;
+    person[root->keypoint] = root->pos;
+    queue[tail++] = root->keypoint;
+
+    /* follow the body connections with the nearest candidates */
+    while (head < tail) {
+      guint parent = queue[head++];
+      pose_metadata_t *md = pose_get_metadata_by_id (data, parent);
+
+      if (md == NULL)
+        continue;
+
+      for (j = 0; j < (guint) md->num_connections; j++) {
+        guint k = md->connections[j];
+        pose_peak *best = NULL;
+        gint64 best_dist = G_MAXINT64;
+
+        if (k >= pose_size || person[k].valid)
+          continue;
+
+        for (n = 0; n < peaks->len; n++) {
+          pose_peak *cand = &g_array_index (peaks, pose_peak, n);
+          gint64 dist;
+
+          if (cand->used || cand->keypoint != k)
+            continue;
+
+          dist = pose_distance_sq (&cand->pos, &person[parent]);
+          if (dist < best_dist) {
+            best_dist = dist;
+            best = cand;
+          }
+        }
+
+        if (best) {
+          best->used = TRUE;
+          person[k] = best->pos;
+          queue[tail++] = k;
+        }
+      }
+    }
+
+    num_persons++;
+  }
+
+  g_free (queue);
+  g_array_free (peaks, TRUE);
+  return num_persons;
+}
+
 /** @brief tensordec-plugin's TensorDecDef callback */
 static GstFlowReturn
 pose_decode (void **pdata, const GstTensorsConfig * config,
@@ -731,11 +1055,8 @@ pose_decode (void **pdata, const GstTensorsConfig * config,
   GstMapInfo out_info;
   GstMemory *out_mem;
   GArray *results = NULL;
-  const GstTensorMemory *detections = NULL;
-  float *arr;
-  int i, j;
   int grid_xsize, grid_ysize;
-  guint pose_size, index;
+  guint pose_size, num_persons, i;
 
   g_assert (outbuf); /** GST Internal Bug */
   /* Ensure we have outbuf properly allocated */
@@ -761,53 +1082,17 @@ pose_decode (void **pdata, const GstTensorsConfig * config,
   grid_ysize = config->info.info[0].dimension[2];
 
   results = g_array_sized_new (FALSE, TRUE, sizeof (pose), pose_size);
-  detections = &input[0];
-  arr = detections->data;
-  for (index = 0; index < pose_size; index++) {
-    int maxX = 0;
-    int maxY = 0;
-    float max = G_MINFLOAT;
-    pose p;
-    for (j = 0; j < grid_ysize; j++) {
-      for (i = 0; i < grid_xsize; i++) {
-        float cen = arr[i * pose_size + j * grid_xsize * pose_size + index];
-        if (data->mode == HEATMAP_OFFSET) {
-          cen = _sigmoid (cen);
-        }
-        if (cen > max) {
-          max = cen;
-          maxX = i;
-          maxY = j;
-        }
-      }
-    }
-
-    p.valid = TRUE;
-    p.prob = max;
-    if (data->mode == HEATMAP_OFFSET) {
-      const gfloat *offset = ((const GstTensorMemory *) &input[1])->data;
-      gfloat offsetX, offsetY, posX, posY;
-      int offsetIdx;
-      offsetIdx = (maxY * grid_xsize + maxX) * pose_size * 2 + index;
-      offsetY = offset[offsetIdx];
-      offsetX = offset[offsetIdx + pose_size];
-      posX = (((gfloat) maxX) / (grid_xsize - 1)) * data->i_width + offsetX;
-      posY = (((gfloat) maxY) / (grid_ysize - 1)) * data->i_height + offsetY;
-      p.x = posX * data->width / data->i_width;
-      p.y = posY * data->height / data->i_height;
-
-    } else {
-      p.x = (maxX * data->width) / data->i_width;
-      p.y = (maxY * data->height) / data->i_height;;
-    }
-    /* Some keypoints can be estimated slightly out of image range */
-    p.x = MIN (data->width, (guint) (MAX (0, p.x)));
-    p.y = MIN (data->height, (guint) (MAX (0, p.y)));
-
-    g_array_append_val (results, p);
+  if (data->max_persons > 1) {
+    num_persons = pose_decode_multi (data, input, grid_xsize, grid_ysize,
+        results);
+  } else {
+    pose_decode_single (data, input, grid_xsize, grid_ysize, results);
+    num_persons = 1;
   }
 
-  draw (&out_info, data, results);
+  for (i = 0; i < num_persons; i++)
+    draw (&out_info, data, &g_array_index (results, pose, i * pose_size));
+
   g_array_free (results, TRUE);
   gst_memory_unmap (out_mem, &out_info);
   if (gst_buffer_get_size (outbuf) == 0)
@@ -61,6 +61,9 @@ class PYDecoderCore
   const std::string script_path;
   PyObject *shape_cls;
   PyObject *core_obj;
+  PyTensorViews input_views; /**< the persistent arrays of the input tensors */
+  PyObject *shape_list; /**< the list of TensorShape of in_info */
+  GstTensorsInfo shape_info; /**< the tensors info of shape_list */
   void *handle; /**< returned handle by dlopen() */
   GMutex py_mutex;
 };
@@ -97,6 +100,9 @@ PYDecoderCore::PYDecoderCore (const char *_script_path)
 
   core_obj = NULL;
   shape_cls = NULL;
+  shape_list = NULL;
+  PyTensorViews_Init (&input_views);
+  gst_tensors_info_init (&shape_info);
 
   g_mutex_init (&py_mutex);
 }
@@ -109,6 +115,9 @@ PYDecoderCore::~PYDecoderCore ()
 {
   Py_SAFEDECREF (core_obj);
   Py_SAFEDECREF (shape_cls);
+  Py_SAFEDECREF (shape_list);
+  PyTensorViews_Clear (&input_views);
+  gst_tensors_info_free (&shape_info);
   PyErr_Clear ();
 
   dlclose (handle);
@@ -132,21 +141,38 @@ PYDecoderCore::decode (const GstTensorsConfig *config,
   GstFlowReturn ret = GST_FLOW_OK;
 
   Py_LOCK ();
-  raw_data = PyList_New (config->info.num_tensors);
-  in_info = PyList_New (config->info.num_tensors);
   rate_n = config->rate_n;
   rate_d = config->rate_d;
 
+  raw_data = PyTensorViews_Prepare (&input_views, config->info.num_tensors);
+  if (nullptr == raw_data) {
+    ret = GST_FLOW_ERROR;
+    goto done;
+  }
+
   for (unsigned int i = 0; i < config->info.num_tensors; i++) {
-    tensor_type nns_type = config->info.info[i].type;
-    npy_intp input_dims[] = { (npy_intp) (input[i].size / gst_tensor_get_element_size (nns_type)) };
-    PyObject *input_array = PyArray_SimpleNewFromData (
-        1, input_dims, getNumpyType (nns_type), input[i].data);
-    PyList_SetItem (raw_data, i, input_array);
-
-    PyObject *shape = PyTensorShape_New (shape_cls, &config->info.info[i]);
-    PyList_SetItem (in_info, i, shape);
+    if (PyTensorViews_Set (&input_views, i, config->info.info[i].type,
+            input[i].data, input[i].size) != 0) {
+      ret = GST_FLOW_ERROR;
+      goto done;
+    }
+  }
+
+  /** the shapes are created again only if the tensors info is changed or the script keeps them */
+  if (shape_list == NULL || Py_REFCNT (shape_list) != 1
+      || !gst_tensors_info_is_equal (&shape_info, &config->info)) {
+    Py_SAFEDECREF (shape_list);
+    shape_list = PyList_New (config->info.num_tensors);
+
+    for (unsigned int i = 0; i < config->info.num_tensors; i++) {
+      PyObject *shape = PyTensorShape_New (shape_cls, &config->info.info[i]);
+      PyList_SetItem (shape_list, i, shape);
+    }
+
+    gst_tensors_info_free (&shape_info);
+    gst_tensors_info_copy (&shape_info, &config->info);
   }
+  in_info = shape_list;
 
   if (!PyObject_HasAttrString (core_obj, (char *)"decode")) {
     Py_ERRMSG ("Cannot find 'decode'");
@@ -104,6 +104,38 @@ initSingleLineSprite (singleLineSprite_t v, rasters_t r, uint32_t pv)
   }
 }
 
+/**
+ * @brief Draw the text in a line on the RGBA frame, from (x, y) to the right.
+ * @param[out] frame The frame to draw the text (RGBA plain)
+ * @param[in] width The width of the frame. The characters over the width are not drawn.
+ * @param[in] sprite The sprite initialized with initSingleLineSprite().
+ */
+void
+drawSingleLineText (uint32_t * frame, guint width, int x, int y,
+    const char *text, singleLineSprite_t sprite)
+{
+  uint32_t *pos1, *pos2;
+  int row;
+
+  pos1 = &frame[y * width + x];
+  for (; *text != '\0'; text++) {
+    uint8_t char_index = (uint8_t) * text;
+
+    if ((x + 8) > (int) width)
+      break;                    /* Stop drawing if it may overfill */
+
+    /* Copy each row (8 pixels) of the character at once. */
+    pos2 = pos1;
+    for (row = 0; row < 13; row++) {
+      memcpy (pos2, sprite[char_index][row], sizeof (sprite[0][0]));
+      pos2 += width;
+    }
+
+    x += 9;
+    pos1 += 9;                  /* charater width + 1px */
+  }
+}
+
 /**
  * @brief Free image labels
  */
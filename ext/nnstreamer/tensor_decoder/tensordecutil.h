@@ -36,6 +36,10 @@ loadImageLabels (const char * label_path, imglabel_t *l);
 extern void
 initSingleLineSprite (singleLineSprite_t v, rasters_t r, uint32_t pv);
 
+extern void
+drawSingleLineText (uint32_t *frame, guint width, int x, int y,
+    const char *text, singleLineSprite_t sprite);
+
 extern void _free_labels (imglabel_t *data);
 
 extern void setFramerateFromConfig  (GstCaps *caps, const GstTensorsConfig * config);
@@ -21,6 +21,11 @@
  * @bug		No known bugs except for NYI items
  *
  * This is the per-NN-framework plugin (armnn) for tensor_filter.
+ *
+ * The runtime imports the memory of the input and output tensors (zero-copy)
+ * if the backend supports it, and the default allocator of nnstreamer is
+ * aligned for the import. Set the custom property 'ImportMemory:false' to
+ * copy the tensors into the memory of the backend.
  */
 
 #include <algorithm>
@@ -32,9 +37,11 @@
 
 #include <memory>
 #include <map>
+#include <sstream>
 #include <vector>
 
 #include <armnn/ArmNN.hpp>
+#include <armnn/Version.hpp>
 
 #if ENABLE_ARMNN_CAFFE
 #include <armnnCaffeParser/ICaffeParser.hpp>
@@ -51,6 +58,18 @@
 #include <nnstreamer_plugin_api.h>
 #include <nnstreamer_util.h>
 
+/**
+ * @brief The alignment of the memory imported by the runtime (cache line of CpuAcc and GpuAcc).
+ */
+#define ARMNN_IMPORT_ALIGNMENT (64)
+
+/**
+ * @brief INetworkProperties with MemorySource is available since ArmNN 21.08 (API 26).
+ */
+#if defined(ARMNN_MAJOR_VERSION) && ARMNN_MAJOR_VERSION >= 26
+#define ARMNN_IMPORT_MEMORY_SOURCE
+#endif
+
 static const gchar *armnn_accl_support[]
     = { ACCL_CPU_NEON_STR, /** ACCL for default and auto config */
         ACCL_CPU_STR, ACCL_GPU_STR, NULL };
@@ -72,10 +91,15 @@ class ArmNNCore
   int getInputTensorDim (GstTensorsInfo *info);
   int getOutputTensorDim (GstTensorsInfo *info);
   int invoke (const GstTensorMemory *input, GstTensorMemory *output);
+  gchar *getProfile ();
 
   private:
   char *model_path;
   accl_hw accel;
+  bool profiling; /**< enable the profiler of the runtime */
+  bool importMemory; /**< import the memory of the tensors into the backend (zero-copy) */
+  std::vector<guint8> inputStaging[NNS_TENSOR_SIZE_LIMIT]; /**< aligned copy of the unaligned input */
+  std::vector<guint8> outputStaging[NNS_TENSOR_SIZE_LIMIT]; /**< aligned copy of the unaligned output */
 
   GstTensorsInfo inputTensorMeta; /**< The tensor info of input tensors */
   GstTensorsInfo outputTensorMeta; /**< The tensor info of output tensors */
@@ -93,12 +117,14 @@ class ArmNNCore
   int makeTfNetwork (std::map<std::string, armnn::TensorShape> &input_map,
       std::vector<std::string> &output_vec);
   int makeNetwork (const GstTensorFilterProperties *prop);
+  void parseCustomOption (const GstTensorFilterProperties *prop);
 
   int setTensorProp (const std::vector<armnn::BindingPointInfo> &bindings,
       GstTensorsInfo *tensorMeta);
   tensor_type getGstTensorType (armnn::DataType armType);
   int getTensorDim (int tensor_idx, tensor_dim dim);
   armnn::Compute getBackend (const accl_hw hw);
+  static void *getAlignedStaging (std::vector<guint8> &staging, gsize size);
 };
 
 /**
@@ -131,6 +157,8 @@ ArmNNCore::ArmNNCore (const char *_model_path, accl_hw hw)
   gst_tensors_info_init (&inputTensorMeta);
   gst_tensors_info_init (&outputTensorMeta);
   networkIdentifier = 0;
+  profiling = false;
+  importMemory = true;
 }
 
 /**
@@ -153,6 +181,9 @@ int
 ArmNNCore::init (const GstTensorFilterProperties *prop)
 {
   int err;
+
+  parseCustomOption (prop);
+
   if ((err = loadModel (prop))) {
     ml_loge ("Failed to load model\n");
     return err;
@@ -170,6 +201,42 @@ ArmNNCore::init (const GstTensorFilterProperties *prop)
   return 0;
 }
 
+/**
+ * @brief	parse the custom properties of the tensor_filter instance
+ */
+void
+ArmNNCore::parseCustomOption (const GstTensorFilterProperties *prop)
+{
+  gchar **strv;
+  guint i, len;
+
+  if (!prop->custom_properties)
+    return;
+
+  strv = g_strsplit (prop->custom_properties, ",", -1);
+  len = g_strv_length (strv);
+
+  for (i = 0; i < len; ++i) {
+    gchar **pair = g_strsplit (strv[i], ":", -1);
+
+    if (g_strv_length (pair) > 1) {
+      g_strstrip (pair[0]);
+      g_strstrip (pair[1]);
+
+      if (g_ascii_strcasecmp (pair[0], "Profile") == 0)
+        profiling = (g_ascii_strcasecmp (pair[1], "true") == 0);
+      else if (g_ascii_strcasecmp (pair[0], "ImportMemory") == 0)
+        importMemory = (g_ascii_strcasecmp (pair[1], "false") != 0);
+      else
+        ml_logw ("Unknown option (%s).", strv[i]);
+    }
+
+    g_strfreev (pair);
+  }
+
+  g_strfreev (strv);
+}
+
 /**
  * @brief	get the model path
  * @return the model path.
@@ -415,10 +482,37 @@ ArmNNCore::loadModel (const GstTensorFilterProperties *prop)
     if (!optNet)
       throw std::runtime_error ("Error optimizing the network.");
 
-    /* Load the network on the device */
-    status = runtime->LoadNetwork (networkIdentifier, std::move (optNet));
-    if (status == armnn::Status::Failure)
-      throw std::runtime_error ("Error loading the network.");
+    /* Load the network on the device, import the memory of the tensors if possible */
+    if (importMemory) {
+      std::string errorMessage;
+#ifdef ARMNN_IMPORT_MEMORY_SOURCE
+      armnn::INetworkProperties props (
+          false, armnn::MemorySource::Malloc, armnn::MemorySource::Malloc);
+#else
+      armnn::INetworkProperties props (true, true);
+#endif
+
+      status = runtime->LoadNetwork (networkIdentifier, std::move (optNet), errorMessage, props);
+      if (status == armnn::Status::Failure) {
+        ml_logw ("Failed to load the network with the memory import (%s), the tensors are copied.",
+            errorMessage.c_str ());
+        importMemory = false;
+
+        optNet = armnn::Optimize (*network, backends, runtime->GetDeviceSpec ());
+        if (!optNet)
+          throw std::runtime_error ("Error optimizing the network.");
+      }
+    }
+
+    if (!importMemory) {
+      status = runtime->LoadNetwork (networkIdentifier, std::move (optNet));
+      if (status == armnn::Status::Failure)
+        throw std::runtime_error ("Error loading the network.");
+    }
+
+    /* record the workload events at every invoke */
+    if (profiling)
+      runtime->GetProfiler (networkIdentifier)->EnableProfiling (true);
   } catch (...) {
     try {
       runtime = nullptr;
@@ -594,8 +688,29 @@ ArmNNCore::getOutputTensorDim (GstTensorsInfo *info)
   return 0;
 }
 
+/**
+ * @brief	get the staging buffer aligned for the memory import
+ * @param staging : the buffer kept for the tensor
+ * @param size : the size of the tensor
+ * @return the aligned address in the buffer
+ */
+void *
+ArmNNCore::getAlignedStaging (std::vector<guint8> &staging, gsize size)
+{
+  guintptr addr;
+
+  if (staging.size () < size + ARMNN_IMPORT_ALIGNMENT)
+    staging.resize (size + ARMNN_IMPORT_ALIGNMENT);
+
+  addr = (guintptr) staging.data ();
+  addr = (addr + ARMNN_IMPORT_ALIGNMENT - 1) & ~((guintptr) ARMNN_IMPORT_ALIGNMENT - 1);
+  return (void *) addr;
+}
+
 /**
  * @brief	run the model with the input.
+ * @note	With the memory import, the tensors not aligned to ARMNN_IMPORT_ALIGNMENT
+ *		are copied through the staging buffers.
  * @param[in] input : The array of input tensors
  * @param[out]  output : The array of output tensors
  * @return 0 if OK. non-zero if error.
@@ -605,6 +720,7 @@ ArmNNCore::invoke (const GstTensorMemory *input, GstTensorMemory *output)
 {
   armnn::InputTensors input_tensors;
   armnn::OutputTensors output_tensors;
+  void *output_staged[NNS_TENSOR_SIZE_LIMIT] = { nullptr };
   armnn::Status ret;
 
   for (unsigned int i = 0; i < inputTensorMeta.num_tensors; i++) {
@@ -612,7 +728,14 @@ ArmNNCore::invoke (const GstTensorMemory *input, GstTensorMemory *output)
       input_tensors.clear ();
       return -EINVAL;
     }
-    armnn::ConstTensor input_tensor (inputBindingInfo[i].second, input[i].data);
+    void *data = input[i].data;
+
+    if (importMemory && ((guintptr) data) % ARMNN_IMPORT_ALIGNMENT != 0) {
+      data = getAlignedStaging (inputStaging[i], input[i].size);
+      memcpy (data, input[i].data, input[i].size);
+    }
+
+    armnn::ConstTensor input_tensor (inputBindingInfo[i].second, data);
     input_tensors.push_back ({ inputBindingInfo[i].first, input_tensor });
   }
 
@@ -622,7 +745,14 @@ ArmNNCore::invoke (const GstTensorMemory *input, GstTensorMemory *output)
       input_tensors.clear ();
       return -EINVAL;
     }
-    armnn::Tensor output_tensor (outputBindingInfo[i].second, output[i].data);
+    void *data = output[i].data;
+
+    if (importMemory && ((guintptr) data) % ARMNN_IMPORT_ALIGNMENT != 0) {
+      data = getAlignedStaging (outputStaging[i], output[i].size);
+      output_staged[i] = data;
+    }
+
+    armnn::Tensor output_tensor (outputBindingInfo[i].second, data);
     output_tensors.push_back ({ outputBindingInfo[i].first, output_tensor });
   }
 
@@ -636,9 +766,42 @@ ArmNNCore::invoke (const GstTensorMemory *input, GstTensorMemory *output)
   if (ret == armnn::Status::Failure)
     return -EINVAL;
 
+  for (unsigned int i = 0; i < outputTensorMeta.num_tensors; i++) {
+    if (output_staged[i])
+      memcpy (output[i].data, output_staged[i], output[i].size);
+  }
+
   return 0;
 }
 
+/**
+ * @brief	get the per-workload profile analyzed by the profiler of the runtime
+ * @return Newly allocated profile text, nullptr if the profile is disabled.
+ * @note The profiler keeps the events of all invokes.
+ */
+gchar *
+ArmNNCore::getProfile ()
+{
+  std::stringstream stream;
+
+  if (!profiling || !runtime)
+    return nullptr;
+
+  try {
+    std::shared_ptr<armnn::IProfiler> profiler = runtime->GetProfiler (networkIdentifier);
+
+    if (!profiler)
+      return nullptr;
+
+    profiler->AnalyzeEventsAndWriteResults (stream);
+  } catch (const std::exception &ex) {
+    ml_loge ("Exception while analyzing the profile : %s", ex.what ());
+    return nullptr;
+  }
+
+  return g_strdup (stream.str ().c_str ());
+}
+
 /**
  * @brief Free privateData and move on.
  */
@@ -779,6 +942,28 @@ armnn_checkAvailability (accl_hw hw)
   return -ENOENT;
 }
 
+/**
+ * @brief The optional callback for GstTensorFilterFramework
+ * @param[in] ops operation to be performed
+ * @param[in/out] data event data
+ * @return 0 if OK. -ENOENT if the operation or the profile is not supported.
+ */
+static int
+armnn_handleEvent (event_ops ops, GstTensorFilterFrameworkEventData *data)
+{
+  ArmNNCore *core;
+
+  if (ops != GET_PROFILE)
+    return -ENOENT;
+
+  g_return_val_if_fail (data != NULL && data->instance != NULL, -EINVAL);
+
+  core = static_cast<ArmNNCore *> (data->instance);
+  data->profile = core->getProfile ();
+
+  return data->profile ? 0 : -ENOENT;
+}
+
 static gchar filter_subplugin_armnn[] = "armnn";
 
 static GstTensorFilterFramework NNS_support_armnn = {.version = GST_TENSOR_FILTER_FRAMEWORK_V0,
@@ -797,7 +982,7 @@ static GstTensorFilterFramework NNS_support_armnn = {.version = GST_TENSOR_FILTE
        .setInputDimension = nullptr,
        .destroyNotify = nullptr,
        .reloadModel = nullptr,
-       .handleEvent = nullptr,
+       .handleEvent = armnn_handleEvent,
        .checkAvailability = armnn_checkAvailability,
        .allocateInInvoke = nullptr,
    } } };
@@ -806,7 +991,13 @@ static GstTensorFilterFramework NNS_support_armnn = {.version = GST_TENSOR_FILTE
 void
 init_filter_armnn (void)
 {
+  /* align the tensors for the memory import of the runtime */
+  gst_tensor_alloc_init (ARMNN_IMPORT_ALIGNMENT - 1);
   nnstreamer_filter_probe (&NNS_support_armnn);
+  nnstreamer_filter_set_custom_property_desc (NNS_support_armnn.v0.name,
+      "Profile", "Set 'true' to post the per-workload profile of the runtime.",
+      "ImportMemory", "Set 'false' to copy the tensors into the memory of the backend (default true).",
+      NULL);
 }
 
 /** @brief Destruct the subplugin */
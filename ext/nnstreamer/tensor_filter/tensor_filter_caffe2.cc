@@ -26,6 +26,7 @@
  */
 
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <unistd.h>
 
@@ -66,6 +67,7 @@ class Caffe2Core
   int getInputTensorDim (GstTensorsInfo *info);
   int getOutputTensorDim (GstTensorsInfo *info);
   int run (const GstTensorMemory *input, GstTensorMemory *output);
+  void releaseOutput (void *data);
 
   private:
   char *init_model_path;
@@ -78,8 +80,10 @@ class Caffe2Core
   Workspace workSpace;
   NetDef initNet, predictNet;
   std::map<char *, Tensor *> inputTensorMap;
+  GstTensorFilterOutputPool *outputPool; /**< memory of the output blobs, reused across frames */
 
   int initInputTensor ();
+  int bindOutputTensor (guint index, void *data);
 };
 
 #ifdef __cplusplus
@@ -109,6 +113,9 @@ Caffe2Core::Caffe2Core (const char *_model_path, const char *_model_path_sub)
   if (!GlobalInitAlreadyRun () && !GlobalInit ()) {
     throw std::runtime_error ("Failed to initialize caffe2.");
   }
+
+  /* the outputs still in use downstream and the ones being written */
+  outputPool = gst_tensor_filter_output_pool_new (2 * NNS_TENSOR_SIZE_LIMIT);
 }
 
 /**
@@ -121,6 +128,7 @@ Caffe2Core::~Caffe2Core ()
   gst_tensors_info_free (&outputTensorMeta);
   g_free (pred_model_path);
   g_free (init_model_path);
+  gst_tensor_filter_output_pool_free (outputPool);
 }
 
 /**
@@ -301,6 +309,70 @@ Caffe2Core::getOutputTensorDim (GstTensorsInfo *info)
   return 0;
 }
 
+#define bindTensor(type)                                                                   \
+  do {                                                                                     \
+    ReinitializeTensor (outputTensor,                                                      \
+        { info->dimension[3], info->dimension[2], info->dimension[1], info->dimension[0] }, \
+        at::dtype<type> ().device (CPU));                                                  \
+    outputTensor->ShareExternalPointer ((type *) data);                                    \
+  } while (0);
+
+/**
+ * @brief	bind the output blob to the memory, the operator writes the output into it.
+ * @param[in] index : The index of the output tensor
+ * @param[in] data : The memory of the output tensor
+ * @return 0 if OK. non-zero if error.
+ */
+int
+Caffe2Core::bindOutputTensor (guint index, void *data)
+{
+  GstTensorInfo *info = &outputTensorMeta.info[index];
+  Tensor *outputTensor = workSpace.CreateBlob (info->name)->GetMutable<Tensor> ();
+
+  switch (info->type) {
+  case _NNS_INT32:
+    bindTensor (int32_t);
+    break;
+  case _NNS_INT16:
+    bindTensor (int16_t);
+    break;
+  case _NNS_UINT16:
+    bindTensor (uint16_t);
+    break;
+  case _NNS_INT8:
+    bindTensor (int8_t);
+    break;
+  case _NNS_UINT8:
+    bindTensor (uint8_t);
+    break;
+  case _NNS_FLOAT64:
+    bindTensor (double);
+    break;
+  case _NNS_FLOAT32:
+    bindTensor (float);
+    break;
+  case _NNS_INT64:
+    bindTensor (int64_t);
+    break;
+  default:
+    ml_loge ("invalid data type is used");
+    return -1;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief	return the memory of the output tensor to the pool.
+ * @param[in] data : The memory of the output tensor given by run()
+ */
+void
+Caffe2Core::releaseOutput (void *data)
+{
+  if (gst_tensor_filter_output_pool_release (outputPool, data) != 0)
+    ml_logw ("Failed to release the output, the data is not given by caffe2.");
+}
+
 /**
  * @brief	run the model with the input.
  * @param[in] input : The array of input tensors
@@ -311,6 +383,7 @@ int
 Caffe2Core::run (const GstTensorMemory *input, GstTensorMemory *output)
 {
   unsigned int i;
+  int ret = 0;
 #if (DBG)
   gint64 start_time = g_get_real_time ();
 #endif
@@ -355,6 +428,19 @@ Caffe2Core::run (const GstTensorMemory *input, GstTensorMemory *output)
     }
   }
 
+  /**
+   * Bind the output blobs to the memory from the pool, then the operators
+   * write the outputs in place and those are given to the next element.
+   */
+  for (i = 0; i < outputTensorMeta.num_tensors; i++) {
+    output[i].data = gst_tensor_filter_output_pool_alloc (outputPool, output[i].size);
+
+    if (bindOutputTensor (i, output[i].data) != 0) {
+      ret = -1;
+      goto error;
+    }
+  }
+
   /**
    * As the input information has not been verified, the first run for the model
    * is encapsulated in a try-catch block
@@ -365,13 +451,16 @@ Caffe2Core::run (const GstTensorMemory *input, GstTensorMemory *output)
       first_run = false;
     } catch (const std::runtime_error &re) {
       ml_loge ("Runtime error while running the model: %s", re.what ());
-      return -4;
+      ret = -4;
+      goto error;
     } catch (const std::exception &ex) {
       ml_loge ("Exception while running the model : %s", ex.what ());
-      return -4;
+      ret = -4;
+      goto error;
     } catch (...) {
       ml_loge ("Unknown exception while running the model");
-      return -4;
+      ret = -4;
+      goto error;
     }
   } else {
     workSpace.RunNet (predictNet.name ());
@@ -380,40 +469,16 @@ Caffe2Core::run (const GstTensorMemory *input, GstTensorMemory *output)
   for (i = 0; i < outputTensorMeta.num_tensors; i++) {
     const auto &out = workSpace.GetBlob (outputTensorMeta.info[i].name)->Get<Tensor> ();
 
-    switch (outputTensorMeta.info[i].type) {
-    case _NNS_INT32:
-      output[i].data = out.data<int32_t> ();
-      break;
-    case _NNS_UINT32:
-      ml_loge ("invalid data type (uint32) is used");
-      return -1;
-    case _NNS_INT16:
-      output[i].data = out.data<int16_t> ();
-      break;
-    case _NNS_UINT16:
-      output[i].data = out.data<uint16_t> ();
-      break;
-    case _NNS_INT8:
-      output[i].data = out.data<int8_t> ();
-      break;
-    case _NNS_UINT8:
-      output[i].data = out.data<uint8_t> ();
-      break;
-    case _NNS_FLOAT64:
-      output[i].data = out.data<double> ();
-      break;
-    case _NNS_FLOAT32:
-      output[i].data = out.data<float> ();
-      break;
-    case _NNS_INT64:
-      output[i].data = out.data<int64_t> ();
-      break;
-    case _NNS_UINT64:
-      ml_loge ("invalid data type (uint64) is used");
-      return -1;
-    default:
-      ml_loge ("invalid data type is used");
-      return -1;
+    /* the operator has reallocated the blob (e.g., reshaped), copy the output */
+    if (out.raw_data () != output[i].data) {
+      if ((size_t) out.nbytes () != output[i].size) {
+        ml_loge ("The size of output %u (%zu) is different from the expected size (%zu).",
+            i, (size_t) out.nbytes (), output[i].size);
+        ret = -1;
+        goto error;
+      }
+
+      memcpy (output[i].data, out.raw_data (), output[i].size);
     }
   }
 
@@ -423,6 +488,16 @@ Caffe2Core::run (const GstTensorMemory *input, GstTensorMemory *output)
 #endif
 
   return 0;
+
+error:
+  for (i = 0; i < outputTensorMeta.num_tensors; i++) {
+    if (output[i].data) {
+      releaseOutput (output[i].data);
+      output[i].data = NULL;
+    }
+  }
+
+  return ret;
 }
 
 /**
@@ -576,9 +651,11 @@ caffe2_getOutputDim (const GstTensorFilterProperties *prop, void **private_data,
 static void
 caffe2_destroyNotify (void **private_data, void *data)
 {
-  UNUSED (private_data);
-  UNUSED (data);
-  /* do nothing */
+  Caffe2Core *core = static_cast<Caffe2Core *> (*private_data);
+
+  /* the model may be closed before the output buffers are released */
+  if (core)
+    core->releaseOutput (data);
 }
 
 /**
@@ -71,13 +71,16 @@ class dvrt_subplugin final : public tensor_filter_subplugin
 
   GstTensorsInfo inputInfo; /**< The tensor info of input tensors */
   GstTensorsInfo outputInfo; /**< The tensor info of output tensors */
-  GMappedFile *modelMap; /**< Model file mmaped to memory */
+  gboolean bindTensors; /**< Try to assign the tensors to the memory of nnstreamer */
+  GstTensorFilterModelMap *modelMap; /**< Model file mmaped to memory, shared by the processes */
 
   NNContext *context; /**< Context for model load and runtime */
   NNEngine *engine; /**< Engine path for context acceleration */
   const NNModel *model; /**< Model blob pointer */
   vector<NNTensor *> inputTensors; /**< Input tensor from model */
   vector<NNTensor *> outputTensors; /**< Output tensor from model */
+  vector<bool> inputBound; /**< Input tensor is assigned to the memory of nnstreamer */
+  vector<bool> outputBound; /**< Output tensor is assigned to the memory of nnstreamer */
 
   static const char *name;
   static dvrt_subplugin *registeredRepresentation;
@@ -92,6 +95,7 @@ class dvrt_subplugin final : public tensor_filter_subplugin
   int setTensorProp (gint isInput);
   int getTensorDim (gsize index, tensor_dim dim);
   int getTensorType (gsize index, tensor_type *type);
+  bool bindTensor (NNTensor *tensor, void *data);
 
   public:
   static void init_filter_dvrt ();
@@ -119,6 +123,7 @@ struct dvrt_subplugin::dvrt_options_s {
   const gchar *enginePath; /**< Engine path for context acceleration */
   guint cacheMb; /**< Context cache size in MiB */
   guint memPoolMb; /**< Context mempool size in MiB */
+  gboolean bindTensors; /**< Assign the input/output tensors to the memory of nnstreamer */
 };
 
 /**
@@ -132,6 +137,7 @@ dvrt_subplugin::dvrt_subplugin ()
   modelMap = nullptr;
   context  = nullptr;
   engine   = nullptr;
+  bindTensors = FALSE;
 }
 
 /** @brief cleanup resources used by dvrt subplugin */
@@ -154,7 +160,7 @@ dvrt_subplugin::cleanup ()
   }
 
   if (modelMap) {
-    g_mapped_file_unref (modelMap);
+    gst_tensor_filter_model_map_close (modelMap);
     modelMap = nullptr;
   }
 }
@@ -191,6 +197,7 @@ dvrt_subplugin::parseCustomOptions (const GstTensorFilterProperties *props,
   opts->enginePath = nullptr;
   opts->cacheMb    = DVRT_CONTEXT_CACHE_SIZE_MB_DEFAULT;
   opts->memPoolMb  = DVRT_CONTEXT_MEMPOOL_SIZE_MB_DEFAULT;
+  opts->bindTensors = TRUE;
 
   if (props->custom_properties) {
     gchar **strv;
@@ -212,6 +219,8 @@ dvrt_subplugin::parseCustomOptions (const GstTensorFilterProperties *props,
           opts->cacheMb = g_ascii_strtoll (pair[1], nullptr, 10);
         else if (g_ascii_strcasecmp (pair[0], "MemPool") == 0)
           opts->memPoolMb = g_ascii_strtoll (pair[1], nullptr, 10);
+        else if (g_ascii_strcasecmp (pair[0], "BindTensors") == 0)
+          opts->bindTensors = (g_ascii_strcasecmp (pair[1], "true") == 0);
       }
 
       g_strfreev (pair);
@@ -341,6 +350,7 @@ dvrt_subplugin::setTensorProp (gint isInput)
   tensorMeta->num_tensors = num;
   tensors->clear ();
   tensors->reserve (num);
+  (isInput ? inputBound : outputBound).assign (num, bindTensors);
 
   for (size_t i = 0; i < num; i++) {
     gsize index = indices[i];
@@ -392,23 +402,21 @@ dvrt_subplugin::setInputTensorProp ()
 int
 dvrt_subplugin::initContext (dvrt_options_s *options)
 {
-  GError *err = nullptr;
   int nerr;
   NNError nnerror;
 
   if (!options->modelPath)
     return -ENOENT;
 
-  GMappedFile *modelMap = g_mapped_file_new (options->modelPath, FALSE, &err);
-  if (!modelMap || err) {
-    nns_logw ("Could not map model file %s %s",
-              options->modelPath, err->message);
-    g_clear_error (&err);
+  modelMap = gst_tensor_filter_model_map_open (options->modelPath,
+      GST_TENSOR_FILTER_MODEL_MAP_DEFAULT);
+  if (!modelMap) {
+    nns_logw ("Could not map model file %s", options->modelPath);
     return -ENOENT;
   }
 
-  gsize size = g_mapped_file_get_length (modelMap);
-  model = g_mapped_file_get_contents (modelMap);
+  size_t size;
+  model = (const NNModel *) gst_tensor_filter_model_map_get_data (modelMap, &size);
   nerr = nn_model_validate (model, size);
   if (nerr) {
     nns_logw ("Model validation failed %s", nn_model_validate_error (nerr));
@@ -456,6 +464,8 @@ dvrt_subplugin::configure_instance (const GstTensorFilterProperties *prop)
   if (ret)
     goto done;
 
+  bindTensors = options.bindTensors;
+
   ret = initContext (&options);
   if (ret)
     goto done;
@@ -474,6 +484,31 @@ done:
   }
 }
 
+/**
+ * @brief Assign the tensor to the memory, the context reads or writes the data in place.
+ * @return true if the tensor uses the memory, false if the data should be copied.
+ */
+bool
+dvrt_subplugin::bindTensor (NNTensor *tensor, void *data)
+{
+  int32_t shape[NNS_TENSOR_RANK_LIMIT];
+  int32_t dims = nn_tensor_dims (tensor);
+
+  if (dims > NNS_TENSOR_RANK_LIMIT)
+    return false;
+
+  memcpy (shape, nn_tensor_shape (tensor), sizeof (int32_t) * dims);
+
+  NNError err = nn_tensor_assign (tensor, nn_tensor_type (tensor), dims, shape, data);
+  if (err) {
+    nns_logi ("Cannot assign the tensor to (%p), fallback to copy: %s",
+              data, nn_strerror (err));
+    return false;
+  }
+
+  return true;
+}
+
 /** @brief invoke using dvrt */
 void
 dvrt_subplugin::invoke (const GstTensorMemory *input, GstTensorMemory *output)
@@ -485,6 +520,13 @@ dvrt_subplugin::invoke (const GstTensorMemory *input, GstTensorMemory *output)
     gsize size = nn_tensor_size (tensor);
     g_assert (size == input[i].size);
 
+    /* the context only reads the input tensor */
+    if (inputBound[i]) {
+      inputBound[i] = bindTensor (tensor, input[i].data);
+      if (inputBound[i])
+        continue;
+    }
+
     void *data = nn_tensor_mapwo (tensor);
     g_assert (data);
     memcpy (data, input[i].data, input[i].size);
@@ -493,19 +535,27 @@ dvrt_subplugin::invoke (const GstTensorMemory *input, GstTensorMemory *output)
     nns_logd ("Invoke Input copy to (%p) (%zu) bytes", data, input[i].size);
   }
 
+  g_assert (outputTensors.size () == outputInfo.num_tensors);
+  for (gsize i = 0; i < outputInfo.num_tensors; ++i) {
+    if (outputBound[i])
+      outputBound[i] = bindTensor (outputTensors[i], output[i].data);
+  }
+
   NNError err = nn_context_run (context);
   if (err) {
     nns_logw ("Context run failed %s", nn_strerror (err));
     throw std::runtime_error ("Invoking DeepView RT failed.");
   }
 
-  g_assert (outputTensors.size () == outputInfo.num_tensors);
   for (gsize i = 0; i < outputInfo.num_tensors; ++i) {
     NNTensor *tensor = outputTensors[i];
     g_assert (tensor);
     gsize size = nn_tensor_size (tensor);
     g_assert (size == output[i].size);
 
+    if (outputBound[i])
+      continue;
+
     const void *data = nn_tensor_mapro (tensor);
     g_assert (data);
     memcpy (output[i].data, data, output[i].size);
@@ -566,6 +616,7 @@ dvrt_subplugin::init_filter_dvrt (void)
       "Cache",   "Context cache size in MiB",
       "MemPool", "Context mempool size in MiB",
       "Engine",  "Engine plugin path for context acceleration",
+      "BindTensors", "Assign the input/output tensors to the buffers instead of copying (default: true)",
       nullptr);
 }
 
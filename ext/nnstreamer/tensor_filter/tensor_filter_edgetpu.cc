@@ -13,15 +13,26 @@
  *
  * This is the per-NN-framework plugin (Edge TPU) for tensor_filter.
  *
- * @todo This supports single-model-single-TPU only. Prep for multi-TPU.
+ * With the custom option 'devices', an interpreter of the model is built for
+ * each of the given Edge TPU devices, and each invoke runs on the least busy
+ * device (the devices are shared by the instances, e.g., tensor_filter with
+ * workers). If the model is compiled into the segments (multiple model files),
+ * the segments are chained and the k-th segment runs on the (k % N)-th device.
+ *
  * @todo A lot of this duplicate tf-lite filter.
  *       We may be able to embed this code into tf-lite filter code.
  */
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <stdint.h>
 
@@ -83,37 +94,61 @@ edgetpu_subplugin_device_type_name (edgetpu_subplugin_device_type t)
   }
 }
 
+/** @brief Edge TPU device shared by the interpreters of the instances */
+struct edgetpu_device {
+  std::string path; /**< The device path, empty for the default device */
+  std::shared_ptr<edgetpu::EdgeTpuContext> context; /**< EdgeTPU Device context */
+  std::atomic<guint> inflight; /**< The number of invokes running on the device */
+};
+
+/** @brief TFLite interpreter of the model (or a segment of the model) on a device */
+struct edgetpu_slot {
+  std::shared_ptr<edgetpu_device> device; /**< nullptr if the device_type is 'dummy' */
+  std::unique_ptr<tflite::Interpreter> interpreter; /**< released before the device */
+};
+
 /** @brief edgetpu subplugin class */
 class edgetpu_subplugin final : public tensor_filter_subplugin
 {
   private:
   bool empty_model;
-  char *model_path; /**< The model *.tflite file */
+  char *model_path; /**< The model *.tflite file (the first segment) */
   edgetpu_subplugin_device_type device_type; /**< The device type of Edge TPU */
+  std::string devices_option; /**< The devices to be used ('all', the number of devices or the device paths) */
   GstTensorsInfo inputInfo; /**< Input tensors metadata */
   GstTensorsInfo outputInfo; /**< Output tensors metadata */
 
   /** Edge-TPU + TFLite Library Properties & Functions ******************/
-  std::unique_ptr<tflite::Interpreter> model_interpreter;
-  /**< TFLite interpreter */
-  tflite::Interpreter *interpreter;
-  /**< model_interpreter.get() */
-  std::shared_ptr<edgetpu::EdgeTpuContext> edgetpu_context;
-  /**< EdgeTPU Device context */
-  std::unique_ptr<tflite::FlatBufferModel> model;
-  /**< Loaded TF Lite model (from model_path) */
+  std::vector<std::unique_ptr<tflite::FlatBufferModel>> models;
+  /**< Loaded TF Lite models (from model files, the segments if more than one) */
+  std::vector<edgetpu_slot> slots;
+  /**< The interpreter for each device, or for each segment */
+  size_t next_slot;
+  /**< The slot to start finding the least busy device (round-robin for the tie) */
   static std::unique_ptr<tflite::Interpreter> BuildEdgeTpuInterpreter (
       const tflite::FlatBufferModel &model, const edgetpu_subplugin_device_type dev_type,
       edgetpu::EdgeTpuContext *edgetpu_context = nullptr);
 
+  static std::map<std::string, std::weak_ptr<edgetpu_device>> opened_devices;
+  /**< The devices opened by the instances, keyed by the device path */
+  static std::mutex devices_lock;
+  static std::shared_ptr<edgetpu_device> openDevice (
+      edgetpu_subplugin_device_type dev_type, const std::string &path);
+  std::vector<std::string> getDevicePaths ();
+
   /** Internal Utility Functions & Properties ***************************/
   void cleanup ();
+  bool isSegmented ()
+  {
+    return models.size () > 1;
+  }
+  TfLiteStatus invokeSlot (edgetpu_slot &slot, const GstTensorMemory *input, GstTensorMemory *output);
   static void setTensorProp (tflite::Interpreter *interpreter,
       const std::vector<int> &tensor_idx_list, GstTensorsInfo &tensorMeta);
   static int getTensorDim (tflite::Interpreter *interpreter, int tensor_idx, tensor_dim dim);
   static tensor_type getTensorType (TfLiteType tfType);
   static std::string str_tolower (std::string s);
-  static edgetpu_subplugin_device_type parse_custom_prop (const char *custom_prop);
+  void parse_custom_prop (const char *custom_prop);
   static const char *name;
   static const accl_hw hw_list[];
   static const int num_hw = 1;
@@ -136,12 +171,13 @@ class edgetpu_subplugin final : public tensor_filter_subplugin
 
 const char *edgetpu_subplugin::name = "edgetpu";
 const accl_hw edgetpu_subplugin::hw_list[] = { ACCL_NPU_EDGE_TPU };
+std::map<std::string, std::weak_ptr<edgetpu_device>> edgetpu_subplugin::opened_devices;
+std::mutex edgetpu_subplugin::devices_lock;
 
 /** @brief edgetpu class constructor */
 edgetpu_subplugin::edgetpu_subplugin ()
     : tensor_filter_subplugin (), empty_model (true), model_path (nullptr),
-      device_type (edgetpu_subplugin_device_type::DEFAULT),
-      model_interpreter (nullptr), edgetpu_context (nullptr), model (nullptr)
+      device_type (edgetpu_subplugin_device_type::DEFAULT), next_slot (0)
 {
   gst_tensors_info_init (std::addressof (inputInfo));
   gst_tensors_info_init (std::addressof (outputInfo));
@@ -155,19 +191,10 @@ edgetpu_subplugin::cleanup ()
   if (empty_model)
     return; /* Nothing to do if it is an empty model */
 
-  if (model_interpreter) {
-    model_interpreter = nullptr; /* delete unique_ptr */
-  }
-  if (interpreter) {
-    interpreter = nullptr; /* it's already freed with model_interpreter */
-  }
-  if (edgetpu_context) {
-    edgetpu_context.reset ();
-    edgetpu_context = nullptr;
-  }
-  if (model) {
-    model = nullptr; /* delete unique_ptr */
-  }
+  /* the interpreters are released before the devices and the models */
+  slots.clear ();
+  models.clear ();
+  next_slot = 0;
 
   gst_tensors_info_free (std::addressof (inputInfo));
   gst_tensors_info_free (std::addressof (outputInfo));
@@ -207,48 +234,136 @@ edgetpu_subplugin::str_tolower (std::string s)
 /**
  * @brief Internal method to parse custom properties
  * @param custom_prop The given c_str value of the 'custom' property
- * @return A edgetpu_subplugin_device_type value for the given 'device_type'
- *        if the value of the 'custom' property. Otherwise,
- *        edgetpu_subplugin_device_type::USB, which is default, is returned.
+ * @note The 'device_type' is edgetpu_subplugin_device_type::USB, which is
+ *       default, if not given. The 'devices' is empty if not given, and the
+ *       default device is opened.
  */
-edgetpu_subplugin_device_type
+void
 edgetpu_subplugin::parse_custom_prop (const char *custom_prop)
 {
+  device_type = edgetpu_subplugin_device_type::DEFAULT;
+  devices_option.clear ();
+
   if ((!custom_prop) || (strlen (custom_prop) == 0))
-    return edgetpu_subplugin_device_type::DEFAULT;
-
-  const std::string cprop (custom_prop);
-  const std::string key ("device_type");
-  const std::size_t max_vec_len = 2;
-  std::vector<std::string> vec;
-  std::stringstream cprop_ss;
-  std::string token;
-  std::size_t pos;
-
-  pos = cprop.find_first_of (',');
-  cprop_ss = std::stringstream (cprop.substr (0, pos));
-
-  while (std::getline (cprop_ss, token, ':')) {
-    vec.push_back (token);
-    if (vec.size () > max_vec_len)
-      break;
+    return;
+
+  std::stringstream cprop_ss ((std::string (custom_prop)));
+  std::string option;
+
+  while (std::getline (cprop_ss, option, ',')) {
+    std::size_t pos = option.find_first_of (':');
+
+    if (pos == std::string::npos)
+      continue;
+
+    /* the device path may contain ':' */
+    std::string key = edgetpu_subplugin::str_tolower (option.substr (0, pos));
+    std::string val = option.substr (pos + 1);
+
+    key.erase (0, key.find_first_not_of (" \t"));
+    key.erase (key.find_last_not_of (" \t") + 1);
+    val.erase (0, val.find_first_not_of (" \t"));
+    val.erase (val.find_last_not_of (" \t") + 1);
+
+    if (key == "device_type") {
+      val = edgetpu_subplugin::str_tolower (val);
+
+      if (edgetpu_subplugin_device_type_name (edgetpu_subplugin_device_type::PCI) == val)
+        device_type = edgetpu_subplugin_device_type::PCI;
+      else if (edgetpu_subplugin_device_type_name (edgetpu_subplugin_device_type::DUMMY) == val)
+        device_type = edgetpu_subplugin_device_type::DUMMY;
+      else
+        device_type = edgetpu_subplugin_device_type::DEFAULT;
+    } else if (key == "devices") {
+      devices_option = val;
+    } else {
+      nns_logw ("Unknown option (%s).", option.c_str ());
+    }
+  }
+}
+
+/**
+ * @brief Internal method to get the paths of the devices to be used.
+ * @return The device paths. A vector with an empty path (the default device) if 'devices' is not given.
+ * @throws std::system_error if the given devices are not found.
+ */
+std::vector<std::string>
+edgetpu_subplugin::getDevicePaths ()
+{
+  std::vector<std::string> paths;
+
+  if (devices_option.empty ()) {
+    paths.push_back (std::string ());
+    return paths;
   }
 
-  if (edgetpu_subplugin::str_tolower (vec[0]) != key)
-    return edgetpu_subplugin_device_type::DEFAULT;
+  const edgetpu::DeviceType type = static_cast<edgetpu::DeviceType> (device_type);
+  std::vector<std::string> available;
 
-  std::string val = edgetpu_subplugin::str_tolower (vec[1]);
-  edgetpu_subplugin_device_type ret;
+  for (const auto &record : edgetpu::EdgeTpuManager::GetSingleton ()->EnumerateEdgeTpu ()) {
+    if (record.type == type)
+      available.push_back (record.path);
+  }
 
-  ret = edgetpu_subplugin_device_type::PCI;
-  if (edgetpu_subplugin_device_type_name (ret) == val)
-    return ret;
+  if (str_tolower (devices_option) == "all") {
+    paths = available;
+  } else if (std::all_of (devices_option.begin (), devices_option.end (), ::isdigit)) {
+    size_t num = std::stoul (devices_option);
 
-  ret = edgetpu_subplugin_device_type::DUMMY;
-  if (edgetpu_subplugin_device_type_name (ret) == val)
-    return ret;
+    if (num > available.size ()) {
+      nns_logw ("Only %zu Edge-TPU devices (%s) are available, %zu devices are requested.",
+          available.size (), edgetpu_subplugin_device_type_name (device_type).c_str (), num);
+      num = available.size ();
+    }
+    paths.assign (available.begin (), available.begin () + num);
+  } else {
+    std::stringstream ss (devices_option);
+    std::string path;
 
-  return edgetpu_subplugin_device_type::DEFAULT;
+    while (std::getline (ss, path, ';')) {
+      if (!path.empty ())
+        paths.push_back (path);
+    }
+  }
+
+  if (paths.empty ())
+    throw std::system_error (ENODEV, std::system_category (), "Cannot find the given edge-TPU devices.");
+
+  return paths;
+}
+
+/**
+ * @brief Internal method to open the device, shared with the other instances.
+ * @param dev_type The device type of Edge TPU
+ * @param path The device path, empty for the default device
+ * @return The opened device. nullptr if failed.
+ */
+std::shared_ptr<edgetpu_device>
+edgetpu_subplugin::openDevice (edgetpu_subplugin_device_type dev_type, const std::string &path)
+{
+  std::lock_guard<std::mutex> lock (devices_lock);
+  std::shared_ptr<edgetpu_device> device = opened_devices[path].lock ();
+
+  if (device)
+    return device;
+
+  device = std::make_shared<edgetpu_device> ();
+  device->path = path;
+  device->inflight = 0;
+
+  if (path.empty ())
+    device->context = edgetpu::EdgeTpuManager::GetSingleton ()->OpenDevice ();
+  else
+    device->context = edgetpu::EdgeTpuManager::GetSingleton ()->OpenDevice (
+        static_cast<edgetpu::DeviceType> (dev_type), path);
+
+  if (nullptr == device->context) {
+    opened_devices.erase (path);
+    return nullptr;
+  }
+
+  opened_devices[path] = device;
+  return device;
 }
 
 /** @brief configure edgetpu instance */
@@ -257,7 +372,7 @@ edgetpu_subplugin::configure_instance (const GstTensorFilterProperties *prop)
 {
   const std::string _model_path = prop->model_files[0];
 
-  this->device_type = this->parse_custom_prop (prop->custom_properties);
+  this->parse_custom_prop (prop->custom_properties);
 
   if (!empty_model) {
     /* Already opened */
@@ -272,64 +387,113 @@ edgetpu_subplugin::configure_instance (const GstTensorFilterProperties *prop)
 
   assert (model_path == nullptr);
 
-  if (!g_file_test (prop->model_files[0], G_FILE_TEST_IS_REGULAR)) {
-    const std::string err_msg = "Given file " + (std::string) prop->model_files[0] + " is not valid";
-    std::cerr << err_msg << std::endl;
-    cleanup ();
-    throw std::invalid_argument (err_msg);
+  for (int i = 0; i < prop->num_models; i++) {
+    if (!g_file_test (prop->model_files[i], G_FILE_TEST_IS_REGULAR)) {
+      const std::string err_msg = "Given file " + (std::string) prop->model_files[i] + " is not valid";
+      std::cerr << err_msg << std::endl;
+      cleanup ();
+      throw std::invalid_argument (err_msg);
+    }
   }
 
   model_path = g_strdup (prop->model_files[0]);
 
-  /** Read a model */
-  model = tflite::FlatBufferModel::BuildFromFile (_model_path.c_str ());
-  if (nullptr == model) {
-    cleanup ();
-    throw std::invalid_argument ("Cannot load the given model file.");
+  /** Read a model (or the segments of the model) */
+  for (int i = 0; i < prop->num_models; i++) {
+    std::unique_ptr<tflite::FlatBufferModel> model
+        = tflite::FlatBufferModel::BuildFromFile (prop->model_files[i]);
+    if (nullptr == model) {
+      cleanup ();
+      throw std::invalid_argument ("Cannot load the given model file.");
+    }
+    models.push_back (std::move (model));
   }
 
-  /** Build an interpreter */
+  /** Build an interpreter for each device, or for each segment */
   if (this->device_type != edgetpu_subplugin_device_type::DUMMY) {
-    edgetpu_context = edgetpu::EdgeTpuManager::GetSingleton ()->OpenDevice ();
-    if (nullptr == edgetpu_context) {
-      std::cerr << "Cannot open edge-TPU device." << std::endl;
+    std::vector<std::string> paths;
+
+    try {
+      paths = getDevicePaths ();
+    } catch (...) {
       cleanup ();
-      throw std::system_error (ENODEV, std::system_category (), "Cannot open edge-TPU device.");
+      throw;
     }
 
-    model_interpreter = BuildEdgeTpuInterpreter (
-        *model, this->device_type, edgetpu_context.get ());
-    if (nullptr == model_interpreter) {
-      std::cerr << "Edge-TPU device is opened, but cannot get its interpreter."
-                << std::endl;
-      cleanup ();
-      throw std::system_error (ENODEV, std::system_category (),
-          "Edge-TPU device is opened, but cannot get its interpreter.");
+    const size_t num_slots = isSegmented () ? models.size () : paths.size ();
+
+    for (size_t i = 0; i < num_slots; i++) {
+      edgetpu_slot slot;
+      const tflite::FlatBufferModel &model = *models[isSegmented () ? i : 0];
+
+      slot.device = openDevice (this->device_type, paths[i % paths.size ()]);
+      if (nullptr == slot.device) {
+        std::cerr << "Cannot open edge-TPU device." << std::endl;
+        cleanup ();
+        throw std::system_error (ENODEV, std::system_category (), "Cannot open edge-TPU device.");
+      }
+
+      slot.interpreter = BuildEdgeTpuInterpreter (
+          model, this->device_type, slot.device->context.get ());
+      if (nullptr == slot.interpreter) {
+        std::cerr << "Edge-TPU device is opened, but cannot get its interpreter."
+                  << std::endl;
+        cleanup ();
+        throw std::system_error (ENODEV, std::system_category (),
+            "Edge-TPU device is opened, but cannot get its interpreter.");
+      }
+
+      nns_logi ("Edge-TPU interpreter %zu is built on the device '%s'.", i,
+          slot.device->path.empty () ? "default" : slot.device->path.c_str ());
+      slots.push_back (std::move (slot));
     }
   } else {
     /* If the device_type is 'dummy', work same as tflite using CPU */
-    tflite::ops::builtin::BuiltinOpResolver resolver;
+    const size_t num_slots = models.size ();
 
-    edgetpu_context = nullptr;
-    model_interpreter = BuildEdgeTpuInterpreter (*model, this->device_type);
-    if (nullptr == model_interpreter) {
-      cleanup ();
-      throw std::system_error (ENODEV, std::system_category (),
-          "Failed to get the interpreter while trying to running dummy device mode of Edge-TPU.");
+    for (size_t i = 0; i < num_slots; i++) {
+      edgetpu_slot slot;
+
+      slot.device = nullptr;
+      slot.interpreter = BuildEdgeTpuInterpreter (*models[i], this->device_type);
+      if (nullptr == slot.interpreter) {
+        cleanup ();
+        throw std::system_error (ENODEV, std::system_category (),
+            "Failed to get the interpreter while trying to running dummy device mode of Edge-TPU.");
+      }
+      slots.push_back (std::move (slot));
     }
   }
 
-  interpreter = model_interpreter.get ();
+  /** The outputs of a segment are the inputs of the next segment */
+  for (size_t i = 1; isSegmented () && i < slots.size (); i++) {
+    tflite::Interpreter *prev = slots[i - 1].interpreter.get ();
+    tflite::Interpreter *next = slots[i].interpreter.get ();
+    bool compatible = (prev->outputs ().size () == next->inputs ().size ());
+
+    for (size_t j = 0; compatible && j < next->inputs ().size (); j++) {
+      compatible = (prev->tensor (prev->outputs ()[j])->bytes
+                    == next->tensor (next->inputs ()[j])->bytes);
+    }
+
+    if (!compatible) {
+      cleanup ();
+      throw std::invalid_argument ("The outputs of the segment " + std::to_string (i - 1)
+                                   + " are incompatible with the inputs of the next segment.");
+    }
+  }
 
   try {
-    setTensorProp (interpreter, interpreter->inputs (), inputInfo);
+    setTensorProp (slots.front ().interpreter.get (),
+        slots.front ().interpreter->inputs (), inputInfo);
   } catch (const std::invalid_argument &ia) {
     cleanup ();
     throw std::invalid_argument ("Input tensor of the given model is incompatible or invalid");
   }
 
   try {
-    setTensorProp (interpreter, interpreter->outputs (), outputInfo);
+    setTensorProp (slots.back ().interpreter.get (),
+        slots.back ().interpreter->outputs (), outputInfo);
   } catch (const std::invalid_argument &ia) {
     cleanup ();
     throw std::invalid_argument ("Output tensor of the given model is incompatible or invalid");
@@ -338,22 +502,23 @@ edgetpu_subplugin::configure_instance (const GstTensorFilterProperties *prop)
   empty_model = false;
 }
 
-/** @brief invoke using edgetpu */
-void
-edgetpu_subplugin::invoke (const GstTensorMemory *input, GstTensorMemory *output)
+/**
+ * @brief run the interpreter of the slot with the given memory.
+ * @param slot The slot to be invoked
+ * @param input The input tensors
+ * @param output The output tensors, nullptr to keep the outputs in the interpreter (the next segment reads them)
+ */
+TfLiteStatus
+edgetpu_subplugin::invokeSlot (edgetpu_slot &slot, const GstTensorMemory *input, GstTensorMemory *output)
 {
-  unsigned int i;
-
+  tflite::Interpreter *interpreter = slot.interpreter.get ();
   std::vector<int> tensors_idx;
   int tensor_idx;
   TfLiteTensor *tensor_ptr;
   TfLiteStatus status;
 
-  assert (!empty_model);
-  assert (interpreter);
-
   /* Configure inputs */
-  for (i = 0; i < inputInfo.num_tensors; i++) {
+  for (size_t i = 0; i < interpreter->inputs ().size (); i++) {
     tensor_idx = interpreter->inputs ()[i];
     tensor_ptr = interpreter->tensor (tensor_idx);
 
@@ -363,7 +528,7 @@ edgetpu_subplugin::invoke (const GstTensorMemory *input, GstTensorMemory *output
   }
 
   /* Configure outputs */
-  for (i = 0; i < outputInfo.num_tensors; ++i) {
+  for (size_t i = 0; output && i < interpreter->outputs ().size (); ++i) {
     tensor_idx = interpreter->outputs ()[i];
     tensor_ptr = interpreter->tensor (tensor_idx);
 
@@ -372,12 +537,65 @@ edgetpu_subplugin::invoke (const GstTensorMemory *input, GstTensorMemory *output
     tensors_idx.push_back (tensor_idx);
   }
 
+  if (slot.device)
+    slot.device->inflight++;
+
   status = interpreter->Invoke ();
 
+  if (slot.device)
+    slot.device->inflight--;
+
   /** if it is not `nullptr`, tensorflow makes `free()` the memory itself. */
-  int tensorSize = tensors_idx.size ();
-  for (int i = 0; i < tensorSize; ++i) {
-    interpreter->tensor (tensors_idx[i])->data.raw = nullptr;
+  for (int idx : tensors_idx) {
+    interpreter->tensor (idx)->data.raw = nullptr;
+  }
+
+  return status;
+}
+
+/** @brief invoke using edgetpu */
+void
+edgetpu_subplugin::invoke (const GstTensorMemory *input, GstTensorMemory *output)
+{
+  TfLiteStatus status = kTfLiteOk;
+
+  assert (!empty_model);
+  assert (!slots.empty ());
+
+  if (isSegmented ()) {
+    GstTensorMemory mem[NNS_TENSOR_SIZE_LIMIT];
+    const GstTensorMemory *in = input;
+
+    /* the outputs of each segment are read by the next segment without copying */
+    for (size_t s = 0; s < slots.size (); s++) {
+      const bool last = (s == slots.size () - 1);
+      tflite::Interpreter *interpreter = slots[s].interpreter.get ();
+
+      status = invokeSlot (slots[s], in, last ? output : nullptr);
+      if (status != kTfLiteOk || last)
+        break;
+
+      for (size_t i = 0; i < interpreter->outputs ().size (); i++) {
+        TfLiteTensor *tensor_ptr = interpreter->tensor (interpreter->outputs ()[i]);
+
+        mem[i].data = tensor_ptr->data.raw;
+        mem[i].size = tensor_ptr->bytes;
+      }
+      in = mem;
+    }
+  } else {
+    /* the least busy device, round-robin if the devices are equally busy */
+    size_t selected = next_slot % slots.size ();
+
+    for (size_t n = 1; n < slots.size (); n++) {
+      size_t i = (next_slot + n) % slots.size ();
+
+      if (slots[i].device->inflight < slots[selected].device->inflight)
+        selected = i;
+    }
+
+    next_slot = selected + 1;
+    status = invokeSlot (slots[selected], input, output);
   }
 
   if (status != kTfLiteOk) {
@@ -461,6 +679,7 @@ edgetpu_subplugin::BuildEdgeTpuInterpreter (const tflite::FlatBufferModel &model
   std::unique_ptr<tflite::Interpreter> interpreter;
   if (tflite::InterpreterBuilder (model, resolver) (&interpreter) != kTfLiteOk) {
     nns_loge ("Failed to build interpreter.");
+    return nullptr;
   }
 
   if (dev_type != edgetpu_subplugin_device_type::DUMMY)
@@ -560,6 +779,9 @@ edgetpu_subplugin::init_filter_edgetpu (void)
       = tensor_filter_subplugin::register_subplugin<edgetpu_subplugin> ();
   nnstreamer_filter_set_custom_property_desc (name, "device_type",
       "Device type of the Edge-TPU instance {'usb' (default), 'pci', 'dummy'}",
+      "devices",
+      "Edge-TPU devices of the device_type to dispatch the invokes {'all', the number of devices, or the device paths separated by ';'}."
+      " The segments of the pipelined model (multiple model files) run on the devices in order.",
       NULL);
 }
 
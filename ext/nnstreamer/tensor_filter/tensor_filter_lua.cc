@@ -65,6 +65,20 @@
  *   end
  * end
  *
+ *   With LuaJIT, the tensors may be accessed at once with FFI pointers,
+ * "input_tensor_ptr(tensor_idx)" and "output_tensor_ptr(tensor_idx)",
+ * which return the typed pointer (cdata) of the tensor data and the number
+ * of the elements. The index of the pointer starts from 0.
+ *
+ *   An Example (LuaJIT):
+ * function nnstreamer_invoke()
+ *   input, num = input_tensor_ptr(1)
+ *   output = output_tensor_ptr(1)
+ *   for i=0,num-1 do
+ *     output[i] = input[i]
+ *   end
+ * end
+ *
  *   In "script mode", not "file mode", the script should NOT have
  * double quote ("), and double dashes ( -- COMMENT ) for comment.
  * Use single quote and --[[ COMMENT --]] format instead.
@@ -286,6 +300,69 @@ getOutputTensor (lua_State *L)
   return expose_tensor (L, &(lt[tidx - 1]));
 }
 
+#ifdef ENABLE_LUAJIT
+/**
+ * @brief Get the data, type and the number of elements of the tensor in Lua.
+ * @note This is used by the FFI accessors, input_tensor_ptr() and output_tensor_ptr().
+ */
+static int
+getTensorPointer (lua_State *L)
+{
+  int is_output = lua_toboolean (L, 1);
+  int tidx = lua_tointeger (L, 2);
+  if (tidx <= 0 || tidx > NNS_TENSOR_SIZE_LIMIT) {
+    throw std::runtime_error ("Invalid idx for `[input/output]_tensor_ptr(idx)`");
+  }
+
+  lua_pushstring (L, is_output ? "output_lua_tensors" : "input_lua_tensors");
+  lua_gettable (L, LUA_REGISTRYINDEX);
+  lua_tensor *lt = &((lua_tensor *) lua_topointer (L, -1))[tidx - 1];
+  lua_pop (L, 1);
+
+  if (lt->data == NULL)
+    throw std::runtime_error ("Invalid idx for `[input/output]_tensor_ptr(idx)`");
+
+  lua_pushlightuserdata (L, lt->data);
+  lua_pushstring (L, gst_tensor_get_type_string (lt->type));
+  lua_pushinteger (L, lt->size / gst_tensor_get_element_size (lt->type));
+
+  return 3;
+}
+
+/**
+ * @brief Lua functions to access the tensors with FFI typed pointers.
+ */
+static const char *ffi_tensor_accessors = R""""(
+local ffi = require('ffi')
+local ctypes = {
+  int32 = ffi.typeof('int32_t *'), uint32 = ffi.typeof('uint32_t *'),
+  int16 = ffi.typeof('int16_t *'), uint16 = ffi.typeof('uint16_t *'),
+  int8 = ffi.typeof('int8_t *'), uint8 = ffi.typeof('uint8_t *'),
+  int64 = ffi.typeof('int64_t *'), uint64 = ffi.typeof('uint64_t *'),
+  float64 = ffi.typeof('double *'), float32 = ffi.typeof('float *'),
+}
+local tensor_pointer = _nns_tensor_pointer
+_nns_tensor_pointer = nil
+
+local function pointer(is_output, idx)
+  local data, dtype, num = tensor_pointer(is_output, idx)
+  local ctype = ctypes[dtype]
+  if ctype == nil then
+    error('FFI access is not supported for ' .. dtype)
+  end
+  return ffi.cast(ctype, data), num
+end
+
+function input_tensor_ptr(idx)
+  return pointer(false, idx)
+end
+
+function output_tensor_ptr(idx)
+  return pointer(true, idx)
+end
+)"""";
+#endif /* ENABLE_LUAJIT */
+
 /** @brief Register metatable for tensor in Lua */
 static void
 create_tensor_type (lua_State *L)
@@ -300,6 +377,14 @@ create_tensor_type (lua_State *L)
   luaL_openlib (L, NULL, tensor, 0);
   lua_register (L, "input_tensor", getInputTensor);
   lua_register (L, "output_tensor", getOutputTensor);
+
+#ifdef ENABLE_LUAJIT
+  lua_register (L, "_nns_tensor_pointer", getTensorPointer);
+  if (luaL_dostring (L, ffi_tensor_accessors) != 0) {
+    throw std::runtime_error (std::string ("Failed to register FFI tensor accessors. Error message: ") +
+        lua_tostring (L, -1));
+  }
+#endif /* ENABLE_LUAJIT */
 }
 
 /** @brief lua subplugin class */
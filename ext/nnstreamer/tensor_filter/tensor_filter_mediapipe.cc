@@ -13,8 +13,16 @@
  * @todo   If there is other input type (not video), or multiple inputs, current system cannot handle it.
  *
  * This is the per-NN-framework plugin (mediapipe) for tensor_filter.
+ *
+ * The graph is started once when the instance is configured. The input tensor
+ * is wrapped as an ImageFrame packet without copying, and the output packet of
+ * the same timestamp is passed to the output without copying if its pixel data
+ * is contiguous. The packet is released when the output buffer is freed.
  */
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 
@@ -68,6 +76,12 @@ class mediapipe_subplugin final : public tensor_filter_subplugin
 
   mediapipe::CalculatorGraphConfig config; /**< about .pbtxt file */
   mediapipe::CalculatorGraph graph;
+  std::unique_ptr<mediapipe::OutputStreamPoller> poller; /**< poller of the output stream */
+  bool graph_started;
+
+  std::map<void *, mediapipe::Packet> output_packets; /**< output packets referred by the output buffers */
+  std::mutex output_lock;
+  GstTensorFilterOutputPool *output_pool; /**< pool of the copied outputs, reused across frames */
 
   int loadMediapipeGraph (const GstTensorFilterProperties *prop);
   static const char *name;
@@ -91,6 +105,11 @@ class mediapipe_subplugin final : public tensor_filter_subplugin
   int eventHandler (event_ops ops, GstTensorFilterFrameworkEventData &data);
 };
 
+/**
+ * @brief The number of the copied output chunks kept for the next frames.
+ */
+#define MEDIAPIPE_OUTPUT_POOL_SIZE (4)
+
 const char *mediapipe_subplugin::name = "mediapipe";
 const accl_hw mediapipe_subplugin::hw_list[] = {};
 
@@ -98,8 +117,9 @@ const accl_hw mediapipe_subplugin::hw_list[] = {};
  * @brief	mediapipe_subplugin Constructor
  */
 mediapipe_subplugin::mediapipe_subplugin ()
-    : tensor_filter_subplugin (), config_path (nullptr)
+    : tensor_filter_subplugin (), config_path (nullptr), graph_started (false)
 {
+  output_pool = gst_tensor_filter_output_pool_new (MEDIAPIPE_OUTPUT_POOL_SIZE);
   gst_tensors_info_init (&inputInfo);
   gst_tensors_info_init (&outputInfo);
 
@@ -115,20 +135,26 @@ mediapipe_subplugin::~mediapipe_subplugin ()
 
   g_free (config_path);
 
-  for (unsigned int i = 0; i < inputInfo.num_tensors; i++) {
-    status = graph.CloseInputStream (inputInfo.info[i].name);
+  if (graph_started) {
+    for (unsigned int i = 0; i < inputInfo.num_tensors; i++) {
+      status = graph.CloseInputStream (inputInfo.info[i].name);
+      if (!status.ok ()) {
+        std::cerr << "Failed to close input stream" << std::endl;
+      }
+    }
+
+    status = graph.WaitUntilDone ();
     if (!status.ok ()) {
-      std::cerr << "Failed to close input stream" << std::endl;
+      std::cerr << "Failed to closing mediapipe graph" << std::endl;
     }
   }
 
   gst_tensors_info_free (&inputInfo);
   gst_tensors_info_free (&outputInfo);
 
-  status = graph.WaitUntilDone ();
-  if (!status.ok ()) {
-    std::cerr << "Failed to closing mediapipe graph" << std::endl;
-  }
+  std::lock_guard<std::mutex> lock (output_lock);
+  output_packets.clear ();
+  gst_tensor_filter_output_pool_free (output_pool);
 }
 
 /**
@@ -163,6 +189,21 @@ mediapipe_subplugin::configure_instance (const GstTensorFilterProperties *prop)
     std::cerr << "Failed to load mediapipe graph" << std::endl;
     throw std::runtime_error ("Failed to load mediapipe graph");
   }
+
+  /* the poller should be added before the graph is started */
+  auto status_or_poller = graph.AddOutputStreamPoller (outputInfo.info[0].name);
+  if (!status_or_poller.ok ()) {
+    std::cerr << "Failed to add output stream poller" << std::endl;
+    throw std::runtime_error ("Failed to add output stream poller");
+  }
+  poller = absl::make_unique<mediapipe::OutputStreamPoller> (
+      std::move (status_or_poller.ValueOrDie ()));
+
+  if (!graph.StartRun ({}).ok ()) {
+    std::cerr << "Fail to start mediapipe graph" << std::endl;
+    throw std::runtime_error ("Fail to start mediapipe graph");
+  }
+  graph_started = true;
 }
 
 /**
@@ -232,7 +273,6 @@ mediapipe_subplugin::loadMediapipeGraph (const GstTensorFilterProperties *prop)
 
 /**
  * @brief	run the mediapipe graph
- * @todo there are few points which can help to improve the performance.
  */
 void
 mediapipe_subplugin::invoke (const GstTensorMemory *input, GstTensorMemory *output)
@@ -244,18 +284,10 @@ mediapipe_subplugin::invoke (const GstTensorMemory *input, GstTensorMemory *outp
   int input_height = inputInfo.info[0].dimension[2];
   int input_channels = inputInfo.info[0].dimension[0];
   int input_widthStep = input_width * input_channels;
+  mediapipe::Timestamp timestamp (frame_timestamp++);
   mediapipe::Status status;
 
-  /* TODO to make it better, start the graph at init or previous step */
-  mediapipe::OutputStreamPoller poller
-      = graph.AddOutputStreamPoller (outputInfo.info[0].name).ValueOrDie ();
-  status = graph.StartRun ({});
-  if (!status.ok ()) {
-    std::cerr << "Fail to start mediapipe graph" << std::endl;
-    throw std::runtime_error ("Fail to start mediapipe graph");
-  }
-
-  // Wrap Mat into an ImageFrame.
+  // Wrap the input tensor into an ImageFrame.
   auto input_frame = absl::make_unique<mediapipe::ImageFrame> (
       mediapipe::ImageFormat::SRGB, input_width, input_height, input_widthStep,
       (uint8_t *)input->data, inputPtrDeleter /* do nothing */
@@ -263,23 +295,38 @@ mediapipe_subplugin::invoke (const GstTensorMemory *input, GstTensorMemory *outp
 
   // Send image packet
   status = graph.AddPacketToInputStream (inputInfo.info[0].name,
-      mediapipe::Adopt (input_frame.release ()).At (mediapipe::Timestamp (frame_timestamp++)));
+      mediapipe::Adopt (input_frame.release ()).At (timestamp));
   if (!status.ok ()) {
     std::cerr << "Failed to add input packet" << std::endl;
     throw std::runtime_error ("Failed to add input packet");
   }
 
-  // Get the graph result packet, or stop if that fails.
+  // Get the graph result packet of the input timestamp, or stop if that fails.
   mediapipe::Packet packet;
-  if (!poller.Next (&packet)) {
-    std::cerr << "Failed to get output packet from mediapipe graph" << std::endl;
-    throw std::runtime_error ("Failed to get output packet from mediapipe graph");
+  do {
+    if (!poller->Next (&packet)) {
+      std::cerr << "Failed to get output packet from mediapipe graph" << std::endl;
+      throw std::runtime_error ("Failed to get output packet from mediapipe graph");
+    }
+  } while (packet.Timestamp () < timestamp);
+
+  if (packet.Timestamp () != timestamp) {
+    std::cerr << "The output packet of the input timestamp is dropped by mediapipe graph" << std::endl;
+    throw std::runtime_error ("Failed to get output packet of the input timestamp");
   }
+
   auto &output_frame = packet.Get<mediapipe::ImageFrame> ();
-  cv::Mat output_frame_mat = mediapipe::formats::MatView (&output_frame);
 
-  /* TODO remove memcpy if it's possible */
-  memcpy (output->data, output_frame_mat.data, output->size);
+  if (output_frame.IsContiguous () && (size_t) output_frame.PixelDataSize () == output->size) {
+    /* pass the pixel data, the packet is released in destroy notify */
+    output->data = (void *) output_frame.PixelData ();
+
+    std::lock_guard<std::mutex> lock (output_lock);
+    output_packets[output->data] = packet;
+  } else {
+    output->data = gst_tensor_filter_output_pool_alloc (output_pool, output->size);
+    output_frame.CopyToBuffer ((uint8_t *) output->data, output->size);
+  }
 
 #if (DBG)
   gint64 stop_time = g_get_real_time ();
@@ -295,7 +342,7 @@ mediapipe_subplugin::getFrameworkInfo (GstTensorFilterFrameworkInfo &info)
 {
   info.name = name;
   info.allow_in_place = FALSE;
-  info.allocate_in_invoke = FALSE;
+  info.allocate_in_invoke = TRUE;
   info.run_without_model = FALSE;
   info.verify_model_path = TRUE;
   info.hw_list = hw_list;
@@ -326,6 +373,18 @@ mediapipe_subplugin::getModelInfo (
 int
 mediapipe_subplugin::eventHandler (event_ops ops, GstTensorFilterFrameworkEventData &data)
 {
+  if (ops == DESTROY_NOTIFY) {
+    std::lock_guard<std::mutex> lock (output_lock);
+    auto it = output_packets.find (data.data);
+
+    if (it != output_packets.end ())
+      output_packets.erase (it);
+    else if (gst_tensor_filter_output_pool_release (output_pool, data.data) != 0)
+      g_free (data.data);
+
+    return 0;
+  }
+
   return -ENOENT;
 }
 
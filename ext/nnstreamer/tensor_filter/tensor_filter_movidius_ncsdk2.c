@@ -24,6 +24,14 @@
  * @bug     No known bugs except for NYI items
  *
  * This is the per-NN-framework plugin (Intel Movidius NCSDK2) for tensor_filter.
+ *
+ * Each instance opens a stick not used yet, so the instances of tensor_filter
+ * (e.g., with the property workers) are dispatched to the plugged sticks.
+ * If all sticks are in use, the instance shares the stick running the same
+ * model, and the invokes of the instances are pipelined through the FIFOs of
+ * the stick: an input is queued while the stick runs the previous ones.
+ * The custom property is as follows (e.g., custom=fifo_depth:4).
+ *  - fifo_depth: the number of the elements in the FIFOs of the stick (default 2).
  */
 
 #include <fcntl.h>
@@ -53,7 +61,8 @@ enum _private_constants
   NNS_MVNCSDK2_SUPPORT_MAX_NUMS_DEVICES = 8,
   NNS_MVNCSDK2_SUPPORT_API_MAJOR_VER = 2,
   NNS_MVNCSDK2_API_VER_ARRAY_SIZE = NC_VERSION_MAX_SIZE,
-  NNS_MVNCSDK2_MAX_NUM_ELEM_IN_FIFO = 2,
+  NNS_MVNCSDK2_DEFAULT_NUM_ELEM_IN_FIFO = 2,
+  NNS_MVNCSDK2_MAX_NUM_ELEM_IN_FIFO = 64,
   NNS_MVNCSDK2_MAX_NUM_TENOSORS_SUPPORTED = 1,
 };
 
@@ -61,9 +70,9 @@ static const char NNS_MVNCSDK2_NAME_INPUT_FIFO[] = "INPUT_FIFO";
 static const char NNS_MVNCSDK2_NAME_OUTPUT_FIFO[] = "OUTPUT_FIFO";
 
 /**
- * @brief internal data of mvncsdk2
+ * @brief the opened stick with the allocated model, shared by the instances
  */
-typedef struct _mvncsdk2_data
+typedef struct _mvncsdk2_device
 {
   /* Variables of the data types from mvnc.h */
   struct ncDeviceHandle_t *handle_device; /** handle for Intel Movidius device */
@@ -73,9 +82,48 @@ typedef struct _mvncsdk2_data
   struct ncFifoHandle_t *handle_fifo_input; /** handle for input fifo (buffer) */
   struct ncFifoHandle_t *handle_fifo_output; /** handle for output fifo (buffer) */
   /* Normal variables */
-  gint32 idx_device;  /** index of device to use (Q. is it necessary?) */
+  gint32 idx_device;  /** index of the device */
+  gchar *model; /** the path of the model allocated on the device */
+  guint fifo_depth; /** the number of the elements in the FIFOs */
+  guint refcount; /** the number of the instances using the device */
+
+  GMutex lock; /** lock to queue the input and to wait the turn to read the output */
+  GCond cond; /** signaled when an output is read */
+  guint64 num_queued; /** the number of the inputs queued */
+  guint64 num_read; /** the number of the outputs read */
+} mvncsdk2_device;
+
+/**
+ * @brief internal data of mvncsdk2
+ */
+typedef struct _mvncsdk2_data
+{
+  mvncsdk2_device *dev; /** the device used by the instance */
 } mvncsdk2_data;
 
+/**
+ * @brief the devices opened in this process, indexed by the device index
+ */
+static mvncsdk2_device *mvncsdk2_devices[NNS_MVNCSDK2_SUPPORT_MAX_NUMS_DEVICES];
+G_LOCK_DEFINE_STATIC (mvncsdk2_devices);
+
+/**
+ * @brief Release the resources of the device
+ */
+static void
+_mvncsdk2_device_free (mvncsdk2_device * dev)
+{
+  ncGraphDestroy (&(dev->handle_graph));
+  ncFifoDestroy (&(dev->handle_fifo_output));
+  ncFifoDestroy (&(dev->handle_fifo_input));
+  ncDeviceDestroy (&(dev->handle_device));
+
+  g_mutex_clear (&dev->lock);
+  g_cond_clear (&dev->cond);
+  g_free (dev->model);
+  g_free (dev);
+}
+
 /**
  * @brief Free privateData and move on.
  * @param prop : property of tensor_filter instance
@@ -85,13 +133,20 @@ static void
 _mvncsdk2_close (const GstTensorFilterProperties * prop, void **private_data)
 {
   mvncsdk2_data *pdata = *private_data;
+  mvncsdk2_device *dev = NULL;
   UNUSED (prop);
 
   if (pdata != NULL) {
-    ncGraphDestroy (&(pdata->handle_graph));
-    ncFifoDestroy (&(pdata->handle_fifo_output));
-    ncFifoDestroy (&(pdata->handle_fifo_input));
-    ncDeviceDestroy (&(pdata->handle_device));
+    G_LOCK (mvncsdk2_devices);
+    pdata->dev->refcount--;
+    if (pdata->dev->refcount == 0) {
+      dev = pdata->dev;
+      mvncsdk2_devices[dev->idx_device] = NULL;
+    }
+    G_UNLOCK (mvncsdk2_devices);
+
+    if (dev)
+      _mvncsdk2_device_free (dev);
 
     g_free (pdata);
     *private_data = NULL;
@@ -99,13 +154,62 @@ _mvncsdk2_close (const GstTensorFilterProperties * prop, void **private_data)
 }
 
 /**
- * @brief The open callback for GstTensorFilterFramework. Called before anything else
+ * @brief Get the FIFO depth from the custom properties
+ * @return the FIFO depth, 0 if the value is invalid.
+ */
+static guint
+_mvncsdk2_get_fifo_depth (const GstTensorFilterProperties * prop)
+{
+  guint fifo_depth = NNS_MVNCSDK2_DEFAULT_NUM_ELEM_IN_FIFO;
+  gchar **strv;
+  guint i, len;
+
+  if (!prop->custom_properties)
+    return fifo_depth;
+
+  strv = g_strsplit (prop->custom_properties, ",", -1);
+  len = g_strv_length (strv);
+
+  for (i = 0; i < len; ++i) {
+    gchar **pair = g_strsplit (strv[i], ":", -1);
+
+    if (g_strv_length (pair) > 1) {
+      g_strstrip (pair[0]);
+      g_strstrip (pair[1]);
+
+      if (g_ascii_strcasecmp (pair[0], "fifo_depth") == 0) {
+        guint64 val;
+
+        if (g_ascii_string_to_unsigned (pair[1], 10, 1,
+                NNS_MVNCSDK2_MAX_NUM_ELEM_IN_FIFO, &val, NULL)) {
+          fifo_depth = (guint) val;
+        } else {
+          ml_loge ("Invalid value of fifo_depth, %s (1 ~ %d)", pair[1],
+              NNS_MVNCSDK2_MAX_NUM_ELEM_IN_FIFO);
+          fifo_depth = 0;
+        }
+      } else {
+        ml_logw ("Unknown option (%s).", strv[i]);
+      }
+    }
+
+    g_strfreev (pair);
+  }
+
+  g_strfreev (strv);
+  return fifo_depth;
+}
+
+/**
+ * @brief Open the device at the given index and allocate the model
  * @param prop : property of tensor_filter instance
- * @param private_data : movidius-ncsdk2 plugin's private data
- * @return 0 if OK. -1 if error.
+ * @param idx_dev : the index of the device
+ * @param fifo_depth : the number of the elements in the FIFOs
+ * @return the opened device, NULL if error.
  */
-static int
-_mvncsdk2_open (const GstTensorFilterProperties * prop, void **private_data)
+static mvncsdk2_device *
+_mvncsdk2_device_open (const GstTensorFilterProperties * prop, gint32 idx_dev,
+    guint fifo_depth)
 {
   /* Variables of the data types from mvnc.h */
   struct ncDeviceHandle_t *handle_device = NULL;
@@ -117,47 +221,19 @@ _mvncsdk2_open (const GstTensorFilterProperties * prop, void **private_data)
   ncStatus_t ret_code;
   /* Normal variables */
   GMappedFile *file_model = NULL;
-  mvncsdk2_data *pdata = NULL;
-  gint32 sdk_ver[NNS_MVNCSDK2_API_VER_ARRAY_SIZE];
-  guint32 size_sdk_ver = sizeof (sdk_ver);
-  gint32 idx_dev = -1;
+  mvncsdk2_device *dev = NULL;
   guint32 len_model_file;
   void *buf_model_file;
   guint32 len;
-  gint32 i;
-
-  /* 0. Check the API version */
-  ret_code = ncGlobalGetOption (NC_RO_API_VERSION, sdk_ver, &size_sdk_ver);
-  if ((ret_code == NC_OK) && (sdk_ver[0] != NNS_MVNCSDK2_SUPPORT_API_MAJOR_VER)) {
-    g_printerr
-        ("The major version number of the MVNCSDK API should be %d, not %d\n",
-        NNS_MVNCSDK2_SUPPORT_API_MAJOR_VER, sdk_ver[0]);
-    return -1;
-  } else if (ret_code != NC_OK) {
-    g_printerr
-        ("Failed to get the information about the version of the MVNCSDK API\n");
-    return -1;
-  }
 
   /**
-   * 1. Initialize device handle:
-   *  we do not know how many devices are plugged and used. Therefore,
-   *  let's try all the possible device indices (currently,
-   *  0 ~ NNS_MVNCSDK2_SUPPORT_MAX_NUMS_DEVICES) here.
+   * 1. Initialize device handle
    */
-  for (i = 0; i < NNS_MVNCSDK2_SUPPORT_MAX_NUMS_DEVICES; ++i) {
-    ret_code = ncDeviceCreate (i, &handle_device);
-    if (ret_code == NC_OK) {
-      idx_dev = i;
-      break;
-    } else {
-      GST_WARNING ("Failed to create device handle at index %d: "
-          "%d is returned\n", i, ret_code);
-    }
-  }
-  if ((ret_code != NC_OK) && (i == NNS_MVNCSDK2_SUPPORT_MAX_NUMS_DEVICES)) {
-    g_printerr ("Cannot create device handle: no available device found\n");
-    return -1;
+  ret_code = ncDeviceCreate (idx_dev, &handle_device);
+  if (ret_code != NC_OK) {
+    GST_WARNING ("Failed to create device handle at index %d: "
+        "%d is returned\n", idx_dev, ret_code);
+    return NULL;
   }
 
   /**
@@ -175,7 +251,7 @@ _mvncsdk2_open (const GstTensorFilterProperties * prop, void **private_data)
    */
   ret_code = ncDeviceOpen (handle_device);
   if (ret_code != NC_OK) {
-    g_printerr ("Cannot open device at index %d\n", idx_dev);
+    GST_WARNING ("Cannot open device at index %d\n", idx_dev);
     goto err_destroy_graph_h;
   }
 
@@ -244,14 +320,14 @@ _mvncsdk2_open (const GstTensorFilterProperties * prop, void **private_data)
    * 7. Allocate fifos for input and output tensors
    */
   ret_code = ncFifoAllocate (handle_fifo_input, handle_device,
-      &tensor_desc_input, NNS_MVNCSDK2_MAX_NUM_ELEM_IN_FIFO);
+      &tensor_desc_input, fifo_depth);
   if (ret_code != NC_OK) {
     g_printerr ("Cannot allocate FIFO in the device for input tensor\n");
     goto err_destroy_graph_h;
   }
 
   ret_code = ncFifoAllocate (handle_fifo_output, handle_device,
-      &tensor_desc_output, NNS_MVNCSDK2_MAX_NUM_ELEM_IN_FIFO);
+      &tensor_desc_output, fifo_depth);
   if (ret_code != NC_OK) {
     g_printerr ("Cannot allocate FIFO in the device for output tensor\n");
     ncFifoDestroy (&handle_fifo_input);
@@ -259,23 +335,27 @@ _mvncsdk2_open (const GstTensorFilterProperties * prop, void **private_data)
   }
 
   /**
-   * 8. Create private data and fill it
+   * 8. Create the device data and fill it
    */
-  pdata = g_try_new0 (mvncsdk2_data, 1);
-  if (pdata == NULL) {
-    g_printerr ("Cannot allocate memory for private data structure\n");
+  dev = g_try_new0 (mvncsdk2_device, 1);
+  if (dev == NULL) {
+    g_printerr ("Cannot allocate memory for device data structure\n");
     goto err_destroy_fifo_h;
   }
 
-  pdata->handle_device = handle_device;
-  pdata->handle_graph = handle_graph;
-  pdata->handle_fifo_input = handle_fifo_input;
-  pdata->handle_fifo_output = handle_fifo_output;
-  pdata->tensor_desc_input = tensor_desc_input;
-  pdata->tensor_desc_output = tensor_desc_output;
-  *private_data = pdata;
+  dev->handle_device = handle_device;
+  dev->handle_graph = handle_graph;
+  dev->handle_fifo_input = handle_fifo_input;
+  dev->handle_fifo_output = handle_fifo_output;
+  dev->tensor_desc_input = tensor_desc_input;
+  dev->tensor_desc_output = tensor_desc_output;
+  dev->idx_device = idx_dev;
+  dev->model = g_strdup (prop->model_files[0]);
+  dev->fifo_depth = fifo_depth;
+  g_mutex_init (&dev->lock);
+  g_cond_init (&dev->cond);
 
-  return 0;
+  return dev;
 
 err_destroy_fifo_h:
   ncFifoDestroy (&handle_fifo_input);
@@ -285,60 +365,185 @@ err_destroy_graph_h:
 err_destroy_device_h:
   ncDeviceDestroy (&handle_device);
 
-  g_printerr ("Failed to initialize %s tensor_filter framework", prop->fwname);
-
-  return -1;
+  return NULL;
 }
 
 /**
- * @brief The mandatory callback for GstTensorFilterFramework
+ * @brief The open callback for GstTensorFilterFramework. Called before anything else
  * @param prop : property of tensor_filter instance
  * @param private_data : movidius-ncsdk2 plugin's private data
- * @param[in] input : The array of input tensors
- * @param[out] output : The array of output tensors
- * @return 0 if OK. non-zero if error.
+ * @return 0 if OK. -1 if error.
  */
 static int
-_mvncsdk2_invoke (const GstTensorFilterProperties * prop, void **private_data,
-    const GstTensorMemory * input, GstTensorMemory * output)
+_mvncsdk2_open (const GstTensorFilterProperties * prop, void **private_data)
 {
   ncStatus_t ret_code;
-  mvncsdk2_data *pdata = *private_data;
-  guint32 buf_size;
+  mvncsdk2_data *pdata = NULL;
+  mvncsdk2_device *dev = NULL;
+  gint32 sdk_ver[NNS_MVNCSDK2_API_VER_ARRAY_SIZE];
+  guint32 size_sdk_ver = sizeof (sdk_ver);
+  guint fifo_depth;
+  gint32 i;
 
-  g_return_val_if_fail (prop->input_configured, -1);
-  if (prop->input_meta.num_tensors != NNS_MVNCSDK2_MAX_NUM_TENOSORS_SUPPORTED) {
-    ml_loge ("The number of input tensor should be one: "
-        "The MVNCSDK API supports single tensor input and output only");
-    goto err_destroy;
+  /* 0. Check the API version */
+  ret_code = ncGlobalGetOption (NC_RO_API_VERSION, sdk_ver, &size_sdk_ver);
+  if ((ret_code == NC_OK) && (sdk_ver[0] != NNS_MVNCSDK2_SUPPORT_API_MAJOR_VER)) {
+    g_printerr
+        ("The major version number of the MVNCSDK API should be %d, not %d\n",
+        NNS_MVNCSDK2_SUPPORT_API_MAJOR_VER, sdk_ver[0]);
+    return -1;
+  } else if (ret_code != NC_OK) {
+    g_printerr
+        ("Failed to get the information about the version of the MVNCSDK API\n");
+    return -1;
+  }
+
+  fifo_depth = _mvncsdk2_get_fifo_depth (prop);
+  if (fifo_depth == 0)
+    return -1;
+
+  pdata = g_try_new0 (mvncsdk2_data, 1);
+  if (pdata == NULL) {
+    g_printerr ("Cannot allocate memory for private data structure\n");
+    return -1;
+  }
+
+  G_LOCK (mvncsdk2_devices);
+  /**
+   * 1. Open a device not used yet:
+   *  we do not know how many devices are plugged and used. Therefore,
+   *  let's try all the possible device indices (currently,
+   *  0 ~ NNS_MVNCSDK2_SUPPORT_MAX_NUMS_DEVICES) here.
+   */
+  for (i = 0; i < NNS_MVNCSDK2_SUPPORT_MAX_NUMS_DEVICES && dev == NULL; ++i) {
+    if (mvncsdk2_devices[i] == NULL) {
+      dev = _mvncsdk2_device_open (prop, i, fifo_depth);
+      if (dev)
+        mvncsdk2_devices[i] = dev;
+    }
+  }
+
+  /**
+   * 2. Otherwise, share the device running the same model with the least instances
+   */
+  if (dev) {
+    pdata->dev = dev;
+  } else {
+    for (i = 0; i < NNS_MVNCSDK2_SUPPORT_MAX_NUMS_DEVICES; ++i) {
+      mvncsdk2_device *opened = mvncsdk2_devices[i];
+
+      if (opened == NULL || g_strcmp0 (opened->model, prop->model_files[0]) != 0)
+        continue;
+
+      if (pdata->dev == NULL || opened->refcount < pdata->dev->refcount)
+        pdata->dev = opened;
+    }
   }
 
+  if (pdata->dev)
+    pdata->dev->refcount++;
+  G_UNLOCK (mvncsdk2_devices);
+
+  if (pdata->dev == NULL) {
+    g_printerr ("Cannot create device handle: no available device found\n");
+    g_free (pdata);
+    g_printerr ("Failed to initialize %s tensor_filter framework", prop->fwname);
+    return -1;
+  }
+
+  *private_data = pdata;
+  return 0;
+}
+
+/**
+ * @brief Queue the input to the device and read the output in the queued order
+ * @param dev : the device
+ * @param[in] input : The input tensor
+ * @param[out] output : The output tensor
+ * @return 0 if OK. -1 if error.
+ * @details The instances sharing the device queue the inputs up to the FIFO
+ *          depth, so the device runs the queued inputs while the host writes
+ *          the next input and reads the previous output.
+ */
+static int
+_mvncsdk2_run (mvncsdk2_device * dev, const GstTensorMemory * input,
+    GstTensorMemory * output)
+{
+  ncStatus_t ret_code;
+  guint32 buf_size;
+  guint64 seq;
+
+  g_mutex_lock (&dev->lock);
+  while (dev->num_queued - dev->num_read >= dev->fifo_depth)
+    g_cond_wait (&dev->cond, &dev->lock);
+
   /* Warning: conversion unsigned long to unsigned int */
   buf_size = (guint32) input->size;
-  ret_code = ncFifoWriteElem (pdata->handle_fifo_input, input->data,
+  ret_code = ncFifoWriteElem (dev->handle_fifo_input, input->data,
       &buf_size, 0);
   if (ret_code != NC_OK) {
+    g_mutex_unlock (&dev->lock);
     g_printerr ("Cannot write input data to the FIFO buffer in the device");
-    goto err_destroy;
+    return -1;
   }
 
-  ret_code = ncGraphQueueInference (pdata->handle_graph,
-      &(pdata->handle_fifo_input), NNS_MVNCSDK2_MAX_NUM_TENOSORS_SUPPORTED,
-      &(pdata->handle_fifo_output), NNS_MVNCSDK2_MAX_NUM_TENOSORS_SUPPORTED);
+  ret_code = ncGraphQueueInference (dev->handle_graph,
+      &(dev->handle_fifo_input), NNS_MVNCSDK2_MAX_NUM_TENOSORS_SUPPORTED,
+      &(dev->handle_fifo_output), NNS_MVNCSDK2_MAX_NUM_TENOSORS_SUPPORTED);
   if (ret_code != NC_OK) {
+    g_mutex_unlock (&dev->lock);
     g_printerr ("Failed to run inference using the device\n");
-    goto err_destroy;
+    return -1;
   }
 
+  /* The outputs come out of the FIFO in the queued order */
+  seq = dev->num_queued++;
+  while (dev->num_read != seq)
+    g_cond_wait (&dev->cond, &dev->lock);
+  g_mutex_unlock (&dev->lock);
+
   /* Warning: conversion unsigned long to unsigned int */
   buf_size = (guint32) output->size;
-  ret_code = ncFifoReadElem (pdata->handle_fifo_output, output->data, &buf_size,
+  ret_code = ncFifoReadElem (dev->handle_fifo_output, output->data, &buf_size,
       NULL);
+
+  g_mutex_lock (&dev->lock);
+  dev->num_read++;
+  g_cond_broadcast (&dev->cond);
+  g_mutex_unlock (&dev->lock);
+
   if (ret_code != NC_OK) {
     g_printerr ("Cannot fetch inference results from the device\n");
+    return -1;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief The mandatory callback for GstTensorFilterFramework
+ * @param prop : property of tensor_filter instance
+ * @param private_data : movidius-ncsdk2 plugin's private data
+ * @param[in] input : The array of input tensors
+ * @param[out] output : The array of output tensors
+ * @return 0 if OK. non-zero if error.
+ */
+static int
+_mvncsdk2_invoke (const GstTensorFilterProperties * prop, void **private_data,
+    const GstTensorMemory * input, GstTensorMemory * output)
+{
+  mvncsdk2_data *pdata = *private_data;
+
+  g_return_val_if_fail (prop->input_configured, -1);
+  if (prop->input_meta.num_tensors != NNS_MVNCSDK2_MAX_NUM_TENOSORS_SUPPORTED) {
+    ml_loge ("The number of input tensor should be one: "
+        "The MVNCSDK API supports single tensor input and output only");
     goto err_destroy;
   }
 
+  if (_mvncsdk2_run (pdata->dev, input, output) != 0)
+    goto err_destroy;
+
   return 0;
 
 err_destroy:
@@ -367,7 +572,7 @@ _mvncsdk2_getInputDim (const GstTensorFilterProperties * prop,
     void **private_data, GstTensorsInfo * info)
 {
   mvncsdk2_data *pdata = *private_data;
-  struct ncTensorDescriptor_t *nc_input_desc = &(pdata->tensor_desc_input);
+  struct ncTensorDescriptor_t *nc_input_desc = &(pdata->dev->tensor_desc_input);
   GstTensorInfo *nns_input_tensor_info;
   UNUSED (prop);
 
@@ -401,7 +606,7 @@ _mvncsdk2_getOutputDim (const GstTensorFilterProperties * prop,
     void **private_data, GstTensorsInfo * info)
 {
   mvncsdk2_data *pdata = *private_data;
-  struct ncTensorDescriptor_t *nc_output_desc = &(pdata->tensor_desc_output);
+  struct ncTensorDescriptor_t *nc_output_desc = &(pdata->dev->tensor_desc_output);
   GstTensorInfo *nns_output_info;
   UNUSED (prop);
 
@@ -469,6 +674,9 @@ void
 init_filter_mvncsdk2 (void)
 {
   nnstreamer_filter_probe (&NNS_support_movidius_ncsdk2);
+  nnstreamer_filter_set_custom_property_desc (NNS_support_movidius_ncsdk2.v0.name,
+      "fifo_depth", "The number of the elements in the FIFOs of the stick (default 2).",
+      NULL);
 }
 
 /** @brief Destruct the subplugin */
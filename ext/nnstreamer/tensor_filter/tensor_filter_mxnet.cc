@@ -65,6 +65,17 @@
  *       enable_tensorrt: (optional)
  *            set true to enable NVIDIA TensorRT. GPU acceleration must be
  *            enabled in order to use it.
+ *       engine_type: (optional)
+ *            The execution engine of MXNet (NaiveEngine, ThreadedEngine or
+ *            ThreadedEnginePerDevice). NaiveEngine runs the operators in the
+ *            invoking thread without the scheduling overhead.
+ *       num_threads: (optional)
+ *            The number of the CPU worker threads of the engine (the
+ *            num-threads property of tensor_filter if not given).
+ *            The engine and its threads are shared in the process, so these
+ *            are applied only before the engine is started (the first model
+ *            loaded in the process) and MXNET_ENGINE_TYPE or
+ *            MXNET_CPU_WORKER_NTHREADS is not set in the environment.
  *
  *     Examples:
  *       tensor_filter framework=mxnet model=model/Inception-BN.json
@@ -81,6 +92,7 @@
  *                custom=input_rank=4:1
  */
 #include <nnstreamer_cppplugin_api_filter.hh>
+#include <nnstreamer_log.h>
 #include <nnstreamer_plugin_api.h>
 #include <nnstreamer_util.h>
 #include <stdexcept>
@@ -138,6 +150,7 @@ class TensorFilterMXNet final : public tensor_filter_subplugin
       std::map<std::string, NDArray> *auxParamInTargetContext, Context targetContext);
   void convertParamMapToTargetContext (const std::map<std::string, NDArray> &paramMap,
       std::map<std::string, NDArray> *paramMapInTargetContext, Context targetContext);
+  void setEngineOptions ();
 
   bool empty_model_; /**< Empty (not initialized) model flag */
   static const GstTensorFilterFrameworkInfo info_; /**< Framework info */
@@ -155,8 +168,12 @@ class TensorFilterMXNet final : public tensor_filter_subplugin
   std::unique_ptr<Executor> executor_; /**< Model executor */
   std::map<std::string, NDArray> args_map_; /**< arguments information of model, used internally by MXNet */
   std::map<std::string, NDArray> aux_map_; /**< auxiliary information of model, used internally by MXNet */
+  std::vector<NDArray> input_arrays_; /**< Input arrays bound to the executor */
+  std::vector<NDArray> output_arrays_; /**< Output arrays of the output operators, reused across frames */
   Context ctx_; /**< Device type (CPU or GPU) */
   bool enable_tensorrt_; /**< Enable NVIDIA TensorRT flag */
+  std::string engine_type_; /**< Execution engine of MXNet, empty for the default */
+  int num_threads_; /**< The number of the CPU worker threads of the engine, 0 for the default */
 
   static TensorFilterMXNet *registeredRepresentation;
 };
@@ -177,7 +194,7 @@ const GstTensorFilterFrameworkInfo TensorFilterMXNet::info_ = { .name = "mxnet",
 
 TensorFilterMXNet::TensorFilterMXNet ()
     : tensor_filter_subplugin (), empty_model_ (true), ctx_ (Context::cpu ()),
-      enable_tensorrt_ (false)
+      enable_tensorrt_ (false), num_threads_ (0)
 {
   /** Nothing to do. Just let it have an empty instance */
 }
@@ -205,6 +222,8 @@ TensorFilterMXNet::configure_instance (const GstTensorFilterProperties *prop)
     ctx_ = Context::gpu ();
   }
 
+  num_threads_ = prop->num_threads;
+
   try {
     parseCustomProperties (prop);
   } catch (const std::invalid_argument &e) {
@@ -212,6 +231,9 @@ TensorFilterMXNet::configure_instance (const GstTensorFilterProperties *prop)
                                  + std::string (e.what ()) + "\n\tReference: " + __FILE__);
   }
 
+  // The engine is started with the first model loaded in the process
+  setEngineOptions ();
+
   // Validate model file paths and then assign
   std::tie (model_symbol_path_, model_params_path_) = [&] {
     const std::vector<std::string> extensions{ TensorFilterMXNet::ext_symbol,
@@ -267,12 +289,15 @@ TensorFilterMXNet::configure_instance (const GstTensorFilterProperties *prop)
   gst_tensors_info_copy (&inputs_info_, &prop->input_meta);
   gst_tensors_info_copy (&outputs_info_, &prop->output_meta);
 
-  // Set ndarrays for the input layers
+  // Set ndarrays for the input layers, bound to the executor once and filled per frame
+  input_arrays_.clear ();
+  output_arrays_.assign (outputs_info_.num_tensors, NDArray ());
   for (unsigned int i = 0; i < inputs_info_.num_tensors; i++) {
     auto &input_tensor = inputs_info_.info[i];
     args_map_[input_tensor.name]
         = NDArray (tensorInfoToShape (input_tensor, input_ranks_[i]), ctx_,
             false, tensorTypeToMXNet (input_tensor.type));
+    input_arrays_.push_back (args_map_[input_tensor.name]);
   }
 
   // These are ndarrays where the execution engine runs
@@ -305,34 +330,31 @@ TensorFilterMXNet::invoke (const GstTensorMemory *input, GstTensorMemory *output
   assert (!empty_model_);
   assert (executor_);
 
-  // Copy input
+  // Copy input into the arrays bound to the executor.
+  // The copy is synchronous, and the engine orders the forward pass after it.
   for (unsigned int i = 0; i < inputs_info_.num_tensors; i++) {
-    auto &input_info = inputs_info_.info[i];
-    auto &input_ndarray = args_map_[input_info.name];
+    auto &input_ndarray = input_arrays_[i];
 
     assert ((input_ndarray.Size () * sizeof (mx_float)) == input[i].size);
     input_ndarray.SyncCopyFromCPU (
         (const mx_float *) input[i].data, input_ndarray.Size ());
-    NDArray::WaitAll ();
   }
 
   // Run forward pass
   executor_->Forward (false);
-  NDArray::WaitAll ();
 
-  // Copy output
+  // Copy output, SyncCopyToCPU waits for the operators writing the array
   for (unsigned int i = 0; i < outputs_info_.num_tensors; i++) {
     auto &output_info = outputs_info_.info[i];
-    NDArray result;
+    NDArray &result = output_arrays_[i];
 
     // Warning: It will cause segfault if the operator name (output name) is different from expected.
     //          The user should know the name of the operator name.
+    // The operator allocates the result at the first frame, and writes into it after that.
     Operator (output_info.name) (executor_->outputs[0]).Invoke (result);
-    NDArray::WaitAll ();
 
     assert ((result.Size () * sizeof (mx_float)) == output[i].size);
     result.SyncCopyToCPU ((mx_float *) output[i].data, result.Size ());
-    NDArray::WaitAll ();
   }
 }
 
@@ -440,6 +462,19 @@ TensorFilterMXNet::parseCustomProperties (const GstTensorFilterProperties *prop)
             }
             enable_tensorrt_ = true;
           }
+        } else if (g_ascii_strcasecmp (option.get ()[0], "engine_type") == 0) {
+          if (g_ascii_strcasecmp (option.get ()[1], "NaiveEngine") != 0
+              && g_ascii_strcasecmp (option.get ()[1], "ThreadedEngine") != 0
+              && g_ascii_strcasecmp (option.get ()[1], "ThreadedEnginePerDevice") != 0) {
+            throw std::invalid_argument (
+                "Unsupported engine_type: " + std::string (option.get ()[1]) + ".");
+          }
+          engine_type_ = option.get ()[1];
+        } else if (g_ascii_strcasecmp (option.get ()[0], "num_threads") == 0) {
+          num_threads_ = (int) g_ascii_strtoll (option.get ()[1], nullptr, 10);
+          if (num_threads_ < 0) {
+            throw std::invalid_argument ("num_threads should be 0 or positive.");
+          }
         } else {
           throw std::invalid_argument (
               "Unsupported custom property: " + std::string (option.get ()[0]) + ".");
@@ -454,6 +489,31 @@ TensorFilterMXNet::parseCustomProperties (const GstTensorFilterProperties *prop)
   return;
 }
 
+/**
+ * @brief Set the engine type and the worker threads of MXNet, read when the engine is started.
+ */
+void
+TensorFilterMXNet::setEngineOptions ()
+{
+  if (!engine_type_.empty ()) {
+    if (!g_setenv ("MXNET_ENGINE_TYPE", engine_type_.c_str (), FALSE)
+        || g_strcmp0 (g_getenv ("MXNET_ENGINE_TYPE"), engine_type_.c_str ()) != 0) {
+      ml_logw ("MXNet engine type is already set (%s), engine_type (%s) is ignored.",
+          GST_STR_NULL (g_getenv ("MXNET_ENGINE_TYPE")), engine_type_.c_str ());
+    }
+  }
+
+  if (num_threads_ > 0) {
+    std::string threads = std::to_string (num_threads_);
+
+    if (!g_setenv ("MXNET_CPU_WORKER_NTHREADS", threads.c_str (), FALSE)
+        || g_strcmp0 (g_getenv ("MXNET_CPU_WORKER_NTHREADS"), threads.c_str ()) != 0) {
+      ml_logw ("MXNet worker threads are already set (%s), num_threads (%d) is ignored.",
+          GST_STR_NULL (g_getenv ("MXNET_CPU_WORKER_NTHREADS")), num_threads_);
+    }
+  }
+}
+
 /**
  * @brief split loaded param map into arg param and aux param with target context
  */
@@ -23,6 +23,11 @@
  *
  * This is the per-NN-framework plugin (Tizen nnfw) for tensor_filter.
  *
+ * Each instance has its own session. For concurrent invokes, set the
+ * property 'workers' of tensor_filter; each worker opens a session.
+ * The memory of the tensors is bound to the session only when it is
+ * changed from the previous invoke (e.g., the buffers from a pool).
+ *
  * @todo NYI: support quant8,bool type
  *
  */
@@ -99,13 +104,17 @@ typedef struct
   nnfw_session *session;
   gchar *model_file;
   gchar *accelerator;
+  gchar **op_backends; /**< per-op backend mapping, op=backend */
+  GstTensorMemory bound_in[NNS_TENSOR_SIZE_LIMIT]; /**< input memory bound to the session */
+  GstTensorMemory bound_out[NNS_TENSOR_SIZE_LIMIT]; /**< output memory bound to the session */
 } nnfw_pdata;
 
 static void nnfw_close (const GstTensorFilterProperties * prop,
     void **private_data);
 static int nnfw_tensors_info_get (const nnfw_pdata * pdata,
     const gboolean is_input, nnfw_tinfo_s * info);
-static int nnfw_invoke_internal (const nnfw_pdata * pdata,
+static void nnfw_tensor_memory_reset (nnfw_pdata * pdata);
+static int nnfw_invoke_internal (nnfw_pdata * pdata,
     const nnfw_tinfo_s * in_info, const nnfw_tinfo_s * out_info,
     const GstTensorMemory * input, GstTensorMemory * output);
 
@@ -165,6 +174,9 @@ nnfw_parse_custom_option (const GstTensorFilterProperties * prop,
          */
         if (g_ascii_strcasecmp (option[0], "Runtime") == 0) {
           pdata->accelerator = g_strdup (option[1]);
+        } else if (g_ascii_strcasecmp (option[0], "OpBackend") == 0) {
+          g_strfreev (pdata->op_backends);
+          pdata->op_backends = g_strsplit (option[1], ";", -1);
         } else {
           nns_logw ("Unknown option (%s).", options[i]);
         }
@@ -183,6 +195,51 @@ nnfw_parse_custom_option (const GstTensorFilterProperties * prop,
   }
 }
 
+/**
+ * @brief Set the backend of the operations, given with custom option OpBackend (e.g., Conv2D=acl_neon;FullyConnected=cpu).
+ * @param[in] pdata nnfw private data
+ * @return 0 on success, negative errno on error
+ */
+static int
+nnfw_set_op_backends (nnfw_pdata * pdata)
+{
+  NNFW_STATUS status;
+  guint i;
+
+  if (pdata->op_backends == NULL)
+    return 0;
+
+  for (i = 0; pdata->op_backends[i] != NULL; i++) {
+    gchar **op_backend;
+
+    if (pdata->op_backends[i][0] == '\0')
+      continue;
+
+    op_backend = g_strsplit (pdata->op_backends[i], "=", 2);
+    if (g_strv_length (op_backend) != 2) {
+      nns_loge ("Invalid op backend (%s), the format is op=backend.",
+          pdata->op_backends[i]);
+      g_strfreev (op_backend);
+      return -EINVAL;
+    }
+
+    g_strstrip (op_backend[0]);
+    g_strstrip (op_backend[1]);
+
+    status = nnfw_set_op_backend (pdata->session, op_backend[0], op_backend[1]);
+    if (status != NNFW_STATUS_NO_ERROR) {
+      nns_loge ("Cannot set nnfw-runtime backend of %s to %s\n",
+          op_backend[0], op_backend[1]);
+      g_strfreev (op_backend);
+      return -EINVAL;
+    }
+
+    g_strfreev (op_backend);
+  }
+
+  return 0;
+}
+
 /**
  * @brief The standard tensor_filter callback
  */
@@ -247,6 +304,10 @@ nnfw_open (const GstTensorFilterProperties * prop, void **private_data)
     goto error_exit;
   }
 
+  err = nnfw_set_op_backends (pdata);
+  if (err)
+    goto error_exit;
+
   status = nnfw_prepare (pdata->session);
   if (status != NNFW_STATUS_NO_ERROR) {
     err = -EINVAL;
@@ -307,6 +368,9 @@ nnfw_close (const GstTensorFilterProperties * prop, void **private_data)
   g_free (pdata->accelerator);
   pdata->accelerator = NULL;
 
+  g_strfreev (pdata->op_backends);
+  pdata->op_backends = NULL;
+
   g_free (pdata);
   *private_data = NULL;
 }
@@ -418,11 +482,14 @@ nnfw_convert_to_gst_info (const nnfw_tinfo_s * nnfw_info,
  * @todo nnfw_apply_tensorinfo() will be deprecated. Use nnfw_set_input_tensorinfo() later (nnfw ver >= 1.6.0).
  */
 static int
-nnfw_set_input_info (const nnfw_pdata * pdata, guint idx,
+nnfw_set_input_info (nnfw_pdata * pdata, guint idx,
     nnfw_tensorinfo * info)
 {
   NNFW_STATUS status;
 
+  /* the session may reset the memory of the tensors */
+  nnfw_tensor_memory_reset (pdata);
+
 #if defined (NNFW_USE_OLD_API)
   status = nnfw_apply_tensorinfo (pdata->session, idx, *info);
 #else
@@ -440,7 +507,7 @@ nnfw_set_input_info (const nnfw_pdata * pdata, guint idx,
  * @return 0 on success, errno on failure
  */
 static int
-nnfw_tensor_info_set (const nnfw_pdata * pdata,
+nnfw_tensor_info_set (nnfw_pdata * pdata,
     const GstTensorsInfo * tensors_info, guint tensor_idx)
 {
   struct nnfw_tensorinfo nnfw_info;
@@ -552,7 +619,7 @@ nnfw_getOutputDim (const GstTensorFilterProperties * prop,
  * When changing the input shape, NNFW will update the output shape after the invoke process is done.
  */
 static gboolean
-nnfw_invoke_dummy (const nnfw_pdata * pdata, const nnfw_tinfo_s * in_info,
+nnfw_invoke_dummy (nnfw_pdata * pdata, const nnfw_tinfo_s * in_info,
     const nnfw_tinfo_s * out_info)
 {
   GstTensorsInfo gst_in_info, gst_out_info;
@@ -606,6 +673,9 @@ nnfw_invoke_dummy (const nnfw_pdata * pdata, const nnfw_tinfo_s * in_info,
     output[i].data = NULL;
   }
 
+  /* the dummy memory is freed, bind the memory again in next invoke */
+  nnfw_tensor_memory_reset (pdata);
+
   return !failed;
 }
 
@@ -682,20 +752,27 @@ error:
  * @param[in] mem Tensor memory containing input/output information
  * @param[in] info Tensor information in nnfw format
  * @param[in] is_input given memory is for input or output
+ * @note The memory is bound again only if it is changed from the previous invoke.
  * @return 0 on sucess, negative errno on error
  */
 static int
-nnfw_tensor_memory_set (const nnfw_pdata * pdata, const GstTensorMemory * mem,
+nnfw_tensor_memory_set (nnfw_pdata * pdata, const GstTensorMemory * mem,
     const nnfw_tinfo_s * info, const gboolean is_input)
 {
   NNFW_STATUS nnfw_status;
+  GstTensorMemory *bound;
   guint idx;
 
   g_return_val_if_fail (G_UNLIKELY (pdata != NULL), -EINVAL);
   g_return_val_if_fail (G_UNLIKELY (mem != NULL && info != NULL), -EINVAL);
   g_return_val_if_fail (G_UNLIKELY (pdata->session != NULL), -EPERM);
 
+  bound = is_input ? pdata->bound_in : pdata->bound_out;
+
   for (idx = 0; idx < info->num_tensors; idx++) {
+    if (bound[idx].data == mem[idx].data && bound[idx].size == mem[idx].size)
+      continue;
+
     if (is_input) {
       nnfw_status = nnfw_set_input (pdata->session, idx,
           info->info[idx].dtype, mem[idx].data, mem[idx].size);
@@ -703,18 +780,34 @@ nnfw_tensor_memory_set (const nnfw_pdata * pdata, const GstTensorMemory * mem,
       nnfw_status = nnfw_set_output (pdata->session, idx,
           info->info[idx].dtype, mem[idx].data, mem[idx].size);
     }
-    if (nnfw_status != NNFW_STATUS_NO_ERROR)
+    if (nnfw_status != NNFW_STATUS_NO_ERROR) {
+      bound[idx].data = NULL;
+      bound[idx].size = 0;
       return -EINVAL;
+    }
+
+    bound[idx] = mem[idx];
   }
 
   return 0;
 }
 
+/**
+ * @brief Clear the memory bound to the session.
+ * @param[in] pdata nnfw private data
+ */
+static void
+nnfw_tensor_memory_reset (nnfw_pdata * pdata)
+{
+  memset (pdata->bound_in, 0, sizeof (pdata->bound_in));
+  memset (pdata->bound_out, 0, sizeof (pdata->bound_out));
+}
+
 /**
  * @brief Internal function to run nnfw session.
  */
 static int
-nnfw_invoke_internal (const nnfw_pdata * pdata,
+nnfw_invoke_internal (nnfw_pdata * pdata,
     const nnfw_tinfo_s * in_info, const nnfw_tinfo_s * out_info,
     const GstTensorMemory * input, GstTensorMemory * output)
 {
@@ -822,7 +915,9 @@ init_filter_nnfw (void)
   nnstreamer_filter_probe (&NNS_support_nnfw);
 
   nnstreamer_filter_set_custom_property_desc (filter_subplugin_nnfw,
-      "Runtime", "Backends on which NNFW uses", NULL);
+      "Runtime", "Backends on which NNFW uses",
+      "OpBackend", "Backend of the operations, separated by ';' (e.g., Conv2D=acl_neon;FullyConnected=cpu)",
+      NULL);
 }
 
 /** @brief Destruct the subplugin */
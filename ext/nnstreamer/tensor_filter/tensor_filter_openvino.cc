@@ -22,9 +22,20 @@
  * @bug     No known bugs except for NYI items
  *
  * This is the per-NN-framework plugin (OpenVino) for tensor_filter.
+ *
+ * The instances of the same model share the executable network and the pool of
+ * the infer requests, which are started asynchronously. Set the property workers
+ * of tensor_filter to invoke the instances concurrently.
+ * The custom properties are as follows (e.g., custom=num_requests:4,performance_hint:THROUGHPUT).
+ *  - num_requests: the max number of the infer requests (default 0, created on demand).
+ *  - performance_hint: OpenVINO PERFORMANCE_HINT, THROUGHPUT or LATENCY.
+ *  - cache_dir: the directory to store the compiled networks (OpenVINO CACHE_DIR).
+ *    The default is cache_dir of [openvino] in nnstreamer.ini, and 'cache_dir:' disables it.
+ *    Whether the network is loaded from the cache is posted with the bus message 'tensor-filter-model-cache'.
  */
 
 #include <glib.h>
+#include <nnstreamer_conf.h>
 #include <nnstreamer_log.h>
 #define NO_ANONYMOUS_NESTED_STRUCT
 #include <nnstreamer_plugin_api_filter.h>
@@ -34,7 +45,9 @@
 #include <ext_list.hpp>
 #endif /* __OPENVINO_CPU_EXT__ */
 #include <inference_engine.hpp>
+#include <cstring>
 #include <iostream>
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <nnstreamer_util.h>
@@ -57,6 +70,9 @@ std::map<accl_hw, std::string> TensorFilterOpenvino::_nnsAcclHwToOVDevMap = {
   { ACCL_CPU, "CPU" }, { ACCL_NPU, "MYRIAD" }, { ACCL_NPU_MOVIDIUS, "MYRIAD" },
 };
 
+std::mutex TensorFilterOpenvino::_sharedNetsLock;
+std::map<std::string, std::weak_ptr<TensorFilterOpenvino::SharedNetwork>> TensorFilterOpenvino::_sharedNets;
+
 const std::string TensorFilterOpenvino::extBin = ".bin";
 const std::string TensorFilterOpenvino::extXml = ".xml";
 
@@ -181,6 +197,68 @@ TensorFilterOpenvino::TensorFilterOpenvino (std::string pathModelXml, std::strin
   this->_outputsDataMap = (this->_networkCNN).getOutputsInfo ();
   this->_isLoaded = false;
   this->_hw = ACCL_NONE;
+  this->_numRequests = 0;
+
+  gchar *cache_dir = nnsconf_get_custom_value_string ("openvino", "cache_dir");
+  if (cache_dir) {
+    this->_cacheDir = g_strstrip (cache_dir);
+    g_free (cache_dir);
+  }
+}
+
+/**
+ * @brief Parse the custom properties of the tensor_filter (num_requests, performance_hint and cache_dir)
+ * @param custom_props the custom properties, 'key:value' separated by ','
+ * @return 0 (TensorFilterOpenvino::RetSuccess) if OK, negative values if error
+ */
+int
+TensorFilterOpenvino::setCustomProperties (const char *custom_props)
+{
+  gchar **strv;
+  guint i, len;
+  int ret = RetSuccess;
+
+  if (!custom_props)
+    return RetSuccess;
+
+  strv = g_strsplit (custom_props, ",", -1);
+  len = g_strv_length (strv);
+
+  for (i = 0; i < len && ret == RetSuccess; ++i) {
+    gchar **pair = g_strsplit (strv[i], ":", 2);
+
+    if (g_strv_length (pair) > 1) {
+      g_strstrip (pair[0]);
+      g_strstrip (pair[1]);
+
+      if (g_ascii_strcasecmp (pair[0], "num_requests") == 0) {
+        guint64 num;
+
+        if (g_ascii_string_to_unsigned (pair[1], 10, 0, G_MAXUINT16, &num, NULL)) {
+          this->_numRequests = (guint) num;
+        } else {
+          ml_loge ("Invalid value of num_requests, %s", pair[1]);
+          ret = RetEInval;
+        }
+      } else if (g_ascii_strcasecmp (pair[0], "performance_hint") == 0) {
+        if (g_ascii_strcasecmp (pair[1], "THROUGHPUT") == 0) {
+          this->_perfHint = "THROUGHPUT";
+        } else if (g_ascii_strcasecmp (pair[1], "LATENCY") == 0) {
+          this->_perfHint = "LATENCY";
+        } else {
+          ml_loge ("Invalid value of performance_hint, %s (THROUGHPUT or LATENCY)", pair[1]);
+          ret = RetEInval;
+        }
+      } else if (g_ascii_strcasecmp (pair[0], "cache_dir") == 0) {
+        this->_cacheDir = pair[1];
+      }
+    }
+
+    g_strfreev (pair);
+  }
+
+  g_strfreev (strv);
+  return ret;
 }
 
 /**
@@ -223,23 +301,330 @@ TensorFilterOpenvino::loadModel (accl_hw hw)
     return RetEInval;
   }
 
+  {
+    std::lock_guard<std::mutex> lock (_sharedNetsLock);
+    std::string key = this->_pathModelXml + "|" + this->_pathModelBin + "|"
+                      + _nnsAcclHwToOVDevMap[hw] + "|" + this->_perfHint + "|"
+                      + std::to_string (this->_numRequests) + "|" + this->_cacheDir;
+
+    /* Reuse the network loaded by the other instance */
+    auto it = _sharedNets.find (key);
+    if (it != _sharedNets.end ())
+      this->_sharedNet = it->second.lock ();
+
+    if (!this->_sharedNet) {
+      auto shared = std::make_shared<SharedNetwork> ();
+      int ret = loadNetwork (*shared, hw);
+
+      if (ret != RetSuccess)
+        return ret;
+
+      this->_sharedNet = shared;
+      _sharedNets[key] = shared;
+    }
+  }
+
+  this->_hw = hw;
+  this->_isLoaded = true;
+
+  return RetSuccess;
+}
+
+/**
+ * @brief Load the network onto the target device and create the infer requests
+ * @param shared the shared network to be loaded
+ * @param hw a user-given acceleration device to use
+ * @return 0 (TensorFilterOpenvino::RetSuccess) if OK, negative values if error
+ */
+int
+TensorFilterOpenvino::loadNetwork (SharedNetwork &shared, accl_hw hw)
+{
+  std::map<std::string, std::string> config;
+  bool useCache = false;
+  guint numCached = 0;
+  gint64 start;
+  guint i;
+
 #ifdef __OPENVINO_CPU_EXT__
   if (hw == ACCL_CPU) {
-    this->_ieCore.AddExtension (
+    shared.core.AddExtension (
         std::make_shared<InferenceEngine::Extensions::Cpu::CpuExtensions> (),
         _nnsAcclHwToOVDevMap[hw]);
   }
 #endif
-  /** @todo Catch the IE exception */
-  this->_executableNet
-      = this->_ieCore.LoadNetwork (this->_networkCNN, _nnsAcclHwToOVDevMap[hw]);
-  this->_hw = hw;
-  this->_isLoaded = true;
-  this->_inferRequest = this->_executableNet.CreateInferRequest ();
+
+  if (!this->_perfHint.empty ())
+    config["PERFORMANCE_HINT"] = this->_perfHint;
+
+  if (!this->_cacheDir.empty ()) {
+    if (g_mkdir_with_parents (this->_cacheDir.c_str (), 0700) != 0) {
+      ml_logw ("Failed to create the cache directory %s, the network is not cached.",
+          this->_cacheDir.c_str ());
+    } else if (!isCacheSupported (shared, hw)) {
+      ml_logw ("The device %s cannot export the compiled network, cache_dir is ignored.",
+          _nnsAcclHwToOVDevMap[hw].c_str ());
+    } else {
+      useCache = true;
+      numCached = countCacheFiles (this->_cacheDir);
+      config["CACHE_DIR"] = this->_cacheDir;
+    }
+  }
+
+  start = g_get_monotonic_time ();
+  try {
+    shared.net = shared.core.LoadNetwork (this->_networkCNN, _nnsAcclHwToOVDevMap[hw], config);
+  } catch (const std::exception &e) {
+    if (config.empty ()) {
+      ml_loge ("Failed to load the network: %s", e.what ());
+      return RetEInval;
+    }
+
+    /* The runtime before PERFORMANCE_HINT or CACHE_DIR: use the CPU streams for throughput */
+    ml_logw ("Failed to set the configuration (%s), try the legacy configuration.", e.what ());
+    config.clear ();
+    useCache = false;
+    if (this->_perfHint == "THROUGHPUT" && hw == ACCL_CPU) {
+      config[InferenceEngine::PluginConfigParams::KEY_CPU_THROUGHPUT_STREAMS]
+          = InferenceEngine::PluginConfigParams::CPU_THROUGHPUT_AUTO;
+    }
+
+    try {
+      shared.net = shared.core.LoadNetwork (this->_networkCNN, _nnsAcclHwToOVDevMap[hw], config);
+    } catch (const std::exception &e2) {
+      ml_loge ("Failed to load the network: %s", e2.what ());
+      return RetEInval;
+    }
+  }
+
+  /* The runtime writes the compiled network into the cache directory if not found */
+  shared.compileTime = g_get_monotonic_time () - start;
+  if (useCache)
+    shared.cacheHit = (countCacheFiles (this->_cacheDir) > numCached) ? 0 : 1;
+  else
+    shared.cacheHit = -1;
+
+  shared.numCreated = 0;
+  shared.maxRequests = this->_numRequests;
+
+  /* Create the infer requests in advance if the number is given */
+  try {
+    for (i = 0; i < shared.maxRequests; ++i) {
+      shared.idle.push_back (std::make_shared<InferSlot> (
+          shared.net.CreateInferRequest ()));
+      shared.numCreated++;
+    }
+  } catch (const std::exception &e) {
+    ml_loge ("Failed to create the infer request: %s", e.what ());
+    return RetEInval;
+  }
+
+  return RetSuccess;
+}
+
+/**
+ * @brief Check the device can import and export the compiled network
+ * @param shared the shared network to be loaded
+ * @param hw a user-given acceleration device to use
+ * @return true if the compiled network can be cached
+ */
+bool
+TensorFilterOpenvino::isCacheSupported (SharedNetwork &shared, accl_hw hw)
+{
+  const std::string &dev = _nnsAcclHwToOVDevMap[hw];
+
+  try {
+    std::vector<std::string> metrics
+        = shared.core.GetMetric (dev, "SUPPORTED_METRICS").as<std::vector<std::string>> ();
+
+    if (std::find (metrics.begin (), metrics.end (), "IMPORT_EXPORT_SUPPORT") != metrics.end ())
+      return shared.core.GetMetric (dev, "IMPORT_EXPORT_SUPPORT").as<bool> ();
+
+    std::vector<std::string> caps
+        = shared.core.GetMetric (dev, "OPTIMIZATION_CAPABILITIES").as<std::vector<std::string>> ();
+
+    return std::find (caps.begin (), caps.end (), "EXPORT_IMPORT") != caps.end ();
+  } catch (const std::exception &e) {
+    ml_logw ("Failed to get the capabilities of the device %s: %s", dev.c_str (), e.what ());
+  }
+
+  return false;
+}
+
+/**
+ * @brief Get the number of the files in the cache directory
+ */
+guint
+TensorFilterOpenvino::countCacheFiles (const std::string &dir)
+{
+  GDir *gdir;
+  guint count = 0;
+
+  gdir = g_dir_open (dir.c_str (), 0, NULL);
+  if (gdir) {
+    while (g_dir_read_name (gdir) != NULL)
+      count++;
+    g_dir_close (gdir);
+  }
+
+  return count;
+}
+
+/**
+ * @brief Get the status of the compiled network cache
+ * @param[out] hit true if the network is imported from the cache directory
+ * @param[out] compileTime the time to load the network onto the device (usec)
+ * @return true if the cache is used
+ */
+bool
+TensorFilterOpenvino::getModelCache (bool *hit, gint64 *compileTime)
+{
+  if (!this->_sharedNet || this->_sharedNet->cacheHit < 0)
+    return false;
+
+  *hit = (this->_sharedNet->cacheHit == 1);
+  *compileTime = this->_sharedNet->compileTime;
+  return true;
+}
+
+/**
+ * @brief Constructor of the infer request with no blob bound
+ */
+TensorFilterOpenvino::InferSlot::InferSlot (InferenceEngine::InferRequest req)
+    : request (req)
+{
+  guint i;
+
+  for (i = 0; i < NNS_TENSOR_SIZE_LIMIT; ++i) {
+    inData[i] = nullptr;
+    outData[i] = nullptr;
+  }
+}
+
+/**
+ * @brief Bind the memory of tensor_filter to the infer request
+ * @param slot the infer request
+ * @param isInput true for the input tensor, false for the output tensor
+ * @param idx the index of the tensor
+ * @param info the information of the tensor
+ * @param mem the memory of the tensor
+ * @return 0 (TensorFilterOpenvino::RetSuccess) if OK, negative values if error
+ * @details The blob is created over the memory without copying the data, and
+ *          set to the request only if the memory differs from the bound one.
+ *          If the memory is not aligned to the element type, the data is copied
+ *          through the staging buffer kept in the request.
+ */
+int
+TensorFilterOpenvino::bindBlob (InferSlot &slot, bool isInput, guint idx,
+    const GstTensorInfo *info, const GstTensorMemory *mem)
+{
+  const InferenceEngine::TensorDesc &desc
+      = isInput ? this->_inputTensorDescs[idx] : this->_outputTensorDescs[idx];
+  const void **inData = &slot.inData[idx];
+  void **outData = &slot.outData[idx];
+  InferenceEngine::Blob::Ptr blob;
+  gsize esize = gst_tensor_get_element_size (info->type);
+
+  if (esize > 0 && ((guintptr) mem->data) % esize == 0) {
+    /* Keep the blob bound to the request while the memory is the same */
+    if (isInput && *inData == mem->data)
+      return RetSuccess;
+    if (!isInput && *outData == mem->data)
+      return RetSuccess;
+
+    blob = convertGstTensorMemoryToBlobPtr (desc, mem, info->type);
+    if (blob == nullptr) {
+      ml_loge ("Failed to create a blob for the tensor: %u", idx);
+      return RetEInval;
+    }
+
+    slot.request.SetBlob (info->name, blob);
+    if (isInput)
+      *inData = mem->data;
+    else
+      *outData = mem->data;
+    return RetSuccess;
+  }
+
+  /* Unaligned memory, copy the data through the staging buffer of the request */
+  std::vector<guint8> &staging = isInput ? slot.inStaging[idx] : slot.outStaging[idx];
+  InferenceEngine::Blob::Ptr &copy = isInput ? slot.inCopy[idx] : slot.outCopy[idx];
+  bool rebind = isInput ? (*inData != nullptr) : (*outData != nullptr);
+
+  if (copy == nullptr) {
+    GstTensorMemory allocated;
+
+    staging.resize (mem->size);
+    allocated.data = staging.data ();
+    allocated.size = mem->size;
+
+    copy = convertGstTensorMemoryToBlobPtr (desc, &allocated, info->type);
+    if (copy == nullptr) {
+      ml_loge ("Failed to create a blob for the tensor: %u", idx);
+      return RetEInval;
+    }
+    rebind = true;
+  }
+
+  if (rebind) {
+    slot.request.SetBlob (info->name, copy);
+    if (isInput)
+      *inData = nullptr;
+    else
+      *outData = nullptr;
+  }
+
+  if (isInput)
+    memcpy (staging.data (), mem->data, mem->size);
 
   return RetSuccess;
 }
 
+/**
+ * @brief Get an idle infer request, create new one or wait if all are in use
+ * @return the infer request, nullptr if error
+ */
+TensorFilterOpenvino::InferRequestPtr
+TensorFilterOpenvino::acquireRequest ()
+{
+  SharedNetwork *shared = this->_sharedNet.get ();
+  std::unique_lock<std::mutex> lock (shared->lock);
+  InferRequestPtr request;
+
+  while (shared->idle.empty ()) {
+    if (shared->maxRequests == 0 || shared->numCreated < shared->maxRequests) {
+      try {
+        request = std::make_shared<InferSlot> (
+            shared->net.CreateInferRequest ());
+      } catch (const std::exception &e) {
+        ml_loge ("Failed to create the infer request: %s", e.what ());
+        return nullptr;
+      }
+
+      shared->numCreated++;
+      return request;
+    }
+
+    shared->cond.wait (lock);
+  }
+
+  request = shared->idle.back ();
+  shared->idle.pop_back ();
+  return request;
+}
+
+/**
+ * @brief Return the infer request to the pool
+ */
+void
+TensorFilterOpenvino::releaseRequest (InferRequestPtr request)
+{
+  SharedNetwork *shared = this->_sharedNet.get ();
+  std::lock_guard<std::mutex> lock (shared->lock);
+
+  shared->idle.push_back (request);
+  shared->cond.notify_one ();
+}
+
 /**
  * @brief	Get the information about the dimensions of input tensors from the given model
  * @param[out] info metadata containing the dimesions and types information of the input tensors
@@ -399,38 +784,51 @@ int
 TensorFilterOpenvino::invoke (const GstTensorFilterProperties *prop,
     const GstTensorMemory *input, GstTensorMemory *output)
 {
-  InferenceEngine::BlobMap inBlobMap;
-  InferenceEngine::BlobMap outBlobMap;
+  InferenceEngine::StatusCode status;
+  InferRequestPtr request;
   guint num_tensors;
   guint i;
 
-  num_tensors = (prop->input_meta).num_tensors;
-  for (i = 0; i < num_tensors; ++i) {
-    const GstTensorInfo *info = &((prop->input_meta).info[i]);
-    InferenceEngine::Blob::Ptr blob = convertGstTensorMemoryToBlobPtr (
-        this->_inputTensorDescs[i], &(input[i]), prop->input_meta.info[i].type);
-    if (blob == nullptr) {
-      ml_loge ("Failed to create a blob for the input tensor: %u", i);
-      return RetEInval;
+  request = acquireRequest ();
+  if (!request)
+    return RetEInval;
+
+  /* Other requests of the shared network run on the device meanwhile */
+  try {
+    num_tensors = (prop->input_meta).num_tensors;
+    for (i = 0; i < num_tensors; ++i) {
+      if (bindBlob (*request, true, i, &prop->input_meta.info[i], &input[i]) != RetSuccess)
+        throw std::runtime_error ("cannot set the input blob");
     }
-    inBlobMap.insert (make_pair (std::string (info->name), blob));
-  }
-  this->_inferRequest.SetInput (inBlobMap);
 
-  num_tensors = (prop->output_meta).num_tensors;
-  for (i = 0; i < num_tensors; ++i) {
-    const GstTensorInfo *info = &((prop->output_meta).info[i]);
-    InferenceEngine::Blob::Ptr blob = convertGstTensorMemoryToBlobPtr (
-        this->_outputTensorDescs[i], &(output[i]), prop->output_meta.info[i].type);
-    outBlobMap.insert (make_pair (std::string (info->name), blob));
-    if (blob == nullptr) {
-      ml_loge ("Failed to create a blob for the output tensor: %u", i);
-      return RetEInval;
+    num_tensors = (prop->output_meta).num_tensors;
+    for (i = 0; i < num_tensors; ++i) {
+      if (bindBlob (*request, false, i, &prop->output_meta.info[i], &output[i]) != RetSuccess)
+        throw std::runtime_error ("cannot set the output blob");
     }
+
+    request->request.StartAsync ();
+    status = request->request.Wait (InferenceEngine::IInferRequest::WaitMode::RESULT_READY);
+
+    if (status == InferenceEngine::OK) {
+      for (i = 0; i < num_tensors; ++i) {
+        InferenceEngine::Blob::Ptr &blob = request->outCopy[i];
+
+        if (request->outData[i] == nullptr && blob != nullptr)
+          memcpy (output[i].data, request->outStaging[i].data (), output[i].size);
+      }
+    }
+  } catch (const std::exception &e) {
+    ml_loge ("Failed to run the infer request: %s", e.what ());
+    status = InferenceEngine::GENERAL_ERROR;
   }
-  this->_inferRequest.SetOutput (outBlobMap);
 
-  this->_inferRequest.Infer ();
+  releaseRequest (request);
+
+  if (status != InferenceEngine::OK) {
+    ml_loge ("Failed to infer, status %d", (int) status);
+    return RetEInval;
+  }
 
   return RetSuccess;
 }
@@ -594,6 +992,9 @@ ov_open (const GstTensorFilterProperties *prop, void **private_data)
   tfOv = new TensorFilterOpenvino (model_path_xml, model_path_bin);
   *private_data = tfOv;
 
+  if (tfOv->setCustomProperties (prop->custom_properties) != TensorFilterOpenvino::RetSuccess)
+    return TensorFilterOpenvino::RetEInval;
+
   return tfOv->loadModel (accelerator);
 }
 
@@ -611,6 +1012,33 @@ ov_checkAvailability (accl_hw hw)
   return -ENOENT;
 }
 
+/**
+ * @brief The optional callback for GstTensorFilterFramework
+ * @param[in] ops the event to handle (GET_MODEL_CACHE)
+ * @param[in/out] data the user data of the event
+ * @return 0 if OK, -ENOENT if not handled
+ */
+static int
+ov_handleEvent (event_ops ops, GstTensorFilterFrameworkEventData *data)
+{
+  TensorFilterOpenvino *tfOv;
+  bool hit;
+  gint64 compileTime;
+
+  if (ops != GET_MODEL_CACHE)
+    return -ENOENT;
+
+  g_return_val_if_fail (data != NULL && data->cache_instance != NULL, -EINVAL);
+
+  tfOv = static_cast<TensorFilterOpenvino *> (data->cache_instance);
+  if (!tfOv->getModelCache (&hit, &compileTime))
+    return -ENOENT;
+
+  data->cache_hit = hit ? 1 : 0;
+  data->compile_time = compileTime;
+  return 0;
+}
+
 static gchar filter_subplugin_openvino[] = "openvino";
 
 static GstTensorFilterFramework NNS_support_openvino = {.version = GST_TENSOR_FILTER_FRAMEWORK_V0,
@@ -629,7 +1057,7 @@ static GstTensorFilterFramework NNS_support_openvino = {.version = GST_TENSOR_FI
        .setInputDimension = nullptr,
        .destroyNotify = nullptr,
        .reloadModel = nullptr,
-       .handleEvent = nullptr,
+       .handleEvent = ov_handleEvent,
        .checkAvailability = ov_checkAvailability,
        .allocateInInvoke = nullptr,
    } } };
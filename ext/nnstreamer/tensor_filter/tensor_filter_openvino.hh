@@ -40,7 +40,11 @@
 #include <ext_list.hpp>
 #endif /* __OPENVINO_CPU_EXT__ */
 #include <inference_engine.hpp>
+#include <condition_variable>
 #include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -66,6 +70,18 @@ public:
   TensorFilterOpenvino (std::string path_model_xml, std::string path_model_bin);
   ~TensorFilterOpenvino ();
 
+  int setCustomProperties (const char *custom_props);
+  guint getNumRequests () {
+    return _numRequests;
+  }
+  std::string getPerformanceHint () {
+    return _perfHint;
+  }
+  std::string getCacheDir () {
+    return _cacheDir;
+  }
+  bool getModelCache (bool *hit, gint64 *compileTime);
+
   /** @todo Need to support other acceleration devices */
   int loadModel (accl_hw hw);
   bool isModelLoaded () {
@@ -89,21 +105,69 @@ protected:
   InferenceEngine::OutputsDataMap _outputsDataMap;
 
 private:
+  /**
+   * @brief Infer request with the blobs bound to it. The blobs over the memory
+   *        of tensor_filter are kept bound while the data pointers are unchanged.
+   */
+  struct InferSlot
+  {
+    InferenceEngine::InferRequest request;
+    const void *inData[NNS_TENSOR_SIZE_LIMIT]; /**< the input memory bound as the blob, nullptr if not bound */
+    void *outData[NNS_TENSOR_SIZE_LIMIT]; /**< the output memory bound as the blob, nullptr if not bound */
+    std::vector<guint8> inStaging[NNS_TENSOR_SIZE_LIMIT]; /**< the staging buffer of the unaligned input */
+    std::vector<guint8> outStaging[NNS_TENSOR_SIZE_LIMIT]; /**< the staging buffer of the unaligned output */
+    InferenceEngine::Blob::Ptr inCopy[NNS_TENSOR_SIZE_LIMIT]; /**< the blob over the input staging buffer */
+    InferenceEngine::Blob::Ptr outCopy[NNS_TENSOR_SIZE_LIMIT]; /**< the blob over the output staging buffer */
+
+    InferSlot (InferenceEngine::InferRequest req);
+  };
+
+  typedef std::shared_ptr<InferSlot> InferRequestPtr;
+
+  /**
+   * @brief Executable network shared by the instances of the same model and options,
+   *        with the pool of the infer requests run asynchronously.
+   */
+  struct SharedNetwork
+  {
+    InferenceEngine::Core core; /**< the core loading the network, released after the network */
+    InferenceEngine::ExecutableNetwork net;
+    std::mutex lock;
+    std::condition_variable cond;
+    std::vector<InferRequestPtr> idle; /**< the infer requests not in use */
+    guint numCreated; /**< the number of the created infer requests */
+    guint maxRequests; /**< the max number of the infer requests, 0 for no limit */
+    int cacheHit; /**< 1 if the network is imported from the cache directory, 0 if compiled, -1 if the cache is not used */
+    gint64 compileTime; /**< the time to load the network onto the device (usec) */
+  };
+
   TensorFilterOpenvino ();
 
+  int loadNetwork (SharedNetwork &shared, accl_hw hw);
+  bool isCacheSupported (SharedNetwork &shared, accl_hw hw);
+  static guint countCacheFiles (const std::string &dir);
+  int bindBlob (InferSlot &slot, bool isInput, guint idx,
+      const GstTensorInfo *info, const GstTensorMemory *mem);
+  InferRequestPtr acquireRequest ();
+  void releaseRequest (InferRequestPtr request);
+
   InferenceEngine::Core _ieCore;
   InferenceEngine::CNNNetReader _networkReaderCNN;
   InferenceEngine::CNNNetwork _networkCNN;
   InferenceEngine::TensorDesc _inputTensorDescs[NNS_TENSOR_SIZE_LIMIT];
   InferenceEngine::TensorDesc _outputTensorDescs[NNS_TENSOR_SIZE_LIMIT];
-  InferenceEngine::ExecutableNetwork _executableNet;
-  InferenceEngine::InferRequest _inferRequest;
+  std::shared_ptr<SharedNetwork> _sharedNet;
   static std::map<accl_hw, std::string> _nnsAcclHwToOVDevMap;
+  static std::mutex _sharedNetsLock;
+  static std::map<std::string, std::weak_ptr<SharedNetwork>> _sharedNets;
 
   std::string _pathModelXml;
   std::string _pathModelBin;
   bool _isLoaded;
   accl_hw _hw;
+  guint _numRequests; /**< custom property num_requests, 0 to create the infer requests on demand */
+  std::string _perfHint; /**< custom property performance_hint, THROUGHPUT or LATENCY */
+  std::string _cacheDir; /**< custom property cache_dir, the directory of the compiled networks (empty to disable) */
 };
 
 #endif /* __TENSOR_FILTER_OPENVINO_H__ */
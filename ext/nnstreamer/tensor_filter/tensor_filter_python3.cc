@@ -39,6 +39,18 @@
  *    model="${PATH_TO_SCRIPT}" ! tensor_sink
  * ]|
  * </refsect2>
+ *
+ * With Python 3.12 or later, set subinterpreter of the [python3] group in
+ * nnstreamer.ini to run each instance in its own sub-interpreter with its own
+ * GIL (PEP 684). The instances do not block each other then. If the script or
+ * a module does not support the per-interpreter GIL (e.g., numpy without the
+ * multi-phase initialization), the instance runs in the main interpreter.
+ *
+ * The numpy arrays given to the script are rebound to the tensors of each
+ * frame, so the script should not keep them after invoke. If the script
+ * defines invokeInto (self, input_array, output_array), nnstreamer allocates
+ * the output tensors and the script writes the results into output_array
+ * instead of returning new arrays from invoke.
  */
 
 #if defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 6))
@@ -51,8 +63,13 @@
 #include <nnstreamer_conf.h>
 #include <nnstreamer_util.h>
 #include <map>
+#include <mutex>
 #include "nnstreamer_python3_helper.h"
 
+#if PY_VERSION_HEX >= 0x030C0000
+#define PY_OWN_GIL_SUPPORT 1
+#endif
+
 /**
  * @brief Macro for debug mode.
  */
@@ -70,8 +87,16 @@ typedef enum _cb_type {
   CB_END,
 } cb_type;
 
-#define Py_LOCK() PyGILState_Ensure()
-#define Py_UNLOCK(gstate) PyGILState_Release(gstate)
+#define Py_LOCK() lock ()
+#define Py_UNLOCK(gstate) unlock (gstate)
+
+/**
+ * @brief	Lock state of the interpreter of PYCore
+ */
+typedef struct {
+  PyGILState_STATE gstate; /**< the state of the main interpreter */
+  PyThreadState *prev; /**< the thread state swapped out by the sub-interpreter */
+} py_lock_state;
 
 /**
  * @brief	Python embedding core structure
@@ -95,6 +120,12 @@ class PYCore
 
   void freeOutputTensors (void *data);
 
+  /** @brief Return true if the script writes the outputs into the given arrays */
+  bool isInvokeInto ()
+  {
+    return invoke_into;
+  }
+
   /** @brief Return callback type */
   cb_type getCbType ()
   {
@@ -104,6 +135,9 @@ class PYCore
   int checkTensorType (int nns_type, int np_type);
   int checkTensorSize (GstTensorMemory *output, PyArrayObject *array);
 
+  py_lock_state lock ();
+  void unlock (py_lock_state state);
+
   private:
   const std::string script_path; /**< from model_path property */
   const std::string module_args; /**< from custom property */
@@ -115,12 +149,22 @@ class PYCore
 
   PyObject *core_obj;
   PyObject *shape_cls;
+  PyTensorViews input_views; /**< the persistent arrays of the input tensors */
+  PyTensorViews output_views; /**< the persistent arrays of the output tensors for invokeInto */
+  bool invoke_into; /**< True if the script defines invokeInto */
 
   GstTensorsInfo inputTensorMeta; /**< The tensor info of input tensors */
   GstTensorsInfo outputTensorMeta; /**< The tensor info of output tensors */
 
   bool configured; /**< True if the script is successfully loaded */
   void *handle; /**< returned handle by dlopen() */
+
+  PyThreadState *sub_tstate; /**< the thread state creating the sub-interpreter, NULL with the main interpreter */
+  std::mutex tstate_lock;
+  std::map<GThread *, std::pair<PyThreadState *, guint>> tstates; /**< the thread state of the sub-interpreter and the lock depth for each thread */
+
+  bool newSubInterpreter ();
+  void endSubInterpreter ();
 };
 
 #ifdef __cplusplus
@@ -144,6 +188,12 @@ PYCore::PYCore (const char *_script_path, const char *_custom)
   if (openPythonLib (&handle))
     throw std::runtime_error (dlerror ());
 
+  sub_tstate = NULL;
+  if (nnsconf_get_custom_value_bool ("python3", "subinterpreter", FALSE)
+      && !newSubInterpreter ())
+    ml_logw ("Cannot create the sub-interpreter, the script runs in the main interpreter.");
+
+  py_lock_state state = Py_LOCK ();
   _import_array (); /** for numpy */
 
   /**
@@ -161,6 +211,7 @@ PYCore::PYCore (const char *_script_path, const char *_custom)
     module_name.erase (ext_idx);
 
   addToSysPath (script_path.substr (0, last_idx).c_str ());
+  Py_UNLOCK (state);
 
   gst_tensors_info_init (&inputTensorMeta);
   gst_tensors_info_init (&outputTensorMeta);
@@ -169,7 +220,150 @@ PYCore::PYCore (const char *_script_path, const char *_custom)
   core_obj = NULL;
   configured = false;
   shape_cls = NULL;
+  invoke_into = false;
+  PyTensorViews_Init (&input_views);
+  PyTensorViews_Init (&output_views);
+}
+
+/**
+ * @brief	Create the sub-interpreter with its own GIL
+ * @note	The caller should hold the GIL of the main interpreter.
+ * @return true if the sub-interpreter is created and numpy is available in it
+ */
+bool
+PYCore::newSubInterpreter ()
+{
+#ifdef PY_OWN_GIL_SUPPORT
+  PyThreadState *main_tstate = PyThreadState_Get ();
+  PyInterpreterConfig config;
+  PyStatus status;
+
+  config.use_main_obmalloc = 0;
+  config.allow_fork = 0;
+  config.allow_exec = 0;
+  config.allow_threads = 1;
+  config.allow_daemon_threads = 0;
+  config.check_multi_interp_extensions = 1;
+  config.gil = PyInterpreterConfig_OWN_GIL;
+
+  /* The new thread state is current and the GIL of the main is released */
+  status = Py_NewInterpreterFromConfig (&sub_tstate, &config);
+  if (PyStatus_Exception (status)) {
+    /* The thread state of the main is restored on failure */
+    ml_loge ("Failed to create the sub-interpreter: %s",
+        status.err_msg ? status.err_msg : "unknown error");
+    sub_tstate = NULL;
+    return false;
+  }
+
+  tstates[g_thread_self ()] = std::make_pair (sub_tstate, 0U);
+
+  /* The extension modules decline to load if they do not support the own GIL */
+  if (_import_array () < 0) {
+    Py_ERRMSG ("numpy does not support the per-interpreter GIL");
+    endSubInterpreter ();
+    PyThreadState_Swap (main_tstate);
+    return false;
+  }
+
+  PyThreadState_Swap (main_tstate);
+  return true;
+#else
+  ml_logw ("The sub-interpreter with its own GIL requires Python 3.12 or later.");
+  return false;
+#endif
+}
+
+/**
+ * @brief	Destroy the sub-interpreter and its thread states
+ * @note	The thread state creating the sub-interpreter should be current.
+ */
+void
+PYCore::endSubInterpreter ()
+{
+#ifdef PY_OWN_GIL_SUPPORT
+  std::map<GThread *, std::pair<PyThreadState *, guint>>::iterator it;
+
+  for (it = tstates.begin (); it != tstates.end (); ++it) {
+    if (it->second.first != sub_tstate) {
+      PyThreadState_Clear (it->second.first);
+      PyThreadState_Delete (it->second.first);
+    }
+  }
+  tstates.clear ();
+
+  Py_EndInterpreter (sub_tstate);
+  sub_tstate = NULL;
+#endif
+}
+
+/**
+ * @brief	Lock the interpreter of the instance for the calling thread
+ * @return the state to unlock the interpreter
+ */
+py_lock_state
+PYCore::lock ()
+{
+  py_lock_state state;
+
+  state.prev = NULL;
+
+#ifdef PY_OWN_GIL_SUPPORT
+  if (sub_tstate) {
+    PyThreadState *tstate;
+    GThread *self = g_thread_self ();
+
+    state.gstate = PyGILState_UNLOCKED;
+
+    {
+      std::lock_guard<std::mutex> guard (tstate_lock);
+      std::map<GThread *, std::pair<PyThreadState *, guint>>::iterator it;
+
+      it = tstates.find (self);
+      if (it == tstates.end ())
+        it = tstates.insert (std::make_pair (self,
+            std::make_pair (PyThreadState_New (sub_tstate->interp), 0U))).first;
+
+      tstate = it->second.first;
+      /* Already locked by this thread */
+      if (it->second.second++ > 0) {
+        state.prev = tstate;
+        return state;
+      }
+    }
+
+    /* Swapping releases the GIL of the previous and takes the own GIL */
+    state.prev = PyThreadState_Swap (tstate);
+    return state;
+  }
+#endif
 
+  state.gstate = PyGILState_Ensure ();
+  return state;
+}
+
+/**
+ * @brief	Unlock the interpreter of the instance
+ * @param state the state returned by lock ()
+ */
+void
+PYCore::unlock (py_lock_state state)
+{
+#ifdef PY_OWN_GIL_SUPPORT
+  if (sub_tstate) {
+    std::unique_lock<std::mutex> guard (tstate_lock);
+    std::pair<PyThreadState *, guint> &entry = tstates[g_thread_self ()];
+
+    if (--entry.second > 0)
+      return;
+
+    guard.unlock ();
+    PyThreadState_Swap (state.prev);
+    return;
+  }
+#endif
+
+  PyGILState_Release (state.gstate);
 }
 
 /**
@@ -181,12 +375,23 @@ PYCore::~PYCore ()
   gst_tensors_info_free (&inputTensorMeta);
   gst_tensors_info_free (&outputTensorMeta);
 
-  PyGILState_STATE gstate = Py_LOCK ();
+  py_lock_state gstate = Py_LOCK ();
   Py_SAFEDECREF (core_obj);
   Py_SAFEDECREF (shape_cls);
+  PyTensorViews_Clear (&input_views);
+  PyTensorViews_Clear (&output_views);
 
   PyErr_Clear ();
-  Py_UNLOCK (gstate);
+
+  if (sub_tstate) {
+    if (PyThreadState_Get () != sub_tstate)
+      PyThreadState_Swap (sub_tstate);
+    endSubInterpreter ();
+    /* No thread state is current after ending the sub-interpreter */
+    PyThreadState_Swap (gstate.prev);
+  } else {
+    Py_UNLOCK (gstate);
+  }
 
   dlclose (handle);
 }
@@ -198,7 +403,7 @@ PYCore::~PYCore ()
 int
 PYCore::init (const GstTensorFilterProperties *prop)
 {
-  PyGILState_STATE gstate = Py_LOCK ();
+  py_lock_state gstate = Py_LOCK ();
   int ret = -EINVAL;
   /** Find nnstreamer_api module */
   PyObject *api_module = PyImport_ImportModule ("nnstreamer_python");
@@ -250,7 +455,7 @@ PYCore::loadScript ()
 #endif
 
   int ret = -EINVAL;
-  PyGILState_STATE gstate = Py_LOCK ();
+  py_lock_state gstate = Py_LOCK ();
 
   PyObject *module = PyImport_ImportModule (module_name.c_str ());
   if (module) {
@@ -292,6 +497,8 @@ PYCore::loadScript ()
           callback_type = CB_GETDIM;
         else
           callback_type = CB_END;
+
+        invoke_into = PyObject_HasAttrString (core_obj, (char *)"invokeInto");
       } else {
         Py_ERRMSG ("Fail to create an instance 'CustomFilter'\n");
         ret = -3;
@@ -372,7 +579,7 @@ PYCore::checkTensorSize (GstTensorMemory *output, PyArrayObject *array)
   if (nullptr == output || nullptr == array)
     throw std::invalid_argument ("Null pointers are given to PYCore::checkTensorSize().\n");
 
-  PyGILState_STATE gstate = Py_LOCK ();
+  py_lock_state gstate = Py_LOCK ();
   size_t total_size = PyArray_ITEMSIZE (array);
 
   for (int i = 0; i < PyArray_NDIM (array); i++)
@@ -397,7 +604,7 @@ PYCore::getInputTensorDim (GstTensorsInfo *info)
   if (nullptr == info)
     throw std::invalid_argument ("A null pointer is given to PYCore::getInputTensorDim().\n");
 
-  PyGILState_STATE gstate = Py_LOCK ();
+  py_lock_state gstate = Py_LOCK ();
 
   PyObject *result = PyObject_CallMethod (core_obj, (char *)"getInputDim", NULL);
   if (result) {
@@ -427,7 +634,7 @@ PYCore::getOutputTensorDim (GstTensorsInfo *info)
   if (nullptr == info)
     throw std::invalid_argument ("A null pointer is given to PYCore::getOutputTensorDim().\n");
 
-  PyGILState_STATE gstate = Py_LOCK ();
+  py_lock_state gstate = Py_LOCK ();
 
   PyObject *result = PyObject_CallMethod (core_obj, (char *)"getOutputDim", NULL);
   if (result) {
@@ -458,7 +665,7 @@ PYCore::setInputTensorDim (const GstTensorsInfo *in_info, GstTensorsInfo *out_in
   if (nullptr == in_info || nullptr == out_info)
     throw std::invalid_argument ("Null pointers are given to PYCore::setInputTensorDim().\n");
 
-  PyGILState_STATE gstate = Py_LOCK ();
+  py_lock_state gstate = Py_LOCK ();
 
   /** to Python list object */
   PyObject *param = PyList_New (in_info->num_tensors);
@@ -502,7 +709,7 @@ void
 PYCore::freeOutputTensors (void *data)
 {
   std::map<void *, PyArrayObject *>::iterator it;
-  PyGILState_STATE gstate = Py_LOCK ();
+  py_lock_state gstate = Py_LOCK ();
 
   it = outputArrayMap.find (data);
   if (it != outputArrayMap.end ()) {
@@ -536,19 +743,49 @@ PYCore::run (const GstTensorMemory *input, GstTensorMemory *output)
   if (nullptr == output || nullptr == input)
     throw std::invalid_argument ("Null pointers are given to PYCore::run().\n");
 
-  PyGILState_STATE gstate = Py_LOCK ();
+  py_lock_state gstate = Py_LOCK ();
+
+  PyObject *param = PyTensorViews_Prepare (&input_views, inputTensorMeta.num_tensors);
+  if (nullptr == param) {
+    res = -1;
+    goto exit;
+  }
 
-  PyObject *param = PyList_New (inputTensorMeta.num_tensors);
   for (unsigned int i = 0; i < inputTensorMeta.num_tensors; i++) {
-    /** create a Numpy array wrapper (1-D) for NNS tensor data */
-    tensor_type nns_type = inputTensorMeta.info[i].type;
-    npy_intp input_dims[]
-        = { (npy_intp) (input[i].size / gst_tensor_get_element_size (nns_type)) };
-    PyObject *input_array = PyArray_SimpleNewFromData (
-        1, input_dims, getNumpyType (nns_type), input[i].data);
-    PyList_SetItem (param, i, input_array);
+    /** rebind the Numpy array wrapper (1-D) to NNS tensor data */
+    if (PyTensorViews_Set (&input_views, i, inputTensorMeta.info[i].type,
+            input[i].data, input[i].size) != 0) {
+      res = -1;
+      goto exit;
+    }
   }
 
+  if (invoke_into) {
+    /** the outputs are allocated by nnstreamer and written by the script */
+    PyObject *out_param = PyTensorViews_Prepare (&output_views, outputTensorMeta.num_tensors);
+    if (nullptr == out_param) {
+      res = -1;
+      goto exit;
+    }
+
+    for (unsigned int i = 0; i < outputTensorMeta.num_tensors; i++) {
+      if (PyTensorViews_Set (&output_views, i, outputTensorMeta.info[i].type,
+              output[i].data, output[i].size) != 0) {
+        res = -1;
+        goto exit;
+      }
+    }
+
+    result = PyObject_CallMethod (
+        core_obj, (char *)"invokeInto", (char *)"(OO)", param, out_param);
+    if (result) {
+      Py_SAFEDECREF (result);
+    } else {
+      Py_ERRMSG ("Fail to call 'invokeInto'");
+      res = -1;
+    }
+    goto exit;
+  }
 
   result
       = PyObject_CallMethod (core_obj, (char *)"invoke", (char *)"(O)", param);
@@ -558,7 +795,7 @@ PYCore::run (const GstTensorMemory *input, GstTensorMemory *output)
       res = -EINVAL;
       ml_logf ("The Python allocated size mismatched. Cannot proceed.\n");
       Py_SAFEDECREF (result);
-      goto exit_decref;
+      goto exit;
     }
 
     for (unsigned int i = 0; i < outputTensorMeta.num_tensors; i++) {
@@ -584,8 +821,7 @@ PYCore::run (const GstTensorMemory *input, GstTensorMemory *output)
     res = -1;
   }
 
-exit_decref:
-  Py_SAFEDECREF (param);
+exit:
   Py_UNLOCK (gstate);
 
 #if (DBG)
@@ -632,6 +868,22 @@ py_destroyNotify (void **private_data, void *data)
   }
 }
 
+/**
+ * @brief The optional callback for GstTensorFilterFramework
+ * @param private_data : python plugin's private data
+ * @return 0 if the script allocates the output tensors, -ENOENT if the script writes into the given outputs.
+ */
+static int
+py_allocateInInvoke (void **private_data)
+{
+  PYCore *core = static_cast<PYCore *> (*private_data);
+
+  if (core && core->isInvokeInto ())
+    return -ENOENT;
+
+  return 0;
+}
+
 /**
  * @brief The optional callback for GstTensorFilterFramework
  * @param[in] prop read-only property values
@@ -822,7 +1074,7 @@ static GstTensorFilterFramework NNS_support_python = {.version = GST_TENSOR_FILT
        .reloadModel = nullptr,
        .handleEvent = nullptr,
        .checkAvailability = py_checkAvailability,
-       .allocateInInvoke = nullptr,
+       .allocateInInvoke = py_allocateInInvoke,
    } } };
 
 static PyThreadState *st;
@@ -24,6 +24,12 @@
  *
  * This is the per-NN-framework plugin (pytorch) for tensor_filter.
  *
+ * With GPU, the tensors are copied through the pinned host tensors kept in the
+ * instance, and the copies and the model run asynchronously on a dedicated
+ * CUDA stream until the outputs are brought back to the host.
+ * The custom properties are as follows (e.g., custom=optimize_for_inference:true).
+ *  - freeze: freeze the model at load time (default false).
+ *  - optimize_for_inference: freeze and optimize the model for inference at load time (default false).
  */
 
 #include <nnstreamer_log.h>
@@ -36,6 +42,10 @@
 #include <nnstreamer_util.h>
 
 #include <torch/script.h>
+#ifdef PYTORCH_CUDA_SUPPORT
+#include <c10/cuda/CUDAGuard.h>
+#include <c10/cuda/CUDAStream.h>
+#endif
 /**
   * Array.h and reverse_iterator.h of PyTorch is GPL-3.0 w/ GCC runtime
   * exception. Make sure that this is being compiled by GCC
@@ -81,10 +91,22 @@ class TorchCore
   GstTensorsInfo outputTensorMeta; /**< The tensor info of output tensors */
   unsigned int configured;
   bool first_run; /**< must be reset after setting input info */
+  bool freeze; /**< custom property freeze */
+  bool optimize; /**< custom property optimize_for_inference */
 
   std::shared_ptr<torch::jit::script::Module> model;
+#ifdef PYTORCH_CUDA_SUPPORT
+  std::unique_ptr<c10::cuda::CUDAStream> stream; /**< the stream to run the model with GPU */
+  at::Tensor inputPinned[NNS_TENSOR_SIZE_LIMIT]; /**< the pinned host tensors of the inputs */
+  at::Tensor inputDevice[NNS_TENSOR_SIZE_LIMIT]; /**< the device tensors of the inputs */
+  at::Tensor outputPinned[NNS_TENSOR_SIZE_LIMIT]; /**< the pinned host tensors of the outputs */
+#endif
 
   void setAccelerator (const char *accelerators);
+  void setCustomProperties (const char *custom_props);
+  int optimizeModel ();
+  at::Tensor copyToDevice (const at::Tensor &host, unsigned int idx);
+  at::Tensor copyToHost (const at::Tensor &device, unsigned int idx);
   tensor_type getTensorTypeFromTorch (torch::Dtype torchType);
   bool getTensorTypeToTorch (tensor_type tensorType, torch::Dtype *torchType);
   int validateOutputTensor (at::Tensor output, unsigned int idx);
@@ -113,6 +135,8 @@ TorchCore::TorchCore (const char *_model_path)
   configured = 0;
   use_gpu = false;
   first_run = true;
+  freeze = false;
+  optimize = false;
   accelerator = ACCL_NONE;
 
   gst_tensors_info_init (&inputTensorMeta);
@@ -154,6 +178,42 @@ use_gpu_ini:
   }
 }
 
+/**
+ * @brief	Parse the custom properties for the pytorch
+ */
+void
+TorchCore::setCustomProperties (const char *custom_props)
+{
+  gchar **strv;
+  guint i, len;
+
+  if (!custom_props)
+    return;
+
+  strv = g_strsplit (custom_props, ",", -1);
+  len = g_strv_length (strv);
+
+  for (i = 0; i < len; ++i) {
+    gchar **pair = g_strsplit (strv[i], ":", -1);
+
+    if (g_strv_length (pair) > 1) {
+      g_strstrip (pair[0]);
+      g_strstrip (pair[1]);
+
+      if (g_ascii_strcasecmp (pair[0], "freeze") == 0)
+        freeze = (g_ascii_strcasecmp (pair[1], "true") == 0);
+      else if (g_ascii_strcasecmp (pair[0], "optimize_for_inference") == 0)
+        optimize = (g_ascii_strcasecmp (pair[1], "true") == 0);
+      else
+        ml_logw ("Unknown custom property %s for pytorch.", pair[0]);
+    }
+
+    g_strfreev (pair);
+  }
+
+  g_strfreev (strv);
+}
+
 /**
  * @brief	initialize the object with torch model
  * @return 0 if OK. non-zero if error.
@@ -164,6 +224,7 @@ TorchCore::init (const GstTensorFilterProperties *prop)
 {
   setAccelerator (prop->accl_str);
   g_message ("gpu = %d, accl = %s", use_gpu, get_accl_hw_str (accelerator));
+  setCustomProperties (prop->custom_properties);
 
   gst_tensors_info_copy (&inputTensorMeta, &prop->input_meta);
   gst_tensors_info_copy (&outputTensorMeta, &prop->output_meta);
@@ -229,6 +290,20 @@ TorchCore::loadModel ()
   /** set the model to evaluation mode */
   model->eval ();
 
+  if ((freeze || optimize) && optimizeModel ())
+    return -1;
+
+#ifdef PYTORCH_CUDA_SUPPORT
+  if (use_gpu) {
+    try {
+      stream.reset (new c10::cuda::CUDAStream (c10::cuda::getStreamFromPool ()));
+    } catch (const std::exception &ex) {
+      ml_loge ("Failed to get the CUDA stream: %s", ex.what ());
+      return -1;
+    }
+  }
+#endif
+
 #if (DBG)
   gint64 stop_time = g_get_real_time ();
   g_message ("Model is loaded: %" G_GINT64_FORMAT, (stop_time - start_time));
@@ -236,6 +311,90 @@ TorchCore::loadModel ()
   return 0;
 }
 
+/**
+ * @brief	freeze and optimize the loaded model for inference
+ * @return 0 if OK. non-zero if error.
+ */
+int
+TorchCore::optimizeModel ()
+{
+#ifdef PYTORCH_VER_ATLEAST_1_9_0
+  try {
+    torch::jit::script::Module frozen = torch::jit::freeze (*model);
+
+    if (optimize)
+      frozen = torch::jit::optimize_for_inference (frozen);
+
+    model = std::make_shared<torch::jit::script::Module> (frozen);
+  } catch (const std::exception &ex) {
+    ml_loge ("Exception while optimizing the model: %s", ex.what ());
+    return -1;
+  }
+#else
+  ml_logw ("Freezing the model requires PyTorch 1.9.0 or later, the model is not optimized.");
+#endif
+  return 0;
+}
+
+/**
+ * @brief	copy the input tensor to the device
+ * @param[in] host the input tensor over the host memory
+ * @param[in] idx index of input
+ * @return the tensor on the device
+ * @note	the copy is asynchronous on the stream of the instance
+ */
+at::Tensor
+TorchCore::copyToDevice (const at::Tensor &host, unsigned int idx)
+{
+#ifdef PYTORCH_CUDA_SUPPORT
+  at::Tensor &pinned = inputPinned[idx];
+  at::Tensor &device = inputDevice[idx];
+
+  if (!pinned.defined () || !pinned.sizes ().equals (host.sizes ())
+      || pinned.scalar_type () != host.scalar_type ()) {
+    pinned = at::empty (host.sizes (), host.options ().pinned_memory (true));
+    device = at::empty (host.sizes (), host.options ().device (at::kCUDA));
+  }
+
+  /* the previous copy from the pinned tensor is done at the end of the last invoke */
+  std::memcpy (pinned.data_ptr (), host.data_ptr (), host.nbytes ());
+  device.copy_ (pinned, true);
+  return device;
+#else
+  UNUSED (idx);
+  return host.to (at::kCUDA);
+#endif
+}
+
+/**
+ * @brief	copy the output tensor to the host
+ * @param[in] device the output tensor on the device
+ * @param[in] idx index of output
+ * @return the contiguous tensor on the host
+ */
+at::Tensor
+TorchCore::copyToHost (const at::Tensor &device, unsigned int idx)
+{
+#ifdef PYTORCH_CUDA_SUPPORT
+  if (idx < NNS_TENSOR_SIZE_LIMIT && device.is_cuda ()) {
+    at::Tensor &pinned = outputPinned[idx];
+
+    if (!pinned.defined () || !pinned.sizes ().equals (device.sizes ())
+        || pinned.scalar_type () != device.scalar_type ()) {
+      pinned = at::empty (device.sizes (),
+          device.options ().device (at::kCPU).pinned_memory (true));
+    }
+
+    pinned.copy_ (device, true);
+    stream->synchronize ();
+    return pinned;
+  }
+#else
+  UNUSED (idx);
+#endif
+  return device.to (at::kCPU);
+}
+
 /**
  * @brief	return the data type of the tensor
  * @param torchType	: the defined type of PyTorch
@@ -420,7 +579,7 @@ TorchCore::processIValue (
 
   /** bring from gpu to cpu */
   if (use_gpu) {
-    output_tensor = output_tensor.to (at::kCPU);
+    output_tensor = copyToHost (output_tensor, idx);
   }
   /** make the memory contiguous for direct access */
   output_tensor = output_tensor.contiguous ();
@@ -512,6 +671,13 @@ TorchCore::invoke (const GstTensorFilterProperties *prop, const GstTensorMemory
   torch::jit::IValue output_value;
   torch::Dtype type;
   at::Tensor tensor;
+#ifdef PYTORCH_CUDA_SUPPORT
+  c10::optional<c10::cuda::CUDAStreamGuard> guard;
+
+  /** the copies and the model run on the stream of this instance */
+  if (use_gpu)
+    guard.emplace (*stream);
+#endif
 
   /** @todo Support other input types other than at::Tensor */
   for (uint i = 0; i < inputTensorMeta.num_tensors; ++i) {
@@ -529,7 +695,7 @@ TorchCore::invoke (const GstTensorFilterProperties *prop, const GstTensorMemory
     tensor = torch::from_blob (input[i].data, input_shape, options);
 
     if (use_gpu) {
-      tensor = tensor.to (at::kCUDA);
+      tensor = copyToDevice (tensor, i);
     }
 
     input_feeds.emplace_back (tensor);
@@ -765,6 +931,10 @@ void
 init_filter_torch (void)
 {
   nnstreamer_filter_probe (&NNS_support_pytorch);
+  nnstreamer_filter_set_custom_property_desc (filter_subplugin_pytorch,
+      "freeze", "Freeze the model at load time (true/false)",
+      "optimize_for_inference", "Freeze and optimize the model for inference at load time (true/false)",
+      NULL);
 }
 
 /** @brief Destruct the subplugin */
@@ -18,6 +18,9 @@
  *  - ComputingUnit: the computing unit to execute the model (default CPU)
  *  - CpuThreadCount: the number of CPU threads to be executed (optional, default 4 if ComputingUnit is CPU)
  *  - GpuCacheSource: the absolute path to GPU Kernel caching (mandatory if ComputingUnit is GPU)
+ *
+ * Each instance of the sub-plugin opens its own SNAP session. To overlap the consecutive frames,
+ * set the property num-workers of tensor_filter, then the frames are executed concurrently with the sessions.
  */
 
 #if !defined(__ANDROID__)
@@ -108,6 +111,8 @@ class tensor_filter_snap final : public tensor_filter_subplugin
   snap_sdk::SnapSessionInterface *session_;
   std::vector<snap_data_info_s> in_info_;
   std::vector<snap_data_info_s> out_info_;
+  std::vector<snap_sdk::SnapData> inputs_; /**< input data bound to the buffers, reused across frames */
+  std::vector<snap_sdk::SnapData> outputs_; /**< output data of the session, reused across frames */
   GstTensorsInfo input_meta_;
   GstTensorsInfo output_meta_;
 };
@@ -423,6 +428,8 @@ tensor_filter_snap::close ()
 
   in_info_.clear ();
   out_info_.clear ();
+  inputs_.clear ();
+  outputs_.clear ();
 }
 
 /**
@@ -467,8 +474,8 @@ tensor_filter_snap::invoke_internal (const GstTensorFilterProperties *prop,
     const GstTensorMemory *input, GstTensorMemory *output, bool configure)
 {
   snap_sdk::ErrCode status;
-  std::vector<snap_sdk::SnapData> inputs;
-  std::vector<snap_sdk::SnapData> outputs;
+  std::vector<snap_sdk::SnapData> &inputs = inputs_;
+  std::vector<snap_sdk::SnapData> &outputs = outputs_;
   guint i;
 
   if (session_ == nullptr) {
@@ -476,16 +483,15 @@ tensor_filter_snap::invoke_internal (const GstTensorFilterProperties *prop,
     return false;
   }
 
-  /* input data */
+  /* input data, SNAP reads the buffers of nnstreamer without the copy */
+  inputs.resize (in_info_.size ());
   for (i = 0; i < in_info_.size (); ++i) {
-    snap_sdk::SnapData input_data;
-
-    input_data.SetData (
+    inputs[i].SetData (
         input[i].data, in_info_[i].shape, in_info_[i].type, in_info_[i].format);
-    inputs.push_back (input_data);
   }
 
   /* invoke */
+  outputs.clear ();
   status = session_->Execute (inputs, &outputs);
   if (status != snap_sdk::ErrCode::OK) {
     snap_loge ("Failed to execute (%s).", error_string (status));
@@ -516,7 +522,7 @@ tensor_filter_snap::invoke_internal (const GstTensorFilterProperties *prop,
   /* fill output data */
   if (output != nullptr) {
     for (i = 0; i < outputs.size (); ++i) {
-      /** @todo is it possible to remove memcpy? */
+      /* the output buffer belongs to the session and is overwritten by the next execution */
       memcpy (output[i].data, outputs[i].GetBuffer (), output[i].size);
     }
   }
@@ -14,8 +14,11 @@
  *
  * This is the per-NN-framework plugin (SNPE) for tensor_filter.
  *
- * @todo This supports only ITensor for input. Do support IUserBuffer.
- * @todo This supports float32 input output only. Do support Tf8 using IUserBuffer.
+ * With the custom option UserBuffer:true, nnstreamer memory is bound to the
+ * user buffers directly. The user buffers support float32, uint8 (the values
+ * without quantization) and tf8 (the quantized values with the encoding of the
+ * model, so the DSP/HTP runtime does not convert them).
+ *
  * @todo This supports only CPU runtime on linux-x86_64. Do support others.
  */
 
@@ -95,12 +98,16 @@ class snpe_subplugin final : public tensor_filter_subplugin
   bool configure_option (const GstTensorFilterProperties *prop);
   bool parse_custom_prop (const char *custom_prop);
   bool set_output_tensor_names (const GstTensorsInfo *info);
-  void configureUserBuffer (zdl::DlSystem::UserBufferMap &buffer_map, const zdl::DlSystem::StringList strList);
+  void configureUserBuffer (zdl::DlSystem::UserBufferMap &buffer_map,
+      std::vector<std::unique_ptr<zdl::DlSystem::IUserBuffer>> &buffers,
+      const zdl::DlSystem::StringList strList, tensor_type data_type, bool quantized);
   void setTensorProp (GstTensorsInfo &tensor_meta, const zdl::DlSystem::StringList strList, tensor_type data_type);
   static const char *runtimeToString (zdl::DlSystem::Runtime_t runtime);
 
   tensor_type input_data_type;
   tensor_type output_data_type;
+  bool input_quantized; /**< input is the quantized (tf8) values with the encoding of the model */
+  bool output_quantized; /**< output is the quantized (tf8) values with the encoding of the model */
 
   bool use_user_buffer;
   zdl::DlSystem::UserBufferMap input_buffer_map;
@@ -133,7 +140,8 @@ snpe_subplugin::snpe_subplugin ()
       runtime_list (zdl::DlSystem::Runtime_t::CPU), use_cpu_fallback (false),
       output_tensor_names_list (), input_tensor_names_list (), max_resizable_dim (0U),
       container (nullptr), snpe (nullptr), input_data_type (_NNS_FLOAT32),
-      output_data_type (_NNS_FLOAT32), use_user_buffer (false)
+      output_data_type (_NNS_FLOAT32), input_quantized (false),
+      output_quantized (false), use_user_buffer (false)
 {
   gst_tensors_info_init (std::addressof (inputInfo));
   gst_tensors_info_init (std::addressof (outputInfo));
@@ -173,6 +181,10 @@ snpe_subplugin::cleanup ()
   input_tensors.clear ();
   input_tensor_map.clear ();
   output_tensor_map.clear ();
+  input_buffer_map.clear ();
+  output_buffer_map.clear ();
+  user_input_buffers.clear ();
+  user_output_buffers.clear ();
   output_tensor_names_list = zdl::DlSystem::StringList ();
   input_tensor_names_list = zdl::DlSystem::StringList ();
 
@@ -314,17 +326,27 @@ snpe_subplugin::parse_custom_prop (const char *custom_prop)
         g_free (_ot_str);
         g_strfreev (names);
       } else if (g_ascii_strcasecmp (option[0], "InputType") == 0) {
+        input_quantized = false;
         if (g_ascii_strcasecmp (option[1], "uint8") == 0) {
           input_data_type = _NNS_UINT8;
           nns_logi ("Set input data type as uint8");
+        } else if (g_ascii_strcasecmp (option[1], "tf8") == 0) {
+          input_data_type = _NNS_UINT8;
+          input_quantized = true;
+          nns_logi ("Set input data type as tf8 (quantized uint8)");
         } else {
           input_data_type = _NNS_FLOAT32;
           nns_logi ("Set input data type as default (float32)");
         }
       } else if (g_ascii_strcasecmp (option[0], "OutputType") == 0) {
+        output_quantized = false;
         if (g_ascii_strcasecmp (option[1], "uint8") == 0) {
           output_data_type = _NNS_UINT8;
           nns_logi ("Set output data type as uint8");
+        } else if (g_ascii_strcasecmp (option[1], "tf8") == 0) {
+          output_data_type = _NNS_UINT8;
+          output_quantized = true;
+          nns_logi ("Set output data type as tf8 (quantized uint8)");
         } else {
           output_data_type = _NNS_FLOAT32;
           nns_logi ("Set output data type as default (float32)");
@@ -445,16 +467,22 @@ snpe_subplugin::configure_instance (const GstTensorFilterProperties *prop)
 
   /** user buffer mode */
   if (use_user_buffer) {
-    if (input_data_type != _NNS_FLOAT32 || output_data_type != _NNS_FLOAT32) {
+    /* Configure input and output */
+    try {
+      configureUserBuffer (input_buffer_map, user_input_buffers,
+          input_tensor_names_list, input_data_type, input_quantized);
+      configureUserBuffer (output_buffer_map, user_output_buffers,
+          output_tensor_names_list, output_data_type, output_quantized);
+    } catch (...) {
       cleanup ();
-      throw std::invalid_argument ("user buffer mode only support float32 type");
+      throw;
     }
-
-    /* Configure input and output */
-    configureUserBuffer (input_buffer_map, input_tensor_names_list);
-    configureUserBuffer (output_buffer_map, output_tensor_names_list);
-
   } else {  /** ITENSOR mode */
+    if (input_quantized || output_quantized) {
+      cleanup ();
+      throw std::invalid_argument ("tf8 type is supported only in user buffer mode (UserBuffer:true)");
+    }
+
     for (size_t i = 0; i < input_tensor_names_list.size (); ++i) {
       const zdl::DlSystem::Optional<zdl::DlSystem::TensorShape> &inputDims_opt
           = snpe->getInputDimensions (input_tensor_names_list.at (i));
@@ -486,15 +514,21 @@ snpe_subplugin::invoke (const GstTensorMemory *input, GstTensorMemory *output)
 #endif
 
   if (use_user_buffer) {
+    /* bind nnstreamer memory to the user buffers without copying the data */
     for (unsigned int i = 0; i < inputInfo.num_tensors; ++i) {
-      input_buffer_map.getUserBuffer (inputInfo.info[i].name)->setBufferAddress (input[i].data);
+      if (user_input_buffers[i]->getSize () != input[i].size)
+        throw std::runtime_error ("The size of input tensor is different from the user buffer.");
+      user_input_buffers[i]->setBufferAddress (input[i].data);
     }
 
     for (unsigned int i = 0; i < outputInfo.num_tensors; ++i) {
-      output_buffer_map.getUserBuffer (outputInfo.info[i].name)->setBufferAddress (output[i].data);
+      if (user_output_buffers[i]->getSize () != output[i].size)
+        throw std::runtime_error ("The size of output tensor is different from the user buffer.");
+      user_output_buffers[i]->setBufferAddress (output[i].data);
     }
 
-    snpe->execute (input_buffer_map, output_buffer_map);
+    if (!snpe->execute (input_buffer_map, output_buffer_map))
+      throw std::runtime_error ("Failed to execute the model with the user buffers.");
   } else {
     /* Configure inputs */
     for (unsigned int i = 0; i < inputInfo.num_tensors; ++i) {
@@ -588,16 +622,25 @@ snpe_subplugin::eventHandler (event_ops ops, GstTensorFilterFrameworkEventData &
 
 /**
  * @brief Method to configure user_buffer_map with given strList of tensor names
+ * @param[out] buffer_map the user buffer map to be configured
+ * @param[out] buffers the user buffers in the order of the tensor names
+ * @param strList the tensor names
+ * @param data_type the data type of nnstreamer tensors (float32 or uint8)
+ * @param quantized true to use the tf8 encoding of the model for uint8 tensors, false to use the values without quantization
  */
 void
-snpe_subplugin::configureUserBuffer (zdl::DlSystem::UserBufferMap &buffer_map, const zdl::DlSystem::StringList strList)
+snpe_subplugin::configureUserBuffer (zdl::DlSystem::UserBufferMap &buffer_map,
+    std::vector<std::unique_ptr<zdl::DlSystem::IUserBuffer>> &buffers,
+    const zdl::DlSystem::StringList strList, tensor_type data_type, bool quantized)
 {
   zdl::DlSystem::IUserBufferFactory& ubFactory = zdl::SNPE::SNPEFactory::getUserBufferFactory ();
+  const size_t element_size = gst_tensor_get_element_size (data_type);
+
   for (const char *name : strList) {
     auto bufferAttributesOpt = snpe->getInputOutputBufferAttributes (name);
     const zdl::DlSystem::TensorShape& bufferShape = (*bufferAttributesOpt)->getDims ();
     std::vector<size_t> strides (bufferShape.rank ());
-    strides[strides.size () - 1] = sizeof (float);
+    strides[strides.size () - 1] = element_size;
     for (size_t i = strides.size () - 1; i > 0; --i) {
       if (bufferShape[i] == 0) {
         if (max_resizable_dim == 0) {
@@ -610,21 +653,48 @@ snpe_subplugin::configureUserBuffer (zdl::DlSystem::UserBufferMap &buffer_map, c
       strides[i - 1] = strides[i] * bufferShape[i];
     }
 
-    size_t bufSize = sizeof (float);
+    size_t bufSize = element_size;
     for (size_t i = 0; i < bufferShape.rank (); ++i) {
       bufSize *= bufferShape[i];
     }
 
     std::unique_ptr<zdl::DlSystem::UserBufferEncoding> userBufferEncoding;
-    userBufferEncoding = std::unique_ptr<zdl::DlSystem::UserBufferEncodingFloat>(new zdl::DlSystem::UserBufferEncodingFloat ());
+    if (data_type == _NNS_UINT8) {
+      /* the uint8 values without quantization, same as ITensor mode */
+      unsigned char step_exactly0 = 0;
+      float step_size = 1.0f;
+
+      if (quantized) {
+        const zdl::DlSystem::UserBufferEncodingTf8 *encoding
+            = dynamic_cast<const zdl::DlSystem::UserBufferEncodingTf8 *> (
+                (*bufferAttributesOpt)->getEncoding ());
+
+        if (encoding == nullptr) {
+          throw std::invalid_argument (
+              std::string ("tensor ") + name + std::string (" is not quantized (tf8) in the model"));
+        }
+
+        step_exactly0 = static_cast<unsigned char> (encoding->getStepExactly0 ());
+        step_size = encoding->getQuantizedStepSize ();
+        nns_logi ("Use tf8 encoding of tensor %s (step exactly 0: %u, step size: %f)",
+            name, (unsigned int) step_exactly0, step_size);
+      }
+
+      userBufferEncoding = std::unique_ptr<zdl::DlSystem::UserBufferEncodingTf8> (
+          new zdl::DlSystem::UserBufferEncodingTf8 (step_exactly0, step_size));
+    } else if (data_type == _NNS_FLOAT32) {
+      userBufferEncoding = std::unique_ptr<zdl::DlSystem::UserBufferEncodingFloat>(new zdl::DlSystem::UserBufferEncodingFloat ());
+    } else {
+      throw std::invalid_argument ("user buffer mode only supports float32 and uint8 type");
+    }
 
-    user_input_buffers.push_back (ubFactory.createUserBuffer (NULL, bufSize, strides, userBufferEncoding.get ()));
+    buffers.push_back (ubFactory.createUserBuffer (NULL, bufSize, strides, userBufferEncoding.get ()));
 
-    if (user_input_buffers.back () == nullptr) {
+    if (buffers.back () == nullptr) {
       throw std::runtime_error ("Error while creating user buffer.");
     }
 
-    buffer_map.add (name, user_input_buffers.back ().get ());
+    buffer_map.add (name, buffers.back ().get ());
   }
 }
 
@@ -674,9 +744,9 @@ snpe_subplugin::init_filter_snpe (void)
       "OutputTensor",
       "Tensor names for the output, separated by ';'. E.g., 'concat:0;concat_1:0'",
       "InputType",
-      "Set the data type of the input {'float32 (default)', 'uint8'}",
+      "Set the data type of the input {'float32 (default)', 'uint8', 'tf8' (quantized uint8, UserBuffer only)}",
       "OutputType",
-      "Set the data type of the output {'float32 (default)', 'uint8'}",
+      "Set the data type of the output {'float32 (default)', 'uint8', 'tf8' (quantized uint8, UserBuffer only)}",
       "UserBuffer",
       "Use user supplied buffers for input/output tensors {'false (default)', 'true'}",
       "MaxResizableDim",
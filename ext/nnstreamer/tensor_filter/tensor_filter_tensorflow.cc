@@ -38,6 +38,7 @@
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <vector>
 
 #include <tensorflow/c/c_api.h>
@@ -91,14 +92,19 @@ class TFCore
 
   std::vector<tf_tensor_info_s> input_tensor_info; /* hold information for TF */
   std::map<void *, TF_Tensor *> outputTensorMap;
+  std::mutex outputTensorLock; /**< output tensors are released by downstream elements */
+
+  std::vector<TF_Output> input_ops; /**< graph operations of the input tensors */
+  std::vector<TF_Output> output_ops; /**< graph operations of the output tensors */
 
   TF_Graph *graph;
   TF_Session *session;
+  TF_Status *run_status; /**< status reused in each invoke */
 
   tensor_type getTensorTypeFromTF (TF_DataType tfType);
   TF_DataType getTensorTypeToTF (tensor_type tType);
   int validateTensor (const GstTensorsInfo *tensorInfo, int is_input);
-  static void releaseBuffer (void *data, size_t t);
+  int lookupOperations (const GstTensorsInfo *tensorInfo, std::vector<TF_Output> &ops);
 };
 
 #ifdef __cplusplus
@@ -122,6 +128,7 @@ TFCore::TFCore (const char *_model_path)
   model_path = g_strdup (_model_path);
   graph = nullptr;
   session = nullptr;
+  run_status = TF_NewStatus ();
 
   gst_tensors_info_init (&inputTensorMeta);
   gst_tensors_info_init (&outputTensorMeta);
@@ -133,6 +140,12 @@ TFCore::TFCore (const char *_model_path)
  */
 TFCore::~TFCore ()
 {
+  for (auto &it : outputTensorMap)
+    TF_DeleteTensor (it.second);
+  outputTensorMap.clear ();
+
+  TF_DeleteStatus (run_status);
+
   if (graph != nullptr)
     TF_DeleteGraph (graph);
 
@@ -164,6 +177,7 @@ TFCore::~TFCore ()
  *        -1 if the model is not loaded.
  *        -2 if the initialization of input tensor is failed.
  *        -3 if the initialization of output tensor is failed.
+ *        -4 if the operations of the tensors are not found.
  */
 int
 TFCore::init (const GstTensorFilterProperties *prop)
@@ -183,6 +197,12 @@ TFCore::init (const GstTensorFilterProperties *prop)
     return -3;
   }
 
+  if (lookupOperations (&prop->input_meta, input_ops)
+      || lookupOperations (&prop->output_meta, output_ops)) {
+    ml_loge ("Failed to find the operations of the tensors");
+    return -4;
+  }
+
   gst_tensors_info_copy (&inputTensorMeta, &prop->input_meta);
   gst_tensors_info_copy (&outputTensorMeta, &prop->output_meta);
 
@@ -190,23 +210,37 @@ TFCore::init (const GstTensorFilterProperties *prop)
 }
 
 /**
- * @brief	get the model path
- * @return the model path.
+ * @brief	find the graph operations of the tensors once, instead of looking up the graph in each invoke
+ * @param	tensorInfo : the tensors' info which user inserted
+ * @param[out] ops : the operations of the tensors
+ * @return 0 if OK. non-zero if error.
  */
-const char *
-TFCore::getModelPath ()
+int
+TFCore::lookupOperations (const GstTensorsInfo *tensorInfo, std::vector<TF_Output> &ops)
 {
-  return model_path;
+  ops.clear ();
+
+  for (unsigned int i = 0; i < tensorInfo->num_tensors; i++) {
+    TF_Output op = { TF_GraphOperationByName (graph, tensorInfo->info[i].name), 0 };
+
+    if (op.oper == nullptr) {
+      ml_loge ("Cannot find the operation %s in the graph", tensorInfo->info[i].name);
+      return -1;
+    }
+    ops.push_back (op);
+  }
+
+  return 0;
 }
 
 /**
- * @brief	the definition of a deallocator method
+ * @brief	get the model path
+ * @return the model path.
  */
-void
-TFCore::releaseBuffer (void *data, size_t t)
+const char *
+TFCore::getModelPath ()
 {
-  UNUSED (t);
-  std::free (data);
+  return model_path;
 }
 
 /**
@@ -224,20 +258,21 @@ TFCore::loadModel ()
 #if (DBG)
   gint64 start_time = g_get_real_time ();
 #endif
-  gsize file_size;
-  gchar *content = nullptr;
-  GError *file_error = nullptr;
-
-  if (!g_file_get_contents (model_path, &content, &file_size, &file_error)) {
-    ml_loge ("Error reading model file!! - %s", file_error->message);
-    g_clear_error (&file_error);
+  GstTensorFilterModelMap *model_map;
+  size_t file_size;
+
+  /* the graph is parsed right away, read ahead the mapped file */
+  model_map = gst_tensor_filter_model_map_open (model_path,
+      GST_TENSOR_FILTER_MODEL_MAP_PRELOAD);
+  if (!model_map) {
+    ml_loge ("Error reading model file!! - %s", model_path);
     return -2;
   }
 
   TF_Buffer *buffer = TF_NewBuffer ();
-  buffer->data = content;
+  buffer->data = gst_tensor_filter_model_map_get_data (model_map, &file_size);
   buffer->length = file_size;
-  buffer->data_deallocator = releaseBuffer;
+  buffer->data_deallocator = nullptr;
 
   graph = TF_NewGraph ();
   g_assert (graph != nullptr);
@@ -248,6 +283,7 @@ TFCore::loadModel ()
   TF_GraphImportGraphDef (graph, buffer, opts, status);
   TF_DeleteImportGraphDefOptions (opts);
   TF_DeleteBuffer (buffer);
+  gst_tensor_filter_model_map_close (model_map);
 
   if (TF_GetCode (status) != TF_OK) {
     ml_loge ("Error deleting graph!! - [Code: %d] %s", TF_GetCode (status),
@@ -500,20 +536,20 @@ TFCore::run (const GstTensorMemory *input, GstTensorMemory *output)
 #if (DBG)
   gint64 start_time = g_get_real_time ();
 #endif
-  std::vector<TF_Output> input_ops;
-  std::vector<TF_Tensor *> input_tensors;
-  std::vector<TF_Output> output_ops;
-  std::vector<TF_Tensor *> output_tensors;
-  TF_Status *status = TF_NewStatus ();
+  TF_Tensor *input_tensors[NNS_TENSOR_SIZE_LIMIT] = { nullptr };
+  TF_Tensor *output_tensors[NNS_TENSOR_SIZE_LIMIT] = { nullptr };
+  TF_Status *status = run_status;
+  unsigned int num_inputs = 0;
   int ret = 0;
 
-  /* create input tensor for the graph from `input` */
+  TF_SetStatus (status, TF_OK, "");
+
+  /**
+   * Create input tensor for the graph from `input`.
+   * The tensors wrap the input memory and the deallocator does not free it.
+   */
   for (unsigned int i = 0; i < inputTensorMeta.num_tensors; i++) {
     TF_Tensor *in_tensor = nullptr;
-    TF_Output input_op
-        = { TF_GraphOperationByName (graph, inputTensorMeta.info[i].name), 0 };
-    g_assert (input_op.oper != nullptr);
-    input_ops.push_back (input_op);
 
     if (input_tensor_info[i].type == TF_STRING) {
 #if (TF_VERSION_MAJOR < 2) || (TF_VERSION_MAJOR == 2 && TF_VERSION_MINOR <= 3)
@@ -548,22 +584,11 @@ TFCore::run (const GstTensorMemory *input, GstTensorMemory *output)
           input_tensor_info[i].dims.data (), input_tensor_info[i].rank, input[i].data,
           input[i].size, DeallocateInputTensor, &input_tensor_info[i]);
     }
-    input_tensors.push_back (in_tensor);
-  }
-
-  /* create output tensor for the graph from `output` */
-  for (unsigned int i = 0; i < outputTensorMeta.num_tensors; i++) {
-    TF_Output output_op
-        = { TF_GraphOperationByName (graph, outputTensorMeta.info[i].name), 0 };
-    g_assert (output_op.oper != nullptr);
-    output_ops.push_back (output_op);
-
-    TF_Tensor *out_tensor = nullptr;
-    output_tensors.push_back (out_tensor);
+    input_tensors[num_inputs++] = in_tensor;
   }
 
-  TF_SessionRun (session, nullptr, input_ops.data (), input_tensors.data (),
-      inputTensorMeta.num_tensors, output_ops.data (), output_tensors.data (),
+  TF_SessionRun (session, nullptr, input_ops.data (), input_tensors,
+      inputTensorMeta.num_tensors, output_ops.data (), output_tensors,
       outputTensorMeta.num_tensors, nullptr, 0, nullptr, status);
 
   if (TF_GetCode (status) != TF_OK) {
@@ -573,18 +598,21 @@ TFCore::run (const GstTensorMemory *input, GstTensorMemory *output)
     goto failed;
   }
 
-  for (unsigned int i = 0; i < outputTensorMeta.num_tensors; i++) {
-    output[i].data = TF_TensorData (output_tensors[i]);
-    outputTensorMap.insert (std::make_pair (output[i].data, output_tensors[i]));
+  /* the output tensors are passed without copying and released in destroyNotify */
+  {
+    std::lock_guard<std::mutex> lock (outputTensorLock);
+
+    for (unsigned int i = 0; i < outputTensorMeta.num_tensors; i++) {
+      output[i].data = TF_TensorData (output_tensors[i]);
+      outputTensorMap.insert (std::make_pair (output[i].data, output_tensors[i]));
+    }
   }
 
 failed:
-  for (unsigned int i = 0; i < input_tensors.size (); i++) {
+  for (unsigned int i = 0; i < num_inputs; i++) {
     TF_DeleteTensor (input_tensors[i]);
   }
 
-  TF_DeleteStatus (status);
-
 #if (DBG)
   gint64 stop_time = g_get_real_time ();
   g_message ("Run() is finished: %" G_GINT64_FORMAT, (stop_time - start_time));
@@ -601,6 +629,7 @@ void
 TFCore::freeOutputTensor (void *data)
 {
   if (data != nullptr) {
+    std::lock_guard<std::mutex> lock (outputTensorLock);
     std::map<void *, TF_Tensor *>::iterator it = outputTensorMap.find (data);
     if (it != outputTensorMap.end ()) {
       TF_DeleteTensor (it->second);
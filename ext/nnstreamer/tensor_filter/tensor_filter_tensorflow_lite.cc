@@ -24,13 +24,27 @@
  * This is the per-NN-framework plugin (tensorflow-lite, tensorflow2-lite)
  * for tensor_filter. The meson build system generates two .so files
  * (e.g., TF-Lite and TF2-Lite) from this source code.
+ *
+ * The interpreters of the same model file share the mapped model, and with
+ * XNNPACK delegate, the packed weights in the XNNPACK weights cache.
+ * With NNAPI or GPU delegate, the compiled model is serialized into the
+ * delegate cache directory (custom property DelegateCacheDir, or
+ * delegate_cache_dir of [tensorflow-lite] in nnstreamer.ini) with the token
+ * of the model hash, so the next start skips the compilation.
  */
 
 #include <algorithm>
+#include <cstdlib>
+#include <functional>
 #include <limits.h>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
 #include <thread>
 #include <unistd.h>
 
+#include <glib/gstdio.h>
 #include <nnstreamer_log.h>
 #include <nnstreamer_plugin_api_util.h>
 #define NO_ANONYMOUS_NESTED_STRUCT
@@ -85,6 +99,21 @@
 #  endif
 #endif
 
+/** serialization of the compiled model of NNAPI and GPU delegates */
+#if TFLITE_VERSION_MAJOR >= 2 && TFLITE_VERSION_MINOR >= 7
+#  define TFLITE_DELEGATE_SERIALIZATION
+#endif
+
+/** per-op profiler */
+#if TFLITE_VERSION_MAJOR >= 2 && TFLITE_VERSION_MINOR >= 3
+#  define TFLITE_PROFILER
+#  if USE_TENSORFLOW2_HEADER_PATH
+#    include <tensorflow2/lite/profiling/buffered_profiler.h>
+#  else
+#    include <tensorflow/lite/profiling/buffered_profiler.h>
+#  endif
+#endif
+
 #if !defined(TFLITE_SUBPLUGIN_NAME)
 #warning "The sub-plugin name for tensorflow-lite is not defined."
 #define TFLITE_SUBPLUGIN_NAME "tensorflow-lite"
@@ -97,6 +126,35 @@
 #define TFLITE_RESOLVER_WITHOUT_DEFAULT_DELEGATES
 #endif
 
+/**
+ * @brief bind nnstreamer memory to the tensors with the custom allocation
+ */
+#if TFLITE_VERSION_MAJOR >= 2 && TFLITE_VERSION_MINOR >= 7
+#define TFLITE_CUSTOM_ALLOCATION
+#endif
+
+/**
+ * @brief The alignment of the custom allocation (tflite::kDefaultTensorAlignment)
+ */
+#define TFLITE_TENSOR_ALIGNMENT (64)
+
+/**
+ * @brief ProfileEvent has the elapsed time instead of the end timestamp
+ */
+#if TFLITE_VERSION_MAJOR >= 2 && TFLITE_VERSION_MINOR >= 5
+#define TFLITE_PROFILE_ELAPSED_TIME
+#endif
+
+/**
+ * @brief The max number of the profile events in an invoke
+ */
+#define TFLITE_PROFILER_MAX_ENTRIES (4096)
+
+/**
+ * @brief The default number of the interpreters prepared for the input shapes (including the current one)
+ */
+#define TFLITE_SHAPE_CACHE_SIZE (4)
+
 /**
  * @brief Macro for debug mode.
  */
@@ -127,8 +185,20 @@ typedef struct {
   gint num_threads; /**< the number of threads */
   const gchar *ext_delegate_path; /**< path to external delegate lib */
   GHashTable *ext_delegate_kv_table; /**< external delegate key values options */
+  gboolean profile; /**< aggregate the per-op profile over the stream */
+  const gchar *delegate_cache_dir; /**< directory to cache the compiled model of the delegate */
+  guint shape_cache; /**< the max number of the interpreters prepared for the input shapes */
 } tflite_option_s;
 
+/**
+ * @brief The per-op profile aggregated over the invokes.
+ */
+typedef struct {
+  const char *kind; /**< delegate (delegated kernel), cpu (builtin kernel) or delegated-op (op in the delegate) */
+  guint64 count; /**< the number of the op invokes */
+  guint64 total_us; /**< the total time of the op (usec) */
+} tflite_op_profile_s;
+
 /**
  * @brief Possible accelerators.
  */
@@ -148,6 +218,50 @@ static GstTensorFilterFrameworkStatistics tflite_internal_stats = {
   .total_overhead_latency = 0,
 };
 
+/**
+ * @brief The model mapped once for the interpreters of the same model file.
+ */
+class TFLiteSharedModel
+{
+  public:
+  TFLiteSharedModel (std::unique_ptr<tflite::FlatBufferModel> flatbuffer);
+  ~TFLiteSharedModel ();
+
+  static std::shared_ptr<TFLiteSharedModel> get (const char *model_path);
+
+  /** @brief get the flatbuffer model */
+  tflite::FlatBufferModel &getModel ()
+  {
+    return *model;
+  }
+
+#if TFLITE_XNNPACK_WEIGHTS_CACHE_SUPPORTED
+  TfLiteXNNPackDelegateWeightsCache *getWeightsCache ();
+#endif
+  const char *getToken ();
+
+  /** @brief lock the packing of the weights */
+  void lock ()
+  {
+    g_mutex_lock (&mutex);
+  }
+  /** @brief unlock the packing of the weights */
+  void unlock ()
+  {
+    g_mutex_unlock (&mutex);
+  }
+
+  private:
+  GMutex mutex;
+  std::unique_ptr<tflite::FlatBufferModel> model;
+  std::string token; /**< the hash of the model, to cache the compiled model of the delegate */
+#if TFLITE_XNNPACK_WEIGHTS_CACHE_SUPPORTED
+  TfLiteXNNPackDelegateWeightsCache *weights_cache; /**< the weights packed by XNNPACK, keyed by the address of the weights in the model */
+#endif
+
+  static std::map<std::string, std::weak_ptr<TFLiteSharedModel>> models;
+};
+
 /**
  * @brief Wrapper class for TFLite Interpreter to support model switching
  */
@@ -167,6 +281,17 @@ class TFLiteInterpreter
   void setModelPath (const char *model_path);
   void setExtDelegate (const char *lib_path, GHashTable *key_val);
   void getExtDelegate (const char **lib_path, GHashTable **key_val);
+  /** @brief set the directory to cache the compiled model of the delegate */
+  void setDelegateCacheDir (const char *dir)
+  {
+    g_free (delegate_cache_dir);
+    delegate_cache_dir = g_strdup (dir);
+  }
+  /** @brief get the directory to cache the compiled model of the delegate */
+  const char *getDelegateCacheDir ()
+  {
+    return delegate_cache_dir;
+  }
   /** @brief get current model path */
   const char *getModelPath ()
   {
@@ -209,16 +334,74 @@ class TFLiteInterpreter
     return delegate_ptr.get ();
   }
 
+  /** @brief aggregate the per-op profile at invoke, before loading the model */
+  void setProfiling (bool enable)
+  {
+    profiling = enable;
+  }
+  void mergeProfile (std::map<std::string, tflite_op_profile_s> &profiles);
+
+  /** @brief keep the interpreters prepared for the input shapes, 0 or 1 to resize the interpreter at every change */
+  void setShapeCacheSize (guint size)
+  {
+    shape_cache_size = size;
+  }
+
+  int createInstances (guint num, int num_threads, tflite_delegate_e delegate);
+  TFLiteInterpreter *lease ();
+  void release (TFLiteInterpreter *instance);
+  int forEachInstance (std::function<int (TFLiteInterpreter *)> func);
+
   private:
+  /**
+   * @brief The interpreter prepared for an input shape, kept in the shape cache.
+   */
+  struct ShapeEntry {
+    std::string key; /**< the input shape */
+    tflite::Interpreter::TfLiteDelegatePtr delegate; /**< the delegate of the interpreter */
+#ifdef TFLITE_PROFILER
+    std::unique_ptr<tflite::profiling::BufferedProfiler> profiler; /**< the profiler of the interpreter */
+#endif
+    std::unique_ptr<tflite::Interpreter> interpreter;
+    bool delegate_cached; /**< the delegate uses the compiled model in the delegate cache */
+    std::vector<void *> inputStaging; /**< staging buffers bound to the input tensors */
+    std::vector<void *> outputStaging; /**< staging buffers bound to the output tensors */
+
+    /** @brief ShapeEntry constructor */
+    ShapeEntry () : delegate (nullptr, [] (TfLiteDelegate *) {}), delegate_cached (false)
+    {
+    }
+  };
+
   GMutex mutex;
   char *model_path;
   bool is_cached_after_first_invoke; /**< To cache again after first invoke */
   bool is_xnnpack_delegated; /**< To check if XNNPACK delegate is used */
+  bool use_custom_allocation; /**< nnstreamer memory is bound to the tensors instead of memcpy */
+  bool custom_allocation_failed; /**< the tensors do not accept the custom allocation */
+  std::vector<void *> inputStaging; /**< aligned buffers bound to the input tensors if the memory is not aligned */
+  std::vector<void *> outputStaging; /**< aligned buffers bound to the output tensors if the memory is not aligned */
+  bool profiling; /**< aggregate the per-op profile at invoke */
+  std::map<std::string, tflite_op_profile_s> op_profiles; /**< the per-op profile keyed by the op name */
   char *ext_delegate_path; /**< path to external delegate lib */
   GHashTable *ext_delegate_kv_table; /**< external delegate key values options */
-
+  char *delegate_cache_dir; /**< directory to cache the compiled model of the delegate */
+  std::string delegate_cache_path; /**< the cache directory of the current delegate */
+  bool delegate_cached; /**< the delegate uses the compiled model in the delegate cache */
+  int load_num_threads; /**< the number of threads given to load the model */
+  tflite_delegate_e load_delegate; /**< the delegate given to load the model */
+  guint shape_cache_size; /**< the max number of the prepared interpreters including the current one */
+  std::string shape_key; /**< the input shape of the current interpreter */
+  std::list<ShapeEntry> shape_cache; /**< the interpreters of the other input shapes, most recently used first */
+
+#ifdef TFLITE_PROFILER
+  std::unique_ptr<tflite::profiling::BufferedProfiler> profiler; /**< should outlive the interpreter */
+#endif
   std::unique_ptr<tflite::Interpreter> interpreter;
-  std::unique_ptr<tflite::FlatBufferModel> model;
+  std::shared_ptr<TFLiteSharedModel> model; /**< shared with the interpreters of the same model file */
+
+  std::vector<TFLiteInterpreter *> instances; /**< pooled instances over the same model */
+  GAsyncQueue *idle_instances; /**< idle instances (including this) to lease, NULL if not pooled */
 
   GstTensorsInfo inputTensorMeta; /**< The tensor info of input tensors */
   GstTensorsInfo outputTensorMeta; /**< The tensor info of output tensors */
@@ -228,10 +411,41 @@ class TFLiteInterpreter
   tensor_type getTensorType (TfLiteType tfType);
   int getTensorDim (int tensor_idx, tensor_dim dim);
   int setTensorProp (const std::vector<int> &tensor_idx_list, GstTensorsInfo *tensorMeta);
+  int prepareCustomAllocation ();
+  int bindStaging (int tensor_idx, TfLiteTensor *tensor, void **staging);
+  bool bindTensor (int tensor_idx, TfLiteTensor *tensor, void *data, size_t size, void *staging);
+  void collectProfile ();
+  int resizeInputTensors (const GstTensorsInfo *info);
+  std::string getShapeKey (const GstTensorsInfo *info);
+  void swapShapeEntry (ShapeEntry &entry);
+  void clearShapeEntry (ShapeEntry &entry);
+  const char *prepareDelegateCache (const char *name);
 
   tflite::Interpreter::TfLiteDelegatePtr delegate_ptr; /**< single delegate supported */
 };
 
+/**
+ * @brief get the token of the model (SHA-256 of the model), to cache the compiled model of the delegate.
+ * @return the token, nullptr if the model is not mapped.
+ */
+const char *
+TFLiteSharedModel::getToken ()
+{
+  const tflite::Allocation *allocation = model->allocation ();
+
+  lock ();
+  if (token.empty () && allocation && allocation->base ()) {
+    gchar *hash = g_compute_checksum_for_data (G_CHECKSUM_SHA256,
+        static_cast<const guchar *> (allocation->base ()), allocation->bytes ());
+
+    token = hash;
+    g_free (hash);
+  }
+  unlock ();
+
+  return token.empty () ? nullptr : token.c_str ();
+}
+
 /**
  * @brief	ring cache structure
  */
@@ -252,6 +466,7 @@ class TFLiteCore
   int invoke (const GstTensorMemory *input, GstTensorMemory *output);
   /** @brief cache input and output tensor ptr before invoke */
   int cacheInOutTensorPtr ();
+  gchar *getProfile ();
   /** @brief callback method to delete interpreter for shared model */
   friend void free_interpreter (void *instance);
   /** @brief callback method to replace interpreter for shared model */
@@ -259,8 +474,11 @@ class TFLiteCore
 
   private:
   int num_threads;
+  guint num_instances; /**< the number of pooled instances of the shared model */
   accl_hw accelerator;
   tflite_delegate_e delegate;
+  bool profiling; /**< aggregate the per-op profile over the stream */
+  guint shape_cache; /**< the max number of the interpreters prepared for the input shapes */
 
   TFLiteInterpreter *interpreter;
   TFLiteInterpreter *interpreter_sub;
@@ -277,6 +495,90 @@ void fini_filter_tflite (void) __attribute__ ((destructor));
 }
 
 G_LOCK_DEFINE_STATIC (slock);
+G_LOCK_DEFINE_STATIC (model_lock);
+
+std::map<std::string, std::weak_ptr<TFLiteSharedModel>> TFLiteSharedModel::models;
+
+/**
+ * @brief TFLiteSharedModel constructor
+ */
+TFLiteSharedModel::TFLiteSharedModel (std::unique_ptr<tflite::FlatBufferModel> flatbuffer)
+: model (std::move (flatbuffer))
+{
+  g_mutex_init (&mutex);
+#if TFLITE_XNNPACK_WEIGHTS_CACHE_SUPPORTED
+  weights_cache = nullptr;
+#endif
+}
+
+/**
+ * @brief TFLiteSharedModel destructor
+ * @note The interpreters and the delegates using the model are already released.
+ */
+TFLiteSharedModel::~TFLiteSharedModel ()
+{
+#if TFLITE_XNNPACK_WEIGHTS_CACHE_SUPPORTED
+  if (weights_cache)
+    TfLiteXNNPackDelegateWeightsCacheDelete (weights_cache);
+#endif
+  g_mutex_clear (&mutex);
+}
+
+/**
+ * @brief get the shared model of the model file, map the file if not shared yet.
+ * @param model_path the path of the model file
+ * @return the shared model, nullptr if failed to map the model.
+ * @note The model is keyed by the path, size and modification time of the file,
+ *       so the updated file is mapped again.
+ */
+std::shared_ptr<TFLiteSharedModel>
+TFLiteSharedModel::get (const char *model_path)
+{
+  std::shared_ptr<TFLiteSharedModel> shared;
+  std::unique_ptr<tflite::FlatBufferModel> flatbuffer;
+  GStatBuf st;
+  gchar *key;
+
+  if (g_stat (model_path, &st) != 0)
+    key = g_strdup (model_path);
+  else
+    key = g_strdup_printf ("%s:%" G_GINT64_FORMAT ":%" G_GINT64_FORMAT,
+        model_path, (gint64) st.st_size, (gint64) st.st_mtime);
+
+  G_LOCK (model_lock);
+  shared = models[key].lock ();
+  if (!shared) {
+    flatbuffer = tflite::FlatBufferModel::BuildFromFile (model_path);
+    if (flatbuffer) {
+      shared = std::make_shared<TFLiteSharedModel> (std::move (flatbuffer));
+      models[key] = shared;
+    } else {
+      models.erase (key);
+    }
+  }
+  G_UNLOCK (model_lock);
+
+  g_free (key);
+  return shared;
+}
+
+#if TFLITE_XNNPACK_WEIGHTS_CACHE_SUPPORTED
+/**
+ * @brief get the XNNPACK weights cache of the model, create it if not exists.
+ * @note The caller should hold the lock.
+ */
+TfLiteXNNPackDelegateWeightsCache *
+TFLiteSharedModel::getWeightsCache ()
+{
+  if (!weights_cache) {
+    weights_cache = TfLiteXNNPackDelegateWeightsCacheCreate ();
+    if (!weights_cache)
+      ml_logw ("Failed to create the XNNPACK weights cache, the weights are packed for each interpreter.");
+  }
+
+  return weights_cache;
+}
+#endif
 
 /**
  * @brief TFLiteInterpreter constructor
@@ -289,6 +591,9 @@ TFLiteInterpreter::TFLiteInterpreter ()
   model_path = nullptr;
   ext_delegate_path = nullptr;
   ext_delegate_kv_table = nullptr;
+  delegate_cache_dir = nullptr;
+  delegate_cached = false;
+  idle_instances = nullptr;
 
   g_mutex_init (&mutex);
 
@@ -297,6 +602,12 @@ TFLiteInterpreter::TFLiteInterpreter ()
 
   is_cached_after_first_invoke = false;
   is_xnnpack_delegated = false;
+  use_custom_allocation = false;
+  custom_allocation_failed = false;
+  profiling = false;
+  load_num_threads = -1;
+  load_delegate = TFLITE_DELEGATE_NONE;
+  shape_cache_size = TFLITE_SHAPE_CACHE_SIZE;
 }
 
 /**
@@ -304,9 +615,33 @@ TFLiteInterpreter::TFLiteInterpreter ()
  */
 TFLiteInterpreter::~TFLiteInterpreter ()
 {
+  if (idle_instances) {
+    /* wait until the leased instances are released */
+    for (size_t i = 0; i <= instances.size (); i++)
+      g_async_queue_pop (idle_instances);
+    g_async_queue_unref (idle_instances);
+  }
+
+  for (TFLiteInterpreter *instance : instances)
+    delete instance;
+  instances.clear ();
+
+  for (ShapeEntry &entry : shape_cache)
+    clearShapeEntry (entry);
+  shape_cache.clear ();
+
+  /* release the interpreter before the delegate and the shared model */
+  interpreter = nullptr;
+
+  for (void *staging : inputStaging)
+    free (staging);
+  for (void *staging : outputStaging)
+    free (staging);
+
   g_mutex_clear (&mutex);
   g_free (model_path);
   g_free (ext_delegate_path);
+  g_free (delegate_cache_dir);
   if (ext_delegate_kv_table)
     g_hash_table_unref(ext_delegate_kv_table);
 
@@ -323,15 +658,32 @@ TFLiteInterpreter::invoke (const GstTensorMemory *input, GstTensorMemory *output
   int64_t start_time, stop_time;
   TfLiteTensor *tensor_ptr;
   TfLiteStatus status;
+  bool staged[NNS_TENSOR_SIZE_LIMIT];
 
   start_time = g_get_monotonic_time ();
 
   /**
    * XNNPACK Delegate uses fixed buffer address for input/output tensors.
    * Therefore tensor data is to be manually copied from/to input/output GStreamer
-   * buffers memory whose address changes at every round.
+   * buffers memory whose address changes at every round, unless the memory is
+   * bound to the tensors with the custom allocation.
    */
-  if (is_xnnpack_delegated) {
+  if (use_custom_allocation) {
+    for (unsigned int i = 0; i < inputTensorMeta.num_tensors; ++i) {
+      tensor_ptr = inputTensorPtr[i];
+      g_assert (tensor_ptr->bytes == input[i].size);
+      if (!bindTensor (interpreter->inputs ()[i], tensor_ptr, input[i].data,
+              input[i].size, inputStaging[i]))
+        memcpy (tensor_ptr->data.raw, input[i].data, input[i].size);
+    }
+
+    for (unsigned int i = 0; i < outputTensorMeta.num_tensors; ++i) {
+      tensor_ptr = outputTensorPtr[i];
+      g_assert (tensor_ptr->bytes == output[i].size);
+      staged[i] = !bindTensor (interpreter->outputs ()[i], tensor_ptr,
+          output[i].data, output[i].size, outputStaging[i]);
+    }
+  } else if (is_xnnpack_delegated) {
     for (unsigned int i = 0; i < inputTensorMeta.num_tensors; ++i) {
       tensor_ptr = inputTensorPtr[i];
       g_assert(tensor_ptr->bytes == input[i].size);
@@ -354,13 +706,25 @@ TFLiteInterpreter::invoke (const GstTensorMemory *input, GstTensorMemory *output
   tflite_internal_stats.total_overhead_latency += stop_time - start_time;
 
   start_time = g_get_monotonic_time ();
+#ifdef TFLITE_PROFILER
+  if (profiler)
+    profiler->StartProfiling ();
+#endif
   status = interpreter->Invoke ();
+  if (profiling)
+    collectProfile ();
 
   /**
    * After the very first invoke, the output buffer address may change.
    * To handle the case, memcpy the output buffer directly.
    */
-  if (is_xnnpack_delegated || !is_cached_after_first_invoke) {
+  if (use_custom_allocation) {
+    for (unsigned int i = 0; i < outputTensorMeta.num_tensors; ++i) {
+      tensor_ptr = outputTensorPtr[i];
+      if (staged[i])
+        memcpy (output[i].data, tensor_ptr->data.raw, output[i].size);
+    }
+  } else if (is_xnnpack_delegated || !is_cached_after_first_invoke) {
     for (unsigned int i = 0; i < outputTensorMeta.num_tensors; ++i) {
       tensor_ptr = outputTensorPtr[i];
       g_assert(tensor_ptr->bytes == output[i].size);
@@ -412,10 +776,18 @@ TFLiteInterpreter::loadModel (int num_threads, tflite_delegate_e delegate_e)
   start_time = g_get_monotonic_time ();
 #endif
 
-  model = tflite::FlatBufferModel::BuildFromFile (model_path);
+  /* to prepare another interpreter for the new input shape */
+  load_num_threads = num_threads;
+  load_delegate = delegate_e;
+  delegate_cached = false;
+
+  /* the pooled instance shares the model which is already loaded */
   if (!model) {
-    ml_loge ("Failed to mmap model\n");
-    return -1;
+    model = TFLiteSharedModel::get (model_path);
+    if (!model) {
+      ml_loge ("Failed to mmap model\n");
+      return -1;
+    }
   }
 
   /**
@@ -430,12 +802,21 @@ TFLiteInterpreter::loadModel (int num_threads, tflite_delegate_e delegate_e)
 #else
   tflite::ops::builtin::BuiltinOpResolver resolver;
 #endif
-  tflite::InterpreterBuilder (*model, resolver) (&interpreter);
+  tflite::InterpreterBuilder (model->getModel (), resolver) (&interpreter);
   if (!interpreter) {
     ml_loge ("Failed to construct interpreter\n");
     return -2;
   }
 
+  if (profiling) {
+#ifdef TFLITE_PROFILER
+    profiler = std::make_unique<tflite::profiling::BufferedProfiler> (TFLITE_PROFILER_MAX_ENTRIES);
+    interpreter->SetProfiler (profiler.get ());
+#else
+    ml_logw ("The per-op profile is not supported with this version of tensorflow-lite.");
+#endif
+  }
+
   if (num_threads > 0) {
     int n = static_cast<int> (std::thread::hardware_concurrency ());
 
@@ -453,6 +834,12 @@ TFLiteInterpreter::loadModel (int num_threads, tflite_delegate_e delegate_e)
       TfLiteXNNPackDelegateOptions xnnpack_options =
           TfLiteXNNPackDelegateOptionsDefault();
       xnnpack_options.num_threads = (num_threads > 1) ? num_threads : 0;
+#if TFLITE_XNNPACK_WEIGHTS_CACHE_SUPPORTED
+      /* the interpreters of the same model reuse the packed weights */
+      model->lock ();
+      xnnpack_options.weights_cache = model->getWeightsCache ();
+      model->unlock ();
+#endif
 
       is_xnnpack_delegated = true;
       ml_logw ("Input/output tensors should be memcpy-ed rather than explicitly assigning its ptr when XNNPACK Delegate is used.");
@@ -488,6 +875,19 @@ TFLiteInterpreter::loadModel (int num_threads, tflite_delegate_e delegate_e)
       options.inference_priority2 = TFLITE_GPU_INFERENCE_PRIORITY_MIN_MEMORY_USAGE;
       options.inference_priority3 = TFLITE_GPU_INFERENCE_PRIORITY_MAX_PRECISION;
 
+#ifdef TFLITE_DELEGATE_SERIALIZATION
+      {
+        const char *cache_dir = prepareDelegateCache ("gpu");
+
+        if (cache_dir) {
+          options.experimental_flags |= TFLITE_GPU_EXPERIMENTAL_FLAGS_ENABLE_SERIALIZATION;
+          options.serialization_dir = cache_dir;
+          options.model_token = model->getToken ();
+          delegate_cached = true;
+        }
+      }
+#endif
+
       delegate = TfLiteGpuDelegateV2Create (&options);
       void (* deleter) (TfLiteDelegate *) =
               [] (TfLiteDelegate *delegate_) {
@@ -504,7 +904,19 @@ TFLiteInterpreter::loadModel (int num_threads, tflite_delegate_e delegate_e)
     {
 #if TFLITE_NNAPI_DELEGATE_SUPPORTED
       /* set nnapi delegate when accelerator set to auto (cpu.neon in Android) or NPU */
-      delegate = new tflite::StatefulNnApiDelegate ();
+      tflite::StatefulNnApiDelegate::Options nnapi_options;
+
+#ifdef TFLITE_DELEGATE_SERIALIZATION
+      const char *cache_dir = prepareDelegateCache ("nnapi");
+
+      if (cache_dir) {
+        nnapi_options.cache_dir = cache_dir;
+        nnapi_options.model_token = model->getToken ();
+        delegate_cached = true;
+      }
+#endif
+
+      delegate = new tflite::StatefulNnApiDelegate (nnapi_options);
       void (* deleter) (TfLiteDelegate *) =
               [] (TfLiteDelegate *delegate_) {
                   delete reinterpret_cast<tflite::StatefulNnApiDelegate *> (delegate_);
@@ -550,19 +962,43 @@ TFLiteInterpreter::loadModel (int num_threads, tflite_delegate_e delegate_e)
       break;
   }
 
+  /* the weights are packed into the shared cache while applying the delegate */
+  if (is_xnnpack_delegated)
+    model->lock ();
+
   delegate = getDelegate ();
   if (delegate != nullptr) {
     if (interpreter->ModifyGraphWithDelegate (delegate) != kTfLiteOk) {
       ml_loge ("Failed to apply delegate\n");
+      if (is_xnnpack_delegated)
+        model->unlock ();
       return -2;
     }
   }
 
   if (interpreter->AllocateTensors () != kTfLiteOk) {
     ml_loge ("Failed to allocate tensors\n");
+    if (is_xnnpack_delegated)
+      model->unlock ();
     return -2;
   }
 
+  if (is_xnnpack_delegated) {
+#if TFLITE_XNNPACK_WEIGHTS_CACHE_SUPPORTED
+    /**
+     * The cache should be finalized before invoking. Soft finalization keeps
+     * it available for the interpreters created later.
+     */
+    TfLiteXNNPackDelegateWeightsCache *cache = model->getWeightsCache ();
+    if (cache && !TfLiteXNNPackDelegateWeightsCacheFinalizeSoft (cache)) {
+      ml_loge ("Failed to finalize the XNNPACK weights cache\n");
+      model->unlock ();
+      return -2;
+    }
+#endif
+    model->unlock ();
+  }
+
 #if (DBG)
   stop_time = g_get_monotonic_time ();
   ml_logi ("Model is loaded: %" G_GINT64_FORMAT, (stop_time - start_time));
@@ -702,28 +1138,111 @@ TFLiteInterpreter::setOutputTensorProp ()
  * @param info Structure for input tensor info.
  * @return 0 if OK. non-zero if error.
  * @note rank can be changed dependent on the model
+ *
+ * Resizing the input tensors re-plans the memory of the interpreter, and
+ * with a delegate, re-prepares the graph. The interpreters prepared for the
+ * recent input shapes are kept in the shape cache, and switching to a cached
+ * shape swaps the interpreter without resizing it.
  */
 int
 TFLiteInterpreter::setInputTensorsInfo (const GstTensorsInfo *info)
 {
-  TfLiteStatus status = kTfLiteOk;
   const std::vector<int> &input_idx_list = interpreter->inputs ();
-  int input_rank;
+  std::string key;
+  int err;
 
   /** Cannot change the number of inputs */
   if (info->num_tensors != input_idx_list.size ())
     return -EINVAL;
 
+  /** cannot change the type of input */
   for (unsigned int tensor_idx = 0; tensor_idx < info->num_tensors; ++tensor_idx) {
-    tensor_type tf_type;
-    const GstTensorInfo *tensor_info;
-
-    tensor_info = &info->info[tensor_idx];
+    tensor_type tf_type = getTensorType (interpreter->tensor (input_idx_list[tensor_idx])->type);
 
-    /** cannot change the type of input */
-    tf_type = getTensorType (interpreter->tensor (input_idx_list[tensor_idx])->type);
-    if (tf_type != tensor_info->type)
+    if (tf_type != info->info[tensor_idx].type)
       return -EINVAL;
+  }
+
+  /* the current interpreter has the input shape of the model */
+  if (shape_key.empty ())
+    shape_key = getShapeKey (&inputTensorMeta);
+
+  key = getShapeKey (info);
+  if (key == shape_key)
+    return 0;
+
+  if (shape_cache_size <= 1) {
+    err = resizeInputTensors (info);
+    /* the interpreter may be partially resized on failure */
+    shape_key = (err == 0) ? key : "-";
+    return err;
+  }
+
+  for (auto it = shape_cache.begin (); it != shape_cache.end (); ++it) {
+    if (it->key != key)
+      continue;
+
+    swapShapeEntry (*it);
+    it->key = shape_key;
+    shape_key = key;
+    shape_cache.splice (shape_cache.begin (), shape_cache, it);
+    return 0;
+  }
+
+  /* keep the current interpreter and prepare another one for the new shape */
+  shape_cache.emplace_front ();
+  swapShapeEntry (shape_cache.front ());
+  shape_cache.front ().key = shape_key;
+
+  if (shape_cache.size () >= shape_cache_size) {
+    /* reuse the least recently used interpreter */
+    swapShapeEntry (shape_cache.back ());
+    shape_cache.pop_back ();
+    err = resizeInputTensors (info);
+  } else {
+    err = loadModel (load_num_threads, load_delegate);
+    if (err == 0)
+      err = resizeInputTensors (info);
+  }
+
+  if (err != 0) {
+    /* restore the previous interpreter */
+    swapShapeEntry (shape_cache.front ());
+    clearShapeEntry (shape_cache.front ());
+    shape_cache.pop_front ();
+    return (err < 0) ? err : -EPERM;
+  }
+
+  shape_key = key;
+  return 0;
+}
+
+/**
+ * @brief resize the input tensors of the current interpreter.
+ * @param info Structure for input tensor info.
+ * @return 0 if OK. non-zero if error.
+ */
+int
+TFLiteInterpreter::resizeInputTensors (const GstTensorsInfo *info)
+{
+  TfLiteStatus status = kTfLiteOk;
+  int input_rank;
+
+  /**
+   * The compiled model in the delegate cache is of the input shape of the model,
+   * and the delegate prepared again with the other shape may reuse it.
+   * Load the interpreter again without the cache.
+   */
+  if (delegate_cached) {
+    int err = loadModel (load_num_threads, load_delegate);
+    if (err != 0)
+      return err;
+  }
+
+  const std::vector<int> &input_idx_list = interpreter->inputs ();
+
+  for (unsigned int tensor_idx = 0; tensor_idx < info->num_tensors; ++tensor_idx) {
+    const GstTensorInfo *tensor_info = &info->info[tensor_idx];
 
     /**
      * Given that the rank intended by the user cannot be exactly determined,
@@ -756,6 +1275,96 @@ TFLiteInterpreter::setInputTensorsInfo (const GstTensorsInfo *info)
   return 0;
 }
 
+/**
+ * @brief get the key of the input shape in the shape cache.
+ */
+std::string
+TFLiteInterpreter::getShapeKey (const GstTensorsInfo *info)
+{
+  std::string key;
+
+  for (unsigned int i = 0; i < info->num_tensors; ++i) {
+    for (int d = 0; d < NNS_TENSOR_RANK_LIMIT; d++) {
+      /* unset dimension (0) is same as 1 */
+      key += std::to_string (MAX (info->info[i].dimension[d], 1U));
+      key += (d < NNS_TENSOR_RANK_LIMIT - 1) ? ":" : ",";
+    }
+  }
+
+  return key;
+}
+
+/**
+ * @brief swap the current interpreter with the interpreter in the shape cache.
+ * @note The tensor pointers should be cached again before invoke.
+ */
+void
+TFLiteInterpreter::swapShapeEntry (ShapeEntry &entry)
+{
+  std::swap (interpreter, entry.interpreter);
+  std::swap (delegate_ptr, entry.delegate);
+  std::swap (delegate_cached, entry.delegate_cached);
+#ifdef TFLITE_PROFILER
+  std::swap (profiler, entry.profiler);
+#endif
+  inputStaging.swap (entry.inputStaging);
+  outputStaging.swap (entry.outputStaging);
+
+  inputTensorPtr.clear ();
+  outputTensorPtr.clear ();
+}
+
+/**
+ * @brief release the interpreter in the shape cache.
+ */
+void
+TFLiteInterpreter::clearShapeEntry (ShapeEntry &entry)
+{
+  /* release the interpreter before the delegate and the staging buffers */
+  entry.interpreter = nullptr;
+
+  for (void *staging : entry.inputStaging)
+    free (staging);
+  for (void *staging : entry.outputStaging)
+    free (staging);
+
+  entry.inputStaging.clear ();
+  entry.outputStaging.clear ();
+}
+
+/**
+ * @brief get the directory to cache the compiled model of the delegate, and create it if not exists.
+ * @param name the name of the delegate, the sub-directory of the cache
+ * @return the directory, nullptr if the cache is disabled or not available.
+ * @note The cache is used only for the input shape of the model.
+ */
+const char *
+TFLiteInterpreter::prepareDelegateCache (const char *name)
+{
+  gchar *path;
+
+  if (!delegate_cache_dir || delegate_cache_dir[0] == '\0' || !shape_key.empty ())
+    return nullptr;
+
+  if (!model || model->getToken () == nullptr) {
+    ml_logw ("Cannot get the token of the model, the delegate cache is not used.");
+    return nullptr;
+  }
+
+  path = g_build_filename (delegate_cache_dir, name, NULL);
+  if (g_mkdir_with_parents (path, 0700) != 0) {
+    ml_logw ("Failed to create the delegate cache directory %s.", path);
+    g_free (path);
+    return nullptr;
+  }
+
+  delegate_cache_path = path;
+  g_free (path);
+
+  ml_logi ("The compiled model of the delegate is cached in %s.", delegate_cache_path.c_str ());
+  return delegate_cache_path.c_str ();
+}
+
 /**
  * @brief update the model path
  */
@@ -834,6 +1443,9 @@ TFLiteInterpreter::cacheInOutTensorPtr ()
     outputTensorPtr.push_back (tensor_ptr);
   }
 
+  if (is_xnnpack_delegated)
+    prepareCustomAllocation ();
+
   return 0;
 
 fail_exit:
@@ -842,20 +1454,293 @@ fail_exit:
   return -EINVAL;
 }
 
+/**
+ * @brief bind the aligned staging buffer to the tensor with the custom allocation
+ * @param[inout] staging the staging buffer, replaced by new one bound to the tensor
+ * @return 0 on success. -errno on failure.
+ */
+int
+TFLiteInterpreter::bindStaging (int tensor_idx, TfLiteTensor *tensor, void **staging)
+{
+#ifdef TFLITE_CUSTOM_ALLOCATION
+  void *buffer = nullptr;
+  TfLiteCustomAllocation allocation;
+
+  if (posix_memalign (&buffer, TFLITE_TENSOR_ALIGNMENT, MAX (tensor->bytes, 1U)) != 0)
+    return -ENOMEM;
+
+  allocation.data = buffer;
+  allocation.bytes = tensor->bytes;
+  if (interpreter->SetCustomAllocationForTensor (tensor_idx, allocation) != kTfLiteOk) {
+    free (buffer);
+    return -EINVAL;
+  }
+
+  /* the previous buffer is not bound anymore */
+  free (*staging);
+  *staging = buffer;
+  return 0;
+#else
+  UNUSED (tensor_idx);
+  UNUSED (tensor);
+  UNUSED (staging);
+  return -ENOTSUP;
+#endif
+}
+
+/**
+ * @brief bind the staging buffers to the input and output tensors, to bind
+ *        nnstreamer memory to the tensors at invoke.
+ * @return 0 on success. -errno if the tensors do not accept the custom allocation.
+ * @note The tensors keep the staging buffers on failure, and the data is copied
+ *       into the tensors as before.
+ */
+int
+TFLiteInterpreter::prepareCustomAllocation ()
+{
+  int err;
+
+  use_custom_allocation = false;
+  if (custom_allocation_failed)
+    return -EINVAL;
+
+  inputStaging.resize (inputTensorMeta.num_tensors, nullptr);
+  for (unsigned int i = 0; i < inputTensorMeta.num_tensors; ++i) {
+    err = bindStaging (interpreter->inputs ()[i], inputTensorPtr[i], &inputStaging[i]);
+    if (err != 0)
+      goto failed;
+  }
+
+  outputStaging.resize (outputTensorMeta.num_tensors, nullptr);
+  for (unsigned int i = 0; i < outputTensorMeta.num_tensors; ++i) {
+    err = bindStaging (interpreter->outputs ()[i], outputTensorPtr[i], &outputStaging[i]);
+    if (err != 0)
+      goto failed;
+  }
+
+  ml_logi ("The tensor memory is bound to the XNNPACK delegated tensors without memcpy if aligned to %d bytes.",
+      TFLITE_TENSOR_ALIGNMENT);
+  use_custom_allocation = true;
+  return 0;
+
+failed:
+  ml_logw ("The tensors do not accept the custom allocation (%d), the tensor memory is copied.", err);
+  custom_allocation_failed = true;
+  return err;
+}
+
+/**
+ * @brief bind the memory to the tensor with the custom allocation if aligned,
+ *        otherwise bind the staging buffer.
+ * @return true if the memory is bound, false if the staging buffer is bound and the data should be copied.
+ */
+bool
+TFLiteInterpreter::bindTensor (int tensor_idx, TfLiteTensor *tensor,
+    void *data, size_t size, void *staging)
+{
+#ifdef TFLITE_CUSTOM_ALLOCATION
+  TfLiteCustomAllocation allocation;
+
+  if (((guintptr) data) % TFLITE_TENSOR_ALIGNMENT == 0 && size == tensor->bytes) {
+    allocation.data = data;
+    allocation.bytes = size;
+    if (interpreter->SetCustomAllocationForTensor (tensor_idx, allocation) == kTfLiteOk)
+      return true;
+  }
+
+  if (tensor->data.raw != staging) {
+    allocation.data = staging;
+    allocation.bytes = tensor->bytes;
+    interpreter->SetCustomAllocationForTensor (tensor_idx, allocation);
+  }
+#else
+  UNUSED (tensor_idx);
+  UNUSED (tensor);
+  UNUSED (data);
+  UNUSED (size);
+  UNUSED (staging);
+#endif
+  return false;
+}
+
+/**
+ * @brief create the pooled instances sharing the loaded model
+ * @param num the number of instances including this
+ * @return 0 on success. -errno on failure.
+ * @note The instances are created only once, the caller should hold the lock.
+ */
+int
+TFLiteInterpreter::createInstances (guint num, int num_threads, tflite_delegate_e delegate_e)
+{
+  TFLiteInterpreter *instance;
+
+  if (num <= 1 || idle_instances != nullptr)
+    return 0;
+
+  if (!model || !interpreter) {
+    ml_loge ("The model should be loaded before creating the instances.");
+    return -EINVAL;
+  }
+
+  for (guint i = 1; i < num; i++) {
+    instance = new TFLiteInterpreter ();
+    instance->setModelPath (model_path);
+    instance->setExtDelegate (ext_delegate_path, ext_delegate_kv_table);
+    instance->setProfiling (profiling);
+    instance->setShapeCacheSize (shape_cache_size);
+    instance->setDelegateCacheDir (delegate_cache_dir);
+    instance->model = model;
+
+    if (instance->loadModel (num_threads, delegate_e) != 0
+        || instance->setInputTensorProp () != 0
+        || instance->setOutputTensorProp () != 0
+        || instance->cacheInOutTensorPtr () != 0) {
+      ml_loge ("Failed to create the %u-th instance of the shared model.", i);
+      delete instance;
+      goto error;
+    }
+
+    instances.push_back (instance);
+  }
+
+  idle_instances = g_async_queue_new ();
+  g_async_queue_push (idle_instances, this);
+  for (TFLiteInterpreter *inst : instances)
+    g_async_queue_push (idle_instances, inst);
+
+  ml_logi ("Created %u instances of the shared model %s", num, model_path);
+  return 0;
+
+error:
+  for (TFLiteInterpreter *inst : instances)
+    delete inst;
+  instances.clear ();
+  return -EINVAL;
+}
+
+/**
+ * @brief lease an idle instance to invoke, wait if all instances are busy.
+ * @return this if the instances are not pooled.
+ */
+TFLiteInterpreter *
+TFLiteInterpreter::lease ()
+{
+  if (!idle_instances)
+    return this;
+
+  return static_cast<TFLiteInterpreter *> (g_async_queue_pop (idle_instances));
+}
+
+/**
+ * @brief release the leased instance.
+ */
+void
+TFLiteInterpreter::release (TFLiteInterpreter *instance)
+{
+  if (idle_instances)
+    g_async_queue_push (idle_instances, instance);
+}
+
+/**
+ * @brief call the function for each pooled instance (except this) with its lock.
+ * @return 0 on success, or the first error of the function.
+ */
+int
+TFLiteInterpreter::forEachInstance (std::function<int (TFLiteInterpreter *)> func)
+{
+  int err = 0;
+
+  for (TFLiteInterpreter *instance : instances) {
+    instance->lock ();
+    err = func (instance);
+    instance->unlock ();
+
+    if (err != 0)
+      break;
+  }
+
+  return err;
+}
+
+/**
+ * @brief aggregate the profile events of the last invoke into the per-op profile.
+ */
+void
+TFLiteInterpreter::collectProfile ()
+{
+#ifdef TFLITE_PROFILER
+  if (!profiler)
+    return;
+
+  profiler->StopProfiling ();
+
+  for (const tflite::profiling::ProfileEvent *event : profiler->GetProfileEvents ()) {
+    const char *kind;
+    guint64 elapsed;
+
+    if (event->event_type == tflite::Profiler::EventType::OPERATOR_INVOKE_EVENT) {
+      const std::pair<TfLiteNode, TfLiteRegistration> *node = nullptr;
+
+      /* the node of the primary subgraph, to find the ops not delegated */
+      if (static_cast<guint64> (event->event_metadata) < interpreter->nodes_size ())
+        node = interpreter->node_and_registration (static_cast<int> (event->event_metadata));
+      kind = (node && node->first.delegate) ? "delegate" : "cpu";
+    } else if (event->event_type == tflite::Profiler::EventType::DELEGATE_OPERATOR_INVOKE_EVENT) {
+      kind = "delegated-op";
+    } else {
+      continue;
+    }
+
+#ifdef TFLITE_PROFILE_ELAPSED_TIME
+    elapsed = event->elapsed_time;
+#else
+    elapsed = event->end_timestamp_us - event->begin_timestamp_us;
+#endif
+
+    tflite_op_profile_s &op = op_profiles[event->tag ? event->tag : "unknown"];
+    op.kind = kind;
+    op.count++;
+    op.total_us += elapsed;
+  }
+
+  profiler->Reset ();
+#endif
+}
+
+/**
+ * @brief add the per-op profile of this interpreter to the given profiles.
+ * @note The caller should hold the lock of this interpreter.
+ */
+void
+TFLiteInterpreter::mergeProfile (std::map<std::string, tflite_op_profile_s> &profiles)
+{
+  for (const auto &it : op_profiles) {
+    tflite_op_profile_s &op = profiles[it.first];
+
+    op.kind = it.second.kind;
+    op.count += it.second.count;
+    op.total_us += it.second.total_us;
+  }
+}
+
 /**
  * @brief	TFLiteCore constructor
  */
 TFLiteCore::TFLiteCore (const GstTensorFilterProperties *prop)
 {
   num_threads = -1;
+  num_instances = 1;
   accelerator = ACCL_NONE;
   delegate = TFLITE_DELEGATE_NONE;
   interpreter_sub = nullptr;
   shared_tensor_filter_key = NULL;
+  profiling = false;
+  shape_cache = TFLITE_SHAPE_CACHE_SIZE;
 
   if (prop->shared_tensor_filter_key) {
     shared_tensor_filter_key =
         g_strdup (prop->shared_tensor_filter_key);
+    num_instances = MAX (prop->shared_tensor_filter_instances, 1U);
     if (!checkSharedInterpreter (prop))
       interpreter = new TFLiteInterpreter ();
   }
@@ -965,12 +1850,18 @@ TFLiteCore::setAccelerator (const char *accelerators, tflite_delegate_e d)
  *        -2 if the initialization of input tensor is failed.
  *        -3 if the initialization of output tensor is failed.
  *        -4 if the caching of input and output tensors failed.
+ *        -5 if the instances of the shared model are not created.
  */
 int
 TFLiteCore::init (tflite_option_s *option)
 {
   interpreter->setModelPath (option->model_file);
   interpreter->setExtDelegate (option->ext_delegate_path, option->ext_delegate_kv_table);
+  interpreter->setDelegateCacheDir (option->delegate_cache_dir);
+  profiling = option->profile;
+  interpreter->setProfiling (profiling);
+  shape_cache = option->shape_cache;
+  interpreter->setShapeCacheSize (shape_cache);
   num_threads = option->num_threads;
   int err;
 
@@ -993,6 +1884,16 @@ TFLiteCore::init (tflite_option_s *option)
     ml_loge ("Failed to cache input and output tensors storage\n");
     return -4;
   }
+  if (num_instances > 1) {
+    interpreter->lock ();
+    err = interpreter->createInstances (num_instances, num_threads, delegate);
+    interpreter->unlock ();
+
+    if (err != 0) {
+      ml_loge ("Failed to create the instances of the shared model\n");
+      return -5;
+    }
+  }
   return 0;
 }
 
@@ -1042,6 +1943,10 @@ TFLiteCore::setInputTensorProp ()
   err = interpreter->setInputTensorProp ();
   interpreter->unlock ();
 
+  if (err == 0)
+    err = interpreter->forEachInstance (
+        [] (TFLiteInterpreter *instance) { return instance->setInputTensorProp (); });
+
   return err;
 }
 
@@ -1058,6 +1963,10 @@ TFLiteCore::setOutputTensorProp ()
   err = interpreter->setOutputTensorProp ();
   interpreter->unlock ();
 
+  if (err == 0)
+    err = interpreter->forEachInstance (
+        [] (TFLiteInterpreter *instance) { return instance->setOutputTensorProp (); });
+
   return err;
 }
 
@@ -1108,6 +2017,11 @@ TFLiteCore::setInputTensorDim (const GstTensorsInfo *info)
   err = interpreter->setInputTensorsInfo (info);
   interpreter->unlock ();
 
+  if (err == 0)
+    err = interpreter->forEachInstance ([info] (TFLiteInterpreter *instance) {
+      return instance->setInputTensorsInfo (info);
+    });
+
   return err;
 }
 
@@ -1178,6 +2092,9 @@ TFLiteCore::reloadModel (const char *_model_path)
   interpreter_sub->setModelPath (_model_path);
   interpreter->getExtDelegate(&_ext_delegate_path, &_ext_delegate_kv);
   interpreter_sub->setExtDelegate(_ext_delegate_path, _ext_delegate_kv);
+  interpreter_sub->setProfiling (profiling);
+  interpreter_sub->setShapeCacheSize (shape_cache);
+  interpreter_sub->setDelegateCacheDir (interpreter->getDelegateCacheDir ());
 
   /**
    * load a model into sub interpreter. This loading overhead is independent
@@ -1199,6 +2116,10 @@ TFLiteCore::reloadModel (const char *_model_path)
     ml_loge ("Failed to cache input and output tensors storage\n");
     return -EINVAL;
   }
+  if (interpreter_sub->createInstances (num_instances, num_threads, delegate) != 0) {
+    ml_loge ("Failed to create the instances of the shared model\n");
+    return -EINVAL;
+  }
 
   if (shared_tensor_filter_key) {
     /* update cores with new interpreter that has shared key */
@@ -1225,12 +2146,18 @@ TFLiteCore::reloadModel (const char *_model_path)
 int
 TFLiteCore::invoke (const GstTensorMemory *input, GstTensorMemory *output)
 {
+  TFLiteInterpreter *pool = interpreter;
+  TFLiteInterpreter *instance;
   int err;
 
-  interpreter->lock ();
-  err = interpreter->invoke (input, output);
-  interpreter->unlock ();
+  /* lease an idle instance if the shared model is pooled */
+  instance = pool->lease ();
+
+  instance->lock ();
+  err = instance->invoke (input, output);
+  instance->unlock ();
 
+  pool->release (instance);
   return err;
 }
 
@@ -1246,9 +2173,54 @@ TFLiteCore::cacheInOutTensorPtr ()
   err = interpreter->cacheInOutTensorPtr ();
   interpreter->unlock ();
 
+  if (err == 0)
+    err = interpreter->forEachInstance (
+        [] (TFLiteInterpreter *instance) { return instance->cacheInOutTensorPtr (); });
+
   return err;
 }
 
+/**
+ * @brief get the per-op profile of the pooled instances, ordered by the total time.
+ * @return Newly allocated profile text, nullptr if the profile is disabled.
+ */
+gchar *
+TFLiteCore::getProfile ()
+{
+  std::map<std::string, tflite_op_profile_s> profiles;
+  std::vector<std::pair<std::string, tflite_op_profile_s>> sorted;
+  GString *str;
+
+  if (!profiling)
+    return nullptr;
+
+  interpreter->lock ();
+  interpreter->mergeProfile (profiles);
+  interpreter->unlock ();
+
+  interpreter->forEachInstance ([&profiles] (TFLiteInterpreter *instance) {
+    instance->mergeProfile (profiles);
+    return 0;
+  });
+
+  sorted.assign (profiles.begin (), profiles.end ());
+  std::sort (sorted.begin (), sorted.end (),
+      [] (const std::pair<std::string, tflite_op_profile_s> &a,
+          const std::pair<std::string, tflite_op_profile_s> &b) {
+        return a.second.total_us > b.second.total_us;
+      });
+
+  str = g_string_new ("op\tkind\tcount\ttotal_us\tavg_us\n");
+  for (const auto &it : sorted) {
+    g_string_append_printf (str,
+        "%s\t%s\t%" G_GUINT64_FORMAT "\t%" G_GUINT64_FORMAT "\t%" G_GUINT64_FORMAT "\n",
+        it.first.c_str (), it.second.kind, it.second.count, it.second.total_us,
+        it.second.total_us / MAX (it.second.count, 1U));
+  }
+
+  return g_string_free (str, FALSE);
+}
+
 /**
  * @brief Internal function to get the option for tf-lite model.
  */
@@ -1264,6 +2236,9 @@ tflite_parseCustomOption (const GstTensorFilterProperties *prop, tflite_option_s
   option->num_threads = -1;
   option->ext_delegate_path = nullptr;
   option->ext_delegate_kv_table = nullptr;
+  option->profile = FALSE;
+  option->shape_cache = TFLITE_SHAPE_CACHE_SIZE;
+  option->delegate_cache_dir = nullptr;
 
   if (prop->custom_properties) {
     gchar **strv;
@@ -1292,6 +2267,13 @@ tflite_parseCustomOption (const GstTensorFilterProperties *prop, tflite_option_s
             option->delegate = TFLITE_DELEGATE_EXTERNAL;
           else
             ml_logw ("Unknown option to set tensorflow-lite delegate (%s).", pair[1]);
+        } else if (g_ascii_strcasecmp (pair[0], "Profile") == 0) {
+          option->profile = (g_ascii_strcasecmp (pair[1], "true") == 0);
+        } else if (g_ascii_strcasecmp (pair[0], "DelegateCacheDir") == 0) {
+          g_free ((gpointer) option->delegate_cache_dir);
+          option->delegate_cache_dir = g_strdup (pair[1]);
+        } else if (g_ascii_strcasecmp (pair[0], "ShapeCache") == 0) {
+          option->shape_cache = (guint) g_ascii_strtoull (pair[1], NULL, 10);
         } else if (g_ascii_strcasecmp (pair[0], "ExtDelegateLib") == 0) {
           option->ext_delegate_path = g_strdup (pair[1]);
         } else if (g_ascii_strcasecmp (pair[0], "ExtDelegateKeyVal") == 0) {
@@ -1328,6 +2310,15 @@ tflite_parseCustomOption (const GstTensorFilterProperties *prop, tflite_option_s
     g_strfreev (strv);
   }
 
+  /* the thread pool of tensor-filter property, if the custom option is not given */
+  if (option->num_threads < 0 && prop->num_threads > 0)
+    option->num_threads = prop->num_threads;
+
+  /* the delegate cache in the configuration, if the custom option is not given */
+  if (option->delegate_cache_dir == NULL)
+    option->delegate_cache_dir =
+        nnsconf_get_custom_value_string ("tensorflow-lite", "delegate_cache_dir");
+
   if (option->delegate == TFLITE_DELEGATE_EXTERNAL
       && option->ext_delegate_path == NULL) {
     ml_logw ("No shared lib for external delegate.");
@@ -1406,6 +2397,8 @@ tflite_loadModelFile (const GstTensorFilterProperties *prop, void **private_data
 done:
   g_free ((gpointer) option.ext_delegate_path);
   option.ext_delegate_path = nullptr;
+  g_free ((gpointer) option.delegate_cache_dir);
+  option.delegate_cache_dir = nullptr;
 
   if (option.ext_delegate_kv_table)
     g_hash_table_unref (option.ext_delegate_kv_table);
@@ -1609,6 +2602,28 @@ tflite_checkAvailability (accl_hw hw)
   return -ENOENT;
 }
 
+/**
+ * @brief The optional callback for GstTensorFilterFramework
+ * @param[in] ops operation to be performed
+ * @param[in/out] data event data
+ * @return 0 if OK. -ENOENT if the operation or the profile is not supported.
+ */
+static int
+tflite_handleEvent (event_ops ops, GstTensorFilterFrameworkEventData *data)
+{
+  TFLiteCore *core;
+
+  if (ops != GET_PROFILE)
+    return -ENOENT;
+
+  g_return_val_if_fail (data != NULL && data->instance != NULL, -EINVAL);
+
+  core = static_cast<TFLiteCore *> (data->instance);
+  data->profile = core->getProfile ();
+
+  return data->profile ? 0 : -ENOENT;
+}
+
 static gchar filter_subplugin_tensorflow_lite[] = TFLITE_SUBPLUGIN_NAME;
 
 static GstTensorFilterFramework NNS_support_tensorflow_lite
@@ -1628,7 +2643,7 @@ static GstTensorFilterFramework NNS_support_tensorflow_lite
               .setInputDimension = tflite_setInputDim,
               .destroyNotify = nullptr,
               .reloadModel = tflite_reloadModel,
-              .handleEvent = nullptr,
+              .handleEvent = tflite_handleEvent,
               .checkAvailability = tflite_checkAvailability,
               .allocateInInvoke = nullptr,
           } } };
@@ -1646,6 +2661,7 @@ init_filter_tflite (void)
       "ExtDelegateLib", "Path to external delegate shared library",
       "ExtDelegateKeyVal", "key/values pairs optional parameters for delegate."
       " Format ExtDelegateKeyVal=key1#value1;key2#value2...",
+      "Profile", "Set 'true' to post the per-op profile aggregated over the stream.",
       NULL);
 }
 
@@ -14,14 +14,29 @@
  * This is the per-NN-framework plugin (TensorRT) for tensor_filter.
  *
  * @note Only support UFF (universal framework format) file as inference model.
+ *       The built engine is cached in engine_cache_dir of [tensorrt] in nnstreamer.ini.
+ *       The instances of the same model share the engine, and each instance runs
+ *       its own execution context on a dedicated CUDA stream with page-locked
+ *       staging buffers. Set the property workers of tensor_filter to invoke the
+ *       instances concurrently, so that the copy of a frame overlaps the
+ *       inference of the previous frame.
+ *       With the property device-memory of tensor_filter, the output stays in
+ *       the Cuda memory and the next TensorRT filter takes it without the copy
+ *       through host memory. The output is downloaded when the other element
+ *       maps it.
  */
 
+#include <map>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <stdexcept>
+#include <string>
 #include <vector>
 
 #include <nnstreamer_cppplugin_api_filter.hh>
 #include <tensor_common.h>
+#include <nnstreamer_conf.h>
 #include <nnstreamer_util.h>
 
 #include <NvInfer.h>
@@ -99,27 +114,55 @@ class tensorrt_subplugin final : public tensor_filter_subplugin
 
 
   private:
+  /** @brief TensorRT engine shared by the instances of the same model */
+  struct SharedEngine {
+    UniquePtr<nvinfer1::IRuntime> runtime{ nullptr }; /**< Runtime to deserialize the cached engine, released after the engine */
+    UniquePtr<nvinfer1::ICudaEngine> engine{ nullptr };
+  };
+
   static const char *name;
+  static const char *engine_precision;
   static const accl_hw hw_list[];
   static const int num_hw = 0;
   static tensorrt_subplugin *registeredRepresentation;
+  static std::mutex enginesLock; /**< Lock for the shared engines */
+  static std::map<std::string, std::weak_ptr<SharedEngine>> sharedEngines; /**< Engines by the key of the model */
+  static const GstTensorDeviceOps deviceOps; /**< Operations of the Cuda memory */
 
   gchar *_uff_path; /**< UFF file path to infer */
   void *_inputBuffer; /**< Input Cuda buffer */
+  void *_outputBuffer; /**< Output Cuda buffer */
+  void *_inputHost; /**< Page-locked staging buffer of the input */
+  gsize _inputSize;
+  gsize _outputSize;
+  cudaStream_t _stream; /**< Dedicated stream of the execution context */
+
+  std::mutex _outputPoolLock; /**< Lock for the output pool, the outputs are released in the other threads */
+  std::vector<void *> _outputPool; /**< Page-locked output buffers to be reused */
+  std::vector<void *> _deviceOutputPool; /**< Cuda output buffers to be reused */
+  std::set<void *> _deviceOutputs; /**< All Cuda output buffers allocated, to find the pool of the released output */
+  bool _deviceInput; /**< The input of the next invoke is in the Cuda memory */
+  bool _deviceOutput; /**< The output of the next invoke should be kept in the Cuda memory */
 
   GstTensorsInfo _inputTensorMeta;
   GstTensorsInfo _outputTensorMeta;
 
   nvinfer1::Dims _InputDims;
   nvinfer1::DataType _DataType;
-  UniquePtr<nvinfer1::ICudaEngine> _Engine{ nullptr };
+  std::shared_ptr<SharedEngine> _Engine{ nullptr };
   UniquePtr<nvinfer1::IExecutionContext> _Context{ nullptr };
 
-  int allocBuffer (void **buffer, gsize size);
+  int allocBuffers ();
+  void *acquireOutput ();
+  void *acquireDeviceOutput ();
+  void releaseOutput (void *data);
   int setInputDims (guint input_rank);
   int setTensorType (tensor_type t);
   int loadModel (const GstTensorFilterProperties *prop);
-  int checkUnifiedMemory ();
+  int buildEngine (SharedEngine &shared);
+  gchar *getEngineKey ();
+  int loadEngineCache (const gchar *path, SharedEngine &shared);
+  void saveEngineCache (const gchar *path, SharedEngine &shared);
 
   /** @brief Make unique pointer */
   template <typename T> UniquePtr<T> makeUnique (T *t)
@@ -129,13 +172,36 @@ class tensorrt_subplugin final : public tensor_filter_subplugin
 };
 
 const char *tensorrt_subplugin::name = "tensorrt";
+/** The builder does not enable reduced precision (kFP16 or kINT8). */
+const char *tensorrt_subplugin::engine_precision = "fp32";
+std::mutex tensorrt_subplugin::enginesLock;
+std::map<std::string, std::weak_ptr<tensorrt_subplugin::SharedEngine>> tensorrt_subplugin::sharedEngines;
+
+/** @brief Download the tensor from the Cuda memory */
+static int
+_cuda_download (void *device_data, void *host_data, size_t size)
+{
+  return (cudaMemcpy (host_data, device_data, size, cudaMemcpyDeviceToHost) == cudaSuccess) ? 0 : -EIO;
+}
+
+/** @brief Upload the tensor to the Cuda memory */
+static int
+_cuda_upload (void *device_data, const void *host_data, size_t size)
+{
+  return (cudaMemcpy (device_data, host_data, size, cudaMemcpyHostToDevice) == cudaSuccess) ? 0 : -EIO;
+}
+
+const GstTensorDeviceOps tensorrt_subplugin::deviceOps
+    = { NNS_TENSOR_MEMORY_CUDA, _cuda_download, _cuda_upload };
 const accl_hw tensorrt_subplugin::hw_list[] = {};
 
 /**
  * @brief constructor of tensorrt_subplugin
  */
 tensorrt_subplugin::tensorrt_subplugin ()
-    : tensor_filter_subplugin (), _uff_path (nullptr), _inputBuffer (nullptr)
+    : tensor_filter_subplugin (), _uff_path (nullptr), _inputBuffer (nullptr),
+      _outputBuffer (nullptr), _inputHost (nullptr), _inputSize (0),
+      _outputSize (0), _stream (nullptr), _deviceInput (false), _deviceOutput (false)
 {
   gst_tensors_info_init (&_inputTensorMeta);
   gst_tensors_info_init (&_outputTensorMeta);
@@ -149,9 +215,28 @@ tensorrt_subplugin::~tensorrt_subplugin ()
   gst_tensors_info_free (&_inputTensorMeta);
   gst_tensors_info_free (&_outputTensorMeta);
 
+  if (_stream != nullptr)
+    cudaStreamDestroy (_stream);
+
   if (_inputBuffer != nullptr)
     cudaFree (_inputBuffer);
 
+  if (_outputBuffer != nullptr)
+    cudaFree (_outputBuffer);
+
+  if (_inputHost != nullptr)
+    cudaFreeHost (_inputHost);
+
+  for (void *data : _outputPool)
+    cudaFreeHost (data);
+  _outputPool.clear ();
+
+  /* the outputs in the device memory are released before closing the instance */
+  for (void *data : _deviceOutputs)
+    cudaFree (data);
+  _deviceOutputs.clear ();
+  _deviceOutputPool.clear ();
+
   if (_uff_path != nullptr)
     g_free (_uff_path);
 }
@@ -201,6 +286,11 @@ tensorrt_subplugin::configure_instance (const GstTensorFilterProperties *prop)
     ml_loge ("Failed to build a TensorRT engine");
     throw std::runtime_error ("Failed to build a TensorRT engine");
   }
+
+  if (allocBuffers () != 0) {
+    ml_loge ("Failed to allocate the buffers for the TensorRT engine");
+    throw std::runtime_error ("Failed to allocate the buffers for the TensorRT engine");
+  }
 }
 
 /**
@@ -211,32 +301,51 @@ tensorrt_subplugin::configure_instance (const GstTensorFilterProperties *prop)
 void
 tensorrt_subplugin::invoke (const GstTensorMemory *input, GstTensorMemory *output)
 {
-  /* If internal _inputBuffer is nullptr, tne allocate GPU memory */
-  if (!_inputBuffer) {
-    if (allocBuffer (&_inputBuffer, input->size) != 0) {
-      ml_loge ("Failed to allocate GPU memory for input");
-      throw std::runtime_error ("Failed to allocate GPU memory for input");
-    }
+  /* SET_DEVICE_MEMORY is applied to this invoke only */
+  bool device_input = _deviceInput;
+  bool device_output = _deviceOutput;
+
+  _deviceInput = _deviceOutput = false;
+
+  if (input->size != _inputSize || output->size != _outputSize) {
+    ml_loge ("Invalid tensor size, input %zu (expected %zu), output %zu (expected %zu)",
+        input->size, _inputSize, output->size, _outputSize);
+    throw std::invalid_argument ("Invalid tensor size");
   }
 
-  /* Copy input data to Cuda memory space */
-  memcpy (_inputBuffer, input->data, input->size);
+  /* Stage the input in page-locked memory, so that the copy runs asynchronously */
+  if (!device_input)
+    memcpy (_inputHost, input->data, input->size);
 
-  /* Allocate output buffer */
-  if (allocBuffer (&output->data, output->size) != 0) {
-    ml_loge ("Failed to allocate GPU memory for output");
-    throw std::runtime_error ("Failed to allocate GPU memory for output");
+  output->data = device_output ? acquireDeviceOutput () : acquireOutput ();
+  if (!output->data) {
+    ml_loge ("Failed to allocate memory for output");
+    throw std::runtime_error ("Failed to allocate memory for output");
   }
 
-  /* Bind the input and execute the network */
-  std::vector<void *> bindings = { _inputBuffer, output->data };
-  if (!_Context->execute (1, bindings.data ())) {
+  /* Upload, execute and download on the stream of this instance, the tensors in the Cuda memory are bound directly */
+  std::vector<void *> bindings = { device_input ? input->data : _inputBuffer,
+    device_output ? output->data : _outputBuffer };
+  if ((!device_input
+          && cudaMemcpyAsync (_inputBuffer, _inputHost, input->size,
+                 cudaMemcpyHostToDevice, _stream) != cudaSuccess)
+      || !_Context->enqueue (1, bindings.data (), _stream, nullptr)
+      || (!device_output
+          && cudaMemcpyAsync (output->data, _outputBuffer, output->size,
+                 cudaMemcpyDeviceToHost, _stream) != cudaSuccess)) {
+    releaseOutput (output->data);
+    output->data = nullptr;
     ml_loge ("Failed to execute the network");
     throw std::runtime_error ("Failed to execute the network");
   }
 
-  /* wait for GPU to finish the inference */
-  cudaDeviceSynchronize ();
+  /* wait for this stream only, the other instances keep running on the GPU */
+  if (cudaStreamSynchronize (_stream) != cudaSuccess) {
+    releaseOutput (output->data);
+    output->data = nullptr;
+    ml_loge ("Failed to synchronize the Cuda stream");
+    throw std::runtime_error ("Failed to synchronize the Cuda stream");
+  }
 }
 
 /**
@@ -273,15 +382,30 @@ tensorrt_subplugin::getModelInfo (
 }
 
 /**
- * @brief Override eventHandler to free Cuda data buffer.
+ * @brief Override eventHandler to return the output buffer to the pool and to keep the tensors in the Cuda memory.
  */
 int
 tensorrt_subplugin::eventHandler (event_ops ops, GstTensorFilterFrameworkEventData &data)
 {
-  if (ops == DESTROY_NOTIFY) {
+  switch (ops) {
+  case DESTROY_NOTIFY:
     if (data.data != nullptr) {
-      cudaFree (data.data);
+      releaseOutput (data.data);
     }
+    break;
+  case GET_DEVICE_MEMORY:
+    data.device_ops = &deviceOps;
+    data.device_input = 1;
+    data.device_output = 1;
+    break;
+  case SET_DEVICE_MEMORY:
+    if (data.device_ops != nullptr && data.device_ops->type != deviceOps.type)
+      return -EINVAL;
+    _deviceInput = (data.device_input != 0);
+    _deviceOutput = (data.device_output != 0);
+    break;
+  default:
+    break;
   }
   return 0;
 }
@@ -294,13 +418,78 @@ tensorrt_subplugin::eventHandler (event_ops ops, GstTensorFilterFrameworkEventDa
 int
 tensorrt_subplugin::loadModel (const GstTensorFilterProperties *prop)
 {
+  std::lock_guard<std::mutex> lock (enginesLock);
+  gchar *key, *cache_dir, *cache_path = nullptr;
+
   UNUSED (prop);
 
-  if (checkUnifiedMemory () != 0) {
-    ml_loge ("Failed to enable unified memory");
+  /* Reuse the engine of the other instance with the same model */
+  key = getEngineKey ();
+  if (key) {
+    auto it = sharedEngines.find (key);
+    if (it != sharedEngines.end ())
+      _Engine = it->second.lock ();
+  }
+
+  if (!_Engine) {
+    auto shared = std::make_shared<SharedEngine> ();
+
+    cache_dir = nnsconf_get_custom_value_string ("tensorrt", "engine_cache_dir");
+    if (key && cache_dir && cache_dir[0] != '\0') {
+      gchar *file_name = g_strdup_printf ("%s.engine", key);
+      cache_path = g_build_filename (cache_dir, file_name, NULL);
+      g_free (file_name);
+    }
+    g_free (cache_dir);
+
+    if (cache_path && loadEngineCache (cache_path, *shared) != 0)
+      ml_logi ("The engine cache %s is not available, build the engine.", cache_path);
+
+    /* Build the engine if it is not cached */
+    if (!shared->engine) {
+      if (buildEngine (*shared) != 0) {
+        g_free (cache_path);
+        g_free (key);
+        return -1;
+      }
+
+      if (cache_path)
+        saveEngineCache (cache_path, *shared);
+    }
+    g_free (cache_path);
+
+    _Engine = shared;
+    if (key) {
+      /* drop the engines released by the closed instances */
+      for (auto it = sharedEngines.begin (); it != sharedEngines.end ();) {
+        if (it->second.expired ())
+          it = sharedEngines.erase (it);
+        else
+          ++it;
+      }
+      sharedEngines[key] = shared;
+    }
+  }
+  g_free (key);
+
+  /* Create ExecutionContext obejct */
+  _Context = makeUnique (_Engine->engine->createExecutionContext ());
+  if (!_Context) {
+    ml_loge ("Failed to create the TensorRT ExecutionContext object");
     return -1;
   }
 
+  return 0;
+}
+
+/**
+ * @brief Build the TensorRT engine from the UFF model file.
+ * @param[out] shared : the engine to be built
+ * @return 0 if successfully built, or -1.
+ */
+int
+tensorrt_subplugin::buildEngine (SharedEngine &shared)
+{
   /* Make builder, network, config, parser object */
   auto builder = makeUnique (nvinfer1::createInferBuilder (gLogger));
   if (!builder) {
@@ -340,63 +529,238 @@ tensorrt_subplugin::loadModel (const GstTensorFilterProperties *prop)
   config->setFlag (nvinfer1::BuilderFlag::kGPU_FALLBACK);
 
   /* Create Engine object */
-  _Engine = makeUnique (builder->buildEngineWithConfig (*network, *config));
-  if (!_Engine) {
+  shared.engine = makeUnique (builder->buildEngineWithConfig (*network, *config));
+  if (!shared.engine) {
     ml_loge ("Failed to create the TensorRT Engine object");
     return -1;
   }
 
-  /* Create ExecutionContext obejct */
-  _Context = makeUnique (_Engine->createExecutionContext ());
-  if (!_Context) {
-    ml_loge ("Failed to create the TensorRT ExecutionContext object");
-    return -1;
+  return 0;
+}
+
+/**
+ * @brief Get the key of the engine to share and cache it.
+ * @return Newly allocated key, nullptr if the key is not available.
+ * @note The key is the hash of the model and its input/output configuration,
+ *       with TensorRT version, GPU SM and precision.
+ */
+gchar *
+tensorrt_subplugin::getEngineKey ()
+{
+  gchar *key;
+  GMappedFile *mapped;
+  GChecksum *checksum;
+  GError *err = nullptr;
+  cudaDeviceProp dev_prop;
+  int device, data_type;
+  const gchar *tensor_name;
+
+  if (cudaGetDevice (&device) != cudaSuccess
+      || cudaGetDeviceProperties (&dev_prop, device) != cudaSuccess) {
+    ml_logw ("Failed to get the GPU properties, the engine is not shared.");
+    return nullptr;
   }
 
-  return 0;
+  mapped = g_mapped_file_new (_uff_path, FALSE, &err);
+  if (!mapped) {
+    ml_logw ("Failed to read the model file %s: %s", _uff_path,
+        err ? err->message : "unknown error");
+    g_clear_error (&err);
+    return nullptr;
+  }
+
+  checksum = g_checksum_new (G_CHECKSUM_SHA256);
+  g_checksum_update (checksum, (const guchar *) g_mapped_file_get_contents (mapped),
+      g_mapped_file_get_length (mapped));
+  g_mapped_file_unref (mapped);
+
+  /* The engine also depends on the registered input and output. */
+  tensor_name = _inputTensorMeta.info[0].name;
+  if (tensor_name)
+    g_checksum_update (checksum, (const guchar *) tensor_name, strlen (tensor_name) + 1);
+  tensor_name = _outputTensorMeta.info[0].name;
+  if (tensor_name)
+    g_checksum_update (checksum, (const guchar *) tensor_name, strlen (tensor_name) + 1);
+  g_checksum_update (checksum, (const guchar *) &_InputDims.nbDims, sizeof (_InputDims.nbDims));
+  g_checksum_update (checksum, (const guchar *) _InputDims.d,
+      sizeof (_InputDims.d[0]) * _InputDims.nbDims);
+  data_type = (int) _DataType;
+  g_checksum_update (checksum, (const guchar *) &data_type, sizeof (data_type));
+
+  key = g_strdup_printf ("%s-trt%d-sm%d%d-%s", g_checksum_get_string (checksum),
+      getInferLibVersion (), dev_prop.major, dev_prop.minor, engine_precision);
+  g_checksum_free (checksum);
+
+  return key;
 }
 
 /**
- * @brief Return whether Unified Memory is supported or not.
- * @return 0 if Unified Memory is supported. non-zero if error.
- * @note After Cuda version 6, logical Unified Memory is supported in programming language level.
- *       However, if the target device is not supported, then cudaMemcpy() internally occurs
- *       and it makes performance degradation.
+ * @brief Deserialize the TensorRT engine from the cache.
+ * @param[in] path : path of the serialized engine
+ * @param[out] shared : the engine to be loaded
+ * @return 0 if successfully loaded, or -1.
  */
 int
-tensorrt_subplugin::checkUnifiedMemory (void)
+tensorrt_subplugin::loadEngineCache (const gchar *path, SharedEngine &shared)
 {
-  int version;
+  GstTensorFilterModelMap *map;
+  const void *blob;
+  size_t size = 0;
+
+  if (!g_file_test (path, G_FILE_TEST_IS_REGULAR))
+    return -1;
 
-  if (cudaRuntimeGetVersion (&version) != cudaSuccess)
+  /* the engine is deserialized right away, read ahead the mapped file */
+  map = gst_tensor_filter_model_map_open (path, GST_TENSOR_FILTER_MODEL_MAP_PRELOAD);
+  if (!map) {
+    ml_logw ("Failed to read the engine cache %s", path);
     return -1;
+  }
+
+  blob = gst_tensor_filter_model_map_get_data (map, &size);
 
-  /* Unified memory requires at least CUDA-6 */
-  if (version < 6000)
+  shared.runtime = makeUnique (nvinfer1::createInferRuntime (gLogger));
+  if (shared.runtime)
+    shared.engine = makeUnique (shared.runtime->deserializeCudaEngine (blob, size, nullptr));
+  gst_tensor_filter_model_map_close (map);
+
+  if (!shared.engine) {
+    ml_logw ("Failed to deserialize the engine cache %s", path);
     return -1;
+  }
 
+  ml_logi ("Loaded the TensorRT engine from the cache %s", path);
   return 0;
 }
 
 /**
- * @brief Allocate a GPU buffer memory
- * @param[out] buffer : pointer to allocated memory
- * @param[in] size : allocation size in bytes
+ * @brief Serialize the TensorRT engine and write it to the cache.
+ * @param[in] path : path of the serialized engine
+ * @param[in] shared : the engine to be serialized
+ */
+void
+tensorrt_subplugin::saveEngineCache (const gchar *path, SharedEngine &shared)
+{
+  gchar *dir;
+  GError *err = nullptr;
+
+  auto serialized = makeUnique (shared.engine->serialize ());
+  if (!serialized) {
+    ml_logw ("Failed to serialize the TensorRT engine");
+    return;
+  }
+
+  dir = g_path_get_dirname (path);
+  if (g_mkdir_with_parents (dir, 0700) != 0) {
+    ml_logw ("Failed to create the engine cache directory %s", dir);
+    g_free (dir);
+    return;
+  }
+  g_free (dir);
+
+  /* The data is written to a temporary file and renamed, so that the other pipelines never read a partial engine. */
+  if (!g_file_set_contents (path, (const gchar *) serialized->data (),
+          (gssize) serialized->size (), &err)) {
+    ml_logw ("Failed to write the engine cache %s: %s", path,
+        err ? err->message : "unknown error");
+    g_clear_error (&err);
+    return;
+  }
+
+  ml_logi ("Saved the TensorRT engine to the cache %s", path);
+}
+
+/**
+ * @brief Allocate the Cuda stream, the device buffers and the page-locked input staging buffer.
  * @return 0 if OK. non-zero if error.
  */
 int
-tensorrt_subplugin::allocBuffer (void **buffer, gsize size)
+tensorrt_subplugin::allocBuffers ()
 {
-  cudaError_t status = cudaMallocManaged (buffer, size);
+  _inputSize = gst_tensor_info_get_size (&_inputTensorMeta.info[0]);
+  _outputSize = gst_tensor_info_get_size (&_outputTensorMeta.info[0]);
 
-  if (status != cudaSuccess) {
+  if (cudaStreamCreateWithFlags (&_stream, cudaStreamNonBlocking) != cudaSuccess) {
+    ml_loge ("Failed to create Cuda stream");
+    _stream = nullptr;
+    return -1;
+  }
+
+  if (cudaMalloc (&_inputBuffer, _inputSize) != cudaSuccess
+      || cudaMalloc (&_outputBuffer, _outputSize) != cudaSuccess) {
     ml_loge ("Failed to allocate Cuda memory");
     return -1;
   }
 
+  if (cudaHostAlloc (&_inputHost, _inputSize, cudaHostAllocWriteCombined) != cudaSuccess) {
+    ml_loge ("Failed to allocate page-locked memory");
+    _inputHost = nullptr;
+    return -1;
+  }
+
   return 0;
 }
 
+/**
+ * @brief Get a page-locked output buffer from the pool, or allocate a new one.
+ * @return The output buffer, nullptr if error.
+ */
+void *
+tensorrt_subplugin::acquireOutput ()
+{
+  void *data = nullptr;
+
+  {
+    std::lock_guard<std::mutex> lock (_outputPoolLock);
+    if (!_outputPool.empty ()) {
+      data = _outputPool.back ();
+      _outputPool.pop_back ();
+    }
+  }
+
+  if (!data && cudaHostAlloc (&data, _outputSize, cudaHostAllocDefault) != cudaSuccess)
+    data = nullptr;
+
+  return data;
+}
+
+/**
+ * @brief Get an output buffer in the Cuda memory from the pool, or allocate a new one.
+ * @return The output buffer, nullptr if error.
+ */
+void *
+tensorrt_subplugin::acquireDeviceOutput ()
+{
+  std::lock_guard<std::mutex> lock (_outputPoolLock);
+  void *data = nullptr;
+
+  if (!_deviceOutputPool.empty ()) {
+    data = _deviceOutputPool.back ();
+    _deviceOutputPool.pop_back ();
+    return data;
+  }
+
+  if (cudaMalloc (&data, _outputSize) != cudaSuccess)
+    return nullptr;
+
+  _deviceOutputs.insert (data);
+  return data;
+}
+
+/**
+ * @brief Return the output buffer to the pool.
+ */
+void
+tensorrt_subplugin::releaseOutput (void *data)
+{
+  std::lock_guard<std::mutex> lock (_outputPoolLock);
+
+  if (_deviceOutputs.count (data) > 0)
+    _deviceOutputPool.push_back (data);
+  else
+    _outputPool.push_back (data);
+}
+
 /**
  * @brief Set the data type of the the TensorRT.
  * @param[in] t : data type of NNStreamer
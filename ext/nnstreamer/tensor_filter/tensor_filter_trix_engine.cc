@@ -10,6 +10,12 @@
  * @see http://github.com/nnstreamer/nnstreamer
  * @author Dongju Chae <dongju.chae@samsung.com>
  * @bug No known bugs except for NYI items
+ *
+ * The instances of the same model (e.g., the workers of tensor_filter) share
+ * the device and the registered model, and each invoke submits its own request,
+ * so that the requests of the instances are queued in the device.
+ * The input tensors in DMA-BUF (e.g., from camera) are given to the device
+ * with the fd, without mapping them in host memory.
  */
 
 #include <tensor_filter_trix_engine.hh>
@@ -25,6 +31,8 @@ TensorFilterTRIxEngine *TensorFilterTRIxEngine::registered = nullptr;
 const char *TensorFilterTRIxEngine::name = "trix-engine";
 const accl_hw TensorFilterTRIxEngine::hw_list[] = {ACCL_NPU_SR};
 const int TensorFilterTRIxEngine::num_hw = 1;
+std::map<std::string, TensorFilterTRIxEngine::shared_model> TensorFilterTRIxEngine::shared_models;
+std::mutex TensorFilterTRIxEngine::shared_models_lock;
 
 /**
  * @brief Construct a new TRIx-Engine subplugin instance
@@ -36,7 +44,8 @@ TensorFilterTRIxEngine::TensorFilterTRIxEngine ()
       model_meta_ (nullptr),
       model_id_ (0),
       trix_in_info_ (),
-      trix_out_info_ () {
+      trix_out_info_ (),
+      dmabuf_ (nullptr) {
   gst_tensors_info_init (addressof (nns_in_info_));
   gst_tensors_info_init (addressof (nns_out_info_));
 }
@@ -45,16 +54,84 @@ TensorFilterTRIxEngine::TensorFilterTRIxEngine ()
  * @brief Destruct the TRIx-Engine subplugin instance
  */
 TensorFilterTRIxEngine::~TensorFilterTRIxEngine () {
+  release_model ();
+
   g_free (model_path_);
   g_free (model_meta_);
 
   gst_tensors_info_free (std::addressof (nns_in_info_));
   gst_tensors_info_free (std::addressof (nns_out_info_));
+}
+
+/**
+ * @brief Get the device and register the model, or share them with the other instance of the same model
+ */
+void
+TensorFilterTRIxEngine::acquire_model (const GstTensorFilterProperties *prop) {
+  std::lock_guard<std::mutex> lock (shared_models_lock);
+  auto it = shared_models.find (model_path_);
+
+  if (it != shared_models.end ()) {
+    it->second.ref_count++;
+    dev_ = it->second.dev;
+    model_id_ = it->second.model_id;
+    return;
+  }
+
+  npudev_h dev = nullptr;
+  uint32_t model_id = 0;
+  int status = -ENOENT;
+  for (int h = 0; h < prop->num_hw; h++) {
+    /* TRIV2 alias for now */
+    if (prop->hw_list[h] == ACCL_NPU_SR) {
+      status = getNPUdeviceByTypeAny (&dev, NPUCOND_TRIV2_CONN_SOCIP, 2);
+      if (status == 0)
+        break;
+    }
+  }
+
+  if (status != 0) {
+    nns_loge ("Unable to find a proper NPU device\n");
+    throw runtime_error ("Unable to find a proper NPU device");
+  }
+
+  generic_buffer model_file;
+  model_file.filepath = model_path_;
+  model_file.size = model_meta_->size;
+  model_file.type = BUFFER_FILE;
+
+  if (registerNPUmodel (dev, &model_file, &model_id) != 0) {
+    putNPUdevice (dev);
+    nns_loge ("Unable to register the model\n");
+    throw runtime_error ("Unable to register the model");
+  }
+
+  shared_models[model_path_] = { dev, model_id, 1 };
+  dev_ = dev;
+  model_id_ = model_id;
+}
+
+/**
+ * @brief Release the shared device and model, the model is unregistered when the last instance is closed
+ */
+void
+TensorFilterTRIxEngine::release_model () {
+  if (dev_ == nullptr)
+    return;
+
+  std::lock_guard<std::mutex> lock (shared_models_lock);
+  auto it = shared_models.find (model_path_);
 
-  if (dev_ != nullptr) {
-    unregisterNPUmodel_all (dev_);
-    putNPUdevice (dev_);
+  if (it != shared_models.end () && it->second.dev == dev_) {
+    if (--it->second.ref_count == 0) {
+      unregisterNPUmodel_all (dev_);
+      putNPUdevice (dev_);
+      shared_models.erase (it);
+    }
   }
+
+  dev_ = nullptr;
+  model_id_ = 0;
 }
 
 /**
@@ -77,6 +154,11 @@ TensorFilterTRIxEngine::configure_instance (const GstTensorFilterProperties *pro
     throw invalid_argument ("Unable to find a model filepath given");
   }
 
+  /* reconfigure with the new model */
+  release_model ();
+  g_free (model_path_);
+  g_free (model_meta_);
+
   model_path_ = g_strdup (prop->model_files[0]);
   model_meta_ = getNPUmodel_metadata (model_path_, false);
   if (model_meta_ == nullptr) {
@@ -84,30 +166,7 @@ TensorFilterTRIxEngine::configure_instance (const GstTensorFilterProperties *pro
     throw runtime_error ("Unable to extract the model metadata");
   }
 
-  int status = -ENOENT;
-  for (int h = 0; h < prop->num_hw; h++) {
-    /* TRIV2 alias for now */
-    if (prop->hw_list[h] == ACCL_NPU_SR) {
-      status = getNPUdeviceByTypeAny (&dev_, NPUCOND_TRIV2_CONN_SOCIP, 2);
-      if (status == 0)
-        break;
-    }
-  }
-
-  if (status != 0) {
-    nns_loge ("Unable to find a proper NPU device\n");
-    throw runtime_error ("Unable to find a proper NPU device");
-  }
-
-  generic_buffer model_file;
-  model_file.filepath = model_path_;
-  model_file.size = model_meta_->size;
-  model_file.type = BUFFER_FILE;
-
-  if (registerNPUmodel (dev_, &model_file, &model_id_) != 0) {
-    nns_loge ("Unable to register the model\n");
-    throw runtime_error ("Unable to register the model");
-  }
+  acquire_model (prop);
 
   rank_limit = MIN (MAX_RANK, NNS_TENSOR_RANK_LIMIT);
 
@@ -219,13 +278,23 @@ TensorFilterTRIxEngine::set_data_info (const GstTensorFilterProperties *prop) {
  * @brief Feed the tensor data to input buffers before invoke()
  */
 void
-TensorFilterTRIxEngine::feed_input_data (const GstTensorMemory *input, input_buffers *input_buf) {
+TensorFilterTRIxEngine::feed_input_data (
+    const GstTensorMemory *input, const GstTensorDmaBuf *dmabuf, input_buffers *input_buf) {
   input_buf->num_buffers = model_meta_->input_seg_num;
 
   for (uint32_t idx = 0; idx < input_buf->num_buffers; ++idx) {
-    input_buf->bufs[idx].addr = input[idx].data;
-    input_buf->bufs[idx].size = input[idx].size;
-    input_buf->bufs[idx].type = BUFFER_MAPPED;
+    if (dmabuf) {
+      /* the device imports the fd without the copy */
+      input_buf->bufs[idx].addr = nullptr;
+      input_buf->bufs[idx].dmabuf = dmabuf[idx].fd;
+      input_buf->bufs[idx].offset = dmabuf[idx].offset;
+      input_buf->bufs[idx].size = dmabuf[idx].size;
+      input_buf->bufs[idx].type = BUFFER_DMABUF;
+    } else {
+      input_buf->bufs[idx].addr = input[idx].data;
+      input_buf->bufs[idx].size = input[idx].size;
+      input_buf->bufs[idx].type = BUFFER_MAPPED;
+    }
   }
 }
 
@@ -251,37 +320,42 @@ void
 TensorFilterTRIxEngine::invoke (const GstTensorMemory *input, GstTensorMemory *output) {
   int req_id;
   int status;
+  /* the DMA-BUF is given for this invoke only */
+  const GstTensorDmaBuf *dmabuf = dmabuf_;
+
+  dmabuf_ = nullptr;
 
   status = createNPU_request (dev_, model_id_, &req_id);
   if (status != 0) {
     nns_loge ("Unable to create NPU request with model id (%u): %d", model_id_, status);
-    return;
+    throw runtime_error ("Unable to create NPU request");
   }
 
   input_buffers input_buf;
   output_buffers output_buf;
   /* feed input data to npu-engine */
-  feed_input_data (input, &input_buf);
+  feed_input_data (input, dmabuf, &input_buf);
 
   status =
       setNPU_requestData (dev_, req_id, &input_buf, &trix_in_info_, &output_buf, &trix_out_info_);
   if (status != 0) {
     nns_loge ("Unable to create NPU request for model %u", model_id_);
-    return;
+    removeNPU_request (dev_, req_id);
+    throw runtime_error ("Unable to set the data of NPU request");
   }
 
   status = submitNPU_request (dev_, req_id);
   if (status != 0) {
     nns_loge ("Unable to submit NPU request with id (%u): %d", req_id, status);
-    return;
+    removeNPU_request (dev_, req_id);
+    throw runtime_error ("Unable to submit NPU request");
   }
   /* extract output data from npu-engine */
   extract_output_data (&output_buf, output);
 
   status = removeNPU_request (dev_, req_id);
   if (status != 0) {
-    nns_loge ("Unable to remove NPU request with id (%u): %d", req_id, status);
-    return;
+    nns_logw ("Unable to remove NPU request with id (%u): %d", req_id, status);
   }
 }
 
@@ -319,8 +393,17 @@ TensorFilterTRIxEngine::getModelInfo (model_info_ops ops, GstTensorsInfo &in_inf
  */
 int
 TensorFilterTRIxEngine::eventHandler (event_ops ops, GstTensorFilterFrameworkEventData &data) {
-  UNUSED (ops);
-  UNUSED (data);
+  switch (ops) {
+    case GET_DEVICE_MEMORY:
+      /* the device imports the input tensors in DMA-BUF */
+      data.dmabuf_input = 1;
+      return 0;
+    case SET_DEVICE_MEMORY:
+      dmabuf_ = data.dmabuf_input ? data.dmabuf : nullptr;
+      return 0;
+    default:
+      break;
+  }
   return -ENOENT;
 }
 
@@ -15,6 +15,10 @@
 #ifndef __TENSOR_FILTER_SUBPLUGIN_TRIxEngine_H__
 #define __TENSOR_FILTER_SUBPLUGIN_TRIxEngine_H__
 
+#include <map>
+#include <mutex>
+#include <string>
+
 /* npu-engine headers */
 #include <npubinfmt.h>
 #include <libnpuhost.h>
@@ -56,8 +60,22 @@ class TensorFilterTRIxEngine : public tensor_filter_subplugin {
   static const accl_hw hw_list[];
   static const int num_hw;
 
+  /**
+   * @brief The device and the model registered on it, shared by the instances of the same model.
+   */
+  typedef struct {
+    npudev_h dev;
+    uint32_t model_id;
+    unsigned int ref_count;
+  } shared_model;
+
+  static std::map<std::string, shared_model> shared_models;
+  static std::mutex shared_models_lock;
+
+  void acquire_model (const GstTensorFilterProperties *prop);
+  void release_model ();
   void set_data_info (const GstTensorFilterProperties *prop);
-  void feed_input_data (const GstTensorMemory *input, input_buffers *input_buf);
+  void feed_input_data (const GstTensorMemory *input, const GstTensorDmaBuf *dmabuf, input_buffers *input_buf);
   void extract_output_data (const output_buffers *output_buf, GstTensorMemory *output);
 
   /* trix-engine vars */
@@ -68,6 +86,7 @@ class TensorFilterTRIxEngine : public tensor_filter_subplugin {
   uint32_t model_id_;
   tensors_data_info trix_in_info_;
   tensors_data_info trix_out_info_;
+  const GstTensorDmaBuf *dmabuf_; /**< DMA-BUF of the input tensors of the next invoke (SET_DEVICE_MEMORY) */
 
   /* nnstreamer vars */
   GstTensorsInfo nns_in_info_;
@@ -10,6 +10,10 @@
  * This is the per-NN-framework plugin (TVM) for tensor_filter.
  *
  * @note    Setting custom property `num_input_tensors` is recommended
+ *
+ * The input and output tensors are bound to the memory of nnstreamer with
+ * `set_input_zero_copy` and `set_output_zero_copy`, and the tensor is copied
+ * only if the runtime rejects the memory (e.g., not aligned).
  */
 
 #include <glib.h>
@@ -49,16 +53,26 @@ class tvm_subplugin final : public tensor_filter_subplugin
   GstTensorsInfo outputInfo;
 
   DLContext device;
+  int num_threads;
   tvm::runtime::Module mod_factory;
   tvm::runtime::Module gmod;
+  tvm::runtime::PackedFunc func_set_input;
+  tvm::runtime::PackedFunc func_set_input_zero_copy;
+  tvm::runtime::PackedFunc func_set_output_zero_copy;
+  tvm::runtime::PackedFunc func_get_output;
+  tvm::runtime::PackedFunc func_run;
   std::vector<DLTensor> input_tensor_list;
   std::vector<DLTensor> output_tensor_list;
-  bool zero_copy_enabled;
+  std::vector<bool> input_zero_copy; /**< false if the input is copied with set_input */
+  std::vector<bool> output_zero_copy; /**< false if the output is copied with get_output */
+  bool tensors_bound; /**< true if the tensors are bound in the previous invoke */
 
   static const char *name;
   static const accl_hw hw_list[];
+  static const gchar *tvm_accl_support[];
   static tvm_subplugin *registeredRepresentation;
 
+  void parse_accelerator (const char *accelerators);
   bool parse_custom_prop (const char *custom_prop);
   bool convert_dtype (tensor_type &nns_type, const DLDataType &dtype);
   void cleanup () noexcept;
@@ -80,14 +94,15 @@ class tvm_subplugin final : public tensor_filter_subplugin
 
 const char *tvm_subplugin::name = "tvm";
 const accl_hw tvm_subplugin::hw_list[] = { ACCL_CPU, ACCL_GPU };
+const gchar *tvm_subplugin::tvm_accl_support[] = { ACCL_CPU_STR, ACCL_GPU_STR, NULL };
 
 /**
  * @brief Construct a new tvm subplugin::tvm subplugin object
  */
 tvm_subplugin::tvm_subplugin ()
     : tensor_filter_subplugin (), empty_model (true), model_path (nullptr),
-      device (DLContext{ kDLCPU, 0 }), mod_factory (nullptr), gmod (nullptr),
-      zero_copy_enabled (true)
+      device (DLContext{ kDLCPU, 0 }), num_threads (0), mod_factory (nullptr),
+      gmod (nullptr), tensors_bound (false)
 {
   gst_tensors_info_init (std::addressof (inputInfo));
   gst_tensors_info_init (std::addressof (outputInfo));
@@ -105,6 +120,14 @@ tvm_subplugin::cleanup () noexcept
 
   input_tensor_list.clear ();
   output_tensor_list.clear ();
+  input_zero_copy.clear ();
+  output_zero_copy.clear ();
+  func_set_input = nullptr;
+  func_set_input_zero_copy = nullptr;
+  func_set_output_zero_copy = nullptr;
+  func_get_output = nullptr;
+  func_run = nullptr;
+  tensors_bound = false;
   gst_tensors_info_free (std::addressof (inputInfo));
   gst_tensors_info_free (std::addressof (outputInfo));
 
@@ -129,6 +152,22 @@ tvm_subplugin::getEmptyInstance ()
   return *(new tvm_subplugin ());
 }
 
+/**
+ * @brief Internal method to set the device from the accelerator property
+ * @param accelerators Given c_str value of 'accelerator' property
+ * @note The custom property `device` overrides the accelerator.
+ */
+void
+tvm_subplugin::parse_accelerator (const char *accelerators)
+{
+  accl_hw accelerator = parse_accl_hw (accelerators, tvm_accl_support, NULL, NULL);
+
+  if (accelerator == ACCL_GPU)
+    device = DLContext{ kDLGPU, 0 };
+  else
+    device = DLContext{ kDLCPU, 0 };
+}
+
 /**
  * @brief Internal method to parse custom properties
  * @param custom_prop Given c_str value of 'custom' property,
@@ -158,6 +197,10 @@ tvm_subplugin::parse_custom_prop (const char *custom_prop)
           device = DLContext{ kDLCPU, 0 };
         } else if (g_ascii_strcasecmp (option[1], "GPU") == 0) {
           device = DLContext{ kDLGPU, 0 };
+        } else if (g_ascii_strcasecmp (option[1], "OpenCL") == 0) {
+          device = DLContext{ kDLOpenCL, 0 };
+        } else if (g_ascii_strcasecmp (option[1], "Vulkan") == 0) {
+          device = DLContext{ kDLVulkan, 0 };
         } else {
           nns_loge ("Unknown device (%s).", option[1]);
           invalid_option = true;
@@ -171,6 +214,13 @@ tvm_subplugin::parse_custom_prop (const char *custom_prop)
           invalid_option = true;
         } else
           num_input_set = true;
+      } else if (g_ascii_strcasecmp (option[0], "num_threads") == 0) {
+        num_threads = (int) g_ascii_strtoll (option[1], NULL, 10);
+
+        if (num_threads <= 0) {
+          nns_loge ("num_threads must be greater than 0");
+          invalid_option = true;
+        }
       } else {
         nns_logw ("Unknown option (%s).", options[op]);
       }
@@ -198,6 +248,8 @@ tvm_subplugin::configure_instance (const GstTensorFilterProperties *prop)
 {
   unsigned int i;
   int idx;
+
+  parse_accelerator (prop->accl_str);
   if (!parse_custom_prop (prop->custom_properties)) {
     nns_loge ("Failed to parse custom property.");
     cleanup ();
@@ -220,6 +272,17 @@ tvm_subplugin::configure_instance (const GstTensorFilterProperties *prop)
     throw std::invalid_argument (err_msg);
   }
 
+  if (num_threads > 0) {
+    const tvm::runtime::PackedFunc *config_threadpool
+        = tvm::runtime::Registry::Get ("runtime.config_threadpool");
+
+    /* affinity mode 1 (kBig) is the default of the runtime */
+    if (config_threadpool != nullptr)
+      (*config_threadpool) (1, num_threads);
+    else
+      nns_logw ("Cannot set the number of threads, `runtime.config_threadpool` is not registered.");
+  }
+
   /* read model */
   model_path = g_strdup (prop->model_files[0]);
   mod_factory = tvm::runtime::Module::LoadFromFile (model_path, "so");
@@ -245,10 +308,27 @@ tvm_subplugin::configure_instance (const GstTensorFilterProperties *prop)
     throw std::invalid_argument ("Packed function `get_output` not defined in model");
   }
 
+  /* find the packed functions once, not in each invoke */
+  func_set_input_zero_copy = gmod.GetFunction ("set_input_zero_copy");
+  func_set_input = gmod.GetFunction ("set_input");
+  if (func_set_input == nullptr) {
+    cleanup ();
+    throw std::invalid_argument ("Packed function `set_input` not defined in model");
+  }
+  func_get_output = getOutput;
+  func_run = gmod.GetFunction ("run");
+  if (func_run == nullptr) {
+    cleanup ();
+    throw std::invalid_argument ("Packed function `run` not defined in model");
+  }
+  /* set_output_zero_copy is not available in old versions of the runtime */
+  func_set_output_zero_copy = gmod.GetFunction ("set_output_zero_copy");
+
   for (i = 0; i < inputInfo.num_tensors; ++i) {
     arr = getInput (i);
     dt = arr.operator-> ();
     input_tensor_list.push_back (*dt);
+    input_zero_copy.push_back (func_set_input_zero_copy != nullptr);
 
     if (!convert_dtype (inputInfo.info[i].type, dt->dtype)) {
       cleanup ();
@@ -266,6 +346,7 @@ tvm_subplugin::configure_instance (const GstTensorFilterProperties *prop)
     arr = getOutput (i);
     dt = arr.operator-> ();
     output_tensor_list.push_back (*dt);
+    output_zero_copy.push_back (func_set_output_zero_copy != nullptr);
 
     if (!convert_dtype (outputInfo.info[i].type, dt->dtype)) {
       cleanup ();
@@ -353,51 +434,52 @@ tvm_subplugin::invoke (const GstTensorMemory *input, GstTensorMemory *output)
   assert (input != NULL && output != NULL);
 
   unsigned int i;
-  tvm::runtime::NDArray tensor;
-
-  /* input data is aligned */
-  const tvm::runtime::PackedFunc &set_input_zero_copy = gmod.GetFunction ("set_input_zero_copy");
-  if (set_input_zero_copy == nullptr) {
-    cleanup ();
-    throw std::runtime_error ("Packed function `set_input_zero_copy` not defined in model");
-  }
-  const tvm::runtime::PackedFunc &set_input = gmod.GetFunction ("set_input");
-  if (set_input == nullptr) {
-    cleanup ();
-    throw std::runtime_error ("Packed function `set_input` not defined in model");
-  }
-  const tvm::runtime::PackedFunc &get_output = gmod.GetFunction ("get_output");
-  if (get_output == nullptr) {
-    cleanup ();
-    throw std::runtime_error ("Packed function `get_output` not defined in model");
-  }
-  const tvm::runtime::PackedFunc &run = gmod.GetFunction ("run");
-  if (run == nullptr) {
-    cleanup ();
-    throw std::runtime_error ("Packed function `run` not defined in model");
-  }
 
+  /**
+   * Bind the memory of the tensors to the runtime.
+   * The zero-copy binding is disabled per tensor if the runtime rejects it in the first invoke.
+   * After that, the runtime keeps pointing to the memory of the previous buffer,
+   * so the invoke fails if the memory cannot be bound.
+   */
   for (i = 0; i < inputInfo.num_tensors; ++i) {
     input_tensor_list[i].data = input[i].data;
 
-    if (zero_copy_enabled) {
+    if (input_zero_copy[i]) {
       try {
-        set_input_zero_copy (i, &input_tensor_list[i]);
+        func_set_input_zero_copy (i, &input_tensor_list[i]);
+        continue;
       } catch (const std::runtime_error &e) {
-        nns_logw ("Input data is not aligned, which results in memory copy.");
-        zero_copy_enabled = false;
-        set_input (i, &input_tensor_list[i]);
+        if (tensors_bound)
+          throw std::runtime_error ("Failed to bind the input memory to the runtime.");
+        nns_logw ("Input %u is not aligned, which results in memory copy: %s", i, e.what ());
+        input_zero_copy[i] = false;
       }
-    } else {
-      set_input (i, &input_tensor_list[i]);
     }
-  }
 
-  run ();
+    func_set_input (i, &input_tensor_list[i]);
+  }
 
   for (i = 0; i < outputInfo.num_tensors; ++i) {
     output_tensor_list[i].data = output[i].data;
-    get_output (i, &output_tensor_list[i]);
+
+    if (output_zero_copy[i]) {
+      try {
+        func_set_output_zero_copy (i, &output_tensor_list[i]);
+      } catch (const std::runtime_error &e) {
+        if (tensors_bound)
+          throw std::runtime_error ("Failed to bind the output memory to the runtime.");
+        nns_logw ("Output %u cannot be bound, which results in memory copy: %s", i, e.what ());
+        output_zero_copy[i] = false;
+      }
+    }
+  }
+
+  func_run ();
+  tensors_bound = true;
+
+  for (i = 0; i < outputInfo.num_tensors; ++i) {
+    if (!output_zero_copy[i])
+      func_get_output (i, &output_tensor_list[i]);
   }
 }
 
@@ -453,8 +535,9 @@ tvm_subplugin::init_filter_tvm (void)
   registeredRepresentation
       = tensor_filter_subplugin::register_subplugin<tvm_subplugin> ();
   nnstreamer_filter_set_custom_property_desc (name, "device",
-      "Device type for the model (`CPU`, `GPU`)", "num_input_tensors",
-      "Number of input tensors", NULL);
+      "Device type for the model (`CPU`, `GPU`, `OpenCL`, `Vulkan`), overrides the accelerator property",
+      "num_input_tensors", "Number of input tensors", "num_threads",
+      "Number of threads of the runtime thread pool", NULL);
 }
 
 /**
@@ -469,6 +469,10 @@ vivante_invoke (const GstTensorFilterProperties * prop,
    /** Copy an input buffer to an input tensor */
     status = call (result_vsi_nn_CopyDataToTensor, VSI_FAILURE, pdata->graph,
         tensor, input[i].data);
+    if (status != VSI_SUCCESS) {
+      g_printerr ("Failed to copy the input tensor %u\n", i);
+      return -EINVAL;
+    }
   }
 #endif
 
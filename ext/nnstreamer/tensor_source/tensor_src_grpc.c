@@ -170,6 +170,60 @@ gst_tensor_src_grpc_class_init (GstTensorSrcGRPCClass * klass)
           0, G_MAXUSHORT, DEFAULT_PROP_PORT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_NUM_CQS,
+      g_param_spec_uint ("num-cqs", "Number of completion queues",
+          "The number of completion queues of the server, each is polled by "
+          "its own thread (non-blocking). A client stream is served by "
+          "a single queue, and the streams are spread to the queues",
+          1, MAX_PROP_NUM_CQS, DEFAULT_PROP_NUM_CQS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_BIDIRECTIONAL,
+      g_param_spec_boolean ("bidirectional", "Bidirectional",
+          "Stream the requests and responses in a single RPC (protobuf). "
+          "The tensor_src_grpc and tensor_sink_grpc of the same host and port "
+          "share the stream, and the request is given with the query meta",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_MAX_INFLIGHT,
+      g_param_spec_uint ("max-inflight", "Max in-flight requests",
+          "The max number of requests waiting for the responses in the "
+          "bidirectional client (0 for unlimited)",
+          0, G_MAXUINT, DEFAULT_PROP_MAX_INFLIGHT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_MAX_MESSAGE_SIZE,
+      g_param_spec_int ("max-message-size", "Max message size",
+          "The max size of a message to send and receive in bytes "
+          "(0 for gRPC default, -1 for unlimited)",
+          -1, G_MAXINT, DEFAULT_PROP_MAX_MESSAGE_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_KEEPALIVE_TIME,
+      g_param_spec_uint ("keepalive-time", "Keepalive time",
+          "The interval of keepalive pings in milliseconds (0 to disable)",
+          0, G_MAXINT, DEFAULT_PROP_KEEPALIVE_TIME,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_KEEPALIVE_TIMEOUT,
+      g_param_spec_uint ("keepalive-timeout", "Keepalive timeout",
+          "The time to wait for the keepalive ping ack in milliseconds",
+          0, G_MAXINT, DEFAULT_PROP_KEEPALIVE_TIMEOUT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_COMPRESSION,
+      g_param_spec_string ("compression", "Compression",
+          "The compression of the channel (none, deflate or gzip)",
+          DEFAULT_PROP_COMPRESSION, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_NUM_CHANNELS,
+      g_param_spec_uint ("num-channels", "Number of channels",
+          "The number of channels (HTTP/2 connections) of the blocking client. "
+          "Each channel has its own stream, and the buffers are spread to "
+          "the streams (the order between the streams is not kept)",
+          1, MAX_PROP_NUM_CHANNELS, DEFAULT_PROP_NUM_CHANNELS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   g_object_class_install_property (gobject_class, PROP_OUT,
       g_param_spec_uint ("out", "Out",
           "The number of output buffers generated",
@@ -305,6 +359,14 @@ grpc_config_init (GstTensorSrcGRPC * self)
   grpc->config.dir = GRPC_DIRECTION_BUFFER_TO_TENSORS;
   grpc->config.port = DEFAULT_PROP_PORT;
   grpc->config.host = g_strdup (DEFAULT_PROP_HOST);
+  grpc->config.num_cqs = DEFAULT_PROP_NUM_CQS;
+  grpc->config.bidirectional = FALSE;
+  grpc->config.max_inflight = DEFAULT_PROP_MAX_INFLIGHT;
+  grpc->config.max_message_size = DEFAULT_PROP_MAX_MESSAGE_SIZE;
+  grpc->config.keepalive_time = DEFAULT_PROP_KEEPALIVE_TIME;
+  grpc->config.keepalive_timeout = DEFAULT_PROP_KEEPALIVE_TIMEOUT;
+  grpc_get_compression (DEFAULT_PROP_COMPRESSION, &grpc->config.compression);
+  grpc->config.num_channels = DEFAULT_PROP_NUM_CHANNELS;
   grpc->config.cb = _grpc_callback;
   grpc->config.cb_data = (void *) self;
   grpc->config.config = &self->config;
@@ -357,7 +419,7 @@ gst_tensor_src_grpc_start (GstBaseSrc * src)
   gboolean ret;
 
   if (grpc->instance)
-    grpc_destroy (grpc->instance);
+    grpc_release (grpc->instance, &grpc->config);
 
   grpc->instance = grpc_new (&grpc->config);
   if (!grpc->instance)
@@ -392,7 +454,7 @@ gst_tensor_src_grpc_stop (GstBaseSrc * src)
   _send_eos_event (self);
 
   if (grpc->instance)
-    grpc_destroy (grpc->instance);
+    grpc_release (grpc->instance, &grpc->config);
   grpc->instance = NULL;
 
   GST_OBJECT_FLAG_UNSET (self, GST_TENSOR_SRC_GRPC_STARTED);
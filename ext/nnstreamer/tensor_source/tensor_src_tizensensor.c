@@ -48,6 +48,18 @@
  *
  * If sequence = -1 (default), we use "default sensor".
  *
+ * With batch-size > 1, the given number of sensor events is accumulated
+ * into a buffer, instead of producing a small buffer for each event.
+ * The buffer consists of two tensors: the values of the events
+ * (value-count:batch-size) and the timestamps of the events in
+ * microseconds (uint64, batch-size). The framerate is the rate of the
+ * sensor events, and the buffers are produced at framerate / batch-size.
+ * batch-latency is given to the sensor listener as the max batch latency,
+ * so that the sensor framework may deliver the events by bulk.
+ * |[
+ * gst-launch -v -m tensor_src_tizensensor type=ACCELEROMETER framerate=200/1 batch-size=50 ! fakesink
+ * ]|
+ *
  * @todo More manual entries coming.
  *
  * @todo Allow to use sensor URIs to designate a sensor
@@ -117,6 +129,8 @@ enum
   PROP_SEQUENCE,
   PROP_MODE,
   PROP_FREQ,
+  PROP_BATCH_SIZE,
+  PROP_BATCH_LATENCY,
 };
 
 /**
@@ -145,6 +159,21 @@ enum
  */
 #define DEFAULT_PROP_SEQUENCE -1
 
+/**
+ * @brief Default number of events in a buffer (no batch)
+ */
+#define DEFAULT_PROP_BATCH_SIZE 1
+
+/**
+ * @brief Max number of events in a buffer
+ */
+#define MAX_BATCH_SIZE 4096
+
+/**
+ * @brief Default max batch latency of the sensor listener (use the default of sensor framework)
+ */
+#define DEFAULT_PROP_BATCH_LATENCY 0
+
 #define _LOCK(obj) g_mutex_lock (&(obj)->lock)
 #define _UNLOCK(obj) g_mutex_unlock (&(obj)->lock)
 
@@ -167,6 +196,8 @@ static GstCaps *gst_tensor_src_tizensensor_get_caps (GstBaseSrc * src,
 static GstCaps *gst_tensor_src_tizensensor_fixate (GstBaseSrc * src,
     GstCaps * caps);
 static gboolean gst_tensor_src_tizensensor_is_seekable (GstBaseSrc * src);
+static gboolean gst_tensor_src_tizensensor_unlock (GstBaseSrc * src);
+static gboolean gst_tensor_src_tizensensor_unlock_stop (GstBaseSrc * src);
 static gboolean gst_tensor_src_tizensensor_query (GstBaseSrc * src, GstQuery * query);
 static GstFlowReturn gst_tensor_src_tizensensor_create (GstBaseSrc * src,
     guint64 offset, guint size, GstBuffer ** buf);
@@ -398,11 +429,23 @@ gst_tensor_src_tizensensor_class_init (GstTensorSrcTIZENSENSORClass * klass)
           0, 1, G_MAXINT, 1,
           DEFAULT_PROP_FREQ_N, DEFAULT_PROP_FREQ_D,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_BATCH_SIZE,
+      g_param_spec_uint ("batch-size", "Batch size",
+          "The number of sensor events in an output buffer. If it is larger "
+          "than 1, the buffer has the values and timestamps of the events",
+          1, MAX_BATCH_SIZE, DEFAULT_PROP_BATCH_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_BATCH_LATENCY,
+      g_param_spec_uint ("batch-latency", "Batch latency",
+          "Max batch latency (ms) of the sensor listener, effective only if "
+          "batch-size is larger than 1. 0 to use the default of the sensor",
+          0, G_MAXUINT, DEFAULT_PROP_BATCH_LATENCY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   /* pad template */
   /** @todo Narrow down allowed tensors/tensor. */
   pad_caps = gst_caps_from_string (GST_TENSOR_CAP_DEFAULT "; "
-      GST_TENSORS_CAP_WITH_NUM ("1"));
+      GST_TENSORS_CAP_WITH_NUM ("(int) [ 1, 2 ]"));
   pad_template = gst_pad_template_new ("src", GST_PAD_SRC, GST_PAD_ALWAYS,
       pad_caps);
   gst_element_class_add_pad_template (gstelement_class, pad_template);
@@ -425,6 +468,10 @@ gst_tensor_src_tizensensor_class_init (GstTensorSrcTIZENSENSORClass * klass)
       GST_DEBUG_FUNCPTR (gst_tensor_src_tizensensor_start);
   gstbasesrc_class->stop = GST_DEBUG_FUNCPTR (gst_tensor_src_tizensensor_stop);
   gstbasesrc_class->query = GST_DEBUG_FUNCPTR (gst_tensor_src_tizensensor_query);
+  gstbasesrc_class->unlock =
+      GST_DEBUG_FUNCPTR (gst_tensor_src_tizensensor_unlock);
+  gstbasesrc_class->unlock_stop =
+      GST_DEBUG_FUNCPTR (gst_tensor_src_tizensensor_unlock_stop);
   gstbasesrc_class->create =
       GST_DEBUG_FUNCPTR (gst_tensor_src_tizensensor_create);
   gstbasesrc_class->fill = GST_DEBUG_FUNCPTR (gst_tensor_src_tizensensor_fill);
@@ -445,6 +492,11 @@ gst_tensor_src_tizensensor_init (GstTensorSrcTIZENSENSOR * self)
   self->freq_n = DEFAULT_PROP_FREQ_N;
   self->freq_d = DEFAULT_PROP_FREQ_D;
   self->type = SENSOR_ALL;
+  self->batch_size = DEFAULT_PROP_BATCH_SIZE;
+  self->batch_latency = DEFAULT_PROP_BATCH_LATENCY;
+  self->batch_events = g_array_new (FALSE, FALSE, sizeof (sensor_event_s));
+  self->last_timestamp = 0;
+  self->flushing = FALSE;
 
   g_mutex_init (&self->lock);
 
@@ -509,6 +561,9 @@ _ts_clean_up_handle (GstTensorSrcTIZENSENSOR * self)
   self->listener = NULL;
   self->sensor = NULL;
 
+  g_array_set_size (self->batch_events, 0);
+  self->last_timestamp = 0;
+
   self->configured = FALSE;
   return 0;
 }
@@ -560,6 +615,31 @@ _ts_get_interval_ms (GstTensorSrcTIZENSENSOR * self)
   return gst_util_uint64_scale_int ((guint64) self->freq_d, 1000, self->freq_n);
 }
 
+/**
+ * @brief Get the information of the output tensors.
+ * @details With batch, the values of the events are stacked in the 2nd
+ *          dimension and the timestamps are given as the 2nd tensor.
+ */
+static void
+_ts_get_tensors_info (GstTensorSrcTIZENSENSOR * self, GstTensorsInfo * info)
+{
+  guint i;
+
+  gst_tensors_info_init (info);
+  info->num_tensors = 1;
+  gst_tensor_info_copy (&info->info[0], self->src_spec);
+
+  if (self->batch_size > 1) {
+    info->num_tensors = 2;
+    info->info[0].dimension[1] = self->batch_size;
+
+    info->info[1].type = _NNS_UINT64;
+    info->info[1].dimension[0] = self->batch_size;
+    for (i = 1; i < NNS_TENSOR_RANK_LIMIT; i++)
+      info->info[1].dimension[i] = 1;
+  }
+}
+
 /**
  * @brief Get handle, setup context, make it ready!
  */
@@ -641,6 +721,17 @@ _ts_configure_handle (GstTensorSrcTIZENSENSOR * self)
 
   nns_logi ("Set sensor_listener interval: %ums", self->interval_ms);
 
+  /* Let the sensor framework deliver the events by bulk if possible */
+  if (self->batch_size > 1 && self->batch_latency > 0) {
+    ret = sensor_listener_set_max_batch_latency (self->listener,
+        self->batch_latency);
+    if (ret != SENSOR_ERROR_NONE) {
+      GST_WARNING_OBJECT (self,
+          "The sensor does not support the batch latency (%d). The events are batched by the element.",
+          ret);
+    }
+  }
+
   /* 4. Register sensor event handler */
   switch (self->mode) {
     case TZN_SENSOR_MODE_POLLING:
@@ -800,6 +891,38 @@ gst_tensor_src_tizensensor_set_property (GObject * object,
       _UNLOCK (self);
     }
       break;
+    case PROP_BATCH_SIZE:
+    case PROP_BATCH_LATENCY:
+    {
+      guint size = self->batch_size;
+      guint latency = self->batch_latency;
+
+      _LOCK (self);
+
+      if (prop_id == PROP_BATCH_SIZE)
+        self->batch_size = g_value_get_uint (value);
+      else
+        self->batch_latency = g_value_get_uint (value);
+
+      silent_debug ("Set batch size %u --> %u, latency %u --> %u ms",
+          size, self->batch_size, latency, self->batch_latency);
+
+      if (size != self->batch_size || latency != self->batch_latency) {
+        /* Same sensor is kept. Only batching is changed */
+        if (self->configured)
+          ret = _ts_reconfigure (self);
+
+        if (ret) {
+          self->batch_size = size;
+          self->batch_latency = latency;
+          GST_ERROR_OBJECT (self,
+              "Calling _ts_reconfigure at set batch property has failed. _ts_reconfigure () returns %d",
+              ret);
+        }
+      }
+      _UNLOCK (self);
+    }
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -831,6 +954,12 @@ gst_tensor_src_tizensensor_get_property (GObject * object,
     case PROP_FREQ:
       gst_value_set_fraction (value, self->freq_n, self->freq_d);
       break;
+    case PROP_BATCH_SIZE:
+      g_value_set_uint (value, self->batch_size);
+      break;
+    case PROP_BATCH_LATENCY:
+      g_value_set_uint (value, self->batch_latency);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -850,6 +979,7 @@ gst_tensor_src_tizensensor_finalize (GObject * object)
   _ts_clean_up_handle (self);
 
   _UNLOCK (self);
+  g_array_free (self->batch_events, TRUE);
   g_mutex_clear (&self->lock);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
@@ -869,6 +999,7 @@ gst_tensor_src_tizensensor_start (GstBaseSrc * src)
   int ret = 0;
   GstTensorSrcTIZENSENSOR *self = GST_TENSOR_SRC_TIZENSENSOR_CAST (src);
   gboolean retval = TRUE;
+  GstTensorsInfo info;
   guint blocksize;
 
   _LOCK (self);
@@ -905,7 +1036,9 @@ gst_tensor_src_tizensensor_start (GstBaseSrc * src)
   }
 
   /* set data size */
-  blocksize = gst_tensor_info_get_size (self->src_spec);
+  _ts_get_tensors_info (self, &info);
+  blocksize = gst_tensors_info_get_size (&info, -1);
+  gst_tensors_info_free (&info);
   gst_base_src_set_blocksize (src, blocksize);
 
   self->running = TRUE;
@@ -975,14 +1108,18 @@ _ts_get_gstcaps_from_conf (GstTensorSrcTIZENSENSOR * self)
     GstTensorsConfig tensors_config;
 
     gst_tensors_config_init (&tensors_config);
-    tensors_config.info.num_tensors = 1;
-
-    gst_tensor_info_copy (&tensors_config.info.info[0], spec);
+    _ts_get_tensors_info (self, &tensors_config.info);
     tensors_config.rate_n = self->freq_n;
-    tensors_config.rate_d = self->freq_d;
-
-    retval = gst_tensor_caps_from_config (&tensors_config);
-    gst_caps_append (retval, gst_tensors_caps_from_config (&tensors_config));
+    tensors_config.rate_d = self->freq_d * self->batch_size;
+
+    if (self->batch_size > 1) {
+      /* The events and timestamps are given with other/tensors only */
+      retval = gst_tensors_caps_from_config (&tensors_config);
+    } else {
+      retval = gst_tensor_caps_from_config (&tensors_config);
+      gst_caps_append (retval, gst_tensors_caps_from_config (&tensors_config));
+    }
+    gst_tensors_config_free (&tensors_config);
   }
 
   return retval;
@@ -1098,8 +1235,9 @@ gst_tensor_src_tizensensor_query (GstBaseSrc * src, GstQuery * query)
         goto done;
       }
 
-      /* min latency is the time to capture one frame/field */
-      min_latency = gst_util_uint64_scale_int (GST_SECOND, freq_d, freq_n);
+      /* min latency is the time to capture one frame/field (or a batch) */
+      min_latency = gst_util_uint64_scale_int (GST_SECOND, freq_d, freq_n) *
+          self->batch_size;
 
       GST_DEBUG_OBJECT (self,
           "Reporting latency min %" GST_TIME_FORMAT " max %" GST_TIME_FORMAT,
@@ -1130,7 +1268,8 @@ gst_tensor_src_tizensensor_create (GstBaseSrc * src, guint64 offset,
   GstTensorSrcTIZENSENSOR *self = GST_TENSOR_SRC_TIZENSENSOR_CAST (src);
   GstBuffer *buf = gst_buffer_new ();
   GstMemory *mem;
-  guint buffer_size;
+  GstTensorsInfo info;
+  guint i, buffer_size;
   GstFlowReturn retval = GST_FLOW_OK;
   UNUSED (size);
   _LOCK (self);
@@ -1144,16 +1283,24 @@ gst_tensor_src_tizensensor_create (GstBaseSrc * src, guint64 offset,
 
   g_assert (self->src_spec);    /* It should be valid if configured */
 
-  /* We don't have multi-tensor (tensors with num-tensors > 1) */
-  buffer_size = gst_tensor_info_get_size (self->src_spec);
-  mem = gst_allocator_alloc (NULL, buffer_size, NULL);
-  if (mem == NULL) {
-    GST_ERROR_OBJECT (self,
-        "Cannot allocate memory for gst buffer of %u bytes", buffer_size);
-    retval = GST_FLOW_ERROR;
-    goto exit;
+  /* A memory for each tensor (values and timestamps if batched) */
+  _ts_get_tensors_info (self, &info);
+  buffer_size = gst_tensors_info_get_size (&info, -1);
+
+  for (i = 0; i < info.num_tensors; i++) {
+    gsize mem_size = gst_tensors_info_get_size (&info, i);
+
+    mem = gst_allocator_alloc (NULL, mem_size, NULL);
+    if (mem == NULL) {
+      GST_ERROR_OBJECT (self,
+          "Cannot allocate memory for gst buffer of %zu bytes", mem_size);
+      gst_tensors_info_free (&info);
+      retval = GST_FLOW_ERROR;
+      goto exit;
+    }
+    gst_buffer_append_memory (buf, mem);
   }
-  gst_buffer_append_memory (buf, mem);
+  gst_tensors_info_free (&info);
 
   _UNLOCK (self);
   retval = gst_tensor_src_tizensensor_fill (src, offset, buffer_size, buf);
@@ -1164,6 +1311,8 @@ gst_tensor_src_tizensensor_create (GstBaseSrc * src, guint64 offset,
   *buffer = buf;
 
 exit:
+  if (retval != GST_FLOW_OK)
+    gst_buffer_unref (buf);
   _UNLOCK (self);
   return retval;
 }
@@ -1182,30 +1331,119 @@ case desttypeenum: \
   break;
 
 /**
- * @brief Copy sensor's values[] to Gst memory map.
+ * @brief Copy sensor's values[] to the given data pointer.
  */
 static void
-_ts_assign_values (float values[], int count, GstMapInfo * map,
+_ts_assign_values (float values[], int count, guint8 * data,
     const GstTensorInfo * spec)
 {
   switch (spec->type) {
     case _NNS_FLOAT32:
-      memcpy (map->data, values, sizeof (float) * count);
+      memcpy (data, values, sizeof (float) * count);
       break;
-      case_cast_loop (values, count, map->data, int64_t, _NNS_INT64);
-      case_cast_loop (values, count, map->data, int32_t, _NNS_INT32);
-      case_cast_loop (values, count, map->data, int16_t, _NNS_INT16);
-      case_cast_loop (values, count, map->data, int8_t, _NNS_INT8);
-      case_cast_loop (values, count, map->data, uint64_t, _NNS_UINT64);
-      case_cast_loop (values, count, map->data, uint32_t, _NNS_UINT32);
-      case_cast_loop (values, count, map->data, uint16_t, _NNS_UINT16);
-      case_cast_loop (values, count, map->data, uint8_t, _NNS_UINT8);
-      case_cast_loop (values, count, map->data, double, _NNS_FLOAT64);
+      case_cast_loop (values, count, data, int64_t, _NNS_INT64);
+      case_cast_loop (values, count, data, int32_t, _NNS_INT32);
+      case_cast_loop (values, count, data, int16_t, _NNS_INT16);
+      case_cast_loop (values, count, data, int8_t, _NNS_INT8);
+      case_cast_loop (values, count, data, uint64_t, _NNS_UINT64);
+      case_cast_loop (values, count, data, uint32_t, _NNS_UINT32);
+      case_cast_loop (values, count, data, uint16_t, _NNS_UINT16);
+      case_cast_loop (values, count, data, uint8_t, _NNS_UINT8);
+      case_cast_loop (values, count, data, double, _NNS_FLOAT64);
     default:
       g_assert (0);   /** Other types are not implemented! */
   }
 }
 
+/**
+ * @brief Unlock function, flush any pending data in the src
+ */
+static gboolean
+gst_tensor_src_tizensensor_unlock (GstBaseSrc * src)
+{
+  GstTensorSrcTIZENSENSOR *self = GST_TENSOR_SRC_TIZENSENSOR_CAST (src);
+
+  _LOCK (self);
+  self->flushing = TRUE;
+  _UNLOCK (self);
+  return TRUE;
+}
+
+/**
+ * @brief Unlock stop function, clear the previous unlock request
+ */
+static gboolean
+gst_tensor_src_tizensensor_unlock_stop (GstBaseSrc * src)
+{
+  GstTensorSrcTIZENSENSOR *self = GST_TENSOR_SRC_TIZENSENSOR_CAST (src);
+
+  _LOCK (self);
+  self->flushing = FALSE;
+  _UNLOCK (self);
+  return TRUE;
+}
+
+/**
+ * @brief Accumulate the sensor events until a batch is ready.
+ * @details The events already batched are skipped with the timestamp,
+ *          because the sensor framework may give the same event again.
+ *          The caller should hold the lock.
+ */
+static GstFlowReturn
+_ts_collect_batch (GstTensorSrcTIZENSENSOR * self, guint batch_size)
+{
+  sensor_event_s *events;
+  int i, count, ret;
+  int src_dim = self->src_spec->dimension[0];
+
+  while (self->batch_events->len < batch_size) {
+    if (self->flushing)
+      return GST_FLOW_FLUSHING;
+
+    events = NULL;
+    count = 0;
+    ret = sensor_listener_read_data_list (self->listener, &events, &count);
+    if (ret != SENSOR_ERROR_NONE) {
+      GST_ERROR_OBJECT (self,
+          "Tizen sensor read failed: sensor_listener_read_data returned %d",
+          ret);
+      g_free (events);
+      return GST_FLOW_ERROR;
+    }
+
+    for (i = 0; i < count; i++) {
+      if (events[i].value_count != src_dim) {
+        GST_ERROR_OBJECT (self,
+            "The number of values (%d) mismatches the metadata (%d)",
+            events[i].value_count, src_dim);
+        g_free (events);
+        return GST_FLOW_ERROR;
+      }
+
+      if (self->last_timestamp > 0 &&
+          events[i].timestamp <= self->last_timestamp)
+        continue;
+
+      g_array_append_val (self->batch_events, events[i]);
+      self->last_timestamp = events[i].timestamp;
+    }
+    g_free (events);
+
+    if (self->batch_events->len < batch_size) {
+      /* Wait for the next events (a sensor interval) */
+      _UNLOCK (self);
+      g_usleep (MAX (1U, self->interval_ms) * 1000);
+      _LOCK (self);
+
+      /* The sensor may be reconfigured while waiting */
+      if (!self->configured || self->batch_size != batch_size)
+        return GST_FLOW_FLUSHING;
+    }
+  }
+
+  return GST_FLOW_OK;
+}
+
 /**
  * @brief fill the buffer with data
  * @note ignore offset,size as there is pull mode
@@ -1219,8 +1457,11 @@ gst_tensor_src_tizensensor_fill (GstBaseSrc * src, guint64 offset,
   GstTensorSrcTIZENSENSOR *self = GST_TENSOR_SRC_TIZENSENSOR_CAST (src);
   sensor_event_s *events = NULL;
   GstFlowReturn retval = GST_FLOW_OK;
-  GstMemory *mem;
-  GstMapInfo map;
+  GstTensorsInfo info;
+  GstMemory *mem, *ts_mem = NULL;
+  GstMapInfo map, ts_map;
+  gsize expected;
+  guint num_tensors;
   int src_dim;
   UNUSED (offset);
   _LOCK (self);
@@ -1232,14 +1473,20 @@ gst_tensor_src_tizensensor_fill (GstBaseSrc * src, guint64 offset,
     goto exit;
   }
 
-  if (size != gst_tensor_info_get_size (self->src_spec)) {
+  _ts_get_tensors_info (self, &info);
+  expected = gst_tensors_info_get_size (&info, -1);
+  num_tensors = info.num_tensors;
+  gst_tensors_info_free (&info);
+
+  if (size != expected || gst_buffer_n_memory (buffer) != num_tensors) {
     GST_ERROR_OBJECT (self,
         "gst_tensor_src_tizensensor_fill() requires size value (%u) to be matched with the configurations of sensors (%lu)",
-        size, (unsigned long) gst_tensor_info_get_size (self->src_spec));
+        size, (unsigned long) expected);
     retval = GST_FLOW_ERROR;
     goto exit;
   }
 
+  memset (&ts_map, 0, sizeof (GstMapInfo));
   mem = gst_buffer_peek_memory (buffer, 0);
   if (!gst_memory_map (mem, &map, GST_MAP_WRITE)) {
     GST_ERROR_OBJECT (self,
@@ -1248,7 +1495,49 @@ gst_tensor_src_tizensensor_fill (GstBaseSrc * src, guint64 offset,
     goto exit;
   }
 
-  if (self->mode == TZN_SENSOR_MODE_POLLING) {
+  if (self->batch_size > 1) {
+    ts_mem = gst_buffer_peek_memory (buffer, 1);
+    if (!gst_memory_map (ts_mem, &ts_map, GST_MAP_WRITE)) {
+      GST_ERROR_OBJECT (self,
+          "gst_tensor_src_tizensensor_fill() cannot map the given buffer for writing timestamps.");
+      ts_mem = NULL;
+      retval = GST_FLOW_ERROR;
+      goto exit_unmap;
+    }
+  }
+
+  if (self->mode == TZN_SENSOR_MODE_POLLING && self->batch_size > 1) {
+    gsize event_size = gst_tensor_info_get_size (self->src_spec);
+    guint64 *timestamps = (guint64 *) ts_map.data;
+    sensor_event_s *event;
+    guint i;
+
+    /* 1. Accumulate the events of a batch */
+    retval = _ts_collect_batch (self, self->batch_size);
+    if (retval != GST_FLOW_OK)
+      goto exit_unmap;
+
+    /* 2. Write values and timestamps of the events to buffer */
+    for (i = 0; i < self->batch_size; i++) {
+      event = &g_array_index (self->batch_events, sensor_event_s, i);
+
+      _ts_assign_values (event->values, event->value_count,
+          map.data + i * event_size, self->src_spec);
+      timestamps[i] = (guint64) event->timestamp;
+    }
+
+    nns_logd ("read %u sensor_data until %" GST_TIME_FORMAT, self->batch_size,
+        GST_TIME_ARGS (timestamps[self->batch_size - 1] * 1000));
+
+    g_array_remove_range (self->batch_events, 0, self->batch_size);
+
+    /* 3. Set duration of a batch so that BaseSrc handles the frequency */
+    if (self->freq_n == 0)
+      GST_BUFFER_DURATION (buffer) = 100 * GST_MSECOND * self->batch_size;
+    else
+      GST_BUFFER_DURATION (buffer) = gst_util_uint64_scale_int (GST_SECOND,
+          self->freq_d, self->freq_n) * self->batch_size;
+  } else if (self->mode == TZN_SENSOR_MODE_POLLING) {
     sensor_event_s *event;
     int count = 0;
     gint64 duration;
@@ -1290,7 +1579,8 @@ gst_tensor_src_tizensensor_fill (GstBaseSrc * src, guint64 offset,
     GST_BUFFER_DURATION (buffer) = duration;
 
     /* 4. Write values to buffer. Be careful on type casting */
-    _ts_assign_values (event->values, event->value_count, &map, self->src_spec);
+    _ts_assign_values (event->values, event->value_count, map.data,
+        self->src_spec);
   } else {
     /** NYI! */
     GST_ERROR_OBJECT (self,
@@ -1301,6 +1591,8 @@ gst_tensor_src_tizensensor_fill (GstBaseSrc * src, guint64 offset,
 
 exit_unmap:
   g_free (events);
+  if (ts_mem)
+    gst_memory_unmap (ts_mem, &ts_map);
   gst_memory_unmap (mem, &map);
 exit:
   _UNLOCK (self);
@@ -85,6 +85,8 @@ struct _GstTensorSrcTIZENSENSOR
   sensor_op_modes mode; /**< Sensor data retrieval mode */
   gint freq_n; /**< Operating frequency of N/d */
   gint freq_d; /**< Operating frequency of n/D */
+  guint batch_size; /**< The number of events in an output buffer */
+  guint batch_latency; /**< Max batch latency (ms) of the sensor listener, 0 for default */
 
   /**
    * Sensor node info (handle, context)
@@ -95,6 +97,10 @@ struct _GstTensorSrcTIZENSENSOR
   unsigned int interval_ms;
   sensor_listener_h listener;
   sensor_h sensor;
+
+  GArray *batch_events; /**< Pending events (sensor_event_s) to be batched */
+  unsigned long long last_timestamp; /**< Timestamp of the last event batched */
+  gboolean flushing; /**< true while the src is unlocked */
 };
 
 /**
@@ -0,0 +1,67 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	gstdatarepo_format.h
+ * @date	14 Oct 2026
+ * @brief	Indexed container format of the samples in MLOps Data repository
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ *
+ * The file starts with GstDataRepoFileHdr, and the index of the tensors
+ * (num_samples x num_tensors GstDataRepoIndexEntry) is at index_offset.
+ * The entry of the t-th tensor of the i-th sample is the
+ * (i * num_tensors + t)-th entry, so any tensor is located in O(1) without
+ * scanning the file. The data of the tensors may be stored sample by sample
+ * (row layout) or tensor by tensor (column layout); the reader only follows
+ * the index, and reading a subset of the tensors (e.g., labels only) touches
+ * only their columns in column layout.
+ * All values are little endian, and index_offset is 8 bytes aligned so the
+ * index can be used directly from the mapped file.
+ */
+
+#ifndef __GST_DATA_REPO_FORMAT_H__
+#define __GST_DATA_REPO_FORMAT_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+#define GST_DATA_REPO_MAGIC 0x52444e4eU /* "NNDR" */
+#define GST_DATA_REPO_VERSION 1
+
+/**
+ * @brief Layout of the tensor data in the container.
+ */
+typedef enum
+{
+  GST_DATA_REPO_LAYOUT_ROW = 0,   /**< the tensors of a sample are stored together */
+  GST_DATA_REPO_LAYOUT_COLUMN = 1 /**< each tensor of all samples is stored together */
+} GstDataRepoLayout;
+
+/**
+ * @brief Header of the container file.
+ */
+typedef struct
+{
+  guint32 magic;        /**< GST_DATA_REPO_MAGIC */
+  guint32 version;      /**< GST_DATA_REPO_VERSION */
+  guint32 num_tensors;  /**< the number of tensors in a sample */
+  guint32 layout;       /**< GstDataRepoLayout */
+  guint64 num_samples;  /**< the number of samples */
+  guint64 index_offset; /**< offset of the index from the beginning of the file */
+  guint64 reserved[4];
+} GstDataRepoFileHdr;
+
+/**
+ * @brief Index entry of a tensor of a sample.
+ */
+typedef struct
+{
+  guint64 offset;       /**< offset of the tensor data from the beginning of the file */
+  guint64 size;         /**< size of the tensor data */
+} GstDataRepoIndexEntry;
+
+G_END_DECLS
+#endif /* __GST_DATA_REPO_FORMAT_H__ */
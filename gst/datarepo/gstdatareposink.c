@@ -0,0 +1,699 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	gstdatareposink.c
+ * @date	15 Oct 2026
+ * @brief	GStreamer plugin to write buffers into a file in MLOps Data repository
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ *
+ * datareposink writes each incoming buffer as a sample of the indexed
+ * container (gstdatarepo_format.h), each memory of the buffer being a tensor
+ * of the sample. The streaming thread only queues the buffer; a writer thread
+ * copies the samples into an aligned staging buffer and writes it in batches
+ * of batch-size bytes, with O_DIRECT if use-direct-io is set. The index and
+ * the header are written when the stream ends, so datareposrc can read the
+ * file as soon as datareposink is stopped.
+ *
+ * ## Example launch line
+ * |[
+ * gst-launch-1.0 videotestsrc ! video/x-raw,format=RGB,width=224,height=224 ! \
+ * tensor_converter ! datareposink location=dataset.dat use-direct-io=true
+ * ]|
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+#include <gst/gst.h>
+#include <glib/gstdio.h>
+#include <stdlib.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include "gstdatareposink.h"
+
+#ifndef O_BINARY
+#define O_BINARY (0)
+#endif
+
+static GstStaticPadTemplate sinktemplate = GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS_ANY);
+
+GST_DEBUG_CATEGORY_STATIC (gst_data_repo_sink_debug);
+#define GST_CAT_DEFAULT gst_data_repo_sink_debug
+
+/* RepoSink signals and args */
+enum
+{
+  PROP_0,
+  PROP_LOCATION,
+  PROP_USE_DIRECT_IO,
+  PROP_BATCH_SIZE,
+  PROP_MAX_PENDING
+};
+
+#define DEFAULT_USE_DIRECT_IO FALSE
+#define DEFAULT_BATCH_SIZE (4 * 1024 * 1024)
+#define DEFAULT_MAX_PENDING 64
+
+/**
+ * @brief Alignment of the staging buffer, file offsets and sizes for O_DIRECT.
+ */
+#define DATA_REPO_SINK_ALIGN 4096
+
+static void gst_data_repo_sink_finalize (GObject * object);
+static void gst_data_repo_sink_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_data_repo_sink_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
+static gboolean gst_data_repo_sink_start (GstBaseSink * basesink);
+static gboolean gst_data_repo_sink_stop (GstBaseSink * basesink);
+static gboolean gst_data_repo_sink_event (GstBaseSink * basesink,
+    GstEvent * event);
+static gboolean gst_data_repo_sink_unlock (GstBaseSink * basesink);
+static gboolean gst_data_repo_sink_unlock_stop (GstBaseSink * basesink);
+static GstFlowReturn gst_data_repo_sink_render (GstBaseSink * basesink,
+    GstBuffer * buffer);
+
+#define _do_init \
+  GST_DEBUG_CATEGORY_INIT (gst_data_repo_sink_debug, "datareposink", 0, "datareposink element");
+
+#define gst_data_repo_sink_parent_class parent_class
+G_DEFINE_TYPE_WITH_CODE (GstDataRepoSink, gst_data_repo_sink,
+    GST_TYPE_BASE_SINK, _do_init);
+
+/**
+ * @brief initialize the datareposink's class
+ */
+static void
+gst_data_repo_sink_class_init (GstDataRepoSinkClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GstElementClass *gstelement_class = GST_ELEMENT_CLASS (klass);
+  GstBaseSinkClass *gstbasesink_class = GST_BASE_SINK_CLASS (klass);
+
+  gobject_class->set_property =
+      GST_DEBUG_FUNCPTR (gst_data_repo_sink_set_property);
+  gobject_class->get_property =
+      GST_DEBUG_FUNCPTR (gst_data_repo_sink_get_property);
+  gobject_class->finalize = gst_data_repo_sink_finalize;
+
+  g_object_class_install_property (gobject_class, PROP_LOCATION,
+      g_param_spec_string ("location", "File Location",
+          "Location of the file to write", NULL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_USE_DIRECT_IO,
+      g_param_spec_boolean ("use-direct-io", "Use direct I/O",
+          "Open the file with O_DIRECT and write the batches bypassing the "
+          "page cache, falls back to the buffered I/O if not supported",
+          DEFAULT_USE_DIRECT_IO,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_BATCH_SIZE,
+      g_param_spec_uint ("batch-size", "Batch size",
+          "The number of bytes written to the file at once, "
+          "rounded up to the multiple of 4096", DATA_REPO_SINK_ALIGN,
+          G_MAXINT, DEFAULT_BATCH_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_MAX_PENDING,
+      g_param_spec_uint ("max-pending", "Max pending samples",
+          "The max number of samples waiting for the writer thread, "
+          "the streaming thread blocks when the queue is full",
+          1, G_MAXUINT, DEFAULT_MAX_PENDING,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  gst_element_class_set_static_metadata (gstelement_class,
+      "NNStreamer MLOps Data Repository Sink",
+      "Sink/File",
+      "Write buffers into a file in MLOps Data Repository",
+      "Samsung Electronics Co., Ltd.");
+  gst_element_class_add_static_pad_template (gstelement_class, &sinktemplate);
+
+  gstbasesink_class->start = GST_DEBUG_FUNCPTR (gst_data_repo_sink_start);
+  gstbasesink_class->stop = GST_DEBUG_FUNCPTR (gst_data_repo_sink_stop);
+  gstbasesink_class->event = GST_DEBUG_FUNCPTR (gst_data_repo_sink_event);
+  gstbasesink_class->unlock = GST_DEBUG_FUNCPTR (gst_data_repo_sink_unlock);
+  gstbasesink_class->unlock_stop =
+      GST_DEBUG_FUNCPTR (gst_data_repo_sink_unlock_stop);
+  gstbasesink_class->render = GST_DEBUG_FUNCPTR (gst_data_repo_sink_render);
+}
+
+/**
+ * @brief Initialize datareposink
+ */
+static void
+gst_data_repo_sink_init (GstDataRepoSink * sink)
+{
+  sink->filename = NULL;
+  sink->fd = -1;
+  sink->direct = FALSE;
+  sink->staging = NULL;
+  sink->staging_size = 0;
+  sink->staging_fill = 0;
+  sink->staging_offset = 0;
+  sink->index = g_array_new (FALSE, FALSE, sizeof (GstDataRepoIndexEntry));
+  sink->num_tensors = 0;
+  sink->num_samples = 0;
+  sink->finished = TRUE;
+  sink->writer = NULL;
+  g_mutex_init (&sink->lock);
+  g_cond_init (&sink->cond);
+  g_queue_init (&sink->queue);
+  sink->draining = FALSE;
+  sink->flushing = FALSE;
+  sink->write_ret = GST_FLOW_OK;
+  sink->use_direct_io = DEFAULT_USE_DIRECT_IO;
+  sink->batch_size = DEFAULT_BATCH_SIZE;
+  sink->max_pending = DEFAULT_MAX_PENDING;
+
+  /* the writer thread keeps up with the stream, do not sync on the clock */
+  gst_base_sink_set_sync (GST_BASE_SINK (sink), FALSE);
+}
+
+/**
+ * @brief Function to finalize instance.
+ */
+static void
+gst_data_repo_sink_finalize (GObject * object)
+{
+  GstDataRepoSink *sink = GST_DATA_REPO_SINK (object);
+
+  g_free (sink->filename);
+  g_array_free (sink->index, TRUE);
+  g_mutex_clear (&sink->lock);
+  g_cond_clear (&sink->cond);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+/**
+ * @brief Setter for datareposink properties.
+ */
+static void
+gst_data_repo_sink_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstDataRepoSink *sink = GST_DATA_REPO_SINK (object);
+
+  switch (prop_id) {
+    case PROP_LOCATION:
+      g_free (sink->filename);
+      sink->filename = g_value_dup_string (value);
+      GST_INFO_OBJECT (sink, "filename : %s", GST_STR_NULL (sink->filename));
+      break;
+    case PROP_USE_DIRECT_IO:
+      sink->use_direct_io = g_value_get_boolean (value);
+      break;
+    case PROP_BATCH_SIZE:
+      sink->batch_size = g_value_get_uint (value);
+      break;
+    case PROP_MAX_PENDING:
+      sink->max_pending = g_value_get_uint (value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/**
+ * @brief Getter for datareposink properties.
+ */
+static void
+gst_data_repo_sink_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstDataRepoSink *sink = GST_DATA_REPO_SINK (object);
+
+  switch (prop_id) {
+    case PROP_LOCATION:
+      g_value_set_string (value, sink->filename);
+      break;
+    case PROP_USE_DIRECT_IO:
+      g_value_set_boolean (value, sink->use_direct_io);
+      break;
+    case PROP_BATCH_SIZE:
+      g_value_set_uint (value, sink->batch_size);
+      break;
+    case PROP_MAX_PENDING:
+      g_value_set_uint (value, sink->max_pending);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/**
+ * @brief Write the data at the offset of the file, retrying the partial writes.
+ */
+static gboolean
+gst_data_repo_sink_pwrite (GstDataRepoSink * sink, const guint8 * data,
+    gsize size, guint64 offset)
+{
+  ssize_t ret;
+
+  while (size > 0) {
+    errno = 0;
+    ret = pwrite (sink->fd, data, size, (off_t) offset);
+    if (ret < 0) {
+      if (errno == EAGAIN || errno == EINTR)
+        continue;
+      GST_ERROR_OBJECT (sink, "Failed to write %" G_GSIZE_FORMAT
+          " bytes at offset %" G_GUINT64_FORMAT ": %s", size, offset,
+          g_strerror (errno));
+      return FALSE;
+    }
+
+    data += ret;
+    size -= (gsize) ret;
+    offset += (guint64) ret;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Append the data to the staging buffer, write the staging buffer whenever it is full.
+ */
+static gboolean
+gst_data_repo_sink_stage (GstDataRepoSink * sink, const guint8 * data,
+    gsize size)
+{
+  gsize n;
+
+  while (size > 0) {
+    n = MIN (size, sink->staging_size - sink->staging_fill);
+    memcpy (sink->staging + sink->staging_fill, data, n);
+    sink->staging_fill += n;
+    data += n;
+    size -= n;
+
+    if (sink->staging_fill == sink->staging_size) {
+      /* full batch, the offset and size are aligned for O_DIRECT */
+      if (!gst_data_repo_sink_pwrite (sink, sink->staging, sink->staging_size,
+              sink->staging_offset))
+        return FALSE;
+
+      sink->staging_offset += sink->staging_size;
+      sink->staging_fill = 0;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Copy the tensors of the sample into the staging buffer and add them to the index.
+ */
+static GstFlowReturn
+gst_data_repo_sink_write_sample (GstDataRepoSink * sink, GstBuffer * buffer)
+{
+  GstDataRepoIndexEntry entry;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint i, num;
+  gboolean ret;
+
+  num = gst_buffer_n_memory (buffer);
+  if (sink->num_tensors == 0) {
+    if (num == 0 || num > NNS_TENSOR_SIZE_LIMIT) {
+      GST_ELEMENT_ERROR (sink, STREAM, FORMAT,
+          ("Invalid number of tensors %u in a sample.", num), (NULL));
+      return GST_FLOW_ERROR;
+    }
+    sink->num_tensors = num;
+  } else if (num != sink->num_tensors) {
+    GST_ELEMENT_ERROR (sink, STREAM, FORMAT,
+        ("The sample has %u tensors, but the data repository has %u tensors "
+            "in a sample.", num, sink->num_tensors), (NULL));
+    return GST_FLOW_ERROR;
+  }
+
+  for (i = 0; i < num; i++) {
+    mem = gst_buffer_peek_memory (buffer, i);
+    if (!gst_memory_map (mem, &info, GST_MAP_READ)) {
+      GST_ELEMENT_ERROR (sink, RESOURCE, READ,
+          ("Failed to map the tensor %u of the sample.", i), (NULL));
+      return GST_FLOW_ERROR;
+    }
+
+    entry.offset = GUINT64_TO_LE (sink->staging_offset + sink->staging_fill);
+    entry.size = GUINT64_TO_LE ((guint64) info.size);
+    ret = gst_data_repo_sink_stage (sink, info.data, info.size);
+    gst_memory_unmap (mem, &info);
+
+    if (!ret) {
+      GST_ELEMENT_ERROR (sink, RESOURCE, WRITE,
+          (("Could not write to file \"%s\"."), sink->filename),
+          GST_ERROR_SYSTEM);
+      return GST_FLOW_ERROR;
+    }
+
+    g_array_append_val (sink->index, entry);
+  }
+
+  sink->num_samples++;
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Thread writing the queued samples.
+ */
+static gpointer
+gst_data_repo_sink_writer_thread (gpointer data)
+{
+  GstDataRepoSink *sink = GST_DATA_REPO_SINK (data);
+  GstBuffer *buffer;
+  GstFlowReturn ret;
+
+  g_mutex_lock (&sink->lock);
+  while (TRUE) {
+    while (g_queue_is_empty (&sink->queue) && !sink->draining)
+      g_cond_wait (&sink->cond, &sink->lock);
+
+    buffer = g_queue_pop_head (&sink->queue);
+    if (buffer == NULL)
+      break;
+
+    /* wake up the streaming thread waiting for the space in the queue */
+    g_cond_broadcast (&sink->cond);
+    g_mutex_unlock (&sink->lock);
+
+    ret = gst_data_repo_sink_write_sample (sink, buffer);
+    gst_buffer_unref (buffer);
+
+    g_mutex_lock (&sink->lock);
+    if (ret != GST_FLOW_OK) {
+      sink->write_ret = ret;
+      g_queue_clear_full (&sink->queue, (GDestroyNotify) gst_buffer_unref);
+      g_cond_broadcast (&sink->cond);
+      break;
+    }
+  }
+  g_mutex_unlock (&sink->lock);
+
+  return NULL;
+}
+
+/**
+ * @brief Wait until the writer thread writes all the queued samples.
+ */
+static void
+gst_data_repo_sink_drain (GstDataRepoSink * sink)
+{
+  if (!sink->writer)
+    return;
+
+  g_mutex_lock (&sink->lock);
+  sink->draining = TRUE;
+  g_cond_broadcast (&sink->cond);
+  g_mutex_unlock (&sink->lock);
+
+  g_thread_join (sink->writer);
+  sink->writer = NULL;
+}
+
+/**
+ * @brief Write the rest of the samples, the index and the header.
+ */
+static gboolean
+gst_data_repo_sink_finish (GstDataRepoSink * sink)
+{
+  GstDataRepoFileHdr hdr;
+  guint64 index_offset;
+  gsize index_size;
+
+  if (sink->finished)
+    return TRUE;
+  sink->finished = TRUE;
+
+  if (sink->direct) {
+    /* the tail of the samples, index and header are not aligned */
+    gint flags = fcntl (sink->fd, F_GETFL);
+
+    if (flags < 0 || fcntl (sink->fd, F_SETFL, flags & ~O_DIRECT) < 0) {
+      GST_ERROR_OBJECT (sink, "Failed to clear O_DIRECT: %s",
+          g_strerror (errno));
+      return FALSE;
+    }
+    sink->direct = FALSE;
+  }
+
+  if (!gst_data_repo_sink_pwrite (sink, sink->staging, sink->staging_fill,
+          sink->staging_offset))
+    return FALSE;
+
+  /* the index is 8 bytes aligned to be used from the mapped file */
+  index_offset = (sink->staging_offset + sink->staging_fill + 7) & ~7ULL;
+  index_size = sink->index->len * sizeof (GstDataRepoIndexEntry);
+  if (index_size > 0 &&
+      !gst_data_repo_sink_pwrite (sink, (const guint8 *) sink->index->data,
+          index_size, index_offset))
+    return FALSE;
+
+  memset (&hdr, 0, sizeof (hdr));
+  hdr.magic = GUINT32_TO_LE (GST_DATA_REPO_MAGIC);
+  hdr.version = GUINT32_TO_LE (GST_DATA_REPO_VERSION);
+  hdr.num_tensors = GUINT32_TO_LE (sink->num_tensors);
+  hdr.layout = GUINT32_TO_LE (GST_DATA_REPO_LAYOUT_ROW);
+  hdr.num_samples = GUINT64_TO_LE (sink->num_samples);
+  hdr.index_offset = GUINT64_TO_LE (index_offset);
+
+  if (!gst_data_repo_sink_pwrite (sink, (const guint8 *) &hdr, sizeof (hdr),
+          0))
+    return FALSE;
+
+  GST_INFO_OBJECT (sink, "Wrote %" G_GUINT64_FORMAT " samples of %u tensors "
+      "to %s", sink->num_samples, sink->num_tensors, sink->filename);
+  return TRUE;
+}
+
+/**
+ * @brief Drain the writer and complete the file.
+ */
+static GstFlowReturn
+gst_data_repo_sink_complete (GstDataRepoSink * sink)
+{
+  gboolean written;
+
+  gst_data_repo_sink_drain (sink);
+
+  if (sink->finished)
+    return sink->write_ret;
+
+  written = gst_data_repo_sink_finish (sink);
+  if (sink->write_ret != GST_FLOW_OK)
+    return sink->write_ret;
+
+  if (!written) {
+    GST_ELEMENT_ERROR (sink, RESOURCE, WRITE,
+        (("Could not write the index of \"%s\"."), sink->filename),
+        GST_ERROR_SYSTEM);
+    sink->write_ret = GST_FLOW_ERROR;
+  }
+
+  return sink->write_ret;
+}
+
+/**
+ * @brief Open the file, with O_DIRECT if requested and supported.
+ */
+static gboolean
+gst_data_repo_sink_open (GstDataRepoSink * sink)
+{
+  int flags = O_WRONLY | O_CREAT | O_TRUNC | O_BINARY;
+
+  sink->direct = FALSE;
+#ifdef O_DIRECT
+  if (sink->use_direct_io) {
+    sink->fd = g_open (sink->filename, flags | O_DIRECT, 0644);
+    if (sink->fd >= 0) {
+      sink->direct = TRUE;
+      return TRUE;
+    }
+
+    GST_WARNING_OBJECT (sink, "Failed to open %s with O_DIRECT (%s), "
+        "fall back to the buffered I/O", sink->filename, g_strerror (errno));
+  }
+#else
+  if (sink->use_direct_io)
+    GST_WARNING_OBJECT (sink, "O_DIRECT is not supported on this platform");
+#endif
+
+  sink->fd = g_open (sink->filename, flags, 0644);
+  return (sink->fd >= 0);
+}
+
+/**
+ * @brief Start datareposink, open the file and the writer thread.
+ */
+static gboolean
+gst_data_repo_sink_start (GstBaseSink * basesink)
+{
+  GstDataRepoSink *sink = GST_DATA_REPO_SINK (basesink);
+  gsize data_offset;
+  void *staging = NULL;
+
+  if (sink->filename == NULL || sink->filename[0] == '\0') {
+    GST_ELEMENT_ERROR (sink, RESOURCE, NOT_FOUND,
+        ("No file name specified for writing."), (NULL));
+    return FALSE;
+  }
+
+  if (!gst_data_repo_sink_open (sink)) {
+    GST_ELEMENT_ERROR (sink, RESOURCE, OPEN_WRITE,
+        (("Could not open file \"%s\" for writing."), sink->filename),
+        GST_ERROR_SYSTEM);
+    return FALSE;
+  }
+
+  sink->staging_size = ((gsize) sink->batch_size + DATA_REPO_SINK_ALIGN - 1) &
+      ~((gsize) DATA_REPO_SINK_ALIGN - 1);
+  if (posix_memalign (&staging, DATA_REPO_SINK_ALIGN, sink->staging_size) != 0) {
+    GST_ELEMENT_ERROR (sink, RESOURCE, NO_SPACE_LEFT,
+        ("Failed to allocate the staging buffer of %" G_GSIZE_FORMAT " bytes.",
+            sink->staging_size), (NULL));
+    g_close (sink->fd, NULL);
+    sink->fd = -1;
+    return FALSE;
+  }
+
+  /**
+   * The header is written at last. Keep the first block for the header,
+   * the samples start at the aligned offset with O_DIRECT.
+   */
+  data_offset = sink->direct ? DATA_REPO_SINK_ALIGN : sizeof (GstDataRepoFileHdr);
+  sink->staging = (guint8 *) staging;
+  memset (sink->staging, 0, data_offset);
+  sink->staging_fill = data_offset;
+  sink->staging_offset = 0;
+  g_array_set_size (sink->index, 0);
+  sink->num_tensors = 0;
+  sink->num_samples = 0;
+  sink->finished = FALSE;
+  sink->draining = FALSE;
+  sink->flushing = FALSE;
+  sink->write_ret = GST_FLOW_OK;
+
+  sink->writer = g_thread_new ("datareposink-writer",
+      gst_data_repo_sink_writer_thread, sink);
+
+  GST_INFO_OBJECT (sink, "Writing %s%s, batch size %" G_GSIZE_FORMAT,
+      sink->filename, sink->direct ? " with O_DIRECT" : "", sink->staging_size);
+  return TRUE;
+}
+
+/**
+ * @brief Stop datareposink, write the rest and close the file.
+ */
+static gboolean
+gst_data_repo_sink_stop (GstBaseSink * basesink)
+{
+  GstDataRepoSink *sink = GST_DATA_REPO_SINK (basesink);
+
+  /* write the samples received so far even if the stream is not ended */
+  gst_data_repo_sink_complete (sink);
+
+  free (sink->staging);
+  sink->staging = NULL;
+  g_array_set_size (sink->index, 0);
+
+  if (sink->fd >= 0) {
+    g_close (sink->fd, NULL);
+    sink->fd = -1;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Handle the events, complete the file at EOS.
+ */
+static gboolean
+gst_data_repo_sink_event (GstBaseSink * basesink, GstEvent * event)
+{
+  GstDataRepoSink *sink = GST_DATA_REPO_SINK (basesink);
+
+  if (GST_EVENT_TYPE (event) == GST_EVENT_EOS)
+    gst_data_repo_sink_complete (sink);
+
+  return GST_BASE_SINK_CLASS (parent_class)->event (basesink, event);
+}
+
+/**
+ * @brief Unblock the streaming thread waiting for the writer.
+ */
+static gboolean
+gst_data_repo_sink_unlock (GstBaseSink * basesink)
+{
+  GstDataRepoSink *sink = GST_DATA_REPO_SINK (basesink);
+
+  g_mutex_lock (&sink->lock);
+  sink->flushing = TRUE;
+  g_cond_broadcast (&sink->cond);
+  g_mutex_unlock (&sink->lock);
+
+  return TRUE;
+}
+
+/**
+ * @brief Clear the unlock state.
+ */
+static gboolean
+gst_data_repo_sink_unlock_stop (GstBaseSink * basesink)
+{
+  GstDataRepoSink *sink = GST_DATA_REPO_SINK (basesink);
+
+  g_mutex_lock (&sink->lock);
+  sink->flushing = FALSE;
+  g_mutex_unlock (&sink->lock);
+
+  return TRUE;
+}
+
+/**
+ * @brief Queue the sample for the writer thread.
+ */
+static GstFlowReturn
+gst_data_repo_sink_render (GstBaseSink * basesink, GstBuffer * buffer)
+{
+  GstDataRepoSink *sink = GST_DATA_REPO_SINK (basesink);
+  GstFlowReturn ret = GST_FLOW_OK;
+
+  g_mutex_lock (&sink->lock);
+  while (!sink->flushing && sink->write_ret == GST_FLOW_OK &&
+      g_queue_get_length (&sink->queue) >= sink->max_pending)
+    g_cond_wait (&sink->cond, &sink->lock);
+
+  if (sink->flushing) {
+    ret = GST_FLOW_FLUSHING;
+  } else if (sink->write_ret != GST_FLOW_OK) {
+    ret = sink->write_ret;
+  } else if (!sink->writer || sink->draining) {
+    ret = GST_FLOW_EOS;
+  } else {
+    /* the writer copies the data, the buffer is only referenced until then */
+    g_queue_push_tail (&sink->queue, gst_buffer_ref (buffer));
+    g_cond_broadcast (&sink->cond);
+  }
+  g_mutex_unlock (&sink->lock);
+
+  return ret;
+}
@@ -0,0 +1,79 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	gstdatareposink.h
+ * @date	15 Oct 2026
+ * @brief	GStreamer plugin to write buffers into a file in MLOps Data repository
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ */
+
+#ifndef __GST_DATA_REPO_SINK_H__
+#define __GST_DATA_REPO_SINK_H__
+
+#include <gst/gst.h>
+#include <gst/base/gstbasesink.h>
+#include "tensor_typedef.h"
+#include "gstdatarepo_format.h"
+
+G_BEGIN_DECLS
+#define GST_TYPE_DATA_REPO_SINK \
+  (gst_data_repo_sink_get_type())
+#define GST_DATA_REPO_SINK(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_DATA_REPO_SINK,GstDataRepoSink))
+#define GST_DATA_REPO_SINK_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_DATA_REPO_SINK,GstDataRepoSinkClass))
+#define GST_IS_DATA_REPO_SINK(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_DATA_REPO_SINK))
+#define GST_IS_DATA_REPO_SINK_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_DATA_REPO_SINK))
+
+typedef struct _GstDataRepoSink GstDataRepoSink;
+typedef struct _GstDataRepoSinkClass GstDataRepoSinkClass;
+
+/**
+ * @brief GstDataRepoSink data structure
+ */
+struct _GstDataRepoSink {
+
+  GstBaseSink parent; /**< parent object */
+
+  gint fd;                  /**< open file descriptor */
+  gboolean direct;          /**< the file is opened with O_DIRECT */
+  guint8 *staging;          /**< aligned buffer collecting the samples to write in a batch */
+  gsize staging_size;       /**< size of the staging buffer */
+  gsize staging_fill;       /**< bytes in the staging buffer */
+  guint64 staging_offset;   /**< file offset of the staging buffer */
+  GArray *index;            /**< GstDataRepoIndexEntry of the written tensors */
+  guint num_tensors;        /**< the number of tensors in a sample, 0 until the first sample */
+  guint64 num_samples;      /**< the number of written samples */
+  gboolean finished;        /**< the index and header are written */
+
+  GThread *writer;          /**< thread writing the queued samples */
+  GMutex lock;
+  GCond cond;
+  GQueue queue;             /**< samples to write */
+  gboolean draining;        /**< no more samples, the writer exits when the queue is empty */
+  gboolean flushing;        /**< render does not wait for the writer */
+  GstFlowReturn write_ret;  /**< result of the writer thread */
+
+  /* property */
+  gchar *filename;          /**< filename */
+  gboolean use_direct_io;   /**< open the file with O_DIRECT */
+  guint batch_size;         /**< bytes written at once */
+  guint max_pending;        /**< max number of samples waiting for the writer */
+};
+
+/**
+ * @brief GstDataRepoSinkClass data structure.
+ */
+struct _GstDataRepoSinkClass {
+  GstBaseSinkClass parent_class;
+};
+
+GType gst_data_repo_sink_get_type (void);
+
+G_END_DECLS
+#endif /* __GST_DATA_REPO_SINK_H__ */
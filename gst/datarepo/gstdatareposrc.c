@@ -37,6 +37,7 @@
 #include <string.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <inttypes.h>
 #include "nnstreamer_util.h"
 #include "gstdatareposrc.h"
@@ -69,7 +70,40 @@ GST_DEBUG_CATEGORY_STATIC (gst_data_repo_src_debug);
 enum
 {
   PROP_0,
-  PROP_LOCATION
+  PROP_LOCATION,
+  PROP_USE_MMAP,
+  PROP_EPOCHS,
+  PROP_SHUFFLE,
+  PROP_START_SAMPLE_INDEX,
+  PROP_STOP_SAMPLE_INDEX,
+  PROP_PREFETCH,
+  PROP_NUM_READERS,
+  PROP_TENSORS_SEQUENCE,
+  PROP_CACHE_SIZE
+};
+
+#define DEFAULT_USE_MMAP FALSE
+#define DEFAULT_EPOCHS 1
+#define DEFAULT_SHUFFLE FALSE
+#define DEFAULT_START_SAMPLE_INDEX 0
+#define DEFAULT_STOP_SAMPLE_INDEX 0
+#define DEFAULT_PREFETCH 0
+#define DEFAULT_NUM_READERS 1
+#define DEFAULT_CACHE_SIZE 0
+
+/**
+ * @brief The number of samples to read ahead in mmap mode.
+ */
+#define MMAP_READ_AHEAD_SAMPLES 4
+
+/**
+ * @brief Mapped file, released when the element and all the memories wrapping it are released.
+ */
+struct _GstDataRepoMmap
+{
+  gint refcount;
+  guint8 *addr;
+  gsize size;
 };
 
 static void gst_data_repo_src_finalize (GObject * object);
@@ -81,6 +115,7 @@ static gboolean gst_data_repo_src_start (GstBaseSrc * basesrc);
 static gboolean gst_data_repo_src_stop (GstBaseSrc * basesrc);
 static GstFlowReturn gst_data_repo_src_create (GstPushSrc * pushsrc,
     GstBuffer ** buffer);
+static void gst_data_repo_src_stop_prefetch (GstDataRepoSrc * src);
 
 #define _do_init \
   GST_DEBUG_CATEGORY_INIT (gst_data_repo_src_debug, "datareposrc", 0, "datareposrc element");
@@ -111,6 +146,73 @@ gst_data_repo_src_class_init (GstDataRepoSrcClass * klass)
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
           GST_PARAM_MUTABLE_READY));
 
+  g_object_class_install_property (gobject_class, PROP_USE_MMAP,
+      g_param_spec_boolean ("use-mmap", "Use mmap",
+          "Map the file into memory and push each sample wrapping the mapped "
+          "region without copying, the page cache is shared with other readers",
+          DEFAULT_USE_MMAP,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_EPOCHS,
+      g_param_spec_uint ("epochs", "Epochs",
+          "The number of passes over the samples", 1, G_MAXUINT,
+          DEFAULT_EPOCHS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_SHUFFLE,
+      g_param_spec_boolean ("shuffle", "Shuffle",
+          "Read the samples in random order, shuffled again for each epoch",
+          DEFAULT_SHUFFLE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_START_SAMPLE_INDEX,
+      g_param_spec_uint ("start-sample-index", "Start sample index",
+          "The index of the first sample to read", 0, G_MAXUINT,
+          DEFAULT_START_SAMPLE_INDEX,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_STOP_SAMPLE_INDEX,
+      g_param_spec_uint ("stop-sample-index", "Stop sample index",
+          "The index of the last sample to read (0 for the last sample of the file)",
+          0, G_MAXUINT, DEFAULT_STOP_SAMPLE_INDEX,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_PREFETCH,
+      g_param_spec_uint ("prefetch", "Prefetch",
+          "The number of samples read ahead in a background thread (0 to read in the streaming thread)",
+          0, G_MAXUINT, DEFAULT_PREFETCH,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_TENSORS_SEQUENCE,
+      g_param_spec_string ("tensors-sequence", "Tensors sequence",
+          "Comma-separated indexes of the tensors to read from each sample "
+          "(e.g., 1 to read the labels only), all tensors if not given",
+          NULL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_NUM_READERS,
+      g_param_spec_uint ("num-readers", "Number of readers",
+          "The number of threads reading the shard files concurrently, "
+          "valid if the location is the pattern of the shard files (e.g., data-%05d.bin)",
+          1, 256, DEFAULT_NUM_READERS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
+  g_object_class_install_property (gobject_class, PROP_CACHE_SIZE,
+      g_param_spec_uint64 ("cache-size", "Cache size",
+          "Max bytes of the samples kept in memory after the first epoch, "
+          "the next epochs push the cached samples without reading the file "
+          "(0 to disable)", 0, G_MAXUINT64, DEFAULT_CACHE_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS |
+          GST_PARAM_MUTABLE_READY));
+
   gobject_class->finalize = gst_data_repo_src_finalize;
 
   gst_element_class_set_static_metadata (gstelement_class,
@@ -140,6 +242,41 @@ gst_data_repo_src_init (GstDataRepoSrc * src)
   src->fd = 0;
   src->offset = 0;
   src->read_position = 0;
+  src->use_mmap = DEFAULT_USE_MMAP;
+  src->mapped = NULL;
+  src->epochs = DEFAULT_EPOCHS;
+  src->shuffle = DEFAULT_SHUFFLE;
+  src->start_sample_index = DEFAULT_START_SAMPLE_INDEX;
+  src->stop_sample_index = DEFAULT_STOP_SAMPLE_INDEX;
+  src->prefetch = DEFAULT_PREFETCH;
+  src->sample_size = 0;
+  src->total_samples = 0;
+  src->order = g_array_new (FALSE, FALSE, sizeof (guint));
+  src->order_pos = 0;
+  src->cur_epoch = 0;
+  src->rand = g_rand_new ();
+  src->prefetch_threads = NULL;
+  src->prefetch_depth = 0;
+  src->num_active_readers = 0;
+  src->shards = NULL;
+  src->num_readers = DEFAULT_NUM_READERS;
+  src->tensors_seq = NULL;
+  src->num_items = 0;
+  src->num_tensors = 0;
+  src->index_offset = 0;
+  src->index = NULL;
+  src->index_buf = NULL;
+  src->file_size = 0;
+  src->cache = NULL;
+  src->cache_base = 0;
+  src->cache_used = 0;
+  src->cache_hits = 0;
+  src->cache_size = DEFAULT_CACHE_SIZE;
+  g_mutex_init (&src->prefetch_lock);
+  g_cond_init (&src->prefetch_cond);
+  g_queue_init (&src->prefetch_queue);
+  src->prefetch_running = FALSE;
+  src->prefetch_ret = GST_FLOW_OK;
 
   /* for test */
   src->length = 3176;           /* Calculation is required using property, 3176 is MNIST size */
@@ -157,6 +294,11 @@ gst_data_repo_src_finalize (GObject * object)
   GstDataRepoSrc *src = GST_DATA_REPO_SRC (object);
 
   g_free (src->filename);
+  g_free (src->tensors_seq);
+  g_array_free (src->order, TRUE);
+  g_rand_free (src->rand);
+  g_mutex_clear (&src->prefetch_lock);
+  g_cond_clear (&src->prefetch_cond);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -222,6 +364,34 @@ gst_data_repo_src_set_property (GObject * object, guint prop_id,
     case PROP_LOCATION:
       gst_data_repo_src_set_location (src, g_value_get_string (value), NULL);
       break;
+    case PROP_USE_MMAP:
+      src->use_mmap = g_value_get_boolean (value);
+      break;
+    case PROP_EPOCHS:
+      src->epochs = g_value_get_uint (value);
+      break;
+    case PROP_SHUFFLE:
+      src->shuffle = g_value_get_boolean (value);
+      break;
+    case PROP_START_SAMPLE_INDEX:
+      src->start_sample_index = g_value_get_uint (value);
+      break;
+    case PROP_STOP_SAMPLE_INDEX:
+      src->stop_sample_index = g_value_get_uint (value);
+      break;
+    case PROP_PREFETCH:
+      src->prefetch = g_value_get_uint (value);
+      break;
+    case PROP_NUM_READERS:
+      src->num_readers = g_value_get_uint (value);
+      break;
+    case PROP_TENSORS_SEQUENCE:
+      g_free (src->tensors_seq);
+      src->tensors_seq = g_value_dup_string (value);
+      break;
+    case PROP_CACHE_SIZE:
+      src->cache_size = g_value_get_uint64 (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -245,6 +415,33 @@ gst_data_repo_src_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_LOCATION:
       g_value_set_string (value, src->filename);
       break;
+    case PROP_USE_MMAP:
+      g_value_set_boolean (value, src->use_mmap);
+      break;
+    case PROP_EPOCHS:
+      g_value_set_uint (value, src->epochs);
+      break;
+    case PROP_SHUFFLE:
+      g_value_set_boolean (value, src->shuffle);
+      break;
+    case PROP_START_SAMPLE_INDEX:
+      g_value_set_uint (value, src->start_sample_index);
+      break;
+    case PROP_STOP_SAMPLE_INDEX:
+      g_value_set_uint (value, src->stop_sample_index);
+      break;
+    case PROP_PREFETCH:
+      g_value_set_uint (value, src->prefetch);
+      break;
+    case PROP_NUM_READERS:
+      g_value_set_uint (value, src->num_readers);
+      break;
+    case PROP_TENSORS_SEQUENCE:
+      g_value_set_string (value, src->tensors_seq);
+      break;
+    case PROP_CACHE_SIZE:
+      g_value_set_uint64 (value, src->cache_size);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -336,43 +533,189 @@ error:
 }
 #endif
 /**
- * @brief Function to read tensors
+ * @brief Release the reference of the mapped file, unmap it with the last reference.
+ */
+static void
+gst_data_repo_src_mmap_unref (GstDataRepoMmap * mapped)
+{
+  if (g_atomic_int_dec_and_test (&mapped->refcount)) {
+    munmap (mapped->addr, mapped->size);
+    g_free (mapped);
+  }
+}
+
+/**
+ * @brief Map the opened file into memory.
+ */
+static gboolean
+gst_data_repo_src_mmap_file (GstDataRepoSrc * src, gsize size)
+{
+  GstDataRepoMmap *mapped;
+  void *addr;
+
+  if (size == 0) {
+    GST_WARNING_OBJECT (src, "Cannot map the empty file %s", src->filename);
+    return FALSE;
+  }
+
+  addr = mmap (NULL, size, PROT_READ, MAP_SHARED, src->fd, 0);
+  if (addr == MAP_FAILED) {
+    GST_WARNING_OBJECT (src, "Failed to map the file %s: %s", src->filename,
+        g_strerror (errno));
+    return FALSE;
+  }
+
+  if (madvise (addr, size, src->shuffle ? MADV_RANDOM : MADV_SEQUENTIAL) != 0)
+    GST_DEBUG_OBJECT (src, "madvise is not available: %s", g_strerror (errno));
+
+  mapped = g_new0 (GstDataRepoMmap, 1);
+  mapped->refcount = 1;
+  mapped->addr = addr;
+  mapped->size = size;
+  src->mapped = mapped;
+
+  return TRUE;
+}
+
+/**
+ * @brief Get the offset and size of the n-th selected tensor of the sample.
+ */
+static gboolean
+gst_data_repo_src_get_item (GstDataRepoSrc * src, guint index, guint n,
+    guint64 * offset, guint64 * size)
+{
+  guint item = src->items[n];
+  guint i;
+
+  if (src->index) {
+    const GstDataRepoIndexEntry *entry =
+        &src->index[(gsize) index * src->num_tensors + item];
+
+    *offset = GUINT64_FROM_LE (entry->offset);
+    *size = GUINT64_FROM_LE (entry->size);
+  } else {
+    *offset = (guint64) src->sample_size * index;
+    for (i = 0; i < item; i++)
+      *offset += src->item_size[i];
+    *size = src->item_size[item];
+  }
+
+  if (*offset > src->file_size || *size > src->file_size - *offset ||
+      *size > G_MAXUINT) {
+    GST_ERROR_OBJECT (src, "Tensor %u of sample %u is out of the file", item,
+        index);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Issue the read-ahead of the samples to be read next in mmap mode.
+ */
+static void
+gst_data_repo_src_mmap_read_ahead (GstDataRepoSrc * src)
+{
+  GstDataRepoMmap *mapped = src->mapped;
+  const gsize page_mask = (gsize) sysconf (_SC_PAGESIZE) - 1;
+  guint i, n, pos;
+
+  for (i = 0, pos = src->order_pos;
+      i < MMAP_READ_AHEAD_SAMPLES && pos < src->order->len; i++, pos++) {
+    guint index = g_array_index (src->order, guint, pos);
+
+    for (n = 0; n < src->num_items; n++) {
+      guint64 offset, size;
+      gsize aligned;
+
+      if (!gst_data_repo_src_get_item (src, index, n, &offset, &size))
+        continue;
+
+      /* madvise requires the page-aligned address */
+      aligned = (gsize) offset & ~page_mask;
+      madvise (mapped->addr + aligned, (gsize) (offset - aligned + size),
+          MADV_WILLNEED);
+    }
+  }
+}
+
+/**
+ * @brief Function to read the sample of the index from the mapped file, each memory wraps the mapped region.
  */
 static GstFlowReturn
-gst_data_repo_src_read_tensors (GstDataRepoSrc * src, GstBuffer ** buffer)
+gst_data_repo_src_read_tensors_mmap (GstDataRepoSrc * src, guint index,
+    GstBuffer ** buffer)
 {
-  int i = 0;
+  GstDataRepoMmap *mapped = src->mapped;
+  guint64 offset, size;
+  GstBuffer *buf;
+  guint i;
+
+  buf = gst_buffer_new ();
+  for (i = 0; i < src->num_items; i++) {
+    if (!gst_data_repo_src_get_item (src, index, i, &offset, &size)) {
+      gst_buffer_unref (buf);
+      return GST_FLOW_ERROR;
+    }
+
+    g_atomic_int_inc (&mapped->refcount);
+    gst_buffer_append_memory (buf,
+        gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY, mapped->addr,
+            mapped->size, (gsize) offset, (gsize) size, mapped,
+            (GDestroyNotify) gst_data_repo_src_mmap_unref));
+
+    src->read_position += size;
+    src->offset = offset + size;
+  }
+
+  gst_data_repo_src_mmap_read_ahead (src);
+
+  *buffer = buf;
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Function to read the sample of the index
+ */
+static GstFlowReturn
+gst_data_repo_src_read_tensors (GstDataRepoSrc * src, guint index,
+    GstBuffer ** buffer)
+{
+  guint i = 0;
   GstBuffer *buf;
   guint to_read, byte_read;
   int ret;
   guint8 *data;
+  guint64 offset, size;
   GstMemory *mem[MAX_ITEM] = { 0, };
   GstMapInfo info[MAX_ITEM];
 
-  /* for MNIST test */
-  src->item_size[0] = 3136;
-  src->item_size[1] = 40;
-
   buf = gst_buffer_new ();
 
-  for (i = 0; i < 2; i++) {
-    mem[i] = gst_allocator_alloc (NULL, src->item_size[i], NULL);
+  for (i = 0; i < src->num_items; i++) {
+    if (!gst_data_repo_src_get_item (src, index, i, &offset, &size))
+      goto error;
+
+    src->offset = offset;
+    mem[i] = gst_allocator_alloc (NULL, (gsize) size, NULL);
 
     if (!gst_memory_map (mem[i], &info[i], GST_MAP_WRITE)) {
       GST_ERROR_OBJECT (src, "Could not map in_mem[%d] GstMemory", i);
+      gst_memory_unref (mem[i]);
       goto error;
     }
 
     data = info[i].data;
 
     byte_read = 0;
-    to_read = src->item_size[i];
+    to_read = (guint) size;
     while (to_read > 0) {
       GST_LOG_OBJECT (src,
           "Reading %d bytes at offset 0x%" G_GINT64_MODIFIER "x", to_read,
           src->offset + byte_read);
       errno = 0;
-      ret = read (src->fd, data + byte_read, to_read);
+      /* read at the offset of the sample, the samples may be read in random order */
+      ret = pread (src->fd, data + byte_read, to_read, src->offset + byte_read);
       GST_LOG_OBJECT (src, "Read: %d", ret);
       if (ret < 0) {
         if (errno == EAGAIN || errno == EINTR)
@@ -390,11 +733,10 @@ gst_data_repo_src_read_tensors (GstDataRepoSrc * src, GstBuffer ** buffer)
       byte_read += ret;
 
       src->read_position += ret;
-      src->offset += ret;
     }
+    src->offset += byte_read;
 
-    if (mem[i])
-      gst_memory_unmap (mem[i], &info[i]);
+    gst_memory_unmap (mem[i], &info[i]);
 
     /* TODO */
     /*if (bytes_read != length) */
@@ -410,14 +752,16 @@ gst_data_repo_src_read_tensors (GstDataRepoSrc * src, GstBuffer ** buffer)
 could_not_read:
   {
     GST_ELEMENT_ERROR (src, RESOURCE, READ, (NULL), GST_ERROR_SYSTEM);
-    gst_memory_unmap (mem[0], &info[0]);
+    gst_memory_unmap (mem[i], &info[i]);
+    gst_memory_unref (mem[i]);
     gst_buffer_unref (buf);
     return GST_FLOW_ERROR;
   }
 eos:
   {
     GST_DEBUG ("EOS");
-    gst_memory_unmap (mem[0], &info[0]);
+    gst_memory_unmap (mem[i], &info[i]);
+    gst_memory_unref (mem[i]);
     gst_buffer_unref (buf);
     return GST_FLOW_EOS;
   }
@@ -426,6 +770,706 @@ error:
   return GST_FLOW_ERROR;
 }
 
+/**
+ * @brief Select the tensors to read with the property tensors-sequence (e.g., "1" or "1,0"), all tensors if it is not given.
+ */
+static gboolean
+gst_data_repo_src_parse_tensors_sequence (GstDataRepoSrc * src,
+    guint num_tensors)
+{
+  gchar **seq;
+  guint i;
+
+  src->num_items = 0;
+  if (src->tensors_seq == NULL || src->tensors_seq[0] == '\0') {
+    for (i = 0; i < num_tensors; i++)
+      src->items[src->num_items++] = i;
+    return TRUE;
+  }
+
+  seq = g_strsplit (src->tensors_seq, ",", -1);
+  for (i = 0; seq[i] != NULL; i++) {
+    gchar *end = NULL;
+    guint64 item = g_ascii_strtoull (g_strstrip (seq[i]), &end, 10);
+
+    if (end == seq[i] || *end != '\0' || item >= num_tensors ||
+        src->num_items >= MAX_ITEM) {
+      GST_ELEMENT_ERROR (src, RESOURCE, SETTINGS,
+          ("Invalid tensors-sequence \"%s\", the sample has %u tensors.",
+              src->tensors_seq, num_tensors), (NULL));
+      g_strfreev (seq);
+      return FALSE;
+    }
+
+    src->items[src->num_items++] = (guint) item;
+  }
+  g_strfreev (seq);
+
+  return (src->num_items > 0);
+}
+
+/**
+ * @brief Detect the indexed container and read its header, or use the raw samples of the fixed size.
+ */
+static gboolean
+gst_data_repo_src_read_header (GstDataRepoSrc * src)
+{
+  GstDataRepoFileHdr hdr;
+  guint64 num_entries;
+
+  src->num_tensors = 0;
+  src->index_offset = 0;
+
+  if (src->file_size < sizeof (hdr) ||
+      pread (src->fd, &hdr, sizeof (hdr), 0) != (ssize_t) sizeof (hdr) ||
+      GUINT32_FROM_LE (hdr.magic) != GST_DATA_REPO_MAGIC) {
+    /* for MNIST test */
+    src->item_size[0] = 3136;
+    src->item_size[1] = 40;
+    src->sample_size = src->item_size[0] + src->item_size[1];
+    src->total_samples = (guint) MIN (src->file_size / src->sample_size,
+        G_MAXUINT);
+    return gst_data_repo_src_parse_tensors_sequence (src, 2);
+  }
+
+  src->num_tensors = GUINT32_FROM_LE (hdr.num_tensors);
+  src->index_offset = GUINT64_FROM_LE (hdr.index_offset);
+  num_entries = GUINT64_FROM_LE (hdr.num_samples) * src->num_tensors;
+
+  if (GUINT32_FROM_LE (hdr.version) != GST_DATA_REPO_VERSION ||
+      src->num_tensors == 0 || src->num_tensors > MAX_ITEM ||
+      GUINT64_FROM_LE (hdr.num_samples) > G_MAXUINT ||
+      (src->index_offset % 8) != 0 || src->index_offset > src->file_size ||
+      num_entries > (src->file_size - src->index_offset) /
+      sizeof (GstDataRepoIndexEntry)) {
+    GST_ELEMENT_ERROR (src, RESOURCE, OPEN_READ,
+        (("Invalid header of the data repository \"%s\"."), src->filename),
+        (NULL));
+    return FALSE;
+  }
+
+  src->total_samples = (guint) GUINT64_FROM_LE (hdr.num_samples);
+  GST_INFO_OBJECT (src, "Indexed data repository, %u samples of %u tensors "
+      "(%s layout)", src->total_samples, src->num_tensors,
+      GUINT32_FROM_LE (hdr.layout) == GST_DATA_REPO_LAYOUT_COLUMN ?
+      "column" : "row");
+
+  return gst_data_repo_src_parse_tensors_sequence (src, src->num_tensors);
+}
+
+/**
+ * @brief Load the index of the container, use the mapped index if the file is mapped.
+ */
+static gboolean
+gst_data_repo_src_load_index (GstDataRepoSrc * src)
+{
+  gsize size;
+
+  if (src->num_tensors == 0)
+    return TRUE;
+
+  size = (gsize) src->total_samples * src->num_tensors *
+      sizeof (GstDataRepoIndexEntry);
+
+  if (src->mapped) {
+    src->index = (const GstDataRepoIndexEntry *)
+        (src->mapped->addr + src->index_offset);
+    return TRUE;
+  }
+
+  src->index_buf = g_try_malloc (MAX (size, 1));
+  if (!src->index_buf ||
+      pread (src->fd, src->index_buf, size, src->index_offset) !=
+      (ssize_t) size) {
+    GST_ELEMENT_ERROR (src, RESOURCE, READ,
+        (("Could not read the index of \"%s\"."), src->filename),
+        GST_ERROR_SYSTEM);
+    g_free (src->index_buf);
+    src->index_buf = NULL;
+    return FALSE;
+  }
+
+  src->index = (const GstDataRepoIndexEntry *) src->index_buf;
+  return TRUE;
+}
+
+/**
+ * @brief Shuffle the sample order of the epoch (Fisher-Yates).
+ */
+static void
+gst_data_repo_src_shuffle (GstDataRepoSrc * src)
+{
+  guint i, j, tmp;
+
+  if (!src->shuffle || src->order->len < 2)
+    return;
+
+  for (i = src->order->len - 1; i > 0; i--) {
+    j = (guint) g_rand_int_range (src->rand, 0, (gint32) i + 1);
+    tmp = g_array_index (src->order, guint, i);
+    g_array_index (src->order, guint, i) = g_array_index (src->order, guint, j);
+    g_array_index (src->order, guint, j) = tmp;
+  }
+}
+
+/**
+ * @brief Fill the sample order with the range of the samples, and shuffle it for the first epoch.
+ */
+static gboolean
+gst_data_repo_src_init_order (GstDataRepoSrc * src)
+{
+  guint start = src->start_sample_index;
+  guint stop = src->stop_sample_index;
+  guint i;
+
+  if (src->total_samples == 0) {
+    GST_ELEMENT_ERROR (src, RESOURCE, OPEN_READ,
+        (("\"%s\" has no sample."), src->filename), (NULL));
+    return FALSE;
+  }
+
+  if (stop == 0)
+    stop = src->total_samples - 1;
+
+  if (start > stop || stop >= src->total_samples) {
+    GST_ELEMENT_ERROR (src, RESOURCE, SETTINGS,
+        ("Invalid sample index range [%u, %u], the file has %u samples.",
+            start, stop, src->total_samples), (NULL));
+    return FALSE;
+  }
+
+  g_array_set_size (src->order, 0);
+  for (i = start; i <= stop; i++)
+    g_array_append_val (src->order, i);
+
+  src->order_pos = 0;
+  src->cur_epoch = 0;
+  gst_data_repo_src_shuffle (src);
+
+  GST_INFO_OBJECT (src, "Read samples [%u, %u] for %u epoch(s)%s", start,
+      stop, src->epochs, src->shuffle ? " in shuffled order" : "");
+  return TRUE;
+}
+
+/**
+ * @brief Prepare the sample cache, used only if the samples are read again in the next epochs.
+ */
+static void
+gst_data_repo_src_init_cache (GstDataRepoSrc * src)
+{
+  src->cache_used = 0;
+  src->cache_hits = 0;
+
+  /* the mapped file is already in memory */
+  if (src->cache_size == 0 || src->epochs < 2 || src->mapped)
+    return;
+
+  /* the order holds the range [start-sample-index, stop-sample-index] */
+  src->cache_base = src->start_sample_index;
+  src->cache = g_ptr_array_new_full (src->order->len,
+      (GDestroyNotify) gst_buffer_unref);
+  g_ptr_array_set_size (src->cache, src->order->len);
+}
+
+/**
+ * @brief Release the cached samples.
+ */
+static void
+gst_data_repo_src_clear_cache (GstDataRepoSrc * src)
+{
+  if (!src->cache)
+    return;
+
+  GST_INFO_OBJECT (src, "Pushed %" G_GUINT64_FORMAT " samples from the cache "
+      "of %" G_GUINT64_FORMAT " bytes", src->cache_hits, src->cache_used);
+  g_ptr_array_free (src->cache, TRUE);
+  src->cache = NULL;
+  src->cache_used = 0;
+}
+
+/**
+ * @brief Keep the sample read in the first epoch if the cache has the space.
+ */
+static void
+gst_data_repo_src_cache_store (GstDataRepoSrc * src, guint index,
+    GstBuffer * buffer)
+{
+  gsize size = gst_buffer_get_size (buffer);
+
+  if (src->cache_used + size > src->cache_size)
+    return;
+
+  /* the memories are shared with the pushed buffer by refcount */
+  g_ptr_array_index (src->cache, index - src->cache_base) =
+      gst_buffer_ref (buffer);
+  src->cache_used += size;
+}
+
+/**
+ * @brief Read the next sample in the order of the epoch, start the next epoch at the end of the order.
+ */
+static GstFlowReturn
+gst_data_repo_src_read_next (GstDataRepoSrc * src, GstBuffer ** buffer)
+{
+  GstFlowReturn ret;
+  GstBuffer *cached;
+  guint index;
+
+  if (src->order_pos >= src->order->len) {
+    if (++src->cur_epoch >= src->epochs) {
+      GST_DEBUG_OBJECT (src, "EOS after %u epoch(s)", src->cur_epoch);
+      return GST_FLOW_EOS;
+    }
+
+    GST_INFO_OBJECT (src, "Start epoch %u", src->cur_epoch);
+    gst_data_repo_src_shuffle (src);
+    src->order_pos = 0;
+  }
+
+  index = g_array_index (src->order, guint, src->order_pos++);
+
+  if (src->mapped)
+    return gst_data_repo_src_read_tensors_mmap (src, index, buffer);
+
+  if (src->cache) {
+    cached = g_ptr_array_index (src->cache, index - src->cache_base);
+    if (cached) {
+      /* new buffer for the metadata, the memories are not copied */
+      *buffer = gst_buffer_copy (cached);
+      src->cache_hits++;
+      return GST_FLOW_OK;
+    }
+  }
+
+  ret = gst_data_repo_src_read_tensors (src, index, buffer);
+  if (ret == GST_FLOW_OK && src->cache && src->cur_epoch == 0)
+    gst_data_repo_src_cache_store (src, index, *buffer);
+
+  return ret;
+}
+
+/**
+ * @brief The prefetch thread, reads the samples ahead in the order of the epoch.
+ */
+static gpointer
+gst_data_repo_src_prefetch_thread (gpointer data)
+{
+  GstDataRepoSrc *src = GST_DATA_REPO_SRC (data);
+  GstFlowReturn ret = GST_FLOW_OK;
+  GstBuffer *buf;
+
+  while (ret == GST_FLOW_OK) {
+    g_mutex_lock (&src->prefetch_lock);
+    while (src->prefetch_running &&
+        g_queue_get_length (&src->prefetch_queue) >= src->prefetch_depth)
+      g_cond_wait (&src->prefetch_cond, &src->prefetch_lock);
+
+    if (!src->prefetch_running) {
+      g_mutex_unlock (&src->prefetch_lock);
+      break;
+    }
+    g_mutex_unlock (&src->prefetch_lock);
+
+    buf = NULL;
+    ret = gst_data_repo_src_read_next (src, &buf);
+
+    g_mutex_lock (&src->prefetch_lock);
+    if (ret == GST_FLOW_OK)
+      g_queue_push_tail (&src->prefetch_queue, buf);
+    else
+      src->prefetch_ret = ret;
+    g_cond_broadcast (&src->prefetch_cond);
+    g_mutex_unlock (&src->prefetch_lock);
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Shard file of the sharded dataset.
+ */
+typedef struct
+{
+  gchar *path;
+  gint fd;
+  guint num_samples;
+  guint next;                   /**< next sample to read, protected by prefetch_lock */
+} GstDataRepoShard;
+
+/**
+ * @brief Reader thread of the sharded dataset.
+ */
+typedef struct
+{
+  GstDataRepoSrc *src;
+  guint home;                   /**< index of the shard to read first */
+} GstDataRepoShardReader;
+
+/**
+ * @brief Release the shard file.
+ */
+static void
+gst_data_repo_src_shard_free (gpointer data)
+{
+  GstDataRepoShard *shard = (GstDataRepoShard *) data;
+
+  if (shard->fd >= 0)
+    close (shard->fd);
+  g_free (shard->path);
+  g_free (shard);
+}
+
+/**
+ * @brief Check whether the location is the pattern of the shard files (e.g., data-%05d.bin).
+ */
+static gboolean
+gst_data_repo_src_is_sharded (GstDataRepoSrc * src)
+{
+  return (src->filename != NULL && strchr (src->filename, '%') != NULL);
+}
+
+/**
+ * @brief Get the path of the shard from the pattern having a decimal conversion (%d, %5d or %05d).
+ * @return Newly allocated path, or NULL if the pattern is invalid.
+ */
+static gchar *
+gst_data_repo_src_get_shard_path (const gchar * pattern, guint index)
+{
+  const gchar *conv = strchr (pattern, '%');
+  const gchar *p = conv + 1;
+  gboolean zero_pad = FALSE;
+  guint width = 0;
+  gchar *prefix, *path;
+
+  if (*p == '0') {
+    zero_pad = TRUE;
+    p++;
+  }
+
+  while (g_ascii_isdigit (*p))
+    width = width * 10 + (*p++ - '0');
+
+  if ((*p != 'd' && *p != 'u') || width > 32 || strchr (p, '%') != NULL)
+    return NULL;
+
+  prefix = g_strndup (pattern, conv - pattern);
+  if (zero_pad)
+    path = g_strdup_printf ("%s%0*u%s", prefix, (gint) width, index, p + 1);
+  else
+    path = g_strdup_printf ("%s%*u%s", prefix, (gint) width, index, p + 1);
+  g_free (prefix);
+
+  return path;
+}
+
+/**
+ * @brief Open the shard files, from index 0 until the file does not exist.
+ */
+static gboolean
+gst_data_repo_src_open_shards (GstDataRepoSrc * src)
+{
+  guint64 total = 0;
+  guint i;
+
+  src->shards = g_ptr_array_new_with_free_func (gst_data_repo_src_shard_free);
+
+  for (i = 0;; i++) {
+    struct_stat stat_results;
+    GstDataRepoShard *shard;
+    gchar *path = gst_data_repo_src_get_shard_path (src->filename, i);
+
+    if (!path) {
+      GST_ELEMENT_ERROR (src, RESOURCE, SETTINGS,
+          ("Invalid pattern of the shard files \"%s\".", src->filename),
+          (NULL));
+      return FALSE;
+    }
+
+    if (!g_file_test (path, G_FILE_TEST_IS_REGULAR)) {
+      g_free (path);
+      break;
+    }
+
+    shard = g_new0 (GstDataRepoShard, 1);
+    shard->path = path;
+    shard->fd = g_open (path, O_RDONLY | O_BINARY, 0);
+    g_ptr_array_add (src->shards, shard);
+
+    if (shard->fd < 0 || fstat (shard->fd, &stat_results) < 0) {
+      GST_ELEMENT_ERROR (src, RESOURCE, OPEN_READ,
+          (("Could not open file \"%s\" for reading."), path),
+          GST_ERROR_SYSTEM);
+      return FALSE;
+    }
+
+    shard->num_samples = (guint) MIN ((guint64) stat_results.st_size /
+        src->sample_size, G_MAXUINT);
+    total += shard->num_samples;
+  }
+
+  if (total == 0) {
+    GST_ELEMENT_ERROR (src, RESOURCE, NOT_FOUND, (NULL),
+        ("No sample in the shard files \"%s\"", src->filename));
+    return FALSE;
+  }
+
+  src->total_samples = (guint) MIN (total, G_MAXUINT);
+  GST_INFO_OBJECT (src, "%u shard(s) of %s, %u samples", src->shards->len,
+      src->filename, src->total_samples);
+  return TRUE;
+}
+
+/**
+ * @brief Pick the shard and the sample to read next, called with prefetch_lock.
+ * @note The reader steals the work from the shard having the most remaining samples when its shard is done.
+ */
+static GstDataRepoShard *
+gst_data_repo_src_pick_shard (GstDataRepoSrc * src, guint home, guint * index)
+{
+  GstDataRepoShard *shard;
+  guint i, remain, max_remain = 0;
+
+  shard = g_ptr_array_index (src->shards, home % src->shards->len);
+  if (shard->next >= shard->num_samples) {
+    shard = NULL;
+
+    for (i = 0; i < src->shards->len; i++) {
+      GstDataRepoShard *s = g_ptr_array_index (src->shards, i);
+
+      remain = s->num_samples - s->next;
+      if (remain > max_remain) {
+        max_remain = remain;
+        shard = s;
+      }
+    }
+  }
+
+  if (!shard) {
+    /* all shards are done, start the next epoch */
+    if (src->cur_epoch + 1 >= src->epochs)
+      return NULL;
+
+    src->cur_epoch++;
+    GST_INFO_OBJECT (src, "Start epoch %u", src->cur_epoch);
+    for (i = 0; i < src->shards->len; i++)
+      ((GstDataRepoShard *) g_ptr_array_index (src->shards, i))->next = 0;
+
+    return gst_data_repo_src_pick_shard (src, home, index);
+  }
+
+  *index = shard->next++;
+  return shard;
+}
+
+/**
+ * @brief Read the sample of the index from the shard file, thread-safe.
+ */
+static GstFlowReturn
+gst_data_repo_src_read_shard_sample (GstDataRepoSrc * src,
+    GstDataRepoShard * shard, guint index, GstBuffer ** buffer)
+{
+  guint64 offset = (guint64) src->sample_size * index;
+  GstBuffer *buf = gst_buffer_new ();
+  GstMapInfo info;
+  GstMemory *mem;
+  gsize byte_read;
+  ssize_t ret;
+  int i;
+
+  for (i = 0; i < 2; i++) {
+    mem = gst_allocator_alloc (NULL, src->item_size[i], NULL);
+    if (!gst_memory_map (mem, &info, GST_MAP_WRITE)) {
+      gst_memory_unref (mem);
+      gst_buffer_unref (buf);
+      return GST_FLOW_ERROR;
+    }
+
+    byte_read = 0;
+    while (byte_read < info.size) {
+      ret = pread (shard->fd, info.data + byte_read, info.size - byte_read,
+          offset + byte_read);
+      if (ret < 0 && (errno == EAGAIN || errno == EINTR))
+        continue;
+
+      if (ret <= 0) {
+        if (ret < 0)
+          GST_ELEMENT_ERROR (src, RESOURCE, READ, (NULL), GST_ERROR_SYSTEM);
+        gst_memory_unmap (mem, &info);
+        gst_memory_unref (mem);
+        gst_buffer_unref (buf);
+        return (ret < 0) ? GST_FLOW_ERROR : GST_FLOW_EOS;
+      }
+
+      byte_read += ret;
+    }
+
+    offset += byte_read;
+    gst_memory_unmap (mem, &info);
+    gst_buffer_append_memory (buf, mem);
+  }
+
+  *buffer = buf;
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief The reader thread of the sharded dataset, interleaves the samples of the shards into the queue.
+ */
+static gpointer
+gst_data_repo_src_shard_reader_thread (gpointer data)
+{
+  GstDataRepoShardReader *reader = (GstDataRepoShardReader *) data;
+  GstDataRepoSrc *src = reader->src;
+  GstFlowReturn ret = GST_FLOW_OK;
+  GstDataRepoShard *shard;
+  GstBuffer *buf;
+  guint index;
+
+  g_mutex_lock (&src->prefetch_lock);
+  while (ret == GST_FLOW_OK) {
+    while (src->prefetch_running &&
+        g_queue_get_length (&src->prefetch_queue) >= src->prefetch_depth)
+      g_cond_wait (&src->prefetch_cond, &src->prefetch_lock);
+
+    if (!src->prefetch_running)
+      break;
+
+    shard = gst_data_repo_src_pick_shard (src, reader->home, &index);
+    if (!shard)
+      break;
+    g_mutex_unlock (&src->prefetch_lock);
+
+    buf = NULL;
+    ret = gst_data_repo_src_read_shard_sample (src, shard, index, &buf);
+
+    g_mutex_lock (&src->prefetch_lock);
+    if (ret == GST_FLOW_OK) {
+      g_queue_push_tail (&src->prefetch_queue, buf);
+    } else {
+      GST_WARNING_OBJECT (src, "Failed to read sample %u of %s", index,
+          shard->path);
+      if (src->prefetch_ret == GST_FLOW_OK)
+        src->prefetch_ret = ret;
+    }
+    g_cond_broadcast (&src->prefetch_cond);
+  }
+
+  /* the last reader signals the end of the samples */
+  if (--src->num_active_readers == 0 && src->prefetch_ret == GST_FLOW_OK)
+    src->prefetch_ret = GST_FLOW_EOS;
+  g_cond_broadcast (&src->prefetch_cond);
+  g_mutex_unlock (&src->prefetch_lock);
+
+  g_free (reader);
+  return NULL;
+}
+
+/**
+ * @brief Start the prefetch threads, the reader threads of the shards or a thread reading ahead the single file.
+ */
+static gboolean
+gst_data_repo_src_start_prefetch (GstDataRepoSrc * src, guint num_threads)
+{
+  GError *err = NULL;
+  GThread *thread;
+  guint i;
+
+  g_queue_init (&src->prefetch_queue);
+  src->prefetch_ret = GST_FLOW_OK;
+  src->prefetch_running = TRUE;
+  src->num_active_readers = 0;
+  src->prefetch_threads = g_ptr_array_new ();
+
+  for (i = 0; i < num_threads; i++) {
+    g_mutex_lock (&src->prefetch_lock);
+    src->num_active_readers++;
+    g_mutex_unlock (&src->prefetch_lock);
+
+    if (src->shards) {
+      GstDataRepoShardReader *reader = g_new0 (GstDataRepoShardReader, 1);
+
+      reader->src = src;
+      reader->home = i;
+      thread = g_thread_try_new ("datareposrc-shard",
+          gst_data_repo_src_shard_reader_thread, reader, &err);
+      if (!thread)
+        g_free (reader);
+    } else {
+      thread = g_thread_try_new ("datareposrc-prefetch",
+          gst_data_repo_src_prefetch_thread, src, &err);
+    }
+
+    if (!thread) {
+      GST_ERROR_OBJECT (src, "Failed to create the prefetch thread: %s",
+          err ? err->message : "unknown");
+      g_clear_error (&err);
+
+      g_mutex_lock (&src->prefetch_lock);
+      src->num_active_readers--;
+      g_mutex_unlock (&src->prefetch_lock);
+      gst_data_repo_src_stop_prefetch (src);
+      return FALSE;
+    }
+
+    g_ptr_array_add (src->prefetch_threads, thread);
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Stop the prefetch threads and drop the prefetched samples.
+ */
+static void
+gst_data_repo_src_stop_prefetch (GstDataRepoSrc * src)
+{
+  guint i;
+
+  if (!src->prefetch_threads)
+    return;
+
+  g_mutex_lock (&src->prefetch_lock);
+  src->prefetch_running = FALSE;
+  g_cond_broadcast (&src->prefetch_cond);
+  g_mutex_unlock (&src->prefetch_lock);
+
+  for (i = 0; i < src->prefetch_threads->len; i++)
+    g_thread_join (g_ptr_array_index (src->prefetch_threads, i));
+  g_ptr_array_free (src->prefetch_threads, TRUE);
+  src->prefetch_threads = NULL;
+
+  g_queue_clear_full (&src->prefetch_queue, (GDestroyNotify) gst_buffer_unref);
+}
+
+/**
+ * @brief Start datareposrc with the shard files.
+ */
+static gboolean
+gst_data_repo_src_start_shards (GstDataRepoSrc * src)
+{
+  /* for MNIST test */
+  src->item_size[0] = 3136;
+  src->item_size[1] = 40;
+  src->sample_size = src->item_size[0] + src->item_size[1];
+  src->cur_epoch = 0;
+  src->fd = -1;
+
+  if (!gst_data_repo_src_open_shards (src))
+    goto error;
+
+  src->prefetch_depth = (src->prefetch > 0) ?
+      src->prefetch : src->num_readers * 2;
+  if (!gst_data_repo_src_start_prefetch (src, src->num_readers))
+    goto error;
+
+  return TRUE;
+
+error:
+  g_ptr_array_free (src->shards, TRUE);
+  src->shards = NULL;
+  return FALSE;
+}
+
 /**
  * @brief Function to create a buffer
  */
@@ -441,7 +1485,23 @@ gst_data_repo_src_create (GstPushSrc * pushsrc, GstBuffer ** buffer)
   /*case application/octet-stream */
   ret = gst_data_repo_src_read_octet_stream (src, buffer);
 #else
-  ret = gst_data_repo_src_read_tensors (src, buffer);
+  if (!src->prefetch_threads)
+    return gst_data_repo_src_read_next (src, buffer);
+
+  g_mutex_lock (&src->prefetch_lock);
+  while (src->prefetch_running && src->prefetch_ret == GST_FLOW_OK &&
+      g_queue_is_empty (&src->prefetch_queue))
+    g_cond_wait (&src->prefetch_cond, &src->prefetch_lock);
+
+  *buffer = g_queue_pop_head (&src->prefetch_queue);
+  if (*buffer)
+    ret = GST_FLOW_OK;
+  else if (!src->prefetch_running)
+    ret = GST_FLOW_FLUSHING;
+  else
+    ret = src->prefetch_ret;
+  g_cond_broadcast (&src->prefetch_cond);
+  g_mutex_unlock (&src->prefetch_lock);
 #endif
 
   return ret;
@@ -460,6 +1520,9 @@ gst_data_repo_src_start (GstBaseSrc * basesrc)
   if (src->filename == NULL || src->filename[0] == '\0')
     goto no_filename;
 
+  if (gst_data_repo_src_is_sharded (src))
+    return gst_data_repo_src_start_shards (src);
+
   GST_INFO_OBJECT (src, "opening file %s", src->filename);
 
   /* open the file */
@@ -483,6 +1546,28 @@ gst_data_repo_src_start (GstBaseSrc * basesrc)
     goto error_close;;
 
   src->read_position = 0;
+  src->offset = 0;
+  src->file_size = (guint64) stat_results.st_size;
+
+  if (!gst_data_repo_src_read_header (src))
+    goto error_close;
+
+  if (!gst_data_repo_src_init_order (src))
+    goto error_close;
+
+  if (src->use_mmap &&
+      !gst_data_repo_src_mmap_file (src, (gsize) stat_results.st_size)) {
+    GST_WARNING_OBJECT (src, "Fall back to read () from the file");
+  }
+
+  if (!gst_data_repo_src_load_index (src))
+    goto error_unmap;
+
+  gst_data_repo_src_init_cache (src);
+
+  src->prefetch_depth = src->prefetch;
+  if (src->prefetch > 0 && !gst_data_repo_src_start_prefetch (src, 1))
+    goto error_unmap;
 
   return TRUE;
 
@@ -527,6 +1612,12 @@ was_socket:
     goto error_close;
   }
 
+error_unmap:
+  gst_data_repo_src_clear_cache (src);
+  if (src->mapped) {
+    gst_data_repo_src_mmap_unref (src->mapped);
+    src->mapped = NULL;
+  }
 error_close:
   close (src->fd);
 error_exit:
@@ -541,6 +1632,26 @@ gst_data_repo_src_stop (GstBaseSrc * basesrc)
 {
   GstDataRepoSrc *src = GST_DATA_REPO_SRC (basesrc);
 
+  gst_data_repo_src_stop_prefetch (src);
+
+  if (src->shards) {
+    g_ptr_array_free (src->shards, TRUE);
+    src->shards = NULL;
+    return TRUE;
+  }
+
+  gst_data_repo_src_clear_cache (src);
+
+  src->index = NULL;
+  g_free (src->index_buf);
+  src->index_buf = NULL;
+
+  /* the memories of the pushed samples keep the mapping until they are released */
+  if (src->mapped) {
+    gst_data_repo_src_mmap_unref (src->mapped);
+    src->mapped = NULL;
+  }
+
   /* close the file */
   g_close (src->fd, NULL);
   src->fd = 0;
@@ -17,6 +17,7 @@
 #include <gst/gst.h>
 #include <gst/base/gstpushsrc.h>
 #include "tensor_typedef.h"
+#include "gstdatarepo_format.h"
 
 G_BEGIN_DECLS
 #define GST_TYPE_DATA_REPO_SRC \
@@ -33,6 +34,7 @@ G_BEGIN_DECLS
 #define MAX_ITEM NNS_TENSOR_SIZE_LIMIT
 
 typedef struct _GstDataRepoSrc GstDataRepoSrc;
+typedef struct _GstDataRepoMmap GstDataRepoMmap;
 typedef struct _GstDataRepoSrcClass GstDataRepoSrcClass;
 
 /**
@@ -46,10 +48,49 @@ struct _GstDataRepoSrc {
   guint64 read_position;		/**< position of fd */
   guint64 offset;
   guint item_size[MAX_ITEM];
+  GstDataRepoMmap *mapped;  /**< mapped file, shared by the memories of the samples */
+  guint sample_size;        /**< size of a sample */
+  guint total_samples;      /**< the number of samples in the file */
+
+  GArray *order;            /**< sample indexes of the epoch */
+  guint order_pos;          /**< position of the next sample in the order */
+  guint cur_epoch;          /**< current epoch */
+  GRand *rand;              /**< random generator to shuffle the order */
+
+  GPtrArray *prefetch_threads; /**< threads to read the samples ahead */
+  guint prefetch_depth;     /**< max number of the samples in the prefetch queue */
+  guint num_active_readers; /**< the number of running prefetch threads */
+  GPtrArray *shards;        /**< shard files of the sharded dataset */
+
+  guint64 file_size;        /**< size of the file */
+  guint items[MAX_ITEM];    /**< indexes of the tensors to read */
+  guint num_items;          /**< the number of tensors to read */
+  guint num_tensors;        /**< the number of tensors in a sample of the indexed data repository (0 for the raw samples) */
+  guint64 index_offset;     /**< offset of the index in the indexed data repository */
+  const GstDataRepoIndexEntry *index; /**< index of the tensors, NULL for the raw samples */
+  gpointer index_buf;       /**< index read from the file when the file is not mapped */
+  GPtrArray *cache;         /**< samples kept in memory for the next epochs, indexed from cache_base */
+  guint cache_base;         /**< the first sample index of the cache */
+  guint64 cache_used;       /**< bytes of the cached samples */
+  guint64 cache_hits;       /**< the number of samples pushed from the cache */
+  GMutex prefetch_lock;
+  GCond prefetch_cond;
+  GQueue prefetch_queue;    /**< samples read ahead */
+  gboolean prefetch_running;
+  GstFlowReturn prefetch_ret; /**< result of the prefetch thread, EOS or error */
 
   /* property */
   gchar *filename;          /**< filename */
   guint length;             /**< buffer size */
+  gboolean use_mmap;        /**< map the file and wrap each sample without copying */
+  guint epochs;             /**< the number of passes over the samples */
+  gboolean shuffle;         /**< shuffle the sample order of each epoch */
+  guint start_sample_index; /**< index of the first sample to read */
+  guint stop_sample_index;  /**< index of the last sample to read (0 for the last sample of the file) */
+  guint prefetch;           /**< the number of samples to read ahead in the prefetch thread (0 to disable) */
+  guint num_readers;        /**< the number of threads reading the shard files */
+  gchar *tensors_seq;       /**< indexes of the tensors to read */
+  guint64 cache_size;       /**< max bytes of the sample cache (0 to disable) */
 
 };
 
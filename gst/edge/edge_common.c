@@ -15,6 +15,8 @@
 #endif
 
 #include "edge_common.h"
+#include "nnstreamer_util.h"
+#include "../nnstreamer/nnstreamer_log.h"
 
 /**
  * @brief register GEnumValue array for edge protocol property handling
@@ -31,6 +33,11 @@ gst_edge_get_connect_type (void)
           "Connect with MQTT brokers and directly sending stream frames via TCP connections."},
       {NNS_EDGE_CONNECT_TYPE_AITT, "AITT",
           "Sending stream frames via AITT connections."},
+#ifdef ENABLE_NNSTREAMER_EDGE_CUSTOM
+      {NNS_EDGE_CONNECT_TYPE_CUSTOM, "CUSTOM",
+          "Sending stream frames via the connection loaded from custom-lib, "
+          "e.g., QUIC or UDP with FEC to avoid the head-of-line blocking of TCP."},
+#endif
       {0, NULL, NULL},
     };
     protocol = g_enum_register_static ("edge_protocol", protocols);
@@ -38,3 +45,103 @@ gst_edge_get_connect_type (void)
 
   return protocol;
 }
+
+/**
+ * @brief Create the edge handle, the connection of custom type is loaded from the library.
+ */
+int
+gst_edge_create_handle (nns_edge_connect_type_e connect_type,
+    const gchar * custom_lib, nns_edge_node_type_e node_type,
+    nns_edge_h * edge_h)
+{
+#ifdef ENABLE_NNSTREAMER_EDGE_CUSTOM
+  if (connect_type == NNS_EDGE_CONNECT_TYPE_CUSTOM) {
+    if (!custom_lib) {
+      nns_loge ("The custom-lib should be given for the custom connection.");
+      return NNS_EDGE_ERROR_INVALID_PARAMETER;
+    }
+
+    return nns_edge_custom_create_handle (NULL, custom_lib, node_type, edge_h);
+  }
+#else
+  UNUSED (custom_lib);
+#endif
+
+  return nns_edge_create_handle (NULL, connect_type, node_type, edge_h);
+}
+
+/**
+ * @brief Set the integer value to the info of the edge data.
+ */
+void
+gst_edge_data_set_int64 (nns_edge_data_h data_h, const gchar * key, gint64 val)
+{
+  gchar *str = g_strdup_printf ("%" G_GINT64_FORMAT, val);
+
+  nns_edge_data_set_info (data_h, key, str);
+  g_free (str);
+}
+
+/**
+ * @brief Get the integer value from the info of the edge data.
+ */
+gboolean
+gst_edge_data_get_int64 (nns_edge_data_h data_h, const gchar * key,
+    gint64 * val)
+{
+  gchar *str = NULL;
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get_info (data_h, key, &str))
+    return FALSE;
+
+  *val = g_ascii_strtoll (str, NULL, 10);
+  g_free (str);
+  return TRUE;
+}
+
+/**
+ * @brief Get the total size of the memories in the edge data.
+ */
+gsize
+gst_edge_data_get_size (nns_edge_data_h data_h)
+{
+  unsigned int i, num = 0;
+  void *data;
+  nns_size_t data_len;
+  gsize size = 0;
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get_count (data_h, &num))
+    return 0;
+
+  for (i = 0; i < num; i++) {
+    if (NNS_EDGE_ERROR_NONE == nns_edge_data_get (data_h, i, &data, &data_len))
+      size += data_len;
+  }
+
+  return size;
+}
+
+/**
+ * @brief Get the memory pressure of the memory budget.
+ */
+gint
+gst_edge_mem_budget_get_pressure (GstAllocator * budget)
+{
+  gint pressure = GST_EDGE_MEM_PRESSURE_NONE;
+
+  if (budget)
+    g_object_get (budget, "pressure", &pressure, NULL);
+
+  return pressure;
+}
+
+/**
+ * @brief Account the bytes held by the owner to the memory budget, negative to release.
+ */
+void
+gst_edge_mem_budget_account (GstAllocator * budget, gpointer owner,
+    gint64 bytes)
+{
+  if (budget && bytes != 0)
+    g_signal_emit_by_name (budget, "account", owner, bytes);
+}
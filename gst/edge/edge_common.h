@@ -27,11 +27,59 @@
 #define DEFAULT_CONNECT_TYPE (NNS_EDGE_CONNECT_TYPE_TCP)
 #define GST_TYPE_EDGE_CONNECT_TYPE (gst_edge_get_connect_type ())
 
+/**
+ * @brief Keys of the edge data info set by edgesink, for the jitter buffer of edgesrc.
+ */
+#define GST_EDGE_INFO_SEQ "edge_seq"
+#define GST_EDGE_INFO_TIMESTAMP "edge_ts"
+
+/**
+ * @brief The memory budget of nnstreamer, kept by the tensor allocator (GstTensorMemPressure).
+ * The edge plugin does not link nnstreamer, it finds the allocator by name.
+ */
+#define GST_EDGE_MEM_BUDGET_ALLOCATOR "GstTensorAllocator"
+#define GST_EDGE_MEM_PRESSURE_NONE (0)
+#define GST_EDGE_MEM_PRESSURE_THROTTLE (1)
+#define GST_EDGE_MEM_PRESSURE_DROP (2)
+
 G_BEGIN_DECLS
 /**
  * @brief register GEnumValue array for edge protocol property handling
  */
     GType gst_edge_get_connect_type (void);
 
+/**
+ * @brief Create the edge handle, the connection of custom type is loaded from the library.
+ * @param custom_lib the path of the custom connection library, valid only for the custom type.
+ */
+int gst_edge_create_handle (nns_edge_connect_type_e connect_type, const gchar * custom_lib, nns_edge_node_type_e node_type, nns_edge_h * edge_h);
+
+/**
+ * @brief Set the integer value to the info of the edge data.
+ */
+void gst_edge_data_set_int64 (nns_edge_data_h data_h, const gchar * key, gint64 val);
+
+/**
+ * @brief Get the integer value from the info of the edge data.
+ * @return TRUE if the edge data has the key.
+ */
+gboolean gst_edge_data_get_int64 (nns_edge_data_h data_h, const gchar * key, gint64 * val);
+
+/**
+ * @brief Get the total size of the memories in the edge data.
+ */
+gsize gst_edge_data_get_size (nns_edge_data_h data_h);
+
+/**
+ * @brief Get the memory pressure of the memory budget.
+ * @param budget the allocator keeping the memory budget, GST_EDGE_MEM_PRESSURE_NONE if it is NULL.
+ */
+gint gst_edge_mem_budget_get_pressure (GstAllocator * budget);
+
+/**
+ * @brief Account the bytes held by the owner to the memory budget, negative to release.
+ */
+void gst_edge_mem_budget_account (GstAllocator * budget, gpointer owner, gint64 bytes);
+
 G_END_DECLS
 #endif /* __GST_EDGE_H__ */
@@ -39,16 +39,39 @@ enum
   PROP_DEST_HOST,
   PROP_DEST_PORT,
   PROP_CONNECT_TYPE,
+  PROP_CUSTOM_LIB,
   PROP_TOPIC,
+  PROP_COMPRESSION,
+  PROP_SHARED_MEMORY,
+  PROP_SEND_QUEUE_SIZE,
 
   PROP_LAST
 };
 #define DEFAULT_MQTT_HOST "127.0.0.1"
 #define DEFAULT_MQTT_PORT 1883
+#define DEFAULT_COMPRESSION QUERY_COMPRESS_NONE
+#define DEFAULT_SHARED_MEMORY FALSE
+#define DEFAULT_SEND_QUEUE_SIZE 0
 
 #define gst_edgesink_parent_class parent_class
 G_DEFINE_TYPE (GstEdgeSink, gst_edgesink, GST_TYPE_BASE_SINK);
 
+/**
+ * @brief The memories owned by the edge data, until the edge layer releases the data.
+ * The destroy callback of the edge data gets the data pointer only, so the mapped memories are found with it.
+ */
+G_LOCK_DEFINE_STATIC (edgesink_mem_table);
+static GHashTable *_edgesink_mem_table = NULL;
+
+/**
+ * @brief The mapped memory sent with the edge data.
+ */
+typedef struct
+{
+  GstMemory *mem;
+  GstMapInfo map;
+} edgesink_mem_s;
+
 static void gst_edgesink_set_property (GObject * object,
     guint prop_id, const GValue * value, GParamSpec * pspec);
 
@@ -104,6 +127,11 @@ gst_edgesink_class_init (GstEdgeSinkClass * klass)
           "The connections type between edgesink and edgesrc.",
           GST_TYPE_EDGE_CONNECT_TYPE, DEFAULT_CONNECT_TYPE,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CUSTOM_LIB,
+      g_param_spec_string ("custom-lib", "Custom connection library",
+          "The path of the library implementing the connection, "
+          "valid only if the connect-type is CUSTOM.", NULL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
   g_object_class_install_property (gobject_class, PROP_DEST_HOST,
       g_param_spec_string ("dest-host", "Destination Host",
           "The destination hostname of the broker", DEFAULT_MQTT_HOST,
@@ -118,6 +146,25 @@ gst_edgesink_class_init (GstEdgeSinkClass * klass)
           "The main topic of the host and option if necessary. "
           "(topic)/(optional topic for main topic).", "",
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_COMPRESSION,
+      g_param_spec_enum ("compression", "Compression",
+          "The compression of the payload sent to edgesrc. "
+          "Edgesrc decompresses the payload, it should be built with the same compression library.",
+          GST_TYPE_QUERY_COMPRESSION, DEFAULT_COMPRESSION,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_SHARED_MEMORY,
+      g_param_spec_boolean ("shared-memory", "Shared memory",
+          "Send the payload via the shared memory to edgesrc on the same host, "
+          "only the descriptor of the shared memory is sent over the connection. "
+          "If the shared memory is full, the payload is sent over the connection.",
+          DEFAULT_SHARED_MEMORY, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_SEND_QUEUE_SIZE,
+      g_param_spec_uint ("send-queue-size", "Send queue size",
+          "The max number of the frames waiting to be sent to the subscribers "
+          "(0 for unlimited). When the queue is full, the oldest frame is dropped, "
+          "so slow subscribers do not stall the pipeline.",
+          0, G_MAXUINT, DEFAULT_SEND_QUEUE_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&sinktemplate));
@@ -146,6 +193,12 @@ gst_edgesink_init (GstEdgeSink * self)
   self->dest_port = DEFAULT_PORT;
   self->topic = NULL;
   self->connect_type = DEFAULT_CONNECT_TYPE;
+  self->custom_lib = NULL;
+  self->compression = DEFAULT_COMPRESSION;
+  self->shared_memory = DEFAULT_SHARED_MEMORY;
+  self->shm = NULL;
+  self->send_queue_size = DEFAULT_SEND_QUEUE_SIZE;
+  self->seq = 0;
 }
 
 /**
@@ -178,6 +231,10 @@ gst_edgesink_set_property (GObject * object, guint prop_id,
     case PROP_CONNECT_TYPE:
       gst_edgesink_set_connect_type (self, g_value_get_enum (value));
       break;
+    case PROP_CUSTOM_LIB:
+      g_free (self->custom_lib);
+      self->custom_lib = g_value_dup_string (value);
+      break;
     case PROP_TOPIC:
       if (!g_value_get_string (value)) {
         nns_logw ("topic property cannot be NULL. Query-hybrid is disabled.");
@@ -186,6 +243,15 @@ gst_edgesink_set_property (GObject * object, guint prop_id,
       g_free (self->topic);
       self->topic = g_value_dup_string (value);
       break;
+    case PROP_COMPRESSION:
+      self->compression = g_value_get_enum (value);
+      break;
+    case PROP_SHARED_MEMORY:
+      self->shared_memory = g_value_get_boolean (value);
+      break;
+    case PROP_SEND_QUEUE_SIZE:
+      self->send_queue_size = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -217,9 +283,21 @@ gst_edgesink_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_CONNECT_TYPE:
       g_value_set_enum (value, gst_edgesink_get_connect_type (self));
       break;
+    case PROP_CUSTOM_LIB:
+      g_value_set_string (value, self->custom_lib);
+      break;
     case PROP_TOPIC:
       g_value_set_string (value, self->topic);
       break;
+    case PROP_COMPRESSION:
+      g_value_set_enum (value, self->compression);
+      break;
+    case PROP_SHARED_MEMORY:
+      g_value_set_boolean (value, self->shared_memory);
+      break;
+    case PROP_SEND_QUEUE_SIZE:
+      g_value_set_uint (value, self->send_queue_size);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -233,6 +311,10 @@ static void
 gst_edgesink_finalize (GObject * object)
 {
   GstEdgeSink *self = GST_EDGESINK (object);
+
+  g_free (self->custom_lib);
+  self->custom_lib = NULL;
+
   if (self->host) {
     g_free (self->host);
     self->host = NULL;
@@ -243,6 +325,11 @@ gst_edgesink_finalize (GObject * object)
     self->edge_h = NULL;
   }
 
+  if (self->shm) {
+    gst_tensor_query_shm_free (self->shm);
+    self->shm = NULL;
+  }
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -257,8 +344,12 @@ gst_edgesink_start (GstBaseSink * basesink)
   int ret;
   char *port = NULL;
 
-  ret =
-      nns_edge_create_handle (NULL, self->connect_type,
+  if (!gst_tensor_query_compression_is_supported (self->compression)) {
+    nns_loge ("The compression is not supported in this build.");
+    return FALSE;
+  }
+
+  ret = gst_edge_create_handle (self->connect_type, self->custom_lib,
       NNS_EDGE_NODE_TYPE_PUB, &self->edge_h);
 
   if (NNS_EDGE_ERROR_NONE != ret) {
@@ -288,6 +379,13 @@ gst_edgesink_start (GstBaseSink * basesink)
   }
   if (self->topic)
     nns_edge_set_info (self->edge_h, "TOPIC", self->topic);
+  if (self->send_queue_size > 0) {
+    /* drop the oldest frame rather than blocking the streaming thread */
+    gchar *queue = g_strdup_printf ("%u:OLD", self->send_queue_size);
+
+    nns_edge_set_info (self->edge_h, "QUEUE_SIZE", queue);
+    g_free (queue);
+  }
 
   if (0 != nns_edge_start (self->edge_h)) {
     nns_loge
@@ -295,18 +393,91 @@ gst_edgesink_start (GstBaseSink * basesink)
     return FALSE;
   }
 
+  if (self->shared_memory && !self->shm) {
+    if (gst_tensor_query_shm_is_supported ())
+      self->shm = gst_tensor_query_shm_new ();
+    else
+      nns_logw ("The shared memory is not supported in this build.");
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Destroy callback of the edge data, release the memory sent with the edge data.
+ */
+static void
+_edgesink_memory_release (void *data)
+{
+  edgesink_mem_s *m = NULL;
+  GSList *list;
+
+  G_LOCK (edgesink_mem_table);
+  list = g_hash_table_lookup (_edgesink_mem_table, data);
+  if (list) {
+    /* The same memory may be sent by multiple edgesinks (e.g., tee). */
+    m = (edgesink_mem_s *) list->data;
+    list = g_slist_delete_link (list, list);
+
+    if (list)
+      g_hash_table_insert (_edgesink_mem_table, data, list);
+    else
+      g_hash_table_remove (_edgesink_mem_table, data);
+  }
+  G_UNLOCK (edgesink_mem_table);
+
+  if (m) {
+    gst_memory_unmap (m->mem, &m->map);
+    gst_memory_unref (m->mem);
+    g_free (m);
+  }
+}
+
+/**
+ * @brief Hand over the mapped memory to the edge data. The memory is unmapped and unreferenced when the edge layer releases the data.
+ */
+static gboolean
+_edgesink_memory_add (nns_edge_data_h data_h, GstMemory * mem,
+    GstMapInfo * map)
+{
+  edgesink_mem_s *m;
+  GSList *list;
+  int ret;
+
+  m = g_new0 (edgesink_mem_s, 1);
+  m->mem = gst_memory_ref (mem);
+  m->map = *map;
+
+  G_LOCK (edgesink_mem_table);
+  if (!_edgesink_mem_table)
+    _edgesink_mem_table = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+  list = g_hash_table_lookup (_edgesink_mem_table, map->data);
+  list = g_slist_prepend (list, m);
+  g_hash_table_insert (_edgesink_mem_table, map->data, list);
+  G_UNLOCK (edgesink_mem_table);
+
+  ret = nns_edge_data_add (data_h, map->data, map->size,
+      _edgesink_memory_release);
+  if (ret != NNS_EDGE_ERROR_NONE) {
+    _edgesink_memory_release (map->data);
+    return FALSE;
+  }
+
   return TRUE;
 }
 
 /**
  * @brief render buffer, send buffer
+ * @note The payload is compressed (or copied into the shared memory) once per
+ * frame, and the edge layer sends the same edge data to all the subscribers.
  */
 static GstFlowReturn
 gst_edgesink_render (GstBaseSink * basesink, GstBuffer * buffer)
 {
   GstEdgeSink *self = GST_EDGESINK (basesink);
   nns_edge_data_h data_h;
-  guint i, num_mems;
+  guint i, num_mems, num_owned = 0;
   int ret;
   GstMemory *mem[NNS_TENSOR_SIZE_LIMIT];
   GstMapInfo map[NNS_TENSOR_SIZE_LIMIT];
@@ -317,6 +488,12 @@ gst_edgesink_render (GstBaseSink * basesink, GstBuffer * buffer)
     return GST_FLOW_ERROR;
   }
 
+  /* the sequence number and sender timestamp for the jitter buffer of edgesrc */
+  gst_edge_data_set_int64 (data_h, GST_EDGE_INFO_SEQ, (gint64) self->seq++);
+  gst_edge_data_set_int64 (data_h, GST_EDGE_INFO_TIMESTAMP,
+      GST_BUFFER_PTS_IS_VALID (buffer) ? (gint64) GST_BUFFER_PTS (buffer) :
+      g_get_monotonic_time () * 1000);
+
   num_mems = gst_buffer_n_memory (buffer);
   for (i = 0; i < num_mems; i++) {
     mem[i] = gst_buffer_peek_memory (buffer, i);
@@ -325,7 +502,32 @@ gst_edgesink_render (GstBaseSink * basesink, GstBuffer * buffer)
       num_mems = i;
       goto done;
     }
-    nns_edge_data_add (data_h, map[i].data, map[i].size, NULL);
+  }
+
+  /* Without the free slot of the shared memory, send the payload. */
+  if (self->shm &&
+      gst_tensor_query_shm_add_data (self->shm, data_h, map, num_mems)) {
+    nns_logd ("Send the payload via the shared memory.");
+  } else if (self->compression != QUERY_COMPRESS_NONE) {
+    if (!gst_tensor_query_compress_add_data (data_h, self->compression,
+            QUERY_QUANTIZE_NONE, NULL, map, num_mems)) {
+      nns_loge ("Failed to add the memories to the edge data.");
+      goto done;
+    }
+  } else {
+    /**
+     * The edge data holds the references of the memories,
+     * so the edge layer may send the data after this function returns.
+     */
+    for (i = 0; i < num_mems; i++) {
+      if (!_edgesink_memory_add (data_h, mem[i], &map[i])) {
+        /* The memory is already released. */
+        nns_loge ("Failed to add the %uth memory to the edge data.", i);
+        num_owned = i + 1;
+        goto done;
+      }
+      num_owned = i + 1;
+    }
   }
 
   nns_edge_send (self->edge_h, data_h);
@@ -335,7 +537,7 @@ done:
   if (data_h)
     nns_edge_data_destroy (data_h);
 
-  for (i = 0; i < num_mems; i++) {
+  for (i = num_owned; i < num_mems; i++) {
     gst_memory_unmap (mem[i], &map[i]);
   }
 
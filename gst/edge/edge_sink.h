@@ -19,6 +19,8 @@
 #include "nnstreamer-edge.h"
 #include "../nnstreamer/nnstreamer_log.h"
 #include "tensor_typedef.h"
+#include "tensor_query_compress.h"
+#include "tensor_query_shm.h"
 
 G_BEGIN_DECLS
 #define GST_TYPE_EDGESINK \
@@ -49,7 +51,13 @@ struct _GstEdgeSink
   gchar *topic;
 
   nns_edge_connect_type_e connect_type;
+  gchar *custom_lib; /**< path of the custom connection library */
   nns_edge_h edge_h;
+  query_compress_e compression; /**< compression of the payload */
+  gboolean shared_memory; /**< true to send the payload via the shared memory */
+  query_shm_s *shm; /**< shared-memory segment to send the payload */
+  guint send_queue_size; /**< max number of the frames waiting to be sent, 0 for unlimited */
+  guint64 seq; /**< sequence number of the next frame */
 };
 
 /**
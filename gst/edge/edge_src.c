@@ -36,11 +36,32 @@ enum
   PROP_DEST_HOST,
   PROP_DEST_PORT,
   PROP_CONNECT_TYPE,
+  PROP_CUSTOM_LIB,
   PROP_TOPIC,
+  PROP_LATENCY,
+  PROP_DROP_LATE,
 
   PROP_LAST
 };
 
+#define DEFAULT_LATENCY 0
+#define DEFAULT_DROP_LATE FALSE
+
+/**
+ * @brief Sequence gap to detect the restart of edgesink.
+ */
+#define JITTER_RESET_SEQ_GAP 1000
+
+/**
+ * @brief Received data waiting in the jitter buffer.
+ */
+typedef struct
+{
+  nns_edge_data_h data_h;
+  gint64 seq;
+  gint64 deadline;              /**< monotonic time (usec) to push the data */
+} edgesrc_jitter_item_s;
+
 #define gst_edgesrc_parent_class parent_class
 G_DEFINE_TYPE (GstEdgeSrc, gst_edgesrc, GST_TYPE_BASE_SRC);
 
@@ -49,6 +70,9 @@ static void gst_edgesrc_set_property (GObject * object, guint prop_id,
 static void gst_edgesrc_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 static void gst_edgesrc_class_finalize (GObject * object);
+static void gst_edgesrc_jitter_clear (GstEdgeSrc * self);
+static void gst_edgesrc_release_budget (GstEdgeSrc * self,
+    nns_edge_data_h data_h);
 
 static gboolean gst_edgesrc_start (GstBaseSrc * basesrc);
 static GstFlowReturn gst_edgesrc_create (GstBaseSrc * basesrc, guint64 offset,
@@ -101,11 +125,28 @@ gst_edgesrc_class_init (GstEdgeSrcClass * klass)
           "The connections type between edgesink and edgesrc.",
           GST_TYPE_EDGE_CONNECT_TYPE, DEFAULT_CONNECT_TYPE,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CUSTOM_LIB,
+      g_param_spec_string ("custom-lib", "Custom connection library",
+          "The path of the library implementing the connection, "
+          "valid only if the connect-type is CUSTOM.", NULL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
   g_object_class_install_property (gobject_class, PROP_TOPIC,
       g_param_spec_string ("topic", "Topic",
           "The main topic of the host and option if necessary. "
           "(topic)/(optional topic for main topic).", "",
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY,
+      g_param_spec_uint ("latency", "Latency",
+          "The target latency (in ms) of the jitter buffer (0 to disable). "
+          "The received data is reordered by the sequence number of edgesink "
+          "and pushed in the pace of the sender timestamps, delayed by the latency.",
+          0, G_MAXUINT, DEFAULT_LATENCY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_DROP_LATE,
+      g_param_spec_boolean ("drop-late", "Drop late",
+          "Drop the data arriving later than its time to be pushed "
+          "(valid only if latency is set)",
+          DEFAULT_DROP_LATE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&srctemplate));
@@ -138,7 +179,17 @@ gst_edgesrc_init (GstEdgeSrc * self)
   self->dest_port = DEFAULT_PORT;
   self->topic = NULL;
   self->msg_queue = g_async_queue_new ();
+  self->pool = gst_tensor_query_decompress_pool_new ();
+  self->shm_reader = gst_tensor_query_shm_reader_new ();
   self->connect_type = DEFAULT_CONNECT_TYPE;
+  self->custom_lib = NULL;
+  self->latency = DEFAULT_LATENCY;
+  self->drop_late = DEFAULT_DROP_LATE;
+  g_queue_init (&self->jitter);
+  self->jitter_started = FALSE;
+  self->num_dropped = 0;
+  self->num_lost = 0;
+  self->budget = NULL;
 }
 
 /**
@@ -171,6 +222,10 @@ gst_edgesrc_set_property (GObject * object, guint prop_id, const GValue * value,
     case PROP_CONNECT_TYPE:
       gst_edgesrc_set_connect_type (self, g_value_get_enum (value));
       break;
+    case PROP_CUSTOM_LIB:
+      g_free (self->custom_lib);
+      self->custom_lib = g_value_dup_string (value);
+      break;
     case PROP_TOPIC:
       if (!g_value_get_string (value)) {
         nns_logw ("topic property cannot be NULL. Query-hybrid is disabled.");
@@ -179,6 +234,12 @@ gst_edgesrc_set_property (GObject * object, guint prop_id, const GValue * value,
       g_free (self->topic);
       self->topic = g_value_dup_string (value);
       break;
+    case PROP_LATENCY:
+      self->latency = g_value_get_uint (value);
+      break;
+    case PROP_DROP_LATE:
+      self->drop_late = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -210,15 +271,52 @@ gst_edgesrc_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_CONNECT_TYPE:
       g_value_set_enum (value, gst_edgesrc_get_connect_type (self));
       break;
+    case PROP_CUSTOM_LIB:
+      g_value_set_string (value, self->custom_lib);
+      break;
     case PROP_TOPIC:
       g_value_set_string (value, self->topic);
       break;
+    case PROP_LATENCY:
+      g_value_set_uint (value, self->latency);
+      break;
+    case PROP_DROP_LATE:
+      g_value_set_boolean (value, self->drop_late);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
+/**
+ * @brief Release the bytes of the data popped from the message queue from the memory budget.
+ */
+static void
+gst_edgesrc_release_budget (GstEdgeSrc * self, nns_edge_data_h data_h)
+{
+  if (self->budget && data_h) {
+    gst_edge_mem_budget_account (self->budget, self,
+        -((gint64) gst_edge_data_get_size (data_h)));
+  }
+}
+
+/**
+ * @brief Release the data in the jitter buffer.
+ */
+static void
+gst_edgesrc_jitter_clear (GstEdgeSrc * self)
+{
+  edgesrc_jitter_item_s *item;
+
+  while ((item = g_queue_pop_head (&self->jitter))) {
+    nns_edge_data_destroy (item->data_h);
+    g_free (item);
+  }
+
+  self->jitter_started = FALSE;
+}
+
 /**
  * @brief finalize the object
  */
@@ -228,23 +326,44 @@ gst_edgesrc_class_finalize (GObject * object)
   GstEdgeSrc *self = GST_EDGESRC (object);
   nns_edge_data_h data_h;
 
+  g_free (self->custom_lib);
+  self->custom_lib = NULL;
+
   if (self->dest_host) {
     g_free (self->dest_host);
     self->dest_host = NULL;
   }
 
+  gst_edgesrc_jitter_clear (self);
+
   if (self->msg_queue) {
     while ((data_h = g_async_queue_try_pop (self->msg_queue))) {
+      gst_edgesrc_release_budget (self, data_h);
       nns_edge_data_destroy (data_h);
     }
     g_async_queue_unref (self->msg_queue);
     self->msg_queue = NULL;
   }
 
+  if (self->pool) {
+    gst_tensor_query_decompress_pool_free (self->pool);
+    self->pool = NULL;
+  }
+
+  if (self->shm_reader) {
+    gst_tensor_query_shm_reader_free (self->shm_reader);
+    self->shm_reader = NULL;
+  }
+
   if (self->edge_h) {
     nns_edge_release_handle (self->edge_h);
     self->edge_h = NULL;
   }
+
+  if (self->budget) {
+    gst_object_unref (self->budget);
+    self->budget = NULL;
+  }
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -267,8 +386,25 @@ _nns_edge_event_cb (nns_edge_event_h event_h, void *user_data)
     case NNS_EDGE_EVENT_NEW_DATA_RECEIVED:
     {
       nns_edge_data_h data;
+      gint pressure;
 
       nns_edge_event_parse_new_data (event_h, &data);
+
+      /**
+       * Memory budget, drop the data over the high watermark.
+       * Over the low watermark, keep the data only if the queue is empty.
+       */
+      pressure = gst_edge_mem_budget_get_pressure (self->budget);
+      if (pressure == GST_EDGE_MEM_PRESSURE_DROP ||
+          (pressure == GST_EDGE_MEM_PRESSURE_THROTTLE &&
+              g_async_queue_length (self->msg_queue) > 0)) {
+        nns_logd ("Memory budget exceeded, edgesrc drops the received data.");
+        nns_edge_data_destroy (data);
+        break;
+      }
+
+      gst_edge_mem_budget_account (self->budget, self,
+          (gint64) gst_edge_data_get_size (data));
       g_async_queue_push (self->msg_queue, data);
       break;
     }
@@ -301,8 +437,11 @@ gst_edgesrc_start (GstBaseSrc * basesrc)
   int ret;
   char *port = NULL;
 
-  ret =
-      nns_edge_create_handle (NULL, self->connect_type,
+  /* the memory budget is set by nnstreamer ([allocator] in nnstreamer.ini) */
+  if (!self->budget)
+    self->budget = gst_allocator_find (GST_EDGE_MEM_BUDGET_ALLOCATOR);
+
+  ret = gst_edge_create_handle (self->connect_type, self->custom_lib,
       NNS_EDGE_NODE_TYPE_SUB, &self->edge_h);
 
   if (NNS_EDGE_ERROR_NONE != ret) {
@@ -349,6 +488,136 @@ gst_edgesrc_start (GstBaseSrc * basesrc)
   return TRUE;
 }
 
+/**
+ * @brief Add the received data to the jitter buffer, in the order of the sequence number.
+ * @return FALSE if the data has no sequence number and should be pushed now.
+ */
+static gboolean
+gst_edgesrc_jitter_insert (GstEdgeSrc * self, nns_edge_data_h data_h,
+    gint64 arrival)
+{
+  edgesrc_jitter_item_s *item;
+  GList *l;
+  gint64 seq, ts, expected;
+
+  if (!gst_edge_data_get_int64 (data_h, GST_EDGE_INFO_SEQ, &seq) ||
+      !gst_edge_data_get_int64 (data_h, GST_EDGE_INFO_TIMESTAMP, &ts))
+    return FALSE;
+
+  if (self->jitter_started && seq < self->next_seq &&
+      self->next_seq - seq > JITTER_RESET_SEQ_GAP) {
+    GST_INFO_OBJECT (self, "Sequence number restarted (%" G_GINT64_FORMAT
+        " -> %" G_GINT64_FORMAT "), reset the jitter buffer",
+        self->next_seq, seq);
+    gst_edgesrc_jitter_clear (self);
+  }
+
+  if (!self->jitter_started) {
+    self->base_ts = ts;
+    self->base_arrival = arrival;
+    self->next_seq = seq;
+    self->jitter_started = TRUE;
+  }
+
+  if (seq < self->next_seq) {
+    /* the next data is already pushed */
+    GST_DEBUG_OBJECT (self, "Drop the late data %" G_GINT64_FORMAT, seq);
+    self->num_dropped++;
+    nns_edge_data_destroy (data_h);
+    return TRUE;
+  }
+
+  /**
+   * The base is the arrival of the data with the shortest transit time,
+   * the others are delayed to the pace of the sender timestamps.
+   */
+  expected = self->base_arrival + (ts - self->base_ts) / 1000;
+  if (arrival < expected) {
+    self->base_arrival -= expected - arrival;
+    expected = arrival;
+  }
+
+  item = g_new0 (edgesrc_jitter_item_s, 1);
+  item->data_h = data_h;
+  item->seq = seq;
+  item->deadline = expected + (gint64) self->latency * 1000;
+
+  if (self->drop_late && arrival > item->deadline) {
+    GST_DEBUG_OBJECT (self, "Drop the data %" G_GINT64_FORMAT
+        " arriving %" G_GINT64_FORMAT " us late", seq,
+        arrival - item->deadline);
+    self->num_dropped++;
+    nns_edge_data_destroy (data_h);
+    g_free (item);
+    return TRUE;
+  }
+
+  for (l = self->jitter.tail; l; l = l->prev) {
+    edgesrc_jitter_item_s *prev = l->data;
+
+    if (prev->seq == seq) {
+      nns_edge_data_destroy (data_h);
+      g_free (item);
+      return TRUE;
+    }
+
+    if (prev->seq < seq)
+      break;
+  }
+
+  if (l)
+    g_queue_insert_after (&self->jitter, l, item);
+  else
+    g_queue_push_head (&self->jitter, item);
+
+  return TRUE;
+}
+
+/**
+ * @brief Get the next data from the jitter buffer when its time comes.
+ */
+static nns_edge_data_h
+gst_edgesrc_jitter_pop (GstEdgeSrc * self)
+{
+  edgesrc_jitter_item_s *item;
+  nns_edge_data_h data_h;
+  gint64 now;
+
+  while (TRUE) {
+    item = g_queue_peek_head (&self->jitter);
+    now = g_get_monotonic_time ();
+
+    if (item && now >= item->deadline) {
+      g_queue_pop_head (&self->jitter);
+      if (item->seq > self->next_seq) {
+        self->num_lost += item->seq - self->next_seq;
+        GST_DEBUG_OBJECT (self, "Lost %" G_GINT64_FORMAT " data before %"
+            G_GINT64_FORMAT, item->seq - self->next_seq, item->seq);
+      }
+      self->next_seq = item->seq + 1;
+
+      data_h = item->data_h;
+      g_free (item);
+      return data_h;
+    }
+
+    if (item)
+      data_h = g_async_queue_timeout_pop (self->msg_queue,
+          item->deadline - now);
+    else
+      data_h = g_async_queue_pop (self->msg_queue);
+
+    if (!data_h)
+      continue;
+
+    gst_edgesrc_release_budget (self, data_h);
+
+    /* create() waits on the queue, so the arrival is close to the pop time */
+    if (!gst_edgesrc_jitter_insert (self, data_h, g_get_monotonic_time ()))
+      return data_h;
+  }
+}
+
 /**
  * @brief Create a buffer containing the subscribed data
  */
@@ -360,37 +629,36 @@ gst_edgesrc_create (GstBaseSrc * basesrc, guint64 offset, guint size,
 
   nns_edge_data_h data_h;
   GstBuffer *buffer = NULL;
-  guint i, num_data;
-  int ret;
+  gboolean received;
 
   UNUSED (offset);
   UNUSED (size);
 
-  data_h = g_async_queue_pop (self->msg_queue);
+  if (self->latency > 0) {
+    data_h = gst_edgesrc_jitter_pop (self);
+  } else {
+    data_h = g_async_queue_pop (self->msg_queue);
+    gst_edgesrc_release_budget (self, data_h);
+  }
 
   if (!data_h) {
     nns_loge ("Failed to get message from the edgesrc message queue.");
     goto done;
   }
 
-  ret = nns_edge_data_get_count (data_h, &num_data);
-  if (ret != NNS_EDGE_ERROR_NONE || num_data == 0) {
-    nns_loge ("Failed to get the number of memories of the edge data.");
-    goto done;
-  }
-
+  /* map the shared memory, or decompress the payload if edgesink compressed it */
   buffer = gst_buffer_new ();
-  for (i = 0; i < num_data; i++) {
-    void *data = NULL;
-    nns_size_t data_len = 0;
-    gpointer new_data;
-
-    nns_edge_data_get (data_h, i, &data, &data_len);
-    new_data = _g_memdup (data, data_len);
+  if (gst_tensor_query_shm_is_shared (data_h)) {
+    received = gst_tensor_query_shm_append (self->shm_reader, data_h, buffer);
+  } else {
+    /* The buffer keeps the edge data, the raw payload is not copied. */
+    received = gst_tensor_query_decompress_append (self->pool, data_h, buffer);
+    data_h = NULL;
+  }
 
-    gst_buffer_append_memory (buffer,
-        gst_memory_new_wrapped (0, new_data, data_len, 0, data_len, new_data,
-            g_free));
+  if (!received) {
+    gst_buffer_unref (buffer);
+    buffer = NULL;
   }
 
 done:
@@ -19,6 +19,8 @@
 #include "nnstreamer-edge.h"
 #include "nnstreamer_util.h"
 #include "../nnstreamer/nnstreamer_log.h"
+#include "tensor_query_compress.h"
+#include "tensor_query_shm.h"
 
 G_BEGIN_DECLS
 #define GST_TYPE_EDGESRC \
@@ -49,8 +51,23 @@ struct _GstEdgeSrc
   gchar *topic;
 
   nns_edge_connect_type_e connect_type;
+  gchar *custom_lib; /**< path of the custom connection library */
   nns_edge_h edge_h;
   GAsyncQueue *msg_queue;
+  query_decompress_pool_s *pool; /**< memory pool for the decoded payload */
+  query_shm_reader_s *shm_reader; /**< mapping of the shared memory from edgesink */
+
+  guint latency; /**< target latency (ms) of the jitter buffer, 0 to disable */
+  gboolean drop_late; /**< drop the data arriving after its time to be pushed */
+  GQueue jitter; /**< received data ordered by the sequence number */
+  gboolean jitter_started; /**< the base of the timestamps is set */
+  gint64 next_seq; /**< sequence number of the data to push next */
+  gint64 base_ts; /**< sender timestamp (ns) of the base */
+  gint64 base_arrival; /**< local arrival time (usec) of the base */
+  guint64 num_dropped; /**< the number of dropped late data */
+  guint64 num_lost; /**< the number of data never received */
+
+  GstAllocator *budget; /**< memory budget of nnstreamer, NULL if it is not set */
 };
 
 /**
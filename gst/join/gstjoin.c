@@ -19,6 +19,13 @@
  * N streams should not operate at the same time.
  * All capabilities (input stream i and output stream) should be the same.
  * For example, If one sinkpad is receiving buffer, the others should be stopped.
+ *
+ * With policy=latency, the streams may operate at the same time (e.g.,
+ * redundant inference branches). join measures the latency of each stream
+ * (arrival running time minus buffer running time) and keeps the
+ * lowest-latency stream active. A buffer not newer than the last forwarded
+ * one is dropped as a late duplicate, and the active pad is switched when it
+ * stalls longer than stall-timeout.
  * <refsect2>
  * <title>Example launch line</title>
  * gst-launch-1.0 ... (input stream 0) ! join.sink_0 \
@@ -64,8 +71,46 @@ enum
   PROP_0,
   PROP_N_PADS,
   PROP_ACTIVE_PAD,
+  PROP_POLICY,
+  PROP_STALL_TIMEOUT,
 };
 
+/**
+ * @brief Default input selection policy
+ */
+#define DEFAULT_POLICY GST_JOIN_POLICY_ARRIVAL
+
+/**
+ * @brief Default stall timeout (ms) of the active pad
+ */
+#define DEFAULT_STALL_TIMEOUT 100
+
+#define GST_TYPE_JOIN_POLICY (gst_join_policy_get_type ())
+
+/**
+ * @brief GType of the input selection policy
+ */
+static GType
+gst_join_policy_get_type (void)
+{
+  static GType policy_type = 0;
+
+  if (policy_type == 0) {
+    static const GEnumValue policies[] = {
+      {GST_JOIN_POLICY_ARRIVAL, "Forward the buffer arrived recently",
+          "arrival"},
+      {GST_JOIN_POLICY_LATENCY,
+          "Prefer the lowest-latency stream and drop late duplicates by PTS",
+          "latency"},
+      {0, NULL, NULL},
+    };
+
+    policy_type = g_enum_register_static ("GstJoinPolicy", policies);
+  }
+
+  return policy_type;
+}
+
 static GstPad *gst_join_get_active_sinkpad (GstJoin * sel);
 static GstPad *gst_join_get_linked_pad (GstJoin * sel,
     GstPad * pad, gboolean strict);
@@ -98,6 +143,9 @@ struct _GstJoinPad
 
   GstSegment segment;           /* the current segment on the pad */
   guint32 segment_seqnum;       /* sequence number of the current segment */
+
+  GstClockTime latency;         /* average latency of the stream */
+  GstClockTime last_arrival;    /* running time of the last arrival */
 };
 
 /**
@@ -162,6 +210,8 @@ gst_join_pad_reset (GstJoinPad * pad)
 {
   GST_OBJECT_LOCK (pad);
   gst_segment_init (&pad->segment, GST_FORMAT_UNDEFINED);
+  pad->latency = GST_CLOCK_TIME_NONE;
+  pad->last_arrival = GST_CLOCK_TIME_NONE;
   GST_OBJECT_UNLOCK (pad);
 }
 
@@ -284,6 +334,9 @@ gst_join_pad_event (GstPad * pad, GstObject * parent, GstEvent * event)
           &selpad->segment);
       break;
     }
+    case GST_EVENT_FLUSH_STOP:
+      sel->last_ts = GST_CLOCK_TIME_NONE;
+      break;
     default:
       break;
   }
@@ -350,6 +403,97 @@ done:
   return res;
 }
 
+/**
+ * @brief Get the current running time of the element.
+ */
+static GstClockTime
+gst_join_get_running_time (GstJoin * sel)
+{
+  GstClockTime now = GST_CLOCK_TIME_NONE;
+  GstClock *clock;
+
+  clock = gst_element_get_clock (GST_ELEMENT_CAST (sel));
+  if (clock) {
+    GstClockTime base_time = gst_element_get_base_time (GST_ELEMENT_CAST (sel));
+
+    now = gst_clock_get_time (clock);
+    now = (now > base_time) ? now - base_time : 0;
+    gst_object_unref (clock);
+  }
+
+  return now;
+}
+
+/**
+ * @brief Check whether the buffer should be forwarded with the latency policy.
+ * @details Updates the latency of the pad, and switches the active pad if the
+ *          pad has lower latency or the active pad stalls.
+ * @return FALSE if the buffer is a late duplicate or from a non-active stream.
+ * @note must be called with the JOIN_LOCK.
+ */
+static gboolean
+gst_join_select_by_latency (GstJoin * sel, GstJoinPad * selpad, GstBuffer * buf)
+{
+  GstJoinPad *active;
+  GstClockTime now, ts = GST_CLOCK_TIME_NONE;
+  gboolean stalled;
+
+  now = gst_join_get_running_time (sel);
+
+  if (GST_BUFFER_PTS_IS_VALID (buf)) {
+    GST_OBJECT_LOCK (selpad);
+    if (selpad->segment.format == GST_FORMAT_TIME)
+      ts = gst_segment_to_running_time (&selpad->segment, GST_FORMAT_TIME,
+          GST_BUFFER_PTS (buf));
+    GST_OBJECT_UNLOCK (selpad);
+
+    /* compare PTS if it cannot be converted to running time */
+    if (!GST_CLOCK_TIME_IS_VALID (ts))
+      ts = GST_BUFFER_PTS (buf);
+    else if (GST_CLOCK_TIME_IS_VALID (now)) {
+      /* moving average latency of the stream */
+      GstClockTime latency = (now > ts) ? now - ts : 0;
+
+      if (GST_CLOCK_TIME_IS_VALID (selpad->latency))
+        selpad->latency = (selpad->latency * 7 + latency) / 8;
+      else
+        selpad->latency = latency;
+    }
+  }
+
+  selpad->last_arrival = now;
+
+  if (GST_CLOCK_TIME_IS_VALID (ts) && GST_CLOCK_TIME_IS_VALID (sel->last_ts)
+      && ts <= sel->last_ts) {
+    GST_LOG_OBJECT (selpad, "Drop late buffer %" GST_TIME_FORMAT,
+        GST_TIME_ARGS (GST_BUFFER_PTS (buf)));
+    return FALSE;
+  }
+
+  active = GST_JOIN_PAD_CAST (sel->active_sinkpad);
+  if (active && active != selpad) {
+    stalled = !GST_CLOCK_TIME_IS_VALID (active->last_arrival) ||
+        (GST_CLOCK_TIME_IS_VALID (now) &&
+        now > active->last_arrival + sel->stall_timeout);
+
+    /* switch only if the latency is lower than the active one by 1/8 */
+    if (!stalled && !(GST_CLOCK_TIME_IS_VALID (selpad->latency) &&
+            GST_CLOCK_TIME_IS_VALID (active->latency) &&
+            selpad->latency < active->latency - active->latency / 8)) {
+      GST_LOG_OBJECT (selpad, "Drop buffer of non-active pad %"
+          GST_TIME_FORMAT, GST_TIME_ARGS (GST_BUFFER_PTS (buf)));
+      return FALSE;
+    }
+
+    GST_DEBUG_OBJECT (sel, "Switch to %s:%s (%s)", GST_DEBUG_PAD_NAME (selpad),
+        stalled ? "active pad stalled" : "lower latency");
+  }
+
+  if (GST_CLOCK_TIME_IS_VALID (ts))
+    sel->last_ts = ts;
+  return TRUE;
+}
+
 /**
  * @brief Chain function, this function does the actual processing.
  */
@@ -370,6 +514,13 @@ gst_join_pad_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 
   GST_JOIN_LOCK (sel);
 
+  if (sel->policy == GST_JOIN_POLICY_LATENCY &&
+      !gst_join_select_by_latency (sel, selpad, buf)) {
+    GST_JOIN_UNLOCK (sel);
+    gst_buffer_unref (buf);
+    return GST_FLOW_OK;
+  }
+
   GST_LOG_OBJECT (pad, "getting active pad");
 
   prev_active_sinkpad =
@@ -420,6 +571,8 @@ gst_join_pad_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 static void gst_join_dispose (GObject * object);
 static void gst_join_finalize (GObject * object);
 
+static void gst_join_set_property (GObject * object,
+    guint prop_id, const GValue * value, GParamSpec * pspec);
 static void gst_join_get_property (GObject * object,
     guint prop_id, GValue * value, GParamSpec * pspec);
 static GstPad *gst_join_request_new_pad (GstElement * element,
@@ -442,6 +595,7 @@ gst_join_class_init (GstJoinClass * klass)
   gobject_class->dispose = gst_join_dispose;
   gobject_class->finalize = gst_join_finalize;
 
+  gobject_class->set_property = gst_join_set_property;
   gobject_class->get_property = gst_join_get_property;
 
   g_object_class_install_property (gobject_class, PROP_N_PADS,
@@ -455,6 +609,19 @@ gst_join_class_init (GstJoinClass * klass)
           G_PARAM_READABLE | GST_PARAM_MUTABLE_PLAYING |
           G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_POLICY,
+      g_param_spec_enum ("policy", "Policy",
+          "The policy to select the input stream", GST_TYPE_JOIN_POLICY,
+          DEFAULT_POLICY, G_PARAM_READWRITE | GST_PARAM_MUTABLE_PLAYING |
+          G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_STALL_TIMEOUT,
+      g_param_spec_uint ("stall-timeout", "Stall timeout",
+          "With the latency policy, switch the active pad if it does not "
+          "receive a buffer for this time (ms)", 0, G_MAXUINT,
+          DEFAULT_STALL_TIMEOUT, G_PARAM_READWRITE | GST_PARAM_MUTABLE_PLAYING |
+          G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_static_metadata (gstelement_class, "Input join",
       "Generic", "N-to-1 input stream join",
       "Gichan Jang <gichan2.jang@samsung.com>, ");
@@ -482,6 +649,9 @@ gst_join_init (GstJoin * sel)
   sel->active_sinkpad = NULL;
   sel->padcount = 0;
   sel->have_group_id = TRUE;
+  sel->policy = DEFAULT_POLICY;
+  sel->stall_timeout = DEFAULT_STALL_TIMEOUT * GST_MSECOND;
+  sel->last_ts = GST_CLOCK_TIME_NONE;
 
   g_mutex_init (&sel->lock);
   g_cond_init (&sel->cond);
@@ -558,6 +728,33 @@ gst_join_set_active_pad (GstJoin * self, GstPad * pad)
   return TRUE;
 }
 
+/**
+ * @brief Setter for join properties.
+ */
+static void
+gst_join_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstJoin *sel = GST_JOIN (object);
+
+  switch (prop_id) {
+    case PROP_POLICY:
+      GST_JOIN_LOCK (object);
+      sel->policy = g_value_get_enum (value);
+      sel->last_ts = GST_CLOCK_TIME_NONE;
+      GST_JOIN_UNLOCK (object);
+      break;
+    case PROP_STALL_TIMEOUT:
+      GST_JOIN_LOCK (object);
+      sel->stall_timeout = g_value_get_uint (value) * GST_MSECOND;
+      GST_JOIN_UNLOCK (object);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
 /**
  * @brief Getter for join properties.
  */
@@ -578,6 +775,12 @@ gst_join_get_property (GObject * object, guint prop_id,
       g_value_set_object (value, sel->active_sinkpad);
       GST_JOIN_UNLOCK (object);
       break;
+    case PROP_POLICY:
+      g_value_set_enum (value, sel->policy);
+      break;
+    case PROP_STALL_TIMEOUT:
+      g_value_set_uint (value, (guint) (sel->stall_timeout / GST_MSECOND));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -30,6 +30,15 @@ G_BEGIN_DECLS
 typedef struct _GstJoin GstJoin;
 typedef struct _GstJoinClass GstJoinClass;
 
+/**
+ * @brief Policy to select the input stream.
+ */
+typedef enum
+{
+  GST_JOIN_POLICY_ARRIVAL = 0,  /**< forward the buffer arrived recently */
+  GST_JOIN_POLICY_LATENCY = 1,  /**< prefer the lowest-latency stream and drop late duplicates */
+} GstJoinPolicy;
+
 /**
  * @brief Internal data structure for join instances.
  */
@@ -45,6 +54,10 @@ struct _GstJoin
 
   gboolean have_group_id;
 
+  GstJoinPolicy policy;         /* input selection policy */
+  GstClockTime stall_timeout;   /* switch if the active pad stalls longer than this */
+  GstClockTime last_ts;         /* running time of the last forwarded buffer */
+
   GMutex lock;
   GCond cond;
 };
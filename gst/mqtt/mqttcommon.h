@@ -57,11 +57,54 @@ typedef struct _GstMQTTMessageHdr {
       GstClockTime dts;
       GstClockTime pts;
       gchar gst_caps_str[GST_MQTT_MAX_LEN_GST_CAPS_STR];
+      guint num_frames; /* the number of frames in a batched message (0 if not batched) */
     };
     guint8 _reserved_hdr[GST_MQTT_LEN_MSG_HDR];
   };
 } GstMQTTMessageHdr;
 
+/**
+ * @brief Defined a custom data type, GstMQTTFrameIdx
+ *
+ * In a batched message (num_frames > 0), the index of each frame follows the
+ * message header, and each index is followed by the size of each memory
+ * (guint32 x num_mems). The data of the frames follows the indexes, which are
+ * padded to 8 bytes.
+ */
+typedef struct _GstMQTTFrameIdx {
+  GstClockTime duration;
+  GstClockTime dts;
+  GstClockTime pts;
+  guint32 num_mems;
+  guint32 _reserved;
+} GstMQTTFrameIdx;
+
+#define GST_MQTT_COMPACT_HDR_MAGIC        0x434d514eU /* "NQMC" */
+#define GST_MQTT_COMPACT_FLAG_CAPS        0x1
+#define GST_MQTT_COMPACT_CAPS_INTERVAL_MS 1000
+
+/**
+ * @brief Defined a custom data type, GstMQTTCompactHdr
+ *
+ * GstMQTTCompactHdr replaces GstMQTTMessageHdr when mqttsink has the property
+ * compact-header. The size of each memory (guint32 x num_mems) follows this.
+ * The caps are sent only when they change (caps_gen is increased), at the
+ * beginning of the stream, and once per GST_MQTT_COMPACT_CAPS_INTERVAL_MS for
+ * late subscribers. In that case, the flag GST_MQTT_COMPACT_FLAG_CAPS is set
+ * and the base time (gint64), the length of the caps string (guint32) and the
+ * caps string follow the sizes. The whole header is padded to 8 bytes.
+ */
+typedef struct _GstMQTTCompactHdr {
+  guint32 magic;
+  guint16 caps_gen;
+  guint8 flags;
+  guint8 num_mems;
+  gint64 sent_time_epoch;
+  GstClockTime duration;
+  GstClockTime dts;
+  GstClockTime pts;
+} GstMQTTCompactHdr;
+
 typedef int64_t (*mqtt_get_unix_epoch)(uint32_t, char **, uint16_t *);
 
 /**
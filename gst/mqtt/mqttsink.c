@@ -58,6 +58,10 @@ enum
   PROP_MQTT_QOS,
   PROP_MQTT_NTP_SYNC,
   PROP_MQTT_NTP_SRVS,
+  PROP_MAX_BATCH,
+  PROP_COMPACT_HEADER,
+  PROP_BATCH_TIMEOUT,
+  PROP_MQTT_NTP_REFRESH,
 
   PROP_LAST
 };
@@ -76,6 +80,10 @@ enum
   DEFAULT_MQTT_QOS = 0,         /* fire and forget */
   DEFAULT_MQTT_NTP_SYNC = FALSE,
   MAX_LEN_PROP_NTP_SRVS = 4096,
+  DEFAULT_MQTT_NTP_REFRESH = 64,        /* secs, the min poll interval of NTP */
+  DEFAULT_MAX_BATCH = 1,        /* publish each buffer */
+  DEFAULT_BATCH_TIMEOUT = 0,    /* no time limit */
+  DEFAULT_COMPACT_HEADER = FALSE,
 };
 
 static guint8 sink_client_id = 0;
@@ -143,6 +151,17 @@ static void gst_mqtt_sink_set_mqtt_qos (GstMqttSink * self, const gint qos);
 static gboolean gst_mqtt_sink_get_mqtt_ntp_sync (GstMqttSink * self);
 static void gst_mqtt_sink_set_mqtt_ntp_sync (GstMqttSink * self,
     const gboolean flag);
+static guint gst_mqtt_sink_get_max_batch (GstMqttSink * self);
+static void gst_mqtt_sink_set_max_batch (GstMqttSink * self, const guint num);
+static guint gst_mqtt_sink_get_batch_timeout (GstMqttSink * self);
+static void gst_mqtt_sink_set_batch_timeout (GstMqttSink * self,
+    const guint timeout);
+static gboolean gst_mqtt_sink_get_compact_header (GstMqttSink * self);
+static void gst_mqtt_sink_set_compact_header (GstMqttSink * self,
+    const gboolean flag);
+static guint gst_mqtt_sink_get_mqtt_ntp_refresh (GstMqttSink * self);
+static void gst_mqtt_sink_set_mqtt_ntp_refresh (GstMqttSink * self,
+    const guint interval);
 static gchar *gst_mqtt_sink_get_mqtt_ntp_srvs (GstMqttSink * self);
 static void gst_mqtt_sink_set_mqtt_ntp_srvs (GstMqttSink * self,
     const gchar * pairs);
@@ -214,8 +233,19 @@ gst_mqtt_sink_init (GstMqttSink * self)
   self->mqtt_ntp_hnames = NULL;
   self->mqtt_ntp_ports = NULL;
   self->mqtt_ntp_num_srvs = 0;
+  self->mqtt_ntp_refresh = DEFAULT_MQTT_NTP_REFRESH;
+  self->ntp_clock = NULL;
   self->get_epoch_func = default_mqtt_get_unix_epoch;
   self->is_connected = FALSE;
+  self->max_batch = DEFAULT_MAX_BATCH;
+  self->batch_timeout = DEFAULT_BATCH_TIMEOUT;
+  self->batch = g_ptr_array_new_with_free_func ((GDestroyNotify) gst_buffer_unref);
+  self->batch_start_time = 0;
+  self->compact_header = DEFAULT_COMPACT_HEADER;
+  self->caps_gen = 0;
+  self->sent_caps_gen = 0;
+  self->caps_sent = FALSE;
+  self->caps_sent_time = 0;
 
   /** init basesink properties */
   gst_base_sink_set_qos_enabled (basesink, DEFAULT_QOS);
@@ -271,6 +301,13 @@ gst_mqtt_sink_class_init (GstMqttSinkClass * klass)
           DEFAULT_MQTT_NTP_SERVERS,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_MQTT_NTP_REFRESH,
+      g_param_spec_uint ("ntp-refresh", "NTP Refresh Interval",
+          "The interval (in seconds) to measure the offset to the NTP servers "
+          "again in the background (valid only if ntp-sync is true)",
+          1, G_MAXUINT, DEFAULT_MQTT_NTP_REFRESH,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   g_object_class_install_property (gobject_class, PROP_MQTT_PUB_TOPIC,
       g_param_spec_string ("pub-topic", "Topic to Publish",
           "The topic's name to publish", NULL,
@@ -318,6 +355,26 @@ gst_mqtt_sink_class_init (GstMqttSinkClass * klass)
           "\t\t\tsee also: https://www.eclipse.org/paho/files/mqttdoc/MQTTAsync/html/qos.html",
           0, 2, DEFAULT_MQTT_QOS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_MAX_BATCH,
+      g_param_spec_uint ("max-batch", "Max number of buffers in a message",
+          "The maximum number of buffers packed into a message (1 = publish each buffer). "
+          "mqttsrc unpacks the message into the buffers",
+          1, G_MAXUINT, DEFAULT_MAX_BATCH,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_BATCH_TIMEOUT,
+      g_param_spec_uint ("batch-timeout", "Timeout for a batched message",
+          "The maximum time (in ms) to hold the buffers to be packed into a message "
+          "(0 = no limit, valid only if max-batch is larger than 1)",
+          0, G_MAXUINT, DEFAULT_BATCH_TIMEOUT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_COMPACT_HEADER,
+      g_param_spec_boolean ("compact-header", "Compact header",
+          "Prepend a compact binary header instead of the fixed-size header to each message. "
+          "The caps are sent only when they change and periodically for late subscribers",
+          DEFAULT_COMPACT_HEADER, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state = gst_mqtt_sink_change_state;
 
   gstbasesink_class->start = GST_DEBUG_FUNCPTR (gst_mqtt_sink_start);
@@ -386,6 +443,18 @@ gst_mqtt_sink_set_property (GObject * object, guint prop_id,
     case PROP_MQTT_NTP_SRVS:
       gst_mqtt_sink_set_mqtt_ntp_srvs (self, g_value_get_string (value));
       break;
+    case PROP_MQTT_NTP_REFRESH:
+      gst_mqtt_sink_set_mqtt_ntp_refresh (self, g_value_get_uint (value));
+      break;
+    case PROP_MAX_BATCH:
+      gst_mqtt_sink_set_max_batch (self, g_value_get_uint (value));
+      break;
+    case PROP_BATCH_TIMEOUT:
+      gst_mqtt_sink_set_batch_timeout (self, g_value_get_uint (value));
+      break;
+    case PROP_COMPACT_HEADER:
+      gst_mqtt_sink_set_compact_header (self, g_value_get_boolean (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -441,6 +510,18 @@ gst_mqtt_sink_get_property (GObject * object, guint prop_id,
     case PROP_MQTT_NTP_SRVS:
       g_value_set_string (value, gst_mqtt_sink_get_mqtt_ntp_srvs (self));
       break;
+    case PROP_MQTT_NTP_REFRESH:
+      g_value_set_uint (value, gst_mqtt_sink_get_mqtt_ntp_refresh (self));
+      break;
+    case PROP_MAX_BATCH:
+      g_value_set_uint (value, gst_mqtt_sink_get_max_batch (self));
+      break;
+    case PROP_BATCH_TIMEOUT:
+      g_value_set_uint (value, gst_mqtt_sink_get_batch_timeout (self));
+      break;
+    case PROP_COMPACT_HEADER:
+      g_value_set_boolean (value, gst_mqtt_sink_get_compact_header (self));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -477,6 +558,10 @@ gst_mqtt_sink_class_finalize (GObject * object)
   self->mqtt_ntp_hnames = NULL;
   g_free (self->mqtt_ntp_ports);
   self->mqtt_ntp_ports = NULL;
+  ntputil_clock_free (self->ntp_clock);
+  self->ntp_clock = NULL;
+  g_ptr_array_free (self->batch, TRUE);
+  self->batch = NULL;
 
   if (self->err)
     g_error_free (self->err);
@@ -484,6 +569,19 @@ gst_mqtt_sink_class_finalize (GObject * object)
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+/**
+ * @brief Get the current Unix epoch time in microseconds, from the NTP clock if ntp-sync is set.
+ */
+static gint64
+_mqtt_sink_get_epoch (GstMqttSink * self)
+{
+  if (self->ntp_clock)
+    return ntputil_clock_get_epoch (self->ntp_clock);
+
+  return self->get_epoch_func (self->mqtt_ntp_num_srvs, self->mqtt_ntp_hnames,
+      self->mqtt_ntp_ports);
+}
+
 /**
  * @brief Handle mqttsink's state change
  */
@@ -510,8 +608,15 @@ gst_mqtt_sink_change_state (GstElement * element, GstStateChange transition)
       GST_INFO_OBJECT (self, "GST_STATE_CHANGE_READY_TO_PAUSED");
       break;
     case GST_STATE_CHANGE_PAUSED_TO_PLAYING:
-      if (self->mqtt_ntp_sync)
-        self->get_epoch_func = ntputil_get_epoch;
+      if (self->mqtt_ntp_sync && !self->ntp_clock) {
+        /* the offset is measured in the background, this does not block */
+        self->ntp_clock = ntputil_clock_new (self->mqtt_ntp_num_srvs,
+            self->mqtt_ntp_hnames, self->mqtt_ntp_ports,
+            self->mqtt_ntp_refresh);
+        if (!self->ntp_clock)
+          GST_WARNING_OBJECT (self, "Failed to start the NTP clock, "
+              "the local clock is used");
+      }
       self->base_time_epoch = GST_CLOCK_TIME_NONE;
       elem_clock = gst_element_get_clock (element);
       if (!elem_clock)
@@ -521,8 +626,9 @@ gst_mqtt_sink_change_state (GstElement * element, GstStateChange transition)
       gst_object_unref (elem_clock);
       diff = GST_CLOCK_DIFF (base_time, cur_time);
       self->base_time_epoch =
-          self->get_epoch_func (self->mqtt_ntp_num_srvs, self->mqtt_ntp_hnames,
-          self->mqtt_ntp_ports) * GST_US_TO_NS_MULTIPLIER - diff;
+          _mqtt_sink_get_epoch (self) * GST_US_TO_NS_MULTIPLIER - diff;
+      /* The compact header carries the base time along with the caps */
+      self->caps_sent = FALSE;
       GST_INFO_OBJECT (self, "GST_STATE_CHANGE_PAUSED_TO_PLAYING");
       break;
     default:
@@ -540,6 +646,8 @@ gst_mqtt_sink_change_state (GstElement * element, GstStateChange transition)
       break;
     case GST_STATE_CHANGE_READY_TO_NULL:
       GST_INFO_OBJECT (self, "GST_STATE_CHANGE_READY_TO_NULL");
+      ntputil_clock_free (self->ntp_clock);
+      self->ntp_clock = NULL;
     default:
       break;
   }
@@ -631,6 +739,7 @@ gst_mqtt_sink_stop (GstBaseSink * basesink)
   disconn_opts.onFailure = cb_mqtt_on_disconnect_failure;
   disconn_opts.context = self;
 
+  g_ptr_array_set_size (self->batch, 0);
   g_atomic_int_set (&self->mqtt_sink_state, SINK_RENDER_STOPPED);
   while (MQTTAsync_isConnected (self->mqtt_client_handle)) {
     gint64 end_time = g_get_monotonic_time () + DEFAULT_MQTT_DISCONNECT_TIMEOUT;
@@ -689,8 +798,7 @@ _put_timestamp_to_msg_buf_hdr (GstMqttSink * self, GstBuffer * gst_buf,
     GstMQTTMessageHdr * hdr)
 {
   hdr->base_time_epoch = self->base_time_epoch;
-  hdr->sent_time_epoch = self->get_epoch_func (self->mqtt_ntp_num_srvs,
-      self->mqtt_ntp_hnames, self->mqtt_ntp_ports) * GST_US_TO_NS_MULTIPLIER;
+  hdr->sent_time_epoch = _mqtt_sink_get_epoch (self) * GST_US_TO_NS_MULTIPLIER;
 
   hdr->duration = GST_BUFFER_DURATION_IS_VALID (gst_buf) ?
       GST_BUFFER_DURATION (gst_buf) : GST_CLOCK_TIME_NONE;
@@ -744,6 +852,251 @@ _mqtt_set_msg_buf_hdr (GstBuffer * gst_buf, GstMQTTMessageHdr * hdr)
   return ret;
 }
 
+/**
+ * @brief A utility function to get the size of the compact header
+ * @param caps_len the length of the caps string, or -1 if the caps are not sent
+ */
+static gsize
+_mqtt_sink_get_compact_hdr_size (guint num_mems, gssize caps_len)
+{
+  gsize size = sizeof (GstMQTTCompactHdr) + num_mems * sizeof (guint32);
+
+  if (caps_len >= 0)
+    size += sizeof (gint64) + sizeof (guint32) + caps_len;
+
+  return GST_ROUND_UP_8 (size);
+}
+
+/**
+ * @brief A utility function to check whether the caps should be sent with the compact header
+ */
+static gboolean
+_mqtt_sink_needs_caps (GstMqttSink * self, gint64 now)
+{
+  if (!self->caps_sent || self->sent_caps_gen != self->caps_gen)
+    return TRUE;
+
+  return (now - self->caps_sent_time >=
+      GST_MQTT_COMPACT_CAPS_INTERVAL_MS * G_TIME_SPAN_MILLISECOND);
+}
+
+/**
+ * @brief A utility function to write the compact header of the buffer into the message
+ * @param caps_len the length of the caps string, or -1 if the caps are not sent
+ */
+static void
+_mqtt_sink_put_compact_hdr (GstMqttSink * self, GstBuffer * gst_buf,
+    guint8 * msg, gssize caps_len)
+{
+  const gsize hdr_size =
+      _mqtt_sink_get_compact_hdr_size (self->mqtt_msg_hdr.num_mems, caps_len);
+  GstMQTTCompactHdr *hdr = (GstMQTTCompactHdr *) msg;
+  gsize offset = sizeof (GstMQTTCompactHdr);
+  guint i;
+
+  memset (msg, 0x0, hdr_size);
+  hdr->magic = GST_MQTT_COMPACT_HDR_MAGIC;
+  hdr->caps_gen = self->caps_gen;
+  hdr->num_mems = self->mqtt_msg_hdr.num_mems;
+  hdr->sent_time_epoch = _mqtt_sink_get_epoch (self) * GST_US_TO_NS_MULTIPLIER;
+  hdr->duration = GST_BUFFER_DURATION_IS_VALID (gst_buf) ?
+      GST_BUFFER_DURATION (gst_buf) : GST_CLOCK_TIME_NONE;
+  hdr->dts = GST_BUFFER_DTS_IS_VALID (gst_buf) ?
+      GST_BUFFER_DTS (gst_buf) : GST_CLOCK_TIME_NONE;
+  hdr->pts = GST_BUFFER_PTS_IS_VALID (gst_buf) ?
+      GST_BUFFER_PTS (gst_buf) : GST_CLOCK_TIME_NONE;
+
+  for (i = 0; i < hdr->num_mems; ++i) {
+    guint32 mem_size = (guint32) self->mqtt_msg_hdr.size_mems[i];
+
+    memcpy (&msg[offset], &mem_size, sizeof (mem_size));
+    offset += sizeof (mem_size);
+  }
+
+  if (caps_len >= 0) {
+    guint32 len = (guint32) caps_len;
+
+    hdr->flags |= GST_MQTT_COMPACT_FLAG_CAPS;
+    memcpy (&msg[offset], &self->base_time_epoch, sizeof (gint64));
+    offset += sizeof (gint64);
+    memcpy (&msg[offset], &len, sizeof (len));
+    offset += sizeof (len);
+    memcpy (&msg[offset], self->mqtt_msg_hdr.gst_caps_str, len);
+
+    self->caps_sent = TRUE;
+    self->sent_caps_gen = self->caps_gen;
+    self->caps_sent_time = g_get_monotonic_time ();
+  }
+}
+
+/**
+ * @brief A utility function to make the message buffer hold the message of the given size
+ * @note MQTTAsync_send () copies the payload into its own command queue, so the
+ *       message buffer is reusable right after it returns. The buffer is kept
+ *       and only grown (to the next power of two) if a larger message comes.
+ */
+static gboolean
+_mqtt_sink_reserve_msg_buf (GstMqttSink * self, gsize msg_size)
+{
+  gsize new_size;
+
+  if (self->max_msg_buf_size != 0 &&
+      self->max_msg_buf_size + GST_MQTT_LEN_MSG_HDR < msg_size) {
+    g_printerr ("%s: The given size for a message buffer is too small: "
+        "given (%" G_GSIZE_FORMAT " bytes) vs. incoming (%" G_GSIZE_FORMAT
+        " bytes)\n", TAG_ERR_MQTTSINK, self->max_msg_buf_size,
+        msg_size - GST_MQTT_LEN_MSG_HDR);
+    return FALSE;
+  }
+
+  if (msg_size > G_MAXINT) {
+    g_printerr ("%s: The message is too large: %" G_GSIZE_FORMAT " bytes\n",
+        TAG_ERR_MQTTSINK, msg_size);
+    return FALSE;
+  }
+
+  if (self->mqtt_msg_buf && self->mqtt_msg_buf_size >= msg_size)
+    return TRUE;
+
+  if (self->max_msg_buf_size != 0) {
+    new_size = self->max_msg_buf_size + GST_MQTT_LEN_MSG_HDR;
+  } else {
+    new_size = GST_MQTT_LEN_MSG_HDR;
+    while (new_size < msg_size)
+      new_size <<= 1;
+  }
+
+  g_free (self->mqtt_msg_buf);
+  self->mqtt_msg_buf = g_try_malloc0 (new_size);
+  self->mqtt_msg_buf_size = self->mqtt_msg_buf ? new_size : 0;
+
+  return (self->mqtt_msg_buf != NULL);
+}
+
+/**
+ * @brief A utility function to publish the buffers in the batch as a message
+ */
+static GstFlowReturn
+_mqtt_sink_publish_batch (GstMqttSink * self)
+{
+  const guint num_frames = self->batch->len;
+  GstMQTTMessageHdr *hdr;
+  GstMQTTFrameIdx frame_idx;
+  gsize idx_size = 0;
+  gsize data_size = 0;
+  gsize msg_size, offset, data_offset;
+  GstFlowReturn ret = GST_FLOW_OK;
+  guint8 *msg_pub;
+  gint mqtt_rc;
+  guint i, j;
+
+  if (num_frames == 0)
+    return GST_FLOW_OK;
+
+  for (i = 0; i < num_frames; ++i) {
+    GstBuffer *buf = g_ptr_array_index (self->batch, i);
+    guint num_mems = gst_buffer_n_memory (buf);
+
+    if (num_mems > GST_MQTT_MAX_NUM_MEMS) {
+      g_printerr ("%s: Too many memories in a buffer to be batched: %u\n",
+          TAG_ERR_MQTTSINK, num_mems);
+      ret = GST_FLOW_ERROR;
+      goto ret_clear_batch;
+    }
+
+    idx_size += sizeof (GstMQTTFrameIdx) + num_mems * sizeof (guint32);
+    data_size += gst_buffer_get_size (buf);
+  }
+
+  idx_size = GST_ROUND_UP_8 (idx_size);
+  msg_size = GST_MQTT_LEN_MSG_HDR + idx_size + data_size;
+  if (!_mqtt_sink_reserve_msg_buf (self, msg_size)) {
+    ret = GST_FLOW_ERROR;
+    goto ret_clear_batch;
+  }
+
+  msg_pub = self->mqtt_msg_buf;
+
+  hdr = (GstMQTTMessageHdr *) msg_pub;
+  memcpy (hdr, &self->mqtt_msg_hdr, sizeof (self->mqtt_msg_hdr));
+  memset (hdr->size_mems, 0x0, sizeof (hdr->size_mems));
+  hdr->num_mems = 0;
+  hdr->num_frames = num_frames;
+  _put_timestamp_to_msg_buf_hdr (self, g_ptr_array_index (self->batch, 0),
+      hdr);
+
+  offset = GST_MQTT_LEN_MSG_HDR;
+  data_offset = GST_MQTT_LEN_MSG_HDR + idx_size;
+  memset (&msg_pub[offset], 0x0, idx_size);
+
+  for (i = 0; i < num_frames; ++i) {
+    GstBuffer *buf = g_ptr_array_index (self->batch, i);
+
+    memset (&frame_idx, 0x0, sizeof (frame_idx));
+    frame_idx.duration = GST_BUFFER_DURATION_IS_VALID (buf) ?
+        GST_BUFFER_DURATION (buf) : GST_CLOCK_TIME_NONE;
+    frame_idx.dts = GST_BUFFER_DTS_IS_VALID (buf) ?
+        GST_BUFFER_DTS (buf) : GST_CLOCK_TIME_NONE;
+    frame_idx.pts = GST_BUFFER_PTS_IS_VALID (buf) ?
+        GST_BUFFER_PTS (buf) : GST_CLOCK_TIME_NONE;
+    frame_idx.num_mems = gst_buffer_n_memory (buf);
+    memcpy (&msg_pub[offset], &frame_idx, sizeof (frame_idx));
+    offset += sizeof (frame_idx);
+
+    for (j = 0; j < frame_idx.num_mems; ++j) {
+      GstMemory *mem = gst_buffer_peek_memory (buf, j);
+      GstMapInfo map;
+      guint32 mem_size;
+
+      if (!gst_memory_map (mem, &map, GST_MAP_READ)) {
+        ret = GST_FLOW_ERROR;
+        goto ret_clear_batch;
+      }
+
+      mem_size = (guint32) map.size;
+      memcpy (&msg_pub[offset], &mem_size, sizeof (mem_size));
+      offset += sizeof (mem_size);
+
+      memcpy (&msg_pub[data_offset], map.data, map.size);
+      data_offset += map.size;
+      gst_memory_unmap (mem, &map);
+    }
+  }
+
+  mqtt_rc = MQTTAsync_send (self->mqtt_client_handle, self->mqtt_topic,
+      (int) msg_size, self->mqtt_msg_buf, self->mqtt_qos, 1,
+      &self->mqtt_respn_opts);
+  if (mqtt_rc != MQTTASYNC_SUCCESS) {
+    ret = GST_FLOW_ERROR;
+  }
+
+ret_clear_batch:
+  g_ptr_array_set_size (self->batch, 0);
+  return ret;
+}
+
+/**
+ * @brief A utility function to add the buffer to the batch and publish the batch if it is full
+ */
+static GstFlowReturn
+_mqtt_sink_add_to_batch (GstMqttSink * self, GstBuffer * in_buf)
+{
+  gint64 now = g_get_monotonic_time ();
+
+  if (self->batch->len == 0)
+    self->batch_start_time = now;
+
+  g_ptr_array_add (self->batch, gst_buffer_ref (in_buf));
+
+  if (self->batch->len >= self->max_batch || self->num_buffers == 0 ||
+      (self->batch_timeout != 0 && now - self->batch_start_time >=
+          (gint64) self->batch_timeout * G_TIME_SPAN_MILLISECOND)) {
+    return _mqtt_sink_publish_batch (self);
+  }
+
+  return GST_FLOW_OK;
+}
+
 /**
  * @brief The callback to process each buffer receiving on the sink pad
  */
@@ -751,12 +1104,12 @@ static GstFlowReturn
 gst_mqtt_sink_render (GstBaseSink * basesink, GstBuffer * in_buf)
 {
   const gsize in_buf_size = gst_buffer_get_size (in_buf);
-  static gboolean is_static_sized_buf = FALSE;
   GstMqttSink *self = GST_MQTT_SINK (basesink);
   GstFlowReturn ret = GST_FLOW_ERROR;
   mqtt_sink_state_t cur_state;
-  GstMemory *in_buf_mem;
-  GstMapInfo in_buf_map;
+  gsize offset, hdr_size;
+  gssize caps_len = -1;
+  guint num_mems, i;
   gint mqtt_rc;
   guint8 *msg_pub;
 
@@ -797,31 +1150,9 @@ gst_mqtt_sink_render (GstBaseSink * basesink, GstBuffer * in_buf)
     self->num_buffers -= 1;
   }
 
-  if ((!is_static_sized_buf) && (self->mqtt_msg_buf) &&
-      (self->mqtt_msg_buf_size != 0) &&
-      (self->mqtt_msg_buf_size < in_buf_size + GST_MQTT_LEN_MSG_HDR)) {
-    g_free (self->mqtt_msg_buf);
-    self->mqtt_msg_buf = NULL;
-    self->mqtt_msg_buf_size = 0;
-  }
-
-  /** Allocate a message buffer */
-  if ((!self->mqtt_msg_buf) && (self->mqtt_msg_buf_size == 0)) {
-    if (self->max_msg_buf_size == 0) {
-      self->mqtt_msg_buf_size = in_buf_size + GST_MQTT_LEN_MSG_HDR;
-    } else {
-      if (self->max_msg_buf_size < in_buf_size) {
-        g_printerr ("%s: The given size for a message buffer is too small: "
-            "given (%" G_GSIZE_FORMAT " bytes) vs. incoming (%" G_GSIZE_FORMAT
-            " bytes)\n", TAG_ERR_MQTTSINK, self->max_msg_buf_size, in_buf_size);
-        ret = GST_FLOW_ERROR;
-        goto ret_with;
-      }
-      self->mqtt_msg_buf_size = self->max_msg_buf_size + GST_MQTT_LEN_MSG_HDR;
-      is_static_sized_buf = TRUE;
-    }
-
-    self->mqtt_msg_buf = g_try_malloc0 (self->mqtt_msg_buf_size);
+  if (self->max_batch > 1) {
+    ret = _mqtt_sink_add_to_batch (self, in_buf);
+    goto ret_with;
   }
 
   if (!_mqtt_set_msg_buf_hdr (in_buf, &self->mqtt_msg_hdr)) {
@@ -829,42 +1160,54 @@ gst_mqtt_sink_render (GstBaseSink * basesink, GstBuffer * in_buf)
     goto ret_with;
   }
 
-  msg_pub = self->mqtt_msg_buf;
-  if (!msg_pub) {
-    self->mqtt_msg_buf_size = 0;
-    ret = GST_FLOW_ERROR;
-    goto ret_with;
+  num_mems = self->mqtt_msg_hdr.num_mems;
+  if (self->compact_header) {
+    if (_mqtt_sink_needs_caps (self, g_get_monotonic_time ()))
+      caps_len = strlen (self->mqtt_msg_hdr.gst_caps_str);
+    hdr_size = _mqtt_sink_get_compact_hdr_size (num_mems, caps_len);
+  } else {
+    hdr_size = GST_MQTT_LEN_MSG_HDR;
   }
-  memcpy (msg_pub, &self->mqtt_msg_hdr, sizeof (self->mqtt_msg_hdr));
-  _put_timestamp_to_msg_buf_hdr (self, in_buf, (GstMQTTMessageHdr *) msg_pub);
 
-  in_buf_mem = gst_buffer_get_all_memory (in_buf);
-  if (!in_buf_mem) {
+  if (!_mqtt_sink_reserve_msg_buf (self, in_buf_size + hdr_size)) {
     ret = GST_FLOW_ERROR;
     goto ret_with;
   }
 
-  if (!gst_memory_map (in_buf_mem, &in_buf_map, GST_MAP_READ)) {
-    ret = GST_FLOW_ERROR;
-    goto ret_unref_in_buf_mem;
+  msg_pub = self->mqtt_msg_buf;
+  if (self->compact_header) {
+    _mqtt_sink_put_compact_hdr (self, in_buf, msg_pub, caps_len);
+  } else {
+    memcpy (msg_pub, &self->mqtt_msg_hdr, sizeof (self->mqtt_msg_hdr));
+    _put_timestamp_to_msg_buf_hdr (self, in_buf,
+        (GstMQTTMessageHdr *) msg_pub);
+  }
+
+  /** Gather each memory right behind the header, without merging them first */
+  offset = hdr_size;
+  for (i = 0; i < num_mems; ++i) {
+    GstMemory *mem = gst_buffer_peek_memory (in_buf, i);
+    GstMapInfo map;
+
+    if (!gst_memory_map (mem, &map, GST_MAP_READ)) {
+      ret = GST_FLOW_ERROR;
+      goto ret_with;
+    }
+
+    memcpy (&msg_pub[offset], map.data, map.size);
+    offset += map.size;
+    gst_memory_unmap (mem, &map);
   }
 
   ret = GST_FLOW_OK;
 
-  memcpy (&msg_pub[sizeof (self->mqtt_msg_hdr)], in_buf_map.data,
-      in_buf_map.size);
   mqtt_rc = MQTTAsync_send (self->mqtt_client_handle, self->mqtt_topic,
-      GST_MQTT_LEN_MSG_HDR + in_buf_map.size, self->mqtt_msg_buf,
-      self->mqtt_qos, 1, &self->mqtt_respn_opts);
+      (int) offset, self->mqtt_msg_buf, self->mqtt_qos, 1,
+      &self->mqtt_respn_opts);
   if (mqtt_rc != MQTTASYNC_SUCCESS) {
     ret = GST_FLOW_ERROR;
   }
 
-  gst_memory_unmap (in_buf_mem, &in_buf_map);
-
-ret_unref_in_buf_mem:
-  gst_memory_unref (in_buf_mem);
-
 ret_with:
   return ret;
 }
@@ -903,6 +1246,8 @@ gst_mqtt_sink_event (GstBaseSink * basesink, GstEvent * event)
 
   switch (type) {
     case GST_EVENT_EOS:
+      if (g_atomic_int_get (&self->mqtt_sink_state) == MQTT_CONNECTED)
+        _mqtt_sink_publish_batch (self);
       g_atomic_int_set (&self->mqtt_sink_state, SINK_RENDER_EOS);
       g_mutex_lock (&self->mqtt_sink_mutex);
       g_cond_broadcast (&self->mqtt_sink_gcond);
@@ -926,11 +1271,16 @@ gst_mqtt_sink_set_caps (GstBaseSink * basesink, GstCaps * caps)
   GstMqttSink *self = GST_MQTT_SINK (basesink);
   gboolean ret;
 
+  if (!self->in_caps || !gst_caps_is_equal (self->in_caps, caps))
+    self->caps_gen++;
+
   ret = gst_caps_replace (&self->in_caps, caps);
 
   if (ret && gst_caps_is_fixed (self->in_caps)) {
     char *caps_str = gst_caps_to_string (caps);
 
+    memset (self->mqtt_msg_hdr.gst_caps_str, 0x0,
+        GST_MQTT_MAX_LEN_GST_CAPS_STR);
     strncpy (self->mqtt_msg_hdr.gst_caps_str, caps_str,
         MIN (strlen (caps_str), GST_MQTT_MAX_LEN_GST_CAPS_STR - 1));
     g_free (caps_str);
@@ -1130,6 +1480,60 @@ gst_mqtt_sink_set_num_buffers (GstMqttSink * self, const gint num)
   self->num_buffers = num;
 }
 
+/**
+ * @brief Getter for the 'max-batch' property.
+ */
+static guint
+gst_mqtt_sink_get_max_batch (GstMqttSink * self)
+{
+  return self->max_batch;
+}
+
+/**
+ * @brief Setter for the 'max-batch' property
+ */
+static void
+gst_mqtt_sink_set_max_batch (GstMqttSink * self, const guint num)
+{
+  self->max_batch = num;
+}
+
+/**
+ * @brief Getter for the 'batch-timeout' property.
+ */
+static guint
+gst_mqtt_sink_get_batch_timeout (GstMqttSink * self)
+{
+  return self->batch_timeout;
+}
+
+/**
+ * @brief Setter for the 'batch-timeout' property
+ */
+static void
+gst_mqtt_sink_set_batch_timeout (GstMqttSink * self, const guint timeout)
+{
+  self->batch_timeout = timeout;
+}
+
+/**
+ * @brief Getter for the 'compact-header' property.
+ */
+static gboolean
+gst_mqtt_sink_get_compact_header (GstMqttSink * self)
+{
+  return self->compact_header;
+}
+
+/**
+ * @brief Setter for the 'compact-header' property
+ */
+static void
+gst_mqtt_sink_set_compact_header (GstMqttSink * self, const gboolean flag)
+{
+  self->compact_header = flag;
+}
+
 /**
  * @brief Getter for the 'mqtt-qos' property.
  */
@@ -1166,6 +1570,24 @@ gst_mqtt_sink_set_mqtt_ntp_sync (GstMqttSink * self, const gboolean flag)
   self->mqtt_ntp_sync = flag;
 }
 
+/**
+ * @brief Getter for the 'ntp-refresh' property.
+ */
+static guint
+gst_mqtt_sink_get_mqtt_ntp_refresh (GstMqttSink * self)
+{
+  return self->mqtt_ntp_refresh;
+}
+
+/**
+ * @brief Setter for the 'ntp-refresh' property
+ */
+static void
+gst_mqtt_sink_set_mqtt_ntp_refresh (GstMqttSink * self, const guint interval)
+{
+  self->mqtt_ntp_refresh = interval;
+}
+
 /**
  * @brief Getter for the 'ntp-srvs' property.
  */
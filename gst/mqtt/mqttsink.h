@@ -18,6 +18,7 @@
 #include <MQTTAsync.h>
 
 #include "mqttcommon.h"
+#include "ntputil.h"
 
 G_BEGIN_DECLS
 
@@ -80,6 +81,8 @@ struct _GstMqttSink {
   gchar *mqtt_ntp_srvs;
   gchar **mqtt_ntp_hnames;
   guint16 *mqtt_ntp_ports;
+  guint mqtt_ntp_refresh;
+  ntputil_clock_t *ntp_clock;
   gboolean is_connected;
 
   mqtt_get_unix_epoch get_epoch_func;
@@ -88,6 +91,17 @@ struct _GstMqttSink {
   gpointer mqtt_msg_buf;
   gsize mqtt_msg_buf_size;
 
+  gboolean compact_header;
+  guint16 caps_gen;
+  guint16 sent_caps_gen;
+  gboolean caps_sent;
+  gint64 caps_sent_time;
+
+  guint max_batch;
+  guint batch_timeout;
+  GPtrArray *batch;
+  gint64 batch_start_time;
+
   MQTTAsync mqtt_client_handle;
   MQTTAsync_connectOptions mqtt_conn_opts;
   MQTTAsync_responseOptions mqtt_respn_opts;
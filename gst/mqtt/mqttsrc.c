@@ -51,6 +51,9 @@ enum
   PROP_MQTT_OPT_CLEANSESSION,
   PROP_MQTT_OPT_KEEP_ALIVE_INTERVAL,
   PROP_MQTT_QOS,
+  PROP_MAX_QUEUE_SIZE,
+  PROP_LEAKY,
+  PROP_NUM_DROPPED,
 
   PROP_LAST
 };
@@ -64,6 +67,8 @@ enum
   DEFAULT_MQTT_SUB_TIMEOUT = 10000000,  /* 10 seconds */
   DEFAULT_MQTT_SUB_TIMEOUT_MIN = 1000000,       /* 1 seconds */
   DEFAULT_MQTT_QOS = 2,         /* Once and one only */
+  DEFAULT_MAX_QUEUE_SIZE = 0,   /* unlimited */
+  DEFAULT_LEAKY = GST_MQTT_SRC_LEAKY_DOWNSTREAM,
 };
 
 static guint8 src_client_id = 0;
@@ -74,6 +79,41 @@ static const gchar DEFAULT_MQTT_CLIENT_ID[] =
     "$HOSTNAME_$PID_^[0-9][0-9]?$|^255$";
 static const gchar DEFAULT_MQTT_CLIENT_ID_FORMAT[] = "%s_%u_src%u";
 
+/**
+ * The memory budget of nnstreamer, kept by the tensor allocator.
+ * mqttsrc does not link nnstreamer, it finds the allocator by name.
+ */
+static const gchar MEM_BUDGET_ALLOCATOR[] = "GstTensorAllocator";
+enum
+{
+  MEM_PRESSURE_NONE = 0,
+  MEM_PRESSURE_THROTTLE = 1,
+  MEM_PRESSURE_DROP = 2,
+};
+
+#define GST_TYPE_MQTT_SRC_LEAKY (gst_mqtt_src_leaky_get_type ())
+
+/**
+ * @brief Register GEnumValue array for the 'leaky' property
+ */
+static GType
+gst_mqtt_src_leaky_get_type (void)
+{
+  static GType leaky = 0;
+  if (leaky == 0) {
+    static GEnumValue leaky_types[] = {
+      {GST_MQTT_SRC_LEAKY_UPSTREAM, "upstream",
+          "Drop the arriving message when the queue is full"},
+      {GST_MQTT_SRC_LEAKY_DOWNSTREAM, "downstream",
+          "Drop the oldest message in the queue when the queue is full"},
+      {0, NULL, NULL},
+    };
+    leaky = g_enum_register_static ("GstMqttSrcLeaky", leaky_types);
+  }
+
+  return leaky;
+}
+
 /** Function prototype declarations */
 static void
 gst_mqtt_src_set_property (GObject * object, guint prop_id,
@@ -123,6 +163,13 @@ static void gst_mqtt_src_set_opt_keep_alive_interval (GstMqttSrc * self,
     const gint num);
 static gint gst_mqtt_src_get_mqtt_qos (GstMqttSrc * self);
 static void gst_mqtt_src_set_mqtt_qos (GstMqttSrc * self, const gint qos);
+static guint gst_mqtt_src_get_max_queue_size (GstMqttSrc * self);
+static void gst_mqtt_src_set_max_queue_size (GstMqttSrc * self,
+    const guint size);
+static GstMqttSrcLeaky gst_mqtt_src_get_leaky (GstMqttSrc * self);
+static void gst_mqtt_src_set_leaky (GstMqttSrc * self,
+    const GstMqttSrcLeaky leaky);
+static guint64 gst_mqtt_src_get_num_dropped (GstMqttSrc * self);
 
 static void cb_mqtt_on_connection_lost (void *context, char *cause);
 static int cb_mqtt_on_message_arrived (void *context, char *topic_name,
@@ -142,10 +189,19 @@ static void cb_mqtt_on_unsubscribe_failure (void *context,
 
 static void cb_memory_wrapped_destroy (void *p);
 
-static GstMQTTMessageHdr *_extract_mqtt_msg_hdr_from (GstMemory * mem,
-    GstMemory ** hdr_mem, GstMapInfo * hdr_map_info);
+static GstMQTTMessageHdr *_extract_mqtt_msg_hdr_from (const guint8 * data,
+    gsize size);
+static gboolean _validate_mem_sizes (const GstMQTTMessageHdr * hdr,
+    gsize hdr_size, gsize size);
 static void _put_timestamp_on_gst_buf (GstMqttSrc * self,
     GstMQTTMessageHdr * hdr, GstBuffer * buf);
+static gboolean _parse_compact_hdr (const guint8 * data, gsize size,
+    GstMQTTMessageHdr * hdr, gsize * hdr_size, guint16 * caps_gen,
+    gboolean * has_caps);
+static void _push_to_queue (GstMqttSrc * self, GstBuffer * buffer);
+static void _account_budget (GstMqttSrc * self, gint64 bytes);
+static gboolean _push_batched_frames (GstMqttSrc * self,
+    GstMQTTMessageHdr * hdr, GstMemory * mem, const guint8 * data, gsize size);
 static gboolean _subscribe (GstMqttSrc * self);
 static gboolean _unsubscribe (GstMqttSrc * self);
 
@@ -201,6 +257,13 @@ gst_mqtt_src_init (GstMqttSrc * self)
   /** init private member variables */
   self->err = NULL;
   self->aqueue = g_async_queue_new ();
+  self->max_queue_size = DEFAULT_MAX_QUEUE_SIZE;
+  self->leaky = DEFAULT_LEAKY;
+  self->num_dropped = 0;
+  self->budget = NULL;
+  self->has_caps_gen = FALSE;
+  self->caps_gen = 0;
+  self->peer_base_time_epoch = 0;
   g_cond_init (&self->mqtt_src_gcond);
   g_mutex_init (&self->mqtt_src_mutex);
   g_mutex_lock (&self->mqtt_src_mutex);
@@ -290,6 +353,24 @@ gst_mqtt_src_class_init (GstMqttSrcClass * klass)
           "\t\t\tsee also: https://www.eclipse.org/paho/files/mqttdoc/MQTTAsync/html/qos.html",
           0, 2, DEFAULT_MQTT_QOS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_MAX_QUEUE_SIZE,
+      g_param_spec_uint ("max-queue-size", "Max queue size",
+          "The maximum number of the received messages waiting to be pushed "
+          "(0 = unlimited). See also the 'leaky' property",
+          0, G_MAXUINT, DEFAULT_MAX_QUEUE_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_LEAKY,
+      g_param_spec_enum ("leaky", "Leaky",
+          "Which message to drop when the receive queue is full",
+          GST_TYPE_MQTT_SRC_LEAKY, DEFAULT_LEAKY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_NUM_DROPPED,
+      g_param_spec_uint64 ("num-dropped", "Number of dropped messages",
+          "The number of the messages dropped because the receive queue is full",
+          0, G_MAXUINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_mqtt_src_change_state);
 
@@ -349,6 +430,12 @@ gst_mqtt_src_set_property (GObject * object, guint prop_id,
     case PROP_MQTT_QOS:
       gst_mqtt_src_set_mqtt_qos (self, g_value_get_int (value));
       break;
+    case PROP_MAX_QUEUE_SIZE:
+      gst_mqtt_src_set_max_queue_size (self, g_value_get_uint (value));
+      break;
+    case PROP_LEAKY:
+      gst_mqtt_src_set_leaky (self, g_value_get_enum (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -395,6 +482,15 @@ gst_mqtt_src_get_property (GObject * object, guint prop_id,
     case PROP_MQTT_QOS:
       g_value_set_int (value, gst_mqtt_src_get_mqtt_qos (self));
       break;
+    case PROP_MAX_QUEUE_SIZE:
+      g_value_set_uint (value, gst_mqtt_src_get_max_queue_size (self));
+      break;
+    case PROP_LEAKY:
+      g_value_set_enum (value, gst_mqtt_src_get_leaky (self));
+      break;
+    case PROP_NUM_DROPPED:
+      g_value_set_uint64 (value, gst_mqtt_src_get_num_dropped (self));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -425,10 +521,14 @@ gst_mqtt_src_class_finalize (GObject * object)
     g_error_free (self->err);
 
   while ((remained = g_async_queue_try_pop (self->aqueue))) {
+    _account_budget (self, -((gint64) gst_buffer_get_size (remained)));
     gst_buffer_unref (remained);
   }
   g_clear_pointer (&self->aqueue, g_async_queue_unref);
 
+  if (self->budget)
+    gst_object_unref (self->budget);
+
   g_mutex_clear (&self->mqtt_src_mutex);
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -527,6 +627,10 @@ gst_mqtt_src_start (GstBaseSrc * basesrc)
   int ret;
   gint64 end_time;
 
+  /* the memory budget is set by nnstreamer ([allocator] in nnstreamer.ini) */
+  if (!self->budget)
+    self->budget = gst_allocator_find (MEM_BUDGET_ALLOCATOR);
+
   if (!g_strcmp0 (DEFAULT_MQTT_CLIENT_ID, self->mqtt_client_id)) {
     g_free (self->mqtt_client_id);
     self->mqtt_client_id = g_strdup_printf (DEFAULT_MQTT_CLIENT_ID_FORMAT,
@@ -744,6 +848,7 @@ gst_mqtt_src_create (GstBaseSrc * basesrc, guint64 offset, guint size,
     *buf = g_async_queue_timeout_pop (self->aqueue,
         DEFAULT_MQTT_SUB_TIMEOUT_MIN);
     if (*buf) {
+      _account_budget (self, -((gint64) gst_buffer_get_size (*buf)));
       GstClockTime base_time = gst_element_get_base_time (GST_ELEMENT (self));
       GstClockTime ulatency = GST_CLOCK_TIME_NONE;
       GstClock *clock;
@@ -1058,6 +1163,57 @@ gst_mqtt_src_set_mqtt_qos (GstMqttSrc * self, const gint qos)
   self->mqtt_qos = qos;
 }
 
+/**
+ * @brief Getter for the 'max-queue-size' property
+ */
+static guint
+gst_mqtt_src_get_max_queue_size (GstMqttSrc * self)
+{
+  return self->max_queue_size;
+}
+
+/**
+ * @brief Setter for the 'max-queue-size' property
+ */
+static void
+gst_mqtt_src_set_max_queue_size (GstMqttSrc * self, const guint size)
+{
+  self->max_queue_size = size;
+}
+
+/**
+ * @brief Getter for the 'leaky' property
+ */
+static GstMqttSrcLeaky
+gst_mqtt_src_get_leaky (GstMqttSrc * self)
+{
+  return self->leaky;
+}
+
+/**
+ * @brief Setter for the 'leaky' property
+ */
+static void
+gst_mqtt_src_set_leaky (GstMqttSrc * self, const GstMqttSrcLeaky leaky)
+{
+  self->leaky = leaky;
+}
+
+/**
+ * @brief Getter for the 'num-dropped' property
+ */
+static guint64
+gst_mqtt_src_get_num_dropped (GstMqttSrc * self)
+{
+  guint64 num;
+
+  g_async_queue_lock (self->aqueue);
+  num = self->num_dropped;
+  g_async_queue_unlock (self->aqueue);
+
+  return num;
+}
+
 /**
   * @brief A callback to handle the connection lost to the broker
   */
@@ -1090,16 +1246,17 @@ cb_mqtt_on_message_arrived (void *context, char *topic_name, int topic_len,
   const int size = message->payloadlen;
   guint8 *data = message->payload;
   GstMQTTMessageHdr *mqtt_msg_hdr;
-  GstMapInfo hdr_map_info;
+  GstMQTTMessageHdr compact_hdr;
   GstMemory *received_mem;
-  GstMemory *hdr_mem;
   GstBuffer *buffer;
   GstBaseSrc *basesrc;
   GstMqttSrc *self;
   GstClock *clock;
+  gboolean has_caps = TRUE;
+  gsize hdr_size = GST_MQTT_LEN_MSG_HDR;
   gsize offset;
+  guint32 magic = 0;
   guint i;
-  UNUSED (topic_name);
   UNUSED (topic_len);
 
   self = GST_MQTT_SRC_CAST (context);
@@ -1107,12 +1264,16 @@ cb_mqtt_on_message_arrived (void *context, char *topic_name, int topic_len,
   if (!self->is_subscribed) {
     g_mutex_unlock (&self->mqtt_src_mutex);
 
+    MQTTAsync_freeMessage (&message);
+    MQTTAsync_free (topic_name);
     return TRUE;
   }
   g_mutex_unlock (&self->mqtt_src_mutex);
 
+  /* returning TRUE passes the ownership of the topic name and message */
+  MQTTAsync_free (topic_name);
+
   basesrc = GST_BASE_SRC (self);
-  clock = gst_element_get_clock (GST_ELEMENT (self));
   received_mem = gst_memory_new_wrapped (0, data, size, 0, size, message,
       (GDestroyNotify) cb_memory_wrapped_destroy);
   if (!received_mem) {
@@ -1121,11 +1282,43 @@ cb_mqtt_on_message_arrived (void *context, char *topic_name, int topic_len,
           "%s: failed to wrap the raw data of received message in GstMemory: %s",
           __func__, g_strerror (ENODATA));
     }
+    MQTTAsync_freeMessage (&message);
     return TRUE;
   }
+  clock = gst_element_get_clock (GST_ELEMENT (self));
+
+  if (size >= (int) sizeof (magic))
+    memcpy (&magic, data, sizeof (magic));
+
+  if (magic == GST_MQTT_COMPACT_HDR_MAGIC) {
+    guint16 caps_gen;
+
+    mqtt_msg_hdr = &compact_hdr;
+    if (!_parse_compact_hdr (data, size, mqtt_msg_hdr, &hdr_size, &caps_gen,
+            &has_caps)) {
+      if (!self->err) {
+        self->err = g_error_new (self->gquark_err_tag, ENODATA,
+            "%s: failed to parse the compact header of received message: %s",
+            __func__, g_strerror (ENODATA));
+      }
+      goto ret_unref_received_mem;
+    }
+
+    if (has_caps) {
+      self->peer_base_time_epoch = mqtt_msg_hdr->base_time_epoch;
+      self->caps_gen = caps_gen;
+      self->has_caps_gen = TRUE;
+    } else if (!self->has_caps_gen || self->caps_gen != caps_gen) {
+      /* Wait for the message carrying the caps of this generation */
+      GST_DEBUG_OBJECT (self, "Drop a message of unknown caps generation %u",
+          caps_gen);
+      goto ret_unref_received_mem;
+    }
+    mqtt_msg_hdr->base_time_epoch = self->peer_base_time_epoch;
+  } else {
+    mqtt_msg_hdr = _extract_mqtt_msg_hdr_from (data, size);
+  }
 
-  mqtt_msg_hdr = _extract_mqtt_msg_hdr_from (received_mem, &hdr_mem,
-      &hdr_map_info);
   if (!mqtt_msg_hdr) {
     if (!self->err) {
       self->err = g_error_new (self->gquark_err_tag, ENODATA,
@@ -1135,7 +1328,9 @@ cb_mqtt_on_message_arrived (void *context, char *topic_name, int topic_len,
     goto ret_unref_received_mem;
   }
 
-  if (!self->caps) {
+  if (!has_caps) {
+    /* The caps are not changed since the last message with the caps */
+  } else if (!self->caps) {
     self->caps = gst_caps_from_string (mqtt_msg_hdr->gst_caps_str);
     gst_mqtt_src_renegotiate (basesrc);
   } else {
@@ -1149,16 +1344,30 @@ cb_mqtt_on_message_arrived (void *context, char *topic_name, int topic_len,
     }
   }
 
-  buffer = gst_buffer_new ();
-  offset = GST_MQTT_LEN_MSG_HDR;
-  for (i = 0; i < mqtt_msg_hdr->num_mems; ++i) {
-    GstMemory *each_memory;
-    int each_size;
-
-    each_size = mqtt_msg_hdr->size_mems[i];
-    each_memory = gst_memory_share (received_mem, offset, each_size);
-    gst_buffer_append_memory (buffer, each_memory);
-    offset += each_size;
+  buffer = NULL;
+  if (mqtt_msg_hdr->num_frames == 0) {
+    if (!_validate_mem_sizes (mqtt_msg_hdr, hdr_size, size)) {
+      if (!self->err) {
+        self->err = g_error_new (self->gquark_err_tag, ENODATA,
+            "%s: the memories in the header exceed the received message: %s",
+            __func__, g_strerror (ENODATA));
+      }
+      goto ret_unref_received_mem;
+    }
+
+    /**
+     * Each memory shares its range of the wrapped payload without copy.
+     * The payload is freed with the message when the last memory is released.
+     */
+    buffer = gst_buffer_new ();
+    offset = hdr_size;
+    for (i = 0; i < mqtt_msg_hdr->num_mems; ++i) {
+      gsize each_size = mqtt_msg_hdr->size_mems[i];
+
+      gst_buffer_append_memory (buffer,
+          gst_memory_share (received_mem, offset, each_size));
+      offset += each_size;
+    }
   }
 
   /** Timestamp synchronization */
@@ -1171,18 +1380,24 @@ cb_mqtt_on_message_arrived (void *context, char *topic_name, int topic_len,
           " and queue length is %d",
           GST_TIME_ARGS (gst_clock_get_time (clock) - base_time),
           g_async_queue_length (self->aqueue));
-
-      gst_object_unref (clock);
     }
   }
-  _put_timestamp_on_gst_buf (self, mqtt_msg_hdr, buffer);
-  g_async_queue_push (self->aqueue, buffer);
-
-  gst_memory_unmap (hdr_mem, &hdr_map_info);
-  gst_memory_unref (hdr_mem);
+  if (buffer) {
+    _put_timestamp_on_gst_buf (self, mqtt_msg_hdr, buffer);
+    _push_to_queue (self, buffer);
+  } else if (!_push_batched_frames (self, mqtt_msg_hdr, received_mem, data,
+          size)) {
+    if (!self->err) {
+      self->err = g_error_new (self->gquark_err_tag, ENODATA,
+          "%s: failed to unpack the frames from received batched message: %s",
+          __func__, g_strerror (ENODATA));
+    }
+  }
 
 ret_unref_received_mem:
   gst_memory_unref (received_mem);
+  if (clock)
+    gst_object_unref (clock);
 
   return TRUE;
 }
@@ -1357,20 +1572,234 @@ _unsubscribe (GstMqttSrc * self)
 
 /**
  * @brief A utility function to extract header information from a received message
+ * @note The header is read in place from the payload, which is allocated by
+ *       the MQTT library and suitably aligned.
  */
 static GstMQTTMessageHdr *
-_extract_mqtt_msg_hdr_from (GstMemory * mem, GstMemory ** hdr_mem,
-    GstMapInfo * hdr_map_info)
+_extract_mqtt_msg_hdr_from (const guint8 * data, gsize size)
 {
-  *hdr_mem = gst_memory_share (mem, 0, GST_MQTT_LEN_MSG_HDR);
-  g_return_val_if_fail (*hdr_mem != NULL, NULL);
-
-  if (!gst_memory_map (*hdr_mem, hdr_map_info, GST_MAP_READ)) {
-    gst_memory_unref (*hdr_mem);
+  if (size < GST_MQTT_LEN_MSG_HDR)
     return NULL;
+
+  return (GstMQTTMessageHdr *) data;
+}
+
+/**
+ * @brief A utility function to check the memories in the header fit in the message
+ */
+static gboolean
+_validate_mem_sizes (const GstMQTTMessageHdr * hdr, gsize hdr_size, gsize size)
+{
+  gsize offset = hdr_size;
+  guint i;
+
+  if (hdr->num_mems > GST_MQTT_MAX_NUM_MEMS || hdr_size > size)
+    return FALSE;
+
+  for (i = 0; i < hdr->num_mems; ++i) {
+    if (hdr->size_mems[i] > size - offset)
+      return FALSE;
+    offset += hdr->size_mems[i];
+  }
+
+  return TRUE;
+}
+
+/**
+  * @brief A utility function to parse the compact header of the message
+  *        into GstMQTTMessageHdr, except for the base time of the publisher
+  *        when the caps are not sent.
+  */
+static gboolean
+_parse_compact_hdr (const guint8 * data, gsize size, GstMQTTMessageHdr * hdr,
+    gsize * hdr_size, guint16 * caps_gen, gboolean * has_caps)
+{
+  GstMQTTCompactHdr compact;
+  gsize offset = sizeof (compact);
+  gsize payload_size = 0;
+  guint i;
+
+  if (size < sizeof (compact))
+    return FALSE;
+
+  memcpy (&compact, data, sizeof (compact));
+  if (compact.num_mems > GST_MQTT_MAX_NUM_MEMS ||
+      offset + compact.num_mems * sizeof (guint32) > size)
+    return FALSE;
+
+  memset (hdr, 0x0, sizeof (*hdr));
+  hdr->num_mems = compact.num_mems;
+  hdr->sent_time_epoch = compact.sent_time_epoch;
+  hdr->duration = compact.duration;
+  hdr->dts = compact.dts;
+  hdr->pts = compact.pts;
+
+  for (i = 0; i < compact.num_mems; ++i) {
+    guint32 mem_size;
+
+    memcpy (&mem_size, &data[offset], sizeof (mem_size));
+    offset += sizeof (mem_size);
+    hdr->size_mems[i] = mem_size;
+    payload_size += mem_size;
+  }
+
+  *has_caps = (compact.flags & GST_MQTT_COMPACT_FLAG_CAPS) != 0;
+  if (*has_caps) {
+    guint32 len;
+
+    if (offset + sizeof (gint64) + sizeof (len) > size)
+      return FALSE;
+
+    memcpy (&hdr->base_time_epoch, &data[offset], sizeof (gint64));
+    offset += sizeof (gint64);
+    memcpy (&len, &data[offset], sizeof (len));
+    offset += sizeof (len);
+
+    if (len >= GST_MQTT_MAX_LEN_GST_CAPS_STR || offset + len > size)
+      return FALSE;
+
+    memcpy (hdr->gst_caps_str, &data[offset], len);
+    offset += len;
+  }
+
+  offset = GST_ROUND_UP_8 (offset);
+  if (offset > size || payload_size > size - offset)
+    return FALSE;
+
+  *hdr_size = offset;
+  *caps_gen = compact.caps_gen;
+  return TRUE;
+}
+
+/**
+  * @brief A utility function to account the bytes in the receive queue to the memory budget
+  */
+static void
+_account_budget (GstMqttSrc * self, gint64 bytes)
+{
+  if (self->budget && bytes != 0)
+    g_signal_emit_by_name (self->budget, "account", self, bytes);
+}
+
+/**
+  * @brief A utility function to push the buffer to the receive queue,
+  *        dropping a message by the leaky policy if the queue is full
+  *        or by the memory budget of nnstreamer
+  */
+static void
+_push_to_queue (GstMqttSrc * self, GstBuffer * buffer)
+{
+  GstBuffer *dropped = NULL;
+  gint pressure = MEM_PRESSURE_NONE;
+  gint queued;
+
+  if (self->budget)
+    g_object_get (self->budget, "pressure", &pressure, NULL);
+
+  g_async_queue_lock (self->aqueue);
+  queued = g_async_queue_length_unlocked (self->aqueue);
+
+  /**
+   * Over the high watermark of the memory budget, drop the arriving message.
+   * Over the low watermark, keep it only if the queue is empty.
+   */
+  if (pressure == MEM_PRESSURE_DROP ||
+      (pressure == MEM_PRESSURE_THROTTLE && queued > 0)) {
+    dropped = buffer;
+    buffer = NULL;
+    self->num_dropped++;
+  } else if (self->max_queue_size != 0 &&
+      queued >= (gint) self->max_queue_size) {
+    if (self->leaky == GST_MQTT_SRC_LEAKY_UPSTREAM) {
+      dropped = buffer;
+      buffer = NULL;
+    } else {
+      dropped = g_async_queue_try_pop_unlocked (self->aqueue);
+      if (dropped)
+        _account_budget (self, -((gint64) gst_buffer_get_size (dropped)));
+    }
+    self->num_dropped++;
+  }
+
+  if (buffer) {
+    _account_budget (self, (gint64) gst_buffer_get_size (buffer));
+    g_async_queue_push_unlocked (self->aqueue, buffer);
   }
+  g_async_queue_unlock (self->aqueue);
 
-  return (GstMQTTMessageHdr *) hdr_map_info->data;
+  if (dropped) {
+    GST_DEBUG_OBJECT (self, "The receive queue is full or the memory budget "
+        "is exceeded, drop a message (%"
+        G_GUINT64_FORMAT " dropped)", self->num_dropped);
+    gst_buffer_unref (dropped);
+  }
+}
+
+/**
+  * @brief A utility function to unpack the batched message into the buffers
+  *        and push them to the queue
+  */
+static gboolean
+_push_batched_frames (GstMqttSrc * self, GstMQTTMessageHdr * hdr,
+    GstMemory * mem, const guint8 * data, gsize size)
+{
+  GstMQTTMessageHdr frame_hdr;
+  GstMQTTFrameIdx frame_idx;
+  gsize offset = GST_MQTT_LEN_MSG_HDR;
+  gsize data_offset;
+  guint i, j;
+
+  /** Validate the indexes and find the beginning of the data */
+  for (i = 0; i < hdr->num_frames; ++i) {
+    if (offset + sizeof (frame_idx) > size)
+      return FALSE;
+
+    memcpy (&frame_idx, &data[offset], sizeof (frame_idx));
+    if (frame_idx.num_mems > GST_MQTT_MAX_NUM_MEMS)
+      return FALSE;
+
+    offset += sizeof (frame_idx) + frame_idx.num_mems * sizeof (guint32);
+  }
+
+  data_offset = GST_MQTT_LEN_MSG_HDR +
+      GST_ROUND_UP_8 (offset - GST_MQTT_LEN_MSG_HDR);
+  if (data_offset > size)
+    return FALSE;
+
+  frame_hdr.base_time_epoch = hdr->base_time_epoch;
+  frame_hdr.sent_time_epoch = hdr->sent_time_epoch;
+
+  offset = GST_MQTT_LEN_MSG_HDR;
+  for (i = 0; i < hdr->num_frames; ++i) {
+    GstBuffer *buffer = gst_buffer_new ();
+
+    memcpy (&frame_idx, &data[offset], sizeof (frame_idx));
+    offset += sizeof (frame_idx);
+
+    for (j = 0; j < frame_idx.num_mems; ++j) {
+      guint32 mem_size;
+
+      memcpy (&mem_size, &data[offset], sizeof (mem_size));
+      offset += sizeof (mem_size);
+
+      if (mem_size > size - data_offset) {
+        gst_buffer_unref (buffer);
+        return FALSE;
+      }
+
+      gst_buffer_append_memory (buffer,
+          gst_memory_share (mem, data_offset, mem_size));
+      data_offset += mem_size;
+    }
+
+    frame_hdr.duration = frame_idx.duration;
+    frame_hdr.dts = frame_idx.dts;
+    frame_hdr.pts = frame_idx.pts;
+    _put_timestamp_on_gst_buf (self, &frame_hdr, buffer);
+    _push_to_queue (self, buffer);
+  }
+
+  return TRUE;
 }
 
 /**
@@ -35,6 +35,14 @@ G_BEGIN_DECLS
 #define GST_IS_MQTT_SRC_CLASS(klass) \
     (G_TYPE_CHECK_CLASS_TYPE ((klass), GST_TYPE_MQTT_SRC))
 
+/**
+ * @brief The policy to drop the messages when the receive queue is full.
+ */
+typedef enum {
+  GST_MQTT_SRC_LEAKY_UPSTREAM = 1,   /* drop the arriving message */
+  GST_MQTT_SRC_LEAKY_DOWNSTREAM = 2, /* drop the oldest message in the queue */
+} GstMqttSrcLeaky;
+
 typedef struct _GstMqttSrc GstMqttSrc;
 typedef struct _GstMqttSrcClass GstMqttSrcClass;
 
@@ -61,6 +69,14 @@ struct _GstMqttSrc {
   gint mqtt_qos;
 
   GAsyncQueue *aqueue;
+  guint max_queue_size;
+  GstMqttSrcLeaky leaky;
+  guint64 num_dropped;
+  GstAllocator *budget;
+
+  gboolean has_caps_gen;
+  guint16 caps_gen;
+  gint64 peer_base_time_epoch;
   GMutex mqtt_src_mutex;
   GCond mqtt_src_gcond;
   gboolean is_connected;
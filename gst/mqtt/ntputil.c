@@ -9,14 +9,17 @@
  * @see     https://github.com/nnstreamer/nnstreamer
  * @author  Wook Song <wook16.song@samsung.com>
  * @bug     No known bugs except for NYI items
- * @todo    Need to support cacheing and polling timer mechanism
  */
 
 #include <errno.h>
 #include <netdb.h>
+#include <pthread.h>
+#include <stdlib.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -117,6 +120,7 @@ const double NTPUTIL_MAX_FRAC_DOUBLE = 4294967295.0L;
 const int64_t NTPUTIL_SEC_TO_USEC_MULTIPLIER = 1000000;
 const char NTPUTIL_DEFAULT_HNAME[] = "pool.ntp.org";
 const uint16_t NTPUTIL_DEFAULT_PORT = 123;
+const time_t NTPUTIL_RECV_TIMEOUT_SEC = 3;
 
 /**
  * @brief Wrapper function of ntohl.
@@ -128,16 +132,45 @@ _convert_to_host_byte_order (uint32_t in)
 }
 
 /**
- * @brief Get NTP timestamps from the given or public NTP servers
+ * @brief Get the local real time as microseconds since the Unix epoch.
+ */
+static int64_t
+_ntputil_get_real_time (void)
+{
+  struct timespec ts;
+
+  clock_gettime (CLOCK_REALTIME, &ts);
+  return (int64_t) ts.tv_sec * NTPUTIL_SEC_TO_USEC_MULTIPLIER +
+      ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief Get the local monotonic time as microseconds.
+ */
+static int64_t
+_ntputil_get_monotonic_time (void)
+{
+  struct timespec ts;
+
+  clock_gettime (CLOCK_MONOTONIC, &ts);
+  return (int64_t) ts.tv_sec * NTPUTIL_SEC_TO_USEC_MULTIPLIER +
+      ts.tv_nsec / 1000;
+}
+
+/**
+ * @brief Exchange an NTP packet with the given or public NTP servers
  * @param[in] hnums A number of hostname and port pairs. If 0 is given,
  *                  the NTP server pool will be used.
  * @param[in] hnames A list of hostname
  * @param[in] ports A list of port
- * @return an Unix epoch time as microseconds on success,
- *         negative values on error
+ * @param[out] sent The local time when the request is sent (nullable)
+ * @param[out] recv The local time when the response is received (nullable)
+ * @return the transmit timestamp of the server as an Unix epoch time in
+ *         microseconds on success, negative values on error
  */
-int64_t
-ntputil_get_epoch (uint32_t hnums, char **hnames, uint16_t * ports)
+static int64_t
+_ntputil_query (uint32_t hnums, char **hnames, uint16_t * ports,
+    int64_t * sent, int64_t * recv)
 {
   struct sockaddr_in serv_addr;
   struct hostent *srv = NULL;
@@ -153,6 +186,13 @@ ntputil_get_epoch (uint32_t hnums, char **hnames, uint16_t * ports)
     goto ret_normal;
   }
 
+  {
+    /* a lost response should not block the caller forever */
+    struct timeval tv = { NTPUTIL_RECV_TIMEOUT_SEC, 0 };
+
+    setsockopt (sockfd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof (tv));
+  }
+
   for (i = 0; i < hnums; ++i) {
     srv = gethostbyname (hnames[i]);
     if (srv != NULL) {
@@ -196,6 +236,8 @@ ntputil_get_epoch (uint32_t hnums, char **hnames, uint16_t * ports)
     packet.li_vn_mode = 0x1B;
 
     /* Request */
+    if (sent)
+      *sent = _ntputil_get_real_time ();
     n = write (sockfd, &packet, sizeof (packet));
     if (n < 0) {
       ret = -errno;
@@ -208,6 +250,8 @@ ntputil_get_epoch (uint32_t hnums, char **hnames, uint16_t * ports)
       ret = -errno;
       goto ret_close_sockfd;
     }
+    if (recv)
+      *recv = _ntputil_get_real_time ();
 
     /**
      * @note ntp_timestamp_t recv_ts in ntp_packet_t means the timestamp as the packet
@@ -243,3 +287,232 @@ ret_close_sockfd:
 ret_normal:
   return ret;
 }
+
+/**
+ * @brief Get NTP timestamps from the given or public NTP servers
+ * @param[in] hnums A number of hostname and port pairs. If 0 is given,
+ *                  the NTP server pool will be used.
+ * @param[in] hnames A list of hostname
+ * @param[in] ports A list of port
+ * @return an Unix epoch time as microseconds on success,
+ *         negative values on error
+ */
+int64_t
+ntputil_get_epoch (uint32_t hnums, char **hnames, uint16_t * ports)
+{
+  return _ntputil_query (hnums, hnames, ports, NULL, NULL);
+}
+
+/**
+ * @brief The max rate to slew the applied offset toward the measured one,
+ *        in microseconds per second (500 ppm, same as adjtime ()).
+ */
+#define NTPUTIL_MAX_SLEW_PPM 500
+
+/**
+ * @brief NTP-synchronized clock, the offset is measured in a background thread.
+ */
+struct _ntputil_clock_t
+{
+  uint32_t hnums;
+  char **hnames;
+  uint16_t *ports;
+  uint32_t refresh_sec;
+
+  pthread_t thread;
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  int running;
+
+  int synced;                   /**< the offset has been measured at least once */
+  int64_t target_offset;        /**< the last measured offset (server - local) */
+  int64_t applied_offset;       /**< the offset applied to the local time */
+  int64_t last_slew;            /**< monotonic time of the last slew */
+  int64_t last_epoch;           /**< the last returned epoch, never goes back */
+};
+
+/**
+ * @brief Measure the offset of the local clock to the NTP server.
+ * @return 0 on success, negative values on error
+ */
+static int
+_ntputil_measure_offset (ntputil_clock_t * clk, int64_t * offset)
+{
+  int64_t sent = 0, recv = 0;
+  int64_t server;
+
+  server = _ntputil_query (clk->hnums, clk->hnames, clk->ports, &sent, &recv);
+  if (server < 0)
+    return -1;
+
+  /* the server stamped the response at the middle of the round trip */
+  *offset = server - (sent + (recv - sent) / 2);
+  return 0;
+}
+
+/**
+ * @brief Move the applied offset toward the measured one, no faster than the max slew rate.
+ * @note The caller should hold the lock.
+ */
+static void
+_ntputil_slew (ntputil_clock_t * clk, int64_t now_mono)
+{
+  int64_t max_step, diff;
+
+  max_step = (now_mono - clk->last_slew) * NTPUTIL_MAX_SLEW_PPM /
+      NTPUTIL_SEC_TO_USEC_MULTIPLIER;
+  clk->last_slew = now_mono;
+
+  diff = clk->target_offset - clk->applied_offset;
+  if (diff > max_step)
+    diff = max_step;
+  else if (diff < -max_step)
+    diff = -max_step;
+
+  clk->applied_offset += diff;
+}
+
+/**
+ * @brief The thread measuring the offset periodically.
+ */
+static void *
+_ntputil_clock_thread (void *data)
+{
+  ntputil_clock_t *clk = (ntputil_clock_t *) data;
+  struct timespec deadline;
+  int64_t offset;
+  int ret;
+
+  pthread_mutex_lock (&clk->lock);
+  while (clk->running) {
+    pthread_mutex_unlock (&clk->lock);
+    ret = _ntputil_measure_offset (clk, &offset);
+    pthread_mutex_lock (&clk->lock);
+
+    if (ret == 0) {
+      if (!clk->synced) {
+        /* step to the first measurement */
+        clk->applied_offset = offset;
+        clk->last_slew = _ntputil_get_monotonic_time ();
+        clk->synced = 1;
+      } else {
+        _ntputil_slew (clk, _ntputil_get_monotonic_time ());
+      }
+      clk->target_offset = offset;
+    }
+
+    if (!clk->running)
+      break;
+
+    /* retry soon until the first measurement succeeds */
+    clock_gettime (CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += clk->synced ? clk->refresh_sec : 1;
+    pthread_cond_timedwait (&clk->cond, &clk->lock, &deadline);
+  }
+  pthread_mutex_unlock (&clk->lock);
+
+  return NULL;
+}
+
+/**
+ * @brief Create the NTP-synchronized clock and start measuring the offset in the background.
+ */
+ntputil_clock_t *
+ntputil_clock_new (uint32_t hnums, char **hnames, uint16_t * ports,
+    uint32_t refresh_sec)
+{
+  ntputil_clock_t *clk;
+  uint32_t i;
+
+  clk = (ntputil_clock_t *) calloc (1, sizeof (ntputil_clock_t));
+  if (!clk)
+    return NULL;
+
+  clk->hnums = hnums;
+  clk->refresh_sec = (refresh_sec > 0) ? refresh_sec : 1;
+  if (hnums > 0) {
+    clk->hnames = (char **) calloc (hnums, sizeof (char *));
+    clk->ports = (uint16_t *) calloc (hnums, sizeof (uint16_t));
+    if (!clk->hnames || !clk->ports)
+      goto error;
+
+    for (i = 0; i < hnums; i++) {
+      clk->hnames[i] = strdup (hnames[i]);
+      if (!clk->hnames[i])
+        goto error;
+      clk->ports[i] = ports[i];
+    }
+  }
+
+  pthread_mutex_init (&clk->lock, NULL);
+  pthread_cond_init (&clk->cond, NULL);
+  clk->last_slew = _ntputil_get_monotonic_time ();
+  clk->running = 1;
+
+  if (pthread_create (&clk->thread, NULL, _ntputil_clock_thread, clk) != 0) {
+    pthread_mutex_destroy (&clk->lock);
+    pthread_cond_destroy (&clk->cond);
+    goto error;
+  }
+
+  return clk;
+
+error:
+  if (clk->hnames) {
+    for (i = 0; i < hnums; i++)
+      free (clk->hnames[i]);
+  }
+  free (clk->hnames);
+  free (clk->ports);
+  free (clk);
+  return NULL;
+}
+
+/**
+ * @brief Get the NTP-synchronized Unix epoch time without blocking.
+ */
+int64_t
+ntputil_clock_get_epoch (ntputil_clock_t * clk)
+{
+  int64_t epoch;
+
+  pthread_mutex_lock (&clk->lock);
+  if (clk->synced)
+    _ntputil_slew (clk, _ntputil_get_monotonic_time ());
+
+  epoch = _ntputil_get_real_time () + clk->applied_offset;
+  if (epoch < clk->last_epoch)
+    epoch = clk->last_epoch;
+  clk->last_epoch = epoch;
+  pthread_mutex_unlock (&clk->lock);
+
+  return epoch;
+}
+
+/**
+ * @brief Stop the background thread and free the clock.
+ */
+void
+ntputil_clock_free (ntputil_clock_t * clk)
+{
+  uint32_t i;
+
+  if (!clk)
+    return;
+
+  pthread_mutex_lock (&clk->lock);
+  clk->running = 0;
+  pthread_cond_broadcast (&clk->cond);
+  pthread_mutex_unlock (&clk->lock);
+
+  /* an exchange in progress ends with the socket timeout or the response */
+  pthread_join (clk->thread, NULL);
+  pthread_mutex_destroy (&clk->lock);
+  pthread_cond_destroy (&clk->cond);
+
+  for (i = 0; i < clk->hnums; i++)
+    free (clk->hnames[i]);
+  free (clk->hnames);
+  free (clk->ports);
+  free (clk);
+}
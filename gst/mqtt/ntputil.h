@@ -30,6 +30,41 @@ extern "C" {
 int64_t
 ntputil_get_epoch (uint32_t hnums, char **hnames, uint16_t * ports);
 
+/**
+ * @brief NTP-synchronized clock measuring the offset in a background thread
+ */
+typedef struct _ntputil_clock_t ntputil_clock_t;
+
+/**
+ * @brief Create the NTP-synchronized clock. The offset to the NTP server is
+ *        measured in a background thread, so this does not block.
+ * @param[in] hnums A number of hostname and port pairs. If 0 is given,
+ *                  the NTP server pool will be used.
+ * @param[in] hnames A list of hostname
+ * @param[in] ports A list of port
+ * @param[in] refresh_sec The interval to measure the offset again
+ * @return the clock on success, NULL on error
+ */
+ntputil_clock_t *
+ntputil_clock_new (uint32_t hnums, char **hnames, uint16_t * ports,
+    uint32_t refresh_sec);
+
+/**
+ * @brief Get the NTP-synchronized time. The local time is used until the
+ *        first measurement, and the offset is slewed to the later ones.
+ * @param[in] clk The clock
+ * @return an Unix epoch time as microseconds, never going back
+ */
+int64_t
+ntputil_clock_get_epoch (ntputil_clock_t * clk);
+
+/**
+ * @brief Stop the background thread and free the clock.
+ * @param[in] clk The clock
+ */
+void
+ntputil_clock_free (ntputil_clock_t * clk);
+
 /**
  * @brief Converting network byte order to host byte order.
  * @note There is a problem in mocking ntohl in GMock, so the wrapper function is temporarily used.
@@ -67,6 +67,7 @@ enum
   PROP_FRAMES_FLUSH,
   PROP_FRAMES_DIMENSION,
   PROP_CONCAT,
+  PROP_NUM_WORKERS,
   PROP_SILENT
 };
 
@@ -100,6 +101,62 @@ enum
  */
 #define DEFAULT_CONCAT TRUE
 
+/**
+ * @brief The number of threads aggregating the frames (1 to aggregate in the chain thread).
+ */
+#define DEFAULT_NUM_WORKERS 1
+
+/**
+ * @brief The max number of workers.
+ */
+#define MAX_NUM_WORKERS (64U)
+
+/**
+ * @brief The max number of buffers waiting for a worker, the chain function is blocked if the queue is full.
+ */
+#define WORKER_QUEUE_SIZE (4U)
+
+/**
+ * @brief The number of output windows kept in the ring buffer.
+ * The window is pushed without copying the data if it does not wrap around the end of the ring, a larger ring makes the wrapped window rare.
+ */
+#define RING_WINDOWS (4U)
+
+/**
+ * @brief Internal data structure for the frames of an aggregation key.
+ *
+ * Each incoming frame is written once in the slot of the ring buffer.
+ * The output window is a view (shared memory) of consecutive slots, the data is copied only if the window wraps around or the frames should be concatenated with frames-dim.
+ * A view pushed to downstream takes an exclusive lock of the ring memory. If downstream still holds the view when new frames arrive, the ring buffer is moved to new memory.
+ */
+typedef struct
+{
+  GstMemory *mem; /**< ring memory (locked exclusively while the ring holds it) */
+  gsize frame_size; /**< size of a frame (slot) */
+  guint capacity; /**< number of slots */
+  guint head; /**< index of the oldest frame */
+  guint count; /**< number of frames in the ring */
+  GstClockTime *pts; /**< timestamp of each slot */
+  GstClockTime *dts; /**< decoding timestamp of each slot */
+  GstBuffer *meta; /**< empty buffer holding the metadata of the latest incoming buffer */
+} tensor_aggregator_ring_s;
+
+/**
+ * @brief Internal data structure for a worker aggregating the frames.
+ *
+ * The aggregation key is assigned to a shard (key % number of workers), so the frames of a key are processed in order by the same worker.
+ * The ring buffers of the keys in the shard are accessed only in the worker thread.
+ */
+typedef struct
+{
+  GstTensorAggregator *self; /**< the element */
+  GThread *thread; /**< the worker thread */
+  GQueue queue; /**< incoming buffers waiting for the worker */
+  GHashTable *ring_table; /**< ring buffers of the keys in the shard */
+  gboolean busy; /**< the worker is processing a buffer */
+  gboolean running; /**< the worker waits for new buffers */
+} tensor_aggregator_shard_s;
+
 /**
  * @brief Template caps string for pads.
  */
@@ -143,6 +200,9 @@ gst_tensor_aggregator_change_state (GstElement * element,
     GstStateChange transition);
 
 static void gst_tensor_aggregator_reset (GstTensorAggregator * self);
+static void gst_tensor_aggregator_workers_stop (GstTensorAggregator * self);
+static void gst_tensor_aggregator_workers_drain (GstTensorAggregator * self);
+static void gst_tensor_aggregator_ring_free (gpointer data);
 static GstCaps *gst_tensor_aggregator_query_caps (GstTensorAggregator * self,
     GstPad * pad, GstCaps * filter);
 static gboolean gst_tensor_aggregator_parse_caps (GstTensorAggregator * self,
@@ -225,6 +285,19 @@ gst_tensor_aggregator_class_init (GstTensorAggregatorClass * klass)
       g_param_spec_boolean ("concat", "Concat", "Concatenate output buffer",
           DEFAULT_CONCAT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstTensorAggregator::num-workers:
+   *
+   * The number of threads aggregating the frames.
+   * If larger than 1, the aggregation keys (the client id in the query meta) are sharded over the threads, and the frames of each key are aggregated and pushed in order in its thread.
+   * The value is applied when the element starts streaming.
+   */
+  g_object_class_install_property (object_class, PROP_NUM_WORKERS,
+      g_param_spec_uint ("num-workers", "Number of workers",
+          "The number of threads aggregating the frames of the keys (1 to aggregate in the chain thread)",
+          1, MAX_NUM_WORKERS, DEFAULT_NUM_WORKERS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstTensorAggregator::silent:
    *
@@ -278,12 +351,21 @@ gst_tensor_aggregator_init (GstTensorAggregator * self)
   self->frames_flush = DEFAULT_FRAMES_FLUSH;
   self->frames_dim = DEFAULT_FRAMES_DIMENSION;
   self->concat = DEFAULT_CONCAT;
+  self->num_workers = DEFAULT_NUM_WORKERS;
+
+  self->shards = NULL;
+  self->num_shards = 0;
+  self->flushing = FALSE;
+  self->worker_ret = GST_FLOW_OK;
+  g_mutex_init (&self->lock);
+  g_cond_init (&self->cond);
 
   self->tensor_configured = FALSE;
   gst_tensors_config_init (&self->in_config);
   gst_tensors_config_init (&self->out_config);
 
-  self->adapter_table = gst_tensor_aggregation_init ();
+  self->ring_table = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+      NULL, gst_tensor_aggregator_ring_free);
   gst_tensor_aggregator_reset (self);
 }
 
@@ -297,11 +379,14 @@ gst_tensor_aggregator_finalize (GObject * object)
 
   self = GST_TENSOR_AGGREGATOR (object);
 
+  gst_tensor_aggregator_workers_stop (self);
   gst_tensor_aggregator_reset (self);
 
   gst_tensors_config_free (&self->in_config);
   gst_tensors_config_free (&self->out_config);
-  g_hash_table_destroy (self->adapter_table);
+  g_hash_table_destroy (self->ring_table);
+  g_mutex_clear (&self->lock);
+  g_cond_clear (&self->cond);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -333,6 +418,9 @@ gst_tensor_aggregator_set_property (GObject * object, guint prop_id,
     case PROP_CONCAT:
       self->concat = g_value_get_boolean (value);
       break;
+    case PROP_NUM_WORKERS:
+      self->num_workers = g_value_get_uint (value);
+      break;
     case PROP_SILENT:
       self->silent = g_value_get_boolean (value);
       break;
@@ -369,6 +457,9 @@ gst_tensor_aggregator_get_property (GObject * object, guint prop_id,
     case PROP_CONCAT:
       g_value_set_boolean (value, self->concat);
       break;
+    case PROP_NUM_WORKERS:
+      g_value_set_uint (value, self->num_workers);
+      break;
     case PROP_SILENT:
       g_value_set_boolean (value, self->silent);
       break;
@@ -392,7 +483,27 @@ gst_tensor_aggregator_sink_event (GstPad * pad, GstObject * parent,
   GST_DEBUG_OBJECT (self, "Received %s event: %" GST_PTR_FORMAT,
       GST_EVENT_TYPE_NAME (event), event);
 
+  /* the serialized event should be pushed after the frames pending in the workers */
+  if (GST_EVENT_IS_SERIALIZED (event))
+    gst_tensor_aggregator_workers_drain (self);
+
   switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_FLUSH_START:
+    {
+      tensor_aggregator_shard_s *shards;
+      guint i;
+
+      /* drop the pending buffers, the worker in gst_pad_push () returns when the flush-start is forwarded */
+      g_mutex_lock (&self->lock);
+      self->flushing = TRUE;
+      shards = (tensor_aggregator_shard_s *) self->shards;
+      for (i = 0; i < self->num_shards; i++)
+        g_queue_clear_full (&shards[i].queue,
+            (GDestroyNotify) gst_buffer_unref);
+      g_cond_broadcast (&self->cond);
+      g_mutex_unlock (&self->lock);
+      break;
+    }
     case GST_EVENT_CAPS:
     {
       GstCaps *in_caps;
@@ -419,6 +530,11 @@ gst_tensor_aggregator_sink_event (GstPad * pad, GstObject * parent,
     }
     case GST_EVENT_FLUSH_STOP:
       gst_tensor_aggregator_reset (self);
+
+      g_mutex_lock (&self->lock);
+      self->flushing = FALSE;
+      self->worker_ret = GST_FLOW_OK;
+      g_mutex_unlock (&self->lock);
       break;
     default:
       break;
@@ -515,19 +631,228 @@ gst_tensor_aggregator_src_query (GstPad * pad, GstObject * parent,
 }
 
 /**
- * @brief Internal function to get adapter.
+ * @brief Internal function to allocate the ring memory.
  */
-static GstAdapter *
-gst_tensor_aggregator_get_adapter (GstTensorAggregator * self, GstBuffer * buf)
+static GstMemory *
+gst_tensor_aggregator_ring_alloc_memory (gsize size)
+{
+  GstMemory *mem;
+
+  mem = gst_allocator_alloc (NULL, size, NULL);
+  if (mem)
+    gst_memory_lock (mem, GST_LOCK_FLAG_EXCLUSIVE);
+
+  return mem;
+}
+
+/**
+ * @brief Internal function to release the ring memory.
+ */
+static void
+gst_tensor_aggregator_ring_release_memory (GstMemory * mem)
+{
+  if (mem) {
+    gst_memory_unlock (mem, GST_LOCK_FLAG_EXCLUSIVE);
+    gst_memory_unref (mem);
+  }
+}
+
+/**
+ * @brief Internal function to free the ring buffer.
+ */
+static void
+gst_tensor_aggregator_ring_free (gpointer data)
+{
+  tensor_aggregator_ring_s *ring = (tensor_aggregator_ring_s *) data;
+
+  if (ring) {
+    gst_tensor_aggregator_ring_release_memory (ring->mem);
+    if (ring->meta)
+      gst_buffer_unref (ring->meta);
+    g_free (ring->pts);
+    g_free (ring->dts);
+    g_free (ring);
+  }
+}
+
+/**
+ * @brief Internal function to get the aggregation key (the client id in the query meta) of the buffer.
+ */
+static guint32
+gst_tensor_aggregator_get_key (GstBuffer * buf)
 {
   GstMetaQuery *meta;
-  guint32 key = 0;
 
   meta = gst_buffer_get_meta_query (buf);
-  if (meta)
-    key = meta->client_id;
+  return meta ? meta->client_id : 0;
+}
+
+/**
+ * @brief Internal function to get the ring buffer of the aggregation key.
+ * @param self this pointer to GstTensorAggregator
+ * @param ring_table the ring buffers of the keys
+ * @param buf incoming buffer (the key is the client id in the query meta)
+ * @param frame_size size of a frame
+ * @return the ring buffer, NULL if failed to allocate the memory
+ */
+static tensor_aggregator_ring_s *
+gst_tensor_aggregator_get_ring (GstTensorAggregator * self,
+    GHashTable * ring_table, GstBuffer * buf, gsize frame_size)
+{
+  tensor_aggregator_ring_s *ring;
+  guint32 key;
+  guint capacity;
+
+  key = gst_tensor_aggregator_get_key (buf);
+  capacity = self->frames_in + self->frames_out * RING_WINDOWS;
+  ring = (tensor_aggregator_ring_s *) g_hash_table_lookup (ring_table,
+      GUINT_TO_POINTER (key));
+  if (ring && ring->frame_size == frame_size && ring->capacity == capacity)
+    return ring;
+
+  /* new key or the frame size is changed */
+  ring = g_new0 (tensor_aggregator_ring_s, 1);
+  ring->frame_size = frame_size;
+  ring->capacity = capacity;
+  ring->pts = g_new (GstClockTime, ring->capacity);
+  ring->dts = g_new (GstClockTime, ring->capacity);
+  ring->mem = gst_tensor_aggregator_ring_alloc_memory (frame_size *
+      ring->capacity);
+
+  if (!ring->mem) {
+    ml_loge ("Failed to allocate the ring buffer of tensor_aggregator.\n");
+    gst_tensor_aggregator_ring_free (ring);
+    return NULL;
+  }
+
+  g_hash_table_insert (ring_table, GUINT_TO_POINTER (key), ring);
+  return ring;
+}
+
+/**
+ * @brief Internal function to move the frames to new ring memory.
+ * Called when downstream still holds the view of the ring memory.
+ */
+static gboolean
+gst_tensor_aggregator_ring_detach (tensor_aggregator_ring_s * ring)
+{
+  GstMemory *mem;
+  GstMapInfo src, dest;
+  guint i, slot;
+
+  mem = gst_tensor_aggregator_ring_alloc_memory (gst_memory_get_sizes
+      (ring->mem, NULL, NULL));
+  if (!mem) {
+    ml_loge ("Failed to allocate the ring buffer of tensor_aggregator.\n");
+    return FALSE;
+  }
+
+  if (ring->count > 0) {
+    if (!gst_memory_map (ring->mem, &src, GST_MAP_READ)) {
+      ml_loge ("Failed to map the ring buffer of tensor_aggregator.\n");
+      gst_tensor_aggregator_ring_release_memory (mem);
+      return FALSE;
+    }
+
+    if (!gst_memory_map (mem, &dest, GST_MAP_WRITE)) {
+      ml_loge ("Failed to map the ring buffer of tensor_aggregator.\n");
+      gst_memory_unmap (ring->mem, &src);
+      gst_tensor_aggregator_ring_release_memory (mem);
+      return FALSE;
+    }
+
+    /* keep the slots of the frames, the views of the old memory are not changed */
+    for (i = 0; i < ring->count; i++) {
+      slot = (ring->head + i) % ring->capacity;
+      nns_memcpy (dest.data + ring->frame_size * slot,
+          src.data + ring->frame_size * slot, ring->frame_size);
+    }
+
+    gst_memory_unmap (mem, &dest);
+    gst_memory_unmap (ring->mem, &src);
+  }
+
+  gst_tensor_aggregator_ring_release_memory (ring->mem);
+  ring->mem = mem;
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to write the frames of incoming buffer into the ring buffer.
+ * @param self this pointer to GstTensorAggregator
+ * @param ring the ring buffer
+ * @param buf incoming buffer
+ * @return TRUE if the frames are written
+ */
+static gboolean
+gst_tensor_aggregator_ring_push (GstTensorAggregator * self,
+    tensor_aggregator_ring_s * ring, GstBuffer * buf)
+{
+  GstMapInfo src, dest;
+  GstClockTime pts, dts, diff;
+  guint i, slot, frames_in;
+  gint fn, fd;
+
+  frames_in = self->frames_in;
+  g_assert (ring->count + frames_in <= ring->capacity);
+
+  if (!gst_memory_map (ring->mem, &dest, GST_MAP_WRITE)) {
+    /* downstream holds the view of the ring memory */
+    if (!gst_tensor_aggregator_ring_detach (ring) ||
+        !gst_memory_map (ring->mem, &dest, GST_MAP_WRITE)) {
+      ml_loge ("Failed to map the ring buffer of tensor_aggregator.\n");
+      return FALSE;
+    }
+  }
+
+  if (!gst_buffer_map (buf, &src, GST_MAP_READ)) {
+    ml_loge ("Failed to map the incoming buffer of tensor_aggregator.\n");
+    gst_memory_unmap (ring->mem, &dest);
+    return FALSE;
+  }
+
+  pts = GST_BUFFER_PTS (buf);
+  dts = GST_BUFFER_DTS (buf);
+  fn = self->in_config.rate_n;
+  fd = self->in_config.rate_d;
+
+  /* copy the frames in one or two blocks (tail and beginning of the ring) */
+  slot = (ring->head + ring->count) % ring->capacity;
+  i = MIN (frames_in, ring->capacity - slot);
+  nns_memcpy (dest.data + ring->frame_size * slot, src.data,
+      ring->frame_size * i);
+  if (i < frames_in) {
+    nns_memcpy (dest.data, src.data + ring->frame_size * i,
+        ring->frame_size * (frames_in - i));
+  }
+
+  /**
+   * Update timestamp.
+   * If frames-in is larger then frames-out, the same timestamp (pts and dts) would be returned.
+   */
+  for (i = 0; i < frames_in; i++) {
+    diff = 0;
+    if (i > 0 && fn > 0 && fd > 0)
+      diff = gst_util_uint64_scale_int ((guint64) i * fd, GST_SECOND, fn);
+
+    ring->pts[slot] = GST_CLOCK_TIME_IS_VALID (pts) ? pts + diff : pts;
+    ring->dts[slot] = GST_CLOCK_TIME_IS_VALID (dts) ? dts + diff : dts;
+    slot = (slot + 1) % ring->capacity;
+  }
 
-  return gst_tensor_aggregation_get_adapter (self->adapter_table, key);
+  ring->count += frames_in;
+
+  gst_buffer_unmap (buf, &src);
+  gst_memory_unmap (ring->mem, &dest);
+
+  /* metadata (e.g., query meta of the client) for the output buffer */
+  if (ring->meta)
+    gst_buffer_unref (ring->meta);
+  ring->meta = gst_buffer_new ();
+  gst_buffer_copy_into (ring->meta, buf, GST_BUFFER_COPY_METADATA, 0, -1);
+
+  return TRUE;
 }
 
 /**
@@ -799,23 +1124,130 @@ gst_tensor_aggregator_concat (GstTensorAggregator * self, GstBuffer * outbuf,
 }
 
 /**
- * @brief Push the buffer to source pad. (Concatenate the buffer if needed)
+ * @brief Internal function to get the tensor info for one frame.
+ * @param self this pointer to GstTensorAggregator
+ * @param frame_size size of a frame in incoming buffer
+ * @param info tensor info for one frame
+ * @return TRUE if the frame size is valid
  */
-static GstFlowReturn
-gst_tensor_aggregator_push (GstTensorAggregator * self, GstBuffer * outbuf,
-    gsize frame_size)
+static gboolean
+gst_tensor_aggregator_get_frame_info (GstTensorAggregator * self,
+    gsize frame_size, GstTensorInfo * info)
 {
-  GstTensorInfo info;
-
   /** tensor info for one frame */
-  info = self->out_config.info.info[0];
+  *info = self->out_config.info.info[0];
   g_assert (self->frames_dim < NNS_TENSOR_RANK_LIMIT);
-  info.dimension[self->frames_dim] /= self->frames_out;
+  info->dimension[self->frames_dim] /= self->frames_out;
 
-  if (frame_size != gst_tensor_info_get_size (&info) || frame_size == 0U) {
+  if (frame_size != gst_tensor_info_get_size (info) || frame_size == 0U) {
     ml_logf
         ("Invalid output capability of tensor_aggregator. Frame size = %"
         G_GSIZE_FORMAT "\n", frame_size);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to get the output window from the ring buffer.
+ * The window is a view of the ring memory if the frames are consecutive in the ring and not needed to concatenate.
+ * Otherwise, the frames are copied once into new memory (with given axis if needed, see gst_tensor_aggregator_concat ()).
+ * @param self this pointer to GstTensorAggregator
+ * @param ring the ring buffer
+ * @param info tensor info for one frame
+ * @return output buffer, NULL if failed to get the data
+ */
+static GstBuffer *
+gst_tensor_aggregator_ring_get_window (GstTensorAggregator * self,
+    tensor_aggregator_ring_s * ring, const GstTensorInfo * info)
+{
+  GstBuffer *outbuf;
+  GstMemory *mem;
+  GstMapInfo src_info, dest_info;
+  gsize frame_size, out_size, block_size, src_idx, dest_idx;
+  guint f, slot, frames_out, split;
+
+  frames_out = self->frames_out;
+  frame_size = ring->frame_size;
+  out_size = frame_size * frames_out;
+
+  if (!gst_tensor_aggregator_check_concat_axis (self, info) &&
+      ring->head + frames_out <= ring->capacity) {
+    mem = gst_memory_share (ring->mem, frame_size * ring->head, out_size);
+  } else {
+    mem = gst_allocator_alloc (NULL, out_size, NULL);
+    if (!mem) {
+      ml_loge ("Failed to allocate the output of tensor_aggregator.\n");
+      return NULL;
+    }
+
+    if (!gst_memory_map (ring->mem, &src_info, GST_MAP_READ)) {
+      ml_loge ("Failed to map the ring buffer of tensor_aggregator.\n");
+      gst_memory_unref (mem);
+      return NULL;
+    }
+
+    if (!gst_memory_map (mem, &dest_info, GST_MAP_WRITE)) {
+      ml_loge ("Failed to map the output of tensor_aggregator.\n");
+      gst_memory_unmap (ring->mem, &src_info);
+      gst_memory_unref (mem);
+      return NULL;
+    }
+
+    if (gst_tensor_aggregator_check_concat_axis (self, info)) {
+      /** get block size */
+      block_size = gst_tensor_get_element_size (info->type);
+      for (f = 0; f <= self->frames_dim; f++) {
+        block_size *= info->dimension[f];
+      }
+
+      src_idx = dest_idx = 0;
+
+      do {
+        for (f = 0; f < frames_out; f++) {
+          slot = (ring->head + f) % ring->capacity;
+          nns_memcpy (dest_info.data + dest_idx,
+              src_info.data + (frame_size * slot) + src_idx, block_size);
+          dest_idx += block_size;
+        }
+
+        src_idx += block_size;
+
+        g_assert (src_idx <= frame_size);
+        g_assert (dest_idx <= dest_info.size);
+      } while (src_idx < frame_size);
+    } else {
+      /* the window wraps around the end of the ring */
+      split = ring->capacity - ring->head;
+      nns_memcpy (dest_info.data, src_info.data + frame_size * ring->head,
+          frame_size * split);
+      nns_memcpy (dest_info.data + frame_size * split, src_info.data,
+          frame_size * (frames_out - split));
+    }
+
+    gst_memory_unmap (mem, &dest_info);
+    gst_memory_unmap (ring->mem, &src_info);
+  }
+
+  outbuf = gst_buffer_new ();
+  gst_buffer_copy_into (outbuf, ring->meta, GST_BUFFER_COPY_METADATA, 0, -1);
+  gst_buffer_append_memory (outbuf, mem);
+
+  return outbuf;
+}
+
+/**
+ * @brief Push the buffer to source pad. (Concatenate the buffer if needed)
+ */
+static GstFlowReturn
+gst_tensor_aggregator_push (GstTensorAggregator * self, GstBuffer * outbuf,
+    gsize frame_size)
+{
+  GstTensorInfo info;
+
+  if (!gst_tensor_aggregator_get_frame_info (self, frame_size, &info)) {
+    gst_buffer_unref (outbuf);
     return GST_FLOW_ERROR;
   }
 
@@ -829,37 +1261,38 @@ gst_tensor_aggregator_push (GstTensorAggregator * self, GstBuffer * outbuf,
 }
 
 /**
- * @brief Chain function, this function does the actual processing.
+ * @brief Internal function to write the frames of the buffer into the ring buffer of its key and push the output windows.
+ * @param self this pointer to GstTensorAggregator
+ * @param ring_table the ring buffers of the keys
+ * @param buf incoming buffer (the ownership is taken)
+ * @return the flow return of the pushed buffers
  */
 static GstFlowReturn
-gst_tensor_aggregator_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
+gst_tensor_aggregator_aggregate (GstTensorAggregator * self,
+    GHashTable * ring_table, GstBuffer * buf)
 {
-  GstTensorAggregator *self;
   GstFlowReturn ret = GST_FLOW_OK;
-  GstAdapter *adapter;
-  gsize avail, buf_size, frame_size, out_size;
-  guint frames_in, frames_out, frames_flush;
+  tensor_aggregator_ring_s *ring;
+  GstTensorInfo info;
+  gsize frame_size;
+  guint frames_in, frames_out, frames_flush, flush;
   GstClockTime duration;
-  UNUSED (pad);
-
-  self = GST_TENSOR_AGGREGATOR (parent);
-  g_assert (self->tensor_configured);
-
-  buf_size = gst_buffer_get_size (buf);
-  g_return_val_if_fail (buf_size > 0, GST_FLOW_ERROR);
 
   frames_in = self->frames_in;
   frames_out = self->frames_out;
   frames_flush = self->frames_flush;
-  frame_size = buf_size / frames_in;
+  frame_size = gst_buffer_get_size (buf) / frames_in;
 
-  if (frames_in == frames_out) {
-    /** push the incoming buffer (do concat if needed) */
-    return gst_tensor_aggregator_push (self, buf, frame_size);
+  if (!gst_tensor_aggregator_get_frame_info (self, frame_size, &info)) {
+    gst_buffer_unref (buf);
+    return GST_FLOW_ERROR;
   }
 
-  adapter = gst_tensor_aggregator_get_adapter (self, buf);
-  g_assert (adapter != NULL);
+  ring = gst_tensor_aggregator_get_ring (self, ring_table, buf, frame_size);
+  if (!ring || !gst_tensor_aggregator_ring_push (self, ring, buf)) {
+    gst_buffer_unref (buf);
+    return GST_FLOW_ERROR;
+  }
 
   duration = GST_BUFFER_DURATION (buf);
   if (GST_CLOCK_TIME_IS_VALID (duration)) {
@@ -867,79 +1300,261 @@ gst_tensor_aggregator_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
     duration = gst_util_uint64_scale_int (duration, frames_out, frames_in);
   }
 
-  gst_adapter_push (adapter, buf);
+  /* frames are written in the ring buffer */
+  gst_buffer_unref (buf);
 
-  out_size = frame_size * frames_out;
-  g_assert (out_size > 0);
-
-  while ((avail = gst_adapter_available (adapter)) >= out_size &&
-      ret == GST_FLOW_OK) {
+  while (ring->count >= frames_out && ret == GST_FLOW_OK) {
     GstBuffer *outbuf;
-    GstClockTime pts, dts;
-    guint64 pts_dist, dts_dist;
-    gsize flush;
-
-    pts = gst_adapter_prev_pts (adapter, &pts_dist);
-    dts = gst_adapter_prev_dts (adapter, &dts_dist);
-
-    /**
-     * Update timestamp.
-     * If frames-in is larger then frames-out, the same timestamp (pts and dts) would be returned.
-     */
-    if (frames_in > 1) {
-      gint fn, fd;
-
-      fn = self->in_config.rate_n;
-      fd = self->in_config.rate_d;
-
-      if (fn > 0 && fd > 0) {
-        if (GST_CLOCK_TIME_IS_VALID (pts)) {
-          pts +=
-              gst_util_uint64_scale_int (pts_dist * fd, GST_SECOND,
-              fn * frame_size);
-        }
-
-        if (GST_CLOCK_TIME_IS_VALID (dts)) {
-          dts +=
-              gst_util_uint64_scale_int (dts_dist * fd, GST_SECOND,
-              fn * frame_size);
-        }
-      }
-    }
 
-    outbuf = gst_adapter_get_buffer (adapter, out_size);
-    outbuf = gst_buffer_make_writable (outbuf);
+    outbuf = gst_tensor_aggregator_ring_get_window (self, ring, &info);
+    if (!outbuf)
+      return GST_FLOW_ERROR;
 
     /** set timestamp */
-    GST_BUFFER_PTS (outbuf) = pts;
-    GST_BUFFER_DTS (outbuf) = dts;
+    GST_BUFFER_PTS (outbuf) = ring->pts[ring->head];
+    GST_BUFFER_DTS (outbuf) = ring->dts[ring->head];
     GST_BUFFER_DURATION (outbuf) = duration;
 
-    ret = gst_tensor_aggregator_push (self, outbuf, frame_size);
+    ret = gst_pad_push (self->srcpad, outbuf);
 
     /** flush data */
     if (frames_flush > 0) {
-      flush = frame_size * frames_flush;
+      flush = frames_flush;
 
-      if (flush > avail) {
+      if (flush > ring->count) {
         /**
          * @todo flush data
          * Invalid state, tried to flush large size.
          * We have to determine how to handle this case. (flush the out-size or all available bytes)
-         * Now all available bytes in adapter will be flushed.
+         * Now all available frames in the ring will be flushed.
          */
-        flush = avail;
+        flush = ring->count;
       }
     } else {
-      flush = out_size;
+      flush = frames_out;
     }
 
-    gst_adapter_flush (adapter, flush);
+    ring->head = (ring->head + flush) % ring->capacity;
+    ring->count -= flush;
   }
 
   return ret;
 }
 
+/**
+ * @brief Internal function for the worker thread, aggregates the buffers of the keys in the shard.
+ */
+static gpointer
+gst_tensor_aggregator_worker (gpointer data)
+{
+  tensor_aggregator_shard_s *shard = (tensor_aggregator_shard_s *) data;
+  GstTensorAggregator *self = shard->self;
+  GstBuffer *buf;
+  GstFlowReturn ret;
+
+  g_mutex_lock (&self->lock);
+  while (TRUE) {
+    while (shard->running && g_queue_is_empty (&shard->queue))
+      g_cond_wait (&self->cond, &self->lock);
+
+    if (!shard->running)
+      break;
+
+    buf = (GstBuffer *) g_queue_pop_head (&shard->queue);
+    shard->busy = TRUE;
+    g_mutex_unlock (&self->lock);
+
+    ret = gst_tensor_aggregator_aggregate (self, shard->ring_table, buf);
+
+    g_mutex_lock (&self->lock);
+    shard->busy = FALSE;
+    if (ret != GST_FLOW_OK && self->worker_ret == GST_FLOW_OK)
+      self->worker_ret = ret;
+    g_cond_broadcast (&self->cond);
+  }
+  g_mutex_unlock (&self->lock);
+
+  return NULL;
+}
+
+/**
+ * @brief Internal function to start the worker threads.
+ * @return TRUE if the workers are started (or not required).
+ */
+static gboolean
+gst_tensor_aggregator_workers_start (GstTensorAggregator * self)
+{
+  tensor_aggregator_shard_s *shards;
+  GError *error = NULL;
+  guint i;
+
+  if (self->num_workers <= 1 || self->shards)
+    return TRUE;
+
+  shards = g_new0 (tensor_aggregator_shard_s, self->num_workers);
+
+  g_mutex_lock (&self->lock);
+  self->shards = shards;
+  self->flushing = FALSE;
+  self->worker_ret = GST_FLOW_OK;
+
+  for (i = 0; i < self->num_workers; i++) {
+    shards[i].self = self;
+    shards[i].running = TRUE;
+    g_queue_init (&shards[i].queue);
+    shards[i].ring_table = g_hash_table_new_full (g_direct_hash,
+        g_direct_equal, NULL, gst_tensor_aggregator_ring_free);
+
+    shards[i].thread = g_thread_try_new ("tensor_aggregator",
+        gst_tensor_aggregator_worker, &shards[i], &error);
+    if (!shards[i].thread) {
+      ml_loge ("Failed to create the worker of tensor_aggregator: %s\n",
+          error ? error->message : "unknown error");
+      g_clear_error (&error);
+      g_hash_table_destroy (shards[i].ring_table);
+      break;
+    }
+
+    self->num_shards++;
+  }
+  g_mutex_unlock (&self->lock);
+
+  if (self->num_shards < self->num_workers) {
+    gst_tensor_aggregator_workers_stop (self);
+    return FALSE;
+  }
+
+  GST_INFO_OBJECT (self, "Started %u workers to aggregate the frames.",
+      self->num_shards);
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to stop the worker threads and free the shards.
+ */
+static void
+gst_tensor_aggregator_workers_stop (GstTensorAggregator * self)
+{
+  tensor_aggregator_shard_s *shards;
+  guint i, num_shards;
+
+  g_mutex_lock (&self->lock);
+  shards = (tensor_aggregator_shard_s *) self->shards;
+  num_shards = self->num_shards;
+
+  for (i = 0; i < num_shards; i++) {
+    shards[i].running = FALSE;
+    g_queue_clear_full (&shards[i].queue, (GDestroyNotify) gst_buffer_unref);
+  }
+
+  self->shards = NULL;
+  self->num_shards = 0;
+  g_cond_broadcast (&self->cond);
+  g_mutex_unlock (&self->lock);
+
+  for (i = 0; i < num_shards; i++) {
+    g_thread_join (shards[i].thread);
+    g_hash_table_destroy (shards[i].ring_table);
+  }
+
+  g_free (shards);
+}
+
+/**
+ * @brief Internal function to wait until the workers process all pending buffers.
+ */
+static void
+gst_tensor_aggregator_workers_drain (GstTensorAggregator * self)
+{
+  tensor_aggregator_shard_s *shards;
+  gboolean pending;
+  guint i;
+
+  g_mutex_lock (&self->lock);
+  do {
+    pending = FALSE;
+    shards = (tensor_aggregator_shard_s *) self->shards;
+
+    for (i = 0; i < self->num_shards; i++) {
+      if (shards[i].busy || !g_queue_is_empty (&shards[i].queue)) {
+        pending = TRUE;
+        break;
+      }
+    }
+
+    if (pending)
+      g_cond_wait (&self->cond, &self->lock);
+  } while (pending);
+  g_mutex_unlock (&self->lock);
+}
+
+/**
+ * @brief Internal function to queue the buffer to the worker of its key.
+ * @return the flow return of the workers
+ */
+static GstFlowReturn
+gst_tensor_aggregator_queue (GstTensorAggregator * self, GstBuffer * buf)
+{
+  tensor_aggregator_shard_s *shard;
+  GstFlowReturn ret;
+
+  g_mutex_lock (&self->lock);
+  shard = (tensor_aggregator_shard_s *) self->shards;
+  shard += gst_tensor_aggregator_get_key (buf) % self->num_shards;
+
+  /* wait for the worker if the queue is full */
+  while (!self->flushing && self->worker_ret == GST_FLOW_OK &&
+      g_queue_get_length (&shard->queue) >= WORKER_QUEUE_SIZE)
+    g_cond_wait (&self->cond, &self->lock);
+
+  ret = self->flushing ? GST_FLOW_FLUSHING : self->worker_ret;
+  if (ret == GST_FLOW_OK) {
+    g_queue_push_tail (&shard->queue, buf);
+    g_cond_broadcast (&self->cond);
+    buf = NULL;
+  }
+  g_mutex_unlock (&self->lock);
+
+  if (buf)
+    gst_buffer_unref (buf);
+
+  return ret;
+}
+
+/**
+ * @brief Chain function, this function does the actual processing.
+ */
+static GstFlowReturn
+gst_tensor_aggregator_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
+{
+  GstTensorAggregator *self;
+  gsize buf_size, frame_size;
+  UNUSED (pad);
+
+  self = GST_TENSOR_AGGREGATOR (parent);
+  g_assert (self->tensor_configured);
+
+  buf_size = gst_buffer_get_size (buf);
+  g_return_val_if_fail (buf_size > 0, GST_FLOW_ERROR);
+
+  frame_size = buf_size / self->frames_in;
+
+  if (self->frames_in == self->frames_out) {
+    /** push the incoming buffer (do concat if needed) */
+    return gst_tensor_aggregator_push (self, buf, frame_size);
+  }
+
+  if (!gst_tensor_aggregator_workers_start (self)) {
+    gst_buffer_unref (buf);
+    return GST_FLOW_ERROR;
+  }
+
+  if (self->shards)
+    return gst_tensor_aggregator_queue (self, buf);
+
+  return gst_tensor_aggregator_aggregate (self, self->ring_table, buf);
+}
+
 /**
  * @brief Called to perform state change.
  */
@@ -964,6 +1579,7 @@ gst_tensor_aggregator_change_state (GstElement * element,
 
   switch (transition) {
     case GST_STATE_CHANGE_PAUSED_TO_READY:
+      gst_tensor_aggregator_workers_stop (self);
       gst_tensor_aggregator_reset (self);
       break;
     default:
@@ -979,8 +1595,15 @@ gst_tensor_aggregator_change_state (GstElement * element,
 static void
 gst_tensor_aggregator_reset (GstTensorAggregator * self)
 {
-  /* remove all buffers from adapter */
-  gst_tensor_aggregation_clear_all (self->adapter_table);
+  tensor_aggregator_shard_s *shards;
+  guint i;
+
+  /* remove all frames in the ring buffers */
+  g_hash_table_remove_all (self->ring_table);
+
+  shards = (tensor_aggregator_shard_s *) self->shards;
+  for (i = 0; i < self->num_shards; i++)
+    g_hash_table_remove_all (shards[i].ring_table);
 }
 
 /**
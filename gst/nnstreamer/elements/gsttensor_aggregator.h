@@ -63,7 +63,15 @@ struct _GstTensorAggregator
   guint frames_flush; /**< number of frames to flush */
   guint frames_dim; /**< index of frames in tensor dimension */
 
-  GHashTable *adapter_table; /**< adapt incoming tensor */
+  GHashTable *ring_table; /**< ring buffer of incoming frames for each aggregation key */
+
+  guint num_workers; /**< number of threads aggregating the frames, the keys are sharded over the threads (1 to aggregate in the chain thread) */
+  gpointer shards; /**< the shard (keys, pending buffers and thread) of each worker */
+  guint num_shards; /**< number of the started workers */
+  GMutex lock; /**< lock for the shards */
+  GCond cond; /**< signals new buffers or idle workers */
+  gboolean flushing; /**< the workers drop the pending buffers */
+  GstFlowReturn worker_ret; /**< the first error returned by the workers */
 
   gboolean tensor_configured; /**< True if already successfully configured tensor metadata */
   GstTensorsConfig in_config; /**< input tensor info */
@@ -0,0 +1,894 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	gsttensor_batch.c
+ * @date	14 Oct 2026
+ * @brief	GStreamer plugin to batch the frames of multiple tensor streams into a tensor stream with the stream IDs
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ */
+
+/**
+ * SECTION:element-tensor_batch
+ *
+ * tensor_batch collects the latest frame of each sink pad (sink_N is the
+ * stream N) and pushes a batch when all streams give a frame, or when the
+ * deadline (timeout) passes after the first frame of the batch arrives.
+ * All streams should have the same tensors info. Each tensor is batched
+ * along the new outermost dimension (the number of the sink pads), e.g.,
+ * 3:224:224:1 of 4 streams becomes 3:224:224:4. The slot of the stream
+ * without a frame is filled with zero.
+ * The last tensor of the output is int32 [the number of the sink pads], the
+ * stream ID of each slot (-1 if the slot is empty), so that tensor_unbatch
+ * routes the results back to the streams.
+ *
+ * <refsect2>
+ * <title>Example launch line</title>
+ * |[
+ * gst-launch-1.0 \
+ * tensor_batch name=batch timeout=10000 ! \
+ * tensor_filter framework=tensorflow-lite model=model.tflite input-combination=0 output-combination=o0,i1 ! \
+ * tensor_unbatch name=unbatch \
+ * ... (camera 0) ! tensor_converter ! batch.sink_0 \
+ * ... (camera 1) ! tensor_converter ! batch.sink_1 \
+ * unbatch.src_0 ! (result of camera 0) ... \
+ * unbatch.src_1 ! (result of camera 1) ...
+ * ]|
+ * </refsect2>
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string.h>
+#include <gst/gst.h>
+#include <glib.h>
+#include <nnstreamer_util.h>
+
+#include "gsttensor_batch.h"
+
+GST_DEBUG_CATEGORY_STATIC (gst_tensor_batch_debug);
+#define GST_CAT_DEFAULT gst_tensor_batch_debug
+
+/**
+ * @brief Macro for debug mode.
+ */
+#ifndef DBG
+#define DBG (!self->silent)
+#endif
+
+/**
+ * @brief Default timeout (wait for all streams).
+ */
+#define DEFAULT_TIMEOUT (0)
+
+enum
+{
+  PROP_0,
+  PROP_SILENT,
+  PROP_TIMEOUT,
+};
+
+/**
+ * @brief Default caps string for sink pad.
+ */
+#define CAPS_STRING_SINK GST_TENSOR_CAP_DEFAULT ";" GST_TENSORS_CAP_MAKE ("static")
+
+/**
+ * @brief Default caps string for src pad.
+ */
+#define CAPS_STRING_SRC GST_TENSORS_CAP_MAKE ("static")
+
+/**
+ * @brief the capabilities of the inputs and outputs.
+ * describe the real formats here.
+ */
+static GstStaticPadTemplate src_templ = GST_STATIC_PAD_TEMPLATE ("src",
+    GST_PAD_SRC,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (CAPS_STRING_SRC)
+    );
+
+static GstStaticPadTemplate sink_templ = GST_STATIC_PAD_TEMPLATE ("sink_%u",
+    GST_PAD_SINK,
+    GST_PAD_REQUEST,
+    GST_STATIC_CAPS (CAPS_STRING_SINK)
+    );
+
+static gboolean gst_tensor_batch_src_event (GstPad * pad, GstObject * parent,
+    GstEvent * event);
+static gboolean gst_tensor_batch_sink_event (GstPad * pad, GstObject * parent,
+    GstEvent * event);
+static GstFlowReturn gst_tensor_batch_chain (GstPad * pad, GstObject * parent,
+    GstBuffer * buf);
+static GstPad *gst_tensor_batch_request_new_pad (GstElement * element,
+    GstPadTemplate * templ, const gchar * name, const GstCaps * caps);
+static GstStateChangeReturn gst_tensor_batch_change_state (GstElement *
+    element, GstStateChange transition);
+
+static void gst_tensor_batch_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_tensor_batch_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
+static void gst_tensor_batch_finalize (GObject * object);
+
+#define gst_tensor_batch_parent_class parent_class
+G_DEFINE_TYPE (GstTensorBatch, gst_tensor_batch, GST_TYPE_ELEMENT);
+
+/**
+ * @brief initialize the tensor_batch's class
+ */
+static void
+gst_tensor_batch_class_init (GstTensorBatchClass * klass)
+{
+  GObjectClass *gobject_class;
+  GstElementClass *gstelement_class;
+
+  GST_DEBUG_CATEGORY_INIT (gst_tensor_batch_debug, "tensor_batch", 0,
+      "Element to batch the frames of multiple tensor streams");
+
+  gobject_class = (GObjectClass *) klass;
+  gstelement_class = (GstElementClass *) klass;
+
+  parent_class = g_type_class_peek_parent (klass);
+
+  gobject_class->finalize = gst_tensor_batch_finalize;
+  gobject_class->get_property = gst_tensor_batch_get_property;
+  gobject_class->set_property = gst_tensor_batch_set_property;
+
+  g_object_class_install_property (gobject_class, PROP_SILENT,
+      g_param_spec_boolean ("silent", "Silent", "Produce verbose output ?",
+          TRUE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_TIMEOUT,
+      g_param_spec_uint64 ("timeout", "Timeout",
+          "The deadline (usec) to push a partial batch after the first frame of the batch arrives, "
+          "0 to wait for the frames of all streams", 0, G_MAXUINT64,
+          DEFAULT_TIMEOUT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  gstelement_class->request_new_pad =
+      GST_DEBUG_FUNCPTR (gst_tensor_batch_request_new_pad);
+  gstelement_class->change_state =
+      GST_DEBUG_FUNCPTR (gst_tensor_batch_change_state);
+
+  gst_element_class_add_pad_template (gstelement_class,
+      gst_static_pad_template_get (&sink_templ));
+  gst_element_class_add_pad_template (gstelement_class,
+      gst_static_pad_template_get (&src_templ));
+
+  gst_element_class_set_details_simple (gstelement_class,
+      "TensorBatch",
+      "Muxer/Tensor",
+      "Batch the frames of multiple tensor streams into a tensor stream with the stream IDs",
+      "agent <agent@local>");
+}
+
+/**
+ * @brief initialize the new element
+ * instantiate pads and add them to element
+ * set pad calback functions
+ * initialize instance structure
+ */
+static void
+gst_tensor_batch_init (GstTensorBatch * self)
+{
+  self->srcpad = gst_pad_new_from_static_template (&src_templ, "src");
+  gst_pad_set_event_function (self->srcpad,
+      GST_DEBUG_FUNCPTR (gst_tensor_batch_src_event));
+  gst_pad_use_fixed_caps (self->srcpad);
+  gst_element_add_pad (GST_ELEMENT (self), self->srcpad);
+
+  self->silent = TRUE;
+  self->timeout = DEFAULT_TIMEOUT;
+  self->sinkpads = g_ptr_array_new ();
+
+  g_mutex_init (&self->lock);
+  g_cond_init (&self->cond);
+  g_mutex_init (&self->push_lock);
+  self->flushing = TRUE;
+  self->filled = 0;
+  self->window_start = 0;
+  self->last_ret = GST_FLOW_OK;
+  self->eos_sent = FALSE;
+
+  gst_tensors_config_init (&self->tensors_config);
+}
+
+/**
+ * @brief finalize vmethod
+ */
+static void
+gst_tensor_batch_finalize (GObject * object)
+{
+  GstTensorBatch *self;
+  GstTensorBatchPad *bpad;
+  guint i;
+
+  self = GST_TENSOR_BATCH (object);
+
+  for (i = 0; i < self->sinkpads->len; i++) {
+    bpad = (GstTensorBatchPad *) g_ptr_array_index (self->sinkpads, i);
+
+    if (bpad->buffer)
+      gst_buffer_unref (bpad->buffer);
+    gst_tensors_config_free (&bpad->config);
+    g_free (bpad);
+  }
+  g_ptr_array_free (self->sinkpads, TRUE);
+
+  gst_tensors_config_free (&self->tensors_config);
+  g_mutex_clear (&self->lock);
+  g_cond_clear (&self->cond);
+  g_mutex_clear (&self->push_lock);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+/**
+ * @brief making new request pad (gst element vmethod)
+ */
+static GstPad *
+gst_tensor_batch_request_new_pad (GstElement * element, GstPadTemplate * templ,
+    const gchar * req_name, const GstCaps * caps)
+{
+  GstTensorBatch *self;
+  GstTensorBatchPad *bpad;
+  GstPad *newpad;
+  gchar *name;
+  UNUSED (req_name);
+  UNUSED (caps);
+
+  g_return_val_if_fail (templ != NULL, NULL);
+  g_return_val_if_fail (GST_IS_TENSOR_BATCH (element), NULL);
+
+  self = GST_TENSOR_BATCH (element);
+
+  g_mutex_lock (&self->lock);
+  if (self->negotiated) {
+    g_mutex_unlock (&self->lock);
+    GST_WARNING_OBJECT (self,
+        "Cannot add the stream, the batch size is fixed with %u streams.",
+        self->sinkpads->len);
+    return NULL;
+  }
+
+  name = g_strdup_printf ("sink_%u", self->sinkpads->len);
+  newpad = gst_pad_new_from_template (templ, name);
+  g_free (name);
+
+  if (!newpad) {
+    g_mutex_unlock (&self->lock);
+    GST_WARNING_OBJECT (self, "failed to create request pad");
+    return NULL;
+  }
+
+  bpad = g_new0 (GstTensorBatchPad, 1);
+  bpad->pad = newpad;
+  bpad->index = self->sinkpads->len;
+  gst_tensors_config_init (&bpad->config);
+  g_ptr_array_add (self->sinkpads, bpad);
+  g_mutex_unlock (&self->lock);
+
+  gst_pad_set_element_private (newpad, bpad);
+  gst_pad_set_chain_function (newpad,
+      GST_DEBUG_FUNCPTR (gst_tensor_batch_chain));
+  gst_pad_set_event_function (newpad,
+      GST_DEBUG_FUNCPTR (gst_tensor_batch_sink_event));
+  gst_element_add_pad (element, newpad);
+
+  return newpad;
+}
+
+/**
+ * @brief src event vmethod
+ */
+static gboolean
+gst_tensor_batch_src_event (GstPad * pad, GstObject * parent, GstEvent * event)
+{
+  g_return_val_if_fail (event != NULL, FALSE);
+
+  switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_SEEK:
+      gst_event_unref (event);
+      return FALSE;
+    default:
+      break;
+  }
+
+  return gst_pad_event_default (pad, parent, event);
+}
+
+/**
+ * @brief Check the batch is ready, all streams give a frame or are ended. The lock should be held.
+ */
+static gboolean
+gst_tensor_batch_is_ready (GstTensorBatch * self)
+{
+  GstTensorBatchPad *bpad;
+  guint i;
+
+  if (self->filled == 0)
+    return FALSE;
+
+  for (i = 0; i < self->sinkpads->len; i++) {
+    bpad = (GstTensorBatchPad *) g_ptr_array_index (self->sinkpads, i);
+
+    if (!bpad->buffer && !bpad->eos)
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Check all streams are ended. The lock should be held.
+ */
+static gboolean
+gst_tensor_batch_is_eos (GstTensorBatch * self)
+{
+  GstTensorBatchPad *bpad;
+  guint i;
+
+  for (i = 0; i < self->sinkpads->len; i++) {
+    bpad = (GstTensorBatchPad *) g_ptr_array_index (self->sinkpads, i);
+
+    if (!bpad->eos)
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Configure the output tensors info with the streams. The lock should be held.
+ */
+static gboolean
+gst_tensor_batch_configure (GstTensorBatch * self)
+{
+  GstTensorsConfig *config = &self->tensors_config;
+  GstTensorBatchPad *bpad, *first = NULL;
+  GstTensorInfo *info;
+  guint i, num_tensors, num_streams;
+  gint rank;
+
+  num_streams = self->sinkpads->len;
+
+  for (i = 0; i < num_streams; i++) {
+    bpad = (GstTensorBatchPad *) g_ptr_array_index (self->sinkpads, i);
+
+    if (!bpad->configured)
+      continue;
+
+    if (!first) {
+      first = bpad;
+    } else if (!gst_tensors_info_is_equal (&first->config.info,
+            &bpad->config.info)) {
+      GST_ERROR_OBJECT (self,
+          "The tensors info of the stream %u is different from the stream %u.",
+          bpad->index, first->index);
+      return FALSE;
+    }
+  }
+
+  if (!first)
+    return FALSE;
+
+  num_tensors = first->config.info.num_tensors;
+  if (num_tensors >= NNS_TENSOR_SIZE_LIMIT) {
+    GST_ERROR_OBJECT (self,
+        "Too many tensors (%u) in the stream, the stream IDs cannot be added.",
+        num_tensors);
+    return FALSE;
+  }
+
+  gst_tensors_config_free (config);
+  gst_tensors_config_init (config);
+
+  for (i = 0; i < num_tensors; i++) {
+    info = &config->info.info[i];
+    gst_tensor_info_copy (info, &first->config.info.info[i]);
+
+    rank = gst_tensor_info_get_rank (info);
+    if (rank >= NNS_TENSOR_RANK_LIMIT) {
+      GST_ERROR_OBJECT (self,
+          "The rank of the %u-th tensor is %d, the batch dimension cannot be added.",
+          i, rank);
+      return FALSE;
+    }
+
+    info->dimension[rank] = num_streams;
+  }
+
+  /* the stream IDs */
+  info = &config->info.info[num_tensors];
+  info->type = _NNS_INT32;
+  info->dimension[0] = num_streams;
+  for (i = 1; i < NNS_TENSOR_RANK_LIMIT; i++)
+    info->dimension[i] = 1;
+
+  config->info.num_tensors = num_tensors + 1;
+  config->info.format = _NNS_TENSOR_FORMAT_STATIC;
+  config->rate_n = first->config.rate_n;
+  config->rate_d = first->config.rate_d;
+
+  return gst_tensors_config_validate (config);
+}
+
+/**
+ * @brief Drop the frames in the slots and wake up the streams. The lock should be held.
+ */
+static void
+gst_tensor_batch_clear_slots (GstTensorBatch * self)
+{
+  GstTensorBatchPad *bpad;
+  guint i;
+
+  for (i = 0; i < self->sinkpads->len; i++) {
+    bpad = (GstTensorBatchPad *) g_ptr_array_index (self->sinkpads, i);
+
+    if (bpad->buffer) {
+      gst_buffer_unref (bpad->buffer);
+      bpad->buffer = NULL;
+    }
+  }
+
+  self->filled = 0;
+  g_cond_broadcast (&self->cond);
+}
+
+/**
+ * @brief Copy the frames in the slots into a batch and clear the slots. The lock should be held.
+ */
+static GstBuffer *
+gst_tensor_batch_take (GstTensorBatch * self)
+{
+  GstTensorsInfo *info = &self->tensors_config.info;
+  GstTensorBatchPad *bpad;
+  GstBuffer *outbuf;
+  GstMemory *mem, *in_mem;
+  GstMapInfo map, in_map;
+  GstClockTime pts = GST_CLOCK_TIME_NONE;
+  guint i, k, num_tensors, num_streams;
+  gsize size;
+
+  num_streams = self->sinkpads->len;
+  num_tensors = info->num_tensors - 1;
+  outbuf = gst_buffer_new ();
+
+  for (i = 0; i < num_tensors; i++) {
+    size = gst_tensors_info_get_size (info, i) / num_streams;
+    mem = gst_allocator_alloc (NULL, size * num_streams, NULL);
+
+    if (!gst_memory_map (mem, &map, GST_MAP_WRITE)) {
+      GST_ERROR_OBJECT (self, "Failed to map the output memory.");
+      gst_memory_unref (mem);
+      gst_buffer_unref (outbuf);
+      outbuf = NULL;
+      goto done;
+    }
+
+    for (k = 0; k < num_streams; k++) {
+      guint8 *dest = map.data + size * k;
+
+      bpad = (GstTensorBatchPad *) g_ptr_array_index (self->sinkpads, k);
+      in_mem = bpad->buffer ? gst_tensor_buffer_get_nth_memory (bpad->buffer,
+          &bpad->config.info, i) : NULL;
+
+      if (in_mem && gst_memory_map (in_mem, &in_map, GST_MAP_READ)) {
+        memcpy (dest, in_map.data, MIN (size, in_map.size));
+        if (in_map.size < size)
+          memset (dest + in_map.size, 0, size - in_map.size);
+        gst_memory_unmap (in_mem, &in_map);
+      } else {
+        memset (dest, 0, size);
+      }
+
+      if (in_mem)
+        gst_memory_unref (in_mem);
+    }
+
+    gst_memory_unmap (mem, &map);
+    gst_buffer_append_memory (outbuf, mem);
+  }
+
+  /* the stream IDs */
+  mem = gst_allocator_alloc (NULL, sizeof (gint32) * num_streams, NULL);
+  if (!gst_memory_map (mem, &map, GST_MAP_WRITE)) {
+    GST_ERROR_OBJECT (self, "Failed to map the output memory.");
+    gst_memory_unref (mem);
+    gst_buffer_unref (outbuf);
+    outbuf = NULL;
+    goto done;
+  }
+
+  for (k = 0; k < num_streams; k++) {
+    bpad = (GstTensorBatchPad *) g_ptr_array_index (self->sinkpads, k);
+    ((gint32 *) map.data)[k] = bpad->buffer ? (gint32) bpad->index : -1;
+
+    if (bpad->buffer && GST_BUFFER_PTS_IS_VALID (bpad->buffer)) {
+      if (!GST_CLOCK_TIME_IS_VALID (pts) || GST_BUFFER_PTS (bpad->buffer) < pts)
+        pts = GST_BUFFER_PTS (bpad->buffer);
+    }
+  }
+
+  gst_memory_unmap (mem, &map);
+  gst_buffer_append_memory (outbuf, mem);
+
+  GST_BUFFER_PTS (outbuf) = pts;
+  silent_debug (self, "Batched %u frames of %u streams.", self->filled,
+      num_streams);
+
+done:
+  gst_tensor_batch_clear_slots (self);
+  return outbuf;
+}
+
+/**
+ * @brief Push the events before the first batch. The push lock should be held.
+ */
+static gboolean
+gst_tensor_batch_push_events (GstTensorBatch * self,
+    const GstTensorsConfig * config)
+{
+  if (self->need_stream_start) {
+    gchar s_id[32];
+
+    g_snprintf (s_id, sizeof (s_id), "tensorbatch-%08x", g_random_int ());
+    gst_pad_push_event (self->srcpad, gst_event_new_stream_start (s_id));
+    self->need_stream_start = FALSE;
+  }
+
+  if (!gst_pad_has_current_caps (self->srcpad)) {
+    GstCaps *caps;
+    gboolean ret;
+
+    caps = gst_tensor_pad_caps_from_config (self->srcpad, config);
+    ret = gst_pad_set_caps (self->srcpad, caps);
+    gst_caps_unref (caps);
+
+    if (!ret) {
+      GST_ELEMENT_ERROR (self, CORE, NEGOTIATION, (NULL),
+          ("Failed to set the caps of the batch."));
+      return FALSE;
+    }
+  }
+
+  if (self->need_segment) {
+    GstSegment segment;
+
+    gst_segment_init (&segment, GST_FORMAT_TIME);
+    gst_pad_push_event (self->srcpad, gst_event_new_segment (&segment));
+    self->need_segment = FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Push the batch of the frames in the slots. The lock should be held, and it is released.
+ */
+static GstFlowReturn
+gst_tensor_batch_push_unlocked (GstTensorBatch * self)
+{
+  GstTensorsConfig config;
+  GstBuffer *outbuf;
+  GstFlowReturn ret;
+
+  if (!self->negotiated) {
+    if (!gst_tensor_batch_configure (self)) {
+      gst_tensor_batch_clear_slots (self);
+      self->last_ret = GST_FLOW_NOT_NEGOTIATED;
+      g_mutex_unlock (&self->lock);
+      GST_ELEMENT_ERROR (self, CORE, NEGOTIATION, (NULL),
+          ("Failed to configure the batch of the streams."));
+      return GST_FLOW_NOT_NEGOTIATED;
+    }
+    self->negotiated = TRUE;
+  }
+
+  outbuf = gst_tensor_batch_take (self);
+  gst_tensors_config_init (&config);
+  gst_tensors_config_copy (&config, &self->tensors_config);
+
+  /* keep the order of the batches */
+  g_mutex_lock (&self->push_lock);
+  g_mutex_unlock (&self->lock);
+
+  if (!outbuf) {
+    ret = GST_FLOW_ERROR;
+  } else if (!gst_tensor_batch_push_events (self, &config)) {
+    gst_buffer_unref (outbuf);
+    ret = GST_FLOW_NOT_NEGOTIATED;
+  } else {
+    ret = gst_pad_push (self->srcpad, outbuf);
+  }
+
+  g_mutex_unlock (&self->push_lock);
+  gst_tensors_config_free (&config);
+
+  if (ret != GST_FLOW_OK) {
+    GST_WARNING_OBJECT (self, "pushed outbuf, result = %s",
+        gst_flow_get_name (ret));
+  }
+
+  g_mutex_lock (&self->lock);
+  self->last_ret = ret;
+  g_mutex_unlock (&self->lock);
+  return ret;
+}
+
+/**
+ * @brief Push EOS if all streams are ended. The lock should be held, and it is released.
+ */
+static void
+gst_tensor_batch_push_eos_unlocked (GstTensorBatch * self)
+{
+  if (self->eos_sent || !gst_tensor_batch_is_eos (self)) {
+    g_mutex_unlock (&self->lock);
+    return;
+  }
+
+  self->eos_sent = TRUE;
+  g_mutex_lock (&self->push_lock);
+  g_mutex_unlock (&self->lock);
+
+  gst_pad_push_event (self->srcpad, gst_event_new_eos ());
+  g_mutex_unlock (&self->push_lock);
+}
+
+/**
+ * @brief sink event vmethod
+ */
+static gboolean
+gst_tensor_batch_sink_event (GstPad * pad, GstObject * parent,
+    GstEvent * event)
+{
+  GstTensorBatch *self;
+  GstTensorBatchPad *bpad;
+
+  g_return_val_if_fail (event != NULL, FALSE);
+
+  self = GST_TENSOR_BATCH (parent);
+  bpad = (GstTensorBatchPad *) gst_pad_get_element_private (pad);
+
+  switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_CAPS:
+    {
+      GstCaps *caps;
+      GstStructure *structure;
+      GstTensorsConfig config;
+      gboolean ret;
+
+      gst_event_parse_caps (event, &caps);
+      structure = gst_caps_get_structure (caps, 0);
+
+      gst_tensors_config_init (&config);
+      gst_tensors_config_from_structure (&config, structure);
+      ret = gst_tensors_config_validate (&config) &&
+          gst_tensors_config_is_static (&config);
+
+      g_mutex_lock (&self->lock);
+      if (ret && self->negotiated && !gst_tensors_info_is_equal (&config.info,
+              &bpad->config.info)) {
+        GST_ERROR_OBJECT (self,
+            "Cannot change the tensors info of the stream %u after the batch is configured.",
+            bpad->index);
+        ret = FALSE;
+      }
+
+      if (ret) {
+        gst_tensors_config_free (&bpad->config);
+        gst_tensors_config_copy (&bpad->config, &config);
+        bpad->configured = TRUE;
+      }
+      g_mutex_unlock (&self->lock);
+
+      gst_tensors_config_free (&config);
+      gst_event_unref (event);
+      return ret;
+    }
+    case GST_EVENT_STREAM_START:
+    case GST_EVENT_SEGMENT:
+      /* the events of the batch are pushed with the first batch */
+      gst_event_unref (event);
+      return TRUE;
+    case GST_EVENT_FLUSH_START:
+    case GST_EVENT_FLUSH_STOP:
+      /* the streams are not seekable */
+      gst_event_unref (event);
+      return TRUE;
+    case GST_EVENT_EOS:
+      gst_event_unref (event);
+
+      g_mutex_lock (&self->lock);
+      bpad->eos = TRUE;
+      silent_debug (self, "The stream %u is ended.", bpad->index);
+
+      /* the other streams may wait for this stream */
+      if (!self->flushing && gst_tensor_batch_is_ready (self)) {
+        gst_tensor_batch_push_unlocked (self);
+        g_mutex_lock (&self->lock);
+      }
+
+      gst_tensor_batch_push_eos_unlocked (self);
+      return TRUE;
+    default:
+      break;
+  }
+
+  return gst_pad_event_default (pad, parent, event);
+}
+
+/**
+ * @brief chain function for sink (gst element vmethod)
+ */
+static GstFlowReturn
+gst_tensor_batch_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
+{
+  GstTensorBatch *self;
+  GstTensorBatchPad *bpad;
+  GstFlowReturn ret;
+  gint64 end_time;
+
+  self = GST_TENSOR_BATCH (parent);
+  bpad = (GstTensorBatchPad *) gst_pad_get_element_private (pad);
+
+  g_mutex_lock (&self->lock);
+
+  if (self->flushing) {
+    g_mutex_unlock (&self->lock);
+    gst_buffer_unref (buf);
+    return GST_FLOW_FLUSHING;
+  }
+
+  if (!bpad->configured) {
+    g_mutex_unlock (&self->lock);
+    gst_buffer_unref (buf);
+    GST_ELEMENT_ERROR (self, CORE, NEGOTIATION, (NULL),
+        ("The caps of the stream %u is not given.", bpad->index));
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+
+  /* the chain waits for the batch, the slot is empty */
+  bpad->buffer = buf;
+  if (self->filled++ == 0)
+    self->window_start = g_get_monotonic_time ();
+
+  if (gst_tensor_batch_is_ready (self))
+    return gst_tensor_batch_push_unlocked (self);
+
+  /* wait until the frame is batched by the other stream or the deadline passes */
+  end_time = self->window_start + (gint64) self->timeout;
+  while (bpad->buffer == buf && !self->flushing) {
+    if (self->timeout == 0) {
+      g_cond_wait (&self->cond, &self->lock);
+    } else if (!g_cond_wait_until (&self->cond, &self->lock, end_time)) {
+      if (bpad->buffer == buf && !self->flushing) {
+        silent_debug (self, "The deadline passes, push the partial batch.");
+        return gst_tensor_batch_push_unlocked (self);
+      }
+    }
+  }
+
+  ret = self->flushing ? GST_FLOW_FLUSHING : self->last_ret;
+  g_mutex_unlock (&self->lock);
+  return ret;
+}
+
+/**
+ * @brief Clear the slots and the streams. The lock should be held.
+ */
+static void
+gst_tensor_batch_reset (GstTensorBatch * self)
+{
+  GstTensorBatchPad *bpad;
+  guint i;
+
+  gst_tensor_batch_clear_slots (self);
+
+  for (i = 0; i < self->sinkpads->len; i++) {
+    bpad = (GstTensorBatchPad *) g_ptr_array_index (self->sinkpads, i);
+    bpad->eos = FALSE;
+  }
+
+  self->last_ret = GST_FLOW_OK;
+  self->eos_sent = FALSE;
+}
+
+/**
+ * @brief change state (gst element vmethod)
+ */
+static GstStateChangeReturn
+gst_tensor_batch_change_state (GstElement * element, GstStateChange transition)
+{
+  GstTensorBatch *self;
+  GstStateChangeReturn ret;
+
+  self = GST_TENSOR_BATCH (element);
+
+  switch (transition) {
+    case GST_STATE_CHANGE_READY_TO_PAUSED:
+      g_mutex_lock (&self->lock);
+      gst_tensor_batch_reset (self);
+      self->flushing = FALSE;
+      self->negotiated = FALSE;
+      self->need_segment = TRUE;
+      self->need_stream_start = TRUE;
+      g_mutex_unlock (&self->lock);
+      break;
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      /* wake up the streams waiting for the batch */
+      g_mutex_lock (&self->lock);
+      self->flushing = TRUE;
+      g_cond_broadcast (&self->cond);
+      g_mutex_unlock (&self->lock);
+      break;
+    default:
+      break;
+  }
+
+  ret = GST_ELEMENT_CLASS (parent_class)->change_state (element, transition);
+  if (ret == GST_STATE_CHANGE_FAILURE)
+    return ret;
+
+  switch (transition) {
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      g_mutex_lock (&self->lock);
+      gst_tensor_batch_reset (self);
+      g_mutex_unlock (&self->lock);
+      break;
+    default:
+      break;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Set property (gst element vmethod)
+ */
+static void
+gst_tensor_batch_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstTensorBatch *self = GST_TENSOR_BATCH (object);
+
+  switch (prop_id) {
+    case PROP_SILENT:
+      self->silent = g_value_get_boolean (value);
+      break;
+    case PROP_TIMEOUT:
+      g_mutex_lock (&self->lock);
+      self->timeout = g_value_get_uint64 (value);
+      g_mutex_unlock (&self->lock);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/**
+ * @brief Get property (gst element vmethod)
+ */
+static void
+gst_tensor_batch_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstTensorBatch *self = GST_TENSOR_BATCH (object);
+
+  switch (prop_id) {
+    case PROP_SILENT:
+      g_value_set_boolean (value, self->silent);
+      break;
+    case PROP_TIMEOUT:
+      g_value_set_uint64 (value, self->timeout);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
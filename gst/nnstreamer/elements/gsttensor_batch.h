@@ -0,0 +1,84 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	gsttensor_batch.h
+ * @date	14 Oct 2026
+ * @brief	GStreamer plugin to batch the frames of multiple tensor streams into a tensor stream with the stream IDs
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ */
+
+#ifndef __GST_TENSOR_BATCH_H__
+#define __GST_TENSOR_BATCH_H__
+
+#include <gst/gst.h>
+#include <tensor_common.h>
+
+G_BEGIN_DECLS
+#define GST_TYPE_TENSOR_BATCH (gst_tensor_batch_get_type ())
+#define GST_TENSOR_BATCH(obj) (G_TYPE_CHECK_INSTANCE_CAST ((obj), GST_TYPE_TENSOR_BATCH, GstTensorBatch))
+#define GST_TENSOR_BATCH_CLASS(klass) (G_TYPE_CHECK_CLASS_CAST ((klass), GST_TYPE_TENSOR_BATCH, GstTensorBatchClass))
+#define GST_TENSOR_BATCH_GET_CLASS(obj) (G_TYPE_INSTANCE_GET_CLASS ((obj), GST_TYPE_TENSOR_BATCH, GstTensorBatchClass))
+#define GST_IS_TENSOR_BATCH(obj) (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_TENSOR_BATCH))
+#define GST_IS_TENSOR_BATCH_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_TENSOR_BATCH))
+#define GST_TENSOR_BATCH_CAST(obj)((GstTensorBatch*)(obj))
+typedef struct _GstTensorBatch GstTensorBatch;
+typedef struct _GstTensorBatchClass GstTensorBatchClass;
+
+/**
+ * @brief The sink pad of tensor_batch, the slot of the stream in the batch.
+ */
+typedef struct
+{
+  GstPad *pad; /**< the sink pad */
+  guint index; /**< the index of the stream (the stream ID in the batch) */
+  GstTensorsConfig config; /**< the tensors info of the stream */
+  gboolean configured; /**< TRUE if the caps of the stream is given */
+  GstBuffer *buffer; /**< the frame waiting for the batch */
+  gboolean eos; /**< TRUE if the stream is ended */
+} GstTensorBatchPad;
+
+/**
+ * @brief Tensor Batch data structure
+ */
+struct _GstTensorBatch
+{
+  GstElement element;
+
+  gboolean silent;
+  guint64 timeout; /**< the deadline (usec) of the partial batch since the first frame of the batch arrives, 0 to wait for all streams */
+  GstPad *srcpad;
+  GPtrArray *sinkpads; /**< the sink pads (GstTensorBatchPad) in the order of the stream ID */
+
+  GMutex lock; /**< lock for the slots */
+  GCond cond; /**< signaled when the frames are batched */
+  GMutex push_lock; /**< lock to push the batches in order */
+  gboolean flushing; /**< TRUE while the element is stopped */
+  guint filled; /**< the number of the frames waiting for the batch */
+  gint64 window_start; /**< the time (usec) the first frame of the batch arrives */
+  GstFlowReturn last_ret; /**< the result of the latest push */
+  gboolean eos_sent; /**< TRUE if all streams are ended and EOS is pushed */
+
+  gboolean negotiated;
+  gboolean need_segment;
+  gboolean need_stream_start;
+  GstTensorsConfig tensors_config; /**< output tensors info */
+};
+
+/**
+ * @brief GstTensorBatchClass inherits GstElementClass
+ */
+struct _GstTensorBatchClass
+{
+  GstElementClass parent_class;
+};
+
+/**
+ * @brief Get Type function required for gst elements
+ */
+GType gst_tensor_batch_get_type (void);
+
+G_END_DECLS
+#endif  /** __GST_TENSOR_BATCH_H__ **/
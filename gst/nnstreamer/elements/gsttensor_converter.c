@@ -123,7 +123,9 @@ enum
   PROP_SET_TIMESTAMP,
   PROP_SUBPLUGINS,
   PROP_SILENT,
-  PROP_MODE
+  PROP_MODE,
+  PROP_VIDEO_POOL,
+  PROP_FRAMES_HOP
 };
 
 /**
@@ -141,6 +143,22 @@ enum
  */
 #define DEFAULT_FRAMES_PER_TENSOR 1
 
+/**
+ * @brief Flag to propose the buffer pool of the video frames without the row padding.
+ */
+#define DEFAULT_VIDEO_POOL FALSE
+
+/**
+ * @brief Frames to advance the window in output tensor (0 means same as frames-per-tensor).
+ */
+#define DEFAULT_FRAMES_HOP 0
+
+/**
+ * @brief The number of hops in the ring block for the overlapped windows.
+ * The overlapped frames are moved to the start of the block once per this number of windows.
+ */
+#define RING_BLOCK_HOPS 16
+
 #define gst_tensor_converter_parent_class parent_class
 G_DEFINE_TYPE (GstTensorConverter, gst_tensor_converter, GST_TYPE_ELEMENT);
 
@@ -158,6 +176,8 @@ static gboolean gst_tensor_converter_src_query (GstPad * pad,
     GstObject * parent, GstQuery * query);
 static GstFlowReturn gst_tensor_converter_chain (GstPad * pad,
     GstObject * parent, GstBuffer * buf);
+static gboolean gst_tensor_converter_video_stride (GstVideoFormat format,
+    gint width);
 static GstStateChangeReturn
 gst_tensor_converter_change_state (GstElement * element,
     GstStateChange transition);
@@ -234,6 +254,20 @@ gst_tensor_converter_class_init (GstTensorConverterClass * klass)
           DEFAULT_FRAMES_PER_TENSOR,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstTensorConverter::frames-hop:
+   *
+   * The number of frames to advance the window of the outgoing buffer.
+   * If it is smaller than frames-per-tensor, the outgoing buffers have the overlapped frames (sliding window),
+   * which are the read-only views of the preallocated ring block without copying the overlap.
+   */
+  g_object_class_install_property (object_class, PROP_FRAMES_HOP,
+      g_param_spec_uint ("frames-hop", "Frames hop",
+          "The number of frames to advance the window of output tensor. "
+          "The windows are overlapped if it is smaller than frames-per-tensor "
+          "(0 to disable the overlap)", 0, G_MAXUINT, DEFAULT_FRAMES_HOP,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstTensorConverter::set-timestamp:
    *
@@ -267,12 +301,26 @@ gst_tensor_converter_class_init (GstTensorConverterClass * klass)
    * GstTensorConverter::mode:
    *
    * Generally this property is used to set tensor converter custom mode.
+   * With mode=preprocess:<option>, the video frame is converted, resized and normalized in a single pass.
    */
   g_object_class_install_property (object_class, PROP_MODE,
       g_param_spec_string ("mode", "Mode",
-          "Converter mode. e.g., mode=custom-code:<registered callback name>. For detail, refer to https://github.com/nnstreamer/nnstreamer/blob/main/gst/nnstreamer/elements/gsttensor_converter.md#custom-converter",
+          "Converter mode. e.g., mode=custom-code:<registered callback name> or mode=preprocess:width=224,height=224,type=float32. For detail, refer to https://github.com/nnstreamer/nnstreamer/blob/main/gst/nnstreamer/elements/gsttensor_converter.md#custom-converter",
           "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstTensorConverter::video-pool:
+   *
+   * The flag to propose the buffer pool of the video frames without the row padding to upstream.
+   * If the video width is not 4-byte aligned, upstream writes the frames into the pool with GstVideoMeta,
+   * and tensor_converter pushes the frames without copying each row.
+   * Upstream should support GstVideoMeta (e.g., videoconvert, videoscale and videotestsrc).
+   */
+  g_object_class_install_property (object_class, PROP_VIDEO_POOL,
+      g_param_spec_boolean ("video-pool", "Video pool",
+          "Propose the buffer pool of the video frames without the row padding to upstream supporting GstVideoMeta, to avoid copying the frames with unaligned width",
+          DEFAULT_VIDEO_POOL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /* set src pad template */
   pad_caps =
       gst_caps_from_string (GST_TENSOR_CAP_DEFAULT ";"
@@ -356,9 +404,12 @@ gst_tensor_converter_init (GstTensorConverter * self)
   self->silent = DEFAULT_SILENT;
   self->set_timestamp = DEFAULT_SET_TIMESTAMP;
   self->frames_per_tensor = DEFAULT_FRAMES_PER_TENSOR;
+  self->frames_hop = DEFAULT_FRAMES_HOP;
+  self->ring = NULL;
   self->in_media_type = _NNS_MEDIA_INVALID;
   self->frame_size = 0;
   self->remove_padding = FALSE;
+  self->video_pool = DEFAULT_VIDEO_POOL;
   self->externalConverter = NULL;
   self->priv_data = NULL;
   self->mode = _CONVERTER_MODE_NONE;
@@ -366,6 +417,8 @@ gst_tensor_converter_init (GstTensorConverter * self)
   self->custom.func = NULL;
   self->custom.data = NULL;
   self->do_not_append_header = FALSE;
+  gst_tensor_converter_preprocess_init (&self->preprocess);
+  self->num_planes = 0;
   gst_tensors_info_init (&self->tensors_info);
   gst_tensors_config_init (&self->tensors_config);
   self->tensors_configured = FALSE;
@@ -392,6 +445,7 @@ gst_tensor_converter_finalize (GObject * object)
 
   g_free (self->mode_option);
   g_free (self->ext_fw);
+  gst_tensor_converter_preprocess_free (&self->preprocess);
   self->custom.func = NULL;
   self->custom.data = NULL;
   if (self->externalConverter && self->externalConverter->close)
@@ -454,6 +508,10 @@ gst_tensor_converter_set_property (GObject * object, guint prop_id,
       self->frames_per_tensor = g_value_get_uint (value);
       silent_debug (self, "Set frames in output = %d", self->frames_per_tensor);
       break;
+    case PROP_FRAMES_HOP:
+      self->frames_hop = g_value_get_uint (value);
+      silent_debug (self, "Set frames hop = %d", self->frames_hop);
+      break;
     case PROP_SET_TIMESTAMP:
       self->set_timestamp = g_value_get_boolean (value);
       silent_debug (self, "Set timestamp = %d", self->set_timestamp);
@@ -462,6 +520,10 @@ gst_tensor_converter_set_property (GObject * object, guint prop_id,
       self->silent = g_value_get_boolean (value);
       silent_debug (self, "Set silent = %d", self->silent);
       break;
+    case PROP_VIDEO_POOL:
+      self->video_pool = g_value_get_boolean (value);
+      silent_debug (self, "Set video pool = %d", self->video_pool);
+      break;
     case PROP_MODE:
     {
       const gchar *param = g_value_get_string (value);
@@ -490,8 +552,27 @@ gst_tensor_converter_set_property (GObject * object, guint prop_id,
         self->custom.data = ptr->data;
       } else if (g_ascii_strcasecmp (strv[0], "custom-script") == 0) {
         self->mode = _CONVERTER_MODE_CUSTOM_SCRIPT;
-        /** @todo detects framework based on the script extension */
-        self->ext_fw = g_strdup ("python3");
+        g_free (self->ext_fw);
+        if (g_strv_length (strv) > 2) {
+          /* custom-script:<subplugin>:<option>, the option is given to the subplugin */
+          self->ext_fw = g_strdup (strv[1]);
+          g_free (self->mode_option);
+          self->mode_option = g_strjoinv (":", &strv[2]);
+        } else {
+          /** @todo detects framework based on the script extension */
+          self->ext_fw = g_strdup ("python3");
+        }
+      } else if (g_ascii_strcasecmp (strv[0], "preprocess") == 0) {
+        if (!gst_tensor_converter_preprocess_parse_option (&self->preprocess,
+                self->mode_option)) {
+          nns_logw
+              ("Failed to parse the preprocess option \"%s\". Refer to https://github.com/nnstreamer/nnstreamer/blob/main/gst/nnstreamer/elements/gsttensor_converter.md#preprocess-mode for detail.",
+              self->mode_option);
+          self->mode = _CONVERTER_MODE_NONE;
+          g_strfreev (strv);
+          break;
+        }
+        self->mode = _CONVERTER_MODE_PREPROCESS;
       }
       g_strfreev (strv);
 
@@ -535,6 +616,9 @@ gst_tensor_converter_get_property (GObject * object, guint prop_id,
     case PROP_FRAMES_PER_TENSOR:
       g_value_set_uint (value, self->frames_per_tensor);
       break;
+    case PROP_FRAMES_HOP:
+      g_value_set_uint (value, self->frames_hop);
+      break;
     case PROP_SET_TIMESTAMP:
       g_value_set_boolean (value, self->set_timestamp);
       break;
@@ -553,6 +637,9 @@ gst_tensor_converter_get_property (GObject * object, guint prop_id,
     case PROP_SILENT:
       g_value_set_boolean (value, self->silent);
       break;
+    case PROP_VIDEO_POOL:
+      g_value_set_boolean (value, self->video_pool);
+      break;
     case PROP_MODE:
     {
       gchar *mode_str = NULL;
@@ -565,6 +652,9 @@ gst_tensor_converter_get_property (GObject * object, guint prop_id,
         else if (self->mode == _CONVERTER_MODE_CUSTOM_SCRIPT)
           mode_str =
               g_strdup_printf ("%s:%s", "custom-script", self->mode_option);
+        else if (self->mode == _CONVERTER_MODE_PREPROCESS)
+          mode_str =
+              g_strdup_printf ("%s:%s", "preprocess", self->mode_option);
       }
       g_value_take_string (value, mode_str);
       break;
@@ -643,6 +733,177 @@ gst_tensor_converter_sink_event (GstPad * pad, GstObject * parent,
   return gst_pad_event_default (pad, parent, event);
 }
 
+#ifndef NO_VIDEO
+/**
+ * @brief Buffer pool for the video frames without the row padding.
+ */
+typedef struct
+{
+  GstBufferPool parent; /**< parent object */
+
+  GstVideoInfo info; /**< video info from the configured caps */
+  gint stride; /**< size of a row without the padding */
+} GstTensorConverterVideoPool;
+
+/**
+ * @brief GstTensorConverterVideoPoolClass data structure.
+ */
+typedef struct
+{
+  GstBufferPoolClass parent_class; /**< parent class */
+} GstTensorConverterVideoPoolClass;
+
+static GType gst_tensor_converter_video_pool_get_type (void);
+G_DEFINE_TYPE (GstTensorConverterVideoPool, gst_tensor_converter_video_pool,
+    GST_TYPE_BUFFER_POOL);
+
+/**
+ * @brief Get the options of the video pool (the buffers have GstVideoMeta).
+ */
+static const gchar **
+gst_tensor_converter_video_pool_get_options (GstBufferPool * pool)
+{
+  static const gchar *options[] = { GST_BUFFER_POOL_OPTION_VIDEO_META, NULL };
+  UNUSED (pool);
+
+  return options;
+}
+
+/**
+ * @brief Configure the video pool, the size of the buffer is the frame without the row padding.
+ */
+static gboolean
+gst_tensor_converter_video_pool_set_config (GstBufferPool * pool,
+    GstStructure * config)
+{
+  GstTensorConverterVideoPool *self = (GstTensorConverterVideoPool *) pool;
+  GstCaps *caps;
+  guint size, min, max;
+
+  if (!gst_buffer_pool_config_get_params (config, &caps, &size, &min, &max) ||
+      caps == NULL || !gst_video_info_from_caps (&self->info, caps) ||
+      GST_VIDEO_INFO_N_PLANES (&self->info) != 1) {
+    nns_loge ("The video pool of tensor_converter requires the caps of "
+        "the single-plane video.");
+    return FALSE;
+  }
+
+  self->stride = GST_VIDEO_INFO_COMP_PSTRIDE (&self->info, 0) *
+      GST_VIDEO_INFO_WIDTH (&self->info);
+  size = (guint) self->stride * GST_VIDEO_INFO_HEIGHT (&self->info);
+
+  gst_buffer_pool_config_set_params (config, caps, size, min, max);
+  return GST_BUFFER_POOL_CLASS
+      (gst_tensor_converter_video_pool_parent_class)->set_config (pool, config);
+}
+
+/**
+ * @brief Allocate a video frame without the row padding, GstVideoMeta describes the stride.
+ */
+static GstFlowReturn
+gst_tensor_converter_video_pool_alloc_buffer (GstBufferPool * pool,
+    GstBuffer ** buffer, GstBufferPoolAcquireParams * params)
+{
+  GstTensorConverterVideoPool *self = (GstTensorConverterVideoPool *) pool;
+  gsize offset[GST_VIDEO_MAX_PLANES] = { 0, };
+  gint stride[GST_VIDEO_MAX_PLANES] = { 0, };
+  GstBuffer *buf;
+
+  UNUSED (params);
+  stride[0] = self->stride;
+
+  buf = gst_buffer_new_allocate (NULL,
+      (gsize) self->stride * GST_VIDEO_INFO_HEIGHT (&self->info), NULL);
+  if (!buf) {
+    nns_loge ("Failed to allocate the video frame in tensor_converter.");
+    return GST_FLOW_ERROR;
+  }
+
+  gst_buffer_add_video_meta_full (buf, GST_VIDEO_FRAME_FLAG_NONE,
+      GST_VIDEO_INFO_FORMAT (&self->info), GST_VIDEO_INFO_WIDTH (&self->info),
+      GST_VIDEO_INFO_HEIGHT (&self->info), 1, offset, stride);
+
+  *buffer = buf;
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Initialize the class of the video pool.
+ */
+static void
+gst_tensor_converter_video_pool_class_init (GstTensorConverterVideoPoolClass *
+    klass)
+{
+  GstBufferPoolClass *pool_class = GST_BUFFER_POOL_CLASS (klass);
+
+  pool_class->get_options = gst_tensor_converter_video_pool_get_options;
+  pool_class->set_config = gst_tensor_converter_video_pool_set_config;
+  pool_class->alloc_buffer = gst_tensor_converter_video_pool_alloc_buffer;
+}
+
+/**
+ * @brief Initialize the video pool.
+ */
+static void
+gst_tensor_converter_video_pool_init (GstTensorConverterVideoPool * self)
+{
+  gst_video_info_init (&self->info);
+  self->stride = 0;
+}
+
+/**
+ * @brief Propose the video pool to upstream if the video frame has the row padding.
+ * @return TRUE if the pool is added to the allocation query.
+ */
+static gboolean
+gst_tensor_converter_propose_video_pool (GstTensorConverter * self,
+    GstQuery * query)
+{
+  GstBufferPool *pool;
+  GstStructure *config;
+  GstCaps *caps;
+  GstVideoInfo vinfo;
+  guint size;
+
+  gst_query_parse_allocation (query, &caps, NULL);
+
+  /* the frames in DMA-BUF are allocated by upstream */
+  if (!caps || gst_caps_features_contains (gst_caps_get_features (caps, 0),
+          VIDEO_CAPS_FEATURE_DMABUF) ||
+      !gst_video_info_from_caps (&vinfo, caps) ||
+      !gst_tensor_converter_video_stride (GST_VIDEO_INFO_FORMAT (&vinfo),
+          GST_VIDEO_INFO_WIDTH (&vinfo)))
+    return FALSE;
+
+  pool = GST_BUFFER_POOL_CAST (g_object_new
+      (gst_tensor_converter_video_pool_get_type (), NULL));
+  gst_object_ref_sink (pool);
+
+  config = gst_buffer_pool_get_config (pool);
+  gst_buffer_pool_config_set_params (config, caps, 0, 0, 0);
+  gst_buffer_pool_config_add_option (config, GST_BUFFER_POOL_OPTION_VIDEO_META);
+
+  if (!gst_buffer_pool_set_config (pool, config)) {
+    GST_WARNING_OBJECT (self, "Failed to configure the video pool.");
+    gst_object_unref (pool);
+    return FALSE;
+  }
+
+  config = gst_buffer_pool_get_config (pool);
+  gst_buffer_pool_config_get_params (config, NULL, &size, NULL, NULL);
+  gst_structure_free (config);
+
+  gst_query_add_allocation_pool (query, pool, size, 0, 0);
+  gst_query_add_allocation_meta (query, GST_VIDEO_META_API_TYPE, NULL);
+  gst_object_unref (pool);
+
+  GST_INFO_OBJECT (self, "Propose the video pool without the row padding "
+      "(stride %d, size %u).", GST_VIDEO_INFO_COMP_PSTRIDE (&vinfo, 0) *
+      GST_VIDEO_INFO_WIDTH (&vinfo), size);
+  return TRUE;
+}
+#endif /* NO_VIDEO */
+
 /**
  * @brief This function handles sink pad query.
  */
@@ -688,6 +949,13 @@ gst_tensor_converter_sink_query (GstPad * pad, GstObject * parent,
       gst_query_set_accept_caps_result (query, res);
       return TRUE;
     }
+#ifndef NO_VIDEO
+    case GST_QUERY_ALLOCATION:
+      if (self->video_pool && gst_tensor_converter_propose_video_pool (self,
+              query))
+        return TRUE;
+      break;
+#endif
     default:
       break;
   }
@@ -849,25 +1117,44 @@ _gst_tensor_converter_chain_octet (GstTensorConverter * self, GstBuffer * buf)
   /* configure multi tensors */
   if (multi || gst_buffer_n_memory (buf) > 1) {
     GstMemory *mem;
-    gsize offset, size;
-    guint i;
+    gsize offset, size, skip;
+    guint i, idx, length;
 
     g_assert (self->frames_per_tensor == 1);
 
     offset = 0;
     buffer = gst_buffer_new ();
-    mem = gst_buffer_get_all_memory (buf);
 
-    if (multi) {
-      for (i = 0; i < _info->num_tensors; ++i) {
-        size = gst_tensors_info_get_size (_info, i);
-        gst_buffer_append_memory (buffer, gst_memory_share (mem, offset, size));
-        offset += size;
+    /**
+     * Share the range of the incoming memory for each tensor.
+     * The memory blocks are merged (copied) only if a tensor spans several blocks.
+     */
+    for (i = 0; i < _info->num_tensors; ++i) {
+      size = multi ? gst_tensors_info_get_size (_info, i) :
+          (gst_buffer_get_size (buf) - offset);
+
+      if (!gst_buffer_find_memory (buf, offset, size, &idx, &length, &skip)) {
+        GST_ERROR_OBJECT (self,
+            "Failed to get the tensor %u (offset %zu, size %zu) from the octet stream.",
+            i, offset, size);
+        break;
+      }
+
+      if (length == 1) {
+        mem = gst_buffer_peek_memory (buf, idx);
+        if (skip == 0 && gst_memory_get_sizes (mem, NULL, NULL) == size)
+          mem = gst_memory_ref (mem);
+        else
+          mem = gst_memory_share (mem, skip, size);
+      } else {
+        GstMemory *merged = gst_buffer_get_memory_range (buf, idx, length);
+
+        mem = gst_memory_share (merged, skip, size);
+        gst_memory_unref (merged);
       }
 
-      gst_memory_unref (mem);
-    } else {
       gst_buffer_append_memory (buffer, mem);
+      offset += size;
     }
 
     /* copy timestamps */
@@ -1008,6 +1295,379 @@ _gst_tensor_converter_chain_chunk (GstTensorConverter * self,
   return ret;
 }
 
+/**
+ * @brief Release the ring block for the overlapped windows.
+ */
+static void
+gst_tensor_converter_ring_free (GstTensorConverter * self)
+{
+  if (self->ring) {
+    gst_memory_unmap (self->ring, &self->ring_map);
+    gst_memory_unref (self->ring);
+    self->ring = NULL;
+  }
+
+  self->ring_read = self->ring_write = 0;
+}
+
+/**
+ * @brief Get the ring block to write the incoming frames, the remained frames are moved to the start of the block.
+ * @return TRUE if the block has the space for the incoming frames.
+ */
+static gboolean
+gst_tensor_converter_ring_prepare (GstTensorConverter * self,
+    guint frames_out, gsize frame_size)
+{
+  GstTensorsConfig *config = &self->tensors_config;
+  GstMemory *ring;
+  GstMapInfo map;
+  gsize keep;
+
+  if (self->ring && self->ring_frame_size != frame_size)
+    gst_tensor_converter_ring_free (self);
+
+  if (self->ring && self->ring_write < self->ring_frames)
+    return TRUE;
+
+  if (self->ring == NULL) {
+    self->ring_frames = frames_out + (gsize) self->frames_hop * RING_BLOCK_HOPS;
+    self->ring_frame_size = frame_size;
+    self->ring_read = self->ring_write = 0;
+    self->ring_pts = self->ring_dts = GST_CLOCK_TIME_NONE;
+  }
+
+  keep = self->ring_write - self->ring_read;
+
+  /**
+   * The outgoing buffers share the block (read-only).
+   * Reuse the block if downstream released all windows, or write a new block.
+   */
+  if (self->ring && GST_MINI_OBJECT_REFCOUNT_VALUE (self->ring) == 1) {
+    memmove (self->ring_map.data, self->ring_map.data +
+        self->ring_read * frame_size, keep * frame_size);
+  } else {
+    ring = gst_allocator_alloc (NULL, self->ring_frames * frame_size, NULL);
+    nns_profile_alloc (self, self->ring_frames * frame_size);
+    if (!ring || !gst_memory_map (ring, &map, GST_MAP_WRITE)) {
+      nns_loge ("Failed to allocate the ring block (%zu bytes) in tensor_converter.",
+          self->ring_frames * frame_size);
+      if (ring)
+        gst_memory_unref (ring);
+      return FALSE;
+    }
+
+    if (self->ring) {
+      nns_profile_memcpy (self, map.data,
+          self->ring_map.data + self->ring_read * frame_size, keep * frame_size);
+      gst_memory_unmap (self->ring, &self->ring_map);
+      gst_memory_unref (self->ring);
+    }
+
+    /* keep the block mapped, the shared memory does not allow writing */
+    self->ring = ring;
+    self->ring_map = map;
+  }
+
+  /* the timestamps of the first frame in the block */
+  if (config->rate_n > 0 && config->rate_d > 0 && self->ring_read > 0) {
+    GstClockTime diff = gst_util_uint64_scale (self->ring_read,
+        (guint64) config->rate_d * GST_SECOND, config->rate_n);
+
+    if (GST_CLOCK_TIME_IS_VALID (self->ring_pts))
+      self->ring_pts += diff;
+    if (GST_CLOCK_TIME_IS_VALID (self->ring_dts))
+      self->ring_dts += diff;
+  }
+
+  self->ring_read = 0;
+  self->ring_write = keep;
+  return TRUE;
+}
+
+/**
+ * @brief Chain function's private routine to push the overlapped windows.
+ * The incoming frames are written once into the ring block, and the outgoing buffers are the views of the block.
+ */
+static GstFlowReturn
+_gst_tensor_converter_chain_ring (GstTensorConverter * self,
+    GstBuffer * inbuf, guint frames_in, guint frames_out, gsize frame_size)
+{
+  GstTensorsConfig *config;
+  GstFlowReturn ret = GST_FLOW_OK;
+  GstClockTime pts, dts, duration, diff;
+  GstMapInfo in_map;
+  gsize copied = 0, len;
+  gboolean have_framerate;
+
+  config = &self->tensors_config;
+  have_framerate = (config->rate_n > 0 && config->rate_d > 0);
+
+  duration = GST_BUFFER_DURATION (inbuf);
+  if (GST_CLOCK_TIME_IS_VALID (duration)) {
+    /** supposed same duration for incoming buffer */
+    duration = gst_util_uint64_scale_int (duration, frames_out, frames_in);
+  }
+
+  if (!gst_buffer_map (inbuf, &in_map, GST_MAP_READ)) {
+    ml_loge ("Cannot map the incoming buffer at tensor_converter.\n");
+    gst_buffer_unref (inbuf);
+    return GST_FLOW_ERROR;
+  }
+
+  frames_in = in_map.size / frame_size;
+
+  while (copied < frames_in && ret == GST_FLOW_OK) {
+    if (!gst_tensor_converter_ring_prepare (self, frames_out, frame_size)) {
+      ret = GST_FLOW_ERROR;
+      break;
+    }
+
+    len = MIN (frames_in - copied, self->ring_frames - self->ring_write);
+    nns_profile_memcpy (self, self->ring_map.data + self->ring_write * frame_size,
+        in_map.data + copied * frame_size, len * frame_size);
+
+    /* the timestamps of the first frame in the block, from the incoming buffer */
+    pts = GST_BUFFER_PTS (inbuf);
+    dts = GST_BUFFER_DTS (inbuf);
+    if (have_framerate) {
+      GstClockTime offset;
+
+      offset = gst_util_uint64_scale (copied, (guint64) config->rate_d *
+          GST_SECOND, config->rate_n);
+      diff = gst_util_uint64_scale (self->ring_write, (guint64) config->rate_d *
+          GST_SECOND, config->rate_n);
+
+      if (GST_CLOCK_TIME_IS_VALID (pts))
+        self->ring_pts = (pts + offset > diff) ? pts + offset - diff : 0;
+      if (GST_CLOCK_TIME_IS_VALID (dts))
+        self->ring_dts = (dts + offset > diff) ? dts + offset - diff : 0;
+    }
+
+    self->ring_write += len;
+    copied += len;
+
+    while (self->ring_write - self->ring_read >= frames_out &&
+        ret == GST_FLOW_OK) {
+      GstBuffer *outbuf;
+
+      outbuf = gst_buffer_new ();
+      gst_buffer_append_memory (outbuf, gst_memory_share (self->ring,
+              self->ring_read * frame_size, frames_out * frame_size));
+
+      /** set timestamp */
+      if (have_framerate) {
+        diff = gst_util_uint64_scale (self->ring_read,
+            (guint64) config->rate_d * GST_SECOND, config->rate_n);
+
+        GST_BUFFER_PTS (outbuf) = GST_CLOCK_TIME_IS_VALID (self->ring_pts) ?
+            self->ring_pts + diff : GST_CLOCK_TIME_NONE;
+        GST_BUFFER_DTS (outbuf) = GST_CLOCK_TIME_IS_VALID (self->ring_dts) ?
+            self->ring_dts + diff : GST_CLOCK_TIME_NONE;
+      } else {
+        GST_BUFFER_PTS (outbuf) = pts;
+        GST_BUFFER_DTS (outbuf) = dts;
+      }
+      GST_BUFFER_DURATION (outbuf) = duration;
+
+      self->ring_read += self->frames_hop;
+      ret = _gst_tensor_converter_chain_push (self, outbuf);
+    }
+  }
+
+  gst_buffer_unmap (inbuf, &in_map);
+  gst_buffer_unref (inbuf);
+  return ret;
+}
+
+/**
+ * @brief Get the offsets and strides of the planes in the incoming video frame. (internal static function)
+ * @return TRUE if all planes are in the buffer
+ */
+static gboolean
+_gst_tensor_converter_video_layout (GstTensorConverter * self,
+    GstBuffer * buf, gsize size, gsize offset[], gsize stride[])
+{
+  tensor_converter_plane_s *plane;
+  guint i;
+#ifndef NO_VIDEO
+  GstVideoMeta *vmeta;
+#endif
+
+  for (i = 0; i < self->num_planes; i++) {
+    offset[i] = self->planes[i].offset;
+    stride[i] = self->planes[i].stride;
+  }
+
+#ifndef NO_VIDEO
+  /* the frame layout is given by upstream (e.g., from the video pool) */
+  vmeta = gst_buffer_get_video_meta (buf);
+  if (vmeta) {
+    if (vmeta->n_planes < self->num_planes) {
+      GST_ERROR_OBJECT (self,
+          "The video meta of the incoming buffer has %u planes, %u planes are expected.",
+          vmeta->n_planes, self->num_planes);
+      return FALSE;
+    }
+
+    for (i = 0; i < self->num_planes; i++) {
+      offset[i] = vmeta->offset[i];
+      stride[i] = (gsize) MAX (vmeta->stride[i], 0);
+    }
+  }
+#else
+  UNUSED (buf);
+#endif
+
+  for (i = 0; i < self->num_planes; i++) {
+    plane = &self->planes[i];
+
+    if (stride[i] < plane->row_size || size < offset[i] +
+        stride[i] * (plane->rows - 1) + plane->row_size) {
+      GST_ERROR_OBJECT (self,
+          "The plane %u of the incoming buffer (offset %zu, stride %zu, buffer size %zu) does not match the video frame (%zu bytes x %u rows).",
+          i, offset[i], stride[i], size, plane->row_size, plane->rows);
+      return FALSE;
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Push the planes of the video frame as the tensors, the plane without the row padding is not copied. (internal static function)
+ * @return the converted buffer, NULL if failed
+ */
+static GstBuffer *
+_gst_tensor_converter_chain_planes (GstTensorConverter * self, GstBuffer * buf)
+{
+  gsize offset[TENSOR_CONVERTER_MAX_PLANES], stride[TENSOR_CONVERTER_MAX_PLANES];
+  tensor_converter_plane_s *plane;
+  GstBuffer *outbuf, *sub;
+  GstMemory *mem;
+  GstMapInfo in_map, out_map;
+  gboolean mapped = FALSE;
+  gsize size;
+  guint i, r;
+
+  if (!_gst_tensor_converter_video_layout (self, buf, gst_buffer_get_size (buf),
+          offset, stride))
+    return NULL;
+
+  outbuf = gst_buffer_new ();
+
+  for (i = 0; i < self->num_planes; i++) {
+    plane = &self->planes[i];
+    size = plane->row_size * plane->rows;
+
+    if (stride[i] == plane->row_size || plane->rows == 1) {
+      /* share the memory of the plane */
+      sub = gst_buffer_copy_region (buf, GST_BUFFER_COPY_MEMORY, offset[i],
+          size);
+      mem = sub ? gst_buffer_get_all_memory (sub) : NULL;
+      if (sub)
+        gst_buffer_unref (sub);
+    } else {
+      if (!mapped) {
+        if (!gst_buffer_map (buf, &in_map, GST_MAP_READ)) {
+          GST_ERROR_OBJECT (self, "Failed to map the incoming buffer.");
+          goto error;
+        }
+        mapped = TRUE;
+      }
+
+      mem = gst_allocator_alloc (NULL, size, NULL);
+      nns_profile_alloc (self, size);
+      if (mem && !gst_memory_map (mem, &out_map, GST_MAP_WRITE)) {
+        gst_memory_unref (mem);
+        mem = NULL;
+      }
+
+      if (mem) {
+        /* remove the row padding */
+        for (r = 0; r < plane->rows; r++)
+          memcpy (out_map.data + plane->row_size * r,
+              in_map.data + offset[i] + stride[i] * r, plane->row_size);
+        nns_profile_copied (self, (gsize) plane->row_size * plane->rows);
+        gst_memory_unmap (mem, &out_map);
+      }
+    }
+
+    if (!mem) {
+      GST_ERROR_OBJECT (self, "Failed to get the plane %u of the video frame.",
+          i);
+      goto error;
+    }
+
+    gst_buffer_append_memory (outbuf, mem);
+  }
+
+  if (mapped)
+    gst_buffer_unmap (buf, &in_map);
+
+  gst_buffer_copy_into (outbuf, buf, GST_BUFFER_COPY_METADATA, 0, -1);
+  return outbuf;
+
+error:
+  if (mapped)
+    gst_buffer_unmap (buf, &in_map);
+  gst_buffer_unref (outbuf);
+  return NULL;
+}
+
+/**
+ * @brief Convert the video frame to a tensor with the fused preprocessing. (internal static function)
+ * @return the converted buffer, NULL if failed
+ */
+static GstBuffer *
+_gst_tensor_converter_chain_preprocess (GstTensorConverter * self,
+    GstBuffer * buf)
+{
+  tensor_converter_preprocess_s *pre = &self->preprocess;
+  GstBuffer *outbuf;
+  GstMapInfo in_map, out_map;
+  gsize offset[TENSOR_CONVERTER_MAX_PLANES], stride[TENSOR_CONVERTER_MAX_PLANES];
+  const guint8 *planes[TENSOR_CONVERTER_MAX_PLANES];
+  gsize out_size;
+  guint i;
+  nns_profile_declare (start);
+
+  if (!gst_buffer_map (buf, &in_map, GST_MAP_READ)) {
+    GST_ERROR_OBJECT (self, "Failed to map the incoming buffer.");
+    return NULL;
+  }
+
+  if (!_gst_tensor_converter_video_layout (self, buf, in_map.size, offset,
+          stride)) {
+    gst_buffer_unmap (buf, &in_map);
+    return NULL;
+  }
+
+  for (i = 0; i < self->num_planes; i++)
+    planes[i] = in_map.data + offset[i];
+
+  out_size = (gsize) pre->out_width * pre->out_height * pre->out_channels *
+      gst_tensor_get_element_size (pre->type);
+  outbuf = gst_buffer_new_and_alloc (out_size);
+  nns_profile_alloc (self, out_size);
+
+  if (!gst_buffer_map (outbuf, &out_map, GST_MAP_WRITE)) {
+    GST_ERROR_OBJECT (self, "Failed to map the output buffer.");
+    gst_buffer_unmap (buf, &in_map);
+    gst_buffer_unref (outbuf);
+    return NULL;
+  }
+
+  nns_profile_compute_begin (start);
+  gst_tensor_converter_preprocess_run (pre, planes, stride, out_map.data);
+  nns_profile_compute_end (self, start);
+
+  gst_buffer_unmap (outbuf, &out_map);
+  gst_buffer_unmap (buf, &in_map);
+
+  gst_buffer_copy_into (outbuf, buf, GST_BUFFER_COPY_METADATA, 0, -1);
+  return outbuf;
+}
+
 /**
  * @brief Chain function, this function does the actual processing.
  */
@@ -1046,7 +1706,29 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
     case _NNS_VIDEO:
     {
       guint color, width, height;
-      gsize type;
+      gsize type, row_size, row_stride, row_offset;
+      gboolean has_layout = FALSE;
+#ifndef NO_VIDEO
+      GstVideoMeta *vmeta;
+#endif
+
+      if (self->mode == _CONVERTER_MODE_PREPROCESS) {
+        inbuf = _gst_tensor_converter_chain_preprocess (self, buf);
+        if (inbuf == NULL)
+          goto error;
+
+        frame_size = gst_buffer_get_size (inbuf);
+        break;
+      }
+
+      if (self->num_planes > 1) {
+        inbuf = _gst_tensor_converter_chain_planes (self, buf);
+        if (inbuf == NULL)
+          goto error;
+
+        frame_size = gst_buffer_get_size (inbuf);
+        break;
+      }
 
       color = config->info.info[0].dimension[0];
       width = config->info.info[0].dimension[1];
@@ -1056,14 +1738,51 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
       /** type * colorspace * width * height */
       frame_size = type * color * width * height;
 
-      /** supposed 1 frame in buffer */
-      g_assert ((buf_size / self->frame_size) == 1);
+      /* size of a row without the padding, and the stride in the incoming buffer */
+      row_size = type * color * width;
+      row_stride = row_size;
+      row_offset = 0;
+
+#ifndef NO_VIDEO
+      /* the frame layout is given by upstream (e.g., from the video pool) */
+      vmeta = gst_buffer_get_video_meta (buf);
+      if (vmeta) {
+        row_stride = (gsize) vmeta->stride[0];
+        row_offset = vmeta->offset[0];
+        has_layout = TRUE;
+      }
+#endif
 
-      if (self->remove_padding) {
+      if (has_layout) {
+        if (row_stride < row_size ||
+            buf_size < row_offset + row_stride * (height - 1) + row_size) {
+          GST_ERROR_OBJECT (self,
+              "The video meta of the incoming buffer (offset %zu, stride %zu, buffer size %zu) does not match the video frame (%u x %u).",
+              row_offset, row_stride, buf_size, width, height);
+          goto error;
+        }
+      } else {
+        /** supposed 1 frame in buffer */
+        g_assert ((buf_size / self->frame_size) == 1);
+
+        if (self->remove_padding) {
+          /**
+           * Refer: https://gstreamer.freedesktop.org/documentation/design/mediatype-video-raw.html
+           */
+          g_assert (row_size % 4); /** Internal logic error! */
+          row_stride = row_size + 4 - (row_size % 4);
+        }
+      }
+
+      if (row_stride == row_size && row_offset == 0) {
+        /* packed frame, push the incoming memory without copying */
+        if (buf_size != frame_size)
+          inbuf = gst_buffer_copy_region (buf,
+              GST_BUFFER_COPY_METADATA | GST_BUFFER_COPY_MEMORY, 0, frame_size);
+      } else {
         GstMapInfo src_info, dest_info;
-        guint d0, d1;
-        unsigned int src_idx = 0, dest_idx = 0;
-        size_t size, offset;
+        guint d1;
+        gsize src_idx = row_offset, dest_idx = 0;
 
         if (!gst_buffer_map (buf, &src_info, GST_MAP_READ)) {
           ml_logf
@@ -1072,7 +1791,7 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
         }
 
         inbuf = gst_buffer_new_and_alloc (frame_size);
-        gst_buffer_memset (inbuf, 0, 0, frame_size);
+        nns_profile_alloc (self, frame_size);
         if (!gst_buffer_map (inbuf, &dest_info, GST_MAP_WRITE)) {
           ml_logf
               ("tensor_converter: Cannot map dest buffer at tensor_converter/video. The outgoing buffer (GstBuffer) for the srcpad of tensor_converter cannot be mapped for writing.\n");
@@ -1081,23 +1800,12 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
           goto error;
         }
 
-        /**
-         * Refer: https://gstreamer.freedesktop.org/documentation/design/mediatype-video-raw.html
-         */
-        size = offset = type * color * width;
-
-        g_assert (offset % 4); /** Internal logic error! */
-        if (offset % 4) {
-          offset += 4 - (offset % 4);
-        }
-
-        for (d0 = 0; d0 < frames_in; d0++) {
-          for (d1 = 0; d1 < height; d1++) {
-            memcpy (dest_info.data + dest_idx, src_info.data + src_idx, size);
-            dest_idx += size;
-            src_idx += offset;
-          }
+        for (d1 = 0; d1 < height; d1++) {
+          memcpy (dest_info.data + dest_idx, src_info.data + src_idx, row_size);
+          dest_idx += row_size;
+          src_idx += row_stride;
         }
+        nns_profile_copied (self, dest_idx);
 
         gst_buffer_unmap (buf, &src_info);
         gst_buffer_unmap (inbuf, &dest_info);
@@ -1123,6 +1831,7 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
         }
 
         inbuf = gst_buffer_new_and_alloc (frame_size);
+        nns_profile_alloc (self, frame_size);
         gst_buffer_memset (inbuf, 0, 0, frame_size);
         if (!gst_buffer_map (inbuf, &dest_info, GST_MAP_WRITE)) {
           ml_logf
@@ -1132,7 +1841,7 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
           goto error;
         }
 
-        memcpy (dest_info.data, src_info.data, block_size);
+        nns_profile_memcpy (self, dest_info.data, src_info.data, block_size);
 
         gst_buffer_unmap (buf, &src_info);
         gst_buffer_unmap (inbuf, &dest_info);
@@ -1157,7 +1866,7 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
       GstTensorMetaInfo meta;
       GstTensorsConfig tmp;
       GstMemory *mem;
-      gsize s1, s2, hsize;
+      gsize s1, s2;
       guint n;
 
       gst_tensors_config_init (&tmp);
@@ -1175,15 +1884,20 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
       inbuf = gst_buffer_new ();
 
       for (n = 0; n < tmp.info.num_tensors; n++) {
-        mem = gst_buffer_peek_memory (buf, n);
-        s1 = gst_memory_get_sizes (mem, NULL, NULL);
-
-        /* flex-tensor has header in each mem block */
-        gst_tensor_meta_info_parse_memory (&meta, mem);
-        gst_tensor_meta_info_convert (&meta, &tmp.info.info[n]);
-        hsize = gst_tensor_meta_info_get_header_size (&meta);
-        s1 -= hsize;
+        /* flex-tensor has header in each mem block, share the data without header */
+        mem = gst_tensor_meta_cache_share_payload (&self->meta_cache[n],
+            gst_buffer_peek_memory (buf, n), &meta);
+        if (!mem || !gst_tensor_meta_info_convert (&meta, &tmp.info.info[n])) {
+          nns_loge
+              ("Cannot process an incoming buffer frame for tensor_converter (chain function). It appears that it is trying to convert other/tensors,format=flexible to other/tensors,format=static. Incoming buffer has invalid header (%u/%u).",
+              (n + 1), tmp.info.num_tensors);
+          if (mem)
+            gst_memory_unref (mem);
+          gst_buffer_unref (inbuf);
+          goto error;
+        }
 
+        s1 = gst_memory_get_sizes (mem, NULL, NULL);
         s2 = gst_tensor_info_get_size (&tmp.info.info[n]);
 
         /**
@@ -1194,11 +1908,12 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
           nns_loge
               ("Cannot process an incoming buffer frame for tensor_converter (chain function). It appears that it is trying to convert other/tensors,format=flexible to other/tensors,format=static. Incoming buffer has invalid data size %zd, expected size is %zd (%u/%u).",
               s1, s2, (n + 1), tmp.info.num_tensors);
+          gst_memory_unref (mem);
           gst_buffer_unref (inbuf);
           goto error;
         }
 
-        gst_buffer_append_memory (inbuf, gst_memory_share (mem, hsize, s1));
+        gst_buffer_append_memory (inbuf, mem);
       }
 
       gst_buffer_copy_into (inbuf, buf, GST_BUFFER_COPY_METADATA, 0, -1);
@@ -1263,6 +1978,26 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
       frames_in = 1;
       frame_size = gst_buffer_get_size (inbuf);
 
+      if (frame_size == 0) {
+        /* the subplugin keeps the data until the frames of a tensor are given */
+        gst_tensors_config_free (&new_config);
+        gst_buffer_unref (inbuf);
+        if (inbuf != buf)
+          gst_buffer_unref (buf);
+        return GST_FLOW_OK;
+      }
+
+      if (new_config.info.format == _NNS_TENSOR_FORMAT_STATIC) {
+        gsize tensors_size = gst_tensors_info_get_size (&new_config.info, -1);
+
+        /* the subplugin may return the frames of the static tensors at once */
+        if (tensors_size > 0 && frame_size > tensors_size &&
+            frame_size % tensors_size == 0) {
+          frames_in = frame_size / tensors_size;
+          frame_size = tensors_size;
+        }
+      }
+
       if (!gst_tensors_config_is_equal (config, &new_config)) {
         gst_tensors_config_free (config);
         *config = new_config;
@@ -1301,6 +2036,11 @@ gst_tensor_converter_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
     return _gst_tensor_converter_chain_push (self, inbuf);
   }
 
+  /* push the overlapped windows */
+  if (self->frames_hop > 0 && self->frames_hop < frames_out)
+    return _gst_tensor_converter_chain_ring (self, inbuf, frames_in,
+        frames_out, frame_size);
+
   /* push multiple buffers */
   return _gst_tensor_converter_chain_chunk (self, inbuf, frames_in,
       frames_out, frame_size);
@@ -1352,6 +2092,7 @@ gst_tensor_converter_reset (GstTensorConverter * self)
 {
   /* remove all buffers from adapter */
   gst_tensor_aggregation_clear_all (self->adapter_table);
+  gst_tensor_converter_ring_free (self);
 
   self->have_segment = FALSE;
   self->need_segment = FALSE;
@@ -1398,7 +2139,6 @@ gst_tensor_converter_video_stride (GstVideoFormat format, gint width)
     case GST_VIDEO_FORMAT_GRAY8:
     case GST_VIDEO_FORMAT_RGB:
     case GST_VIDEO_FORMAT_BGR:
-    case GST_VIDEO_FORMAT_I420:
       if (width % 4) {
         return TRUE;
       }
@@ -1481,9 +2221,16 @@ gst_tensor_converter_parse_video (GstTensorConverter * self,
       config->info.info[0].type = _NNS_UINT8;
       config->info.info[0].dimension[0] = 4;
       break;
+    case GST_VIDEO_FORMAT_NV12:
+    case GST_VIDEO_FORMAT_NV21:
+    case GST_VIDEO_FORMAT_I420:
+      /* the first tensor is the luma plane, the chroma planes follow */
+      config->info.info[0].type = _NNS_UINT8;
+      config->info.info[0].dimension[0] = 1;
+      break;
     default:
       GST_WARNING_OBJECT (self,
-          "The given video caps with format \"%s\" is not supported. Please use GRAY8, RGB, BGR, RGBx, BGRx, xRGB, xBGR, RGBA, BGRA, ARGB, or ABGR.\n",
+          "The given video caps with format \"%s\" is not supported. Please use GRAY8, RGB, BGR, RGBx, BGRx, xRGB, xBGR, RGBA, BGRA, ARGB, ABGR, NV12, NV21, or I420.\n",
           GST_STR_NULL (gst_video_format_to_string (format)));
       break;
   }
@@ -1498,6 +2245,67 @@ gst_tensor_converter_parse_video (GstTensorConverter * self,
 
   config->rate_n = GST_VIDEO_INFO_FPS_N (&vinfo);
   config->rate_d = GST_VIDEO_INFO_FPS_D (&vinfo);
+  self->frame_size = GST_VIDEO_INFO_SIZE (&vinfo);
+
+  /* the layout of the planes, the size of a row is given with the first component in the plane */
+  self->num_planes = MIN (GST_VIDEO_INFO_N_PLANES (&vinfo),
+      TENSOR_CONVERTER_MAX_PLANES);
+  for (i = 0; i < self->num_planes; i++) {
+    self->planes[i].offset = GST_VIDEO_INFO_PLANE_OFFSET (&vinfo, i);
+    self->planes[i].stride = GST_VIDEO_INFO_PLANE_STRIDE (&vinfo, i);
+    self->planes[i].row_size = (gsize) GST_VIDEO_INFO_COMP_PSTRIDE (&vinfo, i) *
+        GST_VIDEO_INFO_COMP_WIDTH (&vinfo, i);
+    self->planes[i].rows = GST_VIDEO_INFO_COMP_HEIGHT (&vinfo, i);
+  }
+
+  if (self->mode == _CONVERTER_MODE_PREPROCESS) {
+    /* the frame is converted row by row, the row padding is handled with the strides. */
+#ifndef NO_VIDEO
+    self->preprocess.yuv_bt709 =
+        (vinfo.colorimetry.matrix == GST_VIDEO_COLOR_MATRIX_BT709);
+    self->preprocess.yuv_full_range =
+        (vinfo.colorimetry.range == GST_VIDEO_COLOR_RANGE_0_255);
+#endif
+
+    if (config->info.info[0].type == _NNS_END ||
+        !gst_tensor_converter_preprocess_configure (&self->preprocess,
+            gst_video_format_to_string (format), width, height,
+            &config->info.info[0])) {
+      GST_ERROR_OBJECT (self,
+          "Failed to configure the preprocess mode (%s) for the video format \"%s\" (%d x %d).",
+          self->mode_option, GST_STR_NULL (gst_video_format_to_string (format)),
+          width, height);
+      return FALSE;
+    }
+
+    return TRUE;
+  }
+
+  if (self->num_planes > 1) {
+    /* Y:UV (NV12 and NV21) or Y:U:V (I420), a tensor for each plane */
+    if (self->frames_per_tensor > 1) {
+      GST_ERROR_OBJECT (self,
+          "The frames-per-tensor (%u) is not supported for the multi-plane video format \"%s\", the planes are the tensors of a frame.",
+          self->frames_per_tensor,
+          GST_STR_NULL (gst_video_format_to_string (format)));
+      return FALSE;
+    }
+
+    config->info.num_tensors = self->num_planes;
+    for (i = 1; i < self->num_planes; i++) {
+      GstTensorInfo *_info = &config->info.info[i];
+      guint d;
+
+      _info->type = _NNS_UINT8;
+      _info->dimension[0] = GST_VIDEO_INFO_COMP_PSTRIDE (&vinfo, i);
+      _info->dimension[1] = GST_VIDEO_INFO_COMP_WIDTH (&vinfo, i);
+      _info->dimension[2] = GST_VIDEO_INFO_COMP_HEIGHT (&vinfo, i);
+      for (d = 3; d < NNS_TENSOR_RANK_LIMIT; d++)
+        _info->dimension[d] = 1;
+    }
+
+    return (config->info.info[0].type != _NNS_END);
+  }
 
   /**
    * Emit Warning if RSTRIDE = RU4 (3BPP) && Width % 4 > 0
@@ -1510,11 +2318,11 @@ gst_tensor_converter_parse_video (GstTensorConverter * self,
     /** @todo need rewrite. */
     GST_WARNING_OBJECT (self,
         "\nYOUR STREAM CONFIGURATION INCURS PERFORMANCE DETERIORATION!\n"
-        "Please use 4 x n as image width for inputs; the width of your input is %d.\n",
-        width);
+        "Please use 4 x n as image width for inputs; the width of your input is %d.\n"
+        "Or set the property video-pool to receive the frames without the row padding "
+        "if upstream supports GstVideoMeta.\n", width);
   }
 
-  self->frame_size = GST_VIDEO_INFO_SIZE (&vinfo);
   return (config->info.info[0].type != _NNS_END);
 }
 
@@ -1918,6 +2726,10 @@ gst_tensor_converter_get_possible_media_caps (GstTensorConverter * self)
   GstCaps *media_caps = NULL;
   GstTensorsConfig config;
 
+  /* the frame size is not related with the tensor shape in preprocess mode */
+  if (self->mode == _CONVERTER_MODE_PREPROCESS)
+    return NULL;
+
   /* get possible caps from downstream element */
   if (gst_tensors_config_from_peer (self->srcpad, &config, NULL)) {
     GstStructure *st;
@@ -1945,8 +2757,17 @@ gst_tensor_converter_get_possible_media_caps (GstTensorConverter * self)
             colorspace = config.info.info[0].dimension[0];
             switch (colorspace) {
               case 1:
-                gst_tensor_converter_get_format_list (&supported_formats,
-                    "GRAY8", NULL);
+                /* the luma plane followed by the chroma planes */
+                if (config.info.num_tensors == 2 &&
+                    config.info.info[1].dimension[0] == 2)
+                  gst_tensor_converter_get_format_list (&supported_formats,
+                      "NV12", "NV21", NULL);
+                else if (config.info.num_tensors == 3)
+                  gst_tensor_converter_get_format_list (&supported_formats,
+                      "I420", NULL);
+                else
+                  gst_tensor_converter_get_format_list (&supported_formats,
+                      "GRAY8", NULL);
                 break;
               case 3:
                 gst_tensor_converter_get_format_list (&supported_formats,
@@ -2111,7 +2932,14 @@ gst_tensor_converter_parse_caps (GstTensorConverter * self,
   g_return_val_if_fail (gst_caps_is_fixed (caps), FALSE);
 
   structure = gst_caps_get_structure (caps, 0);
-  if (self->mode != _CONVERTER_MODE_NONE) {
+  if (self->mode == _CONVERTER_MODE_PREPROCESS) {
+    in_type = gst_structure_get_media_type (structure);
+    if (in_type != _NNS_VIDEO) {
+      GST_ERROR_OBJECT (self,
+          "The preprocess mode of tensor_converter supports video streams only.");
+      return FALSE;
+    }
+  } else if (self->mode != _CONVERTER_MODE_NONE) {
     in_type = _NNS_MEDIA_ANY;
   } else {
     in_type = gst_structure_get_media_type (structure);
@@ -38,6 +38,7 @@
 #include <tensor_common.h>
 #include "nnstreamer_plugin_api_converter.h"
 #include "tensor_converter_custom.h"
+#include "gsttensor_converter_preprocess.h"
 
 G_BEGIN_DECLS
 
@@ -60,6 +61,22 @@ typedef struct
   void * data;
 } converter_custom_cb_s;
 
+/**
+ * @brief The max number of the planes in the incoming video frame (Y, U and V).
+ */
+#define TENSOR_CONVERTER_MAX_PLANES (3)
+
+/**
+ * @brief The layout of a plane in the incoming video frame.
+ */
+typedef struct
+{
+  gsize offset; /**< offset of the plane in the frame */
+  gsize stride; /**< size of a row including the padding */
+  gsize row_size; /**< size of a row without the padding */
+  guint rows; /**< number of the rows */
+} tensor_converter_plane_s;
+
 /**
  * @brief tensor converter mode
  */
@@ -67,6 +84,7 @@ typedef enum {
   _CONVERTER_MODE_NONE = 0,	/**< Normal mode (default) */
   _CONVERTER_MODE_CUSTOM_CODE = 1,	/**<  Custom mode (callback type) */
   _CONVERTER_MODE_CUSTOM_SCRIPT = 2,	/**<  Custom mode (script type) */
+  _CONVERTER_MODE_PREPROCESS = 3,	/**<  Fused preprocessing of video frames (color, resize and normalize) */
 } tensor_converter_mode;
 
 /**
@@ -82,6 +100,16 @@ struct _GstTensorConverter
   gboolean silent; /**< true to print minimized log */
   gboolean set_timestamp; /**< true to set timestamp when received a buffer with invalid timestamp */
   guint frames_per_tensor; /**< number of frames in output tensor */
+  guint frames_hop; /**< number of frames to advance the window in output tensor (sliding window if smaller than frames_per_tensor) */
+
+  GstMemory *ring; /**< preallocated block to accumulate the frames of the overlapped windows */
+  GstMapInfo ring_map; /**< mapped ring block, kept while writing the frames */
+  gsize ring_frames; /**< capacity (frames) of the ring block */
+  gsize ring_frame_size; /**< size of a frame in the ring block */
+  gsize ring_read; /**< index of the first frame of the next window */
+  gsize ring_write; /**< index to write the next incoming frame */
+  GstClockTime ring_pts; /**< pts of the first frame in the ring block */
+  GstClockTime ring_dts; /**< dts of the first frame in the ring block */
   GstTensorsInfo tensors_info; /**< data structure to get/set tensor info */
 
   GHashTable *adapter_table; /**< adapt incoming media stream */
@@ -92,6 +120,7 @@ struct _GstTensorConverter
 
   gsize frame_size; /**< size of one frame */
   gboolean remove_padding; /**< If true, zero-padding must be removed */
+  gboolean video_pool; /**< If true, propose the buffer pool of the video frames without the row padding */
   gboolean tensors_configured; /**< True if already successfully configured tensors metadata */
   GstTensorsConfig tensors_config; /**< output tensors info */
 
@@ -104,7 +133,11 @@ struct _GstTensorConverter
   gchar *mode_option; /**< tensor converter mode option */
   gchar *ext_fw; /**< tensor converter custom mode framework */
   converter_custom_cb_s custom;
+  tensor_converter_preprocess_s preprocess; /**< preprocessing of video frames (mode=preprocess:<option>) */
+  guint num_planes; /**< number of the planes in the incoming video frame */
+  tensor_converter_plane_s planes[TENSOR_CONVERTER_MAX_PLANES]; /**< layout of the planes from the video info (GstVideoMeta of the buffer overrides the offsets and strides) */
   gboolean do_not_append_header;
+  GstTensorMetaCache meta_cache[NNS_TENSOR_SIZE_LIMIT]; /**< the cached layout of incoming flexible tensors */
 
   void *priv_data; /**< plugin's private data */
 };
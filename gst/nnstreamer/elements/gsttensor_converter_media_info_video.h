@@ -22,15 +22,33 @@
 
 #include <gst/video/video-info.h>
 
+/**
+ * @brief Supported video formats, the planes of NV12, NV21 and I420 are converted to the tensors of each plane
+ */
+#define VIDEO_FORMATS_STR \
+    "{ RGB, BGR, RGBx, BGRx, xRGB, xBGR, RGBA, BGRA, ARGB, ABGR, GRAY8, NV12, NV21, I420 }"
+
 /**
  * @brief Caps string for supported video format
  */
 #define VIDEO_CAPS_STR \
-    GST_VIDEO_CAPS_MAKE ("{ RGB, BGR, RGBx, BGRx, xRGB, xBGR, RGBA, BGRA, ARGB, ABGR, GRAY8 }") \
+    GST_VIDEO_CAPS_MAKE (VIDEO_FORMATS_STR) \
+    ", interlace-mode = (string) progressive"
+
+/**
+ * @brief Caps feature of the video frames in DMA-BUF (same as GST_CAPS_FEATURE_MEMORY_DMABUF)
+ */
+#define VIDEO_CAPS_FEATURE_DMABUF "memory:DMABuf"
+
+/**
+ * @brief Caps string for the video frames in DMA-BUF, the packed frame is pushed as the tensor without mapping it
+ */
+#define VIDEO_DMABUF_CAPS_STR \
+    GST_VIDEO_CAPS_MAKE_WITH_FEATURES (VIDEO_CAPS_FEATURE_DMABUF, VIDEO_FORMATS_STR) \
     ", interlace-mode = (string) progressive"
 
 #define append_video_caps_template(caps) \
-    gst_caps_append (caps, gst_caps_from_string (VIDEO_CAPS_STR))
+    gst_caps_append (caps, gst_caps_from_string (VIDEO_CAPS_STR "; " VIDEO_DMABUF_CAPS_STR))
 
 #define is_video_supported(...) TRUE
 #endif /* __GST_TENSOR_CONVERTER_MEDIA_INFO_VIDEO_H__ */
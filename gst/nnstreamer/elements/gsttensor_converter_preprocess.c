@@ -0,0 +1,553 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file    gsttensor_converter_preprocess.c
+ * @date    14 Oct 2026
+ * @brief   Fused preprocessing of video frames in tensor_converter (color, resize, normalize and layout)
+ * @see     http://github.com/nnstreamer/nnstreamer
+ * @author  agent <agent@local>
+ * @bug     No known bugs
+ *
+ * The frame is converted in a single pass, row by row:
+ * the source rows are interpolated vertically into a float row,
+ * then each output pixel is interpolated horizontally, normalized,
+ * and written in the output type and layout.
+ * The rows of 4:2:0 YUV frames are converted to RGB before the interpolation.
+ */
+
+#include <math.h>
+#include <string.h>
+#include <nnstreamer_log.h>
+#include <nnstreamer_plugin_api_util.h>
+#include <tensor_kernels.h>
+#include "gsttensor_converter_preprocess.h"
+
+/**
+ * @brief Initialize the preprocessing data.
+ */
+void
+gst_tensor_converter_preprocess_init (tensor_converter_preprocess_s * pre)
+{
+  guint i;
+
+  memset (pre, 0, sizeof (tensor_converter_preprocess_s));
+  pre->type = _NNS_UINT8;
+  pre->color = PREPROCESS_COLOR_KEEP;
+
+  for (i = 0; i < 4; i++) {
+    pre->mean[i] = 0.0;
+    pre->std[i] = 1.0;
+  }
+}
+
+/**
+ * @brief Free the lookup tables of the preprocessing.
+ */
+static void
+gst_tensor_converter_preprocess_free_tables (tensor_converter_preprocess_s * pre)
+{
+  g_free (pre->x0);
+  g_free (pre->x1);
+  g_free (pre->wx);
+  g_free (pre->y0);
+  g_free (pre->y1);
+  g_free (pre->wy);
+  g_free (pre->row);
+  g_free (pre->row1);
+
+  pre->x0 = pre->x1 = pre->y0 = pre->y1 = NULL;
+  pre->wx = pre->wy = pre->row = pre->row1 = NULL;
+}
+
+/**
+ * @brief Free the preprocessing data.
+ */
+void
+gst_tensor_converter_preprocess_free (tensor_converter_preprocess_s * pre)
+{
+  gst_tensor_converter_preprocess_free_tables (pre);
+}
+
+/**
+ * @brief Parse the values separated with '/' (one value for all channels or a value per channel).
+ */
+static guint
+gst_tensor_converter_preprocess_parse_values (const gchar * str,
+    gdouble * values)
+{
+  gchar **strv;
+  gchar *end;
+  guint i, num;
+
+  strv = g_strsplit (str, "/", -1);
+  num = g_strv_length (strv);
+
+  if (num == 0 || num > 4) {
+    num = 0;
+    goto done;
+  }
+
+  for (i = 0; i < num; i++) {
+    values[i] = g_ascii_strtod (strv[i], &end);
+    if (end == strv[i] || *end != '\0') {
+      num = 0;
+      break;
+    }
+  }
+
+done:
+  g_strfreev (strv);
+  return num;
+}
+
+/**
+ * @brief Parse the option of the preprocessing.
+ */
+gboolean
+gst_tensor_converter_preprocess_parse_option (tensor_converter_preprocess_s *
+    pre, const gchar * option)
+{
+  gchar **options, **kv;
+  gchar *end;
+  guint i, num;
+  gboolean ret = TRUE;
+  guint64 val;
+
+  gst_tensor_converter_preprocess_free (pre);
+  gst_tensor_converter_preprocess_init (pre);
+
+  if (!option || option[0] == '\0')
+    return TRUE;
+
+  options = g_strsplit (option, ",", -1);
+  num = g_strv_length (options);
+
+  for (i = 0; i < num && ret; i++) {
+    kv = g_strsplit (g_strstrip (options[i]), "=", 2);
+
+    if (g_strv_length (kv) != 2) {
+      nns_loge ("Invalid preprocess option '%s', use key=value.", options[i]);
+      ret = FALSE;
+    } else if (g_ascii_strcasecmp (kv[0], "width") == 0) {
+      val = g_ascii_strtoull (kv[1], &end, 10);
+      ret = (end != kv[1] && *end == '\0' && val > 0 && val <= G_MAXUINT16);
+      pre->width = (guint) val;
+    } else if (g_ascii_strcasecmp (kv[0], "height") == 0) {
+      val = g_ascii_strtoull (kv[1], &end, 10);
+      ret = (end != kv[1] && *end == '\0' && val > 0 && val <= G_MAXUINT16);
+      pre->height = (guint) val;
+    } else if (g_ascii_strcasecmp (kv[0], "type") == 0) {
+      pre->type = gst_tensor_get_type (kv[1]);
+      switch (pre->type) {
+        case _NNS_UINT8:
+        case _NNS_INT8:
+        case _NNS_FLOAT32:
+        case _NNS_FLOAT64:
+#ifdef FLOAT16_SUPPORT
+        case _NNS_FLOAT16:
+#endif
+          break;
+        default:
+          ret = FALSE;
+          break;
+      }
+    } else if (g_ascii_strcasecmp (kv[0], "color") == 0) {
+      if (g_ascii_strcasecmp (kv[1], "keep") == 0)
+        pre->color = PREPROCESS_COLOR_KEEP;
+      else if (g_ascii_strcasecmp (kv[1], "rgb") == 0)
+        pre->color = PREPROCESS_COLOR_RGB;
+      else if (g_ascii_strcasecmp (kv[1], "bgr") == 0)
+        pre->color = PREPROCESS_COLOR_BGR;
+      else if (g_ascii_strcasecmp (kv[1], "gray") == 0)
+        pre->color = PREPROCESS_COLOR_GRAY;
+      else
+        ret = FALSE;
+    } else if (g_ascii_strcasecmp (kv[0], "layout") == 0) {
+      if (g_ascii_strcasecmp (kv[1], "nhwc") == 0)
+        pre->channel_first = FALSE;
+      else if (g_ascii_strcasecmp (kv[1], "nchw") == 0)
+        pre->channel_first = TRUE;
+      else
+        ret = FALSE;
+    } else if (g_ascii_strcasecmp (kv[0], "mean") == 0) {
+      pre->num_mean =
+          gst_tensor_converter_preprocess_parse_values (kv[1], pre->mean);
+      ret = (pre->num_mean > 0);
+    } else if (g_ascii_strcasecmp (kv[0], "std") == 0) {
+      pre->num_std =
+          gst_tensor_converter_preprocess_parse_values (kv[1], pre->std);
+      ret = (pre->num_std > 0);
+    } else {
+      nns_loge ("Unknown preprocess option '%s'.", kv[0]);
+      ret = FALSE;
+    }
+
+    if (!ret)
+      nns_loge ("Failed to parse the preprocess option '%s'.", options[i]);
+
+    g_strfreev (kv);
+  }
+
+  g_strfreev (options);
+  return ret;
+}
+
+/**
+ * @brief Get the positions of red, green and blue in the pixel of the video format.
+ * @return bytes per pixel, 0 if the format is not supported
+ */
+static guint
+gst_tensor_converter_preprocess_get_rgb (const gchar * format, guint rgb[3])
+{
+  static const struct
+  {
+    const gchar *name;
+    guint bpp;
+    guint r, g, b;
+  } formats[] = {
+    {"GRAY8", 1, 0, 0, 0},
+    {"RGB", 3, 0, 1, 2},
+    {"BGR", 3, 2, 1, 0},
+    {"RGBx", 4, 0, 1, 2},
+    {"RGBA", 4, 0, 1, 2},
+    {"BGRx", 4, 2, 1, 0},
+    {"BGRA", 4, 2, 1, 0},
+    {"xRGB", 4, 1, 2, 3},
+    {"ARGB", 4, 1, 2, 3},
+    {"xBGR", 4, 3, 2, 1},
+    {"ABGR", 4, 3, 2, 1},
+  };
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (formats); i++) {
+    if (g_strcmp0 (format, formats[i].name) == 0) {
+      rgb[0] = formats[i].r;
+      rgb[1] = formats[i].g;
+      rgb[2] = formats[i].b;
+      return formats[i].bpp;
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Set the layout of the chroma samples if the video format is 4:2:0 YUV.
+ * @return TRUE if the format is NV12, NV21 or I420
+ */
+static gboolean
+gst_tensor_converter_preprocess_set_yuv (tensor_converter_preprocess_s * pre,
+    const gchar * format)
+{
+  static const struct
+  {
+    const gchar *name;
+    guint u_plane, v_plane;
+    gsize u_offset, v_offset;
+    gsize step;
+  } formats[] = {
+    {"NV12", 1, 1, 0, 1, 2},
+    {"NV21", 1, 1, 1, 0, 2},
+    {"I420", 1, 2, 0, 0, 1},
+  };
+  gdouble kr, kb, kg, ys, cs;
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (formats); i++) {
+    if (g_strcmp0 (format, formats[i].name) == 0)
+      break;
+  }
+
+  if (i == G_N_ELEMENTS (formats))
+    return FALSE;
+
+  pre->uv_plane[0] = formats[i].u_plane;
+  pre->uv_plane[1] = formats[i].v_plane;
+  pre->uv_offset[0] = formats[i].u_offset;
+  pre->uv_offset[1] = formats[i].v_offset;
+  pre->uv_step = formats[i].step;
+
+  /* the limited range is [16, 235] for luma and [16, 240] for chroma */
+  kr = pre->yuv_bt709 ? 0.2126 : 0.299;
+  kb = pre->yuv_bt709 ? 0.0722 : 0.114;
+  kg = 1.0 - kr - kb;
+  ys = pre->yuv_full_range ? 1.0 : 255.0 / 219.0;
+  cs = pre->yuv_full_range ? 1.0 : 255.0 / 224.0;
+
+  pre->yuv_coef[0] = (gfloat) ys;
+  pre->yuv_coef[1] = pre->yuv_full_range ? 0.0f : 16.0f;
+  pre->yuv_coef[2] = (gfloat) (2.0 * (1.0 - kr) * cs);
+  pre->yuv_coef[3] = (gfloat) (2.0 * (1.0 - kb) * kb / kg * cs);
+  pre->yuv_coef[4] = (gfloat) (2.0 * (1.0 - kr) * kr / kg * cs);
+  pre->yuv_coef[5] = (gfloat) (2.0 * (1.0 - kb) * cs);
+  return TRUE;
+}
+
+/**
+ * @brief Fill the lookup table of the bilinear interpolation (half-pixel centers).
+ */
+static void
+gst_tensor_converter_preprocess_fill_table (guint in_size, guint out_size,
+    guint * p0, guint * p1, gfloat * w)
+{
+  gdouble ratio = (gdouble) in_size / out_size;
+  gdouble pos;
+  guint i;
+
+  for (i = 0; i < out_size; i++) {
+    pos = (i + 0.5) * ratio - 0.5;
+    pos = CLAMP (pos, 0.0, (gdouble) (in_size - 1));
+
+    p0[i] = (guint) pos;
+    p1[i] = MIN (p0[i] + 1, in_size - 1);
+    w[i] = (gfloat) (pos - p0[i]);
+  }
+}
+
+/**
+ * @brief Configure the preprocessing for the incoming video frame.
+ */
+gboolean
+gst_tensor_converter_preprocess_configure (tensor_converter_preprocess_s *
+    pre, const gchar * format, guint width, guint height, GstTensorInfo * info)
+{
+  guint rgb[3];
+  guint i, c, bpp;
+
+  g_return_val_if_fail (pre != NULL && info != NULL, FALSE);
+
+  pre->yuv = gst_tensor_converter_preprocess_set_yuv (pre, format);
+  if (pre->yuv) {
+    /* the rows are converted to RGB */
+    bpp = 3;
+    rgb[0] = 0;
+    rgb[1] = 1;
+    rgb[2] = 2;
+  } else {
+    bpp = gst_tensor_converter_preprocess_get_rgb (format, rgb);
+  }
+
+  if (bpp == 0 || width == 0 || height == 0) {
+    nns_loge ("The video format %s is not supported in preprocess mode.",
+        GST_STR_NULL (format));
+    return FALSE;
+  }
+
+  pre->in_width = width;
+  pre->in_height = height;
+  pre->in_channels = bpp;
+  pre->out_width = pre->width ? pre->width : width;
+  pre->out_height = pre->height ? pre->height : height;
+  pre->num_terms = 1;
+
+  switch (pre->color) {
+    case PREPROCESS_COLOR_RGB:
+    case PREPROCESS_COLOR_BGR:
+      pre->out_channels = 3;
+      for (c = 0; c < 3; c++) {
+        i = (pre->color == PREPROCESS_COLOR_RGB) ? c : 2 - c;
+        pre->src[c][0] = (bpp == 1) ? 0 : rgb[i];
+        pre->weight[c][0] = 1.0f;
+      }
+      break;
+    case PREPROCESS_COLOR_GRAY:
+      pre->out_channels = 1;
+      if (bpp == 1) {
+        pre->src[0][0] = 0;
+        pre->weight[0][0] = 1.0f;
+      } else {
+        pre->num_terms = 3;
+        pre->src[0][0] = rgb[0];
+        pre->src[0][1] = rgb[1];
+        pre->src[0][2] = rgb[2];
+        pre->weight[0][0] = 0.299f;
+        pre->weight[0][1] = 0.587f;
+        pre->weight[0][2] = 0.114f;
+      }
+      break;
+    default:
+      pre->out_channels = bpp;
+      for (c = 0; c < bpp; c++) {
+        pre->src[c][0] = c;
+        pre->weight[c][0] = 1.0f;
+      }
+      break;
+  }
+
+  if ((pre->num_mean > 1 && pre->num_mean != pre->out_channels) ||
+      (pre->num_std > 1 && pre->num_std != pre->out_channels)) {
+    nns_loge ("The number of mean/std values should be 1 or same as the "
+        "output channels (%u).", pre->out_channels);
+    return FALSE;
+  }
+
+  for (c = 0; c < pre->out_channels; c++) {
+    gdouble mean = pre->mean[(pre->num_mean > 1) ? c : 0];
+    gdouble std = pre->std[(pre->num_std > 1) ? c : 0];
+
+    if (std == 0.0) {
+      nns_loge ("The std of the preprocess option should not be 0.");
+      return FALSE;
+    }
+
+    pre->scale[c] = (gfloat) (1.0 / std);
+    pre->bias[c] = (gfloat) (-mean / std);
+  }
+
+  gst_tensor_converter_preprocess_free_tables (pre);
+  pre->x0 = g_new (guint, pre->out_width);
+  pre->x1 = g_new (guint, pre->out_width);
+  pre->wx = g_new (gfloat, pre->out_width);
+  pre->y0 = g_new (guint, pre->out_height);
+  pre->y1 = g_new (guint, pre->out_height);
+  pre->wy = g_new (gfloat, pre->out_height);
+  pre->row = g_new (gfloat, (gsize) width * bpp);
+  if (pre->yuv)
+    pre->row1 = g_new (gfloat, (gsize) width * bpp);
+
+  gst_tensor_converter_preprocess_fill_table (width, pre->out_width,
+      pre->x0, pre->x1, pre->wx);
+  gst_tensor_converter_preprocess_fill_table (height, pre->out_height,
+      pre->y0, pre->y1, pre->wy);
+
+  info->type = pre->type;
+  if (pre->channel_first) {
+    info->dimension[0] = pre->out_width;
+    info->dimension[1] = pre->out_height;
+    info->dimension[2] = pre->out_channels;
+  } else {
+    info->dimension[0] = pre->out_channels;
+    info->dimension[1] = pre->out_width;
+    info->dimension[2] = pre->out_height;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Macro to write the output row in the type and layout.
+ * The index of the channel c and the column x is (c * cstep + x * xstep).
+ */
+#define preprocess_store_row(pre,out,cstep,xstep,ctype,conv) do { \
+    ctype *_o = (ctype *) (out); \
+    guint _x, _c, _t; \
+    gfloat _v, _a, _b; \
+    for (_x = 0; _x < (pre)->out_width; _x++) { \
+      const gfloat *_p0 = (pre)->row + (gsize) (pre)->x0[_x] * (pre)->in_channels; \
+      const gfloat *_p1 = (pre)->row + (gsize) (pre)->x1[_x] * (pre)->in_channels; \
+      const gfloat _w = (pre)->wx[_x]; \
+      for (_c = 0; _c < (pre)->out_channels; _c++) { \
+        _v = 0.0f; \
+        for (_t = 0; _t < (pre)->num_terms; _t++) { \
+          _a = _p0[(pre)->src[_c][_t]]; \
+          _b = _p1[(pre)->src[_c][_t]]; \
+          _v += (pre)->weight[_c][_t] * (_a + (_b - _a) * _w); \
+        } \
+        _v = _v * (pre)->scale[_c] + (pre)->bias[_c]; \
+        _o[_c * (cstep) + _x * (xstep)] = conv (_v); \
+      } \
+    } \
+  } while (0)
+
+#define conv_float(v) (v)
+#define conv_uint8(v) ((uint8_t) CLAMP (floorf ((v) + 0.5f), 0.0f, 255.0f))
+#define conv_int8(v) ((int8_t) CLAMP (floorf ((v) + 0.5f), -128.0f, 127.0f))
+
+/**
+ * @brief Convert the source row of 4:2:0 YUV frame to RGB.
+ */
+static void
+gst_tensor_converter_preprocess_yuv_row (tensor_converter_preprocess_s * pre,
+    const GstTensorKernels * kernels, const guint8 * const planes[],
+    const gsize strides[], guint y, gfloat * row)
+{
+  const guint8 *u, *v;
+
+  /* a chroma row for 2 rows */
+  u = planes[pre->uv_plane[0]] + strides[pre->uv_plane[0]] * (y / 2) +
+      pre->uv_offset[0];
+  v = planes[pre->uv_plane[1]] + strides[pre->uv_plane[1]] * (y / 2) +
+      pre->uv_offset[1];
+
+  kernels->yuv420_to_rgb_f32 (planes[0] + strides[0] * y, u, v, pre->uv_step,
+      row, pre->in_width, pre->yuv_coef);
+}
+
+/**
+ * @brief Convert, resize and normalize the frame into the output tensor in a single pass.
+ */
+void
+gst_tensor_converter_preprocess_run (tensor_converter_preprocess_s * pre,
+    const guint8 * const planes[], const gsize strides[], guint8 * dest)
+{
+  const gsize row_len = (gsize) pre->in_width * pre->in_channels;
+  const gsize esize = gst_tensor_get_element_size (pre->type);
+  const GstTensorKernels *kernels = gst_tensor_kernels_get ();
+  gsize cstep, xstep, row_step;
+  const guint8 *s0, *s1;
+  guint8 *out;
+  gfloat wy;
+  gsize i;
+  guint y;
+
+  if (pre->channel_first) {
+    /* W:H:C */
+    cstep = (gsize) pre->out_width * pre->out_height;
+    xstep = 1;
+    row_step = pre->out_width;
+  } else {
+    /* C:W:H */
+    cstep = 1;
+    xstep = pre->out_channels;
+    row_step = (gsize) pre->out_width * pre->out_channels;
+  }
+
+  for (y = 0; y < pre->out_height; y++) {
+    s0 = planes[0] + strides[0] * pre->y0[y];
+    s1 = planes[0] + strides[0] * pre->y1[y];
+    wy = pre->wy[y];
+
+    /* vertical interpolation of the source rows (vectorized by the compiler) */
+    if (pre->yuv) {
+      gst_tensor_converter_preprocess_yuv_row (pre, kernels, planes, strides,
+          pre->y0[y], pre->row);
+
+      if (wy != 0.0f) {
+        gst_tensor_converter_preprocess_yuv_row (pre, kernels, planes,
+            strides, pre->y1[y], pre->row1);
+
+        for (i = 0; i < row_len; i++)
+          pre->row[i] += (pre->row1[i] - pre->row[i]) * wy;
+      }
+    } else if (wy == 0.0f) {
+      kernels->u8_to_f32 (s0, pre->row, row_len);
+    } else {
+      for (i = 0; i < row_len; i++)
+        pre->row[i] = (gfloat) s0[i] + ((gfloat) s1[i] - (gfloat) s0[i]) * wy;
+    }
+
+    out = dest + row_step * y * esize;
+
+    switch (pre->type) {
+      case _NNS_FLOAT32:
+        preprocess_store_row (pre, out, cstep, xstep, float, conv_float);
+        break;
+      case _NNS_FLOAT64:
+        preprocess_store_row (pre, out, cstep, xstep, double, conv_float);
+        break;
+#ifdef FLOAT16_SUPPORT
+      case _NNS_FLOAT16:
+        preprocess_store_row (pre, out, cstep, xstep, float16, conv_float);
+        break;
+#endif
+      case _NNS_INT8:
+        preprocess_store_row (pre, out, cstep, xstep, int8_t, conv_int8);
+        break;
+      case _NNS_UINT8:
+      default:
+        preprocess_store_row (pre, out, cstep, xstep, uint8_t, conv_uint8);
+        break;
+    }
+  }
+}
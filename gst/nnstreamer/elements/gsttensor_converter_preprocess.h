@@ -0,0 +1,126 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file    gsttensor_converter_preprocess.h
+ * @date    14 Oct 2026
+ * @brief   Fused preprocessing of video frames in tensor_converter (color, resize, normalize and layout)
+ * @see     http://github.com/nnstreamer/nnstreamer
+ * @author  agent <agent@local>
+ * @bug     No known bugs
+ */
+
+#ifndef __GST_TENSOR_CONVERTER_PREPROCESS_H__
+#define __GST_TENSOR_CONVERTER_PREPROCESS_H__
+
+#include <glib.h>
+#include <tensor_typedef.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief The color of the preprocessed tensor.
+ */
+typedef enum
+{
+  PREPROCESS_COLOR_KEEP = 0, /**< same channels as the incoming frame */
+  PREPROCESS_COLOR_RGB, /**< 3 channels in RGB order */
+  PREPROCESS_COLOR_BGR, /**< 3 channels in BGR order */
+  PREPROCESS_COLOR_GRAY, /**< 1 channel (luma of BT.601) */
+} preprocess_color;
+
+/**
+ * @brief Data structure for the fused preprocessing of video frames.
+ */
+typedef struct
+{
+  /* options (mode=preprocess:<option>) */
+  guint width; /**< width of the output (0 to keep the width of the frame) */
+  guint height; /**< height of the output (0 to keep the height of the frame) */
+  tensor_type type; /**< type of the output */
+  preprocess_color color; /**< color of the output */
+  gboolean channel_first; /**< TRUE for the layout W:H:C (nchw), FALSE for C:W:H (nhwc) */
+  gdouble mean[4]; /**< mean of each output channel */
+  gdouble std[4]; /**< standard deviation of each output channel */
+  guint num_mean; /**< number of the given mean values (1 for all channels) */
+  guint num_std; /**< number of the given std values (1 for all channels) */
+
+  /* colorimetry of the 4:2:0 YUV frame, set before the configuration */
+  gboolean yuv_bt709; /**< TRUE for the matrix of BT.709, FALSE for BT.601 */
+  gboolean yuv_full_range; /**< TRUE if the samples are in [0, 255], FALSE for the limited range */
+
+  /* configured from the video info */
+  guint in_width; /**< width of the incoming frame */
+  guint in_height; /**< height of the incoming frame */
+  guint in_channels; /**< bytes per pixel of the incoming frame (3 for the RGB converted from YUV) */
+  gboolean yuv; /**< TRUE if the incoming frame is 4:2:0 YUV (NV12, NV21 or I420) */
+  guint uv_plane[2]; /**< planes of the U and V samples */
+  gsize uv_offset[2]; /**< offsets of the U and V samples in the row of the plane */
+  gsize uv_step; /**< distance of the chroma samples in a row (1 for the planar, 2 for the semi-planar) */
+  gfloat yuv_coef[6]; /**< coefficients of the conversion to RGB (see yuv420_to_rgb_f32 of the tensor kernels) */
+  guint out_width; /**< width of the output */
+  guint out_height; /**< height of the output */
+  guint out_channels; /**< channels of the output */
+  guint num_terms; /**< number of the source channels of an output channel */
+  guint src[4][3]; /**< source channels of each output channel */
+  gfloat weight[4][3]; /**< weights of the source channels */
+  gfloat scale[4]; /**< 1 / std of each output channel */
+  gfloat bias[4]; /**< -mean / std of each output channel */
+  guint *x0; /**< left source pixel of each output column */
+  guint *x1; /**< right source pixel of each output column */
+  gfloat *wx; /**< weight of the right source pixel */
+  guint *y0; /**< upper source row of each output row */
+  guint *y1; /**< lower source row of each output row */
+  gfloat *wy; /**< weight of the lower source row */
+  gfloat *row; /**< vertically interpolated source row */
+  gfloat *row1; /**< the lower source row converted from YUV */
+} tensor_converter_preprocess_s;
+
+/**
+ * @brief Initialize the preprocessing data.
+ */
+extern void
+gst_tensor_converter_preprocess_init (tensor_converter_preprocess_s * pre);
+
+/**
+ * @brief Free the preprocessing data.
+ */
+extern void
+gst_tensor_converter_preprocess_free (tensor_converter_preprocess_s * pre);
+
+/**
+ * @brief Parse the option of the preprocessing.
+ * @param pre preprocessing data
+ * @param option comma-separated key=value list (width, height, type, color, layout, mean and std)
+ * @return TRUE if the option is valid
+ */
+extern gboolean
+gst_tensor_converter_preprocess_parse_option (tensor_converter_preprocess_s * pre,
+    const gchar * option);
+
+/**
+ * @brief Configure the preprocessing for the incoming video frame.
+ * @param pre preprocessing data
+ * @param format video format string (e.g., RGB, BGRx, GRAY8 or NV12)
+ * @param width width of the incoming frame
+ * @param height height of the incoming frame
+ * @param info tensor info of the output (type and dimension are updated)
+ * @return TRUE if the format is supported
+ */
+extern gboolean
+gst_tensor_converter_preprocess_configure (tensor_converter_preprocess_s * pre,
+    const gchar * format, guint width, guint height, GstTensorInfo * info);
+
+/**
+ * @brief Convert, resize and normalize the frame into the output tensor in a single pass.
+ * @param pre preprocessing data
+ * @param planes the first row of each plane in the incoming frame (Y, UV or Y, U, V for YUV)
+ * @param strides size of a row of each plane in the incoming frame (bytes)
+ * @param dest output tensor
+ */
+extern void
+gst_tensor_converter_preprocess_run (tensor_converter_preprocess_s * pre,
+    const guint8 * const planes[], const gsize strides[], guint8 * dest);
+
+G_END_DECLS
+#endif /* __GST_TENSOR_CONVERTER_PREPROCESS_H__ */
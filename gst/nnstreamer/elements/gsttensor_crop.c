@@ -22,7 +22,12 @@
  * Note that NNStreamer supports maximum 16 (NNS_TENSOR_SIZE_LIMIT) memory blocks in a buffer.
  * So, when incoming buffer on info pad has more than 16 crop-info array, tensor_crop will ignore the data and output buffer will have 16 memory blocks.
  *
- * The output is always in the format of other/tensors-flexible.
+ * By default, the output is in the format of other/tensors-flexible.
+ *
+ * When the property 'max-rois' is set, tensor_crop crops and resizes (nearest neighbor) all regions to 'roi-size'
+ * and outputs static tensors - a batch tensor (dimension ch:width:height:max-rois) and a count tensor (uint32, the number of valid regions).
+ * The output buffers are allocated from a buffer pool, and the unused regions in the batch tensor are filled with zero.
+ * Then the next filter can invoke the model once for all regions. Note that the raw tensor should be static in this mode.
  *
  * <refsect2>
  * <title>Example launch line</title>
@@ -33,6 +38,15 @@
  *       t. ! queue ! (process raw video tensor and push buffer which includes crop info) ! crop.info
  * ]|
  * </refsect2>
+ *
+ * <refsect2>
+ * <title>Example launch line (batch tensor)</title>
+ * |[
+ * gst-launch-1.0 tensor_crop name=crop max-rois=8 roi-size=224:224 ! tensor_filter (batched model, 3:224:224:8) ... \
+ *     (raw video tensor) ! crop.raw \
+ *     (crop info from detection) ! crop.info
+ * ]|
+ * </refsect2>
  */
 
 #ifdef HAVE_CONFIG_H
@@ -43,6 +57,7 @@
 #include <nnstreamer_util.h>
 #include "gsttensor_crop.h"
 #include "tensor_data.h"
+#include "tensor_buffer_pool.h"
 
 /**
  * @brief Internal data structure to describe tensor region.
@@ -62,7 +77,7 @@ typedef struct
 typedef struct
 {
   guint num;
-  tensor_region_s region[NNS_TENSOR_SIZE_LIMIT];
+  tensor_region_s *region;
 } tensor_crop_info_s;
 
 GST_DEBUG_CATEGORY_STATIC (gst_tensor_crop_debug);
@@ -75,7 +90,9 @@ enum
 {
   PROP_0,
   PROP_LATENESS,
-  PROP_SILENT
+  PROP_SILENT,
+  PROP_MAX_ROIS,
+  PROP_ROI_SIZE
 };
 
 /**
@@ -88,6 +105,11 @@ enum
  */
 #define DEFAULT_LATENESS (-1)
 
+/**
+ * @brief Default max number of regions in the batch tensor (0 means flexible output).
+ */
+#define DEFAULT_MAX_ROIS (0)
+
 /**
  * @brief Template for sink pad (raw data).
  */
@@ -111,7 +133,7 @@ static GstStaticPadTemplate info_template = GST_STATIC_PAD_TEMPLATE ("info",
 static GstStaticPadTemplate src_template = GST_STATIC_PAD_TEMPLATE ("src",
     GST_PAD_SRC,
     GST_PAD_ALWAYS,
-    GST_STATIC_CAPS (GST_TENSORS_FLEX_CAP_DEFAULT));
+    GST_STATIC_CAPS (GST_TENSORS_CAP_MAKE ("{ static, flexible }")));
 
 #define gst_tensor_crop_parent_class parent_class
 G_DEFINE_TYPE (GstTensorCrop, gst_tensor_crop, GST_TYPE_ELEMENT);
@@ -171,6 +193,28 @@ gst_tensor_crop_class_init (GstTensorCropClass * klass)
       g_param_spec_boolean ("silent", "Silent", "Produce verbose output",
           DEFAULT_SILENT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstTensorCrop::max-rois:
+   *
+   * The max number of regions in the batch tensor (0 means flexible output).
+   * If this is set, tensor-crop resizes all regions to 'roi-size' and outputs the batch and count tensors.
+   */
+  g_object_class_install_property (object_class, PROP_MAX_ROIS,
+      g_param_spec_uint ("max-rois", "Max ROIs",
+          "The max number of regions in the batch tensor (0 for flexible output)",
+          0, G_MAXUINT16, DEFAULT_MAX_ROIS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorCrop::roi-size:
+   *
+   * The size (width:height) of a region in the batch tensor.
+   */
+  g_object_class_install_property (object_class, PROP_ROI_SIZE,
+      g_param_spec_string ("roi-size", "ROI size",
+          "The size (width:height) of a region in the batch tensor", "",
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   element_class->change_state =
       GST_DEBUG_FUNCPTR (gst_tensor_crop_change_state);
 
@@ -218,7 +262,14 @@ gst_tensor_crop_reset (GstTensorCrop * self)
     }
   }
 
+  if (self->pool) {
+    gst_buffer_pool_set_active (self->pool, FALSE);
+    gst_object_unref (self->pool);
+    self->pool = NULL;
+  }
+
   self->send_stream_start = TRUE;
+  self->batch_configured = FALSE;
 }
 
 /**
@@ -256,6 +307,10 @@ gst_tensor_crop_init (GstTensorCrop * self)
   self->lateness = DEFAULT_LATENESS;
   self->silent = DEFAULT_SILENT;
   self->send_stream_start = TRUE;
+  self->max_rois = DEFAULT_MAX_ROIS;
+  self->roi_width = self->roi_height = 0;
+  self->batch_configured = FALSE;
+  self->pool = NULL;
 }
 
 /**
@@ -296,6 +351,32 @@ gst_tensor_crop_set_property (GObject * object, guint prop_id,
     case PROP_SILENT:
       self->silent = g_value_get_boolean (value);
       break;
+    case PROP_MAX_ROIS:
+      self->max_rois = g_value_get_uint (value);
+      self->batch_configured = FALSE;
+      break;
+    case PROP_ROI_SIZE:
+    {
+      const gchar *str = g_value_get_string (value);
+      gchar **strv = str ? g_strsplit (str, ":", -1) : NULL;
+      guint64 w = 0, h = 0;
+
+      if (strv && g_strv_length (strv) == 2) {
+        w = g_ascii_strtoull (strv[0], NULL, 10);
+        h = g_ascii_strtoull (strv[1], NULL, 10);
+      }
+
+      if (w > 0 && w <= G_MAXUINT && h > 0 && h <= G_MAXUINT) {
+        self->roi_width = (guint) w;
+        self->roi_height = (guint) h;
+        self->batch_configured = FALSE;
+      } else if (str && str[0] != '\0') {
+        GST_ERROR_OBJECT (self, "Invalid roi-size '%s', set width:height.", str);
+      }
+
+      g_strfreev (strv);
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -320,6 +401,16 @@ gst_tensor_crop_get_property (GObject * object, guint prop_id,
     case PROP_SILENT:
       g_value_set_boolean (value, self->silent);
       break;
+    case PROP_MAX_ROIS:
+      g_value_set_uint (value, self->max_rois);
+      break;
+    case PROP_ROI_SIZE:
+      if (self->roi_width > 0 && self->roi_height > 0)
+        g_value_take_string (value,
+            g_strdup_printf ("%u:%u", self->roi_width, self->roi_height));
+      else
+        g_value_set_string (value, "");
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -388,11 +479,12 @@ static gboolean
 gst_tensor_crop_sink_event (GstCollectPads * pads, GstCollectData * data,
     GstEvent * event, gpointer user_data)
 {
+  GstTensorCrop *self;
   GstTensorCropPadData *cpad;
-  UNUSED (user_data);
 
   g_return_val_if_fail (event != NULL, FALSE);
 
+  self = GST_TENSOR_CROP (user_data);
   cpad = (GstTensorCropPadData *) data;
 
   switch (GST_EVENT_TYPE (event)) {
@@ -406,6 +498,10 @@ gst_tensor_crop_sink_event (GstCollectPads * pads, GstCollectData * data,
 
       gst_tensors_config_from_structure (&cpad->config, structure);
 
+      /* the batch tensor has the type and channel of raw tensor */
+      if (data->pad == self->sinkpad_raw)
+        self->batch_configured = FALSE;
+
       gst_event_unref (event);
       return gst_tensors_config_validate (&cpad->config);
     }
@@ -416,12 +512,95 @@ gst_tensor_crop_sink_event (GstCollectPads * pads, GstCollectData * data,
   return gst_collect_pads_event_default (pads, data, event, FALSE);
 }
 
+/**
+ * @brief Internal function to set the output config of the batch tensor.
+ */
+static gboolean
+gst_tensor_crop_get_batch_config (GstTensorCrop * self,
+    GstTensorsConfig * config)
+{
+  GstTensorsConfig *raw_config = NULL;
+  GstTensorInfo *raw_info, *info;
+  GSList *walk;
+
+  for (walk = self->collect->data; walk; walk = g_slist_next (walk)) {
+    GstTensorCropPadData *cpad = (GstTensorCropPadData *) walk->data;
+
+    if (cpad->data.pad == self->sinkpad_raw)
+      raw_config = &cpad->config;
+  }
+
+  if (!raw_config || !gst_tensors_config_is_static (raw_config)) {
+    GST_ERROR_OBJECT (self,
+        "The batch tensor (max-rois %u) requires static raw tensor.",
+        self->max_rois);
+    return FALSE;
+  }
+
+  if (self->roi_width == 0 || self->roi_height == 0) {
+    GST_ERROR_OBJECT (self,
+        "The property roi-size is required to make the batch tensor.");
+    return FALSE;
+  }
+
+  raw_info = &raw_config->info.info[0];
+  config->info.format = _NNS_TENSOR_FORMAT_STATIC;
+  config->info.num_tensors = 2;
+
+  /* batch tensor (NHWC) */
+  info = &config->info.info[0];
+  info->type = raw_info->type;
+  info->dimension[0] = raw_info->dimension[0];
+  info->dimension[1] = self->roi_width;
+  info->dimension[2] = self->roi_height;
+  info->dimension[3] = self->max_rois;
+
+  /* the number of valid regions */
+  info = &config->info.info[1];
+  info->type = _NNS_UINT32;
+  info->dimension[0] = 1;
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to prepare the buffer pool of the batch tensor.
+ */
+static gboolean
+gst_tensor_crop_set_batch_pool (GstTensorCrop * self, GstCaps * caps)
+{
+  GstStructure *config;
+
+  if (self->pool) {
+    gst_buffer_pool_set_active (self->pool, FALSE);
+    gst_object_unref (self->pool);
+  }
+
+  self->pool = gst_tensor_buffer_pool_new ();
+  config = gst_buffer_pool_get_config (self->pool);
+
+  /* no limit, downstream may keep the buffers */
+  gst_buffer_pool_config_set_params (config, caps, 0, 0, 0);
+
+  if (!gst_buffer_pool_set_config (self->pool, config) ||
+      !gst_buffer_pool_set_active (self->pool, TRUE)) {
+    GST_ERROR_OBJECT (self, "Failed to configure the buffer pool.");
+    gst_object_unref (self->pool);
+    self->pool = NULL;
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
 /**
  * @brief Set pad caps if not negotiated.
  */
 static GstFlowReturn
 gst_tensor_crop_negotiate (GstTensorCrop * self)
 {
+  gboolean need_segment;
+
   if (!gst_pad_has_current_caps (self->sinkpad_raw)) {
     GST_ERROR_OBJECT (self,
         "The raw pad of tensor_crop '%s' does not have pad caps.",
@@ -436,7 +615,9 @@ gst_tensor_crop_negotiate (GstTensorCrop * self)
     return GST_FLOW_NOT_NEGOTIATED;
   }
 
-  if (!gst_pad_has_current_caps (self->srcpad)) {
+  need_segment = !gst_pad_has_current_caps (self->srcpad);
+
+  if (need_segment || (self->max_rois > 0 && !self->batch_configured)) {
     GstCaps *caps;
     GstSegment segment;
     GstTensorsConfig config;
@@ -456,7 +637,7 @@ gst_tensor_crop_negotiate (GstTensorCrop * self)
 
     /**
      * Get config from collect-pads and set framerate.
-     * Output is always flexible tensor.
+     * Output is flexible tensor, or static batch and count tensors with max-rois.
      */
     gst_tensors_config_init (&config);
     config.info.format = _NNS_TENSOR_FORMAT_FLEXIBLE;
@@ -475,12 +656,30 @@ gst_tensor_crop_negotiate (GstTensorCrop * self)
       walk = g_slist_next (walk);
     }
 
+    if (self->max_rois > 0 && !gst_tensor_crop_get_batch_config (self, &config)) {
+      gst_tensors_config_free (&config);
+      return GST_FLOW_NOT_NEGOTIATED;
+    }
+
     caps = gst_tensors_caps_from_config (&config);
+    gst_tensors_config_free (&config);
+
+    if (self->max_rois > 0) {
+      if (!gst_tensor_crop_set_batch_pool (self, caps)) {
+        gst_caps_unref (caps);
+        return GST_FLOW_NOT_NEGOTIATED;
+      }
+
+      self->batch_configured = TRUE;
+    }
+
     gst_pad_set_caps (self->srcpad, caps);
     gst_caps_unref (caps);
 
-    gst_segment_init (&segment, GST_FORMAT_TIME);
-    gst_pad_push_event (self->srcpad, gst_event_new_segment (&segment));
+    if (need_segment) {
+      gst_segment_init (&segment, GST_FORMAT_TIME);
+      gst_pad_push_event (self->srcpad, gst_event_new_segment (&segment));
+    }
   }
 
   return GST_FLOW_OK;
@@ -589,8 +788,11 @@ gst_tensor_crop_get_crop_info (GstTensorCrop * self, GstBuffer * info,
 
   memset (cinfo, 0, sizeof (tensor_crop_info_s));
 
+  /* flexible output has a memory block for each region */
   cinfo->num = dsize / (esize * 4);
-  cinfo->num = MIN (cinfo->num, NNS_TENSOR_SIZE_LIMIT);
+  cinfo->num = MIN (cinfo->num,
+      (self->max_rois > 0) ? self->max_rois : NNS_TENSOR_SIZE_LIMIT);
+  cinfo->region = g_new0 (tensor_region_s, MAX (cinfo->num, 1U));
 
   for (i = 0; i < cinfo->num; i++) {
     pos = map.data + hsize + (esize * 4 * i);
@@ -663,7 +865,6 @@ gst_tensor_crop_do_cropping (GstTensorCrop * self, GstBuffer * raw,
   mw = info.dimension[1];
   mh = info.dimension[2];
   esize = gst_tensor_get_element_size (info.type);
-  hsize = gst_tensor_meta_info_get_header_size (&meta);
 
   for (i = 0; i < cinfo->num; i++) {
     _x = (cinfo->region[i].x < mw) ? cinfo->region[i].x : mw;
@@ -672,13 +873,15 @@ gst_tensor_crop_do_cropping (GstTensorCrop * self, GstBuffer * raw,
     _h = (_y + cinfo->region[i].h - 1 < mh) ? cinfo->region[i].h : (mh - _y);
 
     g_assert (_w > 0 && _h > 0);
-    dsize = hsize + (esize * ch * _w * _h);
-    cropped = (guint8 *) g_malloc0 (dsize);
 
-    /* set header for flex tensor */
+    /* set header for flex tensor (compact header size depends on the dimension) */
     meta.dimension[1] = _w;
     meta.dimension[2] = _h;
     meta.dimension[3] = 1;
+    hsize = gst_tensor_meta_info_get_header_size (&meta);
+
+    dsize = hsize + (esize * ch * _w * _h);
+    cropped = (guint8 *) g_malloc0 (dsize);
     gst_tensor_meta_info_update_header (&meta, cropped);
 
     for (j = 0; j < _h; j++) {
@@ -699,6 +902,117 @@ done:
   return result;
 }
 
+/**
+ * @brief Internal function to crop and resize the regions into the batch tensor.
+ */
+static GstBuffer *
+gst_tensor_crop_do_batch (GstTensorCrop * self, GstBuffer * raw,
+    GstTensorsConfig * config, tensor_crop_info_s * cinfo)
+{
+  GstBuffer *result = NULL;
+  GstMemory *mem, *bmem, *cmem;
+  GstMapInfo map, bmap, cmap;
+  GstTensorInfo *info;
+  gsize esize, psize, rsize;
+  guint8 *dest, *row;
+  guint32 count = 0;
+  guint i, ox, oy, ch, mw, mh, ow, oh, sx, sy, _x, _y, _w, _h;
+
+  info = &config->info.info[0];
+  ch = info->dimension[0];
+  mw = info->dimension[1];
+  mh = info->dimension[2];
+  ow = self->roi_width;
+  oh = self->roi_height;
+  esize = gst_tensor_get_element_size (info->type);
+  psize = esize * ch;
+  rsize = psize * ow * oh;
+
+  if (gst_buffer_pool_acquire_buffer (self->pool, &result, NULL) != GST_FLOW_OK) {
+    GST_ERROR_OBJECT (self, "Failed to get the output buffer from the pool.");
+    return NULL;
+  }
+
+  mem = gst_buffer_peek_memory (raw, 0);
+  bmem = gst_buffer_peek_memory (result, 0);
+  cmem = gst_buffer_peek_memory (result, 1);
+
+  if (!gst_memory_map (mem, &map, GST_MAP_READ)) {
+    GST_ERROR_OBJECT (self, "Failed to map the raw buffer.");
+    gst_buffer_unref (result);
+    return NULL;
+  }
+
+  if (map.size < psize * mw * mh) {
+    GST_ERROR_OBJECT (self,
+        "Raw buffer has invalid data size (received %zd, expected %zd).",
+        map.size, psize * mw * mh);
+    gst_memory_unmap (mem, &map);
+    gst_buffer_unref (result);
+    return NULL;
+  }
+
+  if (!gst_memory_map (bmem, &bmap, GST_MAP_WRITE)) {
+    GST_ERROR_OBJECT (self, "Failed to map the batch tensor.");
+    gst_memory_unmap (mem, &map);
+    gst_buffer_unref (result);
+    return NULL;
+  }
+
+  for (i = 0; i < cinfo->num; i++) {
+    _x = (cinfo->region[i].x < mw) ? cinfo->region[i].x : mw;
+    _y = (cinfo->region[i].y < mh) ? cinfo->region[i].y : mh;
+    _w = (_x + cinfo->region[i].w - 1 < mw) ? cinfo->region[i].w : (mw - _x);
+    _h = (_y + cinfo->region[i].h - 1 < mh) ? cinfo->region[i].h : (mh - _y);
+
+    /* skip the region out of raw tensor */
+    if (_w == 0 || _h == 0)
+      continue;
+
+    dest = bmap.data + rsize * count;
+
+    for (oy = 0; oy < oh; oy++) {
+      /* nearest neighbor, sample the center of the output pixel */
+      sy = _y + (guint) ((((guint64) oy * 2 + 1) * _h) / ((guint64) oh * 2));
+      row = map.data + psize * ((gsize) sy * mw + _x);
+
+      if (_w == ow) {
+        memcpy (dest, row, psize * ow);
+      } else {
+        for (ox = 0; ox < ow; ox++) {
+          sx = (guint) ((((guint64) ox * 2 + 1) * _w) / ((guint64) ow * 2));
+          memcpy (dest + psize * ox, row + psize * sx, psize);
+        }
+      }
+
+      dest += psize * ow;
+    }
+
+    count++;
+  }
+
+  /* the buffer from the pool may have old data */
+  if (count < self->max_rois)
+    memset (bmap.data + rsize * count, 0, rsize * (self->max_rois - count));
+
+  gst_memory_unmap (bmem, &bmap);
+  gst_memory_unmap (mem, &map);
+
+  if (!gst_memory_map (cmem, &cmap, GST_MAP_WRITE)) {
+    GST_ERROR_OBJECT (self, "Failed to map the count tensor.");
+    gst_buffer_unref (result);
+    return NULL;
+  }
+
+  memcpy (cmap.data, &count, sizeof (guint32));
+  gst_memory_unmap (cmem, &cmap);
+
+  /* set timestamp from raw buffer */
+  gst_buffer_copy_into (result, raw, GST_BUFFER_COPY_METADATA, 0, -1);
+
+  return result;
+}
+
 /**
  * @brief Internal function to transform the input buffer.
  */
@@ -709,7 +1023,7 @@ gst_tensor_crop_chain (GstTensorCrop * self,
   GstFlowReturn ret;
   GstBuffer *buf_raw, *buf_info, *result;
   GstTensorCropPadData *cpad;
-  tensor_crop_info_s cinfo;
+  tensor_crop_info_s cinfo = { 0, NULL };
   gboolean drop_raw, drop_info;
 
   g_return_val_if_fail (data_raw && data_info, GST_FLOW_ERROR);
@@ -768,10 +1082,18 @@ gst_tensor_crop_chain (GstTensorCrop * self,
     goto done;
   }
 
-  result = gst_tensor_crop_do_cropping (self, buf_raw, &cinfo);
-  ret = gst_pad_push (self->srcpad, result);
+  if (self->max_rois > 0) {
+    cpad = (GstTensorCropPadData *) data_raw;
+    result = gst_tensor_crop_do_batch (self, buf_raw, &cpad->config, &cinfo);
+  } else {
+    result = gst_tensor_crop_do_cropping (self, buf_raw, &cinfo);
+  }
+
+  ret = result ? gst_pad_push (self->srcpad, result) : GST_FLOW_ERROR;
 
 done:
+  g_free (cinfo.region);
+
   if (buf_raw)
     gst_buffer_unref (buf_raw);
   if (buf_info)
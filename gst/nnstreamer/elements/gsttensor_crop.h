@@ -59,6 +59,12 @@ struct _GstTensorCrop
   gboolean silent; /**< true to print minimized log */
   gboolean send_stream_start; /**< flag to send STREAM_START event */
   GstCollectPads *collect; /**< sink pads */
+
+  guint max_rois; /**< max number of regions in the batch tensor (0 for flexible output) */
+  guint roi_width; /**< width of a region in the batch tensor */
+  guint roi_height; /**< height of a region in the batch tensor */
+  gboolean batch_configured; /**< true if the caps and pool of the batch tensor are configured */
+  GstBufferPool *pool; /**< buffer pool for the batch and count tensors */
 };
 
 /**
@@ -23,10 +23,18 @@
  *
  * Note that this does not support other/tensor, but only supports other/tensors.
  *
+ * To keep tensor_debug in the pipelines running at production rates, the
+ * buffers may be sampled (sample-interval, sample-time), and only the sampled
+ * buffers are logged. With tensor-stats, the min/max/mean of the finite values
+ * and the number of NaN and infinite values of each tensor in the sampled
+ * buffers are logged, and the latest statistics with the byte rate are
+ * available with the property stats.
+ *
  * <refsect2>
  * <title>Example launch line</title>
  * |[
  * gst-launch-1.0 videotestsrc ! video/x-raw,format=RGB,width=640,height=480 ! tensor_converter ! tensor_debug output-method=console-info capability=always ! tensor_sink
+ * gst-launch-1.0 ... ! tensor_filter ... ! tensor_debug sample-time=1000 tensor-stats=true ! tensor_sink
  * ]|
  * </refsect2>
  */
@@ -39,6 +47,7 @@
 #include <nnstreamer_log.h>
 #include <nnstreamer_util.h>
 #include "gsttensor_debug.h"
+#include "tensor_data.h"
 #include "tensor_meta.h"
 
 /**
@@ -83,6 +92,10 @@ enum
   PROP_OUTPUT,
   PROP_CAP,
   PROP_META,
+  PROP_SAMPLE_INTERVAL,
+  PROP_SAMPLE_TIME,
+  PROP_TENSOR_STATS,
+  PROP_STATS,
 };
 
 #define C_FLAGS(v) ((guint) v)
@@ -185,6 +198,21 @@ tensor_debug_meta_flags_get_type (void)
 
 #define DEFAULT_TENSOR_DEBUG_META_FLAGS (TDBG_META_DISABLED)
 
+/**
+ * @brief Default sampling, log every buffer.
+ */
+#define DEFAULT_SAMPLE_INTERVAL (1)
+#define DEFAULT_SAMPLE_TIME (0)
+#define DEFAULT_TENSOR_STATS FALSE
+
+/**
+ * @brief Masks of the output methods and the log levels.
+ */
+#define TDBG_OUTPUT_CONSOLE (0x10)
+#define TDBG_OUTPUT_CONSOLE_LEVEL (0x03)
+#define TDBG_OUTPUT_GSTDBG (0x20)
+#define TDBG_OUTPUT_GSTDBG_LEVEL (0x0C)
+
 /**
  * @brief Flag to print minimized log.
  */
@@ -273,6 +301,48 @@ gst_tensor_debug_class_init (GstTensorDebugClass * klass)
           TENSOR_DEBUG_TYPE_META_FLAGS, DEFAULT_TENSOR_DEBUG_META_FLAGS,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstTensorDebug::sample-interval:
+   *
+   * Log 1 in N buffers. The other buffers are passed without inspecting the contents.
+   */
+  g_object_class_install_property (object_class, PROP_SAMPLE_INTERVAL,
+      g_param_spec_uint ("sample-interval", "Sample interval",
+          "Log 1 in N buffers (1 to log every buffer)", 1, G_MAXUINT,
+          DEFAULT_SAMPLE_INTERVAL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorDebug::sample-time:
+   *
+   * Log at most one buffer in the given time (ms), along with sample-interval.
+   */
+  g_object_class_install_property (object_class, PROP_SAMPLE_TIME,
+      g_param_spec_uint ("sample-time", "Sample time",
+          "Log at most one buffer in the given time in milliseconds (0 to disable)",
+          0, G_MAXUINT, DEFAULT_SAMPLE_TIME,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorDebug::tensor-stats:
+   *
+   * Summarize the values of each tensor in the sampled buffers.
+   */
+  g_object_class_install_property (object_class, PROP_TENSOR_STATS,
+      g_param_spec_boolean ("tensor-stats", "Tensor statistics",
+          "Log the min, max and mean of the finite values and the number of NaN and infinite values of each tensor in the sampled buffers",
+          DEFAULT_TENSOR_STATS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorDebug::stats:
+   *
+   * The statistics of the latest sampled buffer.
+   */
+  g_object_class_install_property (object_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "The statistics of the latest sampled buffer: buffers, sampled, bytes, byte-rate (bytes per second), "
+          "nan-count and inf-count (accumulated in the sampled buffers), and min-N, max-N, mean-N of the N-th tensor with tensor-stats",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
 
   /* set pad template */
   gst_element_class_add_pad_template (element_class,
@@ -317,7 +387,23 @@ gst_tensor_debug_init (GstTensorDebug * self)
   self->output_mode = DEFAULT_TENSOR_DEBUG_OUTPUT_FLAGS;
   self->cap_mode = DEFAULT_TENSOR_DEBUG_CAP;
   self->meta_mode = DEFAULT_TENSOR_DEBUG_META_FLAGS;
-
+  self->sample_interval = DEFAULT_SAMPLE_INTERVAL;
+  self->sample_time = DEFAULT_SAMPLE_TIME;
+  self->tensor_stats = DEFAULT_TENSOR_STATS;
+
+  gst_tensors_config_init (&self->in_config);
+  self->caps_updated = FALSE;
+  self->last_dims = NULL;
+  memset (self->meta_cache, 0, sizeof (self->meta_cache));
+
+  self->num_buffers = 0;
+  self->num_bytes = 0;
+  self->num_sampled = 0;
+  self->last_sample_time = 0;
+  self->last_sample_bytes = 0;
+  self->nan_count = 0;
+  self->inf_count = 0;
+  self->stats = NULL;
 }
 
 /**
@@ -326,6 +412,13 @@ gst_tensor_debug_init (GstTensorDebug * self)
 static void
 gst_tensor_debug_finalize (GObject * object)
 {
+  GstTensorDebug *self = GST_TENSOR_DEBUG (object);
+
+  gst_tensors_config_free (&self->in_config);
+  g_free (self->last_dims);
+  if (self->stats)
+    gst_structure_free (self->stats);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -355,6 +448,18 @@ gst_tensor_debug_set_property (GObject * object, guint prop_id,
       self->meta_mode = g_value_get_flags (value);
       silent_debug (self, "Set meta = %x", self->meta_mode);
       break;
+    case PROP_SAMPLE_INTERVAL:
+      self->sample_interval = g_value_get_uint (value);
+      silent_debug (self, "Set sample-interval = %u", self->sample_interval);
+      break;
+    case PROP_SAMPLE_TIME:
+      self->sample_time = g_value_get_uint (value);
+      silent_debug (self, "Set sample-time = %u", self->sample_time);
+      break;
+    case PROP_TENSOR_STATS:
+      self->tensor_stats = g_value_get_boolean (value);
+      silent_debug (self, "Set tensor-stats = %d", self->tensor_stats);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -383,22 +488,242 @@ gst_tensor_debug_get_property (GObject * object, guint prop_id,
     case PROP_META:
       g_value_set_flags (value, self->meta_mode);
       break;
+    case PROP_SAMPLE_INTERVAL:
+      g_value_set_uint (value, self->sample_interval);
+      break;
+    case PROP_SAMPLE_TIME:
+      g_value_set_uint (value, self->sample_time);
+      break;
+    case PROP_TENSOR_STATS:
+      g_value_set_boolean (value, self->tensor_stats);
+      break;
+    case PROP_STATS:
+      GST_OBJECT_LOCK (self);
+      g_value_set_boxed (value, self->stats);
+      GST_OBJECT_UNLOCK (self);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 }
 
+/**
+ * @brief Check whether the buffer is sampled to be logged.
+ */
+static gboolean
+_gst_tensor_debug_is_sampled (GstTensorDebug * self, gint64 now)
+{
+  if ((self->num_buffers - 1) % self->sample_interval != 0)
+    return FALSE;
+
+  if (self->sample_time > 0 && self->last_sample_time > 0 &&
+      now - self->last_sample_time < (gint64) self->sample_time * 1000)
+    return FALSE;
+
+  return TRUE;
+}
+
+/**
+ * @brief Print the debug message with the output methods.
+ */
+static void
+_gst_tensor_debug_print (GstTensorDebug * self, const gchar * msg)
+{
+  guint mode = (guint) self->output_mode;
+
+  if (mode & TDBG_OUTPUT_CONSOLE) {
+    switch (mode & TDBG_OUTPUT_CONSOLE_LEVEL) {
+      case 0x1:
+        nns_logi ("%s", msg);
+        break;
+      case 0x2:
+        nns_logw ("%s", msg);
+        break;
+      case 0x3:
+        nns_loge ("%s", msg);
+        break;
+      default:
+        break;
+    }
+  }
+
+  if (mode & TDBG_OUTPUT_GSTDBG) {
+    switch (mode & TDBG_OUTPUT_GSTDBG_LEVEL) {
+      case 0x4:
+        GST_INFO_OBJECT (self, "%s", msg);
+        break;
+      case 0x8:
+        GST_WARNING_OBJECT (self, "%s", msg);
+        break;
+      case 0xC:
+        GST_ERROR_OBJECT (self, "%s", msg);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+/**
+ * @brief Summarize the values of the tensor and append it to the message and the statistics.
+ */
+static void
+_gst_tensor_debug_summarize (GstTensorDebug * self, guint index,
+    gconstpointer data, gsize size, tensor_type type, GString * msg,
+    GstStructure * stats)
+{
+  tensor_data_summary_s s;
+  gchar *field;
+
+  if (!gst_tensor_data_raw_summary (data, size, type, &s))
+    return;
+
+  self->nan_count += s.nan_count;
+  self->inf_count += s.inf_count;
+
+  g_string_append_printf (msg,
+      "\n  [%u] %s min %g max %g mean %g nan %" G_GSIZE_FORMAT " inf %"
+      G_GSIZE_FORMAT, index, gst_tensor_get_type_string (type), s.min, s.max,
+      s.mean, s.nan_count, s.inf_count);
+
+  field = g_strdup_printf ("min-%u", index);
+  gst_structure_set (stats, field, G_TYPE_DOUBLE, s.min, NULL);
+  g_free (field);
+  field = g_strdup_printf ("max-%u", index);
+  gst_structure_set (stats, field, G_TYPE_DOUBLE, s.max, NULL);
+  g_free (field);
+  field = g_strdup_printf ("mean-%u", index);
+  gst_structure_set (stats, field, G_TYPE_DOUBLE, s.mean, NULL);
+  g_free (field);
+}
+
 /**
  * @brief The core function that provides debug output based
  *        on the contents.
  */
 static void
-_gst_tensor_debug_output (GstTensorDebug * self, GstBuffer * buffer)
+_gst_tensor_debug_output (GstTensorDebug * self, GstBuffer * buffer,
+    gint64 now)
 {
-  UNUSED (self);
-  UNUSED (buffer);
-  /** @todo NYI: do the debug task */
+  GstTensorsInfo *info = &self->in_config.info;
+  gboolean flexible = gst_tensors_config_is_flexible (&self->in_config);
+  gboolean sparse = gst_tensors_config_is_sparse (&self->in_config);
+  gboolean show_dims;
+  GstStructure *stats;
+  GString *msg, *dims = NULL;
+  gdouble byte_rate = 0.0;
+  guint i, num_tensors;
+
+  if (self->last_sample_time > 0 && now > self->last_sample_time) {
+    byte_rate = (gdouble) (self->num_bytes - self->last_sample_bytes) *
+        G_USEC_PER_SEC / (now - self->last_sample_time);
+  }
+
+  self->last_sample_time = now;
+  self->last_sample_bytes = self->num_bytes;
+  self->num_sampled++;
+
+  num_tensors = (flexible || sparse) ? gst_buffer_n_memory (buffer) :
+      info->num_tensors;
+  num_tensors = MIN (num_tensors, NNS_TENSOR_SIZE_LIMIT);
+
+  msg = g_string_new (NULL);
+  g_string_append_printf (msg, "[%s] buffer %" G_GUINT64_FORMAT
+      ": %u tensors, %" G_GSIZE_FORMAT " bytes, %.1f bytes/s",
+      GST_OBJECT_NAME (self), self->num_buffers, num_tensors,
+      gst_buffer_get_size (buffer), byte_rate);
+
+  if (self->meta_mode & TDBG_META_TIMESTAMP) {
+    g_string_append_printf (msg, ", pts %" GST_TIME_FORMAT ", dts %"
+        GST_TIME_FORMAT ", duration %" GST_TIME_FORMAT,
+        GST_TIME_ARGS (GST_BUFFER_PTS (buffer)),
+        GST_TIME_ARGS (GST_BUFFER_DTS (buffer)),
+        GST_TIME_ARGS (GST_BUFFER_DURATION (buffer)));
+  }
+
+  if (self->cap_mode == TDBG_CAP_SHOW_ALWAYS ||
+      (self->cap_mode != TDBG_CAP_DISABLED && self->caps_updated)) {
+    gchar *str = gst_tensors_config_to_string (&self->in_config);
+
+    g_string_append_printf (msg, "\n  caps: %s", str);
+    g_free (str);
+    self->caps_updated = FALSE;
+  }
+
+  stats = gst_structure_new ("tensor-debug-stats",
+      "buffers", G_TYPE_UINT64, self->num_buffers,
+      "sampled", G_TYPE_UINT64, self->num_sampled,
+      "bytes", G_TYPE_UINT64, self->num_bytes,
+      "byte-rate", G_TYPE_DOUBLE, byte_rate, NULL);
+
+  show_dims = flexible && (self->cap_mode == TDBG_CAP_SHOW_UPDATE_F ||
+      self->cap_mode == TDBG_CAP_SHOW_ALWAYS);
+  if (show_dims)
+    dims = g_string_new (NULL);
+
+  /* the sparse tensors are not decoded */
+  for (i = 0; i < num_tensors && !sparse && (self->tensor_stats || dims); i++) {
+    GstMemory *mem;
+    GstMapInfo map;
+    GstTensorMetaInfo meta;
+    tensor_type type = info->info[i].type;
+    gsize hsize = 0;
+
+    mem = gst_tensor_buffer_get_nth_memory (buffer, info, i);
+    if (mem == NULL)
+      break;
+
+    if (!gst_memory_map (mem, &map, GST_MAP_READ)) {
+      gst_memory_unref (mem);
+      break;
+    }
+
+    if (flexible) {
+      hsize = gst_tensor_meta_cache_parse (&self->meta_cache[i], map.data,
+          map.size, &meta);
+      type = meta.type;
+
+      if (hsize > 0 && dims) {
+        gchar *dim = gst_tensor_get_dimension_string (meta.dimension);
+
+        g_string_append_printf (dims, "%s%s:%s", (i > 0) ? "," : "", dim,
+            gst_tensor_get_type_string (type));
+        g_free (dim);
+      }
+    }
+
+    if (self->tensor_stats && (!flexible || hsize > 0) && map.size > hsize) {
+      _gst_tensor_debug_summarize (self, i, map.data + hsize, map.size - hsize,
+          type, msg, stats);
+    }
+
+    gst_memory_unmap (mem, &map);
+    gst_memory_unref (mem);
+  }
+
+  if (dims) {
+    if (self->cap_mode == TDBG_CAP_SHOW_ALWAYS ||
+        g_strcmp0 (dims->str, self->last_dims) != 0) {
+      g_string_append_printf (msg, "\n  dimensions: %s", dims->str);
+      g_free (self->last_dims);
+      self->last_dims = g_strdup (dims->str);
+    }
+
+    g_string_free (dims, TRUE);
+  }
+
+  gst_structure_set (stats, "nan-count", G_TYPE_UINT64, self->nan_count,
+      "inf-count", G_TYPE_UINT64, self->inf_count, NULL);
+
+  GST_OBJECT_LOCK (self);
+  if (self->stats)
+    gst_structure_free (self->stats);
+  self->stats = stats;
+  GST_OBJECT_UNLOCK (self);
+
+  _gst_tensor_debug_print (self, msg->str);
+  g_string_free (msg, TRUE);
 }
 
 /**
@@ -408,8 +733,18 @@ static GstFlowReturn
 gst_tensor_debug_transform_ip (GstBaseTransform * trans, GstBuffer * buffer)
 {
   GstTensorDebug *self = GST_TENSOR_DEBUG (trans);
+  gint64 now;
+
+  self->num_buffers++;
+  self->num_bytes += gst_buffer_get_size (buffer);
 
-  _gst_tensor_debug_output (self, buffer);
+  /* nothing to log or to summarize */
+  if (self->output_mode == TDBG_OUTPUT_DISABLED && !self->tensor_stats)
+    return GST_FLOW_OK;
+
+  now = g_get_monotonic_time ();
+  if (_gst_tensor_debug_is_sampled (self, now))
+    _gst_tensor_debug_output (self, buffer, now);
 
   return GST_FLOW_OK;
 }
@@ -435,7 +770,15 @@ static gboolean
 gst_tensor_debug_set_caps (GstBaseTransform * trans,
     GstCaps * in_caps, GstCaps * out_caps)
 {
-  UNUSED (trans);
+  GstTensorDebug *self = GST_TENSOR_DEBUG (trans);
+
+  if (!gst_caps_can_intersect (in_caps, out_caps))
+    return FALSE;
+
+  gst_tensors_config_free (&self->in_config);
+  gst_tensors_config_from_structure (&self->in_config,
+      gst_caps_get_structure (in_caps, 0));
+  self->caps_updated = TRUE;
 
-  return gst_caps_can_intersect (in_caps, out_caps);
+  return TRUE;
 }
@@ -93,6 +93,25 @@ struct _GstTensorDebug
   tdbg_output_mode output_mode;
   tdbg_cap_mode cap_mode;
   tdbg_meta_mode meta_mode;
+
+  /* sampling */
+  guint sample_interval; /**< log 1 in N buffers */
+  guint sample_time; /**< log at most once in the given time (ms), 0 to disable */
+  gboolean tensor_stats; /**< true to summarize the tensor values of the sampled buffers */
+
+  GstTensorsConfig in_config; /**< config of the incoming tensors */
+  gboolean caps_updated; /**< true if the caps is updated after the latest log */
+  gchar *last_dims; /**< the dimensions of flexible tensors in the latest log */
+  GstTensorMetaCache meta_cache[NNS_TENSOR_SIZE_LIMIT]; /**< cached layout of flexible tensors */
+
+  guint64 num_buffers; /**< the number of incoming buffers */
+  guint64 num_bytes; /**< bytes of incoming buffers */
+  guint64 num_sampled; /**< the number of sampled buffers */
+  gint64 last_sample_time; /**< the time (usec) of the latest sampled buffer */
+  guint64 last_sample_bytes; /**< num_bytes at the latest sampled buffer */
+  guint64 nan_count; /**< the number of NaN values in the sampled buffers */
+  guint64 inf_count; /**< the number of infinite values in the sampled buffers */
+  GstStructure *stats; /**< statistics of the latest sampled buffer, locked by the object lock */
 };
 
 /**
@@ -74,7 +74,9 @@ enum
   PROP_MODE_OPTION7,
   PROP_MODE_OPTION8,
   PROP_MODE_OPTION9,
-  PROP_SUBPLUGINS
+  PROP_SUBPLUGINS,
+  PROP_BATCH,
+  PROP_WORKERS
 };
 
 /**
@@ -82,6 +84,16 @@ enum
  */
 #define DEFAULT_SILENT TRUE
 
+/**
+ * @brief Default number of frames in an input buffer.
+ */
+#define DEFAULT_BATCH 1
+
+/**
+ * @brief Default number of threads to decode the buffers.
+ */
+#define DEFAULT_WORKERS 1
+
 /**
  * @brief Support multi-tensor along with single-tensor as the input
  */
@@ -125,6 +137,10 @@ static gboolean gst_tensordec_set_caps (GstBaseTransform * trans,
 static gboolean gst_tensordec_transform_size (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, gsize size,
     GstCaps * othercaps, gsize * othersize);
+static gboolean gst_tensordec_sink_event (GstBaseTransform * trans,
+    GstEvent * event);
+static gboolean gst_tensordec_stop (GstBaseTransform * trans);
+static void gst_tensordec_workers_stop (GstTensorDecoder * self);
 
 /**
  * @brief Validate decoder sub-plugin's data.
@@ -235,6 +251,48 @@ gst_tensordec_media_caps_from_tensor (GstTensorDecoder * self,
   return self->decoder->getOutCaps (&self->plugin_data, config);
 }
 
+/**
+ * @brief Get the tensor config of a single frame from the batched tensor config.
+ * @param self "this" pointer
+ * @param config tensor config info to be updated
+ * @return FALSE if the outermost dimension of a tensor is not a multiple of the batch
+ */
+static gboolean
+gst_tensordec_get_frame_config (GstTensorDecoder * self,
+    GstTensorsConfig * config)
+{
+  GstTensorInfo *info;
+  guint i, rank;
+
+  if (self->batch <= 1)
+    return TRUE;
+
+  if (gst_tensors_config_is_flexible (config)) {
+    GST_ERROR_OBJECT (self,
+        "The flexible tensor stream cannot be decoded with the property batch.");
+    return FALSE;
+  }
+
+  for (i = 0; i < config->info.num_tensors; i++) {
+    info = &config->info.info[i];
+    rank = gst_tensor_info_get_rank (info);
+
+    if (info->dimension[rank - 1] % self->batch != 0) {
+      GST_ERROR_OBJECT (self,
+          "The outermost dimension (%u) of the %u-th tensor is not a multiple of the batch (%u).",
+          info->dimension[rank - 1], i, self->batch);
+      return FALSE;
+    }
+
+    info->dimension[rank - 1] /= self->batch;
+  }
+
+  if (config->rate_n > 0)
+    config->rate_n *= self->batch;
+
+  return TRUE;
+}
+
 /**
  * @brief Parse structure and return media caps
  * @param self "this" pointer
@@ -247,7 +305,8 @@ gst_tensordec_media_caps_from_structure (GstTensorDecoder * self,
   GstTensorsConfig config;
   GstCaps *result = NULL;
 
-  if (gst_tensors_config_from_structure (&config, structure)) {
+  if (gst_tensors_config_from_structure (&config, structure) &&
+      gst_tensordec_get_frame_config (self, &config)) {
     result = gst_tensordec_media_caps_from_tensor (self, &config);
   }
 
@@ -358,6 +417,22 @@ gst_tensordec_class_init (GstTensorDecoderClass * klass)
           "Registrable sub-plugins list", "",
           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_BATCH,
+      g_param_spec_uint ("batch", "Batch",
+          "The number of frames packed along the outermost dimension of the input tensors. "
+          "Each frame is decoded and pushed in a separate buffer.",
+          1, G_MAXUINT, DEFAULT_BATCH,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_WORKERS,
+      g_param_spec_uint ("workers", "Number of workers",
+          "The number of threads to decode the independent buffers concurrently. "
+          "The output buffers are pushed in the order of incoming buffers. "
+          "This is applied only if the sub-plugin declares it is thread-safe, "
+          "otherwise the buffers are decoded in the streaming thread.",
+          1, TensorDecMaxWorkers, DEFAULT_WORKERS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_details_simple (gstelement_class,
       "TensorDecoder",
       "Converter/Tensor",
@@ -386,6 +461,10 @@ gst_tensordec_class_init (GstTensorDecoderClass * klass)
   /** Allocation units */
   trans_class->transform_size =
       GST_DEBUG_FUNCPTR (gst_tensordec_transform_size);
+
+  /** Events and states */
+  trans_class->sink_event = GST_DEBUG_FUNCPTR (gst_tensordec_sink_event);
+  trans_class->stop = GST_DEBUG_FUNCPTR (gst_tensordec_stop);
 }
 
 /**
@@ -400,6 +479,8 @@ gst_tensordec_init (GstTensorDecoder * self)
   guint i;
 
   self->silent = DEFAULT_SILENT;
+  self->batch = DEFAULT_BATCH;
+  self->num_workers = DEFAULT_WORKERS;
   self->configured = FALSE;
   self->negotiated = FALSE;
   self->decoder = NULL;
@@ -411,6 +492,11 @@ gst_tensordec_init (GstTensorDecoder * self)
     self->option[i] = NULL;
 
   gst_tensors_config_init (&self->tensor_config);
+
+  g_mutex_init (&self->workers.lock);
+  g_cond_init (&self->workers.cond);
+  g_mutex_init (&self->workers.push_lock);
+  self->workers.last_ret = GST_FLOW_OK;
 }
 
 /**
@@ -459,6 +545,12 @@ gst_tensordec_set_property (GObject * object, guint prop_id,
     case PROP_SILENT:
       self->silent = g_value_get_boolean (value);
       break;
+    case PROP_BATCH:
+      self->batch = g_value_get_uint (value);
+      break;
+    case PROP_WORKERS:
+      self->num_workers = g_value_get_uint (value);
+      break;
     case PROP_MODE:
     {
       const GstTensorDecoderDef *decoder;
@@ -547,6 +639,12 @@ gst_tensordec_get_property (GObject * object, guint prop_id,
     case PROP_SILENT:
       g_value_set_boolean (value, self->silent);
       break;
+    case PROP_BATCH:
+      g_value_set_uint (value, self->batch);
+      break;
+    case PROP_WORKERS:
+      g_value_set_uint (value, self->num_workers);
+      break;
     case PROP_MODE:
       if (self->is_custom)
         g_value_set_string (value, "custom-code");
@@ -593,6 +691,11 @@ gst_tensordec_class_finalize (GObject * object)
 
   self = GST_TENSOR_DECODER (object);
 
+  gst_tensordec_workers_stop (self);
+  g_mutex_clear (&self->workers.lock);
+  g_cond_clear (&self->workers.cond);
+  g_mutex_clear (&self->workers.push_lock);
+
   gst_tensor_decoder_clean_plugin (self);
 
   for (i = 0; i < TensorDecMaxOpNum; ++i) {
@@ -627,6 +730,10 @@ gst_tensordec_configure (GstTensorDecoder * self, const GstCaps * in_caps,
     return FALSE;
   }
 
+  /* The sub-plugin handles the tensor config of a single frame. */
+  if (!gst_tensordec_get_frame_config (self, &config))
+    return FALSE;
+
   if (self->decoder == NULL && !self->is_custom) {
     GST_ERROR_OBJECT (self, "Decoder plugin is not yet configured.");
     return FALSE;
@@ -659,6 +766,411 @@ gst_tensordec_configure (GstTensorDecoder * self, const GstCaps * in_caps,
   return TRUE;
 }
 
+/**
+ * @brief Decode the frames packed in the input tensors and push the output buffers except the last one.
+ * @details The last frame is decoded into outbuf, which is pushed by the base class. The timestamps and duration of the input buffer are divided into the frames.
+ */
+static GstFlowReturn
+gst_tensordec_decode_batch (GstTensorDecoder * self, GstBuffer * inbuf,
+    const GstTensorMemory * input, GstBuffer * outbuf)
+{
+  GstBuffer **outbufs;
+  GstTensorMemory frame[NNS_TENSOR_SIZE_LIMIT];
+  GstClockTime pts, dts, duration;
+  GstFlowReturn res = GST_FLOW_OK;
+  gsize out_size;
+  guint i, j, num_tensors, batch;
+
+  batch = self->batch;
+  num_tensors = self->tensor_config.info.num_tensors;
+
+  for (j = 0; j < num_tensors; j++) {
+    if (input[j].size % batch != 0) {
+      GST_ERROR_OBJECT (self,
+          "The size of the %u-th tensor (%zd) is not a multiple of the batch (%u).",
+          j, input[j].size, batch);
+      return GST_FLOW_ERROR;
+    }
+  }
+
+  if (self->is_custom && self->custom.func == NULL) {
+    GST_ERROR_OBJECT (self, "Custom decoder callback is not registered.");
+    return GST_FLOW_ERROR;
+  }
+
+  pts = GST_BUFFER_PTS (inbuf);
+  dts = GST_BUFFER_DTS (inbuf);
+  duration = GST_BUFFER_DURATION (inbuf);
+  if (GST_CLOCK_TIME_IS_VALID (duration))
+    duration /= batch;
+
+  out_size = gst_buffer_get_size (outbuf);
+  outbufs = g_new0 (GstBuffer *, batch);
+
+  for (i = 0; i < batch; i++) {
+    if (i == batch - 1) {
+      outbufs[i] = outbuf;
+    } else {
+      outbufs[i] = (out_size > 0) ?
+          gst_buffer_new_allocate (NULL, out_size, NULL) : gst_buffer_new ();
+      nns_profile_alloc (self, out_size);
+
+      if (outbufs[i] == NULL) {
+        ml_loge ("Failed to allocate the output buffer of the %u-th frame.", i);
+        res = GST_FLOW_ERROR;
+        break;
+      }
+
+      gst_buffer_copy_into (outbufs[i], outbuf, GST_BUFFER_COPY_METADATA, 0,
+          -1);
+    }
+
+    if (GST_CLOCK_TIME_IS_VALID (duration)) {
+      if (GST_CLOCK_TIME_IS_VALID (pts))
+        GST_BUFFER_PTS (outbufs[i]) = pts + i * duration;
+      if (GST_CLOCK_TIME_IS_VALID (dts))
+        GST_BUFFER_DTS (outbufs[i]) = dts + i * duration;
+      GST_BUFFER_DURATION (outbufs[i]) = duration;
+    }
+  }
+
+  if (res != GST_FLOW_OK) {
+    /* do nothing, release the allocated buffers */
+  } else if (!self->is_custom && self->decoder->decodeBatch) {
+    res = self->decoder->decodeBatch (&self->plugin_data, &self->tensor_config,
+        input, batch, outbufs);
+  } else {
+    for (i = 0; i < batch && res == GST_FLOW_OK; i++) {
+      for (j = 0; j < num_tensors; j++) {
+        frame[j].size = input[j].size / batch;
+        frame[j].data = (guint8 *) input[j].data + i * frame[j].size;
+      }
+
+      if (!self->is_custom) {
+        res = self->decoder->decode (&self->plugin_data, &self->tensor_config,
+            frame, outbufs[i]);
+      } else {
+        res = self->custom.func (frame, &self->tensor_config,
+            self->custom.data, outbufs[i]);
+      }
+    }
+  }
+
+  for (i = 0; i < batch - 1 && outbufs[i] != NULL; i++) {
+    if (res == GST_FLOW_OK)
+      res = gst_pad_push (GST_BASE_TRANSFORM_SRC_PAD (self), outbufs[i]);
+    else
+      gst_buffer_unref (outbufs[i]);
+  }
+
+  g_free (outbufs);
+  return res;
+}
+
+/**
+ * @brief Decode the input buffer into outbuf with the sub-plugin (or custom callback).
+ */
+static GstFlowReturn
+gst_tensordec_decode_buffer (GstTensorDecoder * self, GstBuffer * inbuf,
+    GstBuffer * outbuf)
+{
+  GstMemory *in_mem[NNS_TENSOR_SIZE_LIMIT];
+  GstMapInfo in_info[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT];
+  GstFlowReturn res;
+  guint i, num_tensors;
+  nns_profile_declare (start);
+
+  if (gst_tensors_config_is_flexible (&self->tensor_config)) {
+    self->tensor_config.info.num_tensors = gst_buffer_n_memory (inbuf);
+  }
+  num_tensors = self->tensor_config.info.num_tensors;
+  /** Internal logic error. Negotation process should prevent this! */
+  g_assert (gst_buffer_n_memory (inbuf) == num_tensors);
+
+  for (i = 0; i < num_tensors; i++)
+    in_mem[i] = gst_buffer_peek_memory (inbuf, i);
+
+  nns_profile_compute_begin (start);
+
+  /* The sub-plugin may use the input memory without copying the data. */
+  if (!self->is_custom && self->decoder->decodeMemory && self->batch <= 1) {
+    res = self->decoder->decodeMemory (&self->plugin_data,
+        &self->tensor_config, in_mem, num_tensors, outbuf);
+    if (res != GST_FLOW_NOT_SUPPORTED) {
+      nns_profile_compute_end (self, start);
+      return res;
+    }
+  }
+
+  for (i = 0; i < num_tensors; i++) {
+    if (!gst_memory_map (in_mem[i], &in_info[i], GST_MAP_READ)) {
+      guint j;
+      ml_logf ("Failed to map in_mem[%u].\n", i);
+
+      for (j = 0; j < i; j++)
+        gst_memory_unmap (in_mem[j], &in_info[j]);
+      return GST_FLOW_ERROR;
+    }
+
+    input[i].data = in_info[i].data;
+    input[i].size = in_info[i].size;
+  }
+  if (self->batch > 1) {
+    res = gst_tensordec_decode_batch (self, inbuf, input, outbuf);
+  } else if (!self->is_custom) {
+    res = self->decoder->decode (&self->plugin_data, &self->tensor_config,
+        input, outbuf);
+  } else if (self->custom.func != NULL) {
+    res = self->custom.func (input, &self->tensor_config, self->custom.data,
+        outbuf);
+  } else {
+    GST_ERROR_OBJECT (self, "Custom decoder callback is not registered.");
+    res = GST_FLOW_ERROR;
+  }
+
+  nns_profile_compute_end (self, start);
+
+  for (i = 0; i < num_tensors; i++)
+    gst_memory_unmap (in_mem[i], &in_info[i]);
+
+  return res;
+}
+
+/**
+ * @brief Data structure of a buffer queued to the worker threads.
+ */
+typedef struct
+{
+  GstBuffer *inbuf; /**< the input buffer */
+  GstBuffer *outbuf; /**< the output buffer with the metadata of the input buffer */
+  guint64 seq; /**< sequence number of the incoming buffer */
+} GstTensorDecoderWorkerJob;
+
+/**
+ * @brief Push the decoded outputs downstream in the order of incoming buffers.
+ */
+static void
+gst_tensordec_workers_push_ready (GstTensorDecoder * self)
+{
+  GstTensorDecoderWorkers *workers = &self->workers;
+  GstTensorDecoderWorkerSlot *slot;
+  GstBuffer *outbuf;
+  GstFlowReturn ret;
+  gboolean flushing;
+
+  g_mutex_lock (&workers->push_lock);
+  g_mutex_lock (&workers->lock);
+
+  while (workers->seq_out < workers->seq_in) {
+    slot = &workers->slots[workers->seq_out % workers->num_slots];
+    if (!slot->done)
+      break;
+
+    outbuf = slot->outbuf;
+    slot->outbuf = NULL;
+    slot->done = FALSE;
+    flushing = workers->flushing;
+    g_mutex_unlock (&workers->lock);
+
+    ret = GST_FLOW_OK;
+    if (outbuf) {
+      if (flushing)
+        gst_buffer_unref (outbuf);
+      else
+        ret = gst_pad_push (GST_BASE_TRANSFORM_SRC_PAD (self), outbuf);
+    }
+
+    g_mutex_lock (&workers->lock);
+    if (ret != GST_FLOW_OK && workers->last_ret == GST_FLOW_OK)
+      workers->last_ret = ret;
+    workers->seq_out++;
+    g_cond_broadcast (&workers->cond);
+  }
+
+  g_mutex_unlock (&workers->lock);
+  g_mutex_unlock (&workers->push_lock);
+}
+
+/**
+ * @brief Worker thread function to decode the queued buffer.
+ */
+static void
+gst_tensordec_workers_decode (gpointer data, gpointer user_data)
+{
+  GstTensorDecoderWorkerJob *job = (GstTensorDecoderWorkerJob *) data;
+  GstTensorDecoder *self = GST_TENSOR_DECODER_CAST (user_data);
+  GstTensorDecoderWorkers *workers = &self->workers;
+  GstTensorDecoderWorkerSlot *slot;
+  GstFlowReturn ret;
+
+  ret = gst_tensordec_decode_buffer (self, job->inbuf, job->outbuf);
+  gst_buffer_unref (job->inbuf);
+
+  if (ret != GST_FLOW_OK) {
+    gst_buffer_unref (job->outbuf);
+    job->outbuf = NULL;
+  }
+
+  g_mutex_lock (&workers->lock);
+  if (ret != GST_FLOW_OK && ret != GST_BASE_TRANSFORM_FLOW_DROPPED &&
+      workers->last_ret == GST_FLOW_OK)
+    workers->last_ret = ret;
+
+  slot = &workers->slots[job->seq % workers->num_slots];
+  slot->outbuf = job->outbuf;
+  slot->done = TRUE;
+  g_mutex_unlock (&workers->lock);
+
+  g_free (job);
+  gst_tensordec_workers_push_ready (self);
+}
+
+/**
+ * @brief Dispatch the incoming buffer to the worker threads.
+ * @details The base class unrefs outbuf after transform, the worker decodes the buffer into a new output buffer with the same size and metadata.
+ * @return GST_BASE_TRANSFORM_FLOW_DROPPED because the output is pushed by the worker.
+ */
+static GstFlowReturn
+gst_tensordec_workers_submit (GstTensorDecoder * self, GstBuffer * inbuf,
+    GstBuffer * outbuf)
+{
+  GstTensorDecoderWorkers *workers = &self->workers;
+  GstTensorDecoderWorkerJob *job;
+  GstBuffer *job_outbuf;
+  GstFlowReturn ret;
+  gsize out_size;
+
+  g_mutex_lock (&workers->lock);
+  /* limit the number of buffers in flight */
+  while (workers->last_ret == GST_FLOW_OK &&
+      workers->seq_in - workers->seq_out >= workers->num_slots)
+    g_cond_wait (&workers->cond, &workers->lock);
+
+  ret = workers->last_ret;
+  g_mutex_unlock (&workers->lock);
+  if (ret != GST_FLOW_OK)
+    return ret;
+
+  out_size = gst_buffer_get_size (outbuf);
+  job_outbuf = (out_size > 0) ?
+      gst_buffer_new_allocate (NULL, out_size, NULL) : gst_buffer_new ();
+  if (job_outbuf == NULL) {
+    ml_loge ("Failed to allocate the output buffer for the worker.");
+    return GST_FLOW_ERROR;
+  }
+  nns_profile_alloc (self, out_size);
+  gst_buffer_copy_into (job_outbuf, outbuf, GST_BUFFER_COPY_METADATA, 0, -1);
+
+  job = g_new0 (GstTensorDecoderWorkerJob, 1);
+  job->inbuf = gst_buffer_ref (inbuf);
+  job->outbuf = job_outbuf;
+
+  g_mutex_lock (&workers->lock);
+  job->seq = workers->seq_in++;
+  g_mutex_unlock (&workers->lock);
+
+  g_thread_pool_push (workers->pool, job, NULL);
+  return GST_BASE_TRANSFORM_FLOW_DROPPED;
+}
+
+/**
+ * @brief Wait until all buffers in flight are pushed (or discarded).
+ */
+static void
+gst_tensordec_workers_drain (GstTensorDecoder * self)
+{
+  GstTensorDecoderWorkers *workers = &self->workers;
+
+  g_mutex_lock (&workers->lock);
+  while (workers->seq_out < workers->seq_in)
+    g_cond_wait (&workers->cond, &workers->lock);
+  g_mutex_unlock (&workers->lock);
+}
+
+/**
+ * @brief Start the worker threads if the negotiated stream can be decoded concurrently.
+ * @return TRUE if workers are ready (or not required).
+ */
+static gboolean
+gst_tensordec_workers_start (GstTensorDecoder * self)
+{
+  GstTensorDecoderWorkers *workers = &self->workers;
+  GError *error = NULL;
+
+  if (self->num_workers <= 1 || workers->pool)
+    return TRUE;
+
+  if (self->is_custom || !self->decoder || !self->decoder->threadSafe) {
+    GST_WARNING_OBJECT (self,
+        "The decoder sub-plugin is not thread-safe, tensor-decoder decodes the buffers in the streaming thread.");
+    return TRUE;
+  }
+
+  /* the frames in a batch and the flexible tensors are decoded in the streaming thread */
+  if (self->batch > 1 || gst_tensors_config_is_flexible (&self->tensor_config)) {
+    GST_INFO_OBJECT (self,
+        "Cannot decode the batch or flexible tensors concurrently, tensor-decoder decodes the buffers in the streaming thread.");
+    return TRUE;
+  }
+
+  workers->num_slots = self->num_workers * 2;
+  workers->slots = g_new0 (GstTensorDecoderWorkerSlot, workers->num_slots);
+  workers->seq_in = workers->seq_out = 0;
+  workers->flushing = FALSE;
+  workers->last_ret = GST_FLOW_OK;
+
+  workers->pool = g_thread_pool_new (gst_tensordec_workers_decode, self,
+      (gint) self->num_workers, TRUE, &error);
+  if (!workers->pool) {
+    GST_ELEMENT_ERROR (self, RESOURCE, FAILED,
+        ("Failed to create the worker threads: %s",
+            error ? error->message : "unknown error"), (NULL));
+    g_clear_error (&error);
+    g_free (workers->slots);
+    workers->slots = NULL;
+    workers->num_slots = 0;
+    return FALSE;
+  }
+
+  GST_INFO_OBJECT (self, "Started %u workers to decode the buffers.",
+      self->num_workers);
+  return TRUE;
+}
+
+/**
+ * @brief Stop the worker threads and release the pending outputs.
+ */
+static void
+gst_tensordec_workers_stop (GstTensorDecoder * self)
+{
+  GstTensorDecoderWorkers *workers = &self->workers;
+  guint i;
+
+  if (!workers->pool)
+    return;
+
+  g_mutex_lock (&workers->lock);
+  workers->flushing = TRUE;
+  g_cond_broadcast (&workers->cond);
+  g_mutex_unlock (&workers->lock);
+
+  /* wait for the queued jobs */
+  g_thread_pool_free (workers->pool, FALSE, TRUE);
+  workers->pool = NULL;
+
+  for (i = 0; i < workers->num_slots; i++) {
+    if (workers->slots[i].outbuf)
+      gst_buffer_unref (workers->slots[i].outbuf);
+  }
+  g_free (workers->slots);
+  workers->slots = NULL;
+  workers->num_slots = 0;
+  workers->seq_in = workers->seq_out = 0;
+  workers->flushing = FALSE;
+  workers->last_ret = GST_FLOW_OK;
+}
+
 /**
  * @brief non-ip transform. required vmethod for BaseTransform class.
  */
@@ -667,7 +1179,6 @@ gst_tensordec_transform (GstBaseTransform * trans,
     GstBuffer * inbuf, GstBuffer * outbuf)
 {
   GstTensorDecoder *self;
-  GstFlowReturn res;
 
   self = GST_TENSOR_DECODER_CAST (trans);
 
@@ -677,51 +1188,16 @@ gst_tensordec_transform (GstBaseTransform * trans,
     goto unknown_format;
 
   if (self->decoder || self->is_custom) {
-    GstMemory *in_mem[NNS_TENSOR_SIZE_LIMIT];
-    GstMapInfo in_info[NNS_TENSOR_SIZE_LIMIT];
-    GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT];
-    guint i, num_tensors;
+    if (self->workers.pool)
+      return gst_tensordec_workers_submit (self, inbuf, outbuf);
 
-    if (gst_tensors_config_is_flexible (&self->tensor_config)) {
-      self->tensor_config.info.num_tensors = gst_buffer_n_memory (inbuf);
-    }
-    num_tensors = self->tensor_config.info.num_tensors;
-    /** Internal logic error. Negotation process should prevent this! */
-    g_assert (gst_buffer_n_memory (inbuf) == num_tensors);
-
-    for (i = 0; i < num_tensors; i++) {
-      in_mem[i] = gst_buffer_peek_memory (inbuf, i);
-      if (!gst_memory_map (in_mem[i], &in_info[i], GST_MAP_READ)) {
-        guint j;
-        ml_logf ("Failed to map in_mem[%u].\n", i);
-
-        for (j = 0; j < i; j++)
-          gst_memory_unmap (in_mem[j], &in_info[j]);
-        return GST_FLOW_ERROR;
-      }
-
-      input[i].data = in_info[i].data;
-      input[i].size = in_info[i].size;
-    }
-    if (!self->is_custom) {
-      res = self->decoder->decode (&self->plugin_data, &self->tensor_config,
-          input, outbuf);
-    } else if (self->custom.func != NULL) {
-      res = self->custom.func (input, &self->tensor_config, self->custom.data,
-          outbuf);
-    } else {
-      GST_ERROR_OBJECT (self, "Custom decoder callback is not registered.");
-      res = GST_FLOW_ERROR;
-    }
-
-    for (i = 0; i < num_tensors; i++)
-      gst_memory_unmap (in_mem[i], &in_info[i]);
-  } else {
-    GST_ERROR_OBJECT (self, "Decoder plugin not yet configured.");
-    goto unknown_type;
+    return gst_tensordec_decode_buffer (self, inbuf, outbuf);
   }
 
-  return res;
+  GST_ERROR_OBJECT (self, "Decoder plugin not yet configured.");
+  GST_ELEMENT_ERROR (self, CORE, NOT_IMPLEMENTED, (NULL),
+      ("not implemented decoder mode"));
+  return GST_FLOW_NOT_SUPPORTED;
 
 unknown_format:
   GST_ERROR_OBJECT (self, "Hit unknown_format");
@@ -732,10 +1208,6 @@ unknown_tensor:
   GST_ELEMENT_ERROR (self, CORE, NOT_IMPLEMENTED, (NULL),
       ("unknown format for tensor"));
   return GST_FLOW_NOT_NEGOTIATED;
-unknown_type:
-  GST_ELEMENT_ERROR (self, CORE, NOT_IMPLEMENTED, (NULL),
-      ("not implemented decoder mode"));
-  return GST_FLOW_NOT_SUPPORTED;
 }
 
 /**
@@ -897,6 +1369,11 @@ gst_tensordec_set_caps (GstBaseTransform * trans,
     gst_caps_unref (supposed);
   }
 
+  /* The serialized caps event drained the buffers in flight, restart the workers with new config. */
+  gst_tensordec_workers_stop (self);
+  if (self->negotiated && !gst_tensordec_workers_start (self))
+    return FALSE;
+
   return self->negotiated;
 }
 
@@ -928,6 +1405,49 @@ gst_tensordec_transform_size (GstBaseTransform * trans,
   return TRUE;
 }
 
+/**
+ * @brief Event handler for sink pad of tensor decoder.
+ */
+static gboolean
+gst_tensordec_sink_event (GstBaseTransform * trans, GstEvent * event)
+{
+  GstTensorDecoder *self = GST_TENSOR_DECODER_CAST (trans);
+  GstTensorDecoderWorkers *workers = &self->workers;
+
+  if (workers->pool) {
+    if (GST_EVENT_TYPE (event) == GST_EVENT_FLUSH_START) {
+      g_mutex_lock (&workers->lock);
+      workers->flushing = TRUE;
+      g_cond_broadcast (&workers->cond);
+      g_mutex_unlock (&workers->lock);
+    } else if (GST_EVENT_IS_SERIALIZED (event)) {
+      /* keep the order of serialized events and the outputs in flight */
+      gst_tensordec_workers_drain (self);
+
+      if (GST_EVENT_TYPE (event) == GST_EVENT_FLUSH_STOP) {
+        g_mutex_lock (&workers->lock);
+        workers->flushing = FALSE;
+        workers->last_ret = GST_FLOW_OK;
+        g_mutex_unlock (&workers->lock);
+      }
+    }
+  }
+
+  return GST_BASE_TRANSFORM_CLASS (parent_class)->sink_event (trans, event);
+}
+
+/**
+ * @brief Called when the element stops processing. optional vmethod of BaseTransform.
+ */
+static gboolean
+gst_tensordec_stop (GstBaseTransform * trans)
+{
+  GstTensorDecoder *self = GST_TENSOR_DECODER_CAST (trans);
+
+  gst_tensordec_workers_stop (self);
+  return TRUE;
+}
+
 /**
  * @brief Registers a callback for tensor_decoder custom condition
  * @return 0 if success. -ERRNO if error.
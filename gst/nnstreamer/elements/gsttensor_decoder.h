@@ -61,6 +61,37 @@ typedef struct
 
 #define TensorDecMaxOpNum (9)
 
+/**
+ * @brief The max number of worker threads to decode the buffers.
+ */
+#define TensorDecMaxWorkers (64)
+
+/**
+ * @brief Output slot of a buffer decoded by the worker.
+ */
+typedef struct
+{
+  GstBuffer *outbuf; /**< the output buffer (NULL if the buffer is dropped) */
+  gboolean done; /**< TRUE if the worker has finished the buffer */
+} GstTensorDecoderWorkerSlot;
+
+/**
+ * @brief Data structure for concurrent decoding (workers > 1).
+ */
+typedef struct
+{
+  GThreadPool *pool; /**< worker threads to decode the buffers */
+  GMutex lock; /**< mutex for the sequence numbers and output slots */
+  GCond cond; /**< signaled when an output is pushed */
+  GMutex push_lock; /**< serializes pushing the outputs downstream */
+  GstTensorDecoderWorkerSlot *slots; /**< ring of output slots indexed by sequence number */
+  guint num_slots; /**< the max number of buffers in flight */
+  guint64 seq_in; /**< sequence number of the next incoming buffer */
+  guint64 seq_out; /**< sequence number of the next buffer to be pushed */
+  gboolean flushing; /**< TRUE if pending outputs should be discarded */
+  GstFlowReturn last_ret; /**< the last flow return of pushing the outputs */
+} GstTensorDecoderWorkers;
+
 /**
  * @brief Internal data structure for tensordec instances.
  */
@@ -71,6 +102,8 @@ struct _GstTensorDecoder
   /** For transformer */
   gboolean negotiated; /**< TRUE if tensor metadata is set */
   gboolean silent; /**< True if logging is minimized */
+  guint batch; /**< The number of frames packed in the input tensors */
+  guint num_workers; /**< The number of threads to decode the buffers concurrently */
   gchar *option[TensorDecMaxOpNum]; /**< Assume we have two options */
 
   /** For Tensor */
@@ -83,6 +116,8 @@ struct _GstTensorDecoder
 
   const GstTensorDecoderDef *decoder; /**< Plugin object */
   void *plugin_data;
+
+  GstTensorDecoderWorkers workers; /**< worker threads for concurrent decoding */
 };
 
 /**
@@ -63,6 +63,25 @@
  *        d.src_1 ! queue ! do whatever you want here...
  *        ...
  * </refsect2>
+ *
+ * If the stream is routed with several conditions of the same compared value
+ * (e.g., the ranges of a score), the conditions may be given with the
+ * conditions property instead of a chain of tensor-if elements.
+ * The compared value is calculated once, and the buffer is passed to src_n
+ * with THEN action if the n-th condition is the first condition that is TRUE.
+ * If none of the conditions is TRUE, the buffer is passed to the last src pad
+ * (src_N with N conditions) with ELSE action.
+ * <refsect2>
+ * <title>Example launch line with multiple conditions</title>
+ * gst-launch ... (some tensor stream) !
+ *      tensor_if name=tif
+ *        compared-value=TENSOR_MAX_VALUE compared-value-option=0
+ *        conditions="GE:0.8;RANGE_INCLUSIVE:0.5,0.8"
+ *        then=PASSTHROUGH
+ *        else=SKIP
+ *      tif.src_0 ! queue ! (tensor(s) stream for max >= 0.8) ...
+ *      tif.src_1 ! queue ! (tensor(s) stream for 0.5 <= max <= 0.8) ...
+ * </refsect2>
  */
 #ifdef HAVE_CONFIG_H
 #include <config.h>
@@ -97,6 +116,7 @@ enum
   PROP_THEN_OPTION, /**< Option for TRUE Action */
   PROP_ELSE, /**< Action if it is FALSE */
   PROP_ELSE_OPTION, /**< Option for FALSE Action */
+  PROP_CONDITIONS, /**< Conditions of the multi-condition mode */
 };
 
 GST_DEBUG_CATEGORY_STATIC (gst_tensor_if_debug);
@@ -152,6 +172,10 @@ gst_tensor_if_cv_get_type (void)
       {TIFCV_TENSOR_AVERAGE_VALUE, "TENSOR_AVERAGE_VALUE",
           "Decide based on a average value of a specific tensor"},
       {TIFCV_CUSTOM, "CUSTOM", "Decide based on a user defined callback"},
+      {TIFCV_TENSOR_MAX_VALUE, "TENSOR_MAX_VALUE",
+          "Decide based on a max value of a specific tensor"},
+      {TIFCV_TENSOR_MIN_VALUE, "TENSOR_MIN_VALUE",
+          "Decide based on a min value of a specific tensor"},
       {0, NULL, NULL},
     };
     mode_type = g_enum_register_static ("tensor_if_compared_value", mode_types);
@@ -259,10 +283,12 @@ gst_tensor_if_class_init (GstTensorIfClass * klass)
 static void
 gst_tensor_if_init (GstTensorIf * tensor_if)
 {
+  guint i;
+
   tensor_if->silent = TRUE;
   gst_tensors_config_init (&tensor_if->in_config);
-  gst_tensors_config_init (&tensor_if->out_config[0]);
-  gst_tensors_config_init (&tensor_if->out_config[1]);
+  for (i = 0; i <= TENSOR_IF_MAX_CONDITIONS; i++)
+    gst_tensors_config_init (&tensor_if->out_config[i]);
 
   tensor_if->sinkpad = gst_pad_new_from_static_template (&sink_factory, "sink");
   gst_element_add_pad (GST_ELEMENT_CAST (tensor_if), tensor_if->sinkpad);
@@ -278,6 +304,9 @@ gst_tensor_if_init (GstTensorIf * tensor_if)
   tensor_if->else_option = NULL;
   memset (tensor_if->sv, 0, sizeof (tensor_if_sv_s) * 2);
   memset (&tensor_if->custom, 0, sizeof (custom_cb_s));
+  memset (&tensor_if->cond, 0, sizeof (tensor_if_cond_s));
+  memset (tensor_if->conds, 0, sizeof (tensor_if->conds));
+  tensor_if->num_conds = 0;
   tensor_if->custom_configured = FALSE;
 
   g_mutex_init (&tensor_if->lock);
@@ -391,21 +420,28 @@ gst_tensor_if_set_property_cv_option (const GValue * value, GList ** prop_list)
 }
 
 /**
- * @brief Convert GValue to GList according to delimiters
+ * @brief Parse the supplied values according to delimiters
  */
-static void
-gst_tensor_if_set_property_supplied_value (const GValue * value,
-    tensor_if_sv_s * sv, const gchar * delimiters)
+static gboolean
+gst_tensor_if_parse_supplied_value (const gchar * param, tensor_if_sv_s * sv,
+    const gchar * delimiters)
 {
-  gint i;
+  gint i, num;
   gboolean is_float = FALSE;
-  const gchar *param = g_value_get_string (value);
-  gchar **strv = g_strsplit_set (param, delimiters, -1);
-  gint num = g_strv_length (strv);
+  gchar **strv;
 
   if (!param) {
     ml_loge ("Invalid supplied value. The value is NULL.");
-    return;
+    return FALSE;
+  }
+
+  strv = g_strsplit_set (param, delimiters, -1);
+  num = g_strv_length (strv);
+  if (num > 2) {
+    ml_loge ("Invalid supplied value %s. It should be 'SV' or 'SV1,SV2'.",
+        param);
+    g_strfreev (strv);
+    return FALSE;
   }
 
   if (strchr (param, '.') || strchr (param, 'E') || strchr (param, 'e')) {
@@ -423,6 +459,77 @@ gst_tensor_if_set_property_supplied_value (const GValue * value,
     }
   }
   g_strfreev (strv);
+  return TRUE;
+}
+
+/**
+ * @brief Convert GValue to supplied value according to delimiters
+ */
+static void
+gst_tensor_if_set_property_supplied_value (const GValue * value,
+    tensor_if_sv_s * sv, const gchar * delimiters)
+{
+  gst_tensor_if_parse_supplied_value (g_value_get_string (value), sv,
+      delimiters);
+}
+
+/**
+ * @brief Convert GValue to the conditions of the multi-condition mode
+ * @details The conditions are given as 'OP:SV[,SV2];OP:SV[,SV2];...', e.g., 'GE:0.8;RANGE_INCLUSIVE:0.5,0.8'.
+ *          An empty string disables the multi-condition mode.
+ */
+static void
+gst_tensor_if_set_property_conditions (GstTensorIf * self,
+    const GValue * value)
+{
+  const gchar *param = g_value_get_string (value);
+  GEnumClass *op_class;
+  gchar **strv;
+  guint i, num;
+
+  self->num_conds = 0;
+  memset (self->conds, 0, sizeof (self->conds));
+
+  if (!param || param[0] == '\0')
+    return;
+
+  strv = g_strsplit (param, ";", -1);
+  num = g_strv_length (strv);
+  if (num > TENSOR_IF_MAX_CONDITIONS) {
+    ml_loge ("Too many conditions (%u), the max is %d.", num,
+        TENSOR_IF_MAX_CONDITIONS);
+    g_strfreev (strv);
+    return;
+  }
+
+  op_class = g_type_class_ref (GST_TYPE_TENSOR_IF_OP);
+
+  for (i = 0; i < num; i++) {
+    gchar **cond = g_strsplit (g_strstrip (strv[i]), ":", 2);
+    GEnumValue *op = NULL;
+
+    if (g_strv_length (cond) == 2) {
+      op = g_enum_get_value_by_name (op_class, cond[0]);
+      if (!op)
+        op = g_enum_get_value_by_nick (op_class, cond[0]);
+    }
+
+    if (!op || !gst_tensor_if_parse_supplied_value (cond[1],
+            &self->conds[i].sv, ",")) {
+      ml_loge ("Invalid condition '%s'. It should be in the form of 'OP:SV' or 'OP:SV1,SV2'.",
+          strv[i]);
+      g_strfreev (cond);
+      self->num_conds = 0;
+      break;
+    }
+
+    self->conds[i].op = (tensor_if_operator) op->value;
+    self->num_conds = i + 1;
+    g_strfreev (cond);
+  }
+
+  g_type_class_unref (op_class);
+  g_strfreev (strv);
 }
 
 /**
@@ -455,6 +562,18 @@ gst_tensor_if_set_property (GObject * object, guint prop_id,
 {
   GstTensorIf *self = GST_TENSOR_IF (object);
 
+  switch (prop_id) {
+    case PROP_CV:
+    case PROP_CV_OPTION:
+    case PROP_SV:
+    case PROP_CONDITIONS:
+      /* compile the condition again with new value */
+      self->cond.compiled = FALSE;
+      break;
+    default:
+      break;
+  }
+
   switch (prop_id) {
     case PROP_CV:
       self->cv = g_value_get_enum (value);
@@ -484,6 +603,9 @@ gst_tensor_if_set_property (GObject * object, guint prop_id,
     case PROP_ELSE_OPTION:
       gst_tensor_if_set_property_glist (value, &self->else_option, ",");
       break;
+    case PROP_CONDITIONS:
+      gst_tensor_if_set_property_conditions (self, value);
+      break;
     case PROP_SILENT:
       self->silent = g_value_get_boolean (value);
       break;
@@ -538,20 +660,18 @@ gst_tensor_if_property_to_string (GValue * value, GList * prop_list,
 }
 
 /**
- * @brief Convert GValue to supplied value according to delimiters
+ * @brief Convert supplied value to a string
  */
-static void
-gst_tensor_if_get_property_supplied_value (GValue * value, tensor_if_sv_s * sv)
+static gchar *
+gst_tensor_if_supplied_value_to_string (const tensor_if_sv_s * sv)
 {
   guint i;
   gchar *p;
   GPtrArray *arr;
   gchar **strings;
 
-  if (sv == NULL || sv->num == 0) {
-    g_value_set_string (value, "");
-    return;
-  }
+  if (sv == NULL || sv->num == 0)
+    return g_strdup ("");
 
   arr = g_ptr_array_new ();
   for (i = 0; i < sv->num; i++) {
@@ -566,7 +686,42 @@ gst_tensor_if_get_property_supplied_value (GValue * value, tensor_if_sv_s * sv)
   strings = (gchar **) g_ptr_array_free (arr, FALSE);
   p = g_strjoinv (",", strings);
   g_strfreev (strings);
-  g_value_take_string (value, p);
+  return p;
+}
+
+/**
+ * @brief Convert supplied value to GValue
+ */
+static void
+gst_tensor_if_get_property_supplied_value (GValue * value, tensor_if_sv_s * sv)
+{
+  g_value_take_string (value, gst_tensor_if_supplied_value_to_string (sv));
+}
+
+/**
+ * @brief Convert the conditions of the multi-condition mode to GValue
+ */
+static void
+gst_tensor_if_get_property_conditions (GstTensorIf * self, GValue * value)
+{
+  GEnumClass *op_class;
+  GString *str;
+  guint i;
+
+  op_class = g_type_class_ref (GST_TYPE_TENSOR_IF_OP);
+  str = g_string_new (NULL);
+
+  for (i = 0; i < self->num_conds; i++) {
+    GEnumValue *op = g_enum_get_value (op_class, self->conds[i].op);
+    gchar *sv = gst_tensor_if_supplied_value_to_string (&self->conds[i].sv);
+
+    g_string_append_printf (str, "%s%s:%s", (i > 0) ? ";" : "",
+        op ? op->value_name : "", sv);
+    g_free (sv);
+  }
+
+  g_type_class_unref (op_class);
+  g_value_take_string (value, g_string_free (str, FALSE));
 }
 
 /**
@@ -607,6 +762,9 @@ gst_tensor_if_get_property (GObject * object, guint prop_id,
     case PROP_ELSE_OPTION:
       gst_tensor_if_property_to_string (value, self->else_option, prop_id);
       break;
+    case PROP_CONDITIONS:
+      gst_tensor_if_get_property_conditions (self, value);
+      break;
     case PROP_SILENT:
       g_value_set_boolean (value, self->silent);
       break;
@@ -664,6 +822,14 @@ gst_tensor_if_install_properties (GObjectClass * gobject_class)
   g_object_class_install_property (gobject_class, PROP_ELSE_OPTION,
       g_param_spec_string ("else-option", "ELSE_OPTION",
           "Pick tensor ", "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_CONDITIONS,
+      g_param_spec_string ("conditions", "CONDITIONS",
+          "Multiple conditions 'OP:SV[,SV2];OP:SV[,SV2];...' of the compared value. "
+          "The buffer is passed to src_n if n-th condition is the first TRUE condition, "
+          "or to the last src pad with else action if none of the conditions is TRUE. "
+          "Operator and supplied-value are ignored if this is set.", "",
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 /**
@@ -682,6 +848,9 @@ gst_tensor_if_parse_caps (GstTensorIf * tensor_if, GstCaps * caps)
   structure = gst_caps_get_structure (caps, 0);
   gst_tensors_config_from_structure (config, structure);
 
+  /* compile the condition with new tensors info */
+  tensor_if->cond.compiled = FALSE;
+
   return gst_tensors_config_validate (config);
 }
 
@@ -832,59 +1001,41 @@ done:
  */
 static gboolean
 gst_tensor_if_get_comparison_result (GstTensorIf * tensor_if,
-    tensor_data_s * cv, gboolean * result)
+    tensor_data_s * cv, tensor_if_operator op, const tensor_element * sv,
+    gboolean * result)
 {
   gboolean ret = FALSE;
-  tensor_data_s svtc_1, svtc_2;
-
-  svtc_1.type = tensor_if->sv->type;
-  svtc_1.data = tensor_if->sv->data[0];
-  gst_tensor_data_typecast (&svtc_1, cv->type);
-
-  svtc_2.type = tensor_if->sv->type;
-  svtc_2.data = tensor_if->sv->data[1];
-  gst_tensor_data_typecast (&svtc_2, cv->type);
 
   switch (cv->type) {
     case _NNS_INT32:
-      operator_func (cv->data, int32_t, tensor_if->op, svtc_1.data, svtc_2.data,
-          ret);
+      operator_func (cv->data, int32_t, op, sv[0], sv[1], ret);
       break;
     case _NNS_UINT32:
-      operator_func (cv->data, uint32_t, tensor_if->op, svtc_1.data,
-          svtc_2.data, ret);
+      operator_func (cv->data, uint32_t, op, sv[0], sv[1], ret);
       break;
     case _NNS_INT16:
-      operator_func (cv->data, int16_t, tensor_if->op, svtc_1.data, svtc_2.data,
-          ret);
+      operator_func (cv->data, int16_t, op, sv[0], sv[1], ret);
       break;
     case _NNS_UINT16:
-      operator_func (cv->data, uint16_t, tensor_if->op, svtc_1.data,
-          svtc_2.data, ret);
+      operator_func (cv->data, uint16_t, op, sv[0], sv[1], ret);
       break;
     case _NNS_INT8:
-      operator_func (cv->data, int8_t, tensor_if->op, svtc_1.data, svtc_2.data,
-          ret);
+      operator_func (cv->data, int8_t, op, sv[0], sv[1], ret);
       break;
     case _NNS_UINT8:
-      operator_func (cv->data, uint8_t, tensor_if->op, svtc_1.data, svtc_2.data,
-          ret);
+      operator_func (cv->data, uint8_t, op, sv[0], sv[1], ret);
       break;
     case _NNS_FLOAT64:
-      operator_func (cv->data, double, tensor_if->op, svtc_1.data, svtc_2.data,
-          ret);
+      operator_func (cv->data, double, op, sv[0], sv[1], ret);
       break;
     case _NNS_FLOAT32:
-      operator_func (cv->data, float, tensor_if->op, svtc_1.data, svtc_2.data,
-          ret);
+      operator_func (cv->data, float, op, sv[0], sv[1], ret);
       break;
     case _NNS_INT64:
-      operator_func (cv->data, int64_t, tensor_if->op, svtc_1.data, svtc_2.data,
-          ret);
+      operator_func (cv->data, int64_t, op, sv[0], sv[1], ret);
       break;
     case _NNS_UINT64:
-      operator_func (cv->data, uint64_t, tensor_if->op, svtc_1.data,
-          svtc_2.data, ret);
+      operator_func (cv->data, uint64_t, op, sv[0], sv[1], ret);
       break;
     default:
       GST_ERROR_OBJECT (tensor_if, "Unknown tensor type %d", cv->type);
@@ -895,52 +1046,39 @@ gst_tensor_if_get_comparison_result (GstTensorIf * tensor_if,
 }
 
 /**
- * @brief Calculate average value of the nth tensor
+ * @brief Typecast the supplied values to the type of compared value
  */
-static gboolean
-gst_tensor_if_get_tensor_average (GstTensorIf * tensor_if,
-    GstBuffer * buf, tensor_data_s * cv, gint nth)
+static void
+gst_tensor_if_typecast_supplied_value (const tensor_if_sv_s * sv,
+    tensor_type type, tensor_element * cast)
 {
-  GstMemory *in_mem;
-  GstMapInfo in_info;
-  gdouble *avg = NULL;
-  tensor_type type = tensor_if->in_config.info.info[nth].type;
+  tensor_data_s data;
+  guint i;
 
-  in_mem = gst_buffer_peek_memory (buf, nth);
-  if (!gst_memory_map (in_mem, &in_info, GST_MAP_READ)) {
-    GST_WARNING_OBJECT (tensor_if, "Failed to map the input buffer.");
-    return FALSE;
+  for (i = 0; i < 2; i++) {
+    data.type = sv->type;
+    data.data = sv->data[i];
+    gst_tensor_data_typecast (&data, type);
+    cast[i] = data.data;
   }
-
-  gst_tensor_data_raw_average (in_info.data, in_info.size, type, &avg);
-
-  gst_memory_unmap (in_mem, &in_info);
-
-  gst_tensor_data_set (cv, _NNS_FLOAT64, avg);
-  gst_tensor_data_typecast (cv, type);
-
-  g_free (avg);
-  return TRUE;
 }
 
 /**
- * @brief Calculate compared value
+ * @brief Compile the condition with the properties and input tensors info.
+ * The option is parsed and the supplied values are typecast once, instead of handling them for each buffer.
  */
 static gboolean
-gst_tensor_if_calculate_cv (GstTensorIf * tensor_if, GstBuffer * buf,
-    tensor_data_s * cv)
+gst_tensor_if_compile_condition (GstTensorIf * tensor_if)
 {
+  tensor_if_cond_s *cond = &tensor_if->cond;
+  GstTensorInfo *info;
+  tensor_dim target;
+  GList *list;
+  guint i, idx = 0;
+  gsize offset = 1;
+
   switch (tensor_if->cv) {
     case TIFCV_A_VALUE:
-    {
-      GstMemory *in_mem;
-      GstMapInfo in_info;
-      GList *list;
-      uint32_t idx = 0, nth, i, offset = 1;
-      tensor_dim target;
-      const uint32_t *in_dim;
-      tensor_type in_type;
-
       if (g_list_length (tensor_if->cv_option) != NNS_TENSOR_RANK_LIMIT + 1) {
         GST_ERROR_OBJECT (tensor_if,
             "Please specify a proper 'compared-value-option' property, e.g., 0:1:2:3,0");
@@ -949,57 +1087,146 @@ gst_tensor_if_calculate_cv (GstTensorIf * tensor_if, GstBuffer * buf,
       for (list = tensor_if->cv_option; list->next != NULL; list = list->next) {
         target[idx++] = GPOINTER_TO_INT (list->data);
       }
-
-      nth = GPOINTER_TO_INT (list->data);
-      if (gst_buffer_n_memory (buf) <= nth) {
-        GST_ERROR_OBJECT (tensor_if, "Index should be lower than buffer size");
-        return FALSE;
-      }
-
-      in_type = tensor_if->in_config.info.info[nth].type;
-      in_dim = tensor_if->in_config.info.info[nth].dimension;
-
-      in_mem = gst_buffer_peek_memory (buf, nth);
-      if (!gst_memory_map (in_mem, &in_info, GST_MAP_READ)) {
-        GST_WARNING_OBJECT (tensor_if, "Failed to map the input buffer.");
-        return FALSE;
-      }
-
-      /* Find data index for mem access */
-      idx = target[0];
-      for (i = 1; i < NNS_TENSOR_RANK_LIMIT; i++) {
-        offset *= in_dim[i - 1];
-        idx += (target[i]) * offset;
-      }
-
-      idx *= gst_tensor_get_element_size (in_type);
-
-      gst_tensor_data_set (cv, in_type, in_info.data + idx);
-      gst_memory_unmap (in_mem, &in_info);
-
+      cond->nth = GPOINTER_TO_INT (list->data);
       break;
-    }
     case TIFCV_TENSOR_AVERAGE_VALUE:
-    {
-      uint32_t nth;
+    case TIFCV_TENSOR_MAX_VALUE:
+    case TIFCV_TENSOR_MIN_VALUE:
       if (g_list_length (tensor_if->cv_option) != 1) {
         GST_ERROR_OBJECT (tensor_if,
-            "Please specify a proper 'compared-value-option' property, For TENSOR_AVERAGE_VALUE, specify only one tensor. Tensors is not supported.");
-        return FALSE;
-      }
-      nth = GPOINTER_TO_INT (tensor_if->cv_option->data);
-      if (gst_buffer_n_memory (buf) <= nth) {
-        GST_ERROR_OBJECT (tensor_if, "Index should be lower than buffer size");
+            "Please specify a proper 'compared-value-option' property, For TENSOR_AVERAGE_VALUE, TENSOR_MAX_VALUE and TENSOR_MIN_VALUE, specify only one tensor. Tensors is not supported.");
         return FALSE;
       }
-      return gst_tensor_if_get_tensor_average (tensor_if, buf, cv, nth);
-    }
+      cond->nth = GPOINTER_TO_INT (tensor_if->cv_option->data);
+      break;
     default:
       GST_ERROR_OBJECT (tensor_if,
           "Compared value is not supported yet or not defined");
       return FALSE;
   }
+
+  if (cond->nth >= tensor_if->in_config.info.num_tensors ||
+      cond->nth >= NNS_TENSOR_SIZE_LIMIT) {
+    GST_ERROR_OBJECT (tensor_if, "Index should be lower than buffer size");
+    return FALSE;
+  }
+
+  info = &tensor_if->in_config.info.info[cond->nth];
+  cond->type = info->type;
+
+  if (gst_tensor_get_element_size (cond->type) == 0) {
+    GST_ERROR_OBJECT (tensor_if, "Unknown tensor type %d", cond->type);
+    return FALSE;
+  }
+
+  /* Find data index for mem access */
+  cond->offset = 0;
+  if (tensor_if->cv == TIFCV_A_VALUE) {
+    cond->offset = target[0];
+    for (i = 1; i < NNS_TENSOR_RANK_LIMIT; i++) {
+      offset *= info->dimension[i - 1];
+      cond->offset += (target[i]) * offset;
+    }
+
+    cond->offset *= gst_tensor_get_element_size (cond->type);
+  }
+
+  /* typecast the supplied values to the type of compared value */
+  gst_tensor_if_typecast_supplied_value (tensor_if->sv, cond->type, cond->sv);
+  for (i = 0; i < tensor_if->num_conds; i++) {
+    gst_tensor_if_typecast_supplied_value (&tensor_if->conds[i].sv,
+        cond->type, tensor_if->conds[i].cast);
+  }
+
+  cond->compiled = TRUE;
+  return TRUE;
+}
+
+/**
+ * @brief Calculate max, min or average value of the tensor data
+ */
+static gboolean
+gst_tensor_if_reduce (GstTensorIf * tensor_if, const guint8 * data,
+    gsize size, tensor_data_s * cv)
+{
+  tensor_type type = tensor_if->cond.type;
+  gdouble sum, avg;
+  gsize num;
+
+  num = size / gst_tensor_get_element_size (type);
+  if (num == 0) {
+    GST_ERROR_OBJECT (tensor_if, "The tensor is empty.");
+    return FALSE;
+  }
+
+  /* typed reductions of tensor_data, shared with the other elements */
+  switch (tensor_if->cv) {
+    case TIFCV_TENSOR_MAX_VALUE:
+      if (!gst_tensor_data_raw_min_max (data, size, type, 1, NULL, cv))
+        goto error;
+      break;
+    case TIFCV_TENSOR_MIN_VALUE:
+      if (!gst_tensor_data_raw_min_max (data, size, type, 1, cv, NULL))
+        goto error;
+      break;
+    default:
+      if (!gst_tensor_data_raw_sum (data, size, type, 1, &sum))
+        goto error;
+
+      avg = sum / (gdouble) num;
+      gst_tensor_data_set (cv, _NNS_FLOAT64, &avg);
+      gst_tensor_data_typecast (cv, type);
+      break;
+  }
+
   return TRUE;
+
+error:
+  GST_ERROR_OBJECT (tensor_if, "Failed to reduce the tensor of type %d", type);
+  return FALSE;
+}
+
+/**
+ * @brief Calculate compared value
+ */
+static gboolean
+gst_tensor_if_calculate_cv (GstTensorIf * tensor_if, GstBuffer * buf,
+    tensor_data_s * cv)
+{
+  tensor_if_cond_s *cond = &tensor_if->cond;
+  GstMemory *in_mem;
+  GstMapInfo in_info;
+  gboolean ret = TRUE;
+
+  if (!cond->compiled && !gst_tensor_if_compile_condition (tensor_if))
+    return FALSE;
+
+  if (gst_buffer_n_memory (buf) <= cond->nth) {
+    GST_ERROR_OBJECT (tensor_if, "Index should be lower than buffer size");
+    return FALSE;
+  }
+
+  in_mem = gst_buffer_peek_memory (buf, cond->nth);
+  if (!gst_memory_map (in_mem, &in_info, GST_MAP_READ)) {
+    GST_WARNING_OBJECT (tensor_if, "Failed to map the input buffer.");
+    return FALSE;
+  }
+
+  if (tensor_if->cv == TIFCV_A_VALUE) {
+    if (cond->offset + gst_tensor_get_element_size (cond->type) >
+        in_info.size) {
+      GST_ERROR_OBJECT (tensor_if,
+          "The index of compared value is out of the tensor.");
+      ret = FALSE;
+    } else {
+      gst_tensor_data_set (cv, cond->type, in_info.data + cond->offset);
+    }
+  } else {
+    ret = gst_tensor_if_reduce (tensor_if, in_info.data, in_info.size, cv);
+  }
+
+  gst_memory_unmap (in_mem, &in_info);
+  return ret;
 }
 
 /**
@@ -1051,13 +1278,15 @@ nnstreamer_if_custom_unregister (const gchar * name)
  * @brief Determining whether a given condition is true or false
  * @param tensor_if TensorIf Object
  * @param buf gstbuffer from sink pad
+ * @param[out] which the src pad index of the first TRUE condition. The last src pad index (else pad) if none of the conditions is TRUE.
  * @return return TRUE if no error
  */
 static gboolean
 gst_tensor_if_check_condition (GstTensorIf * tensor_if, GstBuffer * buf,
-    gboolean * result)
+    guint * which)
 {
   gboolean ret = FALSE;
+  gboolean result = FALSE;
 
   if (tensor_if->cv == TIFCV_CUSTOM) {
     GstMemory *in_mem[NNS_TENSOR_SIZE_LIMIT];
@@ -1084,22 +1313,71 @@ gst_tensor_if_check_condition (GstTensorIf * tensor_if, GstBuffer * buf,
     }
 
     ret = tensor_if->custom.func (&tensor_if->in_config.info, in_tensors,
-        tensor_if->custom.data, result);
+        tensor_if->custom.data, &result);
 
     for (i = 0; i < tensor_if->in_config.info.num_tensors; i++)
       gst_memory_unmap (in_mem[i], &in_info[i]);
   } else {
     tensor_data_s cv = {.type = _NNS_END,.data._uint8_t = 0 };
+    guint i;
+
     if (!gst_tensor_if_calculate_cv (tensor_if, buf, &cv)) {
       GST_ERROR_OBJECT (tensor_if, " failed to calculate compared value");
       return FALSE;
     }
-    ret = gst_tensor_if_get_comparison_result (tensor_if, &cv, result);
+
+    if (tensor_if->num_conds > 0) {
+      /* the compared value is calculated once and compared with each condition */
+      *which = tensor_if->num_conds;
+      for (i = 0; i < tensor_if->num_conds; i++) {
+        if (!gst_tensor_if_get_comparison_result (tensor_if, &cv,
+                tensor_if->conds[i].op, tensor_if->conds[i].cast, &result))
+          return FALSE;
+
+        if (result) {
+          *which = i;
+          break;
+        }
+      }
+      return TRUE;
+    }
+
+    ret = gst_tensor_if_get_comparison_result (tensor_if, &cv, tensor_if->op,
+        tensor_if->cond.sv, &result);
   }
 
+  *which = result ? TIFSP_THEN_PAD : TIFSP_ELSE_PAD;
   return ret;
 }
 
+/**
+ * @brief Evaluate the condition of tensor_if with the tensors given by the other element (e.g., the outputs of tensor_filter).
+ */
+gboolean
+gst_tensor_if_check_buffer (GstTensorIf * tensor_if,
+    const GstTensorsConfig * config, GstBuffer * buf, gboolean * result)
+{
+  guint which = TIFSP_ELSE_PAD;
+
+  g_return_val_if_fail (GST_IS_TENSOR_IF (tensor_if), FALSE);
+  g_return_val_if_fail (config != NULL, FALSE);
+  g_return_val_if_fail (GST_IS_BUFFER (buf), FALSE);
+  g_return_val_if_fail (result != NULL, FALSE);
+
+  /* compile the condition with new tensors info */
+  if (!gst_tensors_config_is_equal (&tensor_if->in_config, config)) {
+    gst_tensors_config_free (&tensor_if->in_config);
+    gst_tensors_config_copy (&tensor_if->in_config, config);
+    tensor_if->cond.compiled = FALSE;
+  }
+
+  if (!gst_tensor_if_check_condition (tensor_if, buf, &which))
+    return FALSE;
+
+  *result = (which == TIFSP_THEN_PAD);
+  return TRUE;
+}
+
 /**
  * @brief chain function for sink (gst element vmethod)
  */
@@ -1109,9 +1387,9 @@ gst_tensor_if_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
   guint num_tensors, i;
   GstFlowReturn res = GST_FLOW_OK;
   GstTensorIf *tensor_if = GST_TENSOR_IF (parent);
-  gboolean condition_result = FALSE;
   tensor_if_behavior curr_act = TIFB_PASSTHROUGH;
-  tensor_if_srcpads which_srcpad = TIFSP_THEN_PAD;
+  guint which_srcpad = TIFSP_THEN_PAD;
+  guint else_srcpad;
   GList *curr_act_option = NULL;
   GstTensorsConfig *config;
   GstTensorPad *srcpad;
@@ -1126,19 +1404,21 @@ gst_tensor_if_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
   /* supposed n memory blocks in buffer */
   g_assert (gst_buffer_n_memory (buf) == num_tensors);
 
-  if (!gst_tensor_if_check_condition (tensor_if, buf, &condition_result)) {
+  if (!gst_tensor_if_check_condition (tensor_if, buf, &which_srcpad)) {
     GST_ERROR_OBJECT (tensor_if, " Failed to check condition");
+    gst_buffer_unref (buf);
     return GST_FLOW_ERROR;
   }
 
-  if (condition_result) {
+  else_srcpad = (tensor_if->num_conds > 0 && tensor_if->cv != TIFCV_CUSTOM) ?
+      tensor_if->num_conds : TIFSP_ELSE_PAD;
+
+  if (which_srcpad != else_srcpad) {
     curr_act = tensor_if->act_then;
     curr_act_option = tensor_if->then_option;
-    which_srcpad = TIFSP_THEN_PAD;
   } else {
     curr_act = tensor_if->act_else;
     curr_act_option = tensor_if->else_option;
-    which_srcpad = TIFSP_ELSE_PAD;
   }
 
   config = &tensor_if->out_config[which_srcpad];
@@ -1153,25 +1433,40 @@ gst_tensor_if_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
       if (config->info.num_tensors == 0) {
         gst_tensors_info_copy (&config->info, &tensor_if->in_config.info);
       }
-      outbuf = gst_buffer_ref (buf);
+      /* push the incoming buffer as it is, no need to copy the buffer and metadata */
+      outbuf = buf;
+      buf = NULL;
 
       break;
     case TIFB_TENSORPICK:
     {
       GList *list;
-      gint info_idx = 0;
+      guint info_idx = 0;
+      gboolean configured = (config->info.num_tensors > 0);
 
+      /* the picked memories are shared with the incoming buffer (refcount), not copied */
       outbuf = gst_buffer_new ();
       for (list = curr_act_option; list != NULL; list = list->next) {
         i = GPOINTER_TO_INT (list->data);
-        if (config->info.num_tensors == 0) {
-          gst_tensor_info_copy (&config->info.info[info_idx++],
+        if (i >= num_tensors || info_idx >= NNS_TENSOR_SIZE_LIMIT) {
+          GST_ERROR_OBJECT (tensor_if, "Invalid tensor index %u to pick.", i);
+          gst_buffer_unref (outbuf);
+          res = GST_FLOW_ERROR;
+          goto done;
+        }
+        if (!configured) {
+          gst_tensor_info_copy (&config->info.info[info_idx],
               &tensor_if->in_config.info.info[i]);
         }
-        mem = gst_buffer_get_memory (buf, i);
-        gst_buffer_append_memory (outbuf, mem);
+        info_idx++;
+        mem = gst_buffer_peek_memory (buf, i);
+        gst_buffer_append_memory (outbuf, gst_memory_ref (mem));
       }
-      config->info.num_tensors = info_idx;
+      if (!configured)
+        config->info.num_tensors = info_idx;
+
+      /* metadata from incoming buffer */
+      gst_buffer_copy_into (outbuf, buf, GST_BUFFER_COPY_METADATA, 0, -1);
       break;
     }
     case TIFB_SKIP:
@@ -1190,12 +1485,7 @@ gst_tensor_if_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
     gst_pad_push_event (srcpad->pad, gst_event_new_segment (&segment));
   }
 
-  outbuf = gst_buffer_make_writable (outbuf);
-
-  /* metadata from incoming buffer */
-  gst_buffer_copy_into (outbuf, buf, GST_BUFFER_COPY_METADATA, 0, -1);
-
-  ts = GST_BUFFER_TIMESTAMP (buf);
+  ts = GST_BUFFER_TIMESTAMP (outbuf);
   if (srcpad->last_ts == GST_CLOCK_TIME_NONE || srcpad->last_ts != ts) {
     srcpad->last_ts = ts;
   } else {
@@ -1207,6 +1497,7 @@ gst_tensor_if_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
   res = gst_tensor_if_combine_flows (tensor_if, srcpad, res);
 
 done:
-  gst_buffer_unref (buf);
+  if (buf)
+    gst_buffer_unref (buf);
   return res;
 }
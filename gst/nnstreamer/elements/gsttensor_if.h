@@ -36,6 +36,11 @@ G_BEGIN_DECLS
 typedef struct _GstTensorIf GstTensorIf;
 typedef struct _GstTensorIfClass GstTensorIfClass;
 
+/**
+ * @brief The max number of conditions in the multi-condition mode
+ */
+#define TENSOR_IF_MAX_CONDITIONS (16)
+
 /**
  * @brief Compared_Value
  */
@@ -51,6 +56,10 @@ typedef enum {
   TIFCV_ALL_TENSORS_AVERAGE_VALUE = 4,	/**< Decide based on a average value of
 					     tensors or a specific tensor */
   TIFCV_CUSTOM = 5,    /**< Decide based on a user defined condition */
+  TIFCV_TENSOR_MAX_VALUE = 6,	/**< Decide based on a max value of
+				     a specific tensor */
+  TIFCV_TENSOR_MIN_VALUE = 7,	/**< Decide based on a min value of
+				     a specific tensor */
   TIFCV_END,
 } tensor_if_compared_value;
 
@@ -116,6 +125,28 @@ typedef struct
   void * data;
 } custom_cb_s;
 
+/**
+ * @brief Internal data structure for the condition compiled with the input tensors info
+ */
+typedef struct
+{
+  gboolean compiled; /**< TRUE if the condition is compiled with current properties and caps */
+  guint32 nth; /**< index of the tensor for the compared value */
+  gsize offset; /**< byte offset of the element (A_VALUE) */
+  tensor_type type; /**< type of the compared value */
+  tensor_element sv[2]; /**< supplied values typecast to the type of the compared value */
+} tensor_if_cond_s;
+
+/**
+ * @brief Internal data structure for a condition of the multi-condition mode
+ */
+typedef struct
+{
+  tensor_if_operator op; /**< operator of the condition */
+  tensor_if_sv_s sv; /**< supplied values of the condition */
+  tensor_element cast[2]; /**< supplied values typecast to the type of the compared value */
+} tensor_if_multi_cond_s;
+
 /**
  * @brief Tensor If data structure
  */
@@ -127,7 +158,7 @@ struct _GstTensorIf
   gboolean silent;
 
   GstTensorsConfig in_config; /**< input tensor info */
-  GstTensorsConfig out_config[2]; /**< output tensor info */
+  GstTensorsConfig out_config[TENSOR_IF_MAX_CONDITIONS + 1]; /**< output tensor info */
   guint32 num_srcpads;
 
   tensor_if_compared_value cv; /**< compared value */
@@ -141,6 +172,10 @@ struct _GstTensorIf
 
   gboolean custom_configured;
   custom_cb_s custom;
+  tensor_if_cond_s cond; /**< compiled condition */
+
+  tensor_if_multi_cond_s conds[TENSOR_IF_MAX_CONDITIONS]; /**< conditions of the multi-condition mode */
+  guint32 num_conds; /**< the number of conditions, 0 if the multi-condition mode is disabled */
 
   GMutex lock; /**< Lock for custom callback */
 };
@@ -158,6 +193,16 @@ struct _GstTensorIfClass
  */
 GType gst_tensor_if_get_type (void);
 
+/**
+ * @brief Evaluate the condition of tensor_if with the tensors given by the other element (e.g., the outputs of tensor_filter).
+ * @param tensor_if TensorIf Object
+ * @param config the tensors config of the buffer
+ * @param buf the buffer to be evaluated
+ * @param[out] result TRUE if the condition (the first one with conditions) is TRUE
+ * @return TRUE if no error
+ */
+gboolean gst_tensor_if_check_buffer (GstTensorIf * tensor_if, const GstTensorsConfig * config, GstBuffer * buf, gboolean * result);
+
 G_END_DECLS
 
 #endif /* __GST_TENSOR_IF_H__ */
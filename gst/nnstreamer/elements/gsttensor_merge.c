@@ -125,6 +125,8 @@ static gboolean gst_tensor_merge_sink_event (GstCollectPads * pads,
     GstCollectData * data, GstEvent * event, GstTensorMerge * tensor_merge);
 static GstFlowReturn gst_tensor_merge_collected (GstCollectPads * pads,
     GstTensorMerge * tensor_merge);
+static gboolean gst_tensor_merge_sink_query (GstCollectPads * pads,
+    GstCollectData * data, GstQuery * query, GstTensorMerge * tensor_merge);
 
 static void gst_tensor_merge_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec);
@@ -132,6 +134,387 @@ static void gst_tensor_merge_get_property (GObject * object, guint prop_id,
     GValue * value, GParamSpec * pspec);
 static void gst_tensor_merge_finalize (GObject * object);
 
+/**
+ * @brief Max number of the memory blocks waiting for the tensors of all sink pads.
+ */
+#define MERGE_MAX_PENDING_BLOCKS (16)
+
+/**
+ * @brief Memory block of a merged tensor. The upstream elements write the tensors of a frame into their slices.
+ */
+typedef struct
+{
+  gint refcount; /**< reference count */
+  guint8 *data; /**< data of the merged tensor */
+  gsize size; /**< size of the merged tensor */
+  guint64 frame; /**< index of the frame */
+  guint taken; /**< number of the sink pads which have taken the slice */
+} tensor_merge_block_s;
+
+/**
+ * @brief Layout of the merged tensor shared with the buffer pools of the sink pads.
+ */
+struct _tensor_merge_layout_s
+{
+  gint refcount; /**< reference count */
+  GMutex lock; /**< lock for the layout and blocks */
+  gboolean valid; /**< TRUE if all sink pads can write into the slices */
+  guint num_pads; /**< number of the sink pads */
+  gsize size[NNS_TENSOR_SIZE_LIMIT]; /**< size of the tensor of each pad (0 if the tensor cannot be a slice) */
+  gsize offset[NNS_TENSOR_SIZE_LIMIT]; /**< offset of the slice of each pad */
+  gsize total; /**< size of the merged tensor */
+  guint64 next[NNS_TENSOR_SIZE_LIMIT]; /**< index of the next frame of each pad */
+  GQueue blocks; /**< memory blocks waiting for the tensors, ordered by the frame index */
+};
+
+/**
+ * @brief Quark to get the memory block from the memory of a slice.
+ */
+static GQuark merge_block_quark;
+
+/**
+ * @brief Release the memory block.
+ */
+static void
+gst_tensor_merge_block_unref (gpointer data)
+{
+  tensor_merge_block_s *block = (tensor_merge_block_s *) data;
+
+  if (g_atomic_int_dec_and_test (&block->refcount)) {
+    g_free (block->data);
+    g_free (block);
+  }
+}
+
+/**
+ * @brief Get the memory wrapping the block. The memory holds the reference of the block.
+ */
+static GstMemory *
+gst_tensor_merge_block_wrap (tensor_merge_block_s * block, gsize offset,
+    gsize size)
+{
+  GstMemory *mem;
+
+  g_atomic_int_inc (&block->refcount);
+  mem = gst_memory_new_wrapped (0, block->data, block->size, offset, size,
+      block, gst_tensor_merge_block_unref);
+  gst_mini_object_set_qdata (GST_MINI_OBJECT_CAST (mem), merge_block_quark,
+      block, NULL);
+
+  return mem;
+}
+
+/**
+ * @brief Clear the pending blocks and frame index. Caller should hold the lock.
+ */
+static void
+gst_tensor_merge_layout_reset_locked (tensor_merge_layout_s * layout)
+{
+  g_queue_clear_full (&layout->blocks, gst_tensor_merge_block_unref);
+  memset (layout->next, 0, sizeof (layout->next));
+}
+
+/**
+ * @brief Create the layout of the merged tensor.
+ */
+static tensor_merge_layout_s *
+gst_tensor_merge_layout_new (void)
+{
+  tensor_merge_layout_s *layout = g_new0 (tensor_merge_layout_s, 1);
+
+  layout->refcount = 1;
+  g_mutex_init (&layout->lock);
+  g_queue_init (&layout->blocks);
+
+  return layout;
+}
+
+/**
+ * @brief Release the layout of the merged tensor.
+ */
+static void
+gst_tensor_merge_layout_unref (tensor_merge_layout_s * layout)
+{
+  if (g_atomic_int_dec_and_test (&layout->refcount)) {
+    gst_tensor_merge_layout_reset_locked (layout);
+    g_mutex_clear (&layout->lock);
+    g_free (layout);
+  }
+}
+
+/**
+ * @brief Take the slice of the given pad in the next frame.
+ * @return The memory of the slice, or NULL if the layout is not available.
+ */
+static GstMemory *
+gst_tensor_merge_layout_take_slice (tensor_merge_layout_s * layout,
+    guint index)
+{
+  tensor_merge_block_s *block = NULL;
+  GstMemory *mem = NULL;
+  GList *walk;
+  guint64 frame;
+
+  g_mutex_lock (&layout->lock);
+  if (!layout->valid || index >= layout->num_pads)
+    goto done;
+
+  frame = layout->next[index]++;
+
+  for (walk = layout->blocks.head; walk; walk = walk->next) {
+    tensor_merge_block_s *b = (tensor_merge_block_s *) walk->data;
+
+    if (b->frame == frame) {
+      block = b;
+      break;
+    }
+  }
+
+  if (block == NULL) {
+    tensor_merge_block_s *tail = g_queue_peek_tail (&layout->blocks);
+
+    /* the block is already released (other pads went ahead too far) */
+    if (tail && tail->frame > frame)
+      goto done;
+
+    block = g_new0 (tensor_merge_block_s, 1);
+    block->refcount = 1;
+    block->data = g_try_malloc (layout->total);
+    block->size = layout->total;
+    block->frame = frame;
+
+    if (block->data == NULL) {
+      g_free (block);
+      goto done;
+    }
+
+    g_queue_push_tail (&layout->blocks, block);
+    if (g_queue_get_length (&layout->blocks) > MERGE_MAX_PENDING_BLOCKS)
+      gst_tensor_merge_block_unref (g_queue_pop_head (&layout->blocks));
+  }
+
+  mem = gst_tensor_merge_block_wrap (block, layout->offset[index],
+      layout->size[index]);
+
+  if (++block->taken == layout->num_pads) {
+    g_queue_remove (&layout->blocks, block);
+    gst_tensor_merge_block_unref (block);
+  }
+
+done:
+  g_mutex_unlock (&layout->lock);
+  return mem;
+}
+
+#define GST_TYPE_TENSOR_MERGE_POOL (gst_tensor_merge_pool_get_type ())
+#define GST_TENSOR_MERGE_POOL(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST ((obj), GST_TYPE_TENSOR_MERGE_POOL, GstTensorMergePool))
+
+/**
+ * @brief Buffer pool proposed to the upstream of a sink pad, the buffers are the slices of the merged tensor.
+ */
+typedef struct
+{
+  GstBufferPool parent; /**< parent object */
+
+  tensor_merge_layout_s *layout; /**< layout of the merged tensor */
+  guint index; /**< index of the sink pad */
+} GstTensorMergePool;
+
+/**
+ * @brief GstTensorMergePoolClass data structure.
+ */
+typedef struct
+{
+  GstBufferPoolClass parent_class; /**< parent class */
+} GstTensorMergePoolClass;
+
+static GType gst_tensor_merge_pool_get_type (void);
+G_DEFINE_TYPE (GstTensorMergePool, gst_tensor_merge_pool, GST_TYPE_BUFFER_POOL);
+
+/**
+ * @brief Get a buffer with the slice of the merged tensor.
+ * @details The buffer is not recycled, the slice is released with the merged tensor.
+ */
+static GstFlowReturn
+gst_tensor_merge_pool_acquire_buffer (GstBufferPool * pool,
+    GstBuffer ** buffer, GstBufferPoolAcquireParams * params)
+{
+  GstTensorMergePool *self = GST_TENSOR_MERGE_POOL (pool);
+  GstStructure *config;
+  GstMemory *mem;
+  guint size;
+  UNUSED (params);
+
+  if (GST_BUFFER_POOL_IS_FLUSHING (pool))
+    return GST_FLOW_FLUSHING;
+
+  mem = gst_tensor_merge_layout_take_slice (self->layout, self->index);
+
+  if (mem == NULL) {
+    /* a sink pad is not ready, allocate the memory of the frame */
+    config = gst_buffer_pool_get_config (pool);
+    gst_buffer_pool_config_get_params (config, NULL, &size, NULL, NULL);
+    gst_structure_free (config);
+
+    mem = gst_allocator_alloc (NULL, size, NULL);
+    if (mem == NULL)
+      return GST_FLOW_ERROR;
+  }
+
+  *buffer = gst_buffer_new ();
+  gst_buffer_append_memory (*buffer, mem);
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Free the released buffer.
+ */
+static void
+gst_tensor_merge_pool_release_buffer (GstBufferPool * pool,
+    GstBuffer * buffer)
+{
+  UNUSED (pool);
+  gst_buffer_unref (buffer);
+}
+
+/**
+ * @brief Finalize the buffer pool.
+ */
+static void
+gst_tensor_merge_pool_finalize (GObject * object)
+{
+  GstTensorMergePool *self = GST_TENSOR_MERGE_POOL (object);
+
+  gst_tensor_merge_layout_unref (self->layout);
+
+  G_OBJECT_CLASS (gst_tensor_merge_pool_parent_class)->finalize (object);
+}
+
+/**
+ * @brief Initialize the class of the buffer pool.
+ */
+static void
+gst_tensor_merge_pool_class_init (GstTensorMergePoolClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GstBufferPoolClass *pool_class = GST_BUFFER_POOL_CLASS (klass);
+
+  gobject_class->finalize = gst_tensor_merge_pool_finalize;
+
+  pool_class->acquire_buffer = gst_tensor_merge_pool_acquire_buffer;
+  pool_class->release_buffer = gst_tensor_merge_pool_release_buffer;
+}
+
+/**
+ * @brief Initialize the buffer pool.
+ */
+static void
+gst_tensor_merge_pool_init (GstTensorMergePool * self)
+{
+  self->layout = NULL;
+  self->index = 0;
+}
+
+/**
+ * @brief Create the buffer pool of the sink pad.
+ */
+static GstBufferPool *
+gst_tensor_merge_pool_new (tensor_merge_layout_s * layout, guint index)
+{
+  GstTensorMergePool *pool;
+
+  pool = GST_TENSOR_MERGE_POOL (g_object_new (GST_TYPE_TENSOR_MERGE_POOL,
+          NULL));
+  gst_object_ref_sink (pool);
+
+  g_atomic_int_inc (&layout->refcount);
+  pool->layout = layout;
+  pool->index = index;
+
+  return GST_BUFFER_POOL_CAST (pool);
+}
+
+/**
+ * @brief Interleave the blocks of the same size (type) from 2, 3 or 4 tensors. The loops with the fixed number of tensors can be vectorized.
+ */
+#define merge_interleave_typed(type) do { \
+    type *o_ = (type *) outptr; \
+    const type *a_ = (const type *) inptr[0]; \
+    const type *b_ = (const type *) inptr[1]; \
+    const type *c_ = (const type *) inptr[(num > 2) ? 2 : 0]; \
+    const type *d_ = (const type *) inptr[(num > 3) ? 3 : 0]; \
+    if (num == 2) { \
+      for (o = 0; o < outer; o++) { \
+        o_[2 * o] = a_[o]; \
+        o_[2 * o + 1] = b_[o]; \
+      } \
+    } else if (num == 3) { \
+      for (o = 0; o < outer; o++) { \
+        o_[3 * o] = a_[o]; \
+        o_[3 * o + 1] = b_[o]; \
+        o_[3 * o + 2] = c_[o]; \
+      } \
+    } else { \
+      for (o = 0; o < outer; o++) { \
+        o_[4 * o] = a_[o]; \
+        o_[4 * o + 1] = b_[o]; \
+        o_[4 * o + 2] = c_[o]; \
+        o_[4 * o + 3] = d_[o]; \
+      } \
+    } \
+  } while (0)
+
+/**
+ * @brief Interleave the blocks of the tensors for each index of the outer dimensions.
+ * @param outptr output (merged tensor)
+ * @param inptr input tensors
+ * @param block size of the block (inner dimensions) of each tensor
+ * @param num number of the tensors
+ * @param outer number of the blocks in a tensor
+ */
+static void
+gst_tensor_merge_interleave (guint8 * outptr, guint8 ** inptr,
+    const gsize * block, guint num, gsize outer)
+{
+  gboolean typed = (num >= 2 && num <= 4);
+  guintptr align = (guintptr) outptr;
+  gsize o;
+  guint k;
+
+  for (k = 0; k < num; k++) {
+    if (block[k] != block[0])
+      typed = FALSE;
+    align |= (guintptr) inptr[k];
+  }
+
+  if (typed && block[0] <= 8 && (align % block[0]) == 0) {
+    switch (block[0]) {
+      case 1:
+        merge_interleave_typed (guint8);
+        return;
+      case 2:
+        merge_interleave_typed (guint16);
+        return;
+      case 4:
+        merge_interleave_typed (guint32);
+        return;
+      case 8:
+        merge_interleave_typed (guint64);
+        return;
+      default:
+        break;
+    }
+  }
+
+  for (o = 0; o < outer; o++) {
+    for (k = 0; k < num; k++) {
+      memcpy (outptr, inptr[k] + o * block[k], block[k]);
+      outptr += block[k];
+    }
+  }
+}
+
 #define gst_tensor_merge_parent_class parent_class
 G_DEFINE_TYPE (GstTensorMerge, gst_tensor_merge, GST_TYPE_ELEMENT);
 
@@ -147,6 +530,8 @@ gst_tensor_merge_class_init (GstTensorMergeClass * klass)
   GST_DEBUG_CATEGORY_INIT (gst_tensor_merge_debug, "tensor_merge", 0,
       "Element to merge multiple tensor stream to tensor stream");
 
+  merge_block_quark = g_quark_from_static_string ("GstTensorMergeBlock");
+
   gobject_class = (GObjectClass *) klass;
   gstelement_class = (GstElementClass *) klass;
 
@@ -224,6 +609,9 @@ gst_tensor_merge_init (GstTensorMerge * tensor_merge)
   gst_collect_pads_set_function (tensor_merge->collect,
       (GstCollectPadsFunction) GST_DEBUG_FUNCPTR (gst_tensor_merge_collected),
       tensor_merge);
+  gst_collect_pads_set_query_function (tensor_merge->collect,
+      (GstCollectPadsQueryFunction)
+      GST_DEBUG_FUNCPTR (gst_tensor_merge_sink_query), tensor_merge);
 
   tensor_merge->silent = TRUE;
   tensor_merge->sync.mode = SYNC_NOSYNC;
@@ -233,6 +621,7 @@ gst_tensor_merge_init (GstTensorMerge * tensor_merge)
   tensor_merge->loaded = FALSE;
   tensor_merge->current_time = 0;
   tensor_merge->need_set_time = TRUE;
+  tensor_merge->layout = gst_tensor_merge_layout_new ();
 }
 
 /**
@@ -277,6 +666,11 @@ gst_tensor_merge_finalize (GObject * object)
     tensor_merge->sync.option = NULL;
   }
 
+  if (tensor_merge->layout) {
+    gst_tensor_merge_layout_unref (tensor_merge->layout);
+    tensor_merge->layout = NULL;
+  }
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -317,7 +711,8 @@ gst_tensor_merge_request_new_pad (GstElement * element, GstPadTemplate * templ,
 
     tensormergepad = (GstTensorCollectPadData *)
         gst_collect_pads_add_pad (tensor_merge->collect, newpad,
-        sizeof (GstTensorCollectPadData), NULL, TRUE);
+        sizeof (GstTensorCollectPadData),
+        gst_tensor_time_sync_pad_data_free, TRUE);
 
     tensormergepad->pad = newpad;
     gst_pad_set_element_private (newpad, tensormergepad);
@@ -347,6 +742,87 @@ gst_tensor_merge_src_event (GstPad * pad, GstObject * parent, GstEvent * event)
   return gst_pad_event_default (pad, parent, event);
 }
 
+/**
+ * @brief Get the size of the tensor if it can be a slice of the merged tensor (merged along the outermost dimension).
+ * @return The size of the tensor, or 0 if the tensor cannot be a slice.
+ */
+static gsize
+gst_tensor_merge_get_slice_size (GstTensorMerge * tensor_merge,
+    const GstCaps * caps)
+{
+  GstTensorsConfig config;
+  GstTensorInfo *info;
+  gsize size = 0;
+  guint j;
+
+  if (tensor_merge->mode != GTT_LINEAR || caps == NULL ||
+      gst_caps_get_size (caps) == 0)
+    return 0;
+
+  gst_tensors_config_init (&config);
+  if (!gst_tensors_config_from_structure (&config,
+          gst_caps_get_structure (caps, 0)) ||
+      !gst_tensors_config_validate (&config) ||
+      !gst_tensors_config_is_static (&config) ||
+      config.info.num_tensors != 1)
+    goto done;
+
+  info = &config.info.info[0];
+  for (j = tensor_merge->data_linear.direction + 1;
+      j < NNS_TENSOR_RANK_LIMIT; j++) {
+    if (info->dimension[j] > 1)
+      goto done;
+  }
+
+  size = gst_tensor_info_get_size (info);
+
+done:
+  gst_tensors_config_free (&config);
+  return size;
+}
+
+/**
+ * @brief Update the layout of the merged tensor with the caps of the sink pad.
+ */
+static void
+gst_tensor_merge_update_layout (GstTensorMerge * tensor_merge, guint index,
+    const GstCaps * caps)
+{
+  tensor_merge_layout_s *layout = tensor_merge->layout;
+  guint i;
+
+  g_mutex_lock (&layout->lock);
+  gst_tensor_merge_layout_reset_locked (layout);
+
+  layout->num_pads = MIN (g_slist_length (tensor_merge->collect->data),
+      NNS_TENSOR_SIZE_LIMIT);
+  if (index < NNS_TENSOR_SIZE_LIMIT)
+    layout->size[index] = gst_tensor_merge_get_slice_size (tensor_merge, caps);
+
+  layout->valid = (layout->num_pads > 1);
+  layout->total = 0;
+  for (i = 0; i < layout->num_pads; i++) {
+    if (layout->size[i] == 0)
+      layout->valid = FALSE;
+
+    layout->offset[i] = layout->total;
+    layout->total += layout->size[i];
+  }
+
+  g_mutex_unlock (&layout->lock);
+}
+
+/**
+ * @brief Reset the frame index of the layout.
+ */
+static void
+gst_tensor_merge_reset_layout (GstTensorMerge * tensor_merge)
+{
+  g_mutex_lock (&tensor_merge->layout->lock);
+  gst_tensor_merge_layout_reset_locked (tensor_merge->layout);
+  g_mutex_unlock (&tensor_merge->layout->lock);
+}
+
 /**
  * @brief sink event vmethod
  */
@@ -357,10 +833,22 @@ gst_tensor_merge_sink_event (GstCollectPads * pads, GstCollectData * data,
   g_return_val_if_fail (event != NULL, FALSE);
 
   switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_CAPS:
+    {
+      GstCaps *caps;
+      gint index;
+
+      gst_event_parse_caps (event, &caps);
+      index = g_slist_index (pads->data, data);
+      if (index >= 0)
+        gst_tensor_merge_update_layout (tensor_merge, (guint) index, caps);
+      break;
+    }
     case GST_EVENT_FLUSH_STOP:
       tensor_merge->need_segment = TRUE;
       tensor_merge->need_set_time = TRUE;
       gst_tensor_time_sync_flush (tensor_merge->collect);
+      gst_tensor_merge_reset_layout (tensor_merge);
       break;
     default:
       break;
@@ -369,6 +857,47 @@ gst_tensor_merge_sink_event (GstCollectPads * pads, GstCollectData * data,
   return gst_collect_pads_event_default (pads, data, event, FALSE);
 }
 
+/**
+ * @brief sink query vmethod
+ * @details If the tensors are merged along the outermost dimension, tensor_merge proposes the buffer pool to write the tensor into the slice of the merged tensor.
+ */
+static gboolean
+gst_tensor_merge_sink_query (GstCollectPads * pads, GstCollectData * data,
+    GstQuery * query, GstTensorMerge * tensor_merge)
+{
+  if (GST_QUERY_TYPE (query) == GST_QUERY_ALLOCATION) {
+    GstBufferPool *pool;
+    GstStructure *config;
+    GstCaps *caps;
+    gsize size;
+    gint index;
+
+    gst_query_parse_allocation (query, &caps, NULL);
+    index = g_slist_index (pads->data, data);
+    size = gst_tensor_merge_get_slice_size (tensor_merge, caps);
+
+    if (size > 0 && index >= 0 && index < NNS_TENSOR_SIZE_LIMIT) {
+      pool = gst_tensor_merge_pool_new (tensor_merge->layout, (guint) index);
+      config = gst_buffer_pool_get_config (pool);
+      gst_buffer_pool_config_set_params (config, caps, (guint) size, 0, 0);
+
+      if (gst_buffer_pool_set_config (pool, config)) {
+        gst_query_add_allocation_pool (query, pool, (guint) size, 0, 0);
+        gst_object_unref (pool);
+
+        GST_DEBUG_OBJECT (tensor_merge,
+            "Propose the buffer pool of the slices (pad %d, size %zu).",
+            index, size);
+        return TRUE;
+      }
+
+      gst_object_unref (pool);
+    }
+  }
+
+  return gst_collect_pads_query_default (pads, data, query, FALSE);
+}
+
 /**
  * @brief Generate out TensorsConfig with in TensorsConfig
  * @param tensor_merge tensor merger
@@ -453,6 +982,36 @@ gst_tensor_merge_collect_buffer (GstTensorMerge * tensor_merge,
       &tensor_merge->tensors_config, is_eos);
 }
 
+/**
+ * @brief Get the merged tensor without copying the data if the tensors are the slices of a block.
+ * @return The memory of the merged tensor, or NULL if the tensors are not the slices.
+ */
+static GstMemory *
+gst_tensor_merge_join_slices (GstMemory ** mem, GstMapInfo * info, guint num,
+    gsize size)
+{
+  tensor_merge_block_s *block;
+  guint8 *ptr;
+  guint i;
+
+  block = (tensor_merge_block_s *)
+      gst_mini_object_get_qdata (GST_MINI_OBJECT_CAST (mem[0]),
+      merge_block_quark);
+  if (block == NULL || block->size != size)
+    return NULL;
+
+  ptr = block->data;
+  for (i = 0; i < num; i++) {
+    if (gst_mini_object_get_qdata (GST_MINI_OBJECT_CAST (mem[i]),
+            merge_block_quark) != block || info[i].data != ptr)
+      return NULL;
+
+    ptr += info[i].size;
+  }
+
+  return gst_tensor_merge_block_wrap (block, 0, size);
+}
+
 /**
  * @brief Generate Output GstMemory
  * @param tensor_merge tensor merger
@@ -467,21 +1026,31 @@ gst_tensor_merge_generate_mem (GstTensorMerge * tensor_merge,
   GstFlowReturn ret = GST_FLOW_OK;
   GstMapInfo mInfo[NNS_TENSOR_SIZE_LIMIT];
   GstMemory *mem[NNS_TENSOR_SIZE_LIMIT];
+  guint8 *inptr[NNS_TENSOR_SIZE_LIMIT];
+  gsize block[NNS_TENSOR_SIZE_LIMIT];
   GstMapInfo outInfo;
   GstMemory *outMem;
-  uint8_t *inptr, *outptr;
+  GstTensorInfo *info;
   guint num_mem = tensor_merge->tensors_config.info.num_tensors;
-  guint i, j, k, l;
-  size_t c, s;
+  guint i, j, direction;
   gsize outSize = 0;
-  gsize element_size;
-  tensor_dim dim;
-  tensor_type type;
+  gsize outer = 1;
 
-  memcpy (&dim, &tensor_merge->tensors_config.info.info[0].dimension,
-      sizeof (tensor_dim));
-  type = tensor_merge->tensors_config.info.info[0].type;
-  element_size = gst_tensor_get_element_size (type);
+  if (tensor_merge->mode != GTT_LINEAR) {
+    GST_ERROR_OBJECT (tensor_merge, "Cannot identify mode\n");
+    return GST_FLOW_ERROR;
+  }
+
+  /**
+   * The tensors are merged with the blocks of the inner dimensions (up to the direction),
+   * interleaved for each index of the outer dimensions.
+   */
+  direction = tensor_merge->data_linear.direction;
+  info = &tensor_merge->tensors_config.info.info[0];
+  for (j = direction + 1; j < NNS_TENSOR_RANK_LIMIT; j++) {
+    if (info->dimension[j] > 0)
+      outer *= info->dimension[j];
+  }
 
   for (i = 0; i < num_mem; i++) {
     mem[i] = gst_buffer_peek_memory (tensors_buf, i);
@@ -491,104 +1060,32 @@ gst_tensor_merge_generate_mem (GstTensorMerge * tensor_merge,
       ret = GST_FLOW_ERROR;
       goto error_ret;
     }
-    outSize += mInfo[i].size;
-  }
 
-  outMem = gst_allocator_alloc (NULL, outSize, NULL);
-  if (!gst_memory_map (outMem, &outInfo, GST_MAP_WRITE)) {
-    gst_allocator_free (NULL, outMem);
-    ml_logf ("Cannot map output memory buffer\n");
-    ret = GST_FLOW_ERROR;
-    goto error_ret;
+    inptr[i] = mInfo[i].data;
+    block[i] = mInfo[i].size / outer;
+    outSize += mInfo[i].size;
   }
-  outptr = outInfo.data;
 
-  switch (tensor_merge->mode) {
-    case GTT_LINEAR:
-    {
-      switch (tensor_merge->data_linear.direction) {
-        case LINEAR_FIRST:
-        {
-          for (l = 0; l < dim[3]; l++) {
-            for (i = 0; i < dim[2]; i++) {
-              for (j = 0; j < dim[1]; j++) {
-                for (k = 0; k < num_mem; k++) {
-                  c = tensor_merge->tensors_config.info.info[k].dimension[0];
-                  s = element_size * c;
-                  inptr =
-                      mInfo[k].data + (l * dim[2] * dim[1] + i * dim[1] +
-                      j) * s;
-                  memcpy (outptr, inptr, s);
-                  outptr += s;
-                }
-              }
-            }
-          }
-          break;
-        }
-        case LINEAR_SECOND:
-        {
-          for (l = 0; l < dim[3]; l++) {
-            for (i = 0; i < dim[2]; i++) {
-              for (k = 0; k < num_mem; k++) {
-                c = 1;
-                for (j = 0; j < LINEAR_SECOND + 1; j++)
-                  c *= tensor_merge->tensors_config.info.info[k].dimension[j];
-
-                s = element_size * c;
-
-                inptr = mInfo[k].data + (l * dim[2] + i) * s;
-
-                memcpy (outptr, inptr, s);
-                outptr += s;
-              }
-            }
-          }
-          break;
-        }
-        case LINEAR_THIRD:
-        {
-          for (l = 0; l < dim[3]; l++) {
-            for (k = 0; k < num_mem; k++) {
-              c = 1;
-              for (j = 0; j < LINEAR_THIRD + 1; j++)
-                c *= tensor_merge->tensors_config.info.info[k].dimension[j];
-
-              s = element_size * c;
-
-              inptr = mInfo[k].data + l * s;
-
-              memcpy (outptr, inptr, s);
-              outptr += s;
-            }
-          }
-          break;
-        }
-        case LINEAR_FOURTH:
-        {
-          for (k = 0; k < num_mem; k++) {
-            c = 1;
-            for (j = 0; j < LINEAR_FOURTH + 1; j++)
-              c *= tensor_merge->tensors_config.info.info[k].dimension[j];
-
-            s = element_size * c;
-
-            inptr = mInfo[k].data;
-            memcpy (outptr, inptr, s);
-            outptr += s;
-          }
-          break;
-        }
-        default:
-          ret = GST_FLOW_ERROR;
-      }
-      break;
-    }
-    default:
+  /* The upstream elements may have written the tensors into the slices (see gst_tensor_merge_sink_query()). */
+  outMem = (outer == 1) ?
+      gst_tensor_merge_join_slices (mem, mInfo, num_mem, outSize) : NULL;
+
+  if (outMem == NULL) {
+    outMem = gst_allocator_alloc (NULL, outSize, NULL);
+    nns_profile_alloc (tensor_merge, outSize);
+    if (!outMem || !gst_memory_map (outMem, &outInfo, GST_MAP_WRITE)) {
+      if (outMem)
+        gst_allocator_free (NULL, outMem);
+      ml_logf ("Cannot map output memory buffer\n");
       ret = GST_FLOW_ERROR;
+      goto error_ret;
+    }
+
+    gst_tensor_merge_interleave (outInfo.data, inptr, block, num_mem, outer);
+    nns_profile_copied (tensor_merge, outSize);
+    gst_memory_unmap (outMem, &outInfo);
   }
 
-  gst_memory_unmap (outMem, &outInfo);
   gst_buffer_append_memory (tensor_buf, outMem);
   gst_buffer_copy_into (tensor_buf, tensors_buf, GST_BUFFER_COPY_TIMESTAMPS, 0,
       -1);
@@ -733,6 +1230,7 @@ gst_tensor_merge_ready_to_paused (GstTensorMerge * tensor_merge)
   tensor_merge->need_stream_start = TRUE;
   tensor_merge->need_segment = TRUE;
   tensor_merge->negotiated = FALSE;
+  gst_tensor_merge_reset_layout (tensor_merge);
   gst_collect_pads_start (tensor_merge->collect);
 }
 
@@ -41,6 +41,7 @@ G_BEGIN_DECLS
 #define GST_TENSOR_MERGE_CAST(obj)((GstTensorMerge*)(obj))
 typedef struct _GstTensorMerge GstTensorMerge;
 typedef struct _GstTensorMergeClass GstTensorMergeClass;
+typedef struct _tensor_merge_layout_s tensor_merge_layout_s;
 
 typedef enum
 {
@@ -91,6 +92,7 @@ struct _GstTensorMerge
   GstClockTime current_time;
   gboolean need_set_time;
   GstTensorsConfig tensors_config; /**< output tensors info */
+  tensor_merge_layout_s *layout; /**< layout of the merged tensor shared with the buffer pools of the sink pads */
 };
 
 /**
@@ -280,7 +280,8 @@ gst_tensor_mux_request_new_pad (GstElement * element, GstPadTemplate * templ,
 
     tensormuxpad = (GstTensorCollectPadData *)
         gst_collect_pads_add_pad (tensor_mux->collect, newpad,
-        sizeof (GstTensorCollectPadData), NULL, locked);
+        sizeof (GstTensorCollectPadData),
+        gst_tensor_time_sync_pad_data_free, locked);
 
     /* NOTE: if locked is TRUE, waiting flag is not effective */
     gst_collect_pads_set_waiting (tensor_mux->collect,
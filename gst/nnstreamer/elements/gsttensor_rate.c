@@ -28,6 +28,13 @@
  * to upstream elements by sending qos events, which prevents unnecessary
  * data from upstream elements.
  *
+ * When 'adaptive' property is set, it estimates a sustainable output rate
+ * from qos events of downstream elements and the 'latency' of the downstream
+ * tensor_filter (if latency=1 is set on it), and drops the frames exceeding
+ * the rate. With 'throttle', the estimated interval is also propagated to
+ * upstream elements, so that the backlog is shed at the source instead of
+ * piling up in queues.
+ *
  * <refsect2>
  * <title>Example launch line with tensor rate</title>
  * gst-launch-1.0 videotestsrc
@@ -38,6 +45,17 @@
  *      ! videoconvert
  *      ! autovideosink
  * </refsect2>
+ *
+ * <refsect2>
+ * <title>Example launch line with adaptive tensor rate</title>
+ * gst-launch-1.0 v4l2src ! videoconvert ! videoscale
+ *      ! video/x-raw,width=224,height=224,format=RGB
+ *      ! tensor_converter
+ *      ! tensor_rate adaptive=true
+ *      ! queue leaky=2 max-size-buffers=2
+ *      ! tensor_filter framework=tensorflow-lite model=model.tflite latency=1
+ *      ! fakesink
+ * </refsect2>
  */
 
 #ifdef HAVE_CONFIG_H
@@ -72,6 +90,22 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_rate_debug);
 /** @brief default parameters */
 #define DEFAULT_SILENT    TRUE
 #define DEFAULT_THROTTLE  TRUE
+#define DEFAULT_ADAPTIVE  FALSE
+
+/**
+ * @brief The minimum output interval in adaptive mode. The shorter interval is regarded as no limit.
+ */
+#define ADAPTIVE_MIN_INTERVAL (GST_MSECOND)
+
+/**
+ * @brief The number of frames to check the latency of downstream tensor_filter again.
+ */
+#define ADAPTIVE_LATENCY_CHECK_FRAMES (30)
+
+/**
+ * @brief The maximum number of elements to search downstream tensor_filter.
+ */
+#define ADAPTIVE_SEARCH_DEPTH (8)
 
 /**
  * @brief tensor_rate properties
@@ -86,6 +120,7 @@ enum
   PROP_SILENT,
   PROP_THROTTLE,
   PROP_FRAMERATE,
+  PROP_ADAPTIVE,
 };
 
 /**
@@ -138,6 +173,10 @@ static gboolean gst_tensor_rate_start (GstBaseTransform * trans);
 static gboolean gst_tensor_rate_stop (GstBaseTransform * trans);
 static gboolean gst_tensor_rate_sink_event (GstBaseTransform * trans,
     GstEvent * event);
+static gboolean gst_tensor_rate_src_event (GstBaseTransform * trans,
+    GstEvent * event);
+static gboolean gst_tensor_rate_adaptive_drop (GstTensorRate * self,
+    GstClockTime ts);
 
 static void gst_tensor_rate_install_properties (GObjectClass * gobject_class);
 
@@ -189,6 +228,7 @@ gst_tensor_rate_class_init (GstTensorRateClass * klass)
 
   /* setup sink event */
   trans_class->sink_event = GST_DEBUG_FUNCPTR (gst_tensor_rate_sink_event);
+  trans_class->src_event = GST_DEBUG_FUNCPTR (gst_tensor_rate_src_event);
 
   /* start/stop to call open/close */
   trans_class->start = GST_DEBUG_FUNCPTR (gst_tensor_rate_start);
@@ -244,6 +284,20 @@ gst_tensor_rate_push_buffer (GstTensorRate * self, GstBuffer * outbuf,
   /* adapt for looping, bring back to time in current segment. */
   GST_BUFFER_TIMESTAMP (outbuf) = push_ts - self->segment.base;
 
+  /* keep the output timeline, but skip the frame exceeding the sustainable rate */
+  if (gst_tensor_rate_adaptive_drop (self, push_ts)) {
+    silent_debug (self, "adaptive mode, dropping buffer outgoing ts %"
+        GST_TIME_FORMAT, GST_TIME_ARGS (push_ts));
+    self->out--;
+    self->drop++;
+
+    if (!self->silent)
+      gst_tensor_rate_notify_drop (self);
+
+    gst_buffer_unref (outbuf);
+    return GST_FLOW_OK;
+  }
+
   silent_debug (self, "old is best, dup, pushing buffer outgoing ts %"
       GST_TIME_FORMAT, GST_TIME_ARGS (push_ts));
 
@@ -307,6 +361,14 @@ gst_tensor_rate_reset (GstTensorRate * self)
 
   self->sent_qos_on_passthrough = FALSE;
 
+  self->qos_interval = 0;
+  self->filter_interval = 0;
+  self->sent_interval = 0;
+  self->avg_interval = 0;
+  self->last_out_ts = GST_CLOCK_TIME_NONE;
+  self->adaptive_next_ts = GST_CLOCK_TIME_NONE;
+  self->adaptive_count = 0;
+
   gst_tensor_rate_swap_prev (self, NULL, 0);
 }
 
@@ -320,6 +382,7 @@ gst_tensor_rate_init (GstTensorRate * self)
 
   self->silent = DEFAULT_SILENT;
   self->throttle = DEFAULT_THROTTLE;
+  self->adaptive = DEFAULT_ADAPTIVE;
 
   /* decided from caps negotiation */
   self->from_rate_numerator = 0;
@@ -361,6 +424,9 @@ gst_tensor_rate_set_property (GObject * object, guint prop_id,
     case PROP_THROTTLE:
       self->throttle = g_value_get_boolean (value);
       break;
+    case PROP_ADAPTIVE:
+      self->adaptive = g_value_get_boolean (value);
+      break;
     case PROP_FRAMERATE:
     {
       const gchar *str = g_value_get_string (value);
@@ -430,6 +496,9 @@ gst_tensor_rate_get_property (GObject * object, guint prop_id,
     case PROP_THROTTLE:
       g_value_set_boolean (value, self->throttle);
       break;
+    case PROP_ADAPTIVE:
+      g_value_set_boolean (value, self->adaptive);
+      break;
     case PROP_FRAMERATE:
       if (self->rate_n < 0 || self->rate_d <= 0) {
         g_value_set_string (value, "");
@@ -449,17 +518,17 @@ gst_tensor_rate_get_property (GObject * object, guint prop_id,
 #define THROTTLE_DELAY_RATIO (0.999)
 
 /**
- * @brief send throttling qos event to upstream elements
+ * @brief send throttling qos event with the given interval to upstream elements
  */
 static void
-gst_tensor_rate_send_qos_throttle (GstTensorRate * self, GstClockTime timestamp)
+gst_tensor_rate_push_qos_throttle (GstTensorRate * self, GstClockTime interval,
+    GstClockTime timestamp)
 {
   GstPad *sinkpad = GST_BASE_TRANSFORM_SINK_PAD (&self->element);
   GstClockTimeDiff delay;
   GstEvent *event;
 
-  delay = GST_TENSOR_RATE_SCALED_TIME (self, 1);
-  delay = (GstClockTimeDiff) (((gdouble) delay) * THROTTLE_DELAY_RATIO);
+  delay = (GstClockTimeDiff) (((gdouble) interval) * THROTTLE_DELAY_RATIO);
 
   event = gst_event_new_qos (GST_QOS_TYPE_THROTTLE,
       0.9 /** unused */ , delay, timestamp);
@@ -470,6 +539,163 @@ gst_tensor_rate_send_qos_throttle (GstTensorRate * self, GstClockTime timestamp)
   gst_pad_push_event (sinkpad, event);
 }
 
+/**
+ * @brief send throttling qos event to upstream elements
+ */
+static void
+gst_tensor_rate_send_qos_throttle (GstTensorRate * self, GstClockTime timestamp)
+{
+  gst_tensor_rate_push_qos_throttle (self,
+      GST_TENSOR_RATE_SCALED_TIME (self, 1), timestamp);
+}
+
+/**
+ * @brief get the output interval from the latency of downstream tensor_filter
+ * @return the interval, or 0 if no tensor_filter reports the latency
+ */
+static GstClockTime
+gst_tensor_rate_get_filter_interval (GstTensorRate * self)
+{
+  GType filter_type = g_type_from_name ("GstTensorFilter");
+  GstPad *pad = gst_object_ref (GST_BASE_TRANSFORM_SRC_PAD (&self->element));
+  GstClockTime interval = 0;
+  guint depth;
+
+  for (depth = 0; pad && depth < ADAPTIVE_SEARCH_DEPTH; depth++) {
+    GstPad *peer = gst_pad_get_peer (pad);
+    GstElement *element = NULL;
+
+    gst_object_unref (pad);
+    pad = NULL;
+
+    if (peer) {
+      element = gst_pad_get_parent_element (peer);
+      gst_object_unref (peer);
+    }
+
+    if (!element)
+      break;
+
+    if (filter_type != 0 && G_TYPE_CHECK_INSTANCE_TYPE (element, filter_type)) {
+      gint latency = -1;
+      guint workers = 1;
+
+      /* latency is the average invoke time in usec (-1 if profiling is off) */
+      g_object_get (element, "latency", &latency, "workers", &workers, NULL);
+      if (latency > 0)
+        interval = ((GstClockTime) latency) * GST_USECOND / MAX (workers, 1U);
+
+      gst_object_unref (element);
+      break;
+    }
+
+    /* follow the element with a single source pad (e.g., queue) */
+    GST_OBJECT_LOCK (element);
+    if (element->numsrcpads == 1)
+      pad = gst_object_ref (element->srcpads->data);
+    GST_OBJECT_UNLOCK (element);
+
+    gst_object_unref (element);
+  }
+
+  if (pad)
+    gst_object_unref (pad);
+
+  return interval;
+}
+
+/**
+ * @brief update the output interval with the proportion of qos event from downstream
+ */
+static void
+gst_tensor_rate_update_qos_interval (GstTensorRate * self, GstQOSType type,
+    gdouble proportion)
+{
+  GstClockTime base, target;
+
+  if (proportion <= 0.0)
+    return;
+
+  GST_OBJECT_LOCK (self);
+
+  base = (self->qos_interval > 0) ? self->qos_interval : self->avg_interval;
+  if (base > 0) {
+    /**
+     * underflow (e.g., sink): proportion is the ratio of processing time to real-time.
+     * overflow (tensor_filter throttling): proportion is the ratio of incoming interval to the latency.
+     */
+    if (type == GST_QOS_TYPE_OVERFLOW)
+      target = (GstClockTime) (((gdouble) base) / proportion);
+    else
+      target = (GstClockTime) (((gdouble) base) * proportion);
+
+    if (self->qos_interval > 0)
+      target = (self->qos_interval * 3 + target) / 4;
+
+    self->qos_interval = (target < ADAPTIVE_MIN_INTERVAL) ? 0 : target;
+
+    silent_debug (self, "qos proportion %f, output interval %" GST_TIME_FORMAT,
+        proportion, GST_TIME_ARGS (self->qos_interval));
+  }
+
+  GST_OBJECT_UNLOCK (self);
+}
+
+/**
+ * @brief check whether the frame exceeds the sustainable rate in adaptive mode
+ * @param[in] self "this" pointer
+ * @param[in] ts timestamp of the frame to be pushed
+ * @return TRUE if the frame should be dropped
+ */
+static gboolean
+gst_tensor_rate_adaptive_drop (GstTensorRate * self, GstClockTime ts)
+{
+  GstClockTime interval;
+
+  if (!self->adaptive || !GST_CLOCK_TIME_IS_VALID (ts))
+    return FALSE;
+
+  if (self->adaptive_count++ % ADAPTIVE_LATENCY_CHECK_FRAMES == 0) {
+    GstClockTime filter_interval = gst_tensor_rate_get_filter_interval (self);
+
+    GST_OBJECT_LOCK (self);
+    self->filter_interval = filter_interval;
+    GST_OBJECT_UNLOCK (self);
+  }
+
+  GST_OBJECT_LOCK (self);
+  interval = MAX (self->qos_interval, self->filter_interval);
+  GST_OBJECT_UNLOCK (self);
+
+  if (interval > 0 && GST_CLOCK_TIME_IS_VALID (self->adaptive_next_ts) &&
+      ts < self->adaptive_next_ts)
+    return TRUE;
+
+  /* keep the average rate even if the interval is not a multiple of the incoming one */
+  if (interval > 0 && GST_CLOCK_TIME_IS_VALID (self->adaptive_next_ts) &&
+      ts < self->adaptive_next_ts + interval)
+    self->adaptive_next_ts += interval;
+  else
+    self->adaptive_next_ts = ts + interval;
+
+  if (GST_CLOCK_TIME_IS_VALID (self->last_out_ts) && ts > self->last_out_ts) {
+    GstClockTime diff = ts - self->last_out_ts;
+
+    self->avg_interval = (self->avg_interval > 0) ?
+        (self->avg_interval * 7 + diff) / 8 : diff;
+  }
+  self->last_out_ts = ts;
+
+  /* propagate the interval to upstream if it is changed more than 10% */
+  if (self->throttle && interval > 0 &&
+      ABSDIFF (interval, self->sent_interval) * 10 > self->sent_interval) {
+    self->sent_interval = interval;
+    gst_tensor_rate_push_qos_throttle (self, interval, ts);
+  }
+
+  return FALSE;
+}
+
 /**
  * @brief in-place transform
  */
@@ -522,6 +748,15 @@ gst_tensor_rate_transform_ip (GstBaseTransform * trans, GstBuffer * buffer)
       gst_tensor_rate_send_qos_throttle (self, intime);
     }
 
+    if (gst_tensor_rate_adaptive_drop (self, intime)) {
+      self->drop++;
+
+      if (!self->silent)
+        gst_tensor_rate_notify_drop (self);
+
+      return GST_BASE_TRANSFORM_FLOW_DROPPED;
+    }
+
     self->out++;
     return GST_FLOW_OK;
   }
@@ -919,6 +1154,34 @@ gst_tensor_rate_sink_event (GstBaseTransform * trans, GstEvent * event)
   return GST_BASE_TRANSFORM_CLASS (parent_class)->sink_event (trans, event);
 }
 
+/**
+ * @brief Event handler for src pad of tensor rate.
+ * @param[in] trans "this" pointer
+ * @param[in] event a passed event object
+ * @return TRUE if there is no error.
+ */
+static gboolean
+gst_tensor_rate_src_event (GstBaseTransform * trans, GstEvent * event)
+{
+  GstTensorRate *self = GST_TENSOR_RATE (trans);
+
+  if (GST_EVENT_TYPE (event) == GST_EVENT_QOS && self->adaptive) {
+    GstQOSType type;
+    gdouble proportion;
+    GstClockTimeDiff diff;
+    GstClockTime timestamp;
+
+    gst_event_parse_qos (event, &type, &proportion, &diff, &timestamp);
+
+    /* throttling events of downstream are not a measure of the processing time */
+    if (type != GST_QOS_TYPE_THROTTLE)
+      gst_tensor_rate_update_qos_interval (self, type, proportion);
+  }
+
+  /* other events are handled in the default event handler */
+  return GST_BASE_TRANSFORM_CLASS (parent_class)->src_event (trans, event);
+}
+
 /**
  * @brief Called when the element starts processing. optional vmethod of BaseTransform
  * @param[in] trans "this" pointer
@@ -994,4 +1257,12 @@ gst_tensor_rate_install_properties (GObjectClass * object_class)
           "Specify a target framerate to adjust (e.g., framerate=10/1). "
           "Otherwise, the latest processing time will be a target interval.",
           "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /* PROP_ADAPTIVE */
+  g_object_class_install_property (object_class, PROP_ADAPTIVE,
+      g_param_spec_boolean ("adaptive", "Adaptive",
+          "Estimate a sustainable output rate from qos events and the latency "
+          "of downstream tensor_filter (with latency=1), "
+          "and drop the frames exceeding the rate",
+          DEFAULT_ADAPTIVE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
@@ -57,11 +57,21 @@ struct _GstTensorRate
   guint64 next_ts;              /**< Timestamp of next buffer to output */
   guint64 last_ts;              /**< Timestamp of last input buffer */
 
+  /** Adaptive rate */
+  GstClockTime qos_interval;    /**< output interval estimated from qos events (0 if not limited) */
+  GstClockTime filter_interval; /**< output interval from the latency of downstream tensor_filter */
+  GstClockTime sent_interval;   /**< output interval sent to upstream elements */
+  GstClockTime avg_interval;    /**< moving average of the output interval */
+  GstClockTime last_out_ts;     /**< timestamp of the last output in adaptive mode */
+  GstClockTime adaptive_next_ts; /**< earliest timestamp of the next output in adaptive mode */
+  guint64 adaptive_count;       /**< number of frames since the latency of downstream is checked */
+
   /** Properties */
   guint64 in, out, dup, drop;   /**< stat property */
   gint rate_n, rate_d;          /**< framerate property */
   gboolean silent;              /**< debug property */
   gboolean throttle;            /**< throttle property */
+  gboolean adaptive;            /**< adaptive property */
 };
 
 /**
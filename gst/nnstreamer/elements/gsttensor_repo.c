@@ -42,6 +42,20 @@ static GstTensorRepo _repo = {.num_data = 0,.initialized = FALSE };
 #define GST_REPO_WAIT() (g_cond_wait(&_repo.repo_cond, &_repo.repo_lock))
 #define GST_REPO_BROADCAST() (g_cond_broadcast (&_repo.repo_cond))
 
+/**
+ * @brief Wake up the threads waiting on the slot.
+ * The waiters check the slot with the lock after increasing the counter, so the lock is not needed if nobody waits.
+ */
+static inline void
+gst_tensor_repo_wake (GstTensorRepoData * data, GCond * cond, gint * waiting)
+{
+  if (g_atomic_int_get (waiting) > 0) {
+    g_mutex_lock (&data->lock);
+    g_cond_broadcast (cond);
+    g_mutex_unlock (&data->lock);
+  }
+}
+
 /**
  * @brief Getter to get nth GstTensorRepoData.
  */
@@ -52,7 +66,9 @@ gst_tensor_repo_get_repodata (guint nth)
 
   g_return_val_if_fail (_repo.initialized, NULL);
 
+  g_rw_lock_reader_lock (&_repo.hash_lock);
   p = g_hash_table_lookup (_repo.hash, GINT_TO_POINTER (nth));
+  g_rw_lock_reader_unlock (&_repo.hash_lock);
 
   return (GstTensorRepoData *) p;
 }
@@ -71,21 +87,21 @@ gst_tensor_repo_set_changed (guint o_nth, guint nth, gboolean is_sink)
     g_mutex_lock (&data->lock);
 
     if (is_sink) {
-      data->sink_changed = TRUE;
       data->sink_id = nth;
+      g_atomic_int_set (&data->sink_changed, TRUE);
       if (DBG)
         GST_DEBUG ("SET sink_changed! @id %d \n", o_nth);
 
       /* signal pull */
-      g_cond_signal (&data->cond_pull);
+      g_cond_broadcast (&data->cond_pull);
     } else {
-      data->src_changed = TRUE;
       data->src_id = nth;
+      g_atomic_int_set (&data->src_changed, TRUE);
       if (DBG)
         GST_DEBUG ("SET src_changed! @id %d\n", o_nth);
 
       /* signal push */
-      g_cond_signal (&data->cond_push);
+      g_cond_broadcast (&data->cond_push);
     }
 
     g_mutex_unlock (&data->lock);
@@ -110,9 +126,9 @@ gst_tensor_repo_add_repodata (guint nth, gboolean is_sink)
     g_mutex_lock (&data->lock);
 
     if (is_sink)
-      data->sink_changed = FALSE;
+      g_atomic_int_set (&data->sink_changed, FALSE);
     else
-      data->src_changed = FALSE;
+      g_atomic_int_set (&data->src_changed, FALSE);
 
     data->pushed = FALSE;
 
@@ -136,14 +152,22 @@ gst_tensor_repo_add_repodata (guint nth, gboolean is_sink)
   g_mutex_lock (&data->lock);
   data->eos = FALSE;
   data->buffer = NULL;
+  data->buffer_caps = NULL;
   data->caps = NULL;
+  data->double_buffer = FALSE;
+  data->next_buffer = NULL;
+  data->next_caps = NULL;
+  data->waiting_push = 0;
+  data->waiting_pull = 0;
   data->sink_changed = FALSE;
   data->src_changed = FALSE;
   data->pushed = FALSE;
   g_mutex_unlock (&data->lock);
 
   GST_REPO_LOCK ();
+  g_rw_lock_writer_lock (&_repo.hash_lock);
   ret = g_hash_table_insert (_repo.hash, GINT_TO_POINTER (nth), data);
+  g_rw_lock_writer_unlock (&_repo.hash_lock);
 
   if (ret) {
     _repo.num_data++;
@@ -159,10 +183,10 @@ gst_tensor_repo_add_repodata (guint nth, gboolean is_sink)
 }
 
 /**
- * @brief Push GstBuffer into repo.
+ * @brief Set the double-buffered mode of slot.
  */
 gboolean
-gst_tensor_repo_set_buffer (guint nth, GstBuffer * buffer, GstCaps * caps)
+gst_tensor_repo_set_double_buffer (guint nth, gboolean enable)
 {
   GstTensorRepoData *data;
 
@@ -171,33 +195,137 @@ gst_tensor_repo_set_buffer (guint nth, GstBuffer * buffer, GstCaps * caps)
   g_return_val_if_fail (data != NULL, FALSE);
 
   g_mutex_lock (&data->lock);
+  g_atomic_int_set (&data->double_buffer, enable);
+  g_mutex_unlock (&data->lock);
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to update the caps from the producer.
+ * @return the caps of the buffer
+ */
+static GstCaps *
+gst_tensor_repo_update_caps (GstTensorRepoData * data, GstCaps * caps)
+{
+  if (!data->caps || !gst_caps_is_equal (data->caps, caps)) {
+    if (data->caps)
+      gst_caps_unref (data->caps);
+    data->caps = gst_caps_copy (caps);
+  }
+
+  return gst_caps_ref (data->caps);
+}
 
-  while (data->buffer != NULL && !data->eos) {
+/**
+ * @brief Internal function to move the next buffer to the empty slot.
+ */
+static void
+gst_tensor_repo_promote_next_locked (GstTensorRepoData * data)
+{
+  if (g_atomic_pointer_get (&data->buffer) == NULL && data->next_buffer) {
+    data->buffer_caps = data->next_caps;
+    data->next_caps = NULL;
+    g_atomic_pointer_set (&data->buffer, data->next_buffer);
+    data->next_buffer = NULL;
+  }
+}
+
+/**
+ * @brief Internal function to push the buffer in double-buffered mode.
+ * The producer waits only if both the slot and the next buffer are occupied.
+ */
+static gboolean
+gst_tensor_repo_set_double_buffer_locked (GstTensorRepoData * data,
+    GstBuffer * buffer, GstCaps * caps)
+{
+  g_atomic_int_inc (&data->waiting_pull);
+
+  while (g_atomic_pointer_get (&data->buffer) != NULL &&
+      data->next_buffer != NULL && !g_atomic_int_get (&data->eos)) {
     /* wait pull */
     g_cond_wait (&data->cond_pull, &data->lock);
   }
 
-  if (data->eos) {
-    g_mutex_unlock (&data->lock);
+  g_atomic_int_add (&data->waiting_pull, -1);
+
+  if (g_atomic_int_get (&data->eos))
     return FALSE;
+
+  /* keep the order if the consumer has not moved the next buffer yet */
+  gst_tensor_repo_promote_next_locked (data);
+
+  if (g_atomic_pointer_get (&data->buffer) == NULL) {
+    /* the consumer has taken all buffers, publish it in the slot */
+    data->buffer_caps = gst_tensor_repo_update_caps (data, caps);
+    g_atomic_pointer_set (&data->buffer, gst_buffer_ref (buffer));
+  } else {
+    data->next_caps = gst_tensor_repo_update_caps (data, caps);
+    data->next_buffer = gst_buffer_ref (buffer);
   }
 
-  data->buffer = gst_buffer_copy_deep (buffer);
-  if (!data->caps || !gst_caps_is_equal (data->caps, caps)) {
-    if (data->caps)
-      gst_caps_unref (data->caps);
-    data->caps = gst_caps_copy (caps);
+  /* signal push */
+  if (g_atomic_int_get (&data->waiting_push) > 0)
+    g_cond_broadcast (&data->cond_push);
+
+  return TRUE;
+}
+
+/**
+ * @brief Push GstBuffer into repo.
+ */
+gboolean
+gst_tensor_repo_set_buffer (guint nth, GstBuffer * buffer, GstCaps * caps)
+{
+  GstTensorRepoData *data;
+
+  data = gst_tensor_repo_get_repodata (nth);
+
+  g_return_val_if_fail (data != NULL, FALSE);
+
+  if (g_atomic_int_get (&data->double_buffer)) {
+    gboolean ret;
+
+    g_mutex_lock (&data->lock);
+    ret = gst_tensor_repo_set_double_buffer_locked (data, buffer, caps);
+    g_mutex_unlock (&data->lock);
+
+    return ret;
+  }
+
+  if (g_atomic_pointer_get (&data->buffer) != NULL &&
+      !g_atomic_int_get (&data->eos)) {
+    g_mutex_lock (&data->lock);
+    g_atomic_int_inc (&data->waiting_pull);
+
+    while (g_atomic_pointer_get (&data->buffer) != NULL &&
+        !g_atomic_int_get (&data->eos)) {
+      /* wait pull */
+      g_cond_wait (&data->cond_pull, &data->lock);
+    }
+
+    g_atomic_int_add (&data->waiting_pull, -1);
+    g_mutex_unlock (&data->lock);
   }
 
+  if (g_atomic_int_get (&data->eos))
+    return FALSE;
+
+  /* the slot is empty, only the producer updates the caps */
+  data->buffer_caps = gst_tensor_repo_update_caps (data, caps);
+
   if (DBG) {
-    unsigned long size = gst_buffer_get_size (data->buffer);
+    unsigned long size = gst_buffer_get_size (buffer);
     GST_DEBUG ("Pushed [%d] (size : %lu)\n", nth, size);
   }
 
-  /* signal push */
-  g_cond_signal (&data->cond_push);
+  /**
+   * Publish the buffer, the memory is shared with the consumer.
+   * Downstream elements of reposrc copy the buffer if they need to write it.
+   */
+  g_atomic_pointer_set (&data->buffer, gst_buffer_ref (buffer));
 
-  g_mutex_unlock (&data->lock);
+  /* signal push */
+  gst_tensor_repo_wake (data, &data->cond_push, &data->waiting_push);
   return TRUE;
 }
 
@@ -212,9 +340,11 @@ gst_tensor_repo_check_eos (guint nth)
   data = gst_tensor_repo_get_repodata (nth);
 
   if (data) {
+    gboolean eos = g_atomic_int_get (&data->eos);
+
     if (DBG)
-      GST_DEBUG ("check eos done [%s]\n", data->eos ? "TRUE" : "FALSE");
-    return data->eos;
+      GST_DEBUG ("check eos done [%s]\n", eos ? "TRUE" : "FALSE");
+    return eos;
   }
 
   return FALSE;
@@ -238,12 +368,12 @@ gst_tensor_repo_check_changed (guint nth, guint * newid, gboolean is_sink)
         data->sink_changed, data->src_changed);
 
   if (is_sink) {
-    if (data->sink_changed) {
+    if (g_atomic_int_get (&data->sink_changed)) {
       *newid = data->sink_id;
       ret = TRUE;
     }
   } else {
-    if (data->src_changed) {
+    if (g_atomic_int_get (&data->src_changed)) {
       *newid = data->src_id;
       ret = TRUE;
     }
@@ -266,9 +396,9 @@ gst_tensor_repo_set_eos (guint nth)
 
   g_mutex_lock (&data->lock);
 
-  data->eos = TRUE;
-  g_cond_signal (&data->cond_push);
-  g_cond_signal (&data->cond_pull);
+  g_atomic_int_set (&data->eos, TRUE);
+  g_cond_broadcast (&data->cond_push);
+  g_cond_broadcast (&data->cond_pull);
 
   g_mutex_unlock (&data->lock);
   return TRUE;
@@ -288,37 +418,54 @@ gst_tensor_repo_get_buffer (guint nth, gboolean * eos, guint * newid,
 
   g_return_val_if_fail (data != NULL, NULL);
 
-  g_mutex_lock (&data->lock);
+  buf = (GstBuffer *) g_atomic_pointer_get (&data->buffer);
 
-  while (!data->buffer) {
-    if (gst_tensor_repo_check_changed (nth, newid, FALSE)) {
-      buf = NULL;
-      goto done;
-    }
+  if (!buf) {
+    g_mutex_lock (&data->lock);
+    g_atomic_int_inc (&data->waiting_push);
+
+    while (!(buf = (GstBuffer *) g_atomic_pointer_get (&data->buffer))) {
+      if (gst_tensor_repo_check_changed (nth, newid, FALSE))
+        break;
 
-    if (gst_tensor_repo_check_eos (nth)) {
-      *eos = TRUE;
-      buf = NULL;
-      goto done;
+      if (gst_tensor_repo_check_eos (nth)) {
+        *eos = TRUE;
+        break;
+      }
+
+      /* wait push */
+      g_cond_wait (&data->cond_push, &data->lock);
     }
 
-    /* wait push */
-    g_cond_wait (&data->cond_push, &data->lock);
+    g_atomic_int_add (&data->waiting_push, -1);
+    g_mutex_unlock (&data->lock);
+
+    if (!buf)
+      return NULL;
   }
 
-  /* Current buffer will be wasted. */
-  buf = data->buffer;
-  *caps = gst_caps_ref (data->caps);
+  /* take the caps before releasing the slot, the producer updates it after pull */
+  *caps = data->buffer_caps;
+  data->buffer_caps = NULL;
+
   if (DBG) {
     unsigned long size = gst_buffer_get_size (buf);
     GST_DEBUG ("Popped [ %d ] (size: %lu)\n", nth, size);
   }
 
-done:
-  data->buffer = NULL;
+  g_atomic_pointer_set (&data->buffer, NULL);
+
+  if (g_atomic_int_get (&data->double_buffer)) {
+    /* move the next buffer to the slot, the producer may publish another one */
+    g_mutex_lock (&data->lock);
+    gst_tensor_repo_promote_next_locked (data);
+    g_cond_broadcast (&data->cond_pull);
+    g_mutex_unlock (&data->lock);
+    return buf;
+  }
+
   /* signal pull */
-  g_cond_signal (&data->cond_pull);
-  g_mutex_unlock (&data->lock);
+  gst_tensor_repo_wake (data, &data->cond_pull, &data->waiting_pull);
   return buf;
 }
 
@@ -340,6 +487,12 @@ gst_tensor_repo_remove_repodata (guint nth)
     g_mutex_lock (&data->lock);
     if (data->buffer)
       gst_buffer_unref (data->buffer);
+    if (data->buffer_caps)
+      gst_caps_unref (data->buffer_caps);
+    if (data->next_buffer)
+      gst_buffer_unref (data->next_buffer);
+    if (data->next_caps)
+      gst_caps_unref (data->next_caps);
     if (data->caps)
       gst_caps_unref (data->caps);
     g_mutex_unlock (&data->lock);
@@ -348,7 +501,9 @@ gst_tensor_repo_remove_repodata (guint nth)
     g_cond_clear (&data->cond_pull);
     g_cond_clear (&data->cond_push);
 
+    g_rw_lock_writer_lock (&_repo.hash_lock);
     ret = g_hash_table_remove (_repo.hash, GINT_TO_POINTER (nth));
+    g_rw_lock_writer_unlock (&_repo.hash_lock);
 
     if (ret) {
       _repo.num_data--;
@@ -373,6 +528,7 @@ gst_tensor_repo_init (void)
   _repo.num_data = 0;
   g_mutex_init (&_repo.repo_lock);
   g_cond_init (&_repo.repo_cond);
+  g_rw_lock_init (&_repo.hash_lock);
   GST_REPO_LOCK ();
   _repo.hash = g_hash_table_new (g_direct_hash, g_direct_equal);
   _repo.initialized = TRUE;
@@ -36,14 +36,24 @@ G_BEGIN_DECLS
  * @brief GstTensorRepo internal data structure.
  *
  * GstTensorRepo has GSlist of GstTensorRepoData.
+ * A slot is exchanged between single producer (reposink) and single consumer (reposrc).
+ * The buffer is published and taken with atomic operations, the lock and conditions are used only to wait.
+ * In double-buffered mode, the producer may publish the next buffer while the consumer has not taken the previous one.
+ * The next buffer is kept with the lock and moved to the slot when the consumer takes the previous one.
  */
 typedef struct
 {
-  GstBuffer *buffer;
-  GstCaps *caps;
+  GstBuffer *buffer; /**< buffer in the slot (atomic, NULL if empty) */
+  GstCaps *buffer_caps; /**< caps of the buffer in the slot, owned by the consumer after taking the buffer */
+  GstCaps *caps; /**< last caps from the producer */
+  gboolean double_buffer; /**< the slot holds the next buffer as well */
+  GstBuffer *next_buffer; /**< next buffer in double-buffered mode (with the lock) */
+  GstCaps *next_caps; /**< caps of the next buffer */
   GCond cond_push;
   GCond cond_pull;
   GMutex lock;
+  gint waiting_push; /**< number of consumers waiting for push (atomic) */
+  gint waiting_pull; /**< number of producers waiting for pull (atomic) */
   gboolean eos;
   gboolean src_changed;
   guint src_id;
@@ -61,6 +71,7 @@ typedef struct
   GMutex repo_lock;
   GCond repo_cond;
   GHashTable* hash;
+  GRWLock hash_lock;
   gboolean initialized;
 } GstTensorRepo;
 
@@ -82,6 +93,12 @@ gst_tensor_repo_add_repodata (guint myid, gboolean is_sink);
 gboolean
 gst_tensor_repo_set_buffer (guint nth, GstBuffer * buffer, GstCaps * caps);
 
+/**
+ * @brief Set the double-buffered mode of slot.
+ */
+gboolean
+gst_tensor_repo_set_double_buffer (guint nth, gboolean enable);
+
 /**
  * @brief Check EOS (End-of-Stream) of slot.
  */
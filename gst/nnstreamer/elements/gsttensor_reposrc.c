@@ -48,11 +48,13 @@ enum
   PROP_0,
   PROP_CAPS,
   PROP_SLOT_ID,
+  PROP_DOUBLE_BUFFER,
   PROP_SILENT
 };
 
 #define DEFAULT_SILENT TRUE
 #define DEFAULT_INDEX 0
+#define DEFAULT_DOUBLE_BUFFER FALSE
 #define INVALID_INDEX G_MAXUINT
 
 static void gst_tensor_reposrc_set_property (GObject * object, guint prop_id,
@@ -101,6 +103,16 @@ gst_tensor_reposrc_class_init (GstTensorRepoSrcClass * klass)
           0, INVALID_INDEX - 1, DEFAULT_INDEX,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstTensorRepoSrc::double-buffer:
+   *
+   * If TRUE, the slot holds the next buffer as well, so tensor_reposink does not wait for tensor_reposrc to take the previous buffer.
+   */
+  g_object_class_install_property (gobject_class, PROP_DOUBLE_BUFFER,
+      g_param_spec_boolean ("double-buffer", "Double buffer",
+          "Let the slot hold the next buffer, the producer does not wait for the consumer to take the previous one",
+          DEFAULT_DOUBLE_BUFFER, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   basesrc_class->get_caps = gst_tensor_reposrc_getcaps;
   pushsrc_class->create = gst_tensor_reposrc_create;
 
@@ -132,6 +144,7 @@ gst_tensor_reposrc_init (GstTensorRepoSrc * self)
   self->caps = NULL;
   self->set_startid = FALSE;
   self->myid = INVALID_INDEX;
+  self->double_buffer = DEFAULT_DOUBLE_BUFFER;
 }
 
 /**
@@ -213,6 +226,7 @@ gst_tensor_reposrc_set_property (GObject * object, guint prop_id,
       self->negotiation = FALSE;
 
       gst_tensor_repo_add_repodata (self->myid, FALSE);
+      gst_tensor_repo_set_double_buffer (self->myid, self->double_buffer);
 
       if (!self->set_startid) {
         self->o_myid = self->myid;
@@ -222,6 +236,11 @@ gst_tensor_reposrc_set_property (GObject * object, guint prop_id,
       if (self->o_myid != self->myid)
         gst_tensor_repo_set_changed (self->o_myid, self->myid, FALSE);
       break;
+    case PROP_DOUBLE_BUFFER:
+      self->double_buffer = g_value_get_boolean (value);
+      if (self->myid != INVALID_INDEX)
+        gst_tensor_repo_set_double_buffer (self->myid, self->double_buffer);
+      break;
     case PROP_CAPS:
     {
       GstStructure *st = NULL;
@@ -274,6 +293,9 @@ gst_tensor_reposrc_get_property (GObject * object, guint prop_id,
     case PROP_SLOT_ID:
       g_value_set_uint (value, self->myid);
       break;
+    case PROP_DOUBLE_BUFFER:
+      g_value_set_boolean (value, self->double_buffer);
+      break;
     case PROP_CAPS:
       gst_value_set_caps (value, self->caps);
       break;
@@ -295,6 +317,13 @@ gst_tensor_reposrc_gen_dummy_buffer (GstTensorRepoSrc * self)
   guint i, num_tensors;
   gsize size = 0;
 
+  /* the initial state is pushed before the negotiation, get the config from the caps property */
+  if (!gst_tensors_config_validate (&self->config) && self->caps &&
+      gst_caps_is_fixed (self->caps)) {
+    gst_tensors_config_from_structure (&self->config,
+        gst_caps_get_structure (self->caps, 0));
+  }
+
   buf = gst_buffer_new ();
   num_tensors = self->config.info.num_tensors;
 
@@ -64,6 +64,7 @@ struct _GstTensorRepoSrc
   gint fps_d;
   gboolean negotiation;
   gboolean set_startid;
+  gboolean double_buffer;
 };
 
 /**
@@ -60,6 +60,7 @@ enum
   SIGNAL_NEW_DATA,
   SIGNAL_STREAM_START,
   SIGNAL_EOS,
+  SIGNAL_PULL_BUFFER,
   LAST_SIGNAL
 };
 
@@ -71,7 +72,10 @@ enum
   PROP_0,
   PROP_SIGNAL_RATE,
   PROP_EMIT_SIGNAL,
-  PROP_SILENT
+  PROP_SILENT,
+  PROP_MAX_BUFFERS,
+  PROP_OVERFLOW,
+  PROP_DROPPED
 };
 
 /**
@@ -89,6 +93,16 @@ enum
  */
 #define DEFAULT_SILENT TRUE
 
+/**
+ * @brief Size of the queue for the pull-buffer signal (Default 0 to disable the queue).
+ */
+#define DEFAULT_MAX_BUFFERS 0
+
+/**
+ * @brief Policy when the queue is full.
+ */
+#define DEFAULT_OVERFLOW TENSOR_SINK_OVERFLOW_DROP_OLDEST
+
 /**
  * @brief Flag for qos event.
  *
@@ -116,6 +130,10 @@ static void gst_tensor_sink_get_property (GObject * object, guint prop_id,
 static void gst_tensor_sink_finalize (GObject * object);
 
 /** GstBaseSink method implementation */
+static gboolean gst_tensor_sink_start (GstBaseSink * sink);
+static gboolean gst_tensor_sink_stop (GstBaseSink * sink);
+static gboolean gst_tensor_sink_unlock (GstBaseSink * sink);
+static gboolean gst_tensor_sink_unlock_stop (GstBaseSink * sink);
 static gboolean gst_tensor_sink_event (GstBaseSink * sink, GstEvent * event);
 static gboolean gst_tensor_sink_query (GstBaseSink * sink, GstQuery * query);
 static GstFlowReturn gst_tensor_sink_render (GstBaseSink * sink,
@@ -124,8 +142,14 @@ static GstFlowReturn gst_tensor_sink_render_list (GstBaseSink * sink,
     GstBufferList * buffer_list);
 
 /** internal functions */
-static void gst_tensor_sink_render_buffer (GstTensorSink * self,
+static GstFlowReturn gst_tensor_sink_render_buffer (GstTensorSink * self,
     GstBuffer * buffer);
+static GstFlowReturn gst_tensor_sink_queue_push (GstTensorSink * self,
+    GstBuffer * buffer);
+static GstBuffer *gst_tensor_sink_pull_buffer (GstTensorSink * self,
+    GstClockTime timeout);
+static void gst_tensor_sink_queue_clear (GstTensorSink * self);
+static void gst_tensor_sink_set_max_buffers (GstTensorSink * self, guint size);
 static void gst_tensor_sink_set_last_render_time (GstTensorSink * self,
     GstClockTime now);
 static GstClockTime gst_tensor_sink_get_last_render_time (GstTensorSink * self);
@@ -137,6 +161,30 @@ static gboolean gst_tensor_sink_get_emit_signal (GstTensorSink * self);
 static void gst_tensor_sink_set_silent (GstTensorSink * self, gboolean silent);
 static gboolean gst_tensor_sink_get_silent (GstTensorSink * self);
 
+#define GST_TYPE_TENSOR_SINK_OVERFLOW (gst_tensor_sink_overflow_get_type ())
+/**
+ * @brief A private function to register GEnumValue array for the 'overflow-policy' property
+ *        to a GType and return it
+ */
+static GType
+gst_tensor_sink_overflow_get_type (void)
+{
+  static GType mode_type = 0;
+
+  if (mode_type == 0) {
+    static GEnumValue mode_types[] = {
+      {TENSOR_SINK_OVERFLOW_DROP_OLDEST, "drop-oldest",
+          "Drop the oldest buffer in the queue"},
+      {TENSOR_SINK_OVERFLOW_BLOCK, "block",
+          "Block the streaming thread until a buffer is pulled"},
+      {0, NULL, NULL},
+    };
+    mode_type = g_enum_register_static ("tensor_sink_overflow", mode_types);
+  }
+
+  return mode_type;
+}
+
 #define gst_tensor_sink_parent_class parent_class
 G_DEFINE_TYPE (GstTensorSink, gst_tensor_sink, GST_TYPE_BASE_SINK);
 
@@ -198,6 +246,42 @@ gst_tensor_sink_class_init (GstTensorSinkClass * klass)
       g_param_spec_boolean ("silent", "Silent", "Produce verbose output",
           DEFAULT_SILENT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstTensorSink::max-buffers:
+   *
+   * The size of the queue for the action signal pull-buffer (Default 0 to disable the queue).
+   * If max-buffers is larger than 0, GstTensorSink keeps the references of the received buffers in a bounded ring,
+   * and the application threads can pop the buffers with the action signal pull-buffer, without blocking the streaming thread.
+   * If the size is reduced, the oldest buffers in the queue are dropped.
+   */
+  g_object_class_install_property (gobject_class, PROP_MAX_BUFFERS,
+      g_param_spec_uint ("max-buffers", "Max buffers",
+          "The size of the queue for pull-buffer signal (0 to disable the queue)",
+          0, G_MAXUINT16, DEFAULT_MAX_BUFFERS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorSink::overflow-policy:
+   *
+   * The policy when the queue is full. drop-oldest (default) drops the oldest buffer in the queue,
+   * block waits in the streaming thread until the application pulls a buffer.
+   */
+  g_object_class_install_property (gobject_class, PROP_OVERFLOW,
+      g_param_spec_enum ("overflow-policy", "Overflow policy",
+          "The policy when the queue for pull-buffer signal is full",
+          GST_TYPE_TENSOR_SINK_OVERFLOW, DEFAULT_OVERFLOW,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstTensorSink::dropped:
+   *
+   * The number of buffers dropped from the queue (read-only).
+   */
+  g_object_class_install_property (gobject_class, PROP_DROPPED,
+      g_param_spec_uint64 ("dropped", "Dropped",
+          "The number of buffers dropped from the queue for pull-buffer signal",
+          0, G_MAXUINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstTensorSink::new-data:
    *
@@ -230,6 +314,22 @@ gst_tensor_sink_class_init (GstTensorSinkClass * klass)
       G_STRUCT_OFFSET (GstTensorSinkClass, eos), NULL, NULL, NULL,
       G_TYPE_NONE, 0, G_TYPE_NONE);
 
+  /**
+   * GstTensorSink::pull-buffer:
+   *
+   * Action signal to pop the oldest buffer from the queue (see the property max-buffers).
+   * The parameter is the time to wait for a buffer in nanoseconds (GST_CLOCK_TIME_NONE to wait until a buffer is available).
+   * This returns NULL if timed out, end-of-stream reached or the element is stopped. The caller should unref the returned buffer.
+   * Multiple application threads may call this signal at the same time, each buffer is delivered to only one of them.
+   */
+  _tensor_sink_signals[SIGNAL_PULL_BUFFER] =
+      g_signal_new ("pull-buffer", G_TYPE_FROM_CLASS (klass),
+      G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
+      G_STRUCT_OFFSET (GstTensorSinkClass, pull_buffer), NULL, NULL, NULL,
+      GST_TYPE_BUFFER, 1, GST_TYPE_CLOCK_TIME);
+
+  klass->pull_buffer = gst_tensor_sink_pull_buffer;
+
   gst_element_class_set_static_metadata (element_class,
       "TensorSink",
       "Sink/Tensor",
@@ -244,6 +344,10 @@ gst_tensor_sink_class_init (GstTensorSinkClass * klass)
   gst_caps_unref (pad_caps);
 
   /** GstBaseSink methods */
+  bsink_class->start = GST_DEBUG_FUNCPTR (gst_tensor_sink_start);
+  bsink_class->stop = GST_DEBUG_FUNCPTR (gst_tensor_sink_stop);
+  bsink_class->unlock = GST_DEBUG_FUNCPTR (gst_tensor_sink_unlock);
+  bsink_class->unlock_stop = GST_DEBUG_FUNCPTR (gst_tensor_sink_unlock_stop);
   bsink_class->event = GST_DEBUG_FUNCPTR (gst_tensor_sink_event);
   bsink_class->query = GST_DEBUG_FUNCPTR (gst_tensor_sink_query);
   bsink_class->render = GST_DEBUG_FUNCPTR (gst_tensor_sink_render);
@@ -261,12 +365,20 @@ gst_tensor_sink_init (GstTensorSink * self)
   bsink = GST_BASE_SINK (self);
 
   g_mutex_init (&self->mutex);
+  g_cond_init (&self->cond);
 
   /** init properties */
   self->silent = DEFAULT_SILENT;
   self->emit_signal = DEFAULT_EMIT_SIGNAL;
   self->signal_rate = DEFAULT_SIGNAL_RATE;
   self->last_render_time = GST_CLOCK_TIME_NONE;
+  self->max_buffers = DEFAULT_MAX_BUFFERS;
+  self->overflow = DEFAULT_OVERFLOW;
+  self->ring = NULL;
+  self->head = self->count = 0;
+  self->dropped = 0;
+  self->flushing = TRUE;
+  self->eos = FALSE;
 
   /** enable qos */
   gst_base_sink_set_qos_enabled (bsink, DEFAULT_QOS);
@@ -301,6 +413,17 @@ gst_tensor_sink_set_property (GObject * object, guint prop_id,
       gst_tensor_sink_set_silent (self, g_value_get_boolean (value));
       break;
 
+    case PROP_MAX_BUFFERS:
+      gst_tensor_sink_set_max_buffers (self, g_value_get_uint (value));
+      break;
+
+    case PROP_OVERFLOW:
+      g_mutex_lock (&self->mutex);
+      self->overflow = g_value_get_enum (value);
+      g_cond_broadcast (&self->cond);
+      g_mutex_unlock (&self->mutex);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -333,6 +456,24 @@ gst_tensor_sink_get_property (GObject * object, guint prop_id,
       g_value_set_boolean (value, gst_tensor_sink_get_silent (self));
       break;
 
+    case PROP_MAX_BUFFERS:
+      g_mutex_lock (&self->mutex);
+      g_value_set_uint (value, self->max_buffers);
+      g_mutex_unlock (&self->mutex);
+      break;
+
+    case PROP_OVERFLOW:
+      g_mutex_lock (&self->mutex);
+      g_value_set_enum (value, self->overflow);
+      g_mutex_unlock (&self->mutex);
+      break;
+
+    case PROP_DROPPED:
+      g_mutex_lock (&self->mutex);
+      g_value_set_uint64 (value, self->dropped);
+      g_mutex_unlock (&self->mutex);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -351,11 +492,97 @@ gst_tensor_sink_finalize (GObject * object)
 
   self = GST_TENSOR_SINK (object);
 
+  gst_tensor_sink_queue_clear (self);
+  g_free (self->ring);
+  self->ring = NULL;
+
+  g_cond_clear (&self->cond);
   g_mutex_clear (&self->mutex);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+/**
+ * @brief Start processing, the queue accepts buffers.
+ *
+ * GstBaseSink method implementation.
+ */
+static gboolean
+gst_tensor_sink_start (GstBaseSink * sink)
+{
+  GstTensorSink *self;
+
+  self = GST_TENSOR_SINK (sink);
+
+  g_mutex_lock (&self->mutex);
+  self->flushing = FALSE;
+  self->eos = FALSE;
+  self->dropped = 0;
+  g_mutex_unlock (&self->mutex);
+
+  return TRUE;
+}
+
+/**
+ * @brief Stop processing, release the buffers in the queue and wake up the waiting threads.
+ *
+ * GstBaseSink method implementation.
+ */
+static gboolean
+gst_tensor_sink_stop (GstBaseSink * sink)
+{
+  GstTensorSink *self;
+
+  self = GST_TENSOR_SINK (sink);
+
+  g_mutex_lock (&self->mutex);
+  self->flushing = TRUE;
+  g_cond_broadcast (&self->cond);
+  g_mutex_unlock (&self->mutex);
+
+  gst_tensor_sink_queue_clear (self);
+  return TRUE;
+}
+
+/**
+ * @brief Unblock the streaming thread waiting for the queue (e.g., flush-start).
+ *
+ * GstBaseSink method implementation.
+ */
+static gboolean
+gst_tensor_sink_unlock (GstBaseSink * sink)
+{
+  GstTensorSink *self;
+
+  self = GST_TENSOR_SINK (sink);
+
+  g_mutex_lock (&self->mutex);
+  self->flushing = TRUE;
+  g_cond_broadcast (&self->cond);
+  g_mutex_unlock (&self->mutex);
+
+  return TRUE;
+}
+
+/**
+ * @brief Clear the unlock state.
+ *
+ * GstBaseSink method implementation.
+ */
+static gboolean
+gst_tensor_sink_unlock_stop (GstBaseSink * sink)
+{
+  GstTensorSink *self;
+
+  self = GST_TENSOR_SINK (sink);
+
+  g_mutex_lock (&self->mutex);
+  self->flushing = FALSE;
+  g_mutex_unlock (&self->mutex);
+
+  return TRUE;
+}
+
 /**
  * @brief Handle events.
  *
@@ -375,6 +602,10 @@ gst_tensor_sink_event (GstBaseSink * sink, GstEvent * event)
 
   switch (type) {
     case GST_EVENT_STREAM_START:
+      g_mutex_lock (&self->mutex);
+      self->eos = FALSE;
+      g_mutex_unlock (&self->mutex);
+
       if (gst_tensor_sink_get_emit_signal (self)) {
         silent_debug (self, "Emit signal for stream start");
 
@@ -383,6 +614,12 @@ gst_tensor_sink_event (GstBaseSink * sink, GstEvent * event)
       break;
 
     case GST_EVENT_EOS:
+      /* wake up the threads waiting for the queue, pull-buffer returns NULL after the queue is empty */
+      g_mutex_lock (&self->mutex);
+      self->eos = TRUE;
+      g_cond_broadcast (&self->cond);
+      g_mutex_unlock (&self->mutex);
+
       if (gst_tensor_sink_get_emit_signal (self)) {
         silent_debug (self, "Emit signal for eos");
 
@@ -390,6 +627,14 @@ gst_tensor_sink_event (GstBaseSink * sink, GstEvent * event)
       }
       break;
 
+    case GST_EVENT_FLUSH_STOP:
+      g_mutex_lock (&self->mutex);
+      self->eos = FALSE;
+      g_mutex_unlock (&self->mutex);
+
+      gst_tensor_sink_queue_clear (self);
+      break;
+
     default:
       break;
   }
@@ -440,9 +685,8 @@ gst_tensor_sink_render (GstBaseSink * sink, GstBuffer * buffer)
   GstTensorSink *self;
 
   self = GST_TENSOR_SINK (sink);
-  gst_tensor_sink_render_buffer (self, buffer);
 
-  return GST_FLOW_OK;
+  return gst_tensor_sink_render_buffer (self, buffer);
 }
 
 /**
@@ -457,32 +701,33 @@ gst_tensor_sink_render_list (GstBaseSink * sink, GstBufferList * buffer_list)
   GstBuffer *buffer;
   guint i;
   guint num_buffers;
+  GstFlowReturn ret = GST_FLOW_OK;
 
   self = GST_TENSOR_SINK (sink);
   num_buffers = gst_buffer_list_length (buffer_list);
 
-  for (i = 0; i < num_buffers; i++) {
+  for (i = 0; i < num_buffers && ret == GST_FLOW_OK; i++) {
     buffer = gst_buffer_list_get (buffer_list, i);
-    gst_tensor_sink_render_buffer (self, buffer);
+    ret = gst_tensor_sink_render_buffer (self, buffer);
   }
 
-  return GST_FLOW_OK;
+  return ret;
 }
 
 /**
  * @brief Handle buffer data.
- * @return None
+ * @return GST_FLOW_OK, or GST_FLOW_FLUSHING if the queue is flushed while waiting
  * @param self pointer to GstTensorSink
  * @param buffer pointer to GstBuffer to be handled
  */
-static void
+static GstFlowReturn
 gst_tensor_sink_render_buffer (GstTensorSink * self, GstBuffer * buffer)
 {
   GstClockTime now = GST_CLOCK_TIME_NONE;
   guint signal_rate;
   gboolean notify = FALSE;
 
-  g_return_if_fail (GST_IS_TENSOR_SINK (self));
+  g_return_val_if_fail (GST_IS_TENSOR_SINK (self), GST_FLOW_ERROR);
 
   signal_rate = gst_tensor_sink_get_signal_rate (self);
 
@@ -526,6 +771,169 @@ gst_tensor_sink_render_buffer (GstTensorSink * self, GstBuffer * buffer)
   }
 
   silent_debug_timestamp (self, buffer);
+
+  return gst_tensor_sink_queue_push (self, buffer);
+}
+
+/**
+ * @brief Pop the oldest buffer in the ring. The caller should hold the mutex.
+ */
+static GstBuffer *
+gst_tensor_sink_queue_pop_locked (GstTensorSink * self)
+{
+  GstBuffer *buffer;
+
+  buffer = self->ring[self->head];
+  self->ring[self->head] = NULL;
+  self->head = (self->head + 1) % self->max_buffers;
+  self->count--;
+
+  return buffer;
+}
+
+/**
+ * @brief Push the reference of the buffer into the queue for the pull-buffer signal.
+ * @return GST_FLOW_OK, or GST_FLOW_FLUSHING if the queue is flushed while waiting
+ */
+static GstFlowReturn
+gst_tensor_sink_queue_push (GstTensorSink * self, GstBuffer * buffer)
+{
+  GstFlowReturn ret = GST_FLOW_OK;
+
+  g_mutex_lock (&self->mutex);
+
+  if (self->max_buffers == 0)
+    goto done;
+
+  while (self->count >= self->max_buffers && !self->flushing &&
+      self->overflow == TENSOR_SINK_OVERFLOW_BLOCK) {
+    g_cond_wait (&self->cond, &self->mutex);
+
+    /* the queue may be disabled while waiting */
+    if (self->max_buffers == 0)
+      goto done;
+  }
+
+  if (self->flushing) {
+    ret = GST_FLOW_FLUSHING;
+    goto done;
+  }
+
+  if (self->count >= self->max_buffers) {
+    gst_buffer_unref (gst_tensor_sink_queue_pop_locked (self));
+    self->dropped++;
+  }
+
+  self->ring[(self->head + self->count) % self->max_buffers] =
+      gst_buffer_ref (buffer);
+  self->count++;
+
+  /* both the streaming thread and the application threads wait for the cond */
+  g_cond_broadcast (&self->cond);
+
+done:
+  g_mutex_unlock (&self->mutex);
+  return ret;
+}
+
+/**
+ * @brief Pop the oldest buffer from the queue (action signal pull-buffer).
+ * @param self pointer to GstTensorSink
+ * @param timeout the time to wait for a buffer (GST_CLOCK_TIME_NONE to wait until a buffer is available)
+ * @return the buffer (the caller should unref it), or NULL if timed out, eos reached or stopped.
+ */
+static GstBuffer *
+gst_tensor_sink_pull_buffer (GstTensorSink * self, GstClockTime timeout)
+{
+  GstBuffer *buffer = NULL;
+  gint64 end_time = 0;
+
+  g_return_val_if_fail (GST_IS_TENSOR_SINK (self), NULL);
+
+  if (GST_CLOCK_TIME_IS_VALID (timeout))
+    end_time = g_get_monotonic_time () + timeout / GST_USECOND;
+
+  g_mutex_lock (&self->mutex);
+
+  while (self->count == 0) {
+    if (self->eos || self->flushing || self->max_buffers == 0)
+      goto done;
+
+    if (GST_CLOCK_TIME_IS_VALID (timeout)) {
+      if (!g_cond_wait_until (&self->cond, &self->mutex, end_time))
+        goto done;
+    } else {
+      g_cond_wait (&self->cond, &self->mutex);
+    }
+  }
+
+  buffer = gst_tensor_sink_queue_pop_locked (self);
+
+  /* wake up the streaming thread if it is blocked */
+  g_cond_broadcast (&self->cond);
+
+done:
+  g_mutex_unlock (&self->mutex);
+  return buffer;
+}
+
+/**
+ * @brief Release all buffers in the queue.
+ */
+static void
+gst_tensor_sink_queue_clear (GstTensorSink * self)
+{
+  g_mutex_lock (&self->mutex);
+
+  while (self->count > 0)
+    gst_buffer_unref (gst_tensor_sink_queue_pop_locked (self));
+  self->head = 0;
+
+  g_cond_broadcast (&self->cond);
+  g_mutex_unlock (&self->mutex);
+}
+
+/**
+ * @brief Setter for the size of the queue. The newest buffers are kept if the size is reduced.
+ */
+static void
+gst_tensor_sink_set_max_buffers (GstTensorSink * self, guint size)
+{
+  GstBuffer **ring = NULL;
+  guint i, num;
+
+  g_return_if_fail (GST_IS_TENSOR_SINK (self));
+
+  GST_INFO_OBJECT (self, "set max_buffers to %u", size);
+  g_mutex_lock (&self->mutex);
+
+  if (size == self->max_buffers)
+    goto done;
+
+  while (self->count > size) {
+    gst_buffer_unref (gst_tensor_sink_queue_pop_locked (self));
+    self->dropped++;
+  }
+
+  if (size > 0) {
+    ring = g_new0 (GstBuffer *, size);
+    num = self->count;
+
+    for (i = 0; i < num; i++)
+      ring[i] = gst_tensor_sink_queue_pop_locked (self);
+
+    self->count = num;
+  }
+
+  g_free (self->ring);
+  self->ring = ring;
+  self->head = 0;
+  self->max_buffers = size;
+
+  g_cond_broadcast (&self->cond);
+
+done:
+  g_mutex_unlock (&self->mutex);
 }
 
 /**
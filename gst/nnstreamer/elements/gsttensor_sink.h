@@ -47,6 +47,15 @@ G_BEGIN_DECLS
 typedef struct _GstTensorSink GstTensorSink;
 typedef struct _GstTensorSinkClass GstTensorSinkClass;
 
+/**
+ * @brief Policy when the queue for the pull-buffer signal is full.
+ */
+typedef enum
+{
+  TENSOR_SINK_OVERFLOW_DROP_OLDEST = 0, /**< drop the oldest buffer in the queue */
+  TENSOR_SINK_OVERFLOW_BLOCK, /**< block the streaming thread until a buffer is pulled */
+} tensor_sink_overflow_policy;
+
 /**
  * @brief GstTensorSink data structure.
  *
@@ -61,6 +70,17 @@ struct _GstTensorSink
   gboolean emit_signal; /**< true to emit signal for new data, eos */
   guint signal_rate; /**< new data signals per second */
   GstClockTime last_render_time; /**< buffer rendered time */
+
+  /* queue for the pull-buffer signal (protected by mutex) */
+  GCond cond; /**< condition to wait for the queue */
+  guint max_buffers; /**< size of the queue (0 to disable the queue) */
+  tensor_sink_overflow_policy overflow; /**< policy when the queue is full */
+  GstBuffer **ring; /**< ring of buffer references */
+  guint head; /**< index of the oldest buffer in the ring */
+  guint count; /**< number of buffers in the ring */
+  guint64 dropped; /**< number of buffers dropped from the queue */
+  gboolean flushing; /**< TRUE if the queue does not accept buffers */
+  gboolean eos; /**< TRUE if end-of-stream reached */
 };
 
 /**
@@ -76,6 +96,9 @@ struct _GstTensorSinkClass
   void (*new_data) (GstElement * element, GstBuffer * buffer); /**< signal when new data received */
   void (*stream_start) (GstElement * element); /**< signal when stream started */
   void (*eos) (GstElement * element); /**< signal when end of stream reached */
+
+  /** actions */
+  GstBuffer *(*pull_buffer) (GstTensorSink * sink, GstClockTime timeout); /**< action to pull the buffer from the queue */
 };
 
 /**
@@ -17,6 +17,290 @@
 #include <tensor_data.h>
 #include "gsttensor_sparseutil.h"
 
+/**
+ * @brief The number of elements in a block to skip zero elements at once.
+ */
+#define SPARSE_BLOCK_SIZE (64U)
+
+/**
+ * @brief The min number of elements to encode the tensor with multiple threads.
+ */
+#define SPARSE_PARALLEL_MIN_ELEMENTS (1U << 20)
+
+/**
+ * @brief The max number of threads to encode the tensor.
+ */
+#define SPARSE_MAX_THREADS (8U)
+
+/**
+ * @brief Functions to count and compact the non-zero elements of a data type.
+ */
+typedef struct
+{
+  gsize (*count) (const guint8 * dense, gsize start, gsize end);
+  void (*compact) (const guint8 * dense, gsize start, gsize end,
+      guint8 * values, guint8 * indices);
+} sparse_funcs_s;
+
+/**
+ * @brief Internal data structure to encode a range of dense tensor.
+ */
+typedef struct
+{
+  const sparse_funcs_s *funcs; /**< functions for the data type */
+  const guint8 *dense; /**< dense tensor data */
+  gsize start; /**< first element of the range */
+  gsize end; /**< end of the range (exclusive) */
+  gsize nnz; /**< number of non-zero elements in the range */
+  guint8 *values; /**< position to write the values of the range */
+  guint8 *indices; /**< position to write the indices of the range */
+} sparse_range_s;
+
+/**
+ * @brief Macro to define the functions to count and compact the non-zero elements.
+ * The loops have no branch in the element, so that the compiler may vectorize them.
+ * The values and indices are written with memcpy, the output may be unaligned.
+ */
+#define SPARSE_DEFINE_FUNCS(name,ctype) \
+static gsize \
+sparse_count_##name (const guint8 * dense, gsize start, gsize end) \
+{ \
+  const ctype *d = (const ctype *) dense; \
+  gsize i, nnz = 0; \
+  for (i = start; i < end; i++) \
+    nnz += (d[i] != 0); \
+  return nnz; \
+} \
+static void \
+sparse_compact_##name (const guint8 * dense, gsize start, gsize end, \
+    guint8 * values, guint8 * indices) \
+{ \
+  const ctype *d = (const ctype *) dense; \
+  gsize i, j, n, k = 0; \
+  guint idx; \
+  for (i = start; i < end; i += n) { \
+    guint any = 0; \
+    n = MIN (SPARSE_BLOCK_SIZE, end - i); \
+    for (j = 0; j < n; j++) \
+      any |= (d[i + j] != 0); \
+    if (!any) \
+      continue; \
+    for (j = 0; j < n; j++) { \
+      if (d[i + j] != 0) { \
+        idx = (guint) (i + j); \
+        memcpy (values + k * sizeof (ctype), &d[i + j], sizeof (ctype)); \
+        memcpy (indices + k * sizeof (guint), &idx, sizeof (guint)); \
+        k++; \
+      } \
+    } \
+  } \
+} \
+static const sparse_funcs_s sparse_funcs_##name = { \
+  sparse_count_##name, sparse_compact_##name \
+}
+
+/**
+ * @brief Macro to define the function to scatter the values into dense tensor (same element size).
+ */
+#define SPARSE_DEFINE_SCATTER(ctype) \
+static gboolean \
+sparse_scatter_##ctype (guint8 * dense, gsize count, const guint8 * values, \
+    const guint8 * indices, gsize nnz) \
+{ \
+  ctype *d = (ctype *) dense; \
+  gsize i; \
+  guint idx; \
+  for (i = 0; i < nnz; i++) { \
+    memcpy (&idx, indices + i * sizeof (guint), sizeof (guint)); \
+    if (idx >= count) \
+      return FALSE; \
+    memcpy (&d[idx], values + i * sizeof (ctype), sizeof (ctype)); \
+  } \
+  return TRUE; \
+}
+
+/* integers of the same size have the same zero, floating points compare the value (-0.0 is zero) */
+SPARSE_DEFINE_FUNCS (u8, uint8_t);
+SPARSE_DEFINE_FUNCS (u16, uint16_t);
+SPARSE_DEFINE_FUNCS (u32, uint32_t);
+SPARSE_DEFINE_FUNCS (u64, uint64_t);
+SPARSE_DEFINE_FUNCS (f32, float);
+SPARSE_DEFINE_FUNCS (f64, double);
+
+SPARSE_DEFINE_SCATTER (uint8_t)
+SPARSE_DEFINE_SCATTER (uint16_t)
+SPARSE_DEFINE_SCATTER (uint32_t)
+SPARSE_DEFINE_SCATTER (uint64_t)
+
+/**
+ * @brief Get the functions for the data type of sparse tensor.
+ */
+static const sparse_funcs_s *
+sparse_get_funcs (tensor_type type)
+{
+  switch (type) {
+    case _NNS_INT32:
+    case _NNS_UINT32:
+      return &sparse_funcs_u32;
+    case _NNS_INT16:
+    case _NNS_UINT16:
+      return &sparse_funcs_u16;
+    case _NNS_INT8:
+    case _NNS_UINT8:
+      return &sparse_funcs_u8;
+    case _NNS_INT64:
+    case _NNS_UINT64:
+      return &sparse_funcs_u64;
+    case _NNS_FLOAT64:
+      return &sparse_funcs_f64;
+    case _NNS_FLOAT32:
+      return &sparse_funcs_f32;
+    default:
+      break;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Thread function to count the non-zero elements in the range.
+ */
+static gpointer
+sparse_count_range (gpointer data)
+{
+  sparse_range_s *range = (sparse_range_s *) data;
+
+  range->nnz = range->funcs->count (range->dense, range->start, range->end);
+  return NULL;
+}
+
+/**
+ * @brief Thread function to write the non-zero elements in the range.
+ */
+static gpointer
+sparse_compact_range (gpointer data)
+{
+  sparse_range_s *range = (sparse_range_s *) data;
+
+  if (range->nnz > 0)
+    range->funcs->compact (range->dense, range->start, range->end,
+        range->values, range->indices);
+  return NULL;
+}
+
+/**
+ * @brief Run the function for all ranges, the first range in the caller thread.
+ */
+static void
+sparse_run_ranges (sparse_range_s * ranges, guint num, GThreadFunc func)
+{
+  GThread *threads[SPARSE_MAX_THREADS] = { NULL, };
+  guint i;
+
+  for (i = 1; i < num; i++) {
+    threads[i] = g_thread_try_new ("sparse-enc", func, &ranges[i], NULL);
+
+    /* failed to create a thread, run it here */
+    if (!threads[i])
+      func (&ranges[i]);
+  }
+
+  func (&ranges[0]);
+
+  for (i = 1; i < num; i++) {
+    if (threads[i])
+      g_thread_join (threads[i]);
+  }
+}
+
+/**
+ * @brief Write dense tensor into given buffer with sparse tensor data (header, values and indices).
+ * @param[in,out] meta tensor meta structure to be updated
+ * @param[in] sparse sparse tensor data including the header
+ * @param[in] sparse_size size of sparse tensor data
+ * @param[out] dense buffer to write the dense tensor
+ * @param[in] dense_size size of the buffer, should be same to the size of dense tensor
+ * @return TRUE if dense tensor is written
+ */
+gboolean
+gst_tensor_sparse_to_dense_into (GstTensorMetaInfo * meta,
+    const guint8 * sparse, gsize sparse_size, guint8 * dense, gsize dense_size)
+{
+  gboolean scattered;
+  guint nnz;
+  const guint8 *values, *indices;
+  gsize output_size, element_size, header_size;
+
+  g_return_val_if_fail (meta != NULL, FALSE);
+  g_return_val_if_fail (sparse != NULL, FALSE);
+  g_return_val_if_fail (dense != NULL, FALSE);
+
+  if (!gst_tensor_meta_info_parse_header (meta, (gpointer) sparse)) {
+    nns_loge ("Failed to parse meta info from given memory");
+    return FALSE;
+  }
+
+  /* the size of given header, before updating the format */
+  header_size = gst_tensor_meta_info_get_header_size (meta);
+  meta->format = _NNS_TENSOR_FORMAT_STATIC;
+
+  element_size = gst_tensor_get_element_size (meta->type);
+  output_size = gst_tensor_meta_info_get_data_size (meta);
+
+  if (element_size == 0 || output_size == 0 || !sparse_get_funcs (meta->type)) {
+    nns_loge ("Got invalid meta info");
+    return FALSE;
+  }
+
+  if (output_size != dense_size) {
+    nns_loge ("The size of dense tensor %zd is different from the buffer %zd",
+        output_size, dense_size);
+    return FALSE;
+  }
+
+  nnz = meta->sparse_info.nnz;
+
+  if (nnz > output_size / element_size ||
+      header_size + (element_size + sizeof (guint)) * nnz > sparse_size) {
+    nns_loge ("Invalid sparse tensor, nnz %u with the memory size %zd", nnz,
+        sparse_size);
+    return FALSE;
+  }
+
+  memset (dense, 0, output_size);
+  values = sparse + header_size;
+  indices = values + element_size * nnz;
+
+  switch (element_size) {
+    case 1:
+      scattered = sparse_scatter_uint8_t (dense, output_size, values,
+          indices, nnz);
+      break;
+    case 2:
+      scattered = sparse_scatter_uint16_t (dense, output_size / 2, values,
+          indices, nnz);
+      break;
+    case 4:
+      scattered = sparse_scatter_uint32_t (dense, output_size / 4, values,
+          indices, nnz);
+      break;
+    case 8:
+      scattered = sparse_scatter_uint64_t (dense, output_size / 8, values,
+          indices, nnz);
+      break;
+    default:
+      scattered = FALSE;
+      break;
+  }
+
+  if (!scattered) {
+    nns_loge ("Invalid sparse tensor, the index is out of the dense tensor");
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
 /**
  * @brief Make dense tensor with input sparse tensor.
  * @param[in,out] meta tensor meta structure to be updated
@@ -28,10 +312,8 @@ gst_tensor_sparse_to_dense (GstTensorMetaInfo * meta, GstMemory * mem)
 {
   GstMemory *dense = NULL;
   GstMapInfo map;
-  guint i, nnz;
-  guint8 *output, *input;
-  guint *indices;
-  gsize output_size, element_size;
+  guint8 *output;
+  gsize output_size;
 
   if (!gst_memory_map (mem, &map, GST_MAP_READ)) {
     nns_loge ("Failed to map given memory");
@@ -43,59 +325,18 @@ gst_tensor_sparse_to_dense (GstTensorMetaInfo * meta, GstMemory * mem)
     goto done;
   }
 
-  meta->format = _NNS_TENSOR_FORMAT_STATIC;
-
-  element_size = gst_tensor_get_element_size (meta->type);
   output_size = gst_tensor_meta_info_get_data_size (meta);
-
-  if (element_size == 0 || output_size == 0) {
+  if (output_size == 0) {
     nns_loge ("Got invalid meta info");
     goto done;
   }
 
-  output = (guint8 *) g_malloc0 (output_size);
+  output = (guint8 *) g_malloc (output_size);
 
-  nnz = meta->sparse_info.nnz;
-  input = map.data + gst_tensor_meta_info_get_header_size (meta);
-  indices = (guint *) (input + element_size * nnz);
-
-  for (i = 0; i < nnz; ++i) {
-    switch (meta->type) {
-      case _NNS_INT32:
-        ((int32_t *) output)[indices[i]] = ((int32_t *) input)[i];
-        break;
-      case _NNS_UINT32:
-        ((uint32_t *) output)[indices[i]] = ((uint32_t *) input)[i];
-        break;
-      case _NNS_INT16:
-        ((int16_t *) output)[indices[i]] = ((int16_t *) input)[i];
-        break;
-      case _NNS_UINT16:
-        ((uint16_t *) output)[indices[i]] = ((uint16_t *) input)[i];
-        break;
-      case _NNS_INT8:
-        ((int8_t *) output)[indices[i]] = ((int8_t *) input)[i];
-        break;
-      case _NNS_UINT8:
-        ((uint8_t *) output)[indices[i]] = ((uint8_t *) input)[i];
-        break;
-      case _NNS_FLOAT64:
-        ((double *) output)[indices[i]] = ((double *) input)[i];
-        break;
-      case _NNS_FLOAT32:
-        ((float *) output)[indices[i]] = ((float *) input)[i];
-        break;
-      case _NNS_INT64:
-        ((int64_t *) output)[indices[i]] = ((int64_t *) input)[i];
-        break;
-      case _NNS_UINT64:
-        ((uint64_t *) output)[indices[i]] = ((uint64_t *) input)[i];
-        break;
-      default:
-        nns_loge ("Error occured during get tensor value");
-        g_free (output);
-        goto done;
-    }
+  if (!gst_tensor_sparse_to_dense_into (meta, map.data, map.size, output,
+          output_size)) {
+    g_free (output);
+    goto done;
   }
 
   dense = gst_memory_new_wrapped (0, output, output_size, 0, output_size,
@@ -117,12 +358,11 @@ gst_tensor_sparse_from_dense (GstTensorMetaInfo * meta, GstMemory * mem)
 {
   GstMemory *sparse = NULL;
   GstMapInfo map;
-  guint i, nnz = 0;
-  guint8 *output;
-  tensor_type data_type;
-  void *values;
-  guint *indices;
-  gsize output_size, header_size, element_size;
+  const sparse_funcs_s *funcs;
+  sparse_range_s ranges[SPARSE_MAX_THREADS];
+  guint i, num_ranges = 1;
+  guint8 *output, *values, *indices;
+  gsize output_size, header_size, element_size, chunk, nnz = 0;
   gulong element_count;
 
   if (!gst_memory_map (mem, &map, GST_MAP_READ)) {
@@ -130,7 +370,6 @@ gst_tensor_sparse_from_dense (GstTensorMetaInfo * meta, GstMemory * mem)
     return NULL;
   }
 
-  header_size = gst_tensor_meta_info_get_header_size (meta);
   element_size = gst_tensor_get_element_size (meta->type);
   element_count = gst_tensor_get_element_count (meta->dimension);
 
@@ -139,112 +378,64 @@ gst_tensor_sparse_from_dense (GstTensorMetaInfo * meta, GstMemory * mem)
     goto done;
   }
 
-  /** alloc maximum possible size of memory */
-  values = g_malloc0 (element_size * element_count);
-  indices = g_malloc0 (sizeof (guint) * element_count);
-
-  data_type = meta->type;
-
-  /** Consider using macro to reduce loc and readability */
-  for (i = 0; i < element_count; ++i) {
-    switch (data_type) {
-      case _NNS_INT32:
-        if (((int32_t *) map.data)[i] != 0) {
-          ((int32_t *) values)[nnz] = ((int32_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_UINT32:
-        if (((uint32_t *) map.data)[i] != 0) {
-          ((uint32_t *) values)[nnz] = ((uint32_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_INT16:
-        if (((int16_t *) map.data)[i] != 0) {
-          ((int16_t *) values)[nnz] = ((int16_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_UINT16:
-        if (((uint16_t *) map.data)[i] != 0) {
-          ((uint16_t *) values)[nnz] = ((uint16_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_INT8:
-        if (((int8_t *) map.data)[i] != 0) {
-          ((int8_t *) values)[nnz] = ((int8_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_UINT8:
-        if (((uint8_t *) map.data)[i] != 0) {
-          ((uint8_t *) values)[nnz] = ((uint8_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_FLOAT64:
-        if (((double *) map.data)[i] != 0) {
-          ((double *) values)[nnz] = ((double *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_FLOAT32:
-        if (((float *) map.data)[i] != 0) {
-          ((float *) values)[nnz] = ((float *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_INT64:
-        if (((int64_t *) map.data)[i] != 0) {
-          ((int64_t *) values)[nnz] = ((int64_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      case _NNS_UINT64:
-        if (((uint64_t *) map.data)[i] != 0) {
-          ((uint64_t *) values)[nnz] = ((uint64_t *) map.data)[i];
-          indices[nnz] = i;
-          nnz += 1;
-        }
-        break;
-      default:
-        nns_loge ("Error occured during get tensor value");
-        g_free (values);
-        g_free (indices);
-        goto done;
-    }
+  funcs = sparse_get_funcs (meta->type);
+  if (!funcs) {
+    nns_loge ("Error occured during get tensor value");
+    goto done;
+  }
+
+  if (element_count > G_MAXUINT || map.size < element_size * element_count) {
+    nns_loge ("Invalid dense tensor, %lu elements with the memory size %zd",
+        element_count, map.size);
+    goto done;
+  }
+
+  /* split the large tensor, each thread counts and writes its own range */
+  if (element_count >= SPARSE_PARALLEL_MIN_ELEMENTS)
+    num_ranges = CLAMP (g_get_num_processors (), 1U, SPARSE_MAX_THREADS);
+
+  chunk = (element_count + num_ranges - 1) / num_ranges;
+  chunk = (chunk + SPARSE_BLOCK_SIZE - 1) / SPARSE_BLOCK_SIZE * SPARSE_BLOCK_SIZE;
+
+  for (i = 0; i < num_ranges; i++) {
+    ranges[i].funcs = funcs;
+    ranges[i].dense = map.data;
+    ranges[i].start = MIN (chunk * i, element_count);
+    ranges[i].end = MIN (chunk * (i + 1), element_count);
+    ranges[i].nnz = 0;
   }
 
+  /* 1st pass, count the non-zero elements to allocate the exact size */
+  sparse_run_ranges (ranges, num_ranges, sparse_count_range);
+
+  for (i = 0; i < num_ranges; i++)
+    nnz += ranges[i].nnz;
+
   /** update meta nnz info */
   meta->format = _NNS_TENSOR_FORMAT_SPARSE;
-  meta->sparse_info.nnz = nnz;
+  meta->sparse_info.nnz = (guint) nnz;
 
-  /** write to output buffer */
-  output_size = element_size * nnz + sizeof (guint) * nnz;
-
-  /** add meta info header */
-  output_size += header_size;
-  output = g_malloc0 (output_size);
+  /** write to output buffer (header, values and indices) */
+  header_size = gst_tensor_meta_info_get_header_size (meta);
+  output_size = header_size + (element_size + sizeof (guint)) * nnz;
+  output = (guint8 *) g_malloc (output_size);
 
+  memset (output, 0, header_size);
   gst_tensor_meta_info_update_header (meta, output);
 
-  memcpy (output + header_size, values, element_size * nnz);
-  memcpy (output + header_size + (element_size * nnz),
-      indices, sizeof (guint) * nnz);
+  values = output + header_size;
+  indices = values + element_size * nnz;
+
+  /* 2nd pass, compact the non-zero elements into the output */
+  for (i = 0; i < num_ranges; i++) {
+    ranges[i].values = values;
+    ranges[i].indices = indices;
+
+    values += element_size * ranges[i].nnz;
+    indices += sizeof (guint) * ranges[i].nnz;
+  }
 
-  g_free (values);
-  g_free (indices);
+  sparse_run_ranges (ranges, num_ranges, sparse_compact_range);
 
   sparse = gst_memory_new_wrapped (0, output, output_size, 0, output_size,
       output, g_free);
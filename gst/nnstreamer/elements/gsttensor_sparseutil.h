@@ -29,6 +29,19 @@ G_BEGIN_DECLS
 extern GstMemory *
 gst_tensor_sparse_to_dense (GstTensorMetaInfo * meta, GstMemory * mem);
 
+/**
+ * @brief Write dense tensor into given buffer with sparse tensor data (header, values and indices).
+ * @param[in,out] meta tensor meta structure to be updated
+ * @param[in] sparse sparse tensor data including the header
+ * @param[in] sparse_size size of sparse tensor data
+ * @param[out] dense buffer to write the dense tensor
+ * @param[in] dense_size size of the buffer, should be same to the size of dense tensor
+ * @return TRUE if dense tensor is written
+ */
+extern gboolean
+gst_tensor_sparse_to_dense_into (GstTensorMetaInfo * meta,
+    const guint8 * sparse, gsize sparse_size, guint8 * dense, gsize dense_size);
+
 /**
  * @brief Make sparse tensor with input dense tensor.
  * @param[in,out] meta tensor meta structure to be updated
@@ -64,7 +64,8 @@ enum
   PROP_0,
   PROP_SILENT,
   PROP_TENSORPICK,
-  PROP_TENSORSEG
+  PROP_TENSORSEG,
+  PROP_AXIS
 };
 
 /**
@@ -135,6 +136,12 @@ gst_tensor_split_class_init (GstTensorSplitClass * klass)
       g_param_spec_string ("tensorseg", "TensorSeg",
           "How to split tensor ?", "", G_PARAM_READWRITE));
 
+  g_object_class_install_property (gobject_class, PROP_AXIS,
+      g_param_spec_int ("axis", "Axis",
+          "The dimension to split the tensor along (e.g., 0 to split the channels of audio). "
+          "With -1, the segments are the consecutive ranges of the tensor data.",
+          -1, NNS_TENSOR_RANK_LIMIT - 1, -1, G_PARAM_READWRITE));
+
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_tensor_split_change_state);
 
@@ -171,6 +178,7 @@ gst_tensor_split_init (GstTensorSplit * split)
   split->silent = TRUE;
   split->tensorpick = NULL;
   split->tensorseg = NULL;
+  split->axis = -1;
   split->have_group_id = FALSE;
   split->group_id = G_MAXUINT;
   split->srcpads = NULL;
@@ -403,12 +411,111 @@ done:
   return ret;
 }
 
+/**
+ * @brief Check the segments are the consecutive ranges of the tensor data.
+ * @return TRUE if the axis is not given or the dimensions above the axis are 1.
+ */
+static gboolean
+gst_tensor_split_is_consecutive (GstTensorSplit * split)
+{
+  GstTensorInfo *info = &split->sink_tensor_conf.info.info[0];
+  guint j;
+
+  if (split->axis < 0)
+    return TRUE;
+
+  for (j = split->axis + 1; j < NNS_TENSOR_RANK_LIMIT; j++) {
+    if (info->dimension[j] > 1)
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Validate the segments split along the axis.
+ * @return TRUE if the segments have the same dimensions as the incoming tensor except the axis, and the sum of the axis is the incoming one.
+ */
+static gboolean
+gst_tensor_split_check_segments (GstTensorSplit * split)
+{
+  GstTensorInfo *info = &split->sink_tensor_conf.info.info[0];
+  tensor_dim *dim;
+  guint i, j, sum = 0;
+
+  for (i = 0; i < split->tensorseg->len; i++) {
+    dim = g_array_index (split->tensorseg, tensor_dim *, i);
+
+    for (j = 0; j < NNS_TENSOR_RANK_LIMIT; j++) {
+      if ((gint) j == split->axis)
+        sum += (*dim)[j];
+      else if ((*dim)[j] != info->dimension[j])
+        return FALSE;
+    }
+  }
+
+  return (sum == info->dimension[split->axis]);
+}
+
+/**
+ * @brief Gather the blocks of a segment (same size, type) with the stride. The loop without memcpy can be vectorized.
+ */
+#define split_gather_typed(type) do { \
+    type *d_ = (type *) dest; \
+    const type *s_ = (const type *) src; \
+    const gsize st_ = stride / sizeof (type); \
+    for (o = 0; o < outer; o++) \
+      d_[o] = s_[o * st_]; \
+  } while (0)
+
+/**
+ * @brief Gather the blocks of a segment from the tensor split along the inner dimension.
+ * @param dest output (segment)
+ * @param src the first block of the segment in the incoming tensor
+ * @param block size of the block of the segment
+ * @param stride size of the block of the incoming tensor
+ * @param outer number of the blocks
+ */
+static void
+gst_tensor_split_gather (guint8 * dest, const guint8 * src, gsize block,
+    gsize stride, gsize outer)
+{
+  guintptr align = (guintptr) dest | (guintptr) src | (guintptr) stride;
+  gsize o;
+
+  if (block <= 8 && (align % block) == 0) {
+    switch (block) {
+      case 1:
+        split_gather_typed (guint8);
+        return;
+      case 2:
+        split_gather_typed (guint16);
+        return;
+      case 4:
+        split_gather_typed (guint32);
+        return;
+      case 8:
+        split_gather_typed (guint64);
+        return;
+      default:
+        break;
+    }
+  }
+
+  for (o = 0; o < outer; o++) {
+    memcpy (dest, src, block);
+    dest += block;
+    src += stride;
+  }
+}
+
 /**
  * @brief Make Splited Tensor
  * @param split TensorSplit Object
  * @param buffer gstbuffer form src
  * @param nth orther of tensor
  * @return return GstMemory for splited tensor
+ * @details If the segment is a consecutive range in a memory of the incoming buffer, the segment shares the memory without copying the data.
  */
 static GstMemory *
 gst_tensor_split_get_splited (GstTensorSplit * split, GstBuffer * buffer,
@@ -417,32 +524,69 @@ gst_tensor_split_get_splited (GstTensorSplit * split, GstBuffer * buffer,
   GstMemory *mem;
   tensor_dim *dim;
   int i;
-  gsize size, offset;
+  guint j, idx, length;
+  gsize size, offset, skip, element_size;
+  gsize block, stride, outer;
   GstMapInfo src_info, dest_info;
+  gboolean consecutive;
 
-  dim = g_array_index (split->tensorseg, tensor_dim *, nth);
-  size = gst_tensor_get_element_count (*dim) *
+  element_size =
       gst_tensor_get_element_size (split->sink_tensor_conf.info.info[0].type);
+  dim = g_array_index (split->tensorseg, tensor_dim *, nth);
+  size = gst_tensor_get_element_count (*dim) * element_size;
+  consecutive = gst_tensor_split_is_consecutive (split);
+
+  /* the blocks of the axis (consecutive ranges, if the axis is not given) */
+  outer = 1;
+  block = size;
+  stride = size;
+  if (!consecutive) {
+    block = element_size;
+    stride = element_size;
+    for (j = 0; j <= (guint) split->axis; j++) {
+      block *= (*dim)[j];
+      stride *= split->sink_tensor_conf.info.info[0].dimension[j];
+    }
+    outer = size / block;
+  }
+
+  offset = 0;
+  for (i = 0; i < nth; i++) {
+    dim = g_array_index (split->tensorseg, tensor_dim *, i);
+    offset += gst_tensor_get_element_count (*dim) * element_size / outer;
+  }
+
+  if (consecutive && gst_buffer_find_memory (buffer, offset, size, &idx,
+          &length, &skip) && length == 1) {
+    return gst_memory_share (gst_buffer_peek_memory (buffer, idx), skip, size);
+  }
+
+  if (offset + (outer - 1) * stride + block > gst_buffer_get_size (buffer)) {
+    ml_loge ("The segment %d is out of the incoming buffer.", nth);
+    return NULL;
+  }
 
   mem = gst_allocator_alloc (NULL, size, NULL);
+  nns_profile_alloc (split, size);
   if (!gst_memory_map (mem, &dest_info, GST_MAP_WRITE)) {
     ml_logf ("Cannot map memory for destination buffer.\n");
+    gst_memory_unref (mem);
     return NULL;
   }
   if (!gst_buffer_map (buffer, &src_info, GST_MAP_READ)) {
     ml_logf ("Cannot map src-memory to gst buffer at tensor-split.\n");
     gst_memory_unmap (mem, &dest_info);
+    gst_memory_unref (mem);
     return NULL;
   }
 
-  offset = 0;
-  for (i = 0; i < nth; i++) {
-    dim = g_array_index (split->tensorseg, tensor_dim *, i);
-    offset += gst_tensor_get_element_count (*dim) *
-        gst_tensor_get_element_size (split->sink_tensor_conf.info.info[0].type);
-  }
+  if (consecutive)
+    nns_memcpy (dest_info.data, src_info.data + offset, size);
+  else
+    gst_tensor_split_gather (dest_info.data, src_info.data + offset, block,
+        stride, outer);
+  nns_profile_copied (split, size);
 
-  nns_memcpy (dest_info.data, src_info.data + offset, size);
   gst_buffer_unmap (buffer, &src_info);
   gst_memory_unmap (mem, &dest_info);
 
@@ -470,6 +614,14 @@ gst_tensor_split_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
     return GST_FLOW_ERROR;
   }
 
+  if (split->axis >= 0 && !gst_tensor_split_check_segments (split)) {
+    GST_ELEMENT_ERROR (split, STREAM, WRONG_TYPE,
+        ("The segments are not valid to split the tensor along the axis %d.",
+            split->axis), (NULL));
+    gst_buffer_unref (buf);
+    return GST_FLOW_ERROR;
+  }
+
   for (i = 0; i < num_tensors; i++) {
     GstTensorPad *srcpad;
     GstBuffer *outbuf;
@@ -492,8 +644,13 @@ gst_tensor_split_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 
     srcpad = gst_tensor_split_get_tensor_pad (split, buf, &created, i);
 
-    outbuf = gst_buffer_new ();
     mem = gst_tensor_split_get_splited (split, buf, i);
+    if (mem == NULL) {
+      res = GST_FLOW_ERROR;
+      break;
+    }
+
+    outbuf = gst_buffer_new ();
     gst_buffer_append_memory (outbuf, mem);
     ts = GST_BUFFER_TIMESTAMP (buf);
 
@@ -589,6 +746,9 @@ gst_tensor_split_set_property (GObject * object, guint prop_id,
       g_strfreev (strv);
       break;
     }
+    case PROP_AXIS:
+      split->axis = g_value_get_int (value);
+      break;
     case PROP_TENSORSEG:
     {
       guint i;
@@ -639,6 +799,9 @@ gst_tensor_split_get_property (GObject * object, guint prop_id,
     case PROP_SILENT:
       g_value_set_boolean (value, split->silent);
       break;
+    case PROP_AXIS:
+      g_value_set_int (value, split->axis);
+      break;
     case PROP_TENSORPICK:
     {
       GList *list;
@@ -58,6 +58,7 @@ struct _GstTensorSplit
   guint32 num_srcpads;
   GList *tensorpick;
   GArray *tensorseg;
+  gint axis; /**< dimension to split the tensor along (-1 for the consecutive ranges) */
   gboolean have_group_id;
   guint group_id;
   GstTensorsConfig sink_tensor_conf;
@@ -60,6 +60,10 @@
  * Other dimensions are not utilized. The data in the dimension 0 is sorted on
  * the basis of the indexing of the channels provided by the IIO device.
  *
+ * If mmap is enabled and the device supports the block (mmap) interface of the
+ * IIO DMA buffer, the scans are read from the mmap-ed blocks without read ()
+ * and copy. Otherwise, the data is read from the character device.
+ *
  * The enabling of buffer for data capture is performed when transitioning from
  * PAUSED to PLAYING state. This leads to automated synchronization handled by
  * gstreamer. Buffer duration and timestamps set by #gstbasesrc remain in sync
@@ -86,6 +90,14 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <errno.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+
+#if defined (__ARM_NEON)
+#include <arm_neon.h>
+#elif defined (__SSE2__)
+#include <emmintrin.h>
+#endif
 
 #include <nnstreamer_util.h>
 #include "gsttensor_srciio.h"
@@ -151,7 +163,8 @@ enum
   PROP_BUFFER_CAPACITY,
   PROP_FREQUENCY,
   PROP_MERGE_CHANNELS,
-  PROP_POLL_TIMEOUT
+  PROP_POLL_TIMEOUT,
+  PROP_MMAP
 };
 
 /**
@@ -211,6 +224,47 @@ enum
  */
 #define DEFAULT_MERGE_CHANNELS TRUE
 
+/**
+ * @brief Default behavior on using the mmap buffer interface
+ */
+#define DEFAULT_MMAP FALSE
+
+/**
+ * @brief Block (mmap) interface of IIO DMA buffer.
+ * @note This is not in the upstream uapi headers, and the definitions are same
+ *       with the high-speed mmap interface used by libiio.
+ */
+struct iio_buffer_block_alloc_req
+{
+  guint32 type;
+  guint32 size;
+  guint32 count;
+  guint32 id;
+};
+
+/**
+ * @brief Block of IIO DMA buffer.
+ */
+struct iio_buffer_block
+{
+  guint32 id;
+  guint32 size;
+  guint32 bytes_used;
+  guint32 type;
+  guint32 flags;
+  union
+  {
+    guint32 offset;
+  } data;
+  guint64 timestamp;
+};
+
+#define IIO_BLOCK_ALLOC_IOCTL _IOWR('i', 0xa0, struct iio_buffer_block_alloc_req)
+#define IIO_BLOCK_FREE_IOCTL _IO('i', 0xa1)
+#define IIO_BLOCK_QUERY_IOCTL _IOWR('i', 0xa2, struct iio_buffer_block)
+#define IIO_BLOCK_ENQUEUE_IOCTL _IOWR('i', 0xa3, struct iio_buffer_block)
+#define IIO_BLOCK_DEQUEUE_IOCTL _IOWR('i', 0xa4, struct iio_buffer_block)
+
 /**
  * @brief default trigger and device numbers
  */
@@ -380,6 +434,12 @@ gst_tensor_src_iio_class_init (GstTensorSrcIIOClass * klass)
           "Timeout for polling in milliseconds", MIN_POLL_TIMEOUT,
           MAX_POLL_TIMEOUT, DEFAULT_POLL_TIMEOUT, G_PARAM_READWRITE));
 
+  g_object_class_install_property (gobject_class, PROP_MMAP,
+      g_param_spec_boolean ("mmap", "Use mmap buffer",
+          "Read the data from the mmap-ed blocks of the IIO DMA buffer without "
+          "copy, if the device supports the block interface (falls back to read)",
+          DEFAULT_MMAP, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_static_metadata (gstelement_class,
       "TensorSrcIIO",
       "Source/Tensor/Device",
@@ -465,6 +525,8 @@ gst_tensor_src_iio_init (GstTensorSrcIIO * self)
   self->default_buffer_capacity = 0;
   self->default_trigger = NULL;
   self->poll_timeout = DEFAULT_POLL_TIMEOUT;
+  self->use_mmap = DEFAULT_MMAP;
+  self->num_mmap_blocks = 0;
 
   /**
    * format of the source since IIO device as a source is live and operates
@@ -1258,6 +1320,10 @@ gst_tensor_src_iio_set_property (GObject * object, guint prop_id,
       self->poll_timeout = g_value_get_int (value);
       break;
 
+    case PROP_MMAP:
+      self->use_mmap = g_value_get_boolean (value);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1352,6 +1418,10 @@ gst_tensor_src_iio_get_property (GObject * object, guint prop_id,
       g_value_set_int (value, self->poll_timeout);
       break;
 
+    case PROP_MMAP:
+      g_value_set_boolean (value, self->use_mmap);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1911,6 +1981,96 @@ error_return:
   return FALSE;
 }
 
+/**
+ * @brief release the mmap-ed blocks of the IIO DMA buffer.
+ * @param[in/out] self Tensor src IIO object
+ */
+static void
+gst_tensor_src_iio_free_mmap_blocks (GstTensorSrcIIO * self)
+{
+  guint idx;
+
+  for (idx = 0; idx < GST_TENSOR_SRC_IIO_MAX_MMAP_BLOCKS; idx++) {
+    if (self->mmap_blocks[idx] != NULL)
+      munmap (self->mmap_blocks[idx], self->mmap_block_size[idx]);
+    self->mmap_blocks[idx] = NULL;
+    self->mmap_block_size[idx] = 0;
+  }
+
+  if (self->num_mmap_blocks > 0)
+    ioctl (self->buffer_data_fp->fd, IIO_BLOCK_FREE_IOCTL, 0);
+  self->num_mmap_blocks = 0;
+}
+
+/**
+ * @brief allocate and mmap the blocks of the IIO DMA buffer, and queue them.
+ * @param[in/out] self Tensor src IIO object
+ * @return FALSE if the block interface is not available (the data is read
+ *         from the device file), else TRUE
+ */
+static gboolean
+gst_tensor_src_iio_setup_mmap_blocks (GstTensorSrcIIO * self)
+{
+  struct iio_buffer_block_alloc_req req;
+  struct iio_buffer_block block;
+  gint fd = self->buffer_data_fp->fd;
+  gsize bytes_to_read = (gsize) self->scan_size * self->buffer_capacity;
+  guint idx;
+
+  memset (&req, 0, sizeof (req));
+  req.size = (guint32) bytes_to_read;
+  req.count = GST_TENSOR_SRC_IIO_MAX_MMAP_BLOCKS;
+
+  if (ioctl (fd, IIO_BLOCK_ALLOC_IOCTL, &req) < 0) {
+    GST_INFO_OBJECT (self,
+        "The mmap buffer interface is not available (errno %d), use read.",
+        errno);
+    return FALSE;
+  }
+
+  /** the device may allocate less blocks */
+  self->num_mmap_blocks = MIN (req.count, GST_TENSOR_SRC_IIO_MAX_MMAP_BLOCKS);
+  if (self->num_mmap_blocks == 0)
+    goto error;
+
+  for (idx = 0; idx < self->num_mmap_blocks; idx++) {
+    gpointer addr;
+
+    memset (&block, 0, sizeof (block));
+    block.id = idx;
+
+    if (ioctl (fd, IIO_BLOCK_QUERY_IOCTL, &block) < 0)
+      goto error;
+
+    if (block.size < bytes_to_read) {
+      GST_WARNING_OBJECT (self, "The size of block %u is too small (%u/%zu).",
+          idx, block.size, bytes_to_read);
+      goto error;
+    }
+
+    addr = mmap (NULL, block.size, PROT_READ, MAP_SHARED, fd,
+        block.data.offset);
+    if (addr == MAP_FAILED)
+      goto error;
+
+    self->mmap_blocks[idx] = addr;
+    self->mmap_block_size[idx] = block.size;
+
+    if (ioctl (fd, IIO_BLOCK_ENQUEUE_IOCTL, &block) < 0)
+      goto error;
+  }
+
+  GST_INFO_OBJECT (self, "Using %u mmap-ed blocks of the IIO buffer.",
+      self->num_mmap_blocks);
+  return TRUE;
+
+error:
+  GST_WARNING_OBJECT (self,
+      "Failed to set up the mmap buffer (errno %d), use read.", errno);
+  gst_tensor_src_iio_free_mmap_blocks (self);
+  return FALSE;
+}
+
 /**
  * @brief setup device using name/id
  * @param[in/out] self Tensor src iio object
@@ -1970,6 +2130,11 @@ gst_tensor_src_iio_setup_device_buffer (GstTensorSrcIIO * self)
   }
   g_free (filename);
 
+  /** blocks are queued before the buffer is enabled */
+  self->num_mmap_blocks = 0;
+  if (self->use_mmap)
+    gst_tensor_src_iio_setup_mmap_blocks (self);
+
   return TRUE;
 
 error_return:
@@ -2112,6 +2277,7 @@ gst_tensor_src_iio_stop (GstBaseSrc * src)
   /** restore the iio device */
   gst_tensor_src_restore_iio_device (self);
 
+  gst_tensor_src_iio_free_mmap_blocks (self);
   close (self->buffer_data_fp->fd);
   g_free (self->buffer_data_fp);
 
@@ -2357,8 +2523,38 @@ gst_tensor_src_iio_create (GstBaseSrc * src, guint64 offset,
     gst_buffer_append_memory (buf, mem);
   }
 
-  if (gst_tensor_src_iio_fill (src, offset, buffer_size, buf) != GST_FLOW_OK) {
-    goto error_buffer_unref;
+  /**
+   * Over the watermarks of the memory budget, drop the scans (every other scan
+   * over the low watermark) to bound the buffers queued in the pipeline.
+   */
+  while (TRUE) {
+    GstTensorMemPressure pressure;
+
+    if (gst_tensor_src_iio_fill (src, offset, buffer_size,
+            buf) != GST_FLOW_OK) {
+      goto error_buffer_unref;
+    }
+
+    pressure = gst_tensor_alloc_get_pressure ();
+    if (pressure == GST_TENSOR_MEM_PRESSURE_NONE) {
+      self->throttle_skip = FALSE;
+      break;
+    }
+
+    if (pressure == GST_TENSOR_MEM_PRESSURE_THROTTLE && !self->throttle_skip) {
+      self->throttle_skip = TRUE;
+      break;
+    }
+
+    self->throttle_skip = FALSE;
+    self->num_dropped++;
+    GST_DEBUG_OBJECT (self, "Memory budget exceeded, drop the scan (%"
+        G_GUINT64_FORMAT " dropped).", self->num_dropped);
+
+    if (GST_PAD_IS_FLUSHING (GST_BASE_SRC_PAD (src))) {
+      gst_buffer_unref (buf);
+      return GST_FLOW_FLUSHING;
+    }
   }
 
   *buffer = buf;
@@ -2459,6 +2655,132 @@ gst_tensor_src_iio_process_scanned_data (GstTensorSrcIIOChannelProperties *
   return TRUE;
 }
 
+#if defined (__ARM_NEON) || defined (__SSE2__)
+/**
+ * @brief load the raw value of a channel, same with the first step of
+ *        gst_tensor_src_iio_process_scanned_data () for storage upto 4 bytes.
+ */
+static inline guint32
+gst_tensor_src_iio_load_scanned_data (GstTensorSrcIIOChannelProperties * prop,
+    const gchar * data)
+{
+  guint32 value;
+
+  switch (prop->storage_bytes) {
+    case 1:
+      value = *(const guint8 *) (data + prop->location);
+      return value >> (8 - prop->storage_bits);
+    case 2:
+    {
+      guint16 value16 = *(const guint16 *) (data + prop->location);
+
+      if (prop->big_endian)
+        return ((guint32) GUINT16_FROM_BE (value16)) >> (16 - prop->storage_bits);
+      value = GUINT16_FROM_LE (value16);
+      break;
+    }
+    default:
+      value = *(const guint32 *) (data + prop->location);
+
+      if (prop->big_endian)
+        return GUINT32_FROM_BE (value) >> (32 - prop->storage_bits);
+      value = GUINT32_FROM_LE (value);
+      break;
+  }
+
+  return value & (guint32) (G_MAXUINT64 >> (64 - prop->storage_bits));
+}
+#endif
+
+/**
+ * @brief unpack the data of a channel in all scans of the buffer
+ * @param[in] prop Properties of one of the enabled channels
+ * @param[in] data Data read from the IIO device
+ * @param[in] scan_size The size of a scan
+ * @param[in] num_scans The number of scans in the data
+ * @param[out] out Output of the first scan
+ * @param[in] stride The distance between the outputs of the scans
+ * @returns FALSE if fail, else TRUE
+ *
+ * The channel of 4 scans is converted at once with NEON/SSE2 if the storage
+ * is upto 4 bytes, and the others are converted one by one.
+ */
+static gboolean
+gst_tensor_src_iio_unpack_channel (GstTensorSrcIIOChannelProperties * prop,
+    gchar * data, guint scan_size, guint num_scans, gfloat * out, guint stride)
+{
+  guint idx = 0;
+
+#if defined (__ARM_NEON) || defined (__SSE2__)
+  /** the bits of the value processed in gst_tensor_src_iio_process_scanned_data () */
+  guint width = (prop->storage_bytes == 3) ? 32 : prop->storage_bytes * 8;
+
+  if (prop->storage_bytes >= 1 && prop->storage_bytes <= 4 &&
+      prop->used_bits > 0 && prop->used_bits <= width &&
+      (prop->is_signed || prop->used_bits < 32)) {
+    guint32 raw[4] __attribute__ ((aligned (16)));
+    gfloat res[4] __attribute__ ((aligned (16)));
+    guint k, sign_shift = 32 - prop->used_bits;
+    guint32 mask = (guint32) prop->mask;
+#if defined (__ARM_NEON)
+    const int32x4_t shift = vdupq_n_s32 (-(gint32) prop->shift);
+    const int32x4_t lshift = vdupq_n_s32 ((gint32) sign_shift);
+    const int32x4_t rshift = vdupq_n_s32 (-(gint32) sign_shift);
+    const uint32x4_t vmask = vdupq_n_u32 (mask);
+    const float32x4_t offset = vdupq_n_f32 (prop->offset);
+    const float32x4_t scale = vdupq_n_f32 (prop->scale);
+#else
+    const __m128i shift = _mm_cvtsi32_si128 ((gint) prop->shift);
+    const __m128i sshift = _mm_cvtsi32_si128 ((gint) sign_shift);
+    const __m128i vmask = _mm_set1_epi32 ((gint) mask);
+    const __m128 offset = _mm_set1_ps (prop->offset);
+    const __m128 scale = _mm_set1_ps (prop->scale);
+#endif
+
+    for (; idx + 4 <= num_scans; idx += 4) {
+      for (k = 0; k < 4; k++)
+        raw[k] = gst_tensor_src_iio_load_scanned_data (prop,
+            data + (gsize) (idx + k) * scan_size);
+
+#if defined (__ARM_NEON)
+      {
+        uint32x4_t v = vandq_u32 (vshlq_u32 (vld1q_u32 (raw), shift), vmask);
+        int32x4_t iv = vreinterpretq_s32_u32 (v);
+        float32x4_t f;
+
+        if (prop->is_signed)
+          iv = vshlq_s32 (vshlq_s32 (iv, lshift), rshift);
+        f = vmulq_f32 (vaddq_f32 (vcvtq_f32_s32 (iv), offset), scale);
+        vst1q_f32 (res, f);
+      }
+#else
+      {
+        __m128i v = _mm_load_si128 ((const __m128i *) raw);
+        __m128 f;
+
+        v = _mm_and_si128 (_mm_srl_epi32 (v, shift), vmask);
+        if (prop->is_signed)
+          v = _mm_sra_epi32 (_mm_sll_epi32 (v, sshift), sshift);
+        f = _mm_mul_ps (_mm_add_ps (_mm_cvtepi32_ps (v), offset), scale);
+        _mm_store_ps (res, f);
+      }
+#endif
+
+      for (k = 0; k < 4; k++)
+        out[(gsize) (idx + k) * stride] = res[k];
+    }
+  }
+#endif
+
+  for (; idx < num_scans; idx++) {
+    if (!gst_tensor_src_iio_process_scanned_data (prop,
+            data + (gsize) idx * scan_size, out + (gsize) idx * stride))
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
 /**
  * @brief fill the buffer with data
  * @note ignore offset,size as there is pull mode
@@ -2470,9 +2792,11 @@ gst_tensor_src_iio_fill (GstBaseSrc * src, guint64 offset, guint size,
 {
   GstTensorSrcIIO *self;
   gint status, bytes_to_read;
-  guint idx, ch_idx, num_mapped;
-  gchar *raw_data_base, *raw_data;
+  guint idx, ch_idx, num_mapped, stride;
+  gchar *raw_data_base = NULL;
   gfloat *map_data_float;
+  struct iio_buffer_block block;
+  gboolean dequeued = FALSE;
   GstMemory *mem[NNS_TENSOR_SIZE_LIMIT];
   GstMapInfo map[NNS_TENSOR_SIZE_LIMIT];
   guint64 time_to_end, cur_time;
@@ -2499,12 +2823,14 @@ gst_tensor_src_iio_fill (GstBaseSrc * src, guint64 offset, guint size,
     }
     num_mapped = idx + 1;
   }
-  /** memory to data from file */
+  /** memory to data from file, not used with the mmap-ed blocks */
   bytes_to_read = self->scan_size * self->buffer_capacity;
-  raw_data_base = g_malloc (bytes_to_read);
-  if (raw_data_base == NULL) {
-    GST_ERROR_OBJECT (self, "Failed to allocate memory to read raw data.");
-    goto error_data_free;
+  if (self->num_mmap_blocks == 0) {
+    raw_data_base = g_malloc (bytes_to_read);
+    if (raw_data_base == NULL) {
+      GST_ERROR_OBJECT (self, "Failed to allocate memory to read raw data.");
+      goto error_data_free;
+    }
   }
 
   /** wait for the data to arrive */
@@ -2536,8 +2862,30 @@ gst_tensor_src_iio_fill (GstBaseSrc * src, guint64 offset, guint size,
       }
     }
 
-    /** using read for non-blocking access */
-    status = read (self->buffer_data_fp->fd, raw_data_base, bytes_to_read);
+    if (self->num_mmap_blocks > 0) {
+      /** dequeue the filled block, the data is used without copy */
+      memset (&block, 0, sizeof (block));
+      status = ioctl (self->buffer_data_fp->fd, IIO_BLOCK_DEQUEUE_IOCTL, &block);
+      if (status == 0) {
+        if (block.id >= self->num_mmap_blocks) {
+          GST_ERROR_OBJECT (self, "Invalid block %u is dequeued.", block.id);
+          goto error_data_free;
+        }
+
+        dequeued = TRUE;
+        raw_data_base = (gchar *) self->mmap_blocks[block.id];
+        if (block.bytes_used < (guint32) bytes_to_read) {
+          GST_ERROR_OBJECT (self, "Block %u has only %u/%d bytes.", block.id,
+              block.bytes_used, bytes_to_read);
+          goto error_data_free;
+        }
+        break;
+      }
+    } else {
+      /** using read for non-blocking access */
+      status = read (self->buffer_data_fp->fd, raw_data_base, bytes_to_read);
+    }
+
     if (status < bytes_to_read) {
       if (errno == EAGAIN) {
         GST_WARNING_OBJECT (self, "EAGAIN error, try again.");
@@ -2557,37 +2905,35 @@ gst_tensor_src_iio_fill (GstBaseSrc * src, guint64 offset, guint size,
     break;
   }
 
-  /** parse the read data */
-  raw_data = raw_data_base;
-
   /**
+   * parse the read data channel by channel.
    * current assumption is that the all data is float and merged to form
    * a 1 dimension data. 2nd dimension comes from buffer capacity.
    */
-  for (idx = 0; idx < self->buffer_capacity; idx++) {
-    for (channels = self->channels, ch_idx = 0;
-        ch_idx < self->num_channels_enabled;
-        ch_idx++, channels = channels->next) {
-      if (self->tensors_config->info.num_tensors == 1) {
-        /** for other/tensor, only 1 map exist as there is only 1 mem */
-        map_data_float =
-            ((gfloat *) map[0].data) + idx * self->num_channels_enabled +
-            ch_idx;
-      } else {
-        /** for other/tensors, multiple maps exist as there are multiple mem */
-        map_data_float = ((gfloat *) map[ch_idx].data) + idx;
-      }
-      if (!gst_tensor_src_iio_process_scanned_data (channels->data, raw_data,
-              map_data_float)) {
-        GST_ERROR_OBJECT (self, "Error while processing scanned data.");
-        goto error_data_free;
-      }
+  for (channels = self->channels, ch_idx = 0;
+      ch_idx < self->num_channels_enabled;
+      ch_idx++, channels = channels->next) {
+    if (self->tensors_config->info.num_tensors == 1) {
+      /** for other/tensor, only 1 map exist as there is only 1 mem */
+      map_data_float = ((gfloat *) map[0].data) + ch_idx;
+      stride = self->num_channels_enabled;
+    } else {
+      /** for other/tensors, multiple maps exist as there are multiple mem */
+      map_data_float = (gfloat *) map[ch_idx].data;
+      stride = 1;
+    }
+    if (!gst_tensor_src_iio_unpack_channel (channels->data, raw_data_base,
+            self->scan_size, self->buffer_capacity, map_data_float, stride)) {
+      GST_ERROR_OBJECT (self, "Error while processing scanned data.");
+      goto error_data_free;
     }
-    raw_data += self->scan_size;
   }
 
   /** wrap up the buffer */
-  g_free (raw_data_base);
+  if (dequeued)
+    ioctl (self->buffer_data_fp->fd, IIO_BLOCK_ENQUEUE_IOCTL, &block);
+  else
+    g_free (raw_data_base);
   for (idx = 0; idx < self->tensors_config->info.num_tensors; idx++) {
     gst_memory_unmap (mem[idx], &map[idx]);
   }
@@ -2595,7 +2941,10 @@ gst_tensor_src_iio_fill (GstBaseSrc * src, guint64 offset, guint size,
   return GST_FLOW_OK;
 
 error_data_free:
-  g_free (raw_data_base);
+  if (dequeued)
+    ioctl (self->buffer_data_fp->fd, IIO_BLOCK_ENQUEUE_IOCTL, &block);
+  else
+    g_free (raw_data_base);
   for (idx = 0; idx < self->tensors_config->info.num_tensors; idx++) {
     gst_memory_unmap (mem[idx], &map[idx]);
   }
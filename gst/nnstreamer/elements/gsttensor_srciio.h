@@ -34,6 +34,12 @@
 #include <poll.h>
 
 G_BEGIN_DECLS
+
+/**
+ * @brief The max number of blocks of the mmap buffer interface
+ */
+#define GST_TENSOR_SRC_IIO_MAX_MMAP_BLOCKS 4
+
 #define GST_TYPE_TENSOR_SRC_IIO \
   (gst_tensor_src_iio_get_type())
 #define GST_TENSOR_SRC_IIO(obj) \
@@ -131,6 +137,14 @@ struct _GstTensorSrcIIO
   gchar *default_trigger; /**< default set value of sampling frequency */
   gint poll_timeout; /**< timeout for polling the fifo file */
 
+  gboolean use_mmap; /**< true to use the mmap buffer interface if supported */
+  guint num_mmap_blocks; /**< number of mmap-ed blocks (0 if read () is used) */
+  gpointer mmap_blocks[GST_TENSOR_SRC_IIO_MAX_MMAP_BLOCKS]; /**< mmap-ed blocks */
+  gsize mmap_block_size[GST_TENSOR_SRC_IIO_MAX_MMAP_BLOCKS]; /**< size of the blocks */
+
+  gboolean throttle_skip; /**< skip the next scan while the memory budget is over the low watermark */
+  guint64 num_dropped; /**< the number of scans dropped by the memory budget */
+
   /** Only first element is filled when is_tensor is true */
   GstTensorsConfig *tensors_config; /**< tensors for storing data config */
 };
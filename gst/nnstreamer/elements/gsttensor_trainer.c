@@ -66,6 +66,22 @@ G_DEFINE_TYPE (GstTensorTrainer, gst_tensor_trainer, GST_TYPE_ELEMENT);
  */
 #define DEFAULT_STR_PROP_VALUE ""
 
+/**
+ * @brief Default number of the staged batches (double-buffered)
+ */
+#define DEFAULT_PROP_QUEUE_SIZE 2
+
+/**
+ * @brief Default number of the samples in a staged batch
+ */
+#define DEFAULT_PROP_BATCH_SIZE 1
+
+/**
+ * @brief Check the sub-plugin has the callbacks of version 2 (snapshot).
+ */
+#define GST_TENSOR_TRAINER_FW_V2(fw) \
+    (((fw)->version & 0xFFFFFFFFFFFF0000ULL) >= GST_TENSOR_TRAINER_FRAMEWORK_V2)
+
 /**
  * @brief Default string property value 
  */
@@ -81,6 +97,21 @@ enum
   PROP_NUM_LABELS,              /* number of label list */
   PROP_NUM_TRAINING_SAMPLES,    /*number of training data */
   PROP_NUM_VALIDATION_SAMPLES,  /*number of validation data */
+  PROP_QUEUE_SIZE,              /* number of staged batches */
+  PROP_BATCH_SIZE,              /* number of samples in a staged batch */
+  PROP_QUEUE_LEVEL,             /* current number of staged batches */
+  PROP_QUEUE_MAX_LEVEL,         /* highest number of staged batches */
+  PROP_SAMPLES_PER_SEC,         /* number of samples trained per second */
+  PROP_STEP_LATENCY_P50,        /* median step latency */
+  PROP_STEP_LATENCY_P90,        /* 90th percentile step latency */
+  PROP_STEP_LATENCY_P99,        /* 99th percentile step latency */
+  PROP_INPUT_STARVATION_TIME,   /* time the framework waited for the input */
+  PROP_EPOCH_DURATION,          /* duration of the latest epoch */
+  PROP_CHECKPOINT_EPOCHS,       /* take a checkpoint every N epochs */
+  PROP_CHECKPOINT_SAMPLES,      /* take a checkpoint every N samples */
+  PROP_CHECKPOINT_PATH,         /* file path of the checkpoint */
+  PROP_CHECKPOINTS_WRITTEN,     /* number of the checkpoints written */
+  PROP_CHECKPOINTS_SKIPPED,     /* number of the checkpoints skipped */
 };
 
 static void gst_tensor_trainer_set_property (GObject * object, guint prop_id,
@@ -120,6 +151,16 @@ static void gst_tensor_trainer_create_model (GstTensorTrainer * trainer);
 static void gst_tensor_trainer_train_model (GstTensorTrainer * trainer);
 static void gst_tensor_trainer_output_dimension (GstTensorTrainer * trainer);
 static void gst_tensor_trainer_output_type (GstTensorTrainer * trainer);
+static void gst_tensor_trainer_start_feeding (GstTensorTrainer * trainer);
+static void gst_tensor_trainer_stop_feeding (GstTensorTrainer * trainer);
+static void gst_tensor_trainer_reset_metrics (GstTensorTrainer * trainer);
+static void gst_tensor_trainer_get_step_latency (GstTensorTrainer * trainer,
+    gint64 * p50, gint64 * p90, gint64 * p99);
+static gdouble gst_tensor_trainer_get_samples_per_sec (GstTensorTrainer *
+    trainer);
+static void gst_tensor_trainer_post_metrics (GstTensorTrainer * trainer);
+static void gst_tensor_trainer_check_checkpoint (GstTensorTrainer * trainer);
+static void gst_tensor_trainer_join_checkpoint (GstTensorTrainer * trainer);
 
 /**
  * @brief initialize the tensor_trainer's class
@@ -213,6 +254,109 @@ gst_tensor_trainer_class_init (GstTensorTrainerClass * klass)
           G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
           G_PARAM_STATIC_STRINGS));
 
+  g_object_class_install_property (gobject_class, PROP_QUEUE_SIZE,
+      g_param_spec_uint ("queue-size", "Queue size",
+          "The max number of the batches staged to be pushed to the framework "
+          "from the feeding thread, so the training runs while the next "
+          "samples arrive. 0 to push the samples in the streaming thread",
+          0, G_MAXUINT, DEFAULT_PROP_QUEUE_SIZE,
+          G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_BATCH_SIZE,
+      g_param_spec_uint ("batch-size", "Batch size",
+          "The number of the samples assembled into a staged batch",
+          1, G_MAXUINT, DEFAULT_PROP_BATCH_SIZE,
+          G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_QUEUE_LEVEL,
+      g_param_spec_uint ("queue-level", "Queue level",
+          "The current number of the staged batches", 0, G_MAXUINT, 0,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_QUEUE_MAX_LEVEL,
+      g_param_spec_uint ("queue-max-level", "Queue max level",
+          "The highest number of the staged batches since the element started, "
+          "if it stays at queue-size the framework is slower than the input",
+          0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_SAMPLES_PER_SEC,
+      g_param_spec_double ("samples-per-sec", "Samples per second",
+          "The number of the samples trained per second. The element message "
+          "'tensor-trainer-metrics' with the training metrics is posted to the "
+          "bus when an epoch is complete and on EOS",
+          0.0, G_MAXDOUBLE, 0.0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_STEP_LATENCY_P50,
+      g_param_spec_int64 ("step-latency-p50", "Median step latency",
+          "The median (50th percentile) latency of the recent training steps "
+          "in microseconds, -1 if not available. If the subplugin does not "
+          "report the steps, the latency of pushing a sample is measured",
+          -1, G_MAXINT64, -1, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_STEP_LATENCY_P90,
+      g_param_spec_int64 ("step-latency-p90", "90th percentile step latency",
+          "The 90th percentile latency of the recent training steps "
+          "in microseconds, -1 if not available",
+          -1, G_MAXINT64, -1, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_STEP_LATENCY_P99,
+      g_param_spec_int64 ("step-latency-p99", "99th percentile step latency",
+          "The 99th percentile latency of the recent training steps "
+          "in microseconds, -1 if not available",
+          -1, G_MAXINT64, -1, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_INPUT_STARVATION_TIME,
+      g_param_spec_int64 ("input-starvation-time", "Input starvation time",
+          "The accumulated time in microseconds the framework waited for the "
+          "next sample since the first sample was pushed",
+          0, G_MAXINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_EPOCH_DURATION,
+      g_param_spec_int64 ("epoch-duration", "Epoch duration",
+          "The duration of the latest completed epoch in microseconds, "
+          "-1 if no epoch is complete",
+          -1, G_MAXINT64, -1, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_CHECKPOINT_EPOCHS,
+      g_param_spec_uint ("checkpoint-epochs", "Checkpoint epochs",
+          "Take a checkpoint of the model every N epochs while training, "
+          "the checkpoint is written in a background thread. 0 to disable. "
+          "The sub-plugin should support the snapshot of the model",
+          0, G_MAXUINT, 0,
+          G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_CHECKPOINT_SAMPLES,
+      g_param_spec_uint ("checkpoint-samples", "Checkpoint samples",
+          "Take a checkpoint of the model every N samples pushed to the "
+          "framework. 0 to disable",
+          0, G_MAXUINT, 0,
+          G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_CHECKPOINT_PATH,
+      g_param_spec_string ("checkpoint-path", "Checkpoint path",
+          "Path to write the checkpoint, replaced atomically by each "
+          "checkpoint. If empty, model-save-path with the suffix '.ckpt'",
+          DEFAULT_STR_PROP_VALUE,
+          G_PARAM_READWRITE | GST_PARAM_MUTABLE_READY |
+          G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_CHECKPOINTS_WRITTEN,
+      g_param_spec_uint ("checkpoints-written", "Checkpoints written",
+          "The number of the checkpoints written since the element started. "
+          "The element message 'tensor-trainer-checkpoint' is posted to the "
+          "bus when a checkpoint is written",
+          0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (gobject_class, PROP_CHECKPOINTS_SKIPPED,
+      g_param_spec_uint ("checkpoints-skipped", "Checkpoints skipped",
+          "The number of the checkpoints skipped because the previous one "
+          "was still being written",
+          0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_details_simple (gstelement_class, "TensorTrainer",
       "Trainer/Tensor", "Train tensor data using NN Frameworks",
       "Samsung Electronics Co., Ltd.");
@@ -264,11 +408,41 @@ gst_tensor_trainer_init (GstTensorTrainer * trainer)
   trainer->output_configured = FALSE;
   trainer->inputtype_configured = FALSE;
   trainer->total_invoke_num = 0;
+  trainer->total_received_num = 0;
 
   g_cond_init (&trainer->training_complete_cond);
   g_mutex_init (&trainer->trainer_lock);
   trainer->prop.training_complete_cond = &trainer->training_complete_cond;
 
+  trainer->queue_size = DEFAULT_PROP_QUEUE_SIZE;
+  trainer->batch_size = DEFAULT_PROP_BATCH_SIZE;
+  trainer->staging_queue = g_queue_new ();
+  trainer->staging_batch = NULL;
+  trainer->queue_max_level = 0;
+  trainer->feed_thread = NULL;
+  trainer->feed_running = FALSE;
+  trainer->feed_busy = FALSE;
+  trainer->flushing = FALSE;
+  trainer->feed_ret = GST_FLOW_OK;
+  g_mutex_init (&trainer->queue_lock);
+  g_cond_init (&trainer->queue_cond);
+
+  trainer->checkpoint_epochs = 0;
+  trainer->checkpoint_samples = 0;
+  trainer->checkpoint_path = g_strdup (DEFAULT_STR_PROP_VALUE);
+  trainer->checkpoint_thread = NULL;
+  trainer->checkpoint_busy = FALSE;
+  trainer->checkpoint_epoch = 0;
+  trainer->checkpoint_sample = 0;
+  trainer->checkpoint_written = 0;
+  trainer->checkpoint_skipped = 0;
+  g_mutex_init (&trainer->checkpoint_lock);
+  g_cond_init (&trainer->checkpoint_cond);
+
+  g_mutex_init (&trainer->metrics_lock);
+  trainer->prop.metrics_handle = trainer;
+  gst_tensor_trainer_reset_metrics (trainer);
+
   gst_tensor_trainer_output_dimension (trainer);
   gst_tensor_trainer_output_type (trainer);
 }
@@ -291,6 +465,16 @@ gst_tensor_trainer_finalize (GObject * object)
   g_free (trainer->input_type);
   g_free (trainer->output_type);
 
+  gst_tensor_trainer_stop_feeding (trainer);
+  gst_tensor_trainer_join_checkpoint (trainer);
+  g_free (trainer->checkpoint_path);
+  g_mutex_clear (&trainer->checkpoint_lock);
+  g_cond_clear (&trainer->checkpoint_cond);
+  g_queue_free (trainer->staging_queue);
+  g_mutex_clear (&trainer->queue_lock);
+  g_cond_clear (&trainer->queue_cond);
+  g_mutex_clear (&trainer->metrics_lock);
+
   g_cond_clear (&trainer->training_complete_cond);
   g_mutex_clear (&trainer->trainer_lock);
 
@@ -340,6 +524,22 @@ gst_tensor_trainer_set_property (GObject * object, guint prop_id,
     case PROP_NUM_VALIDATION_SAMPLES:
       trainer->prop.num_validation_samples = g_value_get_uint (value);
       break;
+    case PROP_QUEUE_SIZE:
+      trainer->queue_size = g_value_get_uint (value);
+      break;
+    case PROP_BATCH_SIZE:
+      trainer->batch_size = g_value_get_uint (value);
+      break;
+    case PROP_CHECKPOINT_EPOCHS:
+      trainer->checkpoint_epochs = g_value_get_uint (value);
+      break;
+    case PROP_CHECKPOINT_SAMPLES:
+      trainer->checkpoint_samples = g_value_get_uint (value);
+      break;
+    case PROP_CHECKPOINT_PATH:
+      g_free (trainer->checkpoint_path);
+      trainer->checkpoint_path = g_value_dup_string (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -385,6 +585,75 @@ gst_tensor_trainer_get_property (GObject * object, guint prop_id,
     case PROP_NUM_VALIDATION_SAMPLES:
       g_value_set_uint (value, trainer->prop.num_validation_samples);
       break;
+    case PROP_QUEUE_SIZE:
+      g_value_set_uint (value, trainer->queue_size);
+      break;
+    case PROP_BATCH_SIZE:
+      g_value_set_uint (value, trainer->batch_size);
+      break;
+    case PROP_QUEUE_LEVEL:
+      g_mutex_lock (&trainer->queue_lock);
+      g_value_set_uint (value, g_queue_get_length (trainer->staging_queue));
+      g_mutex_unlock (&trainer->queue_lock);
+      break;
+    case PROP_QUEUE_MAX_LEVEL:
+      g_mutex_lock (&trainer->queue_lock);
+      g_value_set_uint (value, trainer->queue_max_level);
+      g_mutex_unlock (&trainer->queue_lock);
+      break;
+    case PROP_SAMPLES_PER_SEC:
+      g_mutex_lock (&trainer->metrics_lock);
+      g_value_set_double (value,
+          gst_tensor_trainer_get_samples_per_sec (trainer));
+      g_mutex_unlock (&trainer->metrics_lock);
+      break;
+    case PROP_STEP_LATENCY_P50:
+    case PROP_STEP_LATENCY_P90:
+    case PROP_STEP_LATENCY_P99:
+    {
+      gint64 p50, p90, p99;
+
+      g_mutex_lock (&trainer->metrics_lock);
+      gst_tensor_trainer_get_step_latency (trainer, &p50, &p90, &p99);
+      g_mutex_unlock (&trainer->metrics_lock);
+
+      if (prop_id == PROP_STEP_LATENCY_P50)
+        g_value_set_int64 (value, p50);
+      else if (prop_id == PROP_STEP_LATENCY_P90)
+        g_value_set_int64 (value, p90);
+      else
+        g_value_set_int64 (value, p99);
+      break;
+    }
+    case PROP_INPUT_STARVATION_TIME:
+      g_mutex_lock (&trainer->metrics_lock);
+      g_value_set_int64 (value, trainer->starvation_time);
+      g_mutex_unlock (&trainer->metrics_lock);
+      break;
+    case PROP_EPOCH_DURATION:
+      g_mutex_lock (&trainer->metrics_lock);
+      g_value_set_int64 (value, trainer->epoch_duration);
+      g_mutex_unlock (&trainer->metrics_lock);
+      break;
+    case PROP_CHECKPOINT_EPOCHS:
+      g_value_set_uint (value, trainer->checkpoint_epochs);
+      break;
+    case PROP_CHECKPOINT_SAMPLES:
+      g_value_set_uint (value, trainer->checkpoint_samples);
+      break;
+    case PROP_CHECKPOINT_PATH:
+      g_value_set_string (value, trainer->checkpoint_path);
+      break;
+    case PROP_CHECKPOINTS_WRITTEN:
+      g_mutex_lock (&trainer->checkpoint_lock);
+      g_value_set_uint (value, trainer->checkpoint_written);
+      g_mutex_unlock (&trainer->checkpoint_lock);
+      break;
+    case PROP_CHECKPOINTS_SKIPPED:
+      g_mutex_lock (&trainer->checkpoint_lock);
+      g_value_set_uint (value, trainer->checkpoint_skipped);
+      g_mutex_unlock (&trainer->checkpoint_lock);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -408,7 +677,9 @@ gst_tensor_trainer_change_state (GstElement * element,
 
     case GST_STATE_CHANGE_READY_TO_PAUSED:
       GST_INFO_OBJECT (trainer, "READY_TO_PAUSED");
+      gst_tensor_trainer_reset_metrics (trainer);
       gst_tensor_trainer_create_model (trainer);
+      gst_tensor_trainer_start_feeding (trainer);
       break;
 
     case GST_STATE_CHANGE_PAUSED_TO_PLAYING:
@@ -416,6 +687,14 @@ gst_tensor_trainer_change_state (GstElement * element,
       gst_tensor_trainer_train_model (trainer);
       break;
 
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      /* unblock the streaming thread waiting for the staging queue */
+      g_mutex_lock (&trainer->queue_lock);
+      trainer->flushing = TRUE;
+      g_cond_broadcast (&trainer->queue_cond);
+      g_mutex_unlock (&trainer->queue_lock);
+      break;
+
     default:
       break;
   }
@@ -429,6 +708,8 @@ gst_tensor_trainer_change_state (GstElement * element,
 
     case GST_STATE_CHANGE_PAUSED_TO_READY:
       GST_INFO_OBJECT (trainer, "PAUSED_TO_READY");
+      gst_tensor_trainer_stop_feeding (trainer);
+      gst_tensor_trainer_join_checkpoint (trainer);
       /* stop model train ? */
       break;
 
@@ -445,192 +726,833 @@ gst_tensor_trainer_change_state (GstElement * element,
 }
 
 /**
- * @brief Chain function, this function does the actual processing.
+ * @brief Reset the training metrics.
  */
-static GstFlowReturn
-gst_tensor_trainer_chain (GstPad * sinkpad, GstObject * parent,
-    GstBuffer * inbuf)
+static void
+gst_tensor_trainer_reset_metrics (GstTensorTrainer * trainer)
+{
+  g_mutex_lock (&trainer->metrics_lock);
+  trainer->metrics_start_time = 0;
+  trainer->metrics_latest_time = 0;
+  trainer->last_push_end_time = 0;
+  trainer->starvation_time = 0;
+  trainer->trained_samples = 0;
+  trainer->step_index = 0;
+  trainer->step_num = 0;
+  trainer->step_reported = FALSE;
+  trainer->epoch_cnt = 0;
+  trainer->epoch_start_time = 0;
+  trainer->epoch_duration = -1;
+  g_mutex_unlock (&trainer->metrics_lock);
+
+  g_mutex_lock (&trainer->checkpoint_lock);
+  trainer->checkpoint_epoch = 0;
+  trainer->checkpoint_sample = trainer->total_invoke_num;
+  trainer->checkpoint_written = 0;
+  trainer->checkpoint_skipped = 0;
+  g_mutex_unlock (&trainer->checkpoint_lock);
+}
+
+/**
+ * @brief Record the latency of a training step.
+ * @note The caller should hold the metrics lock.
+ */
+static void
+gst_tensor_trainer_record_step (GstTensorTrainer * trainer,
+    gint64 num_samples, gint64 step_time, gint64 now)
+{
+  step_time = MAX (step_time, 0);
+
+  trainer->step_times[trainer->step_index] = step_time;
+  trainer->step_index = (trainer->step_index + 1) % GST_TENSOR_TRAINER_MAX_STEPS;
+  if (trainer->step_num < GST_TENSOR_TRAINER_MAX_STEPS)
+    trainer->step_num++;
+
+  trainer->trained_samples += num_samples;
+  if (trainer->metrics_start_time == 0)
+    trainer->metrics_start_time = now - step_time;
+  if (trainer->epoch_start_time == 0)
+    trainer->epoch_start_time = trainer->metrics_start_time;
+  trainer->metrics_latest_time = now;
+}
+
+/**
+ * @brief Compare function to sort the step latencies.
+ */
+static gint
+gst_tensor_trainer_compare_latency (gconstpointer a, gconstpointer b)
+{
+  gint64 va = *((const gint64 *) a);
+  gint64 vb = *((const gint64 *) b);
+
+  return (va > vb) - (va < vb);
+}
+
+/**
+ * @brief Get the percentiles of the recent step latencies (usec), -1 if not available.
+ * @note The caller should hold the metrics lock.
+ */
+static void
+gst_tensor_trainer_get_step_latency (GstTensorTrainer * trainer,
+    gint64 * p50, gint64 * p90, gint64 * p99)
+{
+  gint64 sorted[GST_TENSOR_TRAINER_MAX_STEPS];
+  guint n = trainer->step_num;
+
+  if (n == 0) {
+    *p50 = *p90 = *p99 = -1;
+    return;
+  }
+
+  memcpy (sorted, trainer->step_times, n * sizeof (gint64));
+  qsort (sorted, n, sizeof (gint64), gst_tensor_trainer_compare_latency);
+
+  /* nearest rank */
+  *p50 = sorted[(n * 50 + 99) / 100 - 1];
+  *p90 = sorted[(n * 90 + 99) / 100 - 1];
+  *p99 = sorted[(n * 99 + 99) / 100 - 1];
+}
+
+/**
+ * @brief Get the number of the samples trained per second.
+ * @note The caller should hold the metrics lock.
+ */
+static gdouble
+gst_tensor_trainer_get_samples_per_sec (GstTensorTrainer * trainer)
+{
+  gint64 elapsed = trainer->metrics_latest_time - trainer->metrics_start_time;
+
+  if (trainer->metrics_start_time == 0 || elapsed <= 0)
+    return 0.0;
+
+  return (gdouble) trainer->trained_samples * G_USEC_PER_SEC / elapsed;
+}
+
+/**
+ * @brief Post the element message with the training metrics.
+ */
+static void
+gst_tensor_trainer_post_metrics (GstTensorTrainer * trainer)
+{
+  GstStructure *s;
+  gint64 p50, p90, p99;
+
+  g_mutex_lock (&trainer->metrics_lock);
+  gst_tensor_trainer_get_step_latency (trainer, &p50, &p90, &p99);
+  s = gst_structure_new ("tensor-trainer-metrics",
+      "epoch", G_TYPE_INT64, trainer->epoch_cnt,
+      "epoch-duration", G_TYPE_INT64, trainer->epoch_duration,
+      "samples-per-sec", G_TYPE_DOUBLE,
+      gst_tensor_trainer_get_samples_per_sec (trainer),
+      "step-latency-p50", G_TYPE_INT64, p50,
+      "step-latency-p90", G_TYPE_INT64, p90,
+      "step-latency-p99", G_TYPE_INT64, p99,
+      "input-starvation-time", G_TYPE_INT64, trainer->starvation_time,
+      "trained-samples", G_TYPE_INT64, trainer->trained_samples, NULL);
+  g_mutex_unlock (&trainer->metrics_lock);
+
+  gst_element_post_message (GST_ELEMENT_CAST (trainer),
+      gst_message_new_element (GST_OBJECT_CAST (trainer), s));
+}
+
+/**
+ * @brief Update the epoch duration if the epoch count increases, and post the metrics.
+ */
+static void
+gst_tensor_trainer_update_epoch (GstTensorTrainer * trainer, gint64 epoch_cnt)
+{
+  gboolean updated = FALSE;
+  gint64 now;
+
+  now = g_get_monotonic_time ();
+
+  g_mutex_lock (&trainer->metrics_lock);
+  if (epoch_cnt > trainer->epoch_cnt) {
+    if (trainer->epoch_start_time > 0) {
+      trainer->epoch_duration = (now - trainer->epoch_start_time) /
+          (epoch_cnt - trainer->epoch_cnt);
+    }
+    trainer->epoch_cnt = epoch_cnt;
+    trainer->epoch_start_time = now;
+    updated = TRUE;
+  }
+  g_mutex_unlock (&trainer->metrics_lock);
+
+  if (updated) {
+    GST_INFO_OBJECT (trainer, "Epoch %" G_GINT64_FORMAT " is complete",
+        epoch_cnt);
+    gst_tensor_trainer_post_metrics (trainer);
+
+    if (trainer->checkpoint_epochs > 0)
+      gst_tensor_trainer_check_checkpoint (trainer);
+  }
+}
+
+/**
+ * @brief The checkpoint written in the background thread.
+ */
+typedef struct
 {
   GstTensorTrainer *trainer;
-  GstBuffer *outbuf = NULL;
-  gint ret = -1;
-  guint mem_blocks, i;
-  gsize header_size, expected;
-  gboolean in_flexible, out_flexible;
-  GstMemory *in_mem[NNS_TENSOR_SIZE_LIMIT] = { 0, };
-  GstMapInfo in_info[NNS_TENSOR_SIZE_LIMIT];
-  GstMemory *out_mem[NNS_TENSOR_SIZE_LIMIT] = { 0, };
-  GstMapInfo out_info[NNS_TENSOR_SIZE_LIMIT];
-  GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
-  GstTensorMemory invoke_tensors[NNS_TENSOR_SIZE_LIMIT];
-  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT];
-  GstTensorMetaInfo in_meta[NNS_TENSOR_SIZE_LIMIT];
-  GstTensorMetaInfo out_meta[NNS_TENSOR_SIZE_LIMIT];
+  gchar *path; /**< the file path of the checkpoint */
+  gpointer data; /**< the snapshot of the model given by the sub-plugin */
+  gsize size; /**< the size of the snapshot */
+  gint64 epoch; /**< the number of completed epochs at the snapshot */
+  gint64 samples; /**< the number of pushed samples at the snapshot */
+} GstTensorTrainerCheckpoint;
 
-  trainer = GST_TENSOR_TRAINER (parent);
+/**
+ * @brief Thread to write the checkpoint while the training continues.
+ */
+static gpointer
+gst_tensor_trainer_checkpoint_thread (gpointer data)
+{
+  GstTensorTrainerCheckpoint *ckpt = (GstTensorTrainerCheckpoint *) data;
+  GstTensorTrainer *trainer = ckpt->trainer;
+  GstStructure *s;
+  GError *error = NULL;
+  gboolean written;
+  gint64 start;
+
+  start = g_get_monotonic_time ();
+
+  /* written to a temporary file and renamed, the previous checkpoint is kept on failure */
+  written = g_file_set_contents (ckpt->path, ckpt->data, (gssize) ckpt->size,
+      &error);
+
+  if (written) {
+    GST_INFO_OBJECT (trainer, "Checkpoint of epoch %" G_GINT64_FORMAT
+        " is written to %s (%zu bytes)", ckpt->epoch, ckpt->path, ckpt->size);
+  } else {
+    GST_WARNING_OBJECT (trainer, "Failed to write the checkpoint to %s: %s",
+        ckpt->path, error ? error->message : "unknown error");
+    g_clear_error (&error);
+  }
+
+  s = gst_structure_new ("tensor-trainer-checkpoint",
+      "location", G_TYPE_STRING, ckpt->path,
+      "epoch", G_TYPE_INT64, ckpt->epoch,
+      "samples", G_TYPE_INT64, ckpt->samples,
+      "size", G_TYPE_UINT64, (guint64) ckpt->size,
+      "write-time", G_TYPE_INT64, g_get_monotonic_time () - start,
+      "written", G_TYPE_BOOLEAN, written, NULL);
+  gst_element_post_message (GST_ELEMENT_CAST (trainer),
+      gst_message_new_element (GST_OBJECT_CAST (trainer), s));
+
+  g_free (ckpt->data);
+  g_free (ckpt->path);
+  g_free (ckpt);
+
+  g_mutex_lock (&trainer->checkpoint_lock);
+  if (written)
+    trainer->checkpoint_written++;
+  trainer->checkpoint_busy = FALSE;
+  g_cond_broadcast (&trainer->checkpoint_cond);
+  g_mutex_unlock (&trainer->checkpoint_lock);
+
+  return NULL;
+}
+
+/**
+ * @brief Take the snapshot of the model and write it in the background thread.
+ */
+static void
+gst_tensor_trainer_take_checkpoint (GstTensorTrainer * trainer,
+    gint64 epoch, gint64 samples)
+{
+  GstTensorTrainerCheckpoint *ckpt;
+  GThread *thread;
+  gpointer data = NULL;
+  size_t size = 0;
+  gchar *path;
+
+  if (trainer->checkpoint_path && trainer->checkpoint_path[0] != '\0')
+    path = g_strdup (trainer->checkpoint_path);
+  else if (trainer->model_save_path && trainer->model_save_path[0] != '\0')
+    path = g_strdup_printf ("%s.ckpt", trainer->model_save_path);
+  else
+    return;
+
+  g_mutex_lock (&trainer->checkpoint_lock);
+  if (trainer->checkpoint_busy) {
+    /* do not copy the model again while the previous one is being written */
+    trainer->checkpoint_skipped++;
+    g_mutex_unlock (&trainer->checkpoint_lock);
+    GST_DEBUG_OBJECT (trainer, "Skip the checkpoint of epoch %"
+        G_GINT64_FORMAT ", the previous one is being written", epoch);
+    g_free (path);
+    return;
+  }
+
+  thread = trainer->checkpoint_thread;
+  trainer->checkpoint_thread = NULL;
+  trainer->checkpoint_busy = TRUE;
+  g_mutex_unlock (&trainer->checkpoint_lock);
+
+  /* the previous thread is done */
+  if (thread)
+    g_thread_join (thread);
+
+  if (trainer->fw->snapshot (trainer->fw, &trainer->prop,
+          trainer->privateData, &data, &size) != 0 || !data) {
+    GST_WARNING_OBJECT (trainer, "Failed to take the snapshot of the model");
+    g_free (data);
+    g_free (path);
+
+    g_mutex_lock (&trainer->checkpoint_lock);
+    trainer->checkpoint_busy = FALSE;
+    g_cond_broadcast (&trainer->checkpoint_cond);
+    g_mutex_unlock (&trainer->checkpoint_lock);
+    return;
+  }
+
+  ckpt = g_new0 (GstTensorTrainerCheckpoint, 1);
+  ckpt->trainer = trainer;
+  ckpt->path = path;
+  ckpt->data = data;
+  ckpt->size = size;
+  ckpt->epoch = epoch;
+  ckpt->samples = samples;
+
+  thread = g_thread_try_new ("tensor_trainer-ckpt",
+      gst_tensor_trainer_checkpoint_thread, ckpt, NULL);
+  if (!thread) {
+    GST_WARNING_OBJECT (trainer,
+        "Failed to create the thread, write the checkpoint here");
+    gst_tensor_trainer_checkpoint_thread (ckpt);
+    return;
+  }
+
+  g_mutex_lock (&trainer->checkpoint_lock);
+  trainer->checkpoint_thread = thread;
+  g_mutex_unlock (&trainer->checkpoint_lock);
+}
+
+/**
+ * @brief Take a checkpoint if the given number of epochs or samples has passed since the latest one.
+ */
+static void
+gst_tensor_trainer_check_checkpoint (GstTensorTrainer * trainer)
+{
+  gboolean take = FALSE;
+  gint64 epoch, samples;
+
+  if (!trainer->fw || !GST_TENSOR_TRAINER_FW_V2 (trainer->fw) ||
+      !trainer->fw->snapshot)
+    return;
+
+  g_mutex_lock (&trainer->metrics_lock);
+  epoch = trainer->epoch_cnt;
+  g_mutex_unlock (&trainer->metrics_lock);
+  samples = trainer->total_invoke_num;
+
+  g_mutex_lock (&trainer->checkpoint_lock);
+  if (trainer->checkpoint_epochs > 0 &&
+      epoch - trainer->checkpoint_epoch >= trainer->checkpoint_epochs)
+    take = TRUE;
+  if (trainer->checkpoint_samples > 0 &&
+      samples - trainer->checkpoint_sample >= trainer->checkpoint_samples)
+    take = TRUE;
+
+  if (take) {
+    trainer->checkpoint_epoch = epoch;
+    trainer->checkpoint_sample = samples;
+  }
+  g_mutex_unlock (&trainer->checkpoint_lock);
 
+  if (take)
+    gst_tensor_trainer_take_checkpoint (trainer, epoch, samples);
+}
+
+/**
+ * @brief Wait for the checkpoint being written.
+ */
+static void
+gst_tensor_trainer_join_checkpoint (GstTensorTrainer * trainer)
+{
+  GThread *thread;
+
+  g_mutex_lock (&trainer->checkpoint_lock);
+  while (trainer->checkpoint_busy)
+    g_cond_wait (&trainer->checkpoint_cond, &trainer->checkpoint_lock);
+
+  thread = trainer->checkpoint_thread;
+  trainer->checkpoint_thread = NULL;
+  g_mutex_unlock (&trainer->checkpoint_lock);
+
+  if (thread)
+    g_thread_join (thread);
+}
+
+/**
+ * @brief Sample staged to be pushed to the framework.
+ */
+typedef struct
+{
+  GstBuffer *buffer; /**< the input buffer, mapped until the sample is pushed */
+  guint num_mems;
+  GstMemory *mem[NNS_TENSOR_SIZE_LIMIT];
+  GstMapInfo map[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory tensors[NNS_TENSOR_SIZE_LIMIT];
+} GstTensorTrainerSample;
+
+/**
+ * @brief Free the staged sample.
+ */
+static void
+gst_tensor_trainer_sample_free (gpointer data)
+{
+  GstTensorTrainerSample *sample = (GstTensorTrainerSample *) data;
+  guint i;
+
+  if (!sample)
+    return;
+
+  for (i = 0; i < sample->num_mems; i++)
+    gst_memory_unmap (sample->mem[i], &sample->map[i]);
+
+  gst_buffer_unref (sample->buffer);
+  g_free (sample);
+}
+
+/**
+ * @brief Map the input buffer and check the tensors to be pushed.
+ * @return Newly allocated sample, NULL if the input buffer is invalid.
+ */
+static GstTensorTrainerSample *
+gst_tensor_trainer_sample_new (GstTensorTrainer * trainer, GstPad * sinkpad,
+    GstBuffer * inbuf)
+{
+  GstTensorTrainerSample *sample;
+  GstTensorMetaInfo in_meta;
+  gboolean in_flexible;
+  gsize header_size, expected;
+  guint mem_blocks, i;
+
+  /* Check number of input tensors */
   mem_blocks = gst_buffer_n_memory (inbuf);
+  GST_DEBUG_OBJECT (trainer, "num_tensors: %d",
+      trainer->prop.input_meta.num_tensors);
+  if (mem_blocks != trainer->prop.input_meta.num_tensors) {
+    GST_ERROR_OBJECT (trainer, "Invalid memory blocks(%d),"
+        "number of input tensors may be (%d)", mem_blocks,
+        trainer->prop.input_meta.num_tensors);
+    return NULL;
+  }
+
+  sample = g_new0 (GstTensorTrainerSample, 1);
+  sample->buffer = gst_buffer_ref (inbuf);
+  in_flexible = gst_tensor_pad_caps_is_flexible (sinkpad);
+
   for (i = 0; i < mem_blocks; i++) {
-    in_mem[i] = gst_buffer_peek_memory (inbuf, i);
-    if (!gst_memory_map (in_mem[i], &in_info[i], GST_MAP_READ)) {
+    sample->mem[i] = gst_buffer_peek_memory (inbuf, i);
+    if (!gst_memory_map (sample->mem[i], &sample->map[i], GST_MAP_READ)) {
       GST_ERROR_OBJECT (trainer, "Could not map in_mem[%d] GstMemory", i);
       goto error;
     }
-    in_flexible = gst_tensor_pad_caps_is_flexible (sinkpad);
+    sample->num_mems++;
+
     /* Get header size */
     header_size = 0;
     if (in_flexible) {
-      gst_tensor_meta_info_parse_header (&in_meta[i], &in_info[i].data);
-      header_size = gst_tensor_meta_info_get_header_size (&in_meta[i]);
+      gst_tensor_meta_info_parse_header (&in_meta, sample->map[i].data);
+      header_size = gst_tensor_meta_info_get_header_size (&in_meta);
       GST_INFO ("flexible header size:%zd", header_size);
     } else {
       GST_INFO ("not flexible header size:%zd", header_size);
     }
 
-    in_tensors[i].data = in_info[i].data + header_size;
-    in_tensors[i].size = in_info[i].size - header_size;
-    GST_INFO ("tensor size: %zd", in_tensors[i].size);
-  }
+    if (header_size > sample->map[i].size) {
+      GST_ERROR_OBJECT (trainer, "Invalid header size (%u'th memory chunk)", i);
+      goto error;
+    }
 
-  /* Prepare tensor to invoke */
-  /* Check number of input tensors */
-  GST_DEBUG_OBJECT (trainer, "num_tensors: %d",
-      trainer->prop.input_meta.num_tensors);
-  if (mem_blocks != trainer->prop.input_meta.num_tensors) {
-    GST_ERROR_OBJECT (trainer, "Invalid memory blocks(%d),"
-        "number of input tensors may be (%d)", mem_blocks,
-        trainer->prop.input_meta.num_tensors);
-    goto error;
-  }
+    sample->tensors[i].data = sample->map[i].data + header_size;
+    sample->tensors[i].size = sample->map[i].size - header_size;
+    GST_INFO ("tensor size: %zd", sample->tensors[i].size);
 
-  /* Check size of input tensors */
-  for (i = 0; i < trainer->prop.input_meta.num_tensors; i++) {
+    /* Check size of input tensors */
     expected = gst_tensor_trainer_get_tensor_size (trainer, i, TRUE);
-    if (expected != in_tensors[i].size) {
+    if (expected != sample->tensors[i].size) {
       GST_ERROR_OBJECT (trainer,
           "Invalid tensor size (%u'th memory chunk: %zd)"
-          ", expected size (%zd)", i, in_tensors[i].size, expected);
+          ", expected size (%zd)", i, sample->tensors[i].size, expected);
       goto error;
     }
-    /* Copy to data pointer */
-    invoke_tensors[i] = in_tensors[i];
-    GST_INFO ("in_tensors[%d].size= %zd", i, in_tensors[i].size);
-    GST_INFO ("in_tensors[%d].data: %p", i, in_tensors[i].data);
-    GST_INFO ("invoke_tensors[%d].size= %zd", i, invoke_tensors[i].size);
-    GST_INFO ("invoke_tensors[%d].data: %p", i, invoke_tensors[i].data);
   }
 
-  ret =
-      trainer->fw->push_data (trainer->fw, &trainer->prop, trainer->privateData,
-      invoke_tensors);
+  return sample;
+
+error:
+  gst_tensor_trainer_sample_free (sample);
+  return NULL;
+}
+
+/**
+ * @brief Push the sample to the framework.
+ * @return 0 if OK. Non-zero if error.
+ */
+static gint
+gst_tensor_trainer_push_sample (GstTensorTrainer * trainer,
+    GstTensorTrainerSample * sample)
+{
+  GstTensorTrainerFrameworkInfo info;
+  gint64 start, end;
+  gint ret;
+
+  start = g_get_monotonic_time ();
+  ret = trainer->fw->push_data (trainer->fw, &trainer->prop,
+      trainer->privateData, sample->tensors);
+  end = g_get_monotonic_time ();
   trainer->total_invoke_num++;
 
-  /* Free in info */
-  for (i = 0; i < mem_blocks; i++)
-    gst_memory_unmap (in_mem[i], &in_info[i]);
+  g_mutex_lock (&trainer->metrics_lock);
+  if (trainer->last_push_end_time > 0)
+    trainer->starvation_time += start - trainer->last_push_end_time;
+  trainer->last_push_end_time = end;
 
-  if (ret < 0) {
-    GST_ERROR_OBJECT (trainer, "Invoke error");
-    return GST_FLOW_ERROR;
-  }
+  /* measure the push if the subplugin does not report the steps */
+  if (!trainer->step_reported)
+    gst_tensor_trainer_record_step (trainer, 1, end - start, end);
+  g_mutex_unlock (&trainer->metrics_lock);
 
-  /** Update result if one of epochs is complete,
-      push one outbuf is necessary to change pipeline state.
-      Scheduling with subplugin does not work.
-   */
-  if (trainer->total_invoke_num == 1
-      || trainer->total_invoke_num ==
-      trainer->prop.num_training_samples +
-      trainer->prop.num_validation_samples) {
+  if (ret == 0 && trainer->fw->getFrameworkInfo (trainer->fw, &trainer->prop,
+          trainer->privateData, &info) == 0)
+    gst_tensor_trainer_update_epoch (trainer, info.epoch_cnt);
 
-    /* Prepare output tensor */
-    for (i = 0; i < trainer->output_meta.num_tensors; i++) {
-      out_tensors[i].data = NULL;
-      out_tensors[i].size =
-          gst_tensor_trainer_get_tensor_size (trainer, i, FALSE);
-
-      /* Get header size */
-      header_size = 0;
-      out_flexible = gst_tensor_pad_caps_is_flexible (trainer->srcpad);
-      if (out_flexible) {
-        gst_tensor_info_convert_to_meta (&trainer->output_meta.info[i],
-            &out_meta[i]);
-        header_size = gst_tensor_meta_info_get_header_size (&out_meta[i]);
-        GST_INFO ("flexible header size:%zd", header_size);
-      } else {
-        GST_INFO ("not flexible header size:%zd", header_size);
-      }
+  if (ret == 0 && trainer->checkpoint_samples > 0)
+    gst_tensor_trainer_check_checkpoint (trainer);
 
-      out_mem[i] =
-          gst_allocator_alloc (NULL, out_tensors[i].size + header_size, NULL);
-      if (!out_mem[i]) {
-        GST_ERROR_OBJECT (trainer, "Failed to allocate memory");
-        goto error;
-      }
+  return ret;
+}
 
-      if (!gst_memory_map (out_mem[i], &out_info[i], GST_MAP_WRITE)) {
-        GST_ERROR_OBJECT (trainer, "Could not map in_mem[%d] GstMemory", i);
-        goto error;
-      }
+/**
+ * @brief Thread to push the staged samples to the framework, while the streaming thread prepares the next batch.
+ */
+static gpointer
+gst_tensor_trainer_feed_thread (gpointer data)
+{
+  GstTensorTrainer *trainer = GST_TENSOR_TRAINER (data);
+  GPtrArray *batch;
+  gboolean failed;
+  guint i;
+
+  g_mutex_lock (&trainer->queue_lock);
+  while (trainer->feed_running) {
+    batch = (GPtrArray *) g_queue_pop_head (trainer->staging_queue);
+    if (!batch) {
+      g_cond_wait (&trainer->queue_cond, &trainer->queue_lock);
+      continue;
+    }
 
-      out_tensors[i].data = out_info[i].data + header_size;
+    failed = (trainer->feed_ret != GST_FLOW_OK);
+    trainer->feed_busy = TRUE;
+    g_cond_broadcast (&trainer->queue_cond);
+    g_mutex_unlock (&trainer->queue_lock);
 
-      /* Append header */
-      if (out_flexible) {
-        if (!gst_tensor_meta_info_update_header (&out_meta[i],
-                out_info[i].data)) {
-          GST_ERROR_OBJECT (trainer, "Failed to update header ");
-          goto error;
-        }
+    for (i = 0; i < batch->len && !failed; i++) {
+      if (gst_tensor_trainer_push_sample (trainer,
+              g_ptr_array_index (batch, i)) < 0) {
+        GST_ERROR_OBJECT (trainer, "Invoke error");
+        failed = TRUE;
       }
-#if 0
-      /** @todo Need to updatd out_tensors */
-      /* get loss, accuracy, val_loss, val_accuracy */
-      double data[4] = { 0, 0, 0, 0 };
-      ptr = out_info[i].data;
-      memcpy (ptr, data, sizeof (data));
-#endif
     }
+    g_ptr_array_unref (batch);
 
-    /* Free out info */
-    for (i = 0; i < trainer->output_meta.num_tensors; i++) {
-      if (out_mem[i])
-        gst_memory_unmap (out_mem[i], &out_info[i]);
-    }
+    g_mutex_lock (&trainer->queue_lock);
+    if (failed)
+      trainer->feed_ret = GST_FLOW_ERROR;
+    trainer->feed_busy = FALSE;
+    g_cond_broadcast (&trainer->queue_cond);
+  }
+  g_mutex_unlock (&trainer->queue_lock);
 
-    outbuf = gst_buffer_new ();
-    for (i = 0; i < trainer->output_meta.num_tensors; i++) {
-      /* append the memory block to outbuf */
-      gst_buffer_append_memory (outbuf, out_mem[i]);
+  return NULL;
+}
+
+/**
+ * @brief Move the batch being assembled to the staging queue, waiting while the queue is full.
+ * @note The caller should hold the queue lock.
+ */
+static GstFlowReturn
+gst_tensor_trainer_stage_batch (GstTensorTrainer * trainer)
+{
+  guint level;
+
+  while (!trainer->flushing && trainer->feed_ret == GST_FLOW_OK &&
+      g_queue_get_length (trainer->staging_queue) >= trainer->queue_size)
+    g_cond_wait (&trainer->queue_cond, &trainer->queue_lock);
+
+  if (trainer->flushing)
+    return GST_FLOW_FLUSHING;
+  if (trainer->feed_ret != GST_FLOW_OK)
+    return trainer->feed_ret;
+
+  g_queue_push_tail (trainer->staging_queue, trainer->staging_batch);
+  trainer->staging_batch = NULL;
+
+  level = g_queue_get_length (trainer->staging_queue);
+  if (level > trainer->queue_max_level)
+    trainer->queue_max_level = level;
+  GST_LOG_OBJECT (trainer, "Staged a batch, queue level %u/%u", level,
+      trainer->queue_size);
+
+  g_cond_broadcast (&trainer->queue_cond);
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Add the sample to the batch being assembled, and stage the batch if it is full.
+ */
+static GstFlowReturn
+gst_tensor_trainer_queue_sample (GstTensorTrainer * trainer,
+    GstTensorTrainerSample * sample)
+{
+  GstFlowReturn ret;
+
+  g_mutex_lock (&trainer->queue_lock);
+  if (trainer->flushing) {
+    ret = GST_FLOW_FLUSHING;
+    gst_tensor_trainer_sample_free (sample);
+  } else {
+    if (!trainer->staging_batch) {
+      trainer->staging_batch = g_ptr_array_new_full (trainer->batch_size,
+          gst_tensor_trainer_sample_free);
     }
-    GST_INFO ("out_buffer size : %zd", gst_buffer_get_size (outbuf));
+    g_ptr_array_add (trainer->staging_batch, sample);
 
-    gst_pad_push (trainer->srcpad, outbuf);
+    if (trainer->staging_batch->len >= trainer->batch_size)
+      ret = gst_tensor_trainer_stage_batch (trainer);
+    else
+      ret = trainer->feed_ret;
   }
+  g_mutex_unlock (&trainer->queue_lock);
 
-  gst_buffer_unref (inbuf);
+  return ret;
+}
 
-  return GST_FLOW_OK;
+/**
+ * @brief Drop the staged samples.
+ * @note The caller should hold the queue lock.
+ */
+static void
+gst_tensor_trainer_clear_queue (GstTensorTrainer * trainer)
+{
+  GPtrArray *batch;
 
-error:
-  mem_blocks = gst_buffer_n_memory (inbuf);
-  for (i = 0; i < mem_blocks; i++) {
-    if (in_mem[i])
-      gst_memory_unmap (in_mem[i], &in_info[i]);
+  while ((batch = (GPtrArray *) g_queue_pop_head (trainer->staging_queue)))
+    g_ptr_array_unref (batch);
+
+  if (trainer->staging_batch) {
+    g_ptr_array_unref (trainer->staging_batch);
+    trainer->staging_batch = NULL;
+  }
+
+  g_cond_broadcast (&trainer->queue_cond);
+}
+
+/**
+ * @brief Stage the remaining samples and wait until all staged samples are pushed to the framework.
+ */
+static void
+gst_tensor_trainer_drain_queue (GstTensorTrainer * trainer)
+{
+  g_mutex_lock (&trainer->queue_lock);
+  if (trainer->feed_thread) {
+    if (trainer->staging_batch && trainer->staging_batch->len > 0)
+      gst_tensor_trainer_stage_batch (trainer);
+
+    while (!trainer->flushing && trainer->feed_ret == GST_FLOW_OK &&
+        (!g_queue_is_empty (trainer->staging_queue) || trainer->feed_busy))
+      g_cond_wait (&trainer->queue_cond, &trainer->queue_lock);
+
+    GST_INFO_OBJECT (trainer, "Staging queue drained, max level %u/%u",
+        trainer->queue_max_level, trainer->queue_size);
+  }
+  g_mutex_unlock (&trainer->queue_lock);
+}
+
+/**
+ * @brief Start the thread to push the staged samples to the framework.
+ */
+static void
+gst_tensor_trainer_start_feeding (GstTensorTrainer * trainer)
+{
+  g_mutex_lock (&trainer->queue_lock);
+  trainer->flushing = FALSE;
+  trainer->feed_ret = GST_FLOW_OK;
+  trainer->queue_max_level = 0;
+
+  if (trainer->queue_size > 0 && trainer->fw_created && !trainer->feed_thread) {
+    trainer->feed_running = TRUE;
+    trainer->feed_thread = g_thread_new ("tensor_trainer_feed",
+        gst_tensor_trainer_feed_thread, trainer);
   }
+  g_mutex_unlock (&trainer->queue_lock);
+}
+
+/**
+ * @brief Stop the feeding thread and drop the staged samples.
+ */
+static void
+gst_tensor_trainer_stop_feeding (GstTensorTrainer * trainer)
+{
+  GThread *thread;
+
+  g_mutex_lock (&trainer->queue_lock);
+  thread = trainer->feed_thread;
+  trainer->feed_thread = NULL;
+  trainer->feed_running = FALSE;
+  trainer->flushing = TRUE;
+  g_cond_broadcast (&trainer->queue_cond);
+  g_mutex_unlock (&trainer->queue_lock);
+
+  if (thread)
+    g_thread_join (thread);
+
+  g_mutex_lock (&trainer->queue_lock);
+  gst_tensor_trainer_clear_queue (trainer);
+  g_mutex_unlock (&trainer->queue_lock);
+}
 
+/**
+ * @brief Push the result of the training to the src pad.
+ */
+static GstFlowReturn
+gst_tensor_trainer_push_result (GstTensorTrainer * trainer)
+{
+  GstBuffer *outbuf = NULL;
+  guint i;
+  gsize header_size;
+  gboolean out_flexible;
+  GstMemory *out_mem[NNS_TENSOR_SIZE_LIMIT] = { 0, };
+  GstMapInfo out_info[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMetaInfo out_meta[NNS_TENSOR_SIZE_LIMIT];
+
+  /* Prepare output tensor */
   for (i = 0; i < trainer->output_meta.num_tensors; i++) {
-    if (out_mem[i]) {
-      gst_memory_unmap (out_mem[i], &out_info[i]);
+    out_tensors[i].data = NULL;
+    out_tensors[i].size =
+        gst_tensor_trainer_get_tensor_size (trainer, i, FALSE);
+
+    /* Get header size */
+    header_size = 0;
+    out_flexible = gst_tensor_pad_caps_is_flexible (trainer->srcpad);
+    if (out_flexible) {
+      gst_tensor_info_convert_to_meta (&trainer->output_meta.info[i],
+          &out_meta[i]);
+      header_size = gst_tensor_meta_info_get_header_size (&out_meta[i]);
+      GST_INFO ("flexible header size:%zd", header_size);
+    } else {
+      GST_INFO ("not flexible header size:%zd", header_size);
+    }
+
+    out_mem[i] =
+        gst_allocator_alloc (NULL, out_tensors[i].size + header_size, NULL);
+    if (!out_mem[i]) {
+      GST_ERROR_OBJECT (trainer, "Failed to allocate memory");
+      goto error;
+    }
+
+    if (!gst_memory_map (out_mem[i], &out_info[i], GST_MAP_WRITE)) {
+      GST_ERROR_OBJECT (trainer, "Could not map in_mem[%d] GstMemory", i);
       gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
+      out_mem[i] = NULL;
+      goto error;
+    }
+
+    out_tensors[i].data = out_info[i].data + header_size;
+
+    /* Append header */
+    if (out_flexible) {
+      if (!gst_tensor_meta_info_update_header (&out_meta[i],
+              out_info[i].data)) {
+        GST_ERROR_OBJECT (trainer, "Failed to update header ");
+        gst_memory_unmap (out_mem[i], &out_info[i]);
+        gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
+        out_mem[i] = NULL;
+        goto error;
+      }
     }
+#if 0
+    /** @todo Need to updatd out_tensors */
+    /* get loss, accuracy, val_loss, val_accuracy */
+    double data[4] = { 0, 0, 0, 0 };
+    ptr = out_info[i].data;
+    memcpy (ptr, data, sizeof (data));
+#endif
+    gst_memory_unmap (out_mem[i], &out_info[i]);
   }
 
-  gst_buffer_unref (inbuf);
+  outbuf = gst_buffer_new ();
+  for (i = 0; i < trainer->output_meta.num_tensors; i++) {
+    /* append the memory block to outbuf */
+    gst_buffer_append_memory (outbuf, out_mem[i]);
+  }
+  GST_INFO ("out_buffer size : %zd", gst_buffer_get_size (outbuf));
+
+  gst_pad_push (trainer->srcpad, outbuf);
+  return GST_FLOW_OK;
+
+error:
+  for (i = 0; i < trainer->output_meta.num_tensors; i++) {
+    if (out_mem[i])
+      gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
+  }
 
   return GST_FLOW_ERROR;
 }
 
+/**
+ * @brief Chain function, this function does the actual processing.
+ */
+static GstFlowReturn
+gst_tensor_trainer_chain (GstPad * sinkpad, GstObject * parent,
+    GstBuffer * inbuf)
+{
+  GstTensorTrainer *trainer;
+  GstTensorTrainerSample *sample;
+  GstFlowReturn ret = GST_FLOW_OK;
+
+  trainer = GST_TENSOR_TRAINER (parent);
+
+  sample = gst_tensor_trainer_sample_new (trainer, sinkpad, inbuf);
+  gst_buffer_unref (inbuf);
+
+  if (!sample)
+    return GST_FLOW_ERROR;
+
+  if (trainer->feed_thread) {
+    /* The feeding thread pushes the sample while the next one arrives. */
+    ret = gst_tensor_trainer_queue_sample (trainer, sample);
+  } else {
+    if (gst_tensor_trainer_push_sample (trainer, sample) < 0) {
+      GST_ERROR_OBJECT (trainer, "Invoke error");
+      ret = GST_FLOW_ERROR;
+    }
+    gst_tensor_trainer_sample_free (sample);
+  }
+
+  if (ret != GST_FLOW_OK)
+    return ret;
+
+  trainer->total_received_num++;
+
+  /** Update result if one of epochs is complete,
+      push one outbuf is necessary to change pipeline state.
+      Scheduling with subplugin does not work.
+   */
+  if (trainer->total_received_num == 1
+      || trainer->total_received_num ==
+      trainer->prop.num_training_samples +
+      trainer->prop.num_validation_samples) {
+    ret = gst_tensor_trainer_push_result (trainer);
+  }
+
+  return ret;
+}
+
 /**
  * @brief Get pad caps for caps negotiation.
  */
@@ -711,6 +1633,7 @@ gst_tensor_trainer_sink_event (GstPad * sinkpad, GstObject * parent,
 
   switch (GST_EVENT_TYPE (event)) {
     case GST_EVENT_EOS:
+      gst_tensor_trainer_drain_queue (trainer);
       trainer->fw->getFrameworkInfo (trainer->fw, NULL, trainer->privateData,
           &info);
       if (!info.is_training_complete) {
@@ -722,12 +1645,22 @@ gst_tensor_trainer_sink_event (GstPad * sinkpad, GstObject * parent,
         g_cond_wait (&trainer->training_complete_cond, &trainer->trainer_lock);
         g_mutex_unlock (&trainer->trainer_lock);
       }
+      gst_tensor_trainer_post_metrics (trainer);
       break;
     case GST_EVENT_FLUSH_START:
       GST_INFO_OBJECT (trainer, "get GST_EVENT_FLUSH_START event");
+      g_mutex_lock (&trainer->queue_lock);
+      trainer->flushing = TRUE;
+      gst_tensor_trainer_clear_queue (trainer);
+      g_mutex_unlock (&trainer->queue_lock);
       break;
     case GST_EVENT_FLUSH_STOP:
       GST_INFO_OBJECT (trainer, "get GST_EVENT_FLUSH_STOP event");
+      g_mutex_lock (&trainer->queue_lock);
+      gst_tensor_trainer_clear_queue (trainer);
+      trainer->flushing = FALSE;
+      trainer->feed_ret = GST_FLOW_OK;
+      g_mutex_unlock (&trainer->queue_lock);
       break;
     case GST_EVENT_CAPS:
     {
@@ -1182,3 +2115,52 @@ nnstreamer_trainer_exit (GstTensorTrainerFramework * ttsp)
 
   return unregister_subplugin (NNS_SUBPLUGIN_TRAINER, name);
 }
+
+/**
+ * @brief Trainer's sub-plugin may call this when a training step is done, tensor_trainer collects the step latency and throughput.
+ * @param[in] prop the properties given by tensor_trainer.
+ * @param[in] num_samples The number of samples trained in the step (batch size).
+ * @param[in] step_time The elapsed time of the step in microseconds.
+ */
+void
+nnstreamer_trainer_notify_step (const GstTensorTrainerProperties * prop,
+    int64_t num_samples, int64_t step_time)
+{
+  GstTensorTrainer *trainer;
+
+  g_return_if_fail (prop != NULL);
+  trainer = (GstTensorTrainer *) prop->metrics_handle;
+  g_return_if_fail (GST_IS_TENSOR_TRAINER (trainer));
+
+  g_mutex_lock (&trainer->metrics_lock);
+  if (!trainer->step_reported) {
+    /* drop the latencies of pushing the samples */
+    trainer->step_reported = TRUE;
+    trainer->step_index = 0;
+    trainer->step_num = 0;
+    trainer->trained_samples = 0;
+    trainer->metrics_start_time = 0;
+  }
+
+  gst_tensor_trainer_record_step (trainer, num_samples, step_time,
+      g_get_monotonic_time ());
+  g_mutex_unlock (&trainer->metrics_lock);
+}
+
+/**
+ * @brief Trainer's sub-plugin may call this when an epoch is complete, tensor_trainer posts the metrics of the epoch.
+ * @param[in] prop the properties given by tensor_trainer.
+ * @param[in] epoch_cnt The number of currently completed epochs.
+ */
+void
+nnstreamer_trainer_notify_epoch (const GstTensorTrainerProperties * prop,
+    int64_t epoch_cnt)
+{
+  GstTensorTrainer *trainer;
+
+  g_return_if_fail (prop != NULL);
+  trainer = (GstTensorTrainer *) prop->metrics_handle;
+  g_return_if_fail (GST_IS_TENSOR_TRAINER (trainer));
+
+  gst_tensor_trainer_update_epoch (trainer, epoch_cnt);
+}
@@ -34,6 +34,11 @@ G_BEGIN_DECLS
 #define GST_IS_TENSOR_TRAINER_CLASS(klass) \
   (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_TENSOR_TRAINER))
 
+/**
+ * @brief The number of recent step latencies for the percentiles.
+ */
+#define GST_TENSOR_TRAINER_MAX_STEPS (256)
+
 typedef struct _GstTensorTrainer GstTensorTrainer;
 typedef struct _GstTensorTrainerClass GstTensorTrainerClass;
 
@@ -64,6 +69,7 @@ struct _GstTensorTrainer
   GstTensorsConfig out_config;
 
   gint64 total_invoke_num;      /**< number of total invokes */
+  gint64 total_received_num;    /**< number of total received samples */
   gboolean fw_created;
 
   void *privateData; /**< NNFW plugin's private data is stored here */
@@ -72,6 +78,48 @@ struct _GstTensorTrainer
 
   GMutex trainer_lock;
   GCond training_complete_cond;
+
+  /* staging queue to feed the samples from the feeding thread */
+  guint queue_size; /**< max number of the staged batches, 0 to push the samples in the chain function */
+  guint batch_size; /**< number of the samples in a staged batch */
+  GQueue *staging_queue; /**< queue of the staged batches */
+  GPtrArray *staging_batch; /**< the batch being assembled */
+  guint queue_max_level; /**< the highest number of the staged batches */
+  GMutex queue_lock;
+  GCond queue_cond;
+  GThread *feed_thread;
+  gboolean feed_running; /**< TRUE while the feeding thread runs */
+  gboolean feed_busy; /**< TRUE while the feeding thread pushes a batch */
+  gboolean flushing;
+  GstFlowReturn feed_ret; /**< result of the feeding thread */
+
+  /* training metrics */
+  GMutex metrics_lock;
+  gint64 metrics_start_time; /**< the time of the first sample pushed (usec) */
+  gint64 metrics_latest_time; /**< the time of the latest step or push (usec) */
+  gint64 last_push_end_time; /**< the time the latest push to the framework returned (usec) */
+  gint64 starvation_time; /**< accumulated time the framework waited for the next sample (usec) */
+  gint64 trained_samples; /**< number of the samples trained (or pushed if the steps are not reported) */
+  gint64 step_times[GST_TENSOR_TRAINER_MAX_STEPS]; /**< ring buffer of recent step latencies (usec) */
+  guint step_index; /**< index of the next latency in the ring buffer */
+  guint step_num; /**< the number of latencies in the ring buffer */
+  gboolean step_reported; /**< TRUE if the subplugin reports the training steps */
+  gint64 epoch_cnt; /**< number of completed epochs */
+  gint64 epoch_start_time; /**< the time the current epoch started (usec) */
+  gint64 epoch_duration; /**< duration of the latest completed epoch (usec), -1 if not available */
+
+  /* checkpoint written in the background while training */
+  guint checkpoint_epochs; /**< take a checkpoint every N epochs, 0 if disabled */
+  guint checkpoint_samples; /**< take a checkpoint every N pushed samples, 0 if disabled */
+  gchar *checkpoint_path; /**< the file path of the checkpoint, model-save-path with the suffix .ckpt if empty */
+  GMutex checkpoint_lock;
+  GCond checkpoint_cond;
+  GThread *checkpoint_thread; /**< thread writing the latest checkpoint */
+  gboolean checkpoint_busy; /**< TRUE while the checkpoint is being written */
+  gint64 checkpoint_epoch; /**< the epoch of the latest checkpoint */
+  gint64 checkpoint_sample; /**< the number of pushed samples at the latest checkpoint */
+  guint checkpoint_written; /**< the number of the checkpoints written */
+  guint checkpoint_skipped; /**< the number of the checkpoints skipped because the previous one was being written */
 };
 
 /**
@@ -51,12 +51,21 @@
 #include <math.h>
 #include <nnstreamer_log.h>
 #include <nnstreamer_util.h>
+#include <tensor_kernels.h>
 #include "gsttensor_transform.h"
 
 #ifdef HAVE_ORC
 #include "nnstreamer-orc.h"
 #endif
 
+#if defined (__ARM_NEON)
+#include <arm_neon.h>
+#define TRANSFORM_NEON_ENABLED
+#elif defined (__SSE2__)
+#include <emmintrin.h>
+#define TRANSFORM_SSE2_ENABLED
+#endif
+
 /**
  * @brief Macro for debug mode.
  */
@@ -78,6 +87,13 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_transform_debug);
     "(((add|mul|div)(:([-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?))+(@[0-9]+)?)(,|))+$"
 
 #define REGEX_ARITH_OPTION_TYPECAST "(typecast:([u]?int(8|16|32|64)|float(16|32|64)))"
+#define REGEX_QUANT_OPTION "^(([u]?int(8|16|32)|float(16|32|64)),)?(per-channel:[0-7],)?"\
+    "scale(:[+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?)+(,zero-point(:[-+]?[0-9]+)+)?$"
+
+/**
+ * @brief The number of the elements (de)quantized at once with the scale and zero point of each element.
+ */
+#define QUANT_BLOCK_SIZE (256)
 
 /**
  * @brief The transpose rank is fixed to 4.
@@ -96,7 +112,8 @@ enum
   PROP_OPTION,
   PROP_ACCELERATION,
   PROP_APPLY,
-  PROP_TRANSPOSE_RANK_LIMIT
+  PROP_TRANSPOSE_RANK_LIMIT,
+  PROP_THREADS
 };
 
 /**
@@ -108,6 +125,27 @@ enum
 #define DEFAULT_ACCELERATION FALSE
 #endif
 
+/**
+ * @brief Default number of threads (single-threaded).
+ */
+#define DEFAULT_THREADS (1)
+
+/**
+ * @brief The max number of threads to transform a tensor.
+ */
+#define TRANSFORM_MAX_THREADS (64)
+
+/**
+ * @brief The min size (bytes) of the output to split the work across the threads.
+ * The smaller tensors are transformed in the streaming thread to avoid the dispatch overhead.
+ */
+#define TRANSFORM_PARALLEL_MIN_BYTES (256 * 1024)
+
+/**
+ * @brief The min size (bytes) of the output transformed by a thread.
+ */
+#define TRANSFORM_PARALLEL_GRAIN_BYTES (128 * 1024)
+
 static const gchar *gst_tensor_transform_stand_string[] = {
   [STAND_DEFAULT] = "default",
   [STAND_DC_AVERAGE] = "dc-average",
@@ -152,6 +190,8 @@ static void gst_tensor_transform_finalize (GObject * object);
 /* GstBaseTransformer vmethod implementations */
 static GstFlowReturn gst_tensor_transform_transform (GstBaseTransform * trans,
     GstBuffer * inbuf, GstBuffer * outbuf);
+static GstFlowReturn gst_tensor_transform_transform_ip (GstBaseTransform *
+    trans, GstBuffer * buf);
 static GstCaps *gst_tensor_transform_transform_caps (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, GstCaps * filter);
 static GstCaps *gst_tensor_transform_fixate_caps (GstBaseTransform * trans,
@@ -196,6 +236,12 @@ gst_tensor_transform_mode_get_type (void)
       {GTT_CLAMP, "Mode for clamping all elements of tensor into the range, "
             "option=CLAMP_MIN:CLAMP_MAX",
           "clamp"},
+      {GTT_QUANTIZE, "Mode for quantizing tensor with the scale and zero point, "
+            "option=[(int8|uint8),][per-channel:DIM,]scale:S[:S...][,zero-point:Z[:Z...]]",
+          "quantize"},
+      {GTT_DEQUANTIZE, "Mode for dequantizing tensor with the scale and zero point, "
+            "option=[float(16|32|64),][per-channel:DIM,]scale:S[:S...][,zero-point:Z[:Z...]]",
+          "dequantize"},
       {GTT_UNKNOWN, "Unknown or not-implemented-yet mode",
           "unknown"},
       {0, NULL, NULL},
@@ -250,6 +296,13 @@ gst_tensor_transform_class_init (GstTensorTransformClass * klass)
           "The rank limit of transpose, which varies per version of nnstreamer and may be lower than the global rank limit if it is over 4.",
           0, NNS_TENSOR_RANK_LIMIT, NNS_TENSOR_TRANSPOSE_RANK_LIMIT,
           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_THREADS,
+      g_param_spec_uint ("threads", "Threads",
+          "The number of threads to transform a large tensor, "
+          "the tensor is split across the shared worker threads (0 to use all CPU cores). "
+          "Small tensors are always transformed in a single thread.",
+          0, TRANSFORM_MAX_THREADS, DEFAULT_THREADS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_set_details_simple (gstelement_class,
       "TensorTransform",
@@ -266,6 +319,8 @@ gst_tensor_transform_class_init (GstTensorTransformClass * klass)
 
   /* Processing units */
   trans_class->transform = GST_DEBUG_FUNCPTR (gst_tensor_transform_transform);
+  trans_class->transform_ip =
+      GST_DEBUG_FUNCPTR (gst_tensor_transform_transform_ip);
 
   /* Negotiation units */
   trans_class->transform_caps =
@@ -294,6 +349,7 @@ gst_tensor_transform_init (GstTensorTransform * filter)
   filter->loaded = FALSE;
   filter->operators = NULL;
   filter->acceleration = DEFAULT_ACCELERATION;
+  filter->threads = DEFAULT_THREADS;
   filter->apply = NULL;
 
   gst_tensors_config_init (&filter->in_config);
@@ -555,8 +611,26 @@ refrain_from_heavy_op_on_float16 (gulong n)
       default: GST_ERROR_OBJECT (filter, "Unknown operator %d", op); break; \
     } \
   } while (0)
+
+#define orc_clamp(i,o,n,lo,hi,type) do { \
+    switch (type) { \
+      case _NNS_INT32: nns_orc_clamp_s32 ((gpointer) o, (gpointer) i, (int) (lo), (int) (hi), n); break; \
+      case _NNS_UINT32: nns_orc_clamp_u32 ((gpointer) o, (gpointer) i, (int) (lo), (int) (hi), n); break; \
+      case _NNS_INT16: nns_orc_clamp_s16 ((gpointer) o, (gpointer) i, (int) (lo), (int) (hi), n); break; \
+      case _NNS_UINT16: nns_orc_clamp_u16 ((gpointer) o, (gpointer) i, (int) (lo), (int) (hi), n); break; \
+      case _NNS_INT8: nns_orc_clamp_s8 ((gpointer) o, (gpointer) i, (int) (lo), (int) (hi), n); break; \
+      case _NNS_UINT8: nns_orc_clamp_u8 ((gpointer) o, (gpointer) i, (int) (lo), (int) (hi), n); break; \
+      default: GST_ERROR_OBJECT (filter, "Unsupported type %d", type); g_assert (0); break; \
+    } \
+  } while (0)
 #endif /* HAVE_ORC */
 
+/**
+ * @brief Macro to trace the path (kernel) chosen for the transform.
+ */
+#define trace_path(f,mode,path) \
+    GST_TRACE_OBJECT (f, "%s: %s", mode, path)
+
 /**
  * @brief Macro for operator
  */
@@ -948,6 +1022,105 @@ gst_tensor_transform_set_option_data (GstTensorTransform * filter)
       ret = filter->loaded = TRUE;
       break;
     }
+    case GTT_QUANTIZE:
+    case GTT_DEQUANTIZE:
+    {
+      const gchar *mode_name =
+          (filter->mode == GTT_QUANTIZE) ? "quantize" : "dequantize";
+      tensor_transform_quant *quant = &filter->data_quant;
+      gchar **options, **strv;
+      guint i, k, num, num_zero_points = 0;
+      gboolean valid = TRUE;
+
+      g_free (filter->quant_params);
+      filter->quant_params = NULL;
+
+      if (!g_regex_match_simple (REGEX_QUANT_OPTION, filter->option,
+              G_REGEX_CASELESS, 0)) {
+        ml_loge
+            ("%s: %s: \'%s\' is not a valid option string: it should be in the form of [TYPE,][per-channel:DIM,]scale:S[:S...][,zero-point:Z[:Z...]]\n",
+            filter_name, mode_name, filter->option);
+        break;
+      }
+
+      quant->type = (filter->mode == GTT_QUANTIZE) ? _NNS_INT8 : _NNS_FLOAT32;
+      quant->per_channel = FALSE;
+      quant->ch_dim = 0;
+      quant->num_params = 0;
+
+      /* the order is fixed by the regex, the scales are given before the zero points */
+      options = g_strsplit (filter->option, ",", -1);
+      for (i = 0; options[i] != NULL; i++) {
+        strv = g_strsplit (options[i], ":", -1);
+        num = g_strv_length (strv) - 1;
+
+        if (g_ascii_strcasecmp (strv[0], "per-channel") == 0) {
+          quant->per_channel = TRUE;
+          quant->ch_dim = (guint) g_ascii_strtoull (strv[1], NULL, 10);
+        } else if (g_ascii_strcasecmp (strv[0], "scale") == 0) {
+          quant->num_params = num;
+          filter->quant_params = g_new0 (gfloat, 2 * num);
+          for (k = 0; k < num; k++) {
+            filter->quant_params[k] = (gfloat) g_ascii_strtod (strv[k + 1],
+                NULL);
+            if (!isfinite (filter->quant_params[k]) ||
+                filter->quant_params[k] <= 0.0f)
+              valid = FALSE;
+          }
+        } else if (g_ascii_strcasecmp (strv[0], "zero-point") == 0) {
+          num_zero_points = num;
+          for (k = 0; k < quant->num_params; k++) {
+            if (num != 1 && num != quant->num_params)
+              break;
+            filter->quant_params[quant->num_params + k] =
+                (gfloat) g_ascii_strtoll (strv[(num == 1) ? 1 : k + 1], NULL,
+                10);
+          }
+        } else {
+          quant->type = gst_tensor_get_type (strv[0]);
+        }
+
+        g_strfreev (strv);
+      }
+      g_strfreev (options);
+
+      if (filter->mode == GTT_QUANTIZE) {
+        if (quant->type != _NNS_INT8 && quant->type != _NNS_UINT8) {
+          ml_loge ("%s: %s: the quantized type should be int8 or uint8\n",
+              filter_name, mode_name);
+          valid = FALSE;
+        }
+      } else if (quant->type != _NNS_FLOAT32 && quant->type != _NNS_FLOAT64 &&
+          quant->type != _NNS_FLOAT16) {
+        ml_loge ("%s: %s: the output type should be float16, float32 or float64\n",
+            filter_name, mode_name);
+        valid = FALSE;
+      }
+
+      if (quant->num_params > 1 && !quant->per_channel) {
+        ml_loge ("%s: %s: multiple scales require per-channel:DIM\n",
+            filter_name, mode_name);
+        valid = FALSE;
+      }
+
+      if (num_zero_points > 1 && num_zero_points != quant->num_params) {
+        ml_loge
+            ("%s: %s: the number of the zero points (%u) should be 1 or the number of the scales (%u)\n",
+            filter_name, mode_name, num_zero_points, quant->num_params);
+        valid = FALSE;
+      }
+
+      if (!valid) {
+        ml_loge ("%s: %s: \'%s\' has invalid scale or zero point\n",
+            filter_name, mode_name, filter->option);
+        g_free (filter->quant_params);
+        filter->quant_params = NULL;
+        break;
+      }
+
+      ret = filter->loaded = TRUE;
+      break;
+    }
     default:
       GST_ERROR_OBJECT (filter, "Cannot identify mode\n");
       ret = FALSE;
@@ -957,6 +1130,163 @@ gst_tensor_transform_set_option_data (GstTensorTransform * filter)
   return ret;
 }
 
+/**
+ * @brief Function to transform the range [start, end) of the work units.
+ */
+typedef void (*transform_range_func) (GstTensorTransform * filter,
+    gpointer data, gsize start, gsize end);
+
+/**
+ * @brief Data structure to wait for the ranges pushed to the worker threads.
+ */
+typedef struct
+{
+  GMutex lock; /**< lock for pending */
+  GCond cond; /**< signalled when all ranges are done */
+  guint pending; /**< the number of ranges not finished */
+} transform_parallel_job;
+
+/**
+ * @brief Data structure for a range transformed in the worker thread.
+ */
+typedef struct
+{
+  transform_parallel_job *job; /**< the job this range belongs to */
+  GstTensorTransform *filter; /**< "this" pointer */
+  transform_range_func func; /**< function to transform the range */
+  gpointer data; /**< data for func */
+  gsize start; /**< the first unit of the range */
+  gsize end; /**< the end (exclusive) of the range */
+} transform_parallel_range;
+
+/**
+ * @brief Worker threads shared by all tensor_transform instances using the threads.
+ */
+static GThreadPool *transform_pool = NULL;
+static guint transform_pool_refcount = 0;
+G_LOCK_DEFINE_STATIC (transform_pool);
+
+/**
+ * @brief Transform a range in the worker thread.
+ */
+static void
+gst_tensor_transform_pool_run (gpointer data, gpointer user_data)
+{
+  transform_parallel_range *range = (transform_parallel_range *) data;
+  transform_parallel_job *job = range->job;
+
+  UNUSED (user_data);
+  range->func (range->filter, range->data, range->start, range->end);
+
+  g_mutex_lock (&job->lock);
+  if (--job->pending == 0)
+    g_cond_signal (&job->cond);
+  g_mutex_unlock (&job->lock);
+}
+
+/**
+ * @brief Get the shared worker threads (create the pool if it is not created yet).
+ */
+static void
+gst_tensor_transform_pool_ref (GstTensorTransform * filter)
+{
+  GError *error = NULL;
+
+  G_LOCK (transform_pool);
+  if (transform_pool_refcount++ == 0) {
+    transform_pool = g_thread_pool_new (gst_tensor_transform_pool_run, NULL,
+        MIN (g_get_num_processors (), TRANSFORM_MAX_THREADS), FALSE, &error);
+    if (!transform_pool) {
+      GST_WARNING_OBJECT (filter,
+          "Failed to create the worker threads, transform in a single thread: %s",
+          error ? error->message : "unknown reason");
+      g_clear_error (&error);
+    }
+  }
+  G_UNLOCK (transform_pool);
+}
+
+/**
+ * @brief Release the shared worker threads.
+ */
+static void
+gst_tensor_transform_pool_unref (void)
+{
+  GThreadPool *pool = NULL;
+
+  G_LOCK (transform_pool);
+  if (transform_pool_refcount > 0 && --transform_pool_refcount == 0) {
+    pool = transform_pool;
+    transform_pool = NULL;
+  }
+  G_UNLOCK (transform_pool);
+
+  if (pool)
+    g_thread_pool_free (pool, FALSE, TRUE);
+}
+
+/**
+ * @brief Split the work units across the worker threads and wait for all ranges.
+ * @param[in] filter "this" pointer
+ * @param[in] units the number of work units (e.g., elements or outer slices)
+ * @param[in] unit_size the size (bytes) of the output of a unit
+ * @param[in] func function to transform a range of the units
+ * @param[in] data data for func
+ *
+ * The caller thread transforms the first range. If the threads are disabled
+ * or the output is small, func is called once with the whole range.
+ */
+static void
+gst_tensor_transform_parallel (GstTensorTransform * filter, gsize units,
+    gsize unit_size, transform_range_func func, gpointer data)
+{
+  transform_parallel_range ranges[TRANSFORM_MAX_THREADS];
+  transform_parallel_job job;
+  GThreadPool *pool;
+  gsize total = units * unit_size;
+  guint i, n;
+
+  n = (filter->threads == 0) ? g_get_num_processors () : filter->threads;
+  n = MIN (n, TRANSFORM_MAX_THREADS);
+  n = MIN (n, MAX (1, total / TRANSFORM_PARALLEL_GRAIN_BYTES));
+  n = MIN (n, units);
+
+  G_LOCK (transform_pool);
+  pool = transform_pool;
+  G_UNLOCK (transform_pool);
+
+  if (n <= 1 || pool == NULL || total < TRANSFORM_PARALLEL_MIN_BYTES) {
+    func (filter, data, 0, units);
+    return;
+  }
+
+  g_mutex_init (&job.lock);
+  g_cond_init (&job.cond);
+  job.pending = n - 1;
+
+  for (i = 0; i < n; i++) {
+    ranges[i].job = &job;
+    ranges[i].filter = filter;
+    ranges[i].func = func;
+    ranges[i].data = data;
+    ranges[i].start = units * i / n;
+    ranges[i].end = units * (i + 1) / n;
+
+    if (i > 0)
+      g_thread_pool_push (pool, &ranges[i], NULL);
+  }
+
+  func (filter, data, ranges[0].start, ranges[0].end);
+
+  g_mutex_lock (&job.lock);
+  while (job.pending > 0)
+    g_cond_wait (&job.cond, &job.lock);
+  g_mutex_unlock (&job.lock);
+
+  g_mutex_clear (&job.lock);
+  g_cond_clear (&job.cond);
+}
+
 /**
  * @brief Set property (gst element vmethod)
  */
@@ -1018,6 +1348,20 @@ gst_tensor_transform_set_property (GObject * object, guint prop_id,
       g_strfreev (strv);
       break;
     }
+    case PROP_THREADS:
+    {
+      guint threads = g_value_get_uint (value);
+
+      /* the worker threads are used unless single-threaded */
+      if (filter->threads == 1 && threads != 1)
+        gst_tensor_transform_pool_ref (filter);
+      else if (filter->threads != 1 && threads == 1)
+        gst_tensor_transform_pool_unref ();
+
+      filter->threads = threads;
+      silent_debug (filter, "threads = %u\n", filter->threads);
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1074,6 +1418,9 @@ gst_tensor_transform_get_property (GObject * object, guint prop_id,
     case PROP_TRANSPOSE_RANK_LIMIT:
       g_value_set_uint (value, NNS_TENSOR_TRANSPOSE_RANK_LIMIT);
       break;
+    case PROP_THREADS:
+      g_value_set_uint (value, filter->threads);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1100,340 +1447,1775 @@ gst_tensor_transform_finalize (GObject * object)
     filter->operators = NULL;
   }
 
+  g_free (filter->quant_params);
+  filter->quant_params = NULL;
+
   if (filter->apply) {
     g_list_free (filter->apply);
     filter->apply = NULL;
   }
 
+  if (filter->threads != 1)
+    gst_tensor_transform_pool_unref ();
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
 /**
- * @brief subrouting for tensor-tranform, "dimchg" case.
- * @param[in/out] filter "this" pointer
- * @param[in] in_info input tensor info
- * @param[in] out_info output tensor info
- * @param[in] inptr input tensor
- * @param[out] outptr output tensor
- * @return Gst flow status
+ * @brief The block size (in elements) of the cache-blocked transpose.
  */
-static GstFlowReturn
-gst_tensor_transform_dimchg (GstTensorTransform * filter,
-    GstTensorInfo * in_info, GstTensorInfo * out_info,
-    const uint8_t * inptr, uint8_t * outptr)
-{
-  uint32_t *fromDim = in_info->dimension;
-  uint32_t *toDim = out_info->dimension;
-  unsigned int from = filter->data_dimchg.from;
-  unsigned int to = filter->data_dimchg.to;
-  unsigned int i, j, k;
-  unsigned int loopLimit = 1;
-  gsize loopBlockSize, copyblocksize, copyblocklimit;
-
-  if (from == to) {
-    /** Useless memcpy. Do not call this or @todo do "IP" operation */
-    nns_memcpy (outptr, inptr, gst_tensor_info_get_size (in_info));
-    GST_WARNING_OBJECT (filter,
-        "Calling tensor_transform with high memcpy overhead WITHOUT any effects! Check your stream whether you really need tensor_transform.\n");
-    return GST_FLOW_OK;
-  }
+#define TRANSPOSE_BLOCK (32)
 
-  g_assert (from < NNS_TENSOR_RANK_LIMIT);
-  g_assert (to < NNS_TENSOR_RANK_LIMIT);
-  g_assert (fromDim[from] == toDim[to]);
+/**
+ * @brief The min number of elements to run the blocked transpose.
+ * The smaller tensors use the element-by-element loops.
+ */
+#define TRANSPOSE_BLOCKED_MIN_ELEMENTS (256)
 
-  loopBlockSize = copyblocksize = gst_tensor_get_element_size (in_info->type);
-  copyblocklimit = 1;
+/**
+ * @brief The max number of channels to (de)interleave in a single pass.
+ */
+#define TRANSPOSE_MAX_CHANNELS (4)
 
-  if (from < to) {
-    /**
-     * Smaller-loop-ed a to larger-loop-ed b
-     * E.g., [N][H][W][c] (c:W:H:N) --> [N][c][H][W] (W:H:c:N)
-     *
-     * @todo CRITICAL-TODO: Optimize the performance!
-     */
-    for (i = NNS_TENSOR_RANK_LIMIT - 1; i > to; i--)
-      loopLimit *= toDim[i];
-    for (i = 0; i < to; i++)
-      loopBlockSize *= toDim[i];
+/**
+ * @brief Macro to copy an element with the fixed size (compiled into a load and a store).
+ */
+#define transpose_copy_elem(d,s,size) memcpy ((d), (s), (size))
 
-    for (i = 0; i < from; i++)
-      copyblocksize *= fromDim[i];
-    for (i = 0; i < to; i++)
-      copyblocklimit *= toDim[i];
+/**
+ * @brief Macro to run the blocked transpose loop with the fixed element size.
+ */
+#define transpose_2d_loop(size) do { \
+    for (r0 = 0; r0 < rows; r0 += TRANSPOSE_BLOCK) { \
+      r1 = MIN (r0 + TRANSPOSE_BLOCK, rows); \
+      for (c0 = 0; c0 < cols; c0 += TRANSPOSE_BLOCK) { \
+        c1 = MIN (c0 + TRANSPOSE_BLOCK, cols); \
+        for (c = c0; c < c1; c++) { \
+          const uint8_t *_s = src + r0 * src_stride + c * (size); \
+          uint8_t *_d = dst + c * dst_stride + r0 * (size); \
+          for (r = r0; r < r1; r++, _s += src_stride, _d += (size)) \
+            transpose_copy_elem (_d, _s, (size)); \
+        } \
+      } \
+    } \
+  } while (0)
 
-    for (i = 0; i < loopLimit; i++) {
-      /* [i1][i2][...][iN][b][...] i = i1 x i2 x ... x iN */
-      uint8_t *destptr = outptr + loopBlockSize * toDim[to] * i;
-      const uint8_t *srcptr = inptr + loopBlockSize * toDim[to] * i;
+#if defined (TRANSFORM_NEON_ENABLED) || defined (TRANSFORM_SSE2_ENABLED)
+/**
+ * @brief Transpose 4x4 32-bit elements.
+ */
+static inline void
+transpose_4x4_32bit (const uint8_t * src, gsize src_stride, uint8_t * dst,
+    gsize dst_stride)
+{
+#if defined (TRANSFORM_NEON_ENABLED)
+  uint32x4_t r0 = vld1q_u32 ((const uint32_t *) src);
+  uint32x4_t r1 = vld1q_u32 ((const uint32_t *) (src + src_stride));
+  uint32x4_t r2 = vld1q_u32 ((const uint32_t *) (src + src_stride * 2));
+  uint32x4_t r3 = vld1q_u32 ((const uint32_t *) (src + src_stride * 3));
+  uint32x4x2_t t0 = vtrnq_u32 (r0, r1);
+  uint32x4x2_t t1 = vtrnq_u32 (r2, r3);
+
+  vst1q_u32 ((uint32_t *) dst,
+      vcombine_u32 (vget_low_u32 (t0.val[0]), vget_low_u32 (t1.val[0])));
+  vst1q_u32 ((uint32_t *) (dst + dst_stride),
+      vcombine_u32 (vget_low_u32 (t0.val[1]), vget_low_u32 (t1.val[1])));
+  vst1q_u32 ((uint32_t *) (dst + dst_stride * 2),
+      vcombine_u32 (vget_high_u32 (t0.val[0]), vget_high_u32 (t1.val[0])));
+  vst1q_u32 ((uint32_t *) (dst + dst_stride * 3),
+      vcombine_u32 (vget_high_u32 (t0.val[1]), vget_high_u32 (t1.val[1])));
+#else
+  __m128i r0 = _mm_loadu_si128 ((const __m128i *) src);
+  __m128i r1 = _mm_loadu_si128 ((const __m128i *) (src + src_stride));
+  __m128i r2 = _mm_loadu_si128 ((const __m128i *) (src + src_stride * 2));
+  __m128i r3 = _mm_loadu_si128 ((const __m128i *) (src + src_stride * 3));
+  __m128i t0 = _mm_unpacklo_epi32 (r0, r1);
+  __m128i t1 = _mm_unpacklo_epi32 (r2, r3);
+  __m128i t2 = _mm_unpackhi_epi32 (r0, r1);
+  __m128i t3 = _mm_unpackhi_epi32 (r2, r3);
+
+  _mm_storeu_si128 ((__m128i *) dst, _mm_unpacklo_epi64 (t0, t1));
+  _mm_storeu_si128 ((__m128i *) (dst + dst_stride),
+      _mm_unpackhi_epi64 (t0, t1));
+  _mm_storeu_si128 ((__m128i *) (dst + dst_stride * 2),
+      _mm_unpacklo_epi64 (t2, t3));
+  _mm_storeu_si128 ((__m128i *) (dst + dst_stride * 3),
+      _mm_unpackhi_epi64 (t2, t3));
+#endif
+}
 
-      for (j = 0; j < toDim[to]; j++) {
-        uint8_t *j_destptr = destptr + loopBlockSize * j;
-        for (k = 0; k < copyblocklimit; k++) {
-          nns_memcpy (j_destptr + copyblocksize * k,
-              srcptr + k * copyblocksize * toDim[to] + j * copyblocksize,
-              copyblocksize);
+/**
+ * @brief Transpose 32-bit elements, using 4x4 SIMD blocks in each cache block.
+ */
+static void
+transpose_2d_32bit (const uint8_t * src, uint8_t * dst, gsize rows,
+    gsize cols, gsize src_stride, gsize dst_stride)
+{
+  gsize r, c, r0, r1, c0, c1;
+
+  for (r0 = 0; r0 < rows; r0 += TRANSPOSE_BLOCK) {
+    r1 = MIN (r0 + TRANSPOSE_BLOCK, rows);
+    for (c0 = 0; c0 < cols; c0 += TRANSPOSE_BLOCK) {
+      c1 = MIN (c0 + TRANSPOSE_BLOCK, cols);
+
+      for (r = r0; r + 4 <= r1; r += 4) {
+        for (c = c0; c + 4 <= c1; c += 4)
+          transpose_4x4_32bit (src + r * src_stride + c * 4, src_stride,
+              dst + c * dst_stride + r * 4, dst_stride);
+        for (; c < c1; c++) {
+          transpose_copy_elem (dst + c * dst_stride + r * 4,
+              src + r * src_stride + c * 4, 4);
+          transpose_copy_elem (dst + c * dst_stride + (r + 1) * 4,
+              src + (r + 1) * src_stride + c * 4, 4);
+          transpose_copy_elem (dst + c * dst_stride + (r + 2) * 4,
+              src + (r + 2) * src_stride + c * 4, 4);
+          transpose_copy_elem (dst + c * dst_stride + (r + 3) * 4,
+              src + (r + 3) * src_stride + c * 4, 4);
         }
       }
+      for (; r < r1; r++) {
+        for (c = c0; c < c1; c++)
+          transpose_copy_elem (dst + c * dst_stride + r * 4,
+              src + r * src_stride + c * 4, 4);
+      }
     }
-  } else {
-    /**
-     * Larger-loop-ed a to smaller-loop-ed b
-     * E.g., [N][c][H][W] (W:H:c:N) --> [N][H][W][c] (c:W:H:N)
-     * @todo NYI
-     */
-    ml_loge
-        ("tensor-transform/dimchg operation is not permitted if from >= to.\n");
-    return GST_FLOW_ERROR;
   }
-
-  return GST_FLOW_OK;
 }
+#endif
 
 /**
- * @brief subrouting for tensor-tranform, "typecast" case.
- * @param[in/out] filter "this" pointer
- * @param[in] in_info input tensor info
- * @param[in] out_info output tensor info
- * @param[in] inptr input tensor
- * @param[out] outptr output tensor
- * @return Gst flow status
+ * @brief Split the interleaved channels into the planes.
+ *        (src: pixels x channels, packed) -> (dst: channels x pixels)
  */
-static GstFlowReturn
-gst_tensor_transform_typecast (GstTensorTransform * filter,
-    GstTensorInfo * in_info, GstTensorInfo * out_info,
-    const uint8_t * inptr, uint8_t * outptr)
+static void
+transpose_deinterleave (const uint8_t * src, uint8_t * dst, gsize pixels,
+    gsize channels, gsize dst_stride, gsize esize)
 {
-  gulong i, num;
-  gsize in_element_size, out_element_size;
-
-  num = gst_tensor_get_element_count (in_info->dimension);
-
-#ifdef HAVE_ORC
-  if (orc_supported (filter, in_info->type, out_info->type)) {
-    orc_typecast (inptr, outptr, num, in_info->type, out_info->type);
-    return GST_FLOW_OK;
+  uint8_t *planes[TRANSPOSE_MAX_CHANNELS];
+  gsize p = 0, c;
+
+  for (c = 0; c < channels; c++)
+    planes[c] = dst + c * dst_stride;
+
+#if defined (TRANSFORM_NEON_ENABLED)
+  if (esize == 1 && channels == 3) {
+    for (; p + 16 <= pixels; p += 16) {
+      uint8x16x3_t v = vld3q_u8 (src + p * 3);
+      vst1q_u8 (planes[0] + p, v.val[0]);
+      vst1q_u8 (planes[1] + p, v.val[1]);
+      vst1q_u8 (planes[2] + p, v.val[2]);
+    }
+  } else if (esize == 1 && channels == 4) {
+    for (; p + 16 <= pixels; p += 16) {
+      uint8x16x4_t v = vld4q_u8 (src + p * 4);
+      vst1q_u8 (planes[0] + p, v.val[0]);
+      vst1q_u8 (planes[1] + p, v.val[1]);
+      vst1q_u8 (planes[2] + p, v.val[2]);
+      vst1q_u8 (planes[3] + p, v.val[3]);
+    }
+  } else if (esize == 4 && channels == 3) {
+    for (; p + 4 <= pixels; p += 4) {
+      uint32x4x3_t v = vld3q_u32 ((const uint32_t *) (src + p * 12));
+      vst1q_u32 ((uint32_t *) (planes[0] + p * 4), v.val[0]);
+      vst1q_u32 ((uint32_t *) (planes[1] + p * 4), v.val[1]);
+      vst1q_u32 ((uint32_t *) (planes[2] + p * 4), v.val[2]);
+    }
+  }
+#elif defined (TRANSFORM_SSE2_ENABLED)
+  if (esize == 4 && channels == 4) {
+    for (; p + 4 <= pixels; p += 4)
+      transpose_4x4_32bit (src + p * 16, 16, planes[0] + p * 4, dst_stride);
   }
 #endif
 
-  in_element_size = gst_tensor_get_element_size (in_info->type);
-  out_element_size = gst_tensor_get_element_size (out_info->type);
-
-  for (i = 0; i < num; ++i) {
-    gst_tensor_data_raw_typecast (
-        (gpointer) (inptr + in_element_size * i), in_info->type,
-        (gpointer) (outptr + out_element_size * i), out_info->type);
+  /* the remainders (or without SIMD) in a single pass */
+  switch (esize) {
+    case 1:
+      for (; p < pixels; p++)
+        for (c = 0; c < channels; c++)
+          planes[c][p] = src[p * channels + c];
+      break;
+    default:
+      for (; p < pixels; p++)
+        for (c = 0; c < channels; c++)
+          transpose_copy_elem (planes[c] + p * esize,
+              src + (p * channels + c) * esize, esize);
+      break;
   }
-
-  return GST_FLOW_OK;
 }
 
 /**
- * @brief subrouting for tensor-tranform, "arithmetic" case.
- * @param[in/out] filter "this" pointer
- * @param[in] in_info input tensor info
- * @param[in] out_info output tensor info
- * @param[in] inptr input tensor
- * @param[out] outptr output tensor
+ * @brief Merge the planes into the interleaved channels.
+ *        (src: channels x pixels) -> (dst: pixels x channels, packed)
+ */
+static void
+transpose_interleave (const uint8_t * src, uint8_t * dst, gsize channels,
+    gsize pixels, gsize src_stride, gsize esize)
+{
+  const uint8_t *planes[TRANSPOSE_MAX_CHANNELS];
+  gsize p = 0, c;
+
+  for (c = 0; c < channels; c++)
+    planes[c] = src + c * src_stride;
+
+#if defined (TRANSFORM_NEON_ENABLED)
+  if (esize == 1 && channels == 3) {
+    for (; p + 16 <= pixels; p += 16) {
+      uint8x16x3_t v;
+      v.val[0] = vld1q_u8 (planes[0] + p);
+      v.val[1] = vld1q_u8 (planes[1] + p);
+      v.val[2] = vld1q_u8 (planes[2] + p);
+      vst3q_u8 (dst + p * 3, v);
+    }
+  } else if (esize == 1 && channels == 4) {
+    for (; p + 16 <= pixels; p += 16) {
+      uint8x16x4_t v;
+      v.val[0] = vld1q_u8 (planes[0] + p);
+      v.val[1] = vld1q_u8 (planes[1] + p);
+      v.val[2] = vld1q_u8 (planes[2] + p);
+      v.val[3] = vld1q_u8 (planes[3] + p);
+      vst4q_u8 (dst + p * 4, v);
+    }
+  } else if (esize == 4 && channels == 3) {
+    for (; p + 4 <= pixels; p += 4) {
+      uint32x4x3_t v;
+      v.val[0] = vld1q_u32 ((const uint32_t *) (planes[0] + p * 4));
+      v.val[1] = vld1q_u32 ((const uint32_t *) (planes[1] + p * 4));
+      v.val[2] = vld1q_u32 ((const uint32_t *) (planes[2] + p * 4));
+      vst3q_u32 ((uint32_t *) (dst + p * 12), v);
+    }
+  }
+#elif defined (TRANSFORM_SSE2_ENABLED)
+  if (esize == 4 && channels == 4) {
+    for (; p + 4 <= pixels; p += 4)
+      transpose_4x4_32bit (planes[0] + p * 4, src_stride, dst + p * 16, 16);
+  }
+#endif
+
+  /* the remainders (or without SIMD) in a single pass */
+  switch (esize) {
+    case 1:
+      for (; p < pixels; p++)
+        for (c = 0; c < channels; c++)
+          dst[p * channels + c] = planes[c][p];
+      break;
+    default:
+      for (; p < pixels; p++)
+        for (c = 0; c < channels; c++)
+          transpose_copy_elem (dst + (p * channels + c) * esize,
+              planes[c] + p * esize, esize);
+      break;
+  }
+}
+
+/**
+ * @brief Transpose a matrix with the cache blocking. dst[c][r] = src[r][c]
+ * @param[in] src source matrix (rows x cols)
+ * @param[out] dst destination matrix (cols x rows)
+ * @param[in] rows the number of rows in the source
+ * @param[in] cols the number of columns in the source
+ * @param[in] src_stride bytes between the rows of the source
+ * @param[in] dst_stride bytes between the rows of the destination
+ * @param[in] esize element size (bytes)
+ */
+static void
+transpose_2d (const uint8_t * src, uint8_t * dst, gsize rows, gsize cols,
+    gsize src_stride, gsize dst_stride, gsize esize)
+{
+  gsize r, c, r0, r1, c0, c1;
+
+  if (rows == 1 || cols == 1) {
+    /* a vector, copy the elements with the strides */
+    if (rows == 1) {
+      for (c = 0; c < cols; c++)
+        nns_memcpy (dst + c * dst_stride, src + c * esize, esize);
+    } else {
+      for (r = 0; r < rows; r++)
+        nns_memcpy (dst + r * esize, src + r * src_stride, esize);
+    }
+    return;
+  }
+
+  /* e.g., RGB (NHWC) to planar (NCHW) */
+  if (cols <= TRANSPOSE_MAX_CHANNELS && src_stride == cols * esize) {
+    transpose_deinterleave (src, dst, rows, cols, dst_stride, esize);
+    return;
+  }
+
+  /* e.g., planar (NCHW) to RGB (NHWC) */
+  if (rows <= TRANSPOSE_MAX_CHANNELS && dst_stride == rows * esize) {
+    transpose_interleave (src, dst, rows, cols, src_stride, esize);
+    return;
+  }
+
+  switch (esize) {
+    case 1:
+      transpose_2d_loop (1);
+      break;
+    case 2:
+      transpose_2d_loop (2);
+      break;
+    case 4:
+#if defined (TRANSFORM_NEON_ENABLED) || defined (TRANSFORM_SSE2_ENABLED)
+      transpose_2d_32bit (src, dst, rows, cols, src_stride, dst_stride);
+#else
+      transpose_2d_loop (4);
+#endif
+      break;
+    case 8:
+      transpose_2d_loop (8);
+      break;
+    default:
+      /* large blocks (e.g., dimchg with inner dimensions), copy each block */
+      for (r = 0; r < rows; r++)
+        for (c = 0; c < cols; c++)
+          nns_memcpy (dst + c * dst_stride + r * esize,
+              src + r * src_stride + c * esize, esize);
+      break;
+  }
+}
+
+/**
+ * @brief Data structure for the 2D transposes of the slices with the same shape.
+ */
+typedef struct
+{
+  const uint8_t *src; /**< the first input slice */
+  uint8_t *dst; /**< the first output slice */
+  gsize count; /**< the number of slices */
+  gsize src_step; /**< offset (bytes) of the next input slice */
+  gsize dst_step; /**< offset (bytes) of the next output slice */
+  gsize rows; /**< the number of rows of a slice */
+  gsize cols; /**< the number of columns of a slice */
+  gsize src_stride; /**< row stride (bytes) of the input slice */
+  gsize dst_stride; /**< row stride (bytes) of the output slice */
+  gsize esize; /**< element size (bytes) */
+} transpose_2d_batch;
+
+/**
+ * @brief Transpose the range of the slices, or the range of the rows (columns) of a single slice.
+ */
+static void
+transpose_2d_batch_range (GstTensorTransform * filter, gpointer data,
+    gsize start, gsize end)
+{
+  const transpose_2d_batch *b = (const transpose_2d_batch *) data;
+  gsize k;
+
+  UNUSED (filter);
+
+  if (b->count > 1) {
+    for (k = start; k < end; k++)
+      transpose_2d (b->src + k * b->src_step, b->dst + k * b->dst_step,
+          b->rows, b->cols, b->src_stride, b->dst_stride, b->esize);
+  } else if (b->rows >= b->cols) {
+    /* the rows [start, end) are the columns of the output */
+    transpose_2d (b->src + start * b->src_stride, b->dst + start * b->esize,
+        end - start, b->cols, b->src_stride, b->dst_stride, b->esize);
+  } else {
+    transpose_2d (b->src + start * b->esize, b->dst + start * b->dst_stride,
+        b->rows, end - start, b->src_stride, b->dst_stride, b->esize);
+  }
+}
+
+/**
+ * @brief Run the 2D transposes of the slices (split across the worker threads if enabled).
+ */
+static void
+transpose_2d_batch_run (GstTensorTransform * filter,
+    const transpose_2d_batch * b)
+{
+  gsize units, unit_size;
+
+  if (b->count > 1) {
+    units = b->count;
+    unit_size = b->rows * b->cols * b->esize;
+  } else {
+    units = MAX (b->rows, b->cols);
+    unit_size = MIN (b->rows, b->cols) * b->esize;
+  }
+
+  gst_tensor_transform_parallel (filter, units, unit_size,
+      transpose_2d_batch_range, (gpointer) b);
+}
+
+/**
+ * @brief Transpose the 4D tensor (the last dimension is fixed) with the blocked kernels.
+ * @param[in] filter "this" pointer
+ * @param[in] order the transpose order (output dimension i is input dimension order[i])
+ * @param[in] dim the dimension of the input tensor
+ * @param[in] esize element size (bytes)
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ */
+static void
+transpose_blocked (GstTensorTransform * filter, const uint8_t * order,
+    const uint32_t * dim, gsize esize, const uint8_t * inptr, uint8_t * outptr)
+{
+  gsize d0 = dim[0], d1 = dim[1], d2 = dim[2];
+  gsize batch = 1, slice, b;
+  transpose_2d_batch t;
+  guint i;
+
+  for (i = NNS_TENSOR_TRANSPOSE_RANK_LIMIT - 1; i < NNS_TENSOR_RANK_LIMIT; i++)
+    batch *= dim[i];
+
+  slice = d0 * d1 * d2 * esize;
+
+  /* each permutation of 3 inner dimensions is a (batched) 2D transpose */
+  for (b = 0; b < batch; b++) {
+    t.src = inptr + b * slice;
+    t.dst = outptr + b * slice;
+    t.count = 1;
+    t.src_step = t.dst_step = 0;
+    t.esize = esize;
+
+    if (order[0] == 0) {
+      /* (0,2,1): swap d1 and d2, the rows of d0 are contiguous */
+      t.rows = d2;
+      t.cols = d1;
+      t.src_stride = d1 * d0 * esize;
+      t.dst_stride = d2 * d0 * esize;
+      t.esize = d0 * esize;
+    } else if (order[0] == 1 && order[1] == 0) {
+      /* (1,0,2): swap d0 and d1 in each d2 slice */
+      t.count = d2;
+      t.src_step = t.dst_step = d0 * d1 * esize;
+      t.rows = d1;
+      t.cols = d0;
+      t.src_stride = d0 * esize;
+      t.dst_stride = d1 * esize;
+    } else if (order[0] == 1) {
+      /* (1,2,0): [d2 x d1][d0] to [d0][d2 x d1], e.g., NHWC to NCHW */
+      t.rows = d1 * d2;
+      t.cols = d0;
+      t.src_stride = d0 * esize;
+      t.dst_stride = d1 * d2 * esize;
+    } else if (order[1] == 0) {
+      /* (2,0,1): [d2][d1 x d0] to [d1 x d0][d2], e.g., NCHW to NHWC */
+      t.rows = d2;
+      t.cols = d0 * d1;
+      t.src_stride = d0 * d1 * esize;
+      t.dst_stride = d2 * esize;
+    } else {
+      /* (2,1,0): swap d0 and d2 in each d1 */
+      t.count = d1;
+      t.src_step = d0 * esize;
+      t.dst_step = d2 * esize;
+      t.rows = d2;
+      t.cols = d0;
+      t.src_stride = d1 * d0 * esize;
+      t.dst_stride = d1 * d2 * esize;
+    }
+
+    transpose_2d_batch_run (filter, &t);
+  }
+}
+
+/**
+ * @brief subrouting for tensor-tranform, "dimchg" case.
+ * @param[in/out] filter "this" pointer
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return Gst flow status
+ */
+static GstFlowReturn
+gst_tensor_transform_dimchg (GstTensorTransform * filter,
+    GstTensorInfo * in_info, GstTensorInfo * out_info,
+    const uint8_t * inptr, uint8_t * outptr)
+{
+  uint32_t *fromDim = in_info->dimension;
+  uint32_t *toDim = out_info->dimension;
+  unsigned int from = filter->data_dimchg.from;
+  unsigned int to = filter->data_dimchg.to;
+  unsigned int i, j, k;
+  unsigned int loopLimit = 1;
+  gsize loopBlockSize, copyblocksize, copyblocklimit;
+
+  if (from == to) {
+    /** Useless memcpy. Do not call this or @todo do "IP" operation */
+    nns_profile_memcpy (filter, outptr, inptr,
+        gst_tensor_info_get_size (in_info));
+    GST_WARNING_OBJECT (filter,
+        "Calling tensor_transform with high memcpy overhead WITHOUT any effects! Check your stream whether you really need tensor_transform.\n");
+    return GST_FLOW_OK;
+  }
+
+  g_assert (from < NNS_TENSOR_RANK_LIMIT);
+  g_assert (to < NNS_TENSOR_RANK_LIMIT);
+  g_assert (fromDim[from] == toDim[to]);
+
+  loopBlockSize = copyblocksize = gst_tensor_get_element_size (in_info->type);
+  copyblocklimit = 1;
+
+  if (from < to) {
+    /**
+     * Smaller-loop-ed a to larger-loop-ed b
+     * E.g., [N][H][W][c] (c:W:H:N) --> [N][c][H][W] (W:H:c:N)
+     *
+     * In each outer loop, [B][X][A] is transposed to [X][B][A],
+     * where X is the dimension 'from', A and B are the dimensions below and above X.
+     */
+    for (i = NNS_TENSOR_RANK_LIMIT - 1; i > to; i--)
+      loopLimit *= toDim[i];
+    for (i = 0; i < to; i++)
+      loopBlockSize *= toDim[i];
+
+    for (i = 0; i < from; i++)
+      copyblocksize *= fromDim[i];
+    for (i = from; i < to; i++)
+      copyblocklimit *= toDim[i];
+
+    if (gst_tensor_get_element_count (fromDim) >=
+        TRANSPOSE_BLOCKED_MIN_ELEMENTS) {
+      transpose_2d_batch t;
+
+      t.src = inptr;
+      t.dst = outptr;
+      t.count = loopLimit;
+      t.src_step = t.dst_step = loopBlockSize * toDim[to];
+      t.rows = copyblocklimit;
+      t.cols = toDim[to];
+      t.src_stride = copyblocksize * toDim[to];
+      t.dst_stride = loopBlockSize;
+      t.esize = copyblocksize;
+
+      transpose_2d_batch_run (filter, &t);
+      return GST_FLOW_OK;
+    }
+
+    for (i = 0; i < loopLimit; i++) {
+      /* [i1][i2][...][iN][b][...] i = i1 x i2 x ... x iN */
+      uint8_t *destptr = outptr + loopBlockSize * toDim[to] * i;
+      const uint8_t *srcptr = inptr + loopBlockSize * toDim[to] * i;
+
+      for (j = 0; j < toDim[to]; j++) {
+        uint8_t *j_destptr = destptr + loopBlockSize * j;
+        for (k = 0; k < copyblocklimit; k++) {
+          nns_memcpy (j_destptr + copyblocksize * k,
+              srcptr + k * copyblocksize * toDim[to] + j * copyblocksize,
+              copyblocksize);
+        }
+      }
+    }
+  } else {
+    /**
+     * Larger-loop-ed a to smaller-loop-ed b
+     * E.g., [N][c][H][W] (W:H:c:N) --> [N][H][W][c] (c:W:H:N)
+     * @todo NYI
+     */
+    ml_loge
+        ("tensor-transform/dimchg operation is not permitted if from >= to.\n");
+    return GST_FLOW_ERROR;
+  }
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief The number of elements in a block of the fused arithmetic (and the typed loops of the other modes).
+ * All operators are applied to a block of the output tensor while it stays in the cache.
+ */
+#define ARITH_BLOCK_SIZE (2048)
+
+/**
+ * @brief Macro to check the typed loops support the tensor type.
+ * float16 requires the build option (-Denable-float16=true), then the compiler
+ * converts float16 with the hardware instructions (F16C, AVX512-FP16, or ARMv8 fp16).
+ */
+#ifdef FLOAT16_SUPPORT
+#define arith_type_supported(t) ((t) != _NNS_END)
+#else
+#define arith_type_supported(t) ((t) != _NNS_FLOAT16 && (t) != _NNS_END)
+#endif
+
+/**
+ * @brief Macro to run the typecast loop for the block.
+ */
+#define arith_typecast_loop(i,o,n,itype,otype) do { \
+    const itype *_ip = (const itype *) (i); \
+    otype *_op = (otype *) (o); \
+    gsize _k; \
+    for (_k = 0; _k < (n); _k++) \
+      _op[_k] = (otype) _ip[_k]; \
+  } while (0)
+
+/**
+ * @brief Macro to run the typecast loop, float to unsigned integer via signed integer (same as gst_tensor_data_typecast).
+ */
+#define arith_typecast_unsigned_loop(i,o,n,itype,stype,otype,is_float) do { \
+    if (is_float) { \
+      const itype *_ip = (const itype *) (i); \
+      otype *_op = (otype *) (o); \
+      gsize _k; \
+      for (_k = 0; _k < (n); _k++) \
+        _op[_k] = (otype) (stype) _ip[_k]; \
+    } else { \
+      arith_typecast_loop (i, o, n, itype, otype); \
+    } \
+  } while (0)
+
+/**
+ * @brief Macro to define the typecast kernel for the pair of the input and output types.
+ * The unsigned output from the floating-point input is converted via the signed type (stype).
+ */
+#define TYPECAST_KERNEL(iname,itype,ifloat,oname,otype,stype) \
+static void \
+typecast_kernel_##iname##_to_##oname (const uint8_t * inptr, uint8_t * outptr, \
+    gsize num) \
+{ \
+  arith_typecast_unsigned_loop (inptr, outptr, num, itype, stype, otype, ifloat); \
+}
+
+#ifdef FLOAT16_SUPPORT
+#define TYPECAST_KERNEL_TO_F16(iname,itype,ifloat) \
+    TYPECAST_KERNEL (iname, itype, ifloat, f16, float16, float16)
+#define typecast_kernel_to_f16(iname) typecast_kernel_##iname##_to_f16
+#else
+#define TYPECAST_KERNEL_TO_F16(iname,itype,ifloat)
+#define typecast_kernel_to_f16(iname) NULL
+#endif
+
+/**
+ * @brief Macro to define the typecast kernels from the input type to all types.
+ */
+#define TYPECAST_KERNELS_FROM(iname,itype,ifloat) \
+    TYPECAST_KERNEL (iname, itype, ifloat, s32, int32_t, int32_t) \
+    TYPECAST_KERNEL (iname, itype, ifloat, u32, uint32_t, int32_t) \
+    TYPECAST_KERNEL (iname, itype, ifloat, s16, int16_t, int16_t) \
+    TYPECAST_KERNEL (iname, itype, ifloat, u16, uint16_t, int16_t) \
+    TYPECAST_KERNEL (iname, itype, ifloat, s8, int8_t, int8_t) \
+    TYPECAST_KERNEL (iname, itype, ifloat, u8, uint8_t, int8_t) \
+    TYPECAST_KERNEL (iname, itype, ifloat, f64, double, double) \
+    TYPECAST_KERNEL (iname, itype, ifloat, f32, float, float) \
+    TYPECAST_KERNEL (iname, itype, ifloat, s64, int64_t, int64_t) \
+    TYPECAST_KERNEL (iname, itype, ifloat, u64, uint64_t, int64_t) \
+    TYPECAST_KERNEL_TO_F16 (iname, itype, ifloat)
+
+TYPECAST_KERNELS_FROM (s32, int32_t, FALSE)
+TYPECAST_KERNELS_FROM (u32, uint32_t, FALSE)
+TYPECAST_KERNELS_FROM (s16, int16_t, FALSE)
+TYPECAST_KERNELS_FROM (u16, uint16_t, FALSE)
+TYPECAST_KERNELS_FROM (s8, int8_t, FALSE)
+TYPECAST_KERNELS_FROM (u8, uint8_t, FALSE)
+TYPECAST_KERNELS_FROM (f64, double, TRUE)
+TYPECAST_KERNELS_FROM (f32, float, TRUE)
+TYPECAST_KERNELS_FROM (s64, int64_t, FALSE)
+TYPECAST_KERNELS_FROM (u64, uint64_t, FALSE)
+#ifdef FLOAT16_SUPPORT
+TYPECAST_KERNELS_FROM (f16, float16, TRUE)
+#endif
+
+/**
+ * @brief Macro for the row of the typecast kernels from the input type.
+ */
+#define TYPECAST_KERNEL_ROW(iname) { \
+      [_NNS_INT32] = typecast_kernel_##iname##_to_s32, \
+      [_NNS_UINT32] = typecast_kernel_##iname##_to_u32, \
+      [_NNS_INT16] = typecast_kernel_##iname##_to_s16, \
+      [_NNS_UINT16] = typecast_kernel_##iname##_to_u16, \
+      [_NNS_INT8] = typecast_kernel_##iname##_to_s8, \
+      [_NNS_UINT8] = typecast_kernel_##iname##_to_u8, \
+      [_NNS_FLOAT64] = typecast_kernel_##iname##_to_f64, \
+      [_NNS_FLOAT32] = typecast_kernel_##iname##_to_f32, \
+      [_NNS_INT64] = typecast_kernel_##iname##_to_s64, \
+      [_NNS_UINT64] = typecast_kernel_##iname##_to_u64, \
+      [_NNS_FLOAT16] = typecast_kernel_to_f16 (iname), \
+    }
+
+/**
+ * @brief The typecast kernels indexed by the input and output types (NULL if float16 is not supported).
+ */
+static const tensor_transform_typecast_kernel
+    typecast_kernels[_NNS_END][_NNS_END] = {
+  [_NNS_INT32] = TYPECAST_KERNEL_ROW (s32),
+  [_NNS_UINT32] = TYPECAST_KERNEL_ROW (u32),
+  [_NNS_INT16] = TYPECAST_KERNEL_ROW (s16),
+  [_NNS_UINT16] = TYPECAST_KERNEL_ROW (u16),
+  [_NNS_INT8] = TYPECAST_KERNEL_ROW (s8),
+  [_NNS_UINT8] = TYPECAST_KERNEL_ROW (u8),
+  [_NNS_FLOAT64] = TYPECAST_KERNEL_ROW (f64),
+  [_NNS_FLOAT32] = TYPECAST_KERNEL_ROW (f32),
+  [_NNS_INT64] = TYPECAST_KERNEL_ROW (s64),
+  [_NNS_UINT64] = TYPECAST_KERNEL_ROW (u64),
+#ifdef FLOAT16_SUPPORT
+  [_NNS_FLOAT16] = TYPECAST_KERNEL_ROW (f16),
+#endif
+};
+
+/**
+ * @brief Typecast uint8 to float32, the common input of the models, with the kernel for the running CPU.
+ */
+static void
+typecast_kernel_u8_to_f32_simd (const uint8_t * inptr, uint8_t * outptr,
+    gsize num)
+{
+  gst_tensor_kernels_get ()->u8_to_f32 (inptr, (gfloat *) outptr, num);
+}
+
+/**
+ * @brief Get the typecast kernel for the pair of the input and output types.
+ * @return The kernel, NULL if the type is not supported (float16 without FLOAT16_SUPPORT).
+ */
+static tensor_transform_typecast_kernel
+gst_tensor_transform_get_typecast_kernel (tensor_type in_type,
+    tensor_type out_type)
+{
+  if ((guint) in_type >= _NNS_END || (guint) out_type >= _NNS_END)
+    return NULL;
+
+  if (in_type == _NNS_UINT8 && out_type == _NNS_FLOAT32)
+    return typecast_kernel_u8_to_f32_simd;
+
+  return typecast_kernels[in_type][out_type];
+}
+
+/**
+ * @brief Typecast (or copy if the types are same) the block of the tensor with the kernel.
+ * @return FALSE if the type is not supported (float16 without FLOAT16_SUPPORT).
+ */
+static gboolean
+gst_tensor_transform_typecast_block (tensor_transform_typecast_kernel kernel,
+    tensor_type in_type, tensor_type out_type, const uint8_t * inptr,
+    uint8_t * outptr, gsize num)
+{
+  if (in_type == out_type) {
+    if (inptr != outptr)
+      nns_memcpy (outptr, inptr, num * gst_tensor_get_element_size (in_type));
+    return TRUE;
+  }
+
+  if (kernel == NULL)
+    return FALSE;
+
+  kernel (inptr, outptr, num);
+  return TRUE;
+}
+
+/**
+ * @brief subrouting for tensor-tranform, "typecast" case.
+ * @param[in/out] filter "this" pointer
+ * @param[in] kernels the typed kernels of the tensor
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return Gst flow status
+ */
+static GstFlowReturn
+gst_tensor_transform_typecast (GstTensorTransform * filter,
+    const tensor_transform_kernels * kernels, GstTensorInfo * in_info,
+    GstTensorInfo * out_info, const uint8_t * inptr, uint8_t * outptr)
+{
+  gulong i, num;
+  gsize in_element_size, out_element_size;
+
+  num = gst_tensor_get_element_count (in_info->dimension);
+
+#ifdef HAVE_ORC
+  if (orc_supported (filter, in_info->type, out_info->type)) {
+    trace_path (filter, "typecast", "orc");
+    orc_typecast (inptr, outptr, num, in_info->type, out_info->type);
+    return GST_FLOW_OK;
+  }
+#endif
+
+  /* typed kernel (also for float16 and 64-bit integers, vectorized by the compiler) */
+  if (gst_tensor_transform_typecast_block (kernels->typecast, in_info->type,
+          out_info->type, inptr, outptr, num)) {
+    trace_path (filter, "typecast", filter->acceleration ?
+        "typed kernel (orc does not support 64-bit integers)" :
+        "typed kernel");
+    return GST_FLOW_OK;
+  }
+
+  trace_path (filter, "typecast", "element-wise loop");
+
+  in_element_size = gst_tensor_get_element_size (in_info->type);
+  out_element_size = gst_tensor_get_element_size (out_info->type);
+
+  for (i = 0; i < num; ++i) {
+    gst_tensor_data_raw_typecast (
+        (gpointer) (inptr + in_element_size * i), in_info->type,
+        (gpointer) (outptr + out_element_size * i), out_info->type);
+  }
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief The min number of contiguous elements to apply the per-channel operator segment by segment.
+ * The smaller segments (e.g., interleaved channels) are processed with the strided loop.
+ */
+#define ARITH_MIN_SEGMENT (16)
+
+/**
+ * @brief Macro to apply the operator to the elements (the loop with the stride 1 is vectorized).
+ */
+#define arith_operator_loop_stride(o,n,s,v,opr,otype) do { \
+    otype *_op = (otype *) (o); \
+    const otype _v = (v)->data._##otype; \
+    gsize _k, _n = (n), _s = (s); \
+    for (_k = 0; _k < _n; _k++) \
+      _op[_k * _s] opr _v; \
+  } while (0)
+
+/**
+ * @brief Macro to define the operator kernel for the element type.
+ */
+#define OPERATOR_KERNEL(opname,opr,tname,ttype) \
+static void \
+operator_kernel_##opname##_##tname (uint8_t * outptr, gsize num, gsize stride, \
+    const tensor_data_s * value) \
+{ \
+  if (stride == 1) \
+    arith_operator_loop_stride (outptr, num, 1, value, opr, ttype); \
+  else \
+    arith_operator_loop_stride (outptr, num, stride, value, opr, ttype); \
+}
+
+/**
+ * @brief Macro to define the kernels of all operators for the element type.
+ */
+#define OPERATOR_KERNELS(tname,ttype) \
+    OPERATOR_KERNEL (add, +=, tname, ttype) \
+    OPERATOR_KERNEL (mul, *=, tname, ttype) \
+    OPERATOR_KERNEL (div, /=, tname, ttype)
+
+OPERATOR_KERNELS (s32, int32_t)
+OPERATOR_KERNELS (u32, uint32_t)
+OPERATOR_KERNELS (s16, int16_t)
+OPERATOR_KERNELS (u16, uint16_t)
+OPERATOR_KERNELS (s8, int8_t)
+OPERATOR_KERNELS (u8, uint8_t)
+OPERATOR_KERNELS (f64, double)
+OPERATOR_KERNELS (f32, float)
+OPERATOR_KERNELS (s64, int64_t)
+OPERATOR_KERNELS (u64, uint64_t)
+#ifdef FLOAT16_SUPPORT
+OPERATOR_KERNELS (f16, float16)
+#endif
+
+/**
+ * @brief Macro for the row of the operator kernels of the element type.
+ */
+#define OPERATOR_KERNEL_ROW(tname) { \
+      [GTT_OP_ADD] = operator_kernel_add_##tname, \
+      [GTT_OP_MUL] = operator_kernel_mul_##tname, \
+      [GTT_OP_DIV] = operator_kernel_div_##tname, \
+    }
+
+/**
+ * @brief The operator kernels indexed by the element type and operator (NULL if float16 is not supported).
+ */
+static const tensor_transform_operator_kernel
+    operator_kernels[_NNS_END][GTT_OP_UNKNOWN] = {
+  [_NNS_INT32] = OPERATOR_KERNEL_ROW (s32),
+  [_NNS_UINT32] = OPERATOR_KERNEL_ROW (u32),
+  [_NNS_INT16] = OPERATOR_KERNEL_ROW (s16),
+  [_NNS_UINT16] = OPERATOR_KERNEL_ROW (u16),
+  [_NNS_INT8] = OPERATOR_KERNEL_ROW (s8),
+  [_NNS_UINT8] = OPERATOR_KERNEL_ROW (u8),
+  [_NNS_FLOAT64] = OPERATOR_KERNEL_ROW (f64),
+  [_NNS_FLOAT32] = OPERATOR_KERNEL_ROW (f32),
+  [_NNS_INT64] = OPERATOR_KERNEL_ROW (s64),
+  [_NNS_UINT64] = OPERATOR_KERNEL_ROW (u64),
+#ifdef FLOAT16_SUPPORT
+  [_NNS_FLOAT16] = OPERATOR_KERNEL_ROW (f16),
+#endif
+};
+
+/**
+ * @brief Apply the operator to the elements (with the stride) with the typed kernel.
+ * @return FALSE if the type is not supported (float16 without FLOAT16_SUPPORT).
+ */
+static gboolean
+gst_tensor_transform_operator_block (const tensor_transform_kernels * kernels,
+    uint8_t * outptr, gsize num, gsize stride,
+    const tensor_transform_operator_s * op_s)
+{
+  tensor_transform_operator_kernel kernel;
+
+  if (op_s->op <= GTT_OP_TYPECAST || op_s->op >= GTT_OP_UNKNOWN)
+    return FALSE;
+
+  kernel = kernels->op[op_s->op];
+  if (kernel == NULL)
+    return FALSE;
+
+  kernel (outptr, num, stride, &op_s->value);
+  return TRUE;
+}
+
+/**
+ * @brief Apply the operator to the contiguous elements (or with the stride).
+ */
+static gboolean
+gst_tensor_transform_apply_operator (GstTensorTransform * filter,
+    const tensor_transform_kernels * kernels, gboolean use_orc,
+    uint8_t * outptr, gsize num, gsize stride,
+    tensor_transform_operator_s * op_s)
+{
+#ifdef HAVE_ORC
+  if (use_orc && stride == 1) {
+    orc_operator (outptr, num, &op_s->value, op_s->op);
+    return TRUE;
+  }
+#else
+  UNUSED (filter);
+  UNUSED (use_orc);
+#endif
+
+  return gst_tensor_transform_operator_block (kernels, outptr, num, stride,
+      op_s);
+}
+
+/**
+ * @brief Check the operand is zero (division by zero).
+ */
+static gboolean
+gst_tensor_transform_operand_is_zero (const tensor_data_s * value)
+{
+  double val = 0.0;
+
+  gst_tensor_data_raw_typecast ((gpointer) & value->data, value->type, &val,
+      _NNS_FLOAT64);
+  return (val == 0.0);
+}
+
+/**
+ * @brief Fused arithmetic, the typecast and all operators are applied to each block of the tensor at once.
+ * @param[in] filter "this" pointer
+ * @param[in] kernels the typed kernels of the tensor
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return FALSE if not supported (the caller should run the element-by-element loop)
+ */
+static gboolean
+gst_tensor_transform_arithmetic_fused (GstTensorTransform * filter,
+    const tensor_transform_kernels * kernels, GstTensorInfo * in_info,
+    GstTensorInfo * out_info, const uint8_t * inptr, uint8_t * outptr)
+{
+  gsize i, num, offset, len, block;
+  gsize in_element_size, out_element_size;
+  gsize ch_size = 1, ch_offset = 1, num_ch = 1, num_slabs;
+  gboolean per_channel = filter->data_arithmetic.per_channel_arith;
+  gboolean use_orc = FALSE;
+  const uint8_t *in;
+  uint8_t *out, *seg;
+  GSList *walk;
+  tensor_transform_operator_s *op_s;
+
+#ifdef HAVE_ORC
+  use_orc = orc_supported (filter, in_info->type, out_info->type);
+#endif
+
+  /* float16 without FLOAT16_SUPPORT runs the element-by-element loop */
+  if (!use_orc && (!arith_type_supported (in_info->type) ||
+          !arith_type_supported (out_info->type)))
+    return FALSE;
+
+  /* the operands in the output type */
+  for (walk = filter->operators; walk; walk = g_slist_next (walk)) {
+    op_s = (tensor_transform_operator_s *) walk->data;
+
+    if (op_s->op == GTT_OP_TYPECAST)
+      continue;
+
+    gst_tensor_data_typecast (&op_s->value, out_info->type);
+    if (op_s->op == GTT_OP_DIV &&
+        gst_tensor_transform_operand_is_zero (&op_s->value))
+      return FALSE;
+  }
+
+  num = gst_tensor_get_element_count (in_info->dimension);
+  in_element_size = gst_tensor_get_element_size (in_info->type);
+  out_element_size = gst_tensor_get_element_size (out_info->type);
+  block = ARITH_BLOCK_SIZE;
+
+  trace_path (filter, "arithmetic", use_orc ? "fused blocks (orc)" :
+      (filter->acceleration ?
+          "fused blocks (typed kernels, orc does not support 64-bit integers)" :
+          "fused blocks (typed kernels)"));
+
+  if (per_channel) {
+    /** e.g., ch_dim:1 of 3:4:4:1 -> #ch: 4, ch_size: 3, ch_offset: 12 */
+    for (i = 0; i < filter->data_arithmetic.ch_dim; ++i)
+      ch_size *= in_info->dimension[i];
+    num_ch = in_info->dimension[filter->data_arithmetic.ch_dim];
+    ch_offset = ch_size * num_ch;
+
+    /* the block has the whole channels */
+    block = MAX (1, ARITH_BLOCK_SIZE / ch_offset) * ch_offset;
+  }
+
+  for (offset = 0; offset < num; offset += block) {
+    len = MIN (block, num - offset);
+    in = inptr + offset * in_element_size;
+    out = outptr + offset * out_element_size;
+
+    /* typecast (or copy) the input block to the output block */
+    if (in == out) {
+      /* in-place, the block is already in the output */
+    } else if (use_orc) {
+#ifdef HAVE_ORC
+      orc_typecast (in, out, len, in_info->type, out_info->type);
+#endif
+    } else if (!gst_tensor_transform_typecast_block (kernels->typecast,
+            in_info->type, out_info->type, in, out, len)) {
+      return FALSE;
+    }
+
+    /* apply all operators while the output block is in the cache */
+    for (walk = filter->operators; walk; walk = g_slist_next (walk)) {
+      op_s = (tensor_transform_operator_s *) walk->data;
+
+      if (op_s->op == GTT_OP_TYPECAST)
+        continue;
+
+      if (!per_channel || op_s->applying_ch == -1) {
+        if (!gst_tensor_transform_apply_operator (filter, kernels, use_orc,
+                out, len, 1, op_s))
+          return FALSE;
+        continue;
+      }
+
+      if (op_s->applying_ch < 0 || (gsize) op_s->applying_ch >= num_ch)
+        continue;
+
+      num_slabs = len / ch_offset;
+      seg = out + ch_size * op_s->applying_ch * out_element_size;
+
+      if (ch_size >= ARITH_MIN_SEGMENT) {
+        for (i = 0; i < num_slabs; i++) {
+          if (!gst_tensor_transform_apply_operator (filter, kernels, use_orc,
+                  seg + ch_offset * i * out_element_size, ch_size, 1, op_s))
+            return FALSE;
+        }
+      } else {
+        /* interleaved channels */
+        for (i = 0; i < ch_size; i++) {
+          if (!gst_tensor_transform_operator_block (kernels,
+                  seg + i * out_element_size, num_slabs, ch_offset, op_s))
+            return FALSE;
+        }
+      }
+    }
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief subrouting for tensor-tranform, "arithmetic" case.
+ * @param[in/out] filter "this" pointer
+ * @param[in] kernels the typed kernels of the tensor
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return Gst flow status
+ */
+static GstFlowReturn
+gst_tensor_transform_arithmetic (GstTensorTransform * filter,
+    const tensor_transform_kernels * kernels, GstTensorInfo * in_info,
+    GstTensorInfo * out_info, const uint8_t * inptr, uint8_t * outptr)
+{
+  gulong i, num, j, ch;
+  gsize in_element_size, out_element_size;
+
+  GSList *walk;
+  tensor_transform_operator_s *op_s;
+  tensor_data_s value;
+
+  num = gst_tensor_get_element_count (in_info->dimension);
+
+  /* typecast and all operators in a single pass, block by block */
+  if (gst_tensor_transform_arithmetic_fused (filter, kernels, in_info,
+          out_info, inptr, outptr))
+    return GST_FLOW_OK;
+
+  trace_path (filter, "arithmetic", "element-wise loop");
+
+  in_element_size = gst_tensor_get_element_size (in_info->type);
+  out_element_size = gst_tensor_get_element_size (out_info->type);
+
+  /* per-channel */
+  if (filter->data_arithmetic.per_channel_arith) {
+    guint ch_dim = filter->data_arithmetic.ch_dim;
+    gsize ch_offset, ch_size = 1;
+    for (i = 0; i < ch_dim; ++i) {
+      ch_size *= in_info->dimension[i];
+    }
+    ch_offset = ch_size * in_info->dimension[ch_dim];
+
+    /** In case of 3:4:4:1,
+     * ch_dim:0 -> #ch: 3, ch_size: 1, ch_offset: 3
+     * ch_dim:1 -> #ch: 4, ch_size: 3, ch_offset: 12
+     * ch_dim:2 -> #ch: 4, ch_size: 12, ch_offset: 48
+     * ch_dim:3 -> #ch: 1, ch_size: 48, ch_offset: 48 * 4
+     */
+
+    for (i = 0; i < num / ch_offset; ++i) {
+      for (ch = 0; ch < in_info->dimension[ch_dim]; ++ch) {
+        for (j = 0; j < ch_size; ++j) {
+          gulong data_idx = (i * ch_offset) + (ch * ch_size) + j;
+          gst_tensor_data_set (&value, in_info->type,
+              (gpointer) (inptr + in_element_size * data_idx));
+
+          walk = filter->operators;
+          while (walk) {
+            op_s = (tensor_transform_operator_s *) walk->data;
+            switch (op_s->op) {
+              case GTT_OP_TYPECAST:
+                gst_tensor_data_typecast (&value, op_s->value.type);
+                break;
+              case GTT_OP_ADD:
+              case GTT_OP_MUL:
+              case GTT_OP_DIV:
+              {
+                gst_tensor_data_typecast (&op_s->value, value.type);
+
+                if (op_s->applying_ch == (int) ch || op_s->applying_ch == -1) {
+                  gst_tensor_transform_do_operator (filter, &value,
+                      &op_s->value, op_s->op);
+                }
+                break;
+              }
+              default:
+                g_assert (0);
+                return GST_FLOW_ERROR;
+            }
+
+            walk = g_slist_next (walk);
+          }
+
+          /* set output value */
+          g_assert (out_info->type == value.type);
+          gst_tensor_data_get (&value, outptr + out_element_size * data_idx);
+        }
+      }
+    }
+
+    return GST_FLOW_OK;
+  }
+
+  for (i = 0; i < num; ++i) {
+    /* init value with input tensor type */
+    gst_tensor_data_set (&value, in_info->type,
+        (gpointer) (inptr + in_element_size * i));
+
+    walk = filter->operators;
+    while (walk) {
+      op_s = (tensor_transform_operator_s *) walk->data;
+
+      /**
+       * @todo add more options
+       */
+      switch (op_s->op) {
+        case GTT_OP_TYPECAST:
+          gst_tensor_data_typecast (&value, op_s->value.type);
+          break;
+        case GTT_OP_ADD:
+        case GTT_OP_MUL:
+        case GTT_OP_DIV:
+          gst_tensor_data_typecast (&op_s->value, value.type);
+          gst_tensor_transform_do_operator (filter, &value, &op_s->value,
+              op_s->op);
+          break;
+        default:
+          g_assert (0);
+          return GST_FLOW_ERROR;
+      }
+
+      walk = g_slist_next (walk);
+    }
+
+    /* set output value */
+    g_assert (out_info->type == value.type);
+    gst_tensor_data_get (&value, outptr + out_element_size * i);
+  }
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * Macro to run loop for various data types with transpose
+ */
+#define transposeloop(cl,ck,cj,ci,sl,sk,sj,si,typesize) do { \
+    size_t i, j, k, l;                                  \
+    int inidx = 0, outidx=0;                            \
+    for(cl=0;cl<sl;cl++)                      \
+      for(ci=0;ci<si;ci++)                    \
+        for(cj=0;cj<sj;cj++)                  \
+          for(ck=0;ck<sk;ck++){               \
+            const uint8_t *_in; \
+            uint8_t *_out; \
+            outidx = si*sj*sk*cl + sj*sk*ci + sk*cj + ck; \
+            inidx = SK*SJ*SI*l + SJ*SI*k + SI*j + i; \
+            _in = inptr + inidx * typesize; \
+            _out = outptr + outidx * typesize; \
+            nns_memcpy(_out, _in, typesize); \
+	  }                                                      \
+  } while(0);
+
+/**
+ * @brief subrouting for tensor-tranform, "transpose" case.
+ * @param[in/out] filter "this" pointer
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return Gst flow status
+ */
+static GstFlowReturn
+gst_tensor_transform_transpose (GstTensorTransform * filter,
+    GstTensorInfo * in_info, GstTensorInfo * out_info,
+    const uint8_t * inptr, uint8_t * outptr)
+{
+  int i, from, to;
+  gboolean checkdim = FALSE;
+  uint32_t *fromDim = in_info->dimension;
+  gsize type_size = gst_tensor_get_element_size (in_info->type);
+  gsize indexI, indexJ, SL, SI, SJ, SK;
+  UNUSED (out_info);
+
+  for (i = 0; i < NNS_TENSOR_TRANSPOSE_RANK_LIMIT; i++) {
+    from = i;
+    to = filter->data_transpose.trans_order[i];
+    if (from != to) {
+      checkdim = TRUE;
+      break;
+    }
+  }
+
+  if (!checkdim) {
+    nns_profile_memcpy (filter, outptr, inptr,
+        gst_tensor_info_get_size (in_info));
+    GST_WARNING_OBJECT (filter,
+        "Calling tensor_transform with high memcpy overhead WITHOUT any effects!");
+    return GST_FLOW_OK;
+  }
+
+  if (gst_tensor_get_element_count (fromDim) >= TRANSPOSE_BLOCKED_MIN_ELEMENTS) {
+    transpose_blocked (filter, filter->data_transpose.trans_order, fromDim,
+        type_size, inptr, outptr);
+    return GST_FLOW_OK;
+  }
+
+  indexI = filter->data_transpose.trans_order[0];
+  indexJ = filter->data_transpose.trans_order[1];
+  SL = fromDim[3], SI = fromDim[0], SJ = fromDim[1], SK = fromDim[2];
+
+  switch (indexI) {
+    case 0:
+      if (indexJ == 1) {
+        transposeloop (l, i, j, k, SL, SI, SJ, SK, type_size);
+      } else {
+        transposeloop (l, i, k, j, SL, SI, SK, SJ, type_size);
+      }
+      break;
+    case 1:
+      if (indexJ == 0) {
+        transposeloop (l, j, i, k, SL, SJ, SI, SK, type_size);
+      } else {
+        transposeloop (l, j, k, i, SL, SJ, SK, SI, type_size);
+      }
+      break;
+    case 2:
+      if (indexJ == 0) {
+        transposeloop (l, k, i, j, SL, SK, SI, SJ, type_size);
+      } else {
+        transposeloop (l, k, j, i, SL, SK, SJ, SI, type_size);
+      }
+      break;
+  }
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Data structure for the range of "stand" case.
+ */
+typedef struct
+{
+  const GstTensorInfo *in_info; /**< input tensor info */
+  const GstTensorInfo *out_info; /**< output tensor info */
+  const uint8_t *inptr; /**< input tensor */
+  uint8_t *outptr; /**< output tensor */
+  const gdouble *average; /**< average of each channel */
+  const gdouble *std; /**< std of each channel (NULL for dc-average) */
+  gsize ch_size; /**< the number of channels (1 if not per-channel) */
+} transform_stand_data;
+
+/**
+ * @brief Standardize the range of the elements with the calculated average and std.
+ */
+static void
+gst_tensor_transform_stand_range (GstTensorTransform * filter, gpointer data,
+    gsize start, gsize end)
+{
+  const transform_stand_data *d = (const transform_stand_data *) data;
+  gsize in_element_size, out_element_size, i, k, len, ch;
+  gdouble tmp, buf[ARITH_BLOCK_SIZE];
+
+  in_element_size = gst_tensor_get_element_size (d->in_info->type);
+  out_element_size = gst_tensor_get_element_size (d->out_info->type);
+
+  if (arith_type_supported (d->in_info->type) &&
+      arith_type_supported (d->out_info->type)) {
+    tensor_transform_typecast_kernel to_double, from_double;
+
+    to_double = gst_tensor_transform_get_typecast_kernel (d->in_info->type,
+        _NNS_FLOAT64);
+    from_double = gst_tensor_transform_get_typecast_kernel (_NNS_FLOAT64,
+        d->out_info->type);
+
+    /* typed kernels, convert a block to double and back to the output type */
+    for (i = start; i < end; i += len) {
+      len = MIN (ARITH_BLOCK_SIZE, end - i);
+
+      gst_tensor_transform_typecast_block (to_double, d->in_info->type,
+          _NNS_FLOAT64, d->inptr + in_element_size * i, (uint8_t *) buf, len);
+
+      if (filter->data_stand.mode == STAND_DEFAULT) {
+        if (d->ch_size == 1) {
+          for (k = 0; k < len; k++)
+            buf[k] = fabs ((buf[k] - d->average[0]) / d->std[0]);
+        } else {
+          for (k = 0, ch = i % d->ch_size; k < len; k++) {
+            buf[k] = fabs ((buf[k] - d->average[ch]) / d->std[ch]);
+            if (++ch == d->ch_size)
+              ch = 0;
+          }
+        }
+      } else {
+        for (k = 0, ch = i % d->ch_size; k < len; k++) {
+          buf[k] -= d->average[ch];
+          if (++ch == d->ch_size)
+            ch = 0;
+        }
+      }
+
+      gst_tensor_transform_typecast_block (from_double, _NNS_FLOAT64,
+          d->out_info->type, (const uint8_t *) buf,
+          d->outptr + out_element_size * i, len);
+    }
+    return;
+  }
+
+  for (i = start; i < end; i++) {
+    ch = i % d->ch_size;
+    gst_tensor_data_raw_typecast ((gpointer) (d->inptr + in_element_size * i),
+        d->in_info->type, &tmp, _NNS_FLOAT64);
+
+    if (filter->data_stand.mode == STAND_DEFAULT)
+      tmp = fabs ((tmp - d->average[ch]) / d->std[ch]);
+    else
+      tmp -= d->average[ch];
+
+    gst_tensor_data_raw_typecast (&tmp, _NNS_FLOAT64,
+        (gpointer) (d->outptr + out_element_size * i), d->out_info->type);
+  }
+}
+
+/**
+ * @brief subrouting for tensor-tranform, "stand" case.
+ *        : pixel = abs((pixel - average(tensor))/(std(tensor) + val))
+ * @param[in/out] filter "this" pointer
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
  * @return Gst flow status
  */
 static GstFlowReturn
-gst_tensor_transform_arithmetic (GstTensorTransform * filter,
+gst_tensor_transform_stand (GstTensorTransform * filter,
     GstTensorInfo * in_info, GstTensorInfo * out_info,
     const uint8_t * inptr, uint8_t * outptr)
 {
-  gulong i, num, j, ch;
-  gsize in_element_size, out_element_size;
-
-  GSList *walk;
-  tensor_transform_operator_s *op_s;
-  tensor_data_s value;
+  GstFlowReturn ret = GST_FLOW_OK;
+  gsize data_size, ch_size;
+  gulong num;
+  gdouble *average, *std;
+  transform_stand_data d;
 
   num = gst_tensor_get_element_count (in_info->dimension);
 
-#ifdef HAVE_ORC
-  if (orc_supported (filter, in_info->type, out_info->type)) {
-    walk = filter->operators;
-    /**
-     * Typecast should be called at the first.
-     * Do the typecast. If in/out type is same, this will copy the input array to output.
-     */
-    orc_typecast (inptr, outptr, num, in_info->type, out_info->type);
+  data_size = gst_tensor_info_get_size (in_info);
+  ch_size = in_info->dimension[0];
 
-    if (!filter->data_arithmetic.per_channel_arith) {
-      while (walk) {
-        op_s = (tensor_transform_operator_s *) walk->data;
+  /* calc average and std (only for default mode) in a single pass */
+  average = std = NULL;
+  if (!gst_tensor_data_raw_stats ((gpointer) inptr, data_size, in_info->type,
+          filter->data_stand.per_channel ? ch_size : 1, &average,
+          (filter->data_stand.mode == STAND_DEFAULT) ? &std : NULL)) {
+    GST_ERROR_OBJECT (filter, "Failed to calculate the statistics\n");
+    return GST_FLOW_ERROR;
+  }
 
-        if (op_s->op != GTT_OP_TYPECAST) {
-          gst_tensor_data_typecast (&op_s->value, out_info->type);
-          orc_operator (outptr, num, &op_s->value, op_s->op);
-        }
+  switch (filter->data_stand.mode) {
+    case STAND_DEFAULT:
+    case STAND_DC_AVERAGE:
+    {
+      d.in_info = in_info;
+      d.out_info = out_info;
+      d.inptr = inptr;
+      d.outptr = outptr;
+      d.average = average;
+      d.std = std;
+      d.ch_size = filter->data_stand.per_channel ? ch_size : 1;
+
+      /* the elements are standardized independently after the statistics */
+      gst_tensor_transform_parallel (filter, num,
+          gst_tensor_get_element_size (out_info->type),
+          gst_tensor_transform_stand_range, &d);
+      break;
+    }
+    default:
+      GST_ERROR_OBJECT (filter, "Cannot identify mode\n");
+      ret = GST_FLOW_ERROR;
+  }
 
-        walk = g_slist_next (walk);
-      }
-    } else {
-      gsize typesize = 0;
-      guint ch_dim = filter->data_arithmetic.ch_dim;
-      gsize ch_offset, ch_size = 1;
-      uint8_t *tmp_outptr = NULL;
+  g_free (average);
+  g_free (std);
 
-      for (i = 0; i < ch_dim; ++i) {
-        ch_size *= in_info->dimension[i];
-      }
-      ch_offset = ch_size * in_info->dimension[ch_dim];
-      orc_typesize (typesize, out_info->type);
-
-      while (walk) {
-        op_s = (tensor_transform_operator_s *) walk->data;
-        if (op_s->op == GTT_OP_TYPECAST) {
-          walk = g_slist_next (walk);
-          continue;
-        }
+  return ret;
+}
 
-        if (op_s->applying_ch == -1) {
-          gst_tensor_data_typecast (&op_s->value, out_info->type);
-          orc_operator (outptr, num, &op_s->value, op_s->op);
-        } else {
-          for (i = 0; i < num / ch_offset; ++i) {
-            tmp_outptr =
-                outptr + (ch_size * op_s->applying_ch +
-                ch_offset * i) * typesize;
-            gst_tensor_data_typecast (&op_s->value, out_info->type);
-            orc_operator (tmp_outptr, ch_size, &op_s->value, op_s->op);
-          }
-        }
-        walk = g_slist_next (walk);
-      }
-    }
-    return GST_FLOW_OK;
-  }
+/**
+ * @brief Macro to clamp the floating-point elements in the element type.
+ * Rounding the limits to the element type does not change the result (same as clamping in double),
+ * because no element value lies between a limit and its rounded value.
+ */
+#define clamp_float_loop(i,o,n,mn,mx,ftype) do { \
+    const ftype *_ip = (const ftype *) (i); \
+    ftype *_op = (ftype *) (o); \
+    const ftype _lo = (ftype) (mn), _hi = (ftype) (mx); \
+    gsize _k; \
+    for (_k = 0; _k < (n); _k++) \
+      _op[_k] = CLAMP (_ip[_k], _lo, _hi); \
+  } while (0)
+
+/**
+ * @brief Macro to clamp the integer elements with the integer limits.
+ */
+#define clamp_int_loop(i,o,n,lo,hi,itype) do { \
+    const itype *_ip = (const itype *) (i); \
+    itype *_op = (itype *) (o); \
+    const itype _lo = (itype) (lo), _hi = (itype) (hi); \
+    gsize _k; \
+    for (_k = 0; _k < (n); _k++) \
+      _op[_k] = CLAMP (_ip[_k], _lo, _hi); \
+  } while (0)
+
+/**
+ * @brief Macro to clamp the elements in double and typecast back, the unsigned type via the signed type (same as the element-wise loop).
+ */
+#define clamp_double_loop(i,o,n,mn,mx,ttype,stype) do { \
+    const ttype *_ip = (const ttype *) (i); \
+    ttype *_op = (ttype *) (o); \
+    const gdouble _lo = (mn), _hi = (mx); \
+    gsize _k; \
+    for (_k = 0; _k < (n); _k++) \
+      _op[_k] = (ttype) (stype) CLAMP ((gdouble) _ip[_k], _lo, _hi); \
+  } while (0)
+
+/**
+ * @brief Macro to define the clamp kernels for the element type.
+ * @param loop clamp_float_loop for the floating-point type, clamp_int_loop for the integer type (up to 32 bits, with the integer limits)
+ */
+#define CLAMP_KERNELS(tname,ttype,stype,loop) \
+static void \
+clamp_kernel_##tname (const uint8_t * inptr, uint8_t * outptr, gsize num, \
+    gdouble lo, gdouble hi) \
+{ \
+  loop (inptr, outptr, num, lo, hi, ttype); \
+} \
+static void \
+clamp_double_kernel_##tname (const uint8_t * inptr, uint8_t * outptr, \
+    gsize num, gdouble lo, gdouble hi) \
+{ \
+  clamp_double_loop (inptr, outptr, num, lo, hi, ttype, stype); \
+}
+
+/**
+ * @brief Macro to define the clamp kernel in double only (64-bit integers).
+ */
+#define CLAMP_DOUBLE_KERNEL(tname,ttype,stype) \
+static void \
+clamp_double_kernel_##tname (const uint8_t * inptr, uint8_t * outptr, \
+    gsize num, gdouble lo, gdouble hi) \
+{ \
+  clamp_double_loop (inptr, outptr, num, lo, hi, ttype, stype); \
+}
+
+CLAMP_KERNELS (s32, int32_t, int32_t, clamp_int_loop)
+CLAMP_KERNELS (u32, uint32_t, int32_t, clamp_int_loop)
+CLAMP_KERNELS (s16, int16_t, int16_t, clamp_int_loop)
+CLAMP_KERNELS (u16, uint16_t, int16_t, clamp_int_loop)
+CLAMP_KERNELS (s8, int8_t, int8_t, clamp_int_loop)
+CLAMP_KERNELS (u8, uint8_t, int8_t, clamp_int_loop)
+CLAMP_KERNELS (f64, double, double, clamp_float_loop)
+CLAMP_KERNELS (f32, float, float, clamp_float_loop)
+CLAMP_DOUBLE_KERNEL (s64, int64_t, int64_t)
+CLAMP_DOUBLE_KERNEL (u64, uint64_t, int64_t)
+#ifdef FLOAT16_SUPPORT
+CLAMP_KERNELS (f16, float16, float16, clamp_float_loop)
+#define clamp_kernel_f16_entry clamp_kernel_f16
+#define clamp_double_kernel_f16_entry clamp_double_kernel_f16
+#else
+#define clamp_kernel_f16_entry NULL
+#define clamp_double_kernel_f16_entry NULL
 #endif
 
-  in_element_size = gst_tensor_get_element_size (in_info->type);
-  out_element_size = gst_tensor_get_element_size (out_info->type);
+/**
+ * @brief The clamp kernels in the element type (NULL for 64-bit integers, and float16 if not supported).
+ */
+static const tensor_transform_clamp_kernel clamp_kernels[_NNS_END] = {
+  [_NNS_INT32] = clamp_kernel_s32,
+  [_NNS_UINT32] = clamp_kernel_u32,
+  [_NNS_INT16] = clamp_kernel_s16,
+  [_NNS_UINT16] = clamp_kernel_u16,
+  [_NNS_INT8] = clamp_kernel_s8,
+  [_NNS_UINT8] = clamp_kernel_u8,
+  [_NNS_FLOAT64] = clamp_kernel_f64,
+  [_NNS_FLOAT32] = clamp_kernel_f32,
+  [_NNS_INT64] = NULL,
+  [_NNS_UINT64] = NULL,
+  [_NNS_FLOAT16] = clamp_kernel_f16_entry,
+};
 
-  /* per-channel */
-  if (filter->data_arithmetic.per_channel_arith) {
-    guint ch_dim = filter->data_arithmetic.ch_dim;
-    gsize ch_offset, ch_size = 1;
-    for (i = 0; i < ch_dim; ++i) {
-      ch_size *= in_info->dimension[i];
-    }
-    ch_offset = ch_size * in_info->dimension[ch_dim];
+/**
+ * @brief The clamp kernels in double (NULL for float16 if not supported).
+ */
+static const tensor_transform_clamp_kernel clamp_double_kernels[_NNS_END] = {
+  [_NNS_INT32] = clamp_double_kernel_s32,
+  [_NNS_UINT32] = clamp_double_kernel_u32,
+  [_NNS_INT16] = clamp_double_kernel_s16,
+  [_NNS_UINT16] = clamp_double_kernel_u16,
+  [_NNS_INT8] = clamp_double_kernel_s8,
+  [_NNS_UINT8] = clamp_double_kernel_u8,
+  [_NNS_FLOAT64] = clamp_double_kernel_f64,
+  [_NNS_FLOAT32] = clamp_double_kernel_f32,
+  [_NNS_INT64] = clamp_double_kernel_s64,
+  [_NNS_UINT64] = clamp_double_kernel_u64,
+  [_NNS_FLOAT16] = clamp_double_kernel_f16_entry,
+};
 
-    /** In case of 3:4:4:1,
-     * ch_dim:0 -> #ch: 3, ch_size: 1, ch_offset: 3
-     * ch_dim:1 -> #ch: 4, ch_size: 3, ch_offset: 12
-     * ch_dim:2 -> #ch: 4, ch_size: 12, ch_offset: 48
-     * ch_dim:3 -> #ch: 1, ch_size: 48, ch_offset: 48 * 4
-     */
+/**
+ * @brief Get the integer limits of clamp for the integer type (up to 32 bits).
+ * The limits are truncated like the typecast from double, and clipped to the range of the type.
+ * @return FALSE if the result is not same as clamping in double (the limits are out of the range)
+ */
+static gboolean
+gst_tensor_transform_clamp_int_limits (tensor_type type, gdouble min,
+    gdouble max, gint64 * lo, gint64 * hi)
+{
+  gdouble tmin, tmax, tlo, thi;
 
-    for (i = 0; i < num / ch_offset; ++i) {
-      for (ch = 0; ch < in_info->dimension[ch_dim]; ++ch) {
-        for (j = 0; j < ch_size; ++j) {
-          gulong data_idx = (i * ch_offset) + (ch * ch_size) + j;
-          gst_tensor_data_set (&value, in_info->type,
-              (gpointer) (inptr + in_element_size * data_idx));
+  switch (type) {
+    case _NNS_INT32:
+      tmin = G_MININT32;
+      tmax = G_MAXINT32;
+      break;
+    case _NNS_UINT32:
+      tmin = 0;
+      tmax = G_MAXUINT32;
+      break;
+    case _NNS_INT16:
+      tmin = G_MININT16;
+      tmax = G_MAXINT16;
+      break;
+    case _NNS_UINT16:
+      tmin = 0;
+      tmax = G_MAXUINT16;
+      break;
+    case _NNS_INT8:
+      tmin = G_MININT8;
+      tmax = G_MAXINT8;
+      break;
+    case _NNS_UINT8:
+      tmin = 0;
+      tmax = G_MAXUINT8;
+      break;
+    default:
+      return FALSE;
+  }
 
-          walk = filter->operators;
-          while (walk) {
-            op_s = (tensor_transform_operator_s *) walk->data;
-            switch (op_s->op) {
-              case GTT_OP_TYPECAST:
-                gst_tensor_data_typecast (&value, op_s->value.type);
-                break;
-              case GTT_OP_ADD:
-              case GTT_OP_MUL:
-              case GTT_OP_DIV:
-              {
-                gst_tensor_data_typecast (&op_s->value, value.type);
+  tlo = trunc (min);
+  thi = trunc (max);
 
-                if (op_s->applying_ch == (int) ch || op_s->applying_ch == -1) {
-                  gst_tensor_transform_do_operator (filter, &value,
-                      &op_s->value, op_s->op);
-                }
-                break;
-              }
-              default:
-                g_assert (0);
-                return GST_FLOW_ERROR;
-            }
+  /* all elements are clamped to the value out of the range, or min is larger than max */
+  if (thi < tmin || tlo > tmax || tlo > thi)
+    return FALSE;
 
-            walk = g_slist_next (walk);
-          }
+  *lo = (gint64) MAX (tlo, tmin);
+  *hi = (gint64) MIN (thi, tmax);
+  return TRUE;
+}
 
-          /* set output value */
-          g_assert (out_info->type == value.type);
-          gst_tensor_data_get (&value, outptr + out_element_size * data_idx);
-        }
-      }
+/**
+ * @brief subrouting for tensor-tranform, "clamp" case.
+ *        : pixel = if (pixel > max) ? max :
+ *                  if (pixel < min) ? min : pixel
+ * @param[in/out] filter "this" pointer
+ * @param[in] kernels the typed kernels of the tensor
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return Gst flow status
+ */
+static GstFlowReturn
+gst_tensor_transform_clamp (GstTensorTransform * filter,
+    const tensor_transform_kernels * kernels, GstTensorInfo * in_info,
+    GstTensorInfo * out_info, const uint8_t * inptr, uint8_t * outptr)
+{
+  gsize in_element_size, out_element_size;
+  gulong i, num, data_idx;
+  gdouble tmp;
+  gint64 lo, hi;
+
+  in_element_size = gst_tensor_get_element_size (in_info->type);
+  out_element_size = gst_tensor_get_element_size (out_info->type);
+  num = gst_tensor_get_element_count (in_info->dimension);
+
+  /* integer tensors (up to 32 bits) are clamped with the integer limits */
+  if (kernels->clamp && gst_tensor_transform_clamp_int_limits (in_info->type,
+          filter->data_clamp.min, filter->data_clamp.max, &lo, &hi)) {
+#ifdef HAVE_ORC
+    if (orc_supported (filter, in_info->type, out_info->type)) {
+      trace_path (filter, "clamp", "orc");
+      orc_clamp (inptr, outptr, num, lo, hi, in_info->type);
+      return GST_FLOW_OK;
     }
+#endif
+    trace_path (filter, "clamp", "typed kernel (integer)");
+    kernels->clamp (inptr, outptr, num, (gdouble) lo, (gdouble) hi);
+    return GST_FLOW_OK;
+  }
+
+  /* floating-point tensors are clamped in the element type */
+  if (kernels->clamp && (in_info->type == _NNS_FLOAT64 ||
+          in_info->type == _NNS_FLOAT32 || in_info->type == _NNS_FLOAT16)) {
+    trace_path (filter, "clamp", "typed kernel (floating-point)");
+    kernels->clamp (inptr, outptr, num, filter->data_clamp.min,
+        filter->data_clamp.max);
+    return GST_FLOW_OK;
+  }
 
+  /* 64-bit integers or the limits out of the range of the type */
+  if (kernels->clamp_double) {
+    trace_path (filter, "clamp", "typed kernel (double)");
+    kernels->clamp_double (inptr, outptr, num, filter->data_clamp.min,
+        filter->data_clamp.max);
     return GST_FLOW_OK;
   }
 
+  trace_path (filter, "clamp", "element-wise loop (double)");
+
   for (i = 0; i < num; ++i) {
-    /* init value with input tensor type */
-    gst_tensor_data_set (&value, in_info->type,
-        (gpointer) (inptr + in_element_size * i));
+    data_idx = in_element_size * i;
+    gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx), in_info->type,
+        &tmp, _NNS_FLOAT64);
 
-    walk = filter->operators;
-    while (walk) {
-      op_s = (tensor_transform_operator_s *) walk->data;
+    tmp = CLAMP (tmp, filter->data_clamp.min, filter->data_clamp.max);
 
-      /**
-       * @todo add more options
-       */
-      switch (op_s->op) {
-        case GTT_OP_TYPECAST:
-          gst_tensor_data_typecast (&value, op_s->value.type);
-          break;
-        case GTT_OP_ADD:
-        case GTT_OP_MUL:
-        case GTT_OP_DIV:
-          gst_tensor_data_typecast (&op_s->value, value.type);
-          gst_tensor_transform_do_operator (filter, &value, &op_s->value,
-              op_s->op);
-          break;
-        default:
-          g_assert (0);
-          return GST_FLOW_ERROR;
-      }
+    data_idx = out_element_size * i;
+    gst_tensor_data_raw_typecast (&tmp, _NNS_FLOAT64, outptr + data_idx,
+        out_info->type);
+  }
 
-      walk = g_slist_next (walk);
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief (De)quantize the block of the elements with the scale and zero point of each element.
+ * @return FALSE if the type is not supported (float16 without FLOAT16_SUPPORT).
+ */
+static gboolean
+gst_tensor_transform_quant_block (GstTensorTransform * filter,
+    tensor_type in_type, tensor_type out_type, const uint8_t * inptr,
+    uint8_t * outptr, gsize num, const gfloat * scale, const gfloat * zp)
+{
+  const GstTensorKernels *kernels = gst_tensor_kernels_get ();
+  gfloat buf[QUANT_BLOCK_SIZE];
+  const gfloat *src;
+  gfloat *dst;
+  gsize k;
+
+  if (filter->mode == GTT_QUANTIZE) {
+    src = (const gfloat *) inptr;
+    if (in_type != _NNS_FLOAT32) {
+      if (!gst_tensor_transform_typecast_block
+          (gst_tensor_transform_get_typecast_kernel (in_type, _NNS_FLOAT32),
+              in_type, _NNS_FLOAT32, inptr, (uint8_t *) buf, num))
+        return FALSE;
+      src = buf;
     }
 
-    /* set output value */
-    g_assert (out_info->type == value.type);
-    gst_tensor_data_get (&value, outptr + out_element_size * i);
+    if (out_type == _NNS_INT8)
+      kernels->f32_quantize_s8 (src, (gint8 *) outptr, num, scale, zp);
+    else
+      kernels->f32_quantize_u8 (src, (guint8 *) outptr, num, scale, zp);
+    return TRUE;
   }
 
-  return GST_FLOW_OK;
+  dst = (out_type == _NNS_FLOAT32) ? (gfloat *) outptr : buf;
+
+  if (in_type == _NNS_INT8) {
+    kernels->s8_dequantize ((const gint8 *) inptr, dst, num, scale, zp);
+  } else if (in_type == _NNS_UINT8) {
+    kernels->u8_dequantize (inptr, dst, num, scale, zp);
+  } else {
+    if (!gst_tensor_transform_typecast_block
+        (gst_tensor_transform_get_typecast_kernel (in_type, _NNS_FLOAT32),
+            in_type, _NNS_FLOAT32, inptr, (uint8_t *) dst, num))
+      return FALSE;
+    for (k = 0; k < num; k++)
+      dst[k] = (dst[k] - zp[k]) * scale[k];
+  }
+
+  if (dst == buf)
+    return gst_tensor_transform_typecast_block
+        (gst_tensor_transform_get_typecast_kernel (_NNS_FLOAT32, out_type),
+        _NNS_FLOAT32, out_type, (const uint8_t *) buf, outptr, num);
+  return TRUE;
 }
 
 /**
- * Macro to run loop for various data types with transpose
+ * @brief Fill the scale and zero point of the channel for the elements.
  */
-#define transposeloop(cl,ck,cj,ci,sl,sk,sj,si,typesize) do { \
-    size_t i, j, k, l;                                  \
-    int inidx = 0, outidx=0;                            \
-    for(cl=0;cl<sl;cl++)                      \
-      for(ci=0;ci<si;ci++)                    \
-        for(cj=0;cj<sj;cj++)                  \
-          for(ck=0;ck<sk;ck++){               \
-            const uint8_t *_in; \
-            uint8_t *_out; \
-            outidx = si*sj*sk*cl + sj*sk*ci + sk*cj + ck; \
-            inidx = SK*SJ*SI*l + SJ*SI*k + SI*j + i; \
-            _in = inptr + inidx * typesize; \
-            _out = outptr + outidx * typesize; \
-            nns_memcpy(_out, _in, typesize); \
-	  }                                                      \
-  } while(0);
+static void
+gst_tensor_transform_quant_fill (GstTensorTransform * filter, guint ch,
+    gfloat * scale, gfloat * zp, gsize num)
+{
+  const guint num_params = filter->data_quant.num_params;
+  gfloat s = filter->quant_params[ch];
+  gfloat z = filter->quant_params[num_params + ch];
+  gsize k;
+
+  /* quantize multiplies the reciprocal of the scale */
+  if (filter->mode == GTT_QUANTIZE)
+    s = 1.0f / s;
+
+  for (k = 0; k < num; k++) {
+    scale[k] = s;
+    zp[k] = z;
+  }
+}
 
 /**
- * @brief subrouting for tensor-tranform, "transpose" case.
+ * @brief subrouting for tensor-tranform, "quantize" and "dequantize" case.
+ *        : quantize: q = saturate (round (x / scale + zero_point))
+ *        : dequantize: x = (q - zero_point) * scale
  * @param[in/out] filter "this" pointer
+ * @param[in] kernels the typed kernels of the tensor
  * @param[in] in_info input tensor info
  * @param[in] out_info output tensor info
  * @param[in] inptr input tensor
@@ -1441,220 +3223,281 @@ gst_tensor_transform_arithmetic (GstTensorTransform * filter,
  * @return Gst flow status
  */
 static GstFlowReturn
-gst_tensor_transform_transpose (GstTensorTransform * filter,
-    GstTensorInfo * in_info, GstTensorInfo * out_info,
-    const uint8_t * inptr, uint8_t * outptr)
+gst_tensor_transform_quant (GstTensorTransform * filter,
+    const tensor_transform_kernels * kernels, GstTensorInfo * in_info,
+    GstTensorInfo * out_info, const uint8_t * inptr, uint8_t * outptr)
 {
-  int i, from, to;
-  gboolean checkdim = FALSE;
-  uint32_t *fromDim = in_info->dimension;
-  gsize type_size = gst_tensor_get_element_size (in_info->type);
-  gsize indexI, indexJ, SL, SI, SJ, SK;
-  UNUSED (out_info);
+  const tensor_transform_quant *quant = &filter->data_quant;
+  gfloat scale[QUANT_BLOCK_SIZE], zp[QUANT_BLOCK_SIZE];
+  gsize in_element_size, out_element_size, num, inner, period, block, i, k,
+      len;
+  guint ch, num_ch, d;
+  UNUSED (kernels);
 
-  for (i = 0; i < NNS_TENSOR_TRANSPOSE_RANK_LIMIT; i++) {
-    from = i;
-    to = filter->data_transpose.trans_order[i];
-    if (from != to) {
-      checkdim = TRUE;
-      break;
+  in_element_size = gst_tensor_get_element_size (in_info->type);
+  out_element_size = gst_tensor_get_element_size (out_info->type);
+  num = gst_tensor_get_element_count (in_info->dimension);
+
+  /* the elements of a channel are contiguous in the runs of inner elements */
+  num_ch = 1;
+  inner = num;
+  if (quant->num_params > 1) {
+    num_ch = in_info->dimension[quant->ch_dim];
+    if (num_ch != quant->num_params) {
+      GST_ERROR_OBJECT (filter,
+          "The number of the channels (%u) is not same as the number of the scales (%u).",
+          num_ch, quant->num_params);
+      return GST_FLOW_ERROR;
     }
+
+    for (inner = 1, d = 0; d < quant->ch_dim; d++)
+      inner *= in_info->dimension[d];
   }
 
-  if (!checkdim) {
-    nns_memcpy (outptr, inptr, gst_tensor_info_get_size (in_info));
-    GST_WARNING_OBJECT (filter,
-        "Calling tensor_transform with high memcpy overhead WITHOUT any effects!");
+  period = inner * num_ch;
+
+  if (period <= QUANT_BLOCK_SIZE) {
+    /* the parameters are repeated in the blocks of the multiple of the period */
+    block = period * (QUANT_BLOCK_SIZE / period);
+    for (ch = 0; ch < num_ch; ch++)
+      gst_tensor_transform_quant_fill (filter, ch, scale + ch * inner,
+          zp + ch * inner, inner);
+    for (k = period; k < block; k++) {
+      scale[k] = scale[k - period];
+      zp[k] = zp[k - period];
+    }
+
+    for (i = 0; i < num; i += len) {
+      len = MIN (block, num - i);
+      if (!gst_tensor_transform_quant_block (filter, in_info->type,
+              out_info->type, inptr + in_element_size * i,
+              outptr + out_element_size * i, len, scale, zp))
+        return GST_FLOW_NOT_SUPPORTED;
+    }
+
     return GST_FLOW_OK;
   }
 
-  indexI = filter->data_transpose.trans_order[0];
-  indexJ = filter->data_transpose.trans_order[1];
-  SL = fromDim[3], SI = fromDim[0], SJ = fromDim[1], SK = fromDim[2];
+  /* the parameters are same in the run of a channel */
+  for (i = 0, ch = 0; i < num; i += inner) {
+    gst_tensor_transform_quant_fill (filter, ch, scale, zp,
+        MIN (inner, QUANT_BLOCK_SIZE));
+
+    for (k = 0; k < inner; k += len) {
+      len = MIN (QUANT_BLOCK_SIZE, inner - k);
+      if (!gst_tensor_transform_quant_block (filter, in_info->type,
+              out_info->type, inptr + in_element_size * (i + k),
+              outptr + out_element_size * (i + k), len, scale, zp))
+        return GST_FLOW_NOT_SUPPORTED;
+    }
 
-  switch (indexI) {
-    case 0:
-      if (indexJ == 1) {
-        transposeloop (l, i, j, k, SL, SI, SJ, SK, type_size);
-      } else {
-        transposeloop (l, i, k, j, SL, SI, SK, SJ, type_size);
-      }
-      break;
-    case 1:
-      if (indexJ == 0) {
-        transposeloop (l, j, i, k, SL, SJ, SI, SK, type_size);
-      } else {
-        transposeloop (l, j, k, i, SL, SJ, SK, SI, type_size);
-      }
-      break;
-    case 2:
-      if (indexJ == 0) {
-        transposeloop (l, k, i, j, SL, SK, SI, SJ, type_size);
-      } else {
-        transposeloop (l, k, j, i, SL, SK, SJ, SI, type_size);
-      }
-      break;
+    if (++ch == num_ch)
+      ch = 0;
   }
 
   return GST_FLOW_OK;
 }
 
 /**
- * @brief subrouting for tensor-tranform, "stand" case.
- *        : pixel = abs((pixel - average(tensor))/(std(tensor) + val))
- * @param[in/out] filter "this" pointer
- * @param[in] in_info input tensor info
- * @param[in] out_info output tensor info
- * @param[in] inptr input tensor
- * @param[out] outptr output tensor
- * @return Gst flow status
+ * @brief Select the typed kernels for the input and output types of the tensor.
+ * @param[in] in_type input tensor type
+ * @param[in] out_type output tensor type
+ * @param[out] kernels the typed kernels (NULL if not supported, then the element-wise loop is used)
  */
-static GstFlowReturn
-gst_tensor_transform_stand (GstTensorTransform * filter,
-    GstTensorInfo * in_info, GstTensorInfo * out_info,
-    const uint8_t * inptr, uint8_t * outptr)
+static void
+gst_tensor_transform_select_kernels (tensor_type in_type, tensor_type out_type,
+    tensor_transform_kernels * kernels)
 {
-  GstFlowReturn ret = GST_FLOW_OK;
-  gsize in_element_size, out_element_size, data_size, ch_size;
-  gulong i, num, data_idx, ch;
-  gdouble tmp, *average, *std;
+  memset (kernels, 0, sizeof (tensor_transform_kernels));
 
-  in_element_size = gst_tensor_get_element_size (in_info->type);
-  out_element_size = gst_tensor_get_element_size (out_info->type);
-  num = gst_tensor_get_element_count (in_info->dimension);
+  if ((guint) in_type >= _NNS_END || (guint) out_type >= _NNS_END)
+    return;
 
-  data_size = gst_tensor_info_get_size (in_info);
-  ch_size = in_info->dimension[0];
+  kernels->typecast =
+      gst_tensor_transform_get_typecast_kernel (in_type, out_type);
+  memcpy (kernels->op, operator_kernels[out_type], sizeof (kernels->op));
 
-  /* calc average and std */
-  average = std = NULL;
-  if (filter->data_stand.per_channel) {
-    gst_tensor_data_raw_average_per_channel ((gpointer) inptr, data_size,
-        in_info->type, in_info->dimension, &average);
-    /* calculate std only for default mode */
-    if (filter->data_stand.mode == STAND_DEFAULT)
-      gst_tensor_data_raw_std_per_channel ((gpointer) inptr, data_size,
-          in_info->type, in_info->dimension, average, &std);
-  } else {
-    gst_tensor_data_raw_average ((gpointer) inptr, data_size,
-        in_info->type, &average);
-    /* calculate std only for default mode */
-    if (filter->data_stand.mode == STAND_DEFAULT)
-      gst_tensor_data_raw_std ((gpointer) inptr, data_size, in_info->type,
-          average, &std);
+  if (in_type == out_type) {
+    kernels->clamp = clamp_kernels[in_type];
+    kernels->clamp_double = clamp_double_kernels[in_type];
   }
+}
 
-  switch (filter->data_stand.mode) {
-    case STAND_DEFAULT:
-    {
-      if (!filter->data_stand.per_channel) {
-        for (i = 0; i < num; i++) {
-          data_idx = in_element_size * i;
-          gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx),
-              in_info->type, &tmp, _NNS_FLOAT64);
+/**
+ * @brief Function to transform a tensor (subrouting for each mode).
+ */
+typedef GstFlowReturn (*transform_mode_func) (GstTensorTransform * filter,
+    const tensor_transform_kernels * kernels, GstTensorInfo * in_info,
+    GstTensorInfo * out_info, const uint8_t * inptr, uint8_t * outptr);
 
-          tmp = fabs ((tmp - *average) / *std);
+/**
+ * @brief Data structure to split the tensor along the outer dimensions.
+ */
+typedef struct
+{
+  transform_mode_func func; /**< subrouting of the mode */
+  const tensor_transform_kernels *kernels; /**< the typed kernels of the tensor */
+  GstTensorInfo *in_info; /**< input tensor info */
+  GstTensorInfo *out_info; /**< output tensor info */
+  const uint8_t *inptr; /**< input tensor */
+  uint8_t *outptr; /**< output tensor */
+  guint split_dim; /**< the dimensions from split_dim are flattened into the units */
+  gsize in_unit_size; /**< size (bytes) of an input unit */
+  gsize out_unit_size; /**< size (bytes) of an output unit */
+  gint ret; /**< GstFlowReturn, the error of any range */
+} transform_split_data;
 
-          data_idx = out_element_size * i;
-          gst_tensor_data_raw_typecast (&tmp, _NNS_FLOAT64,
-              (gpointer) (outptr + data_idx), out_info->type);
-        }
-      } else {
-        for (ch = 0; ch < ch_size; ++ch) {
-          for (i = 0; i < num / ch_size; i++) {
-            data_idx = in_element_size * ((i * ch_size) + ch);
-            gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx),
-                in_info->type, &tmp, _NNS_FLOAT64);
+/**
+ * @brief Transform the range of the outer units as a smaller tensor.
+ */
+static void
+gst_tensor_transform_split_range (GstTensorTransform * filter, gpointer data,
+    gsize start, gsize end)
+{
+  transform_split_data *d = (transform_split_data *) data;
+  GstTensorInfo in_info, out_info;
+  GstFlowReturn ret;
+  guint i;
 
-            tmp = fabs ((tmp - average[ch]) / std[ch]);
+  in_info = *d->in_info;
+  out_info = *d->out_info;
 
-            data_idx = out_element_size * ((i * ch_size) + ch);
-            gst_tensor_data_raw_typecast (&tmp, _NNS_FLOAT64,
-                (gpointer) (outptr + data_idx), out_info->type);
-          }
-        }
-      }
-      break;
-    }
-    case STAND_DC_AVERAGE:
-    {
-      if (!filter->data_stand.per_channel) {
-        for (i = 0; i < num; i++) {
-          data_idx = in_element_size * i;
-          gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx),
-              in_info->type, &tmp, _NNS_FLOAT64);
+  for (i = d->split_dim; i < NNS_TENSOR_RANK_LIMIT; i++)
+    in_info.dimension[i] = out_info.dimension[i] = 1;
+  in_info.dimension[d->split_dim] = out_info.dimension[d->split_dim] =
+      (uint32_t) (end - start);
 
-          tmp -= *average;
+  ret = d->func (filter, d->kernels, &in_info, &out_info,
+      d->inptr + start * d->in_unit_size, d->outptr + start * d->out_unit_size);
+  if (ret != GST_FLOW_OK)
+    g_atomic_int_set (&d->ret, ret);
+}
 
-          data_idx = out_element_size * i;
-          gst_tensor_data_raw_typecast (&tmp, _NNS_FLOAT64,
-              (gpointer) (outptr + data_idx), out_info->type);
-        }
-      } else {
-        for (ch = 0; ch < ch_size; ++ch) {
-          for (i = 0; i < num / ch_size; i++) {
-            data_idx = in_element_size * ((i * ch_size) + ch);
-            gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx),
-                in_info->type, &tmp, _NNS_FLOAT64);
+/**
+ * @brief Run the subrouting of the element-wise mode, split across the worker threads if enabled.
+ * @param[in] filter "this" pointer
+ * @param[in] func subrouting of the mode
+ * @param[in] split_dim the dimensions from split_dim are independent (e.g., 0 for element-wise)
+ * @param[in] kernels the typed kernels of the tensor
+ * @param[in] in_info input tensor info
+ * @param[in] out_info output tensor info
+ * @param[in] inptr input tensor
+ * @param[out] outptr output tensor
+ * @return Gst flow status
+ */
+static GstFlowReturn
+gst_tensor_transform_split (GstTensorTransform * filter,
+    transform_mode_func func, guint split_dim,
+    const tensor_transform_kernels * kernels, GstTensorInfo * in_info,
+    GstTensorInfo * out_info, const uint8_t * inptr, uint8_t * outptr)
+{
+  transform_split_data d;
+  gsize units = 1;
+  guint i;
 
-            tmp -= average[ch];
+  if (filter->threads == 1 || split_dim >= NNS_TENSOR_RANK_LIMIT)
+    return func (filter, kernels, in_info, out_info, inptr, outptr);
+
+  d.func = func;
+  d.kernels = kernels;
+  d.in_info = in_info;
+  d.out_info = out_info;
+  d.inptr = inptr;
+  d.outptr = outptr;
+  d.split_dim = split_dim;
+  d.in_unit_size = gst_tensor_get_element_size (in_info->type);
+  d.out_unit_size = gst_tensor_get_element_size (out_info->type);
+  d.ret = GST_FLOW_OK;
+
+  for (i = 0; i < split_dim; i++) {
+    d.in_unit_size *= in_info->dimension[i];
+    d.out_unit_size *= in_info->dimension[i];
+  }
+  for (i = split_dim; i < NNS_TENSOR_RANK_LIMIT; i++)
+    units *= in_info->dimension[i];
 
-            data_idx = out_element_size * ((i * ch_size) + ch);
-            gst_tensor_data_raw_typecast (&tmp, _NNS_FLOAT64,
-                (gpointer) (outptr + data_idx), out_info->type);
-          }
-        }
-      }
-      break;
+  if (filter->mode == GTT_ARITHMETIC) {
+    GSList *walk;
+    tensor_transform_operator_s *op_s;
+
+    /* cast the operands once, the ranges should not update the operators */
+    for (walk = filter->operators; walk; walk = g_slist_next (walk)) {
+      op_s = (tensor_transform_operator_s *) walk->data;
+      if (op_s->op != GTT_OP_TYPECAST)
+        gst_tensor_data_typecast (&op_s->value, out_info->type);
     }
-    default:
-      GST_ERROR_OBJECT (filter, "Cannot identify mode\n");
-      ret = GST_FLOW_ERROR;
   }
 
-  g_free (average);
-  g_free (std);
-
-  return ret;
+  gst_tensor_transform_parallel (filter, units, d.out_unit_size,
+      gst_tensor_transform_split_range, &d);
+  return (GstFlowReturn) d.ret;
 }
 
 /**
- * @brief subrouting for tensor-tranform, "clamp" case.
- *        : pixel = if (pixel > max) ? max :
- *                  if (pixel < min) ? min : pixel
- * @param[in/out] filter "this" pointer
+ * @brief Run the subrouting of the transform mode.
+ * @param[in] filter "this" pointer
+ * @param[in] kernels the typed kernels selected for the types of the tensor
  * @param[in] in_info input tensor info
  * @param[in] out_info output tensor info
  * @param[in] inptr input tensor
- * @param[out] outptr output tensor
+ * @param[out] outptr output tensor (same as inptr if transforming in-place)
  * @return Gst flow status
  */
 static GstFlowReturn
-gst_tensor_transform_clamp (GstTensorTransform * filter,
-    GstTensorInfo * in_info, GstTensorInfo * out_info,
-    const uint8_t * inptr, uint8_t * outptr)
+gst_tensor_transform_run_mode (GstTensorTransform * filter,
+    const tensor_transform_kernels * kernels, GstTensorInfo * in_info,
+    GstTensorInfo * out_info, const uint8_t * inptr, uint8_t * outptr)
 {
-  gsize in_element_size, out_element_size;
-  gulong i, num, data_idx;
-  gdouble tmp;
-
-  in_element_size = gst_tensor_get_element_size (in_info->type);
-  out_element_size = gst_tensor_get_element_size (out_info->type);
-  num = gst_tensor_get_element_count (in_info->dimension);
+  GstFlowReturn res;
+  nns_profile_declare (start);
 
-  for (i = 0; i < num; ++i) {
-    data_idx = in_element_size * i;
-    gst_tensor_data_raw_typecast ((gpointer) (inptr + data_idx), in_info->type,
-        &tmp, _NNS_FLOAT64);
+  nns_profile_compute_begin (start);
 
-    tmp = CLAMP (tmp, filter->data_clamp.min, filter->data_clamp.max);
-
-    data_idx = out_element_size * i;
-    gst_tensor_data_raw_typecast (&tmp, _NNS_FLOAT64, outptr + data_idx,
-        out_info->type);
+  switch (filter->mode) {
+    case GTT_DIMCHG:
+      res = gst_tensor_transform_dimchg (filter, in_info, out_info,
+          inptr, outptr);
+      break;
+    case GTT_TYPECAST:
+      res = gst_tensor_transform_split (filter,
+          gst_tensor_transform_typecast, 0, kernels, in_info, out_info, inptr,
+          outptr);
+      break;
+    case GTT_ARITHMETIC:
+      /* per-channel operators are split with the slabs of all channels */
+      res = gst_tensor_transform_split (filter,
+          gst_tensor_transform_arithmetic,
+          filter->data_arithmetic.per_channel_arith ?
+          filter->data_arithmetic.ch_dim + 1 : 0,
+          kernels, in_info, out_info, inptr, outptr);
+      break;
+    case GTT_TRANSPOSE:
+      res = gst_tensor_transform_transpose (filter, in_info, out_info,
+          inptr, outptr);
+      break;
+    case GTT_STAND:
+      res = gst_tensor_transform_stand (filter, in_info, out_info,
+          inptr, outptr);
+      break;
+    case GTT_CLAMP:
+      res = gst_tensor_transform_split (filter, gst_tensor_transform_clamp,
+          0, kernels, in_info, out_info, inptr, outptr);
+      break;
+    case GTT_QUANTIZE:
+    case GTT_DEQUANTIZE:
+      /* per-channel parameters are split with the slabs of all channels */
+      res = gst_tensor_transform_split (filter, gst_tensor_transform_quant,
+          filter->data_quant.per_channel ? filter->data_quant.ch_dim + 1 : 0,
+          kernels, in_info, out_info, inptr, outptr);
+      break;
+    default:
+      ml_loge ("Not supported tensor transform mode");
+      res = GST_FLOW_NOT_SUPPORTED;
+      break;
   }
 
-  return GST_FLOW_OK;
+  nns_profile_compute_end (filter, start);
+  return res;
 }
 
 /**
@@ -1680,6 +3523,8 @@ gst_tensor_transform_transform (GstBaseTransform * trans,
   gsize buf_size, hsize;
   GstTensorMetaInfo meta;
   GstTensorInfo in_flex_info, out_flex_info;
+  tensor_transform_kernels flex_kernels;
+  const tensor_transform_kernels *kernels;
   gboolean in_flexible, out_flexible;
 
   filter = GST_TENSOR_TRANSFORM_CAST (trans);
@@ -1704,6 +3549,7 @@ gst_tensor_transform_transform (GstBaseTransform * trans,
   for (i = 0; i < num_tensors; i++) {
     in_info = &filter->in_config.info.info[i];
     out_info = &filter->out_config.info.info[i];
+    kernels = &filter->kernels[i];
 
     if (filter->apply && !g_list_find (filter->apply, GINT_TO_POINTER (i))) {
       GstMemory *mem = gst_buffer_peek_memory (inbuf, i);
@@ -1743,6 +3589,11 @@ gst_tensor_transform_transform (GstBaseTransform * trans,
       gst_tensor_transform_convert_dimension (filter, GST_PAD_SINK,
           i, in_info, out_info);
 
+      /* the type of the flexible tensor is given with the buffer */
+      gst_tensor_transform_select_kernels (in_info->type, out_info->type,
+          &flex_kernels);
+      kernels = &flex_kernels;
+
       hsize = gst_tensor_meta_info_get_header_size (&meta);
       inptr += hsize;
     }
@@ -1756,6 +3607,7 @@ gst_tensor_transform_transform (GstBaseTransform * trans,
     }
 
     out_mem[i] = gst_allocator_alloc (NULL, buf_size, NULL);
+    nns_profile_alloc (filter, buf_size);
     gst_buffer_append_memory (outbuf, out_mem[i]);
 
     if (!gst_memory_map (out_mem[i], &out_map[i], GST_MAP_WRITE)) {
@@ -1770,36 +3622,10 @@ gst_tensor_transform_transform (GstBaseTransform * trans,
       outptr += hsize;
     }
 
-    switch (filter->mode) {
-      case GTT_DIMCHG:
-        res = gst_tensor_transform_dimchg (filter, in_info, out_info,
-            inptr, outptr);
-        break;
-      case GTT_TYPECAST:
-        res = gst_tensor_transform_typecast (filter, in_info, out_info,
-            inptr, outptr);
-        break;
-      case GTT_ARITHMETIC:
-        res = gst_tensor_transform_arithmetic (filter, in_info, out_info,
-            inptr, outptr);
-        break;
-      case GTT_TRANSPOSE:
-        res = gst_tensor_transform_transpose (filter, in_info, out_info,
-            inptr, outptr);
-        break;
-      case GTT_STAND:
-        res = gst_tensor_transform_stand (filter, in_info, out_info,
-            inptr, outptr);
-        break;
-      case GTT_CLAMP:
-        res = gst_tensor_transform_clamp (filter, in_info, out_info,
-            inptr, outptr);
-        break;
-      default:
-        ml_loge ("Not supported tensor transform mode");
-        res = GST_FLOW_NOT_SUPPORTED;
-        goto done;
-    }
+    res = gst_tensor_transform_run_mode (filter, kernels, in_info, out_info,
+        inptr, outptr);
+    if (res != GST_FLOW_OK)
+      goto done;
   }
 
 done:
@@ -1813,6 +3639,120 @@ done:
   return res;
 }
 
+/**
+ * @brief in-place transform. optional vmethod for BaseTransform class.
+ * @param[in/out] trans "super" pointer
+ * @param[in/out] buf The gst buffer to be transformed in-place
+ * @return Gst Flow Status
+ */
+static GstFlowReturn
+gst_tensor_transform_transform_ip (GstBaseTransform * trans, GstBuffer * buf)
+{
+  GstTensorTransform *filter;
+  GstTensorInfo *in_info, *out_info;
+  GstFlowReturn res = GST_FLOW_OK;
+  GstMemory *mem, *out_mem;
+  GstMapInfo map, out_map;
+  guint i, num_tensors;
+  gsize offset = 0;
+
+  filter = GST_TENSOR_TRANSFORM_CAST (trans);
+
+  g_return_val_if_fail (filter->loaded, GST_FLOW_ERROR);
+  num_tensors = filter->in_config.info.num_tensors;
+
+  if (gst_buffer_n_memory (buf) != num_tensors) {
+    /* a memory chunk has all tensors (e.g., from the non-tensor element) */
+    if (!gst_buffer_map (buf, &map, GST_MAP_READWRITE)) {
+      ml_loge ("Cannot map the buffer to gst-buf at tensor-transform.\n");
+      return GST_FLOW_ERROR;
+    }
+
+    if (map.size < gst_tensors_info_get_size (&filter->in_config.info, -1)) {
+      ml_loge ("The size of the buffer is smaller than the tensors.\n");
+      res = GST_FLOW_ERROR;
+    }
+
+    for (i = 0; i < num_tensors && res == GST_FLOW_OK; i++) {
+      in_info = &filter->in_config.info.info[i];
+      out_info = &filter->out_config.info.info[i];
+
+      if (!filter->apply || g_list_find (filter->apply, GINT_TO_POINTER (i)))
+        res = gst_tensor_transform_run_mode (filter, &filter->kernels[i],
+            in_info, out_info, map.data + offset, map.data + offset);
+      offset += gst_tensor_info_get_size (in_info);
+    }
+
+    gst_buffer_unmap (buf, &map);
+    return res;
+  }
+
+  for (i = 0; i < num_tensors && res == GST_FLOW_OK; i++) {
+    in_info = &filter->in_config.info.info[i];
+    out_info = &filter->out_config.info.info[i];
+
+    if (filter->apply && !g_list_find (filter->apply, GINT_TO_POINTER (i)))
+      continue;
+
+    mem = gst_buffer_peek_memory (buf, i);
+    if (gst_memory_map (mem, &map, GST_MAP_READWRITE)) {
+      res = gst_tensor_transform_run_mode (filter, &filter->kernels[i],
+          in_info, out_info, map.data, map.data);
+      gst_memory_unmap (mem, &map);
+      continue;
+    }
+
+    /* the memory is read-only or shared with other buffers, write a new memory */
+    if (!gst_memory_map (mem, &map, GST_MAP_READ)) {
+      ml_loge ("Cannot map input buffer to gst-buf at tensor-transform.\n");
+      return GST_FLOW_ERROR;
+    }
+
+    out_mem = gst_allocator_alloc (NULL, gst_tensor_info_get_size (out_info),
+        NULL);
+    nns_profile_alloc (filter, gst_tensor_info_get_size (out_info));
+    if (!gst_memory_map (out_mem, &out_map, GST_MAP_WRITE)) {
+      ml_loge ("Cannot map output buffer to gst-buf at tensor-transform.\n");
+      gst_memory_unmap (mem, &map);
+      gst_memory_unref (out_mem);
+      return GST_FLOW_ERROR;
+    }
+
+    res = gst_tensor_transform_run_mode (filter, &filter->kernels[i],
+        in_info, out_info, map.data, out_map.data);
+
+    gst_memory_unmap (out_mem, &out_map);
+    gst_memory_unmap (mem, &map);
+    gst_buffer_replace_memory (buf, i, out_mem);
+  }
+
+  return res;
+}
+
+/**
+ * @brief Check the tensors can be transformed in-place.
+ * @return TRUE if the mode is element-wise and the shape and type of all tensors are not changed.
+ */
+static gboolean
+gst_tensor_transform_can_transform_ip (GstTensorTransform * filter)
+{
+  switch (filter->mode) {
+    case GTT_ARITHMETIC:
+    case GTT_STAND:
+    case GTT_CLAMP:
+      break;
+    default:
+      return FALSE;
+  }
+
+  if (!gst_tensors_config_is_static (&filter->in_config) ||
+      !gst_tensors_config_is_static (&filter->out_config))
+    return FALSE;
+
+  return gst_tensors_info_is_equal (&filter->in_config.info,
+      &filter->out_config.info);
+}
+
 /**
  * @brief Read cap, parse tensor configuration (dim/type) from the cap.
  * @param[in] filter "this" pointer
@@ -1951,6 +3891,28 @@ gst_tensor_transform_convert_dimension (GstTensorTransform * filter,
       /* same tensors info, do nothing. */
       break;
 
+    case GTT_QUANTIZE:
+    case GTT_DEQUANTIZE:
+      /** For both directions, dimension does not change */
+      if (direction == GST_PAD_SINK) {
+        guint ch = filter->data_quant.ch_dim;
+
+        /* the scales should be given for each channel */
+        if (filter->data_quant.num_params > 1 && in_info->dimension[ch] > 0 &&
+            in_info->dimension[ch] != filter->data_quant.num_params) {
+          GST_WARNING_OBJECT (filter,
+              "The dimension %u (%u) is not same as the number of the scales (%u).",
+              ch, in_info->dimension[ch], filter->data_quant.num_params);
+          return FALSE;
+        }
+
+        out_info->type = filter->data_quant.type;
+      } else {
+        /* cannot get the incoming data type on sink pad */
+        out_info->type = _NNS_END;
+      }
+      break;
+
     default:
       return FALSE;
   }
@@ -2156,6 +4118,19 @@ gst_tensor_transform_set_caps (GstBaseTransform * trans,
   filter->out_config = out_config;
   allowed = TRUE;
 
+  /* select the typed kernels once, the flexible tensors select them with the buffer */
+  for (i = 0; i < NNS_TENSOR_SIZE_LIMIT; i++) {
+    if (!in_flexible && i < in_config.info.num_tensors)
+      gst_tensor_transform_select_kernels (in_config.info.info[i].type,
+          out_config.info.info[i].type, &filter->kernels[i]);
+    else
+      memset (&filter->kernels[i], 0, sizeof (tensor_transform_kernels));
+  }
+
+  /* writes the output into the input buffer, without the frame-sized allocation */
+  gst_base_transform_set_in_place (trans,
+      gst_tensor_transform_can_transform_ip (filter));
+
 error:
   if (!allowed)
     GST_ERROR_OBJECT (filter, "Set Caps Failed!\n");
@@ -62,6 +62,8 @@ typedef enum _tensor_transform_mode
   GTT_TRANSPOSE,      /* Transpose. "transpose" */
   GTT_STAND,          /* Standardization. "stand" */
   GTT_CLAMP,          /* Clamp, "clamp" */
+  GTT_QUANTIZE,       /* Quantization, "quantize" */
+  GTT_DEQUANTIZE,     /* Dequantization, "dequantize" */
 
   GTT_UNKNOWN = -1,   /* Unknown/Not-implemented-yet Mode. "unknown" */
 } tensor_transform_mode;
@@ -140,6 +142,44 @@ typedef struct _tensor_transform_clamp {
   double min, max;
 } tensor_transform_clamp;
 
+/**
+ * @brief Internal data structure for quantize and dequantize mode.
+ */
+typedef struct _tensor_transform_quant {
+  tensor_type type; /**< the quantized type (quantize) or the output type (dequantize) */
+  gboolean per_channel; /**< TRUE if the scale and zero point are given for each channel */
+  guint ch_dim; /**< the dimension of the channels */
+  guint num_params; /**< the number of the scales (1 if per-tensor) */
+} tensor_transform_quant;
+
+/**
+ * @brief Kernel to typecast the elements from the input type to the output type.
+ */
+typedef void (*tensor_transform_typecast_kernel) (const uint8_t * inptr,
+    uint8_t * outptr, gsize num);
+
+/**
+ * @brief Kernel to apply the operator to the elements (with the stride) in the element type.
+ */
+typedef void (*tensor_transform_operator_kernel) (uint8_t * outptr, gsize num,
+    gsize stride, const tensor_data_s * value);
+
+/**
+ * @brief Kernel to clamp the elements with the limits.
+ */
+typedef void (*tensor_transform_clamp_kernel) (const uint8_t * inptr,
+    uint8_t * outptr, gsize num, gdouble lo, gdouble hi);
+
+/**
+ * @brief The typed kernels of the element-wise modes, selected for the input and output types of a tensor.
+ */
+typedef struct {
+  tensor_transform_typecast_kernel typecast; /**< typecast to the output type (NULL if the type is not supported) */
+  tensor_transform_operator_kernel op[GTT_OP_UNKNOWN]; /**< operators in the output type (GTT_OP_TYPECAST is not used) */
+  tensor_transform_clamp_kernel clamp; /**< clamp in the element type, floating-point or integer up to 32 bits (NULL if the types are different) */
+  tensor_transform_clamp_kernel clamp_double; /**< clamp in double and typecast back to the element type (NULL if the types are different) */
+} tensor_transform_kernels;
+
 /**
  * @brief Internal data structure for tensor_transform instances.
  */
@@ -157,13 +197,17 @@ struct _GstTensorTransform
     tensor_transform_transpose data_transpose; /**< Parsed option value for "transpose" mode. */
     tensor_transform_stand data_stand; /**< Parsed option value for "stand" mode. */
     tensor_transform_clamp data_clamp; /**< Parsed option value for "clamp" mode. */
+    tensor_transform_quant data_quant; /**< Parsed option value for "quantize" and "dequantize" mode. */
   };
   gboolean loaded; /**< TRUE if mode & option are loaded */
   gboolean acceleration; /**< TRUE to set orc acceleration */
+  guint threads; /**< the number of threads to transform large tensors (0 for all cores) */
   GSList *operators; /**< operators list */
+  gfloat *quant_params; /**< the scales and then the zero points of the channels (quantize and dequantize) */
 
   GstTensorsConfig in_config; /**< input tensors config */
   GstTensorsConfig out_config; /**< output tensors config */
+  tensor_transform_kernels kernels[NNS_TENSOR_SIZE_LIMIT]; /**< the kernels selected for the types of each tensor at caps negotiation */
   GList *apply; /**< Select the tensors to apply transformation */
 };
 
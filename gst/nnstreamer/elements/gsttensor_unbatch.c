@@ -0,0 +1,616 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	gsttensor_unbatch.c
+ * @date	14 Oct 2026
+ * @brief	GStreamer plugin to route the batched tensors back to the streams with the stream IDs
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ */
+
+/**
+ * SECTION:element-tensor_unbatch
+ *
+ * tensor_unbatch is the pair of tensor_batch. The last tensor of the input
+ * is int32 [N], the stream ID of each slot in the batch (-1 if the slot is
+ * empty), and the other tensors are split along the outermost dimension
+ * into N slices, e.g., 10:4 of 4 streams becomes 10:1 of each stream.
+ * The slices of the slot are pushed to the src pad of the stream ID
+ * (src_ID), which is created when the stream ID appears first.
+ * The slices share the memory of the batch (no copy) if possible.
+ *
+ * <refsect2>
+ * <title>Example launch line</title>
+ * |[
+ * gst-launch-1.0 \
+ * tensor_batch name=batch ! \
+ * tensor_filter framework=tensorflow-lite model=model.tflite input-combination=0 output-combination=o0,i1 ! \
+ * tensor_unbatch name=unbatch \
+ * ... (camera 0) ! tensor_converter ! batch.sink_0 \
+ * ... (camera 1) ! tensor_converter ! batch.sink_1 \
+ * unbatch.src_0 ! (result of camera 0) ... \
+ * unbatch.src_1 ! (result of camera 1) ...
+ * ]|
+ * </refsect2>
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string.h>
+#include <gst/gst.h>
+#include <glib.h>
+#include <nnstreamer_util.h>
+
+#include "gsttensor_unbatch.h"
+
+GST_DEBUG_CATEGORY_STATIC (gst_tensor_unbatch_debug);
+#define GST_CAT_DEFAULT gst_tensor_unbatch_debug
+
+/**
+ * @brief Macro for debug mode.
+ */
+#ifndef DBG
+#define DBG (!self->silent)
+#endif
+
+/**
+ * @brief Default caps string for sink pad.
+ */
+#define CAPS_STRING_SINK GST_TENSORS_CAP_MAKE ("static")
+
+/**
+ * @brief Default caps string for src pad.
+ */
+#define CAPS_STRING_SRC GST_TENSOR_CAP_DEFAULT ";" GST_TENSORS_CAP_MAKE ("static")
+
+enum
+{
+  PROP_0,
+  PROP_SILENT,
+};
+
+/**
+ * @brief the capabilities of the inputs and outputs.
+ * describe the real formats here.
+ */
+static GstStaticPadTemplate src_templ = GST_STATIC_PAD_TEMPLATE ("src_%u",
+    GST_PAD_SRC,
+    GST_PAD_SOMETIMES,
+    GST_STATIC_CAPS (CAPS_STRING_SRC)
+    );
+
+static GstStaticPadTemplate sink_templ = GST_STATIC_PAD_TEMPLATE ("sink",
+    GST_PAD_SINK,
+    GST_PAD_ALWAYS,
+    GST_STATIC_CAPS (CAPS_STRING_SINK)
+    );
+
+static GstFlowReturn gst_tensor_unbatch_chain (GstPad * pad,
+    GstObject * parent, GstBuffer * buf);
+static gboolean gst_tensor_unbatch_event (GstPad * pad, GstObject * parent,
+    GstEvent * event);
+static GstStateChangeReturn gst_tensor_unbatch_change_state (GstElement *
+    element, GstStateChange transition);
+static void gst_tensor_unbatch_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_tensor_unbatch_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
+static void gst_tensor_unbatch_dispose (GObject * object);
+static void gst_tensor_unbatch_finalize (GObject * object);
+#define gst_tensor_unbatch_parent_class parent_class
+G_DEFINE_TYPE (GstTensorUnbatch, gst_tensor_unbatch, GST_TYPE_ELEMENT);
+
+/**
+ * @brief initialize the tensor_unbatch's class
+ */
+static void
+gst_tensor_unbatch_class_init (GstTensorUnbatchClass * klass)
+{
+  GObjectClass *gobject_class;
+  GstElementClass *gstelement_class;
+
+  GST_DEBUG_CATEGORY_INIT (gst_tensor_unbatch_debug, "tensor_unbatch", 0,
+      "Element to route the batched tensors back to the streams");
+
+  gobject_class = (GObjectClass *) klass;
+  gstelement_class = (GstElementClass *) klass;
+
+  parent_class = g_type_class_peek_parent (klass);
+
+  gobject_class->dispose = gst_tensor_unbatch_dispose;
+  gobject_class->finalize = gst_tensor_unbatch_finalize;
+  gobject_class->get_property = gst_tensor_unbatch_get_property;
+  gobject_class->set_property = gst_tensor_unbatch_set_property;
+
+  g_object_class_install_property (gobject_class, PROP_SILENT,
+      g_param_spec_boolean ("silent", "Silent", "Produce verbose output ?",
+          TRUE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  gstelement_class->change_state =
+      GST_DEBUG_FUNCPTR (gst_tensor_unbatch_change_state);
+
+  gst_element_class_add_pad_template (gstelement_class,
+      gst_static_pad_template_get (&sink_templ));
+  gst_element_class_add_pad_template (gstelement_class,
+      gst_static_pad_template_get (&src_templ));
+
+  gst_element_class_set_details_simple (gstelement_class,
+      "TensorUnbatch",
+      "Demuxer/Tensor",
+      "Route the batched tensors back to the streams with the stream IDs",
+      "agent <agent@local>");
+}
+
+/**
+ * @brief initialize the new element
+ * instantiate pads and add them to element
+ * set pad calback functions
+ * initialize instance structure
+ */
+static void
+gst_tensor_unbatch_init (GstTensorUnbatch * self)
+{
+  self->sinkpad = gst_pad_new_from_static_template (&sink_templ, "sink");
+  gst_element_add_pad (GST_ELEMENT_CAST (self), self->sinkpad);
+  gst_pad_set_chain_function (self->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_tensor_unbatch_chain));
+  gst_pad_set_event_function (self->sinkpad,
+      GST_DEBUG_FUNCPTR (gst_tensor_unbatch_event));
+
+  self->silent = TRUE;
+  self->srcpads = NULL;
+  self->have_group_id = FALSE;
+  self->group_id = G_MAXUINT;
+  self->num_streams = 0;
+
+  gst_tensors_config_init (&self->tensors_config);
+  gst_tensors_config_init (&self->stream_config);
+}
+
+/**
+ * @brief function to remove srcpad list
+ */
+static void
+gst_tensor_unbatch_remove_src_pads (GstTensorUnbatch * self)
+{
+  while (self->srcpads != NULL) {
+    GstTensorPad *tensor_pad = self->srcpads->data;
+    gst_element_remove_pad (GST_ELEMENT (self), tensor_pad->pad);
+    g_free (tensor_pad);
+    self->srcpads = g_slist_delete_link (self->srcpads, self->srcpads);
+  }
+  self->srcpads = NULL;
+}
+
+/**
+ * @brief dispose function for tensor unbatch (gst element vmethod)
+ */
+static void
+gst_tensor_unbatch_dispose (GObject * object)
+{
+  GstTensorUnbatch *self = GST_TENSOR_UNBATCH (object);
+
+  gst_tensor_unbatch_remove_src_pads (self);
+  G_OBJECT_CLASS (parent_class)->dispose (object);
+}
+
+/**
+ * @brief finalize vmethod
+ */
+static void
+gst_tensor_unbatch_finalize (GObject * object)
+{
+  GstTensorUnbatch *self = GST_TENSOR_UNBATCH (object);
+
+  gst_tensors_config_free (&self->tensors_config);
+  gst_tensors_config_free (&self->stream_config);
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+/**
+ * @brief Parse caps and configure the tensors info of the streams.
+ * @param self GstTensorUnbatch Ojbect
+ * @param caps incomming capablity
+ * @return TRUE/FALSE (if successfully configured, return TRUE)
+ */
+static gboolean
+gst_tensor_unbatch_parse_caps (GstTensorUnbatch * self, GstCaps * caps)
+{
+  GstStructure *structure;
+  GstTensorsConfig config, stream_config;
+  GstTensorInfo *ids, *info;
+  guint i, num_tensors, num_streams;
+  gint rank;
+  gboolean ret = FALSE;
+
+  structure = gst_caps_get_structure (caps, 0);
+  gst_tensors_config_init (&config);
+  gst_tensors_config_init (&stream_config);
+  gst_tensors_config_from_structure (&config, structure);
+
+  if (!gst_tensors_config_validate (&config) ||
+      !gst_tensors_config_is_static (&config)) {
+    GST_ERROR_OBJECT (self, "Invalid caps, the static tensors are required.");
+    goto done;
+  }
+
+  num_tensors = config.info.num_tensors;
+  if (num_tensors < 2 || num_tensors > NNS_TENSOR_SIZE_LIMIT) {
+    GST_ERROR_OBJECT (self,
+        "The batch should have the tensors and the stream IDs (%u tensors).",
+        num_tensors);
+    goto done;
+  }
+
+  /* the stream IDs, int32 [N] */
+  ids = &config.info.info[num_tensors - 1];
+  if (ids->type != _NNS_INT32 || gst_tensor_info_get_rank (ids) != 1) {
+    GST_ERROR_OBJECT (self,
+        "The last tensor should be the stream IDs (int32 with rank 1).");
+    goto done;
+  }
+  num_streams = ids->dimension[0];
+
+  for (i = 0; i < num_tensors - 1; i++) {
+    info = &stream_config.info.info[i];
+    gst_tensor_info_copy (info, &config.info.info[i]);
+
+    rank = gst_tensor_info_get_rank (info);
+    if (info->dimension[rank - 1] % num_streams != 0) {
+      GST_ERROR_OBJECT (self,
+          "The outermost dimension (%u) of the %u-th tensor is not the multiple of the batch size (%u).",
+          info->dimension[rank - 1], i, num_streams);
+      goto done;
+    }
+
+    info->dimension[rank - 1] /= num_streams;
+  }
+
+  stream_config.info.num_tensors = num_tensors - 1;
+  stream_config.info.format = _NNS_TENSOR_FORMAT_STATIC;
+  stream_config.rate_n = config.rate_n;
+  stream_config.rate_d = config.rate_d;
+
+  gst_tensors_config_free (&self->tensors_config);
+  gst_tensors_config_free (&self->stream_config);
+  gst_tensors_config_copy (&self->tensors_config, &config);
+  gst_tensors_config_copy (&self->stream_config, &stream_config);
+  self->num_streams = num_streams;
+  ret = TRUE;
+
+done:
+  gst_tensors_config_free (&config);
+  gst_tensors_config_free (&stream_config);
+  return ret;
+}
+
+/**
+ * @brief Set the caps of the src pads with the tensors info of the stream.
+ */
+static void
+gst_tensor_unbatch_set_src_caps (GstTensorUnbatch * self, GstPad * pad)
+{
+  GstCaps *caps;
+
+  caps = gst_tensor_pad_caps_from_config (pad, &self->stream_config);
+  if (!gst_pad_set_caps (pad, caps))
+    GST_WARNING_OBJECT (self, "Unable to set pad caps");
+  gst_caps_unref (caps);
+}
+
+/**
+ * @brief event function for sink (gst element vmethod)
+ */
+static gboolean
+gst_tensor_unbatch_event (GstPad * pad, GstObject * parent, GstEvent * event)
+{
+  GstTensorUnbatch *self;
+  self = GST_TENSOR_UNBATCH (parent);
+
+  switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_CAPS:
+    {
+      GstCaps *caps;
+      GSList *walk;
+
+      gst_event_parse_caps (event, &caps);
+      if (!gst_tensor_unbatch_parse_caps (self, caps)) {
+        gst_event_unref (event);
+        return FALSE;
+      }
+
+      /* the caps of the streams are set when the pad is created */
+      for (walk = self->srcpads; walk; walk = g_slist_next (walk)) {
+        GstTensorPad *srcpad = (GstTensorPad *) walk->data;
+        gst_tensor_unbatch_set_src_caps (self, srcpad->pad);
+      }
+
+      gst_event_unref (event);
+      return TRUE;
+    }
+    default:
+      break;
+  }
+
+  return gst_pad_event_default (pad, parent, event);
+}
+
+/**
+ * @brief Get the src pad of the stream, create new pad if it is not created.
+ * @param self TensorUnbatch Object
+ * @param id the stream ID
+ * @return TensorPad of the stream.
+ */
+static GstTensorPad *
+gst_tensor_unbatch_get_tensor_pad (GstTensorUnbatch * self, const guint id)
+{
+  GSList *walk;
+  GstPad *pad;
+  GstTensorPad *tensorpad;
+  GstEvent *event;
+  gchar *name, *stream_id;
+
+  for (walk = self->srcpads; walk; walk = g_slist_next (walk)) {
+    tensorpad = (GstTensorPad *) walk->data;
+    if (tensorpad->nth == id)
+      return tensorpad;
+  }
+
+  GST_DEBUG_OBJECT (self, "creating pad of the stream %u", id);
+
+  name = g_strdup_printf ("src_%u", id);
+  pad = gst_pad_new_from_static_template (&src_templ, name);
+  g_free (name);
+
+  tensorpad = g_new0 (GstTensorPad, 1);
+  tensorpad->pad = pad;
+  tensorpad->nth = id;
+  tensorpad->last_ret = GST_FLOW_OK;
+  tensorpad->last_ts = GST_CLOCK_TIME_NONE;
+  self->srcpads = g_slist_append (self->srcpads, tensorpad);
+
+  gst_pad_use_fixed_caps (pad);
+  gst_pad_set_active (pad, TRUE);
+  gst_element_add_pad (GST_ELEMENT_CAST (self), pad);
+
+  if (!self->have_group_id) {
+    event = gst_pad_get_sticky_event (self->sinkpad, GST_EVENT_STREAM_START, 0);
+    if (event) {
+      self->have_group_id = gst_event_parse_group_id (event, &self->group_id);
+      gst_event_unref (event);
+    }
+
+    if (!self->have_group_id) {
+      self->have_group_id = TRUE;
+      self->group_id = gst_util_group_id_next ();
+    }
+  }
+
+  stream_id = gst_pad_create_stream_id_printf (pad, GST_ELEMENT_CAST (self),
+      "%u", id);
+  event = gst_event_new_stream_start (stream_id);
+  gst_event_set_group_id (event, self->group_id);
+  gst_pad_push_event (pad, event);
+  g_free (stream_id);
+
+  gst_tensor_unbatch_set_src_caps (self, pad);
+
+  /* the segment of the batch */
+  event = gst_pad_get_sticky_event (self->sinkpad, GST_EVENT_SEGMENT, 0);
+  if (!event) {
+    GstSegment segment;
+
+    gst_segment_init (&segment, GST_FORMAT_TIME);
+    event = gst_event_new_segment (&segment);
+  }
+  gst_pad_push_event (pad, event);
+
+  return tensorpad;
+}
+
+/**
+ * @brief Check the status among the streams, not-linked or eos only if all streams are.
+ * @param self TensorUnbatch Object
+ * @return return status after check sources
+ */
+static GstFlowReturn
+gst_tensor_unbatch_combine_flows (GstTensorUnbatch * self)
+{
+  GSList *walk;
+  GstFlowReturn ret = GST_FLOW_OK;
+
+  for (walk = self->srcpads; walk; walk = g_slist_next (walk)) {
+    GstTensorPad *opad = (GstTensorPad *) walk->data;
+
+    if (opad->last_ret != GST_FLOW_NOT_LINKED && opad->last_ret != GST_FLOW_EOS)
+      return GST_FLOW_OK;
+
+    if (walk == self->srcpads)
+      ret = opad->last_ret;
+    else if (opad->last_ret != ret)
+      return GST_FLOW_OK;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Get the slice of the memory, share the memory if possible.
+ */
+static GstMemory *
+gst_tensor_unbatch_get_slice (GstMemory * mem, gsize offset, gsize size)
+{
+  if (GST_MEMORY_FLAG_IS_SET (mem, GST_MEMORY_FLAG_NO_SHARE))
+    return gst_memory_copy (mem, offset, size);
+
+  return gst_memory_share (mem, offset, size);
+}
+
+/**
+ * @brief chain function for sink (gst element vmethod)
+ */
+static GstFlowReturn
+gst_tensor_unbatch_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
+{
+  GstTensorUnbatch *self;
+  GstTensorsInfo *info, *stream_info;
+  GstFlowReturn res = GST_FLOW_OK;
+  GstMemory *mem, *ids_mem;
+  GstMapInfo map;
+  guint i, k, num_tensors;
+  gint32 id;
+  UNUSED (pad);
+
+  self = GST_TENSOR_UNBATCH (parent);
+  info = &self->tensors_config.info;
+  stream_info = &self->stream_config.info;
+
+  if (self->num_streams == 0) {
+    gst_buffer_unref (buf);
+    GST_ELEMENT_ERROR (self, CORE, NEGOTIATION, (NULL),
+        ("The caps of the batch is not given."));
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+
+  num_tensors = info->num_tensors - 1;
+  if (gst_buffer_n_memory (buf) != info->num_tensors) {
+    gst_buffer_unref (buf);
+    GST_ELEMENT_ERROR (self, STREAM, FAILED, (NULL),
+        ("The number of the tensors in the batch is not %u.",
+            info->num_tensors));
+    return GST_FLOW_ERROR;
+  }
+
+  for (i = 0; i < num_tensors; i++) {
+    mem = gst_buffer_peek_memory (buf, i);
+
+    if (gst_memory_get_sizes (mem, NULL, NULL) <
+        gst_tensors_info_get_size (stream_info, i) * self->num_streams) {
+      gst_buffer_unref (buf);
+      GST_ELEMENT_ERROR (self, STREAM, FAILED, (NULL),
+          ("The size of the %u-th tensor is smaller than the batch.", i));
+      return GST_FLOW_ERROR;
+    }
+  }
+
+  ids_mem = gst_buffer_get_memory (buf, num_tensors);
+  if (!gst_memory_map (ids_mem, &map, GST_MAP_READ)) {
+    gst_memory_unref (ids_mem);
+    gst_buffer_unref (buf);
+    GST_ELEMENT_ERROR (self, STREAM, FAILED, (NULL),
+        ("Failed to map the stream IDs."));
+    return GST_FLOW_ERROR;
+  }
+
+  for (k = 0; k < self->num_streams; k++) {
+    GstTensorPad *srcpad;
+    GstBuffer *outbuf;
+    gsize size;
+
+    if (map.size < sizeof (gint32) * (k + 1))
+      break;
+
+    id = ((const gint32 *) map.data)[k];
+    if (id < 0)
+      continue;
+
+    srcpad = gst_tensor_unbatch_get_tensor_pad (self, (guint) id);
+    outbuf = gst_buffer_new ();
+
+    for (i = 0; i < num_tensors; i++) {
+      size = gst_tensors_info_get_size (stream_info, i);
+      mem = gst_buffer_peek_memory (buf, i);
+      gst_buffer_append_memory (outbuf,
+          gst_tensor_unbatch_get_slice (mem, size * k, size));
+    }
+
+    /* metadata from incoming buffer */
+    gst_buffer_copy_into (outbuf, buf, GST_BUFFER_COPY_METADATA, 0, -1);
+
+    silent_debug (self, "pushing the slot %u to the stream %d", k, id);
+    srcpad->last_ret = gst_pad_push (srcpad->pad, outbuf);
+
+    /* the other streams are pushed if the stream is not linked or ended */
+    if (srcpad->last_ret != GST_FLOW_OK &&
+        srcpad->last_ret != GST_FLOW_NOT_LINKED &&
+        srcpad->last_ret != GST_FLOW_EOS) {
+      res = srcpad->last_ret;
+      break;
+    }
+  }
+
+  if (res == GST_FLOW_OK)
+    res = gst_tensor_unbatch_combine_flows (self);
+
+  gst_memory_unmap (ids_mem, &map);
+  gst_memory_unref (ids_mem);
+  gst_buffer_unref (buf);
+  return res;
+}
+
+/**
+ * @brief change state (gst element vmethod)
+ */
+static GstStateChangeReturn
+gst_tensor_unbatch_change_state (GstElement * element,
+    GstStateChange transition)
+{
+  GstTensorUnbatch *self;
+  GstStateChangeReturn ret;
+  self = GST_TENSOR_UNBATCH (element);
+  ret = GST_ELEMENT_CLASS (parent_class)->change_state (element, transition);
+  if (ret == GST_STATE_CHANGE_FAILURE)
+    return ret;
+  switch (transition) {
+    case GST_STATE_CHANGE_PAUSED_TO_READY:
+      self->group_id = G_MAXUINT;
+      self->have_group_id = FALSE;
+      self->num_streams = 0;
+      gst_tensor_unbatch_remove_src_pads (self);
+      break;
+    default:
+      break;
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Set property (gst element vmethod)
+ */
+static void
+gst_tensor_unbatch_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstTensorUnbatch *self = GST_TENSOR_UNBATCH (object);
+  switch (prop_id) {
+    case PROP_SILENT:
+      self->silent = g_value_get_boolean (value);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/**
+ * @brief Get property (gst element vmethod)
+ */
+static void
+gst_tensor_unbatch_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstTensorUnbatch *self = GST_TENSOR_UNBATCH (object);
+  switch (prop_id) {
+    case PROP_SILENT:
+      g_value_set_boolean (value, self->silent);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
@@ -0,0 +1,65 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	gsttensor_unbatch.h
+ * @date	14 Oct 2026
+ * @brief	GStreamer plugin to route the batched tensors back to the streams with the stream IDs
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ */
+
+#ifndef __GST_TENSOR_UNBATCH_H__
+#define __GST_TENSOR_UNBATCH_H__
+
+#include <gst/gst.h>
+#include <tensor_common.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_TENSOR_UNBATCH (gst_tensor_unbatch_get_type ())
+#define GST_TENSOR_UNBATCH(obj) (G_TYPE_CHECK_INSTANCE_CAST ((obj), GST_TYPE_TENSOR_UNBATCH, GstTensorUnbatch))
+#define GST_TENSOR_UNBATCH_CLASS(klass) (G_TYPE_CHECK_CLASS_CAST ((klass), GST_TYPE_TENSOR_UNBATCH, GstTensorUnbatchClass))
+#define GST_TENSOR_UNBATCH_GET_CLASS(obj) (G_TYPE_INSTANCE_GET_CLASS ((obj), GST_TYPE_TENSOR_UNBATCH, GstTensorUnbatchClass))
+#define GST_IS_TENSOR_UNBATCH(obj) (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_TENSOR_UNBATCH))
+#define GST_IS_TENSOR_UNBATCH_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_TENSOR_UNBATCH))
+#define GST_TENSOR_UNBATCH_CAST(obj)((GstTensorUnbatch*)(obj))
+
+typedef struct _GstTensorUnbatch GstTensorUnbatch;
+typedef struct _GstTensorUnbatchClass GstTensorUnbatchClass;
+
+/**
+ * @brief Tensor Unbatch data structure
+ */
+struct _GstTensorUnbatch
+{
+  GstElement element;
+
+  gboolean silent;
+  GstPad *sinkpad;
+  GSList *srcpads; /**< the src pads (GstTensorPad), nth is the stream ID */
+  gboolean have_group_id;
+  guint group_id;
+
+  guint num_streams; /**< the batch size, the number of the stream IDs */
+  GstTensorsConfig tensors_config; /**< input tensors info */
+  GstTensorsConfig stream_config; /**< output tensors info of a stream */
+};
+
+/**
+ * @brief GstTensorUnbatchClass inherits GstElementClass
+ */
+struct _GstTensorUnbatchClass
+{
+  GstElementClass parent_class;
+};
+
+/**
+ * @brief Get Type function required for gst elements
+ */
+GType gst_tensor_unbatch_get_type (void);
+
+G_END_DECLS
+
+#endif  /** __GST_TENSOR_UNBATCH_H__ **/
@@ -35,6 +35,30 @@
 #endif /* __aarch64__ */
 #endif /* __APPLE__ */
 
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <cpuid.h>
+#define CPU_X86_PROBE_ENABLED
+#endif
+
+/**
+ * @brief The names of the CPU features.
+ */
+static const struct
+{
+  guint feature;
+  const gchar *name;
+} cpu_feature_names[] = {
+  {NNS_CPU_FEATURE_NEON, "neon"},
+  {NNS_CPU_FEATURE_SVE, "sve"},
+  {NNS_CPU_FEATURE_FP16, "fp16"},
+  {NNS_CPU_FEATURE_SSE4_1, "sse4.1"},
+  {NNS_CPU_FEATURE_SSE4_2, "sse4.2"},
+  {NNS_CPU_FEATURE_AVX2, "avx2"},
+  {NNS_CPU_FEATURE_AVX512F, "avx512f"},
+  {NNS_CPU_FEATURE_F16C, "f16c"},
+  {NNS_CPU_FEATURE_FMA, "fma"},
+};
+
 /**
  * @brief Check if neon is supported
  * @retval 0 if supported, else -errno
@@ -62,3 +86,162 @@ cpu_neon_accel_available (void)
 
   return neon_available;
 }
+
+#if defined(CPU_X86_PROBE_ENABLED)
+/**
+ * @brief Get the register states enabled by OS (XCR0).
+ */
+static guint64
+cpu_x86_xgetbv (void)
+{
+  guint32 eax, edx;
+
+  /* xgetbv with ecx = 0, encoded to build without -mxsave */
+  __asm__ volatile (".byte 0x0f, 0x01, 0xd0":"=a" (eax), "=d" (edx):"c" (0));
+  return ((guint64) edx << 32) | eax;
+}
+
+/**
+ * @brief Probe the x86 features with cpuid, the AVX states should be enabled by OS.
+ */
+static guint
+cpu_x86_probe (void)
+{
+  guint eax, ebx, ecx, edx;
+  guint features = NNS_CPU_FEATURE_NONE;
+  guint64 xcr0 = 0;
+  gboolean os_avx = FALSE, os_avx512 = FALSE;
+
+  if (!__get_cpuid (1, &eax, &ebx, &ecx, &edx))
+    return features;
+
+  if (ecx & bit_SSE4_1)
+    features |= NNS_CPU_FEATURE_SSE4_1;
+  if (ecx & bit_SSE4_2)
+    features |= NNS_CPU_FEATURE_SSE4_2;
+
+  if ((ecx & bit_OSXSAVE) && (ecx & bit_AVX)) {
+    xcr0 = cpu_x86_xgetbv ();
+    /* XMM and YMM, then opmask and ZMM */
+    os_avx = ((xcr0 & 0x6) == 0x6);
+    os_avx512 = os_avx && ((xcr0 & 0xe0) == 0xe0);
+  }
+
+  if (!os_avx)
+    return features;
+
+  if (ecx & bit_F16C)
+    features |= NNS_CPU_FEATURE_F16C;
+  if (ecx & bit_FMA)
+    features |= NNS_CPU_FEATURE_FMA;
+
+  if (__get_cpuid_max (0, NULL) >= 7) {
+    __cpuid_count (7, 0, eax, ebx, ecx, edx);
+
+    if (ebx & bit_AVX2)
+      features |= NNS_CPU_FEATURE_AVX2;
+    if (os_avx512 && (ebx & bit_AVX512F))
+      features |= NNS_CPU_FEATURE_AVX512F;
+  }
+
+  return features;
+}
+#endif /* CPU_X86_PROBE_ENABLED */
+
+/**
+ * @brief Probe the CPU features.
+ */
+static guint
+cpu_probe_features (void)
+{
+  guint features = NNS_CPU_FEATURE_NONE;
+
+#if defined(__aarch64__) || defined(__arm__)
+  gulong hwcap = getauxval (AT_HWCAP);
+
+  if (cpu_neon_accel_available () == 0)
+    features |= NNS_CPU_FEATURE_NEON;
+#if defined(__aarch64__) && defined(HWCAP_SVE)
+  if (hwcap & HWCAP_SVE)
+    features |= NNS_CPU_FEATURE_SVE;
+#endif
+#if defined(__aarch64__) && defined(HWCAP_ASIMDHP)
+  if (hwcap & HWCAP_ASIMDHP)
+    features |= NNS_CPU_FEATURE_FP16;
+#endif
+  (void) hwcap;
+#elif defined(CPU_X86_PROBE_ENABLED)
+  features = cpu_x86_probe ();
+#endif
+
+  return features;
+}
+
+/**
+ * @brief Get the features disabled with the environment variable.
+ */
+static guint
+cpu_get_disabled_features (void)
+{
+  const gchar *env = g_getenv ("NNSTREAMER_CPU_FEATURES_DISABLE");
+  gchar **names;
+  guint i, j, disabled = NNS_CPU_FEATURE_NONE;
+
+  if (!env || env[0] == '\0')
+    return disabled;
+
+  names = g_strsplit (env, ",", -1);
+  for (i = 0; names[i]; i++) {
+    g_strstrip (names[i]);
+
+    if (g_ascii_strcasecmp (names[i], "all") == 0) {
+      disabled = G_MAXUINT;
+      break;
+    }
+
+    for (j = 0; j < G_N_ELEMENTS (cpu_feature_names); j++) {
+      if (g_ascii_strcasecmp (names[i], cpu_feature_names[j].name) == 0)
+        disabled |= cpu_feature_names[j].feature;
+    }
+  }
+  g_strfreev (names);
+
+  return disabled;
+}
+
+/**
+ * @brief Get the CPU features available at runtime (bitmask of nns_cpu_feature_e).
+ */
+guint
+cpu_get_features (void)
+{
+  static gsize init = 0;
+  static guint features = NNS_CPU_FEATURE_NONE;
+
+  if (g_once_init_enter (&init)) {
+    features = cpu_probe_features () & ~cpu_get_disabled_features ();
+    g_once_init_leave (&init, 1);
+  }
+
+  return features;
+}
+
+/**
+ * @brief Get the names of the CPU features.
+ */
+gchar *
+cpu_get_features_string (guint features)
+{
+  GString *str = g_string_new (NULL);
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (cpu_feature_names); i++) {
+    if (features & cpu_feature_names[i].feature) {
+      if (str->len > 0)
+        g_string_append_c (str, ' ');
+      g_string_append (str, cpu_feature_names[i].name);
+    }
+  }
+
+  return g_string_free (str, FALSE);
+}
@@ -18,10 +18,42 @@
 
 #include <glib.h>
 
+G_BEGIN_DECLS
+
 /**
  * @brief Check if neon is supported
  * @retval 0 if supported, else -errno
  */
 gint cpu_neon_accel_available (void);
 
+/**
+ * @brief The CPU features used by the optimized kernels.
+ */
+typedef enum
+{
+  NNS_CPU_FEATURE_NONE = 0,
+  NNS_CPU_FEATURE_NEON = (1 << 0),      /**< ARM NEON (ASIMD) */
+  NNS_CPU_FEATURE_SVE = (1 << 1),       /**< ARM scalable vector extension */
+  NNS_CPU_FEATURE_FP16 = (1 << 2),      /**< ARM half-precision arithmetic */
+  NNS_CPU_FEATURE_SSE4_1 = (1 << 8),    /**< x86 SSE4.1 */
+  NNS_CPU_FEATURE_SSE4_2 = (1 << 9),    /**< x86 SSE4.2 */
+  NNS_CPU_FEATURE_AVX2 = (1 << 10),     /**< x86 AVX2 */
+  NNS_CPU_FEATURE_AVX512F = (1 << 11),  /**< x86 AVX-512 foundation */
+  NNS_CPU_FEATURE_F16C = (1 << 12),     /**< x86 half-precision conversion */
+  NNS_CPU_FEATURE_FMA = (1 << 13),      /**< x86 fused multiply-add */
+} nns_cpu_feature_e;
+
+/**
+ * @brief Get the CPU features available at runtime (bitmask of nns_cpu_feature_e).
+ * @note The features are probed once in the process. The features listed in the environment variable NNSTREAMER_CPU_FEATURES_DISABLE (comma-separated names, e.g., "avx512f,avx2", or "all") are excluded to test the fallback paths.
+ */
+guint cpu_get_features (void);
+
+/**
+ * @brief Get the names of the CPU features (space-separated, e.g., "sse4.1 sse4.2 avx2").
+ * @return Newly allocated string. The caller should free it.
+ */
+gchar *cpu_get_features_string (guint features);
+
+G_END_DECLS
 #endif /* __G_HW_ACCEL__ */
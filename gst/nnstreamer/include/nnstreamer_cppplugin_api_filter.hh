@@ -39,6 +39,7 @@
 #include <stdexcept>
 #include <stdint.h>
 #include <assert.h>
+#include <errno.h>
 #include <string.h>
 #include <nnstreamer_plugin_api_filter.h>
 #if __cplusplus < 201103L
@@ -72,10 +73,14 @@ class tensor_filter_subplugin {
 
     /** Helper function */
     static inline tensor_filter_subplugin * get_tfsp_with_checks (void * ptr);
+    static tensor_filter_subplugin * get_tfsp (void * ptr) noexcept; /**< Same with get_tfsp_with_checks, but returns nullptr for invalid pointer */
+    static int handle_invoke_exception () noexcept; /**< Converts the exception being handled in invoke to an error code */
     /** tensor_filter/C wrapper functions */
     static int cpp_open (const GstTensorFilterProperties * prop, void **private_data); /**< C wrapper func, open */
     static void cpp_close (const GstTensorFilterProperties * prop, void **private_data); /**< C wrapper func, close */
     static int cpp_invoke (const GstTensorFilterFramework *tf, const GstTensorFilterProperties *prop, void *private_data, const GstTensorMemory *input, GstTensorMemory *output); /**< C V1 wrapper func, invoke */
+    template<typename T>
+    static int cpp_invoke_static (const GstTensorFilterFramework *tf, const GstTensorFilterProperties *prop, void *private_data, const GstTensorMemory *input, GstTensorMemory *output); /**< C V1 wrapper func, invoke statically bound to T::invoke */
     static int cpp_getFrameworkInfo (const GstTensorFilterFramework *tf, const GstTensorFilterProperties * prop, void *private_data, GstTensorFilterFrameworkInfo *fw_info); /**< C V1 wrapper func, getFrameworkInfo */
     static int cpp_getModelInfo (const GstTensorFilterFramework *tf, const GstTensorFilterProperties * prop, void *private_data, model_info_ops ops, GstTensorsInfo *in_info, GstTensorsInfo *out_info); /**< C V1 wrapper func, getModelInfo */
     static int cpp_eventHandler (const GstTensorFilterFramework *tf, const GstTensorFilterProperties * prop, void *private_data, event_ops ops, GstTensorFilterFrameworkEventData *data); /**< C V1 wrapper func, eventHandler */
@@ -105,6 +110,11 @@ class tensor_filter_subplugin {
       memcpy (&emptyInstance->fwdesc, &fwdesc_template,
           sizeof (fwdesc_template));
       emptyInstance->fwdesc.subplugin_data = emptyInstance;
+#if __cplusplus >= 201402L
+      /** A final class cannot be overridden, call T::invoke without vtable. */
+      if (std::is_final<T>::value)
+        emptyInstance->fwdesc.invoke = cpp_invoke_static<T>;
+#endif
       nnstreamer_filter_probe (&emptyInstance->fwdesc);
 
       return emptyInstance;
@@ -192,6 +202,87 @@ class tensor_filter_subplugin {
           */
 };
 
+/**
+ * @brief C V1 wrapper of invoke for the final derived class T.
+ * @detail T::invoke is called directly, so the compiler may inline it into
+ *         the callback of the framework. The instance is checked as
+ *         cpp_invoke does.
+ */
+template<typename T>
+int tensor_filter_subplugin::cpp_invoke_static (
+    const GstTensorFilterFramework *tf, const GstTensorFilterProperties *prop,
+    void *private_data, const GstTensorMemory *input, GstTensorMemory *output)
+{
+  tensor_filter_subplugin *obj = get_tfsp (private_data);
+
+  (void) tf;
+  (void) prop;
+
+  if (obj == nullptr)
+    return -EINVAL;
+
+  try {
+    static_cast<T *> (obj)->T::invoke (input, output);
+  } catch (...) {
+    return handle_invoke_exception ();
+  }
+
+  return 0;
+}
+
+#if __cplusplus >= 201103L
+/**
+ * @brief Compile-time description of a tensor, for the subplugins with fixed input/output.
+ * @detail The type and dimensions (innermost first) are fixed at compile time,
+ *         e.g., static_tensor<_NNS_FLOAT32, 3, 224, 224, 1>. Use
+ *         static_tensors<...>::fill() in getModelInfo().
+ */
+template<tensor_type Type, unsigned int... Dims>
+struct static_tensor {
+  static_assert (sizeof... (Dims) > 0 && sizeof... (Dims) <= NNS_TENSOR_RANK_LIMIT,
+      "The rank of static_tensor should be in 1 ~ NNS_TENSOR_RANK_LIMIT");
+  static_assert (Type < _NNS_END, "Invalid tensor type");
+
+  static constexpr tensor_type type = Type; /**< the type of the tensor */
+  static constexpr unsigned int rank = sizeof... (Dims); /**< the rank of the tensor */
+
+  /**
+   * @brief Set the type and dimension. The name of the info is not changed.
+   */
+  static void fill (GstTensorInfo &info) {
+    const unsigned int dims[] = { Dims... };
+    unsigned int i;
+
+    info.type = Type;
+    for (i = 0; i < NNS_TENSOR_RANK_LIMIT; i++)
+      info.dimension[i] = (i < rank) ? dims[i] : 1U;
+  }
+};
+
+/**
+ * @brief Compile-time description of the tensors, a list of static_tensor.
+ */
+template<typename... Tensors>
+struct static_tensors {
+  static_assert (sizeof... (Tensors) > 0 && sizeof... (Tensors) <= NNS_TENSOR_SIZE_LIMIT,
+      "The number of static_tensors should be in 1 ~ NNS_TENSOR_SIZE_LIMIT");
+
+  static constexpr unsigned int num_tensors = sizeof... (Tensors); /**< the number of tensors */
+
+  /**
+   * @brief Set the number of tensors, types and dimensions.
+   */
+  static void fill (GstTensorsInfo &info) {
+    unsigned int i = 0;
+    /** Expand the pack in order, C++11 does not have fold expressions. */
+    int expand[] = { (Tensors::fill (info.info[i++]), 0)... };
+
+    (void) expand;
+    info.num_tensors = num_tensors;
+  }
+};
+#endif
+
 } /* namespace nnstreamer */
 
 #endif /* __cplusplus */
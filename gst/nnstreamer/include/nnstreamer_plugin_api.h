@@ -82,6 +82,148 @@ gst_tensors_caps_from_config (const GstTensorsConfig * config);
  */
 extern void gst_tensor_alloc_init (gsize alignment);
 
+/**
+ * @brief Statistics of the tensor allocator (the default allocator set by gst_tensor_alloc_init).
+ */
+typedef struct
+{
+  guint64 hits; /**< the number of allocations served from the free lists */
+  guint64 misses; /**< the number of allocations of new memory blocks */
+  guint64 resident_bytes; /**< bytes of memory blocks held by the allocator (in use and cached) */
+  guint64 cached_bytes; /**< bytes of free memory blocks kept for reuse */
+  guint64 in_use_bytes; /**< bytes of memory blocks allocated and not freed yet */
+  guint64 held_bytes; /**< bytes held by the elements (gst_tensor_alloc_account) */
+} GstTensorAllocatorStats;
+
+/**
+ * @brief Memory pressure against the watermarks of the memory budget.
+ */
+typedef enum
+{
+  GST_TENSOR_MEM_PRESSURE_NONE = 0, /**< under the watermarks */
+  GST_TENSOR_MEM_PRESSURE_THROTTLE, /**< over the low watermark, the sources should throttle the incoming data */
+  GST_TENSOR_MEM_PRESSURE_DROP, /**< over the high watermark, the sources should drop the incoming data */
+} GstTensorMemPressure;
+
+/**
+ * @brief set alignment and pool options of the default allocator
+ * @param alignment bytes of alignment
+ * @param pooled TRUE to reuse the freed memory chunks with size-class free lists and per-thread caches
+ * @param hugepage TRUE to back the large memory chunks (>= 2 MiB) with hugepages if available
+ */
+extern void gst_tensor_alloc_init_full (gsize alignment, gboolean pooled, gboolean hugepage);
+
+/**
+ * @brief Get the statistics of the tensor allocator.
+ * @param[out] stats the statistics to be filled
+ */
+extern void gst_tensor_alloc_get_stats (GstTensorAllocatorStats * stats);
+
+/**
+ * @brief Counters of the copy, allocation and compute time of an element.
+ * @note The core elements count them only if nnstreamer is built with -Denable-element-profile=true.
+ */
+typedef struct
+{
+  guint64 memcpy_bytes; /**< bytes copied by the element */
+  guint64 memcpy_count; /**< the number of the copies */
+  guint64 alloc_bytes; /**< bytes of the memory allocated by the element */
+  guint64 alloc_count; /**< the number of the allocations */
+  guint64 compute_ns; /**< time spent in the main compute loop (e.g., invoke, decode or transform) in nanoseconds */
+  guint64 compute_count; /**< the number of the compute calls */
+} GstTensorElementProfile;
+
+/**
+ * @brief Check whether the elements count the copy, allocation and compute time (built with -Denable-element-profile=true).
+ */
+extern gboolean gst_tensor_element_profile_is_enabled (void);
+
+/**
+ * @brief Get the counters of the copy, allocation and compute time of the element.
+ * @param element the element
+ * @param[out] profile the counters to be filled
+ * @return TRUE if the element has the counters, FALSE if the element has not counted anything (the counters are filled with 0).
+ */
+extern gboolean gst_tensor_element_get_profile (GstElement * element, GstTensorElementProfile * profile);
+
+/**
+ * @brief Reset the counters of the copy, allocation and compute time of the element.
+ * @param element the element
+ */
+extern void gst_tensor_element_reset_profile (GstElement * element);
+
+/**
+ * @brief Set the NUMA node of the memory allocated in the calling thread.
+ * @param node the NUMA node, -1 to allocate the memory without binding
+ * @note The memory blocks are bound to the node (preferred policy) and pooled in the free lists of the node.
+ *       The tensor allocator becomes the default allocator if the node is given.
+ */
+extern void gst_tensor_alloc_set_thread_node (gint node);
+
+/**
+ * @brief Set the watermarks of the memory budget.
+ * @param low bytes over which the sources throttle the incoming data (0 to disable)
+ * @param high bytes over which the sources drop the incoming data (0 to disable)
+ * @note The budget counts the memory in use of the tensor allocator (it becomes the default allocator) and the bytes accounted with gst_tensor_alloc_account().
+ */
+extern void gst_tensor_alloc_set_watermarks (guint64 low, guint64 high);
+
+/**
+ * @brief Account the bytes held by the owner, such as the data in the receive queue of an element.
+ * @param owner the owner of the memory (e.g., the element)
+ * @param bytes the bytes to add, negative to release
+ * @note Account the memory which is not allocated by the tensor allocator (e.g., the data received from the network).
+ *       The plugins not linked with nnstreamer may emit the action signal "account" of the allocator "GstTensorAllocator".
+ */
+extern void gst_tensor_alloc_account (gconstpointer owner, gint64 bytes);
+
+/**
+ * @brief Get the bytes held by the owner.
+ * @param owner the owner of the memory
+ * @return the bytes accounted with gst_tensor_alloc_account()
+ */
+extern guint64 gst_tensor_alloc_get_held (gconstpointer owner);
+
+/**
+ * @brief Get the memory pressure against the watermarks.
+ * @return the memory pressure, the sources throttle or drop the incoming data if it is not GST_TENSOR_MEM_PRESSURE_NONE.
+ * @note The plugins not linked with nnstreamer may read the property "pressure" of the allocator "GstTensorAllocator".
+ */
+extern GstTensorMemPressure gst_tensor_alloc_get_pressure (void);
+
+/**
+ * @brief The memory type of the tensor in the device memory (GstMemory of the device data).
+ */
+#define GST_TENSOR_DEVICE_MEMORY_TYPE "NNStreamerDeviceMemory"
+
+/**
+ * @brief Wrap the device data allocated by the framework with new GstMemory.
+ * @param ops the operations of the device memory (static, not copied)
+ * @param device_data the device data (e.g., CUDA device pointer)
+ * @param size the size of the tensor
+ * @param user_data the data passed to @a notify
+ * @param notify called when the memory is freed, to release the device data
+ * @return Newly allocated GstMemory, NULL if failed. (Caller should free returned memory using gst_memory_unref())
+ * @note Mapping the memory downloads the tensor to host memory once, so the elements not aware of the device memory read the tensor as usual. The data written in host memory is uploaded when the device data is requested.
+ */
+extern GstMemory *
+gst_tensor_device_memory_new (const GstTensorDeviceOps * ops, gpointer device_data, gsize size, gpointer user_data, GDestroyNotify notify);
+
+/**
+ * @brief Check the memory is the tensor in the device memory.
+ */
+extern gboolean
+gst_is_tensor_device_memory (GstMemory * mem);
+
+/**
+ * @brief Get the device data of the memory, to pass the tensor to the framework without the copy to host memory.
+ * @param mem the memory to be checked
+ * @param type the type of the device memory accepted by the caller
+ * @return The device data, NULL if the memory is not the device memory of @a type or failed to upload the data written in host memory.
+ */
+extern gpointer
+gst_tensor_device_memory_get_data (GstMemory * mem, tensor_memory_type type);
+
 /**
  * @brief Parse memory and fill the tensor meta.
  * @param[out] meta tensor meta structure to be filled
@@ -91,6 +233,17 @@ extern void gst_tensor_alloc_init (gsize alignment);
 extern gboolean
 gst_tensor_meta_info_parse_memory (GstTensorMetaInfo * meta, GstMemory * mem);
 
+/**
+ * @brief Get the tensor data of flexible tensor memory without the header.
+ * @param[in,out] cache the cached layout, updated if the header is changed
+ * @param[in] mem pointer to GstMemory of flexible tensor
+ * @param[out] meta tensor meta structure to be filled
+ * @return Newly shared GstMemory of the tensor data, NULL if failed to parse the header. (Caller should free returned memory using gst_memory_unref())
+ * @note The tensor data is not copied, returned memory is a sub-memory of @a mem.
+ */
+extern GstMemory *
+gst_tensor_meta_cache_share_payload (GstTensorMetaCache * cache, GstMemory * mem, GstTensorMetaInfo * meta);
+
 /**
  * @brief Append header to memory.
  * @param[in] meta tensor meta structure
@@ -94,6 +94,37 @@ typedef struct _GstTensorDecoderDef
        * @param[in] direction The direction of a pad. Normally this is GST_PAD_SINK.
        * @return The size of a buffer.
        */
+  GstFlowReturn (*decodeMemory) (void **private_data, const GstTensorsConfig *config,
+      GstMemory **input, guint num_tensors, GstBuffer *outbuf);
+      /**< Optional. The function to be called before decode with the input memory blocks (not mapped).
+       * If the data of the input memory can be used as it is, the sub-plugin may append the reference of the input memory to outbuf instead of copying the data (zero-copy).
+       * Note that the sub-plugin should not change the data of the input memory.
+       *
+       * @param[in/out] private_data A sub-plugin may save its internal private data here. The sub-plugin is responsible for alloc/free of this pointer.
+       * @param[in] config The structure of input tensor info.
+       * @param[in] input The array of input memory blocks.
+       * @param[in] num_tensors The number of input memory blocks.
+       * @param[out] outbuf A sub-plugin may append the memory for the negotiated media type.
+       * @return GST_FLOW_OK if OK. GST_FLOW_NOT_SUPPORTED (without updating outbuf) to decode the mapped data with decode.
+       */
+  GstFlowReturn (*decodeBatch) (void **private_data, const GstTensorsConfig *config,
+      const GstTensorMemory *input, guint num_frames, GstBuffer **outbufs);
+      /**< Optional. The function to be called instead of decode when tensor_decoder has the property batch (num_frames > 1).
+       * Each input tensor has num_frames logical frames packed along the outermost dimension, the i-th frame of the j-th tensor starts at input[j].data + i * (input[j].size / num_frames).
+       * If this is NULL, tensor_decoder calls decode for each frame.
+       *
+       * @param[in/out] private_data A sub-plugin may save its internal private data here. The sub-plugin is responsible for alloc/free of this pointer.
+       * @param[in] config The structure of input tensor info of a single frame (same as the one given to getOutCaps).
+       * @param[in] input The array of input tensor data including all frames.
+       * @param[in] num_frames The number of frames in the input tensors.
+       * @param[out] outbufs The array of output buffers (num_frames). A sub-plugin should update or append proper memory of each frame, same as decode.
+       * @return GST_FLOW_OK if OK.
+       */
+  int threadSafe;
+      /**< Optional. Set non-zero if decode and decodeMemory may be called concurrently from multiple threads with the same private_data (i.e., the callbacks do not update private_data).
+       * With the property workers > 1, tensor_decoder decodes the independent input buffers concurrently and pushes the outputs in the order of the input buffers.
+       * If this is zero, tensor_decoder always decodes the buffers in the streaming thread.
+       */
 } GstTensorDecoderDef;
 
 /* extern functions for subplugin management, exist in tensor_decoder.c */
@@ -36,10 +36,11 @@
 #define GST_TENSOR_FILTER_FRAMEWORK_BASE (0xDEAFDEAD00000000ULL)
 #define GST_TENSOR_FILTER_FRAMEWORK_V0 (GST_TENSOR_FILTER_FRAMEWORK_BASE)
 #define GST_TENSOR_FILTER_FRAMEWORK_V1 (GST_TENSOR_FILTER_FRAMEWORK_BASE | 0x10000ULL)
+#define GST_TENSOR_FILTER_FRAMEWORK_V2 (GST_TENSOR_FILTER_FRAMEWORK_BASE | 0x20000ULL)
 
 #define GST_TENSOR_FILTER_API_VERSION_DEFINED (1)
 #define GST_TENSOR_FILTER_API_VERSION_MIN (0)	/* The minimum API version supported (could be obsolete) */
-#define GST_TENSOR_FILTER_API_VERSION_MAX (1)	/* The maximum API version supported (recommended) */
+#define GST_TENSOR_FILTER_API_VERSION_MAX (2)	/* The maximum API version supported (recommended) */
 
 /**
  * @brief Check the value of the version field of GstTensorFilterFramework
@@ -161,6 +162,12 @@ typedef struct _GstTensorFilterProperties
 
   int latency; /**< The average latency over the recent 10 inferences in microseconds */
   int throughput; /**< The average throughput in the number of outputs per second */
+
+  unsigned int shared_tensor_filter_instances; /**< the number of framework instances sharing the model representation of shared_tensor_filter_key. The instances are leased per invoke. */
+
+  const char *cpu_affinity; /**< the list of CPU cores (e.g., "0-3,6") to run the invoke and the framework threads. NULL if not given. */
+  int num_threads; /**< the number of threads for the thread pool of the framework. 0 to use the default of the framework. */
+  int numa_node; /**< the NUMA node to run the invoke and to allocate the output tensors. -1 if not given. */
 } GstTensorFilterProperties;
 
 /**
@@ -191,6 +198,7 @@ typedef struct _GstTensorFilterFrameworkInfo
   accl_hw accl_auto;  /**< accelerator to be used in auto mode (acceleration to be used but accelerator is not specified for the filter) - default -1 implies use first entry from hw_list */
   accl_hw accl_default;   /**< accelerator to be used by default (valid user input is not provided) - default -1 implies use first entry from hw_list*/
   const GstTensorFilterFrameworkStatistics *statistics;  /**< usage statistics by the framework. This is shared across all opened instances of this framework */
+  int sparse_input; /**< TRUE(nonzero) if invoke accepts the sparse input tensors as they are (each GstTensorMemory has the header, the values and the indices). Otherwise, tensor-filter decodes the sparse input stream into dense tensors before invoke. */
 } GstTensorFilterFrameworkInfo;
 
 /**
@@ -200,13 +208,17 @@ typedef struct _GstTensorFilterFrameworkInfo
  */
 typedef enum
 {
-  DESTROY_NOTIFY,   /**< Free the data element allocated in the invoke callback */
+  DESTROY_NOTIFY,   /**< Free the data element allocated in the invoke callback, or return it to the output pool (GstTensorFilterOutputPool) */
   RELOAD_MODEL,     /**< Reloads the subplugin with newely provided model */
   CUSTOM_PROP,      /**< Update the custom properties for the framework */
   SET_INPUT_PROP,   /**< Update input tensor info and layout */
   SET_OUTPUT_PROP,  /**< Update output tensor info and layout */
   SET_ACCELERATOR,  /**< Update accelerator of the subplugin to be used as backend */
   CHECK_HW_AVAILABILITY, /**< Check the hw availability with custom option */
+  GET_PROFILE,      /**< Get the per-op profile aggregated over the stream */
+  GET_MODEL_CACHE,  /**< Get the status of the compiled model cache after opening the model */
+  GET_DEVICE_MEMORY, /**< Get the device memory supported by the framework, to keep the tensors in the device memory between the filters */
+  SET_DEVICE_MEMORY, /**< Set the memory of the tensors (device or host memory) of the next invoke */
 } event_ops;
 
 /**
@@ -258,11 +270,43 @@ typedef struct _GstTensorFilterFrameworkEventData
       accl_hw hw; /**< accelerator to check availability */
       const char *custom; /**< custom option for hardware detection */
     };
+
+    /** for GET_PROFILE */
+    struct {
+      void *instance; /**< The private data of the framework instance (V0 handleEvent does not have the private data) */
+      char *profile;  /**< Newly allocated text of the per-op profile (subplugin specific), tensor_filter frees it with g_free() */
+    };
+
+    /** for GET_MODEL_CACHE */
+    struct {
+      void *cache_instance; /**< The private data of the framework instance (V0 handleEvent does not have the private data) */
+      int cache_hit;        /**< 1 if the compiled model is loaded from the cache, 0 if the model is compiled (and stored in the cache). tensor_filter sets -1 before the call, unchanged means the cache is not used */
+      int64_t compile_time; /**< The time to compile or to load the compiled model (usec) */
+    };
+
+    /** for GET_DEVICE_MEMORY and SET_DEVICE_MEMORY */
+    struct {
+      void *device_instance; /**< The private data of the framework instance (V0 handleEvent does not have the private data) */
+      const GstTensorDeviceOps *device_ops; /**< GET: The operations of the device memory of the framework. tensor_filter sets NULL before the call, unchanged means the device memory is not supported */
+      int device_input;  /**< GET: 1 if the input tensors in the device memory are accepted. SET: 1 if the data of the input tensors of the next invoke is the device memory */
+      int device_output; /**< GET: 1 if the output tensors can be kept in the device memory (allocate_in_invoke is required). SET: 1 if the output tensors of the next invoke should be allocated in the device memory */
+      int dmabuf_input; /**< GET: 1 if the input tensors in DMA-BUF are imported (device_ops may be NULL). SET: 1 if the input tensors of the next invoke are given in dmabuf, then the data of the input tensors is NULL */
+      const GstTensorDmaBuf *dmabuf; /**< SET: The DMA-BUF of the input tensors of the next invoke, in the order of the input tensors (NULL if dmabuf_input is 0). Valid until the invoke returns */
+    };
   };
 } GstTensorFilterFrameworkEventData;
 
 typedef struct _GstTensorFilterFramework GstTensorFilterFramework;
 
+struct _GstMemory;
+
+/**
+ * @brief The callback to complete the invoke with the memory of the tensors (invoke_memory of V2).
+ * @param[in] handle The handle given to invoke_memory.
+ * @param[in] ret 0 if OK (the output memory is set). < 0 if error. > 0 to drop the frame.
+ */
+typedef void (*GstTensorFilterInvokeDone) (void *handle, int ret);
+
 /**
  * @brief Tensor_Filter Subplugin definition
  *
@@ -275,7 +319,7 @@ struct _GstTensorFilterFramework
   uint64_t version;
   /**< Version of the struct
    * | 32bit (validity check) | 16bit (API version) | 16bit (Subplugin's internal version. Tensor_filter does not care) |
-   * API version will be 0x0 (earlier version (_GstTensorFilterFramework_v0)) or 0x1 (newer version (_GstTensorFilterFramework_v1))
+   * API version will be 0x0 (earlier version (_GstTensorFilterFramework_v0)), 0x1 (newer version (_GstTensorFilterFramework_v1)) or 0x2 (_GstTensorFilterFramework_v1 with invoke_memory)
    */
 
   int (*open) (const GstTensorFilterProperties * prop, void **private_data);
@@ -385,6 +429,10 @@ struct _GstTensorFilterFramework
       int (*handleEvent) (event_ops ops, GstTensorFilterFrameworkEventData * data);
       /**< Optional. Runs the event corresponding to the passed operation.
        * If ops == CHECK_HW_AVAILABILITY: tensor_filter will call to check the hw availability with custom option.
+       * If ops == GET_PROFILE: tensor_filter will call to get the per-op profile of the instance (data->instance) and post it with the bus message 'tensor-filter-profile'. The invoke of the instance is not running while this is called.
+       * If ops == GET_MODEL_CACHE: tensor_filter will call to get the status of the compiled model cache of the instance (data->cache_instance) when the element starts, and post it with the bus message 'tensor-filter-model-cache'. Return -ENOENT if the cache is not used.
+       * If ops == GET_DEVICE_MEMORY: tensor_filter will call to get the device memory supported by the instance (data->device_instance) when the element starts.
+       * If ops == SET_DEVICE_MEMORY: tensor_filter will call before each invoke of the instance (data->device_instance) if the device memory or DMA-BUF import is supported. The setting is applied to the next invoke only. The device output is released with DESTROY_NOTIFY.
        * List of operations to be supported are optional.
        *
        * @param[in] ops operation to be performed
@@ -476,6 +524,10 @@ struct _GstTensorFilterFramework
        * If ops == SET_INPUT_PROP: tensor_filter will call to update the property of the subplugin. This function will take tensor info and layout as the argument. This operation can update input tensor shape, type, name and layout.
        * If ops == SET_OUTPUT_PROP: tensor_filter will call to update the property of the subplugin. This function will take tensor info and layout as the argument. This operation can update output tensor shape, type, name and layout.
        * If ops == SET_ACCELERATOR: tensor_filter will call to update the property of the subplugin. This function will take accelerator list as the argument. This operation will update the backend to be used by the corresponding subplugin.
+       * If ops == GET_PROFILE: tensor_filter will call to get the per-op profile of the instance and post it with the bus message 'tensor-filter-profile'. The invoke of the instance is not running while this is called.
+       * If ops == GET_MODEL_CACHE: tensor_filter will call to get the status of the compiled model cache when the element starts, and post it with the bus message 'tensor-filter-model-cache'. Return -ENOENT if the cache is not used.
+       * If ops == GET_DEVICE_MEMORY: tensor_filter will call to get the device memory supported by the framework when the element starts.
+       * If ops == SET_DEVICE_MEMORY: tensor_filter will call before each invoke if the device memory or DMA-BUF import is supported. The setting is applied to the next invoke only. The device output is released with DESTROY_NOTIFY.
        * List of operations to be supported are optional.
        * Note: In these operations, the argument 'prop' will not contain the updated information, but will be updated after the corresponding operation is succeeded.
        *
@@ -486,6 +538,25 @@ struct _GstTensorFilterFramework
        * @return 0 if OK. non-zero if error. -ENOENT if operation is not supported. -EINVAL if operation is supported but provided arguments are invalid.
        */
       void *subplugin_data; /**< This is used by tensor_filter infrastructure. Subplugin authors should NEVER update this. Only the files in /gst/nnstreamer/tensor_filter/ are allowed to access this. */
+
+      int (*invoke_memory) (const GstTensorFilterFramework * self,
+          const GstTensorFilterProperties * prop, void *private_data,
+          struct _GstMemory ** input, unsigned int num_input,
+          struct _GstMemory ** output, unsigned int num_output,
+          GstTensorFilterInvokeDone done, void *handle);
+      /**< Optional, V2 (GST_TENSOR_FILTER_FRAMEWORK_V2) only. Invoke the given network model with the GstMemory of the tensors, without mapping the memory in tensor_filter. With this, the framework may import the memory (e.g., the fd of DMA-BUF or the device memory) or keep the reference of the input memory for the asynchronous invoke.
+       * tensor_filter calls invoke_memory instead of invoke if the input and output tensors are not flexible. Otherwise (and with the single-shot API), invoke is called. Thus, invoke is still mandatory in V2.
+       *
+       * @param[in] prop read-only property values
+       * @param[in/out] private_data A subplugin may save its internal private data here. The subplugin is responsible for alloc/free of this pointer.
+       * @param[in] input The GstMemory of the input tensors (transfer none). Call gst_memory_ref() to keep it after the invoke is done.
+       * @param[in] num_input The number of the input tensors.
+       * @param[out] output The GstMemory of the output tensors to be set by the subplugin (transfer full). The size of each memory should be same with the output tensor.
+       * @param[in] num_output The number of the output tensors.
+       * @param[in] done The callback to complete the invoke, if the subplugin returns -EINPROGRESS.
+       * @param[in] handle The handle to be given to the callback.
+       * @return 0 if OK. -EINPROGRESS if the invoke is running, then the subplugin should call done (handle, ret) after setting the output memory (may be called in any thread). < 0 if error. > 0 to drop the frame.
+       */
     }
 #ifdef NO_ANONYMOUS_NESTED_STRUCT
         v1
@@ -615,6 +686,86 @@ extern void
 nnstreamer_filter_shared_model_replace (void *instance, const char *key,
     void *new_interpreter, void (*replace_callback) (void *, void *), void (*free_callback) (void*));
 
+/**
+ * @brief The pool of the output memory for the sub-plugins allocating the outputs in invoke (allocate_in_invoke).
+ *        The sub-plugin gets the output memory from the pool in invoke and returns it in DESTROY_NOTIFY, then the memory is reused for the next frames.
+ */
+typedef struct _GstTensorFilterOutputPool GstTensorFilterOutputPool;
+
+/**
+ * @brief Create the output pool of a sub-plugin.
+ * @param[in] max_cached The max number of the released memory chunks kept for reuse.
+ * @return The output pool. Free it with gst_tensor_filter_output_pool_free() when the sub-plugin is closed.
+ */
+extern GstTensorFilterOutputPool *
+gst_tensor_filter_output_pool_new (unsigned int max_cached);
+
+/**
+ * @brief Get the output memory from the pool. The released memory of the same size is reused, or new memory is allocated.
+ * @param[in] pool The output pool.
+ * @param[in] size The size of the output memory.
+ * @return The output memory. Return it with gst_tensor_filter_output_pool_release().
+ */
+extern void *
+gst_tensor_filter_output_pool_alloc (GstTensorFilterOutputPool * pool, size_t size);
+
+/**
+ * @brief Return the output memory to the pool, to be called in DESTROY_NOTIFY.
+ * @param[in] pool The output pool.
+ * @param[in] data The output memory to be released.
+ * @return 0 if the memory is from the pool. -ENOENT if the memory is not from the pool, then the sub-plugin should free it.
+ */
+extern int
+gst_tensor_filter_output_pool_release (GstTensorFilterOutputPool * pool, void *data);
+
+/**
+ * @brief Free the output pool. The memory not returned yet is freed when it is released.
+ * @param[in] pool The output pool.
+ */
+extern void
+gst_tensor_filter_output_pool_free (GstTensorFilterOutputPool * pool);
+
+/**
+ * @brief The read-only memory map of a model file, shared by the processes and the filters loading the same file.
+ *        The sub-plugin which reads the model file by itself maps it instead of copying it into its heap, so that the weights are kept once in the page cache.
+ */
+typedef struct _GstTensorFilterModelMap GstTensorFilterModelMap;
+
+/**
+ * @brief The flags to open the model map.
+ */
+typedef enum
+{
+  GST_TENSOR_FILTER_MODEL_MAP_DEFAULT = 0, /**< the pages are loaded on demand */
+  GST_TENSOR_FILTER_MODEL_MAP_POPULATE = (1 << 0), /**< populate the page tables when the file is mapped (MAP_POPULATE) */
+  GST_TENSOR_FILTER_MODEL_MAP_PRELOAD = (1 << 1), /**< read ahead the whole file after it is mapped (MADV_WILLNEED) */
+} GstTensorFilterModelMapFlags;
+
+/**
+ * @brief Open the read-only memory map of a model file. The filters opening the same file in a process share the map.
+ * @param[in] path The path of the model file.
+ * @param[in] flags The bitwise OR of GstTensorFilterModelMapFlags, used when the file is mapped first.
+ * @return The model map, or NULL if the file cannot be mapped. Close it with gst_tensor_filter_model_map_close().
+ */
+extern GstTensorFilterModelMap *
+gst_tensor_filter_model_map_open (const char *path, unsigned int flags);
+
+/**
+ * @brief Get the contents of the model map.
+ * @param[in] map The model map.
+ * @param[out] size The size of the model file.
+ * @return The read-only contents of the model file, valid until the map is closed.
+ */
+extern const void *
+gst_tensor_filter_model_map_get_data (GstTensorFilterModelMap * map, size_t *size);
+
+/**
+ * @brief Close the model map. The file is unmapped when the last user closes it.
+ * @param[in] map The model map.
+ */
+extern void
+gst_tensor_filter_model_map_close (GstTensorFilterModelMap * map);
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,6 +18,7 @@
 
 #define GST_TENSOR_TRAINER_FRAMEWORK_BASE (0xDEAFDEAD00000000ULL)
 #define GST_TENSOR_TRAINER_FRAMEWORK_V1 (GST_TENSOR_TRAINER_FRAMEWORK_BASE | 0x10000ULL)
+#define GST_TENSOR_TRAINER_FRAMEWORK_V2 (GST_TENSOR_TRAINER_FRAMEWORK_BASE | 0x20000ULL)
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,6 +41,7 @@ typedef struct _GstTensorTrainerProperties
   int64_t num_epochs;    /**< The number of repetition of total training and validation sample. subplugin must receive total samples((num_training_samples + num_validation_samples) * num_epochs) */
 
   GCond *training_complete_cond;    /**< Tensor trainer wait when receive EOS before model training is complete, subplugin should send signal when model training is complete. */
+  void *metrics_handle;    /**< Handle of tensor_trainer to collect the training metrics. Subplugin should not touch this, pass the properties to nnstreamer_trainer_notify_step() and nnstreamer_trainer_notify_epoch(). */
 } GstTensorTrainerProperties;
 
 /**
@@ -116,6 +118,19 @@ struct _GstTensorTrainerFramework
    * @note CAUTION: private_data can be NULL if the framework is not yet opened by the caller.
    */
 
+  int (*snapshot) (const GstTensorTrainerFramework * self,
+      const GstTensorTrainerProperties * prop, void *private_data,
+      void **data, size_t *size);
+  /**< Optional (GST_TENSOR_TRAINER_FRAMEWORK_V2). tensor_trainer calls this to take a checkpoint of the model being trained (checkpoint-epochs or checkpoint-samples).
+   * @param[in] prop read-only property values
+   * @param[in] private_data A subplugin may save its internal private data here.
+   * @param[out] data The copy of the current weights in the format the framework loads, allocated with g_malloc(). tensor_trainer writes it to the checkpoint file in a background thread and frees it.
+   * @param[out] size The size of data.
+   * @return 0 if OK. non-zero if error.
+   *
+   * @note This is called while the model is being trained (in the thread calling nnstreamer_trainer_notify_epoch() or after push_data). Copy the weights consistently and return quickly, the training continues while the checkpoint is written.
+   */
+
   /* Need to make (*eventHandler)*/
 
 };
@@ -140,6 +155,29 @@ nnstreamer_trainer_probe (GstTensorTrainerFramework * ttsp);
 extern int
 nnstreamer_trainer_exit (GstTensorTrainerFramework * ttsp);
 
+/**
+ * @brief Trainer's sub-plugin may call this when a training step is done, tensor_trainer collects the step latency and throughput.
+ * @param[in] prop the properties given by tensor_trainer.
+ * @param[in] num_samples The number of samples trained in the step (batch size).
+ * @param[in] step_time The elapsed time of the step in microseconds.
+ *
+ * @note If the sub-plugin does not report the steps, tensor_trainer measures the latency of push_data() instead.
+ */
+extern void
+nnstreamer_trainer_notify_step (const GstTensorTrainerProperties * prop,
+    int64_t num_samples, int64_t step_time);
+
+/**
+ * @brief Trainer's sub-plugin may call this when an epoch is complete, tensor_trainer posts the metrics of the epoch.
+ * @param[in] prop the properties given by tensor_trainer.
+ * @param[in] epoch_cnt The number of currently completed epochs.
+ *
+ * @note tensor_trainer also checks epoch_cnt of GstTensorTrainerFrameworkInfo after pushing each sample, so the epoch duration is available without this call.
+ */
+extern void
+nnstreamer_trainer_notify_epoch (const GstTensorTrainerProperties * prop,
+    int64_t epoch_cnt);
+
 #ifdef __cplusplus
 }
 #endif
@@ -385,6 +385,14 @@ gst_tensor_meta_info_init (GstTensorMetaInfo * meta);
 extern void
 gst_tensor_meta_info_get_version (GstTensorMetaInfo * meta, guint * major, guint * minor);
 
+/**
+ * @brief Set the tensor meta to use the compact header.
+ * @param[in,out] meta tensor meta structure
+ * @note The compact header (version 2) stores the used rank only with variable-length integers, so its size depends on the meta. Get the header size again whenever the meta is changed.
+ */
+extern void
+gst_tensor_meta_info_set_compact (GstTensorMetaInfo * meta);
+
 /**
  * @brief Check the meta info is valid.
  * @param[in] meta tensor meta structure
@@ -428,6 +436,34 @@ gst_tensor_meta_info_update_header (GstTensorMetaInfo * meta, gpointer header);
 extern gboolean
 gst_tensor_meta_info_parse_header (GstTensorMetaInfo * meta, gpointer header);
 
+/**
+ * @brief The max size of the header of flexible tensor.
+ */
+#define NNS_TENSOR_META_HEADER_SIZE_LIMIT (128)
+
+/**
+ * @brief Data structure to cache the layout of flexible tensor.
+ * Consecutive buffers of a stream usually have same shape; if the header is same with the cached one, the meta is reused without parsing and validating it again.
+ * Initialize it with zero (e.g., memset or g_new0) before use.
+ */
+typedef struct
+{
+  gsize header_size; /**< the size of cached header, 0 if not cached */
+  guint8 header[NNS_TENSOR_META_HEADER_SIZE_LIMIT]; /**< the cached header */
+  GstTensorMetaInfo meta; /**< the meta parsed from cached header */
+} GstTensorMetaCache;
+
+/**
+ * @brief Parse the header of flexible tensor with the cached layout.
+ * @param[in,out] cache the cached layout, updated if the header is changed
+ * @param[in] data pointer to flexible tensor (header and tensor data)
+ * @param[in] size the size of @a data
+ * @param[out] meta tensor meta structure to be filled
+ * @return The header size, 0 if failed to parse the header.
+ */
+extern gsize
+gst_tensor_meta_cache_parse (GstTensorMetaCache * cache, gconstpointer data, gsize size, GstTensorMetaInfo * meta);
+
 /**
  * @brief Convert GstTensorMetaInfo structure to GstTensorInfo.
  * @param[in] meta tensor meta structure to be converted
@@ -0,0 +1,112 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	tensor_filter_custom_easy_ops.h
+ * @date	14 Oct 2026
+ * @brief	Common post-processing kernels for custom-easy tensor functions
+ * @see		http://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ *
+ * The functions are optimized with NEON or SSE2 if available, and may be
+ * called in NNS_custom_invoke of the custom-easy (or custom) filter.
+ * The tensor data is given with GstTensorMemory, and the number of elements
+ * is calculated from the size of the memory.
+ * Unless noted, the float tensors are float32, and the input and output
+ * may be the same memory for the element-wise functions.
+ * The functions return 0 if success, -EINVAL with invalid parameters.
+ *
+ * To Packagers:
+ *
+ * This file is to be packaged as "devel" package for NN developers.
+ */
+#ifndef __NNS_TENSOR_FILTER_CUSTOM_EASY_OPS_H__
+#define __NNS_TENSOR_FILTER_CUSTOM_EASY_OPS_H__
+
+#include <stdint.h>
+#include "tensor_typedef.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @brief Get the index of the largest element.
+ * @param[in] in Input tensor.
+ * @param[in] type The type of the input tensor (float32, float64 or integer types).
+ * @param[out] index The index of the first largest element.
+ */
+extern int NNS_custom_easy_argmax (const GstTensorMemory * in,
+    tensor_type type, uint32_t * index);
+
+/**
+ * @brief Get the k largest elements in descending order.
+ * @param[in] in Input tensor.
+ * @param[in] type The type of the input tensor (float32, float64 or integer types).
+ * @param[in] k The number of elements to get. If the tensor has less elements, the remainders are not filled.
+ * @param[out] indices The indices of the elements (k entries).
+ * @param[out] scores The values of the elements (k entries, may be NULL).
+ * @return The number of elements filled, or -EINVAL with invalid parameters.
+ */
+extern int NNS_custom_easy_topk (const GstTensorMemory * in,
+    tensor_type type, uint32_t k, uint32_t * indices, float *scores);
+
+/**
+ * @brief Softmax of float32 tensor.
+ * @param[in] in Input tensor.
+ * @param[out] out Output tensor, the size should be same with the input.
+ * @param[in] num_classes The number of elements in a row. Softmax is computed for each row. 0 to use the whole tensor as a row.
+ */
+extern int NNS_custom_easy_softmax (const GstTensorMemory * in,
+    GstTensorMemory * out, uint32_t num_classes);
+
+/**
+ * @brief Sigmoid of float32 tensor.
+ * @param[in] in Input tensor.
+ * @param[out] out Output tensor, the size should be same with the input.
+ */
+extern int NNS_custom_easy_sigmoid (const GstTensorMemory * in,
+    GstTensorMemory * out);
+
+/**
+ * @brief Dequantize uint8 or int8 tensor to float32, out = (in - zero_point) * scale.
+ * @param[in] in Input tensor.
+ * @param[in] type The type of the input tensor (uint8 or int8).
+ * @param[in] scale The quantization scale.
+ * @param[in] zero_point The quantization zero point.
+ * @param[out] out Output tensor, the size should be 4 times of the input.
+ */
+extern int NNS_custom_easy_dequantize (const GstTensorMemory * in,
+    tensor_type type, float scale, int32_t zero_point, GstTensorMemory * out);
+
+/**
+ * @brief Decode the box deltas with the anchors (SSD box coder).
+ * @param[in] deltas Box deltas, float32 [num_boxes][4] of (y-center, x-center, height, width).
+ * @param[in] anchors Anchors, float32 [num_boxes][4] of (y-center, x-center, height, width).
+ * @param[in] scales The scales of the deltas (y, x, height, width), e.g., (10, 10, 5, 5).
+ * @param[out] out Decoded boxes, float32 [num_boxes][4] of (ymin, xmin, ymax, xmax).
+ * @note The number of boxes is calculated from the size of deltas. The output may be same with the deltas.
+ */
+extern int NNS_custom_easy_box_decode (const GstTensorMemory * deltas,
+    const GstTensorMemory * anchors, const float scales[4],
+    GstTensorMemory * out);
+
+/**
+ * @brief Greedy non-maximum suppression.
+ * @param[in] boxes float32 [num_boxes][4] of (ymin, xmin, ymax, xmax).
+ * @param[in] scores float32 [num_boxes] of the scores of the boxes.
+ * @param[in] iou_threshold The box is suppressed if IoU with the selected box is larger than this.
+ * @param[in] score_threshold The box is ignored if its score is lower than this.
+ * @param[in] max_output The maximum number of boxes to select.
+ * @param[out] selected The indices of the selected boxes in descending order of the scores (max_output entries).
+ * @return The number of selected boxes, or -EINVAL with invalid parameters.
+ */
+extern int NNS_custom_easy_nms (const GstTensorMemory * boxes,
+    const GstTensorMemory * scores, float iou_threshold, float score_threshold,
+    uint32_t max_output, uint32_t * selected);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /*__NNS_TENSOR_FILTER_CUSTOM_EASY_OPS_H__*/
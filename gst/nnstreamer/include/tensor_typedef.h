@@ -142,7 +142,7 @@ typedef enum _nns_tensor_type
   _NNS_FLOAT32,
   _NNS_INT64,
   _NNS_UINT64,
-  _NNS_FLOAT16, /**< added with nnstreamer 2.1.1-devel. If you add any operators (e.g., tensor_transform) to float16, it will either be not supported or be too inefficient. */
+  _NNS_FLOAT16, /**< added with nnstreamer 2.1.1-devel. Requires FLOAT16_SUPPORT (-Denable-float16=true). tensor_transform supports float16 for typecast, arithmetic, clamp and stand with the typed loops using the hardware fp16 conversion. */
 
   _NNS_END,
 } tensor_type;
@@ -225,6 +225,37 @@ typedef struct
   size_t size; /**< The size of tensor. */
 } GstTensorMemory;
 
+/**
+ * @brief The memory holding the tensor data.
+ */
+typedef enum
+{
+  NNS_TENSOR_MEMORY_HOST = 0, /**< System (host) memory */
+  NNS_TENSOR_MEMORY_CUDA,     /**< CUDA device memory (the data is the device pointer) */
+  NNS_TENSOR_MEMORY_OPENCL,   /**< OpenCL buffer (the data is cl_mem) */
+} tensor_memory_type;
+
+/**
+ * @brief Operations of the device memory, given by the framework allocating the device memory.
+ * @details The tensors in the device memory are passed between the filters of the same device without the copy to host memory. The other elements read them in host memory, then the tensor is downloaded once.
+ */
+typedef struct
+{
+  tensor_memory_type type; /**< The type of the device memory */
+  int (*download) (void *device_data, void *host_data, size_t size); /**< Copy the device memory to host memory. Return 0 if OK. */
+  int (*upload) (void *device_data, const void *host_data, size_t size); /**< Copy host memory to the device memory. Return 0 if OK. */
+} GstTensorDeviceOps;
+
+/**
+ * @brief The DMA-BUF of the input tensor, imported by the framework without mapping it in host memory.
+ */
+typedef struct
+{
+  int fd;        /**< The file descriptor of the DMA-BUF */
+  size_t offset; /**< The offset of the tensor in the DMA-BUF */
+  size_t size;   /**< The size of the tensor */
+} GstTensorDmaBuf;
+
 /**
  * @brief Internal data structure for tensor info.
  * @note This must be coherent with api/capi/include/nnstreamer-capi-private.h:ml_tensor_info_s
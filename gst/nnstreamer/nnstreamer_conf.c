@@ -25,6 +25,7 @@
 
 #include <string.h>
 #include <glib.h>
+#include <glib/gstdio.h>
 
 #include "nnstreamer_log.h"
 #include "nnstreamer_conf.h"
@@ -103,6 +104,10 @@ typedef struct
   gchar *conffile;            /**< Location of conf file. */
   gchar *extra_conffile;      /**< Location of extra configuration file. */
 
+  gchar *registry_file;       /**< Location of the registry cache, NULL if disabled. */
+  GKeyFile *registry;         /**< The registry cache (sub-plugin files and names). */
+  gboolean registry_dirty;    /**< TRUE if the registry cache should be saved. */
+
   subplugin_conf conf[NNSCONF_PATH_END];
 } confdata;
 
@@ -222,6 +227,147 @@ _get_filenames (nnsconf_type_path type, const gchar * dir, GSList ** listF,
   return TRUE;
 }
 
+/**
+ * @brief Private function to get the modified time of a file or directory.
+ * @return The modified time in seconds, -1 if failed.
+ */
+static gint64
+_get_mtime (const gchar * path)
+{
+  GStatBuf st;
+
+  if (g_stat (path, &st) != 0)
+    return -1;
+
+  return (gint64) st.st_mtime;
+}
+
+/**
+ * @brief Private function to load the registry cache.
+ */
+static void
+_registry_load (void)
+{
+  if (!conf.registry_file)
+    return;
+
+  conf.registry = g_key_file_new ();
+  g_assert (conf.registry != NULL); /** Internal lib error? out-of-memory? */
+
+  /* It's ok even if we cannot load it, the cache will be created. */
+  g_key_file_load_from_file (conf.registry, conf.registry_file,
+      G_KEY_FILE_NONE, NULL);
+  conf.registry_dirty = FALSE;
+}
+
+/**
+ * @brief Private function to save the registry cache if it is updated.
+ */
+static void
+_registry_save (void)
+{
+  GError *err = NULL;
+  gchar *dir;
+
+  if (!conf.registry || !conf.registry_dirty)
+    return;
+
+  dir = g_path_get_dirname (conf.registry_file);
+  g_mkdir_with_parents (dir, 0755);
+  g_free (dir);
+
+  if (!g_key_file_save_to_file (conf.registry, conf.registry_file, &err)) {
+    ml_logw ("Failed to save the registry cache '%s': %s", conf.registry_file,
+        err ? err->message : "unknown reason");
+    g_clear_error (&err);
+  }
+
+  conf.registry_dirty = FALSE;
+}
+
+/**
+ * @brief Private function to fill in ".so/.dylib list" with the registry cache.
+ * @details The list of a directory is cached with the modified time of the directory.
+ *          If the directory is modified (a file is added or removed), or if it may be
+ *          modified at the same time (in seconds) with the scan, it is scanned again.
+ * @return True if successfully updated.
+ */
+static gboolean
+_get_filenames_cached (nnsconf_type_path type, const gchar * dir,
+    GSList ** listF, GSList ** listN, guint * counter)
+{
+  GSList *lstF = NULL, *lstN = NULL, *l;
+  gchar **files = NULL, **names = NULL;
+  gchar *group;
+  gint64 mtime, scanned;
+  guint i, cnt = 0;
+  gboolean ret = TRUE;
+
+  if (!conf.registry)
+    return _get_filenames (type, dir, listF, listN, counter);
+
+  mtime = _get_mtime (dir);
+  if (mtime < 0)
+    return FALSE;
+
+  group = g_strdup_printf ("dir:%d:%s", type, dir);
+
+  if (g_key_file_get_int64 (conf.registry, group, "mtime", NULL) == mtime &&
+      g_key_file_get_int64 (conf.registry, group, "scanned", NULL) > mtime &&
+      g_key_file_get_boolean (conf.registry, group, "symlink",
+          NULL) == conf.enable_symlink) {
+    files = g_key_file_get_string_list (conf.registry, group, "files", NULL,
+        NULL);
+    names = g_key_file_get_string_list (conf.registry, group, "names", NULL,
+        NULL);
+  }
+
+  if (files && names && g_strv_length (files) == g_strv_length (names)) {
+    for (i = 0; files[i]; i++) {
+      *listF = g_slist_prepend (*listF, g_strdup (files[i]));
+      *listN = g_slist_prepend (*listN, g_strdup (names[i]));
+    }
+    *counter = *counter + i;
+    goto done;
+  }
+
+  /* scan the directory and update the cache */
+  scanned = g_get_real_time () / G_USEC_PER_SEC;
+  ret = _get_filenames (type, dir, &lstF, &lstN, &cnt);
+  if (ret) {
+    g_strfreev (files);
+    g_strfreev (names);
+
+    /* the lists are in reversed order */
+    files = g_new0 (gchar *, cnt + 1);
+    names = g_new0 (gchar *, cnt + 1);
+    for (l = lstF, i = cnt; l; l = l->next)
+      files[--i] = g_strdup (l->data);
+    for (l = lstN, i = cnt; l; l = l->next)
+      names[--i] = g_strdup (l->data);
+
+    g_key_file_set_int64 (conf.registry, group, "mtime", mtime);
+    g_key_file_set_int64 (conf.registry, group, "scanned", scanned);
+    g_key_file_set_boolean (conf.registry, group, "symlink",
+        conf.enable_symlink);
+    g_key_file_set_string_list (conf.registry, group, "files",
+        (const gchar * const *) files, cnt);
+    g_key_file_set_string_list (conf.registry, group, "names",
+        (const gchar * const *) names, cnt);
+    conf.registry_dirty = TRUE;
+
+    *listF = g_slist_concat (lstF, *listF);
+    *listN = g_slist_concat (lstN, *listN);
+    *counter = *counter + cnt;
+  }
+
+done:
+  g_strfreev (files);
+  g_strfreev (names);
+  g_free (group);
+  return ret;
+}
+
 /**
  * @brief Private function to get sub-plugins list with type.
  */
@@ -294,7 +440,7 @@ _fill_in_vstr (gchar *** fullpath_vstr, gchar *** name_vstr,
         }
       }
       if (j == CONF_SOURCE_END)
-        _get_filenames (type, searchpath[i], &lstF, &lstN, &counter);
+        _get_filenames_cached (type, searchpath[i], &lstF, &lstN, &counter);
     }
   }
 
@@ -355,6 +501,13 @@ nnsconf_loadconf (gboolean force_reload)
     g_free (conf.extra_conffile);
     conf.extra_conffile = NULL;
 
+    _registry_save ();
+    if (conf.registry)
+      g_key_file_free (conf.registry);
+    conf.registry = NULL;
+    g_free (conf.registry_file);
+    conf.registry_file = NULL;
+
     for (t = 0; t < NNSCONF_PATH_END; t++) {
 
       for (i = 0; i < CONF_SOURCE_END; i++) {
@@ -426,6 +579,9 @@ nnsconf_loadconf (gboolean force_reload)
       conf.extra_conffile =
           g_key_file_get_string (key_file, "common", "extra_config_path", NULL);
 
+      conf.registry_file =
+          g_key_file_get_string (key_file, "common", "registry_cache", NULL);
+
       _fill_subplugin_path (&conf, key_file, CONF_SOURCE_INI);
     }
 
@@ -457,6 +613,20 @@ nnsconf_loadconf (gboolean force_reload)
     ml_logw ("Failed to load the configuration, no config file found.");
   }
 
+  /* The registry cache from env variable has a higher priority. */
+  if (conf.enable_envvar && g_getenv (NNSTREAMER_ENVVAR_REGISTRY)) {
+    g_free (conf.registry_file);
+    conf.registry_file = _strdup_getenv (NNSTREAMER_ENVVAR_REGISTRY);
+  }
+
+  /* An empty path disables the registry cache. */
+  if (conf.registry_file && conf.registry_file[0] == '\0') {
+    g_free (conf.registry_file);
+    conf.registry_file = NULL;
+  }
+
+  _registry_load ();
+
   for (t = 0; t < NNSCONF_PATH_END; t++) {
     if (t == NNSCONF_PATH_EASY_CUSTOM_FILTERS)
       continue;                 /* It does not have its own configuration */
@@ -474,6 +644,8 @@ nnsconf_loadconf (gboolean force_reload)
         conf.conf[t].path, t);
   }
 
+  _registry_save ();
+
   conf.loaded = TRUE;
   return TRUE;
 }
@@ -543,6 +715,126 @@ nnsconf_get_subplugin_info (nnsconf_type_path type, subplugin_info_s * info)
   return g_strv_length (vstr);
 }
 
+/**
+ * @brief Public function to get the file of the sub-plugin from the registry cache.
+ * @return Newly allocated full path (Caller should free it), or NULL if it is not cached.
+ */
+gchar *
+nnsconf_registry_get_subplugin_path (nnsconf_type_path type,
+    const gchar * name)
+{
+  subplugin_info_s info;
+  gchar *group, *path;
+
+  g_return_val_if_fail (name != NULL, NULL);
+
+  nnsconf_loadconf (FALSE);
+
+  if (!conf.registry)
+    return NULL;
+
+  group = g_strdup_printf ("subplugin:%d", type);
+  path = g_key_file_get_string (conf.registry, group, name, NULL);
+  g_free (group);
+
+  /* The file should be in the current list of sub-plugins. */
+  if (path && (nnsconf_get_subplugin_info (type, &info) == 0 ||
+          !g_strv_contains ((const gchar * const *) info.paths, path))) {
+    g_free (path);
+    path = NULL;
+  }
+
+  return path;
+}
+
+/**
+ * @brief Public function to record the file of the sub-plugin in the registry cache.
+ */
+void
+nnsconf_registry_set_subplugin_path (nnsconf_type_path type,
+    const gchar * name, const gchar * fullpath)
+{
+  gchar *group, *path;
+
+  g_return_if_fail (name != NULL);
+  g_return_if_fail (fullpath != NULL);
+
+  nnsconf_loadconf (FALSE);
+
+  if (!conf.registry)
+    return;
+
+  group = g_strdup_printf ("subplugin:%d", type);
+  path = g_key_file_get_string (conf.registry, group, name, NULL);
+
+  if (g_strcmp0 (path, fullpath) != 0) {
+    g_key_file_set_string (conf.registry, group, name, fullpath);
+    conf.registry_dirty = TRUE;
+    _registry_save ();
+  }
+
+  g_free (path);
+  g_free (group);
+}
+
+/**
+ * @brief Public function to check the sub-plugin file failed to be loaded.
+ * @return TRUE if the file is not modified after it failed to be loaded.
+ */
+gboolean
+nnsconf_registry_is_broken (nnsconf_type_path type, const gchar * fullpath)
+{
+  gchar *group;
+  gint64 mtime;
+  gboolean broken = FALSE;
+
+  g_return_val_if_fail (fullpath != NULL, FALSE);
+
+  nnsconf_loadconf (FALSE);
+
+  if (!conf.registry)
+    return FALSE;
+
+  group = g_strdup_printf ("broken:%d", type);
+  if (g_key_file_has_key (conf.registry, group, fullpath, NULL)) {
+    mtime = g_key_file_get_int64 (conf.registry, group, fullpath, NULL);
+    broken = (mtime == _get_mtime (fullpath));
+  }
+  g_free (group);
+
+  return broken;
+}
+
+/**
+ * @brief Public function to record the sub-plugin file failed to be loaded (or loaded successfully).
+ */
+void
+nnsconf_registry_set_broken (nnsconf_type_path type, const gchar * fullpath,
+    gboolean broken)
+{
+  gchar *group;
+
+  g_return_if_fail (fullpath != NULL);
+
+  nnsconf_loadconf (FALSE);
+
+  if (!conf.registry)
+    return;
+
+  group = g_strdup_printf ("broken:%d", type);
+  if (broken) {
+    g_key_file_set_int64 (conf.registry, group, fullpath,
+        _get_mtime (fullpath));
+    conf.registry_dirty = TRUE;
+  } else if (g_key_file_has_key (conf.registry, group, fullpath, NULL)) {
+    g_key_file_remove_key (conf.registry, group, fullpath, NULL);
+    conf.registry_dirty = TRUE;
+  }
+  g_free (group);
+
+  _registry_save ();
+}
+
 /**
  * @brief Internal cache for the custom key-values
  */
@@ -59,6 +59,7 @@ G_BEGIN_DECLS
 #define NNSTREAMER_CONF_FILE NNSTREAMER_DEFAULT_CONF_FILE
 #endif
 #define NNSTREAMER_ENVVAR_CONF_FILE     "NNSTREAMER_CONF"
+#define NNSTREAMER_ENVVAR_REGISTRY      "NNSTREAMER_REGISTRY"
 
 typedef enum {
   NNSCONF_PATH_FILTERS = 0,
@@ -125,6 +126,43 @@ nnsconf_get_subplugin_name_prefix (nnsconf_type_path type);
 extern guint
 nnsconf_get_subplugin_info (nnsconf_type_path type, subplugin_info_s * info);
 
+/**
+ * @brief Get the file of the sub-plugin from the registry cache.
+ * @param[in] type The type (FILTERS/DECODERS/CUSTOM_FILTERS/CONVERTERS)
+ * @param[in] name The name of sub-plugin registered by the file.
+ * @return Newly allocated full path (Caller should free it), or NULL if the registry cache is disabled or the file is not available.
+ */
+extern gchar *
+nnsconf_registry_get_subplugin_path (nnsconf_type_path type, const gchar * name);
+
+/**
+ * @brief Record the file of the sub-plugin in the registry cache.
+ * @param[in] type The type (FILTERS/DECODERS/CUSTOM_FILTERS/CONVERTERS)
+ * @param[in] name The name of sub-plugin registered by the file.
+ * @param[in] fullpath The full path to the file.
+ */
+extern void
+nnsconf_registry_set_subplugin_path (nnsconf_type_path type, const gchar * name, const gchar * fullpath);
+
+/**
+ * @brief Check the sub-plugin file failed to be loaded, with the registry cache.
+ * @param[in] type The type (FILTERS/DECODERS/CUSTOM_FILTERS/CONVERTERS)
+ * @param[in] fullpath The full path to the file.
+ * @return TRUE if the file failed to be loaded and it is not modified after then.
+ *         FALSE if the registry cache is disabled or the file is not known to be broken.
+ */
+extern gboolean
+nnsconf_registry_is_broken (nnsconf_type_path type, const gchar * fullpath);
+
+/**
+ * @brief Record the sub-plugin file failed to be loaded (or it is loaded successfully) in the registry cache.
+ * @param[in] type The type (FILTERS/DECODERS/CUSTOM_FILTERS/CONVERTERS)
+ * @param[in] fullpath The full path to the file.
+ * @param[in] broken TRUE if the file failed to be loaded.
+ */
+extern void
+nnsconf_registry_set_broken (nnsconf_type_path type, const gchar * fullpath, gboolean broken);
+
 /**
  * @brief Get the custom configuration value from .ini and envvar.
  * @detail For predefined configurations defined in this header,
@@ -215,6 +215,63 @@ gst_tensor_time_sync_flush (GstCollectPads * collect)
   }
 }
 
+/**
+ * @brief A function to release the pad data of mux / merge.
+ */
+void
+gst_tensor_time_sync_pad_data_free (GstCollectData * data)
+{
+  GstTensorCollectPadData *pad;
+
+  g_return_if_fail (data != NULL);
+
+  pad = (GstTensorCollectPadData *) data;
+
+  if (pad->buffer) {
+    gst_buffer_unref (pad->buffer);
+    pad->buffer = NULL;
+  }
+
+  if (pad->caps) {
+    gst_tensors_config_free (&pad->config);
+    gst_caps_unref (pad->caps);
+    pad->caps = NULL;
+  }
+
+  pad->configured = FALSE;
+}
+
+/**
+ * @brief Internal function to get the tensors config of the pad.
+ * The config is cached in the pad data and parsed again only when the current caps is changed.
+ * This is called for every collected buffer under the stream lock of collect pads.
+ */
+static GstTensorsConfig *
+_gst_tensor_time_sync_get_pad_config (GstTensorCollectPadData * pad)
+{
+  GstCaps *caps;
+
+  caps = gst_pad_get_current_caps (pad->pad);
+  if (caps == NULL)
+    return NULL;
+
+  if (caps != pad->caps) {
+    if (pad->caps) {
+      gst_tensors_config_free (&pad->config);
+      gst_caps_unref (pad->caps);
+    }
+
+    pad->caps = gst_caps_ref (caps);
+    gst_tensors_config_init (&pad->config);
+    gst_tensors_config_from_structure (&pad->config,
+        gst_caps_get_structure (caps, 0));
+    pad->configured = gst_tensors_config_validate (&pad->config);
+  }
+
+  gst_caps_unref (caps);
+  return pad->configured ? &pad->config : NULL;
+}
+
 /**
  * @brief Internal function to update buffer in pad data based on the sync mode.
  */
@@ -276,7 +333,7 @@ gst_tensor_time_sync_buffer_from_collectpad (GstCollectPads * collect,
   gint old_numerator = G_MAXINT;
   gint old_denominator = G_MAXINT;
   guint counting, empty_pad;
-  GstTensorsConfig in_configs;
+  GstTensorsConfig *in_configs;
   GstClockTime base_time = 0;
   guint i, n_mem;
   GstMemory *in_mem[NNS_TENSOR_SIZE_LIMIT];
@@ -315,21 +372,12 @@ gst_tensor_time_sync_buffer_from_collectpad (GstCollectPads * collect,
   walk = collect->data;
 
   while (walk) {
-    gboolean configured = FALSE;
     gboolean is_empty = FALSE;
 
     data = (GstCollectData *) walk->data;
     pad = (GstTensorCollectPadData *) data;
 
-    if (gst_pad_has_current_caps (pad->pad)) {
-      GstCaps *caps = gst_pad_get_current_caps (pad->pad);
-      GstStructure *s = gst_caps_get_structure (caps, 0);
-
-      gst_tensors_config_from_structure (&in_configs, s);
-      gst_caps_unref (caps);
-
-      configured = gst_tensors_config_validate (&in_configs);
-    }
+    in_configs = _gst_tensor_time_sync_get_pad_config (pad);
 
     /**
      * This would be an internal logic error.
@@ -338,14 +386,14 @@ gst_tensor_time_sync_buffer_from_collectpad (GstCollectPads * collect,
      * If new sync mode is enabled (e.g., handle output when a pad gets new buffer),
      * this may cause unexpected exception.
      */
-    if (!configured) {
+    if (in_configs == NULL) {
       return FALSE;
     }
 
-    if (in_configs.rate_d < old_denominator)
-      old_denominator = in_configs.rate_d;
-    if (in_configs.rate_n < old_numerator)
-      old_numerator = in_configs.rate_n;
+    if (in_configs->rate_d < old_denominator)
+      old_denominator = in_configs->rate_d;
+    if (in_configs->rate_n < old_numerator)
+      old_numerator = in_configs->rate_n;
 
     walk = g_slist_next (walk);
 
@@ -385,23 +433,23 @@ gst_tensor_time_sync_buffer_from_collectpad (GstCollectPads * collect,
     }
 
     if (GST_IS_BUFFER (buf)) {
-      buf = gst_tensor_buffer_from_config (buf, &in_configs);
+      buf = gst_tensor_buffer_from_config (buf, in_configs);
       n_mem = gst_buffer_n_memory (buf);
 
       /** These are internal logic error. If given inputs are incorrect,
           the negotiation should have been failed before this stage. */
-      if (gst_tensors_config_is_static (&in_configs))
-        g_assert (n_mem == in_configs.info.num_tensors);
+      if (gst_tensors_config_is_static (in_configs))
+        g_assert (n_mem == in_configs->info.num_tensors);
       g_assert ((counting + n_mem) <= NNS_TENSOR_SIZE_LIMIT);
 
-      if (gst_tensors_config_is_flexible (&in_configs))
+      if (gst_tensors_config_is_flexible (in_configs))
         configs->info.format = _NNS_TENSOR_FORMAT_FLEXIBLE;
 
       for (i = 0; i < n_mem; ++i) {
         in_mem[counting] = gst_buffer_get_memory (buf, i);
 
-        configs->info.info[counting] = in_configs.info.info[i];
-        in_formats[counting] = in_configs.info.format;
+        configs->info.info[counting] = in_configs->info.info[i];
+        in_formats[counting] = in_configs->info.format;
         counting++;
       }
 
@@ -706,6 +754,191 @@ gst_tensor_aggregation_get_adapter (GHashTable * table, const guint32 key)
   return aggr->adapter;
 }
 
+/**
+ * @brief The number of entries in the caches of caps and tensors config.
+ */
+#define GST_TENSOR_CAPS_CACHE_SIZE 8
+
+/**
+ * @brief Entry of the caches of caps and tensors config.
+ * The caps cache is keyed by (single, config) and the config cache is keyed by the structure.
+ */
+typedef struct
+{
+  GstStructure *structure; /**< the parsed structure (config cache) */
+  gboolean single; /**< caps for other/tensor (caps cache) */
+  GstCaps *caps; /**< the generated caps (caps cache) */
+  GstTensorsConfig config;
+} GstTensorCapsCacheEntry;
+
+G_LOCK_DEFINE_STATIC (caps_cache_lock);
+static GQueue caps_cache = G_QUEUE_INIT;
+static GQueue config_cache = G_QUEUE_INIT;
+
+/**
+ * @brief Internal function to free the entry of caps cache.
+ */
+static void
+_caps_cache_entry_free (GstTensorCapsCacheEntry * entry)
+{
+  if (entry->structure)
+    gst_structure_free (entry->structure);
+  if (entry->caps)
+    gst_caps_unref (entry->caps);
+  gst_tensors_config_free (&entry->config);
+  g_free (entry);
+}
+
+/**
+ * @brief Internal function to add the entry to the head of the cache, and drop the least recently used one.
+ * @note Caller should hold caps_cache_lock.
+ */
+static void
+_caps_cache_push (GQueue * cache, GstTensorCapsCacheEntry * entry)
+{
+  g_queue_push_head (cache, entry);
+
+  if (g_queue_get_length (cache) > GST_TENSOR_CAPS_CACHE_SIZE)
+    _caps_cache_entry_free (g_queue_pop_tail (cache));
+}
+
+/**
+ * @brief Internal function to move the hit entry to the head of the cache.
+ * @note Caller should hold caps_cache_lock.
+ */
+static void
+_caps_cache_touch (GQueue * cache, GList * link)
+{
+  if (link != cache->head) {
+    g_queue_unlink (cache, link);
+    g_queue_push_head_link (cache, link);
+  }
+}
+
+/**
+ * @brief Internal function to check the configs generate same caps.
+ */
+static gboolean
+_caps_cache_config_equal (const GstTensorsConfig * c1,
+    const GstTensorsConfig * c2)
+{
+  guint i;
+
+  if (c1->rate_n != c2->rate_n || c1->rate_d != c2->rate_d ||
+      c1->info.format != c2->info.format)
+    return FALSE;
+
+  /* caps for flexible and sparse tensors do not describe the tensors */
+  if (c1->info.format != _NNS_TENSOR_FORMAT_STATIC)
+    return TRUE;
+
+  if (c1->info.num_tensors != c2->info.num_tensors ||
+      c1->info.num_tensors > NNS_TENSOR_SIZE_LIMIT)
+    return FALSE;
+
+  for (i = 0; i < c1->info.num_tensors; i++) {
+    if (c1->info.info[i].type != c2->info.info[i].type ||
+        memcmp (c1->info.info[i].dimension, c2->info.info[i].dimension,
+            sizeof (tensor_dim)) != 0)
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to get the copy of cached caps for given config.
+ * @return Newly allocated caps, or NULL if not cached.
+ */
+static GstCaps *
+_caps_cache_lookup_caps (const GstTensorsConfig * config, gboolean single)
+{
+  GstCaps *caps = NULL;
+  GList *link;
+
+  G_LOCK (caps_cache_lock);
+  for (link = caps_cache.head; link; link = link->next) {
+    GstTensorCapsCacheEntry *entry = link->data;
+
+    if (entry->single == single &&
+        _caps_cache_config_equal (&entry->config, config)) {
+      caps = gst_caps_copy (entry->caps);
+      _caps_cache_touch (&caps_cache, link);
+      break;
+    }
+  }
+  G_UNLOCK (caps_cache_lock);
+
+  return caps;
+}
+
+/**
+ * @brief Internal function to add the caps generated from given config to the cache.
+ */
+static void
+_caps_cache_insert_caps (const GstTensorsConfig * config, gboolean single,
+    GstCaps * caps)
+{
+  GstTensorCapsCacheEntry *entry;
+
+  if (!caps || config->info.num_tensors > NNS_TENSOR_SIZE_LIMIT)
+    return;
+
+  entry = g_new0 (GstTensorCapsCacheEntry, 1);
+  entry->single = single;
+  entry->caps = gst_caps_copy (caps);
+  gst_tensors_config_copy (&entry->config, config);
+
+  G_LOCK (caps_cache_lock);
+  _caps_cache_push (&caps_cache, entry);
+  G_UNLOCK (caps_cache_lock);
+}
+
+/**
+ * @brief Internal function to fill the config from the cached config for given structure.
+ * @return TRUE if cached.
+ */
+static gboolean
+_caps_cache_lookup_config (GstTensorsConfig * config,
+    const GstStructure * structure)
+{
+  gboolean found = FALSE;
+  GList *link;
+
+  G_LOCK (caps_cache_lock);
+  for (link = config_cache.head; link; link = link->next) {
+    GstTensorCapsCacheEntry *entry = link->data;
+
+    if (gst_structure_is_equal (entry->structure, structure)) {
+      gst_tensors_config_copy (config, &entry->config);
+      _caps_cache_touch (&config_cache, link);
+      found = TRUE;
+      break;
+    }
+  }
+  G_UNLOCK (caps_cache_lock);
+
+  return found;
+}
+
+/**
+ * @brief Internal function to add the config parsed from given structure to the cache.
+ */
+static void
+_caps_cache_insert_config (const GstTensorsConfig * config,
+    const GstStructure * structure)
+{
+  GstTensorCapsCacheEntry *entry;
+
+  entry = g_new0 (GstTensorCapsCacheEntry, 1);
+  entry->structure = gst_structure_copy (structure);
+  gst_tensors_config_copy (&entry->config, config);
+
+  G_LOCK (caps_cache_lock);
+  _caps_cache_push (&config_cache, entry);
+  G_UNLOCK (caps_cache_lock);
+}
+
 /**
  * @brief Internal function to get caps for single tensor from config.
  */
@@ -1274,6 +1507,10 @@ gst_tensors_caps_from_config (const GstTensorsConfig * config)
 
   g_return_val_if_fail (config != NULL, NULL);
 
+  caps = _caps_cache_lookup_caps (config, FALSE);
+  if (caps)
+    return caps;
+
   if (gst_tensors_config_is_flexible (config)) {
     caps = _get_flexible_caps (config);
   } else {
@@ -1281,6 +1518,7 @@ gst_tensors_caps_from_config (const GstTensorsConfig * config)
   }
 
   caps = gst_caps_truncate (caps);
+  _caps_cache_insert_caps (config, FALSE, caps);
 
   return caps;
 }
@@ -1297,30 +1535,27 @@ gst_tensor_caps_from_config (const GstTensorsConfig * config)
   GstCaps *caps;
   g_return_val_if_fail (config != NULL, NULL);
 
+  caps = _caps_cache_lookup_caps (config, TRUE);
+  if (caps)
+    return caps;
+
   caps = _get_tensor_caps (config);
   caps = gst_caps_truncate (caps);
+  _caps_cache_insert_caps (config, TRUE, caps);
 
   return caps;
 }
 
 /**
- * @brief Parse structure and set tensors config (for other/tensors)
- * @param config tensors config structure to be filled
- * @param structure structure to be interpreted
- * @return TRUE if no error
+ * @brief Internal function to parse structure and set tensors config.
  */
-gboolean
-gst_tensors_config_from_structure (GstTensorsConfig * config,
+static gboolean
+_parse_tensors_config_from_structure (GstTensorsConfig * config,
     const GstStructure * structure)
 {
   const gchar *name;
   tensor_format format = _NNS_TENSOR_FORMAT_STATIC;
 
-  g_return_val_if_fail (config != NULL, FALSE);
-  gst_tensors_config_init (config);
-
-  g_return_val_if_fail (structure != NULL, FALSE);
-
   name = gst_structure_get_name (structure);
 
   if (g_str_equal (name, NNS_MIMETYPE_TENSOR)) {
@@ -1404,6 +1639,32 @@ gst_tensors_config_from_structure (GstTensorsConfig * config,
   return TRUE;
 }
 
+/**
+ * @brief Parse structure and set tensors config (for other/tensors)
+ * @param config tensors config structure to be filled
+ * @param structure structure to be interpreted
+ * @return TRUE if no error
+ * @note The configs of recently parsed structures are cached, the renegotiation with same caps does not parse the strings again.
+ */
+gboolean
+gst_tensors_config_from_structure (GstTensorsConfig * config,
+    const GstStructure * structure)
+{
+  g_return_val_if_fail (config != NULL, FALSE);
+  gst_tensors_config_init (config);
+
+  g_return_val_if_fail (structure != NULL, FALSE);
+
+  if (_caps_cache_lookup_config (config, structure))
+    return TRUE;
+
+  if (!_parse_tensors_config_from_structure (config, structure))
+    return FALSE;
+
+  _caps_cache_insert_config (config, structure);
+  return TRUE;
+}
+
 /**
  * @brief Parse memory and fill the tensor meta.
  * @param[out] meta tensor meta structure to be filled
@@ -1432,6 +1693,36 @@ gst_tensor_meta_info_parse_memory (GstTensorMetaInfo * meta, GstMemory * mem)
   return ret;
 }
 
+/**
+ * @brief Get the tensor data of flexible tensor memory without the header.
+ * @param[in,out] cache the cached layout, updated if the header is changed
+ * @param[in] mem pointer to GstMemory of flexible tensor
+ * @param[out] meta tensor meta structure to be filled
+ * @return Newly shared GstMemory of the tensor data, NULL if failed to parse the header. (Caller should free returned memory using gst_memory_unref())
+ */
+GstMemory *
+gst_tensor_meta_cache_share_payload (GstTensorMetaCache * cache,
+    GstMemory * mem, GstTensorMetaInfo * meta)
+{
+  GstMapInfo map;
+  gsize hsize;
+
+  g_return_val_if_fail (mem != NULL, NULL);
+
+  if (!gst_memory_map (mem, &map, GST_MAP_READ)) {
+    nns_loge ("Failed to get the meta, cannot map the memory.");
+    return NULL;
+  }
+
+  hsize = gst_tensor_meta_cache_parse (cache, map.data, map.size, meta);
+  gst_memory_unmap (mem, &map);
+
+  if (hsize == 0)
+    return NULL;
+
+  return gst_memory_share (mem, hsize, -1);
+}
+
 /**
  * @brief Append header to memory.
  * @param[in] meta tensor meta structure
@@ -1490,31 +1781,119 @@ typedef struct
 } GstTensorExtraInfo;
 
 /**
- * @brief Check if given @a mem has extra tensors.
- * @param[in] mem GstMemory to be checked.
- * @return TRUE if @mem has extra tensors, otherwise FALSE.
-*/
-static gboolean
-gst_tensor_is_extra_memory (GstMemory * mem)
+ * @brief Data structure for the parsed layout of the NNS_TENSOR_SIZE_LIMIT-th memory block.
+ * The layout is cached in the memory (qdata), so that the header is parsed once for each memory.
+ * The entry 0 is the NNS_TENSOR_SIZE_LIMIT-th tensor, and the entry n is the n-th extra tensor.
+ */
+typedef struct
 {
-  GstMapInfo map;
+  guint num_extra_tensors;
+  gsize offsets[NNS_TENSOR_SIZE_EXTRA_LIMIT + 1];
+  gsize sizes[NNS_TENSOR_SIZE_EXTRA_LIMIT + 1];
+} GstTensorExtraLayout;
+
+G_LOCK_DEFINE_STATIC (extra_layout_lock);
+
+/**
+ * @brief Get the quark for the layout of extra tensors.
+ */
+static GQuark
+gst_tensor_extra_layout_quark (void)
+{
+  static GQuark quark = 0;
+
+  if (!quark)
+    quark = g_quark_from_static_string ("GstTensorExtraLayout");
+  return quark;
+}
+
+/**
+ * @brief Get the layout of extra tensors in given @a mem.
+ * @param[in] mem GstMemory to be parsed.
+ * @return The cached layout (valid while @a mem is alive), or NULL if @a mem does not have extra tensors.
+ */
+static const GstTensorExtraLayout *
+gst_tensor_extra_layout_get (GstMemory * mem)
+{
+  GstTensorExtraLayout *layout;
   GstTensorExtraInfo *extra_info;
-  gboolean is_extra;
+  GstMapInfo map;
+  gsize offset;
+  guint i;
 
-  g_return_val_if_fail (mem != NULL, FALSE);
+  g_return_val_if_fail (mem != NULL, NULL);
+
+  G_LOCK (extra_layout_lock);
+  layout = (GstTensorExtraLayout *) gst_mini_object_get_qdata (
+      GST_MINI_OBJECT_CAST (mem), gst_tensor_extra_layout_quark ());
+  if (layout)
+    goto done;
 
   if (!gst_memory_map (mem, &map, GST_MAP_READ)) {
     nns_loge ("Failed to map extra memory");
-    return FALSE;
+    goto done;
   }
 
   extra_info = (GstTensorExtraInfo *) map.data;
 
   /* check magic in header (extra info) of the memory */
-  is_extra = (extra_info && extra_info->magic == NNS_TENSOR_EXTRA_MAGIC);
+  if (map.size < sizeof (GstTensorExtraInfo) ||
+      extra_info->magic != NNS_TENSOR_EXTRA_MAGIC ||
+      extra_info->num_extra_tensors > NNS_TENSOR_SIZE_EXTRA_LIMIT) {
+    gst_memory_unmap (mem, &map);
+    goto done;
+  }
+
+  layout = g_new0 (GstTensorExtraLayout, 1);
+  layout->num_extra_tensors = extra_info->num_extra_tensors;
+  layout->offsets[0] = sizeof (GstTensorExtraInfo);
+  layout->sizes[0] = extra_info->reserved;
+
+  offset = layout->offsets[0] + layout->sizes[0];
+  for (i = 0; i < layout->num_extra_tensors; i++) {
+    layout->offsets[i + 1] = offset;
+    layout->sizes[i + 1] = gst_tensor_info_get_size (&extra_info->infos[i]);
+    offset += layout->sizes[i + 1];
+  }
 
   gst_memory_unmap (mem, &map);
-  return is_extra;
+
+  if (offset > map.size) {
+    nns_loge ("Invalid extra header, the size of tensors exceeds the memory.");
+    g_free (layout);
+    layout = NULL;
+    goto done;
+  }
+
+  gst_mini_object_set_qdata (GST_MINI_OBJECT_CAST (mem),
+      gst_tensor_extra_layout_quark (), layout, g_free);
+
+done:
+  G_UNLOCK (extra_layout_lock);
+  return layout;
+}
+
+/**
+ * @brief Remove the cached layout of extra tensors in given @a mem, after the tensors are changed.
+ */
+static void
+gst_tensor_extra_layout_reset (GstMemory * mem)
+{
+  G_LOCK (extra_layout_lock);
+  gst_mini_object_set_qdata (GST_MINI_OBJECT_CAST (mem),
+      gst_tensor_extra_layout_quark (), NULL, NULL);
+  G_UNLOCK (extra_layout_lock);
+}
+
+/**
+ * @brief Check if given @a mem has extra tensors.
+ * @param[in] mem GstMemory to be checked.
+ * @return TRUE if @mem has extra tensors, otherwise FALSE.
+*/
+static gboolean
+gst_tensor_is_extra_memory (GstMemory * mem)
+{
+  return (gst_tensor_extra_layout_get (mem) != NULL);
 }
 
 /**
@@ -1538,6 +1917,62 @@ gst_tensor_extra_info_init (GstTensorExtraInfo * extra, GstMemory * memory)
   }
 }
 
+/**
+ * @brief Append @a memory to the spare space of extra memory @a extra, without copying the previous tensors.
+ * @param[in/out] extra GstMemory with extra tensors, allocated with spare space.
+ * @param[in] memory GstMemory to append.
+ * @param[in] info GstTensorInfo of given @a memory.
+ * @return TRUE if successfully appended. FALSE if @a extra is shared or does not have enough space.
+ */
+static gboolean
+gst_tensor_extra_memory_append_in_place (GstMemory * extra, GstMemory * memory,
+    const GstTensorInfo * info)
+{
+  GstMapInfo extra_map, incoming_map;
+  GstTensorExtraInfo *extra_info;
+  gsize offset, size, maxsize, incoming_size;
+  gboolean appended = FALSE;
+
+  size = gst_memory_get_sizes (extra, &offset, &maxsize);
+  incoming_size = gst_memory_get_sizes (memory, NULL, NULL);
+
+  /* the tensors in shared memory (e.g., sub-memory of extra tensor) should not be changed */
+  if (extra->parent != NULL || GST_MEMORY_IS_READONLY (extra) ||
+      !gst_mini_object_is_writable (GST_MINI_OBJECT_CAST (extra)) ||
+      offset + size + incoming_size > maxsize)
+    return FALSE;
+
+  if (!gst_memory_map (memory, &incoming_map, GST_MAP_READ))
+    return FALSE;
+
+  gst_memory_resize (extra, 0, size + incoming_size);
+
+  if (!gst_memory_map (extra, &extra_map, GST_MAP_WRITE)) {
+    gst_memory_resize (extra, 0, size);
+    gst_memory_unmap (memory, &incoming_map);
+    return FALSE;
+  }
+
+  extra_info = (GstTensorExtraInfo *) extra_map.data;
+  if (extra_info->num_extra_tensors < NNS_TENSOR_SIZE_EXTRA_LIMIT) {
+    memcpy (extra_map.data + size, incoming_map.data, incoming_size);
+    gst_tensor_info_copy (&extra_info->infos[extra_info->num_extra_tensors],
+        info);
+    extra_info->num_extra_tensors += 1;
+    appended = TRUE;
+  }
+
+  gst_memory_unmap (extra, &extra_map);
+  gst_memory_unmap (memory, &incoming_map);
+
+  if (appended)
+    gst_tensor_extra_layout_reset (extra);
+  else
+    gst_memory_resize (extra, 0, size);
+
+  return appended;
+}
+
 /**
  * @brief Get the nth GstMemory from given @a buffer.
  * @param[in] buffer GstBuffer to be parsed.
@@ -1549,10 +1984,9 @@ GstMemory *
 gst_tensor_buffer_get_nth_memory (GstBuffer * buffer,
     const GstTensorsInfo * info, const guint index)
 {
-  guint i, offset = 0;
-  GstMemory *extra_tensors_memory, *res_mem;
-  GstMapInfo extra_tensors_map;
-  GstTensorExtraInfo *extra_info;
+  guint nth;
+  GstMemory *extra_tensors_memory;
+  const GstTensorExtraLayout *layout;
 
   if (!GST_IS_BUFFER (buffer)) {
     nns_loge ("Failed to parse GstBuffer (invalid input buffer).");
@@ -1582,69 +2016,30 @@ gst_tensor_buffer_get_nth_memory (GstBuffer * buffer,
     return NULL;
   }
 
-  /* If num_tensors is greater than NNS_TENSOR_SIZE_LIMIT, we need to parse extra info. */
-  extra_tensors_memory =
-      gst_buffer_get_memory (buffer, NNS_TENSOR_SIZE_LIMIT - 1);
+  /* If num_tensors is greater than NNS_TENSOR_SIZE_LIMIT, we need the layout of extra tensors. */
+  extra_tensors_memory = gst_buffer_peek_memory (buffer,
+      NNS_TENSOR_SIZE_LIMIT - 1);
   if (!extra_tensors_memory) {
     nns_loge ("Failed to get %d-th memory", NNS_TENSOR_SIZE_LIMIT);
     return NULL;
   }
 
-  if (!gst_memory_map (extra_tensors_memory, &extra_tensors_map, GST_MAP_READ)) {
-    nns_loge ("Failed to map %d-th memory", NNS_TENSOR_SIZE_LIMIT);
-    gst_memory_unref (extra_tensors_memory);
-    return NULL;
-  }
-
-  extra_info = (GstTensorExtraInfo *) extra_tensors_map.data;
-
-  /* check header (extra info) of the memory */
-  /* check magic */
-  if (extra_info->magic != NNS_TENSOR_EXTRA_MAGIC) {
+  layout = gst_tensor_extra_layout_get (extra_tensors_memory);
+  if (!layout) {
     nns_loge ("Invalid extra header");
-    gst_memory_unmap (extra_tensors_memory, &extra_tensors_map);
-    gst_memory_unref (extra_tensors_memory);
     return NULL;
   }
 
   /* check index */
-  if (index >= extra_info->num_extra_tensors + NNS_TENSOR_SIZE_LIMIT) {
+  nth = index - (NNS_TENSOR_SIZE_LIMIT - 1);
+  if (nth > layout->num_extra_tensors) {
     nns_loge ("Invalid index");
-    gst_memory_unmap (extra_tensors_memory, &extra_tensors_map);
-    gst_memory_unref (extra_tensors_memory);
     return NULL;
   }
 
-  /* parse the memory */
-  offset = sizeof (GstTensorExtraInfo);
-
-  /* If index is NNS_TENSOR_SIZE_LIMIT - 1 */
-  if (index == NNS_TENSOR_SIZE_LIMIT - 1) {
-    res_mem =
-        gst_memory_share (extra_tensors_memory, offset, extra_info->reserved);
-    gst_memory_unmap (extra_tensors_memory, &extra_tensors_map);
-    gst_memory_unref (extra_tensors_memory);
-
-    return res_mem;
-  }
-
-  offset += extra_info->reserved;
-
-  for (i = 1; i <= index - NNS_TENSOR_SIZE_LIMIT; ++i) {
-    offset += gst_tensor_info_get_size (&extra_info->infos[i - 1]);
-  }
-
   /* wrap it as GstMemory */
-  res_mem =
-      gst_memory_share (extra_tensors_memory, offset,
-      gst_tensor_info_get_size (&extra_info->infos[index -
-              NNS_TENSOR_SIZE_LIMIT]));
-
-  /* cleanup and return */
-  gst_memory_unmap (extra_tensors_memory, &extra_tensors_map);
-  gst_memory_unref (extra_tensors_memory);
-
-  return res_mem;
+  return gst_memory_share (extra_tensors_memory, layout->offsets[nth],
+      layout->sizes[nth]);
 }
 
 /**
@@ -1658,10 +2053,11 @@ gboolean
 gst_tensor_buffer_append_memory (GstBuffer * buffer, GstMemory * memory,
     const GstTensorInfo * info)
 {
-  guint num_mems, offset, i;
+  guint num_mems, offset;
 
   GstMemory *new_memory, *last_memory;
-  gsize new_mem_size;
+  gsize new_mem_size, incoming_mem_size;
+  gboolean is_extra;
 
   GstMapInfo new_memory_map, last_memory_map, incoming_memory_map;
   GstTensorExtraInfo *new_memory_extra_info;
@@ -1697,19 +2093,35 @@ gst_tensor_buffer_append_memory (GstBuffer * buffer, GstMemory * memory,
   }
 
   new_mem_size = gst_memory_get_sizes (last_memory, NULL, NULL);
+  is_extra = gst_tensor_is_extra_memory (last_memory);
+
+  /* fast path, the extra memory has spare space for incoming memory */
+  if (is_extra && gst_buffer_is_writable (buffer) &&
+      gst_tensor_extra_memory_append_in_place (last_memory, memory, info)) {
+    gst_memory_unref (memory);
+    return TRUE;
+  }
 
   /* if the memory does not have proper header, append it */
-  if (!gst_tensor_is_extra_memory (last_memory)) {
+  if (!is_extra) {
     new_mem_size += sizeof (GstTensorExtraInfo);
   }
 
-  new_mem_size += gst_memory_get_sizes (memory, NULL, NULL);
+  incoming_mem_size = gst_memory_get_sizes (memory, NULL, NULL);
+  new_mem_size += incoming_mem_size;
 
-  new_memory = gst_allocator_alloc (NULL, new_mem_size, NULL);
+  /**
+   * Allocate the spare space for the next extra tensors (twice of the extra tensors),
+   * so that appending many tensors does not copy the previous tensors every time.
+   */
+  new_memory = gst_allocator_alloc (NULL,
+      new_mem_size + MAX (new_mem_size - sizeof (GstTensorExtraInfo),
+          incoming_mem_size), NULL);
   if (!new_memory) {
     nns_loge ("Failed to allocate memory for extra tensors.");
     return FALSE;
   }
+  gst_memory_resize (new_memory, 0, new_mem_size);
 
   if (!gst_memory_map (new_memory, &new_memory_map, GST_MAP_WRITE)) {
     nns_loge ("Failed to map extra memory");
@@ -1726,7 +2138,7 @@ gst_tensor_buffer_append_memory (GstBuffer * buffer, GstMemory * memory,
   }
 
   /* if the last_memory does not have proper header, append it */
-  if (!gst_tensor_is_extra_memory (last_memory)) {
+  if (!is_extra) {
     GstTensorExtraInfo *extra_info = (GstTensorExtraInfo *) new_memory_map.data;
     gst_tensor_extra_info_init (extra_info, last_memory);
     extra_info->reserved = gst_memory_get_sizes (last_memory, NULL, NULL);
@@ -1750,10 +2162,20 @@ gst_tensor_buffer_append_memory (GstBuffer * buffer, GstMemory * memory,
   new_memory_extra_info = (GstTensorExtraInfo *) new_memory_map.data;
   new_memory_extra_info->num_extra_tensors += 1;
 
-  for (i = 0; i < new_memory_extra_info->num_extra_tensors; ++i) {
-    gst_tensor_info_copy (&new_memory_extra_info->infos[i], info);
+  if (new_memory_extra_info->num_extra_tensors > NNS_TENSOR_SIZE_EXTRA_LIMIT) {
+    nns_loge ("Failed to append memory, the max number of extra tensors is %d.",
+        NNS_TENSOR_SIZE_EXTRA_LIMIT);
+    gst_memory_unmap (new_memory, &new_memory_map);
+    gst_memory_unmap (memory, &incoming_memory_map);
+    gst_memory_unmap (last_memory, &last_memory_map);
+    gst_memory_unref (new_memory);
+    return FALSE;
   }
 
+  /* the infos of previous extra tensors are copied with the last memory */
+  gst_tensor_info_copy (&new_memory_extra_info->infos[new_memory_extra_info->
+          num_extra_tensors - 1], info);
+
   memcpy (new_memory_map.data + offset + last_memory_map.size,
       incoming_memory_map.data, incoming_memory_map.size);
 
@@ -1230,6 +1230,153 @@ gst_tensor_get_format_string (tensor_format format)
  */
 #define GST_TENSOR_META_IS_V1(v) (GST_TENSOR_META_VERSION_VALID(v) && (((v) & 0x00FFF000) & GST_TENSOR_META_MAKE_VERSION(1,0)))
 
+/**
+ * @brief The version of compact tensor meta.
+ */
+#define GST_TENSOR_META_VERSION_COMPACT GST_TENSOR_META_MAKE_VERSION(2,0)
+
+/**
+ * @brief Macro to check the version of compact tensor meta.
+ */
+#define GST_TENSOR_META_IS_V2(v) (GST_TENSOR_META_VERSION_VALID(v) && (((v) & 0x00FFF000) >> 12) == 2)
+
+/**
+ * @brief The alignment of compact header, the tensor data after the header is aligned with this.
+ */
+#define GST_TENSOR_META_COMPACT_ALIGN (8)
+
+/**
+ * @brief Internal function to write the variable-length integer (LEB128).
+ * @return The number of bytes. Only counts the bytes if @a buf is NULL.
+ */
+static gsize
+_meta_varint_write (guint8 * buf, guint32 val)
+{
+  gsize len = 0;
+
+  do {
+    guint8 b = val & 0x7F;
+
+    val >>= 7;
+    if (val)
+      b |= 0x80;
+    if (buf)
+      buf[len] = b;
+    len++;
+  } while (val);
+
+  return len;
+}
+
+/**
+ * @brief Internal function to read the variable-length integer (LEB128).
+ * @return The position after the integer, or NULL if the integer is not terminated before @a end.
+ */
+static const guint8 *
+_meta_varint_read (const guint8 * pos, const guint8 * end, guint32 * val)
+{
+  guint shift = 0;
+
+  *val = 0;
+  while (pos < end && shift < 32) {
+    guint8 b = *pos++;
+
+    *val |= ((guint32) (b & 0x7F)) << shift;
+    if (!(b & 0x80))
+      return pos;
+    shift += 7;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Internal function to write the compact header (version 2).
+ * Header layout: version (uint32), header size (uint8), then varints of type, format, media type, rank, dimension[rank] and nnz (sparse only), padded with zero.
+ * @return The header size. Only counts the size if @a header is NULL.
+ */
+static gsize
+_meta_compact_write (const GstTensorMetaInfo * meta, guint8 * header)
+{
+  gsize len = 5;
+  guint32 field[4];
+  guint i, rank;
+
+  for (rank = 0; rank < NNS_TENSOR_META_RANK_LIMIT; rank++) {
+    if (meta->dimension[rank] == 0)
+      break;
+  }
+
+  field[0] = meta->type;
+  field[1] = meta->format;
+  field[2] = meta->media_type;
+  field[3] = rank;
+
+  for (i = 0; i < 4; i++)
+    len += _meta_varint_write (header ? header + len : NULL, field[i]);
+
+  for (i = 0; i < rank; i++)
+    len += _meta_varint_write (header ? header + len : NULL,
+        meta->dimension[i]);
+
+  if (meta->format == _NNS_TENSOR_FORMAT_SPARSE)
+    len += _meta_varint_write (header ? header + len : NULL,
+        meta->sparse_info.nnz);
+
+  len = (len + GST_TENSOR_META_COMPACT_ALIGN - 1) &
+      ~((gsize) GST_TENSOR_META_COMPACT_ALIGN - 1);
+
+  if (header) {
+    memcpy (header, &meta->version, sizeof (uint32_t));
+    header[4] = (guint8) len;
+  }
+
+  return len;
+}
+
+/**
+ * @brief Internal function to read the compact header (version 2).
+ * @return TRUE if the header is successfully parsed.
+ */
+static gboolean
+_meta_compact_read (GstTensorMetaInfo * meta, const guint8 * header)
+{
+  const guint8 *pos, *end;
+  guint32 field[4];
+  guint i;
+
+  if (header[4] < GST_TENSOR_META_COMPACT_ALIGN ||
+      header[4] > NNS_TENSOR_META_HEADER_SIZE_LIMIT)
+    return FALSE;
+
+  pos = header + 5;
+  end = header + header[4];
+
+  for (i = 0; i < 4; i++) {
+    if (!(pos = _meta_varint_read (pos, end, &field[i])))
+      return FALSE;
+  }
+
+  if (field[3] > NNS_TENSOR_META_RANK_LIMIT)
+    return FALSE;
+
+  meta->type = field[0];
+  meta->format = field[1];
+  meta->media_type = field[2];
+
+  for (i = 0; i < field[3]; i++) {
+    if (!(pos = _meta_varint_read (pos, end, &meta->dimension[i])))
+      return FALSE;
+  }
+
+  if (meta->format == _NNS_TENSOR_FORMAT_SPARSE) {
+    if (!(pos = _meta_varint_read (pos, end, &meta->sparse_info.nnz)))
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
 /**
  * @brief Initialize the tensor meta info structure.
  * @param[in,out] meta tensor meta structure to be initialized
@@ -1268,6 +1415,18 @@ gst_tensor_meta_info_get_version (GstTensorMetaInfo * meta,
     *minor = (meta->version & 0x00000FFF);
 }
 
+/**
+ * @brief Set the tensor meta to use the compact header.
+ * @param[in,out] meta tensor meta structure
+ */
+void
+gst_tensor_meta_info_set_compact (GstTensorMetaInfo * meta)
+{
+  g_return_if_fail (meta != NULL);
+
+  meta->version = GST_TENSOR_META_VERSION_COMPACT;
+}
+
 /**
  * @brief Check the meta info is valid.
  * @param[in] meta tensor meta structure
@@ -1328,7 +1487,12 @@ gst_tensor_meta_info_get_header_size (GstTensorMetaInfo * meta)
 
   /* return fixed size for meta version */
   if (GST_TENSOR_META_IS_V1 (meta->version)) {
-    return 128;
+    return NNS_TENSOR_META_HEADER_SIZE_LIMIT;
+  }
+
+  /* compact header, the size depends on the meta */
+  if (GST_TENSOR_META_IS_V2 (meta->version)) {
+    return _meta_compact_write (meta, NULL);
   }
 
   return 0;
@@ -1383,7 +1547,10 @@ gst_tensor_meta_info_update_header (GstTensorMetaInfo * meta, gpointer header)
 
   memset (header, 0, hsize);
 
-  memcpy (header, meta, sizeof (GstTensorMetaInfo));
+  if (GST_TENSOR_META_IS_V2 (meta->version))
+    _meta_compact_write (meta, (guint8 *) header);
+  else
+    memcpy (header, meta, sizeof (GstTensorMetaInfo));
   return TRUE;
 }
 
@@ -1404,6 +1571,16 @@ gst_tensor_meta_info_parse_header (GstTensorMetaInfo * meta, gpointer header)
   gst_tensor_meta_info_init (meta);
 
   meta->version = val[0];
+
+  if (GST_TENSOR_META_IS_V2 (meta->version)) {
+    if (!_meta_compact_read (meta, (const guint8 *) header)) {
+      nns_logd ("Failed to parse the compact header of tensor meta.");
+      return FALSE;
+    }
+
+    return gst_tensor_meta_info_validate (meta);
+  }
+
   meta->type = val[1];
   memcpy (meta->dimension, &val[2],
       sizeof (uint32_t) * NNS_TENSOR_META_RANK_LIMIT);
@@ -1423,6 +1600,49 @@ gst_tensor_meta_info_parse_header (GstTensorMetaInfo * meta, gpointer header)
   return gst_tensor_meta_info_validate (meta);
 }
 
+/**
+ * @brief Parse the header of flexible tensor with the cached layout.
+ * @param[in,out] cache the cached layout, updated if the header is changed
+ * @param[in] data pointer to flexible tensor (header and tensor data)
+ * @param[in] size the size of @a data
+ * @param[out] meta tensor meta structure to be filled
+ * @return The header size, 0 if failed to parse the header.
+ */
+gsize
+gst_tensor_meta_cache_parse (GstTensorMetaCache * cache, gconstpointer data,
+    gsize size, GstTensorMetaInfo * meta)
+{
+  gsize hsize;
+
+  g_return_val_if_fail (cache != NULL, 0);
+  g_return_val_if_fail (data != NULL, 0);
+  g_return_val_if_fail (meta != NULL, 0);
+
+  /* fast path, same header with previous one */
+  hsize = cache->header_size;
+  if (hsize > 0 && size >= hsize && memcmp (data, cache->header, hsize) == 0) {
+    *meta = cache->meta;
+    return hsize;
+  }
+
+  cache->header_size = 0;
+
+  /* the header has version and type at least */
+  if (size < 2 * sizeof (uint32_t) ||
+      !gst_tensor_meta_info_parse_header (meta, (gpointer) data))
+    return 0;
+
+  hsize = gst_tensor_meta_info_get_header_size (meta);
+  if (hsize == 0 || hsize > size || hsize > NNS_TENSOR_META_HEADER_SIZE_LIMIT)
+    return 0;
+
+  memcpy (cache->header, data, hsize);
+  cache->meta = *meta;
+  cache->header_size = hsize;
+
+  return hsize;
+}
+
 /**
  * @brief Convert GstTensorMetaInfo structure to GstTensorInfo.
  * @param[in] meta tensor meta structure to be converted
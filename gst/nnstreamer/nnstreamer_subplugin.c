@@ -134,6 +134,62 @@ _search_subplugin (subpluginType type, const gchar * name, const gchar * path)
   return spdata;
 }
 
+/**
+ * @brief Internal function to get the names of registered sub-plugins.
+ */
+static gchar **
+_get_registered_names (subpluginType type)
+{
+  gchar **names = NULL;
+
+  G_LOCK (splock);
+  if (subplugins[type]) {
+    guint i, len = 0;
+    gpointer *keys = g_hash_table_get_keys_as_array (subplugins[type], &len);
+
+    names = g_new0 (gchar *, len + 1);
+    for (i = 0; i < len; i++)
+      names[i] = g_strdup ((const gchar *) keys[i]);
+    g_free (keys);
+  }
+  G_UNLOCK (splock);
+
+  return names;
+}
+
+/**
+ * @brief Internal function to load all sub-plugins of given type.
+ * The names registered by each file are recorded in the registry cache,
+ * so that the next process opens the file with the name only.
+ */
+static void
+_search_all_subplugins (subpluginType type)
+{
+  nnsconf_type_path conf_type = (nnsconf_type_path) type;
+  subplugin_info_s info;
+  guint i, j, ret;
+
+  ret = nnsconf_get_subplugin_info (conf_type, &info);
+
+  for (i = 0; i < ret; i++) {
+    gchar **before, **after;
+
+    before = _get_registered_names (type);
+    _search_subplugin (type, info.names[i], info.paths[i]);
+    after = _get_registered_names (type);
+
+    for (j = 0; after && after[j]; j++) {
+      if (!before || !g_strv_contains ((const gchar * const *) before,
+              after[j]))
+        nnsconf_registry_set_subplugin_path (conf_type, after[j],
+            info.paths[i]);
+    }
+
+    g_strfreev (before);
+    g_strfreev (after);
+  }
+}
+
 /** @brief Public function defined in the header */
 const void *
 get_subplugin (subpluginType type, const char *name)
@@ -142,27 +198,34 @@ get_subplugin (subpluginType type, const char *name)
 
   g_return_val_if_fail (name, NULL);
 
-  if (searchAlgorithm[type] == NNS_SEARCH_GETALL) {
+  spdata = _get_subplugin_data (type, name);
+
+  if (spdata == NULL && searchAlgorithm[type] == NNS_SEARCH_GETALL) {
     nnsconf_type_path conf_type = (nnsconf_type_path) type;
-    subplugin_info_s info;
-    guint i;
-    guint ret = nnsconf_get_subplugin_info (conf_type, &info);
+    gchar *cached = nnsconf_registry_get_subplugin_path (conf_type, name);
 
-    for (i = 0; i < ret; i++) {
-      _search_subplugin (type, info.names[i], info.paths[i]);
-    }
+    /* Open the file in the registry cache first, and then search all files. */
+    if (cached && nnsconf_validate_file (conf_type, cached))
+      spdata = _search_subplugin (type, name, cached);
+    g_free (cached);
 
-    searchAlgorithm[type] = NNS_SEARCH_NO_OP;
+    if (spdata == NULL) {
+      _search_all_subplugins (type);
+      searchAlgorithm[type] = NNS_SEARCH_NO_OP;
+      spdata = _get_subplugin_data (type, name);
+    }
   }
 
-  spdata = _get_subplugin_data (type, name);
   if (spdata == NULL && searchAlgorithm[type] == NNS_SEARCH_FILENAME) {
     /** Search and register if found with the conf */
     nnsconf_type_path conf_type = (nnsconf_type_path) type;
     const gchar *fullpath = nnsconf_get_fullpath (name, conf_type);
 
-    if (nnsconf_validate_file (conf_type, fullpath)) {
+    /* Do not try to open the file again if it failed to be loaded before. */
+    if (nnsconf_validate_file (conf_type, fullpath) &&
+        !nnsconf_registry_is_broken (conf_type, fullpath)) {
       spdata = _search_subplugin (type, name, fullpath);
+      nnsconf_registry_set_broken (conf_type, fullpath, (spdata == NULL));
     }
   }
 
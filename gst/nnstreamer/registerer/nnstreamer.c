@@ -46,8 +46,11 @@
 #endif
 
 #include <gst/gst.h>
+#include <nnstreamer_conf.h>
+#include <nnstreamer_plugin_api.h>
 
 #include <elements/gsttensor_aggregator.h>
+#include <elements/gsttensor_batch.h>
 #include <elements/gsttensor_converter.h>
 #include <elements/gsttensor_crop.h>
 #include <elements/gsttensor_debug.h>
@@ -65,12 +68,15 @@
 #include <elements/gsttensor_split.h>
 #include <elements/gsttensor_transform.h>
 #include <elements/gsttensor_trainer.h>
+#include <elements/gsttensor_unbatch.h>
 
 #ifdef _ENABLE_SRC_IIO
 #include <elements/gsttensor_srciio.h>
 #endif
 
 #include <tensor_filter/tensor_filter.h>
+#include <tracers/gsttensor_metrics.h>
+#include <tracers/gsttensor_tracer.h>
 #if defined(ENABLE_NNSTREAMER_EDGE)
 #include <tensor_query/tensor_query_serversrc.h>
 #include <tensor_query/tensor_query_serversink.h>
@@ -85,13 +91,44 @@
     } \
   } while (0)
 
+/**
+ * @brief Set the memory budget of the pipelines ([allocator] in nnstreamer.ini).
+ * The sources throttle or drop the incoming data over the watermarks.
+ */
+static void
+gst_nnstreamer_init_memory_budget (void)
+{
+  gchar *low, *high;
+  guint64 low_mb, high_mb;
+
+  low = nnsconf_get_custom_value_string ("allocator", "low_watermark_mb");
+  high = nnsconf_get_custom_value_string ("allocator", "high_watermark_mb");
+  low_mb = low ? g_ascii_strtoull (low, NULL, 10) : 0;
+  high_mb = high ? g_ascii_strtoull (high, NULL, 10) : 0;
+
+  if (low_mb > 0 || high_mb > 0)
+    gst_tensor_alloc_set_watermarks (low_mb << 20, high_mb << 20);
+
+  g_free (low);
+  g_free (high);
+}
+
 /**
  * @brief Function to initialize all nnstreamer elements
  */
 static gboolean
 gst_nnstreamer_init (GstPlugin * plugin)
 {
+  /* pooled tensor allocator, disabled by default ([allocator] in nnstreamer.ini) */
+  if (nnsconf_get_custom_value_bool ("allocator", "enable_pool", FALSE)) {
+    gst_tensor_alloc_init_full (0, TRUE,
+        nnsconf_get_custom_value_bool ("allocator", "enable_hugepage", FALSE));
+  }
+
+  gst_nnstreamer_init_memory_budget ();
+
   NNSTREAMER_INIT (plugin, aggregator, AGGREGATOR);
+  NNSTREAMER_INIT (plugin, batch, BATCH);
   NNSTREAMER_INIT (plugin, converter, CONVERTER);
   NNSTREAMER_INIT (plugin, crop, CROP);
   NNSTREAMER_INIT (plugin, debug, DEBUG);
@@ -110,6 +147,7 @@ gst_nnstreamer_init (GstPlugin * plugin)
   NNSTREAMER_INIT (plugin, if, IF);
   NNSTREAMER_INIT (plugin, rate, RATE);
   NNSTREAMER_INIT (plugin, trainer, TRAINER);
+  NNSTREAMER_INIT (plugin, unbatch, UNBATCH);
 #if defined(ENABLE_NNSTREAMER_EDGE)
   NNSTREAMER_INIT (plugin, query_serversrc, QUERY_SERVERSRC);
   NNSTREAMER_INIT (plugin, query_serversink, QUERY_SERVERSINK);
@@ -118,6 +156,19 @@ gst_nnstreamer_init (GstPlugin * plugin)
 #ifdef _ENABLE_SRC_IIO
   NNSTREAMER_INIT (plugin, src_iio, SRC_IIO);
 #endif
+#ifndef GST_DISABLE_GST_TRACER_HOOKS
+  if (!gst_tracer_register (plugin, "tensortrace", GST_TYPE_TENSOR_TRACER)) {
+    GST_ERROR ("Failed to register nnstreamer tracer : tensortrace");
+    return FALSE;
+  }
+  if (!gst_tracer_register (plugin, "tensormetrics", GST_TYPE_TENSOR_METRICS)) {
+    GST_ERROR ("Failed to register nnstreamer tracer : tensormetrics");
+    return FALSE;
+  }
+#endif
+
+  /* metrics exporter, disabled by default ([metrics] in nnstreamer.ini) */
+  gst_tensor_metrics_init_from_conf ();
   return TRUE;
 }
 
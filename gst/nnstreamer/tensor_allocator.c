@@ -9,14 +9,166 @@
  * @see     http://github.com/nnstreamer/nnstreamer
  * @bug     No known bugs
  *
+ * The tensor allocator aligns the memory chunks with the given alignment.
+ * If the pool is enabled, the freed memory chunks are kept in the size-class
+ * free lists (per-thread caches first, then the global lists) and reused for
+ * the following allocations. Large memory chunks may be backed by hugepages.
+ * If a thread sets its NUMA node (gst_tensor_alloc_set_thread_node), the
+ * memory blocks allocated in the thread are bound to the node and pooled in
+ * the free lists of the node.
+ *
+ * The allocator also keeps the memory budget of the pipelines. It counts the
+ * bytes in use and the bytes the elements hold in their receive queues
+ * (accounted with gst_tensor_alloc_account), and reports the memory pressure
+ * against the watermarks so that the sources can throttle or drop the data.
  */
 
+#include <string.h>
 #include <gst/gst.h>
+#include "nnstreamer_log.h"
 #include "nnstreamer_plugin_api.h"
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #define GST_TENSOR_ALLOCATOR "GstTensorAllocator"
 
+/**
+ * @brief Size classes of the pool: power of 2, from 256 bytes to 64 MiB.
+ */
+#define TENSOR_ALLOC_MIN_SHIFT (8)
+#define TENSOR_ALLOC_MAX_SHIFT (26)
+#define TENSOR_ALLOC_NUM_CLASSES (TENSOR_ALLOC_MAX_SHIFT - TENSOR_ALLOC_MIN_SHIFT + 1)
+
+/**
+ * @brief The alignment (mask) of the pooled memory blocks, which satisfies the alignment less than a page.
+ */
+#define TENSOR_ALLOC_BLOCK_ALIGN (4095)
+
+/**
+ * @brief The number of memory blocks for each size class in the per-thread cache.
+ */
+#define TENSOR_ALLOC_THREAD_CACHE_SIZE (4)
+
+/**
+ * @brief The max bytes of memory blocks kept in the global free lists.
+ */
+#define TENSOR_ALLOC_GLOBAL_CACHE_LIMIT (256 * 1024 * 1024)
+
+/**
+ * @brief Memory blocks larger than this are backed by hugepages if enabled.
+ */
+#define TENSOR_ALLOC_HUGEPAGE_SIZE (2 * 1024 * 1024)
+
+/**
+ * @brief The max number of NUMA nodes of the pool. The memory of the nodes over this is not bound.
+ */
+#define TENSOR_ALLOC_MAX_NODES (16)
+
+/**
+ * @brief The free lists for the memory not bound to a NUMA node, and for each node.
+ */
+#define TENSOR_ALLOC_NUM_NODE_SLOTS (TENSOR_ALLOC_MAX_NODES + 1)
+
+/**
+ * @brief Memory policy of mbind(), preferred node.
+ */
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED (1)
+#endif
+
 static gsize gst_tensor_allocator_alignment = 0;
+static gboolean gst_tensor_allocator_pooled = FALSE;
+static gboolean gst_tensor_allocator_hugepage = FALSE;
+static gboolean gst_tensor_allocator_numa = FALSE;
+
+/**
+ * @brief Memory chunk allocated by the tensor allocator.
+ */
+typedef struct _GstTensorAllocMemory GstTensorAllocMemory;
+
+/**
+ * @brief struct for the memory chunk of GstTensorAllocator
+ */
+struct _GstTensorAllocMemory
+{
+  GstMemory mem; /**< parent memory */
+
+  guint8 *data; /**< aligned pointer of the memory (maxsize) */
+  gpointer block; /**< the allocated memory block (NULL for shared memory) */
+  gsize block_size; /**< the size of the memory block */
+  gint size_class; /**< size class of the pooled memory block (-1 if not pooled) */
+  gint node; /**< NUMA node of the memory block (-1 if not bound) */
+  gboolean mapped; /**< TRUE if the block is mapped (hugepages or bound to a node) */
+  GstTensorAllocMemory *next; /**< next memory in the free list */
+};
+
+/**
+ * @brief Per-thread cache of the free memory chunks.
+ */
+typedef struct
+{
+  GstTensorAllocMemory *mems[TENSOR_ALLOC_NUM_CLASSES][TENSOR_ALLOC_THREAD_CACHE_SIZE]; /**< cached memory chunks */
+  guint count[TENSOR_ALLOC_NUM_CLASSES]; /**< the number of cached memory chunks */
+  gint node; /**< NUMA node of the thread and the cached memory chunks */
+} GstTensorAllocThreadCache;
+
+/**
+ * @brief Global free lists and statistics of the pool.
+ */
+static struct
+{
+  GMutex lock; /**< lock for the free lists */
+  GstTensorAllocMemory *free_list[TENSOR_ALLOC_NUM_NODE_SLOTS][TENSOR_ALLOC_NUM_CLASSES]; /**< global free lists for each NUMA node and size class */
+  gsize cached; /**< bytes in the global free lists */
+
+  gsize hits; /**< allocations served from the free lists (atomic) */
+  gsize misses; /**< allocations of new memory blocks (atomic) */
+  gsize resident; /**< bytes of memory blocks held by the allocator (atomic) */
+  gsize cached_total; /**< bytes of memory blocks in the free lists and thread caches (atomic) */
+  gsize in_use; /**< bytes of memory blocks allocated and not freed yet (atomic) */
+} tensor_alloc_pool;
+
+/**
+ * @brief Memory budget, the bytes held by the elements and the watermarks.
+ */
+static struct
+{
+  GMutex lock; /**< lock for the table of the held bytes */
+  GHashTable *owners; /**< bytes (gint64) held by each owner */
+  gsize held; /**< sum of the bytes held by the owners (atomic) */
+  guint64 low_watermark; /**< throttle the sources over this (0 to disable) */
+  guint64 high_watermark; /**< drop the incoming data over this (0 to disable) */
+} tensor_alloc_budget;
+
+/**
+ * @brief Properties and signals of the tensor allocator, for the plugins not linked with nnstreamer.
+ */
+enum
+{
+  PROP_0,
+  PROP_PRESSURE,
+};
+
+enum
+{
+  SIGNAL_ACCOUNT,
+  LAST_SIGNAL
+};
+
+static guint gst_tensor_allocator_signals[LAST_SIGNAL] = { 0 };
+
+static void gst_tensor_alloc_thread_cache_free (gpointer data);
+static GPrivate tensor_alloc_thread_cache =
+G_PRIVATE_INIT (gst_tensor_alloc_thread_cache_free);
+
+/**
+ * @brief NUMA node of the thread (node + 1, 0 if not set).
+ */
+static GPrivate tensor_alloc_thread_node = G_PRIVATE_INIT (NULL);
 
 /**
  * @brief struct for type GstTensorAllocator
@@ -39,26 +191,452 @@ static GType gst_tensor_allocator_get_type (void);
 G_DEFINE_TYPE (GstTensorAllocator, gst_tensor_allocator, GST_TYPE_ALLOCATOR);
 
 /**
- * @brief   allocation wrapper that binds alignment parameter
+ * @brief Get the size class of the given size.
+ * @return size class index, -1 if the size cannot be pooled.
+ */
+static gint
+_get_size_class (gsize size)
+{
+  gint shift = TENSOR_ALLOC_MIN_SHIFT;
+
+  while (shift <= TENSOR_ALLOC_MAX_SHIFT) {
+    if (size <= ((gsize) 1 << shift))
+      return shift - TENSOR_ALLOC_MIN_SHIFT;
+    shift++;
+  }
+
+  return -1;
+}
+
+/**
+ * @brief Get the NUMA node of the calling thread.
+ * @return the node, -1 if not set.
+ */
+static inline gint
+_get_thread_node (void)
+{
+  return GPOINTER_TO_INT (g_private_get (&tensor_alloc_thread_node)) - 1;
+}
+
+/**
+ * @brief Get the index of the free lists for the NUMA node.
+ */
+static inline gint
+_node_slot (gint node)
+{
+  return node + 1;
+}
+
+/**
+ * @brief Allocate a new memory block.
+ */
+static gboolean
+_block_alloc (GstTensorAllocMemory * mem, gsize size, gsize align, gint node)
+{
+  mem->mapped = FALSE;
+
+#if defined(__linux__)
+  if (align <= TENSOR_ALLOC_BLOCK_ALIGN && (node >= 0 ||
+          (gst_tensor_allocator_hugepage &&
+              size >= TENSOR_ALLOC_HUGEPAGE_SIZE))) {
+    gboolean huge = (gst_tensor_allocator_hugepage &&
+        size >= TENSOR_ALLOC_HUGEPAGE_SIZE);
+    gsize unit = huge ? TENSOR_ALLOC_HUGEPAGE_SIZE :
+        (TENSOR_ALLOC_BLOCK_ALIGN + 1);
+    gsize len = (size + unit - 1) & ~(unit - 1);
+    gpointer addr = mmap (NULL, len, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (addr != MAP_FAILED) {
+#if defined(MADV_HUGEPAGE)
+      /* transparent hugepage, it is not an error if the kernel does not support it. */
+      if (huge && madvise (addr, len, MADV_HUGEPAGE) != 0)
+        nns_logd ("Failed to set hugepage advice for %zu bytes.", len);
+#endif
+#if defined(SYS_mbind)
+      /* the pages are allocated in the node when touched first, wherever the thread runs */
+      if (node >= 0) {
+        unsigned long nodemask = 1UL << node;
+
+        if (syscall (SYS_mbind, addr, len, MPOL_PREFERRED, &nodemask,
+                sizeof (nodemask) * 8, 0) != 0)
+          nns_logd ("Failed to bind %zu bytes to the NUMA node %d.", len, node);
+      }
+#endif
+
+      mem->block = addr;
+      mem->block_size = len;
+      mem->data = (guint8 *) addr;
+      mem->mapped = TRUE;
+      return TRUE;
+    }
+  }
+#endif
+
+  mem->block_size = size + align;
+  mem->block = g_try_malloc (mem->block_size);
+  if (!mem->block)
+    return FALSE;
+
+  mem->data = (guint8 *) (((guintptr) mem->block + align) & ~((guintptr) align));
+  return TRUE;
+}
+
+/**
+ * @brief Free the memory block.
+ */
+static void
+_block_free (GstTensorAllocMemory * mem)
+{
+  if (!mem->block)
+    return;
+
+#if defined(__linux__)
+  if (mem->mapped) {
+    munmap (mem->block, mem->block_size);
+    mem->block = NULL;
+    return;
+  }
+#endif
+
+  g_free (mem->block);
+  mem->block = NULL;
+}
+
+/**
+ * @brief Release the memory chunk and its block.
+ */
+static void
+_release_memory (GstTensorAllocMemory * mem)
+{
+  if (mem->block) {
+    g_atomic_pointer_add (&tensor_alloc_pool.resident,
+        -((gssize) mem->block_size));
+    _block_free (mem);
+  }
+
+  g_free (mem);
+}
+
+/**
+ * @brief Pop a cached memory chunk of the size class and NUMA node.
+ */
+static GstTensorAllocMemory *
+_pool_pop (gint size_class, gint node)
+{
+  GstTensorAllocThreadCache *cache;
+  GstTensorAllocMemory *mem = NULL;
+  gint slot = _node_slot (node);
+
+  cache = g_private_get (&tensor_alloc_thread_cache);
+  if (cache && cache->node == node && cache->count[size_class] > 0) {
+    mem = cache->mems[size_class][--cache->count[size_class]];
+  } else {
+    g_mutex_lock (&tensor_alloc_pool.lock);
+    mem = tensor_alloc_pool.free_list[slot][size_class];
+    if (mem) {
+      tensor_alloc_pool.free_list[slot][size_class] = mem->next;
+      tensor_alloc_pool.cached -= mem->block_size;
+    }
+    g_mutex_unlock (&tensor_alloc_pool.lock);
+  }
+
+  if (mem) {
+    mem->next = NULL;
+    g_atomic_pointer_add (&tensor_alloc_pool.hits, 1);
+    g_atomic_pointer_add (&tensor_alloc_pool.cached_total,
+        -((gssize) mem->block_size));
+  } else {
+    g_atomic_pointer_add (&tensor_alloc_pool.misses, 1);
+  }
+
+  return mem;
+}
+
+/**
+ * @brief Push the memory chunk into the cache. Release it if the caches are full.
+ */
+static void
+_pool_push (GstTensorAllocMemory * mem)
+{
+  GstTensorAllocThreadCache *cache;
+  gint size_class = mem->size_class;
+  gint slot = _node_slot (mem->node);
+
+  cache = g_private_get (&tensor_alloc_thread_cache);
+  if (!cache) {
+    cache = g_new0 (GstTensorAllocThreadCache, 1);
+    cache->node = _get_thread_node ();
+    g_private_set (&tensor_alloc_thread_cache, cache);
+  }
+
+  g_atomic_pointer_add (&tensor_alloc_pool.cached_total, mem->block_size);
+
+  /* the memory of the other node (freed in the downstream thread) goes to the free list of its node */
+  if (cache->node == mem->node &&
+      cache->count[size_class] < TENSOR_ALLOC_THREAD_CACHE_SIZE) {
+    cache->mems[size_class][cache->count[size_class]++] = mem;
+    return;
+  }
+
+  g_mutex_lock (&tensor_alloc_pool.lock);
+  if (tensor_alloc_pool.cached + mem->block_size <=
+      TENSOR_ALLOC_GLOBAL_CACHE_LIMIT) {
+    mem->next = tensor_alloc_pool.free_list[slot][size_class];
+    tensor_alloc_pool.free_list[slot][size_class] = mem;
+    tensor_alloc_pool.cached += mem->block_size;
+    mem = NULL;
+  }
+  g_mutex_unlock (&tensor_alloc_pool.lock);
+
+  if (mem) {
+    g_atomic_pointer_add (&tensor_alloc_pool.cached_total,
+        -((gssize) mem->block_size));
+    _release_memory (mem);
+  }
+}
+
+/**
+ * @brief Move the memory chunks in the thread cache to the global free lists.
+ */
+static void
+_thread_cache_flush (GstTensorAllocThreadCache * cache)
+{
+  GstTensorAllocMemory *mem;
+  gint slot = _node_slot (cache->node);
+  guint i;
+
+  g_mutex_lock (&tensor_alloc_pool.lock);
+  for (i = 0; i < TENSOR_ALLOC_NUM_CLASSES; i++) {
+    while (cache->count[i] > 0) {
+      mem = cache->mems[i][--cache->count[i]];
+
+      mem->next = tensor_alloc_pool.free_list[slot][i];
+      tensor_alloc_pool.free_list[slot][i] = mem;
+      tensor_alloc_pool.cached += mem->block_size;
+    }
+  }
+  g_mutex_unlock (&tensor_alloc_pool.lock);
+}
+
+/**
+ * @brief Move the memory chunks in the thread cache to the global free lists when the thread exits.
+ */
+static void
+gst_tensor_alloc_thread_cache_free (gpointer data)
+{
+  GstTensorAllocThreadCache *cache = (GstTensorAllocThreadCache *) data;
+
+  _thread_cache_flush (cache);
+  g_free (cache);
+}
+
+/**
+ * @brief Initialize the memory chunk.
+ */
+static void
+_init_memory (GstTensorAllocMemory * mem, GstMemoryFlags flags,
+    GstAllocator * allocator, GstMemory * parent, gsize maxsize, gsize align,
+    gsize offset, gsize size)
+{
+  gst_memory_init (GST_MEMORY_CAST (mem), flags, allocator, parent, maxsize,
+      align, offset, size);
+}
+
+/**
+ * @brief allocation function of tensor allocator
  */
 static GstMemory *
 _alloc (GstAllocator * allocator, gsize size, GstAllocationParams * params)
 {
-  GstAllocator *sysmem_alloc;
-  GstAllocatorClass *sysmem_aclass;
-  GstAllocationParams *_params;
-  GstMemory *mem;
+  GstTensorAllocMemory *mem = NULL;
+  gsize maxsize, align;
+  gint size_class = -1;
+  gint node = _get_thread_node ();
+
+  maxsize = size + params->prefix + params->padding;
+  align = params->align | gst_tensor_allocator_alignment | gst_memory_alignment;
 
-  sysmem_alloc = gst_allocator_find (GST_ALLOCATOR_SYSMEM);
-  sysmem_aclass = GST_ALLOCATOR_GET_CLASS (sysmem_alloc);
-  _params = gst_allocation_params_copy (params);
-  _params->align = gst_tensor_allocator_alignment;
+  if (gst_tensor_allocator_pooled && align <= TENSOR_ALLOC_BLOCK_ALIGN) {
+    size_class = _get_size_class (maxsize);
+    if (size_class >= 0)
+      mem = _pool_pop (size_class, node);
+  }
 
-  mem = sysmem_aclass->alloc (allocator, size, _params);
+  if (!mem) {
+    gsize block_size = maxsize;
 
-  gst_allocation_params_free (_params);
-  gst_object_unref (sysmem_alloc);
-  return mem;
+    mem = g_new0 (GstTensorAllocMemory, 1);
+    mem->size_class = size_class;
+    mem->node = node;
+
+    if (size_class >= 0) {
+      block_size = (gsize) 1 << (size_class + TENSOR_ALLOC_MIN_SHIFT);
+      align = TENSOR_ALLOC_BLOCK_ALIGN;
+    }
+
+    if (!_block_alloc (mem, block_size, align, node)) {
+      nns_loge ("Failed to allocate the memory block (%zu bytes).", block_size);
+      g_free (mem);
+      return NULL;
+    }
+
+    g_atomic_pointer_add (&tensor_alloc_pool.resident, mem->block_size);
+  }
+
+  g_atomic_pointer_add (&tensor_alloc_pool.in_use, mem->block_size);
+
+  _init_memory (mem, params->flags, allocator, NULL, maxsize, params->align,
+      params->prefix, size);
+
+  if (params->prefix && (params->flags & GST_MEMORY_FLAG_ZERO_PREFIXED))
+    memset (mem->data, 0, params->prefix);
+  if (params->padding && (params->flags & GST_MEMORY_FLAG_ZERO_PADDED))
+    memset (mem->data + params->prefix + size, 0, params->padding);
+
+  return GST_MEMORY_CAST (mem);
+}
+
+/**
+ * @brief free function of tensor allocator
+ */
+static void
+_free (GstAllocator * allocator, GstMemory * memory)
+{
+  GstTensorAllocMemory *mem = (GstTensorAllocMemory *) memory;
+
+  UNUSED (allocator);
+
+  if (mem->block)
+    g_atomic_pointer_add (&tensor_alloc_pool.in_use,
+        -((gssize) mem->block_size));
+
+  if (mem->block && mem->size_class >= 0 && gst_tensor_allocator_pooled) {
+    _pool_push (mem);
+    return;
+  }
+
+  _release_memory (mem);
+}
+
+/**
+ * @brief map function of tensor allocator
+ */
+static gpointer
+_mem_map (GstMemory * memory, gsize maxsize, GstMapFlags flags)
+{
+  UNUSED (maxsize);
+  UNUSED (flags);
+
+  return ((GstTensorAllocMemory *) memory)->data;
+}
+
+/**
+ * @brief unmap function of tensor allocator
+ */
+static gboolean
+_mem_unmap (GstMemory * memory)
+{
+  UNUSED (memory);
+  return TRUE;
+}
+
+/**
+ * @brief share function of tensor allocator
+ */
+static GstMemory *
+_mem_share (GstMemory * memory, gssize offset, gsize size)
+{
+  GstTensorAllocMemory *mem = (GstTensorAllocMemory *) memory;
+  GstTensorAllocMemory *sub;
+  GstMemory *parent;
+
+  /* find the real parent */
+  if ((parent = memory->parent) == NULL)
+    parent = memory;
+
+  if (size == (gsize) - 1)
+    size = memory->size - offset;
+
+  sub = g_new0 (GstTensorAllocMemory, 1);
+  sub->data = mem->data;
+  sub->size_class = -1;
+  sub->node = mem->node;
+
+  /* the shared memory is always read-only */
+  _init_memory (sub, GST_MINI_OBJECT_FLAGS (parent) |
+      GST_MINI_OBJECT_FLAG_LOCK_READONLY, memory->allocator, parent,
+      memory->maxsize, memory->align, memory->offset + offset, size);
+
+  return GST_MEMORY_CAST (sub);
+}
+
+/**
+ * @brief copy function of tensor allocator
+ */
+static GstMemory *
+_mem_copy (GstMemory * memory, gssize offset, gsize size)
+{
+  GstTensorAllocMemory *mem = (GstTensorAllocMemory *) memory;
+  GstAllocationParams params = { 0, memory->align, 0, 0, };
+  GstMemory *copy;
+  GstMapInfo map;
+
+  if (size == (gsize) - 1)
+    size = (memory->size > (gsize) offset) ? memory->size - offset : 0;
+
+  copy = _alloc (memory->allocator, size, &params);
+  if (copy && gst_memory_map (copy, &map, GST_MAP_WRITE)) {
+    memcpy (map.data, mem->data + memory->offset + offset, size);
+    gst_memory_unmap (copy, &map);
+  }
+
+  return copy;
+}
+
+/**
+ * @brief is_span function of tensor allocator
+ */
+static gboolean
+_mem_is_span (GstMemory * mem1, GstMemory * mem2, gsize * offset)
+{
+  GstTensorAllocMemory *m1 = (GstTensorAllocMemory *) mem1;
+  GstTensorAllocMemory *m2 = (GstTensorAllocMemory *) mem2;
+
+  if (offset)
+    *offset = mem1->offset - mem1->parent->offset;
+
+  /* check if memory is contiguous */
+  return (m1->data + mem1->offset + mem1->size == m2->data + mem2->offset);
+}
+
+/**
+ * @brief get property of tensor allocator
+ */
+static void
+gst_tensor_allocator_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  switch (prop_id) {
+    case PROP_PRESSURE:
+      g_value_set_int (value, (gint) gst_tensor_alloc_get_pressure ());
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/**
+ * @brief handler of the action signal to account the bytes held by the owner
+ */
+static void
+gst_tensor_allocator_account (GstTensorAllocator * allocator,
+    gpointer owner, gint64 bytes)
+{
+  UNUSED (allocator);
+
+  gst_tensor_alloc_account (owner, bytes);
 }
 
 /**
@@ -67,17 +645,42 @@ _alloc (GstAllocator * allocator, gsize size, GstAllocationParams * params)
 static void
 gst_tensor_allocator_class_init (GstTensorAllocatorClass * klass)
 {
-  GstAllocatorClass *allocator_class, *sysmem_aclass;
-  GstAllocator *sysmem_alloc;
+  GObjectClass *gobject_class;
+  GstAllocatorClass *allocator_class;
 
+  gobject_class = (GObjectClass *) klass;
   allocator_class = (GstAllocatorClass *) klass;
-  sysmem_alloc = gst_allocator_find (GST_ALLOCATOR_SYSMEM);
-  sysmem_aclass = GST_ALLOCATOR_GET_CLASS (sysmem_alloc);
+
+  gobject_class->get_property = gst_tensor_allocator_get_property;
 
   allocator_class->alloc = _alloc;
-  allocator_class->free = sysmem_aclass->free;
+  allocator_class->free = _free;
+
+  /**
+   * GstTensorAllocator::pressure:
+   *
+   * The memory pressure (GstTensorMemPressure), for the plugins which find
+   * the allocator with gst_allocator_find() instead of linking nnstreamer.
+   */
+  g_object_class_install_property (gobject_class, PROP_PRESSURE,
+      g_param_spec_int ("pressure", "Pressure",
+          "The memory pressure against the watermarks (0: none, 1: throttle, 2: drop)",
+          GST_TENSOR_MEM_PRESSURE_NONE, GST_TENSOR_MEM_PRESSURE_DROP,
+          GST_TENSOR_MEM_PRESSURE_NONE,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
-  gst_object_unref (sysmem_alloc);
+  /**
+   * GstTensorAllocator::account:
+   * @owner: the owner of the memory
+   * @bytes: the bytes to add (negative to release)
+   *
+   * Action signal to account the bytes held by the owner, same as gst_tensor_alloc_account().
+   */
+  gst_tensor_allocator_signals[SIGNAL_ACCOUNT] =
+      g_signal_new_class_handler ("account", G_TYPE_FROM_CLASS (klass),
+      G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION,
+      G_CALLBACK (gst_tensor_allocator_account), NULL, NULL, NULL,
+      G_TYPE_NONE, 2, G_TYPE_POINTER, G_TYPE_INT64);
 }
 
 /**
@@ -86,19 +689,16 @@ gst_tensor_allocator_class_init (GstTensorAllocatorClass * klass)
 static void
 gst_tensor_allocator_init (GstTensorAllocator * allocator)
 {
-  GstAllocator *sysmem_alloc, *alloc;
+  GstAllocator *alloc;
 
   alloc = GST_ALLOCATOR_CAST (allocator);
-  sysmem_alloc = gst_allocator_find (GST_ALLOCATOR_SYSMEM);
 
-  alloc->mem_type = sysmem_alloc->mem_type;
-  alloc->mem_map = sysmem_alloc->mem_map;
-  alloc->mem_unmap = sysmem_alloc->mem_unmap;
-  alloc->mem_copy = sysmem_alloc->mem_copy;
-  alloc->mem_share = sysmem_alloc->mem_share;
-  alloc->mem_is_span = sysmem_alloc->mem_is_span;
-
-  gst_object_unref (sysmem_alloc);
+  alloc->mem_type = GST_TENSOR_ALLOCATOR;
+  alloc->mem_map = _mem_map;
+  alloc->mem_unmap = _mem_unmap;
+  alloc->mem_copy = _mem_copy;
+  alloc->mem_share = _mem_share;
+  alloc->mem_is_span = _mem_is_span;
 }
 
 /**
@@ -107,14 +707,33 @@ gst_tensor_allocator_init (GstTensorAllocator * allocator)
  */
 void
 gst_tensor_alloc_init (gsize alignment)
+{
+  gst_tensor_alloc_init_full (alignment, gst_tensor_allocator_pooled,
+      gst_tensor_allocator_hugepage);
+}
+
+/**
+ * @brief set alignment and pool options of the default allocator
+ * @param alignment bytes of alignment
+ * @param pooled TRUE to reuse the freed memory chunks with size-class free lists
+ * @param hugepage TRUE to back the large memory chunks (>= 2 MiB) with hugepages
+ */
+void
+gst_tensor_alloc_init_full (gsize alignment, gboolean pooled,
+    gboolean hugepage)
 {
   GstAllocator *allocator;
 
   gst_tensor_allocator_alignment = alignment;
+  gst_tensor_allocator_pooled = pooled;
+  gst_tensor_allocator_hugepage = hugepage;
 
-  /* no alignment */
-  if (alignment == 0) {
-    gst_allocator_set_default (gst_allocator_find (GST_ALLOCATOR_SYSMEM));
+  /* no alignment, no pool, no NUMA node and no memory budget */
+  if (alignment == 0 && !pooled && !hugepage && !gst_tensor_allocator_numa &&
+      tensor_alloc_budget.low_watermark == 0 &&
+      tensor_alloc_budget.high_watermark == 0) {
+    allocator = gst_allocator_find (GST_ALLOCATOR_SYSMEM);
+    gst_allocator_set_default (allocator);
     return;
   }
 
@@ -126,3 +745,169 @@ gst_tensor_alloc_init (gsize alignment)
   }
   gst_allocator_set_default (allocator);
 }
+
+/**
+ * @brief set the NUMA node of the memory allocated in the calling thread
+ * @param node the NUMA node, -1 to allocate the memory without binding
+ * @note The tensor allocator becomes the default allocator if the node is given.
+ */
+void
+gst_tensor_alloc_set_thread_node (gint node)
+{
+  GstTensorAllocThreadCache *cache;
+
+  if (node >= TENSOR_ALLOC_MAX_NODES) {
+    nns_logw ("NUMA node %d is not supported by the tensor allocator (max %d).",
+        node, TENSOR_ALLOC_MAX_NODES - 1);
+    node = -1;
+  }
+
+  if (node < 0)
+    node = -1;
+
+  if (_get_thread_node () == node)
+    return;
+
+  /* the cached memory chunks belong to the previous node */
+  cache = g_private_get (&tensor_alloc_thread_cache);
+  if (cache) {
+    _thread_cache_flush (cache);
+    cache->node = node;
+  }
+
+  g_private_set (&tensor_alloc_thread_node, GINT_TO_POINTER (node + 1));
+
+  if (node >= 0 && !gst_tensor_allocator_numa) {
+    gst_tensor_allocator_numa = TRUE;
+    gst_tensor_alloc_init_full (gst_tensor_allocator_alignment,
+        gst_tensor_allocator_pooled, gst_tensor_allocator_hugepage);
+  }
+}
+
+/**
+ * @brief set the watermarks of the memory budget
+ * @param low bytes over which the sources throttle the incoming data (0 to disable)
+ * @param high bytes over which the sources drop the incoming data (0 to disable)
+ * @note The tensor allocator becomes the default allocator to count the bytes in use.
+ */
+void
+gst_tensor_alloc_set_watermarks (guint64 low, guint64 high)
+{
+  g_mutex_lock (&tensor_alloc_budget.lock);
+  tensor_alloc_budget.low_watermark = low;
+  tensor_alloc_budget.high_watermark = high;
+  g_mutex_unlock (&tensor_alloc_budget.lock);
+
+  gst_tensor_alloc_init_full (gst_tensor_allocator_alignment,
+      gst_tensor_allocator_pooled, gst_tensor_allocator_hugepage);
+}
+
+/**
+ * @brief account the bytes held by the owner (e.g., the data in the receive queue of an element)
+ * @param owner the owner of the memory
+ * @param bytes the bytes to add, negative to release
+ * @note Account the memory which is not allocated by the tensor allocator, such as the data received from the network.
+ */
+void
+gst_tensor_alloc_account (gconstpointer owner, gint64 bytes)
+{
+  gint64 *held;
+
+  g_return_if_fail (owner != NULL);
+
+  if (bytes == 0)
+    return;
+
+  g_mutex_lock (&tensor_alloc_budget.lock);
+  if (!tensor_alloc_budget.owners) {
+    tensor_alloc_budget.owners = g_hash_table_new_full (g_direct_hash,
+        g_direct_equal, NULL, g_free);
+  }
+
+  held = g_hash_table_lookup (tensor_alloc_budget.owners, owner);
+  if (!held) {
+    held = g_new0 (gint64, 1);
+    g_hash_table_insert (tensor_alloc_budget.owners, (gpointer) owner, held);
+  }
+
+  /* do not release more than the owner holds */
+  if (bytes < 0 && -bytes > *held)
+    bytes = -(*held);
+
+  *held += bytes;
+  g_atomic_pointer_add (&tensor_alloc_budget.held, (gssize) bytes);
+
+  if (*held == 0)
+    g_hash_table_remove (tensor_alloc_budget.owners, owner);
+  g_mutex_unlock (&tensor_alloc_budget.lock);
+}
+
+/**
+ * @brief get the bytes held by the owner
+ * @param owner the owner of the memory
+ * @return the bytes accounted with gst_tensor_alloc_account
+ */
+guint64
+gst_tensor_alloc_get_held (gconstpointer owner)
+{
+  gint64 *held = NULL;
+  guint64 bytes = 0;
+
+  g_return_val_if_fail (owner != NULL, 0);
+
+  g_mutex_lock (&tensor_alloc_budget.lock);
+  if (tensor_alloc_budget.owners)
+    held = g_hash_table_lookup (tensor_alloc_budget.owners, owner);
+  if (held)
+    bytes = (guint64) (*held);
+  g_mutex_unlock (&tensor_alloc_budget.lock);
+
+  return bytes;
+}
+
+/**
+ * @brief get the memory pressure against the watermarks
+ * @return the memory pressure, the sources should throttle or drop the incoming data if it is not GST_TENSOR_MEM_PRESSURE_NONE.
+ */
+GstTensorMemPressure
+gst_tensor_alloc_get_pressure (void)
+{
+  guint64 used, low, high;
+
+  low = tensor_alloc_budget.low_watermark;
+  high = tensor_alloc_budget.high_watermark;
+  if (low == 0 && high == 0)
+    return GST_TENSOR_MEM_PRESSURE_NONE;
+
+  used = (guint64) (gsize) g_atomic_pointer_get (&tensor_alloc_pool.in_use) +
+      (guint64) (gsize) g_atomic_pointer_get (&tensor_alloc_budget.held);
+
+  if (high > 0 && used >= high)
+    return GST_TENSOR_MEM_PRESSURE_DROP;
+  if (low > 0 && used >= low)
+    return GST_TENSOR_MEM_PRESSURE_THROTTLE;
+
+  return GST_TENSOR_MEM_PRESSURE_NONE;
+}
+
+/**
+ * @brief Get the statistics of the tensor allocator.
+ * @param[out] stats the statistics to be filled
+ */
+void
+gst_tensor_alloc_get_stats (GstTensorAllocatorStats * stats)
+{
+  g_return_if_fail (stats != NULL);
+
+  stats->hits = (guint64) (gsize) g_atomic_pointer_get (&tensor_alloc_pool.hits);
+  stats->misses =
+      (guint64) (gsize) g_atomic_pointer_get (&tensor_alloc_pool.misses);
+  stats->resident_bytes =
+      (guint64) (gsize) g_atomic_pointer_get (&tensor_alloc_pool.resident);
+  stats->cached_bytes =
+      (guint64) (gsize) g_atomic_pointer_get (&tensor_alloc_pool.cached_total);
+  stats->in_use_bytes =
+      (guint64) (gsize) g_atomic_pointer_get (&tensor_alloc_pool.in_use);
+  stats->held_bytes =
+      (guint64) (gsize) g_atomic_pointer_get (&tensor_alloc_budget.held);
+}
@@ -0,0 +1,200 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file    tensor_buffer_pool.c
+ * @date    14 Oct 2026
+ * @brief   Internal buffer pool for static tensor streams
+ * @author  agent <agent@local>
+ * @see     http://github.com/nnstreamer/nnstreamer
+ * @bug     No known bugs
+ *
+ * The default GstBufferPool allocates a single memory chunk per buffer.
+ * Tensor streams (other/tensors) have a memory chunk for each tensor,
+ * so this pool allocates the memory chunks from the configured caps.
+ */
+
+#include <nnstreamer_log.h>
+#include <nnstreamer_plugin_api.h>
+#include <nnstreamer_util.h>
+#include "tensor_buffer_pool.h"
+
+#define gst_tensor_buffer_pool_parent_class parent_class
+G_DEFINE_TYPE (GstTensorBufferPool, gst_tensor_buffer_pool,
+    GST_TYPE_BUFFER_POOL);
+
+/**
+ * @brief Configure the pool with the caps of static tensors.
+ */
+static gboolean
+gst_tensor_buffer_pool_set_config (GstBufferPool * pool, GstStructure * config)
+{
+  GstTensorBufferPool *self = GST_TENSOR_BUFFER_POOL (pool);
+  GstTensorsConfig tensors_config;
+  GstCaps *caps;
+  GstAllocator *allocator = NULL;
+  GstAllocationParams params;
+  guint size, min, max, i;
+  gsize total = 0;
+  gboolean ret = FALSE;
+
+  if (!gst_buffer_pool_config_get_params (config, &caps, &size, &min, &max)) {
+    nns_loge ("Invalid config for the tensor buffer pool.");
+    return FALSE;
+  }
+
+  if (caps == NULL) {
+    nns_loge ("The tensor buffer pool requires the caps of static tensors.");
+    return FALSE;
+  }
+
+  gst_tensors_config_init (&tensors_config);
+  if (!gst_tensors_config_from_structure (&tensors_config,
+          gst_caps_get_structure (caps, 0)) ||
+      !gst_tensors_config_validate (&tensors_config) ||
+      !gst_tensors_config_is_static (&tensors_config)) {
+    nns_loge ("The tensor buffer pool supports the static tensors only.");
+    goto done;
+  }
+
+  for (i = 0; i < tensors_config.info.num_tensors; i++)
+    total += gst_tensor_info_get_size (&tensors_config.info.info[i]);
+
+  if (!gst_buffer_pool_config_get_allocator (config, &allocator, &params)) {
+    allocator = NULL;
+    gst_allocation_params_init (&params);
+  }
+
+  if (self->allocator)
+    gst_object_unref (self->allocator);
+  self->allocator = allocator ? gst_object_ref (allocator) : NULL;
+  self->params = params;
+
+  gst_tensors_info_free (&self->info);
+  gst_tensors_info_copy (&self->info, &tensors_config.info);
+
+  /* the size of the buffer is the sum of the tensors */
+  gst_buffer_pool_config_set_params (config, caps, (guint) total, min, max);
+  ret = GST_BUFFER_POOL_CLASS (parent_class)->set_config (pool, config);
+
+done:
+  gst_tensors_config_free (&tensors_config);
+  return ret;
+}
+
+/**
+ * @brief Allocate a buffer with a memory chunk for each tensor.
+ */
+static GstFlowReturn
+gst_tensor_buffer_pool_alloc_buffer (GstBufferPool * pool, GstBuffer ** buffer,
+    GstBufferPoolAcquireParams * params)
+{
+  GstTensorBufferPool *self = GST_TENSOR_BUFFER_POOL (pool);
+  GstBuffer *buf;
+  GstMemory *mem;
+  gsize size;
+  guint i;
+
+  UNUSED (params);
+  buf = gst_buffer_new ();
+
+  for (i = 0; i < self->info.num_tensors; i++) {
+    size = gst_tensor_info_get_size (&self->info.info[i]);
+    mem = gst_allocator_alloc (self->allocator, size, &self->params);
+
+    if (!mem) {
+      nns_loge ("Failed to allocate the memory (%zu bytes) of the %u-th tensor.",
+          size, i);
+      gst_buffer_unref (buf);
+      return GST_FLOW_ERROR;
+    }
+
+    gst_buffer_append_memory (buf, mem);
+  }
+
+  *buffer = buf;
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Release a buffer only if the memory chunks are not changed.
+ */
+static void
+gst_tensor_buffer_pool_release_buffer (GstBufferPool * pool, GstBuffer * buffer)
+{
+  GstTensorBufferPool *self = GST_TENSOR_BUFFER_POOL (pool);
+
+  /* the memory chunks may be removed or replaced by other (e.g., combination) */
+  if (gst_buffer_n_memory (buffer) != self->info.num_tensors)
+    GST_BUFFER_FLAG_SET (buffer, GST_BUFFER_FLAG_TAG_MEMORY);
+
+  GST_BUFFER_POOL_CLASS (parent_class)->release_buffer (pool, buffer);
+}
+
+/**
+ * @brief Finalize the tensor buffer pool.
+ */
+static void
+gst_tensor_buffer_pool_finalize (GObject * object)
+{
+  GstTensorBufferPool *self = GST_TENSOR_BUFFER_POOL (object);
+
+  if (self->allocator)
+    gst_object_unref (self->allocator);
+  gst_tensors_info_free (&self->info);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+/**
+ * @brief Initialize the class of tensor buffer pool.
+ */
+static void
+gst_tensor_buffer_pool_class_init (GstTensorBufferPoolClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+  GstBufferPoolClass *pool_class = GST_BUFFER_POOL_CLASS (klass);
+
+  gobject_class->finalize = gst_tensor_buffer_pool_finalize;
+
+  pool_class->set_config = gst_tensor_buffer_pool_set_config;
+  pool_class->alloc_buffer = gst_tensor_buffer_pool_alloc_buffer;
+  pool_class->release_buffer = gst_tensor_buffer_pool_release_buffer;
+}
+
+/**
+ * @brief Initialize the tensor buffer pool.
+ */
+static void
+gst_tensor_buffer_pool_init (GstTensorBufferPool * self)
+{
+  gst_tensors_info_init (&self->info);
+  self->allocator = NULL;
+  gst_allocation_params_init (&self->params);
+}
+
+/**
+ * @brief Create a new buffer pool for static tensor streams.
+ */
+GstBufferPool *
+gst_tensor_buffer_pool_new (void)
+{
+  GstBufferPool *pool;
+
+  pool = GST_BUFFER_POOL_CAST (g_object_new (GST_TYPE_TENSOR_BUFFER_POOL,
+          NULL));
+  gst_object_ref_sink (pool);
+
+  return pool;
+}
+
+/**
+ * @brief Check the buffer has the memory chunks allocated by the tensor buffer pool.
+ */
+gboolean
+gst_tensor_buffer_pool_is_pooled (GstBuffer * buffer)
+{
+  g_return_val_if_fail (GST_IS_BUFFER (buffer), FALSE);
+
+  return (buffer->pool != NULL && GST_IS_TENSOR_BUFFER_POOL (buffer->pool));
+}
@@ -0,0 +1,72 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file    tensor_buffer_pool.h
+ * @date    14 Oct 2026
+ * @brief   Internal buffer pool for static tensor streams
+ * @author  agent <agent@local>
+ * @see     http://github.com/nnstreamer/nnstreamer
+ * @bug     No known bugs
+ *
+ */
+#ifndef __GST_TENSOR_BUFFER_POOL_H__
+#define __GST_TENSOR_BUFFER_POOL_H__
+
+#include <gst/gst.h>
+#include <tensor_typedef.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_TENSOR_BUFFER_POOL (gst_tensor_buffer_pool_get_type ())
+#define GST_TENSOR_BUFFER_POOL(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST ((obj), GST_TYPE_TENSOR_BUFFER_POOL, GstTensorBufferPool))
+#define GST_IS_TENSOR_BUFFER_POOL(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE ((obj), GST_TYPE_TENSOR_BUFFER_POOL))
+
+typedef struct _GstTensorBufferPool GstTensorBufferPool;
+typedef struct _GstTensorBufferPoolClass GstTensorBufferPoolClass;
+
+/**
+ * @brief Buffer pool allocating a memory chunk for each tensor.
+ *
+ * The buffers have the memory chunks of the tensors in the caps (static tensors only),
+ * and return to the pool when downstream releases them.
+ */
+struct _GstTensorBufferPool
+{
+  GstBufferPool parent; /**< parent object */
+
+  GstTensorsInfo info; /**< tensors info from the configured caps */
+  GstAllocator *allocator; /**< allocator for the memory chunks (NULL for default) */
+  GstAllocationParams params; /**< parameters for the memory chunks */
+};
+
+/**
+ * @brief GstTensorBufferPoolClass data structure.
+ */
+struct _GstTensorBufferPoolClass
+{
+  GstBufferPoolClass parent_class; /**< parent class */
+};
+
+/**
+ * @brief Get type of GstTensorBufferPool.
+ */
+GType gst_tensor_buffer_pool_get_type (void);
+
+/**
+ * @brief Create a new buffer pool for static tensor streams.
+ * @return a new GstBufferPool. Caller should unref the pool.
+ */
+extern GstBufferPool *
+gst_tensor_buffer_pool_new (void);
+
+/**
+ * @brief Check the buffer has the memory chunks allocated by the tensor buffer pool.
+ */
+extern gboolean
+gst_tensor_buffer_pool_is_pooled (GstBuffer * buffer);
+
+G_END_DECLS
+#endif /* __GST_TENSOR_BUFFER_POOL_H__ */
@@ -55,6 +55,61 @@
 
 G_BEGIN_DECLS
 
+/**
+ * @brief The counters of an element (see GstTensorElementProfile).
+ */
+typedef enum
+{
+  GST_TENSOR_PROFILE_MEMCPY = 0,
+  GST_TENSOR_PROFILE_ALLOC,
+  GST_TENSOR_PROFILE_COMPUTE,
+} GstTensorElementProfileType;
+
+/**
+ * @brief Add the value to the counter of the element. Use the nns_profile_* macros instead.
+ */
+extern void
+gst_tensor_element_profile_add (GstElement * element, GstTensorElementProfileType type, guint64 value);
+
+/**
+ * @brief Get the monotonic time in nanoseconds for the compute time. Use the nns_profile_* macros instead.
+ */
+extern guint64
+gst_tensor_element_profile_now (void);
+
+/**
+ * @brief Macros to count the copy, allocation and compute time of the element (-Denable-element-profile=true).
+ * They are compiled out if the profile is disabled.
+ * nns_profile_memcpy (e, d, s, n): nns_memcpy and count n bytes.
+ * nns_profile_copied (e, n): count n bytes copied by the element itself (e.g., the rows of a frame).
+ * nns_profile_alloc (e, n): count the allocation of n bytes.
+ * nns_profile_declare (ts): declare the variable of the start time.
+ * nns_profile_compute_begin (ts) / nns_profile_compute_end (e, ts): count the time in between.
+ */
+#ifdef ENABLE_ELEMENT_PROFILE
+#define nns_profile_memcpy(e,d,s,n) do { \
+    gsize _nns_n = (n); \
+    nns_memcpy ((d), (s), _nns_n); \
+    gst_tensor_element_profile_add (GST_ELEMENT_CAST (e), GST_TENSOR_PROFILE_MEMCPY, _nns_n); \
+  } while (0)
+#define nns_profile_copied(e,n) \
+    gst_tensor_element_profile_add (GST_ELEMENT_CAST (e), GST_TENSOR_PROFILE_MEMCPY, (n))
+#define nns_profile_alloc(e,n) \
+    gst_tensor_element_profile_add (GST_ELEMENT_CAST (e), GST_TENSOR_PROFILE_ALLOC, (n))
+#define nns_profile_declare(ts) guint64 ts = 0
+#define nns_profile_compute_begin(ts) do { ts = gst_tensor_element_profile_now (); } while (0)
+#define nns_profile_compute_end(e,ts) \
+    gst_tensor_element_profile_add (GST_ELEMENT_CAST (e), GST_TENSOR_PROFILE_COMPUTE, \
+        gst_tensor_element_profile_now () - (ts))
+#else
+#define nns_profile_memcpy(e,d,s,n) nns_memcpy ((d), (s), (n))
+#define nns_profile_copied(e,n) do { } while (0)
+#define nns_profile_alloc(e,n) do { } while (0)
+#define nns_profile_declare(ts) G_GNUC_UNUSED guint64 ts = 0
+#define nns_profile_compute_begin(ts) do { } while (0)
+#define nns_profile_compute_end(e,ts) do { } while (0)
+#endif
+
 /**
  * @brief time synchronization options
  * @see https://github.com/nnstreamer/nnstreamer/wiki/Synchronization-Policies-at-Mux-and-Merge
@@ -95,6 +150,9 @@ typedef struct
   GstCollectData collect;
   GstBuffer *buffer;
   GstPad *pad;
+  GstCaps *caps; /**< current caps of the pad, the config is parsed only when the caps is changed */
+  GstTensorsConfig config; /**< tensors config from the current caps */
+  gboolean configured; /**< TRUE if the config is valid */
 } GstTensorCollectPadData;
 
 /**
@@ -152,6 +210,14 @@ gst_tensor_time_sync_get_current_time (GstCollectPads * collect, tensor_time_syn
 extern void
 gst_tensor_time_sync_flush (GstCollectPads * collect);
 
+/**
+ * @brief A function to release the pad data of mux / merge.
+ * Set this as the destroy notify when adding the pad (gst_collect_pads_add_pad).
+ * @param data Collect data (GstTensorCollectPadData).
+ */
+extern void
+gst_tensor_time_sync_pad_data_free (GstCollectData * data);
+
 /**
  * @brief  A function call to make tensors from collected pads
  * It decide which buffer is going to be used according to sync option.
@@ -11,7 +11,9 @@
  */
 
 #include <math.h>
+#include <string.h>
 #include "tensor_data.h"
+#include "tensor_kernels.h"
 #include "nnstreamer_log.h"
 #include "nnstreamer_plugin_api.h"
 
@@ -304,143 +306,649 @@ gst_tensor_data_raw_typecast (gpointer input, tensor_type in_type,
 }
 
 /**
- * @brief Calculate average value of the tensor.
+ * @brief The number of elements converted to double at once to calculate the statistics.
+ */
+#define TD_STATS_BLOCK (1024)
+
+/**
+ * @brief Macro to convert the raw data to double (typed loop, vectorized by the compiler).
+ */
+#define td_raw_to_double(raw,buf,n,itype) do { \
+    const itype *_p = (const itype *) (raw); \
+    gsize _k; \
+    for (_k = 0; _k < (n); _k++) \
+      (buf)[_k] = (gdouble) _p[_k]; \
+  } while (0)
+
+/**
+ * @brief Convert the block of raw tensor data to double.
+ */
+static gboolean
+td_raw_block_to_double (gconstpointer raw, tensor_type type, gdouble * buf,
+    gsize n)
+{
+  switch (type) {
+    case _NNS_INT32:
+      td_raw_to_double (raw, buf, n, int32_t);
+      break;
+    case _NNS_UINT32:
+      td_raw_to_double (raw, buf, n, uint32_t);
+      break;
+    case _NNS_INT16:
+      td_raw_to_double (raw, buf, n, int16_t);
+      break;
+    case _NNS_UINT16:
+      td_raw_to_double (raw, buf, n, uint16_t);
+      break;
+    case _NNS_INT8:
+      td_raw_to_double (raw, buf, n, int8_t);
+      break;
+    case _NNS_UINT8:
+      td_raw_to_double (raw, buf, n, uint8_t);
+      break;
+    case _NNS_FLOAT64:
+      memcpy (buf, raw, n * sizeof (gdouble));
+      break;
+    case _NNS_FLOAT32:
+      td_raw_to_double (raw, buf, n, float);
+      break;
+#ifdef FLOAT16_SUPPORT
+    case _NNS_FLOAT16:
+      td_raw_to_double (raw, buf, n, float16);
+      break;
+#endif
+    case _NNS_INT64:
+      td_raw_to_double (raw, buf, n, int64_t);
+      break;
+    case _NNS_UINT64:
+      td_raw_to_double (raw, buf, n, uint64_t);
+      break;
+    default:
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Get the sum of the elements with the stride (4 independent partial sums).
+ */
+static inline gdouble
+td_block_sum (const gdouble * buf, gsize n, gsize stride)
+{
+  gdouble s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+  gsize k = 0;
+
+  if (stride == 1) {
+    for (; k + 4 <= n; k += 4) {
+      s0 += buf[k];
+      s1 += buf[k + 1];
+      s2 += buf[k + 2];
+      s3 += buf[k + 3];
+    }
+  }
+
+  for (k *= stride; k < n * stride; k += stride)
+    s0 += buf[k];
+
+  return (s0 + s1) + (s2 + s3);
+}
+
+/**
+ * @brief Get the sum of the squared deviations from the mean with the stride.
+ */
+static inline gdouble
+td_block_sum_sq (const gdouble * buf, gsize n, gsize stride, gdouble mean)
+{
+  gdouble s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0, d0, d1, d2, d3;
+  gsize k = 0;
+
+  if (stride == 1) {
+    for (; k + 4 <= n; k += 4) {
+      d0 = buf[k] - mean;
+      d1 = buf[k + 1] - mean;
+      d2 = buf[k + 2] - mean;
+      d3 = buf[k + 3] - mean;
+      s0 += d0 * d0;
+      s1 += d1 * d1;
+      s2 += d2 * d2;
+      s3 += d3 * d3;
+    }
+  }
+
+  for (k *= stride; k < n * stride; k += stride) {
+    d0 = buf[k] - mean;
+    s0 += d0 * d0;
+  }
+
+  return (s0 + s1) + (s2 + s3);
+}
+
+/**
+ * @brief Calculate the average and standard deviation of each channel in a single pass.
  * @param raw pointer of raw tensor data
  * @param length byte size of raw tensor data
  * @param type tensor type
- * @param result double pointer for average value of given tensor. Caller should release allocated memory.
+ * @param channels the number of channels (the first dim, 1 for the whole tensor)
+ * @param averages double array contains average values of each channel. Caller should release allocated array.
+ * @param stds double array contains standard deviation of each channel (NULL to skip). Caller should release allocated array.
  * @return TRUE if no error
  */
 gboolean
-gst_tensor_data_raw_average (gpointer raw, gsize length, tensor_type type,
-    gdouble ** result)
+gst_tensor_data_raw_stats (gpointer raw, gsize length, tensor_type type,
+    guint channels, gdouble ** averages, gdouble ** stds)
 {
-  gdouble value, average;
-  gulong i, num;
-  gsize element_size;
-  guint8 *data;
+  gdouble *buf, *m2;
+  gdouble mean, sum, delta;
+  gsize element_size, num, block, offset, len, n, count;
+  guint ch;
 
   g_return_val_if_fail (raw != NULL, FALSE);
   g_return_val_if_fail (length > 0, FALSE);
+  g_return_val_if_fail (channels > 0, FALSE);
   g_return_val_if_fail (type != _NNS_END, FALSE);
+  g_return_val_if_fail (averages != NULL, FALSE);
 
   element_size = gst_tensor_get_element_size (type);
-  num = length / element_size;
+  num = (length / element_size / channels) * channels;
+  g_return_val_if_fail (num > 0, FALSE);
 
-  average = 0.0;
-  *result = (gdouble *) g_try_malloc0 (sizeof (gdouble));
-  if (*result == NULL) {
-    nns_loge ("Failed to allocate memory for calculating average");
-    return FALSE;
+  /* the block has the whole channels */
+  block = MAX (1, TD_STATS_BLOCK / channels) * channels;
+
+  buf = (gdouble *) g_try_malloc (sizeof (gdouble) * block);
+  m2 = (gdouble *) g_try_malloc0 (sizeof (gdouble) * channels);
+  *averages = (gdouble *) g_try_malloc0 (sizeof (gdouble) * channels);
+  if (stds)
+    *stds = (gdouble *) g_try_malloc0 (sizeof (gdouble) * channels);
+
+  if (!buf || !m2 || *averages == NULL || (stds && *stds == NULL)) {
+    nns_loge ("Failed to allocate memory for calculating the statistics");
+    goto error;
   }
 
-  for (i = 0; i < num; ++i) {
-    /* extract value and typecast to double */
-    data = (guint8 *) raw + element_size * i;
-    gst_tensor_data_raw_typecast (data, type, &value, _NNS_FLOAT64);
+  /**
+   * Each block (in the cache) is reduced to the mean and the sum of squared deviations,
+   * then merged to the running values (Chan et al.), which is as stable as Welford's method.
+   */
+  for (offset = 0, count = 0; offset < num; offset += len, count += n) {
+    len = MIN (block, num - offset);
+    n = len / channels;
 
-    average = (value - average) / (i + 1) + average;
+    if (!td_raw_block_to_double ((guint8 *) raw + offset * element_size,
+            type, buf, len)) {
+      nns_loge ("Unsupported tensor type %d to calculate the statistics", type);
+      goto error;
+    }
+
+    for (ch = 0; ch < channels; ch++) {
+      sum = td_block_sum (buf + ch, n, channels);
+      mean = sum / n;
+      delta = mean - (*averages)[ch];
+
+      if (stds)
+        m2[ch] += td_block_sum_sq (buf + ch, n, channels, mean) +
+            delta * delta * ((gdouble) count * n / (count + n));
+      (*averages)[ch] += delta * n / (count + n);
+    }
   }
 
-  **result = average;
+  if (stds) {
+    for (ch = 0; ch < channels; ch++) {
+      (*stds)[ch] = sqrt (m2[ch] / count);
+      if ((*stds)[ch] == 0.0)
+        (*stds)[ch] = 1e-10;
+    }
+  }
 
+  g_free (buf);
+  g_free (m2);
   return TRUE;
+
+error:
+  g_free (buf);
+  g_free (m2);
+  g_free (*averages);
+  *averages = NULL;
+  if (stds) {
+    g_free (*stds);
+    *stds = NULL;
+  }
+  return FALSE;
 }
 
 /**
- * @brief Calculate average value of the tensor per channel (the first dim).
- * @param raw pointer of raw tensor data
- * @param length byte size of raw tensor data
- * @param type tensor type
- * @param tensor_dim tensor dimension
- * @param results double array contains average values of each channel. Caller should release allocated array.
- * @return TRUE if no error
+ * @brief Macro to get the sum of each channel (typed loop, vectorized by the compiler).
+ * The whole tensor is summed with 4 independent partial sums in the accumulator type.
  */
-gboolean
-gst_tensor_data_raw_average_per_channel (gpointer raw, gsize length,
-    tensor_type type, tensor_dim dim, gdouble ** results)
+#define td_sum_typed(raw,num,channels,itype,acc_t,sums) do { \
+    const itype *_p = (const itype *) (raw); \
+    gsize _k, _f, _frames = (num) / (channels); \
+    guint _c; \
+    if ((channels) == 1) { \
+      acc_t _s0 = 0, _s1 = 0, _s2 = 0, _s3 = 0; \
+      for (_k = 0; _k + 4 <= (num); _k += 4) { \
+        _s0 += (acc_t) _p[_k]; \
+        _s1 += (acc_t) _p[_k + 1]; \
+        _s2 += (acc_t) _p[_k + 2]; \
+        _s3 += (acc_t) _p[_k + 3]; \
+      } \
+      for (; _k < (num); _k++) \
+        _s0 += (acc_t) _p[_k]; \
+      (sums)[0] = (gdouble) ((_s0 + _s1) + (_s2 + _s3)); \
+    } else { \
+      for (_c = 0; _c < (channels); _c++) \
+        (sums)[_c] = 0.0; \
+      for (_f = 0; _f < _frames; _f++, _p += (channels)) { \
+        for (_c = 0; _c < (channels); _c++) \
+          (sums)[_c] += (gdouble) _p[_c]; \
+      } \
+    } \
+  } while (0)
+
+/**
+ * @brief Macro to get the min and max of each channel in the tensor type (typed loop, vectorized by the compiler).
+ * Same as the sequential search with '<' and '>' from the first element.
+ */
+#define td_min_max_typed(raw,num,channels,itype,type,mins,maxs) do { \
+    const itype *_p = (const itype *) (raw); \
+    gsize _f, _frames = (num) / (channels); \
+    guint _c; \
+    for (_c = 0; _c < (channels); _c++) { \
+      itype _v, _mn = _p[_c], _mx = _p[_c]; \
+      for (_f = 1; _f < _frames; _f++) { \
+        _v = _p[_f * (channels) + _c]; \
+        _mn = (_v < _mn) ? _v : _mn; \
+        _mx = (_v > _mx) ? _v : _mx; \
+      } \
+      if (mins) \
+        gst_tensor_data_set (&(mins)[_c], type, &_mn); \
+      if (maxs) \
+        gst_tensor_data_set (&(maxs)[_c], type, &_mx); \
+    } \
+  } while (0)
+
+/**
+ * @brief Macro to get the index of the first largest element of each channel.
+ */
+#define td_argmax_typed(raw,num,channels,itype,indices) do { \
+    const itype *_p = (const itype *) (raw); \
+    gsize _f, _idx, _frames = (num) / (channels); \
+    guint _c; \
+    for (_c = 0; _c < (channels); _c++) { \
+      itype _v, _mx = _p[_c]; \
+      for (_f = 1, _idx = 0; _f < _frames; _f++) { \
+        _v = _p[_f * (channels) + _c]; \
+        if (_v > _mx) { \
+          _mx = _v; \
+          _idx = _f; \
+        } \
+      } \
+      (indices)[_c] = _idx; \
+    } \
+  } while (0)
+
+/**
+ * @brief Internal function to get the number of the elements for the reduction.
+ * @return the number of elements (multiple of channels), 0 if invalid.
+ */
+static gsize
+td_reduce_get_num (gconstpointer raw, gsize length, tensor_type type,
+    guint channels)
 {
-  gdouble value, average;
-  gulong ch, i, num, offset;
   gsize element_size;
-  guint8 *data;
 
-  g_return_val_if_fail (raw != NULL, FALSE);
-  g_return_val_if_fail (length > 0, FALSE);
-  g_return_val_if_fail (dim[0] > 0, FALSE);
-  g_return_val_if_fail (type != _NNS_END, FALSE);
+  g_return_val_if_fail (raw != NULL, 0);
+  g_return_val_if_fail (channels > 0, 0);
+  g_return_val_if_fail (type != _NNS_END, 0);
 
   element_size = gst_tensor_get_element_size (type);
-  num = length / element_size;
+  if (element_size == 0)
+    return 0;
 
-  offset = dim[0];
-  num = num / offset;
-  *results = (gdouble *) g_try_malloc0 (sizeof (gdouble) * offset);
-  if (*results == NULL) {
-    nns_loge ("Failed to allocate memory for calculating average");
-    return FALSE;
+  return (length / element_size / channels) * channels;
+}
+
+/**
+ * @brief Get the sum of the elements of each channel.
+ */
+gboolean
+gst_tensor_data_raw_sum (gconstpointer raw, gsize length, tensor_type type,
+    guint channels, gdouble * sums)
+{
+  gsize num;
+
+  g_return_val_if_fail (sums != NULL, FALSE);
+
+  num = td_reduce_get_num (raw, length, type, channels);
+  g_return_val_if_fail (num > 0, FALSE);
+
+  switch (type) {
+    case _NNS_INT32:
+      td_sum_typed (raw, num, channels, int32_t, int64_t, sums);
+      break;
+    case _NNS_UINT32:
+      td_sum_typed (raw, num, channels, uint32_t, uint64_t, sums);
+      break;
+    case _NNS_INT16:
+      td_sum_typed (raw, num, channels, int16_t, int64_t, sums);
+      break;
+    case _NNS_UINT16:
+      td_sum_typed (raw, num, channels, uint16_t, uint64_t, sums);
+      break;
+    case _NNS_INT8:
+      td_sum_typed (raw, num, channels, int8_t, int64_t, sums);
+      break;
+    case _NNS_UINT8:
+      td_sum_typed (raw, num, channels, uint8_t, uint64_t, sums);
+      break;
+    case _NNS_FLOAT64:
+      td_sum_typed (raw, num, channels, double, double, sums);
+      break;
+    case _NNS_FLOAT32:
+      td_sum_typed (raw, num, channels, float, double, sums);
+      break;
+#ifdef FLOAT16_SUPPORT
+    case _NNS_FLOAT16:
+      td_sum_typed (raw, num, channels, float16, double, sums);
+      break;
+#endif
+    case _NNS_INT64:
+      td_sum_typed (raw, num, channels, int64_t, double, sums);
+      break;
+    case _NNS_UINT64:
+      td_sum_typed (raw, num, channels, uint64_t, double, sums);
+      break;
+    default:
+      nns_loge ("Unsupported tensor type %d to get the sum", type);
+      return FALSE;
   }
 
-  for (ch = 0; ch < offset; ++ch) {
-    average = 0.0;
-    for (i = 0; i < num; ++i) {
-      /* extract value and typecast to double */
-      data = (guint8 *) raw + element_size * ((i * offset) + ch);
-      gst_tensor_data_raw_typecast (data, type, &value, _NNS_FLOAT64);
-      average = (value - average) / (i + 1) + average;
-    }
+  return TRUE;
+}
+
+/**
+ * @brief Get the smallest and largest elements of each channel in the tensor type.
+ */
+gboolean
+gst_tensor_data_raw_min_max (gconstpointer raw, gsize length,
+    tensor_type type, guint channels, tensor_data_s * mins,
+    tensor_data_s * maxs)
+{
+  gsize num;
 
-    (*results)[ch] = average;
+  g_return_val_if_fail (mins != NULL || maxs != NULL, FALSE);
+
+  num = td_reduce_get_num (raw, length, type, channels);
+  g_return_val_if_fail (num > 0, FALSE);
+
+  switch (type) {
+    case _NNS_INT32:
+      td_min_max_typed (raw, num, channels, int32_t, type, mins, maxs);
+      break;
+    case _NNS_UINT32:
+      td_min_max_typed (raw, num, channels, uint32_t, type, mins, maxs);
+      break;
+    case _NNS_INT16:
+      td_min_max_typed (raw, num, channels, int16_t, type, mins, maxs);
+      break;
+    case _NNS_UINT16:
+      td_min_max_typed (raw, num, channels, uint16_t, type, mins, maxs);
+      break;
+    case _NNS_INT8:
+      td_min_max_typed (raw, num, channels, int8_t, type, mins, maxs);
+      break;
+    case _NNS_UINT8:
+      td_min_max_typed (raw, num, channels, uint8_t, type, mins, maxs);
+      break;
+    case _NNS_FLOAT64:
+      td_min_max_typed (raw, num, channels, double, type, mins, maxs);
+      break;
+    case _NNS_FLOAT32:
+      td_min_max_typed (raw, num, channels, float, type, mins, maxs);
+      break;
+#ifdef FLOAT16_SUPPORT
+    case _NNS_FLOAT16:
+      td_min_max_typed (raw, num, channels, float16, type, mins, maxs);
+      break;
+#endif
+    case _NNS_INT64:
+      td_min_max_typed (raw, num, channels, int64_t, type, mins, maxs);
+      break;
+    case _NNS_UINT64:
+      td_min_max_typed (raw, num, channels, uint64_t, type, mins, maxs);
+      break;
+    default:
+      nns_loge ("Unsupported tensor type %d to get the min and max", type);
+      return FALSE;
   }
 
   return TRUE;
 }
 
 /**
- * @brief Calculate standard deviation of the tensor.
- * @param raw pointer of raw tensor data
- * @param length byte size of raw tensor data
- * @param type tensor type
- * @param average average value of given tensor
- * @param result double pointer for standard deviation of given tensor. Caller should release allocated memory.
- * @return TRUE if no error
+ * @brief Get the index of the first largest element of each channel.
  */
 gboolean
-gst_tensor_data_raw_std (gpointer raw, gsize length, tensor_type type,
-    gdouble * average, gdouble ** result)
+gst_tensor_data_raw_argmax (gconstpointer raw, gsize length, tensor_type type,
+    guint channels, gsize * indices)
 {
-  gdouble value, std;
-  gulong i, num;
-  gsize element_size;
-  guint8 *data;
+  gsize num;
+  gfloat max;
 
-  g_return_val_if_fail (raw != NULL, FALSE);
-  g_return_val_if_fail (length > 0, FALSE);
-  g_return_val_if_fail (type != _NNS_END, FALSE);
+  g_return_val_if_fail (indices != NULL, FALSE);
+
+  num = td_reduce_get_num (raw, length, type, channels);
+  g_return_val_if_fail (num > 0, FALSE);
+
+  switch (type) {
+    case _NNS_INT32:
+      td_argmax_typed (raw, num, channels, int32_t, indices);
+      break;
+    case _NNS_UINT32:
+      td_argmax_typed (raw, num, channels, uint32_t, indices);
+      break;
+    case _NNS_INT16:
+      td_argmax_typed (raw, num, channels, int16_t, indices);
+      break;
+    case _NNS_UINT16:
+      td_argmax_typed (raw, num, channels, uint16_t, indices);
+      break;
+    case _NNS_INT8:
+      td_argmax_typed (raw, num, channels, int8_t, indices);
+      break;
+    case _NNS_UINT8:
+      td_argmax_typed (raw, num, channels, uint8_t, indices);
+      break;
+    case _NNS_FLOAT64:
+      td_argmax_typed (raw, num, channels, double, indices);
+      break;
+    case _NNS_FLOAT32:
+      if (channels == 1) {
+        /* SIMD kernel for the running CPU */
+        indices[0] = gst_tensor_kernels_get ()->f32_argmax (
+            (const gfloat *) raw, num, &max);
+      } else {
+        td_argmax_typed (raw, num, channels, float, indices);
+      }
+      break;
+#ifdef FLOAT16_SUPPORT
+    case _NNS_FLOAT16:
+      td_argmax_typed (raw, num, channels, float16, indices);
+      break;
+#endif
+    case _NNS_INT64:
+      td_argmax_typed (raw, num, channels, int64_t, indices);
+      break;
+    case _NNS_UINT64:
+      td_argmax_typed (raw, num, channels, uint64_t, indices);
+      break;
+    default:
+      nns_loge ("Unsupported tensor type %d to get the argmax", type);
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to get the sum of the squared deviations from the given mean of each channel.
+ */
+static gboolean
+td_raw_sum_sq (gconstpointer raw, gsize num, tensor_type type, guint channels,
+    const gdouble * means, gdouble * sums)
+{
+  gdouble *buf;
+  gsize element_size, block, offset, len, n;
+  guint ch;
 
   element_size = gst_tensor_get_element_size (type);
-  num = length / element_size;
-  *result = (gdouble *) g_try_malloc0 (sizeof (gdouble));
-  if (*result == NULL) {
+  block = MAX (1, TD_STATS_BLOCK / channels) * channels;
+
+  buf = (gdouble *) g_try_malloc (sizeof (gdouble) * block);
+  if (!buf) {
     nns_loge ("Failed to allocate memory for calculating standard deviation");
     return FALSE;
   }
 
-  std = 0.0;
-  for (i = 0; i < num; ++i) {
-    /* extract value and typecast to double */
-    data = (guint8 *) raw + element_size * i;
-    gst_tensor_data_raw_typecast (data, type, &value, _NNS_FLOAT64);
+  for (ch = 0; ch < channels; ch++)
+    sums[ch] = 0.0;
+
+  for (offset = 0; offset < num; offset += len) {
+    len = MIN (block, num - offset);
+    n = len / channels;
+
+    if (!td_raw_block_to_double ((const guint8 *) raw + offset * element_size,
+            type, buf, len)) {
+      nns_loge ("Unsupported tensor type %d to calculate standard deviation",
+          type);
+      g_free (buf);
+      return FALSE;
+    }
+
+    for (ch = 0; ch < channels; ch++)
+      sums[ch] += td_block_sum_sq (buf + ch, n, channels, means[ch]);
+  }
+
+  g_free (buf);
+  return TRUE;
+}
+
+/**
+ * @brief Internal function to get the average of each channel.
+ */
+static gboolean
+td_raw_average (gpointer raw, gsize length, tensor_type type, guint channels,
+    gdouble ** results)
+{
+  gsize num;
+  guint ch;
+
+  num = td_reduce_get_num (raw, length, type, channels);
+  g_return_val_if_fail (num > 0, FALSE);
+
+  *results = (gdouble *) g_try_malloc0 (sizeof (gdouble) * channels);
+  if (*results == NULL) {
+    nns_loge ("Failed to allocate memory for calculating average");
+    return FALSE;
+  }
 
-    std += pow (value - *average, 2) / num;
+  if (!gst_tensor_data_raw_sum (raw, length, type, channels, *results)) {
+    g_free (*results);
+    *results = NULL;
+    return FALSE;
   }
 
-  std = (std != 0.0) ? sqrt (std) : (1e-10);
-  **result = std;
+  for (ch = 0; ch < channels; ch++)
+    (*results)[ch] /= (gdouble) (num / channels);
 
   return TRUE;
 }
 
+/**
+ * @brief Internal function to get the standard deviation of each channel with the given averages.
+ */
+static gboolean
+td_raw_std (gpointer raw, gsize length, tensor_type type, guint channels,
+    const gdouble * averages, gdouble ** results)
+{
+  gsize num;
+  guint ch;
+
+  num = td_reduce_get_num (raw, length, type, channels);
+  g_return_val_if_fail (num > 0, FALSE);
+  g_return_val_if_fail (averages != NULL, FALSE);
+
+  *results = (gdouble *) g_try_malloc0 (sizeof (gdouble) * channels);
+  if (*results == NULL) {
+    nns_loge ("Failed to allocate memory for calculating standard deviation");
+    return FALSE;
+  }
+
+  if (!td_raw_sum_sq (raw, num, type, channels, averages, *results)) {
+    g_free (*results);
+    *results = NULL;
+    return FALSE;
+  }
+
+  for (ch = 0; ch < channels; ch++) {
+    (*results)[ch] = sqrt ((*results)[ch] / (num / channels));
+    if ((*results)[ch] == 0.0)
+      (*results)[ch] = 1e-10;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Calculate average value of the tensor.
+ * @param raw pointer of raw tensor data
+ * @param length byte size of raw tensor data
+ * @param type tensor type
+ * @param result double pointer for average value of given tensor. Caller should release allocated memory.
+ * @return TRUE if no error
+ */
+gboolean
+gst_tensor_data_raw_average (gpointer raw, gsize length, tensor_type type,
+    gdouble ** result)
+{
+  return td_raw_average (raw, length, type, 1, result);
+}
+
+/**
+ * @brief Calculate average value of the tensor per channel (the first dim).
+ * @param raw pointer of raw tensor data
+ * @param length byte size of raw tensor data
+ * @param type tensor type
+ * @param tensor_dim tensor dimension
+ * @param results double array contains average values of each channel. Caller should release allocated array.
+ * @return TRUE if no error
+ */
+gboolean
+gst_tensor_data_raw_average_per_channel (gpointer raw, gsize length,
+    tensor_type type, tensor_dim dim, gdouble ** results)
+{
+  g_return_val_if_fail (dim[0] > 0, FALSE);
+
+  return td_raw_average (raw, length, type, dim[0], results);
+}
+
+/**
+ * @brief Calculate standard deviation of the tensor.
+ * @param raw pointer of raw tensor data
+ * @param length byte size of raw tensor data
+ * @param type tensor type
+ * @param average average value of given tensor
+ * @param result double pointer for standard deviation of given tensor. Caller should release allocated memory.
+ * @return TRUE if no error
+ */
+gboolean
+gst_tensor_data_raw_std (gpointer raw, gsize length, tensor_type type,
+    gdouble * average, gdouble ** result)
+{
+  return td_raw_std (raw, length, type, 1, average, result);
+}
+
 /**
  * @brief Calculate standard deviation of the tensor per channel (the first dim).
  * @param raw pointer of raw tensor data
@@ -455,38 +963,100 @@ gboolean
 gst_tensor_data_raw_std_per_channel (gpointer raw, gsize length,
     tensor_type type, tensor_dim dim, gdouble * averages, gdouble ** results)
 {
-  gdouble value, std;
-  gulong ch, i, num, offset;
-  gsize element_size;
-  guint8 *data;
+  g_return_val_if_fail (dim[0] > 0, FALSE);
+
+  return td_raw_std (raw, length, type, dim[0], averages, results);
+}
+
+/**
+ * @brief Macro to summarize a block of floating point values.
+ * Branchless reduction with the finite mask, vectorized by the compiler.
+ */
+#define td_summary_float(raw,n,ftype,absf,s,vmin,vmax) do { \
+    const ftype *_p = (const ftype *) (raw); \
+    ftype _mn = (ftype) (vmin), _mx = (ftype) (vmax), _sum = 0; \
+    gsize _k, _nan = 0, _inf = 0; \
+    for (_k = 0; _k < (n); _k++) { \
+      ftype _v = _p[_k]; \
+      int _is_nan = (_v != _v); \
+      int _is_inf = (absf (_v) == (ftype) INFINITY); \
+      int _fin = !(_is_nan | _is_inf); \
+      _nan += _is_nan; \
+      _inf += _is_inf; \
+      _sum += _fin ? _v : (ftype) 0; \
+      _mn = (_fin && _v < _mn) ? _v : _mn; \
+      _mx = (_fin && _v > _mx) ? _v : _mx; \
+    } \
+    (s)->nan_count += _nan; \
+    (s)->inf_count += _inf; \
+    (s)->num += (n) - _nan - _inf; \
+    sum += (gdouble) _sum; \
+    mn = MIN (mn, (gdouble) _mn); \
+    mx = MAX (mx, (gdouble) _mx); \
+  } while (0)
+
+/**
+ * @brief Get the min, max and mean of the finite values and the number of NaN and infinite values in a single pass.
+ */
+gboolean
+gst_tensor_data_raw_summary (gconstpointer raw, gsize length, tensor_type type,
+    tensor_data_summary_s * summary)
+{
+  gdouble buf[TD_STATS_BLOCK];
+  gdouble sum = 0.0, mn = INFINITY, mx = -INFINITY;
+  gsize element_size, num, offset, len;
+  const guint8 *data = (const guint8 *) raw;
+  const GstTensorKernels *kernels = gst_tensor_kernels_get ();
+  GstTensorKernelSummary ks;
 
   g_return_val_if_fail (raw != NULL, FALSE);
-  g_return_val_if_fail (length > 0, FALSE);
-  g_return_val_if_fail (dim[0] > 0, FALSE);
+  g_return_val_if_fail (summary != NULL, FALSE);
   g_return_val_if_fail (type != _NNS_END, FALSE);
 
+  memset (summary, 0, sizeof (tensor_data_summary_s));
+
   element_size = gst_tensor_get_element_size (type);
   num = length / element_size;
+  g_return_val_if_fail (num > 0, FALSE);
 
-  offset = dim[0];
-  num = num / offset;
-  *results = (gdouble *) g_try_malloc0 (sizeof (gdouble) * offset);
-  if (*results == NULL) {
-    nns_loge ("Failed to allocate memory for calculating standard deviation");
-    return FALSE;
-  }
+  /* the block keeps the partial sum of float32 accurate */
+  for (offset = 0; offset < num; offset += len) {
+    len = MIN (TD_STATS_BLOCK, num - offset);
 
-  for (ch = 0; ch < offset; ++ch) {
-    std = 0.0;
-    for (i = 0; i < num; ++i) {
-      /* extract value and typecast to double */
-      data = (guint8 *) raw + element_size * ((i * offset) + ch);
-      gst_tensor_data_raw_typecast (data, type, &value, _NNS_FLOAT64);
-      std += pow (value - averages[ch], 2) / num;
+    switch (type) {
+      case _NNS_FLOAT32:
+        /* SIMD kernel for the running CPU */
+        kernels->f32_summary ((const gfloat *) (data + offset * element_size),
+            len, &ks);
+        summary->nan_count += ks.nan_count;
+        summary->inf_count += ks.inf_count;
+        summary->num += len - ks.nan_count - ks.inf_count;
+        sum += ks.sum;
+        mn = MIN (mn, (gdouble) ks.min);
+        mx = MAX (mx, (gdouble) ks.max);
+        break;
+      case _NNS_FLOAT64:
+        td_summary_float (data + offset * element_size, len, double, fabs,
+            summary, INFINITY, -INFINITY);
+        break;
+      default:
+        /* the other types are converted to double */
+        if (!td_raw_block_to_double (data + offset * element_size, type, buf,
+                len)) {
+          nns_loge ("Unsupported tensor type %d to summarize the values", type);
+          return FALSE;
+        }
+
+        td_summary_float (buf, len, double, fabs, summary, INFINITY,
+            -INFINITY);
+        break;
     }
+  }
 
-    std = (std != 0.0) ? sqrt (std) : (1e-10);
-    (*results)[ch] = std;
+  if (summary->num > 0) {
+    summary->min = mn;
+    summary->max = mx;
+    summary->mean = sum / summary->num;
   }
 
   return TRUE;
@@ -26,6 +26,19 @@ typedef struct
   tensor_element data;
 } tensor_data_s;
 
+/**
+ * @brief Structure for the summary of tensor values.
+ */
+typedef struct
+{
+  gdouble min; /**< the smallest finite value */
+  gdouble max; /**< the largest finite value */
+  gdouble mean; /**< the average of the finite values */
+  gsize num; /**< the number of the finite values */
+  gsize nan_count; /**< the number of NaN values */
+  gsize inf_count; /**< the number of infinite values */
+} tensor_data_summary_s;
+
 /**
  * @brief Set tensor element data with given type.
  * @param td struct for tensor data
@@ -118,5 +131,72 @@ extern gboolean
 gst_tensor_data_raw_std_per_channel (gpointer raw, gsize length, 
     tensor_type type, tensor_dim dim, gdouble * averages, gdouble ** results);
 
+/**
+ * @brief Calculate the average and standard deviation of each channel in a single pass.
+ * @param raw pointer of raw tensor data
+ * @param length byte size of raw tensor data
+ * @param type tensor type
+ * @param channels the number of channels (the first dim, 1 for the whole tensor)
+ * @param averages double array contains average values of each channel. Caller should release allocated array.
+ * @param stds double array contains standard deviation of each channel (NULL to skip). Caller should release allocated array.
+ * @return TRUE if no error
+ */
+extern gboolean
+gst_tensor_data_raw_stats (gpointer raw, gsize length, tensor_type type,
+    guint channels, gdouble ** averages, gdouble ** stds);
+
+/**
+ * @brief Get the min, max and mean of the finite values and the number of NaN and infinite values in a single pass.
+ * @param raw pointer of raw tensor data
+ * @param length byte size of raw tensor data
+ * @param type tensor type
+ * @param summary the summary to be filled. min, max and mean are 0 if there is no finite value.
+ * @return TRUE if no error
+ */
+extern gboolean
+gst_tensor_data_raw_summary (gconstpointer raw, gsize length, tensor_type type,
+    tensor_data_summary_s * summary);
+
+/**
+ * @brief Get the sum of the elements of each channel (the first dim).
+ * @param raw pointer of raw tensor data
+ * @param length byte size of raw tensor data
+ * @param type tensor type
+ * @param channels the number of channels (the first dim, 1 for the whole tensor)
+ * @param sums double array to be filled with the sum of each channel, the size should be channels.
+ * @return TRUE if no error
+ */
+extern gboolean
+gst_tensor_data_raw_sum (gconstpointer raw, gsize length, tensor_type type,
+    guint channels, gdouble * sums);
+
+/**
+ * @brief Get the smallest and largest elements of each channel (the first dim) in the tensor type.
+ * @param raw pointer of raw tensor data
+ * @param length byte size of raw tensor data
+ * @param type tensor type
+ * @param channels the number of channels (the first dim, 1 for the whole tensor)
+ * @param mins array to be filled with the smallest element of each channel (NULL to skip), the size should be channels.
+ * @param maxs array to be filled with the largest element of each channel (NULL to skip), the size should be channels.
+ * @return TRUE if no error
+ */
+extern gboolean
+gst_tensor_data_raw_min_max (gconstpointer raw, gsize length,
+    tensor_type type, guint channels, tensor_data_s * mins,
+    tensor_data_s * maxs);
+
+/**
+ * @brief Get the index of the first largest element of each channel (the first dim).
+ * @param raw pointer of raw tensor data
+ * @param length byte size of raw tensor data
+ * @param type tensor type
+ * @param channels the number of channels (the first dim, 1 for the whole tensor)
+ * @param indices array to be filled with the index of the largest element in each channel, the element is raw[indices[c] * channels + c].
+ * @return TRUE if no error
+ */
+extern gboolean
+gst_tensor_data_raw_argmax (gconstpointer raw, gsize length, tensor_type type,
+    guint channels, gsize * indices);
+
 G_END_DECLS
 #endif /* __NNS_TENSOR_DATA_H__ */
@@ -0,0 +1,317 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file    tensor_device_memory.c
+ * @date    14 Oct 2026
+ * @brief   GstMemory of the tensor in the device memory of the framework
+ * @author  agent <agent@local>
+ * @see     http://github.com/nnstreamer/nnstreamer
+ * @bug     No known bugs
+ *
+ * The device memory wraps the device data (e.g., CUDA device pointer)
+ * allocated by the framework, so that the next filter running on the same
+ * device takes the tensor without the copy through host memory.
+ * The host copy is downloaded on the first map, and the data written in
+ * host memory is uploaded when the device data is requested again.
+ * The memory cannot be shared (sub-memory), the copy is in system memory.
+ */
+
+#include <string.h>
+#include <gst/gst.h>
+#include "nnstreamer_log.h"
+#include "nnstreamer_plugin_api.h"
+
+/**
+ * @brief struct for the tensor in the device memory
+ */
+typedef struct
+{
+  GstMemory mem; /**< parent memory */
+
+  const GstTensorDeviceOps *ops; /**< the operations of the device memory */
+  gpointer device_data; /**< the device data */
+  gpointer user_data; /**< the data passed to notify */
+  GDestroyNotify notify; /**< called to release the device data */
+
+  GMutex lock; /**< lock for the host copy */
+  guint8 *host_data; /**< the host copy (NULL if not downloaded) */
+  gboolean host_valid; /**< TRUE if the host copy has the data of the device */
+  gboolean host_dirty; /**< TRUE if the host copy is written and not uploaded */
+} GstTensorDeviceMemory;
+
+/**
+ * @brief struct for type GstTensorDeviceAllocator
+ */
+typedef struct
+{
+  GstAllocator parent;
+} GstTensorDeviceAllocator;
+
+/**
+ * @brief struct for class GstTensorDeviceAllocatorClass
+ */
+typedef struct
+{
+  GstAllocatorClass parent_class;
+} GstTensorDeviceAllocatorClass;
+
+static GType gst_tensor_device_allocator_get_type (void);
+G_DEFINE_TYPE (GstTensorDeviceAllocator, gst_tensor_device_allocator,
+    GST_TYPE_ALLOCATOR);
+
+/**
+ * @brief alloc function of device allocator, the device memory is allocated by the framework
+ */
+static GstMemory *
+_alloc (GstAllocator * allocator, gsize size, GstAllocationParams * params)
+{
+  UNUSED (allocator);
+  UNUSED (size);
+  UNUSED (params);
+
+  nns_loge ("The device memory should be allocated by the framework.");
+  return NULL;
+}
+
+/**
+ * @brief free function of device allocator
+ */
+static void
+_free (GstAllocator * allocator, GstMemory * memory)
+{
+  GstTensorDeviceMemory *mem = (GstTensorDeviceMemory *) memory;
+
+  UNUSED (allocator);
+
+  if (mem->notify)
+    mem->notify (mem->user_data);
+
+  g_free (mem->host_data);
+  g_mutex_clear (&mem->lock);
+  g_free (mem);
+}
+
+/**
+ * @brief map function of device allocator, download the tensor to the host copy
+ */
+static gpointer
+_mem_map (GstMemory * memory, gsize maxsize, GstMapFlags flags)
+{
+  GstTensorDeviceMemory *mem = (GstTensorDeviceMemory *) memory;
+  gpointer data = NULL;
+
+  g_mutex_lock (&mem->lock);
+
+  if (!mem->host_data)
+    mem->host_data = (guint8 *) g_try_malloc (maxsize);
+  if (!mem->host_data) {
+    nns_loge ("Failed to allocate the host copy of the device memory.");
+    goto done;
+  }
+
+  if (!mem->host_valid) {
+    if (mem->ops->download (mem->device_data, mem->host_data, maxsize) != 0) {
+      nns_loge ("Failed to download the tensor from the device memory.");
+      goto done;
+    }
+    mem->host_valid = TRUE;
+  }
+
+  if (flags & GST_MAP_WRITE)
+    mem->host_dirty = TRUE;
+
+  data = mem->host_data;
+
+done:
+  g_mutex_unlock (&mem->lock);
+  return data;
+}
+
+/**
+ * @brief unmap function of device allocator
+ */
+static gboolean
+_mem_unmap (GstMemory * memory)
+{
+  UNUSED (memory);
+  return TRUE;
+}
+
+/**
+ * @brief share function of device allocator, not supported (GST_MEMORY_FLAG_NO_SHARE)
+ */
+static GstMemory *
+_mem_share (GstMemory * memory, gssize offset, gsize size)
+{
+  UNUSED (memory);
+  UNUSED (offset);
+  UNUSED (size);
+
+  return NULL;
+}
+
+/**
+ * @brief copy function of device allocator, copy the tensor to system memory
+ */
+static GstMemory *
+_mem_copy (GstMemory * memory, gssize offset, gsize size)
+{
+  GstMemory *copy = NULL;
+  GstMapInfo src, dest;
+
+  if (!gst_memory_map (memory, &src, GST_MAP_READ))
+    return NULL;
+
+  if (size == (gsize) - 1)
+    size = (src.size > (gsize) offset) ? src.size - offset : 0;
+
+  copy = gst_allocator_alloc (NULL, size, NULL);
+  if (copy && gst_memory_map (copy, &dest, GST_MAP_WRITE)) {
+    memcpy (dest.data, src.data + offset, size);
+    gst_memory_unmap (copy, &dest);
+  }
+
+  gst_memory_unmap (memory, &src);
+  return copy;
+}
+
+/**
+ * @brief is_span function of device allocator
+ */
+static gboolean
+_mem_is_span (GstMemory * mem1, GstMemory * mem2, gsize * offset)
+{
+  UNUSED (mem1);
+  UNUSED (mem2);
+  UNUSED (offset);
+
+  return FALSE;
+}
+
+/**
+ * @brief class initization for GstTensorDeviceAllocatorClass
+ */
+static void
+gst_tensor_device_allocator_class_init (GstTensorDeviceAllocatorClass * klass)
+{
+  GstAllocatorClass *allocator_class;
+
+  allocator_class = (GstAllocatorClass *) klass;
+
+  allocator_class->alloc = _alloc;
+  allocator_class->free = _free;
+}
+
+/**
+ * @brief initialzation for GstTensorDeviceAllocator
+ */
+static void
+gst_tensor_device_allocator_init (GstTensorDeviceAllocator * allocator)
+{
+  GstAllocator *alloc;
+
+  alloc = GST_ALLOCATOR_CAST (allocator);
+
+  alloc->mem_type = GST_TENSOR_DEVICE_MEMORY_TYPE;
+  alloc->mem_map = _mem_map;
+  alloc->mem_unmap = _mem_unmap;
+  alloc->mem_copy = _mem_copy;
+  alloc->mem_share = _mem_share;
+  alloc->mem_is_span = _mem_is_span;
+
+  GST_OBJECT_FLAG_SET (allocator, GST_ALLOCATOR_FLAG_CUSTOM_ALLOC);
+}
+
+/**
+ * @brief Get the allocator of the device memory (created once, never released).
+ */
+static GstAllocator *
+gst_tensor_device_allocator_get (void)
+{
+  static gsize init = 0;
+  static GstAllocator *allocator = NULL;
+
+  if (g_once_init_enter (&init)) {
+    allocator = (GstAllocator *)
+        g_object_new (gst_tensor_device_allocator_get_type (), NULL);
+    gst_object_ref_sink (allocator);
+    g_once_init_leave (&init, 1);
+  }
+
+  return allocator;
+}
+
+/**
+ * @brief Wrap the device data allocated by the framework with new GstMemory.
+ */
+GstMemory *
+gst_tensor_device_memory_new (const GstTensorDeviceOps * ops,
+    gpointer device_data, gsize size, gpointer user_data,
+    GDestroyNotify notify)
+{
+  GstTensorDeviceMemory *mem;
+
+  g_return_val_if_fail (ops != NULL, NULL);
+  g_return_val_if_fail (ops->download != NULL && ops->upload != NULL, NULL);
+  g_return_val_if_fail (ops->type != NNS_TENSOR_MEMORY_HOST, NULL);
+  g_return_val_if_fail (device_data != NULL, NULL);
+  g_return_val_if_fail (size > 0, NULL);
+
+  mem = g_new0 (GstTensorDeviceMemory, 1);
+  mem->ops = ops;
+  mem->device_data = device_data;
+  mem->user_data = user_data;
+  mem->notify = notify;
+  g_mutex_init (&mem->lock);
+
+  gst_memory_init (GST_MEMORY_CAST (mem), GST_MEMORY_FLAG_NO_SHARE,
+      gst_tensor_device_allocator_get (), NULL, size, 0, 0, size);
+
+  return GST_MEMORY_CAST (mem);
+}
+
+/**
+ * @brief Check the memory is the tensor in the device memory.
+ */
+gboolean
+gst_is_tensor_device_memory (GstMemory * mem)
+{
+  return (mem != NULL && mem->allocator != NULL &&
+      gst_memory_is_type (mem, GST_TENSOR_DEVICE_MEMORY_TYPE));
+}
+
+/**
+ * @brief Get the device data of the memory, to pass the tensor to the framework without the copy to host memory.
+ */
+gpointer
+gst_tensor_device_memory_get_data (GstMemory * mem, tensor_memory_type type)
+{
+  GstTensorDeviceMemory *dmem;
+  gpointer data = NULL;
+
+  if (!gst_is_tensor_device_memory (mem))
+    return NULL;
+
+  dmem = (GstTensorDeviceMemory *) mem;
+
+  /* the offset of the device data (e.g., cl_mem) is not available */
+  if (dmem->ops->type != type || mem->offset != 0)
+    return NULL;
+
+  g_mutex_lock (&dmem->lock);
+  if (dmem->host_dirty) {
+    if (dmem->ops->upload (dmem->device_data, dmem->host_data,
+            mem->maxsize) != 0) {
+      nns_loge ("Failed to upload the tensor to the device memory.");
+      goto done;
+    }
+    dmem->host_dirty = FALSE;
+  }
+
+  data = dmem->device_data;
+
+done:
+  g_mutex_unlock (&dmem->lock);
+  return data;
+}
@@ -67,10 +67,20 @@
 #include <config.h>
 #endif
 
+#include <errno.h>
+#include <math.h>
 #include <string.h>
 #include <nnstreamer_util.h>
+#include <tensor_kernels.h>
 
 #include "tensor_filter.h"
+#include "tensor_buffer_pool.h"
+#include <tracers/gsttensor_tracer.h>
+#include <elements/gsttensor_if.h>
+#include <elements/gsttensor_sparseutil.h>
+#ifdef HAVE_GST_DMABUF
+#include <gst/allocators/gstdmabuf.h>
+#endif
 
 /** @todo rename & move this to better location */
 #define EVENT_NAME_UPDATE_MODEL "evt_update_model"
@@ -81,10 +91,20 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_filter_debug);
 #define TF_MODELNAME(prop) \
     ((prop)->model_files ? ((prop)->model_files[0]) : "[No Model File]")
 
+/**
+ * @brief The size of the block of the input tensors sampled to skip the invoke (skip-threshold).
+ */
+#define SKIP_BLOCK_SIZE (64)
+
+/**
+ * @brief The tensor_filter which has set the CPU affinity of the current thread.
+ */
+static GPrivate cpu_affinity_owner = G_PRIVATE_INIT (NULL);
+
 /**
  * @brief Default caps string for both sink and source pad.
  */
-#define CAPS_STRING GST_TENSOR_CAP_DEFAULT ";" GST_TENSORS_CAP_MAKE ("{ static, flexible }")
+#define CAPS_STRING GST_TENSOR_CAP_DEFAULT ";" GST_TENSORS_CAP_MAKE ("{ static, flexible, sparse }")
 
 /**
  * @brief The capabilities of the inputs
@@ -137,6 +157,8 @@ static gboolean gst_tensor_filter_set_caps (GstBaseTransform * trans,
     GstCaps * incaps, GstCaps * outcaps);
 static gboolean gst_tensor_filter_query (GstBaseTransform * trans,
     GstPadDirection direction, GstQuery * query);
+static gboolean gst_tensor_filter_decide_allocation (GstBaseTransform * trans,
+    GstQuery * query);
 static gboolean gst_tensor_filter_transform_size (GstBaseTransform * trans,
     GstPadDirection direction, GstCaps * caps, gsize size,
     GstCaps * othercaps, gsize * othersize);
@@ -147,6 +169,9 @@ static gboolean gst_tensor_filter_sink_event (GstBaseTransform * trans,
 static gboolean gst_tensor_filter_src_event (GstBaseTransform * trans,
     GstEvent * event);
 
+static void gst_tensor_filter_reload_join (GstTensorFilter * self);
+static void gst_tensor_filter_skip_free (GstTensorFilter * self);
+
 /**
  * @brief initialize the tensor_filter's class
  */
@@ -196,6 +221,8 @@ gst_tensor_filter_class_init (GstTensorFilterClass * klass)
   /* Allocation units */
   trans_class->transform_size =
       GST_DEBUG_FUNCPTR (gst_tensor_filter_transform_size);
+  trans_class->decide_allocation =
+      GST_DEBUG_FUNCPTR (gst_tensor_filter_decide_allocation);
 
   /* setup events */
   trans_class->sink_event = GST_DEBUG_FUNCPTR (gst_tensor_filter_sink_event);
@@ -225,6 +252,39 @@ gst_tensor_filter_init (GstTensorFilter * self)
   self->prev_ts = GST_CLOCK_TIME_NONE;
   self->throttling_delay = 0;
   self->throttling_accum = 0;
+
+  /* init asynchronous invoke */
+  memset (&self->workers, 0, sizeof (GstTensorFilterWorkers));
+  g_mutex_init (&self->workers.lock);
+  g_cond_init (&self->workers.cond);
+  g_mutex_init (&self->workers.push_lock);
+  self->workers.last_ret = GST_FLOW_OK;
+
+  /* init dynamic batching */
+  memset (&self->batch, 0, sizeof (GstTensorFilterBatch));
+  g_mutex_init (&self->batch.lock);
+  g_cond_init (&self->batch.cond);
+  g_queue_init (&self->batch.frames);
+  self->batch.last_ret = GST_FLOW_OK;
+
+  /* init double-buffered reload */
+  memset (&self->reload, 0, sizeof (GstTensorFilterReload));
+  g_mutex_init (&self->reload.lock);
+
+  /* init accelerator scheduling */
+  memset (&self->sched, 0, sizeof (GstTensorFilterSched));
+  g_mutex_init (&self->sched.fallback_lock);
+
+  /* init accelerator switching */
+  memset (&self->accl_switch, 0, sizeof (GstTensorFilterAcclSwitch));
+  g_mutex_init (&self->accl_switch.lock);
+
+  /* init skipping the invoke */
+  memset (&self->skip, 0, sizeof (GstTensorFilterSkip));
+
+  /* init deadline */
+  memset (&self->deadline, 0, sizeof (GstTensorFilterDeadline));
+  self->deadline.earliest = GST_CLOCK_TIME_NONE;
 }
 
 /**
@@ -239,9 +299,24 @@ gst_tensor_filter_finalize (GObject * object)
   self = GST_TENSOR_FILTER (object);
   priv = &self->priv;
 
+  gst_tensor_filter_reload_join (self);
+  gst_tensor_filter_accl_switch_join (self);
   gst_tensor_filter_common_close_fw (priv);
   gst_tensor_filter_common_free_property (priv);
 
+  g_mutex_clear (&self->workers.lock);
+  g_cond_clear (&self->workers.cond);
+  g_mutex_clear (&self->workers.push_lock);
+
+  g_queue_clear_full (&self->batch.frames, (GDestroyNotify) gst_buffer_unref);
+  g_mutex_clear (&self->batch.lock);
+  g_cond_clear (&self->batch.cond);
+
+  g_mutex_clear (&self->reload.lock);
+  g_mutex_clear (&self->sched.fallback_lock);
+  g_mutex_clear (&self->accl_switch.lock);
+  gst_tensor_filter_skip_free (self);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -276,621 +351,3162 @@ gst_tensor_filter_get_tensor_size (GstTensorFilter * self, guint index,
 }
 
 /**
- * @brief Setter for tensor_filter properties.
+ * @brief Invoke the given instance of the framework with zero-filled input tensors.
+ * @param self "this" pointer
+ * @param private_data the private data of framework instance to invoke
+ * @param count the number of invokes
+ * @return TRUE if all invokes are successfully done.
  */
-static void
-gst_tensor_filter_set_property (GObject * object, guint prop_id,
-    const GValue * value, GParamSpec * pspec)
+static gboolean
+gst_tensor_filter_warmup_instance (GstTensorFilter * self,
+    void **private_data, guint count)
 {
-  GstTensorFilter *self;
-  GstTensorFilterPrivate *priv;
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT];
+  gboolean allocate_in_invoke;
+  gboolean done = TRUE;
+  guint i, n;
+  gint ret;
 
-  self = GST_TENSOR_FILTER (object);
-  priv = &self->priv;
+  if (count == 0)
+    return TRUE;
 
-  silent_debug (self, "Setting property for prop %d.\n", prop_id);
+  if (!gst_tensors_info_validate (&prop->input_meta) ||
+      !gst_tensors_info_validate (&prop->output_meta)) {
+    GST_WARNING_OBJECT (self,
+        "The tensors info of the model is not configured, cannot warm up the model.");
+    return FALSE;
+  }
 
-  if (!gst_tensor_filter_common_set_property (priv, prop_id, value, pspec))
-    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+  allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
+
+  for (i = 0; i < prop->input_meta.num_tensors; i++) {
+    in_tensors[i].size = gst_tensor_info_get_size (&prop->input_meta.info[i]);
+    in_tensors[i].data = g_malloc0 (in_tensors[i].size);
+  }
+
+  for (i = 0; i < prop->output_meta.num_tensors; i++) {
+    out_tensors[i].size = gst_tensor_info_get_size (&prop->output_meta.info[i]);
+    out_tensors[i].data =
+        allocate_in_invoke ? NULL : g_malloc (out_tensors[i].size);
+  }
+
+  for (n = 0; n < count; n++) {
+    GST_TF_FW_INVOKE_COMPAT_WITH_DATA (priv, private_data, ret, in_tensors,
+        out_tensors);
+    if (ret < 0) {
+      GST_WARNING_OBJECT (self, "Failed to invoke the model to warm up (%d).",
+          ret);
+      done = FALSE;
+      break;
+    }
+
+    if (allocate_in_invoke) {
+      for (i = 0; i < prop->output_meta.num_tensors; i++) {
+        if (out_tensors[i].data)
+          gst_tensor_filter_destroy_notify_util_full (priv, private_data,
+              out_tensors[i].data);
+        out_tensors[i].data = NULL;
+      }
+    }
+  }
+
+  for (i = 0; i < prop->input_meta.num_tensors; i++)
+    g_free (in_tensors[i].data);
+
+  if (!allocate_in_invoke) {
+    for (i = 0; i < prop->output_meta.num_tensors; i++)
+      g_free (out_tensors[i].data);
+  }
+
+  return done;
 }
 
 /**
- * @brief Getter for tensor_filter properties.
+ * @brief Warm up the framework instances with the configured tensors info (warmup).
+ * @note If the tensors info is not configured yet, it is done when the caps are negotiated.
  */
 static void
-gst_tensor_filter_get_property (GObject * object, guint prop_id,
-    GValue * value, GParamSpec * pspec)
+gst_tensor_filter_warmup (GstTensorFilter * self)
 {
-  GstTensorFilter *self;
-  GstTensorFilterPrivate *priv;
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  gint64 start_time;
+  guint i;
 
-  self = GST_TENSOR_FILTER (object);
-  priv = &self->priv;
+  if (priv->warmup == 0 || self->warmed_up)
+    return;
 
-  silent_debug (self, "Getting property for prop %d.\n", prop_id);
+  if (!prop->fw_opened || !prop->input_configured || !prop->output_configured)
+    return;
 
-  if (!gst_tensor_filter_common_get_property (priv, prop_id, value, pspec))
-    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+  start_time = g_get_monotonic_time ();
+
+  if (!gst_tensor_filter_warmup_instance (self, &priv->privateData,
+          priv->warmup))
+    return;
+
+  for (i = 1; i < self->workers.num_workers; i++) {
+    if (!gst_tensor_filter_warmup_instance (self, &self->workers.instances[i],
+            priv->warmup))
+      return;
+  }
+
+  self->warmed_up = TRUE;
+
+  /* no need to ignore the first measurement */
+  g_atomic_int_set (&priv->stat.latency_ignore_count, 0);
+
+  GST_INFO_OBJECT (self, "Warmed up the model with %u invokes, it took %"
+      G_GINT64_FORMAT " us.", priv->warmup,
+      g_get_monotonic_time () - start_time);
 }
 
 /**
- * @brief Free the data allocated for tensor transform
- * @details default function for tensor filter framework if not provided by the
- *          framework. The data is in GPtrArray - first element is private data
- *          of framework and second element is the data to be freed.
+ * @brief Check the new framework instance has the same tensors info with the current model.
  */
-static void
-gst_tensor_filter_destroy_notify (void *data)
+static gboolean
+gst_tensor_filter_reload_check_info (GstTensorFilter * self,
+    const GstTensorFilterProperties * new_prop, void **new_data)
 {
-  GPtrArray *array = (GPtrArray *) data;
-  GstTensorFilter *self = (GstTensorFilter *) g_ptr_array_index (array, 0);
-  void *tensor_data = (void *) g_ptr_array_index (array, 1);
-  g_ptr_array_free (array, TRUE);
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorsInfo in_info, out_info;
+  gboolean matched = FALSE;
+  gint ret = -1;
+
+  gst_tensors_info_init (&in_info);
+  gst_tensors_info_init (&out_info);
+
+  if (GST_TF_FW_V1 (priv->fw)) {
+    ret = priv->fw->getModelInfo (priv->fw, new_prop, *new_data,
+        GET_IN_OUT_INFO, &in_info, &out_info);
+  } else if (priv->fw->getInputDimension && priv->fw->getOutputDimension) {
+    ret = priv->fw->getInputDimension (new_prop, new_data, &in_info);
+    if (ret == 0)
+      ret = priv->fw->getOutputDimension (new_prop, new_data, &out_info);
+  }
+
+  /* the model may not have the fixed input, set the current input info */
+  if (ret != 0) {
+    gst_tensors_info_free (&in_info);
+    gst_tensors_info_free (&out_info);
+    gst_tensors_info_copy (&in_info, &priv->prop.input_meta);
+
+    if (GST_TF_FW_V1 (priv->fw)) {
+      ret = priv->fw->getModelInfo (priv->fw, new_prop, *new_data,
+          SET_INPUT_INFO, &in_info, &out_info);
+    } else if (priv->fw->setInputDimension) {
+      ret = priv->fw->setInputDimension (new_prop, new_data, &in_info,
+          &out_info);
+    }
+  }
+
+  if (ret == 0) {
+    matched = gst_tensors_info_is_equal (&in_info, &priv->prop.input_meta) &&
+        gst_tensors_info_is_equal (&out_info, &priv->prop.output_meta);
+  }
 
-  gst_tensor_filter_destroy_notify_util (&self->priv, tensor_data);
+  gst_tensors_info_free (&in_info);
+  gst_tensors_info_free (&out_info);
+  return matched;
 }
 
 /**
- * @brief Allocate new memory block from given data.
- * @details tensor-filter should send event to sub-plugin when memory is freed.
+ * @brief Thread to load the new model and switch the framework instance.
  */
-static GstMemory *
-gst_tensor_filter_get_wrapped_mem (GstTensorFilter * self, gpointer data,
-    gsize size)
+static gpointer
+gst_tensor_filter_reload_thread (gpointer user_data)
 {
-  GPtrArray *data_array = g_ptr_array_new ();
+  GstTensorFilter *self = GST_TENSOR_FILTER (user_data);
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties new_prop;
+  GstStructure *s;
+  const gchar **old_files;
+  void *new_data = NULL;
+  void *old_data;
+  gboolean reloaded = FALSE;
+  gint64 start_time, duration;
+
+  start_time = g_get_monotonic_time ();
+
+  /* the properties of the new instance, except the model files */
+  memcpy (&new_prop, &priv->prop, sizeof (GstTensorFilterProperties));
+  new_prop.model_files =
+      (const gchar **) g_strsplit_set (self->reload.model_files, ",", -1);
+  new_prop.num_models = g_strv_length ((gchar **) new_prop.model_files);
+
+  if (priv->fw->open (&new_prop, &new_data) < 0) {
+    GST_WARNING_OBJECT (self, "Failed to open the framework with the model %s.",
+        self->reload.model_files);
+    goto done;
+  }
 
-  g_ptr_array_add (data_array, (gpointer) self);
-  g_ptr_array_add (data_array, (gpointer) data);
+  if (!gst_tensor_filter_reload_check_info (self, &new_prop, &new_data)) {
+    GST_WARNING_OBJECT (self,
+        "The model %s has unmatched tensors info, cannot switch the model.",
+        self->reload.model_files);
+    goto close_new;
+  }
 
-  return gst_memory_new_wrapped (0, data, size, 0, size, (gpointer) data_array,
-      gst_tensor_filter_destroy_notify);
+  /* the first invoke of the new model may take long (e.g., lazy allocation) */
+  if (!gst_tensor_filter_warmup_instance (self, &new_data, 1))
+    goto close_new;
+
+  /* switch the framework instance between invokes */
+  g_mutex_lock (&self->reload.lock);
+  old_data = priv->privateData;
+  priv->privateData = new_data;
+  old_files = priv->prop.model_files;
+  priv->prop.model_files = new_prop.model_files;
+  priv->prop.num_models = new_prop.num_models;
+  g_mutex_unlock (&self->reload.lock);
+
+  /* the previous output is given by the old model */
+  g_atomic_int_set (&self->skip.invalid, TRUE);
+  if (priv->cache)
+    gst_tensor_filter_cache_clear (priv->cache);
+
+  if (priv->fw->close)
+    priv->fw->close (&priv->prop, &old_data);
+  g_strfreev ((gchar **) old_files);
+
+  new_prop.model_files = NULL;
+  reloaded = TRUE;
+  goto done;
+
+close_new:
+  if (priv->fw->close)
+    priv->fw->close (&new_prop, &new_data);
+
+done:
+  duration = g_get_monotonic_time () - start_time;
+  g_strfreev ((gchar **) new_prop.model_files);
+
+  GST_INFO_OBJECT (self, "Reloading the model %s %s, it took %" G_GINT64_FORMAT
+      " us.", self->reload.model_files, reloaded ? "is done" : "has failed",
+      duration);
+
+  s = gst_structure_new ("tensor-filter-reload",
+      "model", G_TYPE_STRING, self->reload.model_files,
+      "success", G_TYPE_BOOLEAN, reloaded,
+      "duration", G_TYPE_INT64, duration, NULL);
+  gst_element_post_message (GST_ELEMENT_CAST (self),
+      gst_message_new_element (GST_OBJECT_CAST (self), s));
+
+  return NULL;
 }
 
 /**
- * @brief Prepare statistics for performance profiling (e.g, latency, throughput)
+ * @brief Wait for the thread loading the model.
  */
 static void
-prepare_statistics (GstTensorFilterPrivate * priv)
+gst_tensor_filter_reload_join (GstTensorFilter * self)
 {
-  priv->stat.latest_invoke_time = g_get_real_time ();
+  if (self->reload.thread) {
+    g_thread_join (self->reload.thread);
+    self->reload.thread = NULL;
+  }
+
+  g_free (self->reload.model_files);
+  self->reload.model_files = NULL;
 }
 
 /**
- * @brief Helper function to accumulate latencies
+ * @brief Start to load the given model in the background (reload-async).
+ * @return TRUE if the thread is started. FALSE if the model should be reloaded synchronously.
  */
-static void
-accumulate_latency (void *data, void *user_data)
+static gboolean
+gst_tensor_filter_reload_start (GstTensorFilter * self, const GValue * value)
 {
-  gint64 *latency = data;
-  gint64 *total_latency = user_data;
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  const gchar *model_files = g_value_get_string (value);
+  GError *error = NULL;
 
-  *total_latency += *latency;
-}
+  if (!priv->reload_async || !priv->is_updatable || !prop->fw_opened ||
+      !priv->fw || !priv->fw->open || !model_files)
+    return FALSE;
+
+  /**
+   * The instance cannot be switched if the model is shared,
+   * the outputs refer to the instance (allocate_in_invoke),
+   * or the model is invoked with multiple instances.
+   */
+  if (prop->shared_tensor_filter_key || self->workers.pool ||
+      gst_tensor_filter_allocate_in_invoke (priv)) {
+    GST_INFO_OBJECT (self, "Cannot switch the framework instance, "
+        "the model is reloaded synchronously.");
+    return FALSE;
+  }
 
-#define THRESHOLD_DROP_OLD  (2000)
-#define THRESHOLD_CACHE_OLD (1000)
+  /* wait for the previous reload */
+  gst_tensor_filter_reload_join (self);
+
+  self->reload.model_files = g_strdup (model_files);
+  self->reload.thread = g_thread_try_new ("tensor_filter_reload",
+      gst_tensor_filter_reload_thread, self, &error);
+  if (!self->reload.thread) {
+    GST_WARNING_OBJECT (self, "Failed to start the reload thread: %s",
+        error ? error->message : "unknown error");
+    g_clear_error (&error);
+    g_free (self->reload.model_files);
+    self->reload.model_files = NULL;
+    return FALSE;
+  }
+
+  return TRUE;
+}
 
 /**
- * @brief Record statistics for performance profiling (e.g, latency, throughput)
+ * @brief The estimate of the invoke latency (usec) on the accelerator, halved for each second since it is measured.
+ * @note The accelerator left for the high latency is tried again after the estimate cools down.
  */
-static void
-record_statistics (GstTensorFilterPrivate * priv)
+static gint64
+gst_tensor_filter_accl_switch_get_estimate (GstTensorFilterAcclSwitch * sw,
+    guint index, gint64 now)
 {
-  gint64 end_time = g_get_real_time ();
-  gint64 *latency;
-  GQueue *recent_latencies = priv->stat.recent_latencies;
-
-  /* ignore first measurements that may be off */
-  if (priv->stat.latency_ignore_count) {
-    priv->stat.latency_ignore_count--;
-    return;
-  }
+  gint64 elapsed;
 
-  latency = g_new (gint64, 1);
-  *latency = end_time - priv->stat.latest_invoke_time;
-  priv->stat.total_invoke_latency += *latency;
-  priv->stat.total_invoke_num += 1;
-
-  if (g_queue_get_length (recent_latencies) == GST_TF_STAT_MAX_RECENT)
-    g_free (g_queue_pop_head (recent_latencies));
-  g_queue_push_tail (recent_latencies, latency);
+  if (sw->estimate[index] == 0)
+    return 0;
 
-  /* the queue should have at least one element */
-  g_assert (g_queue_get_length (recent_latencies) != 0);
+  elapsed = (now - sw->measured[index]) / GST_TF_ACCL_SWITCH_HALFLIFE;
+  return (elapsed >= 62) ? 0 : (sw->estimate[index] >> elapsed);
+}
 
-  if (priv->latency_mode > 0 || priv->latency_reporting) {
-    gint64 avg_latency = 0;
+/**
+ * @brief Thread to switch the framework instance to the other accelerator (accl-switch-high).
+ */
+static gpointer
+gst_tensor_filter_accl_switch_thread (gpointer user_data)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER (user_data);
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterAcclSwitch *sw = &self->accl_switch;
+  GstTensorFilterProperties new_prop;
+  GstTensorFilterFrameworkEventData data;
+  GstStructure *s;
+  void *new_data = NULL;
+  void *old_data;
+  gboolean switched = FALSE;
+  guint from, to;
+  gint64 latency, start_time, duration;
+
+  start_time = g_get_monotonic_time ();
+
+  g_mutex_lock (&sw->lock);
+  from = sw->current;
+  to = sw->target;
+  latency = sw->estimate[from];
+  g_mutex_unlock (&sw->lock);
+
+  /* the framework may switch the accelerator of the instance by itself */
+  memset (&data, 0, sizeof (GstTensorFilterFrameworkEventData));
+  data.hw_list = &sw->hw[to];
+  data.num_hw = 1;
+
+  g_mutex_lock (&self->reload.lock);
+  if (priv->fw->eventHandler (priv->fw, &priv->prop, priv->privateData,
+          SET_ACCELERATOR, &data) == 0) {
+    /* the first invoke on the accelerator may take long */
+    gst_tensor_filter_warmup_instance (self, &priv->privateData, 1);
+    switched = TRUE;
+  }
+  g_mutex_unlock (&self->reload.lock);
 
-    g_queue_foreach (recent_latencies, accumulate_latency, &avg_latency);
-    avg_latency /= g_queue_get_length (recent_latencies);
+  if (switched)
+    goto done;
 
-    /* check integer overflow */
-    if (avg_latency <= INT32_MAX)
-      priv->prop.latency = (gint) avg_latency;
-    else
-      priv->prop.latency = -1;
+  /* open the model on the accelerator and switch the instance between invokes */
+  memcpy (&new_prop, &priv->prop, sizeof (GstTensorFilterProperties));
+  new_prop.hw_list = &sw->hw[to];
+  new_prop.num_hw = 1;
 
-    ml_logi ("[%s] Invoke took %.3f ms", TF_MODELNAME (&(priv->prop)),
-        (*latency) / 1000.0);
+  if (priv->fw->open (&new_prop, &new_data) < 0) {
+    GST_WARNING_OBJECT (self, "Failed to open the framework on %s.",
+        get_accl_hw_str (sw->hw[to]));
+    goto done;
   }
 
-  if (priv->throughput_mode > 0) {
-    gint throughput_int = -1;
-
-    if (priv->stat.total_invoke_latency != 0) {
-      gdouble throughput =
-          (gdouble) (priv->stat.total_invoke_num * G_USEC_PER_SEC * 1000) /
-          priv->stat.total_invoke_latency;
+  if (!gst_tensor_filter_reload_check_info (self, &new_prop, &new_data) ||
+      !gst_tensor_filter_warmup_instance (self, &new_data, 1)) {
+    if (priv->fw->close)
+      priv->fw->close (&new_prop, &new_data);
+    goto done;
+  }
 
-      /* check integer overflow */
-      if (throughput <= INT32_MAX)
-        throughput_int = (gint) throughput;
-    }
+  g_mutex_lock (&self->reload.lock);
+  old_data = priv->privateData;
+  priv->privateData = new_data;
+  g_mutex_unlock (&self->reload.lock);
 
-    /* note that it's a 1000x larger value than actual throughput */
-    priv->prop.throughput = throughput_int;
+  if (priv->fw->close)
+    priv->fw->close (&priv->prop, &old_data);
+  switched = TRUE;
 
-    ml_logi ("[%s] Throughput: %.2f FPS", TF_MODELNAME (&(priv->prop)),
-        throughput_int / 1000.0);
-  }
+done:
+  duration = g_get_monotonic_time () - start_time;
 
-  /**
-   * statistics values are monotonously increasing.
-   * to avoid potential overflow, let's cache old values and subtract them
-   * from the statistics if some threshold is exceeded.
-   */
-  if (priv->stat.total_invoke_num > THRESHOLD_DROP_OLD) {
-    priv->stat.total_invoke_latency -= priv->stat.old_total_invoke_latency;
-    priv->stat.total_invoke_num -= priv->stat.old_total_invoke_num;
-    /* drop cached values */
-    priv->stat.old_total_invoke_latency = 0;
-    priv->stat.old_total_invoke_num = 0;
-  } else if (priv->stat.total_invoke_num > THRESHOLD_CACHE_OLD) {
-    /* cache old values if they are not yet set */
-    if (priv->stat.old_total_invoke_num == 0) {
-      priv->stat.old_total_invoke_latency = priv->stat.total_invoke_latency;
-      priv->stat.old_total_invoke_num = priv->stat.total_invoke_num;
-    }
+  g_mutex_lock (&sw->lock);
+  if (switched) {
+    sw->current = to;
+    sw->switches++;
+  } else {
+    /* do not try the accelerator until it cools down */
+    sw->estimate[to] = MAX (latency, (gint64) priv->accl_switch_high) * 2;
+    sw->measured[to] = g_get_monotonic_time ();
   }
+  sw->switched = g_get_monotonic_time ();
+  sw->running = FALSE;
+  g_mutex_unlock (&sw->lock);
+
+  GST_INFO_OBJECT (self, "Switching the accelerator from %s to %s %s, "
+      "it took %" G_GINT64_FORMAT " us.", get_accl_hw_str (sw->hw[from]),
+      get_accl_hw_str (sw->hw[to]), switched ? "is done" : "has failed",
+      duration);
+
+  s = gst_structure_new ("tensor-filter-accl-switch",
+      "from", G_TYPE_STRING, get_accl_hw_str (sw->hw[from]),
+      "to", G_TYPE_STRING, get_accl_hw_str (sw->hw[to]),
+      "latency", G_TYPE_INT64, latency,
+      "success", G_TYPE_BOOLEAN, switched,
+      "duration", G_TYPE_INT64, duration, NULL);
+  gst_element_post_message (GST_ELEMENT_CAST (self),
+      gst_message_new_element (GST_OBJECT_CAST (self), s));
+
+  return NULL;
 }
 
-
 /**
- * @brief Track estimated latency and notify pipeline when it changes.
- *        Latency estimates may be a bit jittery. On the principle we want to
- *        inform pipeline with the latency from longest inference.
- *        However, first inference may take much longer, or model filter
- *        configuration may change. Therefore any change of more than 10%
- *        (arbitrary value) to a lower latency is also reported to pipeline.
- *        Notification is done sending LATENCY message to bus. Upon receipt,
- *        application will initiate a pipeline latency probe via LATENCY query.
+ * @brief Wait for the thread switching the accelerator.
  */
 static void
-track_latency (GstTensorFilter * self)
+gst_tensor_filter_accl_switch_join (GstTensorFilter * self)
 {
-  GstTensorFilterPrivate *priv = &self->priv;
-  gdouble estimated, reported, deviation;
-
-  GST_OBJECT_LOCK (self);
-  estimated = priv->prop.latency * GST_USECOND;
-  reported = priv->latency_reported;
-  GST_OBJECT_UNLOCK (self);
-
-  if ((priv->latency_reporting) && (estimated > 0)) {
-    if (reported > 0)
-      deviation = ABS (estimated - reported) / reported;
-    else
-      deviation = 0;
-
-    if ((estimated > reported) || (deviation > LATENCY_REPORT_THRESHOLD)) {
-
-      ml_logd ("[%s] latency reported:%.0f estimated:%.0f deviation:%.4f",
-          TF_MODELNAME (&(priv->prop)), reported, estimated, deviation);
-
-      gst_element_post_message (GST_ELEMENT_CAST (self),
-          gst_message_new_latency (GST_OBJECT_CAST (self)));
-    }
+  if (self->accl_switch.thread) {
+    g_thread_join (self->accl_switch.thread);
+    self->accl_switch.thread = NULL;
   }
 }
 
 /**
- * @brief Check throttling delay and send qos overflow event to upstream elements
+ * @brief Update the latency of the current accelerator and switch the accelerator with the hysteresis (accl-switch-high).
+ * @param self "this" pointer
+ * @param latency the latency (usec) of the invoke with the main instance
  */
-static gboolean
-gst_tensor_filter_check_throttling_delay (GstBaseTransform * trans,
-    GstBuffer * inbuf)
+static void
+gst_tensor_filter_accl_switch_update (GstTensorFilter * self, gint64 latency)
 {
-  GstTensorFilter *self;
-  GstTensorFilterPrivate *priv;
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterAcclSwitch *sw = &self->accl_switch;
+  gint64 now, high, low, estimate, best_estimate;
+  guint i, cur, target;
+  GError *error = NULL;
 
-  self = GST_TENSOR_FILTER_CAST (trans);
-  priv = &self->priv;
+  if (sw->num_hw < 2)
+    return;
 
-  GST_OBJECT_LOCK (trans);
+  now = g_get_monotonic_time ();
+  high = (gint64) priv->accl_switch_high;
+  low = (priv->accl_switch_low > 0) ? (gint64) priv->accl_switch_low : high / 2;
 
-  if (self->throttling_delay != 0) {
-    GstClockTime curr_ts = GST_BUFFER_PTS (inbuf);
-    GstClockTime prev_ts = self->prev_ts;
+  g_mutex_lock (&sw->lock);
 
-    self->prev_ts = curr_ts;
+  /* the invoke may be done with the previous instance while switching */
+  if (sw->running)
+    goto done;
 
-    if (GST_CLOCK_TIME_IS_VALID (prev_ts)) {
-      GstClockTimeDiff diff = curr_ts - prev_ts;
-      GstClockTimeDiff delay;
+  cur = sw->current;
+  estimate = sw->estimate[cur];
+  sw->estimate[cur] = (estimate == 0) ? latency :
+      estimate + (latency - estimate) / GST_TF_ACCL_SWITCH_WEIGHT;
+  sw->measured[cur] = now;
 
-      self->throttling_accum += diff;
+  if (now - sw->switched < GST_TF_ACCL_SWITCH_DWELL)
+    goto done;
 
-      /* check whether the average latency is longer than throttling delay */
-      delay = MAX (priv->prop.latency * 1000, self->throttling_delay);
+  target = cur;
 
-      if (self->throttling_accum < delay) {
-        GstClockTimeDiff duration = GST_BUFFER_DURATION (inbuf);        /* original */
-        gdouble avg_rate = gst_guint64_to_gdouble (duration) /
-            gst_guint64_to_gdouble (delay);
+  /* go back to the preferred accelerator if it has cooled down */
+  for (i = 0; i < cur; i++) {
+    if (gst_tensor_filter_accl_switch_get_estimate (sw, i, now) <= low) {
+      target = i;
+      break;
+    }
+  }
 
-        /**
-         * Send qos overflow event to upstream elements.
-         * Upstream elements (e.g., tensor_src, tensor_converter) may handle this.
-         */
-        GstPad *sinkpad = GST_BASE_TRANSFORM_SINK_PAD (&self->element);
-        GstEvent *event = gst_event_new_qos (GST_QOS_TYPE_OVERFLOW,
-            avg_rate, (self->throttling_accum - delay), curr_ts);
+  /* leave the overloaded accelerator for the fastest one expected */
+  if (target == cur && sw->estimate[cur] > high) {
+    best_estimate = sw->estimate[cur];
 
-        gst_pad_push_event (sinkpad, event);
+    for (i = 0; i < sw->num_hw; i++) {
+      if (i == cur)
+        continue;
 
-        GST_OBJECT_UNLOCK (trans);
-        return TRUE;
+      estimate = gst_tensor_filter_accl_switch_get_estimate (sw, i, now);
+      if (estimate < best_estimate) {
+        best_estimate = estimate;
+        target = i;
       }
-
-      self->throttling_accum = 0;
     }
   }
 
-  GST_OBJECT_UNLOCK (trans);
-  return FALSE;
+  if (target == cur)
+    goto done;
+
+  gst_tensor_filter_accl_switch_join (self);
+
+  sw->target = target;
+  sw->running = TRUE;
+  sw->thread = g_thread_try_new ("tensor_filter_accl_switch",
+      gst_tensor_filter_accl_switch_thread, self, &error);
+  if (!sw->thread) {
+    GST_WARNING_OBJECT (self, "Failed to start the thread to switch the "
+        "accelerator: %s", error ? error->message : "unknown error");
+    g_clear_error (&error);
+    sw->running = FALSE;
+    sw->switched = now;
+  }
+
+done:
+  g_mutex_unlock (&sw->lock);
 }
 
 /**
- * @brief Check input paramters for gst_tensor_filter_transform ();
+ * @brief Check the filter can switch the accelerator, with the accelerators given in the order of preference (accl-switch-high).
  */
-static GstFlowReturn
+static void
+gst_tensor_filter_accl_switch_start (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstTensorFilterAcclSwitch *sw = &self->accl_switch;
+  guint i;
+
+  g_mutex_lock (&sw->lock);
+  sw->num_hw = sw->current = 0;
+  sw->switches = 0;
+  sw->switched = g_get_monotonic_time ();
+  g_mutex_unlock (&sw->lock);
+
+  if (priv->accl_switch_high == 0)
+    return;
+
+  /**
+   * The instance cannot be switched if the model is shared, the outputs refer to the instance (allocate_in_invoke),
+   * the model is invoked with multiple instances, or the tensors are kept in the device memory.
+   */
+  if (!GST_TF_FW_V1 (priv->fw) || !priv->fw->open || prop->num_hw < 2 ||
+      prop->shared_tensor_filter_key || priv->num_workers > 1 ||
+      priv->max_batch > 1 || priv->device_ops ||
+      gst_tensor_filter_allocate_in_invoke (priv)) {
+    GST_WARNING_OBJECT (self,
+        "Cannot switch the accelerator, accl-switch-high requires multiple accelerators of the framework (V1) and is not applied with the shared model, workers, max-batch, allocate_in_invoke or the device memory.");
+    return;
+  }
+
+  g_mutex_lock (&sw->lock);
+  sw->num_hw = MIN ((guint) prop->num_hw, GST_TF_MAX_ACCL_SWITCH);
+  for (i = 0; i < sw->num_hw; i++) {
+    sw->hw[i] = prop->hw_list[i];
+    sw->estimate[i] = sw->measured[i] = 0;
+  }
+  g_mutex_unlock (&sw->lock);
+}
+
+/**
+ * @brief Stop switching the accelerator.
+ */
+static void
+gst_tensor_filter_accl_switch_stop (GstTensorFilter * self)
+{
+  gst_tensor_filter_accl_switch_join (self);
+  self->accl_switch.num_hw = 0;
+}
+
+/**
+ * @brief Setter for tensor_filter properties.
+ */
+static void
+gst_tensor_filter_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstTensorFilter *self;
+  GstTensorFilterPrivate *priv;
+
+  self = GST_TENSOR_FILTER (object);
+  priv = &self->priv;
+
+  silent_debug (self, "Setting property for prop %d.\n", prop_id);
+
+  /* double-buffered reload of the model */
+  if (g_str_equal (pspec->name, "model") &&
+      gst_tensor_filter_reload_start (self, value))
+    return;
+
+  if (!gst_tensor_filter_common_set_property (priv, prop_id, value, pspec)) {
+    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+    return;
+  }
+
+  /* the outputs of the previous model are not used */
+  if (g_str_equal (pspec->name, "model")) {
+    g_atomic_int_set (&self->skip.invalid, TRUE);
+    if (priv->cache)
+      gst_tensor_filter_cache_clear (priv->cache);
+  }
+}
+
+/**
+ * @brief Getter for tensor_filter properties.
+ */
+static void
+gst_tensor_filter_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstTensorFilter *self;
+  GstTensorFilterPrivate *priv;
+
+  self = GST_TENSOR_FILTER (object);
+  priv = &self->priv;
+
+  silent_debug (self, "Getting property for prop %d.\n", prop_id);
+
+  if (!gst_tensor_filter_common_get_property (priv, prop_id, value, pspec))
+    G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+}
+
+/**
+ * @brief Free the data allocated for tensor transform
+ * @details default function for tensor filter framework if not provided by the
+ *          framework. The data is in GPtrArray - first element is tensor-filter,
+ *          second element is the data to be freed and third element is the
+ *          private data of framework instance which allocated the data.
+ */
+static void
+gst_tensor_filter_destroy_notify (void *data)
+{
+  GPtrArray *array = (GPtrArray *) data;
+  GstTensorFilter *self = (GstTensorFilter *) g_ptr_array_index (array, 0);
+  void *tensor_data = (void *) g_ptr_array_index (array, 1);
+  void **private_data = (void **) g_ptr_array_index (array, 2);
+  g_ptr_array_free (array, TRUE);
+
+  gst_tensor_filter_destroy_notify_util_full (&self->priv, private_data,
+      tensor_data);
+}
+
+/**
+ * @brief Allocate new memory block from given data.
+ * @details tensor-filter should send event to sub-plugin when memory is freed.
+ */
+static GstMemory *
+gst_tensor_filter_get_wrapped_mem (GstTensorFilter * self,
+    void **private_data, gpointer data, gsize size)
+{
+  GPtrArray *data_array = g_ptr_array_new ();
+
+  g_ptr_array_add (data_array, (gpointer) self);
+  g_ptr_array_add (data_array, (gpointer) data);
+  g_ptr_array_add (data_array, (gpointer) private_data);
+
+  return gst_memory_new_wrapped (0, data, size, 0, size, (gpointer) data_array,
+      gst_tensor_filter_destroy_notify);
+}
+
+/**
+ * @brief Allocate new memory block from given device data.
+ * @details The device data is released with the destroy notify of the sub-plugin, same as the wrapped memory.
+ */
+static GstMemory *
+gst_tensor_filter_get_device_mem (GstTensorFilter * self,
+    void **private_data, gpointer data, gsize size)
+{
+  GPtrArray *data_array = g_ptr_array_new ();
+  GstMemory *mem;
+
+  g_ptr_array_add (data_array, (gpointer) self);
+  g_ptr_array_add (data_array, (gpointer) data);
+  g_ptr_array_add (data_array, (gpointer) private_data);
+
+  mem = gst_tensor_device_memory_new (self->priv.device_ops, data, size,
+      (gpointer) data_array, gst_tensor_filter_destroy_notify);
+  if (!mem)
+    gst_tensor_filter_destroy_notify (data_array);
+
+  return mem;
+}
+
+/**
+ * @brief The completion of the invoke with the memory of the tensors (V2).
+ */
+typedef struct
+{
+  GMutex lock;
+  GCond cond;
+  gboolean done; /**< the framework called the completion callback */
+  gint ret; /**< the result given by the framework */
+} GstTensorFilterInvokeCompletion;
+
+/**
+ * @brief The completion callback of the invoke with the memory of the tensors (V2).
+ */
+static void
+gst_tensor_filter_invoke_done (void *handle, int ret)
+{
+  GstTensorFilterInvokeCompletion *completion = handle;
+
+  g_mutex_lock (&completion->lock);
+  completion->ret = ret;
+  completion->done = TRUE;
+  g_cond_signal (&completion->cond);
+  g_mutex_unlock (&completion->lock);
+}
+
+/**
+ * @brief Invoke the model with the memory of the tensors (V2), and wait for the completion.
+ * @return 0 if OK and the output memory is set. Otherwise, the output memory is released.
+ */
+static gint
+gst_tensor_filter_invoke_memory (GstTensorFilter * self, void *private_data,
+    GstMemory ** input, GstMemory ** output)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstTensorFilterInvokeCompletion completion;
+  guint i;
+  gint ret;
+
+  g_mutex_init (&completion.lock);
+  g_cond_init (&completion.cond);
+  completion.done = FALSE;
+  completion.ret = 0;
+
+  ret = priv->fw->invoke_memory (priv->fw, prop, private_data, input,
+      prop->input_meta.num_tensors, output, prop->output_meta.num_tensors,
+      gst_tensor_filter_invoke_done, &completion);
+
+  if (ret == -EINPROGRESS) {
+    g_mutex_lock (&completion.lock);
+    while (!completion.done)
+      g_cond_wait (&completion.cond, &completion.lock);
+    ret = completion.ret;
+    g_mutex_unlock (&completion.lock);
+  }
+
+  g_cond_clear (&completion.cond);
+  g_mutex_clear (&completion.lock);
+
+  for (i = 0; i < prop->output_meta.num_tensors && ret == 0; i++) {
+    if (!output[i] || gst_memory_get_sizes (output[i], NULL, NULL) !=
+        gst_tensor_filter_get_tensor_size (self, i, FALSE)) {
+      ml_loge
+          ("The tensor-filter subplugin (%s for %s) has set invalid memory for the %u'th output tensor.\n",
+          prop->fwname, TF_MODELNAME (prop), i);
+      ret = -EINVAL;
+    }
+  }
+
+  if (ret != 0) {
+    for (i = 0; i < prop->output_meta.num_tensors; i++) {
+      if (output[i]) {
+        gst_memory_unref (output[i]);
+        output[i] = NULL;
+      }
+    }
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Prepare statistics for performance profiling (e.g, latency, throughput)
+ * @return The time (usec) when the invoke starts.
+ */
+static gint64
+prepare_statistics (GstTensorFilterPrivate * priv)
+{
+  UNUSED (priv);
+  return g_get_real_time ();
+}
+
+/**
+ * @brief Record statistics for performance profiling (e.g, latency, throughput)
+ * @note This is called from the concurrent invoking threads without locking.
+ */
+static void
+record_statistics (GstTensorFilterPrivate * priv, gint64 start_time)
+{
+  GstTensorFilterStatSnapshot snapshot;
+  gint64 latency = g_get_real_time () - start_time;
+
+  if (priv->deadline > 0) {
+    gint64 estimate = g_atomic_int_get (&priv->invoke_estimate);
+
+    /* the invokes in the concurrent threads may overwrite each other */
+    estimate = (estimate == 0) ? latency : estimate + (latency - estimate) / 8;
+    g_atomic_int_set (&priv->invoke_estimate, (gint) CLAMP (estimate, 1,
+            G_MAXINT));
+  }
+
+  if (!gst_tensor_filter_statistics_record (&priv->stat, latency))
+    return;
+
+  if (priv->latency_mode == 0 && !priv->latency_reporting &&
+      priv->throughput_mode == 0)
+    return;
+
+  gst_tensor_filter_statistics_get_snapshot (&priv->stat, &snapshot);
+
+  if (priv->latency_mode > 0 || priv->latency_reporting) {
+    /* check integer overflow */
+    g_atomic_int_set (&priv->prop.latency,
+        (snapshot.recent_latency <= INT32_MAX) ?
+        (gint) snapshot.recent_latency : -1);
+
+    ml_logi ("[%s] Invoke took %.3f ms", TF_MODELNAME (&(priv->prop)),
+        latency / 1000.0);
+  }
+
+  if (priv->throughput_mode > 0) {
+    gint throughput_int = -1;
+    gdouble throughput = snapshot.throughput * 1000;
+
+    /* check integer overflow */
+    if (snapshot.invoke_latency != 0 && throughput <= INT32_MAX)
+      throughput_int = (gint) throughput;
+
+    /* note that it's a 1000x larger value than actual throughput */
+    g_atomic_int_set (&priv->prop.throughput, throughput_int);
+
+    ml_logi ("[%s] Throughput: %.2f FPS", TF_MODELNAME (&(priv->prop)),
+        throughput_int / 1000.0);
+  }
+}
+
+
+/**
+ * @brief Track estimated latency and notify pipeline when it changes.
+ *        Latency estimates may be a bit jittery. On the principle we want to
+ *        inform pipeline with the latency from longest inference.
+ *        However, first inference may take much longer, or model filter
+ *        configuration may change. Therefore any change of more than 10%
+ *        (arbitrary value) to a lower latency is also reported to pipeline.
+ *        Notification is done sending LATENCY message to bus. Upon receipt,
+ *        application will initiate a pipeline latency probe via LATENCY query.
+ */
+static void
+track_latency (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  gdouble estimated, reported, deviation;
+
+  GST_OBJECT_LOCK (self);
+  estimated = g_atomic_int_get (&priv->prop.latency) * GST_USECOND;
+  reported = priv->latency_reported;
+  GST_OBJECT_UNLOCK (self);
+
+  /* the frames may wait for the batch (see gst_tensor_filter_query()) */
+  if (priv->max_batch > 1 && estimated > 0)
+    estimated += (gdouble) priv->batch_timeout * GST_USECOND;
+
+  if ((priv->latency_reporting) && (estimated > 0)) {
+    if (reported > 0)
+      deviation = ABS (estimated - reported) / reported;
+    else
+      deviation = 0;
+
+    if ((estimated > reported) || (deviation > LATENCY_REPORT_THRESHOLD)) {
+
+      ml_logd ("[%s] latency reported:%.0f estimated:%.0f deviation:%.4f",
+          TF_MODELNAME (&(priv->prop)), reported, estimated, deviation);
+
+      gst_element_post_message (GST_ELEMENT_CAST (self),
+          gst_message_new_latency (GST_OBJECT_CAST (self)));
+    }
+  }
+}
+
+/**
+ * @brief Post the element message with the per-op profile of the framework, if the framework supports it.
+ * @note The profile of the main instance is posted, the invoke is serialized with the reload lock.
+ */
+static void
+post_profile (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstStructure *s;
+  gchar *profile;
+
+  if (!priv->prop.fw_opened)
+    return;
+
+  g_mutex_lock (&self->reload.lock);
+  profile = gst_tensor_filter_get_profile (priv, priv->privateData);
+  g_mutex_unlock (&self->reload.lock);
+
+  if (!profile)
+    return;
+
+  s = gst_structure_new ("tensor-filter-profile",
+      "framework", G_TYPE_STRING, priv->prop.fwname,
+      "model", G_TYPE_STRING, TF_MODELNAME (&priv->prop),
+      "profile", G_TYPE_STRING, profile, NULL);
+  g_free (profile);
+
+  gst_element_post_message (GST_ELEMENT_CAST (self),
+      gst_message_new_element (GST_OBJECT_CAST (self), s));
+}
+
+/**
+ * @brief Post the element message with the status of the compiled model cache, if the framework uses the cache.
+ */
+static void
+post_model_cache (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstStructure *s;
+  gboolean hit;
+  gint64 compile_time;
+
+  if (!gst_tensor_filter_get_model_cache (priv, priv->privateData, &hit,
+          &compile_time))
+    return;
+
+  GST_INFO_OBJECT (self, "compiled model cache %s, %" G_GINT64_FORMAT " usec",
+      hit ? "hit" : "miss", compile_time);
+
+  s = gst_structure_new ("tensor-filter-model-cache",
+      "framework", G_TYPE_STRING, priv->prop.fwname,
+      "model", G_TYPE_STRING, TF_MODELNAME (&priv->prop),
+      "cache-hit", G_TYPE_BOOLEAN, hit,
+      "compile-time", G_TYPE_INT64, compile_time, NULL);
+
+  gst_element_post_message (GST_ELEMENT_CAST (self),
+      gst_message_new_element (GST_OBJECT_CAST (self), s));
+}
+
+/**
+ * @brief Post the element message with the latency percentiles and throughput periodically.
+ * @return TRUE if the message is posted.
+ */
+static gboolean
+post_statistics (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterStatistics *stat = &priv->stat;
+  GstTensorFilterStatSnapshot snapshot;
+  GstStructure *s;
+  gint64 now;
+
+  if (priv->stats_interval == 0)
+    return FALSE;
+
+  /* only one of the invoking threads posts the message */
+  if (!g_mutex_trylock (&stat->stats_lock))
+    return FALSE;
+
+  now = g_get_monotonic_time ();
+  if (stat->latest_stats_time != 0 &&
+      now - stat->latest_stats_time < (gint64) priv->stats_interval * 1000) {
+    g_mutex_unlock (&stat->stats_lock);
+    return FALSE;
+  }
+
+  gst_tensor_filter_statistics_get_snapshot (stat, &snapshot);
+  if (snapshot.invoke_num == 0) {
+    g_mutex_unlock (&stat->stats_lock);
+    return FALSE;
+  }
+
+  stat->latest_stats_time = now;
+  g_mutex_unlock (&stat->stats_lock);
+
+  s = gst_structure_new ("tensor-filter-stats",
+      "latency-p50", G_TYPE_INT64, snapshot.latency_p50,
+      "latency-p90", G_TYPE_INT64, snapshot.latency_p90,
+      "latency-p99", G_TYPE_INT64, snapshot.latency_p99,
+      "latency-max", G_TYPE_INT64, snapshot.latency_max,
+      "invoke-count", G_TYPE_UINT64, snapshot.invoke_num,
+      "throughput", G_TYPE_DOUBLE, snapshot.throughput, NULL);
+
+  if (priv->sched_client) {
+    GstTensorFilterSchedStats sched;
+
+    gst_tensor_filter_scheduler_get_stats (priv->sched_client, &sched);
+    gst_structure_set (s,
+        "accl-utilization", G_TYPE_DOUBLE, sched.utilization,
+        "accl-queued", G_TYPE_UINT, sched.queued,
+        "accl-fallbacks", G_TYPE_UINT64, sched.fallback_num, NULL);
+  }
+
+  if (priv->skip_threshold > 0.0) {
+    gst_structure_set (s,
+        "skip-count", G_TYPE_UINT64, priv->skip_num,
+        "skip-rate", G_TYPE_DOUBLE, (priv->skip_frames > 0) ?
+        (gdouble) priv->skip_num / priv->skip_frames : 0.0, NULL);
+  }
+
+  if (priv->deadline > 0) {
+    gst_structure_set (s,
+        "deadline-drops", G_TYPE_UINT64, self->deadline.dropped, NULL);
+  }
+
+  if (self->cascade.num_stages > 0) {
+    gst_structure_set (s,
+        "cascade-depth", G_TYPE_DOUBLE, (priv->cascade_frames > 0) ?
+        (gdouble) priv->cascade_invokes / priv->cascade_frames : 0.0, NULL);
+  }
+
+  if (priv->cache) {
+    GstTensorFilterCacheStats cache;
+
+    gst_tensor_filter_cache_get_stats (priv->cache, &cache);
+    gst_structure_set (s,
+        "cache-hits", G_TYPE_UINT64, cache.hits,
+        "cache-misses", G_TYPE_UINT64, cache.misses,
+        "cache-bytes", G_TYPE_UINT64, (guint64) cache.bytes, NULL);
+  }
+
+  gst_element_post_message (GST_ELEMENT_CAST (self),
+      gst_message_new_element (GST_OBJECT_CAST (self), s));
+  return TRUE;
+}
+
+/**
+ * @brief Check throttling delay and send qos overflow event to upstream elements
+ */
+static gboolean
+gst_tensor_filter_check_throttling_delay (GstBaseTransform * trans,
+    GstBuffer * inbuf)
+{
+  GstTensorFilter *self;
+  GstTensorFilterPrivate *priv;
+
+  self = GST_TENSOR_FILTER_CAST (trans);
+  priv = &self->priv;
+
+  GST_OBJECT_LOCK (trans);
+
+  if (self->throttling_delay != 0) {
+    GstClockTime curr_ts = GST_BUFFER_PTS (inbuf);
+    GstClockTime prev_ts = self->prev_ts;
+
+    self->prev_ts = curr_ts;
+
+    if (GST_CLOCK_TIME_IS_VALID (prev_ts)) {
+      GstClockTimeDiff diff = curr_ts - prev_ts;
+      GstClockTimeDiff delay;
+
+      self->throttling_accum += diff;
+
+      /* check whether the average latency is longer than throttling delay */
+      delay = MAX (priv->prop.latency * 1000, self->throttling_delay);
+
+      if (self->throttling_accum < delay) {
+        GstClockTimeDiff duration = GST_BUFFER_DURATION (inbuf);        /* original */
+        gdouble avg_rate = gst_guint64_to_gdouble (duration) /
+            gst_guint64_to_gdouble (delay);
+
+        /**
+         * Send qos overflow event to upstream elements.
+         * Upstream elements (e.g., tensor_src, tensor_converter) may handle this.
+         */
+        GstPad *sinkpad = GST_BASE_TRANSFORM_SINK_PAD (&self->element);
+        GstEvent *event = gst_event_new_qos (GST_QOS_TYPE_OVERFLOW,
+            avg_rate, (self->throttling_accum - delay), curr_ts);
+
+        gst_pad_push_event (sinkpad, event);
+
+        GST_OBJECT_UNLOCK (trans);
+        return TRUE;
+      }
+
+      self->throttling_accum = 0;
+    }
+  }
+
+  GST_OBJECT_UNLOCK (trans);
+  return FALSE;
+}
+
+/**
+ * @brief Check the frame would miss the deadline with the clock and the QoS events from downstream, and post the QoS message for the dropped frame.
+ * @return TRUE if the frame should be dropped without the invoke.
+ */
+static gboolean
+gst_tensor_filter_check_deadline (GstBaseTransform * trans, GstBuffer * inbuf)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterDeadline *deadline = &self->deadline;
+  GstClockTime running_time, stream_time, earliest, base_time, now;
+  GstClock *clock = NULL;
+  GstMessage *msg;
+  gboolean late = FALSE;
+
+  if (priv->deadline == 0)
+    return FALSE;
+
+  running_time = gst_segment_to_running_time (&trans->segment,
+      GST_FORMAT_TIME, GST_BUFFER_PTS (inbuf));
+  if (!GST_CLOCK_TIME_IS_VALID (running_time))
+    return FALSE;
+
+  GST_OBJECT_LOCK (trans);
+  earliest = deadline->earliest;
+  base_time = GST_ELEMENT_CAST (trans)->base_time;
+  if (GST_STATE (trans) == GST_STATE_PLAYING && GST_ELEMENT_CLOCK (trans))
+    clock = gst_object_ref (GST_ELEMENT_CLOCK (trans));
+  GST_OBJECT_UNLOCK (trans);
+
+  /* downstream has reported the frames before the earliest time are late */
+  if (GST_CLOCK_TIME_IS_VALID (earliest) && running_time <= earliest)
+    late = TRUE;
+
+  if (!late && clock) {
+    now = gst_clock_get_time (clock);
+
+    if (GST_CLOCK_TIME_IS_VALID (now) && now > base_time) {
+      now = now - base_time +
+          (GstClockTime) g_atomic_int_get (&priv->invoke_estimate) * GST_USECOND;
+      late = (now > running_time + priv->deadline * GST_USECOND);
+    }
+  }
+
+  if (clock)
+    gst_object_unref (clock);
+
+  if (!late) {
+    deadline->processed++;
+    return FALSE;
+  }
+
+  deadline->dropped++;
+  silent_debug (self, "Dropped the late frame (running time %" GST_TIME_FORMAT
+      ").\n", GST_TIME_ARGS (running_time));
+
+  stream_time = gst_segment_to_stream_time (&trans->segment, GST_FORMAT_TIME,
+      GST_BUFFER_PTS (inbuf));
+  msg = gst_message_new_qos (GST_OBJECT_CAST (self), TRUE, running_time,
+      stream_time, GST_BUFFER_PTS (inbuf), GST_BUFFER_DURATION (inbuf));
+  gst_message_set_qos_stats (msg, GST_FORMAT_BUFFERS, deadline->processed,
+      deadline->dropped);
+  gst_element_post_message (GST_ELEMENT_CAST (self), msg);
+
+  return TRUE;
+}
+
+/**
+ * @brief Check input paramters for gst_tensor_filter_transform ();
+ */
+static GstFlowReturn
 _gst_tensor_filter_transform_validate (GstBaseTransform * trans,
     GstBuffer * inbuf, GstBuffer * outbuf)
 {
-  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+
+  if (G_UNLIKELY (!priv->configured)) {
+    GST_ELEMENT_ERROR_BTRACE (self, STREAM, TYPE_NOT_FOUND,
+        ("The tensor_filter instance is not configured (pad caps not negotiated). Property info (framework = '%s', framework_opened = %d, model[0] = '%s', num-models = %d, custom_properties = '%s'.",
+            prop ? prop->fwname : "property info is NULL.",
+            prop ? prop->fw_opened : -1,
+            prop ? TF_MODELNAME (prop) : "property info is NULL.",
+            prop ? prop->num_models : -1,
+            prop ? prop->custom_properties : "property info is NULL."));
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+  if (G_UNLIKELY (!priv->fw)) {
+    /**
+      * This is fatal; if framework is not configured until this stage,
+      * it means that an extension is missing or not configured.
+      * We need readable messages for non-developers
+      */
+    GST_ELEMENT_ERROR_BTRACE (self, STREAM, FAILED,
+        ("Framework (filter subplugin) is not found or not configured: 'framework=%s'. Please check if the given framework name is correct and the given model path is consistent with the intended framework especially if 'framework=auto' is given. Please refer to the warning messages created when the framework property is set.",
+            priv->prop.fwname));
+    ml_logf
+        ("\nA corresponding nnstreamer extension (tensor_filter subplugin) is not installed or the framework property of tensor_filter is incorrect: [%s] is not found.\n\n",
+        prop->fwname);
+    return GST_FLOW_ERROR;
+  }
+  if (G_UNLIKELY (!priv->fw->run_without_model) &&
+      G_UNLIKELY (!(prop->model_files &&
+              prop->num_models > 0 && prop->model_files[0]))) {
+    GST_ELEMENT_ERROR_BTRACE (self, STREAM, FAILED,
+        ("For the framework='%s', its model filepath is not provided and this framework requires a model file. Thus, we cannot proceed with tensor_filter for inferences. Please provide a valid model file path.",
+            prop->fwname));
+    return GST_FLOW_ERROR;
+  }
+  if ((GST_TF_FW_V0 (priv->fw) && G_UNLIKELY (!priv->fw->invoke_NN)) ||
+      (GST_TF_FW_V1 (priv->fw) && G_UNLIKELY (!priv->fw->invoke))) {
+    GST_ELEMENT_ERROR_BTRACE (self, STREAM, FAILED,
+        ("The tensor-filter subplugin for the framework='%s' does not have its mandatory methods (or callback functions). It appears that your subplugin implementation of '%s' is not completed. There is no 'invoke_NN (v1)' or 'invoke (v2)' methods available.",
+            prop->fwname, prop->fwname));
+    return GST_FLOW_ERROR;
+  }
+
+  silent_debug (self, "Invoking %s with %s model\n", priv->fw->name,
+      GST_STR_NULL (prop->model_files[0]));
+
+  /* skip input data when throttling delay is set */
+  if (gst_tensor_filter_check_throttling_delay (trans, inbuf))
+    return GST_BASE_TRANSFORM_FLOW_DROPPED;
+
+  /* skip input data which cannot get the output before the deadline */
+  if (gst_tensor_filter_check_deadline (trans, inbuf))
+    return GST_BASE_TRANSFORM_FLOW_DROPPED;
+
+  if (!outbuf) {
+    GST_ELEMENT_ERROR_BTRACE (self, STREAM, FAILED,
+        ("The output buffer for the instance of tensor-filter subplugin (%s / %s) is null. Cannot proceed.",
+            prop->fwname, TF_MODELNAME (prop)));
+    return GST_FLOW_ERROR;
+  }
+  /* the buffer from the tensor buffer pool has the memory chunks to be filled */
+  if (!gst_tensor_buffer_pool_is_pooled (outbuf) &&
+      gst_buffer_get_size (outbuf) != 0) {
+    GST_ELEMENT_ERROR_BTRACE (self, STREAM, FAILED,
+        ("The output buffer for the isntance of tensor-filter subplugin (%s / %s) already has a content (buffer size = %zu). It should be 0.",
+            prop->fwname, TF_MODELNAME (prop), gst_buffer_get_size (outbuf)));
+    return GST_FLOW_ERROR;
+  }
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Invoke the model with the given instance of the framework and fill the output buffer.
+ * @param self "this" pointer
+ * @param private_data the private data of framework instance to invoke
+ * @param inbuf the input buffer
+ * @param outbuf the output buffer to be filled (empty buffer)
+ */
+static GstFlowReturn
+gst_tensor_filter_invoke_buffer (GstTensorFilter * self, void **private_data,
+    GstBuffer * inbuf, GstBuffer * outbuf)
+{
+  GstBaseTransform *trans = GST_BASE_TRANSFORM_CAST (self);
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstMemory *in_mem[NNS_TENSOR_SIZE_LIMIT] = { 0, };
+  GstMemory *invoke_mem[NNS_TENSOR_SIZE_LIMIT] = { 0, };
+  GstMapInfo in_info[NNS_TENSOR_SIZE_LIMIT];
+  GstMemory *out_mem[NNS_TENSOR_SIZE_LIMIT] = { 0, };
+  GstMapInfo out_info[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory invoke_tensors[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT];
+  GList *list;
+  guint i, num_mems;
+  gint ret;
+  gboolean allocate_in_invoke, in_flexible, in_sparse, out_flexible, out_pooled;
+  gboolean mem_invoke;
+  gboolean in_device = FALSE, out_device = FALSE;
+  GstTensorDmaBuf in_dmabuf[NNS_TENSOR_SIZE_LIMIT];
+  gboolean use_dmabuf = FALSE;
+  gboolean need_profiling, need_trace;
+  gsize expected, hsize;
+  gint64 start_time = 0;
+  GstClockTime trace_start = 0;
+  gboolean accl_acquired = FALSE, accl_fallback = FALSE;
+  nns_profile_declare (compute_start);
+
+  GstTensorMetaInfo in_meta[NNS_TENSOR_SIZE_LIMIT];
+  GstTensorMetaInfo out_meta[NNS_TENSOR_SIZE_LIMIT];
+  GstMemory *mem;
+
+  allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
+
+  in_flexible =
+      gst_tensor_pad_caps_is_flexible (GST_BASE_TRANSFORM_SINK_PAD (trans));
+  out_flexible =
+      gst_tensor_pad_caps_is_flexible (GST_BASE_TRANSFORM_SRC_PAD (trans));
+
+  /* the framework takes the sparse tensors (header, values and indices) as they are */
+  in_sparse = priv->sparse_invoke;
+
+  /* outbuf from the tensor buffer pool already has the output memory chunks */
+  out_pooled = (!allocate_in_invoke && gst_tensor_buffer_pool_is_pooled (outbuf)
+      && gst_buffer_n_memory (outbuf) == prop->output_meta.num_tensors);
+
+  /* the framework takes the memory of the tensors without mapping (V2) */
+  mem_invoke = (GST_TF_FW_V2 (priv->fw) && priv->fw->invoke_memory &&
+      !in_flexible && !in_sparse && !out_flexible && !out_pooled);
+
+  /* 1. Get all input tensors from inbuf. */
+  /* Internal Logic Error or GST Bug (sinkcap changed!) */
+  num_mems = gst_buffer_n_memory (inbuf);
+
+  /* the tensors stay in the device memory between the filters on the same device */
+  if (priv->device_ops && !mem_invoke) {
+    out_device = (priv->device_memory && priv->device_output &&
+        !out_flexible && priv->max_batch <= 1);
+
+    /* all input tensors should be in the device memory of the framework */
+    in_device = (priv->device_input && !in_flexible && !in_sparse &&
+        num_mems > 0);
+    for (i = 0; i < num_mems && in_device; i++) {
+      in_device = (gst_tensor_device_memory_get_data (gst_buffer_peek_memory
+              (inbuf, i), priv->device_ops->type) != NULL);
+    }
+  }
+
+#ifdef HAVE_GST_DMABUF
+  /* the framework imports the fd of DMA-BUF (e.g., from camera) without mapping it */
+  if (priv->dmabuf_input && !mem_invoke && !in_device && !in_flexible &&
+      !in_sparse && num_mems > 0 && !priv->combi.in_combi_defined) {
+    use_dmabuf = TRUE;
+    for (i = 0; i < num_mems && use_dmabuf; i++)
+      use_dmabuf = gst_is_dmabuf_memory (gst_buffer_peek_memory (inbuf, i));
+  }
+#endif
+
+  for (i = 0; i < num_mems; i++) {
+    in_mem[i] = gst_buffer_peek_memory (inbuf, i);
+
+    if (mem_invoke) {
+      /* the framework maps or imports the memory by itself */
+      in_tensors[i].data = NULL;
+      in_tensors[i].size = gst_memory_get_sizes (in_mem[i], NULL, NULL);
+      continue;
+    }
+
+    if (in_device) {
+      /* the device data without the copy to host memory */
+      in_tensors[i].data = gst_tensor_device_memory_get_data (in_mem[i],
+          priv->device_ops->type);
+      in_tensors[i].size = gst_memory_get_sizes (in_mem[i], NULL, NULL);
+      continue;
+    }
+
+#ifdef HAVE_GST_DMABUF
+    if (use_dmabuf) {
+      in_dmabuf[i].fd = gst_dmabuf_memory_get_fd (in_mem[i]);
+      in_dmabuf[i].offset = in_mem[i]->offset;
+      in_dmabuf[i].size = in_mem[i]->size;
+
+      in_tensors[i].data = NULL;
+      in_tensors[i].size = in_mem[i]->size;
+      continue;
+    }
+#endif
+
+    if (!gst_memory_map (in_mem[i], &in_info[i], GST_MAP_READ)) {
+      ml_logf_stacktrace
+          ("gst_tensor_filter_transform: For the given input buffer, tensor-filter (%s : %s) cannot map input memory from the buffer for reading. The %u-th memory chunk (%u-th tensor) has failed for memory map.\n",
+          prop->fwname, TF_MODELNAME (prop), i, i);
+      goto mem_map_error;
+    }
+
+    hsize = 0;
+    if (in_flexible) {
+      hsize = gst_tensor_meta_cache_parse (&priv->in_meta_cache[i],
+          in_info[i].data, in_info[i].size, &in_meta[i]);
+      if (hsize == 0) {
+        ml_loge
+            ("gst_tensor_filter_transform: For the given input buffer, tensor-filter (%s : %s) cannot parse the header of flexible tensor. The %u-th memory chunk has invalid header.\n",
+            prop->fwname, TF_MODELNAME (prop), i);
+        goto mem_map_error;
+      }
+    }
+
+    in_tensors[i].data = in_info[i].data + hsize;
+    in_tensors[i].size = in_info[i].size - hsize;
+  }
+
+  /* 1.1 Prepare tensors to invoke. */
+  if (priv->combi.in_combi_defined) {
+    guint info_idx = 0;
+
+    for (list = priv->combi.in_combi; list != NULL; list = list->next) {
+      i = GPOINTER_TO_UINT (list->data);
+
+      if (i >= num_mems) {
+        ml_loge_stacktrace
+            ("gst_tensor_filter_transform: Invalid input combination ('input-combination' property) for the tensor-filter (%s:%s). The %u'th combination's index is %u, which is out of bound (>= %u = the number of memory chunks (tensors) of incoming buffer). Because of buffer index inconsistency, it cannot continue (cannot map the memory for the input buffer).\n",
+            prop->fwname, TF_MODELNAME (prop), info_idx, i, num_mems);
+        goto mem_map_error;
+      }
+
+      expected = gst_tensor_filter_get_tensor_size (self, info_idx, TRUE);
+      if (!in_sparse && expected != in_tensors[i].size) {
+        ml_loge_stacktrace
+            ("gst_tensor_filter_transform: With the given input combination ('input-combination' property) of the tensor-filter, the incoming buffer size of combination index %u (%u'th combination) is %zd, which is invalid and is expected to be %zd. Because of buffer size inconsistency, it cannot continue (cannot map the memory for the input buffer).\n",
+            i, info_idx, in_tensors[i].size, expected);
+        goto mem_map_error;
+      }
+
+      invoke_mem[info_idx] = in_mem[i];
+      invoke_tensors[info_idx++] = in_tensors[i];
+    }
+  } else {
+    if (num_mems != prop->input_meta.num_tensors) {
+      ml_loge_stacktrace
+          ("gst_tensor_filter_transform: Input buffer has invalid number of memory blocks (%u), which is expected to be %u (the number of tensors). Maybe, the pad capability is not consistent with the actual input stream.\n",
+          num_mems, prop->input_meta.num_tensors);
+      goto mem_map_error;
+    }
+
+    for (i = 0; i < prop->input_meta.num_tensors; i++) {
+      expected = gst_tensor_filter_get_tensor_size (self, i, TRUE);
+      if (!in_sparse && expected != in_tensors[i].size) {
+        ml_loge_stacktrace
+            ("gst_tensor_filter_transform: Input buffer size (%u'th memory chunk: %zd) is invalid, which is expected to be %zd, which is the frame size of the corresponding tensor. Maybe, the pad capability is not consistent with the actual input stream; if the size is supposed to change dynamically and the given neural network, framework, and the subpluigins can handle it, please consider using format=flexible.\n",
+            i, in_tensors[i].size, expected);
+        goto mem_map_error;
+      }
+
+      invoke_mem[i] = in_mem[i];
+      invoke_tensors[i] = in_tensors[i];
+    }
+  }
+
+  /* 2. Prepare output tensors. */
+  for (i = 0; i < prop->output_meta.num_tensors; i++) {
+    out_tensors[i].data = NULL;
+    out_tensors[i].size = gst_tensor_filter_get_tensor_size (self, i, FALSE);
+
+    hsize = 0;
+    if (out_flexible) {
+      gst_tensor_info_convert_to_meta (&prop->output_meta.info[i],
+          &out_meta[i]);
+      hsize = gst_tensor_meta_info_get_header_size (&out_meta[i]);
+    }
+
+    /* allocate memory if allocate_in_invoke is FALSE */
+    if (out_pooled) {
+      out_mem[i] = gst_buffer_peek_memory (outbuf, i);
+      if (gst_memory_get_sizes (out_mem[i], NULL, NULL) !=
+          out_tensors[i].size + hsize) {
+        ml_loge_stacktrace
+            ("gst_tensor_filter_transform: the %u'th memory chunk of the pooled output buffer has invalid size %zd, which is expected to be %zd.\n",
+            i, gst_memory_get_sizes (out_mem[i], NULL, NULL),
+            out_tensors[i].size + hsize);
+        out_mem[i] = NULL;
+        goto mem_map_error;
+      }
+      if (!gst_memory_map (out_mem[i], &out_info[i], GST_MAP_WRITE)) {
+        ml_loge_stacktrace
+            ("gst_tensor_filter_transform: cannot map the %u'th memory chunk of the pooled output buffer for write.\n",
+            i);
+        out_mem[i] = NULL;
+        goto mem_map_error;
+      }
+
+      out_tensors[i].data = out_info[i].data + hsize;
+    } else if (!allocate_in_invoke && !mem_invoke) {
+      out_mem[i] =
+          gst_allocator_alloc (NULL, out_tensors[i].size + hsize, NULL);
+      nns_profile_alloc (self, out_tensors[i].size + hsize);
+      if (!out_mem[i]) {
+        ml_loge_stacktrace
+            ("gst_tensor_filter_transform: cannot allocate memory for the output buffer (%u'th memory chunk for %u'th tensor), which requires %zd bytes. gst_allocate_alloc has returned Null. Out of memory?",
+            i, i, out_tensors[i].size + hsize);
+        goto mem_map_error;
+      }
+      if (!gst_memory_map (out_mem[i], &out_info[i], GST_MAP_WRITE)) {
+        ml_loge_stacktrace
+            ("gst_tensor_filter_transform: For the given output buffer, allocated by gst_tensor_filter_transform, it cannot map output memory buffer for the %u'th memory chunk (%u'th output tensor) for write.\n",
+            i, i);
+        goto mem_map_error;
+      }
+
+      out_tensors[i].data = out_info[i].data + hsize;
+
+      /* append header */
+      if (out_flexible) {
+        if (FALSE == gst_tensor_meta_info_update_header
+            (&out_meta[i], out_info[i].data)) {
+          ml_loge_stacktrace
+              ("gst_tensor_meta_info_update_header() has failed to update header for flexible format: invalid metadata or buffer for header is not available. This looks like an internal error of nnstreamer/tensor_filter. Please report to github.com/nnstreamer/nnstreamer/issues. %u'th output buffer has failed to update its header.\n",
+              i);
+          goto mem_map_error;
+        }
+      }
+    }
+  }
+
+  /* pin the invoking thread (streaming thread or worker) and its memory once */
+  if (G_UNLIKELY ((prop->cpu_affinity || prop->numa_node >= 0) &&
+          g_private_get (&cpu_affinity_owner) != self)) {
+    if (!gst_tensor_filter_common_set_cpu_affinity (priv))
+      GST_WARNING_OBJECT (self, "Failed to set the CPU affinity (%s).",
+          GST_STR_NULL (prop->cpu_affinity));
+    g_private_set (&cpu_affinity_owner, self);
+  }
+
+  need_profiling = (priv->latency_mode > 0 || priv->throughput_mode > 0 ||
+      priv->latency_reporting || priv->stats_interval > 0 ||
+      priv->deadline > 0 || self->accl_switch.num_hw > 1);
+  if (need_profiling)
+    start_time = prepare_statistics (priv);
+
+  need_trace = gst_tensor_tracer_is_active ();
+  if (G_UNLIKELY (need_trace))
+    trace_start = gst_util_get_timestamp ();
+
+  /* 3. Call the filter-subplugin callback, "invoke" */
+  if (priv->sched_client) {
+    /* the tensors in the device memory cannot be given to the instance on CPU */
+    guint64 budget = (self->sched.has_fallback && !in_device && !out_device
+        && !use_dmabuf) ? priv->accl_latency_budget : 0;
+
+    accl_acquired = gst_tensor_filter_scheduler_acquire (priv->sched_client,
+        budget);
+    if (!accl_acquired) {
+      accl_fallback = TRUE;
+      g_mutex_lock (&self->sched.fallback_lock);
+      private_data = &self->sched.fallback;
+    }
+  }
+
+  /* the private data may be switched by the reload thread */
+  if (private_data == &priv->privateData)
+    g_mutex_lock (&self->reload.lock);
+  nns_profile_compute_begin (compute_start);
+  if (mem_invoke) {
+    ret = gst_tensor_filter_invoke_memory (self, *private_data, invoke_mem,
+        out_mem);
+  } else if ((priv->device_ops || priv->dmabuf_input) &&
+      !gst_tensor_filter_set_device_memory (priv, *private_data, in_device,
+          out_device, use_dmabuf ? in_dmabuf : NULL)) {
+    ml_loge
+        ("The tensor-filter subplugin (%s for %s) has failed to set the device memory of the tensors.\n",
+        prop->fwname, TF_MODELNAME (prop));
+    ret = -EINVAL;
+  } else {
+    GST_TF_FW_INVOKE_COMPAT_WITH_DATA (priv, private_data, ret, invoke_tensors,
+        out_tensors);
+  }
+  nns_profile_compute_end (self, compute_start);
+  if (private_data == &priv->privateData)
+    g_mutex_unlock (&self->reload.lock);
+  if (accl_acquired)
+    gst_tensor_filter_scheduler_release (priv->sched_client);
+  else if (accl_fallback)
+    g_mutex_unlock (&self->sched.fallback_lock);
+  if (G_UNLIKELY (need_trace))
+    gst_tensor_tracer_record_invoke (GST_ELEMENT_CAST (self), trace_start,
+        gst_util_get_timestamp ());
+  if (need_profiling) {
+    gboolean posted;
+
+    /* the latency of the main instance on the current accelerator */
+    if (self->accl_switch.num_hw > 1 && private_data == &priv->privateData &&
+        ret == 0)
+      gst_tensor_filter_accl_switch_update (self,
+          g_get_real_time () - start_time);
+
+    record_statistics (priv, start_time);
+    posted = post_statistics (self);
+    track_latency (self);
+
+    /* the per-op profile of the framework along with the statistics */
+    if (posted)
+      post_profile (self);
+  }
+
+  /* 4. Free map info and handle error case */
+  for (i = 0; i < num_mems && !in_device && !use_dmabuf && !mem_invoke; i++)
+    gst_memory_unmap (in_mem[i], &in_info[i]);
+
+  if (!allocate_in_invoke && !mem_invoke) {
+    for (i = 0; i < prop->output_meta.num_tensors; i++) {
+      gst_memory_unmap (out_mem[i], &out_info[i]);
+      if (ret != 0 && !out_pooled)
+        gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
+    }
+  }
+
+  /** @todo define enum to indicate status code */
+  if (ret < 0) {
+    ml_loge_stacktrace
+        ("Calling invoke function (inference instance) of the tensor-filter subplugin (%s for %s) has failed with error code (%d).\n",
+        prop->fwname, TF_MODELNAME (prop), ret);
+    return GST_FLOW_ERROR;
+  } else if (ret > 0) {
+    /* drop this buffer */
+    return GST_BASE_TRANSFORM_FLOW_DROPPED;
+  }
+
+  /* 5. Update result */
+  /* The pooled buffer already has the output memory chunks. */
+  if (out_pooled)
+    return GST_FLOW_OK;
+
+  /* If output combination is defined, append input tensors first */
+  if (priv->combi.out_combi_i_defined) {
+    for (list = priv->combi.out_combi_i; list != NULL; list = list->next) {
+      i = GPOINTER_TO_UINT (list->data);
+
+      if (!in_flexible && out_flexible) {
+        /* append header */
+        gst_tensor_info_convert_to_meta (&priv->in_config.info.info[i],
+            &in_meta[i]);
+        mem = gst_tensor_meta_info_append_header (&in_meta[i], in_mem[i]);
+      } else if (in_flexible && !out_flexible) {
+        /* remove header */
+        hsize = gst_tensor_meta_info_get_header_size (&in_meta[i]);
+        mem = gst_memory_share (in_mem[i], hsize, -1);
+      } else {
+        mem = gst_memory_ref (in_mem[i]);
+      }
+
+      gst_buffer_append_memory (outbuf, mem);
+    }
+  }
+
+  for (i = 0; i < prop->output_meta.num_tensors; i++) {
+    if (priv->combi.out_combi_o_defined) {
+      gboolean out_combi = FALSE;
+
+      for (list = priv->combi.out_combi_o; list != NULL; list = list->next) {
+        if (i == GPOINTER_TO_UINT (list->data)) {
+          out_combi = TRUE;
+          break;
+        }
+      }
+      if (!out_combi) {
+        /* release memory block if output tensor is not in the combi list */
+        if (mem_invoke) {
+          gst_memory_unref (out_mem[i]);
+        } else if (allocate_in_invoke) {
+          gst_tensor_filter_destroy_notify_util_full (priv, private_data,
+              out_tensors[i].data);
+        } else {
+          gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
+        }
+
+        continue;
+      }
+    }
+
+    if (allocate_in_invoke && !mem_invoke) {
+      /* prepare memory block if successfully done */
+      if (out_device) {
+        out_mem[i] = mem = gst_tensor_filter_get_device_mem (self,
+            private_data, out_tensors[i].data, out_tensors[i].size);
+        if (!mem) {
+          ml_loge_stacktrace
+              ("gst_tensor_filter_transform: cannot wrap the %u'th output tensor in the device memory.\n",
+              i);
+          return GST_FLOW_ERROR;
+        }
+      } else {
+        out_mem[i] = mem = gst_tensor_filter_get_wrapped_mem (self,
+            private_data, out_tensors[i].data, out_tensors[i].size);
+      }
+
+      if (out_flexible) {
+        /* prepare new memory block with meta */
+        out_mem[i] = gst_tensor_meta_info_append_header (&out_meta[i], mem);
+        gst_memory_unref (mem);
+      }
+    }
+
+    /* append the memory block to outbuf */
+    gst_buffer_append_memory (outbuf, out_mem[i]);
+  }
+
+  return GST_FLOW_OK;
+mem_map_error:
+  num_mems = gst_buffer_n_memory (inbuf);
+  for (i = 0; i < num_mems && !in_device && !use_dmabuf && !mem_invoke; i++) {
+    if (in_mem[i])
+      gst_memory_unmap (in_mem[i], &in_info[i]);
+  }
+
+  if (!allocate_in_invoke && !mem_invoke) {
+    for (i = 0; i < prop->output_meta.num_tensors; i++) {
+      if (out_mem[i]) {
+        gst_memory_unmap (out_mem[i], &out_info[i]);
+        if (!out_pooled)
+          gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
+      }
+    }
+  }
+  return GST_FLOW_ERROR;
+}
+
+/**
+ * @brief Decode the sparse input tensors into dense tensors, in the buffer from the pool if possible.
+ * @param self "this" pointer
+ * @param inbuf the input buffer of sparse tensors
+ * @return the buffer of dense tensors with the metadata of inbuf, or NULL on error. Caller should unref the buffer.
+ */
+static GstBuffer *
+gst_tensor_filter_sparse_decode (GstTensorFilter * self, GstBuffer * inbuf)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstBuffer *dense = NULL;
+  GstMemory *in_mem, *out_mem;
+  GstMapInfo in_map, out_map;
+  GstTensorMetaInfo meta;
+  gboolean pooled, decoded;
+  guint i, num_mems;
+
+  num_mems = gst_buffer_n_memory (inbuf);
+
+  if (priv->sparse_pool && gst_buffer_pool_acquire_buffer (priv->sparse_pool,
+          &dense, NULL) == GST_FLOW_OK &&
+      gst_buffer_n_memory (dense) != num_mems) {
+    gst_buffer_unref (dense);
+    dense = NULL;
+  }
+
+  pooled = (dense != NULL);
+  if (!pooled)
+    dense = gst_buffer_new ();
+
+  for (i = 0; i < num_mems; i++) {
+    in_mem = gst_buffer_peek_memory (inbuf, i);
+
+    /* scatter the values into the pooled memory without new allocation */
+    if (pooled) {
+      if (!gst_memory_map (in_mem, &in_map, GST_MAP_READ)) {
+        ml_loge ("tensor_filter: cannot map the %u'th sparse input tensor.\n",
+            i);
+        goto error;
+      }
+
+      out_mem = gst_buffer_peek_memory (dense, i);
+      decoded = FALSE;
+
+      if (gst_tensor_meta_info_parse_header (&meta, in_map.data) &&
+          gst_tensor_meta_info_get_data_size (&meta) ==
+          gst_memory_get_sizes (out_mem, NULL, NULL) &&
+          gst_memory_map (out_mem, &out_map, GST_MAP_WRITE)) {
+        decoded = gst_tensor_sparse_to_dense_into (&meta, in_map.data,
+            in_map.size, out_map.data, out_map.size);
+        gst_memory_unmap (out_mem, &out_map);
+      }
+
+      gst_memory_unmap (in_mem, &in_map);
+      if (decoded)
+        continue;
+    }
+
+    /* the size of the tensor is different from the pool */
+    out_mem = gst_tensor_sparse_to_dense (&meta, in_mem);
+    if (!out_mem) {
+      ml_loge ("tensor_filter: cannot decode the %u'th sparse input tensor.\n",
+          i);
+      goto error;
+    }
+
+    if (pooled)
+      gst_buffer_replace_memory (dense, i, out_mem);
+    else
+      gst_buffer_append_memory (dense, out_mem);
+  }
+
+  gst_buffer_copy_into (dense, inbuf, GST_BUFFER_COPY_METADATA, 0, -1);
+  return dense;
+
+error:
+  gst_buffer_unref (dense);
+  return NULL;
+}
+
+/**
+ * @brief Encode the output tensors into sparse tensors.
+ * @param self "this" pointer
+ * @param outbuf the output buffer of dense tensors (writable)
+ */
+static GstFlowReturn
+gst_tensor_filter_sparse_encode (GstTensorFilter * self, GstBuffer * outbuf)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorsInfo *info = &priv->out_config.info;
+  GstTensorMetaInfo meta;
+  GstMemory *mem;
+  guint i, num_mems;
+
+  num_mems = gst_buffer_n_memory (outbuf);
+  if (num_mems > info->num_tensors || num_mems > NNS_TENSOR_SIZE_LIMIT) {
+    ml_loge ("tensor_filter: the output buffer has %u tensors, expected %u.\n",
+        num_mems, info->num_tensors);
+    return GST_FLOW_ERROR;
+  }
+
+  for (i = 0; i < num_mems; i++) {
+    gst_tensor_info_convert_to_meta (&info->info[i], &meta);
+    meta.format = _NNS_TENSOR_FORMAT_SPARSE;
+    meta.media_type = _NNS_TENSOR;
+
+    mem = gst_tensor_sparse_from_dense (&meta,
+        gst_buffer_peek_memory (outbuf, i));
+    if (!mem) {
+      ml_loge ("tensor_filter: cannot encode the %u'th output tensor.\n", i);
+      return GST_FLOW_ERROR;
+    }
+
+    gst_buffer_replace_memory (outbuf, i, mem);
+  }
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Release the pool of the dense tensors decoded from the sparse input.
+ */
+static void
+gst_tensor_filter_sparse_stop (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+
+  if (priv->sparse_pool) {
+    gst_buffer_pool_set_active (priv->sparse_pool, FALSE);
+    gst_object_unref (priv->sparse_pool);
+    priv->sparse_pool = NULL;
+  }
+
+  priv->sparse_decode = FALSE;
+  priv->sparse_invoke = FALSE;
+  priv->sparse_output = FALSE;
+}
+
+/**
+ * @brief Configure the sparse input and output streams with the negotiated caps.
+ *
+ * If the framework does not take the sparse tensors (sparse_input of the framework info),
+ * the sparse input is decoded into the buffer from the pool sized with the input of the model.
+ */
+static void
+gst_tensor_filter_sparse_configure (GstTensorFilter * self,
+    GstCaps * incaps, GstCaps * outcaps)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorsConfig config;
+  GstStructure *pool_config;
+  GstBufferPool *pool;
+  GstCaps *caps;
+
+  gst_tensor_filter_sparse_stop (self);
+
+  gst_tensors_config_init (&config);
+  if (gst_tensors_config_from_structure (&config,
+          gst_caps_get_structure (outcaps, 0)))
+    priv->sparse_output = gst_tensors_config_is_sparse (&config);
+  gst_tensors_config_free (&config);
+
+  gst_tensors_config_init (&config);
+  if (!gst_tensors_config_from_structure (&config,
+          gst_caps_get_structure (incaps, 0)) ||
+      !gst_tensors_config_is_sparse (&config))
+    goto done;
+
+  if (priv->info.sparse_input) {
+    priv->sparse_invoke = TRUE;
+    goto done;
+  }
+
+  priv->sparse_decode = TRUE;
+
+  /* the input combination reorders the tensors, the size of the incoming tensors is unknown */
+  if (priv->combi.in_combi_defined)
+    goto done;
+
+  gst_tensors_config_free (&config);
+  gst_tensors_config_init (&config);
+  config.rate_n = priv->in_config.rate_n;
+  config.rate_d = priv->in_config.rate_d;
+
+  if (!gst_tensor_filter_common_get_frame_info (priv, &priv->prop.input_meta,
+          &config.info))
+    goto done;
+
+  caps = gst_tensors_caps_from_config (&config);
+  pool = gst_tensor_buffer_pool_new ();
+  pool_config = gst_buffer_pool_get_config (pool);
+
+  /* no limit, the decoded buffers may be queued for the batch or workers */
+  gst_buffer_pool_config_set_params (pool_config, caps, 0, 0, 0);
+
+  if (gst_buffer_pool_set_config (pool, pool_config) &&
+      gst_buffer_pool_set_active (pool, TRUE)) {
+    priv->sparse_pool = pool;
+  } else {
+    GST_WARNING_OBJECT (self,
+        "Failed to configure the pool of the dense input tensors, allocate the memory for each frame.");
+    gst_object_unref (pool);
+  }
+
+  gst_caps_unref (caps);
+
+done:
+  gst_tensors_config_free (&config);
+}
+
+/**
+ * @brief Job to invoke the model in the worker thread.
+ */
+typedef struct
+{
+  GstBuffer *inbuf; /**< the input buffer */
+  guint64 seq; /**< sequence number of the incoming frame */
+} GstTensorFilterWorkerJob;
+
+/**
+ * @brief Push the finished outputs downstream in the order of incoming frames.
+ */
+static void
+gst_tensor_filter_workers_push_ready (GstTensorFilter * self)
+{
+  GstTensorFilterWorkers *workers = &self->workers;
+  GstTensorFilterWorkerSlot *slot;
+  GstBuffer *outbuf;
+  GstFlowReturn ret;
+  gboolean flushing;
+
+  g_mutex_lock (&workers->push_lock);
+  g_mutex_lock (&workers->lock);
+
+  while (workers->seq_out < workers->seq_in) {
+    slot = &workers->slots[workers->seq_out % workers->num_slots];
+    if (!slot->done)
+      break;
+
+    outbuf = slot->outbuf;
+    slot->outbuf = NULL;
+    slot->done = FALSE;
+    flushing = workers->flushing;
+    g_mutex_unlock (&workers->lock);
+
+    ret = GST_FLOW_OK;
+    if (outbuf) {
+      if (flushing)
+        gst_buffer_unref (outbuf);
+      else
+        ret = gst_pad_push (GST_BASE_TRANSFORM_SRC_PAD (self), outbuf);
+    }
+
+    g_mutex_lock (&workers->lock);
+    if (ret != GST_FLOW_OK && workers->last_ret == GST_FLOW_OK)
+      workers->last_ret = ret;
+    workers->seq_out++;
+    g_cond_broadcast (&workers->cond);
+  }
+
+  g_mutex_unlock (&workers->lock);
+  g_mutex_unlock (&workers->push_lock);
+}
+
+/**
+ * @brief Worker thread function to invoke the model with an idle framework instance.
+ */
+static void
+gst_tensor_filter_workers_invoke (gpointer data, gpointer user_data)
+{
+  GstTensorFilterWorkerJob *job = (GstTensorFilterWorkerJob *) data;
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (user_data);
+  GstTensorFilterWorkers *workers = &self->workers;
+  GstTensorFilterWorkerSlot *slot;
+  GstBuffer *outbuf;
+  GstFlowReturn ret;
+  void **instance;
+
+  if (self->priv.sparse_decode) {
+    GstBuffer *dense = gst_tensor_filter_sparse_decode (self, job->inbuf);
+
+    gst_buffer_unref (job->inbuf);
+    job->inbuf = dense;
+  }
+
+  outbuf = gst_buffer_new ();
+  ret = GST_FLOW_ERROR;
+
+  if (job->inbuf) {
+    instance = (void **) g_async_queue_pop (workers->idle_instances);
+
+    gst_buffer_copy_into (outbuf, job->inbuf, GST_BUFFER_COPY_METADATA, 0, -1);
+    ret = gst_tensor_filter_invoke_buffer (self, instance, job->inbuf, outbuf);
+
+    g_async_queue_push (workers->idle_instances, instance);
+    gst_buffer_unref (job->inbuf);
+  }
+
+  if (ret == GST_FLOW_OK && self->priv.sparse_output)
+    ret = gst_tensor_filter_sparse_encode (self, outbuf);
+
+  if (ret != GST_FLOW_OK) {
+    gst_buffer_unref (outbuf);
+    outbuf = NULL;
+  }
+
+  g_mutex_lock (&workers->lock);
+  if (ret != GST_FLOW_OK && ret != GST_BASE_TRANSFORM_FLOW_DROPPED &&
+      workers->last_ret == GST_FLOW_OK)
+    workers->last_ret = ret;
+
+  slot = &workers->slots[job->seq % workers->num_slots];
+  slot->outbuf = outbuf;
+  slot->done = TRUE;
+  g_mutex_unlock (&workers->lock);
+
+  g_free (job);
+  gst_tensor_filter_workers_push_ready (self);
+}
+
+/**
+ * @brief Dispatch the incoming buffer to the worker threads.
+ * @return GST_BASE_TRANSFORM_FLOW_DROPPED because the output is pushed by the worker.
+ */
+static GstFlowReturn
+gst_tensor_filter_workers_submit (GstTensorFilter * self, GstBuffer * inbuf)
+{
+  GstTensorFilterWorkers *workers = &self->workers;
+  GstTensorFilterWorkerJob *job;
+  GstFlowReturn ret;
+
+  g_mutex_lock (&workers->lock);
+  /* limit the number of frames in flight */
+  while (workers->last_ret == GST_FLOW_OK &&
+      workers->seq_in - workers->seq_out >= workers->num_slots)
+    g_cond_wait (&workers->cond, &workers->lock);
+
+  ret = workers->last_ret;
+  if (ret != GST_FLOW_OK) {
+    g_mutex_unlock (&workers->lock);
+    return ret;
+  }
+
+  job = g_new0 (GstTensorFilterWorkerJob, 1);
+  job->inbuf = gst_buffer_ref (inbuf);
+  job->seq = workers->seq_in++;
+  g_mutex_unlock (&workers->lock);
+
+  g_thread_pool_push (workers->pool, job, NULL);
+  return GST_BASE_TRANSFORM_FLOW_DROPPED;
+}
+
+/**
+ * @brief Wait until all frames in flight are pushed (or discarded).
+ */
+static void
+gst_tensor_filter_workers_drain (GstTensorFilter * self)
+{
+  GstTensorFilterWorkers *workers = &self->workers;
+
+  g_mutex_lock (&workers->lock);
+  while (workers->seq_out < workers->seq_in)
+    g_cond_wait (&workers->cond, &workers->lock);
+  g_mutex_unlock (&workers->lock);
+}
+
+/**
+ * @brief Close the additional framework instances.
+ */
+static void
+gst_tensor_filter_workers_close_instances (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterWorkers *workers = &self->workers;
+  guint i;
+
+  for (i = 1; i < workers->num_workers; i++) {
+    if (priv->fw && priv->fw->close && workers->instances[i])
+      priv->fw->close (&priv->prop, &workers->instances[i]);
+    workers->instances[i] = NULL;
+  }
+}
+
+/**
+ * @brief Open the framework instances and start the worker threads.
+ * @return TRUE if workers are ready (or not required).
+ */
+static gboolean
+gst_tensor_filter_workers_start (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstTensorFilterWorkers *workers = &self->workers;
+  GError *error = NULL;
+  guint i;
+
+  if (priv->num_workers <= 1 || workers->pool)
+    return TRUE;
+
+  if (prop->shared_tensor_filter_key) {
+    GST_WARNING_OBJECT (self,
+        "The model representation is shared with the key '%s'. The framework instances cannot be invoked concurrently, tensor-filter invokes the model in the streaming thread.",
+        prop->shared_tensor_filter_key);
+    return TRUE;
+  }
+
+  workers->num_workers = priv->num_workers;
+
+  for (i = 1; i < workers->num_workers; i++) {
+    workers->instances[i] = NULL;
+
+    if (priv->fw->open && priv->fw->open (prop, &workers->instances[i]) < 0) {
+      GST_ELEMENT_ERROR (self, RESOURCE, FAILED,
+          ("Failed to open the %u-th instance of the framework (%s) for the worker.",
+              i, prop->fwname), (NULL));
+      goto error;
+    }
+  }
+
+  workers->idle_instances = g_async_queue_new ();
+  g_async_queue_push (workers->idle_instances, &priv->privateData);
+  for (i = 1; i < workers->num_workers; i++)
+    g_async_queue_push (workers->idle_instances, &workers->instances[i]);
+
+  workers->num_slots = workers->num_workers * 2;
+  workers->slots = g_new0 (GstTensorFilterWorkerSlot, workers->num_slots);
+  workers->seq_in = workers->seq_out = 0;
+  workers->flushing = FALSE;
+  workers->last_ret = GST_FLOW_OK;
+
+  workers->pool = g_thread_pool_new (gst_tensor_filter_workers_invoke, self,
+      (gint) workers->num_workers, TRUE, &error);
+  if (!workers->pool) {
+    GST_ELEMENT_ERROR (self, RESOURCE, FAILED,
+        ("Failed to create the worker threads: %s",
+            error ? error->message : "unknown error"), (NULL));
+    g_clear_error (&error);
+    goto error;
+  }
+
+  GST_INFO_OBJECT (self, "Started %u workers to invoke the model.",
+      workers->num_workers);
+  return TRUE;
+
+error:
+  gst_tensor_filter_workers_close_instances (self);
+  if (workers->idle_instances) {
+    g_async_queue_unref (workers->idle_instances);
+    workers->idle_instances = NULL;
+  }
+  g_free (workers->slots);
+  workers->slots = NULL;
+  workers->num_workers = 0;
+  return FALSE;
+}
+
+/**
+ * @brief Stop the worker threads and close the framework instances.
+ */
+static void
+gst_tensor_filter_workers_stop (GstTensorFilter * self)
+{
+  GstTensorFilterWorkers *workers = &self->workers;
+  guint i;
+
+  if (!workers->pool)
+    return;
+
+  g_mutex_lock (&workers->lock);
+  workers->flushing = TRUE;
+  g_cond_broadcast (&workers->cond);
+  g_mutex_unlock (&workers->lock);
+
+  /* wait for the queued jobs */
+  g_thread_pool_free (workers->pool, FALSE, TRUE);
+  workers->pool = NULL;
+
+  gst_tensor_filter_workers_close_instances (self);
+
+  g_async_queue_unref (workers->idle_instances);
+  workers->idle_instances = NULL;
+
+  for (i = 0; i < workers->num_slots; i++) {
+    if (workers->slots[i].outbuf)
+      gst_buffer_unref (workers->slots[i].outbuf);
+  }
+  g_free (workers->slots);
+  workers->slots = NULL;
+  workers->num_slots = 0;
+  workers->num_workers = 0;
+  workers->seq_in = workers->seq_out = 0;
+  workers->flushing = FALSE;
+  workers->last_ret = GST_FLOW_OK;
+}
+
+/**
+ * @brief Invoke the queued frames at once and push the outputs. Caller should hold the batch lock.
+ * @details The input memory chunks of the frames are packed along the outermost dimension, and the incomplete batch is padded with zero.
+ */
+static GstFlowReturn
+gst_tensor_filter_batch_invoke_locked (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterBatch *batch = &self->batch;
+  GstBaseTransform *trans = GST_BASE_TRANSFORM_CAST (self);
+  GstBuffer *inbuf, *outbuf, *frame, *out;
+  GstMemory *mem;
+  GstMapInfo map, frame_map;
+  GstFlowReturn ret = GST_FLOW_OK;
+  guint i, k, num_frames, num_mems;
+  gsize frame_size;
+  GList *list;
+
+  num_frames = g_queue_get_length (&batch->frames);
+  if (num_frames == 0)
+    return GST_FLOW_OK;
+
+  if (gst_tensor_pad_caps_is_flexible (GST_BASE_TRANSFORM_SINK_PAD (trans)) ||
+      gst_tensor_pad_caps_is_flexible (GST_BASE_TRANSFORM_SRC_PAD (trans))) {
+    GST_ELEMENT_ERROR_BTRACE (self, STREAM, FAILED,
+        ("tensor_filter (%s:%s) cannot pack the flexible tensors into a batch. Please use static tensor streams with the property max-batch.",
+            GST_STR_NULL (priv->prop.fwname), TF_MODELNAME (&priv->prop)));
+    ret = GST_FLOW_ERROR;
+    goto done;
+  }
+
+  /* 1. Pack the frames. */
+  frame = (GstBuffer *) g_queue_peek_head (&batch->frames);
+  num_mems = gst_buffer_n_memory (frame);
+  inbuf = gst_buffer_new ();
+
+  for (i = 0; i < num_mems; i++) {
+    frame_size = gst_memory_get_sizes (gst_buffer_peek_memory (frame, i),
+        NULL, NULL);
+    mem = gst_allocator_alloc (NULL, frame_size * priv->max_batch, NULL);
+    nns_profile_alloc (self, frame_size * priv->max_batch);
+    if (!mem || !gst_memory_map (mem, &map, GST_MAP_WRITE)) {
+      ml_loge ("Failed to allocate the memory (%zd bytes) for the batch.",
+          frame_size * priv->max_batch);
+      if (mem)
+        gst_memory_unref (mem);
+      gst_buffer_unref (inbuf);
+      ret = GST_FLOW_ERROR;
+      goto done;
+    }
+
+    for (list = batch->frames.head, k = 0; list != NULL; list = list->next, k++) {
+      GstMemory *frame_mem;
+
+      frame_mem = gst_buffer_peek_memory ((GstBuffer *) list->data, i);
+      if (!gst_memory_map (frame_mem, &frame_map, GST_MAP_READ)) {
+        ml_loge ("Cannot map the %u-th memory chunk of the %u-th frame.",
+            i, k);
+        goto pack_error;
+      }
+
+      if (frame_map.size != frame_size) {
+        ml_loge
+            ("The %u-th memory chunk of the %u-th frame has invalid size %zd, all frames in a batch should have the same size (%zd bytes).",
+            i, k, frame_map.size, frame_size);
+        gst_memory_unmap (frame_mem, &frame_map);
+        goto pack_error;
+      }
+
+      nns_profile_memcpy (self, map.data + k * frame_size, frame_map.data,
+          frame_size);
+      gst_memory_unmap (frame_mem, &frame_map);
+    }
+
+    /* zero padding for the incomplete batch */
+    if (num_frames < priv->max_batch)
+      memset (map.data + num_frames * frame_size, 0,
+          (priv->max_batch - num_frames) * frame_size);
+
+    gst_memory_unmap (mem, &map);
+    gst_buffer_append_memory (inbuf, mem);
+  }
+
+  /* 2. Invoke once. */
+  outbuf = gst_buffer_new ();
+  ret = gst_tensor_filter_invoke_buffer (self, &priv->privateData, inbuf,
+      outbuf);
+  gst_buffer_unref (inbuf);
+
+  if (ret != GST_FLOW_OK) {
+    gst_buffer_unref (outbuf);
+
+    /* the subplugin has dropped the batch */
+    if (ret == GST_BASE_TRANSFORM_FLOW_DROPPED)
+      ret = GST_FLOW_OK;
+    goto done;
+  }
+
+  /* 3. Split the outputs and push them with the timestamps of the frames. */
+  num_mems = gst_buffer_n_memory (outbuf);
+
+  for (k = 0; k < num_frames; k++) {
+    frame = (GstBuffer *) g_queue_pop_head (&batch->frames);
+
+    out = gst_buffer_new ();
+    gst_buffer_copy_into (out, frame, GST_BUFFER_COPY_METADATA, 0, -1);
+    gst_buffer_unref (frame);
+
+    for (i = 0; i < num_mems; i++) {
+      mem = gst_buffer_peek_memory (outbuf, i);
+      frame_size = gst_memory_get_sizes (mem, NULL, NULL) / priv->max_batch;
+      gst_buffer_append_memory (out,
+          gst_memory_share (mem, k * frame_size, frame_size));
+    }
+
+    if (g_atomic_int_get (&batch->flushing)) {
+      gst_buffer_unref (out);
+      continue;
+    }
+
+    if (priv->sparse_output &&
+        (ret = gst_tensor_filter_sparse_encode (self, out)) != GST_FLOW_OK) {
+      gst_buffer_unref (out);
+      break;
+    }
+
+    ret = gst_pad_push (GST_BASE_TRANSFORM_SRC_PAD (trans), out);
+    if (ret != GST_FLOW_OK)
+      break;
+  }
+
+  gst_buffer_unref (outbuf);
+
+done:
+  g_queue_clear_full (&batch->frames, (GDestroyNotify) gst_buffer_unref);
+  if (ret != GST_FLOW_OK)
+    batch->last_ret = ret;
+  return ret;
+
+pack_error:
+  gst_memory_unmap (mem, &map);
+  gst_memory_unref (mem);
+  gst_buffer_unref (inbuf);
+  ret = GST_FLOW_ERROR;
+  goto done;
+}
+
+/**
+ * @brief Thread to invoke the incomplete batch when batch-timeout expires.
+ */
+static gpointer
+gst_tensor_filter_batch_loop (gpointer user_data)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (user_data);
+  GstTensorFilterBatch *batch = &self->batch;
+
+  g_mutex_lock (&batch->lock);
+  while (batch->running) {
+    if (g_queue_is_empty (&batch->frames)) {
+      g_cond_wait (&batch->cond, &batch->lock);
+    } else if (g_get_monotonic_time () >= batch->deadline) {
+      gst_tensor_filter_batch_invoke_locked (self);
+    } else {
+      g_cond_wait_until (&batch->cond, &batch->lock, batch->deadline);
+    }
+  }
+  g_mutex_unlock (&batch->lock);
+
+  return NULL;
+}
+
+/**
+ * @brief Queue the incoming buffer and invoke the batch if it is full.
+ * @return GST_BASE_TRANSFORM_FLOW_DROPPED because the outputs are pushed after invoking the batch.
+ */
+static GstFlowReturn
+gst_tensor_filter_batch_submit (GstTensorFilter * self, GstBuffer * inbuf)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterBatch *batch = &self->batch;
+  GstFlowReturn ret;
+
+  g_mutex_lock (&batch->lock);
+  ret = batch->last_ret;
+  if (ret != GST_FLOW_OK || g_atomic_int_get (&batch->flushing))
+    goto done;
+
+  g_queue_push_tail (&batch->frames, gst_buffer_ref (inbuf));
+
+  if (g_queue_get_length (&batch->frames) >= priv->max_batch) {
+    ret = gst_tensor_filter_batch_invoke_locked (self);
+  } else if (g_queue_get_length (&batch->frames) == 1) {
+    batch->deadline = g_get_monotonic_time () + (gint64) priv->batch_timeout;
+    g_cond_signal (&batch->cond);
+  }
+
+done:
+  g_mutex_unlock (&batch->lock);
+  return (ret == GST_FLOW_OK) ? GST_BASE_TRANSFORM_FLOW_DROPPED : ret;
+}
+
+/**
+ * @brief Invoke the queued frames (e.g., before EOS) without waiting for the batch.
+ */
+static void
+gst_tensor_filter_batch_drain (GstTensorFilter * self)
+{
+  g_mutex_lock (&self->batch.lock);
+  gst_tensor_filter_batch_invoke_locked (self);
+  g_mutex_unlock (&self->batch.lock);
+}
+
+/**
+ * @brief Prepare dynamic batching and start the batch thread if batch-timeout is given.
+ */
+static gboolean
+gst_tensor_filter_batch_start (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterBatch *batch = &self->batch;
+  GError *error = NULL;
+
+  if (priv->max_batch <= 1 || batch->running)
+    return TRUE;
+
+  if (priv->num_workers > 1) {
+    GST_WARNING_OBJECT (self,
+        "The property workers is ignored with max-batch (%u). The batch is invoked in the streaming thread.",
+        priv->max_batch);
+  }
+
+  batch->last_ret = GST_FLOW_OK;
+  g_atomic_int_set (&batch->flushing, FALSE);
+
+  /* no timeout, invoke the batch only when it is full or with serialized events */
+  if (priv->batch_timeout == 0)
+    return TRUE;
+
+  batch->running = TRUE;
+  batch->thread = g_thread_try_new ("tensor-filter-batch",
+      gst_tensor_filter_batch_loop, self, &error);
+  if (!batch->thread) {
+    GST_ELEMENT_ERROR (self, RESOURCE, FAILED,
+        ("Failed to create the thread for batch-timeout: %s",
+            error ? error->message : "unknown error"), (NULL));
+    g_clear_error (&error);
+    batch->running = FALSE;
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Stop the batch thread and discard the queued frames.
+ */
+static void
+gst_tensor_filter_batch_stop (GstTensorFilter * self)
+{
+  GstTensorFilterBatch *batch = &self->batch;
+
+  g_mutex_lock (&batch->lock);
+  batch->running = FALSE;
+  g_cond_broadcast (&batch->cond);
+  g_mutex_unlock (&batch->lock);
+
+  if (batch->thread) {
+    g_thread_join (batch->thread);
+    batch->thread = NULL;
+  }
+
+  g_queue_clear_full (&batch->frames, (GDestroyNotify) gst_buffer_unref);
+  batch->last_ret = GST_FLOW_OK;
+}
+
+/**
+ * @brief Drop the reference of the latest invoke (skip-threshold).
+ */
+static void
+gst_tensor_filter_skip_reset (GstTensorFilter * self)
+{
+  GstTensorFilterSkip *skip = &self->skip;
+
+  skip->has_ref = FALSE;
+  skip->pending = FALSE;
+  skip->skipped = 0;
+  gst_buffer_replace (&skip->outbuf, NULL);
+  g_atomic_int_set (&skip->invalid, FALSE);
+}
+
+/**
+ * @brief Free the data to skip the invoke (skip-threshold).
+ */
+static void
+gst_tensor_filter_skip_free (GstTensorFilter * self)
+{
+  GstTensorFilterSkip *skip = &self->skip;
+
+  gst_tensor_filter_skip_reset (self);
+  g_free (skip->ref);
+  g_free (skip->cur);
+  skip->ref = skip->cur = NULL;
+  skip->size = 0;
+}
+
+/**
+ * @brief Check the input tensors can be compared to skip the invoke, called when the caps is set.
+ */
+static void
+gst_tensor_filter_skip_configure (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorsInfo *info = &priv->in_config.info;
+  guint i;
+
+  gst_tensor_filter_skip_reset (self);
+  self->skip.unsupported = FALSE;
+
+  if (priv->skip_threshold <= 0.0)
+    return;
+
+  if (priv->max_batch > 1 || self->workers.pool) {
+    GST_WARNING_OBJECT (self,
+        "skip-threshold is not applied with max-batch or workers.");
+    self->skip.unsupported = TRUE;
+    return;
+  }
+
+  /* the header of flexible or sparse tensor or the data in the device memory is not compared */
+  if (gst_tensor_pad_caps_is_flexible (GST_BASE_TRANSFORM_SINK_PAD (self)) ||
+      priv->sparse_decode || priv->sparse_invoke || priv->device_input) {
+    GST_WARNING_OBJECT (self,
+        "skip-threshold is not applied with the flexible, sparse or device input tensors.");
+    self->skip.unsupported = TRUE;
+    return;
+  }
+
+  for (i = 0; i < info->num_tensors; i++) {
+    if (info->info[i].type != _NNS_UINT8 && info->info[i].type != _NNS_FLOAT32) {
+      GST_WARNING_OBJECT (self,
+          "skip-threshold is not applied, the %u'th input tensor is %s (uint8 or float32 only).",
+          i, gst_tensor_get_type_string (info->info[i].type));
+      self->skip.unsupported = TRUE;
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Get the size of the sampled blocks of the tensor (skip-sample).
+ */
+static gsize
+gst_tensor_filter_skip_sampled_size (gsize size, guint sample)
+{
+  gsize blocks = size / SKIP_BLOCK_SIZE;
+  gsize sampled = ((blocks + sample - 1) / sample) * SKIP_BLOCK_SIZE;
+
+  /* the remainder after the last full block */
+  if (blocks % sample == 0)
+    sampled += size % SKIP_BLOCK_SIZE;
+
+  return sampled;
+}
+
+/**
+ * @brief Get the mean absolute difference of the float32 values.
+ */
+static gdouble
+gst_tensor_filter_skip_f32_distance (const gfloat * a, const gfloat * b,
+    gsize num)
+{
+  gdouble sum = 0.0;
+  gsize i;
+
+  for (i = 0; i < num; i++)
+    sum += fabs ((gdouble) a[i] - (gdouble) b[i]);
+
+  return (num > 0) ? sum / num : 0.0;
+}
+
+/**
+ * @brief Get the buffer sharing the model output in the output buffer, the input tensors of the output combination are excluded.
+ * @return The buffer of the model output, caller should unref it.
+ */
+static GstBuffer *
+gst_tensor_filter_get_model_output (GstTensorFilter * self, GstBuffer * outbuf)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstBuffer *outputs;
+  GstMemory *mem;
+  gboolean pooled;
+  guint i, first = 0, num_mems;
+
+  if (priv->combi.out_combi_i_defined)
+    first = g_list_length (priv->combi.out_combi_i);
+
+  outputs = gst_buffer_new ();
+  pooled = gst_tensor_buffer_pool_is_pooled (outbuf);
+  num_mems = gst_buffer_n_memory (outbuf);
+
+  for (i = first; i < num_mems; i++) {
+    mem = gst_buffer_peek_memory (outbuf, i);
+
+    /* the memory chunks of the pooled buffer are filled again for the next frame */
+    gst_buffer_append_memory (outputs,
+        pooled ? gst_memory_copy (mem, 0, -1) : gst_memory_ref (mem));
+  }
+
+  return outputs;
+}
+
+/**
+ * @brief Fill the output buffer with the model output of the previous invoke.
+ * @param outputs The model output given by gst_tensor_filter_get_model_output().
+ * @return TRUE if the output buffer is filled.
+ */
+static gboolean
+gst_tensor_filter_fill_output (GstTensorFilter * self, GstBuffer * inbuf,
+    GstBuffer * outbuf, GstBuffer * outputs)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorMetaInfo meta;
+  GstMapInfo src, dst;
+  GstMemory *mem;
+  GList *list;
+  guint i, num_mems;
+
+  num_mems = gst_buffer_n_memory (outputs);
+
+  /* the pooled buffer already has the memory chunks to be filled */
+  if (gst_buffer_n_memory (outbuf) > 0) {
+    if (gst_buffer_n_memory (outbuf) != num_mems)
+      return FALSE;
+
+    for (i = 0; i < num_mems; i++) {
+      if (!gst_memory_map (gst_buffer_peek_memory (outputs, i), &src,
+              GST_MAP_READ))
+        return FALSE;
+      if (!gst_memory_map (gst_buffer_peek_memory (outbuf, i), &dst,
+              GST_MAP_WRITE)) {
+        gst_memory_unmap (gst_buffer_peek_memory (outputs, i), &src);
+        return FALSE;
+      }
+
+      nns_profile_memcpy (self, dst.data, src.data, MIN (src.size, dst.size));
+      gst_memory_unmap (gst_buffer_peek_memory (outbuf, i), &dst);
+      gst_memory_unmap (gst_buffer_peek_memory (outputs, i), &src);
+    }
+
+    return TRUE;
+  }
+
+  /* the input tensors in the output are given by the incoming frame */
+  if (priv->combi.out_combi_i_defined) {
+    gboolean out_flexible =
+        gst_tensor_pad_caps_is_flexible (GST_BASE_TRANSFORM_SRC_PAD (self));
+
+    for (list = priv->combi.out_combi_i; list != NULL; list = list->next) {
+      i = GPOINTER_TO_UINT (list->data);
+      mem = gst_buffer_peek_memory (inbuf, i);
+
+      if (out_flexible) {
+        gst_tensor_info_convert_to_meta (&priv->in_config.info.info[i], &meta);
+        mem = gst_tensor_meta_info_append_header (&meta, mem);
+      } else {
+        mem = gst_memory_ref (mem);
+      }
+
+      gst_buffer_append_memory (outbuf, mem);
+    }
+  }
+
+  for (i = 0; i < num_mems; i++)
+    gst_buffer_append_memory (outbuf,
+        gst_memory_ref (gst_buffer_peek_memory (outputs, i)));
+
+  return TRUE;
+}
+
+/**
+ * @brief Compare the sampled blocks of the input tensors with the latest invoke, and push the previous output if the input barely changed (skip-threshold).
+ * @return TRUE if the invoke is skipped and the output buffer is filled.
+ */
+static gboolean
+gst_tensor_filter_skip_invoke (GstTensorFilter * self, GstBuffer * inbuf,
+    GstBuffer * outbuf)
+{
   GstTensorFilterPrivate *priv = &self->priv;
-  GstTensorFilterProperties *prop = &priv->prop;
+  GstTensorFilterSkip *skip = &self->skip;
+  GstTensorsInfo *info = &priv->in_config.info;
+  gsize sizes[NNS_TENSOR_SIZE_LIMIT];
+  gsize total = 0, offset, pos, n;
+  gdouble distance = 0.0, d;
+  guint i, num_mems, sample;
+  GstMapInfo map;
+  GstMemory *mem;
 
-  if (G_UNLIKELY (!priv->configured)) {
-    GST_ELEMENT_ERROR_BTRACE (self, STREAM, TYPE_NOT_FOUND,
-        ("The tensor_filter instance is not configured (pad caps not negotiated). Property info (framework = '%s', framework_opened = %d, model[0] = '%s', num-models = %d, custom_properties = '%s'.",
-            prop ? prop->fwname : "property info is NULL.",
-            prop ? prop->fw_opened : -1,
-            prop ? TF_MODELNAME (prop) : "property info is NULL.",
-            prop ? prop->num_models : -1,
-            prop ? prop->custom_properties : "property info is NULL."));
-    return GST_FLOW_NOT_NEGOTIATED;
-  }
-  if (G_UNLIKELY (!priv->fw)) {
-    /**
-      * This is fatal; if framework is not configured until this stage,
-      * it means that an extension is missing or not configured.
-      * We need readable messages for non-developers
-      */
-    GST_ELEMENT_ERROR_BTRACE (self, STREAM, FAILED,
-        ("Framework (filter subplugin) is not found or not configured: 'framework=%s'. Please check if the given framework name is correct and the given model path is consistent with the intended framework especially if 'framework=auto' is given. Please refer to the warning messages created when the framework property is set.",
-            priv->prop.fwname));
-    ml_logf
-        ("\nA corresponding nnstreamer extension (tensor_filter subplugin) is not installed or the framework property of tensor_filter is incorrect: [%s] is not found.\n\n",
-        prop->fwname);
-    return GST_FLOW_ERROR;
+  skip->pending = FALSE;
+  if (g_atomic_int_get (&skip->invalid))
+    gst_tensor_filter_skip_reset (self);
+
+  num_mems = gst_buffer_n_memory (inbuf);
+  if (num_mems != info->num_tensors)
+    return FALSE;
+
+  sample = MAX (priv->skip_sample, 1U);
+  for (i = 0; i < num_mems; i++) {
+    sizes[i] = gst_tensor_filter_skip_sampled_size (gst_memory_get_sizes
+        (gst_buffer_peek_memory (inbuf, i), NULL, NULL), sample);
+    /* align the float32 values */
+    total = GST_ROUND_UP_8 (total) + sizes[i];
   }
-  if (G_UNLIKELY (!priv->fw->run_without_model) &&
-      G_UNLIKELY (!(prop->model_files &&
-              prop->num_models > 0 && prop->model_files[0]))) {
-    GST_ELEMENT_ERROR_BTRACE (self, STREAM, FAILED,
-        ("For the framework='%s', its model filepath is not provided and this framework requires a model file. Thus, we cannot proceed with tensor_filter for inferences. Please provide a valid model file path.",
-            prop->fwname));
-    return GST_FLOW_ERROR;
+
+  if (total != skip->size) {
+    skip->ref = g_realloc (skip->ref, total);
+    skip->cur = g_realloc (skip->cur, total);
+    skip->size = total;
+    skip->has_ref = FALSE;
   }
-  if ((GST_TF_FW_V0 (priv->fw) && G_UNLIKELY (!priv->fw->invoke_NN)) ||
-      (GST_TF_FW_V1 (priv->fw) && G_UNLIKELY (!priv->fw->invoke))) {
-    GST_ELEMENT_ERROR_BTRACE (self, STREAM, FAILED,
-        ("The tensor-filter subplugin for the framework='%s' does not have its mandatory methods (or callback functions). It appears that your subplugin implementation of '%s' is not completed. There is no 'invoke_NN (v1)' or 'invoke (v2)' methods available.",
-            prop->fwname, prop->fwname));
-    return GST_FLOW_ERROR;
+
+  /* copy the sampled blocks, the reference should not be changed by upstream */
+  offset = 0;
+  for (i = 0; i < num_mems; i++) {
+    mem = gst_buffer_peek_memory (inbuf, i);
+    if (!gst_memory_map (mem, &map, GST_MAP_READ))
+      return FALSE;
+
+    offset = GST_ROUND_UP_8 (offset);
+    for (pos = 0; pos < map.size; pos += (gsize) SKIP_BLOCK_SIZE * sample) {
+      n = MIN ((gsize) SKIP_BLOCK_SIZE, map.size - pos);
+      memcpy (skip->cur + offset, map.data + pos, n);
+      offset += n;
+    }
+
+    gst_memory_unmap (mem, &map);
   }
 
-  silent_debug (self, "Invoking %s with %s model\n", priv->fw->name,
-      GST_STR_NULL (prop->model_files[0]));
+  priv->skip_frames++;
+  skip->pending = TRUE;
 
-  /* skip input data when throttling delay is set */
-  if (gst_tensor_filter_check_throttling_delay (trans, inbuf))
-    return GST_BASE_TRANSFORM_FLOW_DROPPED;
+  if (!skip->has_ref ||
+      (priv->skip_max > 0 && skip->skipped >= priv->skip_max))
+    return FALSE;
 
-  if (!outbuf) {
-    GST_ELEMENT_ERROR_BTRACE (self, STREAM, FAILED,
-        ("The output buffer for the instance of tensor-filter subplugin (%s / %s) is null. Cannot proceed.",
-            prop->fwname, TF_MODELNAME (prop)));
-    return GST_FLOW_ERROR;
+  /* the largest mean absolute difference among the tensors */
+  offset = 0;
+  for (i = 0; i < num_mems; i++) {
+    offset = GST_ROUND_UP_8 (offset);
+
+    if (info->info[i].type == _NNS_UINT8) {
+      d = (sizes[i] > 0) ? (gdouble) gst_tensor_kernels_get ()->u8_sad
+          (skip->cur + offset, skip->ref + offset, sizes[i]) / sizes[i] : 0.0;
+    } else {
+      d = gst_tensor_filter_skip_f32_distance ((const gfloat *) (skip->cur +
+              offset), (const gfloat *) (skip->ref + offset),
+          sizes[i] / sizeof (gfloat));
+    }
+
+    /* NaN is always a change */
+    if (!(d < priv->skip_threshold))
+      return FALSE;
+
+    distance = MAX (distance, d);
+    offset += sizes[i];
   }
-  if (gst_buffer_get_size (outbuf) != 0) {
-    GST_ELEMENT_ERROR_BTRACE (self, STREAM, FAILED,
-        ("The output buffer for the isntance of tensor-filter subplugin (%s / %s) already has a content (buffer size = %zu). It should be 0.",
-            prop->fwname, TF_MODELNAME (prop), gst_buffer_get_size (outbuf)));
-    return GST_FLOW_ERROR;
+
+  if (!gst_tensor_filter_fill_output (self, inbuf, outbuf, skip->outbuf)) {
+    gst_buffer_remove_all_memory (outbuf);
+    return FALSE;
   }
 
-  return GST_FLOW_OK;
+  silent_debug (self, "Skipped the invoke, the input difference is %f.\n",
+      distance);
+
+  skip->pending = FALSE;
+  skip->skipped++;
+  priv->skip_num++;
+  post_statistics (self);
+  return TRUE;
 }
 
 /**
- * @brief non-ip transform. required vmethod of GstBaseTransform.
+ * @brief Keep the input and output of the invoke as the reference to skip the next frames (skip-threshold).
  */
-static GstFlowReturn
-gst_tensor_filter_transform (GstBaseTransform * trans,
-    GstBuffer * inbuf, GstBuffer * outbuf)
+static void
+gst_tensor_filter_skip_update (GstTensorFilter * self, GstFlowReturn ret,
+    GstBuffer * outbuf)
 {
-  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
-  GstTensorFilterPrivate *priv = &self->priv;
-  GstTensorFilterProperties *prop = &priv->prop;
-  GstMemory *in_mem[NNS_TENSOR_SIZE_LIMIT] = { 0, };
-  GstMapInfo in_info[NNS_TENSOR_SIZE_LIMIT];
-  GstMemory *out_mem[NNS_TENSOR_SIZE_LIMIT] = { 0, };
-  GstMapInfo out_info[NNS_TENSOR_SIZE_LIMIT];
-  GstTensorMemory in_tensors[NNS_TENSOR_SIZE_LIMIT];
-  GstTensorMemory invoke_tensors[NNS_TENSOR_SIZE_LIMIT];
-  GstTensorMemory out_tensors[NNS_TENSOR_SIZE_LIMIT];
-  GList *list;
-  guint i, num_mems;
-  gint ret;
-  gboolean allocate_in_invoke, in_flexible, out_flexible;
-  gboolean need_profiling;
-  gsize expected, hsize;
-
-  GstTensorMetaInfo in_meta[NNS_TENSOR_SIZE_LIMIT];
-  GstTensorMetaInfo out_meta[NNS_TENSOR_SIZE_LIMIT];
-  GstMemory *mem;
+  GstTensorFilterSkip *skip = &self->skip;
+  guint8 *tmp;
+
+  if (ret != GST_FLOW_OK || !skip->pending) {
+    /* the output is not given by the sampled input */
+    skip->has_ref = FALSE;
+    skip->pending = FALSE;
+    gst_buffer_replace (&skip->outbuf, NULL);
+    return;
+  }
 
-  /* 0. Check all properties. */
-  GstFlowReturn retval = _gst_tensor_filter_transform_validate (trans, inbuf,
-      outbuf);
-  if (retval != GST_FLOW_OK)
-    return retval;
+  tmp = skip->ref;
+  skip->ref = skip->cur;
+  skip->cur = tmp;
+  skip->has_ref = TRUE;
+  skip->pending = FALSE;
+  skip->skipped = 0;
 
-  allocate_in_invoke = gst_tensor_filter_allocate_in_invoke (priv);
+  /* share the memory chunks, the output buffer pushed downstream stays writable */
+  gst_buffer_replace (&skip->outbuf, NULL);
+  skip->outbuf = gst_tensor_filter_get_model_output (self, outbuf);
+}
 
-  in_flexible =
-      gst_tensor_pad_caps_is_flexible (GST_BASE_TRANSFORM_SINK_PAD (trans));
-  out_flexible =
-      gst_tensor_pad_caps_is_flexible (GST_BASE_TRANSFORM_SRC_PAD (trans));
+/**
+ * @brief Get the hash of the input tensors to find the cached output (cache-size).
+ * @return TRUE if the key is given.
+ */
+static gboolean
+gst_tensor_filter_cache_get_key (GstTensorFilter * self, GstBuffer * inbuf,
+    guint64 * key)
+{
+  GstMapInfo map;
+  GstMemory *mem;
+  guint64 hash = 0;
+  guint i, num_mems;
 
-  /* 1. Get all input tensors from inbuf. */
-  /* Internal Logic Error or GST Bug (sinkcap changed!) */
   num_mems = gst_buffer_n_memory (inbuf);
-
   for (i = 0; i < num_mems; i++) {
-    in_mem[i] = gst_buffer_peek_memory (inbuf, i);
-    if (!gst_memory_map (in_mem[i], &in_info[i], GST_MAP_READ)) {
-      ml_logf_stacktrace
-          ("gst_tensor_filter_transform: For the given input buffer, tensor-filter (%s : %s) cannot map input memory from the buffer for reading. The %u-th memory chunk (%u-th tensor) has failed for memory map.\n",
-          prop->fwname, TF_MODELNAME (prop), i, i);
-      goto mem_map_error;
+    mem = gst_buffer_peek_memory (inbuf, i);
+    if (!gst_memory_map (mem, &map, GST_MAP_READ)) {
+      GST_WARNING_OBJECT (self, "Failed to map the %u'th input tensor.", i);
+      return FALSE;
     }
 
-    hsize = 0;
-    if (in_flexible) {
-      gst_tensor_meta_info_parse_header (&in_meta[i], in_info[i].data);
-      hsize = gst_tensor_meta_info_get_header_size (&in_meta[i]);
+    /* chain the hash of the tensors, the size of each tensor is also hashed */
+    hash = gst_tensor_filter_cache_hash (map.data, map.size, hash);
+    gst_memory_unmap (mem, &map);
+  }
+
+  *key = hash;
+  return TRUE;
+}
+
+/**
+ * @brief Get the properties of the model in the cascade, the model files are given by the stage.
+ */
+static void
+gst_tensor_filter_cascade_get_prop (GstTensorFilter * self,
+    GstTensorFilterCascadeStage * stage, GstTensorFilterProperties * prop)
+{
+  memcpy (prop, &self->priv.prop, sizeof (GstTensorFilterProperties));
+  prop->model_files = (const gchar **) stage->model_files;
+  prop->num_models = stage->num_models;
+}
+
+/**
+ * @brief Create the tensor_if evaluating the outputs with the properties given by cascade-condition.
+ * @return The tensor_if element, NULL if the condition is invalid.
+ */
+static GstElement *
+gst_tensor_filter_cascade_new_condition (GstTensorFilter * self,
+    const gchar * condition)
+{
+  GstElement *cond;
+  GObjectClass *klass;
+  gchar **props, **kv;
+  gboolean failed = FALSE;
+  guint i;
+
+  cond = GST_ELEMENT (gst_object_ref_sink (g_object_new (GST_TYPE_TENSOR_IF,
+              NULL)));
+  klass = G_OBJECT_GET_CLASS (cond);
+
+  props = g_strsplit_set (condition, " \t\n", -1);
+  for (i = 0; props[i] != NULL && !failed; i++) {
+    if (props[i][0] == '\0')
+      continue;
+
+    kv = g_strsplit (props[i], "=", 2);
+    if (g_strv_length (kv) != 2 ||
+        !g_object_class_find_property (klass, kv[0])) {
+      GST_WARNING_OBJECT (self, "Invalid cascade-condition '%s'.", props[i]);
+      failed = TRUE;
+    } else {
+      gst_util_set_object_arg (G_OBJECT (cond), kv[0], kv[1]);
     }
+    g_strfreev (kv);
+  }
+  g_strfreev (props);
 
-    in_tensors[i].data = in_info[i].data + hsize;
-    in_tensors[i].size = in_info[i].size - hsize;
+  if (failed) {
+    gst_object_unref (cond);
+    return NULL;
   }
 
-  /* 1.1 Prepare tensors to invoke. */
-  if (priv->combi.in_combi_defined) {
-    guint info_idx = 0;
+  return cond;
+}
 
-    for (list = priv->combi.in_combi; list != NULL; list = list->next) {
-      i = GPOINTER_TO_UINT (list->data);
+/**
+ * @brief Open the models in the cascade, called when the element starts.
+ */
+static void
+gst_tensor_filter_cascade_start (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterCascade *cascade = &self->cascade;
+  GstTensorFilterCascadeStage *stage;
+  GstTensorFilterProperties prop;
+  gchar **models;
+  guint i;
 
-      if (i >= num_mems) {
-        ml_loge_stacktrace
-            ("gst_tensor_filter_transform: Invalid input combination ('input-combination' property) for the tensor-filter (%s:%s). The %u'th combination's index is %u, which is out of bound (>= %u = the number of memory chunks (tensors) of incoming buffer). Because of buffer index inconsistency, it cannot continue (cannot map the memory for the input buffer).\n",
-            prop->fwname, TF_MODELNAME (prop), info_idx, i, num_mems);
-        goto mem_map_error;
-      }
+  priv->cascade_frames = priv->cascade_invokes = 0;
 
-      expected = gst_tensor_filter_get_tensor_size (self, info_idx, TRUE);
-      if (expected != in_tensors[i].size) {
-        ml_loge_stacktrace
-            ("gst_tensor_filter_transform: With the given input combination ('input-combination' property) of the tensor-filter, the incoming buffer size of combination index %u (%u'th combination) is %zd, which is invalid and is expected to be %zd. Because of buffer size inconsistency, it cannot continue (cannot map the memory for the input buffer).\n",
-            i, info_idx, in_tensors[i].size, expected);
-        goto mem_map_error;
-      }
+  if (!priv->cascade || priv->cascade[0] == '\0')
+    return;
 
-      invoke_tensors[info_idx++] = in_tensors[i];
+  if (priv->max_batch > 1 || priv->num_workers > 1) {
+    GST_WARNING_OBJECT (self,
+        "cascade is not applied with max-batch or workers.");
+    return;
+  }
+
+  if (!priv->cascade_condition || priv->cascade_condition[0] == '\0') {
+    GST_WARNING_OBJECT (self,
+        "cascade-condition is not given, the cascade is not applied.");
+    return;
+  }
+
+  cascade->cond = gst_tensor_filter_cascade_new_condition (self,
+      priv->cascade_condition);
+  if (!cascade->cond)
+    return;
+
+  models = g_strsplit (priv->cascade, ";", -1);
+  for (i = 0; models[i] != NULL; i++) {
+    g_strstrip (models[i]);
+    if (models[i][0] == '\0')
+      continue;
+
+    if (cascade->num_stages == GST_TF_MAX_CASCADE) {
+      GST_WARNING_OBJECT (self,
+          "The cascade has more than %d models, the rest is ignored.",
+          GST_TF_MAX_CASCADE);
+      break;
     }
-  } else {
-    if (num_mems != prop->input_meta.num_tensors) {
-      ml_loge_stacktrace
-          ("gst_tensor_filter_transform: Input buffer has invalid number of memory blocks (%u), which is expected to be %u (the number of tensors). Maybe, the pad capability is not consistent with the actual input stream.\n",
-          num_mems, prop->input_meta.num_tensors);
-      goto mem_map_error;
+
+    stage = &cascade->stages[cascade->num_stages];
+    stage->model_files = g_strsplit (models[i], ",", -1);
+    stage->num_models = g_strv_length (stage->model_files);
+    stage->data = NULL;
+    stage->checked = FALSE;
+
+    gst_tensor_filter_cascade_get_prop (self, stage, &prop);
+    if (priv->fw->open (&prop, &stage->data) < 0) {
+      GST_WARNING_OBJECT (self,
+          "Failed to open the framework with the model %s in the cascade.",
+          models[i]);
+      g_strfreev (stage->model_files);
+      stage->model_files = NULL;
+      continue;
     }
 
-    for (i = 0; i < prop->input_meta.num_tensors; i++) {
-      expected = gst_tensor_filter_get_tensor_size (self, i, TRUE);
-      if (expected != in_tensors[i].size) {
-        ml_loge_stacktrace
-            ("gst_tensor_filter_transform: Input buffer size (%u'th memory chunk: %zd) is invalid, which is expected to be %zd, which is the frame size of the corresponding tensor. Maybe, the pad capability is not consistent with the actual input stream; if the size is supposed to change dynamically and the given neural network, framework, and the subpluigins can handle it, please consider using format=flexible.\n",
-            i, in_tensors[i].size, expected);
-        goto mem_map_error;
-      }
+    cascade->num_stages++;
+  }
+  g_strfreev (models);
 
-      invoke_tensors[i] = in_tensors[i];
-    }
+  if (cascade->num_stages == 0 && cascade->cond) {
+    gst_object_unref (cascade->cond);
+    cascade->cond = NULL;
   }
+}
 
-  /* 2. Prepare output tensors. */
-  for (i = 0; i < prop->output_meta.num_tensors; i++) {
-    out_tensors[i].data = NULL;
-    out_tensors[i].size = gst_tensor_filter_get_tensor_size (self, i, FALSE);
+/**
+ * @brief Close the model of the stage in the cascade.
+ */
+static void
+gst_tensor_filter_cascade_close_stage (GstTensorFilter * self,
+    GstTensorFilterCascadeStage * stage)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties prop;
 
-    hsize = 0;
-    if (out_flexible) {
-      gst_tensor_info_convert_to_meta (&prop->output_meta.info[i],
-          &out_meta[i]);
-      hsize = gst_tensor_meta_info_get_header_size (&out_meta[i]);
-    }
+  gst_tensor_filter_cascade_get_prop (self, stage, &prop);
+  if (priv->fw && priv->fw->close)
+    priv->fw->close (&prop, &stage->data);
 
-    /* allocate memory if allocate_in_invoke is FALSE */
-    if (!allocate_in_invoke) {
-      out_mem[i] =
-          gst_allocator_alloc (NULL, out_tensors[i].size + hsize, NULL);
-      if (!out_mem[i]) {
-        ml_loge_stacktrace
-            ("gst_tensor_filter_transform: cannot allocate memory for the output buffer (%u'th memory chunk for %u'th tensor), which requires %zd bytes. gst_allocate_alloc has returned Null. Out of memory?",
-            i, i, out_tensors[i].size + hsize);
-        goto mem_map_error;
-      }
-      if (!gst_memory_map (out_mem[i], &out_info[i], GST_MAP_WRITE)) {
-        ml_loge_stacktrace
-            ("gst_tensor_filter_transform: For the given output buffer, allocated by gst_tensor_filter_transform, it cannot map output memory buffer for the %u'th memory chunk (%u'th output tensor) for write.\n",
-            i, i);
-        goto mem_map_error;
-      }
+  g_strfreev (stage->model_files);
+  stage->model_files = NULL;
+  stage->data = NULL;
+}
 
-      out_tensors[i].data = out_info[i].data + hsize;
+/**
+ * @brief Close the models in the cascade, called when the element stops.
+ */
+static void
+gst_tensor_filter_cascade_stop (GstTensorFilter * self)
+{
+  GstTensorFilterCascade *cascade = &self->cascade;
+  guint i;
+
+  for (i = 0; i < cascade->num_stages; i++)
+    gst_tensor_filter_cascade_close_stage (self, &cascade->stages[i]);
+
+  cascade->num_stages = 0;
+  if (cascade->cond) {
+    gst_object_unref (cascade->cond);
+    cascade->cond = NULL;
+  }
+}
 
-      /* append header */
-      if (out_flexible) {
-        if (FALSE == gst_tensor_meta_info_update_header
-            (&out_meta[i], out_info[i].data)) {
-          ml_loge_stacktrace
-              ("gst_tensor_meta_info_update_header() has failed to update header for flexible format: invalid metadata or buffer for header is not available. This looks like an internal error of nnstreamer/tensor_filter. Please report to github.com/nnstreamer/nnstreamer/issues. %u'th output buffer has failed to update its header.\n",
-              i);
-          goto mem_map_error;
-        }
-      }
+/**
+ * @brief Check the models in the cascade have the same tensors info with the model, called when the caps is set.
+ */
+static void
+gst_tensor_filter_cascade_configure (GstTensorFilter * self)
+{
+  GstTensorFilterCascade *cascade = &self->cascade;
+  GstTensorFilterCascadeStage *stage;
+  GstTensorFilterProperties prop;
+  guint i = 0;
+
+  while (i < cascade->num_stages) {
+    stage = &cascade->stages[i];
+    gst_tensor_filter_cascade_get_prop (self, stage, &prop);
+
+    if (stage->checked ||
+        gst_tensor_filter_reload_check_info (self, &prop, &stage->data)) {
+      stage->checked = TRUE;
+      i++;
+      continue;
     }
-  }
 
-  need_profiling = (priv->latency_mode > 0 || priv->throughput_mode > 0 ||
-      priv->latency_reporting);
-  if (need_profiling)
-    prepare_statistics (priv);
+    GST_WARNING_OBJECT (self,
+        "The model %s in the cascade has unmatched tensors info, it is removed from the cascade.",
+        stage->model_files[0]);
 
-  /* 3. Call the filter-subplugin callback, "invoke" */
-  GST_TF_FW_INVOKE_COMPAT (priv, ret, invoke_tensors, out_tensors);
-  if (need_profiling) {
-    record_statistics (priv);
-    track_latency (self);
+    gst_tensor_filter_cascade_close_stage (self, stage);
+    cascade->num_stages--;
+    memmove (stage, stage + 1,
+        (cascade->num_stages - i) * sizeof (GstTensorFilterCascadeStage));
   }
 
-  /* 4. Free map info and handle error case */
-  for (i = 0; i < num_mems; i++)
-    gst_memory_unmap (in_mem[i], &in_info[i]);
+  if (cascade->num_stages == 0 && cascade->cond) {
+    gst_object_unref (cascade->cond);
+    cascade->cond = NULL;
+  }
+}
 
-  if (!allocate_in_invoke) {
-    for (i = 0; i < prop->output_meta.num_tensors; i++) {
-      gst_memory_unmap (out_mem[i], &out_info[i]);
-      if (ret != 0)
-        gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
+/**
+ * @brief Invoke the models in order until the outputs satisfy the cascade-condition.
+ */
+static GstFlowReturn
+gst_tensor_filter_invoke_cascade (GstTensorFilter * self, GstBuffer * inbuf,
+    GstBuffer * outbuf)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterCascade *cascade = &self->cascade;
+  GstFlowReturn ret;
+  gboolean confident = FALSE;
+  gboolean out_pooled;
+  guint i;
+
+  priv->cascade_frames++;
+  priv->cascade_invokes++;
+  ret = gst_tensor_filter_invoke_buffer (self, &priv->privateData, inbuf,
+      outbuf);
+
+  for (i = 0; i < cascade->num_stages && ret == GST_FLOW_OK; i++) {
+    if (!gst_tensor_if_check_buffer (GST_TENSOR_IF (cascade->cond),
+            &priv->out_config, outbuf, &confident)) {
+      GST_WARNING_OBJECT (self,
+          "Failed to evaluate the cascade-condition, the outputs are pushed.");
+      break;
     }
-  }
 
-  /** @todo define enum to indicate status code */
-  if (ret < 0) {
-    ml_loge_stacktrace
-        ("Calling invoke function (inference instance) of the tensor-filter subplugin (%s for %s) has failed with error code (%d).\n",
-        prop->fwname, TF_MODELNAME (prop), ret);
-    return GST_FLOW_ERROR;
-  } else if (ret > 0) {
-    /* drop this buffer */
-    return GST_BASE_TRANSFORM_FLOW_DROPPED;
+    if (confident)
+      break;
+
+    /* the pooled buffer keeps the memory chunks to be filled again */
+    out_pooled = (!gst_tensor_filter_allocate_in_invoke (priv) &&
+        gst_tensor_buffer_pool_is_pooled (outbuf) &&
+        gst_buffer_n_memory (outbuf) == priv->prop.output_meta.num_tensors);
+    if (!out_pooled)
+      gst_buffer_remove_all_memory (outbuf);
+
+    priv->cascade_invokes++;
+    ret = gst_tensor_filter_invoke_buffer (self, &cascade->stages[i].data,
+        inbuf, outbuf);
   }
 
-  /* 5. Update result */
-  /* If output combination is defined, append input tensors first */
-  if (priv->combi.out_combi_i_defined) {
-    for (list = priv->combi.out_combi_i; list != NULL; list = list->next) {
-      i = GPOINTER_TO_UINT (list->data);
+  return ret;
+}
 
-      if (!in_flexible && out_flexible) {
-        /* append header */
-        gst_tensor_info_convert_to_meta (&priv->in_config.info.info[i],
-            &in_meta[i]);
-        mem = gst_tensor_meta_info_append_header (&in_meta[i], in_mem[i]);
-      } else if (in_flexible && !out_flexible) {
-        /* remove header */
-        hsize = gst_tensor_meta_info_get_header_size (&in_meta[i]);
-        mem = gst_memory_share (in_mem[i], hsize, -1);
-      } else {
-        mem = gst_memory_ref (in_mem[i]);
-      }
+/**
+ * @brief non-ip transform. required vmethod of GstBaseTransform.
+ */
+static GstFlowReturn
+gst_tensor_filter_transform (GstBaseTransform * trans,
+    GstBuffer * inbuf, GstBuffer * outbuf)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstBuffer *dense = NULL;
+  guint64 cache_key = 0;
+  guint cache_gen = 0;
+  gboolean cached = FALSE;
 
-      gst_buffer_append_memory (outbuf, mem);
-    }
+  /* 0. Check all properties. */
+  GstFlowReturn retval = _gst_tensor_filter_transform_validate (trans, inbuf,
+      outbuf);
+  if (retval != GST_FLOW_OK)
+    return retval;
+
+  /* the workers decode the sparse input in parallel */
+  if (priv->sparse_decode && (priv->max_batch > 1 || !self->workers.pool)) {
+    dense = gst_tensor_filter_sparse_decode (self, inbuf);
+    if (!dense)
+      return GST_FLOW_ERROR;
+
+    inbuf = dense;
   }
 
-  for (i = 0; i < prop->output_meta.num_tensors; i++) {
-    if (priv->combi.out_combi_o_defined) {
-      gboolean out_combi = FALSE;
+  if (priv->max_batch > 1) {
+    retval = gst_tensor_filter_batch_submit (self, inbuf);
+    goto done;
+  }
 
-      for (list = priv->combi.out_combi_o; list != NULL; list = list->next) {
-        if (i == GPOINTER_TO_UINT (list->data)) {
-          out_combi = TRUE;
-          break;
-        }
-      }
-      if (!out_combi) {
-        /* release memory block if output tensor is not in the combi list */
-        if (allocate_in_invoke) {
-          gst_tensor_filter_destroy_notify_util (priv, out_tensors[i].data);
-        } else {
-          gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
-        }
+  if (self->workers.pool)
+    return gst_tensor_filter_workers_submit (self, inbuf);
 
-        continue;
-      }
-    }
+  if (priv->cache && gst_tensor_filter_cache_get_key (self, inbuf,
+          &cache_key)) {
+    GstBuffer *outputs = gst_tensor_filter_cache_lookup (priv->cache,
+        cache_key, &cache_gen);
 
-    if (allocate_in_invoke) {
-      /* prepare memory block if successfully done */
-      out_mem[i] = mem = gst_tensor_filter_get_wrapped_mem (self,
-          out_tensors[i].data, out_tensors[i].size);
+    if (outputs) {
+      gboolean filled = gst_tensor_filter_fill_output (self, inbuf, outbuf,
+          outputs);
 
-      if (out_flexible) {
-        /* prepare new memory block with meta */
-        out_mem[i] = gst_tensor_meta_info_append_header (&out_meta[i], mem);
-        gst_memory_unref (mem);
+      gst_buffer_unref (outputs);
+      if (filled) {
+        post_statistics (self);
+        goto encode;
       }
+
+      gst_buffer_remove_all_memory (outbuf);
     }
 
-    /* append the memory block to outbuf */
-    gst_buffer_append_memory (outbuf, out_mem[i]);
+    cached = TRUE;
   }
 
-  return GST_FLOW_OK;
-mem_map_error:
-  num_mems = gst_buffer_n_memory (inbuf);
-  for (i = 0; i < num_mems; i++) {
-    if (in_mem[i])
-      gst_memory_unmap (in_mem[i], &in_info[i]);
+  if (priv->skip_threshold > 0.0 && !self->skip.unsupported) {
+    if (gst_tensor_filter_skip_invoke (self, inbuf, outbuf))
+      goto encode;
   }
 
-  if (!allocate_in_invoke) {
-    for (i = 0; i < prop->output_meta.num_tensors; i++) {
-      if (out_mem[i]) {
-        gst_memory_unmap (out_mem[i], &out_info[i]);
-        gst_allocator_free (out_mem[i]->allocator, out_mem[i]);
-      }
-    }
+  if (self->cascade.num_stages > 0)
+    retval = gst_tensor_filter_invoke_cascade (self, inbuf, outbuf);
+  else
+    retval = gst_tensor_filter_invoke_buffer (self, &priv->privateData, inbuf,
+        outbuf);
+
+  if (priv->skip_threshold > 0.0 && !self->skip.unsupported)
+    gst_tensor_filter_skip_update (self, retval, outbuf);
+
+  if (cached && retval == GST_FLOW_OK) {
+    GstBuffer *outputs = gst_tensor_filter_get_model_output (self, outbuf);
+
+    gst_tensor_filter_cache_insert (priv->cache, cache_key, cache_gen, outputs);
+    gst_buffer_unref (outputs);
   }
-  return GST_FLOW_ERROR;
+
+encode:
+  if (retval == GST_FLOW_OK && priv->sparse_output)
+    retval = gst_tensor_filter_sparse_encode (self, outbuf);
+
+done:
+  if (dense)
+    gst_buffer_unref (dense);
+
+  return retval;
 }
 
 /**
@@ -907,7 +3523,7 @@ gst_tensor_filter_configure_tensor (GstTensorFilter * self,
   GstTensorFilterProperties *prop;
   GstStructure *structure;
   GstTensorsConfig in_config, out_config;
-  GstTensorsInfo in_info, out_info;
+  GstTensorsInfo in_info, out_info, frame_info;
   gboolean flexible;
 
   g_return_val_if_fail (incaps != NULL, FALSE);
@@ -918,6 +3534,7 @@ gst_tensor_filter_configure_tensor (GstTensorFilter * self,
   gst_tensors_config_init (&out_config);
   gst_tensors_info_init (&in_info);
   gst_tensors_info_init (&out_info);
+  gst_tensors_info_init (&frame_info);
 
   /**
    * GstTensorFilter has to parse the tensor dimension and type from NN model.
@@ -972,8 +3589,9 @@ gst_tensor_filter_configure_tensor (GstTensorFilter * self,
     goto done;
   }
 
-  /* flexible tensor case, we cannot get the exact info from caps. */
-  flexible = gst_tensors_config_is_flexible (&in_config);
+  /* flexible or sparse tensor case, we cannot get the exact info from caps. */
+  flexible = gst_tensors_config_is_flexible (&in_config) ||
+      gst_tensors_config_is_sparse (&in_config);
 
   /** if set-property called and already has info, verify it! */
   if (prop->input_meta.num_tensors > 0) {
@@ -983,10 +3601,12 @@ gst_tensor_filter_configure_tensor (GstTensorFilter * self,
        * Need to compare buffer size in transform().
        */
       GST_INFO_OBJECT (self, "The input tensor is flexible.");
-    } else if (!gst_tensors_info_is_equal (&in_info, &prop->input_meta)) {
+    } else if (!gst_tensor_filter_common_get_frame_info (priv,
+            &prop->input_meta, &frame_info) ||
+        !gst_tensors_info_is_equal (&in_info, &frame_info)) {
       gchar *capstr = gst_caps_to_string (incaps);
       gchar *compare =
-          gst_tensorsinfo_compare_to_string (&in_info, &prop->input_meta);
+          gst_tensorsinfo_compare_to_string (&in_info, &frame_info);
       GST_ELEMENT_ERROR_BTRACE (self, STREAM, WRONG_TYPE,
           ("%s:%u The input tensor of tensor_filter (%s:%s) is not compatible with the configured input information. Please check tensor-filter properties if you have given input dimensions explicitly; or the model properties if you have not given them. Check the input stream caps and related caps-filters, too. The given gstcap is %s, which is not compatible: %s",
               __func__, __LINE__, GST_STR_NULL (prop->fwname),
@@ -1011,11 +3631,27 @@ gst_tensor_filter_configure_tensor (GstTensorFilter * self,
               TF_MODELNAME (prop), capstr));
       g_free (capstr);
       goto done;
-    } else {
-      gst_tensors_info_copy (&prop->input_meta, &in_info);
+    } else if (!gst_tensor_filter_common_get_batched_info (priv, &in_info,
+            &prop->input_meta)) {
+      GST_ELEMENT_ERROR_BTRACE (self, STREAM, WRONG_TYPE,
+          ("%s:%u Failed to get the batched input info (max-batch %u) of tensor_filter (%s:%s).",
+              __func__, __LINE__, priv->max_batch,
+              GST_STR_NULL (prop->fwname), TF_MODELNAME (prop)));
+      goto done;
     }
   }
 
+  /* the sparse input decoded into dense tensors can be packed */
+  if (priv->max_batch > 1 && (gst_tensors_config_is_flexible (&in_config) ||
+          (gst_tensors_config_is_sparse (&in_config) &&
+              priv->info.sparse_input))) {
+    GST_ELEMENT_ERROR_BTRACE (self, STREAM, WRONG_TYPE,
+        ("%s:%u tensor_filter (%s:%s) cannot pack the flexible or sparse tensors into a batch (max-batch %u). Please use static tensor streams.",
+            __func__, __LINE__, GST_STR_NULL (prop->fwname),
+            TF_MODELNAME (prop), priv->max_batch));
+    goto done;
+  }
+
   prop->input_configured = TRUE;
 
   /** call setInputDimension if output tensor is not configured */
@@ -1058,8 +3694,12 @@ gst_tensor_filter_configure_tensor (GstTensorFilter * self,
   out_config.rate_n = in_config.rate_n;
   out_config.rate_d = in_config.rate_d;
 
-  if (!gst_tensor_filter_common_get_combined_out_info (priv, &in_config.info,
-          &prop->output_meta, &out_config.info)) {
+  /* the output stream carries a single frame of the batch */
+  gst_tensors_info_free (&frame_info);
+  if (!gst_tensor_filter_common_get_frame_info (priv, &prop->output_meta,
+          &frame_info) ||
+      !gst_tensor_filter_common_get_combined_out_info (priv, &in_config.info,
+          &frame_info, &out_config.info)) {
     GST_ELEMENT_ERROR_BTRACE (self, STREAM, WRONG_TYPE,
         ("%s:%u Failed to configure combined output info: please refer to the error message of gst_tensor_filter_common_get_combined_out_info(). ",
             __func__, __LINE__));
@@ -1082,6 +3722,7 @@ done:
   gst_tensors_config_free (&out_config);
   gst_tensors_info_free (&in_info);
   gst_tensors_info_free (&out_info);
+  gst_tensors_info_free (&frame_info);
   return priv->configured;
 }
 
@@ -1152,13 +3793,25 @@ gst_tensor_filter_transform_caps (GstBaseTransform * trans,
 
     /* caps: sink pad. get src pad info */
     if (prop->output_configured) {
-      /* caps with sub-plugin's tensor info */
-      gst_tensors_info_copy (&out_info, &prop->output_meta);
-      configured = TRUE;
+      /* caps with sub-plugin's tensor info (a single frame of the batch) */
+      configured = gst_tensor_filter_common_get_frame_info (priv,
+          &prop->output_meta, &out_info);
     } else {
+      GstTensorsInfo batched_in, batched_out;
+
+      gst_tensors_info_init (&batched_in);
+      gst_tensors_info_init (&batched_out);
+
       /* check in-tensor info to call setInputDimension */
-      configured = gst_tensor_filter_common_get_out_info (priv,
-          &in_config.info, &out_info);
+      configured = gst_tensor_filter_common_get_batched_info (priv,
+          &in_config.info, &batched_in) &&
+          gst_tensor_filter_common_get_out_info (priv, &batched_in,
+          &batched_out) &&
+          gst_tensor_filter_common_get_frame_info (priv, &batched_out,
+          &out_info);
+
+      gst_tensors_info_free (&batched_in);
+      gst_tensors_info_free (&batched_out);
     }
 
     /* If output combination option is given, reconfigure tensor info */
@@ -1170,15 +3823,29 @@ gst_tensor_filter_transform_caps (GstBaseTransform * trans,
   } else {
     /* caps: src pad. get sink pad info */
     if (prop->input_configured && !priv->combi.in_combi_defined) {
-      /* caps with sub-plugin's tensor info */
-      gst_tensors_info_copy (&out_config.info, &prop->input_meta);
-      configured = TRUE;
+      /* caps with sub-plugin's tensor info (a single frame of the batch) */
+      configured = gst_tensor_filter_common_get_frame_info (priv,
+          &prop->input_meta, &out_config.info);
     }
   }
 
   if (configured) {
+    GstCaps *sparse;
+
     /* output info may be configured */
     result = gst_tensor_pad_possible_caps_from_config (pad, &out_config);
+
+    /* sparse tensors are decoded before invoke or encoded from the outputs, the lowest priority */
+    sparse = gst_caps_from_string (GST_TENSORS_SPARSE_CAP_DEFAULT);
+    if (out_config.rate_n >= 0 && out_config.rate_d > 0) {
+      gst_caps_set_simple (sparse, "framerate", GST_TYPE_FRACTION,
+          out_config.rate_n, out_config.rate_d, NULL);
+    }
+
+    if (result)
+      gst_caps_append (result, sparse);
+    else
+      result = sparse;
   } else {
     /* we don't know the exact tensor info yet */
     result = gst_caps_from_string (CAPS_STRING);
@@ -1293,6 +3960,8 @@ gst_tensor_filter_set_caps (GstBaseTransform * trans,
   gst_tensors_config_from_structure (&config, structure);
   if (gst_tensors_config_is_flexible (&config)) {
     GST_INFO_OBJECT (self, "Output tensor is flexible.");
+  } else if (gst_tensors_config_is_sparse (&config)) {
+    GST_INFO_OBJECT (self, "Output tensor is sparse.");
   } else if (!gst_tensors_config_is_equal (&priv->out_config, &config)) {
     GstTensorFilterProperties *prop = &priv->prop;
     gchar *compare = gst_tensorsinfo_compare_to_string (&priv->out_config.info,
@@ -1304,6 +3973,10 @@ gst_tensor_filter_set_caps (GstBaseTransform * trans,
     return FALSE;
   }
 
+  gst_tensor_filter_sparse_configure (self, incaps, outcaps);
+  gst_tensor_filter_skip_configure (self);
+  gst_tensor_filter_cascade_configure (self);
+  gst_tensor_filter_warmup (self);
   return TRUE;
 }
 
@@ -1331,7 +4004,7 @@ gst_tensor_filter_query (GstBaseTransform * trans,
       gdouble latency;
 
       GST_OBJECT_LOCK (self);
-      estimated = (gint) priv->prop.latency;
+      estimated = g_atomic_int_get (&priv->prop.latency);
       GST_OBJECT_UNLOCK (self);
 
       if ((priv->latency_reporting) && (estimated > 0)) {
@@ -1345,6 +4018,10 @@ gst_tensor_filter_query (GstBaseTransform * trans,
 
           latency = (gdouble) estimated *GST_USECOND *
               (1 + LATENCY_REPORT_HEADROOM);
+
+          /* add the time to wait for the frames of a batch */
+          if (priv->max_batch > 1)
+            latency += (gdouble) priv->batch_timeout * GST_USECOND;
           priv->latency_reported = (gint64) latency;
 
           min += (gint64) latency;
@@ -1404,6 +4081,86 @@ gst_tensor_filter_transform_size (GstBaseTransform * trans,
   return TRUE;
 }
 
+/**
+ * @brief Check tensor-filter can fill the buffers from the tensor buffer pool.
+ */
+static gboolean
+gst_tensor_filter_can_use_pool (GstTensorFilter * self, GstCaps * caps)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorsConfig config;
+  gboolean is_static;
+
+  /* the output memory is allocated by the subplugin or reordered with the combination */
+  if (gst_tensor_filter_allocate_in_invoke (priv) ||
+      (GST_TF_FW_V2 (priv->fw) && priv->fw->invoke_memory) ||
+      priv->combi.out_combi_i_defined || priv->combi.out_combi_o_defined)
+    return FALSE;
+
+  /* the output buffers are created by tensor-filter itself */
+  if (priv->max_batch > 1 || self->workers.pool)
+    return FALSE;
+
+  gst_tensors_config_init (&config);
+  is_static = gst_tensors_config_from_structure (&config,
+      gst_caps_get_structure (caps, 0)) &&
+      gst_tensors_config_is_static (&config);
+  gst_tensors_config_free (&config);
+
+  return is_static;
+}
+
+/**
+ * @brief Decide the allocation of the output buffers. optional vmethod of BaseTransform
+ *
+ * The default buffer pool has a single memory chunk for the buffer, which cannot be used for the tensors.
+ * If possible, tensor-filter proposes the tensor buffer pool sized from the negotiated output info.
+ */
+static gboolean
+gst_tensor_filter_decide_allocation (GstBaseTransform * trans,
+    GstQuery * query)
+{
+  GstTensorFilter *self = GST_TENSOR_FILTER_CAST (trans);
+  GstCaps *caps = NULL;
+  GstBufferPool *pool;
+  GstStructure *config;
+  guint size = 0, min = 0;
+
+  gst_query_parse_allocation (query, &caps, NULL);
+
+  if (gst_query_get_n_allocation_pools (query) > 0)
+    gst_query_parse_nth_allocation_pool (query, 0, NULL, &size, &min, NULL);
+
+  while (gst_query_get_n_allocation_pools (query) > 0)
+    gst_query_remove_nth_allocation_pool (query, 0);
+
+  if (caps && gst_tensor_filter_can_use_pool (self, caps)) {
+    pool = gst_tensor_buffer_pool_new ();
+    config = gst_buffer_pool_get_config (pool);
+
+    /* no limit, downstream may keep the buffers */
+    gst_buffer_pool_config_set_params (config, caps, size, min, 0);
+
+    if (gst_buffer_pool_set_config (pool, config)) {
+      config = gst_buffer_pool_get_config (pool);
+      gst_buffer_pool_config_get_params (config, NULL, &size, NULL, NULL);
+      gst_structure_free (config);
+
+      gst_query_add_allocation_pool (query, pool, size, min, 0);
+      GST_DEBUG_OBJECT (self, "Use tensor buffer pool (size %u, min %u).",
+          size, min);
+    } else {
+      GST_WARNING_OBJECT (self,
+          "Failed to configure the tensor buffer pool, allocate the output memory for each frame.");
+    }
+
+    gst_object_unref (pool);
+  }
+
+  return GST_BASE_TRANSFORM_CLASS (parent_class)->decide_allocation (trans,
+      query);
+}
+
 /**
  * @brief Event handler for sink pad of tensor filter.
  * @param trans "this" pointer
@@ -1417,7 +4174,54 @@ gst_tensor_filter_sink_event (GstBaseTransform * trans, GstEvent * event)
   GstTensorFilterPrivate *priv;
   self = GST_TENSOR_FILTER_CAST (trans);
   priv = &self->priv;
+
+  if (priv->max_batch > 1) {
+    GstTensorFilterBatch *batch = &self->batch;
+
+    if (GST_EVENT_TYPE (event) == GST_EVENT_FLUSH_START) {
+      g_atomic_int_set (&batch->flushing, TRUE);
+    } else if (GST_EVENT_TYPE (event) == GST_EVENT_FLUSH_STOP) {
+      g_mutex_lock (&batch->lock);
+      g_queue_clear_full (&batch->frames, (GDestroyNotify) gst_buffer_unref);
+      batch->last_ret = GST_FLOW_OK;
+      g_atomic_int_set (&batch->flushing, FALSE);
+      g_mutex_unlock (&batch->lock);
+    } else if (GST_EVENT_IS_SERIALIZED (event)) {
+      /* invoke the incomplete batch to keep the order of serialized events */
+      gst_tensor_filter_batch_drain (self);
+    }
+  }
+
+  if (self->workers.pool) {
+    GstTensorFilterWorkers *workers = &self->workers;
+
+    if (GST_EVENT_TYPE (event) == GST_EVENT_FLUSH_START) {
+      g_mutex_lock (&workers->lock);
+      workers->flushing = TRUE;
+      g_cond_broadcast (&workers->cond);
+      g_mutex_unlock (&workers->lock);
+    } else if (GST_EVENT_IS_SERIALIZED (event)) {
+      /* keep the order of serialized events and the outputs in flight */
+      gst_tensor_filter_workers_drain (self);
+
+      if (GST_EVENT_TYPE (event) == GST_EVENT_FLUSH_STOP) {
+        g_mutex_lock (&workers->lock);
+        workers->flushing = FALSE;
+        workers->last_ret = GST_FLOW_OK;
+        g_mutex_unlock (&workers->lock);
+      }
+    }
+  }
+
   switch (GST_EVENT_TYPE (event)) {
+    case GST_EVENT_FLUSH_STOP:
+      /* the previous output is not pushed again after seeking */
+      gst_tensor_filter_skip_reset (self);
+
+      GST_OBJECT_LOCK (trans);
+      self->deadline.earliest = GST_CLOCK_TIME_NONE;
+      GST_OBJECT_UNLOCK (trans);
+      break;
     case GST_EVENT_CUSTOM_DOWNSTREAM:
     {
       const GstStructure *structure = gst_event_get_structure (event);
@@ -1437,6 +4241,10 @@ gst_tensor_filter_sink_event (GstBaseTransform * trans, GstEvent * event)
       gst_event_unref (event);
       return (ret == 0);
     }
+    case GST_EVENT_EOS:
+      /* the per-op profile aggregated over the stream */
+      post_profile (self);
+      break;
     default:
       break;
   }
@@ -1460,7 +4268,17 @@ gst_tensor_filter_src_event (GstBaseTransform * trans, GstEvent * event)
     {
       GstQOSType type;
       GstClockTimeDiff diff;
-      gst_event_parse_qos (event, &type, NULL, &diff, NULL);
+      GstClockTime timestamp;
+      gst_event_parse_qos (event, &type, NULL, &diff, &timestamp);
+      if (type != GST_QOS_TYPE_THROTTLE && GST_CLOCK_TIME_IS_VALID (timestamp)) {
+        /* the frames before the earliest time would be late in downstream (deadline) */
+        GST_OBJECT_LOCK (trans);
+        if (diff >= 0 || timestamp > (GstClockTime) (-diff))
+          self->deadline.earliest = timestamp + diff;
+        else
+          self->deadline.earliest = 0;
+        GST_OBJECT_UNLOCK (trans);
+      }
       if (type == GST_QOS_TYPE_THROTTLE && diff > 0) {
         GST_OBJECT_LOCK (trans);
         if (self->throttling_delay != 0)
@@ -1484,6 +4302,81 @@ gst_tensor_filter_src_event (GstBaseTransform * trans, GstEvent * event)
   return GST_BASE_TRANSFORM_CLASS (parent_class)->src_event (trans, event);
 }
 
+/**
+ * @brief Register the filter on the accelerator shared in the process and open the instance on CPU for the latency budget.
+ */
+static void
+gst_tensor_filter_sched_start (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterProperties *prop = &priv->prop;
+  GstTensorFilterSched *sched = &self->sched;
+  accl_hw hw;
+
+  if (!priv->accl_schedule || priv->sched_client)
+    return;
+
+  hw = gst_tensor_filter_common_get_accelerator (priv);
+  priv->sched_client = gst_tensor_filter_scheduler_register (hw,
+      priv->accl_priority, priv->accl_weight);
+  if (!priv->sched_client) {
+    GST_INFO_OBJECT (self,
+        "The accelerator (%s) is not shared, the invokes are not scheduled.",
+        get_accl_hw_str (hw));
+    return;
+  }
+
+  if (priv->accl_latency_budget == 0)
+    return;
+
+  /* the instance on CPU cannot follow the shared or reloaded model */
+  if (prop->shared_tensor_filter_key || priv->is_updatable ||
+      !priv->fw->open || !gst_tensor_filter_check_hw_availability (prop->fwname,
+          ACCL_CPU, prop->custom_properties)) {
+    GST_WARNING_OBJECT (self,
+        "The framework (%s) cannot open the model on CPU, the invokes wait for the accelerator regardless of the latency budget.",
+        prop->fwname);
+    return;
+  }
+
+  sched->fallback_prop = *prop;
+  sched->fallback_hw = ACCL_CPU;
+  sched->fallback_prop.hw_list = &sched->fallback_hw;
+  sched->fallback_prop.num_hw = 1;
+  sched->fallback_prop.accl_str = "true:" ACCL_CPU_STR;
+  sched->fallback = NULL;
+
+  if (priv->fw->open (&sched->fallback_prop, &sched->fallback) < 0) {
+    GST_WARNING_OBJECT (self,
+        "Failed to open the framework (%s) on CPU, the invokes wait for the accelerator regardless of the latency budget.",
+        prop->fwname);
+    sched->fallback = NULL;
+    return;
+  }
+
+  sched->has_fallback = TRUE;
+}
+
+/**
+ * @brief Close the instance on CPU and unregister the filter from the shared accelerator.
+ */
+static void
+gst_tensor_filter_sched_stop (GstTensorFilter * self)
+{
+  GstTensorFilterPrivate *priv = &self->priv;
+  GstTensorFilterSched *sched = &self->sched;
+
+  if (sched->has_fallback) {
+    if (priv->fw && priv->fw->close)
+      priv->fw->close (&sched->fallback_prop, &sched->fallback);
+    sched->fallback = NULL;
+    sched->has_fallback = FALSE;
+  }
+
+  gst_tensor_filter_scheduler_unregister (priv->sched_client);
+  priv->sched_client = NULL;
+}
+
 /**
  * @brief Called when the element starts processing. optional vmethod of BaseTransform
  * @param trans "this" pointer
@@ -1500,7 +4393,58 @@ gst_tensor_filter_start (GstBaseTransform * trans)
   if (priv->fw == NULL)
     return FALSE;
   gst_tensor_filter_common_open_fw (priv);
-  return priv->prop.fw_opened;
+  if (!priv->prop.fw_opened)
+    return FALSE;
+
+  post_model_cache (self);
+
+  /* check the framework can keep the tensors in the device memory or import DMA-BUF */
+  priv->device_ops = NULL;
+  priv->device_input = priv->device_output = priv->dmabuf_input = FALSE;
+  if (!gst_tensor_filter_get_device_memory (priv, priv->privateData,
+          &priv->device_ops, &priv->device_input, &priv->device_output,
+          &priv->dmabuf_input) && priv->device_memory) {
+    ml_logw
+        ("The tensor-filter subplugin (%s) does not support the device memory, the tensors are copied to host memory.\n",
+        priv->prop.fwname);
+  }
+
+  gst_tensor_filter_sched_start (self);
+  gst_tensor_filter_accl_switch_start (self);
+  priv->skip_frames = priv->skip_num = 0;
+  priv->invoke_estimate = 0;
+  GST_OBJECT_LOCK (trans);
+  memset (&self->deadline, 0, sizeof (GstTensorFilterDeadline));
+  self->deadline.earliest = GST_CLOCK_TIME_NONE;
+  GST_OBJECT_UNLOCK (trans);
+
+  /* the outputs are cached in the streaming thread, the device memory is not hashed */
+  if (priv->cache_size > 0) {
+    if (priv->max_batch > 1 || priv->num_workers > 1 || priv->device_input) {
+      GST_WARNING_OBJECT (self,
+          "cache-size is not applied with max-batch, workers or the device input tensors.");
+    } else {
+      priv->cache = gst_tensor_filter_cache_new ((gsize) MIN (priv->cache_size,
+              G_MAXSIZE));
+    }
+  }
+
+  gst_tensor_filter_cascade_start (self);
+
+  if (priv->max_batch > 1) {
+    if (!gst_tensor_filter_batch_start (self))
+      return FALSE;
+  } else if (!gst_tensor_filter_workers_start (self)) {
+    return FALSE;
+  }
+
+  /* warm up the model if the tensors info is given by the model or properties */
+  if (priv->warmup > 0) {
+    gst_tensor_filter_load_tensor_info (priv);
+    gst_tensor_filter_warmup (self);
+  }
+
+  return TRUE;
 }
 
 /**
@@ -1515,6 +4459,19 @@ gst_tensor_filter_stop (GstBaseTransform * trans)
   GstTensorFilterPrivate *priv;
   self = GST_TENSOR_FILTER_CAST (trans);
   priv = &self->priv;
+  gst_tensor_filter_reload_join (self);
+  gst_tensor_filter_accl_switch_stop (self);
+  gst_tensor_filter_batch_stop (self);
+  gst_tensor_filter_workers_stop (self);
+  gst_tensor_filter_sched_stop (self);
+  gst_tensor_filter_skip_free (self);
+  gst_tensor_filter_sparse_stop (self);
+  gst_tensor_filter_cascade_stop (self);
+  gst_tensor_filter_cache_free (priv->cache);
+  priv->cache = NULL;
   gst_tensor_filter_common_close_fw (priv);
+  priv->device_ops = NULL;
+  priv->dmabuf_input = FALSE;
+  self->warmed_up = FALSE;
   return TRUE;
 }
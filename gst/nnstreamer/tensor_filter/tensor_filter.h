@@ -55,6 +55,163 @@ G_BEGIN_DECLS
 typedef struct _GstTensorFilter GstTensorFilter;
 typedef struct _GstTensorFilterClass GstTensorFilterClass;
 
+/**
+ * @brief Slot to keep the output of asynchronous invoke until it is pushed in order.
+ */
+typedef struct
+{
+  GstBuffer *outbuf; /**< the output buffer (NULL if the frame is dropped) */
+  gboolean done; /**< TRUE if the worker has finished the frame */
+} GstTensorFilterWorkerSlot;
+
+/**
+ * @brief Data structure for asynchronous multi-worker invoke (workers > 1).
+ */
+typedef struct
+{
+  guint num_workers; /**< the number of framework instances and worker threads */
+  GThreadPool *pool; /**< worker threads to invoke the model */
+  GAsyncQueue *idle_instances; /**< the framework instances (pointer to private data) not being used */
+  void *instances[GST_TF_MAX_WORKERS]; /**< private data of the additional framework instances (index 0 is not used, tensor-filter's private data is the first instance) */
+
+  GMutex lock; /**< mutex for the sequence numbers and output slots */
+  GCond cond; /**< signaled when an output is pushed */
+  GMutex push_lock; /**< serializes pushing the outputs downstream */
+  GstTensorFilterWorkerSlot *slots; /**< ring of output slots indexed by sequence number */
+  guint num_slots; /**< the max number of frames in flight */
+  guint64 seq_in; /**< sequence number of the next incoming frame */
+  guint64 seq_out; /**< sequence number of the next frame to be pushed */
+  gboolean flushing; /**< TRUE if pending outputs should be discarded */
+  GstFlowReturn last_ret; /**< the last flow return of pushing the outputs */
+} GstTensorFilterWorkers;
+
+/**
+ * @brief Data structure for dynamic cross-frame batching (max-batch > 1).
+ */
+typedef struct
+{
+  GMutex lock; /**< mutex for the queued frames, held while invoking the batch */
+  GCond cond; /**< signaled when a frame is queued or the batch thread stops */
+  GQueue frames; /**< the input buffers waiting for the batch */
+  gint64 deadline; /**< monotonic time (usec) to invoke the incomplete batch */
+  GThread *thread; /**< thread to invoke the incomplete batch when batch-timeout expires */
+  gboolean running; /**< TRUE while the batch thread is running */
+  gint flushing; /**< TRUE (atomic) if the queued frames should be discarded */
+  GstFlowReturn last_ret; /**< the last flow return of invoking the batch and pushing the outputs */
+} GstTensorFilterBatch;
+
+/**
+ * @brief Data structure to reload the model in the background thread (reload-async).
+ */
+typedef struct
+{
+  GMutex lock; /**< mutex held while invoking with the private data, to switch the framework instance */
+  GThread *thread; /**< thread to load the new model, NULL if not started */
+  gchar *model_files; /**< the model files to be loaded in the thread */
+} GstTensorFilterReload;
+
+/**
+ * @brief Data structure for the invokes on the accelerator shared in the process (accl-schedule).
+ */
+typedef struct
+{
+  GMutex fallback_lock; /**< mutex held while invoking with the CPU instance */
+  gboolean has_fallback; /**< TRUE if the framework instance on CPU is opened */
+  GstTensorFilterProperties fallback_prop; /**< the properties of the instance on CPU (the accelerator is replaced) */
+  accl_hw fallback_hw; /**< the accelerator list of the instance on CPU */
+  void *fallback; /**< private data of the framework instance on CPU for the frames over accl-latency-budget */
+} GstTensorFilterSched;
+
+/**
+ * @brief The max number of the accelerators to switch between (accl-switch-high).
+ */
+#define GST_TF_MAX_ACCL_SWITCH (8)
+
+/**
+ * @brief The weight of the latest invoke in the average latency on the accelerator (1/N).
+ */
+#define GST_TF_ACCL_SWITCH_WEIGHT (8)
+
+/**
+ * @brief The min time (usec) on the accelerator after switching, to measure the latency.
+ */
+#define GST_TF_ACCL_SWITCH_DWELL (G_USEC_PER_SEC)
+
+/**
+ * @brief The time (usec) to halve the latency of the accelerator not used, to try it again.
+ */
+#define GST_TF_ACCL_SWITCH_HALFLIFE (G_USEC_PER_SEC)
+
+/**
+ * @brief Data structure to switch the accelerator by the invoke latency (accl-switch-high).
+ */
+typedef struct
+{
+  GMutex lock; /**< mutex for the latencies and the thread */
+  GThread *thread; /**< thread to switch the framework instance, NULL if not started */
+  gboolean running; /**< TRUE while the thread is switching the accelerator */
+  guint num_hw; /**< the number of the accelerators to switch between (0: not switching) */
+  accl_hw hw[GST_TF_MAX_ACCL_SWITCH]; /**< the accelerators in the order of preference */
+  gint64 estimate[GST_TF_MAX_ACCL_SWITCH]; /**< the average invoke latency (usec) on the accelerators, 0 if not measured */
+  gint64 measured[GST_TF_MAX_ACCL_SWITCH]; /**< monotonic time (usec) when the latency is measured */
+  guint current; /**< index of the accelerator of the running instance */
+  guint target; /**< index of the accelerator to switch to */
+  gint64 switched; /**< monotonic time (usec) of the latest switch */
+  guint64 switches; /**< the number of the switches */
+} GstTensorFilterAcclSwitch;
+
+/**
+ * @brief Data structure to skip the invoke for the input barely changed (skip-threshold).
+ */
+typedef struct
+{
+  guint8 *ref; /**< the sampled blocks of the input tensors of the latest invoke */
+  guint8 *cur; /**< the sampled blocks of the incoming input tensors */
+  gsize size; /**< the size of the sampled blocks */
+  gboolean has_ref; /**< TRUE if ref and outbuf are given by the latest invoke */
+  gboolean pending; /**< TRUE if cur should be the reference after the invoke */
+  GstBuffer *outbuf; /**< the output of the latest invoke */
+  guint skipped; /**< the number of the consecutive frames skipped */
+  gboolean unsupported; /**< TRUE if the input tensors cannot be compared */
+  gint invalid; /**< TRUE (atomic) if the reference should be dropped (e.g., the model is reloaded) */
+} GstTensorFilterSkip;
+
+/**
+ * @brief Data structure to drop the frames missing the deadline (deadline).
+ */
+typedef struct
+{
+  GstClockTime earliest; /**< the running time given by the QoS event, the frames before it are late (protected by the object lock) */
+  guint64 processed; /**< the number of the frames invoked in time */
+  guint64 dropped; /**< the number of the frames dropped for the deadline */
+} GstTensorFilterDeadline;
+
+/**
+ * @brief The max number of the models invoked after the model (cascade).
+ */
+#define GST_TF_MAX_CASCADE (8)
+
+/**
+ * @brief The model invoked if the outputs of the previous model are not confident (cascade).
+ */
+typedef struct
+{
+  void *data; /**< the private data of the framework instance */
+  gchar **model_files; /**< the model files of the stage */
+  guint num_models; /**< the number of the model files */
+  gboolean checked; /**< TRUE if the tensors info of the model is checked */
+} GstTensorFilterCascadeStage;
+
+/**
+ * @brief Data structure for the early-exit cascade of the models (cascade).
+ */
+typedef struct
+{
+  guint num_stages; /**< the number of the models after the model */
+  GstTensorFilterCascadeStage stages[GST_TF_MAX_CASCADE]; /**< the models in order */
+  GstElement *cond; /**< the tensor_if evaluating the outputs, not linked in the pipeline */
+} GstTensorFilterCascade;
+
 /**
  * @brief Internal data structure for tensor_filter instances.
  */
@@ -67,6 +224,16 @@ struct _GstTensorFilter
   GstClockTime prev_ts;  /**< previous timestamp */
   GstClockTimeDiff throttling_delay;  /**< throttling delay from tensor rate */
   GstClockTimeDiff throttling_accum;  /**< accumulated frame durations for throttling */
+
+  GstTensorFilterWorkers workers; /**< asynchronous invoke with multiple framework instances */
+  GstTensorFilterBatch batch; /**< dynamic batching of incoming frames */
+  GstTensorFilterReload reload; /**< double-buffered reload of the model */
+  GstTensorFilterSched sched; /**< arbitration of the accelerator shared with the other filters */
+  GstTensorFilterAcclSwitch accl_switch; /**< switching the accelerator by the invoke latency */
+  GstTensorFilterSkip skip; /**< skipping the invoke for the unchanged input */
+  GstTensorFilterDeadline deadline; /**< dropping the late frames before the invoke */
+  GstTensorFilterCascade cascade; /**< invoking the next models until the outputs are confident */
+  gboolean warmed_up; /**< TRUE if the model has been warmed up (warmup) */
 };
 
 /**
@@ -0,0 +1,314 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	tensor_filter_cache.c
+ * @date	14 Oct 2026
+ * @brief	Bounded LRU cache of the outputs of tensor_filter for the identical input tensors
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ */
+
+#include <string.h>
+#include "tensor_filter_cache.h"
+
+#define XXH_PRIME64_1 G_GUINT64_CONSTANT (0x9E3779B185EBCA87)
+#define XXH_PRIME64_2 G_GUINT64_CONSTANT (0xC2B2AE3D27D4EB4F)
+#define XXH_PRIME64_3 G_GUINT64_CONSTANT (0x165667B19E3779F9)
+#define XXH_PRIME64_4 G_GUINT64_CONSTANT (0x85EBCA77C2B2AE63)
+#define XXH_PRIME64_5 G_GUINT64_CONSTANT (0x27D4EB2F165667C5)
+
+#define XXH_ROTL64(x,r) (((x) << (r)) | ((x) >> (64 - (r))))
+
+/**
+ * @brief The output cached for the key.
+ */
+typedef struct
+{
+  guint64 key; /**< the hash of the input tensors */
+  GstBuffer *outputs; /**< the output memory chunks */
+  gsize bytes; /**< the size of the outputs */
+} GstTensorFilterCacheEntry;
+
+/**
+ * @brief The cache of the outputs.
+ */
+struct _GstTensorFilterCache
+{
+  GMutex lock; /**< lock for the entries */
+  gsize max_bytes; /**< the maximum size of the cached outputs */
+  gsize bytes; /**< the size of the cached outputs */
+  GHashTable *table; /**< the list nodes of the entries by the key */
+  GQueue lru; /**< the entries, the head is the most recently used one */
+  guint generation; /**< increased when the cache is cleared */
+  guint64 hits; /**< the number of the lookups finding the output */
+  guint64 misses; /**< the number of the lookups not finding the output */
+};
+
+/**
+ * @brief Read the 64-bit little-endian value.
+ */
+static inline guint64
+xxh_read64 (const guint8 * p)
+{
+  guint64 v;
+
+  memcpy (&v, p, sizeof (v));
+  return GUINT64_FROM_LE (v);
+}
+
+/**
+ * @brief Read the 32-bit little-endian value.
+ */
+static inline guint32
+xxh_read32 (const guint8 * p)
+{
+  guint32 v;
+
+  memcpy (&v, p, sizeof (v));
+  return GUINT32_FROM_LE (v);
+}
+
+/**
+ * @brief The round of XXH64.
+ */
+static inline guint64
+xxh_round (guint64 acc, guint64 input)
+{
+  acc += input * XXH_PRIME64_2;
+  acc = XXH_ROTL64 (acc, 31);
+  return acc * XXH_PRIME64_1;
+}
+
+/**
+ * @brief Merge the accumulator into the hash.
+ */
+static inline guint64
+xxh_merge_round (guint64 h, guint64 acc)
+{
+  h ^= xxh_round (0, acc);
+  return h * XXH_PRIME64_1 + XXH_PRIME64_4;
+}
+
+/**
+ * @brief Get the 64-bit hash (XXH64) of the data.
+ */
+guint64
+gst_tensor_filter_cache_hash (const guint8 * data, gsize size, guint64 seed)
+{
+  const guint8 *p = data;
+  const guint8 *end = data + size;
+  guint64 h;
+
+  if (size >= 32) {
+    guint64 v1 = seed + XXH_PRIME64_1 + XXH_PRIME64_2;
+    guint64 v2 = seed + XXH_PRIME64_2;
+    guint64 v3 = seed;
+    guint64 v4 = seed - XXH_PRIME64_1;
+
+    for (; p + 32 <= end; p += 32) {
+      v1 = xxh_round (v1, xxh_read64 (p));
+      v2 = xxh_round (v2, xxh_read64 (p + 8));
+      v3 = xxh_round (v3, xxh_read64 (p + 16));
+      v4 = xxh_round (v4, xxh_read64 (p + 24));
+    }
+
+    h = XXH_ROTL64 (v1, 1) + XXH_ROTL64 (v2, 7) + XXH_ROTL64 (v3, 12) +
+        XXH_ROTL64 (v4, 18);
+    h = xxh_merge_round (h, v1);
+    h = xxh_merge_round (h, v2);
+    h = xxh_merge_round (h, v3);
+    h = xxh_merge_round (h, v4);
+  } else {
+    h = seed + XXH_PRIME64_5;
+  }
+
+  h += (guint64) size;
+
+  for (; p + 8 <= end; p += 8) {
+    h ^= xxh_round (0, xxh_read64 (p));
+    h = XXH_ROTL64 (h, 27) * XXH_PRIME64_1 + XXH_PRIME64_4;
+  }
+
+  if (p + 4 <= end) {
+    h ^= (guint64) xxh_read32 (p) * XXH_PRIME64_1;
+    h = XXH_ROTL64 (h, 23) * XXH_PRIME64_2 + XXH_PRIME64_3;
+    p += 4;
+  }
+
+  for (; p < end; p++) {
+    h ^= (*p) * XXH_PRIME64_5;
+    h = XXH_ROTL64 (h, 11) * XXH_PRIME64_1;
+  }
+
+  /* avalanche */
+  h ^= h >> 33;
+  h *= XXH_PRIME64_2;
+  h ^= h >> 29;
+  h *= XXH_PRIME64_3;
+  h ^= h >> 32;
+
+  return h;
+}
+
+/**
+ * @brief Free the entry.
+ */
+static void
+_cache_entry_free (GstTensorFilterCacheEntry * entry)
+{
+  gst_buffer_unref (entry->outputs);
+  g_free (entry);
+}
+
+/**
+ * @brief Remove the list node of the entry. The lock should be held.
+ */
+static void
+_cache_remove_link (GstTensorFilterCache * cache, GList * link)
+{
+  GstTensorFilterCacheEntry *entry = (GstTensorFilterCacheEntry *) link->data;
+
+  g_hash_table_remove (cache->table, &entry->key);
+  g_queue_delete_link (&cache->lru, link);
+  cache->bytes -= entry->bytes;
+  _cache_entry_free (entry);
+}
+
+/**
+ * @brief Create the cache.
+ */
+GstTensorFilterCache *
+gst_tensor_filter_cache_new (gsize max_bytes)
+{
+  GstTensorFilterCache *cache;
+
+  cache = g_new0 (GstTensorFilterCache, 1);
+  g_mutex_init (&cache->lock);
+  g_queue_init (&cache->lru);
+  cache->max_bytes = max_bytes;
+  cache->table = g_hash_table_new (g_int64_hash, g_int64_equal);
+
+  return cache;
+}
+
+/**
+ * @brief Free the cache and the cached outputs.
+ */
+void
+gst_tensor_filter_cache_free (GstTensorFilterCache * cache)
+{
+  if (!cache)
+    return;
+
+  gst_tensor_filter_cache_clear (cache);
+  g_hash_table_destroy (cache->table);
+  g_mutex_clear (&cache->lock);
+  g_free (cache);
+}
+
+/**
+ * @brief Find the output of the key, the output becomes the most recently used one.
+ */
+GstBuffer *
+gst_tensor_filter_cache_lookup (GstTensorFilterCache * cache, guint64 key,
+    guint * generation)
+{
+  GstTensorFilterCacheEntry *entry;
+  GstBuffer *outputs = NULL;
+  GList *link;
+
+  g_return_val_if_fail (cache != NULL, NULL);
+
+  g_mutex_lock (&cache->lock);
+  link = (GList *) g_hash_table_lookup (cache->table, &key);
+  if (link) {
+    entry = (GstTensorFilterCacheEntry *) link->data;
+    outputs = gst_buffer_ref (entry->outputs);
+
+    g_queue_unlink (&cache->lru, link);
+    g_queue_push_head_link (&cache->lru, link);
+    cache->hits++;
+  } else {
+    cache->misses++;
+  }
+
+  if (generation)
+    *generation = cache->generation;
+  g_mutex_unlock (&cache->lock);
+
+  return outputs;
+}
+
+/**
+ * @brief Add the output of the key, the least recently used outputs are evicted to keep the maximum size.
+ */
+void
+gst_tensor_filter_cache_insert (GstTensorFilterCache * cache, guint64 key,
+    guint generation, GstBuffer * outputs)
+{
+  GstTensorFilterCacheEntry *entry;
+  gsize bytes;
+
+  g_return_if_fail (cache != NULL);
+  g_return_if_fail (outputs != NULL);
+
+  bytes = gst_buffer_get_size (outputs);
+
+  g_mutex_lock (&cache->lock);
+  if (generation != cache->generation || bytes > cache->max_bytes ||
+      g_hash_table_contains (cache->table, &key)) {
+    g_mutex_unlock (&cache->lock);
+    return;
+  }
+
+  while (cache->bytes + bytes > cache->max_bytes)
+    _cache_remove_link (cache, cache->lru.tail);
+
+  entry = g_new0 (GstTensorFilterCacheEntry, 1);
+  entry->key = key;
+  entry->outputs = gst_buffer_ref (outputs);
+  entry->bytes = bytes;
+
+  g_queue_push_head (&cache->lru, entry);
+  g_hash_table_insert (cache->table, &entry->key, cache->lru.head);
+  cache->bytes += bytes;
+  g_mutex_unlock (&cache->lock);
+}
+
+/**
+ * @brief Remove all outputs (e.g., the model is changed).
+ */
+void
+gst_tensor_filter_cache_clear (GstTensorFilterCache * cache)
+{
+  g_return_if_fail (cache != NULL);
+
+  g_mutex_lock (&cache->lock);
+  while (cache->lru.tail)
+    _cache_remove_link (cache, cache->lru.tail);
+  cache->generation++;
+  g_mutex_unlock (&cache->lock);
+}
+
+/**
+ * @brief Get the statistics of the cache.
+ */
+void
+gst_tensor_filter_cache_get_stats (GstTensorFilterCache * cache,
+    GstTensorFilterCacheStats * stats)
+{
+  g_return_if_fail (stats != NULL);
+  memset (stats, 0, sizeof (GstTensorFilterCacheStats));
+
+  if (!cache)
+    return;
+
+  g_mutex_lock (&cache->lock);
+  stats->hits = cache->hits;
+  stats->misses = cache->misses;
+  stats->bytes = cache->bytes;
+  stats->num_entries = cache->lru.length;
+  g_mutex_unlock (&cache->lock);
+}
@@ -0,0 +1,90 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	tensor_filter_cache.h
+ * @date	14 Oct 2026
+ * @brief	Bounded LRU cache of the outputs of tensor_filter for the identical input tensors
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ *
+ * The outputs are keyed by the 64-bit hash (XXH64) of the input tensors.
+ * The cache keeps the memory chunks of the outputs up to the given bytes,
+ * and the least recently used outputs are evicted first.
+ */
+
+#ifndef __TENSOR_FILTER_CACHE_H__
+#define __TENSOR_FILTER_CACHE_H__
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief The cache of the outputs.
+ */
+typedef struct _GstTensorFilterCache GstTensorFilterCache;
+
+/**
+ * @brief Statistics of the cache.
+ */
+typedef struct
+{
+  guint64 hits; /**< the number of the lookups finding the output */
+  guint64 misses; /**< the number of the lookups not finding the output */
+  gsize bytes; /**< the size of the cached outputs */
+  guint num_entries; /**< the number of the cached outputs */
+} GstTensorFilterCacheStats;
+
+/**
+ * @brief Get the 64-bit hash (XXH64) of the data.
+ * @param seed The seed, the hash of the previous data to chain the memory chunks.
+ */
+extern guint64
+gst_tensor_filter_cache_hash (const guint8 * data, gsize size, guint64 seed);
+
+/**
+ * @brief Create the cache.
+ * @param max_bytes The maximum size of the cached outputs.
+ * @return The cache. Free it with gst_tensor_filter_cache_free().
+ */
+extern GstTensorFilterCache *
+gst_tensor_filter_cache_new (gsize max_bytes);
+
+/**
+ * @brief Free the cache and the cached outputs.
+ */
+extern void
+gst_tensor_filter_cache_free (GstTensorFilterCache * cache);
+
+/**
+ * @brief Find the output of the key, the output becomes the most recently used one.
+ * @param[out] generation The generation of the cache, to be given to gst_tensor_filter_cache_insert().
+ * @return The buffer of the output memory chunks (caller should unref it), NULL if not cached.
+ */
+extern GstBuffer *
+gst_tensor_filter_cache_lookup (GstTensorFilterCache * cache, guint64 key, guint * generation);
+
+/**
+ * @brief Add the output of the key, the least recently used outputs are evicted to keep the maximum size.
+ * @param generation The generation given by the lookup, the output is not added if the cache is cleared after the lookup.
+ * @param outputs The buffer of the output memory chunks, the cache takes a ref.
+ */
+extern void
+gst_tensor_filter_cache_insert (GstTensorFilterCache * cache, guint64 key, guint generation, GstBuffer * outputs);
+
+/**
+ * @brief Remove all outputs (e.g., the model is changed).
+ */
+extern void
+gst_tensor_filter_cache_clear (GstTensorFilterCache * cache);
+
+/**
+ * @brief Get the statistics of the cache.
+ */
+extern void
+gst_tensor_filter_cache_get_stats (GstTensorFilterCache * cache, GstTensorFilterCacheStats * stats);
+
+G_END_DECLS
+#endif /* __TENSOR_FILTER_CACHE_H__ */
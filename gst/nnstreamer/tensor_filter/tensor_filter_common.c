@@ -23,7 +23,16 @@
  *
  */
 
+#ifdef __linux__
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <sched.h>
+#endif
+#include <math.h>
+#include <stdio.h>
 #include <string.h>
+#include <glib/gstdio.h>
 
 #include <hw_accel.h>
 #include <nnstreamer_log.h>
@@ -126,6 +135,38 @@ enum
   PROP_OUTPUTCOMBINATION,
   PROP_SHARED_TENSOR_FILTER_KEY,
   PROP_LATENCY_REPORT,
+  PROP_WORKERS,
+  PROP_MAX_BATCH,
+  PROP_BATCH_TIMEOUT,
+  PROP_LATENCY_P50,
+  PROP_LATENCY_P90,
+  PROP_LATENCY_P99,
+  PROP_LATENCY_MAX,
+  PROP_STATS_INTERVAL,
+  PROP_SHARED_TENSOR_FILTER_INSTANCES,
+  PROP_RELOAD_ASYNC,
+  PROP_WARMUP,
+  PROP_CPU_AFFINITY,
+  PROP_THREAD_POOL,
+  PROP_NUMA_NODE,
+  PROP_DEVICE_MEMORY,
+  PROP_ACCL_SCHEDULE,
+  PROP_ACCL_PRIORITY,
+  PROP_ACCL_WEIGHT,
+  PROP_ACCL_LATENCY_BUDGET,
+  PROP_ACCL_UTILIZATION,
+  PROP_ACCL_SWITCH_HIGH,
+  PROP_ACCL_SWITCH_LOW,
+  PROP_SKIP_THRESHOLD,
+  PROP_SKIP_SAMPLE,
+  PROP_SKIP_MAX,
+  PROP_SKIP_RATE,
+  PROP_CACHE_SIZE,
+  PROP_CACHE_HIT_RATE,
+  PROP_DEADLINE,
+  PROP_CASCADE,
+  PROP_CASCADE_CONDITION,
+  PROP_CASCADE_DEPTH,
 };
 
 /**
@@ -545,6 +586,8 @@ gst_tensor_filter_properties_init (GstTensorFilterProperties * prop)
   gst_tensors_info_init (&prop->output_meta);
   gst_tensors_layout_init (prop->output_layout);
   gst_tensors_rank_init (prop->output_ranks);
+
+  prop->numa_node = -1;
 }
 
 /**
@@ -562,21 +605,251 @@ gst_tensor_filter_framework_info_init (GstTensorFilterFrameworkInfo * info)
   info->accl_auto = -1;
   info->accl_default = -1;
   info->statistics = NULL;
+  info->sparse_input = 0;
 }
 
 /**
- * @brief Initialize the GstTensorFilterFrameworkInfo object
+ * @brief Initialize the GstTensorFilterStatistics object
  */
 static void
 gst_tensor_filter_statistics_init (GstTensorFilterStatistics * stat)
 {
-  stat->total_invoke_num = 0;
-  stat->total_invoke_latency = 0;
-  stat->old_total_invoke_num = 0;
-  stat->old_total_invoke_latency = 0;
-  stat->latest_invoke_time = 0;
-  stat->recent_latencies = g_queue_new ();
+  memset (stat, 0, sizeof (GstTensorFilterStatistics));
   stat->latency_ignore_count = 1;
+  g_mutex_init (&stat->stats_lock);
+}
+
+/**
+ * @brief The sequence to assign the shard of statistics to the invoking threads.
+ */
+static gint stat_shard_seq = 0;
+
+/**
+ * @brief The shard index (+1) of statistics for the invoking thread.
+ */
+static GPrivate stat_shard_index = G_PRIVATE_INIT (NULL);
+
+/**
+ * @brief Get the shard of statistics for the current thread.
+ */
+static GstTensorFilterStatShard *
+gst_tensor_filter_statistics_get_shard (GstTensorFilterStatistics * stat)
+{
+  guint index = GPOINTER_TO_UINT (g_private_get (&stat_shard_index));
+
+  if (G_UNLIKELY (index == 0)) {
+    index = ((guint) g_atomic_int_add (&stat_shard_seq, 1)
+        % GST_TF_STAT_SHARDS) + 1;
+    g_private_set (&stat_shard_index, GUINT_TO_POINTER (index));
+  }
+
+  return &stat->shards[index - 1];
+}
+
+/**
+ * @brief Record the invoke latency (usec) in the statistics. This can be called from the concurrent invoking threads.
+ * @return FALSE if the latency is ignored (the first measurements).
+ */
+gboolean
+gst_tensor_filter_statistics_record (GstTensorFilterStatistics * stat,
+    gint64 latency)
+{
+  GstTensorFilterStatShard *shard;
+  gint ignore;
+  guint index;
+
+  g_return_val_if_fail (stat != NULL, FALSE);
+
+  /* ignore first measurements that may be off */
+  while ((ignore = g_atomic_int_get (&stat->latency_ignore_count)) > 0) {
+    if (g_atomic_int_compare_and_exchange (&stat->latency_ignore_count,
+            ignore, ignore - 1))
+      return FALSE;
+  }
+
+  if (latency < 0)
+    latency = 0;
+
+  shard = gst_tensor_filter_statistics_get_shard (stat);
+  g_atomic_pointer_add (&shard->invoke_num, 1);
+  g_atomic_pointer_add (&shard->invoke_latency, (gssize) latency);
+
+  /* ring buffer of the recent latencies */
+  index = (guint) g_atomic_int_add (&stat->recent_count, 1);
+  g_atomic_pointer_set (&stat->recent_latencies[index % GST_TF_STAT_MAX_RECENT],
+      (gssize) latency);
+
+  gst_tensor_filter_histogram_record (&stat->histogram, latency);
+  return TRUE;
+}
+
+/**
+ * @brief Get the snapshot of the statistics, aggregating the per-thread counters.
+ */
+void
+gst_tensor_filter_statistics_get_snapshot (GstTensorFilterStatistics * stat,
+    GstTensorFilterStatSnapshot * snapshot)
+{
+  guint i, num;
+
+  g_return_if_fail (stat != NULL);
+  g_return_if_fail (snapshot != NULL);
+
+  memset (snapshot, 0, sizeof (GstTensorFilterStatSnapshot));
+
+  for (i = 0; i < GST_TF_STAT_SHARDS; i++) {
+    snapshot->invoke_num += g_atomic_pointer_get (&stat->shards[i].invoke_num);
+    snapshot->invoke_latency +=
+        g_atomic_pointer_get (&stat->shards[i].invoke_latency);
+  }
+
+  num = MIN ((guint) g_atomic_int_get (&stat->recent_count),
+      GST_TF_STAT_MAX_RECENT);
+  if (num > 0) {
+    gint64 sum = 0;
+
+    for (i = 0; i < num; i++)
+      sum += g_atomic_pointer_get (&stat->recent_latencies[i]);
+    snapshot->recent_latency = sum / num;
+  } else {
+    snapshot->recent_latency = -1;
+  }
+
+  snapshot->latency_p50 =
+      gst_tensor_filter_histogram_get_percentile (&stat->histogram, 50.0);
+  snapshot->latency_p90 =
+      gst_tensor_filter_histogram_get_percentile (&stat->histogram, 90.0);
+  snapshot->latency_p99 =
+      gst_tensor_filter_histogram_get_percentile (&stat->histogram, 99.0);
+  snapshot->latency_max = (g_atomic_pointer_get (&stat->histogram.total) > 0) ?
+      (gint64) g_atomic_pointer_get (&stat->histogram.max) : -1;
+
+  if (snapshot->invoke_latency > 0)
+    snapshot->throughput = (gdouble) snapshot->invoke_num * G_USEC_PER_SEC /
+        snapshot->invoke_latency;
+}
+
+/**
+ * @brief Get the bucket index of the latency histogram.
+ */
+static guint
+gst_tensor_filter_histogram_index (guint64 value)
+{
+  guint magnitude, sub;
+
+  /* magnitude 0: exact values */
+  if (value < GST_TF_STAT_HIST_SUB_COUNT)
+    return (guint) value;
+
+  magnitude = g_bit_storage (value) - GST_TF_STAT_HIST_SUB_BITS;
+  if (magnitude >= GST_TF_STAT_HIST_MAGNITUDES)
+    return GST_TF_STAT_HIST_SIZE - 1;
+
+  sub = (guint) (value >> (magnitude - 1)) - GST_TF_STAT_HIST_SUB_COUNT;
+  return magnitude * GST_TF_STAT_HIST_SUB_COUNT + sub;
+}
+
+/**
+ * @brief Get the highest value in the bucket of the latency histogram.
+ */
+static guint64
+gst_tensor_filter_histogram_value (guint index)
+{
+  guint magnitude, sub;
+
+  magnitude = index / GST_TF_STAT_HIST_SUB_COUNT;
+  sub = index % GST_TF_STAT_HIST_SUB_COUNT;
+
+  if (magnitude == 0)
+    return sub;
+
+  return (((guint64) GST_TF_STAT_HIST_SUB_COUNT + sub + 1) << (magnitude - 1))
+      - 1;
+}
+
+/**
+ * @brief Record the latency (usec) in the histogram.
+ */
+void
+gst_tensor_filter_histogram_record (GstTensorFilterHistogram * hist,
+    gint64 latency)
+{
+  gssize max;
+
+  g_return_if_fail (hist != NULL);
+
+  if (latency < 0)
+    latency = 0;
+
+  g_atomic_pointer_add (&hist->counts[gst_tensor_filter_histogram_index ((guint64)
+              latency)], 1);
+  g_atomic_pointer_add (&hist->total, 1);
+
+  while ((max = g_atomic_pointer_get (&hist->max)) < latency) {
+    if (g_atomic_pointer_compare_and_exchange (&hist->max, max,
+            (gssize) latency))
+      break;
+  }
+}
+
+/**
+ * @brief Get the latency (usec) at the given percentile from the histogram.
+ * @return the latency, -1 if no latency is recorded.
+ */
+gint64
+gst_tensor_filter_histogram_get_percentile (const GstTensorFilterHistogram *
+    hist, gdouble percentile)
+{
+  /* the counters are updated concurrently, read them atomically */
+  GstTensorFilterHistogram *h = (GstTensorFilterHistogram *) hist;
+  guint64 target, total, count = 0;
+  gint64 max;
+  guint i;
+
+  g_return_val_if_fail (hist != NULL, -1);
+
+  total = g_atomic_pointer_get (&h->total);
+  if (total == 0)
+    return -1;
+
+  max = g_atomic_pointer_get (&h->max);
+
+  percentile = CLAMP (percentile, 0.0, 100.0);
+  target = (guint64) ceil (total * percentile / 100.0);
+  if (target == 0)
+    target = 1;
+
+  for (i = 0; i < GST_TF_STAT_HIST_SIZE; i++) {
+    count += g_atomic_pointer_get (&h->counts[i]);
+
+    if (count >= target)
+      return MIN ((gint64) gst_tensor_filter_histogram_value (i), max);
+  }
+
+  return max;
+}
+
+/**
+ * @brief Get the number of the latencies in the buckets of the histogram up to the given latency (usec).
+ */
+guint64
+gst_tensor_filter_histogram_get_count (const GstTensorFilterHistogram * hist,
+    gint64 latency)
+{
+  GstTensorFilterHistogram *h = (GstTensorFilterHistogram *) hist;
+  guint64 count = 0;
+  guint i;
+
+  g_return_val_if_fail (hist != NULL, 0);
+
+  for (i = 0; i < GST_TF_STAT_HIST_SIZE; i++) {
+    if (latency < 0 || gst_tensor_filter_histogram_value (i) > (guint64) latency)
+      break;
+
+    count += g_atomic_pointer_get (&h->counts[i]);
+  }
+
+  return count;
 }
 
 /**
@@ -802,14 +1075,27 @@ gst_tensor_filter_allocate_in_invoke (GstTensorFilterPrivate * priv)
 void
 gst_tensor_filter_destroy_notify_util (GstTensorFilterPrivate * priv,
     void *data)
+{
+  gst_tensor_filter_destroy_notify_util_full (priv, &priv->privateData, data);
+}
+
+/**
+ * @brief Free the data allocated for tensor filter output by the given instance of the framework
+ * @param[in] priv Struct containing the properties of the object
+ * @param[in] private_data The private data of framework instance which allocated the data
+ * @param[in] data Data to be freed
+ */
+void
+gst_tensor_filter_destroy_notify_util_full (GstTensorFilterPrivate * priv,
+    void **private_data, void *data)
 {
   GstTensorFilterFrameworkEventData event_data;
 
   if (GST_TF_FW_V0 (priv->fw) && priv->fw->destroyNotify) {
-    priv->fw->destroyNotify (&priv->privateData, data);
+    priv->fw->destroyNotify (private_data, data);
   } else if (GST_TF_FW_V1 (priv->fw)) {
     event_data.data = data;
-    if (priv->fw->eventHandler (priv->fw, &priv->prop, priv->privateData,
+    if (priv->fw->eventHandler (priv->fw, &priv->prop, *private_data,
             DESTROY_NOTIFY, &event_data) == -ENOENT) {
       g_free (data);
     }
@@ -818,6 +1104,179 @@ gst_tensor_filter_destroy_notify_util (GstTensorFilterPrivate * priv,
   }
 }
 
+/**
+ * @brief Get the per-op profile of the given instance of the framework
+ * @param[in] priv Struct containing the properties of the object
+ * @param[in] private_data The private data of framework instance
+ * @return Newly allocated profile text, NULL if the framework does not support the profile. Caller should free the value.
+ */
+gchar *
+gst_tensor_filter_get_profile (GstTensorFilterPrivate * priv,
+    void *private_data)
+{
+  GstTensorFilterFrameworkEventData event_data;
+  int ret = -ENOENT;
+
+  if (!priv->fw || !private_data)
+    return NULL;
+
+  event_data.instance = private_data;
+  event_data.profile = NULL;
+
+  if (GST_TF_FW_V0 (priv->fw) && priv->fw->handleEvent) {
+    ret = priv->fw->handleEvent (GET_PROFILE, &event_data);
+  } else if (GST_TF_FW_V1 (priv->fw)) {
+    ret = priv->fw->eventHandler (priv->fw, &priv->prop, private_data,
+        GET_PROFILE, &event_data);
+  }
+
+  if (ret != 0) {
+    g_free (event_data.profile);
+    return NULL;
+  }
+
+  return event_data.profile;
+}
+
+/**
+ * @brief Get the status of the compiled model cache of the given instance of the framework
+ * @param[in] priv Struct containing the properties of the object
+ * @param[in] private_data The private data of framework instance
+ * @param[out] hit TRUE if the compiled model is loaded from the cache
+ * @param[out] compile_time The time to compile or to load the compiled model (usec)
+ * @return TRUE if the framework uses the compiled model cache.
+ */
+gboolean
+gst_tensor_filter_get_model_cache (GstTensorFilterPrivate * priv,
+    void *private_data, gboolean * hit, gint64 * compile_time)
+{
+  GstTensorFilterFrameworkEventData event_data;
+  int ret = -ENOENT;
+
+  if (!priv->fw || !private_data)
+    return FALSE;
+
+  event_data.cache_instance = private_data;
+  event_data.cache_hit = -1;
+  event_data.compile_time = 0;
+
+  if (GST_TF_FW_V0 (priv->fw) && priv->fw->handleEvent) {
+    ret = priv->fw->handleEvent (GET_MODEL_CACHE, &event_data);
+  } else if (GST_TF_FW_V1 (priv->fw)) {
+    ret = priv->fw->eventHandler (priv->fw, &priv->prop, private_data,
+        GET_MODEL_CACHE, &event_data);
+  }
+
+  /* some frameworks return 0 for the events not handled */
+  if (ret != 0 || event_data.cache_hit < 0)
+    return FALSE;
+
+  *hit = (event_data.cache_hit != 0);
+  *compile_time = event_data.compile_time;
+  return TRUE;
+}
+
+/**
+ * @brief Call the event of the device memory with the given instance of the framework
+ */
+static int
+_gtfc_device_memory_event (GstTensorFilterPrivate * priv, void *private_data,
+    event_ops ops, GstTensorFilterFrameworkEventData * event_data)
+{
+  int ret = -ENOENT;
+
+  event_data->device_instance = private_data;
+
+  if (GST_TF_FW_V0 (priv->fw) && priv->fw->handleEvent) {
+    ret = priv->fw->handleEvent (ops, event_data);
+  } else if (GST_TF_FW_V1 (priv->fw)) {
+    ret = priv->fw->eventHandler (priv->fw, &priv->prop, private_data, ops,
+        event_data);
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Get the device memory supported by the given instance of the framework
+ * @param[in] priv Struct containing the properties of the object
+ * @param[in] private_data The private data of framework instance
+ * @param[out] ops The operations of the device memory
+ * @param[out] input TRUE if the input tensors in the device memory are accepted
+ * @param[out] output TRUE if the output tensors can be kept in the device memory
+ * @param[out] dmabuf TRUE if the input tensors in DMA-BUF are imported
+ * @return TRUE if the framework supports the device memory or DMA-BUF import.
+ * @note The out parameters are not changed if it is not supported. The operations are NULL if the framework imports DMA-BUF only.
+ */
+gboolean
+gst_tensor_filter_get_device_memory (GstTensorFilterPrivate * priv,
+    void *private_data, const GstTensorDeviceOps ** ops, gboolean * input,
+    gboolean * output, gboolean * dmabuf)
+{
+  GstTensorFilterFrameworkEventData event_data;
+  int ret;
+
+  if (!priv->fw || !private_data)
+    return FALSE;
+
+  event_data.device_ops = NULL;
+  event_data.device_input = 0;
+  event_data.device_output = 0;
+  event_data.dmabuf_input = 0;
+  event_data.dmabuf = NULL;
+
+  ret = _gtfc_device_memory_event (priv, private_data, GET_DEVICE_MEMORY,
+      &event_data);
+
+  /* some frameworks return 0 for the events not handled */
+  if (ret != 0)
+    return FALSE;
+
+  if (event_data.device_ops != NULL &&
+      event_data.device_ops->type == NNS_TENSOR_MEMORY_HOST)
+    event_data.device_ops = NULL;
+
+  if (event_data.device_ops == NULL && event_data.dmabuf_input == 0)
+    return FALSE;
+
+  *ops = event_data.device_ops;
+  *input = (event_data.device_ops != NULL && event_data.device_input != 0);
+  /* the device output is released with DESTROY_NOTIFY */
+  *output = (event_data.device_ops != NULL && event_data.device_output != 0 &&
+      gst_tensor_filter_allocate_in_invoke (priv));
+  *dmabuf = (event_data.dmabuf_input != 0);
+  return TRUE;
+}
+
+/**
+ * @brief Set the memory of the tensors of the next invoke of the given instance of the framework
+ * @param[in] priv Struct containing the properties of the object
+ * @param[in] private_data The private data of framework instance
+ * @param[in] input TRUE if the data of the input tensors is the device memory
+ * @param[in] output TRUE if the output tensors should be kept in the device memory
+ * @param[in] dmabuf The DMA-BUF of the input tensors, NULL if the input tensors are not given in DMA-BUF
+ * @return TRUE if the framework accepts the setting.
+ */
+gboolean
+gst_tensor_filter_set_device_memory (GstTensorFilterPrivate * priv,
+    void *private_data, gboolean input, gboolean output,
+    const GstTensorDmaBuf * dmabuf)
+{
+  GstTensorFilterFrameworkEventData event_data;
+
+  if (!priv->fw || !private_data)
+    return FALSE;
+
+  event_data.device_ops = priv->device_ops;
+  event_data.device_input = input ? 1 : 0;
+  event_data.device_output = output ? 1 : 0;
+  event_data.dmabuf_input = dmabuf ? 1 : 0;
+  event_data.dmabuf = dmabuf;
+
+  return (_gtfc_device_memory_event (priv, private_data, SET_DEVICE_MEMORY,
+          &event_data) == 0);
+}
+
 /**
  * @brief Printout the comparison results of two tensors as a string.
  * @param[in] info1 The tensors to be shown on the left hand side
@@ -1006,10 +1465,213 @@ gst_tensor_filter_install_properties (GObjectClass * gobject_class)
           "to declare and share such instances. "
           "If it is NULL, it means the model representations is not shared.",
           NULL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class,
+      PROP_SHARED_TENSOR_FILTER_INSTANCES,
+      g_param_spec_uint ("shared-tensor-filter-instances",
+          "The number of instances of shared model representation",
+          "The number of framework instances (e.g., interpreters) created "
+          "over the single model of \"shared-tensor-filter-key\". "
+          "The element instances sharing the key lease an idle instance per invoke, "
+          "so that they may run concurrently without loading the model again. "
+          "The value of the element creating the shared model is applied.",
+          1, 256, 1, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
   g_object_class_install_property (gobject_class, PROP_LATENCY_REPORT,
       g_param_spec_boolean ("latency-report", "Latency report",
           "Report to the pipeline the estimated tensor-filter element latency.",
           FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_WORKERS,
+      g_param_spec_uint ("workers", "Number of workers",
+          "The number of framework instances to invoke the model concurrently. "
+          "If it is larger than 1, tensor-filter opens the given number of "
+          "instances and dispatches incoming frames to the worker threads. "
+          "The output buffers are pushed in the order of incoming frames. "
+          "This is applied when the element starts.",
+          1, GST_TF_MAX_WORKERS, 1, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_MAX_BATCH,
+      g_param_spec_uint ("max-batch", "Max batch",
+          "The maximum number of frames to be packed along the outermost "
+          "dimension and invoked at once. If it is larger than 1, the tensor "
+          "information of the model is the batched one and the input/output "
+          "streams carry a single frame (the outermost dimension divided by "
+          "max-batch).", 1, G_MAXUINT16, 1,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_BATCH_TIMEOUT,
+      g_param_spec_uint64 ("batch-timeout", "Batch timeout",
+          "The maximum time (usec) to wait for the frames to fill a batch. "
+          "When it expires, the incomplete batch is invoked with zero-padded "
+          "frames. 0 means waiting until the batch is full (or EOS).",
+          0, G_MAXUINT64, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY_P50,
+      g_param_spec_int64 ("latency-p50", "Median latency",
+          "The median (50th percentile) invoke latency in microseconds. "
+          "Turn on the property latency to get the value, -1 if not available.",
+          -1, G_MAXINT64, -1, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY_P90,
+      g_param_spec_int64 ("latency-p90", "90th percentile latency",
+          "The 90th percentile invoke latency in microseconds. "
+          "Turn on the property latency to get the value, -1 if not available.",
+          -1, G_MAXINT64, -1, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY_P99,
+      g_param_spec_int64 ("latency-p99", "99th percentile latency",
+          "The 99th percentile invoke latency in microseconds. "
+          "Turn on the property latency to get the value, -1 if not available.",
+          -1, G_MAXINT64, -1, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY_MAX,
+      g_param_spec_int64 ("latency-max", "Max latency",
+          "The max invoke latency in microseconds. "
+          "Turn on the property latency to get the value, -1 if not available.",
+          -1, G_MAXINT64, -1, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_STATS_INTERVAL,
+      g_param_spec_uint ("stats-interval", "Statistics interval",
+          "The interval in milliseconds to post the element message "
+          "'tensor-filter-stats' with the latency percentiles and throughput "
+          "to the bus. 0 means no message.",
+          0, G_MAXUINT, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_RELOAD_ASYNC,
+      g_param_spec_boolean ("reload-async", "Reload the model asynchronously",
+          "If TRUE with is-updatable, the updated model is loaded and warmed up "
+          "in a new framework instance in the background, and the instance is "
+          "switched between invokes. The message 'tensor-filter-reload' is "
+          "posted to the bus when the reload is done.",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_WARMUP,
+      g_param_spec_uint ("warmup", "Warm-up invokes",
+          "The number of invokes with zero-filled tensors to warm up the model "
+          "(e.g., lazy allocation, kernel selection and JIT compilation) "
+          "before the first frame. 0 means no warm-up.",
+          0, G_MAXUINT, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CPU_AFFINITY,
+      g_param_spec_string ("cpu-affinity", "CPU affinity",
+          "The list of CPU cores (e.g., 0-3,6) to run the invoke. "
+          "The invoking thread is pinned to the cores, and the list is "
+          "forwarded to the framework for its threads. Empty for no affinity.",
+          "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_THREAD_POOL,
+      g_param_spec_uint ("thread-pool", "Framework thread pool",
+          "The number of threads for the thread pool of the framework "
+          "(e.g., the intra-op threads of an interpreter). "
+          "0 means the default of the framework. "
+          "The option of the framework given by custom property precedes this.",
+          0, 256, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_NUMA_NODE,
+      g_param_spec_int ("numa-node", "NUMA node",
+          "The NUMA node to run the invoke and to allocate the output tensors. "
+          "The invoking thread is pinned to the CPUs of the node if cpu-affinity "
+          "is not given, and the tensor allocator binds the memory allocated "
+          "in the thread to the node. -1 for no NUMA placement.",
+          -1, 63, -1, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_DEVICE_MEMORY,
+      g_param_spec_boolean ("device-memory", "Keep the outputs in device memory",
+          "If TRUE and the framework supports it (e.g., CUDA memory of "
+          "TensorRT), the output tensors stay in the device memory, and the "
+          "next filter on the same device takes them without the copy to host "
+          "memory. The other elements read the tensors in host memory as usual. "
+          "The input tensors in the device memory are always accepted.",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_ACCL_SCHEDULE,
+      g_param_spec_boolean ("accl-schedule", "Schedule the accelerator",
+          "If TRUE, the invokes on the accelerator (GPU or NPU) are queued "
+          "with the other filters in the process using the same accelerator, "
+          "with accl-priority and accl-weight. "
+          "This is applied when the element starts.",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_ACCL_PRIORITY,
+      g_param_spec_int ("accl-priority", "Accelerator priority",
+          "The priority of the invokes on the shared accelerator, "
+          "the higher goes first (accl-schedule).",
+          -100, 100, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_ACCL_WEIGHT,
+      g_param_spec_uint ("accl-weight", "Accelerator weight",
+          "The share of the accelerator among the filters of the same "
+          "priority (accl-schedule).",
+          1, 1000, 1, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_ACCL_LATENCY_BUDGET,
+      g_param_spec_uint64 ("accl-latency-budget", "Accelerator latency budget",
+          "The maximum time (usec) to wait for the shared accelerator. "
+          "If the estimated wait exceeds it, the frame is invoked with the "
+          "instance of the framework on CPU (if the framework supports CPU). "
+          "0 means waiting for the accelerator (accl-schedule).",
+          0, G_MAXUINT64, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_ACCL_UTILIZATION,
+      g_param_spec_double ("accl-utilization", "Accelerator utilization",
+          "The ratio of the time the shared accelerator is busy (0 to 1), "
+          "-1 if the accelerator is not scheduled (accl-schedule).",
+          -1.0, 1.0, -1.0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_ACCL_SWITCH_HIGH,
+      g_param_spec_uint64 ("accl-switch-high", "Accelerator switch high",
+          "If the average invoke latency (usec) on the accelerator exceeds it, "
+          "the model is switched to the next accelerator given in "
+          "'accelerator' (e.g., true:npu,gpu,cpu). 0 means not switching.",
+          0, G_MAXUINT64, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_ACCL_SWITCH_LOW,
+      g_param_spec_uint64 ("accl-switch-low", "Accelerator switch low",
+          "The model goes back to the preferred accelerator when its latency "
+          "(usec, halved every second since it is left) is below it. "
+          "0 means the half of accl-switch-high.",
+          0, G_MAXUINT64, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_SKIP_THRESHOLD,
+      g_param_spec_double ("skip-threshold", "Skip threshold",
+          "If the mean absolute difference per element of the input tensors "
+          "from the latest invoked frame is less than the threshold, the "
+          "invoke is skipped and the previous output is pushed with the "
+          "timestamps of the frame. The input tensors of uint8 and float32 "
+          "are compared. 0 invokes all frames.",
+          0.0, G_MAXDOUBLE, 0.0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_SKIP_SAMPLE,
+      g_param_spec_uint ("skip-sample", "Skip sample",
+          "Compare 1 of N blocks (64 bytes) of the input tensors, "
+          "1 compares all data (skip-threshold).",
+          1, 1024, 4, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_SKIP_MAX,
+      g_param_spec_uint ("skip-max", "Skip max",
+          "The maximum number of the consecutive frames skipped, "
+          "0 means no limit (skip-threshold).",
+          0, G_MAXUINT, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_SKIP_RATE,
+      g_param_spec_double ("skip-rate", "Skip rate",
+          "The ratio of the frames skipped without the invoke (skip-threshold).",
+          0.0, 1.0, 0.0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CACHE_SIZE,
+      g_param_spec_uint64 ("cache-size", "Cache size",
+          "The maximum bytes of the outputs cached with the hash of the input "
+          "tensors. If the same input tensors are given again, the cached "
+          "output is pushed without the invoke, and the least recently used "
+          "outputs are evicted. 0 disables the cache. "
+          "This is applied when the element starts.",
+          0, G_MAXUINT64, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CACHE_HIT_RATE,
+      g_param_spec_double ("cache-hit-rate", "Cache hit rate",
+          "The ratio of the frames given by the cached outputs (0 to 1), "
+          "-1 if the cache is not used (cache-size).",
+          -1.0, 1.0, -1.0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_DEADLINE,
+      g_param_spec_uint64 ("deadline", "Deadline",
+          "The time (usec) after the running time of the frame to get the "
+          "output. The frame is dropped without the invoke if the current "
+          "running time of the clock plus the average invoke time exceeds "
+          "the deadline, or if downstream has reported with the QoS event "
+          "that the frame is late. 0 invokes all frames.",
+          0, G_MAXUINT64, 0, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CASCADE,
+      g_param_spec_string ("cascade", "Cascade",
+          "The models invoked in order after the model, separated by ';' "
+          "(the files of a model are separated by ','). If the outputs of a "
+          "model do not satisfy the cascade-condition, the next model is "
+          "invoked with the same input, and the outputs of the first "
+          "confident model (or the last model) are pushed. The models should "
+          "have the same tensors info. This is applied when the element starts.",
+          "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CASCADE_CONDITION,
+      g_param_spec_string ("cascade-condition", "Cascade condition",
+          "The condition of the confident outputs, the properties of tensor_if "
+          "separated by spaces (e.g., \"compared-value=TENSOR_AVERAGE_VALUE "
+          "compared-value-option=0 operator=GE supplied-value=0.8\"), "
+          "evaluated with the output tensors of the filter (cascade).",
+          "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CASCADE_DEPTH,
+      g_param_spec_double ("cascade-depth", "Cascade depth",
+          "The average number of the models invoked for a frame (cascade).",
+          0.0, G_MAXDOUBLE, 0.0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 }
 
 /**
@@ -1029,8 +1691,16 @@ gst_tensor_filter_common_init_property (GstTensorFilterPrivate * priv)
   /* set default framework 'auto' */
   priv->prop.fwname = g_strdup ("auto");
 
+  priv->prop.shared_tensor_filter_instances = 1;
+
   /* init internal properties */
   priv->silent = TRUE;
+  priv->num_workers = 1;
+  priv->max_batch = 1;
+  priv->batch_timeout = 0;
+  priv->stats_interval = 0;
+  priv->accl_weight = 1;
+  priv->skip_sample = 4;
   gst_tensors_config_init (&priv->in_config);
   gst_tensors_config_init (&priv->out_config);
 }
@@ -1049,6 +1719,9 @@ gst_tensor_filter_common_free_property (GstTensorFilterPrivate * priv)
   g_free_const (prop->accl_str);
   g_free (prop->hw_list);
   g_free (prop->shared_tensor_filter_key);
+  g_free_const (prop->cpu_affinity);
+  g_free (priv->cascade);
+  g_free (priv->cascade_condition);
 
   g_free_const (prop->custom_properties);
   g_strfreev_const (prop->model_files);
@@ -1059,18 +1732,12 @@ gst_tensor_filter_common_free_property (GstTensorFilterPrivate * priv)
   gst_tensors_config_free (&priv->in_config);
   gst_tensors_config_free (&priv->out_config);
 
+  g_mutex_clear (&priv->stat.stats_lock);
+
   g_list_free (priv->combi.in_combi);
   g_list_free (priv->combi.out_combi_i);
   g_list_free (priv->combi.out_combi_o);
 
-  if (priv->stat.recent_latencies != NULL) {
-    GQueue *queue = priv->stat.recent_latencies;
-    gint64 *latency;
-    while ((latency = g_queue_pop_tail (queue)) != NULL)
-      g_free (latency);
-    g_queue_free (queue);
-  }
-
   G_LOCK (shared_model_table);
   if (shared_model_table) {
     GstTensorFilterSharedModelRepresenatation *rep;
@@ -1195,6 +1862,44 @@ _detect_framework_from_config (const gchar * extension)
   return detected;
 }
 
+/**
+ * @brief Get available framework from the magic bytes of model file.
+ * @details This reads the header of model file only, and does not load any framework.
+ */
+static gchar *
+_detect_framework_from_magic (const gchar * model_file)
+{
+  guint8 header[8] = { 0 };
+  gchar *detected = NULL;
+  FILE *fp;
+  gsize len;
+
+  fp = g_fopen (model_file, "rb");
+  if (fp == NULL)
+    return NULL;
+
+  len = fread (header, 1, sizeof (header), fp);
+  fclose (fp);
+
+  if (len < sizeof (header))
+    return NULL;
+
+  /* flatbuffers file identifier at offset 4 */
+  if (memcmp (header + 4, "TFL3", 4) == 0)
+    detected = g_strdup ("tensorflow-lite");
+  else if (memcmp (header + 4, "CIR0", 4) == 0)
+    detected = g_strdup ("nnfw");
+  /* torchscript model is a zip archive */
+  else if (memcmp (header, "PK\x03\x04", 4) == 0)
+    detected = g_strdup ("pytorch");
+
+  if (detected)
+    nns_logi ("Detected framework is %s with the magic bytes of %s.", detected,
+        model_file);
+
+  return detected;
+}
+
 /**
  * @brief Get neural network framework name from given model file. This does not guarantee the framework is available on the target device.
  * @param[in] model_files the prediction model paths
@@ -1227,8 +1932,15 @@ gst_tensor_filter_detect_framework (const gchar * const *model_files,
    */
   ext = g_malloc0 (sizeof (char *) * (num_models + 1));
   for (i = 0; i < num_models; i++) {
-    if ((pos = strrchr (model_files[i], '.')) == NULL) {
-      nns_logw ("Given model file %s has invalid extension.", model_files[i]);
+    if ((pos = strrchr (model_files[i], '.')) == NULL ||
+        strchr (pos, G_DIR_SEPARATOR) != NULL) {
+      /* Check the magic bytes if the model file does not have the extension */
+      if (num_models == 1)
+        detected_fw = _detect_framework_from_magic (model_files[0]);
+
+      if (!detected_fw)
+        nns_logw ("Given model file %s has invalid extension.",
+            model_files[i]);
       goto done;
     }
 
@@ -1884,6 +2596,150 @@ _gtfc_setprop_OUTPUTCOMBINATION (GstTensorFilterPrivate * priv,
   return ret;
 }
 
+/**
+ * @brief Parse the list of CPU cores (e.g., "0-3,6").
+ * @return The array of core index (guint). NULL if the list is invalid. Caller should free the array.
+ */
+static GArray *
+gst_tensor_filter_parse_cpu_list (const gchar * cpus)
+{
+  GArray *cores;
+  gchar **items;
+  guint i, num, first, last, c;
+  gchar *end;
+
+  if (!cpus || cpus[0] == '\0')
+    return NULL;
+
+  cores = g_array_new (FALSE, FALSE, sizeof (guint));
+  items = g_strsplit (cpus, ",", -1);
+  num = g_strv_length (items);
+
+  for (i = 0; i < num; i++) {
+    g_strstrip (items[i]);
+
+    first = (guint) g_ascii_strtoull (items[i], &end, 10);
+    if (end == items[i])
+      goto error;
+
+    last = first;
+    if (*end == '-') {
+      gchar *range = end + 1;
+
+      last = (guint) g_ascii_strtoull (range, &end, 10);
+      if (end == range || last < first)
+        goto error;
+    }
+
+    if (*end != '\0')
+      goto error;
+
+    for (c = first; c <= last; c++)
+      g_array_append_val (cores, c);
+  }
+
+  g_strfreev (items);
+  return cores;
+
+error:
+  nns_logw ("Invalid list of CPU cores '%s', e.g., 0-3,6.", cpus);
+  g_strfreev (items);
+  g_array_free (cores, TRUE);
+  return NULL;
+}
+
+/**
+ * @brief Get the list of CPU cores of the NUMA node.
+ * @return Newly allocated string (e.g., "0-15,32-47"), NULL if the node is not found.
+ */
+static gchar *
+gst_tensor_filter_get_numa_cpus (gint node)
+{
+  gchar *path, *cpus = NULL;
+
+  path = g_strdup_printf ("/sys/devices/system/node/node%d/cpulist", node);
+  if (!g_file_get_contents (path, &cpus, NULL, NULL)) {
+    nns_logw ("Cannot find the CPUs of the NUMA node %d.", node);
+    cpus = NULL;
+  } else {
+    g_strstrip (cpus);
+  }
+
+  g_free (path);
+  return cpus;
+}
+
+/**
+ * @brief Set the CPU affinity (property cpu-affinity, or the CPUs of property numa-node) and the NUMA node of the memory allocated in the calling thread.
+ * @return TRUE if the affinity is set or not given.
+ */
+gboolean
+gst_tensor_filter_common_set_cpu_affinity (GstTensorFilterPrivate * priv)
+{
+  const gchar *cpus = priv->prop.cpu_affinity;
+#ifdef __linux__
+  cpu_set_t set;
+  GArray *cores;
+  guint i, c;
+
+  if (priv->prop.numa_node >= 0)
+    gst_tensor_alloc_set_thread_node (priv->prop.numa_node);
+
+  if (!cpus)
+    return (priv->prop.numa_node < 0);
+
+  cores = gst_tensor_filter_parse_cpu_list (cpus);
+  if (!cores)
+    return FALSE;
+
+  CPU_ZERO (&set);
+  for (i = 0; i < cores->len; i++) {
+    c = g_array_index (cores, guint, i);
+    if (c < CPU_SETSIZE)
+      CPU_SET (c, &set);
+  }
+  g_array_free (cores, TRUE);
+
+  /* 0 means the calling thread */
+  if (sched_setaffinity (0, sizeof (cpu_set_t), &set) != 0) {
+    nns_logw ("Failed to set the CPU affinity (%s): %s", cpus,
+        g_strerror (errno));
+    return FALSE;
+  }
+
+  return TRUE;
+#else
+  if (!cpus)
+    return TRUE;
+
+  nns_logw ("Setting the CPU affinity is not supported on this platform.");
+  return FALSE;
+#endif
+}
+
+/** @brief Handle "PROP_CPU_AFFINITY" for set-property */
+static gint
+_gtfc_setprop_CPU_AFFINITY (GstTensorFilterProperties * prop,
+    const GValue * value)
+{
+  const gchar *cpus = g_value_get_string (value);
+  GArray *cores;
+
+  g_free_const (prop->cpu_affinity);
+  prop->cpu_affinity = NULL;
+
+  if (!cpus || cpus[0] == '\0')
+    return 0;
+
+  cores = gst_tensor_filter_parse_cpu_list (cpus);
+  if (!cores)
+    return -EINVAL;
+
+  g_array_free (cores, TRUE);
+  prop->cpu_affinity = g_strdup (cpus);
+  return 0;
+}
+
 /** @brief Handle "PROP_SHARED_TENSOR_FILTER_KEY" for set-property */
 static gint
 _gtfc_setprop_SHARED_TENSOR_FILTER_KEY (GstTensorFilterProperties * prop,
@@ -1982,9 +2838,88 @@ gst_tensor_filter_common_set_property (GstTensorFilterPrivate * priv,
     case PROP_SHARED_TENSOR_FILTER_KEY:
       status = _gtfc_setprop_SHARED_TENSOR_FILTER_KEY (prop, value);
       break;
+    case PROP_SHARED_TENSOR_FILTER_INSTANCES:
+      prop->shared_tensor_filter_instances = g_value_get_uint (value);
+      break;
+    case PROP_RELOAD_ASYNC:
+      priv->reload_async = g_value_get_boolean (value);
+      break;
+    case PROP_WARMUP:
+      priv->warmup = g_value_get_uint (value);
+      break;
+    case PROP_CPU_AFFINITY:
+      status = _gtfc_setprop_CPU_AFFINITY (prop, value);
+      break;
+    case PROP_THREAD_POOL:
+      prop->num_threads = (int) g_value_get_uint (value);
+      break;
+    case PROP_NUMA_NODE:
+      prop->numa_node = g_value_get_int (value);
+      break;
+    case PROP_DEVICE_MEMORY:
+      priv->device_memory = g_value_get_boolean (value);
+      break;
+    case PROP_ACCL_SCHEDULE:
+      priv->accl_schedule = g_value_get_boolean (value);
+      break;
+    case PROP_ACCL_PRIORITY:
+      priv->accl_priority = g_value_get_int (value);
+      break;
+    case PROP_ACCL_WEIGHT:
+      priv->accl_weight = g_value_get_uint (value);
+      break;
+    case PROP_ACCL_LATENCY_BUDGET:
+      priv->accl_latency_budget = g_value_get_uint64 (value);
+      break;
+    case PROP_ACCL_SWITCH_HIGH:
+      priv->accl_switch_high = g_value_get_uint64 (value);
+      break;
+    case PROP_ACCL_SWITCH_LOW:
+      priv->accl_switch_low = g_value_get_uint64 (value);
+      break;
+    case PROP_SKIP_THRESHOLD:
+      priv->skip_threshold = g_value_get_double (value);
+      break;
+    case PROP_SKIP_SAMPLE:
+      priv->skip_sample = g_value_get_uint (value);
+      break;
+    case PROP_SKIP_MAX:
+      priv->skip_max = g_value_get_uint (value);
+      break;
+    case PROP_CACHE_SIZE:
+      priv->cache_size = g_value_get_uint64 (value);
+      break;
+    case PROP_DEADLINE:
+      priv->deadline = g_value_get_uint64 (value);
+      break;
+    case PROP_CASCADE:
+      g_free (priv->cascade);
+      priv->cascade = g_value_dup_string (value);
+      break;
+    case PROP_CASCADE_CONDITION:
+      g_free (priv->cascade_condition);
+      priv->cascade_condition = g_value_dup_string (value);
+      break;
     case PROP_LATENCY_REPORT:
       priv->latency_reporting = g_value_get_boolean (value);
       break;
+    case PROP_WORKERS:
+      priv->num_workers = g_value_get_uint (value);
+      break;
+    case PROP_MAX_BATCH:
+      if (priv->prop.input_configured || priv->prop.output_configured) {
+        ml_logw
+            ("Cannot change max-batch after the tensor info of the model is configured.");
+        break;
+      }
+      priv->max_batch = g_value_get_uint (value);
+      break;
+    case PROP_BATCH_TIMEOUT:
+      priv->batch_timeout = g_value_get_uint64 (value);
+      break;
+    case PROP_STATS_INTERVAL:
+      priv->stats_interval = g_value_get_uint (value);
+      break;
     default:
       return FALSE;
   }
@@ -2161,7 +3096,7 @@ gst_tensor_filter_common_get_property (GstTensorFilterPrivate * priv,
       break;
     case PROP_LATENCY:
       if (priv->latency_mode == 1) {
-        g_value_set_int (value, prop->latency);
+        g_value_set_int (value, g_atomic_int_get (&prop->latency));
       } else {
         /* invalid */
         g_value_set_int (value, -1);
@@ -2169,7 +3104,7 @@ gst_tensor_filter_common_get_property (GstTensorFilterPrivate * priv,
       break;
     case PROP_THROUGHPUT:
       if (priv->throughput_mode == 1) {
-        g_value_set_int (value, prop->throughput);
+        g_value_set_int (value, g_atomic_int_get (&prop->throughput));
       } else {
         /* invalid */
         g_value_set_int (value, -1);
@@ -2187,9 +3122,138 @@ gst_tensor_filter_common_get_property (GstTensorFilterPrivate * priv,
       else
         g_value_set_string (value, "");
       break;
+    case PROP_SHARED_TENSOR_FILTER_INSTANCES:
+      g_value_set_uint (value, prop->shared_tensor_filter_instances);
+      break;
+    case PROP_RELOAD_ASYNC:
+      g_value_set_boolean (value, priv->reload_async);
+      break;
+    case PROP_WARMUP:
+      g_value_set_uint (value, priv->warmup);
+      break;
+    case PROP_CPU_AFFINITY:
+      g_value_set_string (value, prop->cpu_affinity ? prop->cpu_affinity : "");
+      break;
+    case PROP_THREAD_POOL:
+      g_value_set_uint (value, (guint) prop->num_threads);
+      break;
+    case PROP_NUMA_NODE:
+      g_value_set_int (value, prop->numa_node);
+      break;
+    case PROP_DEVICE_MEMORY:
+      g_value_set_boolean (value, priv->device_memory);
+      break;
+    case PROP_ACCL_SCHEDULE:
+      g_value_set_boolean (value, priv->accl_schedule);
+      break;
+    case PROP_ACCL_PRIORITY:
+      g_value_set_int (value, priv->accl_priority);
+      break;
+    case PROP_ACCL_WEIGHT:
+      g_value_set_uint (value, priv->accl_weight);
+      break;
+    case PROP_ACCL_LATENCY_BUDGET:
+      g_value_set_uint64 (value, priv->accl_latency_budget);
+      break;
+    case PROP_ACCL_SWITCH_HIGH:
+      g_value_set_uint64 (value, priv->accl_switch_high);
+      break;
+    case PROP_ACCL_SWITCH_LOW:
+      g_value_set_uint64 (value, priv->accl_switch_low);
+      break;
+    case PROP_ACCL_UTILIZATION:
+    {
+      GstTensorFilterSchedStats stats;
+
+      if (priv->sched_client) {
+        gst_tensor_filter_scheduler_get_stats (priv->sched_client, &stats);
+        g_value_set_double (value, stats.utilization);
+      } else {
+        g_value_set_double (value, -1.0);
+      }
+      break;
+    }
+    case PROP_SKIP_THRESHOLD:
+      g_value_set_double (value, priv->skip_threshold);
+      break;
+    case PROP_SKIP_SAMPLE:
+      g_value_set_uint (value, priv->skip_sample);
+      break;
+    case PROP_SKIP_MAX:
+      g_value_set_uint (value, priv->skip_max);
+      break;
+    case PROP_SKIP_RATE:
+      g_value_set_double (value, (priv->skip_frames > 0) ?
+          (gdouble) priv->skip_num / priv->skip_frames : 0.0);
+      break;
+    case PROP_CACHE_SIZE:
+      g_value_set_uint64 (value, priv->cache_size);
+      break;
+    case PROP_DEADLINE:
+      g_value_set_uint64 (value, priv->deadline);
+      break;
+    case PROP_CASCADE:
+      g_value_set_string (value, priv->cascade ? priv->cascade : "");
+      break;
+    case PROP_CASCADE_CONDITION:
+      g_value_set_string (value,
+          priv->cascade_condition ? priv->cascade_condition : "");
+      break;
+    case PROP_CASCADE_DEPTH:
+      g_value_set_double (value, (priv->cascade_frames > 0) ?
+          (gdouble) priv->cascade_invokes / priv->cascade_frames : 0.0);
+      break;
+    case PROP_CACHE_HIT_RATE:
+    {
+      GstTensorFilterCacheStats stats;
+
+      if (priv->cache) {
+        gst_tensor_filter_cache_get_stats (priv->cache, &stats);
+        g_value_set_double (value, (stats.hits + stats.misses > 0) ?
+            (gdouble) stats.hits / (stats.hits + stats.misses) : 0.0);
+      } else {
+        g_value_set_double (value, -1.0);
+      }
+      break;
+    }
     case PROP_LATENCY_REPORT:
       g_value_set_boolean (value, priv->latency_reporting);
       break;
+    case PROP_WORKERS:
+      g_value_set_uint (value, priv->num_workers);
+      break;
+    case PROP_MAX_BATCH:
+      g_value_set_uint (value, priv->max_batch);
+      break;
+    case PROP_BATCH_TIMEOUT:
+      g_value_set_uint64 (value, priv->batch_timeout);
+      break;
+    case PROP_LATENCY_P50:
+      g_value_set_int64 (value,
+          gst_tensor_filter_histogram_get_percentile (&priv->stat.histogram,
+              50.0));
+      break;
+    case PROP_LATENCY_P90:
+      g_value_set_int64 (value,
+          gst_tensor_filter_histogram_get_percentile (&priv->stat.histogram,
+              90.0));
+      break;
+    case PROP_LATENCY_P99:
+      g_value_set_int64 (value,
+          gst_tensor_filter_histogram_get_percentile (&priv->stat.histogram,
+              99.0));
+      break;
+    case PROP_LATENCY_MAX:
+    {
+      GstTensorFilterStatSnapshot snapshot;
+
+      gst_tensor_filter_statistics_get_snapshot (&priv->stat, &snapshot);
+      g_value_set_int64 (value, snapshot.latency_max);
+      break;
+    }
+    case PROP_STATS_INTERVAL:
+      g_value_set_uint (value, priv->stats_interval);
+      break;
     default:
       /* unknown property */
       return FALSE;
@@ -2299,6 +3363,81 @@ error:
   return FALSE;
 }
 
+/**
+ * @brief Get the tensor info of a single frame from the batched tensor info of the model.
+ * @details The outermost dimension of each batched tensor is divided by max-batch.
+ * @return FALSE if the batched info cannot be split into max-batch frames.
+ */
+gboolean
+gst_tensor_filter_common_get_frame_info (GstTensorFilterPrivate * priv,
+    const GstTensorsInfo * batched, GstTensorsInfo * frame)
+{
+  guint i, rank, batch;
+
+  g_return_val_if_fail (batched != NULL, FALSE);
+  g_return_val_if_fail (frame != NULL, FALSE);
+
+  gst_tensors_info_copy (frame, batched);
+
+  batch = priv->max_batch;
+  if (batch <= 1)
+    return TRUE;
+
+  for (i = 0; i < frame->num_tensors; i++) {
+    rank = gst_tensor_info_get_rank (&frame->info[i]);
+
+    if (frame->info[i].dimension[rank - 1] % batch != 0) {
+      nns_loge
+          ("The outermost dimension (%u) of the %u-th tensor cannot be split into %u frames. Please check the property max-batch and the input/output dimension of the model.",
+          frame->info[i].dimension[rank - 1], i, batch);
+      gst_tensors_info_free (frame);
+      return FALSE;
+    }
+
+    frame->info[i].dimension[rank - 1] /= batch;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Get the batched tensor info for the model from the tensor info of a single frame.
+ * @details max-batch is appended as the outermost dimension of each tensor, the inverse of gst_tensor_filter_common_get_frame_info().
+ * @return FALSE if the rank of a tensor exceeds the limit.
+ */
+gboolean
+gst_tensor_filter_common_get_batched_info (GstTensorFilterPrivate * priv,
+    const GstTensorsInfo * frame, GstTensorsInfo * batched)
+{
+  guint i, rank, batch;
+
+  g_return_val_if_fail (frame != NULL, FALSE);
+  g_return_val_if_fail (batched != NULL, FALSE);
+
+  gst_tensors_info_copy (batched, frame);
+
+  batch = priv->max_batch;
+  if (batch <= 1)
+    return TRUE;
+
+  for (i = 0; i < batched->num_tensors; i++) {
+    rank = gst_tensor_info_get_rank (&batched->info[i]);
+
+    if (rank >= NNS_TENSOR_RANK_LIMIT) {
+      nns_loge
+          ("The rank of the %u-th tensor is %u, cannot append the batch dimension.",
+          i, rank);
+      gst_tensors_info_free (batched);
+      return FALSE;
+    }
+
+    /* the frame is supposed to have a batch dimension 1 (e.g., 3:224:224:1) */
+    batched->info[i].dimension[rank] = batch;
+  }
+
+  return TRUE;
+}
+
 /**
  * @brief Get output tensor info from NN model with given input info.
  */
@@ -2424,6 +3563,12 @@ gst_tensor_filter_common_open_fw (GstTensorFilterPrivate * priv)
   if (!priv->prop.fw_opened && priv->fw) {
     gint64 start_time, end_time;
     start_time = g_get_monotonic_time ();
+
+    /* run the framework threads in the CPUs of the NUMA node, if the CPUs are not given */
+    if (priv->prop.numa_node >= 0 && !priv->prop.cpu_affinity)
+      priv->prop.cpu_affinity =
+          gst_tensor_filter_get_numa_cpus (priv->prop.numa_node);
+
     if (priv->fw->open) {
       /* at least one model should be configured before opening fw */
       if (GST_TF_FW_V0 (priv->fw)) {
@@ -2714,6 +3859,34 @@ parse_accl_hw_util (const gchar * accelerators,
   return hw;
 }
 
+/**
+ * @brief Get the accelerator used by the opened framework.
+ * @param[in] priv Struct containing the properties of the object
+ * @return The first accelerator of the user preference supported by the framework, ACCL_NONE if not specified.
+ */
+accl_hw
+gst_tensor_filter_common_get_accelerator (GstTensorFilterPrivate * priv)
+{
+  /* the accelerators to be matched with the user preference */
+  const gchar *accl_list[] = {
+    ACCL_GPU_STR, ACCL_NPU_STR, ACCL_NPU_MOVIDIUS_STR, ACCL_NPU_EDGE_TPU_STR,
+    ACCL_NPU_VIVANTE_STR, ACCL_NPU_SRCN_STR, ACCL_NPU_SLSI_STR, ACCL_NPU_SR_STR,
+    ACCL_CPU_STR, NULL
+  };
+  if (!priv->fw)
+    return ACCL_NONE;
+
+  if (GST_TF_FW_V1 (priv->fw))
+    return (priv->prop.num_hw > 0) ? priv->prop.hw_list[0] : ACCL_NONE;
+
+  /* V0 framework parses the accelerator string by itself, auto and default are not known */
+  if (!priv->prop.accl_str)
+    return ACCL_NONE;
+
+  return parse_accl_hw_util (priv->prop.accl_str, accl_list, ACCL_NONE_STR,
+      ACCL_NONE_STR);
+}
+
 /**
  * @brief Check if this accelerator can be used based on the runtime system
  * @retval 0 if filter can be used, -errno otherwise
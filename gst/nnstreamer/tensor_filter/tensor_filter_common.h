@@ -30,6 +30,8 @@
 #include <nnstreamer_subplugin.h>
 #include <nnstreamer_plugin_api_util.h>
 #include <nnstreamer_plugin_api_filter.h>
+#include "tensor_filter_scheduler.h"
+#include "tensor_filter_cache.h"
 
 G_BEGIN_DECLS
 
@@ -44,7 +46,9 @@ G_BEGIN_DECLS
 #define GST_TF_FW_VN(fw, vn) \
     (fw && checkGstTensorFilterFrameworkVersion (fw->version, vn))
 #define GST_TF_FW_V0(fw) GST_TF_FW_VN (fw, 0)
-#define GST_TF_FW_V1(fw) GST_TF_FW_VN (fw, 1)
+/* V2 is V1 with invoke_memory, the callbacks of V1 are available in V2 */
+#define GST_TF_FW_V1(fw) (GST_TF_FW_VN (fw, 1) || GST_TF_FW_VN (fw, 2))
+#define GST_TF_FW_V2(fw) GST_TF_FW_VN (fw, 2)
 
 /**
  * @brief Invoke callbacks of nn framework. Guarantees calling open for the first call.
@@ -65,29 +69,88 @@ G_BEGIN_DECLS
       } \
     } while (0)
 
-#define GST_TF_FW_INVOKE_COMPAT(priv,ret,in,out) do { \
+#define GST_TF_FW_INVOKE_COMPAT(priv,ret,in,out) \
+    GST_TF_FW_INVOKE_COMPAT_WITH_DATA (priv, &(priv)->privateData, ret, in, out)
+
+/**
+ * @brief Invoke callbacks of nn framework with the given private data (an opened instance of the framework).
+ */
+#define GST_TF_FW_INVOKE_COMPAT_WITH_DATA(priv,pdata,ret,in,out) do { \
       ret = -1; \
       if (GST_TF_FW_V0 ((priv)->fw)) { \
-        ret = (priv)->fw->invoke_NN (&(priv)->prop, &(priv)->privateData, (in), (out)); \
+        ret = (priv)->fw->invoke_NN (&(priv)->prop, (pdata), (in), (out)); \
       } else if (GST_TF_FW_V1 ((priv)->fw)) { \
-        ret = (priv)->fw->invoke ((priv)->fw, &(priv)->prop, (priv)->privateData, (in), (out)); \
+        ret = (priv)->fw->invoke ((priv)->fw, &(priv)->prop, *(pdata), (in), (out)); \
       } \
     } while (0)
 
+#define GST_TF_MAX_WORKERS (64)
+
 #define GST_TF_STAT_MAX_RECENT (10)
 
+/**
+ * @brief Latency histogram (HDR-style): linear sub-buckets for each power of 2.
+ * With 4 sub-bucket bits, the relative error is less than 1/16 up to 2^31 usec.
+ */
+#define GST_TF_STAT_HIST_SUB_BITS (4)
+#define GST_TF_STAT_HIST_SUB_COUNT (1 << GST_TF_STAT_HIST_SUB_BITS)
+#define GST_TF_STAT_HIST_MAGNITUDES (28)
+#define GST_TF_STAT_HIST_SIZE (GST_TF_STAT_HIST_MAGNITUDES * GST_TF_STAT_HIST_SUB_COUNT)
+
+/**
+ * @brief The number of per-thread shards of the statistics counters.
+ */
+#define GST_TF_STAT_SHARDS (8)
+
+/**
+ * @brief Fixed-size histogram of invoke latencies (usec).
+ * The values are pointer-sized to be updated atomically (g_atomic_pointer_add) from the invoking threads.
+ */
+typedef struct _GstTensorFilterHistogram
+{
+  gsize counts[GST_TF_STAT_HIST_SIZE]; /**< the number of latencies in each bucket */
+  gsize total; /**< the number of recorded latencies */
+  gssize max; /**< the max latency (usec) */
+} GstTensorFilterHistogram;
+
+/**
+ * @brief Counters of the statistics updated by the invoking threads, aggregated on read.
+ * Each thread updates the shard of its own, so that the concurrent invokes (e.g., workers) do not contend the same cache line.
+ */
+typedef struct _GstTensorFilterStatShard
+{
+  gsize invoke_num; /**< the number of invokes */
+  gsize invoke_latency; /**< accumulated invoke latency (usec) */
+  gsize padding[6]; /**< to place the shards in separate cache lines */
+} GstTensorFilterStatShard;
+
+/**
+ * @brief Snapshot of the tensor-filter statistics.
+ */
+typedef struct _GstTensorFilterStatSnapshot
+{
+  guint64 invoke_num; /**< the number of recorded invokes */
+  guint64 invoke_latency; /**< accumulated invoke latency (usec) */
+  gint64 recent_latency; /**< the average of recent latencies (usec), -1 if no latency is recorded */
+  gint64 latency_p50; /**< the median latency (usec), -1 if no latency is recorded */
+  gint64 latency_p90; /**< the 90th percentile latency (usec), -1 if no latency is recorded */
+  gint64 latency_p99; /**< the 99th percentile latency (usec), -1 if no latency is recorded */
+  gint64 latency_max; /**< the max latency (usec), -1 if no latency is recorded */
+  gdouble throughput; /**< the number of invokes per second of the invoke time, 0 if no latency is recorded */
+} GstTensorFilterStatSnapshot;
+
 /**
  * @brief Structure definition for tensor-filter statistics
  */
 typedef struct _GstTensorFilterStatistics
 {
-  gint64 total_invoke_num;      /**< number of total invokes */
-  gint64 total_invoke_latency;  /**< accumulated invoke latency (usec) */
-  gint64 old_total_invoke_num;      /**< cached value. number of total invokes */
-  gint64 old_total_invoke_latency;  /**< cached value. accumulated invoke latency (usec) */
-  gint64 latest_invoke_time;    /**< the latest invoke time (usec) */
-  void *recent_latencies;       /**< data structure (e.g., queue) to hold recent latencies */
-  guint latency_ignore_count;   /* number of initial latency measurements to ignore in averaging */
+  GstTensorFilterStatShard shards[GST_TF_STAT_SHARDS]; /**< per-thread counters */
+  gssize recent_latencies[GST_TF_STAT_MAX_RECENT]; /**< ring buffer to hold recent latencies */
+  guint recent_count;           /**< the number of latencies written in the ring buffer (atomic) */
+  gint latency_ignore_count;    /**< number of initial latency measurements to ignore in averaging (atomic) */
+  GstTensorFilterHistogram histogram; /**< latency histogram for the percentiles */
+  GMutex stats_lock;            /**< mutex to post the statistics message */
+  gint64 latest_stats_time;     /**< the latest time (usec) posting the statistics message, protected by stats_lock */
 } GstTensorFilterStatistics;
 
 /**
@@ -126,6 +189,8 @@ typedef struct _GstTensorFilterPrivate
   gboolean silent; /**< Verbose mode if FALSE. int instead of gboolean for non-glib custom plugins */
   gboolean configured; /**< True if already successfully configured tensor metadata */
   gboolean is_updatable; /**<  a given model to the filter is updatable if TRUE */
+  gboolean reload_async; /**< load the updated model in the background and switch the framework instance if TRUE */
+  guint warmup; /**< the number of dummy invokes to warm up the model before the first frame */
   GstTensorsConfig in_config; /**< input tensor info */
   GstTensorsConfig out_config; /**< output tensor info */
 
@@ -133,8 +198,49 @@ typedef struct _GstTensorFilterPrivate
   gint throughput_mode;  /**< throughput profiling mode (0: off, 1: on, ...) */
   gboolean latency_reporting; /**< reporting of estimated filter latency is enabled */
   guint64 latency_reported; /**< latency value reported (ns) in last LATENCY query */
+  guint stats_interval; /**< interval (msec) to post the statistics message (0: off) */
+  guint64 deadline; /**< the time (usec) after the running time of the frame to get the output, the late frame is dropped (0: off) */
+  gint invoke_estimate; /**< the moving average (usec) of the invoke time to check the deadline */
+
+  guint num_workers; /**< the number of framework instances invoked asynchronously (1: invoke in the streaming thread) */
+  guint max_batch; /**< the number of frames packed into a single invoke (1: no batching) */
+  guint64 batch_timeout; /**< the maximum time (usec) to wait for the frames of a batch (0: wait until the batch is full) */
+
+  gboolean device_memory; /**< keep the output tensors in the device memory of the framework if supported */
+  const GstTensorDeviceOps *device_ops; /**< the device memory of the framework (NULL if not supported), updated when the framework is opened */
+  gboolean device_input; /**< TRUE if the framework accepts the input tensors in the device memory */
+  gboolean device_output; /**< TRUE if the framework can keep the output tensors in the device memory */
+  gboolean dmabuf_input; /**< TRUE if the framework imports the input tensors in DMA-BUF */
+
+  gboolean accl_schedule; /**< queue the invokes on the accelerator shared with the other filters */
+  gint accl_priority; /**< the priority of the invokes on the shared accelerator */
+  guint accl_weight; /**< the share of the accelerator among the filters of the same priority */
+  guint64 accl_latency_budget; /**< the max wait (usec) for the accelerator before falling back to CPU (0: no fallback) */
+  GstTensorFilterSchedClient *sched_client; /**< the filter registered on the shared accelerator (NULL if not scheduled) */
+  guint64 accl_switch_high; /**< the average invoke latency (usec) to leave the accelerator (0: not switching) */
+  guint64 accl_switch_low; /**< the latency (usec) of the preferred accelerator to go back (0: half of accl_switch_high) */
+
+  gdouble skip_threshold; /**< the mean absolute difference of the input tensors from the latest invoke to invoke the model (0: invoke all frames) */
+  guint skip_sample; /**< compare 1 of skip_sample blocks of the input tensors */
+  guint skip_max; /**< the max number of the consecutive frames skipped (0: no limit) */
+  guint64 skip_frames; /**< the number of the frames compared */
+  guint64 skip_num; /**< the number of the frames skipped */
+
+  guint64 cache_size; /**< the max bytes of the outputs cached for the identical input tensors (0: no cache) */
+  GstTensorFilterCache *cache; /**< the cache of the outputs (NULL if not cached), created when the element starts */
+
+  gchar *cascade; /**< the models invoked in order until the outputs are confident, separated by ';' */
+  gchar *cascade_condition; /**< the properties of tensor_if to evaluate the confidence of the outputs */
+  guint64 cascade_frames; /**< the number of the frames invoked with the cascade */
+  guint64 cascade_invokes; /**< the number of the invokes of the models in the cascade */
+
+  gboolean sparse_decode; /**< decode the sparse input stream into dense tensors before invoke */
+  gboolean sparse_invoke; /**< invoke the framework with the sparse input tensors as they are (sparse_input of the framework info) */
+  gboolean sparse_output; /**< encode the outputs of the model into the sparse output stream */
+  GstBufferPool *sparse_pool; /**< the pool of the dense tensors decoded from the sparse input (NULL if the size of the tensors is unknown) */
 
   GstTensorFilterCombination combi;
+  GstTensorMetaCache in_meta_cache[NNS_TENSOR_SIZE_LIMIT]; /**< the cached layout of flexible input tensors */
 } GstTensorFilterPrivate;
 
 /**
@@ -220,6 +326,61 @@ extern gboolean
 gst_tensor_filter_common_get_combined_out_info (GstTensorFilterPrivate * priv,
     const GstTensorsInfo * in, const GstTensorsInfo * out, GstTensorsInfo * combined);
 
+/**
+ * @brief Record the latency (usec) in the histogram.
+ */
+extern void
+gst_tensor_filter_histogram_record (GstTensorFilterHistogram * hist, gint64 latency);
+
+/**
+ * @brief Get the latency (usec) at the given percentile from the histogram.
+ * @return the latency, -1 if no latency is recorded.
+ */
+extern gint64
+gst_tensor_filter_histogram_get_percentile (const GstTensorFilterHistogram * hist, gdouble percentile);
+
+/**
+ * @brief Get the number of the latencies in the buckets of the histogram up to the given latency (usec).
+ * @note The bucket containing the given latency is counted only if its highest value is not larger than the latency.
+ */
+extern guint64
+gst_tensor_filter_histogram_get_count (const GstTensorFilterHistogram * hist, gint64 latency);
+
+/**
+ * @brief Record the invoke latency (usec) in the statistics. This can be called from the concurrent invoking threads.
+ * @return FALSE if the latency is ignored (the first measurements).
+ */
+extern gboolean
+gst_tensor_filter_statistics_record (GstTensorFilterStatistics * stat, gint64 latency);
+
+/**
+ * @brief Get the snapshot of the statistics, aggregating the per-thread counters.
+ * @note Each counter is read atomically, the snapshot may not include the invokes being recorded at the same time.
+ */
+extern void
+gst_tensor_filter_statistics_get_snapshot (GstTensorFilterStatistics * stat, GstTensorFilterStatSnapshot * snapshot);
+
+/**
+ * @brief Get the tensor info of a single frame from the batched tensor info of the model.
+ */
+extern gboolean
+gst_tensor_filter_common_get_frame_info (GstTensorFilterPrivate * priv,
+    const GstTensorsInfo * batched, GstTensorsInfo * frame);
+
+/**
+ * @brief Get the batched tensor info for the model from the tensor info of a single frame.
+ */
+extern gboolean
+gst_tensor_filter_common_get_batched_info (GstTensorFilterPrivate * priv,
+    const GstTensorsInfo * frame, GstTensorsInfo * batched);
+
+/**
+ * @brief Set the CPU affinity (property cpu-affinity) of the calling thread.
+ * @return TRUE if the affinity is set or not given.
+ */
+extern gboolean
+gst_tensor_filter_common_set_cpu_affinity (GstTensorFilterPrivate * priv);
+
 /**
  * @brief Get output tensor info from NN model with given input info.
  */
@@ -270,5 +431,46 @@ gst_tensor_filter_check_hw_availability (const gchar * name, const accl_hw hw, c
 extern void
 gst_tensor_filter_destroy_notify_util (GstTensorFilterPrivate *priv, void *data);
 
+/**
+ * @brief Free the data allocated for tensor filter output by the given instance of the framework
+ */
+extern void
+gst_tensor_filter_destroy_notify_util_full (GstTensorFilterPrivate *priv, void **private_data, void *data);
+
+/**
+ * @brief Get the per-op profile of the given instance of the framework
+ * @return Newly allocated profile text, NULL if the framework does not support the profile. Caller should free the value.
+ */
+extern gchar *
+gst_tensor_filter_get_profile (GstTensorFilterPrivate *priv, void *private_data);
+
+/**
+ * @brief Get the status of the compiled model cache of the given instance of the framework
+ * @return TRUE if the framework uses the compiled model cache.
+ */
+extern gboolean
+gst_tensor_filter_get_model_cache (GstTensorFilterPrivate *priv, void *private_data, gboolean *hit, gint64 *compile_time);
+
+/**
+ * @brief Get the device memory supported by the given instance of the framework
+ * @return TRUE if the framework supports the device memory or DMA-BUF import.
+ */
+extern gboolean
+gst_tensor_filter_get_device_memory (GstTensorFilterPrivate *priv, void *private_data, const GstTensorDeviceOps **ops, gboolean *input, gboolean *output, gboolean *dmabuf);
+
+/**
+ * @brief Set the memory of the tensors of the next invoke of the given instance of the framework
+ * @return TRUE if the framework accepts the setting.
+ */
+extern gboolean
+gst_tensor_filter_set_device_memory (GstTensorFilterPrivate *priv, void *private_data, gboolean input, gboolean output, const GstTensorDmaBuf *dmabuf);
+
+/**
+ * @brief Get the accelerator used by the opened framework
+ * @return The accelerator, ACCL_NONE if not specified.
+ */
+extern accl_hw
+gst_tensor_filter_common_get_accelerator (GstTensorFilterPrivate *priv);
+
 G_END_DECLS
 #endif /* __G_TENSOR_FILTER_COMMON_H__ */
@@ -0,0 +1,851 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	tensor_filter_custom_easy_ops.c
+ * @date	14 Oct 2026
+ * @brief	Common post-processing kernels for custom-easy tensor functions
+ * @see		http://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ *
+ * The kernels process 4 float32 elements at once with NEON or SSE2, and the
+ * remainders (or all elements without SIMD) with the scalar code.
+ * The vector exp is the polynomial approximation of Cephes (relative error
+ * about 1e-7 in the float32 range), the same accuracy with expf().
+ */
+
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+
+#include "tensor_filter_custom_easy_ops.h"
+#include "tensor_kernels.h"
+
+#if defined (__ARM_NEON)
+#include <arm_neon.h>
+#define CUSTOM_EASY_NEON_ENABLED
+#elif defined (__SSE2__)
+#include <emmintrin.h>
+#define CUSTOM_EASY_SSE2_ENABLED
+#endif
+
+#if defined (CUSTOM_EASY_NEON_ENABLED) || defined (CUSTOM_EASY_SSE2_ENABLED)
+#define CUSTOM_EASY_SIMD_ENABLED
+
+#define EXP_HI (88.3762626647949f)
+#define EXP_LO (-88.3762626647949f)
+#define EXP_LOG2E (1.44269504088896341f)
+#define EXP_C1 (0.693359375f)
+#define EXP_C2 (-2.12194440e-4f)
+#define EXP_P0 (1.9875691500E-4f)
+#define EXP_P1 (1.3981999507E-3f)
+#define EXP_P2 (8.3334519073E-3f)
+#define EXP_P3 (4.1665795894E-2f)
+#define EXP_P4 (1.6666665459E-1f)
+#define EXP_P5 (5.0000001201E-1f)
+
+#if defined (CUSTOM_EASY_NEON_ENABLED)
+typedef float32x4_t v4f;
+#define v4f_load(p) vld1q_f32 (p)
+#define v4f_store(p,v) vst1q_f32 ((p), (v))
+#define v4f_set1(f) vdupq_n_f32 (f)
+#define v4f_add(a,b) vaddq_f32 ((a), (b))
+#define v4f_sub(a,b) vsubq_f32 ((a), (b))
+#define v4f_mul(a,b) vmulq_f32 ((a), (b))
+#define v4f_max(a,b) vmaxq_f32 ((a), (b))
+#define v4f_min(a,b) vminq_f32 ((a), (b))
+
+/**
+ * @brief a / b. ARMv7 NEON does not have the division.
+ */
+static inline v4f
+v4f_div (v4f a, v4f b)
+{
+#if defined (__aarch64__)
+  return vdivq_f32 (a, b);
+#else
+  /* reciprocal estimate with 2 Newton-Raphson steps */
+  float32x4_t r = vrecpeq_f32 (b);
+  r = vmulq_f32 (vrecpsq_f32 (b, r), r);
+  r = vmulq_f32 (vrecpsq_f32 (b, r), r);
+  return vmulq_f32 (a, r);
+#endif
+}
+
+/**
+ * @brief Get the largest element in the vector.
+ */
+static inline float
+v4f_hmax (v4f v)
+{
+  float32x2_t m = vpmax_f32 (vget_low_f32 (v), vget_high_f32 (v));
+  m = vpmax_f32 (m, m);
+  return vget_lane_f32 (m, 0);
+}
+
+/**
+ * @brief Get the sum of the elements in the vector.
+ */
+static inline float
+v4f_hsum (v4f v)
+{
+  float32x2_t s = vadd_f32 (vget_low_f32 (v), vget_high_f32 (v));
+  s = vpadd_f32 (s, s);
+  return vget_lane_f32 (s, 0);
+}
+
+/**
+ * @brief exp(x) of 4 elements.
+ */
+static inline v4f
+v4f_exp (v4f x)
+{
+  float32x4_t fx, tmp, y, z;
+  uint32x4_t mask;
+  int32x4_t n;
+
+  x = vminq_f32 (x, vdupq_n_f32 (EXP_HI));
+  x = vmaxq_f32 (x, vdupq_n_f32 (EXP_LO));
+
+  /* n = floor (x * log2(e) + 0.5) */
+  fx = vmlaq_f32 (vdupq_n_f32 (0.5f), x, vdupq_n_f32 (EXP_LOG2E));
+  tmp = vcvtq_f32_s32 (vcvtq_s32_f32 (fx));
+  mask = vandq_u32 (vcgtq_f32 (tmp, fx),
+      vreinterpretq_u32_f32 (vdupq_n_f32 (1.0f)));
+  fx = vsubq_f32 (tmp, vreinterpretq_f32_u32 (mask));
+
+  x = vmlsq_f32 (x, fx, vdupq_n_f32 (EXP_C1));
+  x = vmlsq_f32 (x, fx, vdupq_n_f32 (EXP_C2));
+  z = vmulq_f32 (x, x);
+
+  y = vmlaq_f32 (vdupq_n_f32 (EXP_P1), vdupq_n_f32 (EXP_P0), x);
+  y = vmlaq_f32 (vdupq_n_f32 (EXP_P2), y, x);
+  y = vmlaq_f32 (vdupq_n_f32 (EXP_P3), y, x);
+  y = vmlaq_f32 (vdupq_n_f32 (EXP_P4), y, x);
+  y = vmlaq_f32 (vdupq_n_f32 (EXP_P5), y, x);
+  y = vmlaq_f32 (vaddq_f32 (x, vdupq_n_f32 (1.0f)), y, z);
+
+  /* 2^n */
+  n = vaddq_s32 (vcvtq_s32_f32 (fx), vdupq_n_s32 (127));
+  n = vshlq_n_s32 (n, 23);
+
+  return vmulq_f32 (y, vreinterpretq_f32_s32 (n));
+}
+
+/**
+ * @brief Load 4 boxes [4][4] and transpose them to 4 vectors of each coordinate.
+ */
+static inline void
+v4f_load_boxes (const float *p, v4f * c0, v4f * c1, v4f * c2, v4f * c3)
+{
+  float32x4x4_t v = vld4q_f32 (p);
+
+  *c0 = v.val[0];
+  *c1 = v.val[1];
+  *c2 = v.val[2];
+  *c3 = v.val[3];
+}
+
+/**
+ * @brief Transpose 4 vectors of each coordinate and store them as 4 boxes [4][4].
+ */
+static inline void
+v4f_store_boxes (float *p, v4f c0, v4f c1, v4f c2, v4f c3)
+{
+  float32x4x4_t v;
+
+  v.val[0] = c0;
+  v.val[1] = c1;
+  v.val[2] = c2;
+  v.val[3] = c3;
+  vst4q_f32 (p, v);
+}
+#else /* CUSTOM_EASY_SSE2_ENABLED */
+typedef __m128 v4f;
+#define v4f_load(p) _mm_loadu_ps (p)
+#define v4f_store(p,v) _mm_storeu_ps ((p), (v))
+#define v4f_set1(f) _mm_set1_ps (f)
+#define v4f_add(a,b) _mm_add_ps ((a), (b))
+#define v4f_sub(a,b) _mm_sub_ps ((a), (b))
+#define v4f_mul(a,b) _mm_mul_ps ((a), (b))
+#define v4f_div(a,b) _mm_div_ps ((a), (b))
+#define v4f_max(a,b) _mm_max_ps ((a), (b))
+#define v4f_min(a,b) _mm_min_ps ((a), (b))
+
+/**
+ * @brief Get the largest element in the vector.
+ */
+static inline float
+v4f_hmax (v4f v)
+{
+  v = _mm_max_ps (v, _mm_movehl_ps (v, v));
+  v = _mm_max_ss (v, _mm_shuffle_ps (v, v, 1));
+  return _mm_cvtss_f32 (v);
+}
+
+/**
+ * @brief Get the sum of the elements in the vector.
+ */
+static inline float
+v4f_hsum (v4f v)
+{
+  v = _mm_add_ps (v, _mm_movehl_ps (v, v));
+  v = _mm_add_ss (v, _mm_shuffle_ps (v, v, 1));
+  return _mm_cvtss_f32 (v);
+}
+
+/**
+ * @brief exp(x) of 4 elements.
+ */
+static inline v4f
+v4f_exp (v4f x)
+{
+  __m128 fx, tmp, y, z, mask;
+  __m128i n;
+
+  x = _mm_min_ps (x, _mm_set1_ps (EXP_HI));
+  x = _mm_max_ps (x, _mm_set1_ps (EXP_LO));
+
+  /* n = floor (x * log2(e) + 0.5) */
+  fx = _mm_add_ps (_mm_mul_ps (x, _mm_set1_ps (EXP_LOG2E)), _mm_set1_ps (0.5f));
+  tmp = _mm_cvtepi32_ps (_mm_cvttps_epi32 (fx));
+  mask = _mm_and_ps (_mm_cmpgt_ps (tmp, fx), _mm_set1_ps (1.0f));
+  fx = _mm_sub_ps (tmp, mask);
+
+  x = _mm_sub_ps (x, _mm_mul_ps (fx, _mm_set1_ps (EXP_C1)));
+  x = _mm_sub_ps (x, _mm_mul_ps (fx, _mm_set1_ps (EXP_C2)));
+  z = _mm_mul_ps (x, x);
+
+  y = _mm_add_ps (_mm_mul_ps (_mm_set1_ps (EXP_P0), x), _mm_set1_ps (EXP_P1));
+  y = _mm_add_ps (_mm_mul_ps (y, x), _mm_set1_ps (EXP_P2));
+  y = _mm_add_ps (_mm_mul_ps (y, x), _mm_set1_ps (EXP_P3));
+  y = _mm_add_ps (_mm_mul_ps (y, x), _mm_set1_ps (EXP_P4));
+  y = _mm_add_ps (_mm_mul_ps (y, x), _mm_set1_ps (EXP_P5));
+  y = _mm_add_ps (_mm_mul_ps (y, z), _mm_add_ps (x, _mm_set1_ps (1.0f)));
+
+  /* 2^n */
+  n = _mm_add_epi32 (_mm_cvttps_epi32 (fx), _mm_set1_epi32 (127));
+  n = _mm_slli_epi32 (n, 23);
+
+  return _mm_mul_ps (y, _mm_castsi128_ps (n));
+}
+
+/**
+ * @brief Load 4 boxes [4][4] and transpose them to 4 vectors of each coordinate.
+ */
+static inline void
+v4f_load_boxes (const float *p, v4f * c0, v4f * c1, v4f * c2, v4f * c3)
+{
+  __m128 r0 = _mm_loadu_ps (p);
+  __m128 r1 = _mm_loadu_ps (p + 4);
+  __m128 r2 = _mm_loadu_ps (p + 8);
+  __m128 r3 = _mm_loadu_ps (p + 12);
+
+  _MM_TRANSPOSE4_PS (r0, r1, r2, r3);
+  *c0 = r0;
+  *c1 = r1;
+  *c2 = r2;
+  *c3 = r3;
+}
+
+/**
+ * @brief Transpose 4 vectors of each coordinate and store them as 4 boxes [4][4].
+ */
+static inline void
+v4f_store_boxes (float *p, v4f c0, v4f c1, v4f c2, v4f c3)
+{
+  _MM_TRANSPOSE4_PS (c0, c1, c2, c3);
+  _mm_storeu_ps (p, c0);
+  _mm_storeu_ps (p + 4, c1);
+  _mm_storeu_ps (p + 8, c2);
+  _mm_storeu_ps (p + 12, c3);
+}
+#endif
+#endif /* CUSTOM_EASY_SIMD_ENABLED */
+
+/**
+ * @brief The size of the element of the types supported by argmax and top-k.
+ */
+static size_t
+custom_easy_element_size (tensor_type type)
+{
+  switch (type) {
+    case _NNS_INT32:
+    case _NNS_UINT32:
+    case _NNS_FLOAT32:
+      return 4;
+    case _NNS_INT16:
+    case _NNS_UINT16:
+      return 2;
+    case _NNS_INT8:
+    case _NNS_UINT8:
+      return 1;
+    case _NNS_FLOAT64:
+    case _NNS_INT64:
+    case _NNS_UINT64:
+      return 8;
+    default:
+      break;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Get the value of the index-th element as double.
+ */
+static inline double
+custom_easy_get_value (const void *data, tensor_type type, size_t index)
+{
+  switch (type) {
+    case _NNS_INT32:
+      return (double) ((const int32_t *) data)[index];
+    case _NNS_UINT32:
+      return (double) ((const uint32_t *) data)[index];
+    case _NNS_INT16:
+      return (double) ((const int16_t *) data)[index];
+    case _NNS_UINT16:
+      return (double) ((const uint16_t *) data)[index];
+    case _NNS_INT8:
+      return (double) ((const int8_t *) data)[index];
+    case _NNS_UINT8:
+      return (double) ((const uint8_t *) data)[index];
+    case _NNS_FLOAT64:
+      return ((const double *) data)[index];
+    case _NNS_FLOAT32:
+      return (double) ((const float *) data)[index];
+    case _NNS_INT64:
+      return (double) ((const int64_t *) data)[index];
+    case _NNS_UINT64:
+      return (double) ((const uint64_t *) data)[index];
+    default:
+      break;
+  }
+
+  return 0.0;
+}
+
+/**
+ * @brief Get the number of float32 elements, 0 if the memory is invalid.
+ */
+static inline size_t
+custom_easy_num_floats (const GstTensorMemory * mem)
+{
+  if (!mem || !mem->data || mem->size == 0 || (mem->size % sizeof (float)))
+    return 0;
+
+  return mem->size / sizeof (float);
+}
+
+/**
+ * @brief Get the index of the largest element.
+ */
+int
+NNS_custom_easy_argmax (const GstTensorMemory * in, tensor_type type,
+    uint32_t * index)
+{
+  size_t esize, num, i = 0;
+
+  esize = custom_easy_element_size (type);
+  if (!in || !in->data || !index || esize == 0 || in->size < esize)
+    return -EINVAL;
+
+  num = in->size / esize;
+
+  if (type == _NNS_FLOAT32) {
+    float max;
+
+    /* the kernel for the running CPU */
+    *index = (uint32_t) gst_tensor_kernels_get ()->f32_argmax (
+        (const float *) in->data, num, &max);
+  } else {
+    double max = custom_easy_get_value (in->data, type, 0);
+
+    *index = 0;
+    for (i = 1; i < num; i++) {
+      double v = custom_easy_get_value (in->data, type, i);
+
+      if (v > max) {
+        max = v;
+        *index = (uint32_t) i;
+      }
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Get the k largest elements in descending order.
+ */
+int
+NNS_custom_easy_topk (const GstTensorMemory * in, tensor_type type,
+    uint32_t k, uint32_t * indices, float *scores)
+{
+  size_t esize, num, i;
+  double *values;
+  uint32_t filled = 0, j;
+
+  esize = custom_easy_element_size (type);
+  if (!in || !in->data || !indices || esize == 0 || k == 0)
+    return -EINVAL;
+
+  num = in->size / esize;
+  values = g_new (double, k);
+
+  /* keep the sorted k candidates, k is supposed to be small */
+  for (i = 0; i < num; i++) {
+    double v = custom_easy_get_value (in->data, type, i);
+
+    if (filled == k && v <= values[k - 1])
+      continue;
+
+    j = (filled < k) ? filled++ : k - 1;
+    for (; j > 0 && values[j - 1] < v; j--) {
+      values[j] = values[j - 1];
+      indices[j] = indices[j - 1];
+    }
+
+    values[j] = v;
+    indices[j] = (uint32_t) i;
+  }
+
+  if (scores) {
+    for (j = 0; j < filled; j++)
+      scores[j] = (float) values[j];
+  }
+
+  g_free (values);
+  return (int) filled;
+}
+
+/**
+ * @brief Softmax of float32 tensor.
+ */
+int
+NNS_custom_easy_softmax (const GstTensorMemory * in, GstTensorMemory * out,
+    uint32_t num_classes)
+{
+  const float *src;
+  float *dst;
+  size_t num, row, i;
+
+  num = custom_easy_num_floats (in);
+  if (num == 0 || !out || !out->data || out->size < in->size)
+    return -EINVAL;
+
+  if (num_classes == 0)
+    num_classes = (uint32_t) num;
+
+  if (num % num_classes)
+    return -EINVAL;
+
+  for (row = 0; row < num; row += num_classes) {
+    float max, sum, scale;
+
+    src = (const float *) in->data + row;
+    dst = (float *) out->data + row;
+
+    /* 1. max, to avoid the overflow of exp */
+    max = src[0];
+    i = 0;
+#ifdef CUSTOM_EASY_SIMD_ENABLED
+    if (num_classes >= 4) {
+      v4f vmax = v4f_load (src);
+
+      for (i = 4; i + 4 <= num_classes; i += 4)
+        vmax = v4f_max (vmax, v4f_load (src + i));
+      max = v4f_hmax (vmax);
+    }
+#endif
+    for (; i < num_classes; i++) {
+      if (src[i] > max)
+        max = src[i];
+    }
+
+    /* 2. exp (x - max) and the sum */
+    sum = 0.0f;
+    i = 0;
+#ifdef CUSTOM_EASY_SIMD_ENABLED
+    {
+      v4f vmax = v4f_set1 (max);
+      v4f vsum = v4f_set1 (0.0f);
+
+      for (; i + 4 <= num_classes; i += 4) {
+        v4f e = v4f_exp (v4f_sub (v4f_load (src + i), vmax));
+
+        v4f_store (dst + i, e);
+        vsum = v4f_add (vsum, e);
+      }
+      sum = v4f_hsum (vsum);
+    }
+#endif
+    for (; i < num_classes; i++) {
+      dst[i] = expf (src[i] - max);
+      sum += dst[i];
+    }
+
+    /* 3. normalize */
+    scale = 1.0f / sum;
+    i = 0;
+#ifdef CUSTOM_EASY_SIMD_ENABLED
+    {
+      v4f vscale = v4f_set1 (scale);
+
+      for (; i + 4 <= num_classes; i += 4)
+        v4f_store (dst + i, v4f_mul (v4f_load (dst + i), vscale));
+    }
+#endif
+    for (; i < num_classes; i++)
+      dst[i] *= scale;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Sigmoid of float32 tensor.
+ */
+int
+NNS_custom_easy_sigmoid (const GstTensorMemory * in, GstTensorMemory * out)
+{
+  const float *src;
+  float *dst;
+  size_t num, i = 0;
+
+  num = custom_easy_num_floats (in);
+  if (num == 0 || !out || !out->data || out->size < in->size)
+    return -EINVAL;
+
+  src = (const float *) in->data;
+  dst = (float *) out->data;
+
+#ifdef CUSTOM_EASY_SIMD_ENABLED
+  {
+    v4f zero = v4f_set1 (0.0f);
+    v4f one = v4f_set1 (1.0f);
+
+    for (; i + 4 <= num; i += 4) {
+      v4f e = v4f_exp (v4f_sub (zero, v4f_load (src + i)));
+
+      v4f_store (dst + i, v4f_div (one, v4f_add (one, e)));
+    }
+  }
+#endif
+  for (; i < num; i++)
+    dst[i] = 1.0f / (1.0f + expf (-src[i]));
+
+  return 0;
+}
+
+/**
+ * @brief Dequantize uint8 or int8 tensor to float32.
+ */
+int
+NNS_custom_easy_dequantize (const GstTensorMemory * in, tensor_type type,
+    float scale, int32_t zero_point, GstTensorMemory * out)
+{
+  float *dst;
+  size_t num, i = 0;
+
+  if (!in || !in->data || !out || !out->data)
+    return -EINVAL;
+
+  if (type != _NNS_UINT8 && type != _NNS_INT8)
+    return -EINVAL;
+
+  num = in->size;
+  if (out->size < num * sizeof (float))
+    return -EINVAL;
+
+  dst = (float *) out->data;
+
+  if (type == _NNS_UINT8) {
+    const uint8_t *src = (const uint8_t *) in->data;
+
+#if defined (CUSTOM_EASY_NEON_ENABLED)
+    float32x4_t vscale = vdupq_n_f32 (scale);
+    int32x4_t vzp = vdupq_n_s32 (zero_point);
+
+    for (; i + 8 <= num; i += 8) {
+      uint16x8_t w = vmovl_u8 (vld1_u8 (src + i));
+      int32x4_t lo = vreinterpretq_s32_u32 (vmovl_u16 (vget_low_u16 (w)));
+      int32x4_t hi = vreinterpretq_s32_u32 (vmovl_u16 (vget_high_u16 (w)));
+
+      vst1q_f32 (dst + i,
+          vmulq_f32 (vcvtq_f32_s32 (vsubq_s32 (lo, vzp)), vscale));
+      vst1q_f32 (dst + i + 4,
+          vmulq_f32 (vcvtq_f32_s32 (vsubq_s32 (hi, vzp)), vscale));
+    }
+#elif defined (CUSTOM_EASY_SSE2_ENABLED)
+    __m128 vscale = _mm_set1_ps (scale);
+    __m128i vzp = _mm_set1_epi32 (zero_point);
+    __m128i zero = _mm_setzero_si128 ();
+
+    for (; i + 8 <= num; i += 8) {
+      __m128i w = _mm_unpacklo_epi8 (_mm_loadl_epi64 ((const __m128i *)
+              (src + i)), zero);
+      __m128i lo = _mm_unpacklo_epi16 (w, zero);
+      __m128i hi = _mm_unpackhi_epi16 (w, zero);
+
+      _mm_storeu_ps (dst + i,
+          _mm_mul_ps (_mm_cvtepi32_ps (_mm_sub_epi32 (lo, vzp)), vscale));
+      _mm_storeu_ps (dst + i + 4,
+          _mm_mul_ps (_mm_cvtepi32_ps (_mm_sub_epi32 (hi, vzp)), vscale));
+    }
+#endif
+    for (; i < num; i++)
+      dst[i] = (float) ((int32_t) src[i] - zero_point) * scale;
+  } else {
+    const int8_t *src = (const int8_t *) in->data;
+
+#if defined (CUSTOM_EASY_NEON_ENABLED)
+    float32x4_t vscale = vdupq_n_f32 (scale);
+    int32x4_t vzp = vdupq_n_s32 (zero_point);
+
+    for (; i + 8 <= num; i += 8) {
+      int16x8_t w = vmovl_s8 (vld1_s8 (src + i));
+      int32x4_t lo = vmovl_s16 (vget_low_s16 (w));
+      int32x4_t hi = vmovl_s16 (vget_high_s16 (w));
+
+      vst1q_f32 (dst + i,
+          vmulq_f32 (vcvtq_f32_s32 (vsubq_s32 (lo, vzp)), vscale));
+      vst1q_f32 (dst + i + 4,
+          vmulq_f32 (vcvtq_f32_s32 (vsubq_s32 (hi, vzp)), vscale));
+    }
+#elif defined (CUSTOM_EASY_SSE2_ENABLED)
+    __m128 vscale = _mm_set1_ps (scale);
+    __m128i vzp = _mm_set1_epi32 (zero_point);
+
+    for (; i + 8 <= num; i += 8) {
+      __m128i b = _mm_loadl_epi64 ((const __m128i *) (src + i));
+      /* sign extension: place the bytes at the upper bits and shift */
+      __m128i w = _mm_srai_epi16 (_mm_unpacklo_epi8 (b, b), 8);
+      __m128i lo = _mm_srai_epi32 (_mm_unpacklo_epi16 (w, w), 16);
+      __m128i hi = _mm_srai_epi32 (_mm_unpackhi_epi16 (w, w), 16);
+
+      _mm_storeu_ps (dst + i,
+          _mm_mul_ps (_mm_cvtepi32_ps (_mm_sub_epi32 (lo, vzp)), vscale));
+      _mm_storeu_ps (dst + i + 4,
+          _mm_mul_ps (_mm_cvtepi32_ps (_mm_sub_epi32 (hi, vzp)), vscale));
+    }
+#endif
+    for (; i < num; i++)
+      dst[i] = (float) ((int32_t) src[i] - zero_point) * scale;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Decode the box deltas with the anchors (SSD box coder).
+ */
+int
+NNS_custom_easy_box_decode (const GstTensorMemory * deltas,
+    const GstTensorMemory * anchors, const float scales[4],
+    GstTensorMemory * out)
+{
+  const float *d, *a;
+  float *o;
+  size_t num, b = 0;
+
+  num = custom_easy_num_floats (deltas);
+  if (num == 0 || (num % 4) || !scales)
+    return -EINVAL;
+
+  if (custom_easy_num_floats (anchors) < num || !out || !out->data
+      || out->size < deltas->size)
+    return -EINVAL;
+
+  if (scales[0] == 0.0f || scales[1] == 0.0f || scales[2] == 0.0f
+      || scales[3] == 0.0f)
+    return -EINVAL;
+
+  num /= 4;
+  d = (const float *) deltas->data;
+  a = (const float *) anchors->data;
+  o = (float *) out->data;
+
+#ifdef CUSTOM_EASY_SIMD_ENABLED
+  {
+    v4f sy = v4f_set1 (1.0f / scales[0]);
+    v4f sx = v4f_set1 (1.0f / scales[1]);
+    v4f sh = v4f_set1 (1.0f / scales[2]);
+    v4f sw = v4f_set1 (1.0f / scales[3]);
+    v4f half = v4f_set1 (0.5f);
+
+    for (; b + 4 <= num; b += 4) {
+      v4f dy, dx, dh, dw, ay, ax, ah, aw, cy, cx, h, w;
+
+      v4f_load_boxes (d + b * 4, &dy, &dx, &dh, &dw);
+      v4f_load_boxes (a + b * 4, &ay, &ax, &ah, &aw);
+
+      cy = v4f_add (v4f_mul (v4f_mul (dy, sy), ah), ay);
+      cx = v4f_add (v4f_mul (v4f_mul (dx, sx), aw), ax);
+      h = v4f_mul (v4f_mul (v4f_exp (v4f_mul (dh, sh)), ah), half);
+      w = v4f_mul (v4f_mul (v4f_exp (v4f_mul (dw, sw)), aw), half);
+
+      v4f_store_boxes (o + b * 4, v4f_sub (cy, h), v4f_sub (cx, w),
+          v4f_add (cy, h), v4f_add (cx, w));
+    }
+  }
+#endif
+  for (; b < num; b++) {
+    const float *db = d + b * 4;
+    const float *ab = a + b * 4;
+    float cy, cx, h, w;
+
+    cy = db[0] / scales[0] * ab[2] + ab[0];
+    cx = db[1] / scales[1] * ab[3] + ab[1];
+    h = expf (db[2] / scales[2]) * ab[2] * 0.5f;
+    w = expf (db[3] / scales[3]) * ab[3] * 0.5f;
+
+    o[b * 4] = cy - h;
+    o[b * 4 + 1] = cx - w;
+    o[b * 4 + 2] = cy + h;
+    o[b * 4 + 3] = cx + w;
+  }
+
+  return 0;
+}
+
+/**
+ * @brief The candidate box of nms.
+ */
+typedef struct
+{
+  float score;
+  uint32_t index;
+} custom_easy_nms_candidate;
+
+/**
+ * @brief Compare the candidates in descending order of the scores (stable with the index).
+ */
+static int
+custom_easy_nms_compare (const void *a, const void *b)
+{
+  const custom_easy_nms_candidate *ca = (const custom_easy_nms_candidate *) a;
+  const custom_easy_nms_candidate *cb = (const custom_easy_nms_candidate *) b;
+
+  if (ca->score != cb->score)
+    return (ca->score < cb->score) ? 1 : -1;
+
+  return (ca->index > cb->index) - (ca->index < cb->index);
+}
+
+/**
+ * @brief Greedy non-maximum suppression.
+ *
+ * The selected boxes are kept in the coordinate arrays (structure of arrays),
+ * and the IoU of a candidate is compared with 4 selected boxes at once.
+ * The box is suppressed if inter > threshold * union, without the division.
+ */
+int
+NNS_custom_easy_nms (const GstTensorMemory * boxes,
+    const GstTensorMemory * scores, float iou_threshold, float score_threshold,
+    uint32_t max_output, uint32_t * selected)
+{
+  const float *bx, *sc;
+  custom_easy_nms_candidate *cand;
+  float *sel_y1, *sel_x1, *sel_y2, *sel_x2, *sel_area;
+  size_t num, num_cand = 0, cap, c, i;
+  uint32_t num_sel = 0;
+
+  num = custom_easy_num_floats (scores);
+  if (num == 0 || !selected || max_output == 0)
+    return -EINVAL;
+
+  if (custom_easy_num_floats (boxes) < num * 4)
+    return -EINVAL;
+
+  bx = (const float *) boxes->data;
+  sc = (const float *) scores->data;
+
+  cand = g_new (custom_easy_nms_candidate, num);
+  for (i = 0; i < num; i++) {
+    if (sc[i] >= score_threshold) {
+      cand[num_cand].score = sc[i];
+      cand[num_cand].index = (uint32_t) i;
+      num_cand++;
+    }
+  }
+
+  qsort (cand, num_cand, sizeof (custom_easy_nms_candidate),
+      custom_easy_nms_compare);
+
+  /* the coordinates and areas of the selected boxes */
+  cap = MIN ((size_t) max_output, num_cand) + 1;
+  sel_y1 = g_new0 (float, cap * 5);
+  sel_x1 = sel_y1 + cap;
+  sel_y2 = sel_x1 + cap;
+  sel_x2 = sel_y2 + cap;
+  sel_area = sel_x2 + cap;
+
+  for (c = 0; c < num_cand && num_sel < max_output; c++) {
+    const float *box = bx + (size_t) cand[c].index * 4;
+    float y1 = MIN (box[0], box[2]);
+    float x1 = MIN (box[1], box[3]);
+    float y2 = MAX (box[0], box[2]);
+    float x2 = MAX (box[1], box[3]);
+    float area = (y2 - y1) * (x2 - x1);
+    gboolean suppressed = FALSE;
+
+    i = 0;
+#ifdef CUSTOM_EASY_SIMD_ENABLED
+    {
+      v4f vy1 = v4f_set1 (y1), vx1 = v4f_set1 (x1);
+      v4f vy2 = v4f_set1 (y2), vx2 = v4f_set1 (x2);
+      v4f varea = v4f_set1 (area), vth = v4f_set1 (iou_threshold);
+      v4f zero = v4f_set1 (0.0f);
+
+      for (; i + 4 <= num_sel && !suppressed; i += 4) {
+        v4f ih, iw, inter, uni, diff;
+        float d[4];
+
+        ih = v4f_max (v4f_sub (v4f_min (vy2, v4f_load (sel_y2 + i)),
+                v4f_max (vy1, v4f_load (sel_y1 + i))), zero);
+        iw = v4f_max (v4f_sub (v4f_min (vx2, v4f_load (sel_x2 + i)),
+                v4f_max (vx1, v4f_load (sel_x1 + i))), zero);
+        inter = v4f_mul (ih, iw);
+        uni = v4f_sub (v4f_add (varea, v4f_load (sel_area + i)), inter);
+
+        /* suppressed if any of (inter - th * union) is positive */
+        diff = v4f_sub (inter, v4f_mul (vth, uni));
+        v4f_store (d, diff);
+        suppressed = (d[0] > 0.0f || d[1] > 0.0f || d[2] > 0.0f
+            || d[3] > 0.0f);
+      }
+    }
+#endif
+    for (; i < num_sel && !suppressed; i++) {
+      float ih = MIN (y2, sel_y2[i]) - MAX (y1, sel_y1[i]);
+      float iw = MIN (x2, sel_x2[i]) - MAX (x1, sel_x1[i]);
+      float inter, uni;
+
+      if (ih <= 0.0f || iw <= 0.0f)
+        continue;
+
+      inter = ih * iw;
+      uni = area + sel_area[i] - inter;
+      suppressed = (inter > iou_threshold * uni);
+    }
+
+    if (suppressed)
+      continue;
+
+    sel_y1[num_sel] = y1;
+    sel_x1[num_sel] = x1;
+    sel_y2[num_sel] = y2;
+    sel_x2[num_sel] = x2;
+    sel_area[num_sel] = area;
+    selected[num_sel] = cand[c].index;
+    num_sel++;
+  }
+
+  g_free (sel_y1);
+  g_free (cand);
+  return (int) num_sel;
+}
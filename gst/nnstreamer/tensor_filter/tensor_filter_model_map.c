@@ -0,0 +1,243 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	tensor_filter_model_map.c
+ * @date	15 Oct 2026
+ * @brief	Read-only memory map of the model files for the sub-plugins
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ *
+ * A sub-plugin reading the model file into its own heap keeps a private copy
+ * of the weights in each process. The model map maps the file read-only and
+ * shared instead, so the pages of the model are backed by the page cache and
+ * shared by all processes loading the same file. In a process, the filters
+ * and the workers opening the same file share a single mapping.
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <glib.h>
+#include <glib/gstdio.h>
+#include <nnstreamer_log.h>
+#include <nnstreamer_plugin_api_filter.h>
+#include <nnstreamer_util.h>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief The memory map of a model file.
+ */
+struct _GstTensorFilterModelMap
+{
+  gchar *key; /**< path and identity of the file */
+  gint refcount; /**< the number of the users, protected by the lock of the table */
+  gpointer data; /**< mapped contents */
+  gsize size; /**< size of the file */
+#if defined(__linux__)
+  gboolean mapped; /**< data is mapped with mmap (not an empty file) */
+#else
+  GMappedFile *file; /**< mapped file */
+#endif
+};
+
+/**
+ * @brief The model maps opened in this process (key to map).
+ */
+static GHashTable *model_maps = NULL;
+G_LOCK_DEFINE_STATIC (model_maps);
+
+/**
+ * @brief Get the key of the model file, the path with the identity of the file so that a replaced file is mapped again.
+ */
+static gchar *
+_model_map_get_key (const char *path)
+{
+  GStatBuf st;
+
+  if (g_stat (path, &st) != 0 || !S_ISREG (st.st_mode))
+    return NULL;
+
+  return g_strdup_printf ("%s:%" G_GUINT64_FORMAT ":%" G_GUINT64_FORMAT
+      ":%" G_GINT64_FORMAT ":%" G_GINT64_FORMAT, path, (guint64) st.st_dev,
+      (guint64) st.st_ino, (gint64) st.st_size, (gint64) st.st_mtime);
+}
+
+/**
+ * @brief Map the model file.
+ * @return 0 if the file is mapped, or negative errno.
+ */
+static int
+_model_map_file (GstTensorFilterModelMap * map, const char *path,
+    unsigned int flags)
+{
+#if defined(__linux__)
+  struct stat st;
+  int fd, mflags = MAP_SHARED;
+
+  fd = open (path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return -errno;
+
+  if (fstat (fd, &st) != 0) {
+    int err = -errno;
+    close (fd);
+    return err;
+  }
+
+  map->size = (gsize) st.st_size;
+  if (map->size == 0) {
+    /* mmap does not accept an empty file */
+    close (fd);
+    return 0;
+  }
+
+#ifdef MAP_POPULATE
+  if (flags & GST_TENSOR_FILTER_MODEL_MAP_POPULATE)
+    mflags |= MAP_POPULATE;
+#endif
+
+  map->data = mmap (NULL, map->size, PROT_READ, mflags, fd, 0);
+  close (fd);
+
+  if (map->data == MAP_FAILED) {
+    map->data = NULL;
+    return -errno;
+  }
+
+  map->mapped = TRUE;
+
+  if (flags & GST_TENSOR_FILTER_MODEL_MAP_PRELOAD) {
+    /* start reading the whole file ahead, the model is parsed right after it is opened */
+    if (madvise (map->data, map->size, MADV_WILLNEED) != 0)
+      nns_logw ("Failed to read ahead the model file %s.", path);
+  }
+
+  return 0;
+#else
+  GError *err = NULL;
+
+  UNUSED (flags);
+
+  map->file = g_mapped_file_new (path, FALSE, &err);
+  if (!map->file) {
+    nns_loge ("Failed to map the model file %s: %s", path,
+        err ? err->message : "unknown error");
+    g_clear_error (&err);
+    return -EIO;
+  }
+
+  map->data = g_mapped_file_get_contents (map->file);
+  map->size = g_mapped_file_get_length (map->file);
+  return 0;
+#endif
+}
+
+/**
+ * @brief Unmap and free the model map.
+ */
+static void
+_model_map_free (GstTensorFilterModelMap * map)
+{
+#if defined(__linux__)
+  if (map->mapped)
+    munmap (map->data, map->size);
+#else
+  if (map->file)
+    g_mapped_file_unref (map->file);
+#endif
+
+  g_free (map->key);
+  g_free (map);
+}
+
+/**
+ * @brief Open the read-only memory map of a model file.
+ */
+GstTensorFilterModelMap *
+gst_tensor_filter_model_map_open (const char *path, unsigned int flags)
+{
+  GstTensorFilterModelMap *map = NULL;
+  gchar *key;
+  int err;
+
+  g_return_val_if_fail (path != NULL, NULL);
+
+  key = _model_map_get_key (path);
+  if (!key) {
+    nns_loge ("Cannot find the model file %s.", path);
+    return NULL;
+  }
+
+  G_LOCK (model_maps);
+
+  if (!model_maps)
+    model_maps = g_hash_table_new (g_str_hash, g_str_equal);
+
+  map = (GstTensorFilterModelMap *) g_hash_table_lookup (model_maps, key);
+  if (map) {
+    map->refcount++;
+    g_free (key);
+    goto done;
+  }
+
+  map = g_new0 (GstTensorFilterModelMap, 1);
+  map->key = key;
+  map->refcount = 1;
+
+  err = _model_map_file (map, path, flags);
+  if (err != 0) {
+    nns_loge ("Failed to map the model file %s (%d).", path, err);
+    _model_map_free (map);
+    map = NULL;
+    goto done;
+  }
+
+  g_hash_table_insert (model_maps, map->key, map);
+
+done:
+  G_UNLOCK (model_maps);
+  return map;
+}
+
+/**
+ * @brief Get the contents of the model map.
+ */
+const void *
+gst_tensor_filter_model_map_get_data (GstTensorFilterModelMap * map,
+    size_t *size)
+{
+  g_return_val_if_fail (map != NULL, NULL);
+
+  if (size)
+    *size = map->size;
+
+  return map->data;
+}
+
+/**
+ * @brief Close the model map.
+ */
+void
+gst_tensor_filter_model_map_close (GstTensorFilterModelMap * map)
+{
+  gboolean last;
+
+  if (!map)
+    return;
+
+  G_LOCK (model_maps);
+  last = (--map->refcount == 0);
+  if (last)
+    g_hash_table_remove (model_maps, map->key);
+  G_UNLOCK (model_maps);
+
+  if (last)
+    _model_map_free (map);
+}
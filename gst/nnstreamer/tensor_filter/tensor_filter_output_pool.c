@@ -0,0 +1,162 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	tensor_filter_output_pool.c
+ * @date	15 Oct 2026
+ * @brief	Pool of the output memory for the sub-plugins allocating the outputs in invoke
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ *
+ * A sub-plugin with allocate_in_invoke allocates the output memory of each
+ * frame and tensor_filter returns it with DESTROY_NOTIFY when the buffer is
+ * released downstream. The pool keeps the released chunks and hands them out
+ * again for the next frames, so the output memory is reused across frames
+ * instead of being allocated and freed for every invoke.
+ */
+
+#include <errno.h>
+#include <glib.h>
+#include <nnstreamer_plugin_api_filter.h>
+
+/**
+ * @brief The output pool of a sub-plugin.
+ */
+struct _GstTensorFilterOutputPool
+{
+  GMutex lock;
+  gint refcount; /**< the owner and the outstanding chunks after the pool is freed */
+  gboolean closed; /**< the owner freed the pool */
+  guint max_cached; /**< max number of the cached chunks */
+  GHashTable *outstanding; /**< the chunks handed out, pointer to size */
+  GSList *cached; /**< released chunks to be reused */
+  GSList *cached_sizes; /**< size of the cached chunks, same order with cached */
+  guint num_cached; /**< the number of the cached chunks */
+};
+
+/**
+ * @brief Drop a reference of the pool, free it with the last reference.
+ * @note The caller should hold the lock of the pool, it is released here.
+ */
+static void
+_output_pool_unref_locked (GstTensorFilterOutputPool * pool)
+{
+  gboolean last;
+
+  last = (--pool->refcount == 0);
+  g_mutex_unlock (&pool->lock);
+
+  if (last) {
+    g_slist_free_full (pool->cached, g_free);
+    g_slist_free (pool->cached_sizes);
+    g_hash_table_destroy (pool->outstanding);
+    g_mutex_clear (&pool->lock);
+    g_free (pool);
+  }
+}
+
+/**
+ * @brief Create the output pool of a sub-plugin.
+ */
+GstTensorFilterOutputPool *
+gst_tensor_filter_output_pool_new (unsigned int max_cached)
+{
+  GstTensorFilterOutputPool *pool;
+
+  pool = g_new0 (GstTensorFilterOutputPool, 1);
+  g_mutex_init (&pool->lock);
+  pool->refcount = 1;
+  pool->max_cached = max_cached;
+  pool->outstanding = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+  return pool;
+}
+
+/**
+ * @brief Get the output memory from the pool.
+ */
+void *
+gst_tensor_filter_output_pool_alloc (GstTensorFilterOutputPool * pool,
+    size_t size)
+{
+  GSList *data, *sizes;
+  void *chunk = NULL;
+
+  g_return_val_if_fail (pool != NULL, NULL);
+  g_return_val_if_fail (size > 0, NULL);
+
+  g_mutex_lock (&pool->lock);
+
+  for (data = pool->cached, sizes = pool->cached_sizes; data;
+      data = data->next, sizes = sizes->next) {
+    if (GPOINTER_TO_SIZE (sizes->data) == size) {
+      chunk = data->data;
+      pool->cached = g_slist_delete_link (pool->cached, data);
+      pool->cached_sizes = g_slist_delete_link (pool->cached_sizes, sizes);
+      pool->num_cached--;
+      break;
+    }
+  }
+
+  if (!chunk)
+    chunk = g_malloc (size);
+
+  g_hash_table_insert (pool->outstanding, chunk, GSIZE_TO_POINTER (size));
+  pool->refcount++;
+
+  g_mutex_unlock (&pool->lock);
+  return chunk;
+}
+
+/**
+ * @brief Return the output memory to the pool.
+ */
+int
+gst_tensor_filter_output_pool_release (GstTensorFilterOutputPool * pool,
+    void *data)
+{
+  gpointer size;
+
+  g_return_val_if_fail (pool != NULL, -EINVAL);
+
+  g_mutex_lock (&pool->lock);
+
+  if (!g_hash_table_lookup_extended (pool->outstanding, data, NULL, &size)) {
+    g_mutex_unlock (&pool->lock);
+    return -ENOENT;
+  }
+
+  g_hash_table_remove (pool->outstanding, data);
+
+  if (!pool->closed && pool->num_cached < pool->max_cached) {
+    pool->cached = g_slist_prepend (pool->cached, data);
+    pool->cached_sizes = g_slist_prepend (pool->cached_sizes, size);
+    pool->num_cached++;
+  } else {
+    g_free (data);
+  }
+
+  _output_pool_unref_locked (pool);
+  return 0;
+}
+
+/**
+ * @brief Free the output pool of a sub-plugin.
+ */
+void
+gst_tensor_filter_output_pool_free (GstTensorFilterOutputPool * pool)
+{
+  if (!pool)
+    return;
+
+  g_mutex_lock (&pool->lock);
+
+  pool->closed = TRUE;
+  g_slist_free_full (pool->cached, g_free);
+  g_slist_free (pool->cached_sizes);
+  pool->cached = pool->cached_sizes = NULL;
+  pool->num_cached = 0;
+
+  _output_pool_unref_locked (pool);
+}
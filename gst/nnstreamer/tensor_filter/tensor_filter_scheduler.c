@@ -0,0 +1,315 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	tensor_filter_scheduler.c
+ * @date	14 Oct 2026
+ * @brief	Process-wide arbitration of the accelerators shared by tensor_filter instances
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ */
+
+#include <string.h>
+#include <nnstreamer_log.h>
+#include "tensor_filter_scheduler.h"
+
+/**
+ * @brief The weight of the latest invoke time in the average.
+ */
+#define SCHED_AVG_WEIGHT (0.125)
+
+/**
+ * @brief The accelerator shared by the filters.
+ */
+typedef struct
+{
+  accl_hw hw; /**< the accelerator */
+  guint num_clients; /**< the number of the registered filters */
+
+  GMutex lock; /**< lock for the device */
+  GCond cond; /**< signaled when the device is handed over */
+  gboolean busy; /**< TRUE while an invoke is running on the device */
+  GQueue waiting; /**< the invokes waiting for the device (GstTensorFilterSchedWaiter) */
+  guint64 ticket; /**< the order of the arrival, to keep FIFO among the same priority and virtual time */
+  gdouble vtime; /**< the virtual time of the device, the start tag of the latest invoke */
+
+  gdouble avg_invoke_time; /**< the moving average (usec) of the invoke time */
+  gint64 start_time; /**< the time (usec) the device is registered */
+  gint64 busy_since; /**< the time (usec) the device becomes busy */
+  gint64 busy_time; /**< the busy time (usec) of the device except the running one */
+  guint64 invoke_num; /**< the number of invokes */
+  guint64 fallback_num; /**< the number of invokes falling back to CPU */
+} GstTensorFilterSchedDevice;
+
+/**
+ * @brief The filter registered on the shared accelerator.
+ */
+struct _GstTensorFilterSchedClient
+{
+  GstTensorFilterSchedDevice *dev; /**< the device */
+  gint priority; /**< the priority of the invokes */
+  guint weight; /**< the share among the filters of the same priority */
+  gdouble vtime; /**< the virtual finish time of the latest invoke of the filter */
+  gint64 invoke_start; /**< the time (usec) the running invoke acquires the device */
+};
+
+/**
+ * @brief The invoke waiting for the device.
+ */
+typedef struct
+{
+  GstTensorFilterSchedClient *client; /**< the filter */
+  gdouble vtime; /**< the virtual start time of the invoke */
+  guint64 ticket; /**< the order of the arrival */
+  gboolean granted; /**< TRUE if the device is handed over to this invoke */
+} GstTensorFilterSchedWaiter;
+
+static GMutex sched_lock;
+static GHashTable *sched_devices = NULL;
+
+/**
+ * @brief Check the accelerator is arbitrated among the filters (GPU and NPU).
+ */
+gboolean
+gst_tensor_filter_scheduler_is_shared (accl_hw hw)
+{
+  return (hw == ACCL_GPU || (hw & ACCL_NPU) == ACCL_NPU);
+}
+
+/**
+ * @brief Register the filter on the shared accelerator.
+ */
+GstTensorFilterSchedClient *
+gst_tensor_filter_scheduler_register (accl_hw hw, gint priority, guint weight)
+{
+  GstTensorFilterSchedDevice *dev;
+  GstTensorFilterSchedClient *client;
+
+  if (!gst_tensor_filter_scheduler_is_shared (hw))
+    return NULL;
+
+  g_mutex_lock (&sched_lock);
+  if (!sched_devices)
+    sched_devices = g_hash_table_new (g_direct_hash, g_direct_equal);
+
+  dev = (GstTensorFilterSchedDevice *) g_hash_table_lookup (sched_devices,
+      GINT_TO_POINTER (hw));
+  if (!dev) {
+    dev = g_new0 (GstTensorFilterSchedDevice, 1);
+    dev->hw = hw;
+    g_mutex_init (&dev->lock);
+    g_cond_init (&dev->cond);
+    g_queue_init (&dev->waiting);
+    dev->start_time = g_get_monotonic_time ();
+    g_hash_table_insert (sched_devices, GINT_TO_POINTER (hw), dev);
+  }
+  dev->num_clients++;
+  g_mutex_unlock (&sched_lock);
+
+  client = g_new0 (GstTensorFilterSchedClient, 1);
+  client->dev = dev;
+  client->priority = priority;
+  client->weight = MAX (weight, 1U);
+
+  nns_logd ("Registered the filter on the accelerator %s (priority %d, weight %u).",
+      get_accl_hw_str (hw), client->priority, client->weight);
+  return client;
+}
+
+/**
+ * @brief Unregister the filter, the device is released with the last filter.
+ */
+void
+gst_tensor_filter_scheduler_unregister (GstTensorFilterSchedClient * client)
+{
+  GstTensorFilterSchedDevice *dev;
+
+  if (!client)
+    return;
+
+  dev = client->dev;
+
+  g_mutex_lock (&sched_lock);
+  if (--dev->num_clients == 0) {
+    g_hash_table_remove (sched_devices, GINT_TO_POINTER (dev->hw));
+
+    /* no invoke is running, the filters are stopped */
+    g_mutex_clear (&dev->lock);
+    g_cond_clear (&dev->cond);
+    g_free (dev);
+  }
+  g_mutex_unlock (&sched_lock);
+
+  g_free (client);
+}
+
+/**
+ * @brief Check the waiter goes before the other.
+ */
+static gboolean
+_sched_waiter_is_prior (const GstTensorFilterSchedWaiter * w1,
+    const GstTensorFilterSchedWaiter * w2)
+{
+  if (w1->client->priority != w2->client->priority)
+    return w1->client->priority > w2->client->priority;
+  if (w1->vtime != w2->vtime)
+    return w1->vtime < w2->vtime;
+  return w1->ticket < w2->ticket;
+}
+
+/**
+ * @brief Hand over the device to the next waiter. The lock of the device should be held.
+ */
+static void
+_sched_grant_next (GstTensorFilterSchedDevice * dev, gint64 now)
+{
+  GstTensorFilterSchedWaiter *next = NULL, *w;
+  GList *l;
+
+  for (l = dev->waiting.head; l; l = l->next) {
+    w = (GstTensorFilterSchedWaiter *) l->data;
+    if (!next || _sched_waiter_is_prior (w, next))
+      next = w;
+  }
+
+  if (!next) {
+    dev->busy = FALSE;
+    dev->busy_time += now - dev->busy_since;
+    return;
+  }
+
+  g_queue_remove (&dev->waiting, next);
+  next->granted = TRUE;
+  g_cond_broadcast (&dev->cond);
+}
+
+/**
+ * @brief Set the device is acquired by the client. The lock of the device should be held.
+ */
+static void
+_sched_start_invoke (GstTensorFilterSchedClient * client, gdouble vtime)
+{
+  GstTensorFilterSchedDevice *dev = client->dev;
+
+  dev->vtime = MAX (dev->vtime, vtime);
+  client->invoke_start = g_get_monotonic_time ();
+}
+
+/**
+ * @brief Wait for the turn of the filter to invoke on the device.
+ */
+gboolean
+gst_tensor_filter_scheduler_acquire (GstTensorFilterSchedClient * client,
+    guint64 budget)
+{
+  GstTensorFilterSchedDevice *dev;
+  GstTensorFilterSchedWaiter waiter;
+  gdouble vtime;
+
+  g_return_val_if_fail (client != NULL, FALSE);
+  dev = client->dev;
+
+  g_mutex_lock (&dev->lock);
+
+  /* the idle filter does not keep the credit of the past */
+  vtime = MAX (client->vtime, dev->vtime);
+
+  if (!dev->busy) {
+    dev->busy = TRUE;
+    dev->busy_since = g_get_monotonic_time ();
+    _sched_start_invoke (client, vtime);
+    g_mutex_unlock (&dev->lock);
+    return TRUE;
+  }
+
+  if (budget > 0 && dev->avg_invoke_time > 0.0) {
+    gdouble wait = dev->avg_invoke_time * (dev->waiting.length + 1);
+
+    if (wait > (gdouble) budget) {
+      dev->fallback_num++;
+      g_mutex_unlock (&dev->lock);
+      return FALSE;
+    }
+  }
+
+  waiter.client = client;
+  waiter.vtime = vtime;
+  waiter.ticket = dev->ticket++;
+  waiter.granted = FALSE;
+  g_queue_push_tail (&dev->waiting, &waiter);
+
+  while (!waiter.granted)
+    g_cond_wait (&dev->cond, &dev->lock);
+
+  _sched_start_invoke (client, vtime);
+  g_mutex_unlock (&dev->lock);
+  return TRUE;
+}
+
+/**
+ * @brief Release the device after the invoke, the next filter in the queue is woken up.
+ */
+void
+gst_tensor_filter_scheduler_release (GstTensorFilterSchedClient * client)
+{
+  GstTensorFilterSchedDevice *dev;
+  gint64 now, elapsed;
+
+  g_return_if_fail (client != NULL);
+  dev = client->dev;
+
+  g_mutex_lock (&dev->lock);
+  now = g_get_monotonic_time ();
+  elapsed = now - client->invoke_start;
+
+  if (dev->invoke_num == 0)
+    dev->avg_invoke_time = (gdouble) elapsed;
+  else
+    dev->avg_invoke_time += SCHED_AVG_WEIGHT *
+        ((gdouble) elapsed - dev->avg_invoke_time);
+  dev->invoke_num++;
+
+  /* the filter with the larger weight advances the virtual time slowly */
+  client->vtime = MAX (client->vtime, dev->vtime) +
+      (gdouble) elapsed / client->weight;
+
+  _sched_grant_next (dev, now);
+  g_mutex_unlock (&dev->lock);
+}
+
+/**
+ * @brief Get the statistics of the device used by the filter.
+ */
+void
+gst_tensor_filter_scheduler_get_stats (GstTensorFilterSchedClient * client,
+    GstTensorFilterSchedStats * stats)
+{
+  GstTensorFilterSchedDevice *dev;
+  gint64 now, busy, total;
+
+  g_return_if_fail (stats != NULL);
+  memset (stats, 0, sizeof (GstTensorFilterSchedStats));
+
+  if (!client)
+    return;
+
+  dev = client->dev;
+
+  g_mutex_lock (&sched_lock);
+  stats->num_clients = dev->num_clients;
+  g_mutex_unlock (&sched_lock);
+
+  g_mutex_lock (&dev->lock);
+  now = g_get_monotonic_time ();
+  busy = dev->busy_time + (dev->busy ? now - dev->busy_since : 0);
+  total = now - dev->start_time;
+
+  stats->hw = dev->hw;
+  stats->utilization = (total > 0) ? MIN ((gdouble) busy / total, 1.0) : 0.0;
+  stats->invoke_num = dev->invoke_num;
+  stats->fallback_num = dev->fallback_num;
+  stats->queued = dev->waiting.length;
+  stats->avg_invoke_time = (gint64) dev->avg_invoke_time;
+  g_mutex_unlock (&dev->lock);
+}
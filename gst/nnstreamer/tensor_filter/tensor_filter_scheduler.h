@@ -0,0 +1,89 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	tensor_filter_scheduler.h
+ * @date	14 Oct 2026
+ * @brief	Process-wide arbitration of the accelerators shared by tensor_filter instances
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ *
+ * The invokes of the filters using the same accelerator (GPU or NPU) are
+ * queued per device. The filter with the higher priority goes first, and the
+ * filters of the same priority share the device in proportion to the weight
+ * (start-time fair queueing with the invoke time as the cost).
+ * The device runs one invoke at a time.
+ */
+
+#ifndef __TENSOR_FILTER_SCHEDULER_H__
+#define __TENSOR_FILTER_SCHEDULER_H__
+
+#include <glib.h>
+#include "nnstreamer_plugin_api_filter.h"
+
+G_BEGIN_DECLS
+
+/**
+ * @brief The filter registered on the shared accelerator.
+ */
+typedef struct _GstTensorFilterSchedClient GstTensorFilterSchedClient;
+
+/**
+ * @brief Statistics of the shared accelerator.
+ */
+typedef struct
+{
+  accl_hw hw; /**< the accelerator */
+  gdouble utilization; /**< the ratio (0 to 1) of the time the device is busy since the first filter is registered */
+  guint64 invoke_num; /**< the number of invokes on the device */
+  guint64 fallback_num; /**< the number of invokes falling back to CPU because of the latency budget */
+  guint queued; /**< the number of invokes waiting for the device */
+  guint num_clients; /**< the number of filters registered on the device */
+  gint64 avg_invoke_time; /**< the average invoke time (usec) on the device, 0 if unknown */
+} GstTensorFilterSchedStats;
+
+/**
+ * @brief Check the accelerator is arbitrated among the filters (GPU and NPU).
+ */
+extern gboolean
+gst_tensor_filter_scheduler_is_shared (accl_hw hw);
+
+/**
+ * @brief Register the filter on the shared accelerator.
+ * @param hw The accelerator used by the filter.
+ * @param priority The priority of the invokes, the higher goes first.
+ * @param weight The share of the device among the filters of the same priority (larger than 0).
+ * @return The client, NULL if the accelerator is not shared. Free it with gst_tensor_filter_scheduler_unregister().
+ */
+extern GstTensorFilterSchedClient *
+gst_tensor_filter_scheduler_register (accl_hw hw, gint priority, guint weight);
+
+/**
+ * @brief Unregister the filter, the device is released with the last filter.
+ */
+extern void
+gst_tensor_filter_scheduler_unregister (GstTensorFilterSchedClient * client);
+
+/**
+ * @brief Wait for the turn of the filter to invoke on the device.
+ * @param budget The latency budget (usec) to wait for the device, 0 to wait anyway.
+ * @return TRUE if the device is acquired. FALSE if the estimated wait exceeds the budget, then the caller should invoke on CPU (the device is not acquired).
+ */
+extern gboolean
+gst_tensor_filter_scheduler_acquire (GstTensorFilterSchedClient * client, guint64 budget);
+
+/**
+ * @brief Release the device after the invoke, the next filter in the queue is woken up.
+ */
+extern void
+gst_tensor_filter_scheduler_release (GstTensorFilterSchedClient * client);
+
+/**
+ * @brief Get the statistics of the device used by the filter.
+ */
+extern void
+gst_tensor_filter_scheduler_get_stats (GstTensorFilterSchedClient * client, GstTensorFilterSchedStats * stats);
+
+G_END_DECLS
+#endif /* __TENSOR_FILTER_SCHEDULER_H__ */
@@ -54,6 +54,9 @@ typedef struct _GTensorFilterSinglePrivate
 {
   GstTensorFilterPrivate filter_priv; /**< Internal properties for tensor-filter */
   gboolean allocate_in_invoke;  /**< cached value after first invoke */
+  gboolean bound; /**< TRUE if the memory of the caller is bound */
+  GstTensorMemory bound_input[NNS_TENSOR_SIZE_LIMIT]; /**< the bound input memory */
+  GstTensorMemory bound_output[NNS_TENSOR_SIZE_LIMIT]; /**< the bound output memory */
 } GTensorFilterSinglePrivate;
 
 #define G_TENSOR_FILTER_SINGLE_PRIV(obj) ((GTensorFilterSinglePrivate *) (obj)->priv)
@@ -81,6 +84,10 @@ static void g_tensor_filter_destroy_notify (GTensorFilterSingle * self,
 static gboolean g_tensor_filter_allocate_in_invoke (GTensorFilterSingle * self);
 static gboolean g_tensor_filter_single_start (GTensorFilterSingle * self);
 static gboolean g_tensor_filter_single_stop (GTensorFilterSingle * self);
+static gboolean g_tensor_filter_single_bind (GTensorFilterSingle * self,
+    const GstTensorMemory * input, GstTensorMemory * output);
+static gboolean g_tensor_filter_single_invoke_bound (GTensorFilterSingle *
+    self);
 
 /**
  * @brief initialize the tensor_filter's class
@@ -106,6 +113,8 @@ g_tensor_filter_single_class_init (GTensorFilterSingleClass * klass)
   klass->set_input_info = g_tensor_filter_set_input_info;
   klass->destroy_notify = g_tensor_filter_destroy_notify;
   klass->allocate_in_invoke = g_tensor_filter_allocate_in_invoke;
+  klass->bind = g_tensor_filter_single_bind;
+  klass->invoke_bound = g_tensor_filter_single_invoke_bound;
 }
 
 /**
@@ -124,6 +133,7 @@ g_tensor_filter_single_init (GTensorFilterSingle * self)
 
   gst_tensor_filter_common_init_property (priv);
   spriv->allocate_in_invoke = FALSE;
+  spriv->bound = FALSE;
 }
 
 /**
@@ -284,6 +294,7 @@ g_tensor_filter_single_stop (GTensorFilterSingle * self)
 
   /** close framework, unload model */
   gst_tensor_filter_common_close_fw (priv);
+  spriv->bound = FALSE;
   return TRUE;
 }
 
@@ -426,7 +437,101 @@ g_tensor_filter_set_input_info (GTensorFilterSingle * self,
   if (status == 0) {
     gst_tensors_info_copy (&priv->prop.input_meta, in_info);
     gst_tensors_info_copy (&priv->prop.output_meta, out_info);
+
+    /* the bound memory may not fit the new tensors */
+    spriv->bound = FALSE;
   }
 
   return status;
 }
+
+/**
+ * @brief Bind the input and output memory of the caller, to invoke without validation, allocation and copy
+ * @param self "this" pointer
+ * @param input memory containing input data, NULL to unbind
+ * @param output memory to put output data into, NULL to unbind
+ * @return TRUE if the memory is bound (or unbound).
+ * @note The caller should keep the memory until unbound, and should not call invoke_bound at the same time.
+ */
+static gboolean
+g_tensor_filter_single_bind (GTensorFilterSingle * self,
+    const GstTensorMemory * input, GstTensorMemory * output)
+{
+  GTensorFilterSinglePrivate *spriv;
+  GstTensorFilterPrivate *priv;
+  GstTensorInfo *info;
+  guint i;
+
+  spriv = G_TENSOR_FILTER_SINGLE_PRIV (self);
+  priv = &spriv->filter_priv;
+
+  spriv->bound = FALSE;
+  if (input == NULL && output == NULL)
+    return TRUE;
+
+  g_return_val_if_fail (input != NULL && output != NULL, FALSE);
+
+  /** start if not already started */
+  if (!priv->configured) {
+    if (!g_tensor_filter_single_start (self))
+      return FALSE;
+  }
+
+  if (spriv->allocate_in_invoke) {
+    ml_loge ("Cannot bind the memory, the framework allocates the output.");
+    return FALSE;
+  }
+
+  if (!gst_tensors_info_validate (&priv->prop.input_meta) ||
+      !gst_tensors_info_validate (&priv->prop.output_meta)) {
+    ml_loge ("Cannot bind the memory, the tensors info is not configured.");
+    return FALSE;
+  }
+
+  for (i = 0; i < priv->prop.input_meta.num_tensors; i++) {
+    info = &priv->prop.input_meta.info[i];
+
+    if (!input[i].data || input[i].size != gst_tensor_info_get_size (info)) {
+      ml_loge ("Invalid input memory to bind, index %u.", i);
+      return FALSE;
+    }
+    spriv->bound_input[i] = input[i];
+  }
+
+  for (i = 0; i < priv->prop.output_meta.num_tensors; i++) {
+    info = &priv->prop.output_meta.info[i];
+
+    if (!output[i].data || output[i].size != gst_tensor_info_get_size (info)) {
+      ml_loge ("Invalid output memory to bind, index %u.", i);
+      return FALSE;
+    }
+    spriv->bound_output[i] = output[i];
+  }
+
+  spriv->bound = TRUE;
+  return TRUE;
+}
+
+/**
+ * @brief Invoke the filter with the bound memory
+ * @param self "this" pointer
+ * @return TRUE if there is no error.
+ */
+static gboolean
+g_tensor_filter_single_invoke_bound (GTensorFilterSingle * self)
+{
+  GTensorFilterSinglePrivate *spriv;
+  GstTensorFilterPrivate *priv;
+  gint status;
+
+  spriv = G_TENSOR_FILTER_SINGLE_PRIV (self);
+  priv = &spriv->filter_priv;
+
+  if (G_UNLIKELY (!spriv->bound))
+    return FALSE;
+
+  GST_TF_FW_INVOKE_COMPAT (priv, status, spriv->bound_input,
+      spriv->bound_output);
+
+  return (status == 0);
+}
@@ -81,6 +81,15 @@ struct _GTensorFilterSingleClass
   gboolean (*allocate_in_invoke) (GTensorFilterSingle * self);
   /** Free the data allocated by the tensor filter in invoke */
   void (*destroy_notify) (GTensorFilterSingle * self, GstTensorMemory * mem);
+  /**
+   * Bind the input and output memory owned by the caller for invoke_bound.
+   * The memory is validated once here, and it should be kept until unbound (NULL to unbind).
+   * Fails if the filter allocates the output in invoke.
+   */
+  gboolean (*bind) (GTensorFilterSingle * self, const GstTensorMemory * input,
+      GstTensorMemory * output);
+  /** Invoke the filter with the bound memory, without validation, allocation and copy. */
+  gboolean (*invoke_bound) (GTensorFilterSingle * self);
 };
 
 /**
@@ -126,6 +126,44 @@ tensor_filter_subplugin::get_tfsp_with_checks (void *ptr)
   return t;
 }
 
+/**
+ * @brief Get tensor_filter_subplugin pointer with some sanity checks, without exception
+ */
+tensor_filter_subplugin *
+tensor_filter_subplugin::get_tfsp (void *ptr) noexcept
+{
+  tensor_filter_subplugin *t = (tensor_filter_subplugin *)ptr;
+  if (!t || t->sanity != _SANITY_CHECK || t->fwdesc.v1.subplugin_data != nullptr) {
+    nns_loge ("tfsp pointer is invalid");
+    return nullptr;
+  }
+
+  return t;
+}
+
+/**
+ * @brief Get the error code of the exception thrown by invoke. Call this in the catch block.
+ */
+int
+tensor_filter_subplugin::handle_invoke_exception () noexcept
+{
+  try {
+    throw;
+  } catch (const std::invalid_argument &e) {
+    _RETURN_ERR_WITH_MSG (-EINVAL, e.what ());
+  } catch (const std::system_error &e) {
+    _RETURN_ERR_WITH_MSG (e.code ().value () * -1, e.what ());
+  } catch (const std::runtime_error &e) {
+    _RETURN_ERR_WITH_MSG (-EINVAL, e.what ());
+  } catch (const std::exception &e) {
+    _RETURN_ERR_WITH_MSG (-EINVAL, e.what ());
+  } catch (...) {
+    _RETURN_ERR_WITH_MSG (-EINVAL, "Unknown exception in invoke");
+  }
+
+  return -EINVAL;
+}
+
 /**
  * @brief C tensor-filter wrapper callback function, "close"
  */
@@ -166,14 +204,8 @@ tensor_filter_subplugin::cpp_invoke (const GstTensorFilterFramework *tf,
 
   try {
     obj->invoke (input, output);
-  } catch (const std::invalid_argument &e) {
-    _RETURN_ERR_WITH_MSG (-EINVAL, e.what ());
-  } catch (const std::system_error &e) {
-    _RETURN_ERR_WITH_MSG (e.code ().value () * -1, e.what ());
-  } catch (const std::runtime_error &e) {
-    _RETURN_ERR_WITH_MSG (-EINVAL, e.what ());
-  } catch (const std::exception &e) {
-    _RETURN_ERR_WITH_MSG (-EINVAL, e.what ());
+  } catch (...) {
+    return handle_invoke_exception ();
   }
 
   return 0;
@@ -0,0 +1,1299 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	tensor_kernels.c
+ * @date	14 Oct 2026
+ * @brief	Internal dispatch table of the SIMD kernels selected with the CPU features at runtime
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ *
+ * The x86 kernels are compiled with the target attribute, so the library
+ * built for the baseline (e.g., x86-64 with SSE2) uses AVX2 or AVX-512
+ * if the running CPU supports it.
+ */
+
+#include <math.h>
+#include <hw_accel.h>
+#include <nnstreamer_log.h>
+#include "tensor_kernels.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <immintrin.h>
+#define KERNEL_X86_ENABLED
+#define KERNEL_TARGET(isa) __attribute__ ((target (isa)))
+#if defined(__clang__) || (__GNUC__ >= 7)
+#define KERNEL_AVX512_ENABLED
+#endif
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define KERNEL_NEON_ENABLED
+#endif
+
+/**
+ * @brief Initialize the summary.
+ */
+static inline void
+kernel_f32_summary_init (GstTensorKernelSummary * s)
+{
+  s->min = INFINITY;
+  s->max = -INFINITY;
+  s->sum = 0.0;
+  s->nan_count = 0;
+  s->inf_count = 0;
+}
+
+/**
+ * @brief Merge the partial summary (the number of the non-finite values includes NaN).
+ */
+static inline void
+kernel_f32_summary_merge (GstTensorKernelSummary * s, gfloat mn, gfloat mx,
+    gfloat sum, gsize nan_count, gsize nonfinite_count)
+{
+  s->min = MIN (s->min, mn);
+  s->max = MAX (s->max, mx);
+  s->sum += (gdouble) sum;
+  s->nan_count += nan_count;
+  s->inf_count += nonfinite_count - nan_count;
+}
+
+/**
+ * @brief Summarize the values with the branchless loop (also for the remainders of the SIMD kernels).
+ */
+static inline void
+kernel_f32_summary_scalar (const gfloat * src, gsize num,
+    GstTensorKernelSummary * s)
+{
+  gfloat mn = INFINITY, mx = -INFINITY, sum = 0.0f;
+  gsize i, nan_count = 0, nonfinite_count = 0;
+
+  for (i = 0; i < num; i++) {
+    gfloat v = src[i];
+    int is_nan = (v != v);
+    int fin = (fabsf (v) < INFINITY);
+
+    nan_count += is_nan;
+    nonfinite_count += !fin;
+    sum += fin ? v : 0.0f;
+    mn = (fin && v < mn) ? v : mn;
+    mx = (fin && v > mx) ? v : mx;
+  }
+
+  kernel_f32_summary_merge (s, mn, mx, sum, nan_count, nonfinite_count);
+}
+
+/**
+ * @brief Get the index of the first largest value with the f32_max kernel.
+ */
+static inline gsize
+kernel_f32_argmax_with_max (const gfloat * src, gsize num, gfloat * max,
+    gfloat (*f32_max) (const gfloat *, gsize))
+{
+  gsize i;
+  gfloat mx;
+
+  /* the sequential search never updates the max if the first one is NaN */
+  if (isnan (src[0])) {
+    *max = src[0];
+    return 0;
+  }
+
+  /* the max is not NaN, and at least the first value is compared */
+  mx = f32_max (src, num);
+  for (i = 0; i < num; i++) {
+    if (src[i] == mx)
+      break;
+  }
+
+  *max = mx;
+  return i;
+}
+
+/** @brief uint8 to float32, generic */
+static void
+kernel_u8_to_f32_generic (const guint8 * src, gfloat * dst, gsize num)
+{
+  gsize i;
+
+  for (i = 0; i < num; i++)
+    dst[i] = (gfloat) src[i];
+}
+
+/** @brief float32 max, generic */
+static gfloat
+kernel_f32_max_generic (const gfloat * src, gsize num)
+{
+  gfloat mx = -INFINITY;
+  gsize i;
+
+  for (i = 0; i < num; i++)
+    mx = (src[i] > mx) ? src[i] : mx;
+
+  return mx;
+}
+
+/** @brief float32 argmax, generic */
+static gsize
+kernel_f32_argmax_generic (const gfloat * src, gsize num, gfloat * max)
+{
+  gfloat mx = src[0];
+  gsize i, idx = 0;
+
+  for (i = 1; i < num; i++) {
+    if (src[i] > mx) {
+      mx = src[i];
+      idx = i;
+    }
+  }
+
+  *max = mx;
+  return idx;
+}
+
+/** @brief float32 summary, generic */
+static void
+kernel_f32_summary_generic (const gfloat * src, gsize num,
+    GstTensorKernelSummary * s)
+{
+  kernel_f32_summary_init (s);
+  kernel_f32_summary_scalar (src, num, s);
+}
+
+/** @brief uint8 sum of absolute differences, generic */
+static guint64
+kernel_u8_sad_generic (const guint8 * a, const guint8 * b, gsize num)
+{
+  guint64 sad = 0;
+  gsize i;
+
+  for (i = 0; i < num; i++)
+    sad += (a[i] > b[i]) ? (a[i] - b[i]) : (b[i] - a[i]);
+
+  return sad;
+}
+
+/** @brief Clip the quantized value to the range, NaN goes to the minimum like the max of SIMD */
+static inline gfloat
+kernel_quantize_clip (gfloat v, gfloat lo, gfloat hi)
+{
+  v = (v > lo) ? v : lo;
+  return (v < hi) ? v : hi;
+}
+
+/** @brief float32 to int8 quantization, generic */
+static void
+kernel_f32_quantize_s8_generic (const gfloat * src, gint8 * dst, gsize num,
+    const gfloat * inv_scale, const gfloat * zero_point)
+{
+  gsize i;
+
+  for (i = 0; i < num; i++)
+    dst[i] = (gint8) lrintf (kernel_quantize_clip (src[i] * inv_scale[i] +
+            zero_point[i], -128.0f, 127.0f));
+}
+
+/** @brief float32 to uint8 quantization, generic */
+static void
+kernel_f32_quantize_u8_generic (const gfloat * src, guint8 * dst, gsize num,
+    const gfloat * inv_scale, const gfloat * zero_point)
+{
+  gsize i;
+
+  for (i = 0; i < num; i++)
+    dst[i] = (guint8) lrintf (kernel_quantize_clip (src[i] * inv_scale[i] +
+            zero_point[i], 0.0f, 255.0f));
+}
+
+/** @brief int8 to float32 dequantization, generic */
+static void
+kernel_s8_dequantize_generic (const gint8 * src, gfloat * dst, gsize num,
+    const gfloat * scale, const gfloat * zero_point)
+{
+  gsize i;
+
+  for (i = 0; i < num; i++)
+    dst[i] = ((gfloat) src[i] - zero_point[i]) * scale[i];
+}
+
+/** @brief uint8 to float32 dequantization, generic */
+static void
+kernel_u8_dequantize_generic (const guint8 * src, gfloat * dst, gsize num,
+    const gfloat * scale, const gfloat * zero_point)
+{
+  gsize i;
+
+  for (i = 0; i < num; i++)
+    dst[i] = ((gfloat) src[i] - zero_point[i]) * scale[i];
+}
+
+/** @brief Row of 4:2:0 YUV to RGB float32, generic */
+static void
+kernel_yuv420_to_rgb_f32_generic (const guint8 * y, const guint8 * u,
+    const guint8 * v, gsize uv_step, gfloat * dst, gsize width,
+    const gfloat * coef)
+{
+  gfloat l, cu, cv;
+  gsize i;
+
+  for (i = 0; i < width; i++) {
+    l = ((gfloat) y[i] - coef[1]) * coef[0];
+    cu = (gfloat) u[(i / 2) * uv_step] - 128.0f;
+    cv = (gfloat) v[(i / 2) * uv_step] - 128.0f;
+
+    dst[3 * i] = kernel_quantize_clip (l + coef[2] * cv, 0.0f, 255.0f);
+    dst[3 * i + 1] = kernel_quantize_clip (l - coef[3] * cu - coef[4] * cv,
+        0.0f, 255.0f);
+    dst[3 * i + 2] = kernel_quantize_clip (l + coef[5] * cu, 0.0f, 255.0f);
+  }
+}
+
+/** @brief Deinterleave int16 to planar float32, generic */
+static void
+kernel_s16_deinterleave_f32_generic (const gint16 * src, gfloat * dst,
+    gsize frames, guint channels, gsize dst_stride)
+{
+  const gfloat norm = 1.0f / 32768.0f;
+  gsize i;
+  guint c;
+
+  for (c = 0; c < channels; c++) {
+    for (i = 0; i < frames; i++)
+      dst[c * dst_stride + i] = (gfloat) src[i * channels + c] * norm;
+  }
+}
+
+/** @brief Gather 4 chroma samples of 8 pixels into an integer */
+static inline guint32
+kernel_yuv420_chroma (const guint8 * c, gsize step)
+{
+  return (guint32) c[0] | ((guint32) c[step] << 8) |
+      ((guint32) c[2 * step] << 16) | ((guint32) c[3 * step] << 24);
+}
+
+#if defined(KERNEL_X86_ENABLED)
+/** @brief uint8 to float32, SSE4.1 */
+KERNEL_TARGET ("sse4.1")
+static void
+kernel_u8_to_f32_sse41 (const guint8 * src, gfloat * dst, gsize num)
+{
+  gsize i = 0;
+
+  for (; i + 16 <= num; i += 16) {
+    __m128i v = _mm_loadu_si128 ((const __m128i *) (src + i));
+
+    _mm_storeu_ps (dst + i, _mm_cvtepi32_ps (_mm_cvtepu8_epi32 (v)));
+    _mm_storeu_ps (dst + i + 4,
+        _mm_cvtepi32_ps (_mm_cvtepu8_epi32 (_mm_srli_si128 (v, 4))));
+    _mm_storeu_ps (dst + i + 8,
+        _mm_cvtepi32_ps (_mm_cvtepu8_epi32 (_mm_srli_si128 (v, 8))));
+    _mm_storeu_ps (dst + i + 12,
+        _mm_cvtepi32_ps (_mm_cvtepu8_epi32 (_mm_srli_si128 (v, 12))));
+  }
+
+  kernel_u8_to_f32_generic (src + i, dst + i, num - i);
+}
+
+/** @brief Horizontal max of the vector, SSE4.1 */
+KERNEL_TARGET ("sse4.1")
+static inline gfloat
+kernel_hmax_sse41 (__m128 v)
+{
+  v = _mm_max_ps (v, _mm_movehl_ps (v, v));
+  v = _mm_max_ss (v, _mm_shuffle_ps (v, v, 1));
+  return _mm_cvtss_f32 (v);
+}
+
+/** @brief float32 max, SSE4.1 */
+KERNEL_TARGET ("sse4.1")
+static gfloat
+kernel_f32_max_sse41 (const gfloat * src, gsize num)
+{
+  __m128 vmax = _mm_set1_ps (-INFINITY);
+  gfloat mx;
+  gsize i = 0;
+
+  /* maxps returns the second operand (the max so far) if the value is NaN */
+  for (; i + 4 <= num; i += 4)
+    vmax = _mm_max_ps (_mm_loadu_ps (src + i), vmax);
+
+  mx = kernel_hmax_sse41 (vmax);
+  return MAX (mx, kernel_f32_max_generic (src + i, num - i));
+}
+
+/** @brief float32 argmax, SSE4.1 */
+KERNEL_TARGET ("sse4.1")
+static gsize
+kernel_f32_argmax_sse41 (const gfloat * src, gsize num, gfloat * max)
+{
+  return kernel_f32_argmax_with_max (src, num, max, kernel_f32_max_sse41);
+}
+
+/** @brief float32 summary, SSE4.1 */
+KERNEL_TARGET ("sse4.1")
+static void
+kernel_f32_summary_sse41 (const gfloat * src, gsize num,
+    GstTensorKernelSummary * s)
+{
+  const __m128 vinf = _mm_set1_ps (INFINITY);
+  const __m128 vninf = _mm_set1_ps (-INFINITY);
+  const __m128 vabs = _mm_castsi128_ps (_mm_set1_epi32 (0x7fffffff));
+  __m128 vmin = vinf, vmax = vninf, vsum = _mm_setzero_ps ();
+  gfloat t[4], sum;
+  gsize i = 0, nan_count = 0, nonfinite_count = 0;
+
+  kernel_f32_summary_init (s);
+
+  for (; i + 4 <= num; i += 4) {
+    __m128 x = _mm_loadu_ps (src + i);
+    __m128 fin = _mm_cmplt_ps (_mm_and_ps (x, vabs), vinf);
+
+    nan_count += __builtin_popcount (_mm_movemask_ps (_mm_cmpunord_ps (x, x)));
+    nonfinite_count += 4 - __builtin_popcount (_mm_movemask_ps (fin));
+    vsum = _mm_add_ps (vsum, _mm_and_ps (x, fin));
+    vmin = _mm_min_ps (vmin, _mm_blendv_ps (vinf, x, fin));
+    vmax = _mm_max_ps (vmax, _mm_blendv_ps (vninf, x, fin));
+  }
+
+  vmin = _mm_min_ps (vmin, _mm_movehl_ps (vmin, vmin));
+  vmin = _mm_min_ss (vmin, _mm_shuffle_ps (vmin, vmin, 1));
+  _mm_storeu_ps (t, vsum);
+  sum = (t[0] + t[1]) + (t[2] + t[3]);
+
+  kernel_f32_summary_merge (s, _mm_cvtss_f32 (vmin), kernel_hmax_sse41 (vmax),
+      sum, nan_count, nonfinite_count);
+  kernel_f32_summary_scalar (src + i, num - i, s);
+}
+
+/** @brief uint8 sum of absolute differences, SSE4.1 */
+KERNEL_TARGET ("sse4.1")
+static guint64
+kernel_u8_sad_sse41 (const guint8 * a, const guint8 * b, gsize num)
+{
+  __m128i vsad = _mm_setzero_si128 ();
+  guint64 lanes[2];
+  gsize i = 0;
+
+  /* psadbw sums 8 bytes into each 64-bit lane, no overflow */
+  for (; i + 16 <= num; i += 16)
+    vsad = _mm_add_epi64 (vsad,
+        _mm_sad_epu8 (_mm_loadu_si128 ((const __m128i *) (a + i)),
+            _mm_loadu_si128 ((const __m128i *) (b + i))));
+
+  /* the 64-bit extract is not available in 32-bit x86 */
+  _mm_storeu_si128 ((__m128i *) lanes, vsad);
+  return lanes[0] + lanes[1] + kernel_u8_sad_generic (a + i, b + i, num - i);
+}
+
+/** @brief Quantize 4 values to int32 in the range, SSE4.1 */
+KERNEL_TARGET ("sse4.1")
+static inline __m128i
+kernel_quantize_sse41 (const gfloat * src, const gfloat * inv_scale,
+    const gfloat * zero_point, __m128 lo, __m128 hi)
+{
+  __m128 v = _mm_add_ps (_mm_mul_ps (_mm_loadu_ps (src),
+          _mm_loadu_ps (inv_scale)), _mm_loadu_ps (zero_point));
+
+  /* maxps gives the second operand (lo) for NaN */
+  return _mm_cvtps_epi32 (_mm_min_ps (_mm_max_ps (v, lo), hi));
+}
+
+/** @brief float32 to int8 quantization, SSE4.1 */
+KERNEL_TARGET ("sse4.1")
+static void
+kernel_f32_quantize_s8_sse41 (const gfloat * src, gint8 * dst, gsize num,
+    const gfloat * inv_scale, const gfloat * zero_point)
+{
+  const __m128 lo = _mm_set1_ps (-128.0f), hi = _mm_set1_ps (127.0f);
+  __m128i q0, q1, q2, q3;
+  gsize i = 0;
+
+  for (; i + 16 <= num; i += 16) {
+    q0 = kernel_quantize_sse41 (src + i, inv_scale + i, zero_point + i, lo, hi);
+    q1 = kernel_quantize_sse41 (src + i + 4, inv_scale + i + 4,
+        zero_point + i + 4, lo, hi);
+    q2 = kernel_quantize_sse41 (src + i + 8, inv_scale + i + 8,
+        zero_point + i + 8, lo, hi);
+    q3 = kernel_quantize_sse41 (src + i + 12, inv_scale + i + 12,
+        zero_point + i + 12, lo, hi);
+
+    _mm_storeu_si128 ((__m128i *) (dst + i),
+        _mm_packs_epi16 (_mm_packs_epi32 (q0, q1), _mm_packs_epi32 (q2, q3)));
+  }
+
+  kernel_f32_quantize_s8_generic (src + i, dst + i, num - i, inv_scale + i,
+      zero_point + i);
+}
+
+/** @brief float32 to uint8 quantization, SSE4.1 */
+KERNEL_TARGET ("sse4.1")
+static void
+kernel_f32_quantize_u8_sse41 (const gfloat * src, guint8 * dst, gsize num,
+    const gfloat * inv_scale, const gfloat * zero_point)
+{
+  const __m128 lo = _mm_set1_ps (0.0f), hi = _mm_set1_ps (255.0f);
+  __m128i q0, q1, q2, q3;
+  gsize i = 0;
+
+  for (; i + 16 <= num; i += 16) {
+    q0 = kernel_quantize_sse41 (src + i, inv_scale + i, zero_point + i, lo, hi);
+    q1 = kernel_quantize_sse41 (src + i + 4, inv_scale + i + 4,
+        zero_point + i + 4, lo, hi);
+    q2 = kernel_quantize_sse41 (src + i + 8, inv_scale + i + 8,
+        zero_point + i + 8, lo, hi);
+    q3 = kernel_quantize_sse41 (src + i + 12, inv_scale + i + 12,
+        zero_point + i + 12, lo, hi);
+
+    _mm_storeu_si128 ((__m128i *) (dst + i),
+        _mm_packus_epi16 (_mm_packs_epi32 (q0, q1), _mm_packs_epi32 (q2, q3)));
+  }
+
+  kernel_f32_quantize_u8_generic (src + i, dst + i, num - i, inv_scale + i,
+      zero_point + i);
+}
+
+/** @brief Dequantize 4 values of int32, SSE4.1 */
+KERNEL_TARGET ("sse4.1")
+static inline void
+kernel_dequantize_sse41 (__m128i q, gfloat * dst, const gfloat * scale,
+    const gfloat * zero_point)
+{
+  _mm_storeu_ps (dst, _mm_mul_ps (_mm_sub_ps (_mm_cvtepi32_ps (q),
+              _mm_loadu_ps (zero_point)), _mm_loadu_ps (scale)));
+}
+
+/** @brief int8 to float32 dequantization, SSE4.1 */
+KERNEL_TARGET ("sse4.1")
+static void
+kernel_s8_dequantize_sse41 (const gint8 * src, gfloat * dst, gsize num,
+    const gfloat * scale, const gfloat * zero_point)
+{
+  gsize i = 0, k;
+
+  for (; i + 16 <= num; i += 16) {
+    __m128i v = _mm_loadu_si128 ((const __m128i *) (src + i));
+
+    for (k = 0; k < 16; k += 4) {
+      kernel_dequantize_sse41 (_mm_cvtepi8_epi32 (v), dst + i + k,
+          scale + i + k, zero_point + i + k);
+      v = _mm_srli_si128 (v, 4);
+    }
+  }
+
+  kernel_s8_dequantize_generic (src + i, dst + i, num - i, scale + i,
+      zero_point + i);
+}
+
+/** @brief uint8 to float32 dequantization, SSE4.1 */
+KERNEL_TARGET ("sse4.1")
+static void
+kernel_u8_dequantize_sse41 (const guint8 * src, gfloat * dst, gsize num,
+    const gfloat * scale, const gfloat * zero_point)
+{
+  gsize i = 0, k;
+
+  for (; i + 16 <= num; i += 16) {
+    __m128i v = _mm_loadu_si128 ((const __m128i *) (src + i));
+
+    for (k = 0; k < 16; k += 4) {
+      kernel_dequantize_sse41 (_mm_cvtepu8_epi32 (v), dst + i + k,
+          scale + i + k, zero_point + i + k);
+      v = _mm_srli_si128 (v, 4);
+    }
+  }
+
+  kernel_u8_dequantize_generic (src + i, dst + i, num - i, scale + i,
+      zero_point + i);
+}
+
+/** @brief Convert 4 pixels to RGB and store them interleaved, SSE4.1 */
+KERNEL_TARGET ("sse4.1")
+static inline void
+kernel_yuv_to_rgb_sse41 (__m128 l, __m128 cu, __m128 cv, const gfloat * coef,
+    gfloat * dst)
+{
+  const __m128 lo = _mm_setzero_ps ();
+  const __m128 hi = _mm_set1_ps (255.0f);
+  __m128 r, g, b, t0, t1, t2;
+
+  r = _mm_add_ps (l, _mm_mul_ps (_mm_set1_ps (coef[2]), cv));
+  g = _mm_sub_ps (_mm_sub_ps (l, _mm_mul_ps (_mm_set1_ps (coef[3]), cu)),
+      _mm_mul_ps (_mm_set1_ps (coef[4]), cv));
+  b = _mm_add_ps (l, _mm_mul_ps (_mm_set1_ps (coef[5]), cu));
+
+  r = _mm_min_ps (_mm_max_ps (r, lo), hi);
+  g = _mm_min_ps (_mm_max_ps (g, lo), hi);
+  b = _mm_min_ps (_mm_max_ps (b, lo), hi);
+
+  /* r0 g0 b0 r1 | g1 b1 r2 g2 | b2 r3 g3 b3 */
+  t0 = _mm_unpacklo_ps (r, g);
+  t1 = _mm_unpackhi_ps (r, g);
+  t2 = _mm_shuffle_ps (b, t0, _MM_SHUFFLE (2, 2, 0, 0));
+  _mm_storeu_ps (dst, _mm_shuffle_ps (t0, t2, _MM_SHUFFLE (2, 0, 1, 0)));
+  t2 = _mm_shuffle_ps (t0, b, _MM_SHUFFLE (1, 1, 3, 3));
+  _mm_storeu_ps (dst + 4, _mm_shuffle_ps (t2, t1, _MM_SHUFFLE (1, 0, 2, 0)));
+  t2 = _mm_shuffle_ps (b, t1, _MM_SHUFFLE (2, 2, 2, 2));
+  t1 = _mm_shuffle_ps (t1, b, _MM_SHUFFLE (3, 3, 3, 3));
+  _mm_storeu_ps (dst + 8, _mm_shuffle_ps (t2, t1, _MM_SHUFFLE (2, 0, 2, 0)));
+}
+
+/** @brief Row of 4:2:0 YUV to RGB float32, SSE4.1 */
+KERNEL_TARGET ("sse4.1")
+static void
+kernel_yuv420_to_rgb_f32_sse41 (const guint8 * y, const guint8 * u,
+    const guint8 * v, gsize uv_step, gfloat * dst, gsize width,
+    const gfloat * coef)
+{
+  const __m128 scale = _mm_set1_ps (coef[0]);
+  const __m128 offset = _mm_set1_ps (coef[1]);
+  const __m128 center = _mm_set1_ps (128.0f);
+  gsize i = 0, k;
+
+  for (; i + 8 <= width; i += 8) {
+    __m128i vy = _mm_loadl_epi64 ((const __m128i *) (y + i));
+    __m128i vu = _mm_cvtsi32_si128 ((int)
+        kernel_yuv420_chroma (u + (i / 2) * uv_step, uv_step));
+    __m128i vv = _mm_cvtsi32_si128 ((int)
+        kernel_yuv420_chroma (v + (i / 2) * uv_step, uv_step));
+
+    /* a chroma sample for 2 pixels */
+    vu = _mm_unpacklo_epi8 (vu, vu);
+    vv = _mm_unpacklo_epi8 (vv, vv);
+
+    for (k = 0; k < 8; k += 4) {
+      __m128 l = _mm_mul_ps (_mm_sub_ps (_mm_cvtepi32_ps (_mm_cvtepu8_epi32
+                  (vy)), offset), scale);
+      __m128 cu = _mm_sub_ps (_mm_cvtepi32_ps (_mm_cvtepu8_epi32 (vu)), center);
+      __m128 cv = _mm_sub_ps (_mm_cvtepi32_ps (_mm_cvtepu8_epi32 (vv)), center);
+
+      kernel_yuv_to_rgb_sse41 (l, cu, cv, coef, dst + 3 * (i + k));
+      vy = _mm_srli_si128 (vy, 4);
+      vu = _mm_srli_si128 (vu, 4);
+      vv = _mm_srli_si128 (vv, 4);
+    }
+  }
+
+  kernel_yuv420_to_rgb_f32_generic (y + i, u + (i / 2) * uv_step,
+      v + (i / 2) * uv_step, uv_step, dst + 3 * i, width - i, coef);
+}
+
+/** @brief Deinterleave int16 to planar float32, SSE4.1 (mono and stereo) */
+KERNEL_TARGET ("sse4.1")
+static void
+kernel_s16_deinterleave_f32_sse41 (const gint16 * src, gfloat * dst,
+    gsize frames, guint channels, gsize dst_stride)
+{
+  const __m128 norm = _mm_set1_ps (1.0f / 32768.0f);
+  gsize i = 0;
+
+  if (channels == 1) {
+    for (; i + 8 <= frames; i += 8) {
+      __m128i v = _mm_loadu_si128 ((const __m128i *) (src + i));
+
+      _mm_storeu_ps (dst + i,
+          _mm_mul_ps (_mm_cvtepi32_ps (_mm_cvtepi16_epi32 (v)), norm));
+      _mm_storeu_ps (dst + i + 4, _mm_mul_ps (_mm_cvtepi32_ps
+              (_mm_cvtepi16_epi32 (_mm_srli_si128 (v, 8))), norm));
+    }
+  } else if (channels == 2) {
+    for (; i + 4 <= frames; i += 4) {
+      __m128i v = _mm_loadu_si128 ((const __m128i *) (src + 2 * i));
+
+      /* the left sample is the low half of the 32-bit frame */
+      _mm_storeu_ps (dst + i, _mm_mul_ps (_mm_cvtepi32_ps (_mm_srai_epi32
+                  (_mm_slli_epi32 (v, 16), 16)), norm));
+      _mm_storeu_ps (dst + dst_stride + i,
+          _mm_mul_ps (_mm_cvtepi32_ps (_mm_srai_epi32 (v, 16)), norm));
+    }
+
+    kernel_s16_deinterleave_f32_generic (src + 2 * i, dst + i, frames - i, 2,
+        dst_stride);
+    return;
+  }
+
+  kernel_s16_deinterleave_f32_generic (src + i * channels, dst + i,
+      frames - i, channels, dst_stride);
+}
+
+/** @brief uint8 to float32, AVX2 */
+KERNEL_TARGET ("avx2")
+static void
+kernel_u8_to_f32_avx2 (const guint8 * src, gfloat * dst, gsize num)
+{
+  gsize i = 0;
+
+  for (; i + 16 <= num; i += 16) {
+    __m128i v = _mm_loadu_si128 ((const __m128i *) (src + i));
+
+    _mm256_storeu_ps (dst + i, _mm256_cvtepi32_ps (_mm256_cvtepu8_epi32 (v)));
+    _mm256_storeu_ps (dst + i + 8,
+        _mm256_cvtepi32_ps (_mm256_cvtepu8_epi32 (_mm_srli_si128 (v, 8))));
+  }
+
+  kernel_u8_to_f32_generic (src + i, dst + i, num - i);
+}
+
+/** @brief float32 max, AVX2 */
+KERNEL_TARGET ("avx2")
+static gfloat
+kernel_f32_max_avx2 (const gfloat * src, gsize num)
+{
+  __m256 vmax = _mm256_set1_ps (-INFINITY);
+  gfloat mx;
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8)
+    vmax = _mm256_max_ps (_mm256_loadu_ps (src + i), vmax);
+
+  mx = kernel_hmax_sse41 (_mm_max_ps (_mm256_castps256_ps128 (vmax),
+          _mm256_extractf128_ps (vmax, 1)));
+  return MAX (mx, kernel_f32_max_generic (src + i, num - i));
+}
+
+/** @brief float32 argmax, AVX2 */
+KERNEL_TARGET ("avx2")
+static gsize
+kernel_f32_argmax_avx2 (const gfloat * src, gsize num, gfloat * max)
+{
+  return kernel_f32_argmax_with_max (src, num, max, kernel_f32_max_avx2);
+}
+
+/** @brief float32 summary, AVX2 */
+KERNEL_TARGET ("avx2")
+static void
+kernel_f32_summary_avx2 (const gfloat * src, gsize num,
+    GstTensorKernelSummary * s)
+{
+  const __m256 vinf = _mm256_set1_ps (INFINITY);
+  const __m256 vninf = _mm256_set1_ps (-INFINITY);
+  const __m256 vabs = _mm256_castsi256_ps (_mm256_set1_epi32 (0x7fffffff));
+  __m256 vmin = vinf, vmax = vninf, vsum = _mm256_setzero_ps ();
+  gfloat tmin[8], tmax[8], tsum[8], mn, mx, sum;
+  gsize i = 0, k, nan_count = 0, nonfinite_count = 0;
+
+  kernel_f32_summary_init (s);
+
+  for (; i + 8 <= num; i += 8) {
+    __m256 x = _mm256_loadu_ps (src + i);
+    __m256 fin = _mm256_cmp_ps (_mm256_and_ps (x, vabs), vinf, _CMP_LT_OQ);
+
+    nan_count += __builtin_popcount (_mm256_movemask_ps (_mm256_cmp_ps (x, x,
+                _CMP_UNORD_Q)));
+    nonfinite_count += 8 - __builtin_popcount (_mm256_movemask_ps (fin));
+    vsum = _mm256_add_ps (vsum, _mm256_and_ps (x, fin));
+    vmin = _mm256_min_ps (vmin, _mm256_blendv_ps (vinf, x, fin));
+    vmax = _mm256_max_ps (vmax, _mm256_blendv_ps (vninf, x, fin));
+  }
+
+  _mm256_storeu_ps (tmin, vmin);
+  _mm256_storeu_ps (tmax, vmax);
+  _mm256_storeu_ps (tsum, vsum);
+
+  mn = tmin[0];
+  mx = tmax[0];
+  sum = tsum[0];
+  for (k = 1; k < 8; k++) {
+    mn = MIN (mn, tmin[k]);
+    mx = MAX (mx, tmax[k]);
+    sum += tsum[k];
+  }
+
+  kernel_f32_summary_merge (s, mn, mx, sum, nan_count, nonfinite_count);
+  kernel_f32_summary_scalar (src + i, num - i, s);
+}
+
+/** @brief uint8 sum of absolute differences, AVX2 */
+KERNEL_TARGET ("avx2")
+static guint64
+kernel_u8_sad_avx2 (const guint8 * a, const guint8 * b, gsize num)
+{
+  __m256i vsad = _mm256_setzero_si256 ();
+  guint64 lanes[2];
+  gsize i = 0;
+
+  for (; i + 32 <= num; i += 32)
+    vsad = _mm256_add_epi64 (vsad,
+        _mm256_sad_epu8 (_mm256_loadu_si256 ((const __m256i *) (a + i)),
+            _mm256_loadu_si256 ((const __m256i *) (b + i))));
+
+  _mm_storeu_si128 ((__m128i *) lanes,
+      _mm_add_epi64 (_mm256_castsi256_si128 (vsad),
+          _mm256_extracti128_si256 (vsad, 1)));
+  return lanes[0] + lanes[1] + kernel_u8_sad_generic (a + i, b + i, num - i);
+}
+
+/** @brief Quantize 8 values to int32 in the range, AVX2 */
+KERNEL_TARGET ("avx2")
+static inline __m256i
+kernel_quantize_avx2 (const gfloat * src, const gfloat * inv_scale,
+    const gfloat * zero_point, __m256 lo, __m256 hi)
+{
+  __m256 v = _mm256_add_ps (_mm256_mul_ps (_mm256_loadu_ps (src),
+          _mm256_loadu_ps (inv_scale)), _mm256_loadu_ps (zero_point));
+
+  return _mm256_cvtps_epi32 (_mm256_min_ps (_mm256_max_ps (v, lo), hi));
+}
+
+/**
+ * @brief Pack 32 values of int32 to 16 bits with saturation, AVX2.
+ * The packs of AVX2 work in each 128-bit lane, the result is in the order of 32-bit groups 0,2,4,6,1,3,5,7.
+ */
+KERNEL_TARGET ("avx2")
+static inline void
+kernel_quantize_pack_avx2 (const gfloat * src, const gfloat * inv_scale,
+    const gfloat * zero_point, __m256 lo, __m256 hi, __m256i * q01,
+    __m256i * q23)
+{
+  *q01 = _mm256_packs_epi32 (kernel_quantize_avx2 (src, inv_scale, zero_point,
+          lo, hi), kernel_quantize_avx2 (src + 8, inv_scale + 8,
+          zero_point + 8, lo, hi));
+  *q23 = _mm256_packs_epi32 (kernel_quantize_avx2 (src + 16, inv_scale + 16,
+          zero_point + 16, lo, hi), kernel_quantize_avx2 (src + 24,
+          inv_scale + 24, zero_point + 24, lo, hi));
+}
+
+/** @brief float32 to int8 quantization, AVX2 */
+KERNEL_TARGET ("avx2")
+static void
+kernel_f32_quantize_s8_avx2 (const gfloat * src, gint8 * dst, gsize num,
+    const gfloat * inv_scale, const gfloat * zero_point)
+{
+  const __m256 lo = _mm256_set1_ps (-128.0f), hi = _mm256_set1_ps (127.0f);
+  const __m256i order = _mm256_setr_epi32 (0, 4, 1, 5, 2, 6, 3, 7);
+  __m256i q01, q23;
+  gsize i = 0;
+
+  for (; i + 32 <= num; i += 32) {
+    kernel_quantize_pack_avx2 (src + i, inv_scale + i, zero_point + i, lo, hi,
+        &q01, &q23);
+    _mm256_storeu_si256 ((__m256i *) (dst + i),
+        _mm256_permutevar8x32_epi32 (_mm256_packs_epi16 (q01, q23), order));
+  }
+
+  kernel_f32_quantize_s8_sse41 (src + i, dst + i, num - i, inv_scale + i,
+      zero_point + i);
+}
+
+/** @brief float32 to uint8 quantization, AVX2 */
+KERNEL_TARGET ("avx2")
+static void
+kernel_f32_quantize_u8_avx2 (const gfloat * src, guint8 * dst, gsize num,
+    const gfloat * inv_scale, const gfloat * zero_point)
+{
+  const __m256 lo = _mm256_set1_ps (0.0f), hi = _mm256_set1_ps (255.0f);
+  const __m256i order = _mm256_setr_epi32 (0, 4, 1, 5, 2, 6, 3, 7);
+  __m256i q01, q23;
+  gsize i = 0;
+
+  for (; i + 32 <= num; i += 32) {
+    kernel_quantize_pack_avx2 (src + i, inv_scale + i, zero_point + i, lo, hi,
+        &q01, &q23);
+    _mm256_storeu_si256 ((__m256i *) (dst + i),
+        _mm256_permutevar8x32_epi32 (_mm256_packus_epi16 (q01, q23), order));
+  }
+
+  kernel_f32_quantize_u8_sse41 (src + i, dst + i, num - i, inv_scale + i,
+      zero_point + i);
+}
+
+/** @brief Dequantize 8 values of int32, AVX2 */
+KERNEL_TARGET ("avx2")
+static inline void
+kernel_dequantize_avx2 (__m256i q, gfloat * dst, const gfloat * scale,
+    const gfloat * zero_point)
+{
+  _mm256_storeu_ps (dst, _mm256_mul_ps (_mm256_sub_ps (_mm256_cvtepi32_ps (q),
+              _mm256_loadu_ps (zero_point)), _mm256_loadu_ps (scale)));
+}
+
+/** @brief int8 to float32 dequantization, AVX2 */
+KERNEL_TARGET ("avx2")
+static void
+kernel_s8_dequantize_avx2 (const gint8 * src, gfloat * dst, gsize num,
+    const gfloat * scale, const gfloat * zero_point)
+{
+  gsize i = 0;
+
+  for (; i + 16 <= num; i += 16) {
+    __m128i v = _mm_loadu_si128 ((const __m128i *) (src + i));
+
+    kernel_dequantize_avx2 (_mm256_cvtepi8_epi32 (v), dst + i, scale + i,
+        zero_point + i);
+    kernel_dequantize_avx2 (_mm256_cvtepi8_epi32 (_mm_srli_si128 (v, 8)),
+        dst + i + 8, scale + i + 8, zero_point + i + 8);
+  }
+
+  kernel_s8_dequantize_generic (src + i, dst + i, num - i, scale + i,
+      zero_point + i);
+}
+
+/** @brief uint8 to float32 dequantization, AVX2 */
+KERNEL_TARGET ("avx2")
+static void
+kernel_u8_dequantize_avx2 (const guint8 * src, gfloat * dst, gsize num,
+    const gfloat * scale, const gfloat * zero_point)
+{
+  gsize i = 0;
+
+  for (; i + 16 <= num; i += 16) {
+    __m128i v = _mm_loadu_si128 ((const __m128i *) (src + i));
+
+    kernel_dequantize_avx2 (_mm256_cvtepu8_epi32 (v), dst + i, scale + i,
+        zero_point + i);
+    kernel_dequantize_avx2 (_mm256_cvtepu8_epi32 (_mm_srli_si128 (v, 8)),
+        dst + i + 8, scale + i + 8, zero_point + i + 8);
+  }
+
+  kernel_u8_dequantize_generic (src + i, dst + i, num - i, scale + i,
+      zero_point + i);
+}
+
+/** @brief Deinterleave int16 to planar float32, AVX2 (mono and stereo) */
+KERNEL_TARGET ("avx2")
+static void
+kernel_s16_deinterleave_f32_avx2 (const gint16 * src, gfloat * dst,
+    gsize frames, guint channels, gsize dst_stride)
+{
+  const __m256 norm = _mm256_set1_ps (1.0f / 32768.0f);
+  gsize i = 0;
+
+  if (channels == 1) {
+    for (; i + 16 <= frames; i += 16) {
+      __m128i lo = _mm_loadu_si128 ((const __m128i *) (src + i));
+      __m128i hi = _mm_loadu_si128 ((const __m128i *) (src + i + 8));
+
+      _mm256_storeu_ps (dst + i, _mm256_mul_ps (_mm256_cvtepi32_ps
+              (_mm256_cvtepi16_epi32 (lo)), norm));
+      _mm256_storeu_ps (dst + i + 8, _mm256_mul_ps (_mm256_cvtepi32_ps
+              (_mm256_cvtepi16_epi32 (hi)), norm));
+    }
+  } else if (channels == 2) {
+    for (; i + 8 <= frames; i += 8) {
+      __m256i v = _mm256_loadu_si256 ((const __m256i *) (src + 2 * i));
+
+      /* the left sample is the low half of the 32-bit frame */
+      _mm256_storeu_ps (dst + i, _mm256_mul_ps (_mm256_cvtepi32_ps
+              (_mm256_srai_epi32 (_mm256_slli_epi32 (v, 16), 16)), norm));
+      _mm256_storeu_ps (dst + dst_stride + i,
+          _mm256_mul_ps (_mm256_cvtepi32_ps (_mm256_srai_epi32 (v, 16)),
+              norm));
+    }
+
+    kernel_s16_deinterleave_f32_generic (src + 2 * i, dst + i, frames - i, 2,
+        dst_stride);
+    return;
+  }
+
+  kernel_s16_deinterleave_f32_generic (src + i * channels, dst + i,
+      frames - i, channels, dst_stride);
+}
+
+#if defined(KERNEL_AVX512_ENABLED)
+/** @brief uint8 to float32, AVX-512 */
+KERNEL_TARGET ("avx512f")
+static void
+kernel_u8_to_f32_avx512 (const guint8 * src, gfloat * dst, gsize num)
+{
+  gsize i = 0;
+
+  for (; i + 16 <= num; i += 16) {
+    __m128i v = _mm_loadu_si128 ((const __m128i *) (src + i));
+
+    _mm512_storeu_ps (dst + i, _mm512_cvtepi32_ps (_mm512_cvtepu8_epi32 (v)));
+  }
+
+  kernel_u8_to_f32_generic (src + i, dst + i, num - i);
+}
+
+/** @brief float32 max, AVX-512 */
+KERNEL_TARGET ("avx512f")
+static gfloat
+kernel_f32_max_avx512 (const gfloat * src, gsize num)
+{
+  __m512 vmax = _mm512_set1_ps (-INFINITY);
+  gfloat mx;
+  gsize i = 0;
+
+  for (; i + 16 <= num; i += 16)
+    vmax = _mm512_max_ps (_mm512_loadu_ps (src + i), vmax);
+
+  mx = _mm512_reduce_max_ps (vmax);
+  return MAX (mx, kernel_f32_max_generic (src + i, num - i));
+}
+
+/** @brief float32 argmax, AVX-512 */
+KERNEL_TARGET ("avx512f")
+static gsize
+kernel_f32_argmax_avx512 (const gfloat * src, gsize num, gfloat * max)
+{
+  return kernel_f32_argmax_with_max (src, num, max, kernel_f32_max_avx512);
+}
+#endif /* KERNEL_AVX512_ENABLED */
+#endif /* KERNEL_X86_ENABLED */
+
+#if defined(KERNEL_NEON_ENABLED)
+/** @brief uint8 to float32, NEON */
+static void
+kernel_u8_to_f32_neon (const guint8 * src, gfloat * dst, gsize num)
+{
+  gsize i = 0;
+
+  for (; i + 16 <= num; i += 16) {
+    uint8x16_t v = vld1q_u8 (src + i);
+    uint16x8_t lo = vmovl_u8 (vget_low_u8 (v));
+    uint16x8_t hi = vmovl_u8 (vget_high_u8 (v));
+
+    vst1q_f32 (dst + i, vcvtq_f32_u32 (vmovl_u16 (vget_low_u16 (lo))));
+    vst1q_f32 (dst + i + 4, vcvtq_f32_u32 (vmovl_u16 (vget_high_u16 (lo))));
+    vst1q_f32 (dst + i + 8, vcvtq_f32_u32 (vmovl_u16 (vget_low_u16 (hi))));
+    vst1q_f32 (dst + i + 12, vcvtq_f32_u32 (vmovl_u16 (vget_high_u16 (hi))));
+  }
+
+  kernel_u8_to_f32_generic (src + i, dst + i, num - i);
+}
+
+/** @brief float32 max, NEON */
+static gfloat
+kernel_f32_max_neon (const gfloat * src, gsize num)
+{
+  float32x4_t vmax = vdupq_n_f32 (-INFINITY);
+  gfloat mx;
+  gsize i = 0;
+
+  /* fmaxnm returns the number if the other one is NaN */
+  for (; i + 4 <= num; i += 4)
+    vmax = vmaxnmq_f32 (vmax, vld1q_f32 (src + i));
+
+  mx = vmaxnmvq_f32 (vmax);
+  return MAX (mx, kernel_f32_max_generic (src + i, num - i));
+}
+
+/** @brief float32 argmax, NEON */
+static gsize
+kernel_f32_argmax_neon (const gfloat * src, gsize num, gfloat * max)
+{
+  return kernel_f32_argmax_with_max (src, num, max, kernel_f32_max_neon);
+}
+
+/** @brief uint8 sum of absolute differences, NEON */
+static guint64
+kernel_u8_sad_neon (const guint8 * a, const guint8 * b, gsize num)
+{
+  uint64x2_t vsad = vdupq_n_u64 (0);
+  gsize i = 0;
+
+  for (; i + 16 <= num; i += 16) {
+    uint8x16_t d = vabdq_u8 (vld1q_u8 (a + i), vld1q_u8 (b + i));
+
+    vsad = vpadalq_u32 (vsad, vpaddlq_u16 (vpaddlq_u8 (d)));
+  }
+
+  return vaddvq_u64 (vsad) + kernel_u8_sad_generic (a + i, b + i, num - i);
+}
+
+/** @brief Quantize 8 values to int16 in the range, NEON */
+static inline int16x8_t
+kernel_quantize_neon (const gfloat * src, const gfloat * inv_scale,
+    const gfloat * zero_point, float32x4_t lo, float32x4_t hi)
+{
+  float32x4_t v0 = vaddq_f32 (vmulq_f32 (vld1q_f32 (src),
+          vld1q_f32 (inv_scale)), vld1q_f32 (zero_point));
+  float32x4_t v1 = vaddq_f32 (vmulq_f32 (vld1q_f32 (src + 4),
+          vld1q_f32 (inv_scale + 4)), vld1q_f32 (zero_point + 4));
+
+  /* fmaxnm gives the number (lo) for NaN, fcvtns rounds to the nearest even */
+  v0 = vminq_f32 (vmaxnmq_f32 (v0, lo), hi);
+  v1 = vminq_f32 (vmaxnmq_f32 (v1, lo), hi);
+  return vcombine_s16 (vqmovn_s32 (vcvtnq_s32_f32 (v0)),
+      vqmovn_s32 (vcvtnq_s32_f32 (v1)));
+}
+
+/** @brief float32 to int8 quantization, NEON */
+static void
+kernel_f32_quantize_s8_neon (const gfloat * src, gint8 * dst, gsize num,
+    const gfloat * inv_scale, const gfloat * zero_point)
+{
+  const float32x4_t lo = vdupq_n_f32 (-128.0f), hi = vdupq_n_f32 (127.0f);
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8)
+    vst1_s8 (dst + i, vqmovn_s16 (kernel_quantize_neon (src + i,
+                inv_scale + i, zero_point + i, lo, hi)));
+
+  kernel_f32_quantize_s8_generic (src + i, dst + i, num - i, inv_scale + i,
+      zero_point + i);
+}
+
+/** @brief float32 to uint8 quantization, NEON */
+static void
+kernel_f32_quantize_u8_neon (const gfloat * src, guint8 * dst, gsize num,
+    const gfloat * inv_scale, const gfloat * zero_point)
+{
+  const float32x4_t lo = vdupq_n_f32 (0.0f), hi = vdupq_n_f32 (255.0f);
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8)
+    vst1_u8 (dst + i, vqmovun_s16 (kernel_quantize_neon (src + i,
+                inv_scale + i, zero_point + i, lo, hi)));
+
+  kernel_f32_quantize_u8_generic (src + i, dst + i, num - i, inv_scale + i,
+      zero_point + i);
+}
+
+/** @brief Dequantize 8 values of int16, NEON */
+static inline void
+kernel_dequantize_neon (int16x8_t q, gfloat * dst, const gfloat * scale,
+    const gfloat * zero_point)
+{
+  float32x4_t v0 = vcvtq_f32_s32 (vmovl_s16 (vget_low_s16 (q)));
+  float32x4_t v1 = vcvtq_f32_s32 (vmovl_s16 (vget_high_s16 (q)));
+
+  vst1q_f32 (dst, vmulq_f32 (vsubq_f32 (v0, vld1q_f32 (zero_point)),
+          vld1q_f32 (scale)));
+  vst1q_f32 (dst + 4, vmulq_f32 (vsubq_f32 (v1, vld1q_f32 (zero_point + 4)),
+          vld1q_f32 (scale + 4)));
+}
+
+/** @brief int8 to float32 dequantization, NEON */
+static void
+kernel_s8_dequantize_neon (const gint8 * src, gfloat * dst, gsize num,
+    const gfloat * scale, const gfloat * zero_point)
+{
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8)
+    kernel_dequantize_neon (vmovl_s8 (vld1_s8 (src + i)), dst + i, scale + i,
+        zero_point + i);
+
+  kernel_s8_dequantize_generic (src + i, dst + i, num - i, scale + i,
+      zero_point + i);
+}
+
+/** @brief uint8 to float32 dequantization, NEON */
+static void
+kernel_u8_dequantize_neon (const guint8 * src, gfloat * dst, gsize num,
+    const gfloat * scale, const gfloat * zero_point)
+{
+  gsize i = 0;
+
+  for (; i + 8 <= num; i += 8)
+    kernel_dequantize_neon (vreinterpretq_s16_u16 (vmovl_u8 (vld1_u8 (src +
+                    i))), dst + i, scale + i, zero_point + i);
+
+  kernel_u8_dequantize_generic (src + i, dst + i, num - i, scale + i,
+      zero_point + i);
+}
+
+/** @brief Convert 4 pixels to RGB and store them interleaved, NEON */
+static inline void
+kernel_yuv_to_rgb_neon (float32x4_t l, float32x4_t cu, float32x4_t cv,
+    const gfloat * coef, gfloat * dst)
+{
+  const float32x4_t lo = vdupq_n_f32 (0.0f);
+  const float32x4_t hi = vdupq_n_f32 (255.0f);
+  float32x4x3_t rgb;
+
+  rgb.val[0] = vaddq_f32 (l, vmulq_n_f32 (cv, coef[2]));
+  rgb.val[1] = vsubq_f32 (vsubq_f32 (l, vmulq_n_f32 (cu, coef[3])),
+      vmulq_n_f32 (cv, coef[4]));
+  rgb.val[2] = vaddq_f32 (l, vmulq_n_f32 (cu, coef[5]));
+
+  rgb.val[0] = vminq_f32 (vmaxq_f32 (rgb.val[0], lo), hi);
+  rgb.val[1] = vminq_f32 (vmaxq_f32 (rgb.val[1], lo), hi);
+  rgb.val[2] = vminq_f32 (vmaxq_f32 (rgb.val[2], lo), hi);
+
+  vst3q_f32 (dst, rgb);
+}
+
+/** @brief Row of 4:2:0 YUV to RGB float32, NEON */
+static void
+kernel_yuv420_to_rgb_f32_neon (const guint8 * y, const guint8 * u,
+    const guint8 * v, gsize uv_step, gfloat * dst, gsize width,
+    const gfloat * coef)
+{
+  const float32x4_t scale = vdupq_n_f32 (coef[0]);
+  const float32x4_t offset = vdupq_n_f32 (coef[1]);
+  const float32x4_t center = vdupq_n_f32 (128.0f);
+  gsize i = 0;
+
+  for (; i + 8 <= width; i += 8) {
+    uint16x8_t vy = vmovl_u8 (vld1_u8 (y + i));
+    uint8x8_t vu = vreinterpret_u8_u32 (vdup_n_u32 (kernel_yuv420_chroma (u +
+                (i / 2) * uv_step, uv_step)));
+    uint8x8_t vv = vreinterpret_u8_u32 (vdup_n_u32 (kernel_yuv420_chroma (v +
+                (i / 2) * uv_step, uv_step)));
+    uint16x8_t wu, wv;
+
+    /* a chroma sample for 2 pixels */
+    wu = vmovl_u8 (vzip_u8 (vu, vu).val[0]);
+    wv = vmovl_u8 (vzip_u8 (vv, vv).val[0]);
+
+    kernel_yuv_to_rgb_neon (vmulq_f32 (vsubq_f32 (vcvtq_f32_u32 (vmovl_u16
+                    (vget_low_u16 (vy))), offset), scale),
+        vsubq_f32 (vcvtq_f32_u32 (vmovl_u16 (vget_low_u16 (wu))), center),
+        vsubq_f32 (vcvtq_f32_u32 (vmovl_u16 (vget_low_u16 (wv))), center),
+        coef, dst + 3 * i);
+    kernel_yuv_to_rgb_neon (vmulq_f32 (vsubq_f32 (vcvtq_f32_u32 (vmovl_u16
+                    (vget_high_u16 (vy))), offset), scale),
+        vsubq_f32 (vcvtq_f32_u32 (vmovl_u16 (vget_high_u16 (wu))), center),
+        vsubq_f32 (vcvtq_f32_u32 (vmovl_u16 (vget_high_u16 (wv))), center),
+        coef, dst + 3 * (i + 4));
+  }
+
+  kernel_yuv420_to_rgb_f32_generic (y + i, u + (i / 2) * uv_step,
+      v + (i / 2) * uv_step, uv_step, dst + 3 * i, width - i, coef);
+}
+
+/** @brief Deinterleave int16 to planar float32, NEON (mono and stereo) */
+static void
+kernel_s16_deinterleave_f32_neon (const gint16 * src, gfloat * dst,
+    gsize frames, guint channels, gsize dst_stride)
+{
+  gsize i = 0;
+
+  if (channels == 1) {
+    for (; i + 8 <= frames; i += 8) {
+      int16x8_t v = vld1q_s16 (src + i);
+
+      vst1q_f32 (dst + i, vcvtq_n_f32_s32 (vmovl_s16 (vget_low_s16 (v)), 15));
+      vst1q_f32 (dst + i + 4,
+          vcvtq_n_f32_s32 (vmovl_s16 (vget_high_s16 (v)), 15));
+    }
+  } else if (channels == 2) {
+    for (; i + 8 <= frames; i += 8) {
+      int16x8x2_t v = vld2q_s16 (src + 2 * i);
+
+      vst1q_f32 (dst + i,
+          vcvtq_n_f32_s32 (vmovl_s16 (vget_low_s16 (v.val[0])), 15));
+      vst1q_f32 (dst + i + 4,
+          vcvtq_n_f32_s32 (vmovl_s16 (vget_high_s16 (v.val[0])), 15));
+      vst1q_f32 (dst + dst_stride + i,
+          vcvtq_n_f32_s32 (vmovl_s16 (vget_low_s16 (v.val[1])), 15));
+      vst1q_f32 (dst + dst_stride + i + 4,
+          vcvtq_n_f32_s32 (vmovl_s16 (vget_high_s16 (v.val[1])), 15));
+    }
+
+    kernel_s16_deinterleave_f32_generic (src + 2 * i, dst + i, frames - i, 2,
+        dst_stride);
+    return;
+  }
+
+  kernel_s16_deinterleave_f32_generic (src + i * channels, dst + i,
+      frames - i, channels, dst_stride);
+}
+
+/** @brief float32 summary, NEON */
+static void
+kernel_f32_summary_neon (const gfloat * src, gsize num,
+    GstTensorKernelSummary * s)
+{
+  const float32x4_t vinf = vdupq_n_f32 (INFINITY);
+  const float32x4_t vninf = vdupq_n_f32 (-INFINITY);
+  float32x4_t vmin = vinf, vmax = vninf, vsum = vdupq_n_f32 (0.0f);
+  gsize i = 0, nan_count = 0, nonfinite_count = 0;
+
+  kernel_f32_summary_init (s);
+
+  for (; i + 4 <= num; i += 4) {
+    float32x4_t x = vld1q_f32 (src + i);
+    uint32x4_t fin = vcltq_f32 (vabsq_f32 (x), vinf);
+    uint32x4_t vnan = vmvnq_u32 (vceqq_f32 (x, x));
+
+    nan_count += vaddvq_u32 (vshrq_n_u32 (vnan, 31));
+    nonfinite_count += 4 - vaddvq_u32 (vshrq_n_u32 (fin, 31));
+    vsum = vaddq_f32 (vsum,
+        vreinterpretq_f32_u32 (vandq_u32 (vreinterpretq_u32_f32 (x), fin)));
+    vmin = vminq_f32 (vmin, vbslq_f32 (fin, x, vinf));
+    vmax = vmaxq_f32 (vmax, vbslq_f32 (fin, x, vninf));
+  }
+
+  kernel_f32_summary_merge (s, vminvq_f32 (vmin), vmaxvq_f32 (vmax),
+      vaddvq_f32 (vsum), nan_count, nonfinite_count);
+  kernel_f32_summary_scalar (src + i, num - i, s);
+}
+#endif /* KERNEL_NEON_ENABLED */
+
+/**
+ * @brief The kernels in the order of the preference, the last one is always available.
+ */
+static const GstTensorKernels kernels_table[] = {
+#if defined(KERNEL_X86_ENABLED)
+#if defined(KERNEL_AVX512_ENABLED)
+  /* the summary with the mask registers is not faster than AVX2, vpsadbw of 512 bits requires AVX512BW */
+  /* the color conversion of a row is bound by the 3-channel interleaving, SSE4.1 is used in AVX2 and AVX-512 */
+  {"avx512f", NNS_CPU_FEATURE_AVX512F | NNS_CPU_FEATURE_AVX2,
+      kernel_u8_to_f32_avx512, kernel_f32_max_avx512, kernel_f32_argmax_avx512,
+      kernel_f32_summary_avx2, kernel_u8_sad_avx2,
+      kernel_f32_quantize_s8_avx2, kernel_f32_quantize_u8_avx2,
+      kernel_s8_dequantize_avx2, kernel_u8_dequantize_avx2,
+      kernel_yuv420_to_rgb_f32_sse41, kernel_s16_deinterleave_f32_avx2},
+#endif
+  {"avx2", NNS_CPU_FEATURE_AVX2,
+      kernel_u8_to_f32_avx2, kernel_f32_max_avx2, kernel_f32_argmax_avx2,
+      kernel_f32_summary_avx2, kernel_u8_sad_avx2,
+      kernel_f32_quantize_s8_avx2, kernel_f32_quantize_u8_avx2,
+      kernel_s8_dequantize_avx2, kernel_u8_dequantize_avx2,
+      kernel_yuv420_to_rgb_f32_sse41, kernel_s16_deinterleave_f32_avx2},
+  {"sse4.1", NNS_CPU_FEATURE_SSE4_1,
+      kernel_u8_to_f32_sse41, kernel_f32_max_sse41, kernel_f32_argmax_sse41,
+      kernel_f32_summary_sse41, kernel_u8_sad_sse41,
+      kernel_f32_quantize_s8_sse41, kernel_f32_quantize_u8_sse41,
+      kernel_s8_dequantize_sse41, kernel_u8_dequantize_sse41,
+      kernel_yuv420_to_rgb_f32_sse41, kernel_s16_deinterleave_f32_sse41},
+#endif
+#if defined(KERNEL_NEON_ENABLED)
+  {"neon", NNS_CPU_FEATURE_NEON,
+      kernel_u8_to_f32_neon, kernel_f32_max_neon, kernel_f32_argmax_neon,
+      kernel_f32_summary_neon, kernel_u8_sad_neon,
+      kernel_f32_quantize_s8_neon, kernel_f32_quantize_u8_neon,
+      kernel_s8_dequantize_neon, kernel_u8_dequantize_neon,
+      kernel_yuv420_to_rgb_f32_neon, kernel_s16_deinterleave_f32_neon},
+#endif
+  {"generic", NNS_CPU_FEATURE_NONE,
+      kernel_u8_to_f32_generic, kernel_f32_max_generic,
+      kernel_f32_argmax_generic, kernel_f32_summary_generic,
+      kernel_u8_sad_generic, kernel_f32_quantize_s8_generic,
+      kernel_f32_quantize_u8_generic, kernel_s8_dequantize_generic,
+      kernel_u8_dequantize_generic, kernel_yuv420_to_rgb_f32_generic,
+      kernel_s16_deinterleave_f32_generic},
+};
+
+/**
+ * @brief Get the best kernels using the given CPU features only.
+ */
+const GstTensorKernels *
+gst_tensor_kernels_lookup (guint features)
+{
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (kernels_table); i++) {
+    if ((kernels_table[i].features & features) == kernels_table[i].features)
+      return &kernels_table[i];
+  }
+
+  return &kernels_table[G_N_ELEMENTS (kernels_table) - 1];
+}
+
+/**
+ * @brief Get the kernels for the CPU features of the running CPU.
+ */
+const GstTensorKernels *
+gst_tensor_kernels_get (void)
+{
+  static gsize init = 0;
+  static const GstTensorKernels *kernels = NULL;
+
+  if (g_once_init_enter (&init)) {
+    guint features = cpu_get_features ();
+    gchar *names = cpu_get_features_string (features);
+
+    kernels = gst_tensor_kernels_lookup (features);
+    nns_logd ("The tensor kernels for %s are selected (CPU features: %s).",
+        kernels->name, names);
+
+    g_free (names);
+    g_once_init_leave (&init, 1);
+  }
+
+  return kernels;
+}
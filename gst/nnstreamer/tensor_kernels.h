@@ -0,0 +1,132 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	tensor_kernels.h
+ * @date	14 Oct 2026
+ * @brief	Internal dispatch table of the SIMD kernels selected with the CPU features at runtime
+ * @see		https://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ *
+ * The kernels are built for several instruction sets (generic C, SSE4.1,
+ * AVX2 and AVX-512 on x86, NEON on aarch64) regardless of the compiler
+ * flags, and the best one for the running CPU is selected once.
+ * The data may be unaligned.
+ */
+
+#ifndef __NNS_TENSOR_KERNELS_H__
+#define __NNS_TENSOR_KERNELS_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+/**
+ * @brief The summary of the float32 values by the kernel.
+ */
+typedef struct
+{
+  gfloat min; /**< the minimum of the finite values (INFINITY if none) */
+  gfloat max; /**< the maximum of the finite values (-INFINITY if none) */
+  gdouble sum; /**< the sum of the finite values */
+  gsize nan_count; /**< the number of NaN */
+  gsize inf_count; /**< the number of infinite values */
+} GstTensorKernelSummary;
+
+/**
+ * @brief The table of the kernels for an instruction set.
+ */
+typedef struct
+{
+  const gchar *name; /**< the name of the instruction set */
+  guint features; /**< the CPU features required (nns_cpu_feature_e) */
+
+  /**
+   * @brief Convert uint8 to float32.
+   */
+  void (*u8_to_f32) (const guint8 * src, gfloat * dst, gsize num);
+
+  /**
+   * @brief Get the largest value, NaN is ignored.
+   * @return The largest value, -INFINITY if no value is compared.
+   */
+  gfloat (*f32_max) (const gfloat * src, gsize num);
+
+  /**
+   * @brief Get the index of the first largest value, same as the sequential search with '>' (NaN is never selected unless the first value is NaN).
+   * @param[in] num The number of the values, should be larger than 0.
+   * @param[out] max The largest value.
+   */
+  gsize (*f32_argmax) (const gfloat * src, gsize num, gfloat * max);
+
+  /**
+   * @brief Get the min, max and sum of the finite values and the number of NaN and infinite values.
+   */
+  void (*f32_summary) (const gfloat * src, gsize num,
+      GstTensorKernelSummary * summary);
+
+  /**
+   * @brief Get the sum of the absolute differences of two uint8 arrays.
+   */
+  guint64 (*u8_sad) (const guint8 * a, const guint8 * b, gsize num);
+
+  /**
+   * @brief Quantize float32 to int8, dst = saturate (round (src * inv_scale + zero_point)).
+   * The parameters are given for each element. The values are rounded to the nearest (ties to even), and NaN goes to the minimum.
+   */
+  void (*f32_quantize_s8) (const gfloat * src, gint8 * dst, gsize num,
+      const gfloat * inv_scale, const gfloat * zero_point);
+
+  /**
+   * @brief Quantize float32 to uint8, same as f32_quantize_s8 with the range of uint8.
+   */
+  void (*f32_quantize_u8) (const gfloat * src, guint8 * dst, gsize num,
+      const gfloat * inv_scale, const gfloat * zero_point);
+
+  /**
+   * @brief Dequantize int8 to float32, dst = (src - zero_point) * scale. The parameters are given for each element.
+   */
+  void (*s8_dequantize) (const gint8 * src, gfloat * dst, gsize num,
+      const gfloat * scale, const gfloat * zero_point);
+
+  /**
+   * @brief Dequantize uint8 to float32, same as s8_dequantize.
+   */
+  void (*u8_dequantize) (const guint8 * src, gfloat * dst, gsize num,
+      const gfloat * scale, const gfloat * zero_point);
+
+  /**
+   * @brief Convert a row of 4:2:0 YUV to interleaved RGB float32 clamped to [0, 255].
+   * The pixel x takes the chroma samples u[(x / 2) * uv_step] and v[(x / 2) * uv_step] (uv_step is 1 for I420, 2 for NV12 and NV21).
+   * @param coef The coefficients {y_scale, y_offset, r_v, g_u, g_v, b_u}, l = (y - y_offset) * y_scale, R = l + r_v * v, G = l - g_u * u - g_v * v, B = l + b_u * u, with the chroma centered at 0.
+   */
+  void (*yuv420_to_rgb_f32) (const guint8 * y, const guint8 * u,
+      const guint8 * v, gsize uv_step, gfloat * dst, gsize width,
+      const gfloat * coef);
+
+  /**
+   * @brief Deinterleave int16 samples to planar float32 normalized to [-1, 1).
+   * The sample of the channel c in the frame i is written to dst[c * dst_stride + i] as src[i * channels + c] / 32768.
+   */
+  void (*s16_deinterleave_f32) (const gint16 * src, gfloat * dst,
+      gsize frames, guint channels, gsize dst_stride);
+} GstTensorKernels;
+
+/**
+ * @brief Get the kernels for the CPU features of the running CPU.
+ * @return The kernels, do not free it.
+ */
+extern const GstTensorKernels *
+gst_tensor_kernels_get (void);
+
+/**
+ * @brief Get the best kernels using the given CPU features only.
+ * @param features The bitmask of nns_cpu_feature_e. The features not supported by the running CPU should not be given.
+ * @return The kernels, the generic one if no instruction set matches.
+ */
+extern const GstTensorKernels *
+gst_tensor_kernels_lookup (guint features);
+
+G_END_DECLS
+#endif /* __NNS_TENSOR_KERNELS_H__ */
@@ -14,6 +14,7 @@
 #include "config.h"
 #endif
 
+#include <string.h>
 #include <nnstreamer_util.h>
 #include "tensor_meta.h"
 
@@ -51,6 +52,12 @@ gst_meta_query_init (GstMeta * meta, gpointer params, GstBuffer * buffer)
   UNUSED (params);
   UNUSED (buffer);
   emeta->client_id = 0;
+  emeta->request_id = -1;
+  emeta->client_send_time = 0;
+  emeta->server_recv_time = 0;
+  emeta->invoke_start_time = 0;
+  emeta->batch_size = 0;
+  emeta->num_items = 0;
   return TRUE;
 }
 
@@ -77,6 +84,20 @@ gst_meta_query_transform (GstBuffer * transbuf, GstMeta * meta,
   UNUSED (type);
   UNUSED (data);
   dest_meta->client_id = src_meta->client_id;
+  dest_meta->request_id = src_meta->request_id;
+  dest_meta->client_send_time = src_meta->client_send_time;
+  dest_meta->server_recv_time = src_meta->server_recv_time;
+  dest_meta->invoke_start_time = src_meta->invoke_start_time;
+  dest_meta->batch_size = src_meta->batch_size;
+  dest_meta->num_items = src_meta->num_items;
+  memcpy (dest_meta->item_client_id, src_meta->item_client_id,
+      sizeof (src_meta->item_client_id));
+  memcpy (dest_meta->item_request_id, src_meta->item_request_id,
+      sizeof (src_meta->item_request_id));
+  memcpy (dest_meta->item_client_send_time, src_meta->item_client_send_time,
+      sizeof (src_meta->item_client_send_time));
+  memcpy (dest_meta->item_server_recv_time, src_meta->item_server_recv_time,
+      sizeof (src_meta->item_server_recv_time));
   return TRUE;
 }
 
@@ -20,6 +20,11 @@ G_BEGIN_DECLS
 
 typedef int64_t query_client_id_t;
 
+/**
+ * @brief The max number of requests in a batched buffer of the query server.
+ */
+#define QUERY_MAX_BATCH 32
+
 /**
  * @brief GstMetaQuery meta structure
  */
@@ -28,6 +33,20 @@ typedef struct
   GstMeta meta;
 
   query_client_id_t client_id;
+  int64_t request_id; /**< sequence number of the request given by the client (-1 if not given) */
+
+  /* timestamps of the request (real time in usec, 0 if not given) */
+  int64_t client_send_time; /**< the client sent the request (client clock) */
+  int64_t server_recv_time; /**< the server received the request (server clock) */
+  int64_t invoke_start_time; /**< tensor_query_serversrc pushed the request (server clock) */
+
+  /* batched requests from multiple clients (tensor_query_serversrc max-batch) */
+  uint32_t batch_size; /**< number of slots in the batched buffer (0 if not batched) */
+  uint32_t num_items; /**< number of valid requests in the batched buffer */
+  query_client_id_t item_client_id[QUERY_MAX_BATCH]; /**< client ID of each request */
+  int64_t item_request_id[QUERY_MAX_BATCH]; /**< sequence number of each request */
+  int64_t item_client_send_time[QUERY_MAX_BATCH]; /**< client_send_time of each request */
+  int64_t item_server_recv_time[QUERY_MAX_BATCH]; /**< server_recv_time of each request */
 } GstMetaQuery;
 
 /**
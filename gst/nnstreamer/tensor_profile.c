@@ -0,0 +1,199 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file    tensor_profile.c
+ * @date    15 Oct 2026
+ * @brief   Counters of the copy, allocation and compute time of nnstreamer elements
+ * @see     http://github.com/nnstreamer/nnstreamer
+ * @author  agent <agent@local>
+ * @bug     No known bugs
+ *
+ * The core elements count the bytes copied with nns_profile_memcpy, the
+ * memory allocated for the outputs and the time spent in the main compute
+ * loops (nns_profile_compute_begin/end) if nnstreamer is built with
+ * -Denable-element-profile=true. Otherwise the macros are compiled out and
+ * the counters are not available.
+ * The counters are kept in the qdata of the element, and are read with
+ * gst_tensor_element_get_profile(), e.g., by the tensormetrics tracer.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <string.h>
+#include "tensor_common.h"
+
+/**
+ * @brief The counters of an element.
+ */
+typedef struct
+{
+  GMutex lock;
+  GstTensorElementProfile profile;
+} GstTensorElementProfileData;
+
+/**
+ * @brief Lock to attach the counters to the element.
+ */
+G_LOCK_DEFINE_STATIC (profile_attach);
+
+/**
+ * @brief Get the quark of the counters.
+ */
+static GQuark
+_profile_quark (void)
+{
+  static GQuark quark = 0;
+
+  if (g_once_init_enter (&quark)) {
+    GQuark q = g_quark_from_static_string ("nnstreamer-element-profile");
+    g_once_init_leave (&quark, q);
+  }
+
+  return quark;
+}
+
+/**
+ * @brief Free the counters with the element.
+ */
+static void
+_profile_data_free (gpointer data)
+{
+  GstTensorElementProfileData *pdata = (GstTensorElementProfileData *) data;
+
+  g_mutex_clear (&pdata->lock);
+  g_free (pdata);
+}
+
+/**
+ * @brief Get the counters of the element.
+ * @param create TRUE to attach new counters to the element if not exist.
+ */
+static GstTensorElementProfileData *
+_profile_data_get (GstElement * element, gboolean create)
+{
+  GstTensorElementProfileData *pdata;
+  GQuark quark = _profile_quark ();
+
+  pdata = (GstTensorElementProfileData *) g_object_get_qdata (G_OBJECT (element),
+      quark);
+  if (pdata || !create)
+    return pdata;
+
+  G_LOCK (profile_attach);
+  pdata = (GstTensorElementProfileData *) g_object_get_qdata (G_OBJECT (element),
+      quark);
+  if (!pdata) {
+    pdata = g_new0 (GstTensorElementProfileData, 1);
+    g_mutex_init (&pdata->lock);
+    g_object_set_qdata_full (G_OBJECT (element), quark, pdata,
+        _profile_data_free);
+  }
+  G_UNLOCK (profile_attach);
+
+  return pdata;
+}
+
+/**
+ * @brief Get the monotonic time in nanoseconds for the compute time.
+ */
+guint64
+gst_tensor_element_profile_now (void)
+{
+  return (guint64) gst_util_get_timestamp ();
+}
+
+/**
+ * @brief Add the value to the counter of the element.
+ */
+void
+gst_tensor_element_profile_add (GstElement * element,
+    GstTensorElementProfileType type, guint64 value)
+{
+  GstTensorElementProfileData *pdata;
+  GstTensorElementProfile *p;
+
+  if (!element)
+    return;
+
+  pdata = _profile_data_get (element, TRUE);
+  p = &pdata->profile;
+
+  g_mutex_lock (&pdata->lock);
+  switch (type) {
+    case GST_TENSOR_PROFILE_MEMCPY:
+      p->memcpy_bytes += value;
+      p->memcpy_count++;
+      break;
+    case GST_TENSOR_PROFILE_ALLOC:
+      p->alloc_bytes += value;
+      p->alloc_count++;
+      break;
+    case GST_TENSOR_PROFILE_COMPUTE:
+      p->compute_ns += value;
+      p->compute_count++;
+      break;
+    default:
+      break;
+  }
+  g_mutex_unlock (&pdata->lock);
+}
+
+/**
+ * @brief Get the counters of the copy, allocation and compute time of the element.
+ */
+gboolean
+gst_tensor_element_get_profile (GstElement * element,
+    GstTensorElementProfile * profile)
+{
+  GstTensorElementProfileData *pdata;
+
+  g_return_val_if_fail (GST_IS_ELEMENT (element), FALSE);
+  g_return_val_if_fail (profile != NULL, FALSE);
+
+  memset (profile, 0, sizeof (GstTensorElementProfile));
+
+  pdata = _profile_data_get (element, FALSE);
+  if (!pdata)
+    return FALSE;
+
+  g_mutex_lock (&pdata->lock);
+  *profile = pdata->profile;
+  g_mutex_unlock (&pdata->lock);
+
+  return TRUE;
+}
+
+/**
+ * @brief Reset the counters of the element.
+ */
+void
+gst_tensor_element_reset_profile (GstElement * element)
+{
+  GstTensorElementProfileData *pdata;
+
+  g_return_if_fail (GST_IS_ELEMENT (element));
+
+  pdata = _profile_data_get (element, FALSE);
+  if (!pdata)
+    return;
+
+  g_mutex_lock (&pdata->lock);
+  memset (&pdata->profile, 0, sizeof (GstTensorElementProfile));
+  g_mutex_unlock (&pdata->lock);
+}
+
+/**
+ * @brief Check whether the elements count the copy, allocation and compute time.
+ */
+gboolean
+gst_tensor_element_profile_is_enabled (void)
+{
+#ifdef ENABLE_ELEMENT_PROFILE
+  return TRUE;
+#else
+  return FALSE;
+#endif
+}
@@ -43,9 +43,22 @@ enum
   PROP_DEST_HOST,
   PROP_DEST_PORT,
   PROP_CONNECT_TYPE,
+  PROP_CUSTOM_LIB,
   PROP_TOPIC,
   PROP_TIMEOUT,
   PROP_SILENT,
+  PROP_MAX_IN_FLIGHT,
+  PROP_OUT_OF_ORDER,
+  PROP_DEST_LIST,
+  PROP_LOAD_BALANCE,
+  PROP_COMPRESSION,
+  PROP_QUANTIZE,
+  PROP_SHARED_MEMORY,
+  PROP_LATENCY_STATS,
+  PROP_LATENCY_REPORT,
+  PROP_ADAPTIVE_TIMEOUT,
+  PROP_HEDGE,
+  PROP_CONNECTION_POOL,
 };
 
 #define TCP_HIGHEST_PORT        65535
@@ -54,6 +67,99 @@ enum
 #define TCP_DEFAULT_CLIENT_SRC_PORT 3001
 #define DEFAULT_CLIENT_TIMEOUT  0
 #define DEFAULT_SILENT TRUE
+#define DEFAULT_MAX_IN_FLIGHT 1
+#define DEFAULT_OUT_OF_ORDER FALSE
+#define MAX_IN_FLIGHT_LIMIT 1024
+#define DEFAULT_LOAD_BALANCE QUERY_CLIENT_LB_LEAST_OUTSTANDING
+#define DEFAULT_COMPRESSION QUERY_COMPRESS_NONE
+#define DEFAULT_QUANTIZE QUERY_QUANTIZE_NONE
+#define DEFAULT_SHARED_MEMORY FALSE
+#define DEFAULT_LATENCY_REPORT 0
+#define DEFAULT_ADAPTIVE_TIMEOUT FALSE
+#define DEFAULT_HEDGE FALSE
+#define DEFAULT_CONNECTION_POOL FALSE
+
+/**
+ * @brief The number of the answers to get the percentiles of the round-trip time.
+ */
+#define LATENCY_MIN_SAMPLES 16
+
+/**
+ * @brief The adaptive timeout is the p99 of the round-trip time multiplied by this factor.
+ */
+#define ADAPTIVE_TIMEOUT_FACTOR 3
+
+/**
+ * @brief The minimum of the adaptive timeout (in usec).
+ */
+#define ADAPTIVE_TIMEOUT_MIN (10 * G_TIME_SPAN_MILLISECOND)
+
+/**
+ * @brief Interval (in usec) to retry the connection to the disconnected server.
+ */
+#define SERVER_RETRY_INTERVAL G_TIME_SPAN_SECOND
+
+/**
+ * @brief Data structure for the query server.
+ */
+typedef struct
+{
+  GstTensorQueryClient *client; /**< the client which owns this server */
+  gchar *host; /**< server host */
+  guint16 port; /**< server port */
+  guint16 src_port; /**< port to receive the answers (0 for any port) */
+  nns_edge_h edge_h; /**< edge handle connected to the server */
+  gboolean connected; /**< true if the server is available */
+  gint64 retry_time; /**< monotonic time to retry the connection */
+  guint outstanding; /**< number of requests waiting for the answer */
+  gint64 latency; /**< average round-trip time (in usec), 0 if unknown */
+  gchar *caps_str; /**< capability received from the server when connected */
+  gchar *pool_key; /**< key of the connection pool to return the edge handle, NULL if not pooled */
+} query_client_server_s;
+
+/**
+ * @brief Max number of the idle connections in the pool for each destination.
+ */
+#define CONNECTION_POOL_MAX_IDLE 4
+
+/**
+ * @brief The idle connection in the pool is closed after this time (in usec).
+ */
+#define CONNECTION_POOL_IDLE_TIMEOUT (60 * G_TIME_SPAN_SECOND)
+
+/**
+ * @brief Idle connection to the query server, kept in the process-wide pool.
+ */
+typedef struct
+{
+  nns_edge_h edge_h; /**< edge handle connected to the server */
+  gchar *caps_str; /**< capability received from the server when connected */
+  gint64 idle_time; /**< monotonic time when the connection is returned */
+} query_client_conn_s;
+
+/**
+ * @brief Process-wide pool of the idle connections (key to GQueue of query_client_conn_s, the latest first).
+ */
+G_LOCK_DEFINE_STATIC (query_client_pool);
+static GHashTable *_conn_pool = NULL;
+
+static void init_queryclient (void) __attribute__((constructor));
+static void fini_queryclient (void) __attribute__((destructor));
+
+/**
+ * @brief Data structure for the request waiting for the answer from the server.
+ */
+typedef struct
+{
+  gint64 request_id; /**< sequence number of the request */
+  query_client_server_s *server; /**< the server which handles this request */
+  gint64 sent_time; /**< monotonic time when the request is sent */
+  GstBuffer *out_buf; /**< output buffer, which has the metadata of the incoming buffer */
+  gboolean answered; /**< true if the answer is received */
+  nns_edge_data_h data_h; /**< copy of the request to send the hedged request (NULL if not hedging) */
+  query_client_server_s *hedge_server; /**< the server which handles the hedged request */
+  gboolean hedged; /**< true if the hedged request is already handled */
+} query_client_request_s;
 
 GST_DEBUG_CATEGORY_STATIC (gst_tensor_query_client_debug);
 #define GST_CAT_DEFAULT gst_tensor_query_client_debug
@@ -74,6 +180,30 @@ static GstStaticPadTemplate srctemplate = GST_STATIC_PAD_TEMPLATE ("src",
     GST_PAD_ALWAYS,
     GST_STATIC_CAPS_ANY);
 
+#define GST_TYPE_QUERY_CLIENT_LOAD_BALANCE (gst_tensor_query_client_lb_get_type ())
+/**
+ * @brief Register GEnumValue array for the load-balance property.
+ */
+static GType
+gst_tensor_query_client_lb_get_type (void)
+{
+  static GType lb_type = 0;
+
+  if (lb_type == 0) {
+    static GEnumValue lb_types[] = {
+      {QUERY_CLIENT_LB_LEAST_OUTSTANDING, "least-outstanding",
+          "Send to the server with the least requests waiting for the answer"},
+      {QUERY_CLIENT_LB_LATENCY_WEIGHTED, "latency-weighted",
+          "Send to the server with the least expected latency (outstanding requests x round-trip time)"},
+      {0, NULL, NULL},
+    };
+    lb_type = g_enum_register_static ("tensor_query_client_load_balance",
+        lb_types);
+  }
+
+  return lb_type;
+}
+
 #define gst_tensor_query_client_parent_class parent_class
 G_DEFINE_TYPE (GstTensorQueryClient, gst_tensor_query_client, GST_TYPE_ELEMENT);
 
@@ -91,6 +221,10 @@ static GstFlowReturn gst_tensor_query_client_chain (GstPad * pad,
     GstObject * parent, GstBuffer * buf);
 static GstCaps *gst_tensor_query_client_query_caps (GstTensorQueryClient * self,
     GstPad * pad, GstCaps * filter);
+static GstFlowReturn gst_tensor_query_client_wait_answers (GstTensorQueryClient
+    * self, guint limit);
+static void gst_tensor_query_client_clear_requests (GstTensorQueryClient *
+    self);
 
 /**
  * @brief initialize the class
@@ -135,6 +269,11 @@ gst_tensor_query_client_class_init (GstTensorQueryClientClass * klass)
           "The connections type between client and server.",
           GST_TYPE_QUERY_CONNECT_TYPE, DEFAULT_CONNECT_TYPE,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CUSTOM_LIB,
+      g_param_spec_string ("custom-lib", "Custom connection library",
+          "The path of the library implementing the connection, "
+          "valid only if the connect-type is CUSTOM.", NULL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
   g_object_class_install_property (gobject_class, PROP_TOPIC,
       g_param_spec_string ("topic", "Topic",
           "The main topic of the host.",
@@ -145,6 +284,72 @@ gst_tensor_query_client_class_init (GstTensorQueryClientClass * klass)
           "A timeout value (in ms) to wait message from query server after sending buffer to server. 0 means no wait.",
           0, G_MAXUINT, DEFAULT_CLIENT_TIMEOUT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_MAX_IN_FLIGHT,
+      g_param_spec_uint ("max-in-flight", "Max in-flight requests",
+          "The max number of requests sent to the server without waiting for the answers. "
+          "1 means the client waits for the answer of each request. "
+          "If the window is full, the client waits for an answer with timeout, "
+          "or the default timeout (10 sec) if timeout is 0, and drops the oldest request if timed out.",
+          1, MAX_IN_FLIGHT_LIMIT, DEFAULT_MAX_IN_FLIGHT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_OUT_OF_ORDER,
+      g_param_spec_boolean ("out-of-order", "Out of order",
+          "Push the answers in the received order, instead of the order of the requests (only if max-in-flight > 1).",
+          DEFAULT_OUT_OF_ORDER, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_DEST_LIST,
+      g_param_spec_string ("dest-list", "Destination list",
+          "Comma-separated list of tensor query servers (host:port) to balance the load. "
+          "If given, dest-host and dest-port are ignored.",
+          "", G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LOAD_BALANCE,
+      g_param_spec_enum ("load-balance", "Load balance",
+          "The policy to select the server for each buffer if dest-list has multiple servers.",
+          GST_TYPE_QUERY_CLIENT_LOAD_BALANCE, DEFAULT_LOAD_BALANCE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_COMPRESSION,
+      g_param_spec_enum ("compression", "Compression",
+          "The compression of the payload sent to the server. "
+          "If the server does not support the compression, the payload is not compressed.",
+          GST_TYPE_QUERY_COMPRESSION, DEFAULT_COMPRESSION,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_QUANTIZE,
+      g_param_spec_enum ("quantize", "Quantize",
+          "The quantization of the static float32 tensors before the compression (lossy). "
+          "The server restores the float32 tensors.",
+          GST_TYPE_QUERY_QUANTIZE, DEFAULT_QUANTIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_SHARED_MEMORY,
+      g_param_spec_boolean ("shared-memory", "Shared memory",
+          "Send the payload via the shared memory to the servers on the same host, "
+          "only the descriptor of the shared memory is sent over the connection. "
+          "If the shared memory is full, the payload is sent over the connection.",
+          DEFAULT_SHARED_MEMORY, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY_STATS,
+      g_param_spec_boxed ("latency-stats", "Latency statistics",
+          "The percentiles (p50, p90, p99 in usec) of the latency breakdown of the recent requests: "
+          "total (round-trip), network, queue (server queueing) and invoke (server pipeline). "
+          "The estimated clock offset of the server is given as clock-offset.",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_LATENCY_REPORT,
+      g_param_spec_uint ("latency-report", "Latency report",
+          "Post the element message with the latency-stats on the bus every N answers (0 to disable).",
+          0, G_MAXUINT, DEFAULT_LATENCY_REPORT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_ADAPTIVE_TIMEOUT,
+      g_param_spec_boolean ("adaptive-timeout", "Adaptive timeout",
+          "Derive the timeout from the round-trip time of the recent requests (3 x p99). "
+          "The property timeout (10 seconds if 0) is the upper bound of the adaptive timeout.",
+          DEFAULT_ADAPTIVE_TIMEOUT, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_HEDGE,
+      g_param_spec_boolean ("hedge", "Hedged requests",
+          "Send the request again to other server in dest-list if the answer is not received within "
+          "the p95 of the round-trip time, and push the first answer.",
+          DEFAULT_HEDGE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CONNECTION_POOL,
+      g_param_spec_boolean ("connection-pool", "Connection pool",
+          "Keep the connections to the servers in a process-wide pool when the element is released, "
+          "and reuse them in the clients with the same destination and caps.",
+          DEFAULT_CONNECTION_POOL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&sinktemplate));
@@ -183,6 +388,7 @@ gst_tensor_query_client_init (GstTensorQueryClient * self)
   /* init properties */
   self->silent = DEFAULT_SILENT;
   self->connect_type = DEFAULT_CONNECT_TYPE;
+  self->custom_lib = NULL;
   self->host = g_strdup (TCP_DEFAULT_HOST);
   self->port = TCP_DEFAULT_CLIENT_SRC_PORT;
   self->dest_host = g_strdup (TCP_DEFAULT_HOST);
@@ -190,8 +396,28 @@ gst_tensor_query_client_init (GstTensorQueryClient * self)
   self->topic = NULL;
   self->in_caps_str = NULL;
   self->timeout = DEFAULT_CLIENT_TIMEOUT;
-  self->edge_h = NULL;
+  self->dest_list = NULL;
+  self->servers = NULL;
+  self->load_balance = DEFAULT_LOAD_BALANCE;
+  self->next_server = 0;
   self->msg_queue = g_async_queue_new ();
+  self->max_in_flight = DEFAULT_MAX_IN_FLIGHT;
+  self->out_of_order = DEFAULT_OUT_OF_ORDER;
+  self->request_seq = 0;
+  g_queue_init (&self->pending);
+  self->compression = DEFAULT_COMPRESSION;
+  self->quantize = DEFAULT_QUANTIZE;
+  self->active_compression = DEFAULT_COMPRESSION;
+  self->active_quantize = DEFAULT_QUANTIZE;
+  gst_tensors_config_init (&self->in_config);
+  self->shared_memory = DEFAULT_SHARED_MEMORY;
+  self->shm = NULL;
+  self->latency_report = DEFAULT_LATENCY_REPORT;
+  memset (&self->latency, 0, sizeof (query_client_latency_s));
+  self->adaptive_timeout = DEFAULT_ADAPTIVE_TIMEOUT;
+  self->hedge = DEFAULT_HEDGE;
+  self->rtt_p95 = self->rtt_p99 = 0;
+  self->connection_pool = DEFAULT_CONNECTION_POOL;
 }
 
 /**
@@ -203,6 +429,9 @@ gst_tensor_query_client_finalize (GObject * object)
   GstTensorQueryClient *self = GST_TENSOR_QUERY_CLIENT (object);
   nns_edge_data_h data_h;
 
+  g_free (self->custom_lib);
+  self->custom_lib = NULL;
+
   g_free (self->host);
   self->host = NULL;
   g_free (self->dest_host);
@@ -211,6 +440,11 @@ gst_tensor_query_client_finalize (GObject * object)
   self->topic = NULL;
   g_free (self->in_caps_str);
   self->in_caps_str = NULL;
+  g_free (self->dest_list);
+  self->dest_list = NULL;
+  gst_tensors_config_free (&self->in_config);
+
+  gst_tensor_query_client_clear_requests (self);
 
   while ((data_h = g_async_queue_try_pop (self->msg_queue))) {
     nns_edge_data_destroy (data_h);
@@ -221,14 +455,142 @@ gst_tensor_query_client_finalize (GObject * object)
     self->msg_queue = NULL;
   }
 
-  if (self->edge_h) {
-    nns_edge_release_handle (self->edge_h);
-    self->edge_h = NULL;
+  if (self->servers) {
+    g_ptr_array_free (self->servers, TRUE);
+    self->servers = NULL;
+  }
+
+  if (self->shm) {
+    gst_tensor_query_shm_free (self->shm);
+    self->shm = NULL;
   }
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+/**
+ * @brief Compare function to sort the latency samples.
+ */
+static gint
+_client_latency_compare (gconstpointer a, gconstpointer b)
+{
+  gint64 va = *((const gint64 *) a);
+  gint64 vb = *((const gint64 *) b);
+
+  return (va > vb) - (va < vb);
+}
+
+/**
+ * @brief Get the percentiles of the latency breakdown of the recent requests.
+ * @return Newly allocated structure. The caller should free it.
+ */
+static GstStructure *
+gst_tensor_query_client_get_latency (GstTensorQueryClient * self)
+{
+  static const gchar *names[QUERY_LATENCY_NUM] = {
+    "total", "network", "queue", "invoke"
+  };
+  static const guint percentiles[] = { 50, 90, 99 };
+  query_client_latency_s *latency;
+  GstStructure *stats;
+  guint c, p, num;
+
+  latency = g_new (query_client_latency_s, 1);
+
+  GST_OBJECT_LOCK (self);
+  memcpy (latency, &self->latency, sizeof (query_client_latency_s));
+  GST_OBJECT_UNLOCK (self);
+
+  num = (guint) MIN (latency->count, QUERY_LATENCY_WINDOW);
+  stats = gst_structure_new ("tensor-query-latency",
+      "samples", G_TYPE_UINT, num,
+      "clock-offset", G_TYPE_INT64, latency->clock_offset, NULL);
+
+  for (c = 0; c < QUERY_LATENCY_NUM; c++) {
+    qsort (latency->samples[c], num, sizeof (gint64), _client_latency_compare);
+
+    for (p = 0; p < G_N_ELEMENTS (percentiles); p++) {
+      gchar *field = g_strdup_printf ("%s-p%u", names[c], percentiles[p]);
+      gint64 val = (num > 0) ?
+          latency->samples[c][(num - 1) * percentiles[p] / 100] : 0;
+
+      gst_structure_set (stats, field, G_TYPE_INT64, val, NULL);
+      g_free (field);
+    }
+  }
+
+  g_free (latency);
+  return stats;
+}
+
+/**
+ * @brief Update the latency breakdown with the timestamps of the answer.
+ */
+static void
+gst_tensor_query_client_update_latency (GstTensorQueryClient * self,
+    nns_edge_data_h data_h)
+{
+  gint64 client_send, client_recv, server_recv, server_send;
+  gint64 invoke_start, invoke_end, rtt, offset;
+  guint idx;
+  gboolean report;
+
+  client_send = gst_tensor_query_get_time (data_h, QUERY_TIME_CLIENT_SEND);
+  client_recv = gst_tensor_query_get_time (data_h, QUERY_TIME_CLIENT_RECV);
+  server_recv = gst_tensor_query_get_time (data_h, QUERY_TIME_SERVER_RECV);
+  server_send = gst_tensor_query_get_time (data_h, QUERY_TIME_SERVER_SEND);
+  invoke_start = gst_tensor_query_get_time (data_h, QUERY_TIME_INVOKE_START);
+  invoke_end = gst_tensor_query_get_time (data_h, QUERY_TIME_INVOKE_END);
+
+  /* The server does not support the timestamps. */
+  if (client_send == 0 || client_recv == 0 || server_recv == 0 ||
+      server_send == 0 || invoke_start == 0 || invoke_end == 0)
+    return;
+
+  /**
+   * The client and server timestamps are compared in the same clock only.
+   * The offset of the server clock is estimated as NTP (RFC 5905) does.
+   */
+  rtt = MAX (client_recv - client_send, 0);
+  offset = ((server_recv - client_send) + (server_send - client_recv)) / 2;
+
+  GST_OBJECT_LOCK (self);
+  idx = self->latency.count % QUERY_LATENCY_WINDOW;
+  self->latency.samples[QUERY_LATENCY_TOTAL][idx] = rtt;
+  self->latency.samples[QUERY_LATENCY_NETWORK][idx] =
+      MAX (rtt - (server_send - server_recv), 0);
+  self->latency.samples[QUERY_LATENCY_QUEUE][idx] =
+      MAX (invoke_start - server_recv, 0);
+  self->latency.samples[QUERY_LATENCY_INVOKE][idx] =
+      MAX (invoke_end - invoke_start, 0);
+  self->latency.clock_offset = (self->latency.count > 0) ?
+      (3 * self->latency.clock_offset + offset) / 4 : offset;
+  self->latency.count++;
+
+  report = (self->latency_report > 0 &&
+      self->latency.count % self->latency_report == 0);
+  GST_OBJECT_UNLOCK (self);
+
+  /* The samples are updated in the streaming thread only, no lock to read them here. */
+  if (self->latency.count % LATENCY_MIN_SAMPLES == 0) {
+    gint64 rtt_samples[QUERY_LATENCY_WINDOW];
+    guint num = (guint) MIN (self->latency.count, QUERY_LATENCY_WINDOW);
+
+    memcpy (rtt_samples, self->latency.samples[QUERY_LATENCY_TOTAL],
+        num * sizeof (gint64));
+    qsort (rtt_samples, num, sizeof (gint64), _client_latency_compare);
+
+    self->rtt_p95 = rtt_samples[(num - 1) * 95 / 100];
+    self->rtt_p99 = rtt_samples[(num - 1) * 99 / 100];
+  }
+
+  if (report) {
+    gst_element_post_message (GST_ELEMENT_CAST (self),
+        gst_message_new_element (GST_OBJECT_CAST (self),
+            gst_tensor_query_client_get_latency (self)));
+  }
+}
+
 /**
  * @brief set property
  */
@@ -265,6 +627,10 @@ gst_tensor_query_client_set_property (GObject * object, guint prop_id,
     case PROP_CONNECT_TYPE:
       self->connect_type = g_value_get_enum (value);
       break;
+    case PROP_CUSTOM_LIB:
+      g_free (self->custom_lib);
+      self->custom_lib = g_value_dup_string (value);
+      break;
     case PROP_TOPIC:
       if (!g_value_get_string (value)) {
         nns_logw ("Topic property cannot be NULL. Query-hybrid is disabled.");
@@ -279,6 +645,40 @@ gst_tensor_query_client_set_property (GObject * object, guint prop_id,
     case PROP_SILENT:
       self->silent = g_value_get_boolean (value);
       break;
+    case PROP_MAX_IN_FLIGHT:
+      self->max_in_flight = g_value_get_uint (value);
+      break;
+    case PROP_OUT_OF_ORDER:
+      self->out_of_order = g_value_get_boolean (value);
+      break;
+    case PROP_DEST_LIST:
+      g_free (self->dest_list);
+      self->dest_list = g_value_dup_string (value);
+      break;
+    case PROP_LOAD_BALANCE:
+      self->load_balance = g_value_get_enum (value);
+      break;
+    case PROP_COMPRESSION:
+      self->compression = g_value_get_enum (value);
+      break;
+    case PROP_QUANTIZE:
+      self->quantize = g_value_get_enum (value);
+      break;
+    case PROP_SHARED_MEMORY:
+      self->shared_memory = g_value_get_boolean (value);
+      break;
+    case PROP_LATENCY_REPORT:
+      self->latency_report = g_value_get_uint (value);
+      break;
+    case PROP_ADAPTIVE_TIMEOUT:
+      self->adaptive_timeout = g_value_get_boolean (value);
+      break;
+    case PROP_HEDGE:
+      self->hedge = g_value_get_boolean (value);
+      break;
+    case PROP_CONNECTION_POOL:
+      self->connection_pool = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -310,6 +710,9 @@ gst_tensor_query_client_get_property (GObject * object, guint prop_id,
     case PROP_CONNECT_TYPE:
       g_value_set_enum (value, self->connect_type);
       break;
+    case PROP_CUSTOM_LIB:
+      g_value_set_string (value, self->custom_lib);
+      break;
     case PROP_TOPIC:
       g_value_set_string (value, self->topic);
       break;
@@ -319,6 +722,42 @@ gst_tensor_query_client_get_property (GObject * object, guint prop_id,
     case PROP_SILENT:
       g_value_set_boolean (value, self->silent);
       break;
+    case PROP_MAX_IN_FLIGHT:
+      g_value_set_uint (value, self->max_in_flight);
+      break;
+    case PROP_OUT_OF_ORDER:
+      g_value_set_boolean (value, self->out_of_order);
+      break;
+    case PROP_DEST_LIST:
+      g_value_set_string (value, self->dest_list);
+      break;
+    case PROP_LOAD_BALANCE:
+      g_value_set_enum (value, self->load_balance);
+      break;
+    case PROP_COMPRESSION:
+      g_value_set_enum (value, self->compression);
+      break;
+    case PROP_QUANTIZE:
+      g_value_set_enum (value, self->quantize);
+      break;
+    case PROP_SHARED_MEMORY:
+      g_value_set_boolean (value, self->shared_memory);
+      break;
+    case PROP_LATENCY_STATS:
+      g_value_take_boxed (value, gst_tensor_query_client_get_latency (self));
+      break;
+    case PROP_LATENCY_REPORT:
+      g_value_set_uint (value, self->latency_report);
+      break;
+    case PROP_ADAPTIVE_TIMEOUT:
+      g_value_set_boolean (value, self->adaptive_timeout);
+      break;
+    case PROP_HEDGE:
+      g_value_set_boolean (value, self->hedge);
+      break;
+    case PROP_CONNECTION_POOL:
+      g_value_set_boolean (value, self->connection_pool);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -363,15 +802,15 @@ gst_tensor_query_client_update_caps (GstTensorQueryClient * self,
  * @brief Retry to connect to available server.
  */
 static gboolean
-_client_retry_connection (GstTensorQueryClient * self)
+_client_retry_connection (query_client_server_s * server)
 {
-  if (NNS_EDGE_ERROR_NONE != nns_edge_disconnect (self->edge_h)) {
+  if (NNS_EDGE_ERROR_NONE != nns_edge_disconnect (server->edge_h)) {
     nns_loge ("Failed to retry connection, disconnection failure");
     return FALSE;
   }
 
-  if (NNS_EDGE_ERROR_NONE != nns_edge_connect (self->edge_h,
-          self->dest_host, self->dest_port)) {
+  if (NNS_EDGE_ERROR_NONE != nns_edge_connect (server->edge_h,
+          server->host, server->port)) {
     nns_loge ("Failed to retry connection, connection failure");
     return FALSE;
   }
@@ -383,11 +822,10 @@ _client_retry_connection (GstTensorQueryClient * self)
  * @brief Parse caps from received event data.
  */
 static gchar *
-_nns_edge_parse_caps (gchar * caps_str, gboolean is_src)
+_nns_edge_parse_caps (gchar * caps_str, const gchar * find_key)
 {
   gchar **strv;
   gint num, i;
-  gchar *find_key = NULL;
   gchar *ret_str = NULL;
 
   if (!caps_str)
@@ -396,24 +834,115 @@ _nns_edge_parse_caps (gchar * caps_str, gboolean is_src)
   strv = g_strsplit (caps_str, "@", -1);
   num = g_strv_length (strv);
 
-  find_key =
-      is_src ==
-      TRUE ? g_strdup ("query_server_src_caps") :
-      g_strdup ("query_server_sink_caps");
-
-  for (i = 1; i < num; i += 2) {
+  for (i = 1; i < num - 1; i += 2) {
     if (0 == g_strcmp0 (find_key, strv[i])) {
       ret_str = g_strdup (strv[i + 1]);
       break;
     }
   }
 
-  g_free (find_key);
   g_strfreev (strv);
 
   return ret_str;
 }
 
+/**
+ * @brief Check the codecs of the server, and disable the compression if the server cannot decompress it.
+ */
+static void
+_client_negotiate_codecs (GstTensorQueryClient * self, gchar * caps_str)
+{
+  gchar *codecs;
+  GEnumValue *val;
+
+  if (self->active_compression == QUERY_COMPRESS_NONE &&
+      self->active_quantize == QUERY_QUANTIZE_NONE)
+    return;
+
+  codecs = _nns_edge_parse_caps (caps_str, QUERY_SERVER_CODECS_KEY);
+  nns_logd ("Received server codecs: %s", GST_STR_NULL (codecs));
+
+  if (self->active_compression != QUERY_COMPRESS_NONE) {
+    val = g_enum_get_value (g_type_class_peek (GST_TYPE_QUERY_COMPRESSION),
+        self->active_compression);
+    if (!gst_tensor_query_codec_is_accepted (codecs, val->value_name)) {
+      nns_logw ("The server does not support the compression %s, "
+          "send the payload without compression.", val->value_name);
+      self->active_compression = QUERY_COMPRESS_NONE;
+    }
+  }
+
+  if (self->active_quantize != QUERY_QUANTIZE_NONE) {
+    val = g_enum_get_value (g_type_class_peek (GST_TYPE_QUERY_QUANTIZE),
+        self->active_quantize);
+    if (!gst_tensor_query_codec_is_accepted (codecs, val->value_name)) {
+      nns_logw ("The server does not support the quantization %s, "
+          "send the float32 tensors.", val->value_name);
+      self->active_quantize = QUERY_QUANTIZE_NONE;
+    }
+  }
+
+  g_free (codecs);
+}
+
+/**
+ * @brief Check the capability of the server and update the caps of the client.
+ */
+static int
+_client_handle_capability (GstTensorQueryClient * self, gchar * caps_str)
+{
+  GstCaps *server_caps, *client_caps;
+  GstStructure *server_st, *client_st;
+  gboolean result = FALSE;
+  gchar *ret_str;
+  int ret = NNS_EDGE_ERROR_NONE;
+
+  ret_str = _nns_edge_parse_caps (caps_str, "query_server_src_caps");
+  nns_logd ("Received server-src caps: %s", GST_STR_NULL (ret_str));
+  client_caps = gst_caps_from_string ((gchar *) self->in_caps_str);
+  server_caps = gst_caps_from_string (ret_str);
+  g_free (ret_str);
+
+  /** Server framerate may vary. Let's skip comparing the framerate. */
+  gst_caps_set_simple (server_caps, "framerate", GST_TYPE_FRACTION, 0, 1,
+      NULL);
+  gst_caps_set_simple (client_caps, "framerate", GST_TYPE_FRACTION, 0, 1,
+      NULL);
+
+  server_st = gst_caps_get_structure (server_caps, 0);
+  client_st = gst_caps_get_structure (client_caps, 0);
+
+  if (gst_structure_is_tensor_stream (server_st)) {
+    GstTensorsConfig server_config, client_config;
+
+    gst_tensors_config_from_structure (&server_config, server_st);
+    gst_tensors_config_from_structure (&client_config, client_st);
+
+    result = gst_tensors_config_is_equal (&server_config, &client_config);
+  }
+
+  if (result || gst_caps_can_intersect (client_caps, server_caps)) {
+    /** Update client src caps */
+    ret_str = _nns_edge_parse_caps (caps_str, "query_server_sink_caps");
+    nns_logd ("Received server-sink caps: %s", GST_STR_NULL (ret_str));
+    if (!gst_tensor_query_client_update_caps (self, ret_str)) {
+      nns_loge ("Failed to update client source caps.");
+      ret = NNS_EDGE_ERROR_UNKNOWN;
+    }
+    g_free (ret_str);
+
+    _client_negotiate_codecs (self, caps_str);
+  } else {
+    /* respond deny with src caps string */
+    nns_loge ("Query caps is not acceptable!");
+    ret = NNS_EDGE_ERROR_UNKNOWN;
+  }
+
+  gst_caps_unref (server_caps);
+  gst_caps_unref (client_caps);
+  return ret;
+}
+
 /**
  * @brief nnstreamer-edge event callback.
  */
@@ -422,7 +951,8 @@ _nns_edge_event_cb (nns_edge_event_h event_h, void *user_data)
 {
   nns_edge_event_e event_type;
   int ret = NNS_EDGE_ERROR_NONE;
-  GstTensorQueryClient *self = (GstTensorQueryClient *) user_data;
+  query_client_server_s *server = (query_client_server_s *) user_data;
+  GstTensorQueryClient *self = server->client;
 
   if (NNS_EDGE_ERROR_NONE != nns_edge_event_get_type (event_h, &event_type)) {
     nns_loge ("Failed to get event type!");
@@ -432,54 +962,18 @@ _nns_edge_event_cb (nns_edge_event_h event_h, void *user_data)
   switch (event_type) {
     case NNS_EDGE_EVENT_CAPABILITY:
     {
-      GstCaps *server_caps, *client_caps;
-      GstStructure *server_st, *client_st;
-      gboolean result = FALSE;
-      gchar *ret_str, *caps_str;
+      gchar *caps_str;
 
       nns_edge_event_parse_capability (event_h, &caps_str);
-      ret_str = _nns_edge_parse_caps (caps_str, TRUE);
-      nns_logd ("Received server-src caps: %s", GST_STR_NULL (ret_str));
-      client_caps = gst_caps_from_string ((gchar *) self->in_caps_str);
-      server_caps = gst_caps_from_string (ret_str);
-      g_free (ret_str);
-
-      /** Server framerate may vary. Let's skip comparing the framerate. */
-      gst_caps_set_simple (server_caps, "framerate", GST_TYPE_FRACTION, 0, 1,
-          NULL);
-      gst_caps_set_simple (client_caps, "framerate", GST_TYPE_FRACTION, 0, 1,
-          NULL);
+      ret = _client_handle_capability (self, caps_str);
 
-      server_st = gst_caps_get_structure (server_caps, 0);
-      client_st = gst_caps_get_structure (client_caps, 0);
-
-      if (gst_structure_is_tensor_stream (server_st)) {
-        GstTensorsConfig server_config, client_config;
-
-        gst_tensors_config_from_structure (&server_config, server_st);
-        gst_tensors_config_from_structure (&client_config, client_st);
-
-        result = gst_tensors_config_is_equal (&server_config, &client_config);
-      }
-
-      if (result || gst_caps_can_intersect (client_caps, server_caps)) {
-        /** Update client src caps */
-        ret_str = _nns_edge_parse_caps (caps_str, FALSE);
-        nns_logd ("Received server-sink caps: %s", GST_STR_NULL (ret_str));
-        if (!gst_tensor_query_client_update_caps (self, ret_str)) {
-          nns_loge ("Failed to update client source caps.");
-          ret = NNS_EDGE_ERROR_UNKNOWN;
-        }
-        g_free (ret_str);
+      /* The capability is applied again when the pooled connection is reused. */
+      if (ret == NNS_EDGE_ERROR_NONE) {
+        g_free (server->caps_str);
+        server->caps_str = caps_str;
       } else {
-        /* respond deny with src caps string */
-        nns_loge ("Query caps is not acceptable!");
-        ret = NNS_EDGE_ERROR_UNKNOWN;
+        g_free (caps_str);
       }
-
-      gst_caps_unref (server_caps);
-      gst_caps_unref (client_caps);
-      g_free (caps_str);
       break;
     }
     case NNS_EDGE_EVENT_NEW_DATA_RECEIVED:
@@ -487,6 +981,8 @@ _nns_edge_event_cb (nns_edge_event_h event_h, void *user_data)
       nns_edge_data_h data;
 
       nns_edge_event_parse_new_data (event_h, &data);
+      gst_tensor_query_set_time (data, QUERY_TIME_CLIENT_RECV,
+          g_get_real_time ());
       g_async_queue_push (self->msg_queue, data);
       break;
     }
@@ -498,71 +994,428 @@ _nns_edge_event_cb (nns_edge_event_h event_h, void *user_data)
 }
 
 /**
- * @brief Internal function to create edge handle.
+ * @brief nnstreamer-edge event callback of the idle connection in the pool, the answers are dropped.
+ */
+static int
+_client_pool_event_cb (nns_edge_event_h event_h, void *user_data)
+{
+  UNUSED (event_h);
+  UNUSED (user_data);
+  return NNS_EDGE_ERROR_NONE;
+}
+
+/**
+ * @brief Free the idle connection.
+ */
+static void
+_client_conn_free (gpointer data)
+{
+  query_client_conn_s *conn = (query_client_conn_s *) data;
+
+  if (conn->edge_h)
+    nns_edge_release_handle (conn->edge_h);
+
+  g_free (conn->caps_str);
+  g_free (conn);
+}
+
+/**
+ * @brief Free the queue of the idle connections.
+ */
+static void
+_client_conn_queue_free (gpointer data)
+{
+  g_queue_free_full ((GQueue *) data, _client_conn_free);
+}
+
+/**
+ * @brief Get the key of the connection pool. The connections with the same key are interchangeable.
+ */
+static gchar *
+_client_pool_get_key (GstTensorQueryClient * self,
+    query_client_server_s * server)
+{
+  return g_strdup_printf ("%d|%s|%s|%s:%u|%s:%u|%s", self->connect_type,
+      GST_STR_NULL (self->custom_lib), GST_STR_NULL (self->topic),
+      GST_STR_NULL (self->host), server->src_port, server->host,
+      server->port, GST_STR_NULL (self->in_caps_str));
+}
+
+/**
+ * @brief Lease the idle connection to the server from the pool.
+ * @return TRUE if the server gets the connection.
  */
 static gboolean
-gst_tensor_query_client_create_edge_handle (GstTensorQueryClient * self)
+_client_pool_lease (GstTensorQueryClient * self,
+    query_client_server_s * server)
 {
-  gboolean started = FALSE;
-  gchar *prev_caps = NULL;
-  int ret;
+  query_client_conn_s *conn = NULL;
+  GSList *expired = NULL;
+  GQueue *queue;
+  gint64 now = g_get_monotonic_time ();
+
+  g_free (server->pool_key);
+  server->pool_key = _client_pool_get_key (self, server);
+
+  G_LOCK (query_client_pool);
+  queue = g_hash_table_lookup (_conn_pool, server->pool_key);
+  while (queue && (conn = g_queue_pop_head (queue))) {
+    if (now - conn->idle_time < CONNECTION_POOL_IDLE_TIMEOUT)
+      break;
 
-  /* Already created, compare caps string. */
-  if (self->edge_h) {
-    ret = nns_edge_get_info (self->edge_h, "CAPS", &prev_caps);
-
-    if (ret != NNS_EDGE_ERROR_NONE || !prev_caps ||
-        !g_str_equal (prev_caps, self->in_caps_str)) {
-      /* Capability is changed, close old handle. */
-      nns_edge_release_handle (self->edge_h);
-      self->edge_h = NULL;
-    } else {
-      return TRUE;
+    expired = g_slist_prepend (expired, conn);
+    conn = NULL;
+  }
+  G_UNLOCK (query_client_pool);
+
+  /* Release the handles out of the lock, it may wait for the threads of the handle. */
+  g_slist_free_full (expired, _client_conn_free);
+
+  if (!conn)
+    return FALSE;
+
+  nns_edge_set_event_callback (conn->edge_h, _nns_edge_event_cb, server);
+
+  /* The server does not send the capability again, apply the one received when connected. */
+  if (_client_handle_capability (self, conn->caps_str) != NNS_EDGE_ERROR_NONE) {
+    _client_conn_free (conn);
+    return FALSE;
+  }
+
+  nns_logd ("Reuse the pooled connection to %s:%u.", server->host,
+      server->port);
+  server->edge_h = conn->edge_h;
+  server->caps_str = conn->caps_str;
+  g_free (conn);
+  return TRUE;
+}
+
+/**
+ * @brief Return the connection of the server to the pool.
+ * @return TRUE if the pool takes the edge handle.
+ */
+static gboolean
+_client_pool_return (query_client_server_s * server)
+{
+  query_client_conn_s *conn;
+  GSList *expired = NULL;
+  GQueue *queue;
+  gint64 now = g_get_monotonic_time ();
+
+  if (!server->pool_key || !server->edge_h || !server->connected ||
+      !server->caps_str)
+    return FALSE;
+
+  nns_edge_set_event_callback (server->edge_h, _client_pool_event_cb, NULL);
+
+  conn = g_new0 (query_client_conn_s, 1);
+  conn->edge_h = server->edge_h;
+  conn->caps_str = server->caps_str;
+  conn->idle_time = now;
+
+  server->edge_h = NULL;
+  server->caps_str = NULL;
+
+  G_LOCK (query_client_pool);
+  queue = g_hash_table_lookup (_conn_pool, server->pool_key);
+  if (!queue) {
+    queue = g_queue_new ();
+    g_hash_table_insert (_conn_pool, g_strdup (server->pool_key), queue);
+  }
+
+  g_queue_push_head (queue, conn);
+
+  /* Close the oldest connections over the limit or idle too long. */
+  while ((conn = g_queue_peek_tail (queue)) &&
+      (g_queue_get_length (queue) > CONNECTION_POOL_MAX_IDLE ||
+          now - conn->idle_time >= CONNECTION_POOL_IDLE_TIMEOUT)) {
+    expired = g_slist_prepend (expired, g_queue_pop_tail (queue));
+  }
+  G_UNLOCK (query_client_pool);
+
+  g_slist_free_full (expired, _client_conn_free);
+  return TRUE;
+}
+
+/**
+ * @brief Release the edge handle of the server.
+ */
+static void
+_client_server_free (gpointer data)
+{
+  query_client_server_s *server = (query_client_server_s *) data;
+
+  if (server->edge_h && !_client_pool_return (server))
+    nns_edge_release_handle (server->edge_h);
+
+  g_free (server->caps_str);
+  g_free (server->pool_key);
+  g_free (server->host);
+  g_free (server);
+}
+
+/**
+ * @brief Check whether all query servers are on the same host.
+ */
+static gboolean
+_client_servers_are_local (GPtrArray * servers)
+{
+  query_client_server_s *server;
+  guint i;
+
+  for (i = 0; i < servers->len; i++) {
+    server = g_ptr_array_index (servers, i);
+
+    if (g_ascii_strcasecmp (server->host, "localhost") != 0 &&
+        !g_str_has_prefix (server->host, "127.") &&
+        g_strcmp0 (server->host, "::1") != 0)
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Parse the list of query servers (host:port,host:port,...).
+ */
+static GPtrArray *
+_client_parse_servers (GstTensorQueryClient * self)
+{
+  GPtrArray *servers;
+  query_client_server_s *server;
+  gchar **strv;
+  guint i, num;
+
+  servers = g_ptr_array_new_with_free_func (_client_server_free);
+
+  if (!self->dest_list || self->dest_list[0] == '\0') {
+    server = g_new0 (query_client_server_s, 1);
+    server->client = self;
+    server->host = g_strdup (self->dest_host);
+    server->port = self->dest_port;
+    server->src_port = self->port;
+    g_ptr_array_add (servers, server);
+    return servers;
+  }
+
+  strv = g_strsplit (self->dest_list, ",", -1);
+  num = g_strv_length (strv);
+
+  for (i = 0; i < num; i++) {
+    gchar *addr = g_strstrip (strv[i]);
+    gchar *sep = g_strrstr (addr, ":");
+    guint64 port;
+
+    if (addr[0] == '\0')
+      continue;
+
+    if (!sep || !g_ascii_string_to_unsigned (sep + 1, 10, 0, TCP_HIGHEST_PORT,
+            &port, NULL)) {
+      nns_logw ("Invalid query server address '%s', skip it.", addr);
+      continue;
     }
+
+    server = g_new0 (query_client_server_s, 1);
+    server->client = self;
+    server->host = g_strndup (addr, sep - addr);
+    server->port = (guint16) port;
+    /* Each edge handle needs its own port to receive the answers. */
+    server->src_port = (servers->len == 0) ? self->port : 0;
+    g_ptr_array_add (servers, server);
   }
 
-  ret = nns_edge_create_handle ("TEMP_ID", self->connect_type,
-      NNS_EDGE_NODE_TYPE_QUERY_CLIENT, &self->edge_h);
-  if (ret != NNS_EDGE_ERROR_NONE)
+  g_strfreev (strv);
+  return servers;
+}
+
+/**
+ * @brief Create the edge handle of the server and connect to it.
+ */
+static gboolean
+_client_server_connect (GstTensorQueryClient * self,
+    query_client_server_s * server)
+{
+  int ret;
+
+  if (server->edge_h)
+    return _client_retry_connection (server);
+
+  if (self->connection_pool && _client_pool_lease (self, server))
+    return TRUE;
+
+  ret = gst_tensor_query_create_edge_handle ("TEMP_ID", self->connect_type,
+      self->custom_lib, NNS_EDGE_NODE_TYPE_QUERY_CLIENT, &server->edge_h);
+  if (ret != NNS_EDGE_ERROR_NONE) {
+    server->edge_h = NULL;
     return FALSE;
+  }
 
-  nns_edge_set_event_callback (self->edge_h, _nns_edge_event_cb, self);
+  nns_edge_set_event_callback (server->edge_h, _nns_edge_event_cb, server);
 
   if (self->topic)
-    nns_edge_set_info (self->edge_h, "TOPIC", self->topic);
+    nns_edge_set_info (server->edge_h, "TOPIC", self->topic);
   if (self->host)
-    nns_edge_set_info (self->edge_h, "HOST", self->host);
-  if (self->port > 0) {
-    gchar *port = g_strdup_printf ("%u", self->port);
-    nns_edge_set_info (self->edge_h, "PORT", port);
+    nns_edge_set_info (server->edge_h, "HOST", self->host);
+  if (server->src_port > 0) {
+    gchar *port = g_strdup_printf ("%u", server->src_port);
+    nns_edge_set_info (server->edge_h, "PORT", port);
     g_free (port);
   }
-  nns_edge_set_info (self->edge_h, "CAPS", self->in_caps_str);
+  nns_edge_set_info (server->edge_h, "CAPS", self->in_caps_str);
 
-  ret = nns_edge_start (self->edge_h);
+  ret = nns_edge_start (server->edge_h);
   if (ret != NNS_EDGE_ERROR_NONE) {
     nns_loge
         ("Failed to start NNStreamer-edge. Please check server IP and port.");
-    goto done;
+    goto error;
   }
 
-  ret = nns_edge_connect (self->edge_h, self->dest_host, self->dest_port);
+  ret = nns_edge_connect (server->edge_h, server->host, server->port);
   if (ret != NNS_EDGE_ERROR_NONE) {
-    nns_loge ("Failed to connect to edge server!");
-    goto done;
+    nns_loge ("Failed to connect to edge server %s:%u!", server->host,
+        server->port);
+    goto error;
   }
 
-  started = TRUE;
+  return TRUE;
+
+error:
+  nns_edge_release_handle (server->edge_h);
+  server->edge_h = NULL;
+  g_free (server->pool_key);
+  server->pool_key = NULL;
+  return FALSE;
+}
+
+/**
+ * @brief Internal function to create edge handle.
+ */
+static gboolean
+gst_tensor_query_client_create_edge_handle (GstTensorQueryClient * self)
+{
+  query_client_server_s *server;
+  gboolean started = FALSE;
+  gchar *prev_caps = NULL;
+  guint i;
+  int ret;
+
+  /* Already created, compare caps string. */
+  if (self->servers) {
+    server = g_ptr_array_index (self->servers, 0);
+
+    if (server->edge_h) {
+      ret = nns_edge_get_info (server->edge_h, "CAPS", &prev_caps);
+
+      if (ret == NNS_EDGE_ERROR_NONE && prev_caps &&
+          g_str_equal (prev_caps, self->in_caps_str)) {
+        g_free (prev_caps);
+        return TRUE;
+      }
+
+      g_free (prev_caps);
+    }
+
+    /* Capability is changed, close old handles. */
+    gst_tensor_query_client_clear_requests (self);
+    g_ptr_array_free (self->servers, TRUE);
+    self->servers = NULL;
+  }
+
+  self->servers = _client_parse_servers (self);
+  self->next_server = 0;
+
+  /* The servers may disable the compression while connecting. */
+  self->active_compression = self->compression;
+  self->active_quantize = self->quantize;
+
+  if (!gst_tensor_query_compression_is_supported (self->active_compression)) {
+    nns_logw ("The compression is not supported in this build, "
+        "send the payload without compression.");
+    self->active_compression = QUERY_COMPRESS_NONE;
+  }
+
+  /* The shared memory is available only if all servers are on the same host. */
+  if (self->shared_memory && !_client_servers_are_local (self->servers)) {
+    nns_logw ("The query server is not on the same host, "
+        "send the payload without the shared memory.");
+    gst_tensor_query_shm_free (self->shm);
+    self->shm = NULL;
+  } else if (self->shared_memory && !self->shm) {
+    if (gst_tensor_query_shm_is_supported ())
+      self->shm = gst_tensor_query_shm_new ();
+    else
+      nns_logw ("The shared memory is not supported in this build.");
+  }
+
+  for (i = 0; i < self->servers->len; i++) {
+    server = g_ptr_array_index (self->servers, i);
+
+    server->connected = _client_server_connect (self, server);
+    if (server->connected)
+      started = TRUE;
+    else
+      server->retry_time = g_get_monotonic_time () + SERVER_RETRY_INTERVAL;
+  }
 
-done:
   if (!started) {
-    nns_edge_release_handle (self->edge_h);
-    self->edge_h = NULL;
+    g_ptr_array_free (self->servers, TRUE);
+    self->servers = NULL;
   }
 
   return started;
 }
 
+/**
+ * @brief Select the query server to send the buffer, and retry the connection to the disconnected servers.
+ * @return the server, or NULL if no server is available.
+ */
+static query_client_server_s *
+gst_tensor_query_client_select_server (GstTensorQueryClient * self)
+{
+  query_client_server_s *server, *best = NULL;
+  guint64 score, best_score = 0;
+  gint64 now;
+  guint i, num;
+
+  num = self->servers->len;
+  if (num == 1)
+    return g_ptr_array_index (self->servers, 0);
+
+  now = g_get_monotonic_time ();
+
+  /* Start from the next server, the servers with the same score are used in turn. */
+  for (i = 0; i < num; i++) {
+    server = g_ptr_array_index (self->servers, (self->next_server + i) % num);
+
+    if (!server->connected) {
+      if (now < server->retry_time)
+        continue;
+
+      server->connected = _client_server_connect (self, server);
+      if (!server->connected) {
+        server->retry_time = now + SERVER_RETRY_INTERVAL;
+        continue;
+      }
+
+      nns_logi ("Reconnected to the query server %s:%u.", server->host,
+          server->port);
+    }
+
+    if (self->load_balance == QUERY_CLIENT_LB_LATENCY_WEIGHTED)
+      score = (guint64) (server->outstanding + 1) * server->latency;
+    else
+      score = server->outstanding;
+
+    if (!best || score < best_score) {
+      best = server;
+      best_score = score;
+    }
+  }
+
+  self->next_server = (self->next_server + 1) % num;
+  return best;
+}
+
 /**
  * @brief This function handles sink event.
  */
@@ -579,12 +1432,20 @@ gst_tensor_query_client_sink_event (GstPad * pad,
     case GST_EVENT_CAPS:
     {
       GstCaps *caps;
+      GstStructure *structure;
       gboolean ret;
 
       gst_event_parse_caps (event, &caps);
       g_free (self->in_caps_str);
       self->in_caps_str = gst_caps_to_string (caps);
 
+      /* tensors info to quantize the float32 tensors */
+      gst_tensors_config_free (&self->in_config);
+      structure = gst_caps_get_structure (caps, 0);
+      if (!gst_structure_is_tensor_stream (structure) ||
+          !gst_tensors_config_from_structure (&self->in_config, structure))
+        gst_tensors_config_init (&self->in_config);
+
       ret = gst_tensor_query_client_create_edge_handle (self);
       if (!ret)
         nns_loge ("Failed to create edge handle, cannot start query client.");
@@ -592,6 +1453,13 @@ gst_tensor_query_client_sink_event (GstPad * pad,
       gst_event_unref (event);
       return ret;
     }
+    case GST_EVENT_EOS:
+      /* push the answers of the pending requests before eos */
+      gst_tensor_query_client_wait_answers (self, 0);
+      break;
+    case GST_EVENT_FLUSH_STOP:
+      gst_tensor_query_client_clear_requests (self);
+      break;
     default:
       break;
   }
@@ -650,6 +1518,336 @@ gst_tensor_query_client_sink_query (GstPad * pad,
   return gst_pad_query_default (pad, parent, query);
 }
 
+/**
+ * @brief Append the memories of the received edge data to the buffer.
+ */
+static gboolean
+gst_tensor_query_client_append_data (nns_edge_data_h data_h, GstBuffer * buf)
+{
+  guint i, num_data;
+  int ret;
+
+  ret = nns_edge_data_get_count (data_h, &num_data);
+  if (ret != NNS_EDGE_ERROR_NONE || num_data == 0) {
+    nns_loge ("Failed to get the number of memories of the edge data.");
+    return FALSE;
+  }
+
+  for (i = 0; i < num_data; i++) {
+    void *data = NULL;
+    nns_size_t data_len;
+    gpointer new_data;
+
+    nns_edge_data_get (data_h, i, &data, &data_len);
+    new_data = _g_memdup (data, data_len);
+    gst_buffer_append_memory (buf,
+        gst_memory_new_wrapped (0, new_data, data_len, 0,
+            data_len, new_data, g_free));
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Get the timeout (in usec) to wait the answer.
+ */
+static gint64
+gst_tensor_query_client_get_timeout (GstTensorQueryClient * self)
+{
+  gint64 timeout;
+
+  timeout = (self->timeout > 0) ? self->timeout * G_TIME_SPAN_MILLISECOND :
+      QUERY_DEFAULT_TIMEOUT_SEC * G_TIME_SPAN_SECOND;
+
+  if (self->adaptive_timeout && self->rtt_p99 > 0) {
+    timeout = CLAMP (ADAPTIVE_TIMEOUT_FACTOR * self->rtt_p99,
+        ADAPTIVE_TIMEOUT_MIN, timeout);
+  }
+
+  return timeout;
+}
+
+/**
+ * @brief Update the statistics of the server when the request is answered or dropped.
+ * @param update_latency true to update the round-trip time of the server with the elapsed time of the request.
+ */
+static void
+_client_request_done (query_client_request_s * req, gboolean update_latency)
+{
+  query_client_server_s *server = req->server;
+  gint64 rtt;
+
+  if (!server)
+    return;
+
+  if (server->outstanding > 0)
+    server->outstanding--;
+
+  if (update_latency) {
+    rtt = MAX (g_get_monotonic_time () - req->sent_time, 1);
+    server->latency =
+        (server->latency > 0) ? (3 * server->latency + rtt) / 4 : rtt;
+  }
+
+  if (req->hedge_server && req->hedge_server->outstanding > 0)
+    req->hedge_server->outstanding--;
+
+  if (req->data_h)
+    nns_edge_data_destroy (req->data_h);
+
+  req->server = NULL;
+  req->hedge_server = NULL;
+  req->data_h = NULL;
+}
+
+/**
+ * @brief Release the requests waiting for the answer.
+ */
+static void
+gst_tensor_query_client_clear_requests (GstTensorQueryClient * self)
+{
+  query_client_request_s *req;
+
+  while ((req = g_queue_pop_head (&self->pending))) {
+    _client_request_done (req, FALSE);
+    gst_buffer_unref (req->out_buf);
+    g_free (req);
+  }
+}
+
+/**
+ * @brief Push the answered requests at the head of the pending queue, in the order of the requests.
+ */
+static GstFlowReturn
+gst_tensor_query_client_push_answered (GstTensorQueryClient * self)
+{
+  query_client_request_s *req;
+  GstFlowReturn ret = GST_FLOW_OK;
+
+  while (ret == GST_FLOW_OK && (req = g_queue_peek_head (&self->pending)) &&
+      req->answered) {
+    g_queue_pop_head (&self->pending);
+
+    ret = gst_pad_push (self->srcpad, req->out_buf);
+    g_free (req);
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Find the request of the received answer and push the answer downstream.
+ */
+static GstFlowReturn
+gst_tensor_query_client_handle_answer (GstTensorQueryClient * self,
+    nns_edge_data_h data_h)
+{
+  query_client_request_s *req = NULL;
+  GList *l;
+  gint64 request_id = -1;
+  gchar *val = NULL;
+
+  if (NNS_EDGE_ERROR_NONE == nns_edge_data_get_info (data_h, "request_id",
+          &val)) {
+    request_id = g_ascii_strtoll (val, NULL, 10);
+    g_free (val);
+  }
+
+  for (l = self->pending.head; l; l = l->next) {
+    query_client_request_s *r = (query_client_request_s *) l->data;
+
+    /* if the server does not return the sequence number, the answers are in the order of the requests. */
+    if (r->answered)
+      continue;
+
+    if (request_id < 0 || r->request_id == request_id) {
+      req = r;
+      break;
+    }
+  }
+
+  if (!req) {
+    /* The slower answer of the hedged request. */
+    if (self->hedge)
+      nns_logd ("Received the answer of the request (%" G_GINT64_FORMAT
+          ") already answered, drop it.", request_id);
+    else
+      nns_logw ("Received the answer of unknown request (%" G_GINT64_FORMAT
+          "), drop it.", request_id);
+    return GST_FLOW_OK;
+  }
+
+  _client_request_done (req, TRUE);
+  gst_tensor_query_client_update_latency (self, data_h);
+
+  if (!gst_tensor_query_client_append_data (data_h, req->out_buf)) {
+    g_queue_remove (&self->pending, req);
+    gst_buffer_unref (req->out_buf);
+    g_free (req);
+    return GST_FLOW_ERROR;
+  }
+
+  req->answered = TRUE;
+
+  if (self->out_of_order) {
+    GstBuffer *out_buf = req->out_buf;
+
+    g_queue_remove (&self->pending, req);
+    g_free (req);
+    return gst_pad_push (self->srcpad, out_buf);
+  }
+
+  return gst_tensor_query_client_push_answered (self);
+}
+
+/**
+ * @brief Send the request again to other server if the answer is not received within the p95 of the round-trip time.
+ * @return the monotonic time to check the next hedged request, or 0 if no request to hedge.
+ */
+static gint64
+gst_tensor_query_client_hedge_requests (GstTensorQueryClient * self,
+    gint64 now)
+{
+  query_client_request_s *req;
+  query_client_server_s *server, *best;
+  gint64 hedge_time, next_time = 0;
+  gchar *val;
+  GList *l;
+  guint i;
+
+  if (!self->hedge || self->rtt_p95 <= 0 || self->servers->len < 2)
+    return 0;
+
+  for (l = self->pending.head; l; l = l->next) {
+    req = (query_client_request_s *) l->data;
+
+    if (req->answered || req->hedged || !req->data_h)
+      continue;
+
+    hedge_time = req->sent_time + self->rtt_p95;
+    if (now < hedge_time) {
+      if (next_time == 0 || hedge_time < next_time)
+        next_time = hedge_time;
+      continue;
+    }
+
+    req->hedged = TRUE;
+
+    /* the connected server with the least outstanding requests, except the first one */
+    best = NULL;
+    for (i = 0; i < self->servers->len; i++) {
+      server = g_ptr_array_index (self->servers, i);
+
+      if (server == req->server || !server->connected)
+        continue;
+
+      if (!best || server->outstanding < best->outstanding)
+        best = server;
+    }
+
+    if (best) {
+      /* the answer is sent back to the connection of the client ID */
+      nns_edge_get_info (best->edge_h, "client_id", &val);
+      nns_edge_data_set_info (req->data_h, "client_id", val);
+      g_free (val);
+
+      if (NNS_EDGE_ERROR_NONE == nns_edge_send (best->edge_h, req->data_h)) {
+        nns_logd ("Send the hedged request %" G_GINT64_FORMAT
+            " to server %s:%u.", req->request_id, best->host, best->port);
+        req->hedge_server = best;
+        best->outstanding++;
+      }
+    }
+
+    nns_edge_data_destroy (req->data_h);
+    req->data_h = NULL;
+  }
+
+  return next_time;
+}
+
+/**
+ * @brief Wait for the answers until the number of pending requests is not larger than the limit.
+ * If timed out, the oldest request is dropped.
+ */
+static GstFlowReturn
+gst_tensor_query_client_wait_answers (GstTensorQueryClient * self, guint limit)
+{
+  nns_edge_data_h data_h;
+  GstFlowReturn ret = GST_FLOW_OK;
+  gint64 timeout, now, end_time, hedge_time, wait_time;
+
+  timeout = gst_tensor_query_client_get_timeout (self);
+
+  /* push the answers already received */
+  while (ret == GST_FLOW_OK && !g_queue_is_empty (&self->pending) &&
+      (data_h = g_async_queue_try_pop (self->msg_queue))) {
+    ret = gst_tensor_query_client_handle_answer (self, data_h);
+    nns_edge_data_destroy (data_h);
+  }
+
+  end_time = g_get_monotonic_time () + timeout;
+
+  while (ret == GST_FLOW_OK && g_queue_get_length (&self->pending) > limit) {
+    now = g_get_monotonic_time ();
+
+    /* wake up to send the hedged request before the timeout */
+    hedge_time = gst_tensor_query_client_hedge_requests (self, now);
+    wait_time = (hedge_time > 0 && hedge_time < end_time) ?
+        hedge_time - now : end_time - now;
+
+    data_h = g_async_queue_timeout_pop (self->msg_queue, MAX (wait_time, 0));
+
+    if (data_h) {
+      ret = gst_tensor_query_client_handle_answer (self, data_h);
+      nns_edge_data_destroy (data_h);
+      end_time = g_get_monotonic_time () + timeout;
+    } else if (g_get_monotonic_time () < end_time) {
+      continue;
+    } else {
+      query_client_request_s *req = g_queue_pop_head (&self->pending);
+
+      nns_logw ("Timed out to wait the answer of request %" G_GINT64_FORMAT
+          ", drop it.", req->request_id);
+      /* the elapsed time penalizes the server in the latency-weighted selection */
+      _client_request_done (req, TRUE);
+      gst_buffer_unref (req->out_buf);
+      g_free (req);
+
+      ret = gst_tensor_query_client_push_answered (self);
+      end_time = g_get_monotonic_time () + timeout;
+    }
+  }
+
+  return ret;
+}
+
+/**
+ * @brief Add the sent request to the pending queue, and push the received answers.
+ */
+static GstFlowReturn
+gst_tensor_query_client_add_request (GstTensorQueryClient * self,
+    GstBuffer * buf, query_client_server_s * server, nns_edge_data_h data_h)
+{
+  query_client_request_s *req;
+
+  req = g_new0 (query_client_request_s, 1);
+  req->request_id = self->request_seq++;
+  req->server = server;
+  req->sent_time = g_get_monotonic_time ();
+  req->answered = FALSE;
+  req->data_h = data_h;
+  server->outstanding++;
+
+  /* metadata from incoming buffer */
+  req->out_buf = gst_buffer_new ();
+  gst_buffer_copy_into (req->out_buf, buf, GST_BUFFER_COPY_METADATA, 0, -1);
+
+  g_queue_push_tail (&self->pending, req);
+
+  return gst_tensor_query_client_wait_answers (self, self->max_in_flight - 1);
+}
+
 /**
  * @brief Chain function, this function does the actual processing.
  */
@@ -661,13 +1859,24 @@ gst_tensor_query_client_chain (GstPad * pad,
   GstBuffer *out_buf = NULL;
   GstFlowReturn res = GST_FLOW_OK;
   nns_edge_data_h data_h;
-  guint i, num_mems, num_data;
+  guint i, num_mems;
   int ret;
   GstMemory *mem[NNS_TENSOR_SIZE_LIMIT];
   GstMapInfo map[NNS_TENSOR_SIZE_LIMIT];
   gchar *val;
+  query_client_server_s *server;
+  gboolean pipelined;
   UNUSED (pad);
 
+  if (!self->servers) {
+    nns_loge ("The query client is not connected to the server.");
+    gst_buffer_unref (buf);
+    return GST_FLOW_ERROR;
+  }
+
+  /* The answers from multiple servers are matched by the sequence number. */
+  pipelined = (self->max_in_flight > 1 || self->servers->len > 1);
+
   ret = nns_edge_data_create (&data_h);
   if (ret != NNS_EDGE_ERROR_NONE) {
     nns_loge ("Failed to create data handle in client chain.");
@@ -682,42 +1891,87 @@ gst_tensor_query_client_chain (GstPad * pad,
       num_mems = i;
       goto done;
     }
-    nns_edge_data_add (data_h, map[i].data, map[i].size, NULL);
   }
 
-  nns_edge_get_info (self->edge_h, "client_id", &val);
+  /* Without the free slot of the shared memory, send the payload. */
+  if (self->shm &&
+      gst_tensor_query_shm_add_data (self->shm, data_h, map, num_mems)) {
+    nns_logd ("Send the payload via the shared memory.");
+  } else if (!gst_tensor_query_compress_add_data (data_h,
+          self->active_compression, self->active_quantize,
+          &self->in_config.info, map, num_mems)) {
+    nns_loge ("Failed to add the memories to the edge data.");
+    res = GST_FLOW_ERROR;
+    goto done;
+  }
+
+  if (pipelined) {
+    /* sequence number to match the answer */
+    val = g_strdup_printf ("%" G_GINT64_FORMAT, self->request_seq);
+    nns_edge_data_set_info (data_h, "request_id", val);
+    g_free (val);
+  }
+
+select_server:
+  server = gst_tensor_query_client_select_server (self);
+  if (!server) {
+    nns_loge ("Failed to send the buffer, no query server is available.");
+    res = GST_FLOW_ERROR;
+    goto done;
+  }
+
+  nns_edge_get_info (server->edge_h, "client_id", &val);
   nns_edge_data_set_info (data_h, "client_id", val);
   g_free (val);
 
-  if (NNS_EDGE_ERROR_NONE != nns_edge_send (self->edge_h, data_h)) {
+  gst_tensor_query_set_time (data_h, QUERY_TIME_CLIENT_SEND,
+      g_get_real_time ());
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_send (server->edge_h, data_h)) {
+    if (self->servers->len > 1) {
+      /* failover, send the buffer to other server and retry the connection later */
+      nns_logw ("Failed to publish to server %s:%u, try other server.",
+          server->host, server->port);
+      server->connected = FALSE;
+      server->retry_time = g_get_monotonic_time () + SERVER_RETRY_INTERVAL;
+      goto select_server;
+    }
+
     nns_logw ("Failed to publish to server node, retry connection.");
     goto retry;
   }
 
+  if (pipelined) {
+    nns_edge_data_h hedge_h = NULL;
+
+    /* keep the copy of the request, the mapped memories are released after sending */
+    if (self->hedge && self->servers->len > 1 &&
+        NNS_EDGE_ERROR_NONE != nns_edge_data_copy (data_h, &hedge_h))
+      hedge_h = NULL;
+
+    nns_edge_data_destroy (data_h);
+    data_h = NULL;
+
+    res = gst_tensor_query_client_add_request (self, buf, server, hedge_h);
+    goto done;
+  }
+
   nns_edge_data_destroy (data_h);
+  data_h = NULL;
 
-  data_h = g_async_queue_timeout_pop (self->msg_queue,
+  data_h = g_async_queue_timeout_pop (self->msg_queue, self->adaptive_timeout ?
+      gst_tensor_query_client_get_timeout (self) :
       self->timeout * G_TIME_SPAN_MILLISECOND);
   if (data_h) {
-    ret = nns_edge_data_get_count (data_h, &num_data);
-    if (ret != NNS_EDGE_ERROR_NONE || num_data == 0) {
-      nns_loge ("Failed to get the number of memories of the edge data.");
+    gst_tensor_query_client_update_latency (self, data_h);
+
+    out_buf = gst_buffer_new ();
+    if (!gst_tensor_query_client_append_data (data_h, out_buf)) {
+      gst_buffer_unref (out_buf);
       res = GST_FLOW_ERROR;
       goto done;
     }
 
-    out_buf = gst_buffer_new ();
-    for (i = 0; i < num_data; i++) {
-      void *data = NULL;
-      nns_size_t data_len;
-      gpointer new_data;
-
-      nns_edge_data_get (data_h, i, &data, &data_len);
-      new_data = _g_memdup (data, data_len);
-      gst_buffer_append_memory (out_buf,
-          gst_memory_new_wrapped (0, new_data, data_len, 0,
-              data_len, new_data, g_free));
-    }
     /* metadata from incoming buffer */
     gst_buffer_copy_into (out_buf, buf, GST_BUFFER_COPY_METADATA, 0, -1);
 
@@ -726,7 +1980,7 @@ gst_tensor_query_client_chain (GstPad * pad,
   goto done;
 
 retry:
-  if (!self->topic || !_client_retry_connection (self)) {
+  if (!self->topic || !_client_retry_connection (server)) {
     nns_loge ("Failed to retry connection");
     res = GST_FLOW_ERROR;
   }
@@ -772,3 +2026,29 @@ gst_tensor_query_client_query_caps (GstTensorQueryClient * self, GstPad * pad,
   silent_debug_caps (self, caps, "result");
   return caps;
 }
+
+/**
+ * @brief Initialize the connection pool.
+ */
+static void
+init_queryclient (void)
+{
+  G_LOCK (query_client_pool);
+  g_assert (NULL == _conn_pool); /** Internal error (duplicated init call?) */
+  _conn_pool = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+      _client_conn_queue_free);
+  G_UNLOCK (query_client_pool);
+}
+
+/**
+ * @brief Close the idle connections in the pool.
+ */
+static void
+fini_queryclient (void)
+{
+  G_LOCK (query_client_pool);
+  g_assert (_conn_pool); /** Internal error (init not called?) */
+  g_hash_table_destroy (_conn_pool);
+  _conn_pool = NULL;
+  G_UNLOCK (query_client_pool);
+}
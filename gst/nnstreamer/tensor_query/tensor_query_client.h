@@ -17,6 +17,8 @@
 #include <gio/gio.h>
 #include <tensor_common.h>
 #include "nnstreamer-edge.h"
+#include "tensor_query_compress.h"
+#include "tensor_query_shm.h"
 
 G_BEGIN_DECLS
 
@@ -35,6 +37,43 @@ G_BEGIN_DECLS
 typedef struct _GstTensorQueryClient GstTensorQueryClient;
 typedef struct _GstTensorQueryClientClass GstTensorQueryClientClass;
 
+/**
+ * @brief Policy to select the query server for each buffer.
+ */
+typedef enum
+{
+  QUERY_CLIENT_LB_LEAST_OUTSTANDING = 0, /**< the server with the least requests waiting for the answer */
+  QUERY_CLIENT_LB_LATENCY_WEIGHTED, /**< the server with the least expected latency (outstanding requests x round-trip time) */
+} query_client_load_balance_e;
+
+/**
+ * @brief Components of the latency breakdown of the request.
+ */
+typedef enum
+{
+  QUERY_LATENCY_TOTAL = 0, /**< round-trip time measured by the client */
+  QUERY_LATENCY_NETWORK, /**< round-trip time except the time spent in the server */
+  QUERY_LATENCY_QUEUE, /**< the server received the request until tensor_query_serversrc pushed it */
+  QUERY_LATENCY_INVOKE, /**< tensor_query_serversrc pushed the request until tensor_query_serversink got the result */
+
+  QUERY_LATENCY_NUM
+} query_latency_e;
+
+/**
+ * @brief The number of recent requests to get the latency percentiles.
+ */
+#define QUERY_LATENCY_WINDOW 256
+
+/**
+ * @brief Rolling window of the latency breakdown (in usec).
+ */
+typedef struct
+{
+  gint64 samples[QUERY_LATENCY_NUM][QUERY_LATENCY_WINDOW];
+  guint64 count; /**< number of the answers with the timestamps */
+  gint64 clock_offset; /**< estimated offset of the server clock from the client clock */
+} query_client_latency_s;
+
 /**
  * @brief GstTensorQueryClient data structure.
  */
@@ -56,9 +95,43 @@ struct _GstTensorQueryClient
   gchar *dest_host;
   guint16 dest_port;
 
+  gchar *dest_list; /**< comma-separated list of query servers (host:port) */
+
   nns_edge_connect_type_e connect_type;
-  nns_edge_h edge_h;
+  gchar *custom_lib; /**< path of the custom connection library */
+  GPtrArray *servers; /**< query servers and edge handles (query_client_server_s) */
+  guint load_balance; /**< policy to select the server for each buffer */
+  guint next_server; /**< index of the server to start the selection */
   GAsyncQueue *msg_queue;
+
+  /* Pipelined requests */
+  guint max_in_flight; /**< max number of requests waiting for the answer (1 to wait for each answer) */
+  gboolean out_of_order; /**< true to push the answers in the received order */
+  gint64 request_seq; /**< sequence number of the next request */
+  GQueue pending; /**< requests waiting for the answer, in the order of the requests */
+
+  /* Payload compression */
+  query_compress_e compression; /**< compression of the payload */
+  query_quantize_e quantize; /**< quantization of the float32 tensors */
+  query_compress_e active_compression; /**< compression accepted by the servers */
+  query_quantize_e active_quantize; /**< quantization accepted by the servers */
+  GstTensorsConfig in_config; /**< config of the incoming tensors to quantize */
+
+  /* Shared-memory transport */
+  gboolean shared_memory; /**< true to send the payload via the shared memory */
+  query_shm_s *shm; /**< shared-memory segment to send the payload */
+
+  /* Latency breakdown */
+  guint latency_report; /**< number of answers between the latency messages on the bus (0 to disable) */
+  query_client_latency_s latency; /**< latency breakdown of the recent requests, locked by the object lock */
+
+  /* Adaptive timeout and hedged requests */
+  gboolean adaptive_timeout; /**< true to derive the timeout from the round-trip time of the recent requests */
+  gboolean hedge; /**< true to send the request to other server if the answer is slower than the p95 */
+  gint64 rtt_p95; /**< p95 of the round-trip time (in usec) of the recent requests, 0 if unknown */
+  gint64 rtt_p99; /**< p99 of the round-trip time (in usec) of the recent requests, 0 if unknown */
+
+  gboolean connection_pool; /**< true to reuse the connections in the process-wide pool */
 };
 
 /**
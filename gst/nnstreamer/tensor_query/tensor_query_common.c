@@ -17,6 +17,8 @@
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include "nnstreamer_log.h"
+#include "nnstreamer_util.h"
 #include "tensor_query_common.h"
 
 #ifndef EREMOTEIO
@@ -36,6 +38,11 @@ gst_tensor_query_get_connect_type (void)
           "Directly sending stream frames via TCP connections."},
       {NNS_EDGE_CONNECT_TYPE_HYBRID, "HYBRID",
           "Connect with MQTT brokers and directly sending stream frames via TCP connections."},
+#ifdef ENABLE_NNSTREAMER_EDGE_CUSTOM
+      {NNS_EDGE_CONNECT_TYPE_CUSTOM, "CUSTOM",
+          "Sending stream frames via the connection loaded from custom-lib, "
+          "e.g., QUIC or UDP with FEC to avoid the head-of-line blocking of TCP."},
+#endif
       {0, NULL, NULL},
     };
     protocol = g_enum_register_static ("tensor_query_protocol", protocols);
@@ -43,3 +50,123 @@ gst_tensor_query_get_connect_type (void)
 
   return protocol;
 }
+
+/**
+ * @brief Create the edge handle, the connection of custom type is loaded from the library.
+ */
+int
+gst_tensor_query_create_edge_handle (const char *id,
+    nns_edge_connect_type_e connect_type, const gchar * custom_lib,
+    nns_edge_node_type_e node_type, nns_edge_h * edge_h)
+{
+#ifdef ENABLE_NNSTREAMER_EDGE_CUSTOM
+  if (connect_type == NNS_EDGE_CONNECT_TYPE_CUSTOM) {
+    if (!custom_lib) {
+      nns_loge ("The custom-lib should be given for the custom connection.");
+      return NNS_EDGE_ERROR_INVALID_PARAMETER;
+    }
+
+    return nns_edge_custom_create_handle (id, custom_lib, node_type, edge_h);
+  }
+#else
+  UNUSED (custom_lib);
+#endif
+
+  return nns_edge_create_handle (id, connect_type, node_type, edge_h);
+}
+
+/**
+ * @brief Get the caps string of a single request from the caps of the batched tensors.
+ */
+gchar *
+gst_tensor_query_get_item_caps_str (GstCaps * caps, guint batch)
+{
+  GstTensorsConfig config;
+  GstStructure *structure;
+  GstCaps *item_caps;
+  GstTensorInfo *info;
+  gchar *caps_str;
+  guint i, rank;
+
+  if (batch <= 1 || !gst_caps_is_fixed (caps))
+    return gst_caps_to_string (caps);
+
+  structure = gst_caps_get_structure (caps, 0);
+  if (!gst_structure_is_tensor_stream (structure) ||
+      !gst_tensors_config_from_structure (&config, structure))
+    return gst_caps_to_string (caps);
+
+  for (i = 0; i < config.info.num_tensors; i++) {
+    info = &config.info.info[i];
+    rank = gst_tensor_info_get_rank (info);
+
+    if (rank > 0 && info->dimension[rank - 1] == batch)
+      info->dimension[rank - 1] = 1;
+    else
+      nns_logw ("The outermost dimension of the tensor %u is not the batch %u.",
+          i, batch);
+  }
+
+  item_caps = gst_tensors_caps_from_config (&config);
+  caps_str = gst_caps_to_string (item_caps);
+
+  gst_caps_unref (item_caps);
+  gst_tensors_config_free (&config);
+  return caps_str;
+}
+
+/**
+ * @brief Set the timestamp (in usec) to the edge data.
+ */
+void
+gst_tensor_query_set_time (nns_edge_data_h data_h, const gchar * key,
+    gint64 time)
+{
+  gchar *val;
+
+  if (time <= 0)
+    return;
+
+  val = g_strdup_printf ("%" G_GINT64_FORMAT, time);
+  nns_edge_data_set_info (data_h, key, val);
+  g_free (val);
+}
+
+/**
+ * @brief Get the timestamp (in usec) from the edge data.
+ */
+gint64
+gst_tensor_query_get_time (nns_edge_data_h data_h, const gchar * key)
+{
+  gchar *val = NULL;
+  gint64 time = 0;
+
+  if (NNS_EDGE_ERROR_NONE == nns_edge_data_get_info (data_h, key, &val)) {
+    time = g_ascii_strtoll (val, NULL, 10);
+    g_free (val);
+  }
+
+  return MAX (time, 0);
+}
+
+/**
+ * @brief Get the total size of the memories in the edge data.
+ */
+gsize
+gst_tensor_query_get_data_size (nns_edge_data_h data_h)
+{
+  unsigned int i, num = 0;
+  void *data;
+  nns_size_t data_len;
+  gsize size = 0;
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get_count (data_h, &num))
+    return 0;
+
+  for (i = 0; i < num; i++) {
+    if (NNS_EDGE_ERROR_NONE == nns_edge_data_get (data_h, i, &data, &data_len))
+      size += data_len;
+  }
+
+  return size;
+}
@@ -27,6 +27,17 @@ extern "C" {
  */
 #define QUERY_DEFAULT_TIMEOUT_SEC 10
 
+/**
+ * @brief Keys of the timestamps of the request in the edge data, real time (in usec) of each host.
+ * The client computes the latency breakdown with the timestamps in the answer.
+ */
+#define QUERY_TIME_CLIENT_SEND "client_send_time"
+#define QUERY_TIME_CLIENT_RECV "client_recv_time"
+#define QUERY_TIME_SERVER_RECV "server_recv_time"
+#define QUERY_TIME_INVOKE_START "server_invoke_start"
+#define QUERY_TIME_INVOKE_END "server_invoke_end"
+#define QUERY_TIME_SERVER_SEND "server_send_time"
+
 /**
  * @brief protocol options for tensor query.
  */
@@ -40,6 +51,45 @@ extern "C" {
 GType
 gst_tensor_query_get_connect_type (void);
 
+/**
+ * @brief Create the edge handle, the connection of custom type is loaded from the library.
+ * @param custom_lib the path of the custom connection library, valid only for the custom type.
+ * @return NNS_EDGE_ERROR_NONE if the handle is created.
+ */
+int
+gst_tensor_query_create_edge_handle (const char *id,
+    nns_edge_connect_type_e connect_type, const gchar * custom_lib,
+    nns_edge_node_type_e node_type, nns_edge_h * edge_h);
+
+/**
+ * @brief Get the caps string of a single request from the caps of the batched tensors.
+ * @param caps the caps of the batched tensors, the outermost dimension of each tensor is the batch.
+ * @param batch the number of requests in a batch.
+ * @return Newly allocated caps string. The caller should free it.
+ */
+gchar *
+gst_tensor_query_get_item_caps_str (GstCaps * caps, guint batch);
+
+/**
+ * @brief Set the timestamp (in usec) to the edge data. Nothing is set if the time is not positive.
+ */
+void
+gst_tensor_query_set_time (nns_edge_data_h data_h, const gchar * key,
+    gint64 time);
+
+/**
+ * @brief Get the timestamp (in usec) from the edge data.
+ * @return the timestamp, or 0 if not given.
+ */
+gint64
+gst_tensor_query_get_time (nns_edge_data_h data_h, const gchar * key);
+
+/**
+ * @brief Get the total size of the memories in the edge data.
+ */
+gsize
+gst_tensor_query_get_data_size (nns_edge_data_h data_h);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
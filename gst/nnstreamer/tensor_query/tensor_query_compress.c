@@ -0,0 +1,978 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file   tensor_query_compress.c
+ * @date   14 Oct 2026
+ * @brief  Payload compression and quantization of the edge data for tensor query and edge elements
+ * @see    https://github.com/nnstreamer/nnstreamer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ *
+ * The encoded edge data has the info below, the receiver decodes the payload with it.
+ * - "compression": the nick of the compression (not set if not compressed)
+ * - "raw_size": comma-separated sizes of the decoded memories
+ * - "quantize": comma-separated nicks of the quantization of each memory
+ * - "quant_scale": comma-separated scales of the int8 quantization of each memory
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <string.h>
+#include "tensor_query_compress.h"
+#include "nnstreamer_log.h"
+#include "nnstreamer_util.h"
+
+#ifdef ENABLE_LZ4
+#include <lz4.h>
+#endif
+#ifdef ENABLE_ZSTD
+#include <zstd.h>
+#endif
+
+/**
+ * @brief Compression level of zstd. Use the fast level, the payload is sent in real time.
+ */
+#define QUERY_ZSTD_LEVEL 1
+
+/**
+ * @brief Max number of the free memory blocks in the pool.
+ */
+#define QUERY_POOL_MAX_BLOCKS 16
+
+/**
+ * @brief Decoding info of the edge data.
+ */
+typedef struct
+{
+  query_compress_e compress;
+  guint num;
+  gsize raw_size[NNS_TENSOR_SIZE_LIMIT];
+  query_quantize_e quant[NNS_TENSOR_SIZE_LIMIT];
+  gfloat scale[NNS_TENSOR_SIZE_LIMIT];
+} query_codec_info_s;
+
+/**
+ * @brief Data structure of the memory pool for the decoded payload.
+ */
+struct _query_decompress_pool_s
+{
+  gint ref_count;
+  GMutex lock;
+  GSList *blocks; /**< free memory blocks (query_pool_block_s) */
+  guint num_blocks;
+};
+
+/**
+ * @brief Memory block in the pool.
+ */
+typedef struct
+{
+  query_decompress_pool_s *pool;
+  gsize size;
+  guint8 *data;
+} query_pool_block_s;
+
+/**
+ * @brief The received edge data shared by the wrapped memories.
+ */
+typedef struct
+{
+  gint ref_count;
+  nns_edge_data_h data_h;
+} query_data_ref_s;
+
+/**
+ * @brief Register GEnumValue array for the compression property.
+ */
+GType
+gst_tensor_query_compression_get_type (void)
+{
+  static GType compression = 0;
+  if (compression == 0) {
+    static GEnumValue compressions[] = {
+      {QUERY_COMPRESS_NONE, "none", "Send the payload as it is."},
+      {QUERY_COMPRESS_LZ4, "lz4",
+          "Compress the payload with LZ4, fast with moderate ratio."},
+      {QUERY_COMPRESS_ZSTD, "zstd",
+          "Compress the payload with Zstandard, better ratio than LZ4."},
+      {0, NULL, NULL},
+    };
+    compression =
+        g_enum_register_static ("tensor_query_compression", compressions);
+  }
+
+  return compression;
+}
+
+/**
+ * @brief Register GEnumValue array for the quantize property.
+ */
+GType
+gst_tensor_query_quantize_get_type (void)
+{
+  static GType quantize = 0;
+  if (quantize == 0) {
+    static GEnumValue quantizes[] = {
+      {QUERY_QUANTIZE_NONE, "none", "Send the float32 tensors as they are."},
+      {QUERY_QUANTIZE_FP16, "fp16",
+          "Convert the float32 tensors to float16, the receiver restores float32."},
+      {QUERY_QUANTIZE_INT8, "int8",
+          "Quantize the float32 tensors to int8 with a scale per tensor, the receiver restores float32."},
+      {0, NULL, NULL},
+    };
+    quantize = g_enum_register_static ("tensor_query_quantize", quantizes);
+  }
+
+  return quantize;
+}
+
+/**
+ * @brief Get the nick of the enum value.
+ */
+static const gchar *
+_codec_get_nick (GType type, gint value)
+{
+  GEnumClass *klass = g_type_class_ref (type);
+  GEnumValue *val = g_enum_get_value (klass, value);
+  const gchar *nick = val ? val->value_name : NULL;
+
+  /* The enum class is static, the name is valid after unref. */
+  g_type_class_unref (klass);
+  return nick;
+}
+
+/**
+ * @brief Get the enum value from the nick.
+ */
+static gint
+_codec_get_value (GType type, const gchar * nick)
+{
+  GEnumClass *klass = g_type_class_ref (type);
+  GEnumValue *val = g_enum_get_value_by_name (klass, nick);
+  gint value = val ? val->value : -1;
+
+  g_type_class_unref (klass);
+  return value;
+}
+
+/**
+ * @brief Check whether the compression is available in this build.
+ */
+gboolean
+gst_tensor_query_compression_is_supported (query_compress_e compress)
+{
+  switch (compress) {
+    case QUERY_COMPRESS_NONE:
+      return TRUE;
+#ifdef ENABLE_LZ4
+    case QUERY_COMPRESS_LZ4:
+      return TRUE;
+#endif
+#ifdef ENABLE_ZSTD
+    case QUERY_COMPRESS_ZSTD:
+      return TRUE;
+#endif
+    default:
+      break;
+  }
+
+  return FALSE;
+}
+
+/**
+ * @brief Get the comma-separated list of the codecs available in this build.
+ */
+gchar *
+gst_tensor_query_get_supported_codecs (void)
+{
+  GString *codecs = g_string_new (NULL);
+
+#ifdef ENABLE_LZ4
+  g_string_append (codecs, "lz4,");
+#endif
+#ifdef ENABLE_ZSTD
+  g_string_append (codecs, "zstd,");
+#endif
+  g_string_append (codecs, "fp16,int8");
+
+  return g_string_free (codecs, FALSE);
+}
+
+/**
+ * @brief Check whether the codec name is in the list of the codecs.
+ */
+gboolean
+gst_tensor_query_codec_is_accepted (const gchar * codecs, const gchar * name)
+{
+  gchar **strv;
+  gboolean accepted;
+
+  if (!codecs || !name)
+    return FALSE;
+
+  strv = g_strsplit (codecs, ",", -1);
+  accepted = g_strv_contains ((const gchar * const *) strv, name);
+  g_strfreev (strv);
+
+  return accepted;
+}
+
+/**
+ * @brief Convert float32 to float16 (round to nearest).
+ */
+static guint16
+_float_to_half (gfloat value)
+{
+  guint32 u, mant, half;
+  guint32 sign;
+  gint32 exp;
+
+  memcpy (&u, &value, sizeof (u));
+  sign = (u >> 16) & 0x8000;
+  exp = (gint32) ((u >> 23) & 0xff) - 127 + 15;
+  mant = u & 0x7fffff;
+
+  if (((u >> 23) & 0xff) == 0xff) {
+    /* inf or nan */
+    return sign | 0x7c00 | (mant ? 0x200 : 0);
+  }
+
+  if (exp >= 0x1f) {
+    /* overflow */
+    return sign | 0x7c00;
+  }
+
+  if (exp <= 0) {
+    guint32 shift;
+
+    /* subnormal or zero */
+    if (exp < -10)
+      return sign;
+
+    mant |= 0x800000;
+    shift = (guint32) (14 - exp);
+    half = mant >> shift;
+    if ((mant >> (shift - 1)) & 1)
+      half++;
+
+    return sign | half;
+  }
+
+  half = sign | ((guint32) exp << 10) | (mant >> 13);
+  if (mant & 0x1000)
+    half++;                     /* the carry rounds up to the exponent */
+
+  return half;
+}
+
+/**
+ * @brief Convert float16 to float32.
+ */
+static gfloat
+_half_to_float (guint16 half)
+{
+  guint32 sign = ((guint32) half & 0x8000) << 16;
+  guint32 exp = (half >> 10) & 0x1f;
+  guint32 mant = half & 0x3ff;
+  guint32 u;
+  gfloat value;
+
+  if (exp == 0) {
+    if (mant == 0) {
+      u = sign;
+    } else {
+      /* subnormal, normalize the mantissa */
+      exp = 127 - 15 + 1;
+      while (!(mant & 0x400)) {
+        mant <<= 1;
+        exp--;
+      }
+      mant &= 0x3ff;
+      u = sign | (exp << 23) | (mant << 13);
+    }
+  } else if (exp == 0x1f) {
+    u = sign | 0x7f800000 | (mant << 13);
+  } else {
+    u = sign | ((exp + 127 - 15) << 23) | (mant << 13);
+  }
+
+  memcpy (&value, &u, sizeof (value));
+  return value;
+}
+
+/**
+ * @brief Quantize the float32 data. The data may not be aligned.
+ * @return Newly allocated data. The caller should free it.
+ */
+static guint8 *
+_quantize (query_quantize_e quant, const guint8 * src, gsize size,
+    gsize * out_size, gfloat * scale)
+{
+  gsize i, n = size / sizeof (gfloat);
+  guint8 *out;
+  gfloat val, max = 0.0f;
+
+  if (quant == QUERY_QUANTIZE_FP16) {
+    *out_size = n * sizeof (guint16);
+    out = g_malloc (*out_size);
+
+    for (i = 0; i < n; i++) {
+      guint16 half;
+
+      memcpy (&val, src + i * sizeof (gfloat), sizeof (gfloat));
+      half = _float_to_half (val);
+      memcpy (out + i * sizeof (guint16), &half, sizeof (guint16));
+    }
+
+    *scale = 1.0f;
+    return out;
+  }
+
+  /* symmetric int8 quantization with the max absolute value */
+  for (i = 0; i < n; i++) {
+    memcpy (&val, src + i * sizeof (gfloat), sizeof (gfloat));
+    if (val < 0)
+      val = -val;
+    if (val > max)
+      max = val;
+  }
+
+  *scale = (max > 0.0f) ? (max / 127.0f) : 1.0f;
+  *out_size = n;
+  out = g_malloc (*out_size);
+
+  for (i = 0; i < n; i++) {
+    memcpy (&val, src + i * sizeof (gfloat), sizeof (gfloat));
+    val = val / *scale;
+    val = CLAMP (val, -127.0f, 127.0f);
+    ((gint8 *) out)[i] = (gint8) (val >= 0 ? val + 0.5f : val - 0.5f);
+  }
+
+  return out;
+}
+
+/**
+ * @brief Restore the float32 data from the quantized data.
+ */
+static void
+_dequantize (query_quantize_e quant, const guint8 * src, gfloat scale,
+    guint8 * dest, gsize size)
+{
+  gsize i, n = size / sizeof (gfloat);
+  gfloat val;
+
+  for (i = 0; i < n; i++) {
+    if (quant == QUERY_QUANTIZE_FP16) {
+      guint16 half;
+
+      memcpy (&half, src + i * sizeof (guint16), sizeof (guint16));
+      val = _half_to_float (half);
+    } else {
+      val = ((const gint8 *) src)[i] * scale;
+    }
+
+    memcpy (dest + i * sizeof (gfloat), &val, sizeof (gfloat));
+  }
+}
+
+/**
+ * @brief Get the size of the quantized data.
+ */
+static gsize
+_quantized_size (query_quantize_e quant, gsize size)
+{
+  switch (quant) {
+    case QUERY_QUANTIZE_FP16:
+      return size / sizeof (gfloat) * sizeof (guint16);
+    case QUERY_QUANTIZE_INT8:
+      return size / sizeof (gfloat);
+    default:
+      break;
+  }
+
+  return size;
+}
+
+/**
+ * @brief Compress the data.
+ * @return Newly allocated data, or NULL if failed. The caller should free it.
+ */
+static guint8 *
+_compress (query_compress_e compress, const guint8 * src, gsize size,
+    gsize * out_size)
+{
+  guint8 *out = NULL;
+
+  switch (compress) {
+#ifdef ENABLE_LZ4
+    case QUERY_COMPRESS_LZ4:
+    {
+      int bound, len;
+
+      if (size > LZ4_MAX_INPUT_SIZE)
+        break;
+
+      bound = LZ4_compressBound ((int) size);
+      out = g_malloc (bound);
+      len = LZ4_compress_default ((const char *) src, (char *) out, (int) size,
+          bound);
+      if (len <= 0) {
+        g_free (out);
+        return NULL;
+      }
+
+      *out_size = len;
+      return out;
+    }
+#endif
+#ifdef ENABLE_ZSTD
+    case QUERY_COMPRESS_ZSTD:
+    {
+      size_t bound, len;
+
+      bound = ZSTD_compressBound (size);
+      out = g_malloc (bound);
+      len = ZSTD_compress (out, bound, src, size, QUERY_ZSTD_LEVEL);
+      if (ZSTD_isError (len)) {
+        g_free (out);
+        return NULL;
+      }
+
+      *out_size = len;
+      return out;
+    }
+#endif
+    default:
+      break;
+  }
+
+  UNUSED (src);
+  UNUSED (size);
+  UNUSED (out_size);
+  return out;
+}
+
+/**
+ * @brief Decompress the data into the destination.
+ */
+static gboolean
+_decompress (query_compress_e compress, const guint8 * src, gsize size,
+    guint8 * dest, gsize dest_size)
+{
+  switch (compress) {
+#ifdef ENABLE_LZ4
+    case QUERY_COMPRESS_LZ4:
+    {
+      int len = LZ4_decompress_safe ((const char *) src, (char *) dest,
+          (int) size, (int) dest_size);
+
+      return (len >= 0 && (gsize) len == dest_size);
+    }
+#endif
+#ifdef ENABLE_ZSTD
+    case QUERY_COMPRESS_ZSTD:
+    {
+      size_t len = ZSTD_decompress (dest, dest_size, src, size);
+
+      return (!ZSTD_isError (len) && len == dest_size);
+    }
+#endif
+    default:
+      break;
+  }
+
+  UNUSED (src);
+  UNUSED (size);
+  UNUSED (dest);
+  UNUSED (dest_size);
+  return FALSE;
+}
+
+/**
+ * @brief Add the memories to the edge data, compressing and quantizing the payload.
+ */
+gboolean
+gst_tensor_query_compress_add_data (nns_edge_data_h data_h,
+    query_compress_e compress, query_quantize_e quantize,
+    const GstTensorsInfo * info, GstMapInfo * map, guint num)
+{
+  GString *raw_size, *quant, *scale;
+  gchar str[G_ASCII_DTOSTR_BUF_SIZE];
+  guint i;
+  gboolean ret = TRUE;
+
+  if (compress == QUERY_COMPRESS_NONE && quantize == QUERY_QUANTIZE_NONE) {
+    for (i = 0; i < num; i++)
+      nns_edge_data_add (data_h, map[i].data, map[i].size, NULL);
+    return TRUE;
+  }
+
+  if (!gst_tensor_query_compression_is_supported (compress)) {
+    nns_loge ("The compression %s is not supported in this build.",
+        _codec_get_nick (GST_TYPE_QUERY_COMPRESSION, compress));
+    return FALSE;
+  }
+
+  raw_size = g_string_new (NULL);
+  quant = g_string_new (NULL);
+  scale = g_string_new (NULL);
+
+  for (i = 0; i < num; i++) {
+    const guint8 *data = map[i].data;
+    gsize size = map[i].size;
+    guint8 *qdata = NULL, *cdata = NULL;
+    query_quantize_e q = QUERY_QUANTIZE_NONE;
+    gfloat s = 1.0f;
+
+    /* quantize the static float32 tensors only */
+    if (quantize != QUERY_QUANTIZE_NONE && info &&
+        info->format == _NNS_TENSOR_FORMAT_STATIC && i < info->num_tensors &&
+        info->info[i].type == _NNS_FLOAT32 && size % sizeof (gfloat) == 0) {
+      q = quantize;
+      qdata = _quantize (q, data, size, &size, &s);
+      data = qdata;
+    }
+
+    if (compress != QUERY_COMPRESS_NONE) {
+      cdata = _compress (compress, data, size, &size);
+      if (!cdata) {
+        nns_loge ("Failed to compress the %uth memory.", i);
+        g_free (qdata);
+        ret = FALSE;
+        break;
+      }
+
+      g_free (qdata);
+      qdata = NULL;
+      data = cdata;
+    }
+
+    if (cdata || qdata) {
+      /* the edge data releases the encoded data */
+      nns_edge_data_add (data_h, (void *) data, size, g_free);
+    } else {
+      nns_edge_data_add (data_h, map[i].data, map[i].size, NULL);
+    }
+
+    g_string_append_printf (raw_size, "%s%" G_GSIZE_FORMAT, i ? "," : "",
+        map[i].size);
+    g_string_append_printf (quant, "%s%s", i ? "," : "",
+        _codec_get_nick (GST_TYPE_QUERY_QUANTIZE, q));
+    g_ascii_dtostr (str, sizeof (str), s);
+    g_string_append_printf (scale, "%s%s", i ? "," : "", str);
+  }
+
+  if (ret) {
+    if (compress != QUERY_COMPRESS_NONE)
+      nns_edge_data_set_info (data_h, "compression",
+          _codec_get_nick (GST_TYPE_QUERY_COMPRESSION, compress));
+    nns_edge_data_set_info (data_h, "raw_size", raw_size->str);
+    nns_edge_data_set_info (data_h, "quantize", quant->str);
+    nns_edge_data_set_info (data_h, "quant_scale", scale->str);
+  }
+
+  g_string_free (raw_size, TRUE);
+  g_string_free (quant, TRUE);
+  g_string_free (scale, TRUE);
+
+  return ret;
+}
+
+/**
+ * @brief Parse the decoding info of the edge data.
+ * @return FALSE if the info is invalid. If the data is not encoded, codec->num is 0.
+ */
+static gboolean
+_codec_parse_info (nns_edge_data_h data_h, query_codec_info_s * codec)
+{
+  gchar *val = NULL;
+  gchar **sizes = NULL, **quants = NULL, **scales = NULL;
+  guint i, num;
+  gboolean ret = FALSE;
+
+  memset (codec, 0, sizeof (query_codec_info_s));
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get_info (data_h, "raw_size", &val))
+    return TRUE;
+
+  sizes = g_strsplit (val, ",", -1);
+  g_free (val);
+  val = NULL;
+
+  if (NNS_EDGE_ERROR_NONE == nns_edge_data_get_info (data_h, "compression",
+          &val)) {
+    gint c = _codec_get_value (GST_TYPE_QUERY_COMPRESSION, val);
+
+    if (c < 0 || !gst_tensor_query_compression_is_supported (c)) {
+      nns_loge ("The compression %s is not supported in this build.", val);
+      goto done;
+    }
+
+    codec->compress = c;
+    g_free (val);
+    val = NULL;
+  }
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get_info (data_h, "quantize", &val))
+    goto done;
+  quants = g_strsplit (val, ",", -1);
+  g_free (val);
+  val = NULL;
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get_info (data_h, "quant_scale",
+          &val))
+    goto done;
+  scales = g_strsplit (val, ",", -1);
+
+  num = g_strv_length (sizes);
+  if (num == 0 || num > NNS_TENSOR_SIZE_LIMIT ||
+      g_strv_length (quants) != num || g_strv_length (scales) != num)
+    goto done;
+
+  for (i = 0; i < num; i++) {
+    gint q = _codec_get_value (GST_TYPE_QUERY_QUANTIZE, quants[i]);
+
+    if (q < 0)
+      goto done;
+
+    codec->raw_size[i] = g_ascii_strtoull (sizes[i], NULL, 10);
+    codec->quant[i] = q;
+    codec->scale[i] = (gfloat) g_ascii_strtod (scales[i], NULL);
+  }
+
+  codec->num = num;
+  ret = TRUE;
+
+done:
+  if (!ret)
+    nns_loge ("Invalid codec info of the edge data.");
+
+  g_free (val);
+  g_strfreev (sizes);
+  g_strfreev (quants);
+  g_strfreev (scales);
+  return ret;
+}
+
+/**
+ * @brief Decode the memory with the codec info.
+ */
+static gboolean
+_codec_decode (const query_codec_info_s * codec, guint index,
+    const guint8 * src, gsize src_size, guint8 * dest, gsize size)
+{
+  query_quantize_e quant = codec->quant[index];
+  gsize qsize = _quantized_size (quant, size);
+  const guint8 *qdata = src;
+  guint8 *tmp = NULL;
+
+  if (size != codec->raw_size[index])
+    return FALSE;
+
+  if (codec->compress != QUERY_COMPRESS_NONE) {
+    guint8 *target = dest;
+
+    if (quant != QUERY_QUANTIZE_NONE)
+      target = tmp = g_malloc (qsize);
+
+    if (!_decompress (codec->compress, src, src_size, target, qsize)) {
+      nns_loge ("Failed to decompress the %uth memory.", index);
+      g_free (tmp);
+      return FALSE;
+    }
+
+    qdata = target;
+  } else if (src_size != qsize) {
+    return FALSE;
+  }
+
+  if (quant != QUERY_QUANTIZE_NONE)
+    _dequantize (quant, qdata, codec->scale[index], dest, size);
+  else if (qdata != dest)
+    memcpy (dest, qdata, size);
+
+  g_free (tmp);
+  return TRUE;
+}
+
+/**
+ * @brief Get the decoded sizes of the memories in the edge data.
+ */
+gboolean
+gst_tensor_query_decompress_get_sizes (nns_edge_data_h data_h, gsize * sizes,
+    guint * num)
+{
+  query_codec_info_s codec;
+  guint i, count;
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get_count (data_h, &count) ||
+      count == 0 || count > NNS_TENSOR_SIZE_LIMIT)
+    return FALSE;
+
+  if (!_codec_parse_info (data_h, &codec))
+    return FALSE;
+
+  if (codec.num > 0 && codec.num != count)
+    return FALSE;
+
+  for (i = 0; i < count; i++) {
+    void *data = NULL;
+    nns_size_t data_len = 0;
+
+    if (codec.num > 0) {
+      sizes[i] = codec.raw_size[i];
+    } else {
+      nns_edge_data_get (data_h, i, &data, &data_len);
+      sizes[i] = data_len;
+    }
+  }
+
+  *num = count;
+  return TRUE;
+}
+
+/**
+ * @brief Decode the memory of the edge data into the given destination.
+ */
+gboolean
+gst_tensor_query_decompress_copy (nns_edge_data_h data_h, guint index,
+    guint8 * dest, gsize size)
+{
+  query_codec_info_s codec;
+  void *data = NULL;
+  nns_size_t data_len = 0;
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get (data_h, index, &data,
+          &data_len))
+    return FALSE;
+
+  if (!_codec_parse_info (data_h, &codec))
+    return FALSE;
+
+  if (codec.num == 0) {
+    if (data_len != size)
+      return FALSE;
+
+    memcpy (dest, data, size);
+    return TRUE;
+  }
+
+  if (index >= codec.num)
+    return FALSE;
+
+  return _codec_decode (&codec, index, data, data_len, dest, size);
+}
+
+/**
+ * @brief Create new memory pool for the decoded payload.
+ */
+query_decompress_pool_s *
+gst_tensor_query_decompress_pool_new (void)
+{
+  query_decompress_pool_s *pool = g_new0 (query_decompress_pool_s, 1);
+
+  pool->ref_count = 1;
+  g_mutex_init (&pool->lock);
+
+  return pool;
+}
+
+/**
+ * @brief Unref the memory pool, free the blocks if the pool is not used.
+ */
+static void
+_pool_unref (query_decompress_pool_s * pool)
+{
+  GSList *l;
+
+  if (!g_atomic_int_dec_and_test (&pool->ref_count))
+    return;
+
+  for (l = pool->blocks; l; l = l->next) {
+    query_pool_block_s *block = l->data;
+
+    g_free (block->data);
+    g_free (block);
+  }
+
+  g_slist_free (pool->blocks);
+  g_mutex_clear (&pool->lock);
+  g_free (pool);
+}
+
+/**
+ * @brief Release the memory pool.
+ */
+void
+gst_tensor_query_decompress_pool_free (query_decompress_pool_s * pool)
+{
+  if (pool)
+    _pool_unref (pool);
+}
+
+/**
+ * @brief Destroy the received edge data when all wrapped memories are released.
+ */
+static void
+_data_ref_unref (gpointer data)
+{
+  query_data_ref_s *ref = (query_data_ref_s *) data;
+
+  if (!g_atomic_int_dec_and_test (&ref->ref_count))
+    return;
+
+  nns_edge_data_destroy (ref->data_h);
+  g_free (ref);
+}
+
+/**
+ * @brief Wrap the raw memories of the edge data and append them to the buffer without copying.
+ */
+static gboolean
+_wrap_append (nns_edge_data_h data_h, guint num, GstBuffer * buffer)
+{
+  query_data_ref_s *ref;
+  gboolean ret = TRUE;
+  guint i;
+
+  ref = g_new0 (query_data_ref_s, 1);
+  ref->ref_count = 1;
+  ref->data_h = data_h;
+
+  for (i = 0; i < num; i++) {
+    void *data = NULL;
+    nns_size_t data_len = 0;
+
+    if (NNS_EDGE_ERROR_NONE != nns_edge_data_get (data_h, i, &data, &data_len)) {
+      nns_loge ("Failed to get the %uth memory of the edge data.", i);
+      ret = FALSE;
+      break;
+    }
+
+    g_atomic_int_inc (&ref->ref_count);
+    gst_buffer_append_memory (buffer,
+        gst_memory_new_wrapped (0, data, data_len, 0, data_len, ref,
+            _data_ref_unref));
+  }
+
+  _data_ref_unref (ref);
+  return ret;
+}
+
+/**
+ * @brief Get the memory block with the size from the pool.
+ */
+static query_pool_block_s *
+_pool_acquire (query_decompress_pool_s * pool, gsize size)
+{
+  query_pool_block_s *block = NULL;
+  GSList *l;
+
+  g_mutex_lock (&pool->lock);
+  for (l = pool->blocks; l; l = l->next) {
+    query_pool_block_s *b = l->data;
+
+    if (b->size == size) {
+      block = b;
+      pool->blocks = g_slist_delete_link (pool->blocks, l);
+      pool->num_blocks--;
+      break;
+    }
+  }
+  g_mutex_unlock (&pool->lock);
+
+  if (!block) {
+    block = g_new0 (query_pool_block_s, 1);
+    block->size = size;
+    block->data = g_malloc (size);
+  }
+
+  block->pool = pool;
+  g_atomic_int_inc (&pool->ref_count);
+
+  return block;
+}
+
+/**
+ * @brief Return the memory block to the pool when the memory is released.
+ */
+static void
+_pool_release (gpointer data)
+{
+  query_pool_block_s *block = (query_pool_block_s *) data;
+  query_decompress_pool_s *pool = block->pool;
+
+  g_mutex_lock (&pool->lock);
+  if (pool->num_blocks < QUERY_POOL_MAX_BLOCKS) {
+    pool->blocks = g_slist_prepend (pool->blocks, block);
+    pool->num_blocks++;
+    block = NULL;
+  }
+  g_mutex_unlock (&pool->lock);
+
+  if (block) {
+    g_free (block->data);
+    g_free (block);
+  }
+
+  _pool_unref (pool);
+}
+
+/**
+ * @brief Decode the memories of the edge data and append them to the buffer.
+ */
+gboolean
+gst_tensor_query_decompress_append (query_decompress_pool_s * pool,
+    nns_edge_data_h data_h, GstBuffer * buffer)
+{
+  query_codec_info_s codec;
+  guint i, num;
+  gboolean ret = FALSE;
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get_count (data_h, &num) ||
+      num == 0 || num > NNS_TENSOR_SIZE_LIMIT) {
+    nns_loge ("Failed to get the number of memories of the edge data.");
+    goto done;
+  }
+
+  if (!_codec_parse_info (data_h, &codec))
+    goto done;
+
+  /* The raw payload is not copied, the memories keep the edge data. */
+  if (codec.num == 0)
+    return _wrap_append (data_h, num, buffer);
+
+  if (codec.num != num) {
+    nns_loge ("Invalid codec info, the number of memories is different.");
+    goto done;
+  }
+
+  for (i = 0; i < num; i++) {
+    void *data = NULL;
+    nns_size_t data_len = 0;
+    gsize size;
+    query_pool_block_s *block;
+
+    nns_edge_data_get (data_h, i, &data, &data_len);
+    size = (codec.num > 0) ? codec.raw_size[i] : data_len;
+
+    block = _pool_acquire (pool, size);
+    if (!_codec_decode (&codec, i, data, data_len, block->data, size)) {
+      nns_loge ("Failed to decode the %uth memory of the edge data.", i);
+      _pool_release (block);
+      goto done;
+    }
+
+    gst_buffer_append_memory (buffer,
+        gst_memory_new_wrapped (0, block->data, size, 0, size, block,
+            _pool_release));
+  }
+
+  ret = TRUE;
+
+done:
+  nns_edge_data_destroy (data_h);
+  return ret;
+}
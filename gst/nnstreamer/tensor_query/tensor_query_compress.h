@@ -0,0 +1,157 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file   tensor_query_compress.h
+ * @date   14 Oct 2026
+ * @brief  Payload compression and quantization of the edge data for tensor query and edge elements
+ * @see    https://github.com/nnstreamer/nnstreamer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ */
+
+#ifndef __TENSOR_QUERY_COMPRESS_H__
+#define __TENSOR_QUERY_COMPRESS_H__
+
+#include <glib.h>
+#include <gst/gst.h>
+#include "tensor_typedef.h"
+#include "nnstreamer-edge.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#define GST_TYPE_QUERY_COMPRESSION (gst_tensor_query_compression_get_type ())
+#define GST_TYPE_QUERY_QUANTIZE (gst_tensor_query_quantize_get_type ())
+
+/**
+ * @brief The key of the codecs in the caps info of the query server.
+ */
+#define QUERY_SERVER_CODECS_KEY "query_server_codecs"
+
+/**
+ * @brief Compression of the payload.
+ */
+typedef enum
+{
+  QUERY_COMPRESS_NONE = 0,
+  QUERY_COMPRESS_LZ4,
+  QUERY_COMPRESS_ZSTD,
+} query_compress_e;
+
+/**
+ * @brief Quantization of the float32 tensors in the payload.
+ */
+typedef enum
+{
+  QUERY_QUANTIZE_NONE = 0,
+  QUERY_QUANTIZE_FP16,
+  QUERY_QUANTIZE_INT8,
+} query_quantize_e;
+
+/**
+ * @brief Pool of the memory blocks for the decoded payload.
+ */
+typedef struct _query_decompress_pool_s query_decompress_pool_s;
+
+/**
+ * @brief Register GEnumValue array for the compression property.
+ */
+GType
+gst_tensor_query_compression_get_type (void);
+
+/**
+ * @brief Register GEnumValue array for the quantize property.
+ */
+GType
+gst_tensor_query_quantize_get_type (void);
+
+/**
+ * @brief Check whether the compression is available in this build.
+ */
+gboolean
+gst_tensor_query_compression_is_supported (query_compress_e compress);
+
+/**
+ * @brief Get the comma-separated list of the codecs available in this build (e.g., "lz4,zstd,fp16,int8").
+ * @return Newly allocated string. The caller should free it.
+ */
+gchar *
+gst_tensor_query_get_supported_codecs (void);
+
+/**
+ * @brief Check whether the codec name is in the list of the codecs.
+ * @param codecs comma-separated list of the codecs from the peer.
+ * @param name the name of the codec (nick of the compression or quantize).
+ */
+gboolean
+gst_tensor_query_codec_is_accepted (const gchar * codecs, const gchar * name);
+
+/**
+ * @brief Add the memories to the edge data, compressing and quantizing the payload.
+ * @param data_h the edge data handle
+ * @param compress compression of the payload
+ * @param quantize quantization of the float32 tensors, applied before the compression
+ * @param info tensors info of the memories (NULL if unknown, the memories are not quantized)
+ * @param map the mapped memories
+ * @param num the number of the memories
+ * @note Without compression and quantization, the mapped data is added as it is and the caller should keep the memories mapped until the data is sent.
+ * @return TRUE if the memories are successfully added
+ */
+gboolean
+gst_tensor_query_compress_add_data (nns_edge_data_h data_h,
+    query_compress_e compress, query_quantize_e quantize,
+    const GstTensorsInfo * info, GstMapInfo * map, guint num);
+
+/**
+ * @brief Get the decoded sizes of the memories in the edge data.
+ * @param data_h the edge data handle
+ * @param sizes the array to get the decoded size of each memory (NNS_TENSOR_SIZE_LIMIT)
+ * @param num the number of the memories
+ * @return TRUE if the sizes are available
+ */
+gboolean
+gst_tensor_query_decompress_get_sizes (nns_edge_data_h data_h, gsize * sizes,
+    guint * num);
+
+/**
+ * @brief Decode the memory of the edge data into the given destination.
+ * @param data_h the edge data handle
+ * @param index the index of the memory
+ * @param dest the destination, the size should be the decoded size of the memory
+ * @param size the size of the destination
+ * @return TRUE if the memory is successfully decoded
+ */
+gboolean
+gst_tensor_query_decompress_copy (nns_edge_data_h data_h, guint index,
+    guint8 * dest, gsize size);
+
+/**
+ * @brief Create new memory pool for the decoded payload.
+ */
+query_decompress_pool_s *
+gst_tensor_query_decompress_pool_new (void);
+
+/**
+ * @brief Release the memory pool. The memory blocks in use are freed when the memories are released.
+ */
+void
+gst_tensor_query_decompress_pool_free (query_decompress_pool_s * pool);
+
+/**
+ * @brief Decode the memories of the edge data and append them to the buffer.
+ * @param pool the memory pool for the decoded payload
+ * @param data_h the edge data handle
+ * @param buffer the buffer to append the memories
+ * @note The raw payload is wrapped without copying. This function takes the ownership of the edge data handle, and the handle is destroyed when the memories are released.
+ * @return TRUE if the memories are successfully appended
+ */
+gboolean
+gst_tensor_query_decompress_append (query_decompress_pool_s * pool,
+    nns_edge_data_h data_h, GstBuffer * buffer);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* __TENSOR_QUERY_COMPRESS_H__ */
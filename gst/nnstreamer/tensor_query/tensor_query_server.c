@@ -17,6 +17,7 @@
 #include "tensor_query_server.h"
 #include <tensor_typedef.h>
 #include <tensor_common.h>
+#include "tensor_query_common.h"
 
 /**
  * @brief mutex for tensor-query server table.
@@ -47,8 +48,22 @@ _release_server_data (gpointer data)
     _data->edge_h = NULL;
   }
 
+  if (_data->msg_queue) {
+    nns_edge_data_h data_h;
+
+    while ((data_h = g_async_queue_try_pop (_data->msg_queue)))
+      nns_edge_data_destroy (data_h);
+
+    gst_tensor_alloc_account (_data,
+        -((gint64) gst_tensor_alloc_get_held (_data)));
+
+    g_async_queue_unref (_data->msg_queue);
+    _data->msg_queue = NULL;
+  }
+
   g_mutex_clear (&_data->lock);
   g_cond_clear (&_data->cond);
+  g_cond_clear (&_data->queue_cond);
   g_free (_data->id);
   g_free (_data);
 }
@@ -73,12 +88,17 @@ gst_tensor_query_server_get_handle (const char *id)
  */
 edge_server_handle
 gst_tensor_query_server_add_data (const char *id,
-    nns_edge_connect_type_e connect_type)
+    nns_edge_connect_type_e connect_type, const gchar * custom_lib)
 {
   GstTensorQueryServer *data = NULL;
   int ret;
 
-  data = gst_tensor_query_server_get_handle (id);
+  /* The elements with the same id share the server data. */
+  G_LOCK (query_server_table);
+  data = g_hash_table_lookup (_qs_table, id);
+  if (NULL != data)
+    data->ref_count++;
+  G_UNLOCK (query_server_table);
 
   if (NULL != data) {
     return data;
@@ -92,10 +112,16 @@ gst_tensor_query_server_add_data (const char *id,
 
   g_mutex_init (&data->lock);
   g_cond_init (&data->cond);
+  g_cond_init (&data->queue_cond);
   data->id = g_strdup (id);
   data->configured = FALSE;
+  data->batch_size = 1;
+  data->ref_count = 1;
+  data->num_workers = 0;
+  data->max_pending = 0;
+  data->msg_queue = g_async_queue_new ();
 
-  ret = nns_edge_create_handle (id, connect_type,
+  ret = gst_tensor_query_create_edge_handle (id, connect_type, custom_lib,
       NNS_EDGE_NODE_TYPE_QUERY_SERVER, &data->edge_h);
   if (NNS_EDGE_ERROR_NONE != ret) {
     GST_ERROR ("Failed to get nnstreamer edge handle.");
@@ -135,11 +161,144 @@ gst_tensor_query_server_remove_data (edge_server_handle server_h)
   }
 
   G_LOCK (query_server_table);
-  if (g_hash_table_lookup (_qs_table, data->id))
-    g_hash_table_remove (_qs_table, data->id);
+  if (g_hash_table_lookup (_qs_table, data->id) == data) {
+    /* Release the server data when the last element is removed. */
+    if (--data->ref_count <= 0)
+      g_hash_table_remove (_qs_table, data->id);
+  }
   G_UNLOCK (query_server_table);
 }
 
+/**
+ * @brief nnstreamer-edge event callback of the query server, shared by the workers.
+ */
+static int
+_query_server_edge_event_cb (nns_edge_event_h event_h, void *user_data)
+{
+  GstTensorQueryServer *data = (GstTensorQueryServer *) user_data;
+  nns_edge_event_e event_type;
+  nns_edge_data_h data_h;
+  gint64 end_time, recv_time;
+  GstTensorMemPressure pressure;
+  guint max_pending;
+  gboolean full = FALSE;
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_event_get_type (event_h, &event_type)) {
+    nns_loge ("Failed to get event type!");
+    return NNS_EDGE_ERROR_UNKNOWN;
+  }
+
+  if (event_type != NNS_EDGE_EVENT_NEW_DATA_RECEIVED)
+    return NNS_EDGE_ERROR_NONE;
+
+  recv_time = g_get_real_time ();
+
+  /* Over the high watermark of the memory budget, drop the request. */
+  pressure = gst_tensor_alloc_get_pressure ();
+  if (pressure == GST_TENSOR_MEM_PRESSURE_DROP) {
+    nns_logw ("Memory budget exceeded, query server %s drops the request.",
+        data->id);
+    return NNS_EDGE_ERROR_NONE;
+  }
+
+  /**
+   * Backpressure, block the receiving thread until a worker pops the request.
+   * Drop the request if no worker takes the request in time.
+   * Over the low watermark, accept a request only when the queue is empty.
+   */
+  end_time = g_get_monotonic_time () +
+      DEFAULT_QUERY_INFO_TIMEOUT * G_TIME_SPAN_SECOND;
+
+  g_mutex_lock (&data->lock);
+  max_pending = data->max_pending;
+  if (pressure == GST_TENSOR_MEM_PRESSURE_THROTTLE)
+    max_pending = 1;
+
+  while (max_pending > 0 &&
+      g_async_queue_length (data->msg_queue) >= (gint) max_pending) {
+    if (!g_cond_wait_until (&data->queue_cond, &data->lock, end_time)) {
+      full = TRUE;
+      break;
+    }
+  }
+  g_mutex_unlock (&data->lock);
+
+  if (full) {
+    nns_logw ("The request queue of query server %s is full, drop the request.",
+        data->id);
+    return NNS_EDGE_ERROR_NONE;
+  }
+
+  nns_edge_event_parse_new_data (event_h, &data_h);
+  gst_tensor_query_set_time (data_h, QUERY_TIME_SERVER_RECV, recv_time);
+  gst_tensor_alloc_account (data,
+      (gint64) gst_tensor_query_get_data_size (data_h));
+  g_async_queue_push (data->msg_queue, data_h);
+
+  return NNS_EDGE_ERROR_NONE;
+}
+
+/**
+ * @brief Register a serversrc as a worker of the query server.
+ */
+gboolean
+gst_tensor_query_server_add_worker (edge_server_handle server_h,
+    guint max_pending)
+{
+  GstTensorQueryServer *data = (GstTensorQueryServer *) server_h;
+  gboolean first;
+
+  if (NULL == data) {
+    return FALSE;
+  }
+
+  g_mutex_lock (&data->lock);
+  first = (data->num_workers == 0);
+  data->num_workers++;
+  if (max_pending > 0)
+    data->max_pending = max_pending;
+  g_mutex_unlock (&data->lock);
+
+  if (first)
+    nns_edge_set_event_callback (data->edge_h, _query_server_edge_event_cb,
+        data);
+
+  return first;
+}
+
+/**
+ * @brief Pop the request from the queue shared by the workers.
+ */
+nns_edge_data_h
+gst_tensor_query_server_pop_data (edge_server_handle server_h, gint64 timeout)
+{
+  GstTensorQueryServer *data = (GstTensorQueryServer *) server_h;
+  nns_edge_data_h data_h;
+
+  if (NULL == data) {
+    return NULL;
+  }
+
+  if (timeout < 0)
+    data_h = g_async_queue_pop (data->msg_queue);
+  else if (timeout == 0)
+    data_h = g_async_queue_try_pop (data->msg_queue);
+  else
+    data_h = g_async_queue_timeout_pop (data->msg_queue, timeout);
+
+  if (data_h) {
+    gst_tensor_alloc_account (data,
+        -((gint64) gst_tensor_query_get_data_size (data_h)));
+
+    /* wake up the receiving thread waiting for the space of the queue */
+    g_mutex_lock (&data->lock);
+    g_cond_signal (&data->queue_cond);
+    g_mutex_unlock (&data->lock);
+  }
+
+  return data_h;
+}
+
 /**
  * @brief Wait until the sink is configured and get server info handle.
  */
@@ -184,6 +343,44 @@ gst_tensor_query_server_set_configured (edge_server_handle server_h)
   g_mutex_unlock (&data->lock);
 }
 
+/**
+ * @brief Set the number of requests in a batched buffer of the query server.
+ */
+void
+gst_tensor_query_server_set_batch_size (edge_server_handle server_h,
+    guint batch_size)
+{
+  GstTensorQueryServer *data = (GstTensorQueryServer *) server_h;
+
+  if (NULL == data) {
+    return;
+  }
+
+  g_mutex_lock (&data->lock);
+  data->batch_size = MAX (batch_size, 1);
+  g_mutex_unlock (&data->lock);
+}
+
+/**
+ * @brief Get the number of requests in a batched buffer of the query server.
+ */
+guint
+gst_tensor_query_server_get_batch_size (edge_server_handle server_h)
+{
+  GstTensorQueryServer *data = (GstTensorQueryServer *) server_h;
+  guint batch_size;
+
+  if (NULL == data) {
+    return 1;
+  }
+
+  g_mutex_lock (&data->lock);
+  batch_size = data->batch_size;
+  g_mutex_unlock (&data->lock);
+
+  return batch_size;
+}
+
 /**
  * @brief set query server caps.
  */
@@ -202,11 +399,15 @@ gst_tensor_query_server_set_caps (edge_server_handle server_h,
   nns_edge_get_info (data->edge_h, "CAPS", &prev_caps_str);
   if (!prev_caps_str)
     prev_caps_str = g_strdup ("");
-  new_caps_str = g_strdup_printf ("%s%s", prev_caps_str, caps_str);
-  nns_edge_set_info (data->edge_h, "CAPS", new_caps_str);
+
+  /* The workers with the same id may set the same caps. */
+  if (!g_strstr_len (prev_caps_str, -1, caps_str)) {
+    new_caps_str = g_strdup_printf ("%s%s", prev_caps_str, caps_str);
+    nns_edge_set_info (data->edge_h, "CAPS", new_caps_str);
+    g_free (new_caps_str);
+  }
 
   g_free (prev_caps_str);
-  g_free (new_caps_str);
 
   g_mutex_unlock (&data->lock);
 }
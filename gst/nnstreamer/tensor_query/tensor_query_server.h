@@ -31,10 +31,18 @@ typedef struct
 {
   char *id;
   gboolean configured;
+  guint batch_size; /**< number of requests in a batched buffer (1 if not batched) */
   GMutex lock;
   GCond cond;
 
   nns_edge_h edge_h;
+
+  /* Workers (serversrc) sharing the edge handle */
+  gint ref_count; /**< number of elements using this server data */
+  guint num_workers; /**< number of serversrc registered as workers */
+  GAsyncQueue *msg_queue; /**< requests from the clients, shared by the workers */
+  guint max_pending; /**< max number of requests in the queue (0 for unlimited) */
+  GCond queue_cond; /**< condition to wait for the space of the queue */
 } GstTensorQueryServer;
 
 /**
@@ -47,7 +55,7 @@ gst_tensor_query_server_get_handle (const char *id);
  * @brief Add GstTensorQueryServer.
  */
 edge_server_handle
-gst_tensor_query_server_add_data (const char *id, nns_edge_connect_type_e connect_type);
+gst_tensor_query_server_add_data (const char *id, nns_edge_connect_type_e connect_type, const gchar * custom_lib);
 
 /**
  * @brief Remove GstTensorQueryServer.
@@ -55,6 +63,24 @@ gst_tensor_query_server_add_data (const char *id, nns_edge_connect_type_e connec
 void
 gst_tensor_query_server_remove_data (edge_server_handle server_h);
 
+/**
+ * @brief Register a serversrc as a worker of the query server.
+ * @param server_h the query server handle
+ * @param max_pending max number of requests in the queue (0 for unlimited)
+ * @return TRUE if this is the first worker, which should configure and start the edge handle.
+ */
+gboolean
+gst_tensor_query_server_add_worker (edge_server_handle server_h, guint max_pending);
+
+/**
+ * @brief Pop the request from the queue shared by the workers.
+ * @param server_h the query server handle
+ * @param timeout time to wait (in usec), 0 not to wait, and negative value to wait until a request is received.
+ * @return the edge data of the request, or NULL if no request. The caller should destroy it.
+ */
+nns_edge_data_h
+gst_tensor_query_server_pop_data (edge_server_handle server_h, gint64 timeout);
+
 /**
  * @brief Wait until the sink is configured and get server info handle.
  */
@@ -73,6 +99,18 @@ gst_tensor_query_server_get_edge_handle (edge_server_handle server_h);
 void
 gst_tensor_query_server_set_configured (edge_server_handle server_h);
 
+/**
+ * @brief Set the number of requests in a batched buffer of the query server.
+ */
+void
+gst_tensor_query_server_set_batch_size (edge_server_handle server_h, guint batch_size);
+
+/**
+ * @brief Get the number of requests in a batched buffer of the query server.
+ */
+guint
+gst_tensor_query_server_get_batch_size (edge_server_handle server_h);
+
 /**
  * @brief set query server caps.
  */
@@ -34,6 +34,7 @@ enum
 {
   PROP_0,
   PROP_CONNECT_TYPE,
+  PROP_CUSTOM_LIB,
   PROP_ID,
   PROP_TIMEOUT,
   PROP_METALESS_FRAME_LIMIT
@@ -78,6 +79,11 @@ gst_tensor_query_serversink_class_init (GstTensorQueryServerSinkClass * klass)
           "The connection type",
           GST_TYPE_QUERY_CONNECT_TYPE, DEFAULT_CONNECT_TYPE,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CUSTOM_LIB,
+      g_param_spec_string ("custom-lib", "Custom connection library",
+          "The path of the library implementing the connection, "
+          "valid only if the connect-type is CUSTOM.", NULL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
   g_object_class_install_property (gobject_class, PROP_TIMEOUT,
       g_param_spec_uint ("timeout", "Timeout",
           "The timeout as seconds to maintain connection", 0,
@@ -118,6 +124,7 @@ static void
 gst_tensor_query_serversink_init (GstTensorQueryServerSink * sink)
 {
   sink->connect_type = DEFAULT_CONNECT_TYPE;
+  sink->custom_lib = NULL;
   sink->timeout = QUERY_DEFAULT_TIMEOUT_SEC;
   sink->sink_id = DEFAULT_SERVER_ID;
   sink->metaless_frame_count = 0;
@@ -130,6 +137,10 @@ static void
 gst_tensor_query_serversink_finalize (GObject * object)
 {
   GstTensorQueryServerSink *sink = GST_TENSOR_QUERY_SERVERSINK (object);
+
+  g_free (sink->custom_lib);
+  sink->custom_lib = NULL;
+
   gst_tensor_query_server_remove_data (sink->server_h);
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -147,6 +158,10 @@ gst_tensor_query_serversink_set_property (GObject * object, guint prop_id,
     case PROP_CONNECT_TYPE:
       serversink->connect_type = g_value_get_enum (value);
       break;
+    case PROP_CUSTOM_LIB:
+      g_free (serversink->custom_lib);
+      serversink->custom_lib = g_value_dup_string (value);
+      break;
     case PROP_TIMEOUT:
       serversink->timeout = g_value_get_uint (value);
       break;
@@ -175,6 +190,9 @@ gst_tensor_query_serversink_get_property (GObject * object, guint prop_id,
     case PROP_CONNECT_TYPE:
       g_value_set_enum (value, serversink->connect_type);
       break;
+    case PROP_CUSTOM_LIB:
+      g_value_set_string (value, serversink->custom_lib);
+      break;
     case PROP_TIMEOUT:
       g_value_set_uint (value, serversink->timeout);
       break;
@@ -199,10 +217,13 @@ gst_tensor_query_serversink_start (GstBaseSink * bsink)
   GstTensorQueryServerSink *sink = GST_TENSOR_QUERY_SERVERSINK (bsink);
   gchar *id_str = NULL;
 
-  id_str = g_strdup_printf ("%u", sink->sink_id);
-  sink->server_h =
-      gst_tensor_query_server_add_data (id_str, sink->connect_type);
-  g_free (id_str);
+  if (!sink->server_h) {
+    id_str = g_strdup_printf ("%u", sink->sink_id);
+    sink->server_h =
+        gst_tensor_query_server_add_data (id_str, sink->connect_type,
+        sink->custom_lib);
+    g_free (id_str);
+  }
 
   sink->edge_h = gst_tensor_query_server_get_edge_handle (sink->server_h);
   gst_tensor_query_server_set_configured (sink->server_h);
@@ -219,7 +240,9 @@ gst_tensor_query_serversink_set_caps (GstBaseSink * bsink, GstCaps * caps)
   GstTensorQueryServerSink *sink = GST_TENSOR_QUERY_SERVERSINK (bsink);
   gchar *caps_str, *new_caps_str;
 
-  caps_str = gst_caps_to_string (caps);
+  /* The clients receive the result of a single request, advertise the caps without the batch. */
+  caps_str = gst_tensor_query_get_item_caps_str (caps,
+      gst_tensor_query_server_get_batch_size (sink->server_h));
 
   new_caps_str = g_strdup_printf ("@query_server_sink_caps@%s", caps_str);
   gst_tensor_query_server_set_caps (sink->server_h, new_caps_str);
@@ -230,6 +253,79 @@ gst_tensor_query_serversink_set_caps (GstBaseSink * bsink, GstCaps * caps)
   return TRUE;
 }
 
+/**
+ * @brief Set the timestamps of the request to the answer, so that the client gets the latency breakdown.
+ */
+static void
+_gst_tensor_query_serversink_set_times (nns_edge_data_h data_h,
+    int64_t client_send_time, int64_t server_recv_time,
+    int64_t invoke_start_time, int64_t invoke_end_time)
+{
+  /* The client does not stamp the request, skip the server timestamps. */
+  if (client_send_time <= 0)
+    return;
+
+  gst_tensor_query_set_time (data_h, QUERY_TIME_CLIENT_SEND, client_send_time);
+  gst_tensor_query_set_time (data_h, QUERY_TIME_SERVER_RECV, server_recv_time);
+  gst_tensor_query_set_time (data_h, QUERY_TIME_INVOKE_START,
+      invoke_start_time);
+  gst_tensor_query_set_time (data_h, QUERY_TIME_INVOKE_END, invoke_end_time);
+  gst_tensor_query_set_time (data_h, QUERY_TIME_SERVER_SEND,
+      g_get_real_time ());
+}
+
+/**
+ * @brief Send the result of each request in the batched buffer to its client.
+ */
+static void
+_gst_tensor_query_serversink_send_batch (GstTensorQueryServerSink * sink,
+    GstMetaQuery * meta_query, GstMapInfo * map, guint num_mems,
+    int64_t invoke_end_time)
+{
+  nns_edge_data_h data_h;
+  guint i, k;
+  gsize slot_size[NNS_TENSOR_SIZE_LIMIT];
+  char *val;
+
+  for (i = 0; i < num_mems; i++) {
+    if (map[i].size % meta_query->batch_size != 0) {
+      nns_logw ("The size of the %uth memory (%zd) is not a multiple of the batch %u.",
+          i, map[i].size, meta_query->batch_size);
+    }
+    slot_size[i] = map[i].size / meta_query->batch_size;
+  }
+
+  for (k = 0; k < meta_query->num_items && k < meta_query->batch_size; k++) {
+    if (NNS_EDGE_ERROR_NONE != nns_edge_data_create (&data_h)) {
+      nns_loge ("Failed to create data handle in server sink.");
+      return;
+    }
+
+    for (i = 0; i < num_mems; i++)
+      nns_edge_data_add (data_h, map[i].data + k * slot_size[i], slot_size[i],
+          NULL);
+
+    val = g_strdup_printf ("%lld", (long long) meta_query->item_client_id[k]);
+    nns_edge_data_set_info (data_h, "client_id", val);
+    g_free (val);
+
+    if (meta_query->item_request_id[k] >= 0) {
+      val = g_strdup_printf ("%lld",
+          (long long) meta_query->item_request_id[k]);
+      nns_edge_data_set_info (data_h, "request_id", val);
+      g_free (val);
+    }
+
+    _gst_tensor_query_serversink_set_times (data_h,
+        meta_query->item_client_send_time[k],
+        meta_query->item_server_recv_time[k], meta_query->invoke_start_time,
+        invoke_end_time);
+
+    nns_edge_send (sink->edge_h, data_h);
+    nns_edge_data_destroy (data_h);
+  }
+}
+
 /**
  * @brief render buffer, send buffer to client
  */
@@ -244,9 +340,25 @@ gst_tensor_query_serversink_render (GstBaseSink * bsink, GstBuffer * buf)
   GstMemory *mem[NNS_TENSOR_SIZE_LIMIT];
   GstMapInfo map[NNS_TENSOR_SIZE_LIMIT];
   char *val;
+  int64_t invoke_end_time = g_get_real_time ();
 
   meta_query = gst_buffer_get_meta_query (buf);
-  if (meta_query) {
+  if (meta_query && meta_query->batch_size > 0) {
+    sink->metaless_frame_count = 0;
+
+    num_mems = gst_buffer_n_memory (buf);
+    for (i = 0; i < num_mems; i++) {
+      mem[i] = gst_buffer_peek_memory (buf, i);
+      if (!gst_memory_map (mem[i], &map[i], GST_MAP_READ)) {
+        ml_loge ("Cannot map the %uth memory in gst-buffer.", i);
+        num_mems = i;
+        goto done;
+      }
+    }
+
+    _gst_tensor_query_serversink_send_batch (sink, meta_query, map, num_mems,
+        invoke_end_time);
+  } else if (meta_query) {
     sink->metaless_frame_count = 0;
 
     ret = nns_edge_data_create (&data_h);
@@ -271,6 +383,16 @@ gst_tensor_query_serversink_render (GstBaseSink * bsink, GstBuffer * buf)
     nns_edge_data_set_info (data_h, "client_id", val);
     g_free (val);
 
+    if (meta_query->request_id >= 0) {
+      val = g_strdup_printf ("%lld", (long long) meta_query->request_id);
+      nns_edge_data_set_info (data_h, "request_id", val);
+      g_free (val);
+    }
+
+    _gst_tensor_query_serversink_set_times (data_h,
+        meta_query->client_send_time, meta_query->server_recv_time,
+        meta_query->invoke_start_time, invoke_end_time);
+
     nns_edge_send (sink->edge_h, data_h);
     nns_edge_data_destroy (data_h);
   } else {
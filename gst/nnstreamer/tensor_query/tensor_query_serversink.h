@@ -49,6 +49,7 @@ struct _GstTensorQueryServerSink
   gint metaless_frame_count;
 
   nns_edge_connect_type_e connect_type;
+  gchar *custom_lib; /**< path of the custom connection library */
   edge_server_handle server_h;
   nns_edge_h edge_h;
 };
@@ -14,6 +14,7 @@
 #include <config.h>
 #endif
 
+#include <string.h>
 #include <tensor_typedef.h>
 #include <tensor_common.h>
 #include "tensor_query_serversrc.h"
@@ -27,6 +28,9 @@ GST_DEBUG_CATEGORY_STATIC (gst_tensor_query_serversrc_debug);
 #define DEFAULT_IS_LIVE TRUE
 #define DEFAULT_MQTT_HOST "127.0.0.1"
 #define DEFAULT_MQTT_PORT 1883
+#define DEFAULT_MAX_BATCH 1
+#define DEFAULT_BATCH_TIMEOUT 0
+#define DEFAULT_MAX_PENDING 0
 
 /**
  * @brief the capabilities of the outputs
@@ -47,10 +51,14 @@ enum
   PROP_DEST_HOST,
   PROP_DEST_PORT,
   PROP_CONNECT_TYPE,
+  PROP_CUSTOM_LIB,
   PROP_TIMEOUT,
   PROP_TOPIC,
   PROP_ID,
-  PROP_IS_LIVE
+  PROP_IS_LIVE,
+  PROP_MAX_BATCH,
+  PROP_BATCH_TIMEOUT,
+  PROP_MAX_PENDING
 };
 
 #define gst_tensor_query_serversrc_parent_class parent_class
@@ -107,6 +115,11 @@ gst_tensor_query_serversrc_class_init (GstTensorQueryServerSrcClass * klass)
       g_param_spec_enum ("connect-type", "Connect Type", "The connection type.",
           GST_TYPE_QUERY_CONNECT_TYPE, DEFAULT_CONNECT_TYPE,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_CUSTOM_LIB,
+      g_param_spec_string ("custom-lib", "Custom connection library",
+          "The path of the library implementing the connection, "
+          "valid only if the connect-type is CUSTOM.", NULL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
   g_object_class_install_property (gobject_class, PROP_TIMEOUT,
       g_param_spec_uint ("timeout", "Timeout",
           "The timeout as seconds to maintain connection", 0, 3600,
@@ -125,6 +138,25 @@ gst_tensor_query_serversrc_class_init (GstTensorQueryServerSrcClass * klass)
       g_param_spec_boolean ("is-live", "Is Live",
           "Synchronize the incoming buffers' timestamp with the current running time",
           DEFAULT_IS_LIVE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_MAX_BATCH,
+      g_param_spec_uint ("max-batch", "Max batch",
+          "The max number of requests from the clients to be batched into a buffer. "
+          "The outermost dimension of each tensor in the caps of serversrc should be max-batch, "
+          "the unused slots are filled with zero and tensor_query_serversink sends the result of each request to its client.",
+          1, QUERY_MAX_BATCH, DEFAULT_MAX_BATCH,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_BATCH_TIMEOUT,
+      g_param_spec_uint ("batch-timeout", "Batch timeout",
+          "The time (in ms) to wait for more requests after the first request of the batch. "
+          "0 means the requests already received are batched without waiting.",
+          0, G_MAXUINT, DEFAULT_BATCH_TIMEOUT,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  g_object_class_install_property (gobject_class, PROP_MAX_PENDING,
+      g_param_spec_uint ("max-pending", "Max pending",
+          "The max number of requests waiting in the queue shared by the serversrc elements with the same id (workers). "
+          "The server stops receiving new requests while the queue is full. 0 means unlimited.",
+          0, G_MAXUINT, DEFAULT_MAX_PENDING,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_add_pad_template (gstelement_class,
       gst_static_pad_template_get (&srctemplate));
@@ -152,11 +184,18 @@ gst_tensor_query_serversrc_init (GstTensorQueryServerSrc * src)
   src->dest_host = g_strdup (DEFAULT_MQTT_HOST);
   src->dest_port = DEFAULT_MQTT_PORT;
   src->connect_type = DEFAULT_CONNECT_TYPE;
+  src->custom_lib = NULL;
   src->timeout = QUERY_DEFAULT_TIMEOUT_SEC;
   src->topic = NULL;
   src->src_id = DEFAULT_SERVER_ID;
   src->configured = FALSE;
-  src->msg_queue = g_async_queue_new ();
+  src->server_h = NULL;
+  src->max_pending = DEFAULT_MAX_PENDING;
+  src->pool = gst_tensor_query_decompress_pool_new ();
+  src->shm_reader = gst_tensor_query_shm_reader_new ();
+  src->max_batch = DEFAULT_MAX_BATCH;
+  src->batch_timeout = DEFAULT_BATCH_TIMEOUT;
+  src->pending_data = NULL;
 
   gst_base_src_set_format (GST_BASE_SRC (src), GST_FORMAT_TIME);
   /** set the timestamps on each buffer */
@@ -172,8 +211,9 @@ static void
 gst_tensor_query_serversrc_finalize (GObject * object)
 {
   GstTensorQueryServerSrc *src = GST_TENSOR_QUERY_SERVERSRC (object);
-  nns_edge_data_h data_h;
 
+  g_free (src->custom_lib);
+  src->custom_lib = NULL;
   g_free (src->host);
   src->host = NULL;
   g_free (src->dest_host);
@@ -181,10 +221,18 @@ gst_tensor_query_serversrc_finalize (GObject * object)
   g_free (src->topic);
   src->topic = NULL;
 
-  while ((data_h = g_async_queue_try_pop (src->msg_queue))) {
-    nns_edge_data_destroy (data_h);
+  if (src->pending_data) {
+    nns_edge_data_destroy (src->pending_data);
+    src->pending_data = NULL;
   }
-  g_async_queue_unref (src->msg_queue);
+
+  gst_tensor_query_server_remove_data (src->server_h);
+  src->server_h = NULL;
+
+  gst_tensor_query_decompress_pool_free (src->pool);
+  src->pool = NULL;
+  gst_tensor_query_shm_reader_free (src->shm_reader);
+  src->shm_reader = NULL;
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -224,6 +272,10 @@ gst_tensor_query_serversrc_set_property (GObject * object, guint prop_id,
     case PROP_CONNECT_TYPE:
       serversrc->connect_type = g_value_get_enum (value);
       break;
+    case PROP_CUSTOM_LIB:
+      g_free (serversrc->custom_lib);
+      serversrc->custom_lib = g_value_dup_string (value);
+      break;
     case PROP_TIMEOUT:
       serversrc->timeout = g_value_get_uint (value);
       break;
@@ -242,6 +294,15 @@ gst_tensor_query_serversrc_set_property (GObject * object, guint prop_id,
       gst_base_src_set_live (GST_BASE_SRC (serversrc),
           g_value_get_boolean (value));
       break;
+    case PROP_MAX_BATCH:
+      serversrc->max_batch = g_value_get_uint (value);
+      break;
+    case PROP_BATCH_TIMEOUT:
+      serversrc->batch_timeout = g_value_get_uint (value);
+      break;
+    case PROP_MAX_PENDING:
+      serversrc->max_pending = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -273,6 +334,9 @@ gst_tensor_query_serversrc_get_property (GObject * object, guint prop_id,
     case PROP_CONNECT_TYPE:
       g_value_set_enum (value, serversrc->connect_type);
       break;
+    case PROP_CUSTOM_LIB:
+      g_value_set_string (value, serversrc->custom_lib);
+      break;
     case PROP_TIMEOUT:
       g_value_set_uint (value, serversrc->timeout);
       break;
@@ -286,41 +350,19 @@ gst_tensor_query_serversrc_get_property (GObject * object, guint prop_id,
       g_value_set_boolean (value,
           gst_base_src_is_live (GST_BASE_SRC (serversrc)));
       break;
-    default:
-      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+    case PROP_MAX_BATCH:
+      g_value_set_uint (value, serversrc->max_batch);
       break;
-  }
-}
-
-/**
- * @brief nnstreamer-edge event callback.
- */
-static int
-_nns_edge_event_cb (nns_edge_event_h event_h, void *user_data)
-{
-  nns_edge_event_e event_type;
-  int ret = NNS_EDGE_ERROR_NONE;
-
-  GstTensorQueryServerSrc *src = (GstTensorQueryServerSrc *) user_data;
-  if (0 != nns_edge_event_get_type (event_h, &event_type)) {
-    nns_loge ("Failed to get event type!");
-    return NNS_EDGE_ERROR_UNKNOWN;
-  }
-
-  switch (event_type) {
-    case NNS_EDGE_EVENT_NEW_DATA_RECEIVED:
-    {
-      nns_edge_data_h data;
-
-      nns_edge_event_parse_new_data (event_h, &data);
-      g_async_queue_push (src->msg_queue, data);
+    case PROP_BATCH_TIMEOUT:
+      g_value_set_uint (value, serversrc->batch_timeout);
+      break;
+    case PROP_MAX_PENDING:
+      g_value_set_uint (value, serversrc->max_pending);
       break;
-    }
     default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
-
-  return ret;
 }
 
 /**
@@ -332,11 +374,27 @@ gst_tensor_query_serversrc_start (GstBaseSrc * bsrc)
   GstTensorQueryServerSrc *src = GST_TENSOR_QUERY_SERVERSRC (bsrc);
   char *id_str = NULL, *port = NULL;
 
-  id_str = g_strdup_printf ("%d", src->src_id);
-  src->server_h = gst_tensor_query_server_add_data (id_str, src->connect_type);
-  g_free (id_str);
+  if (!src->server_h) {
+    id_str = g_strdup_printf ("%d", src->src_id);
+    src->server_h =
+        gst_tensor_query_server_add_data (id_str, src->connect_type,
+        src->custom_lib);
+    g_free (id_str);
+  }
 
   src->edge_h = gst_tensor_query_server_get_edge_handle (src->server_h);
+  gst_tensor_query_server_set_batch_size (src->server_h, src->max_batch);
+
+  /**
+   * The serversrc elements with the same id share the edge handle and pop
+   * the requests from the same queue. The first one starts the edge handle.
+   */
+  if (!gst_tensor_query_server_add_worker (src->server_h, src->max_pending)) {
+    nns_logi ("Query server %u: add a worker sharing the server handle.",
+        src->src_id);
+    goto wait_sink;
+  }
+
   if (src->host)
     nns_edge_set_info (src->edge_h, "HOST", src->host);
   if (src->port > 0) {
@@ -354,14 +412,13 @@ gst_tensor_query_serversrc_start (GstBaseSrc * bsrc)
   if (src->topic)
     nns_edge_set_info (src->edge_h, "TOPIC", src->topic);
 
-  nns_edge_set_event_callback (src->edge_h, _nns_edge_event_cb, src);
-
   if (NNS_EDGE_ERROR_NONE != nns_edge_start (src->edge_h)) {
     nns_loge
         ("Failed to start NNStreamer-edge. Please check server IP and port.");
     return FALSE;
   }
 
+wait_sink:
   if (!gst_tensor_query_server_wait_sink (src->server_h)) {
     nns_loge ("Failed to get server information from query server.");
     return FALSE;
@@ -370,6 +427,34 @@ gst_tensor_query_serversrc_start (GstBaseSrc * bsrc)
   return TRUE;
 }
 
+/**
+ * @brief Get the client ID and the sequence number of the request.
+ * @return FALSE if the request does not have the client ID.
+ */
+static gboolean
+_gst_tensor_query_serversrc_parse_request (nns_edge_data_h data_h,
+    query_client_id_t * client_id, int64_t * request_id)
+{
+  char *val;
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get_info (data_h, "client_id",
+          &val))
+    return FALSE;
+
+  *client_id = g_ascii_strtoll (val, NULL, 10);
+  g_free (val);
+
+  /* optional, the client sends the sequence number to match the answer */
+  *request_id = -1;
+  if (NNS_EDGE_ERROR_NONE == nns_edge_data_get_info (data_h, "request_id",
+          &val)) {
+    *request_id = g_ascii_strtoll (val, NULL, 10);
+    g_free (val);
+  }
+
+  return TRUE;
+}
+
 /**
  * @brief Get buffer from message queue.
  */
@@ -378,53 +463,212 @@ _gst_tensor_query_serversrc_get_buffer (GstTensorQueryServerSrc * src)
 {
   nns_edge_data_h data_h;
   GstBuffer *buffer = NULL;
-  guint i, num_data;
   GstMetaQuery *meta_query;
-  int ret;
+  gboolean received;
+  query_client_id_t client_id;
+  int64_t request_id, client_send_time, server_recv_time;
 
-  data_h = g_async_queue_pop (src->msg_queue);
+  data_h = gst_tensor_query_server_pop_data (src->server_h, -1);
 
   if (!data_h) {
     nns_loge ("Failed to get message from the server message queue");
     return NULL;
   }
 
-  ret = nns_edge_data_get_count (data_h, &num_data);
-  if (ret != NNS_EDGE_ERROR_NONE || num_data == 0) {
-    nns_loge ("Failed to get the number of memories of the edge data.");
+  if (!_gst_tensor_query_serversrc_parse_request (data_h, &client_id,
+          &request_id)) {
+    nns_edge_data_destroy (data_h);
+    return NULL;
+  }
+
+  client_send_time = gst_tensor_query_get_time (data_h, QUERY_TIME_CLIENT_SEND);
+  server_recv_time = gst_tensor_query_get_time (data_h, QUERY_TIME_SERVER_RECV);
+
+  /* map the shared memory, or decompress the payload if the client compressed it */
+  buffer = gst_buffer_new ();
+  if (gst_tensor_query_shm_is_shared (data_h)) {
+    received = gst_tensor_query_shm_append (src->shm_reader, data_h, buffer);
+    nns_edge_data_destroy (data_h);
+  } else {
+    /* The buffer keeps the edge data, the raw payload is not copied. */
+    received = gst_tensor_query_decompress_append (src->pool, data_h, buffer);
+  }
+
+  if (!received) {
+    gst_buffer_unref (buffer);
+    return NULL;
+  }
+
+  meta_query = gst_buffer_add_meta_query (buffer);
+  if (meta_query) {
+    meta_query->client_id = client_id;
+    meta_query->request_id = request_id;
+    meta_query->client_send_time = client_send_time;
+    meta_query->server_recv_time = server_recv_time;
+    meta_query->invoke_start_time = g_get_real_time ();
+  }
+
+  return buffer;
+}
+
+/**
+ * @brief Get the sizes of the memories in the request (after decompression).
+ */
+static gboolean
+_gst_tensor_query_serversrc_get_sizes (nns_edge_data_h data_h, gsize * sizes,
+    guint * num)
+{
+  if (gst_tensor_query_shm_is_shared (data_h))
+    return gst_tensor_query_shm_get_sizes (data_h, sizes, num);
+
+  return gst_tensor_query_decompress_get_sizes (data_h, sizes, num);
+}
+
+/**
+ * @brief Check the request has the same number and sizes of memories as the first request of the batch.
+ */
+static gboolean
+_gst_tensor_query_serversrc_is_batchable (nns_edge_data_h data_h,
+    guint num_data, const gsize * sizes)
+{
+  gsize data_sizes[NNS_TENSOR_SIZE_LIMIT];
+  guint i, num = 0;
+
+  /* compare the decompressed sizes */
+  if (!_gst_tensor_query_serversrc_get_sizes (data_h, data_sizes, &num) ||
+      num != num_data)
+    return FALSE;
+
+  for (i = 0; i < num; i++) {
+    if (data_sizes[i] != sizes[i])
+      return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Get the batched buffer of the requests from multiple clients.
+ */
+static GstBuffer *
+_gst_tensor_query_serversrc_get_batch (GstTensorQueryServerSrc * src)
+{
+  nns_edge_data_h items[QUERY_MAX_BATCH];
+  query_client_id_t client_id[QUERY_MAX_BATCH];
+  int64_t request_id[QUERY_MAX_BATCH];
+  gsize sizes[NNS_TENSOR_SIZE_LIMIT];
+  GstBuffer *buffer = NULL;
+  GstMetaQuery *meta_query;
+  guint i, k, num_items = 0, num_data = 0;
+  gint64 end_time;
+
+  /* The first request of the batch, blocked until a request is received. */
+  if (src->pending_data) {
+    items[0] = src->pending_data;
+    src->pending_data = NULL;
+  } else {
+    items[0] = gst_tensor_query_server_pop_data (src->server_h, -1);
+  }
+
+  if (!items[0]) {
+    nns_loge ("Failed to get message from the server message queue");
+    return NULL;
+  }
+  num_items = 1;
+
+  if (!_gst_tensor_query_serversrc_parse_request (items[0], &client_id[0],
+          &request_id[0])) {
+    nns_loge ("Cannot get the client ID of the request.");
+    goto done;
+  }
+
+  if (!_gst_tensor_query_serversrc_get_sizes (items[0], sizes, &num_data)) {
+    nns_loge ("Failed to get the sizes of memories of the edge data.");
     goto done;
   }
 
+  /* Collect the pending requests with the same size. */
+  end_time = g_get_monotonic_time () +
+      src->batch_timeout * G_TIME_SPAN_MILLISECOND;
+
+  while (num_items < src->max_batch) {
+    nns_edge_data_h data_h;
+    gint64 remain = end_time - g_get_monotonic_time ();
+
+    data_h = gst_tensor_query_server_pop_data (src->server_h, MAX (remain, 0));
+
+    if (!data_h)
+      break;
+
+    if (!_gst_tensor_query_serversrc_is_batchable (data_h, num_data, sizes)) {
+      /* This request starts the next batch. */
+      src->pending_data = data_h;
+      break;
+    }
+
+    if (!_gst_tensor_query_serversrc_parse_request (data_h,
+            &client_id[num_items], &request_id[num_items])) {
+      nns_logw ("Cannot get the client ID of the request, drop it.");
+      nns_edge_data_destroy (data_h);
+      continue;
+    }
+
+    items[num_items++] = data_h;
+  }
+
   buffer = gst_buffer_new ();
+  meta_query = gst_buffer_add_meta_query (buffer);
+  if (!meta_query) {
+    gst_buffer_unref (buffer);
+    buffer = NULL;
+    goto done;
+  }
+
   for (i = 0; i < num_data; i++) {
-    void *data = NULL;
-    nns_size_t data_len = 0;
-    gpointer new_data;
+    guint8 *new_data = g_malloc0 (sizes[i] * src->max_batch);
 
-    nns_edge_data_get (data_h, i, &data, &data_len);
-    new_data = _g_memdup (data, data_len);
+    /* decompress each request into its slot */
+    for (k = 0; k < num_items; k++) {
+      guint8 *dest = new_data + k * sizes[i];
+      gboolean copied;
+
+      if (gst_tensor_query_shm_is_shared (items[k]))
+        copied = gst_tensor_query_shm_copy (src->shm_reader, items[k], i, dest,
+            sizes[i]);
+      else
+        copied = gst_tensor_query_decompress_copy (items[k], i, dest, sizes[i]);
+
+      if (!copied)
+        nns_logw ("Failed to decode the request %u, the slot is zero.", k);
+    }
 
     gst_buffer_append_memory (buffer,
-        gst_memory_new_wrapped (0, new_data, data_len, 0, data_len, new_data,
-            g_free));
+        gst_memory_new_wrapped (0, new_data, sizes[i] * src->max_batch, 0,
+            sizes[i] * src->max_batch, new_data, g_free));
   }
 
-  meta_query = gst_buffer_add_meta_query (buffer);
-  if (meta_query) {
-    char *val;
-
-    ret = nns_edge_data_get_info (data_h, "client_id", &val);
-    if (NNS_EDGE_ERROR_NONE != ret) {
-      gst_buffer_unref (buffer);
-      buffer = NULL;
-    } else {
-      meta_query->client_id = g_ascii_strtoll (val, NULL, 10);
-      g_free (val);
-    }
+  meta_query->batch_size = src->max_batch;
+  meta_query->num_items = num_items;
+
+  for (k = 0; k < num_items; k++) {
+    meta_query->item_client_id[k] = client_id[k];
+    meta_query->item_request_id[k] = request_id[k];
+    meta_query->item_client_send_time[k] =
+        gst_tensor_query_get_time (items[k], QUERY_TIME_CLIENT_SEND);
+    meta_query->item_server_recv_time[k] =
+        gst_tensor_query_get_time (items[k], QUERY_TIME_SERVER_RECV);
   }
 
+  meta_query->client_id = meta_query->item_client_id[0];
+  meta_query->request_id = meta_query->item_request_id[0];
+  meta_query->client_send_time = meta_query->item_client_send_time[0];
+  meta_query->server_recv_time = meta_query->item_server_recv_time[0];
+  meta_query->invoke_start_time = g_get_real_time ();
+
 done:
-  nns_edge_data_destroy (data_h);
+  for (k = 0; k < num_items; k++)
+    nns_edge_data_destroy (items[k]);
+
   return buffer;
 }
 
@@ -438,25 +682,33 @@ gst_tensor_query_serversrc_create (GstPushSrc * psrc, GstBuffer ** outbuf)
   GstBaseSrc *bsrc = GST_BASE_SRC (psrc);
 
   if (!src->configured) {
-    gchar *caps_str, *new_caps_str;
+    gchar *caps_str, *new_caps_str, *codecs;
 
     GstCaps *caps = gst_pad_peer_query_caps (GST_BASE_SRC_PAD (bsrc), NULL);
     if (gst_caps_is_fixed (caps)) {
       gst_base_src_set_caps (bsrc, caps);
     }
 
-    caps_str = gst_caps_to_string (caps);
+    /* The clients send a single request, advertise the caps without the batch. */
+    caps_str = gst_tensor_query_get_item_caps_str (caps, src->max_batch);
 
-    new_caps_str = g_strdup_printf ("@query_server_src_caps@%s", caps_str);
+    /* The codecs to decompress the payload from the clients */
+    codecs = gst_tensor_query_get_supported_codecs ();
+    new_caps_str = g_strdup_printf ("@query_server_src_caps@%s@"
+        QUERY_SERVER_CODECS_KEY "@%s", caps_str, codecs);
     gst_tensor_query_server_set_caps (src->server_h, new_caps_str);
     g_free (new_caps_str);
     g_free (caps_str);
+    g_free (codecs);
 
     gst_caps_unref (caps);
     src->configured = TRUE;
   }
 
-  *outbuf = _gst_tensor_query_serversrc_get_buffer (src);
+  if (src->max_batch > 1)
+    *outbuf = _gst_tensor_query_serversrc_get_batch (src);
+  else
+    *outbuf = _gst_tensor_query_serversrc_get_buffer (src);
   if (*outbuf == NULL) {
     nns_loge ("Failed to get buffer to push to the tensor query serversrc.");
     return GST_FLOW_ERROR;
@@ -17,6 +17,8 @@
 #include <gst/base/gstpushsrc.h>
 #include <tensor_meta.h>
 #include "tensor_query_server.h"
+#include "tensor_query_compress.h"
+#include "tensor_query_shm.h"
 
 G_BEGIN_DECLS
 
@@ -54,9 +56,17 @@ struct _GstTensorQueryServerSrc
   gchar *topic; /**< Main operation such as 'object_detection' or 'image_segmentation' */
 
   nns_edge_connect_type_e connect_type;
+  gchar *custom_lib; /**< path of the custom connection library */
   edge_server_handle server_h;
   nns_edge_h edge_h;
-  GAsyncQueue *msg_queue;
+  guint max_pending; /**< max number of requests in the queue shared by the workers */
+  query_decompress_pool_s *pool; /**< memory pool for the decompressed requests */
+  query_shm_reader_s *shm_reader; /**< mapping of the shared memory from the clients */
+
+  /* Batching requests from multiple clients */
+  guint max_batch; /**< max number of requests in a buffer (1 to disable batching) */
+  guint batch_timeout; /**< time (in ms) to wait for more requests after the first one */
+  nns_edge_data_h pending_data; /**< request which cannot be batched with the previous ones */
 };
 
 /**
@@ -0,0 +1,624 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file   tensor_query_shm.c
+ * @date   14 Oct 2026
+ * @brief  Shared-memory transport of the edge data between the processes on the same host
+ * @see    https://github.com/nnstreamer/nnstreamer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ *
+ * The sender creates a POSIX shared-memory segment with a ring of slots. It copies
+ * the memories into a free slot and sends only the descriptor of the slot (name
+ * of the segment, slot and sizes) with the edge data. The receiver maps the segment
+ * and wraps the slot into the memories without copying the payload.
+ *
+ * The state of each slot in the header is the generation of the data, or 0 if free.
+ * The sender sets the generation after writing the payload, and the receiver resets
+ * it with compare-and-exchange when the memories are released, so no lock is shared
+ * between the processes. If the descriptor is lost (e.g., no receiver is connected),
+ * the sender reclaims the slot after QUERY_SHM_RECLAIM_TIMEOUT.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+#include <string.h>
+#include "tensor_query_shm.h"
+#include "nnstreamer_log.h"
+#include "nnstreamer_util.h"
+
+#ifdef HAVE_SHM_OPEN
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define QUERY_SHM_MAGIC 0x4e4e5348      /* NNSH */
+#define QUERY_SHM_NUM_SLOTS 8
+#define QUERY_SHM_NAME_PREFIX "/nnstreamer-shm-"
+#define QUERY_SHM_NAME_LEN 64
+#define QUERY_SHM_DATA_OFFSET 4096      /* the header is in the first page */
+#define QUERY_SHM_PAGE_SIZE 4096
+#define QUERY_SHM_MEM_ALIGN 64
+#define QUERY_SHM_RECLAIM_TIMEOUT (10 * G_TIME_SPAN_SECOND)
+
+#define QUERY_SHM_ROUND_UP(v,a) ((((v) + (a) - 1) / (a)) * (a))
+
+/**
+ * @brief Header of the shared-memory segment.
+ */
+typedef struct
+{
+  guint32 magic;
+  guint32 num_slots;
+  guint64 slot_size;
+  gint state[QUERY_SHM_NUM_SLOTS]; /**< generation of the data in the slot, 0 if free */
+} query_shm_header_s;
+
+/**
+ * @brief Descriptor of the slot, sent with the edge data.
+ */
+typedef struct
+{
+  guint32 magic;
+  guint32 slot;
+  gint32 gen;
+  guint32 num;
+  guint64 sizes[NNS_TENSOR_SIZE_LIMIT];
+  gchar name[QUERY_SHM_NAME_LEN];
+} query_shm_desc_s;
+
+/**
+ * @brief Data structure of the sender.
+ */
+struct _query_shm_s
+{
+  gchar *name; /**< name of the segment */
+  guint8 *addr; /**< mapped address of the segment */
+  gsize size; /**< size of the segment */
+  gint gen; /**< generation of the last data */
+  guint next_slot; /**< slot to start searching the free slot */
+  gint64 sent_time[QUERY_SHM_NUM_SLOTS]; /**< monotonic time when the slot is sent */
+  gboolean disabled; /**< TRUE if the segment cannot be created */
+};
+
+/**
+ * @brief Mapping of the segment in the receiver.
+ */
+typedef struct
+{
+  gint ref_count;
+  gchar *name;
+  guint8 *addr;
+  gsize size;
+} query_shm_mapping_s;
+
+/**
+ * @brief Data structure of the receiver.
+ */
+struct _query_shm_reader_s
+{
+  GMutex lock;
+  query_shm_mapping_s *mapping; /**< the last mapped segment */
+};
+
+/**
+ * @brief Reference of the slot, shared by the memories in the slot.
+ */
+typedef struct
+{
+  query_shm_mapping_s *mapping;
+  guint slot;
+  gint gen;
+  gint count; /**< number of the memories in use */
+} query_shm_slot_ref_s;
+
+/**
+ * @brief Check whether the shared-memory transport is available in this build.
+ */
+gboolean
+gst_tensor_query_shm_is_supported (void)
+{
+#ifdef HAVE_SHM_OPEN
+  return TRUE;
+#else
+  return FALSE;
+#endif
+}
+
+/**
+ * @brief Create the sender of the shared-memory transport.
+ */
+query_shm_s *
+gst_tensor_query_shm_new (void)
+{
+  query_shm_s *shm = g_new0 (query_shm_s, 1);
+
+  shm->disabled = !gst_tensor_query_shm_is_supported ();
+  return shm;
+}
+
+/**
+ * @brief Release the sender and unlink the segment.
+ */
+void
+gst_tensor_query_shm_free (query_shm_s * shm)
+{
+  if (!shm)
+    return;
+
+#ifdef HAVE_SHM_OPEN
+  if (shm->addr) {
+    munmap (shm->addr, shm->size);
+    shm_unlink (shm->name);
+  }
+#endif
+
+  g_free (shm->name);
+  g_free (shm);
+}
+
+/**
+ * @brief Create the segment with the slot size.
+ */
+static gboolean
+_shm_create (query_shm_s * shm, gsize slot_size)
+{
+#ifdef HAVE_SHM_OPEN
+  static gint seq = 0;
+  query_shm_header_s *header;
+  gint fd;
+
+  shm->name = g_strdup_printf (QUERY_SHM_NAME_PREFIX "%d-%d", (gint) getpid (),
+      g_atomic_int_add (&seq, 1));
+  shm->size = QUERY_SHM_DATA_OFFSET + slot_size * QUERY_SHM_NUM_SLOTS;
+
+  fd = shm_open (shm->name, O_CREAT | O_EXCL | O_RDWR, 0600);
+  if (fd < 0) {
+    nns_loge ("Failed to create the shared memory %s.", shm->name);
+    goto error;
+  }
+
+  if (ftruncate (fd, (off_t) shm->size) < 0) {
+    nns_loge ("Failed to set the size of the shared memory %s.", shm->name);
+    close (fd);
+    shm_unlink (shm->name);
+    goto error;
+  }
+
+  shm->addr = mmap (NULL, shm->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close (fd);
+
+  if (shm->addr == MAP_FAILED) {
+    nns_loge ("Failed to map the shared memory %s.", shm->name);
+    shm->addr = NULL;
+    shm_unlink (shm->name);
+    goto error;
+  }
+
+  /* The new segment is filled with zero, all slots are free. */
+  header = (query_shm_header_s *) shm->addr;
+  header->num_slots = QUERY_SHM_NUM_SLOTS;
+  header->slot_size = slot_size;
+  g_atomic_int_set ((gint *) & header->magic, QUERY_SHM_MAGIC);
+
+  return TRUE;
+
+error:
+  g_free (shm->name);
+  shm->name = NULL;
+#else
+  UNUSED (shm);
+  UNUSED (slot_size);
+#endif
+  return FALSE;
+}
+
+/**
+ * @brief Copy the memories into a free slot of the segment and add the descriptor of the slot to the edge data.
+ */
+gboolean
+gst_tensor_query_shm_add_data (query_shm_s * shm, nns_edge_data_h data_h,
+    GstMapInfo * map, guint num)
+{
+  query_shm_header_s *header;
+  query_shm_desc_s *desc;
+  gsize total = 0, offset = 0;
+  gint64 now;
+  guint i, n, slot = QUERY_SHM_NUM_SLOTS;
+  guint8 *dest;
+
+  if (!shm || shm->disabled || num == 0 || num > NNS_TENSOR_SIZE_LIMIT)
+    return FALSE;
+
+  for (i = 0; i < num; i++)
+    total += QUERY_SHM_ROUND_UP (map[i].size, QUERY_SHM_MEM_ALIGN);
+
+  if (!shm->addr) {
+    /* The slot size is decided with the first data. */
+    if (!_shm_create (shm, QUERY_SHM_ROUND_UP (total, QUERY_SHM_PAGE_SIZE))) {
+      nns_logw ("Cannot use the shared memory, send the data via the network.");
+      shm->disabled = TRUE;
+      return FALSE;
+    }
+  }
+
+  header = (query_shm_header_s *) shm->addr;
+  if (total > header->slot_size)
+    return FALSE;
+
+  now = g_get_monotonic_time ();
+  for (n = 0; n < QUERY_SHM_NUM_SLOTS; n++) {
+    guint s = (shm->next_slot + n) % QUERY_SHM_NUM_SLOTS;
+    gint state = g_atomic_int_get (&header->state[s]);
+
+    /* Only the sender sets the generation, the free slot is owned by the sender. */
+    if (state == 0 || (now - shm->sent_time[s] > QUERY_SHM_RECLAIM_TIMEOUT &&
+            g_atomic_int_compare_and_exchange (&header->state[s], state, 0))) {
+      slot = s;
+      break;
+    }
+  }
+
+  if (slot == QUERY_SHM_NUM_SLOTS)
+    return FALSE;
+
+  desc = g_new0 (query_shm_desc_s, 1);
+  desc->magic = QUERY_SHM_MAGIC;
+  desc->slot = slot;
+  desc->num = num;
+  g_strlcpy (desc->name, shm->name, QUERY_SHM_NAME_LEN);
+
+  dest = shm->addr + QUERY_SHM_DATA_OFFSET + header->slot_size * slot;
+  for (i = 0; i < num; i++) {
+    memcpy (dest + offset, map[i].data, map[i].size);
+    desc->sizes[i] = map[i].size;
+    offset += QUERY_SHM_ROUND_UP (map[i].size, QUERY_SHM_MEM_ALIGN);
+  }
+
+  if (++shm->gen <= 0)
+    shm->gen = 1;
+  desc->gen = shm->gen;
+
+  /* publish the slot after writing the payload */
+  g_atomic_int_set (&header->state[slot], desc->gen);
+  shm->sent_time[slot] = now;
+  shm->next_slot = (slot + 1) % QUERY_SHM_NUM_SLOTS;
+
+  nns_edge_data_add (data_h, desc, sizeof (query_shm_desc_s), g_free);
+  nns_edge_data_set_info (data_h, "shm", "1");
+
+  return TRUE;
+}
+
+/**
+ * @brief Create the receiver of the shared-memory transport.
+ */
+query_shm_reader_s *
+gst_tensor_query_shm_reader_new (void)
+{
+  query_shm_reader_s *reader = g_new0 (query_shm_reader_s, 1);
+
+  g_mutex_init (&reader->lock);
+  return reader;
+}
+
+/**
+ * @brief Unref the mapping of the segment.
+ */
+static void
+_shm_mapping_unref (query_shm_mapping_s * mapping)
+{
+  if (!g_atomic_int_dec_and_test (&mapping->ref_count))
+    return;
+
+#ifdef HAVE_SHM_OPEN
+  munmap (mapping->addr, mapping->size);
+#endif
+  g_free (mapping->name);
+  g_free (mapping);
+}
+
+/**
+ * @brief Release the receiver.
+ */
+void
+gst_tensor_query_shm_reader_free (query_shm_reader_s * reader)
+{
+  if (!reader)
+    return;
+
+  if (reader->mapping)
+    _shm_mapping_unref (reader->mapping);
+
+  g_mutex_clear (&reader->lock);
+  g_free (reader);
+}
+
+/**
+ * @brief Map the segment with the name.
+ */
+static query_shm_mapping_s *
+_shm_mapping_open (const gchar * name)
+{
+#ifdef HAVE_SHM_OPEN
+  query_shm_mapping_s *mapping;
+  query_shm_header_s *header;
+  struct stat st;
+  guint8 *addr;
+  gint fd;
+
+  /* Map the segment of nnstreamer only. */
+  if (!g_str_has_prefix (name, QUERY_SHM_NAME_PREFIX) || strchr (name + 1, '/'))
+    return NULL;
+
+  fd = shm_open (name, O_RDWR, 0);
+  if (fd < 0) {
+    nns_loge ("Failed to open the shared memory %s.", name);
+    return NULL;
+  }
+
+  if (fstat (fd, &st) < 0 || st.st_size < QUERY_SHM_DATA_OFFSET) {
+    close (fd);
+    return NULL;
+  }
+
+  addr = mmap (NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close (fd);
+
+  if (addr == MAP_FAILED) {
+    nns_loge ("Failed to map the shared memory %s.", name);
+    return NULL;
+  }
+
+  header = (query_shm_header_s *) addr;
+  if (header->magic != QUERY_SHM_MAGIC ||
+      header->num_slots != QUERY_SHM_NUM_SLOTS ||
+      QUERY_SHM_DATA_OFFSET + header->slot_size * header->num_slots >
+      (guint64) st.st_size) {
+    nns_loge ("Invalid shared memory %s.", name);
+    munmap (addr, st.st_size);
+    return NULL;
+  }
+
+  mapping = g_new0 (query_shm_mapping_s, 1);
+  mapping->ref_count = 1;
+  mapping->name = g_strdup (name);
+  mapping->addr = addr;
+  mapping->size = st.st_size;
+
+  return mapping;
+#else
+  UNUSED (name);
+  return NULL;
+#endif
+}
+
+/**
+ * @brief Get the mapping of the segment, the caller should unref it.
+ */
+static query_shm_mapping_s *
+_shm_reader_get_mapping (query_shm_reader_s * reader, const gchar * name)
+{
+  query_shm_mapping_s *mapping;
+
+  g_mutex_lock (&reader->lock);
+  mapping = reader->mapping;
+
+  if (!mapping || !g_str_equal (mapping->name, name)) {
+    /* The sender is restarted, or the data is from another sender. */
+    mapping = _shm_mapping_open (name);
+    if (mapping) {
+      if (reader->mapping)
+        _shm_mapping_unref (reader->mapping);
+      reader->mapping = mapping;
+    }
+  }
+
+  if (mapping)
+    g_atomic_int_inc (&mapping->ref_count);
+  g_mutex_unlock (&reader->lock);
+
+  return mapping;
+}
+
+/**
+ * @brief Check whether the edge data has the descriptor of the shared memory.
+ */
+gboolean
+gst_tensor_query_shm_is_shared (nns_edge_data_h data_h)
+{
+  gchar *val = NULL;
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get_info (data_h, "shm", &val))
+    return FALSE;
+
+  g_free (val);
+  return TRUE;
+}
+
+/**
+ * @brief Get the descriptor from the edge data.
+ */
+static gboolean
+_shm_get_desc (nns_edge_data_h data_h, query_shm_desc_s * desc)
+{
+  void *data = NULL;
+  nns_size_t data_len = 0;
+
+  if (NNS_EDGE_ERROR_NONE != nns_edge_data_get (data_h, 0, &data, &data_len) ||
+      data_len != sizeof (query_shm_desc_s))
+    return FALSE;
+
+  memcpy (desc, data, sizeof (query_shm_desc_s));
+  desc->name[QUERY_SHM_NAME_LEN - 1] = '\0';
+
+  return (desc->magic == QUERY_SHM_MAGIC && desc->slot < QUERY_SHM_NUM_SLOTS &&
+      desc->num > 0 && desc->num <= NNS_TENSOR_SIZE_LIMIT);
+}
+
+/**
+ * @brief Get the mapping and the address of the slot described in the edge data.
+ * @return the mapping of the segment, or NULL if the slot is not valid. The caller should unref it.
+ */
+static query_shm_mapping_s *
+_shm_get_slot (query_shm_reader_s * reader, nns_edge_data_h data_h,
+    query_shm_desc_s * desc, guint8 ** slot_addr)
+{
+  query_shm_mapping_s *mapping;
+  query_shm_header_s *header;
+  gsize total = 0;
+  guint i;
+
+  if (!_shm_get_desc (data_h, desc)) {
+    nns_loge ("Invalid descriptor of the shared memory.");
+    return NULL;
+  }
+
+  mapping = _shm_reader_get_mapping (reader, desc->name);
+  if (!mapping)
+    return NULL;
+
+  header = (query_shm_header_s *) mapping->addr;
+  for (i = 0; i < desc->num; i++)
+    total += QUERY_SHM_ROUND_UP (desc->sizes[i], QUERY_SHM_MEM_ALIGN);
+
+  if (total > header->slot_size) {
+    nns_loge ("Invalid descriptor of the shared memory, the size is too large.");
+    _shm_mapping_unref (mapping);
+    return NULL;
+  }
+
+  /* The slot is reclaimed by the sender if the generation is different. */
+  if (g_atomic_int_get (&header->state[desc->slot]) != desc->gen) {
+    nns_logw ("The slot %u of the shared memory is already reclaimed.",
+        desc->slot);
+    _shm_mapping_unref (mapping);
+    return NULL;
+  }
+
+  *slot_addr =
+      mapping->addr + QUERY_SHM_DATA_OFFSET + header->slot_size * desc->slot;
+  return mapping;
+}
+
+/**
+ * @brief Release the slot to the sender.
+ */
+static void
+_shm_release_slot (query_shm_mapping_s * mapping, guint slot, gint gen)
+{
+  query_shm_header_s *header = (query_shm_header_s *) mapping->addr;
+
+  /* Do nothing if the sender has already reclaimed the slot. */
+  g_atomic_int_compare_and_exchange (&header->state[slot], gen, 0);
+}
+
+/**
+ * @brief Get the sizes of the memories in the slot.
+ */
+gboolean
+gst_tensor_query_shm_get_sizes (nns_edge_data_h data_h, gsize * sizes,
+    guint * num)
+{
+  query_shm_desc_s desc;
+  guint i;
+
+  if (!_shm_get_desc (data_h, &desc))
+    return FALSE;
+
+  for (i = 0; i < desc.num; i++)
+    sizes[i] = desc.sizes[i];
+
+  *num = desc.num;
+  return TRUE;
+}
+
+/**
+ * @brief Copy the memory in the slot into the destination.
+ */
+gboolean
+gst_tensor_query_shm_copy (query_shm_reader_s * reader, nns_edge_data_h data_h,
+    guint index, guint8 * dest, gsize size)
+{
+  query_shm_mapping_s *mapping;
+  query_shm_desc_s desc;
+  guint8 *addr = NULL;
+  gsize offset = 0;
+  guint i;
+
+  mapping = _shm_get_slot (reader, data_h, &desc, &addr);
+  if (!mapping)
+    return FALSE;
+
+  if (index >= desc.num || desc.sizes[index] != size) {
+    _shm_mapping_unref (mapping);
+    return FALSE;
+  }
+
+  for (i = 0; i < index; i++)
+    offset += QUERY_SHM_ROUND_UP (desc.sizes[i], QUERY_SHM_MEM_ALIGN);
+
+  memcpy (dest, addr + offset, size);
+
+  if (index == desc.num - 1)
+    _shm_release_slot (mapping, desc.slot, desc.gen);
+
+  _shm_mapping_unref (mapping);
+  return TRUE;
+}
+
+/**
+ * @brief Release the memory in the slot, and the slot if all memories are released.
+ */
+static void
+_shm_slot_ref_release (gpointer data)
+{
+  query_shm_slot_ref_s *ref = (query_shm_slot_ref_s *) data;
+
+  if (!g_atomic_int_dec_and_test (&ref->count))
+    return;
+
+  _shm_release_slot (ref->mapping, ref->slot, ref->gen);
+  _shm_mapping_unref (ref->mapping);
+  g_free (ref);
+}
+
+/**
+ * @brief Append the memories in the slot to the buffer without copying the payload.
+ */
+gboolean
+gst_tensor_query_shm_append (query_shm_reader_s * reader,
+    nns_edge_data_h data_h, GstBuffer * buffer)
+{
+  query_shm_mapping_s *mapping;
+  query_shm_slot_ref_s *ref;
+  query_shm_desc_s desc;
+  guint8 *addr = NULL;
+  gsize offset = 0;
+  guint i;
+
+  mapping = _shm_get_slot (reader, data_h, &desc, &addr);
+  if (!mapping)
+    return FALSE;
+
+  ref = g_new0 (query_shm_slot_ref_s, 1);
+  ref->mapping = mapping;
+  ref->slot = desc.slot;
+  ref->gen = desc.gen;
+  ref->count = desc.num;
+
+  for (i = 0; i < desc.num; i++) {
+    gsize size = desc.sizes[i];
+
+    gst_buffer_append_memory (buffer,
+        gst_memory_new_wrapped (0, addr + offset, size, 0, size, ref,
+            _shm_slot_ref_release));
+    offset += QUERY_SHM_ROUND_UP (size, QUERY_SHM_MEM_ALIGN);
+  }
+
+  return TRUE;
+}
@@ -0,0 +1,119 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file   tensor_query_shm.h
+ * @date   14 Oct 2026
+ * @brief  Shared-memory transport of the edge data between the processes on the same host
+ * @see    https://github.com/nnstreamer/nnstreamer
+ * @author agent <agent@local>
+ * @bug    No known bugs except for NYI items
+ */
+
+#ifndef __TENSOR_QUERY_SHM_H__
+#define __TENSOR_QUERY_SHM_H__
+
+#include <glib.h>
+#include <gst/gst.h>
+#include "tensor_typedef.h"
+#include "nnstreamer-edge.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * @brief Shared-memory segment of the sender.
+ */
+typedef struct _query_shm_s query_shm_s;
+
+/**
+ * @brief Shared-memory segments mapped by the receiver.
+ */
+typedef struct _query_shm_reader_s query_shm_reader_s;
+
+/**
+ * @brief Check whether the shared-memory transport is available in this build.
+ */
+gboolean
+gst_tensor_query_shm_is_supported (void);
+
+/**
+ * @brief Create the sender of the shared-memory transport. The segment is created with the first data.
+ */
+query_shm_s *
+gst_tensor_query_shm_new (void);
+
+/**
+ * @brief Release the sender and unlink the segment. The receivers keep the mapping until their memories are released.
+ */
+void
+gst_tensor_query_shm_free (query_shm_s * shm);
+
+/**
+ * @brief Copy the memories into a free slot of the segment and add the descriptor of the slot to the edge data.
+ * @param shm the sender of the shared-memory transport
+ * @param data_h the edge data handle
+ * @param map the mapped memories
+ * @param num the number of the memories
+ * @return FALSE if no slot is available or the memories are too large. The caller should add the memories to the edge data.
+ */
+gboolean
+gst_tensor_query_shm_add_data (query_shm_s * shm, nns_edge_data_h data_h,
+    GstMapInfo * map, guint num);
+
+/**
+ * @brief Create the receiver of the shared-memory transport.
+ */
+query_shm_reader_s *
+gst_tensor_query_shm_reader_new (void);
+
+/**
+ * @brief Release the receiver. The mapping is released when the memories are released.
+ */
+void
+gst_tensor_query_shm_reader_free (query_shm_reader_s * reader);
+
+/**
+ * @brief Check whether the edge data has the descriptor of the shared memory.
+ */
+gboolean
+gst_tensor_query_shm_is_shared (nns_edge_data_h data_h);
+
+/**
+ * @brief Get the sizes of the memories in the slot.
+ * @param data_h the edge data handle, which has the descriptor of the shared memory
+ * @param sizes the array to get the size of each memory (NNS_TENSOR_SIZE_LIMIT)
+ * @param num the number of the memories
+ */
+gboolean
+gst_tensor_query_shm_get_sizes (nns_edge_data_h data_h, gsize * sizes,
+    guint * num);
+
+/**
+ * @brief Copy the memory in the slot into the destination, and release the slot after copying the last memory.
+ * @param reader the receiver of the shared-memory transport
+ * @param data_h the edge data handle, which has the descriptor of the shared memory
+ * @param index the index of the memory
+ * @param dest the destination
+ * @param size the size of the destination
+ */
+gboolean
+gst_tensor_query_shm_copy (query_shm_reader_s * reader, nns_edge_data_h data_h,
+    guint index, guint8 * dest, gsize size);
+
+/**
+ * @brief Append the memories in the slot to the buffer without copying the payload.
+ * @param reader the receiver of the shared-memory transport
+ * @param data_h the edge data handle, which has the descriptor of the shared memory
+ * @param buffer the buffer to append the memories
+ * @note The slot is released when all memories are released. The sender reclaims the slot after a few seconds, so the downstream element should not hold the buffer longer.
+ */
+gboolean
+gst_tensor_query_shm_append (query_shm_reader_s * reader,
+    nns_edge_data_h data_h, GstBuffer * buffer);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* __TENSOR_QUERY_SHM_H__ */
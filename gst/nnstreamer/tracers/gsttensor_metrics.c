@@ -0,0 +1,899 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file    gsttensor_metrics.c
+ * @date    14 Oct 2026
+ * @brief   GStreamer tracer to export the metrics of nnstreamer elements (Prometheus text format)
+ * @see     http://github.com/nnstreamer/nnstreamer
+ * @author  agent <agent@local>
+ * @bug     No known bugs
+ */
+
+/**
+ * SECTION:tracer-tensormetrics
+ *
+ * A tracer that tracks the nnstreamer elements created in the process and
+ * serves their metrics in Prometheus (OpenMetrics compatible) text format
+ * with an in-process HTTP endpoint, e.g., http://127.0.0.1:9464/metrics.
+ *
+ * The exported metrics are:
+ * - nnstreamer_filter_invoke_latency_seconds: histogram of the invoke latency of tensor_filter.
+ * - nnstreamer_element_dropped_total: the number of the buffers (or messages) dropped by the element,
+ *   e.g., tensor_sink, tensor_rate and mqttsrc.
+ * - nnstreamer_query_latency_seconds: the percentiles of the latency breakdown of tensor_query_client.
+ * - nnstreamer_element_bytes_total: bytes of the buffers received (in) and pushed (out) by the element,
+ *   e.g., the bytes sent by edgesink and received by edgesrc.
+ * - nnstreamer_allocator_*: the statistics of the pooled tensor allocator.
+ * - nnstreamer_element_{memcpy_bytes,alloc_bytes,allocations,compute_seconds}_total: the bytes copied,
+ *   the allocations and the compute time of the core elements, if built with -Denable-element-profile=true.
+ *
+ * The exporter runs without GST_TRACERS if it is enabled in nnstreamer.ini:
+ * |[
+ * [metrics]
+ * enable_exporter=True
+ * address=0.0.0.0
+ * port=9464
+ * ]|
+ *
+ * <refsect2>
+ * <title>Example launch line</title>
+ * |[
+ * GST_TRACERS="tensormetrics(port=9464)" gst-launch-1.0 videotestsrc ! tensor_converter ! tensor_sink
+ * ]|
+ * </refsect2>
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <string.h>
+#include <nnstreamer_conf.h>
+#include <nnstreamer_log.h>
+#include <nnstreamer_plugin_api.h>
+#include <nnstreamer_util.h>
+#include <tensor_filter/tensor_filter.h>
+#include "gsttensor_metrics.h"
+
+/**
+ * @brief Default address of the HTTP endpoint.
+ */
+#define DEFAULT_ADDRESS "127.0.0.1"
+
+/**
+ * @brief Default port of the HTTP endpoint.
+ */
+#define DEFAULT_PORT (9464)
+
+/**
+ * @brief The max size of the HTTP request header.
+ */
+#define METRICS_MAX_REQUEST (4096)
+
+/**
+ * @brief The number of the threads handling the HTTP requests.
+ */
+#define METRICS_MAX_THREADS (2)
+
+/**
+ * @brief Prune the released elements from the list after this number of the new elements.
+ */
+#define METRICS_PRUNE_INTERVAL (64)
+
+/**
+ * @brief The exporter configured in nnstreamer.ini.
+ */
+static GstTensorMetrics *conf_exporter = NULL;
+
+#ifndef GST_DISABLE_GST_TRACER_HOOKS
+
+GST_DEBUG_CATEGORY_STATIC (gst_tensor_metrics_debug);
+#define GST_CAT_DEFAULT gst_tensor_metrics_debug
+
+#define gst_tensor_metrics_parent_class parent_class
+G_DEFINE_TYPE (GstTensorMetrics, gst_tensor_metrics, GST_TYPE_TRACER);
+
+/**
+ * @brief The plugins of the tracked elements.
+ */
+static const gchar *metrics_plugins[] = {
+  "nnstreamer", "edge", "mqtt", "datarepo", "join", NULL
+};
+
+/**
+ * @brief The properties (guint64) of the number of dropped buffers.
+ */
+static const gchar *metrics_drop_props[] = {
+  "dropped", "drop", "num-dropped", NULL
+};
+
+/**
+ * @brief The buckets (usec) of the invoke latency histogram.
+ */
+static const gint64 metrics_latency_buckets[] = {
+  100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000,
+  100000, 250000, 500000, 1000000, 2500000, 5000000
+};
+
+/**
+ * @brief Data of the tracked element.
+ */
+typedef struct
+{
+  GWeakRef ref; /**< the element */
+  gchar *factory; /**< name of the element factory */
+  gsize bytes_in; /**< bytes of the received buffers (atomic) */
+  gsize bytes_out; /**< bytes of the pushed buffers (atomic) */
+} GstTensorMetricsElement;
+
+/**
+ * @brief Free the data of the tracked element.
+ */
+static void
+gst_tensor_metrics_element_free (gpointer data)
+{
+  GstTensorMetricsElement *e = (GstTensorMetricsElement *) data;
+
+  g_weak_ref_clear (&e->ref);
+  g_free (e->factory);
+  g_free (e);
+}
+
+/**
+ * @brief Escape the label value (backslash, double-quote and line feed).
+ */
+static gchar *
+gst_tensor_metrics_escape (const gchar * str)
+{
+  GString *escaped = g_string_new (NULL);
+
+  for (; str && *str; str++) {
+    if (*str == '\\' || *str == '"')
+      g_string_append_c (escaped, '\\');
+
+    if (*str == '\n')
+      g_string_append (escaped, "\\n");
+    else
+      g_string_append_c (escaped, *str);
+  }
+
+  return g_string_free (escaped, FALSE);
+}
+
+/**
+ * @brief Remove the released elements from the list. The caller should hold the lock.
+ */
+static void
+gst_tensor_metrics_prune (GstTensorMetrics * self)
+{
+  GHashTableIter iter;
+  gpointer value;
+
+  g_hash_table_iter_init (&iter, self->elements);
+  while (g_hash_table_iter_next (&iter, NULL, &value)) {
+    GstTensorMetricsElement *e = (GstTensorMetricsElement *) value;
+    GObject *element = g_weak_ref_get (&e->ref);
+
+    if (element)
+      g_object_unref (element);
+    else
+      g_hash_table_iter_remove (&iter);
+  }
+
+  self->num_added = 0;
+}
+
+/**
+ * @brief Get the data of the tracked element (NULL if not tracked).
+ */
+static inline GstTensorMetricsElement *
+gst_tensor_metrics_get_element (GstTensorMetrics * self, GstObject * object)
+{
+  if (object == NULL || !GST_IS_ELEMENT (object) || GST_IS_BIN (object))
+    return NULL;
+
+  return (GstTensorMetricsElement *) g_object_get_qdata (G_OBJECT (object),
+      self->quark);
+}
+
+/**
+ * @brief Add the bytes of the buffers pushed from the pad.
+ */
+static void
+gst_tensor_metrics_add_bytes (GstTensorMetrics * self, GstPad * pad,
+    gsize size)
+{
+  GstTensorMetricsElement *e;
+  GstPad *peer;
+
+  e = gst_tensor_metrics_get_element (self, GST_OBJECT_PARENT (pad));
+  if (e)
+    g_atomic_pointer_add (&e->bytes_out, size);
+
+  peer = gst_pad_get_peer (pad);
+  if (peer) {
+    e = gst_tensor_metrics_get_element (self, GST_OBJECT_PARENT (peer));
+    if (e)
+      g_atomic_pointer_add (&e->bytes_in, size);
+
+    gst_object_unref (peer);
+  }
+}
+
+/**
+ * @brief Hook when an element is created.
+ */
+static void
+gst_tensor_metrics_element_new (GObject * object, GstClockTime ts,
+    GstElement * element)
+{
+  GstTensorMetrics *self = GST_TENSOR_METRICS (object);
+  GstElementFactory *factory;
+  GstTensorMetricsElement *e;
+  const gchar *plugin;
+
+  UNUSED (ts);
+
+  factory = gst_element_get_factory (element);
+  if (factory == NULL || GST_IS_BIN (element))
+    return;
+
+  plugin = gst_plugin_feature_get_plugin_name (GST_PLUGIN_FEATURE (factory));
+  if (plugin == NULL || !g_strv_contains (metrics_plugins, plugin))
+    return;
+
+  e = g_new0 (GstTensorMetricsElement, 1);
+  g_weak_ref_init (&e->ref, element);
+  e->factory = g_strdup (GST_OBJECT_NAME (factory));
+
+  g_mutex_lock (&self->lock);
+  if (++self->num_added > METRICS_PRUNE_INTERVAL)
+    gst_tensor_metrics_prune (self);
+
+  g_hash_table_insert (self->elements, e, e);
+  g_object_set_qdata (G_OBJECT (element), self->quark, e);
+  g_mutex_unlock (&self->lock);
+}
+
+/**
+ * @brief Hook before pushing a buffer.
+ */
+static void
+gst_tensor_metrics_pad_push_pre (GObject * object, GstClockTime ts,
+    GstPad * pad, GstBuffer * buffer)
+{
+  UNUSED (ts);
+  gst_tensor_metrics_add_bytes (GST_TENSOR_METRICS (object), pad,
+      gst_buffer_get_size (buffer));
+}
+
+/**
+ * @brief Hook before pushing a buffer list.
+ */
+static void
+gst_tensor_metrics_pad_push_list_pre (GObject * object, GstClockTime ts,
+    GstPad * pad, GstBufferList * list)
+{
+  UNUSED (ts);
+  gst_tensor_metrics_add_bytes (GST_TENSOR_METRICS (object), pad,
+      gst_buffer_list_calculate_size (list));
+}
+
+/**
+ * @brief Append the help and type of the metric.
+ */
+static void
+gst_tensor_metrics_append_header (GString * out, const gchar * name,
+    const gchar * type, const gchar * help)
+{
+  g_string_append_printf (out, "# HELP %s %s\n# TYPE %s %s\n",
+      name, help, name, type);
+}
+
+/**
+ * @brief Append the invoke latency histogram of tensor_filter.
+ */
+static void
+gst_tensor_metrics_append_filter (GString * out, GstElement * element,
+    const gchar * name)
+{
+  GstTensorFilterPrivate *priv = &GST_TENSOR_FILTER_CAST (element)->priv;
+  GstTensorFilterStatSnapshot snapshot;
+  gchar *labels, *fw;
+  guint i;
+
+  gst_tensor_filter_statistics_get_snapshot (&priv->stat, &snapshot);
+
+  fw = gst_tensor_metrics_escape (priv->prop.fwname);
+  labels = g_strdup_printf ("element=\"%s\",framework=\"%s\"", name, fw);
+  g_free (fw);
+
+  for (i = 0; i < G_N_ELEMENTS (metrics_latency_buckets); i++) {
+    g_string_append_printf (out,
+        "nnstreamer_filter_invoke_latency_seconds_bucket{%s,le=\"%g\"} %"
+        G_GUINT64_FORMAT "\n", labels, metrics_latency_buckets[i] / 1e6,
+        gst_tensor_filter_histogram_get_count (&priv->stat.histogram,
+            metrics_latency_buckets[i]));
+  }
+
+  g_string_append_printf (out,
+      "nnstreamer_filter_invoke_latency_seconds_bucket{%s,le=\"+Inf\"} %"
+      G_GUINT64_FORMAT "\n", labels, snapshot.invoke_num);
+  g_string_append_printf (out,
+      "nnstreamer_filter_invoke_latency_seconds_sum{%s} %.6f\n", labels,
+      snapshot.invoke_latency / 1e6);
+  g_string_append_printf (out,
+      "nnstreamer_filter_invoke_latency_seconds_count{%s} %" G_GUINT64_FORMAT
+      "\n", labels, snapshot.invoke_num);
+
+  g_free (labels);
+}
+
+/**
+ * @brief Append the number of the dropped buffers.
+ */
+static void
+gst_tensor_metrics_append_dropped (GString * out, GstElement * element,
+    const gchar * name, GstTensorMetricsElement * e)
+{
+  GObjectClass *klass = G_OBJECT_GET_CLASS (element);
+  GParamSpec *pspec;
+  guint64 dropped;
+  guint i;
+
+  for (i = 0; metrics_drop_props[i]; i++) {
+    pspec = g_object_class_find_property (klass, metrics_drop_props[i]);
+    if (pspec == NULL || pspec->value_type != G_TYPE_UINT64 ||
+        !(pspec->flags & G_PARAM_READABLE))
+      continue;
+
+    g_object_get (element, metrics_drop_props[i], &dropped, NULL);
+    g_string_append_printf (out,
+        "nnstreamer_element_dropped_total{element=\"%s\",factory=\"%s\"} %"
+        G_GUINT64_FORMAT "\n", name, e->factory, dropped);
+    break;
+  }
+}
+
+/**
+ * @brief Append the percentiles of the latency breakdown (e.g., "total-p99" in latency-stats of tensor_query_client).
+ */
+static void
+gst_tensor_metrics_append_query (GString * out, GstElement * element,
+    const gchar * name)
+{
+  GParamSpec *pspec;
+  GstStructure *stats = NULL;
+  gint i, num;
+
+  pspec = g_object_class_find_property (G_OBJECT_GET_CLASS (element),
+      "latency-stats");
+  if (pspec == NULL || pspec->value_type != GST_TYPE_STRUCTURE)
+    return;
+
+  g_object_get (element, "latency-stats", &stats, NULL);
+  if (stats == NULL)
+    return;
+
+  num = gst_structure_n_fields (stats);
+  for (i = 0; i < num; i++) {
+    const gchar *field = gst_structure_nth_field_name (stats, i);
+    const gchar *p = strrchr (field, '-');
+    gchar *component;
+    gint64 val;
+
+    if (p == NULL || p[1] != 'p' || !g_ascii_isdigit (p[2]) ||
+        !gst_structure_get_int64 (stats, field, &val))
+      continue;
+
+    component = g_strndup (field, p - field);
+    g_string_append_printf (out,
+        "nnstreamer_query_latency_seconds{element=\"%s\",component=\"%s\",quantile=\"0.%s\"} %.6f\n",
+        name, component, p + 2, val / 1e6);
+    g_free (component);
+  }
+
+  gst_structure_free (stats);
+}
+
+/**
+ * @brief Append the counters of the copy, allocation and compute time of the elements (-Denable-element-profile=true).
+ */
+static void
+gst_tensor_metrics_append_profile (GString * out, GPtrArray * elements,
+    GPtrArray * names, GPtrArray * data)
+{
+  GstTensorElementProfile *profiles;
+  gboolean *valid;
+  guint i;
+
+  profiles = g_new0 (GstTensorElementProfile, elements->len);
+  valid = g_new0 (gboolean, elements->len);
+
+  for (i = 0; i < elements->len; i++)
+    valid[i] = gst_tensor_element_get_profile (g_ptr_array_index (elements, i),
+        &profiles[i]);
+
+#define append_profile_counter(metric,help,fmt,value) do { \
+    gst_tensor_metrics_append_header (out, metric, "counter", help); \
+    for (i = 0; i < elements->len; i++) { \
+      GstTensorMetricsElement *e = g_ptr_array_index (data, i); \
+      if (!valid[i]) \
+        continue; \
+      g_string_append_printf (out, metric "{element=\"%s\",factory=\"%s\"} " \
+          fmt "\n", (const gchar *) g_ptr_array_index (names, i), e->factory, \
+          value); \
+    } \
+  } while (0)
+
+  append_profile_counter ("nnstreamer_element_memcpy_bytes_total",
+      "Bytes copied by the element.", "%" G_GUINT64_FORMAT,
+      profiles[i].memcpy_bytes);
+  append_profile_counter ("nnstreamer_element_alloc_bytes_total",
+      "Bytes of the memory allocated by the element.", "%" G_GUINT64_FORMAT,
+      profiles[i].alloc_bytes);
+  append_profile_counter ("nnstreamer_element_allocations_total",
+      "The number of the allocations of the element.", "%" G_GUINT64_FORMAT,
+      profiles[i].alloc_count);
+  append_profile_counter ("nnstreamer_element_compute_seconds_total",
+      "Time spent in the main compute loop of the element.", "%.9f",
+      (gdouble) profiles[i].compute_ns / GST_SECOND);
+
+#undef append_profile_counter
+
+  g_free (valid);
+  g_free (profiles);
+}
+
+/**
+ * @brief Append the statistics of the tensor allocator.
+ */
+static void
+gst_tensor_metrics_append_allocator (GString * out)
+{
+  GstTensorAllocatorStats stats;
+
+  gst_tensor_alloc_get_stats (&stats);
+
+  gst_tensor_metrics_append_header (out, "nnstreamer_allocator_hits_total",
+      "counter", "The number of allocations served from the pool.");
+  g_string_append_printf (out, "nnstreamer_allocator_hits_total %"
+      G_GUINT64_FORMAT "\n", stats.hits);
+  gst_tensor_metrics_append_header (out, "nnstreamer_allocator_misses_total",
+      "counter", "The number of allocations of new memory blocks.");
+  g_string_append_printf (out, "nnstreamer_allocator_misses_total %"
+      G_GUINT64_FORMAT "\n", stats.misses);
+  gst_tensor_metrics_append_header (out, "nnstreamer_allocator_resident_bytes",
+      "gauge", "Bytes of the memory blocks held by the allocator.");
+  g_string_append_printf (out, "nnstreamer_allocator_resident_bytes %"
+      G_GUINT64_FORMAT "\n", stats.resident_bytes);
+  gst_tensor_metrics_append_header (out, "nnstreamer_allocator_cached_bytes",
+      "gauge", "Bytes of the free memory blocks kept for reuse.");
+  g_string_append_printf (out, "nnstreamer_allocator_cached_bytes %"
+      G_GUINT64_FORMAT "\n", stats.cached_bytes);
+  gst_tensor_metrics_append_header (out, "nnstreamer_allocator_in_use_bytes",
+      "gauge", "Bytes of the memory blocks allocated and not freed yet.");
+  g_string_append_printf (out, "nnstreamer_allocator_in_use_bytes %"
+      G_GUINT64_FORMAT "\n", stats.in_use_bytes);
+  gst_tensor_metrics_append_header (out, "nnstreamer_allocator_held_bytes",
+      "gauge", "Bytes held in the receive queues of the elements.");
+  g_string_append_printf (out, "nnstreamer_allocator_held_bytes %"
+      G_GUINT64_FORMAT "\n", stats.held_bytes);
+  gst_tensor_metrics_append_header (out, "nnstreamer_allocator_pressure",
+      "gauge", "The memory pressure (0: none, 1: throttle, 2: drop).");
+  g_string_append_printf (out, "nnstreamer_allocator_pressure %d\n",
+      (gint) gst_tensor_alloc_get_pressure ());
+}
+
+/**
+ * @brief Get the metrics of the tracked elements in Prometheus text exposition format.
+ */
+gchar *
+gst_tensor_metrics_collect (GstTensorMetrics * self)
+{
+  GPtrArray *elements, *data, *names;
+  GHashTableIter iter;
+  gpointer value;
+  GString *out;
+  guint i;
+
+  g_return_val_if_fail (GST_IS_TENSOR_METRICS (self), NULL);
+
+  elements = g_ptr_array_new_with_free_func (gst_object_unref);
+  data = g_ptr_array_new ();
+  names = g_ptr_array_new_with_free_func (g_free);
+
+  /* hold the references, the elements may be released while collecting */
+  g_mutex_lock (&self->lock);
+  gst_tensor_metrics_prune (self);
+  g_hash_table_iter_init (&iter, self->elements);
+  while (g_hash_table_iter_next (&iter, NULL, &value)) {
+    GstTensorMetricsElement *e = (GstTensorMetricsElement *) value;
+    GObject *element = g_weak_ref_get (&e->ref);
+
+    if (element) {
+      g_ptr_array_add (elements, element);
+      g_ptr_array_add (data, e);
+    }
+  }
+  g_mutex_unlock (&self->lock);
+
+  /* the name may be changed after the element is created */
+  for (i = 0; i < elements->len; i++) {
+    gchar *name = gst_object_get_name (g_ptr_array_index (elements, i));
+
+    g_ptr_array_add (names, gst_tensor_metrics_escape (name));
+    g_free (name);
+  }
+
+  out = g_string_new (NULL);
+
+  gst_tensor_metrics_append_header (out,
+      "nnstreamer_filter_invoke_latency_seconds", "histogram",
+      "Invoke latency of tensor_filter.");
+  for (i = 0; i < elements->len; i++) {
+    GstElement *element = g_ptr_array_index (elements, i);
+
+    if (GST_IS_TENSOR_FILTER (element))
+      gst_tensor_metrics_append_filter (out, element,
+          g_ptr_array_index (names, i));
+  }
+
+  gst_tensor_metrics_append_header (out, "nnstreamer_element_dropped_total",
+      "counter", "The number of buffers dropped by the element.");
+  for (i = 0; i < elements->len; i++)
+    gst_tensor_metrics_append_dropped (out, g_ptr_array_index (elements, i),
+        g_ptr_array_index (names, i), g_ptr_array_index (data, i));
+
+  gst_tensor_metrics_append_header (out, "nnstreamer_query_latency_seconds",
+      "gauge", "Percentiles of the latency breakdown of the recent queries.");
+  for (i = 0; i < elements->len; i++)
+    gst_tensor_metrics_append_query (out, g_ptr_array_index (elements, i),
+        g_ptr_array_index (names, i));
+
+  gst_tensor_metrics_append_header (out, "nnstreamer_element_bytes_total",
+      "counter", "Bytes of the buffers received (in) and pushed (out) by the element.");
+  for (i = 0; i < elements->len; i++) {
+    GstTensorMetricsElement *e = g_ptr_array_index (data, i);
+    const gchar *name = g_ptr_array_index (names, i);
+
+    g_string_append_printf (out,
+        "nnstreamer_element_bytes_total{element=\"%s\",factory=\"%s\",direction=\"in\"} %"
+        G_GSIZE_FORMAT "\n", name, e->factory,
+        (gsize) g_atomic_pointer_get (&e->bytes_in));
+    g_string_append_printf (out,
+        "nnstreamer_element_bytes_total{element=\"%s\",factory=\"%s\",direction=\"out\"} %"
+        G_GSIZE_FORMAT "\n", name, e->factory,
+        (gsize) g_atomic_pointer_get (&e->bytes_out));
+  }
+
+  if (gst_tensor_element_profile_is_enabled ())
+    gst_tensor_metrics_append_profile (out, elements, names, data);
+
+  gst_tensor_metrics_append_allocator (out);
+
+  g_ptr_array_free (names, TRUE);
+  g_ptr_array_free (data, TRUE);
+  g_ptr_array_free (elements, TRUE);
+  return g_string_free (out, FALSE);
+}
+
+/**
+ * @brief Handle the HTTP request to the endpoint.
+ */
+static gboolean
+gst_tensor_metrics_handle_request (GThreadedSocketService * service,
+    GSocketConnection * connection, GObject * source, gpointer user_data)
+{
+  GstTensorMetrics *self = GST_TENSOR_METRICS (user_data);
+  GInputStream *in;
+  GOutputStream *output;
+  gchar request[METRICS_MAX_REQUEST + 1];
+  gsize len = 0;
+  gssize n;
+  gchar *body = NULL, *header;
+  const gchar *status = "404 Not Found";
+
+  UNUSED (service);
+  UNUSED (source);
+
+  g_socket_set_timeout (g_socket_connection_get_socket (connection), 5);
+  in = g_io_stream_get_input_stream (G_IO_STREAM (connection));
+  output = g_io_stream_get_output_stream (G_IO_STREAM (connection));
+
+  /* read the request header */
+  while (len < METRICS_MAX_REQUEST) {
+    n = g_input_stream_read (in, request + len, METRICS_MAX_REQUEST - len,
+        NULL, NULL);
+    if (n <= 0)
+      break;
+
+    len += (gsize) n;
+    request[len] = '\0';
+    if (strstr (request, "\r\n\r\n") || strstr (request, "\n\n"))
+      break;
+  }
+  request[len] = '\0';
+
+  if (g_str_has_prefix (request, "GET /metrics ") ||
+      g_str_has_prefix (request, "GET / ") ||
+      g_str_has_prefix (request, "GET /metrics?")) {
+    status = "200 OK";
+    body = gst_tensor_metrics_collect (self);
+  } else if (len == 0) {
+    return TRUE;
+  }
+
+  if (body == NULL)
+    body = g_strdup ("Not Found\n");
+
+  header = g_strdup_printf ("HTTP/1.0 %s\r\n"
+      "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+      "Content-Length: %" G_GSIZE_FORMAT "\r\n"
+      "Connection: close\r\n\r\n", status, strlen (body));
+
+  if (g_output_stream_write_all (output, header, strlen (header), NULL, NULL,
+          NULL)) {
+    g_output_stream_write_all (output, body, strlen (body), NULL, NULL, NULL);
+  }
+
+  g_free (header);
+  g_free (body);
+  return TRUE;
+}
+
+/**
+ * @brief Start the HTTP endpoint.
+ */
+static void
+gst_tensor_metrics_start_service (GstTensorMetrics * self)
+{
+  GSocketAddress *address, *effective = NULL;
+  GError *error = NULL;
+
+  address = g_inet_socket_address_new_from_string (self->address, self->port);
+  if (address == NULL) {
+    nns_logw ("tensormetrics: invalid address '%s'.", self->address);
+    return;
+  }
+
+  self->service = g_threaded_socket_service_new (METRICS_MAX_THREADS);
+  if (!g_socket_listener_add_address (G_SOCKET_LISTENER (self->service),
+          address, G_SOCKET_TYPE_STREAM, G_SOCKET_PROTOCOL_TCP, NULL,
+          &effective, &error)) {
+    nns_logw ("tensormetrics: cannot listen %s:%u (%s).", self->address,
+        self->port, error ? error->message : "unknown error");
+    g_clear_error (&error);
+    g_clear_object (&self->service);
+    g_object_unref (address);
+    return;
+  }
+
+  if (effective) {
+    self->port = g_inet_socket_address_get_port (G_INET_SOCKET_ADDRESS
+        (effective));
+    g_object_unref (effective);
+  }
+
+  g_signal_connect (self->service, "run",
+      G_CALLBACK (gst_tensor_metrics_handle_request), self);
+  g_socket_service_start (self->service);
+  g_object_unref (address);
+
+  GST_INFO_OBJECT (self, "Serving the metrics on http://%s:%u/metrics",
+      self->address, self->port);
+}
+
+/**
+ * @brief Parse the parameters of the tracer (e.g., "address=0.0.0.0,port=9464").
+ */
+static void
+gst_tensor_metrics_parse_params (GstTensorMetrics * self, const gchar * params)
+{
+  GstStructure *structure;
+  const gchar *address;
+  gchar *str;
+  gint port;
+
+  if (params == NULL || params[0] == '\0')
+    return;
+
+  str = g_strdup_printf ("tensormetrics,%s", params);
+  structure = gst_structure_from_string (str, NULL);
+  g_free (str);
+
+  if (structure == NULL) {
+    nns_logw ("tensormetrics: invalid params '%s', use the default.", params);
+    return;
+  }
+
+  if (gst_structure_has_field (structure, "address")) {
+    address = gst_structure_get_string (structure, "address");
+
+    /* empty address to collect the metrics without the endpoint */
+    g_free (self->address);
+    self->address = (address && address[0] != '\0') ? g_strdup (address) : NULL;
+  }
+
+  if (gst_structure_get_int (structure, "port", &port) && port >= 0 &&
+      port <= G_MAXUINT16)
+    self->port = (guint) port;
+
+  gst_structure_free (structure);
+}
+
+/**
+ * @brief Start the HTTP endpoint with the parameters.
+ */
+static void
+gst_tensor_metrics_constructed (GObject * object)
+{
+  GstTensorMetrics *self = GST_TENSOR_METRICS (object);
+  gchar *params = NULL;
+
+  g_object_get (object, "params", &params, NULL);
+  gst_tensor_metrics_parse_params (self, params);
+  g_free (params);
+
+  if (self->address)
+    gst_tensor_metrics_start_service (self);
+
+  if (G_OBJECT_CLASS (parent_class)->constructed)
+    G_OBJECT_CLASS (parent_class)->constructed (object);
+}
+
+/**
+ * @brief Stop the HTTP endpoint and release the list of the elements.
+ */
+static void
+gst_tensor_metrics_finalize (GObject * object)
+{
+  GstTensorMetrics *self = GST_TENSOR_METRICS (object);
+  GHashTableIter iter;
+  gpointer value;
+
+  if (self->service) {
+    g_socket_service_stop (self->service);
+    g_socket_listener_close (G_SOCKET_LISTENER (self->service));
+    g_clear_object (&self->service);
+  }
+
+  /* detach the data from the live elements */
+  g_hash_table_iter_init (&iter, self->elements);
+  while (g_hash_table_iter_next (&iter, NULL, &value)) {
+    GstTensorMetricsElement *e = (GstTensorMetricsElement *) value;
+    GObject *element = g_weak_ref_get (&e->ref);
+
+    if (element) {
+      g_object_set_qdata (element, self->quark, NULL);
+      g_object_unref (element);
+    }
+  }
+
+  g_hash_table_destroy (self->elements);
+  g_free (self->address);
+  g_mutex_clear (&self->lock);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+/**
+ * @brief Initialize the class of tensor metrics.
+ */
+static void
+gst_tensor_metrics_class_init (GstTensorMetricsClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  GST_DEBUG_CATEGORY_INIT (gst_tensor_metrics_debug, "tensormetrics", 0,
+      "Tracer to export the metrics of nnstreamer elements");
+
+  gobject_class->constructed = gst_tensor_metrics_constructed;
+  gobject_class->finalize = gst_tensor_metrics_finalize;
+}
+
+/**
+ * @brief Initialize the tensor metrics.
+ */
+static void
+gst_tensor_metrics_init (GstTensorMetrics * self)
+{
+  GstTracer *tracer = GST_TRACER (self);
+  gchar *key;
+
+  /* the key of the element data, the elements may be tracked by multiple tracers */
+  key = g_strdup_printf ("nnstreamer-metrics-%p", (gpointer) self);
+  self->quark = g_quark_from_string (key);
+  g_free (key);
+
+  g_mutex_init (&self->lock);
+  self->elements = g_hash_table_new_full (g_direct_hash, g_direct_equal,
+      NULL, gst_tensor_metrics_element_free);
+  self->num_added = 0;
+  self->address = g_strdup (DEFAULT_ADDRESS);
+  self->port = DEFAULT_PORT;
+  self->service = NULL;
+
+  gst_tracing_register_hook (tracer, "element-new",
+      G_CALLBACK (gst_tensor_metrics_element_new));
+  gst_tracing_register_hook (tracer, "pad-push-pre",
+      G_CALLBACK (gst_tensor_metrics_pad_push_pre));
+  gst_tracing_register_hook (tracer, "pad-push-list-pre",
+      G_CALLBACK (gst_tensor_metrics_pad_push_list_pre));
+}
+
+/**
+ * @brief Start the metrics exporter configured in nnstreamer.ini ([metrics] section).
+ */
+void
+gst_tensor_metrics_init_from_conf (void)
+{
+  static gsize initialized = 0;
+
+  if (g_once_init_enter (&initialized)) {
+    if (nnsconf_get_custom_value_bool ("metrics", "enable_exporter", FALSE)) {
+      gchar *address = nnsconf_get_custom_value_string ("metrics", "address");
+      gchar *port = nnsconf_get_custom_value_string ("metrics", "port");
+      gchar *params;
+
+      params = g_strdup_printf ("address=\"%s\",port=%u",
+          (address && address[0] != '\0') ? address : DEFAULT_ADDRESS,
+          port ? (guint) g_ascii_strtoull (port, NULL, 10) : DEFAULT_PORT);
+      conf_exporter = g_object_new (GST_TYPE_TENSOR_METRICS, "params", params,
+          NULL);
+
+      g_free (params);
+      g_free (address);
+      g_free (port);
+    }
+
+    g_once_init_leave (&initialized, 1);
+  }
+}
+
+#else /* GST_DISABLE_GST_TRACER_HOOKS */
+
+G_DEFINE_TYPE (GstTensorMetrics, gst_tensor_metrics, G_TYPE_OBJECT);
+
+/**
+ * @brief Initialize the class of tensor metrics (tracer hooks are disabled).
+ */
+static void
+gst_tensor_metrics_class_init (GstTensorMetricsClass * klass)
+{
+  UNUSED (klass);
+}
+
+/**
+ * @brief Initialize the tensor metrics (tracer hooks are disabled).
+ */
+static void
+gst_tensor_metrics_init (GstTensorMetrics * self)
+{
+  UNUSED (self);
+}
+
+/**
+ * @brief Get the metrics of the tracked elements (tracer hooks are disabled).
+ */
+gchar *
+gst_tensor_metrics_collect (GstTensorMetrics * self)
+{
+  UNUSED (self);
+  return g_strdup ("");
+}
+
+/**
+ * @brief Start the metrics exporter configured in nnstreamer.ini (tracer hooks are disabled).
+ */
+void
+gst_tensor_metrics_init_from_conf (void)
+{
+  if (nnsconf_get_custom_value_bool ("metrics", "enable_exporter", FALSE))
+    nns_logw ("tensormetrics: the tracer hooks are disabled in GStreamer.");
+
+  UNUSED (conf_exporter);
+}
+
+#endif /* GST_DISABLE_GST_TRACER_HOOKS */
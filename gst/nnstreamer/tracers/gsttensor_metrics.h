@@ -0,0 +1,88 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file    gsttensor_metrics.h
+ * @date    14 Oct 2026
+ * @brief   GStreamer tracer to export the metrics of nnstreamer elements (Prometheus text format)
+ * @see     http://github.com/nnstreamer/nnstreamer
+ * @author  agent <agent@local>
+ * @bug     No known bugs
+ */
+
+#ifndef __GST_TENSOR_METRICS_H__
+#define __GST_TENSOR_METRICS_H__
+
+#include <gst/gst.h>
+#include <gio/gio.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_TENSOR_METRICS \
+  (gst_tensor_metrics_get_type())
+#define GST_TENSOR_METRICS(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_TENSOR_METRICS,GstTensorMetrics))
+#define GST_TENSOR_METRICS_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_TENSOR_METRICS,GstTensorMetricsClass))
+#define GST_IS_TENSOR_METRICS(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_TENSOR_METRICS))
+#define GST_IS_TENSOR_METRICS_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_TENSOR_METRICS))
+
+typedef struct _GstTensorMetrics GstTensorMetrics;
+typedef struct _GstTensorMetricsClass GstTensorMetricsClass;
+
+/**
+ * @brief Tracer collecting the metrics of nnstreamer elements and serving them over HTTP.
+ */
+struct _GstTensorMetrics
+{
+#ifndef GST_DISABLE_GST_TRACER_HOOKS
+  GstTracer parent; /**< parent object */
+#else
+  GObject parent; /**< parent object (tracer hooks are disabled) */
+#endif
+
+  GMutex lock; /**< lock for the list of the elements */
+  GHashTable *elements; /**< the tracked elements (GstTensorMetricsElement) */
+  guint num_added; /**< the number of the elements added since the list is pruned */
+  GQuark quark; /**< key of the element data attached to the tracked elements */
+
+  gchar *address; /**< address to listen, NULL to disable the endpoint */
+  guint port; /**< port to listen (0 to get an available port) */
+  GSocketService *service; /**< HTTP endpoint (NULL if not started) */
+};
+
+/**
+ * @brief GstTensorMetricsClass data structure.
+ */
+struct _GstTensorMetricsClass
+{
+#ifndef GST_DISABLE_GST_TRACER_HOOKS
+  GstTracerClass parent_class; /**< parent class */
+#else
+  GObjectClass parent_class; /**< parent class */
+#endif
+};
+
+/**
+ * @brief Get type of GstTensorMetrics.
+ */
+GType gst_tensor_metrics_get_type (void);
+
+/**
+ * @brief Start the metrics exporter configured in nnstreamer.ini ([metrics] section).
+ * @note The exporter is created once in the process, and it is not released.
+ */
+extern void
+gst_tensor_metrics_init_from_conf (void);
+
+/**
+ * @brief Get the metrics of the tracked elements in Prometheus text exposition format.
+ * @return Newly allocated string. The caller should free it.
+ */
+extern gchar *
+gst_tensor_metrics_collect (GstTensorMetrics * self);
+
+G_END_DECLS
+#endif /* __GST_TENSOR_METRICS_H__ */
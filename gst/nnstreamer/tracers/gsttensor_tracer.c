@@ -0,0 +1,561 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file    gsttensor_tracer.c
+ * @date    14 Oct 2026
+ * @brief   GStreamer tracer to profile nnstreamer pipelines (Chrome trace JSON)
+ * @see     http://github.com/nnstreamer/nnstreamer
+ * @author  agent <agent@local>
+ * @bug     No known bugs
+ */
+
+/**
+ * SECTION:tracer-tensortrace
+ *
+ * A tracer that measures the processing time of each element in the pipeline
+ * and writes the events in Chrome trace (JSON array) format, which can be
+ * opened with chrome://tracing or ui.perfetto.dev.
+ *
+ * For each buffer (or buffer list) pushed to an element, it records the
+ * duration of the chain function, the self time (excluding the time spent
+ * by the downstream elements in the same thread), the bytes of the input and
+ * output buffers, and the number of the output memory chunks which are newly
+ * written (mem_alloc) or shared with the input buffer (mem_shared).
+ * The invoke time of tensor_filter is written as a separate event.
+ *
+ * <refsect2>
+ * <title>Example launch line</title>
+ * |[
+ * GST_TRACERS="tensortrace(file=/tmp/trace.json)" gst-launch-1.0 videotestsrc num-buffers=10 ! tensor_converter ! tensor_sink
+ * ]|
+ * </refsect2>
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <glib/gstdio.h>
+#include <nnstreamer_log.h>
+#include <nnstreamer_util.h>
+#include "gsttensor_tracer.h"
+
+#ifdef G_OS_UNIX
+#include <unistd.h>
+#define TRACER_PID ((gint) getpid ())
+#else
+#define TRACER_PID (0)
+#endif
+
+/**
+ * @brief Default path of the trace file.
+ */
+#define DEFAULT_LOCATION "tensortrace.json"
+
+/**
+ * @brief The max number of input memory chunks to be compared with the output.
+ */
+#define TRACER_MAX_MEMS (16)
+
+/**
+ * @brief The tracer writing the invoke events.
+ */
+static GstTensorTracer *active_tracer = NULL;
+
+#ifndef GST_DISABLE_GST_TRACER_HOOKS
+
+G_LOCK_DEFINE_STATIC (active_tracer);
+
+GST_DEBUG_CATEGORY_STATIC (gst_tensor_tracer_debug);
+#define GST_CAT_DEFAULT gst_tensor_tracer_debug
+
+#define gst_tensor_tracer_parent_class parent_class
+G_DEFINE_TYPE (GstTensorTracer, gst_tensor_tracer, GST_TYPE_TRACER);
+
+/**
+ * @brief Data of the element processing a buffer in the current thread.
+ */
+typedef struct
+{
+  GstElement *element; /**< the element (NULL for a bin or a ghost pad) */
+  GstClockTime start; /**< timestamp when the buffer is pushed */
+  GstClockTime child_time; /**< time spent by the downstream elements in the same thread */
+  GstClockTime invoke_time; /**< invoke time of the tensor filter */
+  guint64 bytes_in; /**< bytes of the input buffers */
+  guint64 bytes_out; /**< bytes of the output buffers */
+  guint mem_alloc; /**< the number of the newly written output memory chunks */
+  guint mem_shared; /**< the number of the output memory chunks shared with the input */
+  guint num_in_mems; /**< the number of the input memory chunks */
+  gconstpointer in_mems[TRACER_MAX_MEMS]; /**< the input memory chunks (to compare the address only) */
+} GstTensorTracerFrame;
+
+/**
+ * @brief Stack of the elements processing a buffer in the current thread.
+ */
+typedef struct
+{
+  guint tid; /**< thread id in the trace */
+  GArray *frames; /**< the stack of GstTensorTracerFrame */
+} GstTensorTracerThread;
+
+static gint tracer_num_threads = 0;
+
+/**
+ * @brief Free the stack of the thread.
+ */
+static void
+gst_tensor_tracer_thread_free (gpointer data)
+{
+  GstTensorTracerThread *thread = (GstTensorTracerThread *) data;
+
+  g_array_free (thread->frames, TRUE);
+  g_free (thread);
+}
+
+static GPrivate tracer_thread = G_PRIVATE_INIT (gst_tensor_tracer_thread_free);
+
+/**
+ * @brief Get the stack of the current thread.
+ */
+static GstTensorTracerThread *
+gst_tensor_tracer_get_thread (void)
+{
+  GstTensorTracerThread *thread = g_private_get (&tracer_thread);
+
+  if (G_UNLIKELY (thread == NULL)) {
+    thread = g_new0 (GstTensorTracerThread, 1);
+    thread->tid = (guint) g_atomic_int_add (&tracer_num_threads, 1) + 1;
+    thread->frames = g_array_new (FALSE, TRUE, sizeof (GstTensorTracerFrame));
+    g_private_set (&tracer_thread, thread);
+  }
+
+  return thread;
+}
+
+/**
+ * @brief Get the top of the stack (NULL if empty).
+ */
+static GstTensorTracerFrame *
+gst_tensor_tracer_get_top (GstTensorTracerThread * thread)
+{
+  if (thread->frames->len == 0)
+    return NULL;
+
+  return &g_array_index (thread->frames, GstTensorTracerFrame,
+      thread->frames->len - 1);
+}
+
+/**
+ * @brief Write an event to the trace file.
+ */
+static void
+gst_tensor_tracer_write (GstTensorTracer * self, const gchar * format, ...)
+{
+  va_list args;
+  gchar *event;
+
+  if (self->file == NULL)
+    return;
+
+  va_start (args, format);
+  event = g_strdup_vprintf (format, args);
+  va_end (args);
+
+  g_mutex_lock (&self->lock);
+  fprintf (self->file, "%s  %s", (self->num_events > 0) ? ",\n" : "", event);
+  self->num_events++;
+  g_mutex_unlock (&self->lock);
+
+  g_free (event);
+}
+
+/**
+ * @brief Add the input buffer to the frame.
+ */
+static void
+gst_tensor_tracer_frame_add_input (GstTensorTracerFrame * frame,
+    GstBuffer * buffer)
+{
+  guint i, num_mems;
+
+  frame->bytes_in += gst_buffer_get_size (buffer);
+
+  num_mems = gst_buffer_n_memory (buffer);
+  for (i = 0; i < num_mems && frame->num_in_mems < TRACER_MAX_MEMS; i++)
+    frame->in_mems[frame->num_in_mems++] = gst_buffer_peek_memory (buffer, i);
+}
+
+/**
+ * @brief Add the output buffer to the frame.
+ */
+static void
+gst_tensor_tracer_frame_add_output (GstTensorTracerFrame * frame,
+    GstBuffer * buffer)
+{
+  GstMemory *mem;
+  guint i, j, num_mems;
+  gboolean shared;
+
+  frame->bytes_out += gst_buffer_get_size (buffer);
+
+  num_mems = gst_buffer_n_memory (buffer);
+  for (i = 0; i < num_mems; i++) {
+    mem = gst_buffer_peek_memory (buffer, i);
+    shared = FALSE;
+
+    /* the same memory or its sub-memory means no copy */
+    for (j = 0; j < frame->num_in_mems && !shared; j++) {
+      shared = (frame->in_mems[j] == (gconstpointer) mem ||
+          frame->in_mems[j] == (gconstpointer) mem->parent);
+    }
+
+    if (shared)
+      frame->mem_shared++;
+    else
+      frame->mem_alloc++;
+  }
+}
+
+/**
+ * @brief Get the element of the pad which receives the buffer (NULL if not an element).
+ */
+static GstElement *
+gst_tensor_tracer_get_peer_element (GstPad * pad)
+{
+  GstPad *peer;
+  GstObject *parent;
+  GstElement *element = NULL;
+
+  peer = gst_pad_get_peer (pad);
+  if (peer == NULL)
+    return NULL;
+
+  parent = GST_OBJECT_PARENT (peer);
+  if (parent && GST_IS_ELEMENT (parent) && !GST_IS_BIN (parent))
+    element = GST_ELEMENT_CAST (parent);
+
+  gst_object_unref (peer);
+  return element;
+}
+
+/**
+ * @brief Push a frame for the element which receives the buffers.
+ */
+static void
+gst_tensor_tracer_push_frame (GstClockTime ts, GstPad * pad,
+    GstBuffer ** buffers, guint num_buffers)
+{
+  GstTensorTracerThread *thread;
+  GstTensorTracerFrame *top;
+  GstTensorTracerFrame frame = { 0, };
+  GstObject *parent;
+  guint i;
+
+  thread = gst_tensor_tracer_get_thread ();
+  parent = GST_OBJECT_PARENT (pad);
+
+  /* the output of the element processing a buffer in this thread */
+  top = gst_tensor_tracer_get_top (thread);
+  if (top && top->element && (GstObject *) top->element == parent) {
+    for (i = 0; i < num_buffers; i++)
+      gst_tensor_tracer_frame_add_output (top, buffers[i]);
+  }
+
+  /* push a frame for the bin (or ghost pad) to keep the stack balanced */
+  frame.element = gst_tensor_tracer_get_peer_element (pad);
+  frame.start = ts;
+  if (frame.element) {
+    for (i = 0; i < num_buffers; i++)
+      gst_tensor_tracer_frame_add_input (&frame, buffers[i]);
+  }
+
+  g_array_append_val (thread->frames, frame);
+}
+
+/**
+ * @brief Pop the frame and write the event of the element.
+ */
+static void
+gst_tensor_tracer_pop_frame (GstTensorTracer * self, GstClockTime ts)
+{
+  GstTensorTracerThread *thread;
+  GstTensorTracerFrame frame;
+  GstTensorTracerFrame *top;
+  GstClockTime dur, self_time;
+  gchar *name;
+
+  thread = gst_tensor_tracer_get_thread ();
+
+  /* the tracer may be created while pushing a buffer */
+  top = gst_tensor_tracer_get_top (thread);
+  if (top == NULL)
+    return;
+
+  frame = *top;
+  g_array_set_size (thread->frames, thread->frames->len - 1);
+
+  dur = (ts > frame.start) ? ts - frame.start : 0;
+  self_time = (dur > frame.child_time) ? dur - frame.child_time : 0;
+
+  top = gst_tensor_tracer_get_top (thread);
+  if (top)
+    top->child_time += dur;
+
+  if (frame.element == NULL)
+    return;
+
+  name = g_strescape (GST_OBJECT_NAME (frame.element), NULL);
+  gst_tensor_tracer_write (self,
+      "{\"name\":\"%s\",\"cat\":\"element\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%u,"
+      "\"args\":{\"type\":\"%s\",\"self_time\":%.3f,\"invoke_time\":%.3f,"
+      "\"bytes_in\":%" G_GUINT64_FORMAT ",\"bytes_out\":%" G_GUINT64_FORMAT
+      ",\"mem_alloc\":%u,\"mem_shared\":%u}}",
+      name, frame.start / 1000.0, dur / 1000.0, TRACER_PID, thread->tid,
+      G_OBJECT_TYPE_NAME (frame.element), self_time / 1000.0,
+      frame.invoke_time / 1000.0, frame.bytes_in, frame.bytes_out,
+      frame.mem_alloc, frame.mem_shared);
+  g_free (name);
+}
+
+/**
+ * @brief Hook before pushing a buffer.
+ */
+static void
+gst_tensor_tracer_pad_push_pre (GObject * object, GstClockTime ts,
+    GstPad * pad, GstBuffer * buffer)
+{
+  UNUSED (object);
+  gst_tensor_tracer_push_frame (ts, pad, &buffer, 1);
+}
+
+/**
+ * @brief Hook before pushing a buffer list.
+ */
+static void
+gst_tensor_tracer_pad_push_list_pre (GObject * object, GstClockTime ts,
+    GstPad * pad, GstBufferList * list)
+{
+  GstBuffer *buffers[TRACER_MAX_MEMS];
+  guint i, num_buffers;
+
+  UNUSED (object);
+  num_buffers = MIN (gst_buffer_list_length (list), TRACER_MAX_MEMS);
+  for (i = 0; i < num_buffers; i++)
+    buffers[i] = gst_buffer_list_get (list, i);
+
+  gst_tensor_tracer_push_frame (ts, pad, buffers, num_buffers);
+}
+
+/**
+ * @brief Hook after pushing a buffer (or a buffer list).
+ */
+static void
+gst_tensor_tracer_pad_push_post (GObject * object, GstClockTime ts,
+    GstPad * pad, GstFlowReturn res)
+{
+  UNUSED (pad);
+  UNUSED (res);
+  gst_tensor_tracer_pop_frame (GST_TENSOR_TRACER (object), ts);
+}
+
+/**
+ * @brief Parse the parameters of the tracer (e.g., "file=/tmp/trace.json").
+ */
+static void
+gst_tensor_tracer_parse_params (GstTensorTracer * self, const gchar * params)
+{
+  GstStructure *structure;
+  const gchar *file;
+  gchar *str;
+
+  if (params == NULL || params[0] == '\0')
+    return;
+
+  str = g_strdup_printf ("tensortrace,%s", params);
+  structure = gst_structure_from_string (str, NULL);
+  g_free (str);
+
+  if (structure == NULL) {
+    nns_logw ("tensortrace: invalid params '%s', use the default.", params);
+    return;
+  }
+
+  file = gst_structure_get_string (structure, "file");
+  if (file) {
+    g_free (self->location);
+    self->location = g_strdup (file);
+  }
+
+  gst_structure_free (structure);
+}
+
+/**
+ * @brief Open the trace file with the parameters.
+ */
+static void
+gst_tensor_tracer_constructed (GObject * object)
+{
+  GstTensorTracer *self = GST_TENSOR_TRACER (object);
+  gchar *params = NULL;
+
+  g_object_get (object, "params", &params, NULL);
+  gst_tensor_tracer_parse_params (self, params);
+  g_free (params);
+
+  self->file = g_fopen (self->location, "w");
+  if (self->file == NULL) {
+    nns_logw ("tensortrace: cannot open the trace file '%s'.", self->location);
+  } else {
+    fputs ("[\n", self->file);
+
+    G_LOCK (active_tracer);
+    if (active_tracer == NULL)
+      g_atomic_pointer_set (&active_tracer, self);
+    G_UNLOCK (active_tracer);
+  }
+
+  if (G_OBJECT_CLASS (parent_class)->constructed)
+    G_OBJECT_CLASS (parent_class)->constructed (object);
+}
+
+/**
+ * @brief Close the trace file.
+ */
+static void
+gst_tensor_tracer_finalize (GObject * object)
+{
+  GstTensorTracer *self = GST_TENSOR_TRACER (object);
+
+  G_LOCK (active_tracer);
+  if (active_tracer == self)
+    g_atomic_pointer_set (&active_tracer, NULL);
+  G_UNLOCK (active_tracer);
+
+  if (self->file) {
+    fputs ("\n]\n", self->file);
+    fclose (self->file);
+    self->file = NULL;
+  }
+
+  g_free (self->location);
+  g_mutex_clear (&self->lock);
+
+  G_OBJECT_CLASS (parent_class)->finalize (object);
+}
+
+/**
+ * @brief Initialize the class of tensor tracer.
+ */
+static void
+gst_tensor_tracer_class_init (GstTensorTracerClass * klass)
+{
+  GObjectClass *gobject_class = G_OBJECT_CLASS (klass);
+
+  GST_DEBUG_CATEGORY_INIT (gst_tensor_tracer_debug, "tensortrace", 0,
+      "Tracer to write Chrome trace of nnstreamer pipelines");
+
+  gobject_class->constructed = gst_tensor_tracer_constructed;
+  gobject_class->finalize = gst_tensor_tracer_finalize;
+}
+
+/**
+ * @brief Initialize the tensor tracer.
+ */
+static void
+gst_tensor_tracer_init (GstTensorTracer * self)
+{
+  GstTracer *tracer = GST_TRACER (self);
+
+  g_mutex_init (&self->lock);
+  self->location = g_strdup (DEFAULT_LOCATION);
+  self->file = NULL;
+  self->num_events = 0;
+
+  gst_tracing_register_hook (tracer, "pad-push-pre",
+      G_CALLBACK (gst_tensor_tracer_pad_push_pre));
+  gst_tracing_register_hook (tracer, "pad-push-post",
+      G_CALLBACK (gst_tensor_tracer_pad_push_post));
+  gst_tracing_register_hook (tracer, "pad-push-list-pre",
+      G_CALLBACK (gst_tensor_tracer_pad_push_list_pre));
+  gst_tracing_register_hook (tracer, "pad-push-list-post",
+      G_CALLBACK (gst_tensor_tracer_pad_push_post));
+}
+
+/**
+ * @brief Write the invoke time of the tensor filter to the trace.
+ */
+void
+gst_tensor_tracer_record_invoke (GstElement * element, GstClockTime start,
+    GstClockTime end)
+{
+  GstTensorTracerThread *thread;
+  GstTensorTracerFrame *top;
+  GstClockTime dur;
+  gchar *name;
+
+  g_return_if_fail (GST_IS_ELEMENT (element));
+
+  thread = gst_tensor_tracer_get_thread ();
+  dur = (end > start) ? end - start : 0;
+
+  /* the invoke in the streaming thread (not in the workers) */
+  top = gst_tensor_tracer_get_top (thread);
+  if (top && top->element == element)
+    top->invoke_time += dur;
+
+  G_LOCK (active_tracer);
+  if (active_tracer) {
+    name = g_strescape (GST_OBJECT_NAME (element), NULL);
+    gst_tensor_tracer_write (active_tracer,
+        "{\"name\":\"%s:invoke\",\"cat\":\"invoke\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%u}",
+        name, start / 1000.0, dur / 1000.0, TRACER_PID, thread->tid);
+    g_free (name);
+  }
+  G_UNLOCK (active_tracer);
+}
+
+#else /* GST_DISABLE_GST_TRACER_HOOKS */
+
+G_DEFINE_TYPE (GstTensorTracer, gst_tensor_tracer, G_TYPE_OBJECT);
+
+/**
+ * @brief Initialize the class of tensor tracer (tracer hooks are disabled).
+ */
+static void
+gst_tensor_tracer_class_init (GstTensorTracerClass * klass)
+{
+  UNUSED (klass);
+}
+
+/**
+ * @brief Initialize the tensor tracer (tracer hooks are disabled).
+ */
+static void
+gst_tensor_tracer_init (GstTensorTracer * self)
+{
+  UNUSED (self);
+}
+
+/**
+ * @brief Write the invoke time of the tensor filter to the trace.
+ */
+void
+gst_tensor_tracer_record_invoke (GstElement * element, GstClockTime start,
+    GstClockTime end)
+{
+  UNUSED (element);
+  UNUSED (start);
+  UNUSED (end);
+}
+
+#endif /* GST_DISABLE_GST_TRACER_HOOKS */
+
+/**
+ * @brief Check whether the tensor tracer is running.
+ */
+gboolean
+gst_tensor_tracer_is_active (void)
+{
+  return (g_atomic_pointer_get (&active_tracer) != NULL);
+}
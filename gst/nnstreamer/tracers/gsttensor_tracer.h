@@ -0,0 +1,87 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file    gsttensor_tracer.h
+ * @date    14 Oct 2026
+ * @brief   GStreamer tracer to profile nnstreamer pipelines (Chrome trace JSON)
+ * @see     http://github.com/nnstreamer/nnstreamer
+ * @author  agent <agent@local>
+ * @bug     No known bugs
+ */
+
+#ifndef __GST_TENSOR_TRACER_H__
+#define __GST_TENSOR_TRACER_H__
+
+#include <stdio.h>
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+#define GST_TYPE_TENSOR_TRACER \
+  (gst_tensor_tracer_get_type())
+#define GST_TENSOR_TRACER(obj) \
+  (G_TYPE_CHECK_INSTANCE_CAST((obj),GST_TYPE_TENSOR_TRACER,GstTensorTracer))
+#define GST_TENSOR_TRACER_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_CAST((klass),GST_TYPE_TENSOR_TRACER,GstTensorTracerClass))
+#define GST_IS_TENSOR_TRACER(obj) \
+  (G_TYPE_CHECK_INSTANCE_TYPE((obj),GST_TYPE_TENSOR_TRACER))
+#define GST_IS_TENSOR_TRACER_CLASS(klass) \
+  (G_TYPE_CHECK_CLASS_TYPE((klass),GST_TYPE_TENSOR_TRACER))
+
+typedef struct _GstTensorTracer GstTensorTracer;
+typedef struct _GstTensorTracerClass GstTensorTracerClass;
+
+/**
+ * @brief Tracer writing the processing time of the elements in Chrome trace format.
+ */
+struct _GstTensorTracer
+{
+#ifndef GST_DISABLE_GST_TRACER_HOOKS
+  GstTracer parent; /**< parent object */
+#else
+  GObject parent; /**< parent object (tracer hooks are disabled) */
+#endif
+
+  GMutex lock; /**< lock for the trace file */
+  gchar *location; /**< path of the trace file */
+  FILE *file; /**< trace file (NULL if not opened) */
+  guint64 num_events; /**< the number of written events */
+};
+
+/**
+ * @brief GstTensorTracerClass data structure.
+ */
+struct _GstTensorTracerClass
+{
+#ifndef GST_DISABLE_GST_TRACER_HOOKS
+  GstTracerClass parent_class; /**< parent class */
+#else
+  GObjectClass parent_class; /**< parent class */
+#endif
+};
+
+/**
+ * @brief Get type of GstTensorTracer.
+ */
+GType gst_tensor_tracer_get_type (void);
+
+/**
+ * @brief Check whether the tensor tracer is running.
+ * @return TRUE if a tensor tracer is created and writing the trace.
+ */
+extern gboolean
+gst_tensor_tracer_is_active (void);
+
+/**
+ * @brief Write the invoke time of the tensor filter to the trace.
+ * @param element the element invoking the model
+ * @param start the timestamp (gst_util_get_timestamp) before the invoke
+ * @param end the timestamp (gst_util_get_timestamp) after the invoke
+ */
+extern void
+gst_tensor_tracer_record_invoke (GstElement * element, GstClockTime start,
+    GstClockTime end);
+
+G_END_DECLS
+#endif /* __GST_TENSOR_TRACER_H__ */
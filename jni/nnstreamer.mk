@@ -32,13 +32,19 @@ NNSTREAMER_INCLUDES := \
 # nnstreamer common sources. (including tensor-filter common, custom filter)
 NNSTREAMER_COMMON_SRCS := \
     $(NNSTREAMER_GST_HOME)/hw_accel.c \
+    $(NNSTREAMER_GST_HOME)/tensor_kernels.c \
     $(NNSTREAMER_GST_HOME)/nnstreamer_conf.c \
     $(NNSTREAMER_GST_HOME)/nnstreamer_log.c \
     $(NNSTREAMER_GST_HOME)/nnstreamer_subplugin.c \
     $(NNSTREAMER_GST_HOME)/nnstreamer_plugin_api_util_impl.c \
     $(NNSTREAMER_GST_HOME)/tensor_filter/tensor_filter_common.c \
+    $(NNSTREAMER_GST_HOME)/tensor_filter/tensor_filter_scheduler.c \
+    $(NNSTREAMER_GST_HOME)/tensor_filter/tensor_filter_cache.c \
+    $(NNSTREAMER_GST_HOME)/tensor_filter/tensor_filter_output_pool.c \
+    $(NNSTREAMER_GST_HOME)/tensor_filter/tensor_filter_model_map.c \
     $(NNSTREAMER_GST_HOME)/tensor_filter/tensor_filter_custom.c \
     $(NNSTREAMER_GST_HOME)/tensor_filter/tensor_filter_custom_easy.c \
+    $(NNSTREAMER_GST_HOME)/tensor_filter/tensor_filter_custom_easy_ops.c \
     $(NNSTREAMER_GST_HOME)/tensor_filter/tensor_filter_support_cc.cc \
     $(NNSTREAMER_GST_HOME)/tensor_filter/tensor_filter_single.c \
     $(NNSTREAMER_EXT_HOME)/tensor_filter/tensor_filter_cpp.cc
@@ -46,11 +52,15 @@ NNSTREAMER_COMMON_SRCS := \
 # nnstreamer plugins. Not used for SINGLE-only build.
 NNSTREAMER_PLUGINS_SRCS := \
     $(NNSTREAMER_GST_HOME)/tensor_data.c \
+    $(NNSTREAMER_GST_HOME)/tensor_device_memory.c \
     $(NNSTREAMER_GST_HOME)/tensor_meta.c \
+    $(NNSTREAMER_GST_HOME)/tensor_profile.c \
     $(NNSTREAMER_GST_HOME)/nnstreamer_plugin_api_impl.c \
     $(NNSTREAMER_GST_HOME)/registerer/nnstreamer.c \
     $(NNSTREAMER_GST_HOME)/elements/gsttensor_aggregator.c \
+    $(NNSTREAMER_GST_HOME)/elements/gsttensor_batch.c \
     $(NNSTREAMER_GST_HOME)/elements/gsttensor_converter.c \
+    $(NNSTREAMER_GST_HOME)/elements/gsttensor_converter_preprocess.c \
     $(NNSTREAMER_GST_HOME)/elements/gsttensor_crop.c \
     $(NNSTREAMER_GST_HOME)/elements/gsttensor_debug.c \
     $(NNSTREAMER_GST_HOME)/elements/gsttensor_decoder.c \
@@ -69,11 +79,16 @@ NNSTREAMER_PLUGINS_SRCS := \
     $(NNSTREAMER_GST_HOME)/elements/gsttensor_split.c \
     $(NNSTREAMER_GST_HOME)/elements/gsttensor_trainer.c \
     $(NNSTREAMER_GST_HOME)/elements/gsttensor_transform.c \
-    $(NNSTREAMER_GST_HOME)/tensor_filter/tensor_filter.c
+    $(NNSTREAMER_GST_HOME)/elements/gsttensor_unbatch.c \
+    $(NNSTREAMER_GST_HOME)/tensor_filter/tensor_filter.c \
+    $(NNSTREAMER_GST_HOME)/tracers/gsttensor_tracer.c \
+    $(NNSTREAMER_GST_HOME)/tracers/gsttensor_metrics.c
 
 # tensor-query element with nnstreamer-edge
 NNSTREAMER_QUERY_SRCS := \
     $(NNSTREAMER_GST_HOME)/tensor_query/tensor_query_common.c \
+    $(NNSTREAMER_GST_HOME)/tensor_query/tensor_query_compress.c \
+    $(NNSTREAMER_GST_HOME)/tensor_query/tensor_query_shm.c \
     $(NNSTREAMER_GST_HOME)/tensor_query/tensor_query_client.c \
     $(NNSTREAMER_GST_HOME)/tensor_query/tensor_query_serversink.c \
     $(NNSTREAMER_GST_HOME)/tensor_query/tensor_query_serversrc.c \
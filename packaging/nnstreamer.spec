@@ -996,6 +996,7 @@ cp -r result %{buildroot}%{_datadir}/nnstreamer/unittest/
 %{_prefix}/lib/nnstreamer/decoders/libnnstreamer_decoder_image_labeling.so
 %{_prefix}/lib/nnstreamer/decoders/libnnstreamer_decoder_direct_video.so
 %{_prefix}/lib/nnstreamer/decoders/libnnstreamer_decoder_octet_stream.so
+%{_prefix}/lib/nnstreamer/converters/libnnstreamer_converter_audio_feature.so
 %{_prefix}/lib/nnstreamer/filters/libnnstreamer_filter_cpp.so
 %{gstlibdir}/libnnstreamer.so
 %if 0%{?nnstreamer_edge_support}
@@ -1119,6 +1120,7 @@ cp -r result %{buildroot}%{_datadir}/nnstreamer/unittest/
 %{_includedir}/nnstreamer/tensor_if.h
 %{_includedir}/nnstreamer/tensor_filter_custom.h
 %{_includedir}/nnstreamer/tensor_filter_custom_easy.h
+%{_includedir}/nnstreamer/tensor_filter_custom_easy_ops.h
 %{_includedir}/nnstreamer/tensor_converter_custom.h
 %{_includedir}/nnstreamer/tensor_decoder_custom.h
 %{_includedir}/nnstreamer/nnstreamer_plugin_api_decoder.h
@@ -14,11 +14,16 @@
  */
 
 #include <gtest/gtest.h>
+#include <errno.h>
 #include <glib.h>
 #include <glib/gstdio.h>
 #include <nnstreamer_conf.h>
 #include <nnstreamer_plugin_api.h>
+#include <nnstreamer_plugin_api_filter.h>
+#include <hw_accel.h>
 #include <tensor_common.h>
+#include <tensor_data.h>
+#include <tensor_kernels.h>
 #include <unistd.h>
 #include <unittest_util.h>
 
@@ -1444,6 +1449,114 @@ TEST (commonMetaInfo, appendHeader)
   gst_memory_unref (result);
 }
 
+/**
+ * @brief Test for tensor meta info (compact header).
+ */
+TEST (commonMetaInfo, compactHeader)
+{
+  GstTensorMetaInfo meta1, meta2;
+  guint8 header[128];
+  gsize hsize;
+  guint major, minor;
+
+  gst_tensor_meta_info_init (&meta1);
+  gst_tensor_meta_info_set_compact (&meta1);
+  meta1.type = _NNS_FLOAT32;
+  meta1.format = _NNS_TENSOR_FORMAT_FLEXIBLE;
+  meta1.dimension[0] = 4U;
+  meta1.dimension[1] = 300U;
+  meta1.dimension[2] = 70000U;
+
+  gst_tensor_meta_info_get_version (&meta1, &major, &minor);
+  EXPECT_EQ (major, 2U);
+  EXPECT_EQ (minor, 0U);
+
+  /* 4 + 1 (size) + 4 (type, format, media, rank) + 1 + 2 + 3 (dims), aligned to 8 */
+  hsize = gst_tensor_meta_info_get_header_size (&meta1);
+  EXPECT_EQ (hsize, 16U);
+
+  memset (header, 0xff, sizeof (header));
+  EXPECT_TRUE (gst_tensor_meta_info_update_header (&meta1, header));
+  EXPECT_TRUE (gst_tensor_meta_info_parse_header (&meta2, header));
+  EXPECT_EQ (meta2.version, meta1.version);
+  EXPECT_EQ (meta2.type, _NNS_FLOAT32);
+  EXPECT_EQ (meta2.format, _NNS_TENSOR_FORMAT_FLEXIBLE);
+  EXPECT_EQ ((media_type) meta2.media_type, _NNS_TENSOR);
+  EXPECT_EQ (meta2.dimension[0], 4U);
+  EXPECT_EQ (meta2.dimension[1], 300U);
+  EXPECT_EQ (meta2.dimension[2], 70000U);
+  EXPECT_EQ (meta2.dimension[3], 0U);
+  EXPECT_EQ (gst_tensor_meta_info_get_header_size (&meta2), hsize);
+
+  /* sparse tensor has nnz */
+  meta1.format = _NNS_TENSOR_FORMAT_SPARSE;
+  meta1.sparse_info.nnz = 200U;
+  EXPECT_TRUE (gst_tensor_meta_info_update_header (&meta1, header));
+  EXPECT_TRUE (gst_tensor_meta_info_parse_header (&meta2, header));
+  EXPECT_EQ (meta2.format, _NNS_TENSOR_FORMAT_SPARSE);
+  EXPECT_EQ (meta2.sparse_info.nnz, 200U);
+
+  /* invalid header size */
+  header[4] = 200;
+  EXPECT_FALSE (gst_tensor_meta_info_parse_header (&meta2, header));
+}
+
+/**
+ * @brief Test for the cached layout of flexible tensor.
+ */
+TEST (commonMetaInfo, cacheLayout)
+{
+  GstTensorMetaCache cache;
+  GstTensorMetaInfo meta1, meta2;
+  GstMemory *data, *mem, *payload;
+  GstMapInfo map;
+  gsize hsize;
+
+  memset (&cache, 0, sizeof (cache));
+
+  gst_tensor_meta_info_init (&meta1);
+  meta1.type = _NNS_UINT8;
+  meta1.format = _NNS_TENSOR_FORMAT_FLEXIBLE;
+  meta1.dimension[0] = 10U;
+
+  data = gst_allocator_alloc (NULL, 10, NULL);
+  mem = gst_tensor_meta_info_append_header (&meta1, data);
+  hsize = gst_tensor_meta_info_get_header_size (&meta1);
+
+  /* parse and cache the header */
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+  EXPECT_EQ (gst_tensor_meta_cache_parse (&cache, map.data, map.size, &meta2), hsize);
+  EXPECT_EQ (cache.header_size, hsize);
+  EXPECT_EQ (meta2.dimension[0], 10U);
+
+  /* same header, the meta is from the cache */
+  EXPECT_EQ (gst_tensor_meta_cache_parse (&cache, map.data, map.size, &meta2), hsize);
+  EXPECT_EQ (meta2.type, _NNS_UINT8);
+
+  /* too small data */
+  EXPECT_EQ (gst_tensor_meta_cache_parse (&cache, map.data, 4, &meta2), 0U);
+  gst_memory_unmap (mem, &map);
+
+  /* the payload shares the data without the header */
+  payload = gst_tensor_meta_cache_share_payload (&cache, mem, &meta2);
+  ASSERT_TRUE (payload != NULL);
+  EXPECT_EQ (gst_memory_get_sizes (payload, NULL, NULL), 10U);
+  EXPECT_TRUE (payload->parent == mem);
+  gst_memory_unref (payload);
+  gst_memory_unref (mem);
+
+  /* changed header is parsed again */
+  meta1.dimension[0] = 5U;
+  mem = gst_tensor_meta_info_append_header (&meta1, data);
+  payload = gst_tensor_meta_cache_share_payload (&cache, mem, &meta2);
+  ASSERT_TRUE (payload != NULL);
+  EXPECT_EQ (meta2.dimension[0], 5U);
+  gst_memory_unref (payload);
+  gst_memory_unref (mem);
+
+  gst_memory_unref (data);
+}
+
 /**
  * @brief Test for tensor meta info (append header to memory with invalid param).
  */
@@ -1798,6 +1911,89 @@ TEST (confCustom, checkExtraConfPath_p)
   }
 }
 
+/**
+ * @brief Test for the registry cache of sub-plugins
+ */
+TEST (confCustom, registryCache_p)
+{
+  gchar *fullpath = g_build_path ("/", g_get_tmp_dir (), "nns-tizen-XXXXXX", NULL);
+  gchar *dir = g_mkdtemp (fullpath);
+  gchar *filename = g_build_path ("/", dir, "nnstreamer.ini", NULL);
+  gchar *registry = g_build_path ("/", dir, "cache", "registry.ini", NULL);
+  gchar *dirf = g_build_path ("/", dir, "filters", NULL);
+  gchar *confenv = g_strdup (g_getenv ("NNSTREAMER_CONF"));
+  gchar *path;
+  const gchar *fn;
+
+  EXPECT_EQ (g_mkdir (dirf, 0755), 0);
+
+  FILE *fp = g_fopen (filename, "w");
+  ASSERT_TRUE (fp != NULL);
+  g_fprintf (fp, "[common]\n");
+  g_fprintf (fp, "registry_cache=%s\n", registry);
+  g_fprintf (fp, "[filter]\n");
+  g_fprintf (fp, "filters=%s\n", dirf);
+  fclose (fp);
+
+  gchar *f1 = create_null_file (
+      dirf, "libnnstreamer_filter_fantastic" NNSTREAMER_SO_FILE_EXTENSION);
+
+  EXPECT_TRUE (g_setenv ("NNSTREAMER_CONF", filename, TRUE));
+  EXPECT_TRUE (nnsconf_loadconf (TRUE));
+  EXPECT_TRUE (g_file_test (registry, G_FILE_TEST_IS_REGULAR));
+
+  fn = nnsconf_get_fullpath ("fantastic", NNSCONF_PATH_FILTERS);
+  EXPECT_STREQ (fn, f1);
+
+  /* the name registered by the file */
+  nnsconf_registry_set_subplugin_path (NNSCONF_PATH_FILTERS, "wonderful", f1);
+  nnsconf_registry_set_subplugin_path (
+      NNSCONF_PATH_FILTERS, "notfound", "/not/found/libnnstreamer_filter_notfound.so");
+
+  /* reload the configuration with the cache */
+  EXPECT_TRUE (nnsconf_loadconf (TRUE));
+
+  fn = nnsconf_get_fullpath ("fantastic", NNSCONF_PATH_FILTERS);
+  EXPECT_STREQ (fn, f1);
+
+  path = nnsconf_registry_get_subplugin_path (NNSCONF_PATH_FILTERS, "wonderful");
+  EXPECT_STREQ (path, f1);
+  g_free (path);
+
+  /* the file is not in the list of sub-plugins */
+  path = nnsconf_registry_get_subplugin_path (NNSCONF_PATH_FILTERS, "notfound");
+  EXPECT_TRUE (path == NULL);
+  path = nnsconf_registry_get_subplugin_path (NNSCONF_PATH_DECODERS, "wonderful");
+  EXPECT_TRUE (path == NULL);
+
+  /* the file failed to be loaded */
+  EXPECT_FALSE (nnsconf_registry_is_broken (NNSCONF_PATH_FILTERS, f1));
+  nnsconf_registry_set_broken (NNSCONF_PATH_FILTERS, f1, TRUE);
+  EXPECT_TRUE (nnsconf_registry_is_broken (NNSCONF_PATH_FILTERS, f1));
+  EXPECT_FALSE (nnsconf_registry_is_broken (NNSCONF_PATH_DECODERS, f1));
+  nnsconf_registry_set_broken (NNSCONF_PATH_FILTERS, f1, FALSE);
+  EXPECT_FALSE (nnsconf_registry_is_broken (NNSCONF_PATH_FILTERS, f1));
+
+  gchar *cachedir = g_path_get_dirname (registry);
+
+  removeTempFile (&f1);
+  removeTempFile (&registry);
+  removeTempFile (&filename);
+  g_rmdir (cachedir);
+  g_rmdir (dirf);
+  g_free (cachedir);
+  g_free (dirf);
+  g_free (fullpath);
+
+  if (confenv) {
+    EXPECT_TRUE (g_setenv ("NNSTREAMER_CONF", confenv, TRUE));
+    g_free (confenv);
+  } else {
+    g_unsetenv ("NNSTREAMER_CONF");
+  }
+  EXPECT_TRUE (nnsconf_loadconf (TRUE));
+}
+
 /**
  * @brief Test nnstreamer conf util (name prefix with invalid param).
  */
@@ -2012,6 +2208,611 @@ TEST (commonUtil, createTensorBufferInvalidSize_n)
   EXPECT_FALSE (out != NULL);
 }
 
+/**
+ * @brief Test for tensor allocator (reuse the pooled memory).
+ */
+TEST (commonTensorAllocator, pooledReuse)
+{
+  GstTensorAllocatorStats stats1, stats2;
+  GstMemory *mem;
+  GstMapInfo map;
+  gpointer data;
+
+  gst_tensor_alloc_init_full (0, TRUE, FALSE);
+
+  mem = gst_allocator_alloc (NULL, 1000, NULL);
+  ASSERT_TRUE (mem != NULL);
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_WRITE));
+  data = map.data;
+  memset (map.data, 0xAB, map.size);
+  gst_memory_unmap (mem, &map);
+  gst_memory_unref (mem);
+
+  gst_tensor_alloc_get_stats (&stats1);
+  EXPECT_GT (stats1.resident_bytes, 0ULL);
+  EXPECT_GT (stats1.cached_bytes, 0ULL);
+
+  /* same size class, the memory block is reused from the thread cache */
+  mem = gst_allocator_alloc (NULL, 900, NULL);
+  ASSERT_TRUE (mem != NULL);
+  EXPECT_EQ (gst_memory_get_sizes (mem, NULL, NULL), 900U);
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+  EXPECT_EQ (map.data, (guint8 *) data);
+  gst_memory_unmap (mem, &map);
+
+  gst_tensor_alloc_get_stats (&stats2);
+  EXPECT_EQ (stats2.hits, stats1.hits + 1);
+  EXPECT_EQ (stats2.misses, stats1.misses);
+  EXPECT_LT (stats2.cached_bytes, stats1.cached_bytes);
+
+  gst_memory_unref (mem);
+  gst_tensor_alloc_init_full (0, FALSE, FALSE);
+}
+
+/**
+ * @brief Test for tensor allocator (alignment with the pooled memory).
+ */
+TEST (commonTensorAllocator, pooledAlignment)
+{
+  GstMemory *mem, *sub;
+  GstMapInfo map;
+
+  gst_tensor_alloc_init_full (63, TRUE, FALSE);
+
+  mem = gst_allocator_alloc (NULL, 3000, NULL);
+  ASSERT_TRUE (mem != NULL);
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_WRITE));
+  EXPECT_EQ (((guintptr) map.data) & 63, 0U);
+  map.data[100] = 0x12;
+  gst_memory_unmap (mem, &map);
+
+  /* shared memory refers the parent */
+  sub = gst_memory_share (mem, 100, 10);
+  ASSERT_TRUE (sub != NULL);
+  ASSERT_TRUE (gst_memory_map (sub, &map, GST_MAP_READ));
+  EXPECT_EQ (map.size, 10U);
+  EXPECT_EQ (map.data[0], 0x12);
+  gst_memory_unmap (sub, &map);
+
+  gst_memory_unref (sub);
+  gst_memory_unref (mem);
+  gst_tensor_alloc_init_full (0, FALSE, FALSE);
+}
+
+/**
+ * @brief Test for tensor allocator (invalid param).
+ */
+TEST (commonTensorAllocator, getStatsInvalidParam_n)
+{
+  /* do not crash with null param */
+  gst_tensor_alloc_get_stats (NULL);
+}
+
+/**
+ * @brief Test for tensor allocator (memory of the NUMA node).
+ */
+TEST (commonTensorAllocator, numaNode)
+{
+  GstTensorAllocatorStats stats1, stats2;
+  GstMemory *mem;
+  GstMapInfo map;
+  gpointer data;
+
+  gst_tensor_alloc_init_full (0, TRUE, FALSE);
+  gst_tensor_alloc_set_thread_node (0);
+
+  mem = gst_allocator_alloc (NULL, 5000, NULL);
+  ASSERT_TRUE (mem != NULL);
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_WRITE));
+  data = map.data;
+  memset (map.data, 0xCD, map.size);
+  gst_memory_unmap (mem, &map);
+  gst_memory_unref (mem);
+
+  /* the memory of the node is reused in the thread of the same node */
+  gst_tensor_alloc_get_stats (&stats1);
+  mem = gst_allocator_alloc (NULL, 5000, NULL);
+  ASSERT_TRUE (mem != NULL);
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+  EXPECT_EQ (map.data, (guint8 *) data);
+  gst_memory_unmap (mem, &map);
+  gst_memory_unref (mem);
+
+  gst_tensor_alloc_get_stats (&stats2);
+  EXPECT_EQ (stats2.hits, stats1.hits + 1);
+
+  /* not bound to the node, the memory of the node is not used */
+  gst_tensor_alloc_set_thread_node (-1);
+  mem = gst_allocator_alloc (NULL, 5000, NULL);
+  ASSERT_TRUE (mem != NULL);
+  ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+  EXPECT_NE (map.data, (guint8 *) data);
+  gst_memory_unmap (mem, &map);
+  gst_memory_unref (mem);
+
+  gst_tensor_alloc_init_full (0, FALSE, FALSE);
+}
+
+/**
+ * @brief Test for the memory budget (pressure with the held bytes).
+ */
+TEST (commonTensorAllocator, memoryBudget)
+{
+  GstTensorAllocatorStats stats;
+  gint owner1, owner2;
+  GstAllocator *allocator;
+  gint pressure = -1;
+
+  EXPECT_EQ (gst_tensor_alloc_get_pressure (), GST_TENSOR_MEM_PRESSURE_NONE);
+
+  gst_tensor_alloc_set_watermarks (100000, 200000);
+  EXPECT_EQ (gst_tensor_alloc_get_pressure (), GST_TENSOR_MEM_PRESSURE_NONE);
+
+  gst_tensor_alloc_account (&owner1, 120000);
+  EXPECT_EQ (gst_tensor_alloc_get_held (&owner1), 120000ULL);
+  EXPECT_EQ (gst_tensor_alloc_get_pressure (), GST_TENSOR_MEM_PRESSURE_THROTTLE);
+
+  gst_tensor_alloc_account (&owner2, 100000);
+  EXPECT_EQ (gst_tensor_alloc_get_held (&owner2), 100000ULL);
+  EXPECT_EQ (gst_tensor_alloc_get_pressure (), GST_TENSOR_MEM_PRESSURE_DROP);
+
+  gst_tensor_alloc_get_stats (&stats);
+  EXPECT_GE (stats.held_bytes, 220000ULL);
+
+  /* the plugins not linked with nnstreamer use the property and signal */
+  allocator = gst_allocator_find ("GstTensorAllocator");
+  ASSERT_TRUE (allocator != NULL);
+  g_object_get (allocator, "pressure", &pressure, NULL);
+  EXPECT_EQ (pressure, (gint) GST_TENSOR_MEM_PRESSURE_DROP);
+  g_signal_emit_by_name (allocator, "account", &owner2, (gint64) -100000);
+  EXPECT_EQ (gst_tensor_alloc_get_held (&owner2), 0ULL);
+  gst_object_unref (allocator);
+
+  EXPECT_EQ (gst_tensor_alloc_get_pressure (), GST_TENSOR_MEM_PRESSURE_THROTTLE);
+
+  /* cannot release more than the owner holds */
+  gst_tensor_alloc_account (&owner1, -200000);
+  EXPECT_EQ (gst_tensor_alloc_get_held (&owner1), 0ULL);
+  EXPECT_EQ (gst_tensor_alloc_get_pressure (), GST_TENSOR_MEM_PRESSURE_NONE);
+
+  gst_tensor_alloc_set_watermarks (0, 0);
+  gst_tensor_alloc_init_full (0, FALSE, FALSE);
+}
+
+/**
+ * @brief Test for the memory budget (the memory in use of the allocator).
+ */
+TEST (commonTensorAllocator, memoryBudgetInUse)
+{
+  GstTensorAllocatorStats stats1, stats2;
+  GstMemory *mem;
+
+  gst_tensor_alloc_set_watermarks (0, 4096);
+  gst_tensor_alloc_get_stats (&stats1);
+
+  mem = gst_allocator_alloc (NULL, 8192, NULL);
+  ASSERT_TRUE (mem != NULL);
+
+  gst_tensor_alloc_get_stats (&stats2);
+  EXPECT_GE (stats2.in_use_bytes, stats1.in_use_bytes + 8192);
+  EXPECT_EQ (gst_tensor_alloc_get_pressure (), GST_TENSOR_MEM_PRESSURE_DROP);
+
+  gst_memory_unref (mem);
+
+  gst_tensor_alloc_get_stats (&stats2);
+  EXPECT_EQ (stats2.in_use_bytes, stats1.in_use_bytes);
+
+  gst_tensor_alloc_set_watermarks (0, 0);
+  gst_tensor_alloc_init_full (0, FALSE, FALSE);
+}
+
+/**
+ * @brief Test for the memory budget (invalid param).
+ */
+TEST (commonTensorAllocator, memoryBudgetInvalidParam_n)
+{
+  /* do not crash with null owner */
+  gst_tensor_alloc_account (NULL, 100);
+  EXPECT_EQ (gst_tensor_alloc_get_held (NULL), 0ULL);
+}
+
+/**
+ * @brief Test for the output pool of the sub-plugins.
+ */
+TEST (commonFilterOutputPool, reuse)
+{
+  GstTensorFilterOutputPool *pool;
+  void *data1, *data2, *data3;
+
+  pool = gst_tensor_filter_output_pool_new (1);
+  ASSERT_TRUE (pool != NULL);
+
+  data1 = gst_tensor_filter_output_pool_alloc (pool, 100);
+  data2 = gst_tensor_filter_output_pool_alloc (pool, 100);
+  ASSERT_TRUE (data1 != NULL);
+  ASSERT_TRUE (data2 != NULL);
+  EXPECT_NE (data1, data2);
+
+  /* the released memory of the same size is reused */
+  EXPECT_EQ (gst_tensor_filter_output_pool_release (pool, data1), 0);
+  data3 = gst_tensor_filter_output_pool_alloc (pool, 100);
+  EXPECT_EQ (data3, data1);
+
+  /* max 1 chunk is cached, the other one is freed */
+  EXPECT_EQ (gst_tensor_filter_output_pool_release (pool, data2), 0);
+  EXPECT_EQ (gst_tensor_filter_output_pool_release (pool, data3), 0);
+
+  /* different size */
+  data1 = gst_tensor_filter_output_pool_alloc (pool, 200);
+  ASSERT_TRUE (data1 != NULL);
+
+  /* the outstanding memory is freed after the pool is freed */
+  gst_tensor_filter_output_pool_free (pool);
+  EXPECT_EQ (gst_tensor_filter_output_pool_release (pool, data1), 0);
+}
+
+/**
+ * @brief Test for the output pool of the sub-plugins (not from the pool).
+ */
+TEST (commonFilterOutputPool, releaseUnknown_n)
+{
+  GstTensorFilterOutputPool *pool;
+  void *data;
+
+  pool = gst_tensor_filter_output_pool_new (4);
+  data = g_malloc (10);
+
+  EXPECT_EQ (gst_tensor_filter_output_pool_release (pool, data), -ENOENT);
+  EXPECT_EQ (gst_tensor_filter_output_pool_release (NULL, data), -EINVAL);
+  EXPECT_TRUE (gst_tensor_filter_output_pool_alloc (pool, 0) == NULL);
+
+  g_free (data);
+  gst_tensor_filter_output_pool_free (pool);
+}
+
+/**
+ * @brief Test for the counters of the copy, allocation and compute time of the element.
+ */
+TEST (commonElementProfile, counters)
+{
+  GstElement *element;
+  GstTensorElementProfile profile;
+  guint8 src[16] = { 1, 2, 3 }, dst[16] = { 0 };
+  nns_profile_declare (start);
+
+  element = gst_element_factory_make ("fakesink", NULL);
+  ASSERT_TRUE (element != NULL);
+
+  /* nothing counted yet */
+  EXPECT_FALSE (gst_tensor_element_get_profile (element, &profile));
+  EXPECT_EQ (profile.memcpy_bytes, 0U);
+
+  gst_tensor_element_profile_add (element, GST_TENSOR_PROFILE_MEMCPY, 16);
+  gst_tensor_element_profile_add (element, GST_TENSOR_PROFILE_MEMCPY, 4);
+  gst_tensor_element_profile_add (element, GST_TENSOR_PROFILE_ALLOC, 100);
+  gst_tensor_element_profile_add (element, GST_TENSOR_PROFILE_COMPUTE, 1000);
+
+  EXPECT_TRUE (gst_tensor_element_get_profile (element, &profile));
+  EXPECT_EQ (profile.memcpy_bytes, 20U);
+  EXPECT_EQ (profile.memcpy_count, 2U);
+  EXPECT_EQ (profile.alloc_bytes, 100U);
+  EXPECT_EQ (profile.alloc_count, 1U);
+  EXPECT_EQ (profile.compute_ns, 1000U);
+  EXPECT_EQ (profile.compute_count, 1U);
+
+  gst_tensor_element_reset_profile (element);
+  EXPECT_TRUE (gst_tensor_element_get_profile (element, &profile));
+  EXPECT_EQ (profile.memcpy_bytes, 0U);
+  EXPECT_EQ (profile.compute_count, 0U);
+
+  /* the macros are compiled out without -Denable-element-profile=true */
+  nns_profile_compute_begin (start);
+  nns_profile_memcpy (element, dst, src, sizeof (src));
+  nns_profile_alloc (element, 8);
+  nns_profile_compute_end (element, start);
+  EXPECT_EQ (memcmp (dst, src, sizeof (src)), 0);
+
+  EXPECT_TRUE (gst_tensor_element_get_profile (element, &profile));
+  if (gst_tensor_element_profile_is_enabled ()) {
+    EXPECT_EQ (profile.memcpy_bytes, sizeof (src));
+    EXPECT_EQ (profile.alloc_bytes, 8U);
+    EXPECT_EQ (profile.compute_count, 1U);
+  } else {
+    EXPECT_EQ (profile.memcpy_bytes, 0U);
+    EXPECT_EQ (profile.alloc_bytes, 0U);
+    EXPECT_EQ (profile.compute_count, 0U);
+  }
+
+  gst_object_unref (element);
+}
+
+/**
+ * @brief Test for the counters of the element with invalid param.
+ */
+TEST (commonElementProfile, invalidParam_n)
+{
+  GstTensorElementProfile profile;
+  GstElement *element;
+
+  EXPECT_FALSE (gst_tensor_element_get_profile (NULL, &profile));
+
+  element = gst_element_factory_make ("fakesink", NULL);
+  ASSERT_TRUE (element != NULL);
+  EXPECT_FALSE (gst_tensor_element_get_profile (element, NULL));
+
+  /* ignored */
+  gst_tensor_element_profile_add (NULL, GST_TENSOR_PROFILE_MEMCPY, 16);
+  gst_tensor_element_reset_profile (element);
+  EXPECT_FALSE (gst_tensor_element_get_profile (element, &profile));
+
+  gst_object_unref (element);
+}
+
+/**
+ * @brief Test for the model map of the sub-plugins.
+ */
+TEST (commonFilterModelMap, shared)
+{
+  GstTensorFilterModelMap *map1, *map2;
+  const gchar contents[] = "nnstreamer model map";
+  gchar *path;
+  const void *data;
+  size_t size = 0;
+
+  path = g_build_filename (g_get_tmp_dir (), "nns_model_map_test.bin", NULL);
+  ASSERT_TRUE (g_file_set_contents (path, contents, sizeof (contents), NULL));
+
+  map1 = gst_tensor_filter_model_map_open (path, GST_TENSOR_FILTER_MODEL_MAP_POPULATE);
+  ASSERT_TRUE (map1 != NULL);
+  data = gst_tensor_filter_model_map_get_data (map1, &size);
+  ASSERT_TRUE (data != NULL);
+  EXPECT_EQ (size, sizeof (contents));
+  EXPECT_EQ (memcmp (data, contents, size), 0);
+
+  /* the same file is mapped once in the process */
+  map2 = gst_tensor_filter_model_map_open (path, GST_TENSOR_FILTER_MODEL_MAP_PRELOAD);
+  EXPECT_EQ (map1, map2);
+  EXPECT_EQ (gst_tensor_filter_model_map_get_data (map2, NULL), data);
+
+  gst_tensor_filter_model_map_close (map1);
+  EXPECT_EQ (memcmp (gst_tensor_filter_model_map_get_data (map2, NULL), contents, size), 0);
+  gst_tensor_filter_model_map_close (map2);
+
+  g_remove (path);
+  g_free (path);
+}
+
+/**
+ * @brief Test for the model map of the sub-plugins with invalid param.
+ */
+TEST (commonFilterModelMap, invalidParam_n)
+{
+  gchar *path;
+
+  path = g_build_filename (g_get_tmp_dir (), "nns_model_map_not_exist.bin", NULL);
+  EXPECT_TRUE (gst_tensor_filter_model_map_open (path, 0) == NULL);
+  EXPECT_TRUE (gst_tensor_filter_model_map_open (g_get_tmp_dir (), 0) == NULL);
+  EXPECT_TRUE (gst_tensor_filter_model_map_open (NULL, 0) == NULL);
+  EXPECT_TRUE (gst_tensor_filter_model_map_get_data (NULL, NULL) == NULL);
+  gst_tensor_filter_model_map_close (NULL);
+  g_free (path);
+}
+
+/**
+ * @brief Test for the tensor kernels, the kernels available in the CPU should get same results with the generic one.
+ */
+TEST (commonTensorKernels, compareWithGeneric)
+{
+  const GstTensorKernels *generic = gst_tensor_kernels_lookup (NNS_CPU_FEATURE_NONE);
+  const guint candidates[] = { NNS_CPU_FEATURE_NEON, NNS_CPU_FEATURE_SSE4_1,
+    NNS_CPU_FEATURE_AVX2, NNS_CPU_FEATURE_AVX2 | NNS_CPU_FEATURE_AVX512F };
+  const gsize num = 1003;
+  guint features = cpu_get_features ();
+  guint8 *u8 = g_new (guint8, num);
+  gfloat *f32 = g_new (gfloat, num);
+  gfloat *out1 = g_new (gfloat, num);
+  gfloat *out2 = g_new (gfloat, num);
+  gfloat *scale = g_new (gfloat, num);
+  gfloat *zp = g_new (gfloat, num);
+  guint8 *q1 = g_new (guint8, num);
+  guint8 *q2 = g_new (guint8, num);
+  const gfloat yuv_coef[] = { 1.164f, 16.0f, 1.596f, 0.392f, 0.813f, 2.017f };
+  GstTensorKernelSummary s1, s2;
+  gfloat max1, max2;
+  gsize i, c, n;
+
+  EXPECT_STREQ (generic->name, "generic");
+  ASSERT_TRUE (gst_tensor_kernels_get () != NULL);
+
+  for (i = 0; i < num; i++) {
+    u8[i] = (guint8) (i * 7);
+    f32[i] = (gfloat) ((i * 37) % 101) - 50.5f;
+    scale[i] = (i % 2) ? 2.0f : 0.5f;
+    zp[i] = (gfloat) (i % 5) - 2.0f;
+  }
+  f32[10] = NAN;
+  f32[500] = INFINITY;
+  f32[501] = -INFINITY;
+  f32[777] = 60.0f;
+  f32[900] = 60.0f;
+
+  for (c = 0; c < G_N_ELEMENTS (candidates); c++) {
+    const GstTensorKernels *k;
+
+    if ((features & candidates[c]) != candidates[c])
+      continue;
+
+    k = gst_tensor_kernels_lookup (candidates[c]);
+
+    /* the lengths for the remainders of each vector size */
+    for (n = num - 17; n <= num; n++) {
+      generic->u8_to_f32 (u8, out1, n);
+      k->u8_to_f32 (u8, out2, n);
+      EXPECT_EQ (memcmp (out1, out2, n * sizeof (gfloat)), 0);
+
+      EXPECT_FLOAT_EQ (k->f32_max (f32, n), generic->f32_max (f32, n));
+      EXPECT_EQ (k->f32_argmax (f32, n, &max2), generic->f32_argmax (f32, n, &max1));
+      EXPECT_FLOAT_EQ (max1, max2);
+
+      generic->f32_summary (f32, n, &s1);
+      k->f32_summary (f32, n, &s2);
+      EXPECT_FLOAT_EQ (s1.min, s2.min);
+      EXPECT_FLOAT_EQ (s1.max, s2.max);
+      EXPECT_NEAR (s1.sum, s2.sum, 1e-2);
+      EXPECT_EQ (s1.nan_count, s2.nan_count);
+      EXPECT_EQ (s1.inf_count, s2.inf_count);
+
+      EXPECT_EQ (k->u8_sad (u8, u8 + 17, n - 17), generic->u8_sad (u8, u8 + 17, n - 17));
+
+      generic->f32_quantize_s8 (f32, (gint8 *) q1, n, scale, zp);
+      k->f32_quantize_s8 (f32, (gint8 *) q2, n, scale, zp);
+      EXPECT_EQ (memcmp (q1, q2, n), 0);
+
+      generic->f32_quantize_u8 (f32, q1, n, scale, zp);
+      k->f32_quantize_u8 (f32, q2, n, scale, zp);
+      EXPECT_EQ (memcmp (q1, q2, n), 0);
+
+      generic->s8_dequantize ((const gint8 *) u8, out1, n, scale, zp);
+      k->s8_dequantize ((const gint8 *) u8, out2, n, scale, zp);
+      EXPECT_EQ (memcmp (out1, out2, n * sizeof (gfloat)), 0);
+
+      generic->u8_dequantize (u8, out1, n, scale, zp);
+      k->u8_dequantize (u8, out2, n, scale, zp);
+      EXPECT_EQ (memcmp (out1, out2, n * sizeof (gfloat)), 0);
+
+      /* I420 and NV12 rows of (n / 3) pixels */
+      for (i = 1; i <= 2; i++) {
+        gsize w = n / 3, x;
+
+        generic->yuv420_to_rgb_f32 (u8, q1, q1 + 1, i, out1, w, yuv_coef);
+        k->yuv420_to_rgb_f32 (u8, q1, q1 + 1, i, out2, w, yuv_coef);
+        for (x = 0; x < 3 * w; x++)
+          EXPECT_NEAR (out1[x], out2[x], 1e-3);
+      }
+
+      /* mono, stereo and 3 channels of the int16 samples */
+      for (i = 1; i <= 3; i++) {
+        gsize frames = n / 6;
+
+        generic->s16_deinterleave_f32 ((const gint16 *) u8, out1, frames, i, frames);
+        k->s16_deinterleave_f32 ((const gint16 *) u8, out2, frames, i, frames);
+        EXPECT_EQ (memcmp (out1, out2, i * frames * sizeof (gfloat)), 0);
+      }
+    }
+
+    EXPECT_EQ (k->f32_argmax (f32, num, &max2), 777U);
+    EXPECT_FLOAT_EQ (max2, 60.0f);
+
+    /* the sequential search does not update the max if the first one is NaN */
+    f32[0] = NAN;
+    EXPECT_EQ (k->f32_argmax (f32, num, &max2), 0U);
+    f32[0] = -50.5f;
+  }
+
+  g_free (u8);
+  g_free (f32);
+  g_free (out1);
+  g_free (out2);
+  g_free (scale);
+  g_free (zp);
+  g_free (q1);
+  g_free (q2);
+}
+
+/**
+ * @brief Test for the typed reductions of the tensor data.
+ */
+TEST (commonTensorData, reduceTyped)
+{
+  const gint16 s16[] = { 3, -7, 11, 4, -2, 11, 9, -7, 0, 1 };
+  const gfloat f32[] = { 1.5f, -2.0f, 7.25f, 0.5f, 7.25f, -3.0f };
+  tensor_data_s mins[2], maxs[2];
+  gdouble sums[2], *avg = NULL, *std = NULL;
+  gsize indices[2];
+  tensor_dim dim = { 2, 5, 1, 1 };
+  gint16 v;
+  gfloat f;
+
+  /* whole tensor */
+  EXPECT_TRUE (gst_tensor_data_raw_sum (s16, sizeof (s16), _NNS_INT16, 1, sums));
+  EXPECT_DOUBLE_EQ (sums[0], 23.0);
+
+  EXPECT_TRUE (gst_tensor_data_raw_min_max (s16, sizeof (s16), _NNS_INT16, 1, mins, maxs));
+  EXPECT_EQ (mins[0].type, _NNS_INT16);
+  gst_tensor_data_get (&mins[0], &v);
+  EXPECT_EQ (v, -7);
+  gst_tensor_data_get (&maxs[0], &v);
+  EXPECT_EQ (v, 11);
+
+  /* the first largest element */
+  EXPECT_TRUE (gst_tensor_data_raw_argmax (s16, sizeof (s16), _NNS_INT16, 1, indices));
+  EXPECT_EQ (indices[0], 2U);
+  EXPECT_TRUE (gst_tensor_data_raw_argmax (f32, sizeof (f32), _NNS_FLOAT32, 1, indices));
+  EXPECT_EQ (indices[0], 2U);
+
+  /* per channel (the first dim) */
+  EXPECT_TRUE (gst_tensor_data_raw_sum (s16, sizeof (s16), _NNS_INT16, 2, sums));
+  EXPECT_DOUBLE_EQ (sums[0], 21.0);
+  EXPECT_DOUBLE_EQ (sums[1], 2.0);
+
+  EXPECT_TRUE (gst_tensor_data_raw_min_max (s16, sizeof (s16), _NNS_INT16, 2, NULL, maxs));
+  gst_tensor_data_get (&maxs[0], &v);
+  EXPECT_EQ (v, 11);
+  gst_tensor_data_get (&maxs[1], &v);
+  EXPECT_EQ (v, 11);
+
+  EXPECT_TRUE (gst_tensor_data_raw_argmax (s16, sizeof (s16), _NNS_INT16, 2, indices));
+  EXPECT_EQ (indices[0], 1U);
+  EXPECT_EQ (indices[1], 2U);
+
+  EXPECT_TRUE (gst_tensor_data_raw_min_max (f32, sizeof (f32), _NNS_FLOAT32, 2, mins, NULL));
+  gst_tensor_data_get (&mins[0], &f);
+  EXPECT_FLOAT_EQ (f, 1.5f);
+  gst_tensor_data_get (&mins[1], &f);
+  EXPECT_FLOAT_EQ (f, -3.0f);
+
+  EXPECT_TRUE (gst_tensor_data_raw_argmax (f32, sizeof (f32), _NNS_FLOAT32, 2, indices));
+  EXPECT_EQ (indices[0], 1U);
+  EXPECT_EQ (indices[1], 1U);
+
+  /* average and standard deviation on top of the reductions */
+  EXPECT_TRUE (gst_tensor_data_raw_average_per_channel ((gpointer) s16,
+      sizeof (s16), _NNS_INT16, dim, &avg));
+  EXPECT_DOUBLE_EQ (avg[0], 4.2);
+  EXPECT_DOUBLE_EQ (avg[1], 0.4);
+
+  EXPECT_TRUE (gst_tensor_data_raw_std_per_channel ((gpointer) s16,
+      sizeof (s16), _NNS_INT16, dim, avg, &std));
+  EXPECT_NEAR (std[0], sqrt (25.36), 1e-9);
+  EXPECT_NEAR (std[1], sqrt (47.04), 1e-9);
+  g_free (avg);
+  g_free (std);
+
+  EXPECT_TRUE (gst_tensor_data_raw_average ((gpointer) s16, sizeof (s16), _NNS_INT16, &avg));
+  EXPECT_DOUBLE_EQ (avg[0], 2.3);
+  g_free (avg);
+}
+
+/**
+ * @brief Test for the typed reductions of the tensor data with invalid param.
+ */
+TEST (commonTensorData, reduceTyped_n)
+{
+  const gint16 s16[] = { 3, -7, 11, 4 };
+  tensor_data_s maxs[1];
+  gdouble sums[1];
+  gsize indices[1];
+
+  EXPECT_FALSE (gst_tensor_data_raw_sum (NULL, sizeof (s16), _NNS_INT16, 1, sums));
+  EXPECT_FALSE (gst_tensor_data_raw_sum (s16, sizeof (s16), _NNS_INT16, 0, sums));
+  EXPECT_FALSE (gst_tensor_data_raw_sum (s16, sizeof (s16), _NNS_END, 1, sums));
+  EXPECT_FALSE (gst_tensor_data_raw_sum (s16, 0, _NNS_INT16, 1, sums));
+  EXPECT_FALSE (gst_tensor_data_raw_min_max (s16, sizeof (s16), _NNS_INT16, 1, NULL, NULL));
+  EXPECT_FALSE (gst_tensor_data_raw_min_max (s16, sizeof (s16), _NNS_INT16, 8, NULL, maxs));
+  EXPECT_FALSE (gst_tensor_data_raw_argmax (s16, sizeof (s16), _NNS_INT16, 1, NULL));
+  EXPECT_FALSE (gst_tensor_data_raw_argmax (s16, 1, _NNS_INT16, 1, indices));
+}
+
 /**
  * @brief Main function for unit test.
  */
@@ -0,0 +1,29 @@
+#!/usr/bin/env python3
+
+##
+# SPDX-License-Identifier: LGPL-2.1-only
+#
+# Copyright (C) 2026 Samsung Electronics Co., Ltd.
+#
+# @file checkResult.py
+# @brief Compare the float32 features with the golden result within the tolerance
+# @author agent <agent@local>
+
+import sys
+import numpy as np
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        print("Wrong # of parameters")
+        exit(-1)
+
+    golden = np.fromfile(sys.argv[1], dtype=np.float32)
+    result = np.fromfile(sys.argv[2], dtype=np.float32)
+
+    if golden.size == 0 or golden.size != result.size:
+        print("The size is different: golden %d, result %d" % (golden.size, result.size))
+        exit(1)
+
+    # the FFT of float32 in the subplugin and float64 in numpy, compared in the log scale
+    exit(0 if np.allclose(golden, result, rtol=1e-3, atol=1e-2) else 1)
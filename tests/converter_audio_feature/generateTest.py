@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+
+##
+# SPDX-License-Identifier: LGPL-2.1-only
+#
+# Copyright (C) 2026 Samsung Electronics Co., Ltd.
+#
+# @file generateTest.py
+# @brief Generate the audio and golden test results for the audio_feature converter subplugin
+# @author agent <agent@local>
+
+import numpy as np
+
+RATE = 16000
+N_FFT = 256
+HOP = 128
+N_MELS = 20
+N_MFCC = 8
+FRAMES = 4
+
+
+def hz_to_mel(hz):
+    return 2595.0 * np.log10(1.0 + hz / 700.0)
+
+
+def mel_to_hz(mel):
+    return 700.0 * (10.0 ** (mel / 2595.0) - 1.0)
+
+
+def mel_filterbank():
+    pts = mel_to_hz(np.linspace(hz_to_mel(0.0), hz_to_mel(RATE / 2.0), N_MELS + 2))
+    freqs = np.arange(N_FFT // 2 + 1) * RATE / N_FFT
+    fb = np.zeros([N_MELS, N_FFT // 2 + 1])
+    for m in range(N_MELS):
+        lo, mid, hi = pts[m], pts[m + 1], pts[m + 2]
+        up = (freqs > lo) & (freqs < mid)
+        down = (freqs >= mid) & (freqs < hi)
+        fb[m, up] = (freqs[up] - lo) / (mid - lo)
+        fb[m, down] = (hi - freqs[down]) / (hi - mid)
+    return fb
+
+
+def features(pcm, mfcc):
+    window = 0.5 - 0.5 * np.cos(2.0 * np.pi * np.arange(N_FFT) / N_FFT)
+    fb = mel_filterbank()
+    num = (len(pcm) - N_FFT) // HOP + 1
+    frames = np.stack([pcm[i * HOP:i * HOP + N_FFT] * window for i in range(num)])
+    power = np.abs(np.fft.rfft(frames, axis=1)) ** 2
+    logmel = np.log(np.maximum(power @ fb.T, 1e-10))
+    if not mfcc:
+        return logmel
+    j = np.arange(N_MELS)
+    dct = np.stack([np.sqrt((1.0 if i == 0 else 2.0) / N_MELS) *
+                    np.cos(np.pi * i * (j + 0.5) / N_MELS) for i in range(N_MFCC)])
+    return logmel @ dct.T
+
+
+def save_tensors(filename, feat):
+    # the tensor of FRAMES x channels, n-feat:frames:channels
+    num = feat.shape[1] // FRAMES
+    feat = feat[:, :num * FRAMES, :].reshape(feat.shape[0], num, FRAMES, -1)
+    with open(filename, 'wb') as file:
+        file.write(feat.transpose(1, 0, 2, 3).astype(np.float32).tobytes())
+
+
+t = np.arange(RATE // 2) / RATE
+left = 0.5 * np.sin(2.0 * np.pi * 440.0 * t)
+right = 0.3 * np.sin(2.0 * np.pi * 1500.0 * t) + 0.05 * np.random.randn(len(t))
+samples = np.clip(np.stack([left, right], axis=1) * 32767, -32768, 32767).astype(np.int16)
+
+with open('test_00.raw', 'wb') as file:
+    file.write(samples.astype('<i2').tobytes())
+
+pcm = samples.astype(np.float32) / 32768.0
+
+# raw, planar samples of a buffer
+with open('test_00.golden', 'wb') as file:
+    file.write(pcm.T.astype(np.float32).tobytes())
+
+# raw, 1000 samples in a tensor
+with open('test_01.golden', 'wb') as file:
+    file.write(pcm.reshape(-1, 1000, 2).transpose(0, 2, 1).astype(np.float32).tobytes())
+
+save_tensors('test_02.golden', np.stack([features(pcm[:, c], False) for c in range(2)]))
+save_tensors('test_03.golden', np.stack([features(pcm[:, c], True) for c in range(2)]))
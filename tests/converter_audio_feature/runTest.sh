@@ -0,0 +1,76 @@
+#!/usr/bin/env bash
+##
+## SPDX-License-Identifier: LGPL-2.1-only
+##
+## @file runTest.sh
+## @author agent <agent@local>
+## @date 14 Oct 2026
+## @brief SSAT Test Cases for the audio_feature converter subplugin
+##
+
+if [[ "$SSATAPILOADED" != "1" ]]; then
+    SILENT=0
+    INDEPENDENT=1
+    search="ssat-api.sh"
+    source $search
+    printf "${Blue}Independent Mode${NC}"
+fi
+
+# This is compatible with SSAT (https://github.com/myungjoo/SSAT)
+testInit $1
+
+PATH_TO_PLUGIN="../../build"
+
+if [[ -d $PATH_TO_PLUGIN ]]; then
+    ini_path="${PATH_TO_PLUGIN}/ext/nnstreamer/tensor_converter"
+    if [[ -d ${ini_path} ]]; then
+        check=$(ls ${ini_path} | grep audio_feature.so)
+        if [[ ! $check ]]; then
+            echo "Cannot find audio_feature shared lib"
+            report
+            exit
+        fi
+    else
+        echo "Cannot find ${ini_path}"
+    fi
+else
+    echo "No build directory"
+    report
+    exit
+fi
+
+if [ "$SKIPGEN" == "YES" ]; then
+    echo "Test Case Generation Skipped"
+    sopath=$2
+else
+    echo "Test Case Generation Started"
+    python3 generateTest.py
+    sopath=$1
+fi
+
+CAPS="audio/x-raw,format=S16LE,rate=16000,channels=2,layout=interleaved"
+
+# Deinterleave each incoming buffer
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=\"test_00.raw\" blocksize=-1 ! ${CAPS} ! tensor_converter mode=\"custom-script:audio_feature:channels=2\" ! filesink location=\"./result_00.dat\" sync=true" 1 0 0 $PERFORMANCE
+callCompareTest result_00.dat test_00.golden 1 "Golden test comparison 1" 1 0
+
+# The tensor of 1000 samples from the buffers of 750 samples
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=\"test_00.raw\" blocksize=3000 ! ${CAPS} ! tensor_converter mode=\"custom-script:audio_feature:channels=2,frames=1000\" ! filesink location=\"./result_01.dat\" sync=true" 2 0 0 $PERFORMANCE
+callCompareTest result_01.dat test_01.golden 2 "Golden test comparison 2" 1 0
+
+# Log-mel spectrogram, 4 STFT frames in a tensor
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=\"test_00.raw\" blocksize=1236 ! ${CAPS} ! tensor_converter mode=\"custom-script:audio_feature:channels=2,feature=logmel,n-fft=256,hop=128,n-mels=20,frames=4\" ! filesink location=\"./result_02.dat\" sync=true" 3 0 0 $PERFORMANCE
+python3 checkResult.py test_02.golden result_02.dat
+testResult $? 3 "Golden test comparison 3" 0 1
+
+# MFCC
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=\"test_00.raw\" blocksize=-1 ! ${CAPS} ! tensor_converter mode=\"custom-script:audio_feature:channels=2,feature=mfcc,n-fft=256,hop=128,n-mels=20,n-mfcc=8,frames=4\" ! filesink location=\"./result_03.dat\" sync=true" 4 0 0 $PERFORMANCE
+python3 checkResult.py test_03.golden result_03.dat
+testResult $? 4 "Golden test comparison 4" 0 1
+
+# The size of the FFT should be a power of 2
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=\"test_00.raw\" blocksize=-1 ! ${CAPS} ! tensor_converter mode=\"custom-script:audio_feature:channels=2,feature=logmel,n-fft=300\" ! filesink location=\"./result_04.dat\" sync=true" 5F_n 0 1 $PERFORMANCE
+
+rm *.raw *.dat *.golden
+
+report
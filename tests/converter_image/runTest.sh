@@ -0,0 +1,77 @@
+#!/usr/bin/env bash
+##
+## SPDX-License-Identifier: LGPL-2.1-only
+##
+## @file runTest.sh
+## @author agent <agent@local>
+## @date 14 Oct 2026
+## @brief SSAT Test Cases for the image converter subplugin
+##
+
+if [[ "$SSATAPILOADED" != "1" ]]; then
+    SILENT=0
+    INDEPENDENT=1
+    search="ssat-api.sh"
+    source $search
+    printf "${Blue}Independent Mode${NC}"
+fi
+
+# This is compatible with SSAT (https://github.com/myungjoo/SSAT)
+testInit $1
+
+PATH_TO_PLUGIN="../../build"
+
+if [[ -d $PATH_TO_PLUGIN ]]; then
+    ini_path="${PATH_TO_PLUGIN}/ext/nnstreamer/tensor_converter"
+    if [[ -d ${ini_path} ]]; then
+        check=$(ls ${ini_path} | grep converter_image.so)
+        if [[ ! $check ]]; then
+            echo "Cannot find image shared lib"
+            report
+            exit
+        fi
+    else
+        echo "Cannot find ${ini_path}"
+    fi
+else
+    echo "No build directory"
+    report
+    exit
+fi
+
+# Check the size of the output
+function checkSize() {
+    size=$(stat -c %s $1)
+    [[ "$size" == "$2" ]]
+    testResult $? $3 "$4" 0 1
+}
+
+# Generate the test images
+gst-launch-1.0 -q videotestsrc num-buffers=1 pattern=13 ! video/x-raw,format=RGB,width=640,height=480 ! pngenc ! filesink location=test_00.png
+gst-launch-1.0 -q videotestsrc num-buffers=1 pattern=13 ! video/x-raw,format=GRAY8,width=640,height=480 ! jpegenc ! filesink location=test_01.jpg
+gst-launch-1.0 -q videotestsrc num-buffers=1 pattern=13 ! video/x-raw,format=I420,width=640,height=480 ! jpegenc ! filesink location=test_02.jpg
+
+# PNG in the original size, compared with pngdec
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=test_00.png blocksize=-1 ! pngdec ! videoconvert ! video/x-raw,format=RGB ! tensor_converter ! filesink location=test_00.golden" 1-1 0 0 $PERFORMANCE
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=test_00.png blocksize=-1 ! image/png ! tensor_converter ! filesink location=result_00.dat" 1-2 0 0 $PERFORMANCE
+callCompareTest result_00.dat test_00.golden 1 "Golden test comparison 1" 1 0
+
+# Gray JPEG in the original size, compared with jpegdec
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=test_01.jpg blocksize=-1 ! jpegdec idct-method=islow ! video/x-raw,format=GRAY8 ! tensor_converter ! filesink location=test_01.golden" 2-1 0 0 $PERFORMANCE
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=test_01.jpg blocksize=-1 ! image/jpeg ! tensor_converter ! filesink location=result_01.dat" 2-2 0 0 $PERFORMANCE
+callCompareTest result_01.dat test_01.golden 2 "Golden test comparison 2" 1 0
+
+# JPEG decoded in 1/8 (80x60) with the scaled IDCT
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=test_02.jpg blocksize=-1 ! image/jpeg ! tensor_converter mode=\"custom-script:image:width=80,height=60\" ! filesink location=result_02.dat" 3-1 0 0 $PERFORMANCE
+checkSize result_02.dat 14400 3 "Output size of the scaled JPEG"
+
+# JPEG decoded in 1/2 and resized to the normalized float32 tensor
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=test_02.jpg blocksize=-1 ! image/jpeg ! tensor_converter mode=\"custom-script:image:width=224,height=224,type=float32,mean=127.5,std=127.5\" ! filesink location=result_03.dat" 4-1 0 0 $PERFORMANCE
+checkSize result_03.dat 602112 4 "Output size of the float32 tensor"
+
+# Invalid option
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=test_02.jpg blocksize=-1 ! image/jpeg ! tensor_converter mode=\"custom-script:image:width=invalid\" ! filesink location=result_04.dat" 5F_n 0 1 $PERFORMANCE
+
+rm *.png *.jpg *.dat *.golden
+
+report
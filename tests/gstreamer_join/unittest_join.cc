@@ -147,6 +147,98 @@ TEST (join, normal0)
   gst_object_unref (pipeline);
 }
 
+/**
+ * @brief Test join element with the latency policy
+ */
+TEST (join, policyLatency)
+{
+  gint idx;
+  guint stall_timeout;
+  gint policy;
+  GstBuffer *buf_0, *buf_1, *buf_2, *buf_3;
+  GstElement *appsrc_handle_0, *appsrc_handle_1, *sink_handle, *join_handle;
+  GstPad *active_pad;
+  gchar *active_name;
+
+  gchar *str_pipeline = g_strdup (
+      "appsrc name=appsrc_0 format=time ! other/tensor,dimension=(string)3:4:2:2,type=(string)int32,framerate=(fraction)0/1 ! join.sink_0 "
+      "appsrc name=appsrc_1 format=time ! other/tensor,dimension=(string)3:4:2:2,type=(string)int32,framerate=(fraction)0/1 ! join.sink_1 "
+      "join name=join policy=latency stall-timeout=50 ! other/tensor,dimension=(string)3:4:2:2, type=(string)int32, framerate=(fraction)0/1 ! "
+      "tensor_sink name=sinkx async=false");
+
+  GstElement *pipeline = gst_parse_launch (str_pipeline, NULL);
+  g_free (str_pipeline);
+  ASSERT_NE (pipeline, nullptr);
+
+  join_handle = gst_bin_get_by_name (GST_BIN (pipeline), "join");
+  ASSERT_NE (join_handle, nullptr);
+
+  g_object_get (join_handle, "policy", &policy, "stall-timeout", &stall_timeout, NULL);
+  EXPECT_EQ (1, policy);
+  EXPECT_EQ (50U, stall_timeout);
+
+  appsrc_handle_0 = gst_bin_get_by_name (GST_BIN (pipeline), "appsrc_0");
+  EXPECT_NE (appsrc_handle_0, nullptr);
+
+  appsrc_handle_1 = gst_bin_get_by_name (GST_BIN (pipeline), "appsrc_1");
+  EXPECT_NE (appsrc_handle_1, nullptr);
+
+  sink_handle = gst_bin_get_by_name (GST_BIN (pipeline), "sinkx");
+  EXPECT_NE (sink_handle, nullptr);
+
+  g_signal_connect (sink_handle, "new-data", (GCallback)new_data_cb, (gpointer)&idx);
+
+  /* The same frames (PTS) from two redundant streams */
+  buf_0 = gst_buffer_new_wrapped (_g_memdup (test_frames[0], 192), 192);
+  GST_BUFFER_PTS (buf_0) = 0;
+  buf_1 = gst_buffer_copy (buf_0);
+
+  buf_2 = gst_buffer_new_wrapped (_g_memdup (test_frames[1], 192), 192);
+  GST_BUFFER_PTS (buf_2) = 10 * GST_MSECOND;
+  buf_3 = gst_buffer_copy (buf_2);
+
+  data_received = 0;
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (100000);
+
+  idx = 0;
+  EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (appsrc_handle_0), buf_0), GST_FLOW_OK);
+  g_usleep (100000);
+
+  /* Late duplicate, should be dropped */
+  idx = 100;
+  EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (appsrc_handle_1), buf_1), GST_FLOW_OK);
+  g_usleep (100000);
+
+  /* sink_0 stalls longer than stall-timeout, switch to sink_1 */
+  idx = 1;
+  EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (appsrc_handle_1), buf_2), GST_FLOW_OK);
+  g_usleep (100000);
+
+  g_object_get (join_handle, "active-pad", &active_pad, NULL);
+  EXPECT_NE (nullptr, active_pad);
+  active_name = gst_pad_get_name (active_pad);
+  EXPECT_STREQ ("sink_1", active_name);
+  gst_object_unref (active_pad);
+  g_free (active_name);
+
+  /* Late duplicate, should be dropped */
+  idx = 100;
+  EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (appsrc_handle_0), buf_3), GST_FLOW_OK);
+  g_usleep (100000);
+
+  gst_object_unref (sink_handle);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (100000);
+  EXPECT_EQ (2, data_received);
+
+  gst_object_unref (appsrc_handle_0);
+  gst_object_unref (appsrc_handle_1);
+  gst_object_unref (join_handle);
+  gst_object_unref (pipeline);
+}
+
 /**
  * @brief Test get property with invalid parameter
  */
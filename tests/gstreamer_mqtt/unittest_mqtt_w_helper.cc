@@ -220,6 +220,7 @@ TEST (testMqttSink, sinkGetSetProperties)
   gboolean bprop;
   gint iprop;
   gulong ulprop;
+  guint uprop;
 
   ASSERT_TRUE (h != NULL);
   /** test the default */
@@ -283,6 +284,24 @@ TEST (testMqttSink, sinkGetSetProperties)
   EXPECT_STREQ (sprop, "time.google.com:123");
   g_free (sprop);
 
+  g_object_get (h->element, "max-batch", &uprop, NULL);
+  EXPECT_EQ (uprop, 1U);
+  g_object_set (h->element, "max-batch", 8U, NULL);
+  g_object_get (h->element, "max-batch", &uprop, NULL);
+  EXPECT_EQ (uprop, 8U);
+
+  g_object_get (h->element, "batch-timeout", &uprop, NULL);
+  EXPECT_EQ (uprop, 0U);
+  g_object_set (h->element, "batch-timeout", 50U, NULL);
+  g_object_get (h->element, "batch-timeout", &uprop, NULL);
+  EXPECT_EQ (uprop, 50U);
+
+  g_object_get (h->element, "compact-header", &bprop, NULL);
+  EXPECT_FALSE (bprop);
+  g_object_set (h->element, "compact-header", true, NULL);
+  g_object_get (h->element, "compact-header", &bprop, NULL);
+  EXPECT_TRUE (bprop);
+
   gst_harness_teardown (h);
 }
 
@@ -296,6 +315,8 @@ TEST (testMqttSrc, srcGetSetProperties)
   gboolean bprop;
   gint iprop;
   gint64 lprop;
+  guint uprop;
+  guint64 ulprop;
 
   ASSERT_TRUE (h != NULL);
 
@@ -347,6 +368,21 @@ TEST (testMqttSrc, srcGetSetProperties)
   g_object_get (h->element, "mqtt-qos", &iprop, NULL);
   EXPECT_TRUE (iprop == 1);
 
+  g_object_get (h->element, "max-queue-size", &uprop, NULL);
+  EXPECT_EQ (uprop, 0U);
+  g_object_set (h->element, "max-queue-size", 4U, NULL);
+  g_object_get (h->element, "max-queue-size", &uprop, NULL);
+  EXPECT_EQ (uprop, 4U);
+
+  g_object_get (h->element, "leaky", &iprop, NULL);
+  EXPECT_EQ (iprop, 2); /* downstream */
+  gst_util_set_object_arg (G_OBJECT (h->element), "leaky", "upstream");
+  g_object_get (h->element, "leaky", &iprop, NULL);
+  EXPECT_EQ (iprop, 1);
+
+  g_object_get (h->element, "num-dropped", &ulprop, NULL);
+  EXPECT_EQ (ulprop, 0ULL);
+
   gst_harness_teardown (h);
 }
 
@@ -649,7 +685,8 @@ TEST (testMqttSrcWithHelper, srcNormalLaunch0)
 
   ma_ret = std::async (std::launch::async,
       GstMqttTestHelper::getInstance ().getCbMessageArrived (),
-      GstMqttTestHelper::getInstance ().getContext (), topic_name, 0, msg);
+      GstMqttTestHelper::getInstance ().getContext (),
+      g_strdup (topic_name), 0, msg);
   EXPECT_TRUE (ma_ret.get ());
 
   ret = gst_element_get_state (pipeline, &cur_state, NULL, GST_CLOCK_TIME_NONE);
@@ -742,7 +779,8 @@ TEST (testMqttSrcWithHelper, srcNormalLaunch1)
 
   ma_ret = std::async (std::launch::async,
       GstMqttTestHelper::getInstance ().getCbMessageArrived (),
-      GstMqttTestHelper::getInstance ().getContext (), topic_name, 0, msg);
+      GstMqttTestHelper::getInstance ().getContext (),
+      g_strdup (topic_name), 0, msg);
   EXPECT_TRUE (ma_ret.get ());
 
   ret = gst_element_get_state (pipeline, &cur_state, NULL, GST_CLOCK_TIME_NONE);
@@ -758,7 +796,8 @@ TEST (testMqttSrcWithHelper, srcNormalLaunch1)
 
   ma_ret = std::async (std::launch::async,
       GstMqttTestHelper::getInstance ().getCbMessageArrived (),
-      GstMqttTestHelper::getInstance ().getContext (), topic_name, 0, msg);
+      GstMqttTestHelper::getInstance ().getContext (),
+      g_strdup (topic_name), 0, msg);
   EXPECT_TRUE (ma_ret.get ());
 
   ret = gst_element_set_state (pipeline, GST_STATE_NULL);
@@ -849,7 +888,8 @@ TEST (testMqttSrcWithHelper, srcNormalLaunch0_n)
 
   ma_ret = std::async (std::launch::async,
       GstMqttTestHelper::getInstance ().getCbMessageArrived (),
-      GstMqttTestHelper::getInstance ().getContext (), topic_name, 0, msg);
+      GstMqttTestHelper::getInstance ().getContext (),
+      g_strdup (topic_name), 0, msg);
   EXPECT_TRUE (ma_ret.get ());
 
   ret = gst_element_get_state (pipeline, &cur_state, NULL, GST_CLOCK_TIME_NONE);
@@ -945,7 +985,8 @@ TEST (testMqttSrcWithHelper, srcNormalLaunch1_n)
 
   ma_ret = std::async (std::launch::async,
       GstMqttTestHelper::getInstance ().getCbMessageArrived (),
-      GstMqttTestHelper::getInstance ().getContext (), topic_name, 0, msg);
+      GstMqttTestHelper::getInstance ().getContext (),
+      g_strdup (topic_name), 0, msg);
   EXPECT_TRUE (ma_ret.get ());
 
   ret = gst_element_get_state (pipeline, &cur_state, NULL, GST_CLOCK_TIME_NONE);
@@ -1042,7 +1083,8 @@ TEST (testMqttSrcWithHelper, srcNormalLaunch2)
 
   ma_ret = std::async (std::launch::async,
       GstMqttTestHelper::getInstance ().getCbMessageArrived (),
-      GstMqttTestHelper::getInstance ().getContext (), topic_name, 0, msg);
+      GstMqttTestHelper::getInstance ().getContext (),
+      g_strdup (topic_name), 0, msg);
   EXPECT_TRUE (ma_ret.get ());
 
   ret = gst_element_get_state (pipeline, &cur_state, NULL, GST_CLOCK_TIME_NONE);
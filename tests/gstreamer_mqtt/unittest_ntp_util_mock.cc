@@ -286,6 +286,36 @@ TEST_F (ntpUtilMockTest, getEpochIvalidTimestamp)
   delete mockInstance;
 }
 
+/**
+ * @brief Test for ntp clock using the local time until the server responds.
+ */
+TEST_F (ntpUtilMockTest, clockNotSynced)
+{
+  ntputil_clock_t *clk;
+  int64_t before, epoch, next;
+
+  mockInstance = new NtpUtilMock ();
+
+  EXPECT_CALL (*mockInstance, gethostbyname(_))
+      .WillRepeatedly(DoAll(
+        testing::Assign(&h_errno, HOST_NOT_FOUND),
+        Return (nullptr)));
+
+  before = g_get_real_time ();
+  clk = ntputil_clock_new (0, nullptr, nullptr, 1);
+  ASSERT_TRUE (clk != nullptr);
+
+  epoch = ntputil_clock_get_epoch (clk);
+  EXPECT_GE (epoch, before);
+  EXPECT_LE (epoch, g_get_real_time ());
+
+  next = ntputil_clock_get_epoch (clk);
+  EXPECT_GE (next, epoch);
+
+  ntputil_clock_free (clk);
+  delete mockInstance;
+}
+
 /**
  * @brief Main GTest
  */
@@ -0,0 +1,509 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ *
+ * @file	benchmark_elements.c
+ * @date	14 Oct 2026
+ * @brief	Throughput benchmark of the core nnstreamer elements
+ * @see		http://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ *
+ * Each case runs a fixed pipeline (appsrc ! element ! fakesink) with
+ * synthetic tensors of the given dimension and type, and prints a line of
+ * JSON object with frames/sec, ns/byte, the latency percentiles, the RSS and
+ * the allocations per frame, along with the commit, host and CPU features.
+ * The latency of a frame is the time from pushing it into appsrc to its
+ * arrival at fakesink, including the wait in the queue of appsrc.
+ * The allocations are the memory blocks allocated with the default
+ * allocator while the measured frames are processed; the frames from appsrc
+ * wrap a pre-allocated data, so the source itself does not allocate.
+ *
+ * $ meson test -C build --benchmark
+ * $ ./build/tests/benchmark_elements --frames=1000 --filter=transform
+ *
+ * The results are appended to the file given by NNSTREAMER_PERF_REPORT as
+ * well, with the results of the other performance tests.
+ */
+
+#include <string.h>
+#include <glib.h>
+#include <gst/gst.h>
+#include <gst/app/gstappsrc.h>
+#include <nnstreamer_plugin_api.h>
+#include <tensor_filter_custom_easy.h>
+#include <unittest_util.h>
+
+/**
+ * @brief Timeout to wait for the end of a case (seconds).
+ */
+#define BENCH_TIMEOUT_SEC (120)
+
+/**
+ * @brief Allocator counting the allocations, the memory is allocated with the wrapped allocator.
+ */
+typedef struct
+{
+  GstAllocator parent;
+  GstAllocator *inner;
+  gsize allocs;
+} BenchAllocator;
+
+/**
+ * @brief Class of BenchAllocator.
+ */
+typedef struct
+{
+  GstAllocatorClass parent_class;
+} BenchAllocatorClass;
+
+G_DEFINE_TYPE (BenchAllocator, bench_allocator, GST_TYPE_ALLOCATOR);
+
+/**
+ * @brief Benchmark case.
+ */
+typedef struct
+{
+  const gchar *name; /**< the name of the case */
+  const gchar *pipeline; /**< the elements between appsrc and fakesink, NULL if it depends on the tensor */
+  gboolean octet; /**< TRUE to push octet stream instead of tensors */
+  gboolean uint8_only; /**< TRUE if the case supports uint8 tensors only */
+} BenchCase;
+
+/**
+ * @brief The state of a benchmark run, updated in the streaming thread.
+ */
+typedef struct
+{
+  BenchAllocator *allocator;
+  guint warmup;
+  guint frames;
+  gint received;
+  gint64 *push_times; /**< the time pushing each frame into appsrc */
+  GArray *latencies; /**< the latency of the measured frames (ms, gdouble) */
+  gint64 start_time;
+  gint64 end_time;
+  gsize start_allocs;
+  gsize end_allocs;
+} BenchRun;
+
+/**
+ * @brief The cases to run.
+ */
+static const BenchCase bench_cases[] = {
+  {"converter", NULL, TRUE, FALSE},
+  {"transform", "tensor_transform mode=arithmetic "
+        "option=typecast:float32,add:-127.5,div:127.5", FALSE, FALSE},
+  {"merge", "tee name=t t. ! queue ! m.sink_0 t. ! queue ! m.sink_1 "
+        "tensor_merge name=m mode=linear option=3 sync-mode=nosync", FALSE,
+        FALSE},
+  {"split", NULL, FALSE, FALSE},
+  {"decoder", "tensor_decoder mode=direct_video", FALSE, TRUE},
+  {"filter", NULL, FALSE, FALSE},
+};
+
+/**
+ * @brief The dimensions of the synthetic tensors (channel:width:height).
+ */
+static const gchar *bench_dims[] = {
+  "3:32:32:1", "3:224:224:1", "3:640:480:1",
+};
+
+/**
+ * @brief The types of the synthetic tensors.
+ */
+static const gchar *bench_types[] = {
+  "uint8", "float32",
+};
+
+static gint opt_frames = 500;
+static gint opt_warmup = 20;
+static gchar *opt_filter = NULL;
+static gchar *opt_output = NULL;
+
+/**
+ * @brief Command line options.
+ */
+static GOptionEntry bench_options[] = {
+  {"frames", 'n', 0, G_OPTION_ARG_INT, &opt_frames,
+      "The number of the measured frames in a case (default 500)", "N"},
+  {"warmup", 'w', 0, G_OPTION_ARG_INT, &opt_warmup,
+      "The number of the frames before measuring (default 20)", "N"},
+  {"filter", 'f', 0, G_OPTION_ARG_STRING, &opt_filter,
+      "Run the cases whose name contains the string", "NAME"},
+  {"output", 'o', 0, G_OPTION_ARG_FILENAME, &opt_output,
+      "Write the results to the file as well as stdout", "FILE"},
+  {NULL}
+};
+
+/**
+ * @brief Allocate the memory with the wrapped allocator.
+ */
+static GstMemory *
+bench_allocator_alloc (GstAllocator * allocator, gsize size,
+    GstAllocationParams * params)
+{
+  BenchAllocator *self = (BenchAllocator *) allocator;
+
+  g_atomic_pointer_add (&self->allocs, 1);
+  return gst_allocator_alloc (self->inner, size, params);
+}
+
+/**
+ * @brief Finalize BenchAllocator.
+ */
+static void
+bench_allocator_finalize (GObject * object)
+{
+  BenchAllocator *self = (BenchAllocator *) object;
+
+  if (self->inner)
+    gst_object_unref (self->inner);
+
+  G_OBJECT_CLASS (bench_allocator_parent_class)->finalize (object);
+}
+
+/**
+ * @brief Initialize the class of BenchAllocator.
+ */
+static void
+bench_allocator_class_init (BenchAllocatorClass * klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+  GstAllocatorClass *allocator_class = GST_ALLOCATOR_CLASS (klass);
+
+  object_class->finalize = bench_allocator_finalize;
+  allocator_class->alloc = bench_allocator_alloc;
+}
+
+/**
+ * @brief Initialize BenchAllocator.
+ */
+static void
+bench_allocator_init (BenchAllocator * self)
+{
+  self->inner = NULL;
+  self->allocs = 0;
+}
+
+/**
+ * @brief Get the number of the allocations.
+ */
+static gsize
+bench_allocator_get_count (BenchAllocator * self)
+{
+  return (gsize) g_atomic_pointer_get (&self->allocs);
+}
+
+/**
+ * @brief Custom-easy function to measure the overhead of tensor_filter. Output is allocated by the filter.
+ */
+static int
+bench_filter_invoke (void *data, const GstTensorFilterProperties * prop,
+    const GstTensorMemory * in, GstTensorMemory * out)
+{
+  (void) data;
+  (void) prop;
+  (void) in;
+  (void) out;
+
+  return 0;
+}
+
+/**
+ * @brief Callback of fakesink, records the time and allocations at the first and last measured frames.
+ */
+static void
+bench_handoff_cb (GstElement * sink, GstBuffer * buffer, GstPad * pad,
+    gpointer user_data)
+{
+  BenchRun *run = (BenchRun *) user_data;
+  guint received;
+
+  (void) sink;
+  (void) buffer;
+  (void) pad;
+
+  received = (guint) g_atomic_int_add (&run->received, 1) + 1;
+
+  if (received > run->warmup && received <= run->warmup + run->frames) {
+    gdouble latency = (g_get_monotonic_time () -
+        run->push_times[received - 1]) / 1000.0;
+
+    g_array_append_val (run->latencies, latency);
+  }
+
+  if (received == run->warmup) {
+    run->start_allocs = bench_allocator_get_count (run->allocator);
+    run->start_time = g_get_monotonic_time ();
+  } else if (received == run->warmup + run->frames) {
+    run->end_time = g_get_monotonic_time ();
+    run->end_allocs = bench_allocator_get_count (run->allocator);
+  }
+}
+
+/**
+ * @brief Get the description of the pipeline for the case.
+ */
+static gchar *
+bench_get_pipeline (const BenchCase * bc, const gchar * dim,
+    const gchar * type, const gchar * model, gsize size)
+{
+  gchar *caps, *element, *desc;
+
+  if (bc->octet) {
+    caps = g_strdup ("application/octet-stream,framerate=(fraction)0/1");
+  } else {
+    caps = g_strdup_printf ("other/tensors,num_tensors=1,format=static,"
+        "dimensions=(string)%s,types=(string)%s,framerate=(fraction)0/1",
+        dim, type);
+  }
+
+  if (g_str_equal (bc->name, "converter")) {
+    element = g_strdup_printf ("tensor_converter input-dim=%s input-type=%s",
+        dim, type);
+  } else if (g_str_equal (bc->name, "split")) {
+    /* split the channels into 1 and 2 */
+    gchar **d = g_strsplit (dim, ":", 2);
+
+    element = g_strdup_printf ("tensor_split name=s tensorseg=1:%s,2:%s "
+        "s.src_0 ! fakesink sync=false s.src_1", d[1], d[1]);
+    g_strfreev (d);
+  } else if (g_str_equal (bc->name, "filter")) {
+    element = g_strdup_printf ("tensor_filter framework=custom-easy model=%s",
+        model);
+  } else {
+    element = g_strdup (bc->pipeline);
+  }
+
+  desc = g_strdup_printf ("appsrc name=src caps=\"%s\" max-bytes=%zu block=true ! "
+      "%s ! fakesink name=sink sync=false signal-handoffs=true",
+      caps, size * 4, element);
+
+  g_free (caps);
+  g_free (element);
+  return desc;
+}
+
+/**
+ * @brief Run a benchmark case and print the result.
+ * @return TRUE if the case is successfully done.
+ */
+static gboolean
+bench_run_case (const BenchCase * bc, const gchar * dim, const gchar * type,
+    BenchAllocator * allocator, FILE * out)
+{
+  GstTensorsInfo info;
+  GstElement *pipeline, *src, *sink;
+  GstBus *bus;
+  GstMessage *msg;
+  BenchRun run;
+  gchar *desc, *model = NULL, *scenario, *metrics, *result;
+  gpointer data;
+  gsize size;
+  guint i, total;
+  gboolean ret = FALSE;
+
+  gst_tensors_info_init (&info);
+  info.num_tensors = 1;
+  info.info[0].type = gst_tensor_get_type (type);
+  gst_tensor_parse_dimension (dim, info.info[0].dimension);
+  size = gst_tensor_info_get_size (&info.info[0]);
+
+  if (g_str_equal (bc->name, "filter")) {
+    model = g_strdup_printf ("nns_benchmark_%s_%s", type, dim);
+    g_strdelimit (model, ":", '_');
+
+    if (NNS_custom_easy_register (model, bench_filter_invoke, NULL, &info,
+            &info) != 0) {
+      g_printerr ("Failed to register the custom-easy function %s.\n", model);
+      goto done;
+    }
+  }
+
+  desc = bench_get_pipeline (bc, dim, type, model, size);
+  pipeline = gst_parse_launch (desc, NULL);
+  if (pipeline == NULL) {
+    g_printerr ("Failed to create the pipeline: %s\n", desc);
+    g_free (desc);
+    goto done;
+  }
+  g_free (desc);
+
+  memset (&run, 0, sizeof (run));
+  run.allocator = allocator;
+  run.warmup = (guint) opt_warmup;
+  run.frames = (guint) opt_frames;
+  run.push_times = g_new0 (gint64, run.warmup + run.frames);
+  run.latencies = g_array_sized_new (FALSE, FALSE, sizeof (gdouble),
+      run.frames);
+
+  src = gst_bin_get_by_name (GST_BIN (pipeline), "src");
+  sink = gst_bin_get_by_name (GST_BIN (pipeline), "sink");
+  g_signal_connect (sink, "handoff", G_CALLBACK (bench_handoff_cb), &run);
+
+  data = g_malloc0 (size);
+  total = run.warmup + run.frames;
+
+  if (gst_element_set_state (pipeline, GST_STATE_PLAYING) ==
+      GST_STATE_CHANGE_FAILURE) {
+    g_printerr ("Failed to start the pipeline of %s.\n", bc->name);
+    goto stop;
+  }
+
+  for (i = 0; i < total; i++) {
+    GstBuffer *buffer = gst_buffer_new_wrapped_full (0, data, size, 0, size,
+        NULL, NULL);
+
+    run.push_times[i] = g_get_monotonic_time ();
+    if (gst_app_src_push_buffer (GST_APP_SRC (src), buffer) != GST_FLOW_OK) {
+      g_printerr ("Failed to push the buffer %u of %s.\n", i, bc->name);
+      break;
+    }
+  }
+  gst_app_src_end_of_stream (GST_APP_SRC (src));
+
+  bus = gst_element_get_bus (pipeline);
+  msg = gst_bus_timed_pop_filtered (bus, BENCH_TIMEOUT_SEC * GST_SECOND,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  gst_object_unref (bus);
+
+  if (msg == NULL || GST_MESSAGE_TYPE (msg) != GST_MESSAGE_EOS) {
+    g_printerr ("Failed to run the case %s (%s, %s).\n", bc->name, dim, type);
+  } else if ((guint) g_atomic_int_get (&run.received) < total) {
+    g_printerr ("The case %s (%s, %s) received %d of %u frames.\n", bc->name,
+        dim, type, g_atomic_int_get (&run.received), total);
+  } else {
+    gdouble elapsed = (gdouble) (run.end_time - run.start_time);
+    gdouble fps = 0.0, ns_per_byte = 0.0;
+    gdouble allocs = (gdouble) (run.end_allocs - run.start_allocs);
+
+    if (elapsed > 0.0) {
+      fps = run.frames * (gdouble) G_USEC_PER_SEC / elapsed;
+      ns_per_byte = elapsed * 1000.0 / ((gdouble) size * run.frames);
+    }
+
+    scenario = g_strdup_printf ("%s/%s/%s", bc->name, dim, type);
+    metrics = g_strdup_printf ("\"benchmark\": \"%s\", \"dimension\": \"%s\", "
+        "\"type\": \"%s\", \"bytes\": %zu, \"frames\": %u, "
+        "\"fps\": %.2f, \"ns_per_byte\": %.4f, \"allocs_per_frame\": %.2f, "
+        "\"latency_p50_ms\": %.3f, \"latency_p90_ms\": %.3f, "
+        "\"latency_p99_ms\": %.3f",
+        bc->name, dim, type, size, run.frames, fps, ns_per_byte,
+        allocs / run.frames,
+        unittest_perf_percentile (run.latencies, 50.0),
+        unittest_perf_percentile (run.latencies, 90.0),
+        unittest_perf_percentile (run.latencies, 99.0));
+
+    result = unittest_perf_format ("benchmark_elements", scenario, metrics);
+    g_print ("%s\n", result);
+    if (out)
+      fprintf (out, "%s\n", result);
+    unittest_perf_report ("benchmark_elements", scenario, metrics);
+
+    g_free (result);
+    g_free (metrics);
+    g_free (scenario);
+    ret = TRUE;
+  }
+
+  if (msg)
+    gst_message_unref (msg);
+
+stop:
+  gst_element_set_state (pipeline, GST_STATE_NULL);
+  gst_object_unref (src);
+  gst_object_unref (sink);
+  gst_object_unref (pipeline);
+  g_free (data);
+  g_free (run.push_times);
+  g_array_free (run.latencies, TRUE);
+
+done:
+  if (model) {
+    NNS_custom_easy_unregister (model);
+    g_free (model);
+  }
+  gst_tensors_info_free (&info);
+  return ret;
+}
+
+/**
+ * @brief Main function of the benchmark.
+ */
+int
+main (int argc, char *argv[])
+{
+  GOptionContext *ctx;
+  GError *err = NULL;
+  GstElement *loader;
+  BenchAllocator *allocator;
+  FILE *out = NULL;
+  guint c, d, t;
+  gint failed = 0;
+
+  ctx = g_option_context_new ("- benchmark of nnstreamer elements");
+  g_option_context_add_main_entries (ctx, bench_options, NULL);
+  g_option_context_add_group (ctx, gst_init_get_option_group ());
+  if (!g_option_context_parse (ctx, &argc, &argv, &err)) {
+    g_printerr ("Failed to parse the options: %s\n", err->message);
+    g_clear_error (&err);
+    g_option_context_free (ctx);
+    return 1;
+  }
+  g_option_context_free (ctx);
+
+  if (opt_frames <= 0 || opt_warmup <= 0) {
+    g_printerr ("The number of frames and warm-up frames should be positive.\n");
+    return 1;
+  }
+
+  gst_init (&argc, &argv);
+
+  /* load nnstreamer first, it may replace the default allocator */
+  loader = gst_element_factory_make ("tensor_converter", NULL);
+  if (loader == NULL) {
+    g_printerr ("Failed to load nnstreamer.\n");
+    return 1;
+  }
+  gst_object_unref (loader);
+
+  allocator = g_object_new (bench_allocator_get_type (), NULL);
+  allocator->inner = gst_allocator_find (NULL);
+  gst_allocator_set_default (GST_ALLOCATOR (gst_object_ref (allocator)));
+
+  if (opt_output) {
+    out = fopen (opt_output, "w");
+    if (out == NULL)
+      g_printerr ("Failed to open %s, the results are printed only.\n",
+          opt_output);
+  }
+
+  for (c = 0; c < G_N_ELEMENTS (bench_cases); c++) {
+    const BenchCase *bc = &bench_cases[c];
+
+    if (opt_filter && !strstr (bc->name, opt_filter))
+      continue;
+
+    for (t = 0; t < G_N_ELEMENTS (bench_types); t++) {
+      if (bc->uint8_only && !g_str_equal (bench_types[t], "uint8"))
+        continue;
+
+      for (d = 0; d < G_N_ELEMENTS (bench_dims); d++) {
+        if (!bench_run_case (bc, bench_dims[d], bench_types[t], allocator, out))
+          failed++;
+      }
+    }
+  }
+
+  if (out)
+    fclose (out);
+
+  /* restore the default allocator */
+  gst_allocator_set_default (gst_object_ref (allocator->inner));
+  gst_object_unref (allocator);
+  g_free (opt_filter);
+  g_free (opt_output);
+
+  return (failed > 0) ? 1 : 0;
+}
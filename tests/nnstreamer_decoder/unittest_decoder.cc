@@ -11,6 +11,7 @@
 #include <flatbuffers/flexbuffers.h>
 #include <glib.h>
 #include <gst/gst.h>
+#include <gst/check/gstharness.h>
 #include <nnstreamer_plugin_api_decoder.h>
 #include <nnstreamer_subplugin.h>
 #include <tensor_common.h>
@@ -145,6 +146,115 @@ TEST (tensorDecoderCustom, normal0)
   removeTempFile (&tmp_flex_custom);
 }
 
+/**
+ * @brief custom callback function to copy the input data of a frame
+ */
+static int
+tensor_decoder_custom_copy_cb (const GstTensorMemory *input,
+    const GstTensorsConfig *config, void *data, GstBuffer *out_buf)
+{
+  GstMemory *out_mem;
+
+  data_received++;
+  out_mem = gst_allocator_alloc (NULL, input[0].size, NULL);
+  gst_memory_fill (out_mem, 0, (guint8 *) input[0].data, input[0].size);
+  gst_buffer_append_memory (out_buf, out_mem);
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Test behavior: decode the frames packed in a buffer (property batch)
+ */
+TEST (tensorDecoderCustom, batchFrames)
+{
+  GstHarness *h;
+  GstTensorsConfig config;
+  GstBuffer *in_buf, *out_buf;
+  GstMapInfo map;
+  guint i, j;
+
+  EXPECT_EQ (0, nnstreamer_decoder_custom_register ("tdec_copy", tensor_decoder_custom_copy_cb, NULL));
+  data_received = 0;
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+  gst_harness_add_parse (h, "tensor_decoder mode=custom-code option1=tdec_copy batch=2");
+
+  /* 2 frames of uint8 4:1 */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("4:2", config.info.info[0].dimension);
+  config.rate_n = 10;
+  config.rate_d = 1;
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  in_buf = gst_harness_create_buffer (h, 8U);
+  ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_WRITE));
+  for (i = 0; i < 8U; i++)
+    map.data[i] = i;
+  gst_buffer_unmap (in_buf, &map);
+  GST_BUFFER_PTS (in_buf) = 0;
+  GST_BUFFER_DURATION (in_buf) = 100 * GST_MSECOND;
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  EXPECT_EQ (gst_harness_buffers_received (h), 2U);
+
+  for (i = 0; i < 2U; i++) {
+    out_buf = gst_harness_pull (h);
+    ASSERT_TRUE (out_buf != NULL);
+    EXPECT_EQ (GST_BUFFER_PTS (out_buf), i * 50 * GST_MSECOND);
+    EXPECT_EQ (GST_BUFFER_DURATION (out_buf), 50 * GST_MSECOND);
+
+    ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+    EXPECT_EQ (map.size, 4U);
+    for (j = 0; j < 4U; j++)
+      EXPECT_EQ (map.data[j], i * 4 + j);
+    gst_buffer_unmap (out_buf, &map);
+    gst_buffer_unref (out_buf);
+  }
+
+  EXPECT_EQ (2, data_received);
+
+  gst_harness_teardown (h);
+  gst_tensors_config_free (&config);
+  EXPECT_EQ (0, nnstreamer_decoder_custom_unregister ("tdec_copy"));
+}
+
+/**
+ * @brief Test behavior: the outermost dimension is not a multiple of the batch
+ */
+TEST (tensorDecoderCustom, batchInvalidDimension_n)
+{
+  GstHarness *h;
+  GstTensorsConfig config;
+  GstBuffer *in_buf;
+
+  EXPECT_EQ (0, nnstreamer_decoder_custom_register ("tdec_copy", tensor_decoder_custom_copy_cb, NULL));
+  data_received = 0;
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+  gst_harness_add_parse (h, "tensor_decoder mode=custom-code option1=tdec_copy batch=2");
+
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("4:3", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  in_buf = gst_harness_create_buffer (h, 12U);
+  EXPECT_NE (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  EXPECT_EQ (0, data_received);
+
+  gst_harness_teardown (h);
+  gst_tensors_config_free (&config);
+  EXPECT_EQ (0, nnstreamer_decoder_custom_unregister ("tdec_copy"));
+}
+
 /**
  * @brief Register custom callback with NULL parameter
  */
@@ -344,6 +454,96 @@ TEST (tensorDecoder, subpluginNullDesc_n)
   free_default_decoder (sub);
 }
 
+/** @brief tensordec-plugin's getOutCaps callback (octet stream) */
+static GstCaps *
+decsub_octet_getOutCaps (void **pdata, const GstTensorsConfig *config)
+{
+  return gst_caps_from_string ("application/octet-stream");
+}
+
+/** @brief tensordec-plugin's decode callback copying the input with random delay */
+static GstFlowReturn
+decsub_copy_decode (void **pdata, const GstTensorsConfig *config,
+    const GstTensorMemory *input, GstBuffer *outbuf)
+{
+  GstMemory *out_mem;
+
+  /* shuffle the order of the finished buffers */
+  g_usleep (g_random_int_range (0, 5000));
+
+  out_mem = gst_allocator_alloc (NULL, input[0].size, NULL);
+  gst_memory_fill (out_mem, 0, (guint8 *) input[0].data, input[0].size);
+  gst_buffer_append_memory (outbuf, out_mem);
+  g_atomic_int_inc (&data_received);
+
+  return GST_FLOW_OK;
+}
+
+/**
+ * @brief Test behavior: decode the buffers with the worker threads (property workers)
+ */
+TEST (tensorDecoder, workersOrderedOutput)
+{
+  GstTensorDecoderDef *sub = get_default_decoder ("tdec_workers");
+  GstHarness *h;
+  GstTensorsConfig config;
+  GstBuffer *in_buf, *out_buf;
+  GstMapInfo map;
+  guint i, workers = 0;
+  const guint num_buffers = 20U;
+
+  sub->getOutCaps = decsub_octet_getOutCaps;
+  sub->decode = decsub_copy_decode;
+  sub->threadSafe = 1;
+  EXPECT_TRUE (nnstreamer_decoder_probe (sub));
+  data_received = 0;
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+  gst_harness_add_parse (h, "tensor_decoder mode=tdec_workers workers=4");
+
+  g_object_get (h->element, "workers", &workers, NULL);
+  EXPECT_EQ (workers, 4U);
+
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("4:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  for (i = 0; i < num_buffers; i++) {
+    in_buf = gst_harness_create_buffer (h, 4U);
+    gst_buffer_memset (in_buf, 0, (guint8) i, 4U);
+    GST_BUFFER_PTS (in_buf) = i * GST_MSECOND;
+
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  }
+
+  /* the serialized event waits for the buffers in flight */
+  EXPECT_TRUE (gst_harness_push_event (h, gst_event_new_eos ()));
+  EXPECT_EQ (gst_harness_buffers_received (h), num_buffers);
+  EXPECT_EQ (g_atomic_int_get (&data_received), (int) num_buffers);
+
+  for (i = 0; i < num_buffers; i++) {
+    out_buf = gst_harness_pull (h);
+    ASSERT_TRUE (out_buf != NULL);
+    EXPECT_EQ (GST_BUFFER_PTS (out_buf), i * GST_MSECOND);
+
+    ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+    EXPECT_EQ (map.size, 4U);
+    EXPECT_EQ (map.data[0], i);
+    gst_buffer_unmap (out_buf, &map);
+    gst_buffer_unref (out_buf);
+  }
+
+  gst_harness_teardown (h);
+  gst_tensors_config_free (&config);
+  nnstreamer_decoder_exit ("tdec_workers");
+  free_default_decoder (sub);
+}
+
 /**
  * @brief Main GTest
  */
@@ -93,6 +93,27 @@ for result in tensordecoder.orange.*.log; do
     let i++
 done
 
+# Top-5 labels (text) and index-score pairs (tensor)
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} filesrc location=\"${PATH_TO_IMAGE}\" ! pngdec ! videoscale ! imagefreeze ! videoconvert ! video/x-raw, format=RGB, framerate=0/1 ! tensor_converter ! tensor_filter framework=\"tensorflow1-lite\" model=\"${PATH_TO_MODEL}\" ! \
+tee name=t ! queue ! tensor_decoder mode=image_labeling option1=\"${PATH_TO_LABEL}\" option2=5 ! filesink location=\"tensordecoder.top5.log\" \
+t. ! queue ! tensor_decoder mode=image_labeling option1=\"${PATH_TO_LABEL}\" option2=5 option3=tensor ! filesink location=\"tensordecoder.top5.tensor\"" D2 0 0 $PERFORMANCE
+label=$(head -n 1 tensordecoder.top5.log)
+lines=$(cat tensordecoder.top5.log | wc -l)
+# 5 labels, without the newline at the end
+if [ "$label" == "orange" ] && [ "$lines" == "4" ]; then
+    testResult 1 D2-1 "Decoding top-5 labels"
+else
+    testResult 0 D2-1 "Decoding top-5 labels"
+fi
+size=$(stat -c %s tensordecoder.top5.tensor)
+# float32 2:5
+if [ "$size" == "40" ]; then
+    testResult 1 D2-2 "Decoding top-5 index-score pairs"
+else
+    testResult 0 D2-2 "Decoding top-5 index-score pairs"
+fi
+
 rm *.log
+rm *.tensor
 
 report
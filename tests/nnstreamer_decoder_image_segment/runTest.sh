@@ -97,6 +97,23 @@ videotestsrc num_buffers=1 ! videoconvert ! videoscale ! video/x-raw,format=RGB,
 videomixer name=mix sink_0::alpha=0.7 sink_1::alpha=0.6 ! videoconvert ! fakesink" \
 3_n 0 1
 
+# Label index map (uint8) decoded with the worker threads
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} \
+videotestsrc num_buffers=4 ! videoconvert ! videoscale ! video/x-raw,format=RGB,width=257,height=257 ! \
+    tensor_converter ! tensor_transform mode=arithmetic option=typecast:float32,div:255.0 ! \
+    tensor_filter framework=tensorflow1-lite model=${PATH_TO_MODEL} ! \
+    tensor_decoder mode=image_segment option1=tflite-deeplab option3=index option4=2 ! \
+    other/tensors,num_tensors=1,types=uint8,dimensions=1:257:257:1 ! fakesink" \
+4 0 0 $PERFORMANCE
+
+# THIS SHOULD EMIT ERROR (no index output of snpe-depth)
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} \
+videotestsrc num_buffers=1 ! videoconvert ! videoscale ! video/x-raw,format=RGB,width=257,height=257 ! \
+    tensor_converter ! tensor_transform mode=arithmetic option=typecast:float32,div:255.0 ! \
+    tensor_filter framework=tensorflow1-lite model=${PATH_TO_MODEL} ! \
+    tensor_decoder mode=image_segment option1=snpe-depth option3=index ! fakesink" \
+5_n 0 1
+
 rm test_output.*
 
 report
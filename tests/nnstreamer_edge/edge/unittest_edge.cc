@@ -28,6 +28,7 @@ TEST (edgeSink, properties0)
   gint int_val;
   guint uint_val;
   gchar *str_val;
+  gboolean bool_val;
 
   /* Create a nnstreamer pipeline */
   pipeline = g_strdup_printf (
@@ -68,6 +69,18 @@ TEST (edgeSink, properties0)
   EXPECT_STREQ ("TEMP_TEST_TOPIC", str_val);
   g_free (str_val);
 
+  g_object_get (edge_handle, "compression", &int_val, NULL);
+  EXPECT_EQ (0, int_val);
+  g_object_set (edge_handle, "compression", 1, NULL);
+  g_object_get (edge_handle, "compression", &int_val, NULL);
+  EXPECT_EQ (1, int_val);
+
+  g_object_get (edge_handle, "shared-memory", &bool_val, NULL);
+  EXPECT_EQ (FALSE, bool_val);
+  g_object_set (edge_handle, "shared-memory", TRUE, NULL);
+  g_object_get (edge_handle, "shared-memory", &bool_val, NULL);
+  EXPECT_EQ (TRUE, bool_val);
+
   gst_object_unref (edge_handle);
   gst_object_unref (gstpipe);
   g_free (pipeline);
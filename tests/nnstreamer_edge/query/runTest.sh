@@ -141,6 +141,73 @@ _callCompareTest raw8_2.log result8_2.log 8-5 "Compare 8-5" 1 0
 kill -9 $pid &> /dev/null
 wait $pid
 
+# Pipelined requests, the answers are pushed in the order of the requests.
+PORT=`python3 ../../get_available_port.py`
+gstTestBackground "--gst-plugin-path=${PATH_TO_PLUGIN} tensor_query_serversrc port=${PORT} ! other/tensors,format=static,num_tensors=1,dimensions=(string)3:300:300:1,types=(string)uint8 ! tensor_query_serversink async=false" 10-1 0 0 30
+pid=$!
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc is-live=true num-buffers=10 ! videoconvert ! videoscale ! video/x-raw,width=300,height=300,format=RGB ! tensor_converter ! tee name = t t. ! queue ! multifilesink location= raw10_%1d.log t. ! queue ! tensor_query_client port=0 dest-port=${PORT} max-in-flight=4 timeout=1000 ! multifilesink location=result10_%1d.log" 10-2 0 0 $PERFORMANCE $TIMEOUT_SEC
+_callCompareTest raw10_0.log result10_0.log 10-3 "Compare 10-3" 1 0
+_callCompareTest raw10_1.log result10_1.log 10-4 "Compare 10-4" 1 0
+_callCompareTest raw10_9.log result10_9.log 10-5 "Compare 10-5" 1 0
+kill -9 $pid &> /dev/null
+wait $pid
+
+# Load balancing between two query servers.
+PORT1=`python3 ../../get_available_port.py`
+PORT2=`python3 ../../get_available_port.py`
+gstTestBackground "--gst-plugin-path=${PATH_TO_PLUGIN} tensor_query_serversrc port=${PORT1} ! other/tensors,format=static,num_tensors=1,dimensions=(string)3:300:300:1,types=(string)uint8 ! tensor_query_serversink async=false" 11-1 0 0 30
+pid1=$!
+gstTestBackground "--gst-plugin-path=${PATH_TO_PLUGIN} tensor_query_serversrc port=${PORT2} ! other/tensors,format=static,num_tensors=1,dimensions=(string)3:300:300:1,types=(string)uint8 ! tensor_query_serversink async=false" 11-2 0 0 30
+pid2=$!
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc is-live=true num-buffers=10 ! videoconvert ! videoscale ! video/x-raw,width=300,height=300,format=RGB ! tensor_converter ! tee name = t t. ! queue ! multifilesink location= raw11_%1d.log t. ! queue ! tensor_query_client port=0 dest-list=127.0.0.1:${PORT1},127.0.0.1:${PORT2} max-in-flight=2 timeout=1000 ! multifilesink location=result11_%1d.log" 11-3 0 0 $PERFORMANCE $TIMEOUT_SEC
+_callCompareTest raw11_0.log result11_0.log 11-4 "Compare 11-4" 1 0
+_callCompareTest raw11_1.log result11_1.log 11-5 "Compare 11-5" 1 0
+_callCompareTest raw11_9.log result11_9.log 11-6 "Compare 11-6" 1 0
+kill -9 $pid1 $pid2 &> /dev/null
+wait $pid1 $pid2
+
+# Batching the requests in the server, the result of each request is sent back to the client.
+PORT=`python3 ../../get_available_port.py`
+gstTestBackground "--gst-plugin-path=${PATH_TO_PLUGIN} tensor_query_serversrc port=${PORT} max-batch=2 batch-timeout=10 ! other/tensors,format=static,num_tensors=1,dimensions=(string)3:300:300:2,types=(string)uint8 ! tensor_query_serversink async=false" 12-1 0 0 30
+pid=$!
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc is-live=true num-buffers=10 ! videoconvert ! videoscale ! video/x-raw,width=300,height=300,format=RGB ! tensor_converter ! tee name = t t. ! queue ! multifilesink location= raw12_%1d.log t. ! queue ! tensor_query_client port=0 dest-port=${PORT} max-in-flight=2 timeout=1000 ! multifilesink location=result12_%1d.log" 12-2 0 0 $PERFORMANCE $TIMEOUT_SEC
+_callCompareTest raw12_0.log result12_0.log 12-3 "Compare 12-3" 1 0
+_callCompareTest raw12_1.log result12_1.log 12-4 "Compare 12-4" 1 0
+_callCompareTest raw12_9.log result12_9.log 12-5 "Compare 12-5" 1 0
+kill -9 $pid &> /dev/null
+wait $pid
+
+# Two workers (serversrc-serversink branches with the same id) sharing the server handle.
+PORT=`python3 ../../get_available_port.py`
+gstTestBackground "--gst-plugin-path=${PATH_TO_PLUGIN} tensor_query_serversrc id=13 port=${PORT} max-pending=4 ! other/tensors,format=static,num_tensors=1,dimensions=(string)3:300:300:1,types=(string)uint8 ! queue ! tensor_query_serversink id=13 async=false tensor_query_serversrc id=13 ! other/tensors,format=static,num_tensors=1,dimensions=(string)3:300:300:1,types=(string)uint8 ! queue ! tensor_query_serversink id=13 async=false" 13-1 0 0 30
+pid=$!
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc is-live=true num-buffers=10 ! videoconvert ! videoscale ! video/x-raw,width=300,height=300,format=RGB ! tensor_converter ! tee name = t t. ! queue ! multifilesink location= raw13_%1d.log t. ! queue ! tensor_query_client port=0 dest-port=${PORT} max-in-flight=2 timeout=1000 ! multifilesink location=result13_%1d.log" 13-2 0 0 $PERFORMANCE $TIMEOUT_SEC
+_callCompareTest raw13_0.log result13_0.log 13-3 "Compare 13-3" 1 0
+_callCompareTest raw13_1.log result13_1.log 13-4 "Compare 13-4" 1 0
+_callCompareTest raw13_9.log result13_9.log 13-5 "Compare 13-5" 1 0
+kill -9 $pid &> /dev/null
+wait $pid
+
+# Encoded payload, uint8 tensors are not quantized and the server restores the original data.
+PORT=`python3 ../../get_available_port.py`
+gstTestBackground "--gst-plugin-path=${PATH_TO_PLUGIN} tensor_query_serversrc port=${PORT} ! other/tensors,format=static,num_tensors=1,dimensions=(string)3:300:300:1,types=(string)uint8 ! tensor_query_serversink async=false" 14-1 0 0 30
+pid=$!
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc is-live=true num-buffers=10 ! videoconvert ! videoscale ! video/x-raw,width=300,height=300,format=RGB ! tensor_converter ! tee name = t t. ! queue ! multifilesink location= raw14_%1d.log t. ! queue ! tensor_query_client port=0 dest-port=${PORT} quantize=fp16 ! multifilesink location=result14_%1d.log" 14-2 0 0 $PERFORMANCE $TIMEOUT_SEC
+_callCompareTest raw14_0.log result14_0.log 14-3 "Compare 14-3" 1 0
+_callCompareTest raw14_9.log result14_9.log 14-4 "Compare 14-4" 1 0
+kill -9 $pid &> /dev/null
+wait $pid
+
+# Shared-memory transport, the server on the same host reads the payload from the shared memory.
+PORT=`python3 ../../get_available_port.py`
+gstTestBackground "--gst-plugin-path=${PATH_TO_PLUGIN} tensor_query_serversrc port=${PORT} ! other/tensors,format=static,num_tensors=1,dimensions=(string)3:300:300:1,types=(string)uint8 ! tensor_query_serversink async=false" 15-1 0 0 30
+pid=$!
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} videotestsrc is-live=true num-buffers=10 ! videoconvert ! videoscale ! video/x-raw,width=300,height=300,format=RGB ! tensor_converter ! tee name = t t. ! queue ! multifilesink location= raw15_%1d.log t. ! queue ! tensor_query_client port=0 dest-port=${PORT} shared-memory=true ! multifilesink location=result15_%1d.log" 15-2 0 0 $PERFORMANCE $TIMEOUT_SEC
+_callCompareTest raw15_0.log result15_0.log 15-3 "Compare 15-3" 1 0
+_callCompareTest raw15_9.log result15_9.log 15-4 "Compare 15-4" 1 0
+kill -9 $pid &> /dev/null
+wait $pid
+
 if [ -f /usr/sbin/mosquitto ]
 then
   testResult 1 9-0 "mosquitto mqtt broker search" 1
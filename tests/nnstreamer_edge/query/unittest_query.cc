@@ -55,6 +55,25 @@ TEST (tensorQuery, serverProperties0)
   g_object_get (srv_handle, "timeout", &uint_val, NULL);
   EXPECT_EQ (10U, uint_val);
 
+  g_object_get (srv_handle, "max-batch", &uint_val, NULL);
+  EXPECT_EQ (1U, uint_val);
+  g_object_set (srv_handle, "max-batch", 4U, NULL);
+  g_object_get (srv_handle, "max-batch", &uint_val, NULL);
+  EXPECT_EQ (4U, uint_val);
+  g_object_set (srv_handle, "max-batch", 1U, NULL);
+
+  g_object_get (srv_handle, "batch-timeout", &uint_val, NULL);
+  EXPECT_EQ (0U, uint_val);
+  g_object_set (srv_handle, "batch-timeout", 5U, NULL);
+  g_object_get (srv_handle, "batch-timeout", &uint_val, NULL);
+  EXPECT_EQ (5U, uint_val);
+
+  g_object_get (srv_handle, "max-pending", &uint_val, NULL);
+  EXPECT_EQ (0U, uint_val);
+  g_object_set (srv_handle, "max-pending", 8U, NULL);
+  g_object_get (srv_handle, "max-pending", &uint_val, NULL);
+  EXPECT_EQ (8U, uint_val);
+
   /* Set properties of query server source */
   g_object_set (srv_handle, "host", "127.0.0.2", NULL);
   g_object_get (srv_handle, "host", &str_val, NULL);
@@ -160,8 +179,10 @@ TEST (tensorQuery, clientProperties0)
   GstElement *client_handle;
   nns_edge_connect_type_e connect_type;
   guint uint_val;
+  gint int_val;
   gchar *str_val;
   gboolean bool_val;
+  GstStructure *stats = NULL;
 
   /* Create a query client pipeline */
   pipeline = g_strdup_printf (
@@ -205,6 +226,73 @@ TEST (tensorQuery, clientProperties0)
   g_object_get (client_handle, "silent", &bool_val, NULL);
   EXPECT_EQ (FALSE, bool_val);
 
+  g_object_get (client_handle, "max-in-flight", &uint_val, NULL);
+  EXPECT_EQ (1U, uint_val);
+  g_object_set (client_handle, "max-in-flight", 8U, NULL);
+  g_object_get (client_handle, "max-in-flight", &uint_val, NULL);
+  EXPECT_EQ (8U, uint_val);
+
+  g_object_get (client_handle, "out-of-order", &bool_val, NULL);
+  EXPECT_EQ (FALSE, bool_val);
+  g_object_set (client_handle, "out-of-order", TRUE, NULL);
+  g_object_get (client_handle, "out-of-order", &bool_val, NULL);
+  EXPECT_EQ (TRUE, bool_val);
+
+  g_object_set (client_handle, "dest-list", "127.0.0.1:3000,127.0.0.2:3000", NULL);
+  g_object_get (client_handle, "dest-list", &str_val, NULL);
+  EXPECT_STREQ ("127.0.0.1:3000,127.0.0.2:3000", str_val);
+  g_free (str_val);
+
+  g_object_get (client_handle, "compression", &int_val, NULL);
+  EXPECT_EQ (0, int_val);
+  g_object_set (client_handle, "compression", 2, NULL);
+  g_object_get (client_handle, "compression", &int_val, NULL);
+  EXPECT_EQ (2, int_val);
+
+  g_object_get (client_handle, "quantize", &int_val, NULL);
+  EXPECT_EQ (0, int_val);
+  g_object_set (client_handle, "quantize", 1, NULL);
+  g_object_get (client_handle, "quantize", &int_val, NULL);
+  EXPECT_EQ (1, int_val);
+
+  g_object_get (client_handle, "shared-memory", &bool_val, NULL);
+  EXPECT_EQ (FALSE, bool_val);
+  g_object_set (client_handle, "shared-memory", TRUE, NULL);
+  g_object_get (client_handle, "shared-memory", &bool_val, NULL);
+  EXPECT_EQ (TRUE, bool_val);
+
+  g_object_get (client_handle, "latency-report", &uint_val, NULL);
+  EXPECT_EQ (0U, uint_val);
+  g_object_set (client_handle, "latency-report", 30U, NULL);
+  g_object_get (client_handle, "latency-report", &uint_val, NULL);
+  EXPECT_EQ (30U, uint_val);
+
+  g_object_get (client_handle, "latency-stats", &stats, NULL);
+  ASSERT_TRUE (stats != NULL);
+  EXPECT_TRUE (gst_structure_get_uint (stats, "samples", &uint_val));
+  EXPECT_EQ (0U, uint_val);
+  EXPECT_TRUE (gst_structure_has_field (stats, "total-p99"));
+  EXPECT_TRUE (gst_structure_has_field (stats, "invoke-p50"));
+  gst_structure_free (stats);
+
+  g_object_get (client_handle, "adaptive-timeout", &bool_val, NULL);
+  EXPECT_EQ (FALSE, bool_val);
+  g_object_set (client_handle, "adaptive-timeout", TRUE, NULL);
+  g_object_get (client_handle, "adaptive-timeout", &bool_val, NULL);
+  EXPECT_EQ (TRUE, bool_val);
+
+  g_object_get (client_handle, "hedge", &bool_val, NULL);
+  EXPECT_EQ (FALSE, bool_val);
+  g_object_set (client_handle, "hedge", TRUE, NULL);
+  g_object_get (client_handle, "hedge", &bool_val, NULL);
+  EXPECT_EQ (TRUE, bool_val);
+
+  g_object_get (client_handle, "connection-pool", &bool_val, NULL);
+  EXPECT_EQ (FALSE, bool_val);
+  g_object_set (client_handle, "connection-pool", TRUE, NULL);
+  g_object_get (client_handle, "connection-pool", &bool_val, NULL);
+  EXPECT_EQ (TRUE, bool_val);
+
   gst_object_unref (client_handle);
   gst_object_unref (gstpipe);
   g_free (pipeline);
@@ -12,6 +12,7 @@
 #include <glib/gstdio.h> /* GStatBuf */
 #include <gst/gst.h>
 #include <tensor_common.h>
+#include <nnstreamer_plugin_api_filter.h>
 
 /**
  * @brief Standard positive case with a small tensorflow-lite model
@@ -131,6 +132,56 @@ TEST (edgetpuTfliteDirect, error02_n)
   g_free (pipeline);
 }
 
+/**
+ * @brief Positive case with the segments of a model chained (dummy device)
+ */
+TEST (edgetpuTfliteDirect, segments01)
+{
+  int ret;
+  void *data = NULL;
+  float in_val = 10.0, out_val = 0.0;
+  GstTensorMemory input, output;
+  GstTensorFilterProperties prop;
+  GstTensorsInfo in_info, out_info;
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  ASSERT_NE (root_path, nullptr);
+  gchar *test_model = g_build_filename (root_path, "tests", "test_models",
+      "models", "add.tflite", NULL);
+  const gchar *model_files[] = { test_model, test_model, NULL };
+
+  const GstTensorFilterFramework *sp = nnstreamer_filter_find ("edgetpu");
+  ASSERT_TRUE (sp != nullptr);
+
+  memset (&prop, 0, sizeof (GstTensorFilterProperties));
+  prop.fwname = "edgetpu";
+  prop.model_files = model_files;
+  prop.num_models = 2;
+  prop.custom_properties = "device_type:dummy";
+
+  ret = sp->open (&prop, &data);
+  EXPECT_EQ (ret, 0);
+
+  ret = sp->getModelInfo (NULL, NULL, data, GET_IN_OUT_INFO, &in_info, &out_info);
+  EXPECT_EQ (ret, 0);
+  EXPECT_EQ (in_info.num_tensors, 1U);
+  EXPECT_EQ (out_info.num_tensors, 1U);
+
+  /* each segment adds 2 */
+  input.data = &in_val;
+  input.size = sizeof (float);
+  output.data = &out_val;
+  output.size = sizeof (float);
+
+  ret = sp->invoke (NULL, NULL, data, &input, &output);
+  EXPECT_EQ (ret, 0);
+  EXPECT_FLOAT_EQ (out_val, 14.0);
+
+  sp->close (&prop, &data);
+  gst_tensors_info_free (&in_info);
+  gst_tensors_info_free (&out_info);
+  g_free (test_model);
+}
+
 /**
  * @brief Main GTest
  */
@@ -640,6 +640,70 @@ end
   sp->close (&prop, &data);
 }
 
+#ifdef ENABLE_LUAJIT
+/**
+ * @brief Positive case with invoke for lua model using the FFI pointers of the tensors
+ */
+TEST (nnstreamerFilterLua, invokeFFI00)
+{
+  int ret;
+  void *data = NULL;
+  GstTensorMemory input, output;
+  GstTensorFilterProperties prop;
+  const char *lua_script = R""""(
+inputTensorsInfo = {
+  num = 1,
+  dim = {{10, 1, 1, 1}, },
+  type = {'float32', }
+}
+outputTensorsInfo = {
+  num = 1,
+  dim = {{10, 1, 1, 1}, },
+  type = {'float32', }
+}
+function nnstreamer_invoke()
+  input, num = input_tensor_ptr(1)
+  output = output_tensor_ptr(1)
+
+  for i=0,num-1 do
+    output[i] = input[i] * 2
+  end
+
+end
+)"""";
+  const gchar *model_files[] = {
+    lua_script,
+    NULL,
+  };
+  guint i;
+
+  output.size = input.size = sizeof (float) * 10;
+
+  input.data = g_malloc (input.size);
+  output.data = g_malloc0 (output.size);
+
+  for (i = 0; i < 10; i++)
+    static_cast<float *> (input.data)[i] = (float) i;
+
+  const GstTensorFilterFramework *sp = nnstreamer_filter_find ("lua");
+  EXPECT_NE (sp, nullptr);
+  _SetFilterProp (&prop, "lua", model_files);
+
+  ret = sp->open (&prop, &data);
+  EXPECT_EQ (ret, 0);
+  EXPECT_NE (data, (void *) NULL);
+  ret = sp->invoke (NULL, NULL, data, &input, &output);
+
+  EXPECT_EQ (ret, 0);
+  for (i = 0; i < 10; i++)
+    EXPECT_FLOAT_EQ (static_cast<float *> (output.data)[i], (float) (i * 2));
+
+  g_free (input.data);
+  g_free (output.data);
+  sp->close (&prop, &data);
+}
+#endif /* ENABLE_LUAJIT */
+
 /**
  * @brief Negative case with invoke for lua model: invalid index for tensor
  */
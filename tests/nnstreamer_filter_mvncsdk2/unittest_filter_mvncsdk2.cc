@@ -110,6 +110,82 @@ TEST (pipelineMvncsdk2Filter, launchNormal)
   NCSDKTensorFilterTestHelper::getInstance ().release ();
 }
 
+/**
+ * @brief Testing the instances of the workers with the custom FIFO depth
+ */
+TEST (pipelineMvncsdk2Filter, launchWorkers)
+{
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  gchar *pipeline;
+  gchar *test_model;
+  GstElement *gstpipe;
+  GstStateChangeReturn ret;
+
+  if (root_path == NULL) {
+    root_path = "..";
+  }
+  test_model = g_build_filename (root_path, "tests", "test_models", "models",
+      "google_lenet_ncsdk_caffe_1.graph", NULL);
+  pipeline = g_strdup_printf (
+      "videotestsrc num-buffers=10 ! videoconvert ! videoscale ! video/x-raw,format=BGR,width=224,height=224 "
+      "! tensor_converter ! tensor_transform mode=arithmetic option=typecast:float32,add:-104.0069877 "
+      "! tensor_filter framework=movidius-ncsdk2 model=\"%s\" workers=2 custom=fifo_depth:4 ! fakesink",
+      test_model);
+
+  NCSDKTensorFilterTestHelper::getInstance ().init (GOOGLE_LENET);
+
+  gstpipe = gst_parse_launch (pipeline, NULL);
+  ASSERT_TRUE (gstpipe != NULL);
+
+  ret = gst_element_set_state (gstpipe, GST_STATE_PLAYING);
+  EXPECT_TRUE (ret == GST_STATE_CHANGE_ASYNC || ret == GST_STATE_CHANGE_SUCCESS);
+  g_usleep (1 * G_USEC_PER_SEC);
+
+  ret = gst_element_set_state (gstpipe, GST_STATE_NULL);
+  EXPECT_EQ (ret, GST_STATE_CHANGE_SUCCESS);
+
+  gst_object_unref (gstpipe);
+  g_free (test_model);
+  g_free (pipeline);
+
+  NCSDKTensorFilterTestHelper::getInstance ().release ();
+}
+
+/**
+ * @brief Testing the invalid FIFO depth
+ */
+TEST (pipelineMvncsdk2Filter, launchInvalidFifoDepth_n)
+{
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  gchar *pipeline;
+  gchar *test_model;
+  GstElement *gstpipe;
+
+  if (root_path == NULL) {
+    root_path = "..";
+  }
+  test_model = g_build_filename (root_path, "tests", "test_models", "models",
+      "google_lenet_ncsdk_caffe_1.graph", NULL);
+  pipeline = g_strdup_printf (
+      "videotestsrc num-buffers=1 ! videoconvert ! videoscale ! video/x-raw,format=BGR,width=224,height=224 "
+      "! tensor_converter ! tensor_transform mode=arithmetic option=typecast:float32,add:-104.0069877 "
+      "! tensor_filter framework=movidius-ncsdk2 model=\"%s\" custom=fifo_depth:0 ! fakesink",
+      test_model);
+
+  NCSDKTensorFilterTestHelper::getInstance ().init (GOOGLE_LENET);
+
+  gstpipe = gst_parse_launch (pipeline, NULL);
+  ASSERT_TRUE (gstpipe != NULL);
+
+  EXPECT_EQ (gst_element_set_state (gstpipe, GST_STATE_PLAYING), GST_STATE_CHANGE_FAILURE);
+
+  gst_object_unref (gstpipe);
+  g_free (test_model);
+  g_free (pipeline);
+
+  NCSDKTensorFilterTestHelper::getInstance ().release ();
+}
+
 #define TEST_PIPELINE_LAUNCH_NORMAL_FAILURE(idx, fail_stage)                                                  \
   TEST (pipelineMvncsdk2Filter, launchNormal##idx##_n)                                                        \
   {                                                                                                           \
@@ -1162,6 +1162,92 @@ TEST (tensorFilterOpenvino, convertGstTensorMemoryToBlobPtr0)
   g_free (test_model_bin);
 }
 
+/**
+ * @brief Test cases for the custom properties (num_requests and performance_hint)
+ */
+TEST (tensorFilterOpenvino, customProperties0)
+{
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  std::string str_test_model;
+  gchar *test_model_xml;
+  gchar *test_model_bin;
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model_xml = g_build_filename (root_path, "tests", "test_models", "models",
+      str_test_model.assign (MODEL_BASE_NAME_MOBINET_V2)
+          .append (TensorFilterOpenvino::extXml)
+          .c_str (),
+      NULL);
+  test_model_bin = g_build_filename (root_path, "tests", "test_models", "models",
+      str_test_model.assign (MODEL_BASE_NAME_MOBINET_V2)
+          .append (TensorFilterOpenvino::extBin)
+          .c_str (),
+      NULL);
+
+  {
+    TensorFilterOpenvino tfOv (std::string (test_model_xml), std::string (test_model_bin));
+
+    EXPECT_EQ (tfOv.getNumRequests (), 0U);
+    EXPECT_TRUE (tfOv.getPerformanceHint ().empty ());
+
+    EXPECT_EQ (tfOv.setCustomProperties (NULL), TensorFilterOpenvino::RetSuccess);
+    EXPECT_EQ (tfOv.setCustomProperties ("num_requests:4, performance_hint:throughput"),
+        TensorFilterOpenvino::RetSuccess);
+    EXPECT_EQ (tfOv.getNumRequests (), 4U);
+    EXPECT_EQ (tfOv.getPerformanceHint (), "THROUGHPUT");
+
+    EXPECT_EQ (tfOv.setCustomProperties ("performance_hint:LATENCY"),
+        TensorFilterOpenvino::RetSuccess);
+    EXPECT_EQ (tfOv.getPerformanceHint (), "LATENCY");
+  }
+
+  g_free (test_model_xml);
+  g_free (test_model_bin);
+}
+
+/**
+ * @brief Negative test cases for the custom properties with invalid values
+ */
+TEST (tensorFilterOpenvino, customProperties0_n)
+{
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  std::string str_test_model;
+  gchar *test_model_xml;
+  gchar *test_model_bin;
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model_xml = g_build_filename (root_path, "tests", "test_models", "models",
+      str_test_model.assign (MODEL_BASE_NAME_MOBINET_V2)
+          .append (TensorFilterOpenvino::extXml)
+          .c_str (),
+      NULL);
+  test_model_bin = g_build_filename (root_path, "tests", "test_models", "models",
+      str_test_model.assign (MODEL_BASE_NAME_MOBINET_V2)
+          .append (TensorFilterOpenvino::extBin)
+          .c_str (),
+      NULL);
+
+  {
+    TensorFilterOpenvino tfOv (std::string (test_model_xml), std::string (test_model_bin));
+
+    EXPECT_EQ (tfOv.setCustomProperties ("num_requests:many"), TensorFilterOpenvino::RetEInval);
+    EXPECT_EQ (tfOv.setCustomProperties ("num_requests:-1"), TensorFilterOpenvino::RetEInval);
+    EXPECT_EQ (tfOv.setCustomProperties ("performance_hint:fast"),
+        TensorFilterOpenvino::RetEInval);
+    EXPECT_EQ (tfOv.getNumRequests (), 0U);
+    EXPECT_TRUE (tfOv.getPerformanceHint ().empty ());
+  }
+
+  g_free (test_model_xml);
+  g_free (test_model_bin);
+}
+
 /**
  * @brief Main function for unit test.
  */
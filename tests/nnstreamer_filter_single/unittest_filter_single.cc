@@ -127,6 +127,58 @@ TEST_F (NNSFilterSingleTest, invoke_p)
   klass->destroy_notify (single, &output);
 }
 
+/**
+ * @brief Test to invoke tf-lite model with the bound memory, and compare the latency with invoke.
+ */
+TEST_F (NNSFilterSingleTest, invokeBound_p)
+{
+  const guint repeat = 20U;
+  gint64 start, elapsed, elapsed_bound;
+  guint i;
+
+  ASSERT_TRUE (this->loaded);
+  output.data = g_malloc0 (output.size);
+
+  EXPECT_TRUE (klass->bind (single, &input, &output));
+  EXPECT_TRUE (klass->invoke_bound (single));
+  EXPECT_EQ (951U, get_max_score (&output));
+
+  start = g_get_monotonic_time ();
+  for (i = 0; i < repeat; i++)
+    EXPECT_TRUE (klass->invoke (single, &input, &output, FALSE));
+  elapsed = g_get_monotonic_time () - start;
+
+  start = g_get_monotonic_time ();
+  for (i = 0; i < repeat; i++)
+    EXPECT_TRUE (klass->invoke_bound (single));
+  elapsed_bound = g_get_monotonic_time () - start;
+
+  EXPECT_EQ (951U, get_max_score (&output));
+  g_print ("invoke %" G_GINT64_FORMAT " usec, invoke_bound %" G_GINT64_FORMAT
+      " usec (average of %u invokes)\n", elapsed / repeat, elapsed_bound / repeat, repeat);
+
+  /* unbind */
+  EXPECT_TRUE (klass->bind (single, NULL, NULL));
+  EXPECT_FALSE (klass->invoke_bound (single));
+}
+
+/**
+ * @brief Test to bind the memory with invalid param.
+ */
+TEST_F (NNSFilterSingleTest, bindInvalidParam_n)
+{
+  ASSERT_TRUE (this->loaded);
+  output.data = g_malloc0 (output.size);
+
+  EXPECT_FALSE (klass->bind (single, &input, NULL));
+  EXPECT_FALSE (klass->bind (single, NULL, &output));
+
+  /* the size of memory is different from the model */
+  output.size = 10U;
+  EXPECT_FALSE (klass->bind (single, &input, &output));
+  EXPECT_FALSE (klass->invoke_bound (single));
+}
+
 /**
  * @brief Test to invoke tf-lite model with invalid param.
  */
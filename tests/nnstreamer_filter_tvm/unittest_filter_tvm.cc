@@ -467,6 +467,41 @@ TEST_F (NNStreamerFilterTVMTest, launchInvalidDevice_n)
   EXPECT_EQ (setPipelineStateSync (gstpipe, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
 }
 
+/**
+ * @brief Positive case with the accelerator property and the number of threads
+ */
+TEST_F (NNStreamerFilterTVMTest, launchAcceleratorThreads)
+{
+  pipeline = g_strdup_printf ("videotestsrc num-buffers=1 ! videoconvert ! videoscale ! video/x-raw,format=RGB,width=480,height=640 ! tensor_converter ! tensor_transform mode=arithmetic option=typecast:float32,add:-255.0 ! tensor_filter framework=tvm model=\"%s\" accelerator=true:cpu custom=num_input_tensors:1,num_threads:2 ! tensor_sink name=sink",
+      model_file);
+
+  gstpipe = gst_parse_launch (pipeline, nullptr);
+  EXPECT_NE (gstpipe, nullptr);
+
+  sink_handle = gst_bin_get_by_name (GST_BIN (gstpipe), "sink");
+  EXPECT_NE (sink_handle, nullptr);
+  g_signal_connect (sink_handle, "new-data", (GCallback) NNStreamerFilterTVMTest::CheckOutput, NULL);
+
+  EXPECT_EQ (setPipelineStateSync (gstpipe, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  EXPECT_EQ (setPipelineStateSync (gstpipe, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+}
+
+/**
+ * @brief Negative case with invalid custom property (num_threads)
+ */
+TEST_F (NNStreamerFilterTVMTest, launchInvalidThreads_n)
+{
+  /* Test: invalid custom property num_threads should be bigger than 0 */
+  pipeline = g_strdup_printf ("videotestsrc num-buffers=1 ! videoconvert ! videoscale ! video/x-raw,format=RGB,width=480,height=640 ! tensor_converter ! tensor_transform mode=arithmetic option=typecast:float32,add:-255.0 ! tensor_filter framework=tvm model=\"%s\" custom=num_input_tensors:1,num_threads:0 ! fakesink",
+      model_file);
+
+  gstpipe = gst_parse_launch (pipeline, nullptr);
+  EXPECT_NE (gstpipe, nullptr);
+
+  EXPECT_NE (setPipelineStateSync (gstpipe, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  EXPECT_EQ (setPipelineStateSync (gstpipe, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+}
+
 /**
  * @brief Main gtest
  */
@@ -161,8 +161,8 @@ TEST (nnstreamerGrpc, srcGetPropertyDefault)
 {
   TestOption option;
   GstElement *src;
-  gboolean silent, server;
-  guint port, out;
+  gboolean silent, server, bidirectional;
+  guint port, out, num_cqs, max_inflight;
   gchar *host;
 
   _set_default_option (option);
@@ -189,6 +189,15 @@ TEST (nnstreamerGrpc, srcGetPropertyDefault)
   g_object_get (src, "out", &out, NULL);
   EXPECT_EQ (out, DEFAULT_OUT);
 
+  g_object_get (src, "num-cqs", &num_cqs, NULL);
+  EXPECT_EQ (num_cqs, 1U);
+
+  g_object_get (src, "bidirectional", &bidirectional, NULL);
+  EXPECT_FALSE (bidirectional);
+
+  g_object_get (src, "max-inflight", &max_inflight, NULL);
+  EXPECT_EQ (max_inflight, 16U);
+
   gst_object_unref (src);
   gst_object_unref (test_data.pipeline);
 }
@@ -200,8 +209,8 @@ TEST (nnstreamerGrpc, sinkGetPropertyDefault)
 {
   TestOption option;
   GstElement *sink;
-  gboolean silent, server;
-  guint port, out;
+  gboolean silent, server, bidirectional;
+  guint port, out, num_cqs, max_inflight;
   gchar *host;
 
   _set_default_option (option);
@@ -228,6 +237,15 @@ TEST (nnstreamerGrpc, sinkGetPropertyDefault)
   g_object_get (sink, "out", &out, NULL);
   EXPECT_EQ (out, DEFAULT_OUT);
 
+  g_object_get (sink, "num-cqs", &num_cqs, NULL);
+  EXPECT_EQ (num_cqs, 1U);
+
+  g_object_get (sink, "bidirectional", &bidirectional, NULL);
+  EXPECT_FALSE (bidirectional);
+
+  g_object_get (sink, "max-inflight", &max_inflight, NULL);
+  EXPECT_EQ (max_inflight, 16U);
+
   gst_object_unref (sink);
   gst_object_unref (test_data.pipeline);
 }
@@ -239,9 +257,10 @@ TEST (nnstreamerGrpc, srcSetProperty)
 {
   TestOption option;
   GstElement *src;
-  gboolean silent, server;
-  guint port;
-  gchar *host;
+  gboolean silent, server, bidirectional;
+  guint port, num_cqs, max_inflight, keepalive_time, num_channels;
+  gint max_message_size;
+  gchar *host, *compression;
 
   _set_default_option (option);
   option.mode = GRPC_MODE_SRC;
@@ -268,6 +287,45 @@ TEST (nnstreamerGrpc, srcSetProperty)
   g_object_get (src, "port", &port, NULL);
   EXPECT_EQ (port, 1000U);
 
+  g_object_set (src, "num-cqs", 4U, NULL);
+  g_object_get (src, "num-cqs", &num_cqs, NULL);
+  EXPECT_EQ (num_cqs, 4U);
+
+  g_object_set (src, "bidirectional", TRUE, NULL);
+  g_object_get (src, "bidirectional", &bidirectional, NULL);
+  EXPECT_TRUE (bidirectional);
+
+  g_object_set (src, "max-inflight", 4U, NULL);
+  g_object_get (src, "max-inflight", &max_inflight, NULL);
+  EXPECT_EQ (max_inflight, 4U);
+
+  g_object_set (src, "max-message-size", -1, NULL);
+  g_object_get (src, "max-message-size", &max_message_size, NULL);
+  EXPECT_EQ (max_message_size, -1);
+
+  g_object_set (src, "keepalive-time", 10000U, NULL);
+  g_object_get (src, "keepalive-time", &keepalive_time, NULL);
+  EXPECT_EQ (keepalive_time, 10000U);
+
+  g_object_get (src, "compression", &compression, NULL);
+  EXPECT_STREQ (compression, "none");
+  g_free (compression);
+
+  g_object_set (src, "compression", "gzip", NULL);
+  g_object_get (src, "compression", &compression, NULL);
+  EXPECT_STREQ (compression, "gzip");
+  g_free (compression);
+
+  /* invalid compression is ignored */
+  g_object_set (src, "compression", "invalid", NULL);
+  g_object_get (src, "compression", &compression, NULL);
+  EXPECT_STREQ (compression, "gzip");
+  g_free (compression);
+
+  g_object_set (src, "num-channels", 4U, NULL);
+  g_object_get (src, "num-channels", &num_channels, NULL);
+  EXPECT_EQ (num_channels, 4U);
+
   gst_object_unref (src);
   gst_object_unref (test_data.pipeline);
 }
@@ -279,9 +337,10 @@ TEST (nnstreamerGrpc, sinkSetProperty)
 {
   TestOption option;
   GstElement *sink;
-  gboolean silent, server;
-  guint port;
-  gchar *host;
+  gboolean silent, server, bidirectional;
+  guint port, num_cqs, max_inflight, keepalive_time, num_channels;
+  gint max_message_size;
+  gchar *host, *compression;
 
   _set_default_option (option);
   option.mode = GRPC_MODE_SINK;
@@ -308,6 +367,45 @@ TEST (nnstreamerGrpc, sinkSetProperty)
   g_object_get (sink, "port", &port, NULL);
   EXPECT_EQ (port, 1000U);
 
+  g_object_set (sink, "num-cqs", 4U, NULL);
+  g_object_get (sink, "num-cqs", &num_cqs, NULL);
+  EXPECT_EQ (num_cqs, 4U);
+
+  g_object_set (sink, "bidirectional", TRUE, NULL);
+  g_object_get (sink, "bidirectional", &bidirectional, NULL);
+  EXPECT_TRUE (bidirectional);
+
+  g_object_set (sink, "max-inflight", 4U, NULL);
+  g_object_get (sink, "max-inflight", &max_inflight, NULL);
+  EXPECT_EQ (max_inflight, 4U);
+
+  g_object_set (sink, "max-message-size", -1, NULL);
+  g_object_get (sink, "max-message-size", &max_message_size, NULL);
+  EXPECT_EQ (max_message_size, -1);
+
+  g_object_set (sink, "keepalive-time", 10000U, NULL);
+  g_object_get (sink, "keepalive-time", &keepalive_time, NULL);
+  EXPECT_EQ (keepalive_time, 10000U);
+
+  g_object_get (sink, "compression", &compression, NULL);
+  EXPECT_STREQ (compression, "none");
+  g_free (compression);
+
+  g_object_set (sink, "compression", "gzip", NULL);
+  g_object_get (sink, "compression", &compression, NULL);
+  EXPECT_STREQ (compression, "gzip");
+  g_free (compression);
+
+  /* invalid compression is ignored */
+  g_object_set (sink, "compression", "invalid", NULL);
+  g_object_get (sink, "compression", &compression, NULL);
+  EXPECT_STREQ (compression, "gzip");
+  g_free (compression);
+
+  g_object_set (sink, "num-channels", 4U, NULL);
+  g_object_get (sink, "num-channels", &num_channels, NULL);
+  EXPECT_EQ (num_channels, 4U);
+
   gst_object_unref (sink);
   gst_object_unref (test_data.pipeline);
 }
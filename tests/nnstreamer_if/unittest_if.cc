@@ -160,6 +160,17 @@ TEST (tensorIfProp, properties0)
   EXPECT_STREQ ("0", str_val);
   g_free (str_val);
 
+  g_object_set (tif_handle, "conditions", "GT:3000;RANGE_INCLUSIVE:2000,2500", NULL);
+  g_object_get (tif_handle, "conditions", &str_val, NULL);
+  EXPECT_STREQ ("GT:3000;RANGE_INCLUSIVE:2000,2500", str_val);
+  g_free (str_val);
+
+  /* invalid operator disables the multi-condition mode */
+  g_object_set (tif_handle, "conditions", "GT:3000;INVALID:2000", NULL);
+  g_object_get (tif_handle, "conditions", &str_val, NULL);
+  EXPECT_STREQ ("", str_val);
+  g_free (str_val);
+
   g_object_set (tif_handle, "silent", TRUE, NULL);
   g_object_get (tif_handle, "silent", &bool_val, NULL);
   EXPECT_EQ (TRUE, bool_val);
@@ -735,6 +746,168 @@ TEST (tensorIfAppsrc, action1)
   g_free (str_pipeline);
 }
 
+/**
+ * @brief Test behavior: TENSOR_MAX_VALUE and TENSOR_MIN_VALUE with tensors stream using appsrc
+ */
+TEST (tensorIfAppsrc, maxMinValue)
+{
+  GstBuffer *buf_0, *buf_1;
+  GstMemory *mem;
+  GstMapInfo info;
+  GstElement *appsrc_handle, *sink_handle, *tif_handle;
+  gint i, idx;
+
+  gchar *str_pipeline = g_strdup (
+      "appsrc name=appsrc ! other/tensors,num_tensors=2,dimensions=(string)3:4:2:2.3:4:2:2, types=(string)int32.int32,framerate=(fraction)0/1 ! "
+      "tensor_if name=tif compared-value=TENSOR_MAX_VALUE compared-value-option=1 supplied-value=2224 "
+      "operator=EQ then=TENSORPICK then-option=0 else=TENSORPICK else-option=1 "
+      "tif.src_0 ! queue ! tensor_sink name=sink_true async=false "
+      "tif.src_1 ! queue ! tensor_sink name=sink_false async=false");
+
+  GstElement *pipeline = gst_parse_launch (str_pipeline, NULL);
+  EXPECT_NE (pipeline, nullptr);
+
+  appsrc_handle = gst_bin_get_by_name (GST_BIN (pipeline), "appsrc");
+  EXPECT_NE (appsrc_handle, nullptr);
+
+  tif_handle = gst_bin_get_by_name (GST_BIN (pipeline), "tif");
+  EXPECT_NE (tif_handle, nullptr);
+
+  sink_handle = gst_bin_get_by_name (GST_BIN (pipeline), "sink_true");
+  EXPECT_NE (sink_handle, nullptr);
+
+  g_signal_connect (sink_handle, "new-data", (GCallback)new_data_cb, (gpointer)&idx);
+  gst_object_unref (sink_handle);
+
+  sink_handle = gst_bin_get_by_name (GST_BIN (pipeline), "sink_false");
+  EXPECT_NE (sink_handle, nullptr);
+
+  g_signal_connect (sink_handle, "new-data", (GCallback)new_data_cb, (gpointer)&idx);
+  gst_object_unref (sink_handle);
+
+  buf_0 = gst_buffer_new ();
+  for (i = 0; i < 2; i++) {
+    gboolean ret;
+    mem = gst_allocator_alloc (NULL, 192, NULL);
+    ret = gst_memory_map (mem, &info, GST_MAP_WRITE);
+    ASSERT_TRUE (ret);
+    memcpy (info.data, test_frames[i], 192);
+    gst_memory_unmap (mem, &info);
+    gst_buffer_append_memory (buf_0, mem);
+  }
+  buf_1 = gst_buffer_copy (buf_0);
+
+  data_received = 0;
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (100000);
+
+  /* max value of 2nd tensor is 2224 */
+  idx = 0;
+  EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (appsrc_handle), buf_0), GST_FLOW_OK);
+  g_usleep (100000);
+
+  /* min value of 2nd tensor is 2101 */
+  g_object_set (tif_handle, "compared-value", TIFCV_TENSOR_MIN_VALUE, NULL);
+
+  idx = 1;
+  EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (appsrc_handle), buf_1), GST_FLOW_OK);
+  g_usleep (100000);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (100000);
+
+  EXPECT_EQ (2, data_received);
+
+  gst_object_unref (appsrc_handle);
+  gst_object_unref (tif_handle);
+  gst_object_unref (pipeline);
+  g_free (str_pipeline);
+}
+
+/**
+ * @brief Test behavior: multiple conditions with tensors stream using appsrc
+ */
+TEST (tensorIfAppsrc, multiConditions)
+{
+  GstBuffer *buf_0, *buf_1;
+  GstMemory *mem;
+  GstMapInfo info;
+  GstElement *appsrc_handle, *sink_handle, *tif_handle;
+  gint i, idx_invalid = 100, idx_then = 1, idx_else = 0;
+
+  gchar *str_pipeline = g_strdup (
+      "appsrc name=appsrc ! other/tensors,num_tensors=2,dimensions=(string)3:4:2:2.3:4:2:2, types=(string)int32.int32,framerate=(fraction)0/1 ! "
+      "tensor_if name=tif compared-value=TENSOR_MAX_VALUE compared-value-option=1 "
+      "conditions=\"GT:3000;RANGE_INCLUSIVE:2000,2500\" "
+      "then=TENSORPICK then-option=1 else=TENSORPICK else-option=0 "
+      "tif.src_0 ! queue ! tensor_sink name=sink_0 async=false "
+      "tif.src_1 ! queue ! tensor_sink name=sink_1 async=false "
+      "tif.src_2 ! queue ! tensor_sink name=sink_2 async=false");
+
+  GstElement *pipeline = gst_parse_launch (str_pipeline, NULL);
+  EXPECT_NE (pipeline, nullptr);
+
+  appsrc_handle = gst_bin_get_by_name (GST_BIN (pipeline), "appsrc");
+  EXPECT_NE (appsrc_handle, nullptr);
+
+  tif_handle = gst_bin_get_by_name (GST_BIN (pipeline), "tif");
+  EXPECT_NE (tif_handle, nullptr);
+
+  sink_handle = gst_bin_get_by_name (GST_BIN (pipeline), "sink_0");
+  EXPECT_NE (sink_handle, nullptr);
+
+  g_signal_connect (sink_handle, "new-data", (GCallback)new_data_cb, (gpointer)&idx_invalid);
+  gst_object_unref (sink_handle);
+
+  sink_handle = gst_bin_get_by_name (GST_BIN (pipeline), "sink_1");
+  EXPECT_NE (sink_handle, nullptr);
+
+  g_signal_connect (sink_handle, "new-data", (GCallback)new_data_cb, (gpointer)&idx_then);
+  gst_object_unref (sink_handle);
+
+  sink_handle = gst_bin_get_by_name (GST_BIN (pipeline), "sink_2");
+  EXPECT_NE (sink_handle, nullptr);
+
+  g_signal_connect (sink_handle, "new-data", (GCallback)new_data_cb, (gpointer)&idx_else);
+  gst_object_unref (sink_handle);
+
+  buf_0 = gst_buffer_new ();
+  for (i = 0; i < 2; i++) {
+    gboolean ret;
+    mem = gst_allocator_alloc (NULL, 192, NULL);
+    ret = gst_memory_map (mem, &info, GST_MAP_WRITE);
+    ASSERT_TRUE (ret);
+    memcpy (info.data, test_frames[i], 192);
+    gst_memory_unmap (mem, &info);
+    gst_buffer_append_memory (buf_0, mem);
+  }
+  buf_1 = gst_buffer_copy (buf_0);
+
+  data_received = 0;
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (100000);
+
+  /* max value of 2nd tensor is 2224, 2nd condition is TRUE */
+  EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (appsrc_handle), buf_0), GST_FLOW_OK);
+  g_usleep (100000);
+
+  /* none of the conditions is TRUE */
+  g_object_set (tif_handle, "conditions", "GT:3000;LT:1000", NULL);
+
+  EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (appsrc_handle), buf_1), GST_FLOW_OK);
+  g_usleep (100000);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  g_usleep (100000);
+
+  EXPECT_EQ (2, data_received);
+
+  gst_object_unref (appsrc_handle);
+  gst_object_unref (tif_handle);
+  gst_object_unref (pipeline);
+  g_free (str_pipeline);
+}
+
 /**
  * @brief custom callback function
  */
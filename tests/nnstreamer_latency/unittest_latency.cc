@@ -44,6 +44,44 @@ protected:
   gboolean latency_report;
   guint64 filter_latency_ms;
   GstElement *pipeline;
+  GArray *frame_latencies; /**< latency of the frames arriving at the sink (ms) */
+  gint64 first_frame_time;
+  gint64 last_frame_time;
+
+  /**
+   * @brief Pad probe recording the latency of the frames arriving at the sink.
+   *        The latency is the running time at the sink minus the timestamp
+   *        from the live source, before the sink waits for the clock.
+   */
+  static GstPadProbeReturn frameProbe (GstPad * pad,
+      GstPadProbeInfo * info, gpointer user_data) {
+    NNSLatencyTest *self = (NNSLatencyTest *) user_data;
+    GstBuffer *buffer = GST_PAD_PROBE_INFO_BUFFER (info);
+    GstElement *sink = GST_ELEMENT (gst_pad_get_parent (pad));
+    GstClock *clock = gst_element_get_clock (sink);
+    gint64 now = g_get_monotonic_time ();
+
+    if (clock && GST_BUFFER_PTS_IS_VALID (buffer)) {
+      GstClockTime running_time = gst_clock_get_time (clock) -
+          gst_element_get_base_time (sink);
+
+      if (running_time >= GST_BUFFER_PTS (buffer)) {
+        gdouble latency_ms = (gdouble) (running_time -
+            GST_BUFFER_PTS (buffer)) / GST_MSECOND;
+
+        g_array_append_val (self->frame_latencies, latency_ms);
+      }
+    }
+
+    if (self->first_frame_time == 0)
+      self->first_frame_time = now;
+    self->last_frame_time = now;
+
+    if (clock)
+      gst_object_unref (clock);
+    gst_object_unref (sink);
+    return GST_PAD_PROBE_OK;
+  }
 
 
   /**
@@ -52,6 +90,8 @@ protected:
   void SetUp () override {
     latency_report = FALSE;
     filter_latency_ms = 0UL;
+    frame_latencies = g_array_new (FALSE, FALSE, sizeof (gdouble));
+    first_frame_time = last_frame_time = 0;
   }
 
   /**
@@ -60,6 +100,8 @@ protected:
   void TearDown () override {
     gst_object_unref (pipeline);
     pipeline = nullptr;
+    g_array_free (frame_latencies, TRUE);
+    frame_latencies = nullptr;
   }
 
   /**
@@ -112,8 +154,16 @@ protected:
 
     g_printf ("pipeline: %s\n", pipeline_str);
     pipeline = gst_parse_launch (pipeline_str, nullptr);
+    if (pipeline == nullptr)
+      return FALSE;
 
-    return pipeline != nullptr ? TRUE : FALSE;
+    GstElement *sink = gst_bin_get_by_name (GST_BIN (pipeline), SINK_NAME);
+    GstPad *pad = gst_element_get_static_pad (sink, "sink");
+    gst_pad_add_probe (pad, GST_PAD_PROBE_TYPE_BUFFER, frameProbe, this, nullptr);
+    gst_object_unref (pad);
+    gst_object_unref (sink);
+
+    return TRUE;
   }
 
   /**
@@ -171,6 +221,37 @@ protected:
     return TRUE;
   }
 
+  /**
+   * @brief Report the frame rate and latency percentiles at the sink with the
+   *        pipeline latency, if NNSTREAMER_PERF_REPORT is given.
+   *        Call this after stopping the pipeline.
+   */
+  void reportPerformance (guint64 pipeline_latency_ms) {
+    const ::testing::TestInfo *test_info =
+        ::testing::UnitTest::GetInstance ()->current_test_info ();
+    gdouble fps = 0.0;
+    guint frames = frame_latencies->len;
+
+    if (!unittest_perf_enabled ())
+      return;
+
+    if (frames > 1 && last_frame_time > first_frame_time)
+      fps = (frames - 1) * (gdouble) G_USEC_PER_SEC /
+          (last_frame_time - first_frame_time);
+
+    g_autofree gchar *metrics = g_strdup_printf ("\"frames\": %u, "
+        "\"fps\": %.2f, \"latency_p50_ms\": %.3f, \"latency_p90_ms\": %.3f, "
+        "\"latency_p99_ms\": %.3f, \"pipeline_latency_ms\": %" G_GUINT64_FORMAT,
+        frames, fps,
+        unittest_perf_percentile (frame_latencies, 50.0),
+        unittest_perf_percentile (frame_latencies, 90.0),
+        unittest_perf_percentile (frame_latencies, 99.0),
+        pipeline_latency_ms);
+
+    EXPECT_TRUE (unittest_perf_report ("unittest_latency", test_info->name (),
+        metrics));
+  }
+
 };
 
 const gchar * NNSLatencyTest::custom_dir = nullptr;
@@ -206,6 +287,8 @@ TEST_F (NNSLatencyTest, noTensorFilterLatencyReport)
   g_printf ("min_ms:%" G_GUINT64_FORMAT " threshold:%" G_GUINT64_FORMAT "\n",
             min_ms, threshold_ms);
   EXPECT_LE (min_ms, threshold_ms);
+
+  reportPerformance (min_ms);
 }
 
 /**
@@ -239,6 +322,8 @@ TEST_F (NNSLatencyTest, TensorFilterLatencyReport)
             threshold_max);
   EXPECT_GE (min_ms, threshold_min);
   EXPECT_LE (min_ms, threshold_max);
+
+  reportPerformance (min_ms);
 }
 
 
@@ -71,6 +71,11 @@ gstTest "--gst-plugin-path=${PATH_TO_PLUGIN}  tensor_merge name=merge mode=linea
 
 callCompareTest batch.golden batch.log 10 "Compare 10" 1 0
 
+# Merge along the outermost dimension, the upstream tensor_transform writes the tensors into the slices of the merged tensor (buffer pool of tensor_merge).
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN}  tensor_merge name=merge mode=linear option=3 ! filesink location=batch_pool.log filesrc location=batch_1.dat blocksize=60000 num_buffers=1 ! application/octet-stream ! tensor_converter input-dim=3:100:50:1 input-type=float32 ! tensor_transform mode=typecast option=float64 ! tensor_transform mode=typecast option=float32 ! merge.sink_0 filesrc location=batch_2.dat blocksize=120000 num_buffers=1 ! application/octet-stream ! tensor_converter input-dim=3:100:50:2 input-type=float32 ! tensor_transform mode=typecast option=float64 ! tensor_transform mode=typecast option=float32 ! merge.sink_1 filesrc location=batch_3.dat blocksize=180000 num_buffers=1 ! application/octet-stream ! tensor_converter input-dim=3:100:50:3 input-type=float32 ! tensor_transform mode=typecast option=float64 ! tensor_transform mode=typecast option=float32 ! merge.sink_2" 10-1 0 0 $PERFORMANCE
+
+callCompareTest batch.golden batch_pool.log 10-1 "Compare 10-1" 1 0
+
 gstTest "--gst-plugin-path=${PATH_TO_PLUGIN}  tensor_merge name=merge mode=linear option=2 silent=true sync-mode=slowest ! multifilesink location=testsynch00_%1d.log multifilesrc location=\"testsequence03_%1d.png\" index=0 caps=\"image/png, framerate=(fraction)30/1\" ! pngdec ! tensor_converter ! merge.sink_0 multifilesrc location=\"testsequence03_%1d.png\" index=0 caps=\"image/png, framerate=(fraction)10/1\" ! pngdec ! tensor_converter ! merge.sink_1" 11 0 0 $PERFORMANCE
 
 callCompareTest testsynch00_0.golden testsynch00_0.log 11-1 "Compare 11-1" 1 0
@@ -13,6 +13,8 @@
 #include <gst/check/gstharness.h>
 #include <gst/check/gsttestclock.h>
 #include <gst/gst.h>
+#include <gst/video/video.h>
+#include <math.h>
 #include <nnstreamer_plugin_api_converter.h>
 #include <nnstreamer_plugin_api_decoder.h>
 #include <nnstreamer_plugin_api_filter.h>
@@ -1945,6 +1947,80 @@ TEST (testTensorTransform, arithmeticPerChannel)
   gst_harness_teardown (h);
 }
 
+/**
+ * @brief Test for tensor_transform arithmetic with a large tensor (processed block by block)
+ */
+TEST (testTensorTransform, arithmeticFused)
+{
+  const guint num_buffers = 2;
+  const guint array_size = 3 * 64 * 48;
+
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMemory *mem;
+  GstMapInfo info;
+  guint i, b;
+  gsize data_in_size, data_out_size;
+
+  h = gst_harness_new ("tensor_transform");
+
+  g_object_set (h->element, "mode", GTT_ARITHMETIC, "option",
+      "typecast:float32,add:-127.5,div:127.5", NULL);
+  g_object_set (h->element, "acceleration", (gboolean) FALSE, NULL);
+
+  /* input tensor info */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:64:48:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+  data_in_size = gst_tensors_info_get_size (&config.info, 0);
+
+  config.info.info[0].type = _NNS_FLOAT32;
+  data_out_size = gst_tensors_info_get_size (&config.info, 0);
+
+  /* push buffers */
+  for (b = 0; b < num_buffers; b++) {
+    /* set input buffer */
+    in_buf = gst_harness_create_buffer (h, data_in_size);
+
+    mem = gst_buffer_peek_memory (in_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+
+    for (i = 0; i < array_size; i++)
+      ((uint8_t *) info.data)[i] = (uint8_t) ((i * 7 + b) % 256);
+
+    gst_memory_unmap (mem, &info);
+
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+    /* get output buffer */
+    out_buf = gst_harness_pull (h);
+
+    ASSERT_TRUE (out_buf != NULL);
+    ASSERT_EQ (gst_buffer_n_memory (out_buf), 1U);
+    ASSERT_EQ (gst_buffer_get_size (out_buf), data_out_size);
+
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+
+    for (i = 0; i < array_size; i++) {
+      float expected = ((float) ((i * 7 + b) % 256) - 127.5f) / 127.5f;
+      EXPECT_FLOAT_EQ (((float *) info.data)[i], expected);
+    }
+
+    gst_memory_unmap (mem, &info);
+    gst_buffer_unref (out_buf);
+  }
+
+  EXPECT_EQ (gst_harness_buffers_received (h), num_buffers);
+  gst_harness_teardown (h);
+}
+
 /**
  * @brief Test for tensor_transform arithmetic (changing option string dynamically)
  */
@@ -2760,6 +2836,55 @@ TEST (testTensorAggregator, flushData)
   gst_harness_teardown (h);
 }
 
+/**
+ * @brief Test for tensor_aggregator (sliding window, frames wrap around the ring buffer)
+ */
+TEST (testTensorAggregator, slidingWindow)
+{
+  GstHarness *h;
+  GstTensorsConfig config;
+  gint data[4], expected[12];
+  guint i, j;
+  gsize data_size;
+
+  h = gst_harness_new ("tensor_aggregator");
+
+  g_object_set (h->element, "frames-out", 3, "frames-flush", 1, "frames-dim", 1, NULL);
+
+  /* set input tensor info and pad caps */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1;
+  config.info.info[0].type = _NNS_INT32;
+  gst_tensor_parse_dimension ("4:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+  data_size = gst_tensors_info_get_size (&config.info, 0);
+
+  /* push 30 frames, outputs are pulled after 20 frames (held in harness pad) */
+  for (i = 0; i < 30; i++) {
+    for (j = 0; j < 4; j++)
+      data[j] = i * 10 + j;
+    _aggregator_test_push_buffer (h, data, data_size);
+
+    if (i >= 2 && i < 20) {
+      for (j = 0; j < 12; j++)
+        expected[j] = (i - 2 + j / 4) * 10 + (j % 4);
+      _aggregator_test_check_output (h, expected, 12);
+    }
+  }
+
+  for (i = 20; i < 30; i++) {
+    for (j = 0; j < 12; j++)
+      expected[j] = (i - 2 + j / 4) * 10 + (j % 4);
+    _aggregator_test_check_output (h, expected, 12);
+  }
+
+  EXPECT_EQ (gst_harness_buffers_received (h), 28U);
+  gst_harness_teardown (h);
+}
+
 /**
  * @brief Test for tensor_aggregator (supposed multi clients using tensor-meta)
  */
@@ -2870,6 +2995,92 @@ TEST (testTensorAggregator, multiClients)
   gst_harness_teardown (h);
 }
 
+/**
+ * @brief Test for tensor_aggregator (multi clients aggregated with workers)
+ */
+TEST (testTensorAggregator, multiClientsWorkers)
+{
+  GstHarness *h;
+  GstBuffer *input, *output;
+  GstMetaQuery *meta;
+  GstTensorsConfig config;
+  GstMemory *mem;
+  GstMapInfo map;
+  guint i, c, received, num_workers;
+  gsize data_size;
+  gint *data;
+  const guint num_clients = 8;
+  const guint num_frames = 10;
+  gint last[8];
+
+  h = gst_harness_new ("tensor_aggregator");
+
+  /* input 1 frame / output 2 frames, the clients are sharded over 3 workers */
+  g_object_set (h->element, "frames-in", 1, "frames-out", 2, "frames-dim", 1,
+      "num-workers", 3, NULL);
+  g_object_get (h->element, "num-workers", &num_workers, NULL);
+  EXPECT_EQ (num_workers, 3U);
+
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1;
+  config.info.info[0].type = _NNS_INT32;
+  gst_tensor_parse_dimension ("4:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+  data_size = gst_tensors_info_get_size (&config.info, 0);
+
+  /* push the frames of the clients in turn, the value is (client * 100 + index) */
+  for (i = 0; i < num_frames; i++) {
+    for (c = 0; c < num_clients; c++) {
+      input = gst_harness_create_buffer (h, data_size);
+      mem = gst_buffer_peek_memory (input, 0);
+      ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_WRITE));
+      data = (gint *) map.data;
+      data[0] = data[1] = data[2] = data[3] = (gint) (c * 100 + i);
+      gst_memory_unmap (mem, &map);
+
+      meta = gst_buffer_add_meta_query (input);
+      meta->client_id = c;
+
+      EXPECT_EQ (gst_harness_push (h, input), GST_FLOW_OK);
+    }
+  }
+
+  received = _harness_wait_for_output_buffer (h, num_clients * num_frames / 2);
+  EXPECT_EQ (received, num_clients * num_frames / 2);
+
+  /* the windows of each client should be in order */
+  for (c = 0; c < num_clients; c++)
+    last[c] = -1;
+
+  for (i = 0; i < received; i++) {
+    output = gst_harness_pull (h);
+    meta = gst_buffer_get_meta_query (output);
+    ASSERT_TRUE (meta != NULL);
+    c = meta->client_id;
+    ASSERT_LT (c, num_clients);
+
+    mem = gst_buffer_peek_memory (output, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+    ASSERT_EQ (map.size, data_size * 2);
+    data = (gint *) map.data;
+
+    EXPECT_EQ (data[0], (gint) (c * 100) + last[c] + 1);
+    EXPECT_EQ (data[4], data[0] + 1);
+    last[c] = data[4] - (gint) (c * 100);
+
+    gst_memory_unmap (mem, &map);
+    gst_buffer_unref (output);
+  }
+
+  for (c = 0; c < num_clients; c++)
+    EXPECT_EQ (last[c], (gint) num_frames - 1);
+
+  gst_harness_teardown (h);
+}
+
 /**
  * @brief Test for tensor_converter (bytes to multi tensors)
  */
@@ -3036,6 +3247,54 @@ TEST (testTensorConverter, bytesToMulti2)
   gst_harness_teardown (h);
 }
 
+/**
+ * @brief Test for tensor_converter (bytes to multi tensors sharing the incoming memory)
+ */
+TEST (testTensorConverter, bytesToMultiZeroCopy)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstCaps *caps;
+  GstMemory *mem[2];
+  gsize offset;
+
+  h = gst_harness_new ("tensor_converter");
+
+  g_object_set (h->element, "input-dim", "4:2,4:2,8:1", "input-type",
+      "int32,int32,uint8", NULL);
+
+  caps = gst_caps_from_string ("application/octet-stream");
+  gst_harness_set_src_caps (h, caps);
+
+  /* 1st block has 1st and 2nd tensors, 2nd block is 3rd tensor */
+  mem[0] = gst_allocator_alloc (NULL, 64, NULL);
+  mem[1] = gst_allocator_alloc (NULL, 8, NULL);
+  in_buf = gst_buffer_new ();
+  gst_buffer_append_memory (in_buf, gst_memory_ref (mem[0]));
+  gst_buffer_append_memory (in_buf, gst_memory_ref (mem[1]));
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_n_memory (out_buf), 3U);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), 72U);
+
+  /* shared ranges of the 1st block and the 2nd block itself */
+  EXPECT_TRUE (gst_buffer_peek_memory (out_buf, 0)->parent == mem[0]);
+  EXPECT_TRUE (gst_memory_is_span (gst_buffer_peek_memory (out_buf, 0),
+      gst_buffer_peek_memory (out_buf, 1), &offset));
+  EXPECT_EQ (offset, 0U);
+  EXPECT_TRUE (gst_buffer_peek_memory (out_buf, 2) == mem[1]);
+
+  gst_buffer_unref (out_buf);
+  gst_memory_unref (mem[0]);
+  gst_memory_unref (mem[1]);
+
+  EXPECT_EQ (gst_harness_buffers_received (h), 1U);
+  gst_harness_teardown (h);
+}
+
 /**
  * @brief Test for tensor_converter (bytes to multi tensors)
  */
@@ -3384,103 +3643,482 @@ TEST (testTensorConverter, bytesToStatic)
 }
 
 /**
- * @brief Test for tensor_converter (bytes to flex tensor)
+ * @brief Test for tensor_converter (video with unaligned width, frames from the video pool)
  */
-TEST (testTensorConverter, bytesToFlex)
+TEST (testTensorConverter, videoPoolPacked)
 {
   GstHarness *h;
-  GstCaps *caps;
   GstBuffer *in_buf, *out_buf;
-  GstMemory *mem;
-  GstTensorMetaInfo meta;
-  guint i, received;
-  gsize data_size;
+  GstVideoMeta *vmeta;
+  GstMapInfo map;
+  gpointer in_data;
+  guint i;
 
   h = gst_harness_new ("tensor_converter");
+  g_object_set (h->element, "video-pool", (gboolean) TRUE, NULL);
 
-  /* in/out caps */
-  caps = gst_caps_from_string (GST_TENSORS_FLEX_CAP_DEFAULT);
-  gst_caps_set_simple (caps, "framerate", GST_TYPE_FRACTION, 0, 1, NULL);
-  gst_harness_set_sink_caps (h, caps);
+  /* upstream uses the video pool proposed by tensor_converter */
+  gst_harness_set_src_caps_str (h,
+      "video/x-raw,format=RGB,width=5,height=4,framerate=(fraction)30/1");
 
-  caps = gst_caps_from_string ("application/octet-stream");
-  gst_harness_set_src_caps (h, caps);
+  in_buf = gst_harness_create_buffer (h, 60);
+  vmeta = gst_buffer_get_video_meta (in_buf);
+  ASSERT_TRUE (vmeta != NULL);
+  EXPECT_EQ (vmeta->stride[0], 15);
 
-  /* push buffers */
-  for (i = 1; i <= 3; i++) {
-    data_size = i * 10U;
+  ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_WRITE));
+  for (i = 0; i < 60; i++)
+    map.data[i] = (guint8) i;
+  in_data = map.data;
+  gst_buffer_unmap (in_buf, &map);
 
-    in_buf = gst_harness_create_buffer (h, data_size);
-    EXPECT_EQ (GST_FLOW_OK, gst_harness_push (h, in_buf));
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), 60U);
 
-    received = _harness_wait_for_output_buffer (h, i);
-    EXPECT_EQ (received, i);
+  /* no copy */
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  EXPECT_EQ (map.data, in_data);
+  for (i = 0; i < 60; i++)
+    EXPECT_EQ (map.data[i], (guint8) i);
+  gst_buffer_unmap (out_buf, &map);
 
-    out_buf = gst_harness_pull (h);
-    EXPECT_EQ (gst_buffer_n_memory (out_buf), 1U);
-    mem = gst_buffer_peek_memory (out_buf, 0);
-    gst_tensor_meta_info_parse_memory (&meta, mem);
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+}
 
-    EXPECT_EQ (meta.type, _NNS_UINT8);
-    EXPECT_EQ (meta.dimension[0], data_size);
-    EXPECT_EQ (meta.dimension[1], 1U);
-    EXPECT_EQ ((media_type) meta.media_type, _NNS_OCTET);
+/**
+ * @brief Test for tensor_converter (video with unaligned width, the stride from the video meta)
+ */
+TEST (testTensorConverter, videoMetaStride)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstMapInfo map;
+  gsize offset[GST_VIDEO_MAX_PLANES] = { 0, };
+  gint stride[GST_VIDEO_MAX_PLANES] = { 0, };
+  guint i, row, col;
 
-    data_size = gst_tensor_meta_info_get_header_size (&meta);
-    data_size += gst_tensor_meta_info_get_data_size (&meta);
+  h = gst_harness_new ("tensor_converter");
+  gst_harness_set_src_caps_str (h,
+      "video/x-raw,format=GRAY8,width=5,height=4,framerate=(fraction)30/1");
 
-    EXPECT_EQ (gst_buffer_get_size (out_buf), data_size);
-    gst_buffer_unref (out_buf);
+  /* each row has 3 bytes of padding */
+  in_buf = gst_harness_create_buffer (h, 32);
+  ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_WRITE));
+  for (i = 0; i < 32; i++)
+    map.data[i] = (guint8) i;
+  gst_buffer_unmap (in_buf, &map);
+
+  stride[0] = 8;
+  gst_buffer_add_video_meta_full (in_buf, GST_VIDEO_FRAME_FLAG_NONE,
+      GST_VIDEO_FORMAT_GRAY8, 5, 4, 1, offset, stride);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), 20U);
+
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  for (row = 0; row < 4; row++) {
+    for (col = 0; col < 5; col++)
+      EXPECT_EQ (map.data[row * 5 + col], (guint8) (row * 8 + col));
   }
+  gst_buffer_unmap (out_buf, &map);
 
+  gst_buffer_unref (out_buf);
   gst_harness_teardown (h);
 }
 
 /**
- * @brief Test for tensor_converter (bytes to flex tensor with invalid condition)
+ * @brief Test for tensor_converter (video in DMA-BUF, the memory is pushed without mapping it)
  */
-TEST (testTensorConverter, bytesToFlexInvalidFrames_n)
+TEST (testTensorConverter, videoDmaBufPassthrough)
 {
   GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstMemory *in_mem;
   GstCaps *caps;
-  GstBuffer *in_buf;
+  GstTensorsConfig config;
 
   h = gst_harness_new ("tensor_converter");
+  gst_harness_set_src_caps_str (h,
+      "video/x-raw(memory:DMABuf),format=RGB,width=4,height=2,framerate=(fraction)30/1");
 
-  /* cannot configure multi tensors if output is flex tensor. */
-  g_object_set (h->element, "frames-per-tensor", "2", NULL);
-
-  /* in/out caps */
-  caps = gst_caps_from_string (GST_TENSORS_FLEX_CAP_DEFAULT);
-  gst_caps_set_simple (caps, "framerate", GST_TYPE_FRACTION, 0, 1, NULL);
-  gst_harness_set_sink_caps (h, caps);
-
-  caps = gst_caps_from_string ("application/octet-stream");
-  gst_harness_set_src_caps (h, caps);
+  in_buf = gst_harness_create_buffer (h, 24);
+  in_mem = gst_buffer_peek_memory (in_buf, 0);
 
-  /* push buffers */
-  in_buf = gst_harness_create_buffer (h, 100U);
-  EXPECT_EQ (GST_FLOW_NOT_NEGOTIATED, gst_harness_push (h, in_buf));
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_n_memory (out_buf), 1U);
+  EXPECT_EQ (gst_buffer_peek_memory (out_buf, 0), in_mem);
+
+  /* the tensor stream does not have the caps feature */
+  caps = gst_pad_get_current_caps (h->sinkpad);
+  ASSERT_TRUE (caps != NULL);
+  EXPECT_TRUE (gst_caps_features_is_equal (gst_caps_get_features (caps, 0),
+      GST_CAPS_FEATURES_MEMORY_SYSTEM_MEMORY));
+  EXPECT_TRUE (gst_tensors_config_from_structure (&config,
+      gst_caps_get_structure (caps, 0)));
+  EXPECT_EQ (config.info.info[0].dimension[0], 3U);
+  EXPECT_EQ (config.info.info[0].dimension[1], 4U);
+  EXPECT_EQ (config.info.info[0].dimension[2], 2U);
+  gst_tensors_config_free (&config);
+  gst_caps_unref (caps);
 
-  EXPECT_EQ (gst_harness_buffers_received (h), 0U);
+  gst_buffer_unref (out_buf);
   gst_harness_teardown (h);
 }
 
 /**
- * @brief Test for tensor_converter (flexible to static tensor)
+ * @brief Test for tensor_converter (audio, overlapped windows with frames-hop)
  */
-TEST (testTensorConverter, flexToStaticTensor)
+TEST (testTensorConverter, audioFramesHop)
 {
   GstHarness *h;
   GstBuffer *in_buf, *out_buf;
-  GstMemory *mem;
   GstMapInfo map;
-  GstTensorMetaInfo meta;
-  GstTensorsInfo info;
-  GstCaps *caps;
-  guint8 *data;
-  guint i, j, received, *value;
-  gsize data_size, hsize;
+  gint16 *data;
+  guint i, k;
+
+  h = gst_harness_new ("tensor_converter");
+  g_object_set (h->element, "frames-per-tensor", 4U, "frames-hop", 2U, NULL);
+  gst_harness_set_src_caps_str (h,
+      "audio/x-raw,format=S16LE,rate=16000,channels=1,layout=interleaved");
+
+  /* 10 frames in 2 buffers */
+  for (k = 0; k < 2; k++) {
+    in_buf = gst_harness_create_buffer (h, 5 * sizeof (gint16));
+    ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_WRITE));
+    data = (gint16 *) map.data;
+    for (i = 0; i < 5; i++)
+      data[i] = (gint16) (k * 5 + i);
+    gst_buffer_unmap (in_buf, &map);
+
+    EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  }
+
+  /* windows: 0-3, 2-5, 4-7, 6-9 */
+  EXPECT_EQ (gst_harness_buffers_received (h), 4U);
+
+  for (k = 0; k < 4; k++) {
+    out_buf = gst_harness_pull (h);
+    ASSERT_TRUE (out_buf != NULL);
+    ASSERT_EQ (gst_buffer_get_size (out_buf), 4 * sizeof (gint16));
+
+    ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+    data = (gint16 *) map.data;
+    for (i = 0; i < 4; i++)
+      EXPECT_EQ (data[i], (gint16) (k * 2 + i));
+    gst_buffer_unmap (out_buf, &map);
+
+    /* the overlapped frames are read-only */
+    EXPECT_TRUE (GST_MEMORY_IS_READONLY (gst_buffer_peek_memory (out_buf, 0)));
+    gst_buffer_unref (out_buf);
+  }
+
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_converter (preprocess mode, color order, resize and normalize in a single pass)
+ */
+TEST (testTensorConverter, videoPreprocess)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstMapInfo map;
+  gchar *mode = NULL;
+  gfloat *data;
+  guint x, y;
+  const gfloat expected[] = { 25.0f, 35.0f, 20.0f, 22.0f, 200.0f, 198.0f };
+
+  h = gst_harness_new ("tensor_converter");
+  g_object_set (h->element, "mode",
+      "preprocess:width=2,height=1,type=float32,color=rgb,layout=nchw,mean=5/0.5/-0.5,std=2/1/1",
+      NULL);
+  g_object_get (h->element, "mode", &mode, NULL);
+  EXPECT_STREQ (mode,
+      "preprocess:width=2,height=1,type=float32,color=rgb,layout=nchw,mean=5/0.5/-0.5,std=2/1/1");
+  g_free (mode);
+
+  gst_harness_set_src_caps_str (h,
+      "video/x-raw,format=BGRx,width=4,height=2,framerate=(fraction)30/1");
+
+  /* R = 10x + 100y, G = 20 + x, B = 200 - x */
+  in_buf = gst_harness_create_buffer (h, 4 * 4 * 2);
+  ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_WRITE));
+  for (y = 0; y < 2; y++) {
+    for (x = 0; x < 4; x++) {
+      map.data[(y * 4 + x) * 4 + 0] = (guint8) (200 - x);
+      map.data[(y * 4 + x) * 4 + 1] = (guint8) (20 + x);
+      map.data[(y * 4 + x) * 4 + 2] = (guint8) (10 * x + 100 * y);
+      map.data[(y * 4 + x) * 4 + 3] = 0;
+    }
+  }
+  gst_buffer_unmap (in_buf, &map);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), 6 * sizeof (gfloat));
+
+  /* each output pixel is the average of 2x2 pixels, channels are in the order of R, G and B */
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  data = (gfloat *) map.data;
+  for (x = 0; x < 6; x++)
+    EXPECT_FLOAT_EQ (data[x], expected[x]);
+  gst_buffer_unmap (out_buf, &map);
+
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_converter (NV12, the planes are the tensors without copying)
+ */
+TEST (testTensorConverter, videoNV12Planes)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstCaps *caps;
+  GstTensorsConfig config;
+  GstMapInfo map;
+  guint i;
+
+  h = gst_harness_new ("tensor_converter");
+  gst_harness_set_src_caps_str (h,
+      "video/x-raw,format=NV12,width=4,height=2,framerate=(fraction)30/1");
+
+  /* Y (4 x 2) and UV (2 x 1) */
+  in_buf = gst_harness_create_buffer (h, 12);
+  ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_WRITE));
+  for (i = 0; i < 12; i++)
+    map.data[i] = (guint8) i;
+  gst_buffer_unmap (in_buf, &map);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_n_memory (out_buf), 2U);
+
+  ASSERT_TRUE (gst_memory_map (gst_buffer_peek_memory (out_buf, 0), &map, GST_MAP_READ));
+  ASSERT_EQ (map.size, 8U);
+  for (i = 0; i < 8; i++)
+    EXPECT_EQ (map.data[i], i);
+  gst_memory_unmap (gst_buffer_peek_memory (out_buf, 0), &map);
+
+  ASSERT_TRUE (gst_memory_map (gst_buffer_peek_memory (out_buf, 1), &map, GST_MAP_READ));
+  ASSERT_EQ (map.size, 4U);
+  for (i = 0; i < 4; i++)
+    EXPECT_EQ (map.data[i], 8 + i);
+  gst_memory_unmap (gst_buffer_peek_memory (out_buf, 1), &map);
+
+  caps = gst_pad_get_current_caps (h->sinkpad);
+  ASSERT_TRUE (caps != NULL);
+  EXPECT_TRUE (gst_tensors_config_from_structure (&config,
+      gst_caps_get_structure (caps, 0)));
+  EXPECT_EQ (config.info.num_tensors, 2U);
+  EXPECT_EQ (config.info.info[0].dimension[0], 1U);
+  EXPECT_EQ (config.info.info[0].dimension[1], 4U);
+  EXPECT_EQ (config.info.info[0].dimension[2], 2U);
+  EXPECT_EQ (config.info.info[1].dimension[0], 2U);
+  EXPECT_EQ (config.info.info[1].dimension[1], 2U);
+  EXPECT_EQ (config.info.info[1].dimension[2], 1U);
+  gst_tensors_config_free (&config);
+  gst_caps_unref (caps);
+
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_converter (I420 with the row padding, the planes are copied without the padding)
+ */
+TEST (testTensorConverter, videoI420PaddedPlanes)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstMapInfo map;
+  guint i, p;
+  /* the strides of the planes are 8, 4 and 4 */
+  const gsize offset[] = { 0, 16, 20 };
+  const gsize size[] = { 12, 3, 3 };
+  const gsize stride[] = { 8, 4, 4 };
+  const gsize width[] = { 6, 3, 3 };
+
+  h = gst_harness_new ("tensor_converter");
+  gst_harness_set_src_caps_str (h,
+      "video/x-raw,format=I420,width=6,height=2,framerate=(fraction)30/1");
+
+  in_buf = gst_harness_create_buffer (h, 24);
+  ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_WRITE));
+  for (i = 0; i < 24; i++)
+    map.data[i] = (guint8) i;
+  gst_buffer_unmap (in_buf, &map);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_n_memory (out_buf), 3U);
+
+  for (p = 0; p < 3; p++) {
+    GstMemory *mem = gst_buffer_peek_memory (out_buf, p);
+
+    ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+    ASSERT_EQ (map.size, size[p]);
+    for (i = 0; i < size[p]; i++)
+      EXPECT_EQ (map.data[i], offset[p] + stride[p] * (i / width[p]) + i % width[p]);
+    gst_memory_unmap (mem, &map);
+  }
+
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_converter (preprocess mode, NV12 to RGB without the intermediate frame)
+ */
+TEST (testTensorConverter, videoPreprocessNV12)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstMapInfo map;
+  guint i;
+
+  h = gst_harness_new ("tensor_converter");
+  g_object_set (h->element, "mode", "preprocess:color=rgb", NULL);
+  gst_harness_set_src_caps_str (h,
+      "video/x-raw,format=NV12,width=4,height=2,colorimetry=bt601,framerate=(fraction)30/1");
+
+  /* Y = 126, U = 128, V = 192 */
+  in_buf = gst_harness_create_buffer (h, 12);
+  ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_WRITE));
+  memset (map.data, 126, 8);
+  for (i = 8; i < 12; i += 2) {
+    map.data[i] = 128;
+    map.data[i + 1] = 192;
+  }
+  gst_buffer_unmap (in_buf, &map);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), 4U * 2U * 3U);
+
+  /* BT.601 of the limited range */
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  for (i = 0; i < 8; i++) {
+    EXPECT_EQ (map.data[i * 3], 230);
+    EXPECT_EQ (map.data[i * 3 + 1], 76);
+    EXPECT_EQ (map.data[i * 3 + 2], 128);
+  }
+  gst_buffer_unmap (out_buf, &map);
+
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_converter (bytes to flex tensor)
+ */
+TEST (testTensorConverter, bytesToFlex)
+{
+  GstHarness *h;
+  GstCaps *caps;
+  GstBuffer *in_buf, *out_buf;
+  GstMemory *mem;
+  GstTensorMetaInfo meta;
+  guint i, received;
+  gsize data_size;
+
+  h = gst_harness_new ("tensor_converter");
+
+  /* in/out caps */
+  caps = gst_caps_from_string (GST_TENSORS_FLEX_CAP_DEFAULT);
+  gst_caps_set_simple (caps, "framerate", GST_TYPE_FRACTION, 0, 1, NULL);
+  gst_harness_set_sink_caps (h, caps);
+
+  caps = gst_caps_from_string ("application/octet-stream");
+  gst_harness_set_src_caps (h, caps);
+
+  /* push buffers */
+  for (i = 1; i <= 3; i++) {
+    data_size = i * 10U;
+
+    in_buf = gst_harness_create_buffer (h, data_size);
+    EXPECT_EQ (GST_FLOW_OK, gst_harness_push (h, in_buf));
+
+    received = _harness_wait_for_output_buffer (h, i);
+    EXPECT_EQ (received, i);
+
+    out_buf = gst_harness_pull (h);
+    EXPECT_EQ (gst_buffer_n_memory (out_buf), 1U);
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    gst_tensor_meta_info_parse_memory (&meta, mem);
+
+    EXPECT_EQ (meta.type, _NNS_UINT8);
+    EXPECT_EQ (meta.dimension[0], data_size);
+    EXPECT_EQ (meta.dimension[1], 1U);
+    EXPECT_EQ ((media_type) meta.media_type, _NNS_OCTET);
+
+    data_size = gst_tensor_meta_info_get_header_size (&meta);
+    data_size += gst_tensor_meta_info_get_data_size (&meta);
+
+    EXPECT_EQ (gst_buffer_get_size (out_buf), data_size);
+    gst_buffer_unref (out_buf);
+  }
+
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_converter (bytes to flex tensor with invalid condition)
+ */
+TEST (testTensorConverter, bytesToFlexInvalidFrames_n)
+{
+  GstHarness *h;
+  GstCaps *caps;
+  GstBuffer *in_buf;
+
+  h = gst_harness_new ("tensor_converter");
+
+  /* cannot configure multi tensors if output is flex tensor. */
+  g_object_set (h->element, "frames-per-tensor", "2", NULL);
+
+  /* in/out caps */
+  caps = gst_caps_from_string (GST_TENSORS_FLEX_CAP_DEFAULT);
+  gst_caps_set_simple (caps, "framerate", GST_TYPE_FRACTION, 0, 1, NULL);
+  gst_harness_set_sink_caps (h, caps);
+
+  caps = gst_caps_from_string ("application/octet-stream");
+  gst_harness_set_src_caps (h, caps);
+
+  /* push buffers */
+  in_buf = gst_harness_create_buffer (h, 100U);
+  EXPECT_EQ (GST_FLOW_NOT_NEGOTIATED, gst_harness_push (h, in_buf));
+
+  EXPECT_EQ (gst_harness_buffers_received (h), 0U);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_converter (flexible to static tensor)
+ */
+TEST (testTensorConverter, flexToStaticTensor)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstMemory *mem;
+  GstMapInfo map;
+  GstTensorMetaInfo meta;
+  GstTensorsInfo info;
+  GstCaps *caps;
+  guint8 *data;
+  guint i, j, received, *value;
+  gsize data_size, hsize;
 
   h = gst_harness_new ("tensor_converter");
 
@@ -3530,143 +4168,681 @@ TEST (testTensorConverter, flexToStaticTensor)
       0, data_size, data, g_free);
   gst_buffer_append_memory (in_buf, mem);
 
-  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  /* wait for output buffer */
+  received = _harness_wait_for_output_buffer (h, 1U);
+  ASSERT_EQ (received, 1U);
+
+  /* get output buffer */
+  out_buf = gst_harness_pull (h);
+  EXPECT_EQ (gst_buffer_n_memory (out_buf), 2U);
+
+  for (i = 0; i < gst_buffer_n_memory (out_buf); i++) {
+    mem = gst_buffer_peek_memory (out_buf, i);
+    ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+    EXPECT_EQ (map.size, gst_tensors_info_get_size (&info, i));
+    value = (guint *) map.data;
+
+    for (j = 0; j < (i + 1) * 10; j++)
+      EXPECT_EQ (value[j], j * (i + 1) * 10);
+
+    gst_memory_unmap (mem, &map);
+  }
+
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_converter (flexible to static tensor)
+ */
+TEST (testTensorConverter, flexToStaticInvalidBuffer1_n)
+{
+  GstHarness *h;
+  GstBuffer *in_buf;
+  GstMemory *mem;
+  GstTensorMetaInfo meta;
+  GstTensorInfo info;
+  GstCaps *caps;
+  gpointer data;
+  gsize data_size;
+
+  h = gst_harness_new ("tensor_converter");
+
+  g_object_set (h->element, "input-dim", "3:4:2:2,3:4:2:2", "input-type",
+      "int32,int32", NULL);
+
+  /* in/out caps and tensors info */
+  caps = gst_caps_from_string (GST_TENSORS_FLEX_CAP_DEFAULT);
+  gst_caps_set_simple (caps, "framerate", GST_TYPE_FRACTION, 0, 1, NULL);
+  gst_harness_set_src_caps (h, caps);
+
+  gst_tensor_info_init (&info);
+  info.type = _NNS_INT32;
+  gst_tensor_parse_dimension ("3:4:2:2", info.dimension);
+
+  /* push buffer (invalid number) */
+  in_buf = gst_buffer_new ();
+
+  gst_tensor_info_convert_to_meta (&info, &meta);
+  data_size = gst_tensor_meta_info_get_header_size (&meta);
+  data_size += gst_tensor_meta_info_get_data_size (&meta);
+
+  data = g_malloc0 (data_size);
+  gst_tensor_meta_info_update_header (&meta, data);
+
+  mem = gst_memory_new_wrapped ((GstMemoryFlags) 0, data, data_size,
+      0, data_size, data, g_free);
+  gst_buffer_append_memory (in_buf, mem);
+
+  EXPECT_NE (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  EXPECT_EQ (gst_harness_buffers_received (h), 0U);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_converter (flexible to static tensor)
+ */
+TEST (testTensorConverter, flexToStaticInvalidBuffer2_n)
+{
+  GstHarness *h;
+  GstBuffer *in_buf;
+  GstMemory *mem;
+  GstTensorMetaInfo meta;
+  GstTensorsInfo info;
+  GstCaps *caps;
+  gpointer data;
+  gsize data_size;
+
+  h = gst_harness_new ("tensor_converter");
+
+  g_object_set (h->element, "input-dim", "3:4:2:2,3:4:2:2", "input-type",
+      "int32,int32", NULL);
+
+  /* in/out caps and tensors info */
+  caps = gst_caps_from_string (GST_TENSORS_FLEX_CAP_DEFAULT);
+  gst_caps_set_simple (caps, "framerate", GST_TYPE_FRACTION, 0, 1, NULL);
+  gst_harness_set_src_caps (h, caps);
+
+  gst_tensors_info_init (&info);
+  info.num_tensors = 2;
+
+  info.info[0].type = _NNS_INT32;
+  gst_tensor_parse_dimension ("3:4:2:2", info.info[0].dimension);
+  info.info[1].type = _NNS_INT32;
+  gst_tensor_parse_dimension ("3:4:2:2", info.info[1].dimension);
+
+  /* push buffer (invalid buffer size) */
+  in_buf = gst_buffer_new ();
+
+  /* 1st mem block */
+  gst_tensor_info_convert_to_meta (&info.info[0], &meta);
+  data_size = gst_tensor_meta_info_get_header_size (&meta);
+  data_size += gst_tensor_meta_info_get_data_size (&meta);
+
+  data = g_malloc0 (data_size);
+  gst_tensor_meta_info_update_header (&meta, data);
+
+  mem = gst_memory_new_wrapped ((GstMemoryFlags) 0, data, data_size,
+      0, data_size, data, g_free);
+  gst_buffer_append_memory (in_buf, mem);
+
+  /* 2nd mem block (invalid size) */
+  gst_tensor_info_convert_to_meta (&info.info[1], &meta);
+  data_size = gst_tensor_meta_info_get_header_size (&meta);
+  data_size += gst_tensor_meta_info_get_data_size (&meta) / 2;
+
+  data = g_malloc0 (data_size);
+  gst_tensor_meta_info_update_header (&meta, data);
+
+  mem = gst_memory_new_wrapped ((GstMemoryFlags) 0, data, data_size,
+      0, data_size, data, g_free);
+  gst_buffer_append_memory (in_buf, mem);
+
+  EXPECT_NE (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  EXPECT_EQ (gst_harness_buffers_received (h), 0U);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Reference (element-by-element) transpose of 4D tensor.
+ */
+static void
+_transpose_reference (const guint *order, const guint *dim, gsize esize,
+    const uint8_t *in, uint8_t *out)
+{
+  guint od[4], idx[4], o[4], n;
+  gsize in_off, out_off;
+
+  for (n = 0; n < 4; n++)
+    od[n] = dim[order[n]];
+
+  for (idx[3] = 0; idx[3] < dim[3]; idx[3]++) {
+    for (idx[2] = 0; idx[2] < dim[2]; idx[2]++) {
+      for (idx[1] = 0; idx[1] < dim[1]; idx[1]++) {
+        for (idx[0] = 0; idx[0] < dim[0]; idx[0]++) {
+          for (n = 0; n < 4; n++)
+            o[n] = idx[order[n]];
+
+          in_off = (gsize) idx[3] * dim[2] + idx[2];
+          in_off = (in_off * dim[1] + idx[1]) * dim[0] + idx[0];
+          out_off = (gsize) o[3] * od[2] + o[2];
+          out_off = (out_off * od[1] + o[1]) * od[0] + o[0];
+          memcpy (out + out_off * esize, in + in_off * esize, esize);
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Push a tensor to tensor_transform and compare the result with the reference transpose.
+ */
+static void
+_transpose_check (const gchar *mode, const gchar *option, const guint *order,
+    const gchar *dim_str, tensor_type type, gint64 *elapsed)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMapInfo in_info, out_info;
+  guint dim[4] = { 1, 1, 1, 1 };
+  gsize i, size, esize;
+  uint8_t *expected;
+  gint64 start_ts;
+
+  h = gst_harness_new ("tensor_transform");
+  g_object_set (h->element, "mode",
+      (strcmp (mode, "dimchg") == 0) ? GTT_DIMCHG : GTT_TRANSPOSE, "option",
+      option, NULL);
+
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = type;
+  gst_tensor_parse_dimension (dim_str, config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  for (i = 0; i < 4; i++)
+    dim[i] = config.info.info[0].dimension[i];
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+  size = gst_tensors_info_get_size (&config.info, 0);
+  esize = gst_tensor_get_element_size (type);
+
+  in_buf = gst_harness_create_buffer (h, size);
+  ASSERT_TRUE (gst_buffer_map (in_buf, &in_info, GST_MAP_WRITE));
+  for (i = 0; i < size; i++)
+    in_info.data[i] = (uint8_t) (i * 7 + i / 3);
+
+  expected = (uint8_t *) g_malloc0 (size);
+  _transpose_reference (order, dim, esize, in_info.data, expected);
+  gst_buffer_unmap (in_buf, &in_info);
+
+  start_ts = g_get_monotonic_time ();
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  if (elapsed)
+    *elapsed = g_get_monotonic_time () - start_ts;
+
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), size);
+  ASSERT_TRUE (gst_buffer_map (out_buf, &out_info, GST_MAP_READ));
+  EXPECT_EQ (memcmp (out_info.data, expected, size), 0);
+  gst_buffer_unmap (out_buf, &out_info);
+
+  gst_buffer_unref (out_buf);
+  g_free (expected);
+  gst_harness_teardown (h);
+}
+
+/**
+ * @brief Test for tensor_transform transpose (all orders and element sizes, blocked kernels)
+ */
+TEST (testTensorTransform, transposeBlocked)
+{
+  const gchar *options[]
+      = { "1:2:0:3", "2:0:1:3", "1:0:2:3", "0:2:1:3", "2:1:0:3" };
+  const guint orders[][4] = { { 1, 2, 0, 3 }, { 2, 0, 1, 3 }, { 1, 0, 2, 3 },
+    { 0, 2, 1, 3 }, { 2, 1, 0, 3 } };
+  const tensor_type types[]
+      = { _NNS_UINT8, _NNS_INT16, _NNS_FLOAT32, _NNS_FLOAT64 };
+  guint i, t;
+
+  for (i = 0; i < G_N_ELEMENTS (options); i++) {
+    for (t = 0; t < G_N_ELEMENTS (types); t++) {
+      _transpose_check ("transpose", options[i], orders[i], "3:37:41:2",
+          types[t], NULL);
+      _transpose_check ("transpose", options[i], orders[i], "4:64:48:1",
+          types[t], NULL);
+      _transpose_check ("transpose", options[i], orders[i], "35:3:50:2",
+          types[t], NULL);
+    }
+  }
+}
+
+/**
+ * @brief Test for tensor_transform dimchg (blocked kernels)
+ */
+TEST (testTensorTransform, dimchgBlocked)
+{
+  const guint order_0_2[4] = { 1, 2, 0, 3 };
+  const guint order_0_1[4] = { 1, 0, 2, 3 };
+
+  _transpose_check ("dimchg", "0:2", order_0_2, "3:64:48:2", _NNS_UINT8, NULL);
+  _transpose_check (
+      "dimchg", "0:2", order_0_2, "4:64:48:1", _NNS_FLOAT32, NULL);
+  _transpose_check ("dimchg", "0:1", order_0_1, "33:65:4:1", _NNS_INT16, NULL);
+}
+
+/**
+ * @brief Test for tensor_transform transpose (performance, 1080p RGB NHWC to NCHW)
+ */
+TEST (testTensorTransform, transposePerformance)
+{
+  const guint order[4] = { 1, 2, 0, 3 };
+  const guint dim[4] = { 3, 1920, 1080, 1 };
+  const gsize size = 3 * 1920 * 1080;
+  gint64 start_ts, diff_loop, diff_transform = 0;
+  uint8_t *in, *out;
+
+  /* the element-by-element loop */
+  in = (uint8_t *) g_malloc0 (size);
+  out = (uint8_t *) g_malloc0 (size);
+
+  start_ts = g_get_monotonic_time ();
+  _transpose_reference (order, dim, 1, in, out);
+  diff_loop = g_get_monotonic_time () - start_ts;
+  _print_log ("transpose 1080p RGB loop: %" G_GINT64_FORMAT, diff_loop);
+
+  g_free (in);
+  g_free (out);
+
+  /* tensor_transform (including the buffer handling in the harness) */
+  _transpose_check ("transpose", "1:2:0:3", order, "3:1920:1080:1",
+      _NNS_UINT8, &diff_transform);
+  _print_log ("transpose 1080p RGB tensor_transform: %" G_GINT64_FORMAT,
+      diff_transform);
+
+  _transpose_check ("dimchg", "0:2", order, "3:1920:1080:1", _NNS_UINT8,
+      &diff_transform);
+  _print_log ("dimchg 1080p RGB tensor_transform: %" G_GINT64_FORMAT,
+      diff_transform);
+}
+
+/**
+ * @brief Push a tensor to tensor_transform with the given number of threads.
+ */
+static GstBuffer *
+_transform_with_threads (tensor_transform_mode mode, const gchar *option,
+    const gchar *dim_str, tensor_type type, guint threads)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMapInfo info;
+  gsize i, size;
+
+  h = gst_harness_new ("tensor_transform");
+  g_object_set (h->element, "mode", mode, "option", option, "threads",
+      threads, NULL);
+
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = type;
+  gst_tensor_parse_dimension (dim_str, config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+  size = gst_tensors_info_get_size (&config.info, 0);
+
+  in_buf = gst_harness_create_buffer (h, size);
+  if (!gst_buffer_map (in_buf, &info, GST_MAP_WRITE)) {
+    gst_buffer_unref (in_buf);
+    gst_harness_teardown (h);
+    return NULL;
+  }
+  for (i = 0; i < size; i++)
+    info.data[i] = (uint8_t) (i * 7 + i / 3);
+  gst_buffer_unmap (in_buf, &info);
+
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+
+  gst_harness_teardown (h);
+  return out_buf;
+}
+
+/**
+ * @brief Test for tensor_transform with the worker threads (same result as single thread)
+ */
+TEST (testTensorTransform, threads)
+{
+  const struct {
+    tensor_transform_mode mode;
+    const gchar *option;
+  } cases[] = {
+    { GTT_TYPECAST, "float32" },
+    { GTT_ARITHMETIC, "typecast:float32,add:-127.5,div:127.5" },
+    { GTT_ARITHMETIC, "typecast:int32,per-channel:true@0,add:1@0,mul:2@1,add:-3@2" },
+    { GTT_ARITHMETIC, "typecast:float64,per-channel:true@1,mul:3@5,add:1" },
+    { GTT_CLAMP, "10:200" },
+    { GTT_STAND, "default:float32" },
+    { GTT_STAND, "dc-average:float32,per-channel:true" },
+    { GTT_TRANSPOSE, "1:2:0:3" },
+    { GTT_TRANSPOSE, "1:0:2:3" },
+    { GTT_DIMCHG, "0:2" },
+  };
+  GstBuffer *single, *multi;
+  GstMapInfo s_info, m_info;
+  guint i;
+  GValue val = G_VALUE_INIT;
+  GstElement *transform;
+
+  transform = gst_element_factory_make ("tensor_transform", NULL);
+  ASSERT_TRUE (transform != NULL);
+  g_value_init (&val, G_TYPE_UINT);
+  g_object_get_property (G_OBJECT (transform), "threads", &val);
+  EXPECT_EQ (g_value_get_uint (&val), 1U);
+  g_value_unset (&val);
+  gst_object_unref (transform);
+
+  for (i = 0; i < G_N_ELEMENTS (cases); i++) {
+    single = _transform_with_threads (
+        cases[i].mode, cases[i].option, "3:640:480:1", _NNS_UINT8, 1);
+    multi = _transform_with_threads (
+        cases[i].mode, cases[i].option, "3:640:480:1", _NNS_UINT8, 4);
+    ASSERT_TRUE (single != NULL);
+    ASSERT_TRUE (multi != NULL);
+
+    ASSERT_EQ (gst_buffer_get_size (single), gst_buffer_get_size (multi));
+    ASSERT_TRUE (gst_buffer_map (single, &s_info, GST_MAP_READ));
+    ASSERT_TRUE (gst_buffer_map (multi, &m_info, GST_MAP_READ));
+    EXPECT_EQ (memcmp (s_info.data, m_info.data, s_info.size), 0)
+        << "Different result with threads, option " << cases[i].option;
+    gst_buffer_unmap (single, &s_info);
+    gst_buffer_unmap (multi, &m_info);
 
-  /* wait for output buffer */
-  received = _harness_wait_for_output_buffer (h, 1U);
-  ASSERT_EQ (received, 1U);
+    gst_buffer_unref (single);
+    gst_buffer_unref (multi);
+  }
+}
 
-  /* get output buffer */
-  out_buf = gst_harness_pull (h);
-  EXPECT_EQ (gst_buffer_n_memory (out_buf), 2U);
+/**
+ * @brief Test for tensor_transform stand per-channel (single-pass statistics)
+ */
+TEST (testTensorTransform, standPerChannelStats)
+{
+  const guint channels = 3;
+  const gsize num = 3 * 64 * 48;
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMapInfo info;
+  gdouble average[3] = { 0.0, }, stddev[3] = { 0.0, };
+  gsize i, ch, count = num / channels;
+  float *in, *out;
+
+  in = (float *) g_malloc (num * sizeof (float));
+  for (i = 0; i < num; i++)
+    in[i] = 1000.0f + (float) ((i * 7 + i / 3) % 255) * (i % channels + 1);
+
+  /* reference with two passes */
+  for (i = 0; i < num; i++)
+    average[i % channels] += in[i];
+  for (ch = 0; ch < channels; ch++)
+    average[ch] /= count;
+  for (i = 0; i < num; i++)
+    stddev[i % channels] += pow (in[i] - average[i % channels], 2);
+  for (ch = 0; ch < channels; ch++)
+    stddev[ch] = sqrt (stddev[ch] / count);
 
-  for (i = 0; i < gst_buffer_n_memory (out_buf); i++) {
-    mem = gst_buffer_peek_memory (out_buf, i);
-    ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
-    EXPECT_EQ (map.size, gst_tensors_info_get_size (&info, i));
-    value = (guint *) map.data;
+  h = gst_harness_new ("tensor_transform");
+  g_object_set (h->element, "mode", GTT_STAND, "option",
+      "default:float32,per-channel:true", NULL);
 
-    for (j = 0; j < (i + 1) * 10; j++)
-      EXPECT_EQ (value[j], j * (i + 1) * 10);
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_FLOAT32;
+  gst_tensor_parse_dimension ("3:64:48:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
 
-    gst_memory_unmap (mem, &map);
-  }
+  in_buf = gst_harness_create_buffer (h, num * sizeof (float));
+  gst_buffer_fill (in_buf, 0, in, num * sizeof (float));
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), num * sizeof (float));
 
+  ASSERT_TRUE (gst_buffer_map (out_buf, &info, GST_MAP_READ));
+  out = (float *) info.data;
+  for (i = 0; i < num; i++) {
+    ch = i % channels;
+    EXPECT_NEAR (out[i], fabs ((in[i] - average[ch]) / stddev[ch]), 1e-5);
+  }
+  gst_buffer_unmap (out_buf, &info);
   gst_buffer_unref (out_buf);
+
   gst_harness_teardown (h);
+  g_free (in);
 }
 
+#ifdef FLOAT16_SUPPORT
 /**
- * @brief Test for tensor_converter (flexible to static tensor)
+ * @brief Test for tensor_transform float16 (normalize uint8 to float16 and clamp)
  */
-TEST (testTensorConverter, flexToStaticInvalidBuffer1_n)
+TEST (testTensorTransform, float16Typed)
 {
+  const gsize num = 3 * 64 * 48;
   GstHarness *h;
-  GstBuffer *in_buf;
-  GstMemory *mem;
-  GstTensorMetaInfo meta;
-  GstTensorInfo info;
-  GstCaps *caps;
-  gpointer data;
-  gsize data_size;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMapInfo info;
+  gsize i;
+  float16 *out;
+  uint8_t *in;
 
-  h = gst_harness_new ("tensor_converter");
+  in = (uint8_t *) g_malloc (num);
+  for (i = 0; i < num; i++)
+    in[i] = (uint8_t) (i * 7 + i / 3);
 
-  g_object_set (h->element, "input-dim", "3:4:2:2,3:4:2:2", "input-type",
-      "int32,int32", NULL);
+  /* uint8 to float16 normalize */
+  h = gst_harness_new ("tensor_transform");
+  g_object_set (h->element, "mode", GTT_ARITHMETIC, "option",
+      "typecast:float16,add:-127.5,div:127.5", "acceleration", (gboolean) FALSE,
+      NULL);
 
-  /* in/out caps and tensors info */
-  caps = gst_caps_from_string (GST_TENSORS_FLEX_CAP_DEFAULT);
-  gst_caps_set_simple (caps, "framerate", GST_TYPE_FRACTION, 0, 1, NULL);
-  gst_harness_set_src_caps (h, caps);
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:64:48:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
 
-  gst_tensor_info_init (&info);
-  info.type = _NNS_INT32;
-  gst_tensor_parse_dimension ("3:4:2:2", info.dimension);
+  in_buf = gst_harness_create_buffer (h, num);
+  gst_buffer_fill (in_buf, 0, in, num);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), num * sizeof (float16));
 
-  /* push buffer (invalid number) */
-  in_buf = gst_buffer_new ();
+  ASSERT_TRUE (gst_buffer_map (out_buf, &info, GST_MAP_READ));
+  out = (float16 *) info.data;
+  for (i = 0; i < num; i++) {
+    float16 expected = (float16) in[i];
+    expected = expected + (float16) -127.5;
+    expected = expected / (float16) 127.5;
+    EXPECT_FLOAT_EQ ((float) out[i], (float) expected);
+  }
+  gst_buffer_unmap (out_buf, &info);
+  gst_buffer_unref (out_buf);
+  gst_harness_teardown (h);
 
-  gst_tensor_info_convert_to_meta (&info, &meta);
-  data_size = gst_tensor_meta_info_get_header_size (&meta);
-  data_size += gst_tensor_meta_info_get_data_size (&meta);
+  /* float16 clamp */
+  h = gst_harness_new ("tensor_transform");
+  g_object_set (h->element, "mode", GTT_CLAMP, "option", "-0.5:0.25", NULL);
 
-  data = g_malloc0 (data_size);
-  gst_tensor_meta_info_update_header (&meta, data);
+  config.info.info[0].type = _NNS_FLOAT16;
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
 
-  mem = gst_memory_new_wrapped ((GstMemoryFlags) 0, data, data_size,
-      0, data_size, data, g_free);
-  gst_buffer_append_memory (in_buf, mem);
+  in_buf = gst_harness_create_buffer (h, num * sizeof (float16));
+  ASSERT_TRUE (gst_buffer_map (in_buf, &info, GST_MAP_WRITE));
+  out = (float16 *) info.data;
+  for (i = 0; i < num; i++)
+    out[i] = (float16) (((float) in[i] - 127.5f) / 127.5f);
+  gst_buffer_unmap (in_buf, &info);
 
-  EXPECT_NE (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
 
-  EXPECT_EQ (gst_harness_buffers_received (h), 0U);
+  ASSERT_TRUE (gst_buffer_map (out_buf, &info, GST_MAP_READ));
+  out = (float16 *) info.data;
+  for (i = 0; i < num; i++) {
+    float16 value = (float16) (((float) in[i] - 127.5f) / 127.5f);
+    double expected = CLAMP ((double) value, -0.5, 0.25);
+    EXPECT_FLOAT_EQ ((float) out[i], (float) (float16) expected);
+  }
+  gst_buffer_unmap (out_buf, &info);
+  gst_buffer_unref (out_buf);
   gst_harness_teardown (h);
+
+  g_free (in);
 }
+#endif /* FLOAT16_SUPPORT */
 
 /**
- * @brief Test for tensor_converter (flexible to static tensor)
+ * @brief Test for tensor_transform in-place arithmetic (writable and shared input)
  */
-TEST (testTensorConverter, flexToStaticInvalidBuffer2_n)
+TEST (testTensorTransform, arithmeticInPlace)
 {
+  const gsize num = 3 * 64 * 48;
   GstHarness *h;
-  GstBuffer *in_buf;
-  GstMemory *mem;
-  GstTensorMetaInfo meta;
-  GstTensorsInfo info;
-  GstCaps *caps;
-  gpointer data;
-  gsize data_size;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMapInfo info;
+  gpointer in_data;
+  gsize i;
+  float *in, *out;
 
-  h = gst_harness_new ("tensor_converter");
+  in = (float *) g_malloc (num * sizeof (float));
+  for (i = 0; i < num; i++)
+    in[i] = (float) (i % 255);
 
-  g_object_set (h->element, "input-dim", "3:4:2:2,3:4:2:2", "input-type",
-      "int32,int32", NULL);
+  h = gst_harness_new ("tensor_transform");
+  g_object_set (h->element, "mode", GTT_ARITHMETIC, "option", "add:1,mul:2",
+      NULL);
 
-  /* in/out caps and tensors info */
-  caps = gst_caps_from_string (GST_TENSORS_FLEX_CAP_DEFAULT);
-  gst_caps_set_simple (caps, "framerate", GST_TYPE_FRACTION, 0, 1, NULL);
-  gst_harness_set_src_caps (h, caps);
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_FLOAT32;
+  gst_tensor_parse_dimension ("3:64:48:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
 
-  gst_tensors_info_init (&info);
-  info.num_tensors = 2;
+  /* writable input, the output is written into the same memory */
+  in_buf = gst_harness_create_buffer (h, num * sizeof (float));
+  gst_buffer_fill (in_buf, 0, in, num * sizeof (float));
+  ASSERT_TRUE (gst_buffer_map (in_buf, &info, GST_MAP_READ));
+  in_data = info.data;
+  gst_buffer_unmap (in_buf, &info);
 
-  info.info[0].type = _NNS_INT32;
-  gst_tensor_parse_dimension ("3:4:2:2", info.info[0].dimension);
-  info.info[1].type = _NNS_INT32;
-  gst_tensor_parse_dimension ("3:4:2:2", info.info[1].dimension);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), num * sizeof (float));
+
+  ASSERT_TRUE (gst_buffer_map (out_buf, &info, GST_MAP_READ));
+  EXPECT_EQ (info.data, in_data);
+  out = (float *) info.data;
+  for (i = 0; i < num; i++)
+    EXPECT_FLOAT_EQ (out[i], (in[i] + 1.0f) * 2.0f);
+  gst_buffer_unmap (out_buf, &info);
+  gst_buffer_unref (out_buf);
 
-  /* push buffer (invalid buffer size) */
-  in_buf = gst_buffer_new ();
+  /* shared input, the input data should not be changed */
+  in_buf = gst_harness_create_buffer (h, num * sizeof (float));
+  gst_buffer_fill (in_buf, 0, in, num * sizeof (float));
+  gst_buffer_ref (in_buf);
 
-  /* 1st mem block */
-  gst_tensor_info_convert_to_meta (&info.info[0], &meta);
-  data_size = gst_tensor_meta_info_get_header_size (&meta);
-  data_size += gst_tensor_meta_info_get_data_size (&meta);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
 
-  data = g_malloc0 (data_size);
-  gst_tensor_meta_info_update_header (&meta, data);
+  ASSERT_TRUE (gst_buffer_map (out_buf, &info, GST_MAP_READ));
+  out = (float *) info.data;
+  for (i = 0; i < num; i++)
+    EXPECT_FLOAT_EQ (out[i], (in[i] + 1.0f) * 2.0f);
+  gst_buffer_unmap (out_buf, &info);
+  gst_buffer_unref (out_buf);
 
-  mem = gst_memory_new_wrapped ((GstMemoryFlags) 0, data, data_size,
-      0, data_size, data, g_free);
-  gst_buffer_append_memory (in_buf, mem);
+  ASSERT_TRUE (gst_buffer_map (in_buf, &info, GST_MAP_READ));
+  out = (float *) info.data;
+  for (i = 0; i < num; i++)
+    EXPECT_FLOAT_EQ (out[i], in[i]);
+  gst_buffer_unmap (in_buf, &info);
+  gst_buffer_unref (in_buf);
 
-  /* 2nd mem block (invalid size) */
-  gst_tensor_info_convert_to_meta (&info.info[1], &meta);
-  data_size = gst_tensor_meta_info_get_header_size (&meta);
-  data_size += gst_tensor_meta_info_get_data_size (&meta) / 2;
+  gst_harness_teardown (h);
+  g_free (in);
+}
 
-  data = g_malloc0 (data_size);
-  gst_tensor_meta_info_update_header (&meta, data);
+/**
+ * @brief Test for tensor_transform clamp with the integer limits (int16)
+ */
+TEST (testTensorTransform, clampIntegerLimits)
+{
+  const gsize num = 3 * 64 * 48;
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstTensorsConfig config;
+  GstMapInfo info;
+  gsize i;
+  int16_t *in, *out, expected;
 
-  mem = gst_memory_new_wrapped ((GstMemoryFlags) 0, data, data_size,
-      0, data_size, data, g_free);
-  gst_buffer_append_memory (in_buf, mem);
+  in = (int16_t *) g_malloc (num * sizeof (int16_t));
+  for (i = 0; i < num; i++)
+    in[i] = (int16_t) ((gint) (i * 37 % 1000) - 500);
 
-  EXPECT_NE (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  h = gst_harness_new ("tensor_transform");
+  g_object_set (h->element, "mode", GTT_CLAMP, "option", "-100.7:250.9",
+      "acceleration", (gboolean) TRUE, NULL);
+
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_INT16;
+  gst_tensor_parse_dimension ("3:64:48:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
+
+  in_buf = gst_harness_create_buffer (h, num * sizeof (int16_t));
+  gst_buffer_fill (in_buf, 0, in, num * sizeof (int16_t));
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_get_size (out_buf), num * sizeof (int16_t));
+
+  ASSERT_TRUE (gst_buffer_map (out_buf, &info, GST_MAP_READ));
+  out = (int16_t *) info.data;
+  for (i = 0; i < num; i++) {
+    /* same as the typecast of the clamped value in double */
+    expected = (int16_t) CLAMP ((gdouble) in[i], -100.7, 250.9);
+    EXPECT_EQ (out[i], expected);
+  }
+  gst_buffer_unmap (out_buf, &info);
+  gst_buffer_unref (out_buf);
 
-  EXPECT_EQ (gst_harness_buffers_received (h), 0U);
   gst_harness_teardown (h);
+  g_free (in);
 }
 
 #ifdef HAVE_ORC
@@ -5317,8 +6493,96 @@ TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteSetProperty)
   gst_harness_get (h, "tensor_filter", "is-updatable", &prop_updatable, NULL);
   EXPECT_TRUE (prop_updatable);
 
-  /* playing state */
-  wait_for_element_state (h->element, GST_STATE_PLAYING);
+  /* playing state */
+  wait_for_element_state (h->element, GST_STATE_PLAYING);
+
+  /* push buffer (dummy input RGB 224x224, output 1001) */
+  in_size = 3 * 224 * 224;
+  out_size = 1001;
+
+  in_buf = gst_harness_create_buffer (h, in_size);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  /* get output buffer */
+  out_buf = gst_harness_pull (h);
+  EXPECT_EQ (gst_buffer_n_memory (out_buf), 1U);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), out_size);
+  gst_buffer_unref (out_buf);
+
+  /* set second model file */
+  gst_harness_set (h, "tensor_filter", "model", test_model2, NULL);
+
+  gst_harness_get (h, "tensor_filter", "model", &prop_string, NULL);
+  EXPECT_STREQ (prop_string, test_model2);
+  g_free (prop_string);
+
+  /* push buffer again */
+  in_buf = gst_harness_create_buffer (h, in_size);
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+
+  /* get output buffer */
+  out_buf = gst_harness_pull (h);
+  EXPECT_EQ (gst_buffer_n_memory (out_buf), 1U);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), out_size);
+  gst_buffer_unref (out_buf);
+
+  gst_harness_teardown (h);
+  g_free (test_model);
+  g_free (test_model2);
+}
+
+/**
+ * @brief Test to reload tf-lite model in the background (reload-async)
+ */
+TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteAsync)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstBus *bus;
+  GstMessage *msg;
+  const GstStructure *s;
+  gsize in_size, out_size;
+  GstTensorsConfig config;
+  gboolean success = FALSE;
+  gint64 duration = -1;
+  gchar *str_launch_line, *prop_string;
+
+  const gchar *root_path = g_getenv ("NNSTREAMER_SOURCE_ROOT_PATH");
+  gchar *test_model, *test_model2;
+
+  /* supposed to run test in build directory */
+  if (root_path == NULL)
+    root_path = "..";
+
+  test_model = g_build_filename (root_path, "tests", "test_models", "models",
+      "mobilenet_v1_1.0_224_quant.tflite", NULL);
+  ASSERT_TRUE (g_file_test (test_model, G_FILE_TEST_EXISTS));
+
+  test_model2 = g_build_filename (root_path, "tests", "test_models", "models",
+      "mobilenet_v2_1.0_224_quant.tflite", NULL);
+  ASSERT_TRUE (g_file_test (test_model2, G_FILE_TEST_EXISTS));
+
+  h = gst_harness_new_empty ();
+  ASSERT_TRUE (h != NULL);
+
+  str_launch_line = g_strdup_printf ("tensor_filter framework=tensorflow-lite "
+                                     "is-updatable=true reload-async=true model=%s",
+      test_model);
+  gst_harness_add_parse (h, str_launch_line);
+  g_free (str_launch_line);
+
+  bus = gst_bus_new ();
+  gst_element_set_bus (h->element, bus);
+
+  /* input tensor info */
+  gst_tensors_config_init (&config);
+  config.info.num_tensors = 1U;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:224:224:1", config.info.info[0].dimension);
+  config.rate_n = 0;
+  config.rate_d = 1;
+
+  gst_harness_set_src_caps (h, gst_tensors_caps_from_config (&config));
 
   /* push buffer (dummy input RGB 224x224, output 1001) */
   in_size = 3 * 224 * 224;
@@ -5327,15 +6591,23 @@ TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteSetProperty)
   in_buf = gst_harness_create_buffer (h, in_size);
   EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
 
-  /* get output buffer */
   out_buf = gst_harness_pull (h);
-  EXPECT_EQ (gst_buffer_n_memory (out_buf), 1U);
   EXPECT_EQ (gst_buffer_get_size (out_buf), out_size);
   gst_buffer_unref (out_buf);
 
-  /* set second model file */
+  /* set second model file, the model is loaded in the background */
   gst_harness_set (h, "tensor_filter", "model", test_model2, NULL);
 
+  msg = gst_bus_timed_pop_filtered (bus, 10 * GST_SECOND, GST_MESSAGE_ELEMENT);
+  ASSERT_TRUE (msg != NULL);
+  s = gst_message_get_structure (msg);
+  EXPECT_TRUE (gst_structure_has_name (s, "tensor-filter-reload"));
+  EXPECT_TRUE (gst_structure_get_boolean (s, "success", &success));
+  EXPECT_TRUE (success);
+  EXPECT_TRUE (gst_structure_get_int64 (s, "duration", &duration));
+  EXPECT_GT (duration, 0);
+  gst_message_unref (msg);
+
   gst_harness_get (h, "tensor_filter", "model", &prop_string, NULL);
   EXPECT_STREQ (prop_string, test_model2);
   g_free (prop_string);
@@ -5344,12 +6616,12 @@ TEST_REQUIRE_TFLITE (testTensorFilter, reloadTFliteSetProperty)
   in_buf = gst_harness_create_buffer (h, in_size);
   EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
 
-  /* get output buffer */
   out_buf = gst_harness_pull (h);
-  EXPECT_EQ (gst_buffer_n_memory (out_buf), 1U);
   EXPECT_EQ (gst_buffer_get_size (out_buf), out_size);
   gst_buffer_unref (out_buf);
 
+  gst_element_set_bus (h->element, NULL);
+  gst_object_unref (bus);
   gst_harness_teardown (h);
   g_free (test_model);
   g_free (test_model2);
@@ -6706,6 +7978,129 @@ TEST_REQUIRE_TFLITE (testTensorFilter, flexToFlex)
   gst_harness_teardown (h);
 }
 
+/**
+ * @brief Test for direct_video decoder sharing the input memory (rows aligned to 4 bytes)
+ */
+TEST (testDecoderDirectVideo, zeroCopy)
+{
+  const GstTensorDecoderDef *dv_dec;
+  GstTensorsConfig config;
+  GstMemory *mem;
+  GstBuffer *out_buf;
+  void *pdata = NULL;
+
+  dv_dec = nnstreamer_decoder_find ("direct_video");
+  ASSERT_TRUE (dv_dec);
+  ASSERT_TRUE (dv_dec->decodeMemory);
+  ASSERT_TRUE (dv_dec->init (&pdata));
+
+  gst_tensors_config_init (&config);
+  config.rate_n = 0;
+  config.rate_d = 1;
+  config.info.num_tensors = 1;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("4:5:2:1", config.info.info[0].dimension);
+
+  mem = gst_allocator_alloc (NULL, 40, NULL);
+  out_buf = gst_buffer_new ();
+
+  EXPECT_EQ (dv_dec->getTransformSize (&pdata, &config, NULL, 40, NULL, GST_PAD_SINK), 0U);
+  EXPECT_EQ (dv_dec->decodeMemory (&pdata, &config, &mem, 1, out_buf), GST_FLOW_OK);
+  EXPECT_EQ (gst_buffer_n_memory (out_buf), 1U);
+  EXPECT_TRUE (gst_buffer_peek_memory (out_buf, 0) == mem);
+
+  gst_buffer_unref (out_buf);
+  gst_memory_unref (mem);
+  gst_tensors_config_free (&config);
+  dv_dec->exit (&pdata);
+}
+
+/**
+ * @brief Test for octet_stream decoder sharing the input memory
+ */
+TEST (testDecoderOctetStream, zeroCopy)
+{
+  const GstTensorDecoderDef *os_dec;
+  GstTensorsConfig config;
+  GstMemory *mem[2];
+  GstBuffer *out_buf;
+  void *pdata = NULL;
+
+  os_dec = nnstreamer_decoder_find ("octet_stream");
+  ASSERT_TRUE (os_dec);
+  ASSERT_TRUE (os_dec->decodeMemory);
+  ASSERT_TRUE (os_dec->init (&pdata));
+
+  gst_tensors_config_init (&config);
+  config.rate_n = 0;
+  config.rate_d = 1;
+  config.info.num_tensors = 2;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("4:5:2:1", config.info.info[0].dimension);
+  config.info.info[1].type = _NNS_FLOAT32;
+  gst_tensor_parse_dimension ("10:1:1:1", config.info.info[1].dimension);
+
+  mem[0] = gst_allocator_alloc (NULL, 40, NULL);
+  mem[1] = gst_allocator_alloc (NULL, 40, NULL);
+  out_buf = gst_buffer_new ();
+
+  EXPECT_EQ (os_dec->decodeMemory (&pdata, &config, mem, 2, out_buf), GST_FLOW_OK);
+  EXPECT_EQ (gst_buffer_n_memory (out_buf), 2U);
+  EXPECT_EQ (gst_buffer_get_size (out_buf), 80U);
+  EXPECT_TRUE (gst_buffer_peek_memory (out_buf, 0)->parent == mem[0]);
+  EXPECT_TRUE (gst_buffer_peek_memory (out_buf, 1)->parent == mem[1]);
+
+  gst_buffer_unref (out_buf);
+
+  /* the memory smaller than the tensor */
+  out_buf = gst_buffer_new ();
+  gst_tensor_parse_dimension ("11:1:1:1", config.info.info[1].dimension);
+  EXPECT_EQ (os_dec->decodeMemory (&pdata, &config, mem, 2, out_buf), GST_FLOW_NOT_SUPPORTED);
+  EXPECT_EQ (gst_buffer_n_memory (out_buf), 0U);
+
+  gst_buffer_unref (out_buf);
+  gst_memory_unref (mem[0]);
+  gst_memory_unref (mem[1]);
+  gst_tensors_config_free (&config);
+  os_dec->exit (&pdata);
+}
+
+/**
+ * @brief Test for direct_video decoder with the padded rows (copy is needed)
+ */
+TEST (testDecoderDirectVideo, zeroCopyPadding_n)
+{
+  const GstTensorDecoderDef *dv_dec;
+  GstTensorsConfig config;
+  GstMemory *mem;
+  GstBuffer *out_buf;
+  void *pdata = NULL;
+
+  dv_dec = nnstreamer_decoder_find ("direct_video");
+  ASSERT_TRUE (dv_dec);
+  ASSERT_TRUE (dv_dec->init (&pdata));
+
+  gst_tensors_config_init (&config);
+  config.rate_n = 0;
+  config.rate_d = 1;
+  config.info.num_tensors = 1;
+  config.info.info[0].type = _NNS_UINT8;
+  gst_tensor_parse_dimension ("3:5:2:1", config.info.info[0].dimension);
+
+  mem = gst_allocator_alloc (NULL, 30, NULL);
+  out_buf = gst_buffer_new ();
+
+  /* 15 bytes per row, padded to 16 bytes */
+  EXPECT_EQ (dv_dec->getTransformSize (&pdata, &config, NULL, 30, NULL, GST_PAD_SINK), 32U);
+  EXPECT_EQ (dv_dec->decodeMemory (&pdata, &config, &mem, 1, out_buf), GST_FLOW_NOT_SUPPORTED);
+  EXPECT_EQ (gst_buffer_n_memory (out_buf), 0U);
+
+  gst_buffer_unref (out_buf);
+  gst_memory_unref (mem);
+  gst_tensors_config_free (&config);
+  dv_dec->exit (&pdata);
+}
+
 
 #if ENABLE_PROTOBUF && ENABLE_FLATBUF
 /**
@@ -7459,6 +8854,102 @@ TEST (testTensorCrop, cropTensor)
   _crop_test_free (&crop_test);
 }
 
+/**
+ * @brief Test for tensor_crop, cropping and resizing the regions into the batch tensor.
+ */
+TEST (testTensorCrop, cropBatch)
+{
+  crop_test_data_s crop_test;
+  GstBuffer *out_buf;
+  GstMemory *mem;
+  GstMapInfo map;
+  guint i;
+  guint *_data, *_info, *batch;
+  gchar *roi_size = NULL;
+  guint max_rois = 0;
+
+  _crop_test_init (&crop_test);
+
+  g_object_set (crop_test.crop->element, "max-rois", 3U, "roi-size", "2:2", NULL);
+  g_object_get (crop_test.crop->element, "max-rois", &max_rois, "roi-size", &roi_size, NULL);
+  EXPECT_EQ (max_rois, 3U);
+  EXPECT_STREQ (roi_size, "2:2");
+  g_free (roi_size);
+
+  /* prepare test data */
+  crop_test.raw_info.type = _NNS_UINT32;
+  gst_tensor_parse_dimension ("1:10:4:1", crop_test.raw_info.dimension);
+
+  crop_test.raw_size = sizeof (guint) * 40U;
+  crop_test.raw_data = g_malloc0 (crop_test.raw_size);
+  _data = (guint *) crop_test.raw_data;
+
+  for (i = 0; i < 40; i++)
+    _data[i] = i + 1;
+
+  crop_test.info_type = _NNS_UINT32;
+  crop_test.info_size = sizeof (guint) * 12U;
+  crop_test.info_num = 3U;
+  crop_test.info_data = g_malloc0 (crop_test.info_size);
+  _info = (guint *) crop_test.info_data;
+
+  /* crop info ([3, 0, 3, 1] [2, 1, 7, 2] [20, 20, 1, 1] out of raw tensor) */
+  _info[0] = 3U;
+  _info[1] = 0U;
+  _info[2] = 3U;
+  _info[3] = 1U;
+  _info[4] = 2U;
+  _info[5] = 1U;
+  _info[6] = 7U;
+  _info[7] = 2U;
+  _info[8] = 20U;
+  _info[9] = 20U;
+  _info[10] = 1U;
+  _info[11] = 1U;
+
+  _crop_test_push_buffer (&crop_test);
+  EXPECT_EQ (crop_test.received, 1U);
+
+  if (crop_test.received > 0) {
+    out_buf = gst_harness_pull (crop_test.crop);
+    ASSERT_EQ (gst_buffer_n_memory (out_buf), 2U);
+
+    mem = gst_buffer_peek_memory (out_buf, 0);
+    ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+    ASSERT_EQ (map.size, sizeof (guint) * 12U);
+    batch = (guint *) map.data;
+
+    /* [3, 0, 3, 1] resized to 2x2, expected [4, 6, 4, 6] */
+    EXPECT_EQ (batch[0], 4U);
+    EXPECT_EQ (batch[1], 6U);
+    EXPECT_EQ (batch[2], 4U);
+    EXPECT_EQ (batch[3], 6U);
+
+    /* [2, 1, 7, 2] resized to 2x2, expected [14, 18, 24, 28] */
+    EXPECT_EQ (batch[4], 14U);
+    EXPECT_EQ (batch[5], 18U);
+    EXPECT_EQ (batch[6], 24U);
+    EXPECT_EQ (batch[7], 28U);
+
+    /* unused region */
+    for (i = 8; i < 12; i++)
+      EXPECT_EQ (batch[i], 0U);
+
+    gst_memory_unmap (mem, &map);
+
+    /* count tensor */
+    mem = gst_buffer_peek_memory (out_buf, 1);
+    ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_READ));
+    ASSERT_EQ (map.size, sizeof (guint));
+    EXPECT_EQ (((guint *) map.data)[0], 2U);
+    gst_memory_unmap (mem, &map);
+
+    gst_buffer_unref (out_buf);
+  }
+
+  _crop_test_free (&crop_test);
+}
+
 /**
  * @brief Test for tensor_crop, invalid property name.
  */
@@ -7748,6 +9239,92 @@ TEST (testTensorSparse, utilConvert)
   EXPECT_FALSE (failed);
 }
 
+/**
+ * @brief Test for tensor_sparse util, large tensor encoded with multiple threads.
+ */
+TEST (testTensorSparse, utilConvertLarge)
+{
+  GstMemory *sparse, *dense, *origin;
+  GstMapInfo map;
+  GstTensorInfo info;
+  GstTensorMetaInfo meta;
+  float *data;
+  gsize i, data_size;
+
+  gst_tensor_info_init (&info);
+  info.type = _NNS_FLOAT32;
+  gst_tensor_parse_dimension ("1024:1024:3", info.dimension);
+  gst_tensor_info_convert_to_meta (&info, &meta);
+
+  data_size = gst_tensor_info_get_size (&info);
+  data = (float *) g_malloc0 (data_size);
+  for (i = 0; i < data_size / sizeof (float); i += 97)
+    data[i] = (float) (i % 13) - 6.0f;
+
+  origin = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,
+      data, data_size, 0, data_size, data, g_free);
+
+  sparse = gst_tensor_sparse_from_dense (&meta, origin);
+  ASSERT_TRUE (sparse != NULL);
+  EXPECT_EQ (gst_memory_get_sizes (sparse, NULL, NULL),
+      gst_tensor_meta_info_get_header_size (&meta)
+          + (sizeof (float) + sizeof (guint)) * meta.sparse_info.nnz);
+
+  dense = gst_tensor_sparse_to_dense (&meta, sparse);
+  ASSERT_TRUE (dense != NULL);
+  ASSERT_TRUE (gst_memory_map (dense, &map, GST_MAP_READ));
+  EXPECT_EQ (map.size, data_size);
+  EXPECT_EQ (memcmp (map.data, data, data_size), 0);
+  gst_memory_unmap (dense, &map);
+
+  gst_tensor_info_free (&info);
+  gst_memory_unref (sparse);
+  gst_memory_unref (dense);
+  gst_memory_unref (origin);
+}
+
+/**
+ * @brief Test for tensor_sparse util, sparse tensor with the index out of the dense tensor.
+ */
+TEST (testTensorSparse, utilInvalidIndex_n)
+{
+  GstMemory *sparse, *dense, *origin;
+  GstMapInfo map;
+  GstTensorInfo info;
+  GstTensorMetaInfo meta;
+  guint *data, index;
+  gsize data_size, hsize;
+
+  gst_tensor_info_init (&info);
+  info.type = _NNS_UINT32;
+  gst_tensor_parse_dimension ("40", info.dimension);
+  gst_tensor_info_convert_to_meta (&info, &meta);
+
+  data_size = gst_tensor_info_get_size (&info);
+  data = (guint *) g_malloc0 (data_size);
+  data[10] = 1U;
+  origin = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,
+      data, data_size, 0, data_size, data, g_free);
+
+  sparse = gst_tensor_sparse_from_dense (&meta, origin);
+  ASSERT_TRUE (sparse != NULL);
+  EXPECT_EQ (meta.sparse_info.nnz, 1U);
+
+  /* overwrite the index */
+  hsize = gst_tensor_meta_info_get_header_size (&meta);
+  ASSERT_TRUE (gst_memory_map (sparse, &map, GST_MAP_WRITE));
+  index = 40U;
+  memcpy (map.data + hsize + sizeof (guint), &index, sizeof (guint));
+  gst_memory_unmap (sparse, &map);
+
+  dense = gst_tensor_sparse_to_dense (&meta, sparse);
+  EXPECT_FALSE (dense != NULL);
+
+  gst_tensor_info_free (&info);
+  gst_memory_unref (sparse);
+  gst_memory_unref (origin);
+}
+
 /**
  * @brief Test for tensor_sparse util, invalid tensor-meta.
  */
@@ -7773,6 +9350,60 @@ TEST (testTensorSparse, utilInvalidMeta_n)
   gst_memory_unref (in);
 }
 
+/**
+ * @brief Test for tensor_sparse util, decode into the given buffer.
+ */
+TEST (testTensorSparse, utilDenseInto)
+{
+  GstMemory *sparse, *origin;
+  GstMapInfo map;
+  GstTensorInfo info;
+  GstTensorMetaInfo meta;
+  gfloat *data, *dense;
+  gsize data_size;
+  guint i;
+
+  gst_tensor_info_init (&info);
+  info.type = _NNS_FLOAT32;
+  gst_tensor_parse_dimension ("100", info.dimension);
+  gst_tensor_info_convert_to_meta (&info, &meta);
+
+  data_size = gst_tensor_info_get_size (&info);
+  data = (gfloat *) g_malloc0 (data_size);
+  data[3] = 1.5f;
+  data[77] = -2.0f;
+  origin = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY,
+      data, data_size, 0, data_size, data, g_free);
+
+  sparse = gst_tensor_sparse_from_dense (&meta, origin);
+  ASSERT_TRUE (sparse != NULL);
+
+  /* the buffer is cleared before the values are written */
+  dense = (gfloat *) g_malloc (data_size);
+  for (i = 0; i < 100U; i++)
+    dense[i] = 9.0f;
+
+  ASSERT_TRUE (gst_memory_map (sparse, &map, GST_MAP_READ));
+  EXPECT_TRUE (gst_tensor_sparse_to_dense_into (&meta, map.data, map.size,
+      (guint8 *) dense, data_size));
+  EXPECT_EQ (meta.format, _NNS_TENSOR_FORMAT_STATIC);
+
+  for (i = 0; i < 100U; i++)
+    EXPECT_FLOAT_EQ (dense[i], data[i]);
+
+  /* the size of the buffer should be same to the dense tensor */
+  EXPECT_FALSE (gst_tensor_sparse_to_dense_into (&meta, map.data, map.size,
+      (guint8 *) dense, data_size - 4));
+  EXPECT_FALSE (gst_tensor_sparse_to_dense_into (&meta, map.data,
+      map.size - 4, (guint8 *) dense, data_size));
+  gst_memory_unmap (sparse, &map);
+
+  g_free (dense);
+  gst_tensor_info_free (&info);
+  gst_memory_unref (sparse);
+  gst_memory_unref (origin);
+}
+
 /**
  * @brief Test for tensor_sparse_enc, invalid property name.
  */
@@ -7817,6 +9448,153 @@ TEST (testTensorSparse, decInvalidProperty_n)
   gst_harness_teardown (h);
 }
 
+/**
+ * @brief Test for tensor_batch, the partial batches with the stream IDs after the deadline.
+ */
+TEST (testTensorBatch, partialBatch)
+{
+  GstHarness *h0, *h1;
+  GstBuffer *in_buf, *out_buf;
+  GstMapInfo map;
+  GstCaps *caps;
+  GstTensorsConfig config;
+  const gchar *caps_str
+      = "other/tensors,num_tensors=1,types=uint8,dimensions=4:1,format=static,framerate=(fraction)0/1";
+  guint i;
+
+  h0 = gst_harness_new_with_padnames ("tensor_batch", "sink_0", "src");
+  h1 = gst_harness_new_with_element (h0->element, "sink_1", NULL);
+  g_object_set (h0->element, "timeout", (guint64) 1000, NULL);
+
+  gst_harness_set_src_caps_str (h0, caps_str);
+  gst_harness_set_src_caps_str (h1, caps_str);
+
+  /* the stream 1 does not give a frame, the partial batch is pushed */
+  in_buf = gst_harness_create_buffer (h0, 4);
+  ASSERT_TRUE (gst_buffer_map (in_buf, &map, GST_MAP_WRITE));
+  for (i = 0; i < 4; i++)
+    map.data[i] = (guint8) (i + 1);
+  gst_buffer_unmap (in_buf, &map);
+
+  EXPECT_EQ (gst_harness_push (h0, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h0);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_n_memory (out_buf), 2U);
+
+  ASSERT_TRUE (gst_buffer_map_range (out_buf, 0, 1, &map, GST_MAP_READ));
+  ASSERT_EQ (map.size, 8U);
+  for (i = 0; i < 4; i++) {
+    EXPECT_EQ (map.data[i], i + 1);
+    EXPECT_EQ (map.data[i + 4], 0U);
+  }
+  gst_buffer_unmap (out_buf, &map);
+
+  ASSERT_TRUE (gst_buffer_map_range (out_buf, 1, 1, &map, GST_MAP_READ));
+  ASSERT_EQ (map.size, 2 * sizeof (gint32));
+  EXPECT_EQ (((gint32 *) map.data)[0], 0);
+  EXPECT_EQ (((gint32 *) map.data)[1], -1);
+  gst_buffer_unmap (out_buf, &map);
+  gst_buffer_unref (out_buf);
+
+  /* the tensors are batched with the outermost dimension */
+  caps = gst_pad_get_current_caps (h0->sinkpad);
+  ASSERT_TRUE (caps != NULL);
+  EXPECT_TRUE (gst_tensors_config_from_structure (&config,
+      gst_caps_get_structure (caps, 0)));
+  EXPECT_EQ (config.info.num_tensors, 2U);
+  EXPECT_EQ (config.info.info[0].type, _NNS_UINT8);
+  EXPECT_EQ (config.info.info[0].dimension[0], 4U);
+  EXPECT_EQ (config.info.info[0].dimension[1], 2U);
+  EXPECT_EQ (config.info.info[1].type, _NNS_INT32);
+  EXPECT_EQ (config.info.info[1].dimension[0], 2U);
+  gst_tensors_config_free (&config);
+  gst_caps_unref (caps);
+
+  /* the stream 0 is ended, the batch is pushed with the frame of the stream 1 */
+  EXPECT_TRUE (gst_harness_push_event (h0, gst_event_new_eos ()));
+  in_buf = gst_harness_create_buffer (h1, 4);
+  gst_buffer_memset (in_buf, 0, 5, 4);
+
+  EXPECT_EQ (gst_harness_push (h1, in_buf), GST_FLOW_OK);
+  out_buf = gst_harness_pull (h0);
+  ASSERT_TRUE (out_buf != NULL);
+
+  ASSERT_TRUE (gst_buffer_map_range (out_buf, 0, 1, &map, GST_MAP_READ));
+  for (i = 0; i < 4; i++) {
+    EXPECT_EQ (map.data[i], 0U);
+    EXPECT_EQ (map.data[i + 4], 5U);
+  }
+  gst_buffer_unmap (out_buf, &map);
+
+  ASSERT_TRUE (gst_buffer_map_range (out_buf, 1, 1, &map, GST_MAP_READ));
+  EXPECT_EQ (((gint32 *) map.data)[0], -1);
+  EXPECT_EQ (((gint32 *) map.data)[1], 1);
+  gst_buffer_unmap (out_buf, &map);
+  gst_buffer_unref (out_buf);
+
+  gst_harness_teardown (h1);
+  gst_harness_teardown (h0);
+}
+
+/**
+ * @brief Test for tensor_unbatch, the slices are routed to the src pads of the stream IDs.
+ */
+TEST (testTensorBatch, unbatchRoute)
+{
+  GstHarness *h;
+  GstBuffer *in_buf, *out_buf;
+  GstMemory *mem;
+  GstMapInfo map;
+  GstCaps *caps;
+  GstTensorsConfig config;
+  gint32 ids[2] = { 1, 0 };
+  guint8 data[4] = { 1, 2, 3, 4 };
+
+  /* the stream 0 is not linked */
+  h = gst_harness_new_with_padnames ("tensor_unbatch", "sink", "src_1");
+  gst_harness_set_src_caps_str (h,
+      "other/tensors,num_tensors=2,types=(string)\"uint8,int32\",dimensions=(string)\"2:2,2\",format=static,framerate=(fraction)0/1");
+
+  in_buf = gst_buffer_new ();
+  mem = gst_allocator_alloc (NULL, sizeof (data), NULL);
+  gst_memory_map (mem, &map, GST_MAP_WRITE);
+  memcpy (map.data, data, sizeof (data));
+  gst_memory_unmap (mem, &map);
+  gst_buffer_append_memory (in_buf, mem);
+
+  mem = gst_allocator_alloc (NULL, sizeof (ids), NULL);
+  gst_memory_map (mem, &map, GST_MAP_WRITE);
+  memcpy (map.data, ids, sizeof (ids));
+  gst_memory_unmap (mem, &map);
+  gst_buffer_append_memory (in_buf, mem);
+
+  /* the slot 0 is the stream 1 */
+  EXPECT_EQ (gst_harness_push (h, in_buf), GST_FLOW_OK);
+  EXPECT_EQ (gst_harness_buffers_received (h), 1U);
+
+  out_buf = gst_harness_pull (h);
+  ASSERT_TRUE (out_buf != NULL);
+  ASSERT_EQ (gst_buffer_n_memory (out_buf), 1U);
+  ASSERT_TRUE (gst_buffer_map (out_buf, &map, GST_MAP_READ));
+  ASSERT_EQ (map.size, 2U);
+  EXPECT_EQ (map.data[0], 1U);
+  EXPECT_EQ (map.data[1], 2U);
+  gst_buffer_unmap (out_buf, &map);
+  gst_buffer_unref (out_buf);
+
+  caps = gst_pad_get_current_caps (h->sinkpad);
+  ASSERT_TRUE (caps != NULL);
+  EXPECT_TRUE (gst_tensors_config_from_structure (&config,
+      gst_caps_get_structure (caps, 0)));
+  EXPECT_EQ (config.info.num_tensors, 1U);
+  EXPECT_EQ (config.info.info[0].dimension[0], 2U);
+  EXPECT_EQ (config.info.info[0].dimension[1], 1U);
+  gst_tensors_config_free (&config);
+  gst_caps_unref (caps);
+
+  gst_harness_teardown (h);
+}
+
 /**
  * @brief Main function for unit test.
  */
@@ -209,7 +209,7 @@ protected:
  */
 TEST_F (NNSRateTest, getPropertyDefault)
 {
-  gboolean silent, throttle;
+  gboolean silent, throttle, adaptive;
   guint64 in, out, dup, drop;
   g_autofree gchar *framerate = nullptr;
 
@@ -224,6 +224,9 @@ TEST_F (NNSRateTest, getPropertyDefault)
   g_object_get (rate, "throttle", &throttle, NULL);
   EXPECT_FALSE (throttle);
 
+  g_object_get (rate, "adaptive", &adaptive, NULL);
+  EXPECT_FALSE (adaptive);
+
   g_object_get (rate, "framerate", &framerate, NULL);
   EXPECT_STREQ (framerate, DEFAULT_SOURCE_FRAMERATE.c_str());
 
@@ -245,7 +248,7 @@ TEST_F (NNSRateTest, getPropertyDefault)
  */
 TEST_F (NNSRateTest, setProperty)
 {
-  gboolean silent, throttle;
+  gboolean silent, throttle, adaptive;
   g_autofree gchar *framerate = nullptr;
 
   ASSERT_TRUE (setupPipeline());
@@ -261,6 +264,10 @@ TEST_F (NNSRateTest, setProperty)
   g_object_get (rate, "throttle", &throttle, NULL);
   EXPECT_TRUE (throttle);
 
+  g_object_set (rate, "adaptive", (gboolean) TRUE, NULL);
+  g_object_get (rate, "adaptive", &adaptive, NULL);
+  EXPECT_TRUE (adaptive);
+
   g_object_set (rate, "framerate", "15/1", NULL);
   g_object_get (rate, "framerate", &framerate, NULL);
   EXPECT_STREQ ("15/1", framerate);
@@ -349,6 +356,39 @@ TEST_F (NNSRateTest, passthrough)
         UNITTEST_STATECHANGE_TIMEOUT), 0);
 }
 
+/**
+ * @brief Test tensor_rate with adaptive mode (no qos from downstream, nothing dropped)
+ */
+TEST_F (NNSRateTest, adaptiveWithoutQos)
+{
+  guint64 in, out, dup, drop;
+
+  ASSERT_TRUE (setupPipeline());
+
+  GstElement *rate = getRateElem();
+  ASSERT_TRUE (rate != NULL);
+
+  g_object_set (rate, "adaptive", (gboolean) TRUE, NULL);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING,
+    UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  EXPECT_TRUE (NNSRateTest::wait_pipeline_eos (pipeline));
+
+  g_object_get (rate, "in", &in, NULL);
+  g_object_get (rate, "out", &out, NULL);
+  g_object_get (rate, "duplicate", &dup, NULL);
+  g_object_get (rate, "drop", &drop, NULL);
+
+  EXPECT_EQ (in, source_num_buffers);
+  EXPECT_EQ (out, source_num_buffers);
+  EXPECT_EQ (0U, dup);
+  EXPECT_EQ (0U, drop);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL,
+        UNITTEST_STATECHANGE_TIMEOUT), 0);
+}
+
 /**
  * @brief Test tensor_rate with no-throttling mode
  */
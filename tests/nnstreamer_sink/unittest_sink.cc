@@ -20,6 +20,7 @@
 #include "tensor_common.h"
 
 #include "../gst/nnstreamer/tensor_filter/tensor_filter_common.h"
+#include "../gst/nnstreamer/tracers/gsttensor_metrics.h"
 
 /**
  * @brief Macro for debug mode.
@@ -1233,6 +1234,14 @@ TEST (tensorSinkTest, properties)
   g_object_get (g_test_data.sink, "signal-rate", &res_rate, NULL);
   EXPECT_EQ (res_rate, rate);
 
+  /** default max-buffers is 0 (queue disabled) */
+  g_object_get (g_test_data.sink, "max-buffers", &rate, NULL);
+  EXPECT_EQ (rate, 0U);
+
+  g_object_set (g_test_data.sink, "max-buffers", 3U, NULL);
+  g_object_get (g_test_data.sink, "max-buffers", &res_rate, NULL);
+  EXPECT_EQ (res_rate, 3U);
+
   /** default emit-signal is TRUE */
   g_object_get (g_test_data.sink, "emit-signal", &emit, NULL);
   EXPECT_EQ (emit, TRUE);
@@ -1378,6 +1387,64 @@ TEST (tensorSinkTest, emitSignal)
   _free_test_data (option);
 }
 
+/**
+ * @brief Test for tensor sink pull-buffer (drop the oldest buffers).
+ */
+TEST (tensorSinkTest, pullBuffer)
+{
+  const guint num_buffers = 5;
+  GstBuffer *buffer;
+  guint64 prev_pts = 0;
+  guint64 dropped = 0;
+  guint i;
+  TestOption option = { num_buffers, TEST_TYPE_VIDEO_RGB };
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  g_object_set (g_test_data.sink, "emit-signal", (gboolean)FALSE,
+      "max-buffers", 2U, NULL);
+
+  /** no buffer before start */
+  buffer = NULL;
+  g_signal_emit_by_name (g_test_data.sink, "pull-buffer", (GstClockTime) 0, &buffer);
+  EXPECT_TRUE (buffer == NULL);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /** the newest 2 buffers are kept in the queue */
+  for (i = 0; i < 2; i++) {
+    buffer = NULL;
+    g_signal_emit_by_name (
+        g_test_data.sink, "pull-buffer", (GstClockTime) GST_SECOND, &buffer);
+    ASSERT_TRUE (buffer != NULL);
+
+    if (i > 0)
+      EXPECT_GT (GST_BUFFER_PTS (buffer), prev_pts);
+    prev_pts = GST_BUFFER_PTS (buffer);
+    gst_buffer_unref (buffer);
+  }
+
+  /** eos reached and the queue is empty */
+  buffer = NULL;
+  g_signal_emit_by_name (g_test_data.sink, "pull-buffer", GST_CLOCK_TIME_NONE, &buffer);
+  EXPECT_TRUE (buffer == NULL);
+
+  g_object_get (g_test_data.sink, "dropped", &dropped, NULL);
+  EXPECT_EQ (dropped, (guint64) (num_buffers - 2));
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /** no signal */
+  EXPECT_EQ (g_test_data.received, 0U);
+
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
 /**
  * @brief Test for tensor sink signal-rate.
  */
@@ -3502,43 +3569,790 @@ TEST (tensorStreamTest, flexToStatic)
 
   timeout_id = g_timeout_add (5000, _test_src_eos_timer_cb, g_test_data.loop);
   g_main_loop_run (g_test_data.loop);
-  g_source_remove (timeout_id);
+  g_source_remove (timeout_id);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /** check received buffers */
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.mem_blocks, 1U);
+  EXPECT_EQ (g_test_data.received_size, 10U);
+
+  /** check timestamp */
+  EXPECT_FALSE (g_test_data.invalid_timestamp);
+
+  /** check tensor config */
+  EXPECT_TRUE (gst_tensors_config_validate (&g_test_data.tensors_config));
+  EXPECT_EQ (g_test_data.tensors_config.info.info[0].type, _NNS_UINT8);
+  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[0], 10U);
+  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[1], 1U);
+  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[2], 1U);
+  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[3], 1U);
+  EXPECT_EQ (g_test_data.tensors_config.rate_n, 10);
+  EXPECT_EQ (g_test_data.tensors_config.rate_d, 1);
+
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for other/tensor, passthrough custom filter.
+ */
+TEST (tensorStreamTest, customFilterTensor)
+{
+  const guint num_buffers = 5;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_TENSOR };
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /** check received buffers */
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.mem_blocks, 1U);
+  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
+
+  /** check timestamp */
+  EXPECT_FALSE (g_test_data.invalid_timestamp);
+
+  /** check tensor config for video */
+  EXPECT_TRUE (gst_tensors_config_validate (&g_test_data.tensors_config));
+  EXPECT_EQ (g_test_data.tensors_config.info.info[0].type, _NNS_UINT8);
+  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[0], 3U);
+  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[1], 160U);
+  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[2], 120U);
+  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[3], 1U);
+  EXPECT_EQ (g_test_data.tensors_config.rate_n, (int)fps);
+  EXPECT_EQ (g_test_data.tensors_config.rate_d, 1);
+
+  /** check caps and config for tensor */
+  {
+    GstCaps *caps;
+    GstStructure *structure;
+    GstTensorsConfig config;
+
+    caps = gst_tensors_caps_from_config (&g_test_data.tensors_config);
+    structure = gst_caps_get_structure (caps, 0);
+
+    EXPECT_TRUE (gst_tensors_config_from_structure (&config, structure));
+    EXPECT_TRUE (gst_tensors_config_is_equal (&config, &g_test_data.tensors_config));
+
+    gst_caps_unref (caps);
+    gst_tensors_config_free (&config);
+  }
+
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for other/tensor, passthrough custom filter with multiple workers.
+ */
+TEST (tensorStreamTest, customFilterTensorWorkers)
+{
+  const guint num_buffers = 10;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_TENSOR };
+  GstElement *filter;
+  guint workers;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  filter = gst_bin_get_by_name (GST_BIN (g_test_data.pipeline), "test_filter");
+
+  /* default is single worker */
+  g_object_get (filter, "workers", &workers, NULL);
+  EXPECT_EQ (workers, 1U);
+
+  g_object_set (filter, "workers", 3U, NULL);
+  g_object_get (filter, "workers", &workers, NULL);
+  EXPECT_EQ (workers, 3U);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /** check received buffers (in order) */
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.mem_blocks, 1U);
+  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
+  EXPECT_FALSE (g_test_data.invalid_timestamp);
+
+  gst_object_unref (filter);
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for other/tensor, passthrough custom filter with dynamic batching.
+ */
+TEST (tensorStreamTest, customFilterTensorBatch)
+{
+  const guint num_buffers = 5;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_TENSOR };
+  GstElement *filter;
+  guint max_batch;
+  guint64 timeout;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  filter = gst_bin_get_by_name (GST_BIN (g_test_data.pipeline), "test_filter");
+
+  /* default is no batching */
+  g_object_get (filter, "max-batch", &max_batch, "batch-timeout", &timeout, NULL);
+  EXPECT_EQ (max_batch, 1U);
+  EXPECT_EQ (timeout, 0ULL);
+
+  /* the last frame is invoked with EOS (incomplete batch) */
+  g_object_set (filter, "max-batch", 2U, "batch-timeout", (guint64) 100000, NULL);
+  g_object_get (filter, "max-batch", &max_batch, "batch-timeout", &timeout, NULL);
+  EXPECT_EQ (max_batch, 2U);
+  EXPECT_EQ (timeout, 100000ULL);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /** check received buffers (single frame) */
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.mem_blocks, 1U);
+  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
+  EXPECT_FALSE (g_test_data.invalid_timestamp);
+  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[0], 3U);
+  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[1], 160U);
+  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[2], 120U);
+  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[3], 1U);
+
+  gst_object_unref (filter);
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for latency percentiles of tensor_filter.
+ */
+TEST (tensorStreamTest, customFilterTensorLatencyStats)
+{
+  const guint num_buffers = 10;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_TENSOR };
+  GstElement *filter;
+  gint64 p50, p90, p99, max;
+  guint interval;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  filter = gst_bin_get_by_name (GST_BIN (g_test_data.pipeline), "test_filter");
+
+  /* not measured yet */
+  g_object_get (filter, "latency-p50", &p50, "latency-max", &max,
+      "stats-interval", &interval, NULL);
+  EXPECT_EQ (p50, -1);
+  EXPECT_EQ (max, -1);
+  EXPECT_EQ (interval, 0U);
+
+  g_object_set (filter, "latency", 1, "stats-interval", 1U, NULL);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+
+  g_object_get (filter, "latency-p50", &p50, "latency-p90", &p90,
+      "latency-p99", &p99, "latency-max", &max, NULL);
+  EXPECT_GE (p50, 0);
+  EXPECT_LE (p50, p90);
+  EXPECT_LE (p90, p99);
+  EXPECT_LE (p99, max);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+  EXPECT_EQ (g_test_data.received, num_buffers);
+
+  gst_object_unref (filter);
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for tensor_filter warming up the model before the first frame.
+ */
+TEST (tensorStreamTest, customFilterTensorWarmup)
+{
+  const guint num_buffers = 5;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_TENSOR };
+  GstElement *filter;
+  guint warmup;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  filter = gst_bin_get_by_name (GST_BIN (g_test_data.pipeline), "test_filter");
+
+  g_object_get (filter, "warmup", &warmup, NULL);
+  EXPECT_EQ (warmup, 0U);
+
+  g_object_set (filter, "warmup", 3U, NULL);
+  g_object_get (filter, "warmup", &warmup, NULL);
+  EXPECT_EQ (warmup, 3U);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /** the outputs of dummy invokes are not pushed */
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.mem_blocks, 1U);
+  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
+
+  gst_object_unref (filter);
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for tensor_filter with the device memory, the framework without the device memory copies the tensors to host memory.
+ */
+TEST (tensorStreamTest, customFilterTensorDeviceMemory)
+{
+  const guint num_buffers = 5;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_TENSOR };
+  GstElement *filter;
+  gboolean device_memory;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  filter = gst_bin_get_by_name (GST_BIN (g_test_data.pipeline), "test_filter");
+
+  g_object_get (filter, "device-memory", &device_memory, NULL);
+  EXPECT_FALSE (device_memory);
+
+  g_object_set (filter, "device-memory", TRUE, NULL);
+  g_object_get (filter, "device-memory", &device_memory, NULL);
+  EXPECT_TRUE (device_memory);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /** check received buffers */
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.mem_blocks, 1U);
+  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
+
+  gst_object_unref (filter);
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for tensor_filter with the accelerator scheduling properties.
+ */
+TEST (tensorStreamTest, customFilterTensorAcclSchedule)
+{
+  const guint num_buffers = 5;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_TENSOR };
+  GstElement *filter;
+  gboolean schedule;
+  gint priority;
+  guint weight;
+  guint64 budget;
+  gdouble utilization;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  filter = gst_bin_get_by_name (GST_BIN (g_test_data.pipeline), "test_filter");
+
+  g_object_get (filter, "accl-schedule", &schedule, "accl-priority", &priority,
+      "accl-weight", &weight, "accl-latency-budget", &budget,
+      "accl-utilization", &utilization, NULL);
+  EXPECT_FALSE (schedule);
+  EXPECT_EQ (priority, 0);
+  EXPECT_EQ (weight, 1U);
+  EXPECT_EQ (budget, 0U);
+  EXPECT_DOUBLE_EQ (utilization, -1.0);
+
+  g_object_set (filter, "accl-schedule", TRUE, "accl-priority", 10,
+      "accl-weight", 3U, "accl-latency-budget", (guint64) 1000, NULL);
+  g_object_get (filter, "accl-schedule", &schedule, "accl-priority", &priority,
+      "accl-weight", &weight, "accl-latency-budget", &budget, NULL);
+  EXPECT_TRUE (schedule);
+  EXPECT_EQ (priority, 10);
+  EXPECT_EQ (weight, 3U);
+  EXPECT_EQ (budget, 1000U);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+
+  /** the custom filter runs on CPU, the invokes are not scheduled */
+  g_object_get (filter, "accl-utilization", &utilization, NULL);
+  EXPECT_DOUBLE_EQ (utilization, -1.0);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /** check received buffers */
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
+
+  gst_object_unref (filter);
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for tensor_filter with the accelerator switching properties.
+ */
+TEST (tensorStreamTest, customFilterTensorAcclSwitch)
+{
+  const guint num_buffers = 5;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_TENSOR };
+  GstElement *filter;
+  guint64 high, low;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  filter = gst_bin_get_by_name (GST_BIN (g_test_data.pipeline), "test_filter");
+
+  g_object_get (filter, "accl-switch-high", &high, "accl-switch-low", &low, NULL);
+  EXPECT_EQ (high, 0U);
+  EXPECT_EQ (low, 0U);
+
+  g_object_set (filter, "accl-switch-high", (guint64) 1,
+      "accl-switch-low", (guint64) 1, NULL);
+  g_object_get (filter, "accl-switch-high", &high, "accl-switch-low", &low, NULL);
+  EXPECT_EQ (high, 1U);
+  EXPECT_EQ (low, 1U);
+
+  /** the custom filter has no accelerator to switch, the invokes are done on CPU */
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /** check received buffers */
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
+
+  gst_object_unref (filter);
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for tensor_filter skipping the invoke for the unchanged input.
+ */
+TEST (tensorStreamTest, customFilterTensorSkipInvoke)
+{
+  const guint num_buffers = 5;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_TENSOR };
+  GstElement *filter;
+  gdouble threshold, rate;
+  guint sample, max;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  filter = gst_bin_get_by_name (GST_BIN (g_test_data.pipeline), "test_filter");
+
+  g_object_get (filter, "skip-threshold", &threshold, "skip-sample", &sample,
+      "skip-max", &max, "skip-rate", &rate, NULL);
+  EXPECT_DOUBLE_EQ (threshold, 0.0);
+  EXPECT_EQ (sample, 4U);
+  EXPECT_EQ (max, 0U);
+  EXPECT_DOUBLE_EQ (rate, 0.0);
+
+  g_object_set (filter, "skip-threshold", 1.0, "skip-sample", 2U,
+      "skip-max", 2U, NULL);
+  g_object_get (filter, "skip-threshold", &threshold, "skip-sample", &sample,
+      "skip-max", &max, NULL);
+  EXPECT_DOUBLE_EQ (threshold, 1.0);
+  EXPECT_EQ (sample, 2U);
+  EXPECT_EQ (max, 2U);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+
+  /** the frames of videotestsrc are same, the 1st and 4th frames are invoked (skip-max) */
+  g_object_get (filter, "skip-rate", &rate, NULL);
+  EXPECT_DOUBLE_EQ (rate, 3.0 / 5.0);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /** the skipped frames are pushed with the previous output */
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
+
+  gst_object_unref (filter);
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for tensor_filter with the cache of the outputs.
+ */
+TEST (tensorStreamTest, customFilterTensorCache)
+{
+  const guint num_buffers = 5;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_TENSOR };
+  GstElement *filter;
+  guint64 size;
+  gdouble rate;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  filter = gst_bin_get_by_name (GST_BIN (g_test_data.pipeline), "test_filter");
+
+  g_object_get (filter, "cache-size", &size, "cache-hit-rate", &rate, NULL);
+  EXPECT_EQ (size, 0U);
+  EXPECT_DOUBLE_EQ (rate, -1.0);
+
+  g_object_set (filter, "cache-size", (guint64) (1024 * 1024), NULL);
+  g_object_get (filter, "cache-size", &size, NULL);
+  EXPECT_EQ (size, 1024U * 1024U);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+
+  /** the frames of videotestsrc are same, only the 1st frame is invoked */
+  g_object_get (filter, "cache-hit-rate", &rate, NULL);
+  EXPECT_DOUBLE_EQ (rate, 4.0 / 5.0);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /** the cached output is pushed for the same input */
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
+
+  gst_object_unref (filter);
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for tensor_filter with the deadline of the frames.
+ */
+TEST (tensorStreamTest, customFilterTensorDeadline)
+{
+  const guint num_buffers = 5;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_TENSOR };
+  GstElement *filter;
+  guint64 deadline;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  filter = gst_bin_get_by_name (GST_BIN (g_test_data.pipeline), "test_filter");
+
+  g_object_get (filter, "deadline", &deadline, NULL);
+  EXPECT_EQ (deadline, 0U);
+
+  /** the frames of videotestsrc (not live) are earlier than the clock */
+  g_object_set (filter, "deadline", (guint64) G_USEC_PER_SEC, NULL);
+  g_object_get (filter, "deadline", &deadline, NULL);
+  EXPECT_EQ (deadline, (guint64) G_USEC_PER_SEC);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /** no frame is dropped */
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
+
+  gst_object_unref (filter);
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for tensor_filter invoking the models in the cascade.
+ */
+TEST (tensorStreamTest, customFilterTensorCascade)
+{
+  const guint num_buffers = 5;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_TENSOR };
+  GstElement *filter;
+  gchar *model, *cascade, *str;
+  gdouble depth;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  filter = gst_bin_get_by_name (GST_BIN (g_test_data.pipeline), "test_filter");
+
+  g_object_get (filter, "cascade", &str, NULL);
+  EXPECT_STREQ (str, "");
+  g_free (str);
+
+  /** the average of uint8 tensor never exceeds 255, all models are invoked */
+  model = g_strdup_printf ("%s/libnnstreamer_customfilter_passthrough_variable%s",
+      custom_dir ? custom_dir : "./tests/nnstreamer_example",
+      NNSTREAMER_SO_FILE_EXTENSION);
+  cascade = g_strdup_printf ("%s;%s", model, model);
+  g_object_set (filter, "cascade", cascade, "cascade-condition",
+      "compared-value=TENSOR_AVERAGE_VALUE compared-value-option=0 operator=GT supplied-value=255",
+      NULL);
+  g_object_get (filter, "cascade", &str, NULL);
+  EXPECT_STREQ (str, cascade);
+  g_free (str);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+
+  /** the model and 2 models in the cascade are invoked for each frame */
+  g_object_get (filter, "cascade-depth", &depth, NULL);
+  EXPECT_DOUBLE_EQ (depth, 3.0);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+
+  /** check received buffers */
+  EXPECT_EQ (g_test_data.received, num_buffers);
+  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
+
+  g_free (model);
+  g_free (cascade);
+  gst_object_unref (filter);
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for tensor_filter with the CPU affinity and thread pool.
+ */
+TEST (tensorStreamTest, customFilterTensorCpuAffinity)
+{
+  const guint num_buffers = 5;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_TENSOR };
+  GstElement *filter;
+  gchar *cpus;
+  guint threads;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  filter = gst_bin_get_by_name (GST_BIN (g_test_data.pipeline), "test_filter");
+
+  g_object_get (filter, "cpu-affinity", &cpus, "thread-pool", &threads, NULL);
+  EXPECT_STREQ (cpus, "");
+  EXPECT_EQ (threads, 0U);
+  g_free (cpus);
+
+  g_object_set (filter, "cpu-affinity", "0", "thread-pool", 2U, NULL);
+  g_object_get (filter, "cpu-affinity", &cpus, "thread-pool", &threads, NULL);
+  EXPECT_STREQ (cpus, "0");
+  EXPECT_EQ (threads, 2U);
+  g_free (cpus);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+  EXPECT_EQ (g_test_data.received, num_buffers);
+
+  gst_object_unref (filter);
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for tensor_filter with the NUMA node.
+ */
+TEST (tensorStreamTest, customFilterTensorNumaNode)
+{
+  const guint num_buffers = 5;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_TENSOR };
+  GstElement *filter;
+  gint node;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  filter = gst_bin_get_by_name (GST_BIN (g_test_data.pipeline), "test_filter");
+
+  g_object_get (filter, "numa-node", &node, NULL);
+  EXPECT_EQ (node, -1);
+
+  /* node 0 exists in any system, the memory is allocated in node 0 */
+  g_object_set (filter, "numa-node", 0, NULL);
+  g_object_get (filter, "numa-node", &node, NULL);
+  EXPECT_EQ (node, 0);
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
+
+  EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
+
+  /** check eos message */
+  EXPECT_EQ (g_test_data.status, TEST_EOS);
+  EXPECT_EQ (g_test_data.received, num_buffers);
+
+  gst_object_unref (filter);
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
+}
+
+/**
+ * @brief Test for tensor_filter with invalid list of CPU cores.
+ */
+TEST (tensorStreamTest, customFilterTensorCpuAffinityInvalid_n)
+{
+  TestOption option = { 1, TEST_TYPE_CUSTOM_TENSOR };
+  GstElement *filter;
+  gchar *cpus;
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  filter = gst_bin_get_by_name (GST_BIN (g_test_data.pipeline), "test_filter");
+
+  g_object_set (filter, "cpu-affinity", "3-1", NULL);
+  g_object_get (filter, "cpu-affinity", &cpus, NULL);
+  EXPECT_STREQ (cpus, "");
+  g_free (cpus);
+
+  g_object_set (filter, "cpu-affinity", "0,a", NULL);
+  g_object_get (filter, "cpu-affinity", &cpus, NULL);
+  EXPECT_STREQ (cpus, "");
+  g_free (cpus);
+
+  gst_object_unref (filter);
+  _free_test_data (option);
+}
+
+#ifndef GST_DISABLE_GST_TRACER_HOOKS
+/**
+ * @brief Test for the tensortrace tracer writing Chrome trace JSON.
+ */
+TEST (tensorStreamTest, customFilterTensorTracer)
+{
+  const guint num_buffers = 5;
+  TestOption option = { num_buffers, TEST_TYPE_CUSTOM_TENSOR };
+  GstPluginFeature *feature;
+  GObject *tracer;
+  gchar *trace_file, *params, *contents = NULL;
+
+  feature = gst_registry_lookup_feature (gst_registry_get (), "tensortrace");
+  ASSERT_TRUE (feature != NULL);
+
+  trace_file = g_build_filename (g_get_tmp_dir (), "nnst_tensortrace.json", NULL);
+  params = g_strdup_printf ("file=%s", trace_file);
+  tracer = (GObject *) g_object_new (gst_tracer_factory_get_tracer_type (
+                                         GST_TRACER_FACTORY (feature)),
+      "params", params, NULL);
+  ASSERT_TRUE (tracer != NULL);
+
+  ASSERT_TRUE (_setup_pipeline (option));
+
+  gst_element_set_state (g_test_data.pipeline, GST_STATE_PLAYING);
+  g_main_loop_run (g_test_data.loop);
 
   EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
   gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
-
-  /** check eos message */
   EXPECT_EQ (g_test_data.status, TEST_EOS);
-
-  /** check received buffers */
   EXPECT_EQ (g_test_data.received, num_buffers);
-  EXPECT_EQ (g_test_data.mem_blocks, 1U);
-  EXPECT_EQ (g_test_data.received_size, 10U);
+  EXPECT_FALSE (g_test_data.test_failed);
+  _free_test_data (option);
 
-  /** check timestamp */
-  EXPECT_FALSE (g_test_data.invalid_timestamp);
+  /* the trace file is closed when the tracer is released */
+  g_object_unref (tracer);
 
-  /** check tensor config */
-  EXPECT_TRUE (gst_tensors_config_validate (&g_test_data.tensors_config));
-  EXPECT_EQ (g_test_data.tensors_config.info.info[0].type, _NNS_UINT8);
-  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[0], 10U);
-  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[1], 1U);
-  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[2], 1U);
-  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[3], 1U);
-  EXPECT_EQ (g_test_data.tensors_config.rate_n, 10);
-  EXPECT_EQ (g_test_data.tensors_config.rate_d, 1);
+  ASSERT_TRUE (g_file_get_contents (trace_file, &contents, NULL, NULL));
+  EXPECT_TRUE (g_str_has_prefix (contents, "["));
+  EXPECT_TRUE (g_str_has_suffix (contents, "]\n"));
+  EXPECT_TRUE (strstr (contents, "\"name\":\"test_filter\",\"cat\":\"element\"") != NULL);
+  EXPECT_TRUE (strstr (contents, "\"name\":\"test_filter:invoke\"") != NULL);
 
-  EXPECT_FALSE (g_test_data.test_failed);
-  _free_test_data (option);
+  g_free (contents);
+  g_remove (trace_file);
+  g_free (trace_file);
+  g_free (params);
+  gst_object_unref (feature);
 }
 
 /**
- * @brief Test for other/tensor, passthrough custom filter.
+ * @brief Test for the tensormetrics tracer serving the metrics in Prometheus text format.
  */
-TEST (tensorStreamTest, customFilterTensor)
+TEST (tensorStreamTest, customFilterTensorMetrics)
 {
   const guint num_buffers = 5;
   TestOption option = { num_buffers, TEST_TYPE_CUSTOM_TENSOR };
+  GstPluginFeature *feature;
+  GObject *tracer;
+  GSocketClient *client;
+  GSocketConnection *conn;
+  GInputStream *in;
+  gchar *metrics, *request;
+  gchar response[4096];
+  gsize len = 0;
+  gssize n;
+
+  feature = gst_registry_lookup_feature (gst_registry_get (), "tensormetrics");
+  ASSERT_TRUE (feature != NULL);
+
+  /* available port */
+  tracer = (GObject *) g_object_new (gst_tracer_factory_get_tracer_type (
+                                         GST_TRACER_FACTORY (feature)),
+      "params", "address=127.0.0.1,port=0", NULL);
+  ASSERT_TRUE (tracer != NULL);
+  ASSERT_TRUE (GST_TENSOR_METRICS (tracer)->service != NULL);
 
   ASSERT_TRUE (_setup_pipeline (option));
 
@@ -3547,47 +4361,48 @@ TEST (tensorStreamTest, customFilterTensor)
 
   EXPECT_TRUE (_wait_pipeline_process_buffers (num_buffers));
   gst_element_set_state (g_test_data.pipeline, GST_STATE_NULL);
-
-  /** check eos message */
   EXPECT_EQ (g_test_data.status, TEST_EOS);
-
-  /** check received buffers */
   EXPECT_EQ (g_test_data.received, num_buffers);
-  EXPECT_EQ (g_test_data.mem_blocks, 1U);
-  EXPECT_EQ (g_test_data.received_size, 3U * 160 * 120);
-
-  /** check timestamp */
-  EXPECT_FALSE (g_test_data.invalid_timestamp);
-
-  /** check tensor config for video */
-  EXPECT_TRUE (gst_tensors_config_validate (&g_test_data.tensors_config));
-  EXPECT_EQ (g_test_data.tensors_config.info.info[0].type, _NNS_UINT8);
-  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[0], 3U);
-  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[1], 160U);
-  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[2], 120U);
-  EXPECT_EQ (g_test_data.tensors_config.info.info[0].dimension[3], 1U);
-  EXPECT_EQ (g_test_data.tensors_config.rate_n, (int)fps);
-  EXPECT_EQ (g_test_data.tensors_config.rate_d, 1);
-
-  /** check caps and config for tensor */
-  {
-    GstCaps *caps;
-    GstStructure *structure;
-    GstTensorsConfig config;
-
-    caps = gst_tensors_caps_from_config (&g_test_data.tensors_config);
-    structure = gst_caps_get_structure (caps, 0);
-
-    EXPECT_TRUE (gst_tensors_config_from_structure (&config, structure));
-    EXPECT_TRUE (gst_tensors_config_is_equal (&config, &g_test_data.tensors_config));
 
-    gst_caps_unref (caps);
-    gst_tensors_config_free (&config);
-  }
+  metrics = gst_tensor_metrics_collect (GST_TENSOR_METRICS (tracer));
+  EXPECT_TRUE (strstr (metrics,
+      "# TYPE nnstreamer_filter_invoke_latency_seconds histogram") != NULL);
+  EXPECT_TRUE (strstr (metrics,
+      "nnstreamer_filter_invoke_latency_seconds_count{element=\"test_filter\"") != NULL);
+  EXPECT_TRUE (strstr (metrics,
+      "nnstreamer_element_bytes_total{element=\"test_filter\",factory=\"tensor_filter\",direction=\"in\"}") != NULL);
+  EXPECT_TRUE (strstr (metrics, "nnstreamer_allocator_hits_total") != NULL);
+  g_free (metrics);
+
+  /* scrape the endpoint */
+  client = g_socket_client_new ();
+  conn = g_socket_client_connect_to_host (client, "127.0.0.1",
+      GST_TENSOR_METRICS (tracer)->port, NULL, NULL);
+  ASSERT_TRUE (conn != NULL);
+
+  request = g_strdup ("GET /metrics HTTP/1.0\r\n\r\n");
+  EXPECT_TRUE (g_output_stream_write_all (
+      g_io_stream_get_output_stream (G_IO_STREAM (conn)), request,
+      strlen (request), NULL, NULL, NULL));
+
+  in = g_io_stream_get_input_stream (G_IO_STREAM (conn));
+  while (len < sizeof (response) - 1
+         && (n = g_input_stream_read (in, response + len, sizeof (response) - 1 - len, NULL, NULL)) > 0)
+    len += (gsize) n;
+  response[len] = '\0';
+
+  EXPECT_TRUE (g_str_has_prefix (response, "HTTP/1.0 200 OK"));
+  EXPECT_TRUE (strstr (response, "nnstreamer_filter_invoke_latency_seconds") != NULL);
+
+  g_free (request);
+  g_object_unref (conn);
+  g_object_unref (client);
 
-  EXPECT_FALSE (g_test_data.test_failed);
   _free_test_data (option);
+  g_object_unref (tracer);
+  gst_object_unref (feature);
 }
+#endif
 
 /**
  * @brief Test for other/tensors, passthrough custom filter.
@@ -4317,6 +5132,69 @@ test_custom_v1_eventHandler (const GstTensorFilterFramework *self,
   return -ENOENT;
 }
 
+static guint test_custom_v2_invoked = 0;
+
+/**
+ * @brief Data to complete the invoke of the custom filter (v2) in other thread.
+ */
+typedef struct
+{
+  GstMemory *input; /**< the input memory kept until the invoke is done */
+  GstMemory **output; /**< the output memory to be set */
+  GstTensorFilterInvokeDone done; /**< the completion callback */
+  void *handle; /**< the handle of the completion callback */
+} test_custom_v2_job;
+
+/**
+ * @brief Copy the input memory to the output in other thread (v2).
+ */
+static gpointer
+test_custom_v2_thread (gpointer data)
+{
+  test_custom_v2_job *job = (test_custom_v2_job *) data;
+  GstMapInfo in_info, out_info;
+  gsize size;
+
+  size = gst_memory_get_sizes (job->input, NULL, NULL);
+  job->output[0] = gst_allocator_alloc (NULL, size, NULL);
+
+  gst_memory_map (job->input, &in_info, GST_MAP_READ);
+  gst_memory_map (job->output[0], &out_info, GST_MAP_WRITE);
+  memcpy (out_info.data, in_info.data, size);
+  gst_memory_unmap (job->output[0], &out_info);
+  gst_memory_unmap (job->input, &in_info);
+
+  gst_memory_unref (job->input);
+  job->done (job->handle, 0);
+  g_free (job);
+  return NULL;
+}
+
+/**
+ * @brief The invoke with the memory of the tensors (v2), done in other thread.
+ */
+static int
+test_custom_v2_invoke_memory (const GstTensorFilterFramework *self,
+    const GstTensorFilterProperties *prop, void *private_data, GstMemory **input,
+    unsigned int num_input, GstMemory **output, unsigned int num_output,
+    GstTensorFilterInvokeDone done, void *handle)
+{
+  test_custom_v2_job *job;
+
+  if (num_input != 1U || num_output != 1U)
+    return -EINVAL;
+
+  job = g_new0 (test_custom_v2_job, 1);
+  job->input = gst_memory_ref (input[0]);
+  job->output = output;
+  job->done = done;
+  job->handle = handle;
+
+  test_custom_v2_invoked++;
+  g_thread_unref (g_thread_new ("test-v2", test_custom_v2_thread, job));
+  return -EINPROGRESS;
+}
+
 /**
  * @brief Test for passthrough custom filter without model.
  */
@@ -4559,6 +5437,33 @@ TEST (tensorStreamTest, subpluginV1Run)
   g_free (fw);
 }
 
+/**
+ * @brief Test for passthrough custom filter invoked with the memory of the tensors (v2).
+ */
+TEST (tensorStreamTest, subpluginV2InvokeMemory)
+{
+  GstTensorFilterFramework *fw = g_new0 (GstTensorFilterFramework, 1);
+
+  ASSERT_TRUE (fw != NULL);
+  fw->version = GST_TENSOR_FILTER_FRAMEWORK_V2;
+  fw->invoke = test_custom_v1_invoke;
+  fw->getFrameworkInfo = test_custom_v1_getFWInfo;
+  fw->getModelInfo = test_custom_v1_getModelInfo;
+  fw->eventHandler = test_custom_v1_eventHandler;
+  fw->invoke_memory = test_custom_v2_invoke_memory;
+
+  /* register custom filter */
+  EXPECT_TRUE (nnstreamer_filter_probe (fw));
+
+  test_custom_v2_invoked = 0;
+  test_custom_run_pipeline ();
+  EXPECT_EQ (test_custom_v2_invoked, 10U);
+
+  /* unregister custom filter */
+  nnstreamer_filter_exit (test_fw_custom_name);
+  g_free (fw);
+}
+
 /**
  * @brief Test for plugin registration with invalid param (v1).
  */
@@ -6417,6 +7322,144 @@ TEST (tensorFilterCustomEasy, unregister1_n)
   ASSERT_NE (ret, 0);
 }
 
+#include <math.h>
+#include <tensor_filter_custom_easy_ops.h>
+
+/**
+ * @brief Test argmax and top-k of custom-easy ops
+ */
+TEST (tensorFilterCustomEasyOps, argmaxTopk)
+{
+  float data[11] = { 0.1f, 0.7f, -1.0f, 0.3f, 0.9f, 0.2f, 0.9f, 0.0f, 0.5f, 0.8f, 0.4f };
+  uint8_t qdata[5] = { 3, 10, 200, 255, 7 };
+  GstTensorMemory in = { data, sizeof (data) };
+  uint32_t index = 0U, indices[3];
+  float scores[3];
+
+  EXPECT_EQ (NNS_custom_easy_argmax (&in, _NNS_FLOAT32, &index), 0);
+  EXPECT_EQ (index, 4U);
+
+  EXPECT_EQ (NNS_custom_easy_topk (&in, _NNS_FLOAT32, 3, indices, scores), 3);
+  EXPECT_EQ (indices[0], 4U);
+  EXPECT_EQ (indices[1], 6U);
+  EXPECT_EQ (indices[2], 9U);
+  EXPECT_FLOAT_EQ (scores[2], 0.8f);
+
+  in.data = qdata;
+  in.size = sizeof (qdata);
+  EXPECT_EQ (NNS_custom_easy_argmax (&in, _NNS_UINT8, &index), 0);
+  EXPECT_EQ (index, 3U);
+}
+
+/**
+ * @brief Test argmax with invalid param
+ */
+TEST (tensorFilterCustomEasyOps, argmaxInvalidParam_n)
+{
+  float data[4] = { 0.0f };
+  GstTensorMemory in = { data, sizeof (data) };
+  uint32_t index;
+
+  EXPECT_NE (NNS_custom_easy_argmax (NULL, _NNS_FLOAT32, &index), 0);
+  EXPECT_NE (NNS_custom_easy_argmax (&in, _NNS_FLOAT32, NULL), 0);
+  EXPECT_NE (NNS_custom_easy_argmax (&in, _NNS_END, &index), 0);
+  EXPECT_LT (NNS_custom_easy_topk (&in, _NNS_FLOAT32, 0, &index, NULL), 0);
+}
+
+/**
+ * @brief Test softmax, sigmoid and dequantize of custom-easy ops
+ */
+TEST (tensorFilterCustomEasyOps, elementwise)
+{
+  float data[10], out[10], sum;
+  uint8_t qdata[10];
+  GstTensorMemory in = { data, sizeof (data) };
+  GstTensorMemory mem_out = { out, sizeof (out) };
+  GstTensorMemory qin = { qdata, sizeof (qdata) };
+  guint i;
+
+  for (i = 0; i < 10; i++)
+    data[i] = (float) i - 4.5f;
+
+  /* softmax of 2 rows */
+  EXPECT_EQ (NNS_custom_easy_softmax (&in, &mem_out, 5), 0);
+  sum = 0.0f;
+  for (i = 0; i < 5; i++)
+    sum += out[i];
+  EXPECT_NEAR (sum, 1.0f, 1e-5);
+  EXPECT_NEAR (out[4], 1.0f / (1.0f + expf (-1.0f) + expf (-2.0f) + expf (-3.0f) + expf (-4.0f)), 1e-5);
+  EXPECT_NEAR (out[5], out[0], 1e-6);
+
+  EXPECT_EQ (NNS_custom_easy_sigmoid (&in, &mem_out), 0);
+  for (i = 0; i < 10; i++)
+    EXPECT_NEAR (out[i], 1.0f / (1.0f + expf (-data[i])), 1e-6);
+
+  for (i = 0; i < 10; i++)
+    qdata[i] = (uint8_t) (i * 25);
+  EXPECT_EQ (NNS_custom_easy_dequantize (&qin, _NNS_UINT8, 0.5f, 100, &mem_out), 0);
+  for (i = 0; i < 10; i++)
+    EXPECT_FLOAT_EQ (out[i], ((float) (i * 25) - 100.0f) * 0.5f);
+}
+
+/**
+ * @brief Test element-wise functions with invalid param
+ */
+TEST (tensorFilterCustomEasyOps, elementwiseInvalidParam_n)
+{
+  float data[10], out[4];
+  GstTensorMemory in = { data, sizeof (data) };
+  GstTensorMemory mem_out = { out, sizeof (out) };
+
+  /* small output */
+  EXPECT_NE (NNS_custom_easy_softmax (&in, &mem_out, 0), 0);
+  EXPECT_NE (NNS_custom_easy_sigmoid (&in, &mem_out), 0);
+  /* 10 is not multiple of 3 */
+  mem_out.data = data;
+  mem_out.size = sizeof (data);
+  EXPECT_NE (NNS_custom_easy_softmax (&in, &mem_out, 3), 0);
+  EXPECT_NE (NNS_custom_easy_dequantize (&in, _NNS_FLOAT32, 1.0f, 0, &mem_out), 0);
+}
+
+/**
+ * @brief Test box decode and nms of custom-easy ops
+ */
+TEST (tensorFilterCustomEasyOps, boxDecodeNms)
+{
+  float deltas[20] = { 0.0f };
+  float anchors[20], boxes[20];
+  float scores[5] = { 0.9f, 0.8f, 0.7f, 0.6f, 0.05f };
+  const float scales[4] = { 10.0f, 10.0f, 5.0f, 5.0f };
+  GstTensorMemory mem_d = { deltas, sizeof (deltas) };
+  GstTensorMemory mem_a = { anchors, sizeof (anchors) };
+  GstTensorMemory mem_b = { boxes, sizeof (boxes) };
+  GstTensorMemory mem_s = { scores, sizeof (scores) };
+  uint32_t selected[5];
+  guint i;
+
+  /* anchors (cy, cx, h, w): 0, 1 overlap, 2, 3 are apart */
+  for (i = 0; i < 5; i++) {
+    anchors[i * 4] = (i == 1) ? 0.22f : 0.2f * (i + 1);
+    anchors[i * 4 + 1] = 0.5f;
+    anchors[i * 4 + 2] = 0.1f;
+    anchors[i * 4 + 3] = 0.2f;
+  }
+  deltas[1] = 1.0f; /* x-center + 1 / 10 * w */
+
+  EXPECT_EQ (NNS_custom_easy_box_decode (&mem_d, &mem_a, scales, &mem_b), 0);
+  EXPECT_NEAR (boxes[0], 0.15f, 1e-6);
+  EXPECT_NEAR (boxes[1], 0.42f, 1e-6);
+  EXPECT_NEAR (boxes[2], 0.25f, 1e-6);
+  EXPECT_NEAR (boxes[3], 0.62f, 1e-6);
+
+  EXPECT_EQ (NNS_custom_easy_nms (&mem_b, &mem_s, 0.5f, 0.1f, 5, selected), 3);
+  EXPECT_EQ (selected[0], 0U);
+  EXPECT_EQ (selected[1], 2U);
+  EXPECT_EQ (selected[2], 3U);
+
+  EXPECT_EQ (NNS_custom_easy_nms (&mem_b, &mem_s, 0.5f, 0.1f, 1, selected), 1);
+  EXPECT_LT (NNS_custom_easy_nms (&mem_b, &mem_s, 0.5f, 0.1f, 0, selected), 0);
+}
+
 static int data_received = 0;
 const gint test_frames[20] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19};
 
@@ -6519,6 +7562,341 @@ TEST (extraTensors, manualextratensors)
   g_free (str_pipeline);
 }
 
+/**
+ * @brief Test to get the extra tensors of different sizes with gst_tensor_buffer_get_nth_memory API.
+ */
+TEST (extraTensors, nthMemoryDifferentSizes)
+{
+  GstBuffer *buffer;
+  GstMemory *mem;
+  GstMapInfo info;
+  GstTensorsInfo ts_info;
+  gint i, j, *data;
+  const gint num_tensors = NNS_TENSOR_SIZE_LIMIT + 4;
+
+  buffer = gst_buffer_new ();
+
+  for (i = 0; i < num_tensors; i++) {
+    GstTensorInfo tinfo;
+    gint num = (i % 4) + 1;
+
+    mem = gst_allocator_alloc (NULL, num * sizeof (gint), NULL);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+    data = (gint *) info.data;
+    for (j = 0; j < num; j++)
+      data[j] = i * 10 + j;
+    gst_memory_unmap (mem, &info);
+
+    gst_tensor_info_init (&tinfo);
+    tinfo.type = _NNS_INT32;
+    tinfo.dimension[0] = num;
+    for (j = 1; j < NNS_TENSOR_RANK_LIMIT; ++j)
+      tinfo.dimension[j] = 1;
+
+    EXPECT_TRUE (gst_tensor_buffer_append_memory (buffer, mem, &tinfo));
+    gst_tensor_info_free (&tinfo);
+  }
+
+  EXPECT_EQ (gst_buffer_n_memory (buffer), (guint) NNS_TENSOR_SIZE_LIMIT);
+
+  gst_tensors_info_init (&ts_info);
+  ts_info.num_tensors = num_tensors;
+
+  /* access the tensors twice, the layout of extra tensors is cached at first. */
+  for (j = 0; j < 2; j++) {
+    for (i = num_tensors - 1; i >= 0; i--) {
+      gint num = (i % 4) + 1;
+
+      mem = gst_tensor_buffer_get_nth_memory (buffer, &ts_info, i);
+      ASSERT_TRUE (mem != NULL);
+      ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+      EXPECT_EQ (info.size, num * sizeof (gint));
+      data = (gint *) info.data;
+      EXPECT_EQ (data[0], i * 10);
+      EXPECT_EQ (data[num - 1], i * 10 + num - 1);
+      gst_memory_unmap (mem, &info);
+      gst_memory_unref (mem);
+    }
+  }
+
+  /* invalid index */
+  EXPECT_TRUE (gst_tensor_buffer_get_nth_memory (buffer, &ts_info, num_tensors) == NULL);
+
+  gst_buffer_unref (buffer);
+}
+
+/**
+ * @brief Test the cached conversions between caps and tensors config.
+ */
+TEST (tensorCapsCache, configRoundTrip)
+{
+  GstTensorsConfig config, parsed;
+  GstCaps *caps1, *caps2;
+  GstStructure *structure;
+  guint i;
+
+  gst_tensors_config_init (&config);
+  config.rate_n = 30;
+  config.rate_d = 1;
+  config.info.num_tensors = 2;
+  for (i = 0; i < 2; i++) {
+    config.info.info[i].type = _NNS_UINT8;
+    gst_tensor_parse_dimension ("3:224:224:1", config.info.info[i].dimension);
+  }
+
+  /* the second call returns the copy of cached caps */
+  caps1 = gst_tensors_caps_from_config (&config);
+  caps2 = gst_tensors_caps_from_config (&config);
+  ASSERT_TRUE (caps1 != NULL && caps2 != NULL);
+  EXPECT_TRUE (caps1 != caps2);
+  EXPECT_TRUE (gst_caps_is_equal (caps1, caps2));
+  EXPECT_TRUE (gst_caps_is_writable (caps2));
+  gst_caps_unref (caps2);
+
+  /* different dimension should not hit the cache */
+  config.info.info[1].dimension[0] = 4;
+  caps2 = gst_tensors_caps_from_config (&config);
+  EXPECT_FALSE (gst_caps_is_equal (caps1, caps2));
+  gst_caps_unref (caps2);
+
+  /* parse same structure twice */
+  for (i = 0; i < 2; i++) {
+    structure = gst_caps_get_structure (caps1, 0);
+    EXPECT_TRUE (gst_tensors_config_from_structure (&parsed, structure));
+    EXPECT_EQ (parsed.info.num_tensors, 2U);
+    EXPECT_EQ (parsed.info.info[1].type, _NNS_UINT8);
+    EXPECT_EQ (parsed.info.info[1].dimension[0], 3U);
+    EXPECT_EQ (parsed.info.info[1].dimension[1], 224U);
+    EXPECT_EQ (parsed.rate_n, 30);
+    gst_tensors_config_free (&parsed);
+  }
+
+  gst_caps_unref (caps1);
+
+  /* single tensor caps are cached separately */
+  config.info.num_tensors = 1;
+  caps1 = gst_tensor_caps_from_config (&config);
+  caps2 = gst_tensor_caps_from_config (&config);
+  ASSERT_TRUE (caps1 != NULL && caps2 != NULL);
+  EXPECT_TRUE (gst_caps_is_equal (caps1, caps2));
+  structure = gst_caps_get_structure (caps2, 0);
+  EXPECT_TRUE (gst_structure_has_name (structure, NNS_MIMETYPE_TENSOR));
+  gst_caps_unref (caps1);
+  gst_caps_unref (caps2);
+
+  gst_tensors_config_free (&config);
+}
+
+/**
+ * @brief Test to append many extra tensors, the shared extra tensor should not be changed.
+ */
+TEST (extraTensors, appendManyTensors)
+{
+  GstBuffer *buffer;
+  GstMemory *mem, *shared;
+  GstMapInfo info;
+  GstTensorsInfo ts_info;
+  GstTensorInfo tinfo;
+  gint i, j;
+  const gint num_tensors = 60;
+
+  buffer = gst_buffer_new ();
+
+  gst_tensor_info_init (&tinfo);
+  tinfo.type = _NNS_INT32;
+  for (j = 0; j < NNS_TENSOR_RANK_LIMIT; ++j)
+    tinfo.dimension[j] = 1;
+
+  gst_tensors_info_init (&ts_info);
+  shared = NULL;
+
+  for (i = 0; i < num_tensors; i++) {
+    mem = gst_allocator_alloc (NULL, sizeof (gint), NULL);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_WRITE));
+    *((gint *) info.data) = i;
+    gst_memory_unmap (mem, &info);
+
+    EXPECT_TRUE (gst_tensor_buffer_append_memory (buffer, mem, &tinfo));
+
+    /* hold an extra tensor while appending the next tensors */
+    if (i == NNS_TENSOR_SIZE_LIMIT + 2) {
+      ts_info.num_tensors = i + 1;
+      shared = gst_tensor_buffer_get_nth_memory (buffer, &ts_info, i);
+      ASSERT_TRUE (shared != NULL);
+    }
+  }
+
+  EXPECT_EQ (gst_buffer_n_memory (buffer), (guint) NNS_TENSOR_SIZE_LIMIT);
+
+  ASSERT_TRUE (gst_memory_map (shared, &info, GST_MAP_READ));
+  EXPECT_EQ (*((gint *) info.data), NNS_TENSOR_SIZE_LIMIT + 2);
+  gst_memory_unmap (shared, &info);
+  gst_memory_unref (shared);
+
+  ts_info.num_tensors = num_tensors;
+  for (i = 0; i < num_tensors; i++) {
+    mem = gst_tensor_buffer_get_nth_memory (buffer, &ts_info, i);
+    ASSERT_TRUE (mem != NULL);
+    ASSERT_TRUE (gst_memory_map (mem, &info, GST_MAP_READ));
+    EXPECT_EQ (info.size, sizeof (gint));
+    EXPECT_EQ (*((gint *) info.data), i);
+    gst_memory_unmap (mem, &info);
+    gst_memory_unref (mem);
+  }
+
+  gst_tensor_info_free (&tinfo);
+  gst_buffer_unref (buffer);
+}
+
+/**
+ * @brief Test to detect the framework with the magic bytes of model file without extension.
+ */
+TEST (tensorFilterDetect, magicBytes)
+{
+  const guint8 tflite[8] = { 0x1c, 0x00, 0x00, 0x00, 'T', 'F', 'L', '3' };
+  const guint8 circle[8] = { 0x1c, 0x00, 0x00, 0x00, 'C', 'I', 'R', '0' };
+  const guint8 unknown[8] = { 0x00 };
+  gchar *dir = g_build_filename (g_get_tmp_dir (), "nns-detect-XXXXXX", NULL);
+  gchar *model = g_build_filename (g_mkdtemp (dir), "model", NULL);
+  const gchar *models[] = { model, NULL };
+  gchar *fw;
+
+  ASSERT_TRUE (g_file_set_contents (model, (const gchar *) tflite, sizeof (tflite), NULL));
+  fw = gst_tensor_filter_detect_framework (models, 1, FALSE);
+  EXPECT_STREQ (fw, "tensorflow-lite");
+  g_free (fw);
+
+  ASSERT_TRUE (g_file_set_contents (model, (const gchar *) circle, sizeof (circle), NULL));
+  fw = gst_tensor_filter_detect_framework (models, 1, FALSE);
+  EXPECT_STREQ (fw, "nnfw");
+  g_free (fw);
+
+  ASSERT_TRUE (g_file_set_contents (model, (const gchar *) unknown, sizeof (unknown), NULL));
+  fw = gst_tensor_filter_detect_framework (models, 1, FALSE);
+  EXPECT_TRUE (fw == NULL);
+  g_free (fw);
+
+  g_remove (model);
+  g_rmdir (dir);
+  g_free (model);
+  g_free (dir);
+}
+
+/**
+ * @brief Test to summarize the sampled tensors with tensor_debug.
+ */
+TEST (tensorDebug, sampledStats)
+{
+  GstElement *pipeline, *appsrc, *debug;
+  GstStructure *stats = NULL;
+  GstBuffer *buffer;
+  GstMemory *mem;
+  GstMapInfo map;
+  guint64 val;
+  gdouble dval;
+  guint i;
+
+  pipeline = gst_parse_launch (
+      "appsrc name=appsrc ! other/tensors,num_tensors=1,format=static,dimensions=(string)4:1:1:1,types=(string)float32,framerate=(fraction)0/1 ! "
+      "tensor_debug name=debug output-method=disabled sample-interval=2 tensor-stats=true ! tensor_sink async=false",
+      NULL);
+  ASSERT_TRUE (pipeline != NULL);
+
+  appsrc = gst_bin_get_by_name (GST_BIN (pipeline), "appsrc");
+  debug = gst_bin_get_by_name (GST_BIN (pipeline), "debug");
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_PLAYING, UNITTEST_STATECHANGE_TIMEOUT), 0);
+
+  for (i = 0; i < 4; i++) {
+    float *data;
+
+    mem = gst_allocator_alloc (NULL, 4 * sizeof (float), NULL);
+    ASSERT_TRUE (gst_memory_map (mem, &map, GST_MAP_WRITE));
+    data = (float *) map.data;
+    data[0] = -1.0f * (i + 1);
+    data[1] = 2.0f;
+    data[2] = NAN;
+    data[3] = 3.0f;
+    gst_memory_unmap (mem, &map);
+
+    buffer = gst_buffer_new ();
+    gst_buffer_append_memory (buffer, mem);
+    EXPECT_EQ (gst_app_src_push_buffer (GST_APP_SRC (appsrc), buffer), GST_FLOW_OK);
+  }
+
+  g_usleep (200000);
+
+  /* the 1st and 3rd buffers are sampled, stats is of the 3rd buffer */
+  g_object_get (debug, "stats", &stats, NULL);
+  ASSERT_TRUE (stats != NULL);
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "buffers", &val));
+  EXPECT_EQ (val, 3U);
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "sampled", &val));
+  EXPECT_EQ (val, 2U);
+  EXPECT_TRUE (gst_structure_get_uint64 (stats, "nan-count", &val));
+  EXPECT_EQ (val, 2U);
+  EXPECT_TRUE (gst_structure_get_double (stats, "min-0", &dval));
+  EXPECT_DOUBLE_EQ (dval, -3.0);
+  EXPECT_TRUE (gst_structure_get_double (stats, "max-0", &dval));
+  EXPECT_DOUBLE_EQ (dval, 3.0);
+  EXPECT_TRUE (gst_structure_get_double (stats, "mean-0", &dval));
+  EXPECT_DOUBLE_EQ (dval, 2.0 / 3.0);
+  gst_structure_free (stats);
+
+  EXPECT_EQ (setPipelineStateSync (pipeline, GST_STATE_NULL, UNITTEST_STATECHANGE_TIMEOUT), 0);
+  gst_object_unref (debug);
+  gst_object_unref (appsrc);
+  gst_object_unref (pipeline);
+}
+
+/**
+ * @brief Thread to record the latencies in the statistics of tensor-filter.
+ */
+static gpointer
+_record_statistics_thread (gpointer data)
+{
+  GstTensorFilterStatistics *stat = (GstTensorFilterStatistics *) data;
+  gint64 i;
+
+  for (i = 1; i <= 1000; i++)
+    gst_tensor_filter_statistics_record (stat, i);
+
+  return NULL;
+}
+
+/**
+ * @brief Test to record the statistics of tensor-filter from the concurrent threads.
+ */
+TEST (tensorFilterStatistics, concurrentRecord)
+{
+  GstTensorFilterPrivate priv;
+  GstTensorFilterStatSnapshot snapshot;
+  GThread *threads[4];
+  guint i;
+
+  memset (&priv, 0, sizeof (GstTensorFilterPrivate));
+  gst_tensor_filter_common_init_property (&priv);
+
+  for (i = 0; i < 4; i++)
+    threads[i] = g_thread_new ("stat", _record_statistics_thread, &priv.stat);
+  for (i = 0; i < 4; i++)
+    g_thread_join (threads[i]);
+
+  gst_tensor_filter_statistics_get_snapshot (&priv.stat, &snapshot);
+
+  /* the first latency is ignored */
+  EXPECT_EQ (snapshot.invoke_num, 3999U);
+  EXPECT_GE (snapshot.invoke_latency, 4000U * 1001U / 2U - 1000U);
+  EXPECT_LE (snapshot.invoke_latency, 4000U * 1001U / 2U - 1U);
+  EXPECT_EQ (priv.stat.histogram.total, 3999U);
+  EXPECT_EQ (snapshot.latency_max, 1000);
+  EXPECT_LE (snapshot.latency_p50, snapshot.latency_p99);
+  EXPECT_LE (snapshot.latency_p99, snapshot.latency_max);
+  EXPECT_GT (snapshot.recent_latency, 0);
+  EXPECT_GT (snapshot.throughput, 0.0);
+
+  gst_tensor_filter_common_free_property (&priv);
+}
+
 /**
  * @brief Main function for unit test.
  */
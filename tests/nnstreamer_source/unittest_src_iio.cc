@@ -782,6 +782,7 @@ TEST (testTensorSrcIio, properties)
   gulong ret_frequency;
   gboolean ret_merge_channels;
   gint ret_poll_timeout;
+  gboolean ret_mmap;
   gint ret_number;
 
   /** setup */
@@ -887,6 +888,13 @@ TEST (testTensorSrcIio, properties)
   g_object_get (src_iio, "poll-timeout", &ret_poll_timeout, NULL);
   EXPECT_EQ (ret_poll_timeout, poll_timeout);
 
+  /** mmap test */
+  g_object_get (src_iio, "mmap", &ret_mmap, NULL);
+  EXPECT_FALSE (ret_mmap);
+  g_object_set (src_iio, "mmap", TRUE, NULL);
+  g_object_get (src_iio, "mmap", &ret_mmap, NULL);
+  EXPECT_TRUE (ret_mmap);
+
   /** teardown */
   gst_object_unref (src_iio);
   gst_harness_teardown (hrnss);
@@ -217,6 +217,24 @@ filesrc location=sample1.sparse ! \
     tensor_filter framework=lua model=\"${DEC_RESULT_TEST_SCRIPT}\" ! \
     tensor_sink" 6 0 0 $PERFORMANCE
 
+# Test tensor_filter decoding the sparse input before invoke
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} \
+filesrc location=sample1.sparse ! \
+    other/tensors,format=sparse,framerate=0/1 ! \
+    tensor_filter framework=lua model=\"${DEC_RESULT_TEST_SCRIPT}\" ! \
+    filesink location=filter7.result sync=true" 7 0 0 $PERFORMANCE
+callCompareTest sample1.dense filter7.result 7-1 "Compare 7" 0 0
+
+# Test tensor_filter encoding the outputs into sparse tensors
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN} \
+filesrc location=sample1.dense ! \
+    other/tensors,num_tensors=1,framerate=0/1,dimensions=1:3:4:1,types=uint8 ! \
+    tensor_filter framework=lua model=\"${DEC_RESULT_TEST_SCRIPT}\" ! \
+    other/tensors,format=sparse,framerate=0/1 ! \
+    tensor_sparse_dec ! \
+    filesink location=filter8.result sync=true" 8 0 0 $PERFORMANCE
+callCompareTest sample1.dense filter8.result 8-1 "Compare 8" 0 0
+
 rm *.dense *.result *.sparse
 
 report
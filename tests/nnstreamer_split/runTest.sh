@@ -66,6 +66,14 @@ gstTest "--gst-plugin-path=${PATH_TO_PLUGIN}  multifilesrc location=\"testsequen
 callCompareTest testcase_stream_2_0.golden split07_0.log 7_0 "Compare 7-0" 1 0
 callCompareTest testcase_stream_2_1.golden split07_1.log 7_1 "Compare 7-1" 1 0
 
+# Test axis (split the channels and merge them again)
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN}  filesrc location=testcase_RGB_100x100.png ! pngdec ! videoscale ! imagefreeze ! videoconvert ! video/x-raw, format = RGB, width=100, height=100, framerate=0/1 ! tensor_converter ! tensor_split name=split axis=0 tensorseg=1:100:100,1:100:100,1:100:100 tensor_merge name=merge mode=linear option=0 ! filesink location=split08.log split.src_0 ! queue ! merge.sink_0 split.src_1 ! queue ! merge.sink_1 split.src_2 ! queue ! merge.sink_2" 8 0 0 $PERFORMANCE
+
+callCompareTest testcase_0_0.golden split08.log 8 "Compare 8" 1 0
+
+# Test axis with invalid segments (the sum of the axis is not the incoming one)
+gstTest "--gst-plugin-path=${PATH_TO_PLUGIN}  filesrc location=testcase_RGB_100x100.png ! pngdec ! videoscale ! imagefreeze ! videoconvert ! video/x-raw, format = RGB, width=100, height=100, framerate=0/1 ! tensor_converter ! tensor_split name=split axis=0 tensorseg=1:100:100,1:100:100 split. ! queue ! fakesink split. ! queue ! fakesink" 9_n 0 1 $PERFORMANCE
+
 rm *.log *.bmp *.png *.golden *.raw *.dat
 
 report
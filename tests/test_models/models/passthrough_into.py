@@ -0,0 +1,52 @@
+##
+# SPDX-License-Identifier: LGPL-2.1-only
+#
+# Copyright (C) 2026 Samsung Electronics
+#
+# @file    passthrough_into.py
+# @brief   Python custom filter example: passthrough into the given outputs
+# @author  agent <agent@local>
+
+import numpy as np
+import nnstreamer_python as nns
+
+D1 = 3
+D2 = 280
+D3 = 40
+D4 = 1
+D5 = 1
+D6 = 1
+D7 = 1
+D8 = 1
+
+
+##
+# @brief  User-defined custom filter; DO NOT CHANGE CLASS NAME
+class CustomFilter(object):
+    ##
+    # @brief  The constructor for custom filter: passthrough
+    def __init__(self, *args):
+        self.input_dims = [nns.TensorShape([D1, D2, D3, D4, D5, D6, D7, D8], np.uint8)]
+        self.output_dims = [nns.TensorShape([D1, D2, D3, D4, D5, D6, D7, D8], np.uint8)]
+
+    ##
+    # @brief  python callback: getInputDim
+    # @param  None
+    # @return user-assigned input dimensions
+    def getInputDim(self):
+        return self.input_dims
+
+    ##
+    # @brief  Python callback: getOutputDim
+    # @param  None
+    # @return user-assigned output dimensions
+    def getOutputDim(self):
+        return self.output_dims
+
+    ##
+    # @brief  Python callback: invokeInto
+    # @param  Input tensors: list of input numpy array
+    # @param  Output tensors: list of output numpy array allocated by nnstreamer
+    def invokeInto(self, input_array, output_array):
+        for i in range(len(input_array)):
+            np.copyto(output_array[i], input_array[i])
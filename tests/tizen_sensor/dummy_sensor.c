@@ -211,6 +211,21 @@ sensor_listener_set_interval (sensor_listener_h listener,
   return SENSOR_ERROR_NONE;
 }
 
+/**
+ * @brief Dummy (simulation) Tizen Sensor Framework API
+ */
+int
+sensor_listener_set_max_batch_latency (sensor_listener_h listener,
+    unsigned int max_batch_latency)
+{
+  sensor_listener_s *ptr = listener;
+  if (NULL == listener)
+    return -EINVAL;
+
+  ptr->max_batch_latency = max_batch_latency;
+  return SENSOR_ERROR_NONE;
+}
+
 /**
  * @brief Dummy (simulation) Tizen Sensor Framework API
  */
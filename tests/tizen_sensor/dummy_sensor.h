@@ -116,6 +116,7 @@ typedef struct {
   sensor_s *listening;
   int is_listening;
   unsigned int interval_ms;
+  unsigned int max_batch_latency;
 } sensor_listener_s;
 
 typedef void* sensor_listener_h;
@@ -155,6 +156,9 @@ sensor_listener_stop (sensor_listener_h listener);
 extern int
 sensor_listener_set_interval (sensor_listener_h listener, unsigned int interval_ms);
 
+extern int
+sensor_listener_set_max_batch_latency (sensor_listener_h listener, unsigned int max_batch_latency);
+
 extern int
 sensor_listener_read_data_list (sensor_listener_h listener, sensor_event_s ** events, int * count);
 
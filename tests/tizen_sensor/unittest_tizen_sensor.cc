@@ -222,6 +222,85 @@ TEST (tizensensorAsSource, virtualSensorFlow03)
   g_free (pipeline);
 }
 
+/**
+ * @brief Test if the batched sensor events are given with the timestamps.
+ */
+static void
+callback_batch (GstElement *element, GstBuffer *buffer, gpointer user_data)
+{
+  guint *received = (guint *) user_data;
+  GstMemory *mem;
+  GstMapInfo map_info;
+  guint64 *ts;
+  guint i;
+
+  EXPECT_EQ (gst_buffer_n_memory (buffer), 2U);
+  EXPECT_EQ (gst_buffer_get_size (buffer), 4 * (sizeof (float) + sizeof (guint64)));
+
+  mem = gst_buffer_peek_memory (buffer, 1);
+  if (gst_memory_map (mem, &map_info, GST_MAP_READ)) {
+    ts = (guint64 *) map_info.data;
+
+    /* The events are not duplicated */
+    for (i = 1; i < 4; i++)
+      EXPECT_LT (ts[i - 1], ts[i]);
+
+    gst_memory_unmap (mem, &map_info);
+  }
+
+  *received += 1;
+}
+
+/**
+ * @brief Test pipeline with batched sensor events
+ */
+TEST (tizensensorAsSource, virtualSensorFlowBatch)
+{
+  GError *err = NULL;
+  GstElement *pipe, *sink;
+  gchar *pipeline;
+  sensor_event_s value;
+  sensor_h sensor;
+  guint received = 0;
+  int i, status = 0;
+
+  status = sensor_get_default_sensor (SENSOR_LIGHT, &sensor);
+  EXPECT_EQ (status, 0);
+
+  value.accuracy = 1;
+  value.value_count = 1;
+
+  /* Create a nnstreamer pipeline */
+  pipeline = g_strdup_printf (
+      "tensor_src_tizensensor type=SENSOR_LIGHT sequence=-1 num-buffers=2 framerate=100/1 batch-size=4 batch-latency=40 ! tensor_sink name=getv");
+  pipe = gst_parse_launch (pipeline, &err);
+  ASSERT_TRUE (pipe && !err);
+  g_clear_error (&err);
+
+  sink = gst_bin_get_by_name (GST_BIN (pipe), "getv");
+  EXPECT_TRUE (sink != NULL);
+  g_signal_connect (sink, "new-data", (GCallback) callback_batch, &received);
+
+  gst_element_set_state (pipe, GST_STATE_PLAYING);
+  wait_for_start (pipe);
+
+  /* Publish the events with increasing timestamps */
+  for (i = 0; i < 40 && received < 2; i++) {
+    value.timestamp = 0U;
+    value.values[0] = (float) i;
+    EXPECT_EQ (dummy_publish (sensor, value), 0);
+    g_usleep (30000);
+  }
+
+  EXPECT_TRUE (wait_pipeline_process_buffers (&received, 2, TEST_TIME_OUT_TIZEN_SENSOR_MS));
+
+  gst_element_set_state (pipe, GST_STATE_NULL);
+
+  gst_object_unref (sink);
+  gst_object_unref (pipe);
+  g_free (pipeline);
+}
+
 /**
  * @brief Test pipeline creation and sink
  */
@@ -425,7 +504,7 @@ TEST (tizensensorAsSource, getProperty1)
   gstpipe = gst_parse_launch (pipeline, &err);
   if (gstpipe) {
     gboolean silent;
-    guint sequence, freq_n, freq_p, mode;
+    guint sequence, freq_n, freq_p, mode, batch_size, batch_latency;
     GEnumValue sensor_type;
     GstElement *sensor_handle;
 
@@ -453,6 +532,18 @@ TEST (tizensensorAsSource, getProperty1)
     EXPECT_EQ (freq_n, 10);
     EXPECT_EQ (freq_p, 1);
 
+    g_object_get (sensor_handle, "batch-size", &batch_size, NULL);
+    EXPECT_EQ (batch_size, 1U);
+    g_object_set (sensor_handle, "batch-size", 8, NULL);
+    g_object_get (sensor_handle, "batch-size", &batch_size, NULL);
+    EXPECT_EQ (batch_size, 8U);
+
+    g_object_get (sensor_handle, "batch-latency", &batch_latency, NULL);
+    EXPECT_EQ (batch_latency, 0U);
+    g_object_set (sensor_handle, "batch-latency", 100, NULL);
+    g_object_get (sensor_handle, "batch-latency", &batch_latency, NULL);
+    EXPECT_EQ (batch_latency, 100U);
+
     gst_object_unref (sensor_handle);
     gst_object_unref (gstpipe);
   } else {
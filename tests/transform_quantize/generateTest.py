@@ -0,0 +1,58 @@
+#!/usr/bin/env python3
+
+##
+# SPDX-License-Identifier: LGPL-2.1-only
+#
+# Copyright (C) 2026 Samsung Electronics Co., Ltd.
+#
+# @file generateTest.py
+# @brief Generate golden test results for quantize and dequantize test cases
+# @author agent <agent@local>
+
+import sys
+import os
+import numpy as np
+
+
+def quantize(data, dtype, scale, zero_point):
+    info = np.iinfo(dtype)
+    q = np.rint(data * np.float32(1.0 / scale) + np.float32(zero_point))
+    return np.clip(q, info.min, info.max).astype(dtype)
+
+
+def save_quantize_data(filename, dtype, scale, zero_point):
+    data = np.random.randint(-300, 300, size=[100, 50]).astype(np.float32)
+    with open(filename, 'wb') as file:
+        file.write(data.tobytes())
+
+    with open(filename + '.golden', 'wb') as file:
+        file.write(quantize(data, dtype, scale, zero_point).tobytes())
+
+
+def save_quantize_channel_data(filename, dtype, scales, zero_points):
+    data = np.random.randint(-100, 100, size=[100, 50, 3]).astype(np.float32)
+    with open(filename, 'wb') as file:
+        file.write(data.tobytes())
+
+    # the innermost dimension (dim 0) is the channel
+    q = np.empty(data.shape, dtype=dtype)
+    for c in range(len(scales)):
+        q[..., c] = quantize(data[..., c], dtype, scales[c], zero_points[c])
+    with open(filename + '.golden', 'wb') as file:
+        file.write(q.tobytes())
+
+
+def save_dequantize_data(filename, dtype, scale, zero_point):
+    data = np.random.randint(-128, 128, size=[100, 50]).astype(dtype)
+    with open(filename, 'wb') as file:
+        file.write(data.tobytes())
+
+    x = (data.astype(np.float32) - np.float32(zero_point)) * np.float32(scale)
+    with open(filename + '.golden', 'wb') as file:
+        file.write(x.astype(np.float32).tobytes())
+
+
+save_quantize_data('test_00.dat', np.int8, 0.5, 0)
+save_quantize_data('test_01.dat', np.uint8, 2.0, 128)
+save_quantize_channel_data('test_02.dat', np.int8, [0.5, 0.25, 2.0], [1, -1, 0])
+save_dequantize_data('test_03.dat', np.int8, 0.5, 3)
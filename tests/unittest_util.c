@@ -11,8 +11,16 @@
 #include <gst/gst.h>
 #include <glib/gstdio.h>
 #include <string.h>
+#include <stdio.h>
+#include <sys/utsname.h>
+#include <sys/resource.h>
+#include <hw_accel.h>
 #include "unittest_util.h"
 
+#ifndef NNS_TEST_COMMIT
+#define NNS_TEST_COMMIT "unknown"
+#endif
+
 /**
  * @brief Set pipeline state, wait until it's done.
  * @return 0 success, -ESTRPIPE if failed, -ETIME if timeout happens.
@@ -213,6 +221,187 @@ get_available_port (void)
   return port;
 }
 
+/**
+ * @brief Check if the performance results are requested with NNSTREAMER_PERF_REPORT.
+ */
+gboolean
+unittest_perf_enabled (void)
+{
+  const gchar *path = g_getenv (UNITTEST_PERF_REPORT_ENV);
+
+  return (path != NULL && path[0] != '\0');
+}
+
+/**
+ * @brief Compare the samples (gdouble).
+ */
+static gint
+_perf_compare_samples (gconstpointer a, gconstpointer b)
+{
+  gdouble x = *((const gdouble *) a);
+  gdouble y = *((const gdouble *) b);
+
+  return (x > y) - (x < y);
+}
+
+/**
+ * @brief Get the percentile of the samples (nearest rank).
+ */
+gdouble
+unittest_perf_percentile (GArray * samples, gdouble percent)
+{
+  gdouble pos;
+  guint rank;
+
+  if (samples == NULL || samples->len == 0)
+    return 0.0;
+
+  g_array_sort (samples, _perf_compare_samples);
+
+  /* the smallest rank covering the percent of the samples, 1-based */
+  pos = CLAMP (percent, 0.0, 100.0) / 100.0 * samples->len;
+  rank = (guint) pos;
+  if ((gdouble) rank < pos)
+    rank++;
+  if (rank > 0)
+    rank--;
+
+  return g_array_index (samples, gdouble, MIN (rank, samples->len - 1));
+}
+
+/**
+ * @brief Get the resident set size of the process in KiB.
+ */
+guint64
+unittest_perf_get_rss_kb (gboolean peak)
+{
+  const gchar *key = peak ? "VmHWM:" : "VmRSS:";
+  gchar *status = NULL;
+  gchar *pos;
+  guint64 size = 0;
+
+  if (g_file_get_contents ("/proc/self/status", &status, NULL, NULL)) {
+    pos = strstr (status, key);
+    if (pos)
+      size = g_ascii_strtoull (pos + strlen (key), NULL, 10);
+    g_free (status);
+  }
+
+  if (size == 0 && peak) {
+    struct rusage usage;
+
+    if (getrusage (RUSAGE_SELF, &usage) == 0) {
+      size = (guint64) usage.ru_maxrss;
+#ifdef __APPLE__
+      size /= 1024; /* bytes on macOS */
+#endif
+    }
+  }
+
+  return size;
+}
+
+/**
+ * @brief Append the string to the JSON string value, escaping the special characters.
+ */
+static void
+_perf_append_json_string (GString * json, const gchar * str)
+{
+  const gchar *s;
+
+  g_string_append_c (json, '"');
+  for (s = (str != NULL) ? str : ""; *s != '\0'; s++) {
+    if (*s == '"' || *s == '\\')
+      g_string_append_printf (json, "\\%c", *s);
+    else if ((guchar) *s < 0x20)
+      g_string_append_printf (json, "\\u%04x", (guint) *s);
+    else
+      g_string_append_c (json, *s);
+  }
+  g_string_append_c (json, '"');
+}
+
+/**
+ * @brief Get a line of JSON object with the environment, the RSS and the metrics of a scenario.
+ */
+gchar *
+unittest_perf_format (const gchar * suite, const gchar * scenario,
+    const gchar * metrics)
+{
+  GString *json;
+  struct utsname uts;
+  const gchar *commit;
+  gchar *features;
+
+  /* the commit can be given when the tests are built out of the source tree */
+  commit = g_getenv ("NNSTREAMER_PERF_COMMIT");
+  if (commit == NULL || commit[0] == '\0')
+    commit = NNS_TEST_COMMIT;
+
+  features = cpu_get_features_string (cpu_get_features ());
+  if (uname (&uts) != 0)
+    memset (&uts, 0, sizeof (uts));
+
+  json = g_string_new ("{\"suite\": ");
+  _perf_append_json_string (json, suite);
+  g_string_append (json, ", \"scenario\": ");
+  _perf_append_json_string (json, scenario);
+  g_string_append (json, ", \"version\": ");
+  _perf_append_json_string (json, VERSION);
+  g_string_append (json, ", \"commit\": ");
+  _perf_append_json_string (json, commit);
+  g_string_append (json, ", \"host\": ");
+  _perf_append_json_string (json, g_get_host_name ());
+  g_string_append (json, ", \"os\": ");
+  _perf_append_json_string (json, uts.sysname);
+  g_string_append (json, ", \"arch\": ");
+  _perf_append_json_string (json, uts.machine);
+  g_string_append (json, ", \"cpus\": ");
+  g_string_append_printf (json, "%u", g_get_num_processors ());
+  g_string_append (json, ", \"cpu_features\": ");
+  _perf_append_json_string (json, features);
+  g_string_append_printf (json, ", \"rss_kb\": %" G_GUINT64_FORMAT
+      ", \"peak_rss_kb\": %" G_GUINT64_FORMAT,
+      unittest_perf_get_rss_kb (FALSE), unittest_perf_get_rss_kb (TRUE));
+
+  if (metrics && metrics[0] != '\0')
+    g_string_append_printf (json, ", %s", metrics);
+  g_string_append_c (json, '}');
+
+  g_free (features);
+  return g_string_free (json, FALSE);
+}
+
+/**
+ * @brief Append the results of a scenario to the file given by NNSTREAMER_PERF_REPORT.
+ */
+gboolean
+unittest_perf_report (const gchar * suite, const gchar * scenario,
+    const gchar * metrics)
+{
+  const gchar *path;
+  gchar *line;
+  FILE *fp;
+  gboolean ret;
+
+  if (!unittest_perf_enabled ())
+    return FALSE;
+
+  path = g_getenv (UNITTEST_PERF_REPORT_ENV);
+  fp = g_fopen (path, "a");
+  if (fp == NULL) {
+    g_warning ("Failed to open the performance report %s.", path);
+    return FALSE;
+  }
+
+  line = unittest_perf_format (suite, scenario, metrics);
+  ret = (fprintf (fp, "%s\n", line) > 0);
+  fclose (fp);
+
+  g_free (line);
+  return ret;
+}
+
 #ifdef FAKEDLOG
 /**
  * @brief Hijack dlog Tizen infra for unit testing to force printing out.
@@ -74,6 +74,51 @@ replace_string (gchar * source, const gchar * what, const gchar * to, const gcha
 extern guint
 get_available_port (void);
 
+/**
+ * @brief Environment variable with the file to append the performance results of the tests (a line of JSON object per scenario).
+ */
+#define UNITTEST_PERF_REPORT_ENV "NNSTREAMER_PERF_REPORT"
+
+/**
+ * @brief Check if the performance results are requested with NNSTREAMER_PERF_REPORT.
+ */
+extern gboolean
+unittest_perf_enabled (void);
+
+/**
+ * @brief Get the percentile of the samples (nearest rank).
+ * @param[in,out] samples GArray of gdouble. The samples are sorted.
+ * @param[in] percent The percentile (0 ~ 100).
+ * @return The value at the percentile, 0 if there is no sample.
+ */
+extern gdouble
+unittest_perf_percentile (GArray * samples, gdouble percent);
+
+/**
+ * @brief Get the resident set size of the process in KiB.
+ * @param[in] peak TRUE to get the peak size instead of the current size.
+ * @return The size, 0 if it is not available.
+ */
+extern guint64
+unittest_perf_get_rss_kb (gboolean peak);
+
+/**
+ * @brief Get a line of JSON object with the environment (commit, host, CPU features), the RSS and the metrics of a scenario.
+ * @param[in] suite The name of the test suite.
+ * @param[in] scenario The name of the scenario.
+ * @param[in] metrics The JSON members of the results (e.g., "\"fps\": 30.0, \"latency_p50_ms\": 2.1"), or NULL.
+ * @return Newly allocated string. The returned string should be freed with g_free().
+ */
+extern gchar *
+unittest_perf_format (const gchar * suite, const gchar * scenario, const gchar * metrics);
+
+/**
+ * @brief Append the results of a scenario to the file given by NNSTREAMER_PERF_REPORT.
+ * @return TRUE if the line is written, FALSE if NNSTREAMER_PERF_REPORT is not set or the file cannot be written.
+ */
+extern gboolean
+unittest_perf_report (const gchar * suite, const gchar * scenario, const gchar * metrics);
+
 /**
  * @brief Wait until the pipeline saving the file
  * @return TRUE on success, FALSE when a time-out occurs
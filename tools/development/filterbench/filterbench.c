@@ -0,0 +1,492 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * NNStreamer tensor_filter sub-plugin microbenchmark
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file	filterbench.c
+ * @date	15 Oct 2026
+ * @brief	Microbenchmark of tensor_filter sub-plugins, without GStreamer pipelines
+ * @see		http://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ *
+ * This is a utility for nnstreamer developers.
+ * This loads a tensor_filter sub-plugin with nnstreamer_filter_find(),
+ * invokes the model in a loop with synthetic inputs, and reports
+ * the latency percentiles of the invoke, the overhead of the tensor_filter
+ * path (output allocation, input copy and release) around the invoke,
+ * and the memory copies and allocations per invoke.
+ *
+ * The allocations are counted by wrapping malloc family of glibc,
+ * so the allocations of the sub-plugin and the framework are included.
+ */
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+#include <nnstreamer_plugin_api_filter.h>
+#include <nnstreamer_plugin_api_util.h>
+
+#define DEFAULT_ITERATIONS 100
+#define DEFAULT_WARMUP 10
+
+#ifdef __GLIBC__
+extern void *__libc_malloc (size_t size);
+extern void *__libc_calloc (size_t nmemb, size_t size);
+extern void *__libc_realloc (void *ptr, size_t size);
+
+static volatile gint counting = 0;
+static gint num_allocs = 0;
+
+/**
+ * @brief Count the allocation while the invoke is running.
+ */
+static inline void
+count_alloc (void)
+{
+  if (g_atomic_int_get (&counting))
+    g_atomic_int_inc (&num_allocs);
+}
+
+/**
+ * @brief malloc wrapper to count the allocations.
+ */
+void *
+malloc (size_t size)
+{
+  count_alloc ();
+  return __libc_malloc (size);
+}
+
+/**
+ * @brief calloc wrapper to count the allocations.
+ */
+void *
+calloc (size_t nmemb, size_t size)
+{
+  count_alloc ();
+  return __libc_calloc (nmemb, size);
+}
+
+/**
+ * @brief realloc wrapper to count the allocations.
+ */
+void *
+realloc (void *ptr, size_t size)
+{
+  count_alloc ();
+  return __libc_realloc (ptr, size);
+}
+
+#define ALLOC_COUNT_START() do { \
+    g_atomic_int_set (&num_allocs, 0); \
+    g_atomic_int_set (&counting, 1); \
+  } while (0)
+#define ALLOC_COUNT_STOP() (g_atomic_int_set (&counting, 0), g_atomic_int_get (&num_allocs))
+#define ALLOC_COUNT_SUPPORTED TRUE
+#else
+#define ALLOC_COUNT_START() do { } while (0)
+#define ALLOC_COUNT_STOP() (0)
+#define ALLOC_COUNT_SUPPORTED FALSE
+#endif
+
+/**
+ * @brief Options of the benchmark.
+ */
+static gchar *opt_framework = NULL;
+static gchar *opt_model = NULL;
+static gchar *opt_input_dim = NULL;
+static gchar *opt_input_type = NULL;
+static gchar *opt_accelerator = NULL;
+static gchar *opt_custom = NULL;
+static gint opt_iterations = DEFAULT_ITERATIONS;
+static gint opt_warmup = DEFAULT_WARMUP;
+
+static GOptionEntry entries[] = {
+  {"framework", 'f', 0, G_OPTION_ARG_STRING, &opt_framework,
+      "The name of the tensor_filter sub-plugin (mandatory)", "NAME"},
+  {"model", 'm', 0, G_OPTION_ARG_STRING, &opt_model,
+      "The comma-separated list of model files", "FILES"},
+  {"input", 'i', 0, G_OPTION_ARG_STRING, &opt_input_dim,
+      "The input dimensions if the model does not give them (e.g., 3:224:224:1)",
+      "DIM"},
+  {"inputtype", 't', 0, G_OPTION_ARG_STRING, &opt_input_type,
+      "The input types if the model does not give them (e.g., uint8)", "TYPE"},
+  {"accelerator", 'a', 0, G_OPTION_ARG_STRING, &opt_accelerator,
+      "The accelerator of the sub-plugin (e.g., true:cpu)", "ACCL"},
+  {"custom", 'c', 0, G_OPTION_ARG_STRING, &opt_custom,
+      "The custom properties of the sub-plugin", "PROPS"},
+  {"iterations", 'n', 0, G_OPTION_ARG_INT, &opt_iterations,
+      "The number of measured invokes (default 100)", "N"},
+  {"warmup", 'w', 0, G_OPTION_ARG_INT, &opt_warmup,
+      "The number of invokes before the measurement (default 10)", "N"},
+  {NULL}
+};
+
+/**
+ * @brief The sub-plugin instance to benchmark.
+ */
+typedef struct
+{
+  const GstTensorFilterFramework *fw;
+  GstTensorFilterProperties prop;
+  void *private_data;
+  gboolean v1;
+  gboolean allocate_in_invoke;
+} filterbench_s;
+
+/**
+ * @brief Compare function to sort the latency samples.
+ */
+static gint
+compare_int64 (gconstpointer a, gconstpointer b)
+{
+  gint64 va = *(const gint64 *) a;
+  gint64 vb = *(const gint64 *) b;
+
+  return (va > vb) - (va < vb);
+}
+
+/**
+ * @brief Get the percentile of the sorted samples.
+ */
+static gint64
+get_percentile (const gint64 * sorted, guint num, guint percent)
+{
+  guint idx = (num * percent + 99) / 100;
+
+  return sorted[MIN (MAX (idx, 1U), num) - 1];
+}
+
+/**
+ * @brief Get the input and output info of the model.
+ */
+static gboolean
+get_model_info (filterbench_s * bench, GstTensorsInfo * in_info,
+    GstTensorsInfo * out_info)
+{
+  const GstTensorFilterFramework *fw = bench->fw;
+  int ret = -ENOENT;
+
+  if (!opt_input_dim) {
+    if (bench->v1) {
+      ret = fw->getModelInfo (fw, &bench->prop, bench->private_data,
+          GET_IN_OUT_INFO, in_info, out_info);
+    } else if (fw->getInputDimension && fw->getOutputDimension) {
+      ret = fw->getInputDimension (&bench->prop, &bench->private_data, in_info);
+      if (ret == 0)
+        ret = fw->getOutputDimension (&bench->prop, &bench->private_data,
+            out_info);
+    }
+
+    if (ret == 0)
+      return TRUE;
+  }
+
+  /* Set the input info given by the options. */
+  gst_tensors_info_free (in_info);
+  gst_tensors_info_init (in_info);
+
+  if (!opt_input_dim || !opt_input_type) {
+    g_printerr ("The model does not give the input info, "
+        "please set the options --input and --inputtype.\n");
+    return FALSE;
+  }
+
+  in_info->num_tensors =
+      gst_tensors_info_parse_dimensions_string (in_info, opt_input_dim);
+  if (gst_tensors_info_parse_types_string (in_info, opt_input_type) !=
+      in_info->num_tensors) {
+    g_printerr ("The number of the input types does not match.\n");
+    return FALSE;
+  }
+
+  if (bench->v1) {
+    ret = fw->getModelInfo (fw, &bench->prop, bench->private_data,
+        SET_INPUT_INFO, in_info, out_info);
+  } else if (fw->setInputDimension) {
+    ret = fw->setInputDimension (&bench->prop, &bench->private_data, in_info,
+        out_info);
+  }
+
+  if (ret != 0) {
+    g_printerr ("Failed to set the input info (%d).\n", ret);
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * @brief Invoke the model once.
+ */
+static gint
+invoke (filterbench_s * bench, const GstTensorMemory * input,
+    GstTensorMemory * output)
+{
+  const GstTensorFilterFramework *fw = bench->fw;
+
+  if (bench->v1)
+    return fw->invoke (fw, &bench->prop, bench->private_data, input, output);
+
+  return fw->invoke_NN (&bench->prop, &bench->private_data, input, output);
+}
+
+/**
+ * @brief Release the output tensor allocated by the sub-plugin.
+ */
+static void
+destroy_output (filterbench_s * bench, void *data)
+{
+  const GstTensorFilterFramework *fw = bench->fw;
+  GstTensorFilterFrameworkEventData event_data;
+
+  if (!bench->v1 && fw->destroyNotify) {
+    fw->destroyNotify (&bench->private_data, data);
+  } else if (bench->v1) {
+    event_data.data = data;
+    if (fw->eventHandler (fw, &bench->prop, bench->private_data,
+            DESTROY_NOTIFY, &event_data) == -ENOENT)
+      g_free (data);
+  } else {
+    g_free (data);
+  }
+}
+
+/**
+ * @brief Print the latency percentiles of the samples (in usec).
+ */
+static void
+print_latency (const gchar * name, gint64 * samples, guint num)
+{
+  gint64 sum = 0;
+  guint i;
+
+  qsort (samples, num, sizeof (gint64), compare_int64);
+  for (i = 0; i < num; i++)
+    sum += samples[i];
+
+  g_print ("%-10s avg %8" G_GINT64_FORMAT "  p50 %8" G_GINT64_FORMAT
+      "  p90 %8" G_GINT64_FORMAT "  p99 %8" G_GINT64_FORMAT "  max %8"
+      G_GINT64_FORMAT "\n", name, sum / num, get_percentile (samples, num, 50),
+      get_percentile (samples, num, 90), get_percentile (samples, num, 99),
+      samples[num - 1]);
+}
+
+/**
+ * @brief Run the benchmark.
+ */
+static int
+run_bench (filterbench_s * bench)
+{
+  GstTensorsInfo in_info, out_info;
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT] = { {0,}, };
+  GstTensorMemory output[NNS_TENSOR_SIZE_LIMIT] = { {0,}, };
+  gpointer source[NNS_TENSOR_SIZE_LIMIT] = { NULL, };
+  gint64 *invoke_us, *overhead_us;
+  gint64 start, begin, end;
+  guint64 copied = 0, allocated = 0, total_allocs = 0;
+  guint i, n, total;
+  int ret = -1;
+
+  gst_tensors_info_init (&in_info);
+  gst_tensors_info_init (&out_info);
+
+  if (!get_model_info (bench, &in_info, &out_info))
+    goto done;
+
+  /* The sub-plugin may refer to the configured info as tensor_filter sets. */
+  gst_tensors_info_copy (&bench->prop.input_meta, &in_info);
+  gst_tensors_info_copy (&bench->prop.output_meta, &out_info);
+  bench->prop.input_configured = bench->prop.output_configured = TRUE;
+
+  /* Synthetic inputs, copied to the input tensors as tensor_filter gets them from the buffer. */
+  for (i = 0; i < in_info.num_tensors; i++) {
+    guint8 *data;
+    gsize s;
+
+    input[i].size = gst_tensors_info_get_size (&in_info, i);
+    input[i].data = g_malloc (input[i].size);
+    source[i] = data = g_malloc (input[i].size);
+
+    for (s = 0; s < input[i].size; s++)
+      data[s] = (guint8) g_random_int_range (0, 256);
+  }
+
+  for (i = 0; i < out_info.num_tensors; i++)
+    output[i].size = gst_tensors_info_get_size (&out_info, i);
+
+  total = (guint) (opt_warmup + opt_iterations);
+  invoke_us = g_new0 (gint64, opt_iterations);
+  overhead_us = g_new0 (gint64, opt_iterations);
+
+  for (n = 0; n < total; n++) {
+    gboolean measure = (n >= (guint) opt_warmup);
+    guint idx = n - opt_warmup;
+    gint allocs;
+
+    start = g_get_monotonic_time ();
+
+    for (i = 0; i < in_info.num_tensors; i++)
+      memcpy (input[i].data, source[i], input[i].size);
+
+    if (!bench->allocate_in_invoke) {
+      for (i = 0; i < out_info.num_tensors; i++)
+        output[i].data = g_malloc (output[i].size);
+    }
+
+    if (measure)
+      ALLOC_COUNT_START ();
+    begin = g_get_monotonic_time ();
+    ret = invoke (bench, input, output);
+    end = g_get_monotonic_time ();
+    allocs = measure ? ALLOC_COUNT_STOP () : 0;
+
+    for (i = 0; i < out_info.num_tensors; i++) {
+      if (bench->allocate_in_invoke)
+        destroy_output (bench, output[i].data);
+      else
+        g_free (output[i].data);
+      output[i].data = NULL;
+    }
+
+    if (ret != 0) {
+      g_printerr ("Failed to invoke the model (%d).\n", ret);
+      goto free_samples;
+    }
+
+    if (measure) {
+      invoke_us[idx] = end - begin;
+      overhead_us[idx] = (g_get_monotonic_time () - start) - (end - begin);
+      total_allocs += allocs;
+
+      for (i = 0; i < in_info.num_tensors; i++)
+        copied += input[i].size;
+      if (!bench->allocate_in_invoke) {
+        for (i = 0; i < out_info.num_tensors; i++)
+          allocated += output[i].size;
+      }
+    }
+  }
+
+  g_print ("\nFramework  : %s (API V%d)\n", bench->prop.fwname,
+      bench->v1 ? 1 : 0);
+  g_print ("Iterations : %d (warm-up %d)\n", opt_iterations, opt_warmup);
+  g_print ("Tensors    : %u input(s), %u output(s)\n", in_info.num_tensors,
+      out_info.num_tensors);
+  g_print ("\nLatency (usec)\n");
+  print_latency ("invoke", invoke_us, opt_iterations);
+  print_latency ("overhead", overhead_us, opt_iterations);
+
+  g_print ("\nPer invoke\n");
+  g_print ("input copy  : %" G_GUINT64_FORMAT " bytes in %u memcpy\n",
+      copied / opt_iterations, in_info.num_tensors);
+  if (bench->allocate_in_invoke)
+    g_print ("output      : allocated by the sub-plugin\n");
+  else
+    g_print ("output      : %" G_GUINT64_FORMAT " bytes in %u allocations\n",
+        allocated / opt_iterations, out_info.num_tensors);
+  if (ALLOC_COUNT_SUPPORTED)
+    g_print ("allocations : %.1f in the sub-plugin\n",
+        (gdouble) total_allocs / opt_iterations);
+  else
+    g_print ("allocations : not supported in this platform\n");
+
+  ret = 0;
+
+free_samples:
+  g_free (invoke_us);
+  g_free (overhead_us);
+
+  for (i = 0; i < in_info.num_tensors; i++) {
+    g_free (input[i].data);
+    g_free (source[i]);
+  }
+
+done:
+  gst_tensors_info_free (&in_info);
+  gst_tensors_info_free (&out_info);
+  return ret;
+}
+
+/**
+ * @brief Main routine
+ */
+int
+main (int argc, char *argv[])
+{
+  GOptionContext *ctx;
+  GError *err = NULL;
+  GstTensorFilterFrameworkInfo info;
+  filterbench_s bench;
+  gchar **models = NULL;
+  int ret = -1;
+
+  ctx = g_option_context_new ("- benchmark a tensor_filter sub-plugin");
+  g_option_context_add_main_entries (ctx, entries, NULL);
+
+  if (!g_option_context_parse (ctx, &argc, &argv, &err)) {
+    g_printerr ("Failed to parse the options: %s\n", err->message);
+    g_clear_error (&err);
+    g_option_context_free (ctx);
+    return -1;
+  }
+  g_option_context_free (ctx);
+
+  if (!opt_framework || opt_iterations <= 0 || opt_warmup < 0) {
+    g_printerr ("Please set the framework and the positive iterations.\n");
+    return -1;
+  }
+
+  memset (&bench, 0, sizeof (filterbench_s));
+  bench.fw = nnstreamer_filter_find (opt_framework);
+  if (!bench.fw) {
+    g_printerr ("Cannot find the sub-plugin '%s'.\n", opt_framework);
+    return -1;
+  }
+
+  /* V2 has the callbacks of V1 */
+  bench.v1 = (checkGstTensorFilterFrameworkVersion (bench.fw->version, 1) ||
+      checkGstTensorFilterFrameworkVersion (bench.fw->version, 2));
+
+  if (opt_model)
+    models = g_strsplit (opt_model, ",", -1);
+
+  bench.prop.fwname = opt_framework;
+  bench.prop.model_files = (const char **) models;
+  bench.prop.num_models = models ? (int) g_strv_length (models) : 0;
+  bench.prop.custom_properties = opt_custom;
+  bench.prop.accl_str = opt_accelerator;
+  gst_tensors_info_init (&bench.prop.input_meta);
+  gst_tensors_info_init (&bench.prop.output_meta);
+
+  if (bench.fw->open && bench.fw->open (&bench.prop, &bench.private_data) != 0) {
+    g_printerr ("Failed to open the model with '%s'.\n", opt_framework);
+    goto done;
+  }
+  bench.prop.fw_opened = TRUE;
+
+  if (bench.v1) {
+    memset (&info, 0, sizeof (info));
+    if (bench.fw->getFrameworkInfo (bench.fw, &bench.prop, bench.private_data,
+            &info) == 0)
+      bench.allocate_in_invoke = info.allocate_in_invoke;
+  } else {
+    bench.allocate_in_invoke = bench.fw->allocate_in_invoke;
+    if (bench.allocate_in_invoke && bench.fw->allocateInInvoke)
+      bench.allocate_in_invoke =
+          (bench.fw->allocateInInvoke (&bench.private_data) == 0);
+  }
+
+  ret = run_bench (&bench);
+
+  if (bench.fw->close)
+    bench.fw->close (&bench.prop, &bench.private_data);
+
+done:
+  gst_tensors_info_free (&bench.prop.input_meta);
+  gst_tensors_info_free (&bench.prop.output_meta);
+  g_strfreev (models);
+  return ret;
+}
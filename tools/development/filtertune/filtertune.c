@@ -0,0 +1,387 @@
+/* SPDX-License-Identifier: LGPL-2.1-only */
+/**
+ * NNStreamer tensor_filter configuration tuner
+ * Copyright (C) 2026 Samsung Electronics Co., Ltd.
+ */
+/**
+ * @file	filtertune.c
+ * @date	15 Oct 2026
+ * @brief	Find the fastest framework and accelerator of tensor_filter for the model
+ * @see		http://github.com/nnstreamer/nnstreamer
+ * @author	agent <agent@local>
+ * @bug		No known bugs except for NYI items
+ *
+ * This is a utility for nnstreamer developers.
+ * This enumerates the tensor_filter sub-plugins and the accelerators
+ * available in this device, runs the model with each configuration
+ * (and each number of the framework threads) with tensor_filter_single,
+ * and prints the fastest configuration as a pipeline description and
+ * an entry of nnstreamer.ini.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <glib.h>
+#include <nnstreamer_plugin_api_filter.h>
+#include <nnstreamer_plugin_api_util.h>
+#include <nnstreamer_internal.h>
+#include <nnstreamer_subplugin.h>
+#include "../../../gst/nnstreamer/tensor_filter/tensor_filter_single.h"
+
+#define DEFAULT_ITERATIONS 50
+#define DEFAULT_WARMUP 5
+
+/**
+ * @brief The accelerators to check the availability.
+ */
+static const accl_hw candidate_hw[] = {
+  ACCL_CPU, ACCL_CPU_SIMD, ACCL_GPU, ACCL_NPU, ACCL_NPU_MOVIDIUS,
+  ACCL_NPU_EDGE_TPU, ACCL_NPU_VIVANTE, ACCL_NPU_SRCN, ACCL_NPU_SLSI,
+  ACCL_NPU_SR,
+};
+
+/**
+ * @brief The sub-plugins which do not load a model file.
+ */
+static const gchar *skip_frameworks[] = {
+  "custom", "custom-easy", NULL
+};
+
+/**
+ * @brief Options of the tuner.
+ */
+static gchar *opt_model = NULL;
+static gchar *opt_frameworks = NULL;
+static gchar *opt_threads = NULL;
+static gchar *opt_input_dim = NULL;
+static gchar *opt_input_type = NULL;
+static gchar *opt_custom = NULL;
+static gint opt_iterations = DEFAULT_ITERATIONS;
+static gint opt_warmup = DEFAULT_WARMUP;
+
+static GOptionEntry entries[] = {
+  {"model", 'm', 0, G_OPTION_ARG_STRING, &opt_model,
+      "The comma-separated list of model files (mandatory)", "FILES"},
+  {"framework", 'f', 0, G_OPTION_ARG_STRING, &opt_frameworks,
+      "The comma-separated list of sub-plugins to try (default: all)", "NAMES"},
+  {"threads", 'j', 0, G_OPTION_ARG_STRING, &opt_threads,
+      "The comma-separated list of the framework threads to try (default: 0, the default of the framework)",
+      "LIST"},
+  {"input", 'i', 0, G_OPTION_ARG_STRING, &opt_input_dim,
+      "The input dimensions if the model does not give them (e.g., 3:224:224:1)",
+      "DIM"},
+  {"inputtype", 't', 0, G_OPTION_ARG_STRING, &opt_input_type,
+      "The input types if the model does not give them (e.g., uint8)", "TYPE"},
+  {"custom", 'c', 0, G_OPTION_ARG_STRING, &opt_custom,
+      "The custom properties of the sub-plugins", "PROPS"},
+  {"iterations", 'n', 0, G_OPTION_ARG_INT, &opt_iterations,
+      "The number of measured invokes of each configuration (default 50)", "N"},
+  {"warmup", 'w', 0, G_OPTION_ARG_INT, &opt_warmup,
+      "The number of invokes before the measurement (default 5)", "N"},
+  {NULL}
+};
+
+/**
+ * @brief The configuration of tensor_filter and its result.
+ */
+typedef struct
+{
+  gchar *framework;
+  gchar *accelerator; /**< accelerator property, NULL for the default of the framework */
+  guint threads; /**< thread-pool property */
+  gboolean done; /**< the model is invoked with this configuration */
+  gint64 p50; /**< median latency of the invoke (usec) */
+  gint64 p90; /**< 90th percentile latency of the invoke (usec) */
+} filtertune_config_s;
+
+/**
+ * @brief Compare function to sort the latency samples.
+ */
+static gint
+compare_int64 (gconstpointer a, gconstpointer b)
+{
+  gint64 va = *(const gint64 *) a;
+  gint64 vb = *(const gint64 *) b;
+
+  return (va > vb) - (va < vb);
+}
+
+/**
+ * @brief Free the configuration.
+ */
+static void
+free_config (gpointer data)
+{
+  filtertune_config_s *config = (filtertune_config_s *) data;
+
+  g_free (config->framework);
+  g_free (config->accelerator);
+  g_free (config);
+}
+
+/**
+ * @brief Get the input and output info of the model opened by tensor_filter_single.
+ */
+static gboolean
+get_model_info (GTensorFilterSingle * single, GstTensorsInfo * in_info,
+    GstTensorsInfo * out_info)
+{
+  GTensorFilterSingleClass *klass;
+  gchar *dim = NULL, *type = NULL;
+
+  klass = (GTensorFilterSingleClass *) G_OBJECT_GET_CLASS (single);
+  if (!klass->input_configured (single)) {
+    if (!opt_input_dim || !opt_input_type)
+      return FALSE;
+
+    in_info->num_tensors =
+        gst_tensors_info_parse_dimensions_string (in_info, opt_input_dim);
+    gst_tensors_info_parse_types_string (in_info, opt_input_type);
+
+    return (klass->set_input_info (single, in_info, out_info) == 0);
+  }
+
+  g_object_get (single, "input", &dim, "inputtype", &type, NULL);
+  in_info->num_tensors = gst_tensors_info_parse_dimensions_string (in_info, dim);
+  gst_tensors_info_parse_types_string (in_info, type);
+  g_free (dim);
+  g_free (type);
+
+  g_object_get (single, "output", &dim, "outputtype", &type, NULL);
+  out_info->num_tensors =
+      gst_tensors_info_parse_dimensions_string (out_info, dim);
+  gst_tensors_info_parse_types_string (out_info, type);
+  g_free (dim);
+  g_free (type);
+
+  return (in_info->num_tensors > 0 && out_info->num_tensors > 0);
+}
+
+/**
+ * @brief Run the model with the configuration and measure the latency.
+ */
+static void
+run_config (filtertune_config_s * config)
+{
+  GTensorFilterSingle *single;
+  GTensorFilterSingleClass *klass;
+  GstTensorsInfo in_info, out_info;
+  GstTensorMemory input[NNS_TENSOR_SIZE_LIMIT] = { {0,}, };
+  GstTensorMemory output[NNS_TENSOR_SIZE_LIMIT] = { {0,}, };
+  gint64 *samples = NULL;
+  gint64 begin;
+  gboolean allocated;
+  guint i, n, total;
+
+  gst_tensors_info_init (&in_info);
+  gst_tensors_info_init (&out_info);
+
+  single = g_object_new (G_TYPE_TENSOR_FILTER_SINGLE, "framework",
+      config->framework, "model", opt_model, NULL);
+  if (config->accelerator)
+    g_object_set (single, "accelerator", config->accelerator, NULL);
+  if (config->threads > 0)
+    g_object_set (single, "thread-pool", config->threads, NULL);
+  if (opt_custom)
+    g_object_set (single, "custom", opt_custom, NULL);
+
+  klass = (GTensorFilterSingleClass *) G_OBJECT_GET_CLASS (single);
+
+  if (!klass->start (single))
+    goto done;
+
+  if (!get_model_info (single, &in_info, &out_info))
+    goto stop;
+
+  for (i = 0; i < in_info.num_tensors; i++) {
+    input[i].size = gst_tensors_info_get_size (&in_info, i);
+    input[i].data = g_malloc0 (input[i].size);
+  }
+  for (i = 0; i < out_info.num_tensors; i++)
+    output[i].size = gst_tensors_info_get_size (&out_info, i);
+
+  allocated = klass->allocate_in_invoke (single);
+  total = (guint) (opt_warmup + opt_iterations);
+  samples = g_new0 (gint64, opt_iterations);
+
+  for (n = 0; n < total; n++) {
+    gboolean ret;
+
+    begin = g_get_monotonic_time ();
+    ret = klass->invoke (single, input, output, TRUE);
+    if (n >= (guint) opt_warmup)
+      samples[n - opt_warmup] = g_get_monotonic_time () - begin;
+
+    if (!ret)
+      goto stop;
+
+    if (allocated) {
+      klass->destroy_notify (single, output);
+    } else {
+      for (i = 0; i < out_info.num_tensors; i++) {
+        g_free (output[i].data);
+        output[i].data = NULL;
+      }
+    }
+  }
+
+  qsort (samples, opt_iterations, sizeof (gint64), compare_int64);
+  config->p50 = samples[(opt_iterations - 1) / 2];
+  config->p90 = samples[(opt_iterations * 9 - 1) / 10];
+  config->done = TRUE;
+
+stop:
+  klass->stop (single);
+
+  for (i = 0; i < in_info.num_tensors; i++)
+    g_free (input[i].data);
+  g_free (samples);
+
+done:
+  g_object_unref (single);
+  gst_tensors_info_free (&in_info);
+  gst_tensors_info_free (&out_info);
+}
+
+/**
+ * @brief Add the configurations of the framework, for each available accelerator and the number of threads.
+ */
+static void
+add_configs (GPtrArray * configs, const gchar * framework, gchar ** threads)
+{
+  filtertune_config_s *config;
+  guint h, t;
+
+  if (!nnstreamer_filter_find (framework)) {
+    g_printerr ("Cannot find the sub-plugin '%s', skip it.\n", framework);
+    return;
+  }
+
+  /* h == G_N_ELEMENTS: the default of the framework */
+  for (h = 0; h <= G_N_ELEMENTS (candidate_hw); h++) {
+    if (h < G_N_ELEMENTS (candidate_hw) &&
+        !gst_tensor_filter_check_hw_availability (framework, candidate_hw[h],
+            NULL))
+      continue;
+
+    for (t = 0; threads[t]; t++) {
+      config = g_new0 (filtertune_config_s, 1);
+      config->framework = g_strdup (framework);
+      config->threads = (guint) g_ascii_strtoull (threads[t], NULL, 10);
+      if (h < G_N_ELEMENTS (candidate_hw))
+        config->accelerator = g_strdup_printf ("true:%s",
+            get_accl_hw_str (candidate_hw[h]));
+
+      g_ptr_array_add (configs, config);
+    }
+  }
+}
+
+/**
+ * @brief Print the fastest configuration.
+ */
+static void
+print_best (filtertune_config_s * best)
+{
+  const gchar *ext;
+
+  g_print ("\nThe fastest configuration (p50 %" G_GINT64_FORMAT " usec):\n\n",
+      best->p50);
+
+  g_print ("  tensor_filter framework=%s model=%s", best->framework, opt_model);
+  if (best->accelerator)
+    g_print (" accelerator=%s", best->accelerator);
+  if (best->threads > 0)
+    g_print (" thread-pool=%u", best->threads);
+  if (opt_custom)
+    g_print (" custom=%s", opt_custom);
+  g_print ("\n");
+
+  /* nnstreamer.ini selects the framework of framework=auto with the extension of the model. */
+  ext = strrchr (opt_model, '.');
+  if (ext && !strchr (ext, '/') && !strchr (ext, ',')) {
+    g_print ("\nnnstreamer.ini:\n\n");
+    g_print ("  [filter]\n");
+    g_print ("  framework_priority_%s=%s\n", ext + 1, best->framework);
+  }
+}
+
+/**
+ * @brief Main routine
+ */
+int
+main (int argc, char *argv[])
+{
+  GOptionContext *ctx;
+  GError *err = NULL;
+  GPtrArray *configs;
+  filtertune_config_s *config, *best = NULL;
+  gchar **frameworks, **threads;
+  guint i;
+
+  ctx = g_option_context_new ("- find the fastest tensor_filter configuration");
+  g_option_context_add_main_entries (ctx, entries, NULL);
+
+  if (!g_option_context_parse (ctx, &argc, &argv, &err)) {
+    g_printerr ("Failed to parse the options: %s\n", err->message);
+    g_clear_error (&err);
+    g_option_context_free (ctx);
+    return -1;
+  }
+  g_option_context_free (ctx);
+
+  if (!opt_model || opt_iterations <= 0 || opt_warmup < 0) {
+    g_printerr ("Please set the model and the positive iterations.\n");
+    return -1;
+  }
+
+  if (opt_frameworks)
+    frameworks = g_strsplit (opt_frameworks, ",", -1);
+  else
+    frameworks = get_all_subplugins (NNS_SUBPLUGIN_FILTER);
+
+  threads = g_strsplit (opt_threads ? opt_threads : "0", ",", -1);
+  configs = g_ptr_array_new_with_free_func (free_config);
+
+  for (i = 0; frameworks && frameworks[i]; i++) {
+    gchar *name = g_strstrip (frameworks[i]);
+
+    if (name[0] == '\0' ||
+        g_strv_contains ((const gchar * const *) skip_frameworks, name))
+      continue;
+
+    add_configs (configs, name, threads);
+  }
+
+  g_print ("%-24s %-20s %8s %10s %10s\n", "framework", "accelerator",
+      "threads", "p50(usec)", "p90(usec)");
+
+  for (i = 0; i < configs->len; i++) {
+    config = g_ptr_array_index (configs, i);
+    run_config (config);
+
+    if (!config->done) {
+      g_print ("%-24s %-20s %8u %10s %10s\n", config->framework,
+          config->accelerator ? config->accelerator : "(default)",
+          config->threads, "failed", "-");
+      continue;
+    }
+
+    g_print ("%-24s %-20s %8u %10" G_GINT64_FORMAT " %10" G_GINT64_FORMAT
+        "\n", config->framework,
+        config->accelerator ? config->accelerator : "(default)",
+        config->threads, config->p50, config->p90);
+
+    if (!best || config->p50 < best->p50)
+      best = config;
+  }
+
+  if (best)
+    print_best (best);
+  else
+    g_printerr ("\nNo configuration can run the model.\n");
+
+  g_ptr_array_free (configs, TRUE);
+  g_strfreev (frameworks);
+  g_strfreev (threads);
+  return best ? 0 : -1;
+}